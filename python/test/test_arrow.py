@@ -17,7 +17,7 @@
 import unittest
 import pyarrow
 
-from pyvelox.arrow import to_velox, to_arrow
+from pyvelox.arrow import to_velox, to_arrow, to_arrow_reader
 from pyvelox.vector import Vector
 
 
@@ -70,6 +70,25 @@ class TestPyVeloxArrow(unittest.TestCase):
         self.assertTrue(isinstance(struct_array, pyarrow.StructArray))
         self.assertEqual(struct_array, record_batch.to_struct_array())
 
+    def test_reader(self):
+        batches = [
+            pyarrow.RecordBatch.from_arrays(
+                [
+                    pyarrow.array([i, i + 1]),
+                    pyarrow.array(["a", "b"]),
+                ],
+                names=["col1", "col2"],
+            )
+            for i in range(3)
+        ]
+        reader = to_arrow_reader(to_velox(batch) for batch in batches)
+        self.assertTrue(isinstance(reader, pyarrow.RecordBatchReader))
+        self.assertEqual(reader.schema, batches[0].schema)
+        self.assertEqual(reader.read_all(), pyarrow.Table.from_batches(batches))
+
+        with self.assertRaises(RuntimeError):
+            to_arrow_reader([])
+
     def test_empty(self):
         # TODO: Velox's arrow bridge does not allow missing buffers (even if
         # there are no rows):
@@ -315,34 +315,35 @@ void QueryBenchmarkBase::readCombinations() {
   }
 }
 
-void QueryBenchmarkBase::runCombinations(int32_t level) {
-  if (level == parameters_.size()) {
-    if (FLAGS_clear_ram_cache) {
+void QueryBenchmarkBase::clearCaches(bool ramCache, bool ssdCache) {
+  if (ramCache) {
 #ifdef linux
-      // system("echo 3 >/proc/sys/vm/drop_caches");
-      bool success = false;
-      auto fd = open("/proc//sys/vm/drop_caches", O_WRONLY);
-      if (fd > 0) {
-        success = write(fd, "3", 1) == 1;
-        close(fd);
-      }
-      if (!success) {
-        LOG(ERROR) << "Failed to clear OS disk cache: errno=" << errno;
-      }
+    // system("echo 3 >/proc/sys/vm/drop_caches");
+    bool success = false;
+    auto fd = open("/proc//sys/vm/drop_caches", O_WRONLY);
+    if (fd > 0) {
+      success = write(fd, "3", 1) == 1;
+      close(fd);
+    }
+    if (!success) {
+      LOG(ERROR) << "Failed to clear OS disk cache: errno=" << errno;
+    }
 #endif
 
-      if (cache_) {
-        cache_->clear();
-      }
+    if (cache_) {
+      cache_->clear();
     }
-    if (FLAGS_clear_ssd_cache) {
-      if (cache_) {
-        auto ssdCache = cache_->ssdCache();
-        if (ssdCache) {
-          ssdCache->clear();
-        }
-      }
+  }
+  if (ssdCache && cache_) {
+    if (auto* ssd = cache_->ssdCache()) {
+      ssd->clear();
     }
+  }
+}
+
+void QueryBenchmarkBase::runCombinations(int32_t level) {
+  if (level == parameters_.size()) {
+    clearCaches(FLAGS_clear_ram_cache, FLAGS_clear_ssd_cache);
     if (FLAGS_warmup_after_clear) {
       std::stringstream result;
       RunStats ignore;
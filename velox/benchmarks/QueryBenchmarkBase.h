@@ -85,6 +85,11 @@ class QueryBenchmarkBase {
   virtual std::shared_ptr<config::ConfigBase> makeConnectorProperties();
 
  protected:
+  /// Clears the OS file system cache (if root on Linux) and the in-process
+  /// data cache if 'ramCache' is true, and the SSD cache if 'ssdCache' is
+  /// true.
+  void clearCaches(bool ramCache, bool ssdCache);
+
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
   std::shared_ptr<memory::MemoryAllocator> allocator_;
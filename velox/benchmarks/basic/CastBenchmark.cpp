@@ -92,6 +92,27 @@ int main(int argc, char** argv) {
       [](auto row) { return fmt::format("2024-05-{:02d}", 1 + row % 30); });
   auto invalidDateStrings = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto row) { return fmt::format("2024-05...{}", row); });
+  // Dirty data where one row in five fails to cast.
+  auto dirtyIntStrings =
+      vectorMaker.flatVector<std::string>(vectorSize, [](auto row) {
+        if (row % 10 == 0) {
+          return fmt::format("{}x", row);
+        }
+        if (row % 10 == 5) {
+          return std::string("\u0663\u0664");
+        }
+        return std::to_string(row);
+      });
+  auto dirtyDoubleStrings =
+      vectorMaker.flatVector<std::string>(vectorSize, [](auto row) {
+        return row % 5 == 0 ? fmt::format("{}.1.2", row)
+                            : fmt::format("{}.5", row);
+      });
+  auto dirtyDateStrings =
+      vectorMaker.flatVector<std::string>(vectorSize, [](auto row) {
+        return row % 5 == 0 ? fmt::format("2024-05...{}", row)
+                            : fmt::format("2024-05-{:02d}", 1 + row % 30);
+      });
 
   benchmarkBuilder
       .addBenchmarkSet(
@@ -124,6 +145,27 @@ int main(int argc, char** argv) {
           "tryexpr_cast_invalid_input", "try(cast (invalid_date as timestamp))")
       .addExpression("cast_valid", "cast(valid_date as timestamp)");
 
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_dirty_varchar_as_int",
+          vectorMaker.rowVector({"dirty"}, {dirtyIntStrings}))
+      .addExpression("try_cast", "try_cast(dirty as int)")
+      .addExpression("tryexpr_cast", "try(cast(dirty as int))");
+
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_dirty_varchar_as_double",
+          vectorMaker.rowVector({"dirty"}, {dirtyDoubleStrings}))
+      .addExpression("try_cast", "try_cast(dirty as double)")
+      .addExpression("tryexpr_cast", "try(cast(dirty as double))");
+
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_dirty_varchar_as_date",
+          vectorMaker.rowVector({"dirty"}, {dirtyDateStrings}))
+      .addExpression("try_cast", "try_cast(dirty as date)")
+      .addExpression("tryexpr_cast", "try(cast(dirty as date))");
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast_timestamp_as_varchar",
@@ -41,7 +41,8 @@ class SelectivityVectorBenchmark
         rows99PerCent_(vectorSize),
         rows50PerCent_(vectorSize),
         rows10PerCent_(vectorSize),
-        rows1PerCent_(vectorSize) {
+        rows1PerCent_(vectorSize),
+        rows01PerCent_(vectorSize) {
     VectorFuzzer::Options opts;
     opts.vectorSize = vectorSize_;
     opts.nullRatio = 0;
@@ -64,6 +65,11 @@ class SelectivityVectorBenchmark
         rows1PerCent_.setValid(i, false);
       }
 
+      // Set 99.9% to invalid.
+      if (fuzzer.coinToss(0.999)) {
+        rows01PerCent_.setValid(i, false);
+      }
+
       // Set 1% to invalid.
       if (fuzzer.coinToss(0.01)) {
         rows99PerCent_.setValid(i, false);
@@ -75,6 +81,7 @@ class SelectivityVectorBenchmark
     rows50PerCent_.updateBounds();
     rows10PerCent_.updateBounds();
     rows1PerCent_.updateBounds();
+    rows01PerCent_.updateBounds();
   }
 
   size_t runBaseline() {
@@ -108,6 +115,24 @@ class SelectivityVectorBenchmark
     return run(rows99PerCent_);
   }
 
+  // Uses the list of selected rows that the first iteration makes.
+  size_t runSelectivity01PerCent() {
+    return run(rows01PerCent_);
+  }
+
+  // Scans the bits as before sparse selections were kept as lists.
+  size_t runSelectivity01PerCentBits() {
+    const int64_t* flatBuffer = flatVector_->values()->as<int64_t>();
+    size_t sum = 0;
+    bits::forEachSetBit(
+        rows01PerCent_.allBits(),
+        rows01PerCent_.begin(),
+        rows01PerCent_.end(),
+        [&](auto row) { sum += flatBuffer[row]; });
+    folly::doNotOptimizeAway(sum);
+    return vectorSize_;
+  }
+
  private:
   size_t run(const SelectivityVector& rows) {
     const int64_t* flatBuffer = flatVector_->values()->as<int64_t>();
@@ -126,6 +151,7 @@ class SelectivityVectorBenchmark
   SelectivityVector rows50PerCent_;
   SelectivityVector rows10PerCent_;
   SelectivityVector rows1PerCent_;
+  SelectivityVector rows01PerCent_;
 };
 
 std::unique_ptr<SelectivityVectorBenchmark> benchmark;
@@ -161,6 +187,14 @@ BENCHMARK(sumSelectivity1PerCent) {
   run([] { benchmark->runSelectivity1PerCent(); });
 }
 
+BENCHMARK(sumSelectivity01PerCent) {
+  run([] { benchmark->runSelectivity01PerCent(); });
+}
+
+BENCHMARK(sumSelectivity01PerCentBits) {
+  run([] { benchmark->runSelectivity01PerCentBits(); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/benchmarks/functions/FunctionSignatureBenchmark.h"
+
+#include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Aggregate.h"
+#include "velox/exec/AggregateFunctionRegistry.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/expression/Expr.h"
+#include "velox/expression/ExprConstants.h"
+#include "velox/expression/fuzzer/ArgumentTypeFuzzer.h"
+#include "velox/functions/FunctionRegistry.h"
+
+namespace facebook::velox {
+namespace {
+
+std::string argTypesName(const std::vector<TypePtr>& argTypes) {
+  std::vector<std::string> names;
+  names.reserve(argTypes.size());
+  for (const auto& type : argTypes) {
+    names.push_back(type->toString());
+  }
+  return folly::join(", ", names);
+}
+
+bool regressed(double value, double baseline, double maxPct, double minNs) {
+  return value - baseline >= minNs && value > baseline * (1 + maxPct / 100);
+}
+
+} // namespace
+
+// static
+std::string FunctionSignatureBenchmark::encodingName(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::kFlat:
+      return "flat";
+    case Encoding::kDictionary:
+      return "dictionary";
+    case Encoding::kConstant:
+      return "constant";
+  }
+  VELOX_UNREACHABLE();
+}
+
+// static
+std::vector<FunctionSignatureBenchmark::Encoding>
+FunctionSignatureBenchmark::parseEncodings(std::string_view encodings) {
+  std::vector<std::string> names;
+  folly::split(',', encodings, names, true);
+  std::vector<Encoding> result;
+  for (const auto& name : names) {
+    if (name == "flat") {
+      result.push_back(Encoding::kFlat);
+    } else if (name == "dictionary") {
+      result.push_back(Encoding::kDictionary);
+    } else if (name == "constant") {
+      result.push_back(Encoding::kConstant);
+    } else {
+      VELOX_USER_FAIL("Unknown encoding: {}", name);
+    }
+  }
+  VELOX_USER_CHECK(!result.empty(), "No encodings given");
+  return result;
+}
+
+FunctionSignatureBenchmark::FunctionSignatureBenchmark(
+    Options options,
+    memory::MemoryPool* pool)
+    : options_(std::move(options)),
+      pool_(pool),
+      queryCtx_(core::QueryCtx::create()),
+      execCtx_(pool_, queryCtx_.get()) {
+  VELOX_USER_CHECK_GT(options_.vectorSize, 0);
+  VELOX_USER_CHECK_GT(options_.iterations, 0);
+  VELOX_USER_CHECK(!options_.nullRatios.empty(), "No null ratios given");
+}
+
+bool FunctionSignatureBenchmark::resolveArgumentTypes(
+    const std::string& name,
+    const exec::FunctionSignature& signature,
+    std::vector<TypePtr>& argTypes) {
+  if (signature.hasLambdaArgument()) {
+    return false;
+  }
+  // Seeded by the signature so that a signature binds to the same types in
+  // every run, whatever else is registered.
+  FuzzerGenerator rng(
+      options_.seed ^ folly::hash::fnv64(name + signature.toString()));
+  fuzzer::ArgumentTypeFuzzer typeFuzzer(signature, rng);
+  if (!typeFuzzer.fuzzArgumentTypes(options_.maxVariadicArgs)) {
+    return false;
+  }
+  argTypes = typeFuzzer.argumentTypes();
+  return true;
+}
+
+RowVectorPtr FunctionSignatureBenchmark::makeInput(
+    const exec::FunctionSignature& signature,
+    const std::vector<TypePtr>& argTypes,
+    Encoding encoding,
+    double nullRatio,
+    std::vector<core::TypedExprPtr>& args) {
+  VectorFuzzer::Options fuzzerOptions;
+  fuzzerOptions.vectorSize = options_.vectorSize;
+  fuzzerOptions.nullRatio = nullRatio;
+  VectorFuzzer fuzzer(fuzzerOptions, pool_, options_.seed);
+
+  const auto& constantArgs = signature.constantArguments();
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<VectorPtr> children;
+  for (auto i = 0; i < argTypes.size(); ++i) {
+    const auto& type = argTypes[i];
+    // The repeated arguments of a variadic signature are like its last one.
+    const bool constant = !constantArgs.empty() &&
+        constantArgs[std::min<size_t>(i, constantArgs.size() - 1)];
+    if (constant) {
+      // A null constant would make most functions trivial.
+      args.push_back(std::make_shared<core::ConstantTypedExpr>(
+          BaseVector::wrapInConstant(1, 0, fuzzer.fuzzFlatNotNull(type, 1))));
+      continue;
+    }
+    names.push_back(fmt::format("c{}", children.size()));
+    types.push_back(type);
+    args.push_back(
+        std::make_shared<core::FieldAccessTypedExpr>(type, names.back()));
+    switch (encoding) {
+      case Encoding::kFlat:
+        children.push_back(fuzzer.fuzzFlat(type));
+        break;
+      case Encoding::kDictionary:
+        children.push_back(fuzzer.fuzzDictionary(fuzzer.fuzzFlat(type)));
+        break;
+      case Encoding::kConstant:
+        children.push_back(fuzzer.fuzzConstant(type));
+        break;
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool_,
+      ROW(std::move(names), std::move(types)),
+      nullptr,
+      options_.vectorSize,
+      std::move(children));
+}
+
+uint64_t FunctionSignatureBenchmark::timeScalar(
+    const core::TypedExprPtr& call,
+    const RowVectorPtr& input) {
+  exec::ExprSet exprSet({call}, &execCtx_);
+  SelectivityVector rows(input->size());
+  auto evaluate = [&]() {
+    exec::EvalCtx evalCtx(&execCtx_, &exprSet, input.get());
+    std::vector<VectorPtr> results(1);
+    exprSet.eval(rows, evalCtx, results);
+    folly::doNotOptimizeAway(results);
+  };
+  // The first evaluation also builds the state a function caches on its
+  // first call, e.g. a compiled regular expression.
+  evaluate();
+  std::vector<uint64_t> nanos(options_.iterations, 0);
+  for (auto& iterationNanos : nanos) {
+    NanosecondTimer timer(&iterationNanos);
+    evaluate();
+  }
+  std::sort(nanos.begin(), nanos.end());
+  return nanos[nanos.size() / 2];
+}
+
+uint64_t FunctionSignatureBenchmark::timeAggregate(
+    const core::CallTypedExprPtr& call,
+    const std::vector<TypePtr>& argTypes,
+    const RowVectorPtr& input) {
+  auto makePlan = [&](size_t repeatTimes) {
+    return exec::test::PlanBuilder()
+        .values({input}, false, repeatTimes)
+        .addNode([&](std::string id, core::PlanNodePtr source) {
+          return std::make_shared<core::AggregationNode>(
+              id,
+              core::AggregationNode::Step::kSingle,
+              std::vector<core::FieldAccessTypedExprPtr>{},
+              std::vector<core::FieldAccessTypedExprPtr>{},
+              std::vector<std::string>{"a0"},
+              std::vector<core::AggregationNode::Aggregate>{{call, argTypes}},
+              false,
+              false,
+              std::move(source));
+        })
+        .planNode();
+  };
+  // Warms up as timeScalar() does.
+  exec::test::AssertQueryBuilder(makePlan(1)).copyResults(pool_);
+  const auto plan = makePlan(options_.iterations);
+  uint64_t nanos = 0;
+  {
+    NanosecondTimer timer(&nanos);
+    exec::test::AssertQueryBuilder(plan).copyResults(pool_);
+  }
+  return nanos;
+}
+
+void FunctionSignatureBenchmark::runCase(
+    bool aggregate,
+    const std::string& name,
+    const exec::FunctionSignature& signature,
+    const std::vector<TypePtr>& argTypes,
+    Encoding encoding,
+    double nullRatio,
+    std::ostream& out) {
+  const auto types = argTypesName(argTypes);
+  const auto key = fmt::format(
+      "{}:{}({})/{}/nulls={}",
+      aggregate ? "aggregate" : "scalar",
+      name,
+      types,
+      encodingName(encoding),
+      nullRatio);
+  try {
+    std::vector<core::TypedExprPtr> args;
+    const auto input =
+        makeInput(signature, argTypes, encoding, nullRatio, args);
+    double nsPerRow;
+    bool underTry = false;
+    if (aggregate) {
+      auto call = std::make_shared<core::CallTypedExpr>(
+          exec::resolveResultType(name, argTypes), std::move(args), name);
+      nsPerRow = static_cast<double>(timeAggregate(call, argTypes, input)) /
+          (input->size() * options_.iterations);
+    } else {
+      const auto resultType = resolveFunction(name, argTypes);
+      VELOX_CHECK_NOT_NULL(resultType, "Cannot resolve the function");
+      core::TypedExprPtr call = std::make_shared<core::CallTypedExpr>(
+          resultType, std::move(args), name);
+      uint64_t nanos;
+      try {
+        nanos = timeScalar(call, input);
+      } catch (const VeloxUserError&) {
+        // Random input is often invalid for the function, e.g. a malformed
+        // URL. Under TRY the rows that fail become null and the others are
+        // still timed.
+        call = std::make_shared<core::CallTypedExpr>(
+            resultType,
+            std::vector<core::TypedExprPtr>{call},
+            expression::kTry);
+        nanos = timeScalar(call, input);
+        underTry = true;
+      }
+      nsPerRow = static_cast<double>(nanos) / input->size();
+    }
+    out << key << ": " << fmt::format("{:.2f}", nsPerRow) << " ns/row"
+        << (underTry ? " under try" : "") << std::endl;
+    results_.push_back(folly::dynamic::object("key", key)("function", name)(
+        "aggregate", aggregate)("argTypes", types)(
+        "encoding", encodingName(encoding))("nullRatio", nullRatio)(
+        "nsPerRow", nsPerRow)("underTry", underTry));
+  } catch (const VeloxException& e) {
+    out << key << ": failed: " << e.message() << std::endl;
+    failures_.push_back(
+        folly::dynamic::object("key", key)("error", e.message()));
+  } catch (const std::exception& e) {
+    out << key << ": failed: " << e.what() << std::endl;
+    failures_.push_back(folly::dynamic::object("key", key)("error", e.what()));
+  }
+}
+
+folly::dynamic FunctionSignatureBenchmark::run(std::ostream& out) {
+  results_ = folly::dynamic::array;
+  failures_ = folly::dynamic::array;
+  auto included = [&](const std::string& name) {
+    return (options_.onlyFunctions.empty() ||
+            options_.onlyFunctions.count(name)) &&
+        !options_.skipFunctions.count(name);
+  };
+
+  // Keyed on whether the function is an aggregate and its name. Sorted for a
+  // stable order in the output.
+  std::map<
+      std::pair<bool, std::string>,
+      std::vector<const exec::FunctionSignature*>>
+      functions;
+  for (const auto& [name, signatures] : getFunctionSignatures()) {
+    if (included(name)) {
+      functions[{false, name}] = signatures;
+    }
+  }
+  // The registry keeps the signatures alive.
+  const auto aggregateSignatures = options_.aggregates
+      ? exec::getAggregateFunctionSignatures()
+      : exec::AggregateFunctionSignatureMap{};
+  for (const auto& [name, signatures] : aggregateSignatures) {
+    if (!included(name)) {
+      continue;
+    }
+    auto& entry = functions[{true, name}];
+    for (const auto& signature : signatures) {
+      entry.push_back(signature.get());
+    }
+  }
+
+  int64_t numSkipped = 0;
+  for (const auto& [function, signatures] : functions) {
+    const auto& [aggregate, name] = function;
+    for (const auto* signature : signatures) {
+      std::vector<TypePtr> argTypes;
+      if (!resolveArgumentTypes(name, *signature, argTypes)) {
+        ++numSkipped;
+        continue;
+      }
+      for (auto encoding : options_.encodings) {
+        if (aggregate && encoding == Encoding::kConstant) {
+          continue;
+        }
+        for (auto nullRatio : options_.nullRatios) {
+          runCase(
+              aggregate,
+              name,
+              *signature,
+              argTypes,
+              encoding,
+              nullRatio,
+              out);
+        }
+      }
+    }
+  }
+  out << results_.size() << " cases run, " << failures_.size()
+      << " failed, " << numSkipped
+      << " signatures skipped for lambda or unbound arguments" << std::endl;
+
+  std::vector<const folly::dynamic*> slowest;
+  for (const auto& result : results_) {
+    slowest.push_back(&result);
+  }
+  std::sort(
+      slowest.begin(), slowest.end(), [](const auto* left, const auto* right) {
+        return (*left)["nsPerRow"].asDouble() >
+            (*right)["nsPerRow"].asDouble();
+      });
+  slowest.resize(std::min<size_t>(slowest.size(), options_.numSlowest));
+  if (!slowest.empty()) {
+    out << "Slowest cases:" << std::endl;
+  }
+  for (const auto* result : slowest) {
+    out << "  " << (*result)["key"].asString() << ": "
+        << fmt::format("{:.2f}", (*result)["nsPerRow"].asDouble())
+        << " ns/row" << std::endl;
+  }
+
+  return folly::dynamic::object("results", results_)("failures", failures_)(
+      "numSkipped", numSkipped);
+}
+
+// static
+folly::dynamic FunctionSignatureBenchmark::compare(
+    const folly::dynamic& results,
+    const folly::dynamic& baseline,
+    const Thresholds& thresholds) {
+  std::unordered_map<std::string, double> baselineNsPerRow;
+  for (const auto& result : baseline["results"]) {
+    baselineNsPerRow[result["key"].asString()] = result["nsPerRow"].asDouble();
+  }
+  folly::dynamic regressions = folly::dynamic::array;
+  for (const auto& result : results["results"]) {
+    const auto key = result["key"].asString();
+    auto it = baselineNsPerRow.find(key);
+    if (it == baselineNsPerRow.end()) {
+      continue;
+    }
+    const auto nsPerRow = result["nsPerRow"].asDouble();
+    if (regressed(
+            nsPerRow, it->second, thresholds.pct, thresholds.minNsPerRow)) {
+      regressions.push_back(folly::dynamic::object("key", key)(
+          "nsPerRow", nsPerRow)("baselineNsPerRow", it->second));
+    }
+  }
+  for (const auto& failure : results["failures"]) {
+    const auto key = failure["key"].asString();
+    auto it = baselineNsPerRow.find(key);
+    if (it != baselineNsPerRow.end()) {
+      regressions.push_back(folly::dynamic::object("key", key)(
+          "nsPerRow", nullptr)("baselineNsPerRow", it->second)(
+          "error", failure["error"]));
+    }
+  }
+  return regressions;
+}
+
+} // namespace facebook::velox
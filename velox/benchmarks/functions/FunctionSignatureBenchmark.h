@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/dynamic.h>
+#include <unordered_set>
+
+#include "velox/core/QueryCtx.h"
+#include "velox/expression/FunctionSignature.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+namespace facebook::velox {
+
+/// Benchmarks every registered scalar and, optionally, aggregate function
+/// signature on input generated by VectorFuzzer. Each signature is run once
+/// per encoding and null ratio of its input, and its cost is recorded in
+/// nanoseconds per input row. Results are JSON and can be compared against
+/// the JSON of an earlier run to find the functions that got slower.
+///
+/// The caller registers the functions before calling run().
+class FunctionSignatureBenchmark {
+ public:
+  /// The encoding of the non-constant arguments of a signature.
+  enum class Encoding {
+    kFlat,
+    /// A random dictionary over a flat vector.
+    kDictionary,
+    /// A constant vector. Only run for scalar functions.
+    kConstant,
+  };
+
+  static std::string encodingName(Encoding encoding);
+
+  /// Parses a comma separated list of encoding names.
+  static std::vector<Encoding> parseEncodings(std::string_view encodings);
+
+  struct Options {
+    std::vector<Encoding> encodings{Encoding::kFlat};
+    std::vector<double> nullRatios{0};
+    vector_size_t vectorSize{10'000};
+    /// Number of timed evaluations of a scalar signature. The median is
+    /// recorded. For aggregates, the number of times the input is repeated.
+    int32_t iterations{10};
+    /// Maximum number of repetitions of the last argument of a variadic
+    /// signature.
+    int32_t maxVariadicArgs{2};
+    size_t seed{0};
+    bool aggregates{false};
+    /// If not empty, only these functions are run.
+    std::unordered_set<std::string> onlyFunctions;
+    std::unordered_set<std::string> skipFunctions;
+    /// Number of the slowest cases printed at the end of run().
+    int32_t numSlowest{20};
+  };
+
+  FunctionSignatureBenchmark(Options options, memory::MemoryPool* pool);
+
+  /// Runs all the signatures and returns {"results": [...], "failures":
+  /// [...]}. A result has the case key, function, argument types, encoding,
+  /// null ratio and nsPerRow. A failure has the key and the error. Prints a
+  /// line per case to 'out'.
+  folly::dynamic run(std::ostream& out);
+
+  struct Thresholds {
+    /// A case regresses if its nsPerRow exceeds the baseline by this many
+    /// percent...
+    double pct{20};
+    /// ...and by at least this many nanoseconds.
+    double minNsPerRow{1};
+  };
+
+  /// Returns the regressions of 'results' against 'baseline', both as
+  /// returned by run(). A case that failed but has a baseline result is a
+  /// regression. Cases without a baseline are not compared.
+  static folly::dynamic compare(
+      const folly::dynamic& results,
+      const folly::dynamic& baseline,
+      const Thresholds& thresholds);
+
+ private:
+  // Resolves the argument types of 'signature' of 'name'. Returns false if
+  // the signature cannot be bound or has a lambda argument.
+  bool resolveArgumentTypes(
+      const std::string& name,
+      const exec::FunctionSignature& signature,
+      std::vector<TypePtr>& argTypes);
+
+  // Generates the input and the argument expressions of a call with
+  // 'argTypes'. The arguments that 'signature' requires to be constant
+  // become constant expressions. The others are fields of the input.
+  RowVectorPtr makeInput(
+      const exec::FunctionSignature& signature,
+      const std::vector<TypePtr>& argTypes,
+      Encoding encoding,
+      double nullRatio,
+      std::vector<core::TypedExprPtr>& args);
+
+  // Returns the median nanoseconds of evaluating 'call' on 'input'.
+  uint64_t timeScalar(
+      const core::TypedExprPtr& call,
+      const RowVectorPtr& input);
+
+  // Returns the nanoseconds of aggregating 'input' 'iterations' times with
+  // 'call' in a global single aggregation.
+  uint64_t timeAggregate(
+      const core::CallTypedExprPtr& call,
+      const std::vector<TypePtr>& argTypes,
+      const RowVectorPtr& input);
+
+  // Runs one case. Adds its result or failure.
+  void runCase(
+      bool aggregate,
+      const std::string& name,
+      const exec::FunctionSignature& signature,
+      const std::vector<TypePtr>& argTypes,
+      Encoding encoding,
+      double nullRatio,
+      std::ostream& out);
+
+  const Options options_;
+  memory::MemoryPool* const pool_;
+  const std::shared_ptr<core::QueryCtx> queryCtx_;
+  core::ExecCtx execCtx_;
+  folly::dynamic results_ = folly::dynamic::array;
+  folly::dynamic failures_ = folly::dynamic::array;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+
+#include "velox/benchmarks/functions/FunctionSignatureBenchmark.h"
+#include "velox/expression/RegisterSpecialForm.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/sparksql/aggregates/Register.h"
+#include "velox/functions/sparksql/registration/Register.h"
+
+DEFINE_string(
+    function_set,
+    "presto",
+    "Functions to benchmark: presto or spark");
+DEFINE_bool(aggregates, false, "Also benchmark the aggregate functions");
+DEFINE_string(
+    functions,
+    "",
+    "Comma separated names of the functions to run. Runs all if empty");
+DEFINE_string(
+    skip_functions,
+    "",
+    "Comma separated names of the functions not to run");
+DEFINE_string(
+    encodings,
+    "flat,dictionary,constant",
+    "Comma separated encodings of the arguments: flat, dictionary or "
+    "constant. Aggregates are not run on constant arguments");
+DEFINE_string(
+    null_ratios,
+    "0,0.5",
+    "Comma separated ratios of nulls in the arguments");
+DEFINE_int32(vector_size, 10'000, "Number of rows of an input vector");
+DEFINE_int32(
+    iterations,
+    10,
+    "Number of timed evaluations of a scalar function, of which the median "
+    "is recorded. For aggregates, the number of times the input is fed to "
+    "the aggregation");
+DEFINE_int64(seed, 0, "Seed of the argument types and values");
+DEFINE_int32(num_slowest, 20, "Number of the slowest cases to print");
+DEFINE_string(output_json, "", "File to write the results to");
+DEFINE_string(
+    baseline_json,
+    "",
+    "Results of an earlier run to compare against. The program exits with an "
+    "error if any case regresses");
+DEFINE_double(
+    max_regression_pct,
+    20,
+    "Percentage of the baseline ns/row by which a case may get slower");
+DEFINE_double(
+    min_regression_ns,
+    1,
+    "A case slower than the baseline by less than this many ns/row does not "
+    "regress");
+
+using namespace facebook::velox;
+
+namespace {
+
+std::unordered_set<std::string> splitList(std::string_view list) {
+  std::vector<std::string> names;
+  folly::split(',', list, names, true);
+  return {names.begin(), names.end()};
+}
+
+void registerFunctions() {
+  exec::registerFunctionCallToSpecialForms();
+  if (FLAGS_function_set == "presto") {
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions(
+        "", /*withCompanionFunctions=*/false);
+  } else if (FLAGS_function_set == "spark") {
+    functions::sparksql::registerFunctions("");
+    functions::aggregate::sparksql::registerAggregateFunctions(
+        "", /*withCompanionFunctions=*/false);
+  } else {
+    VELOX_USER_FAIL("Unknown function set: {}", FLAGS_function_set);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string kUsage(
+      "This program benchmarks every signature of the registered functions "
+      "on fuzzed input and compares the ns/row against a baseline. Run "
+      "'velox_function_signature_benchmark "
+      "-helpon=FunctionSignatureBenchmarkMain' for available options.\n");
+  gflags::SetUsageMessage(kUsage);
+  folly::Init init{&argc, &argv, false};
+  memory::MemoryManager::initialize(memory::MemoryManager::Options{});
+  registerFunctions();
+
+  FunctionSignatureBenchmark::Options options;
+  options.encodings =
+      FunctionSignatureBenchmark::parseEncodings(FLAGS_encodings);
+  options.nullRatios.clear();
+  for (const auto& ratio : splitList(FLAGS_null_ratios)) {
+    options.nullRatios.push_back(folly::to<double>(ratio));
+  }
+  std::sort(options.nullRatios.begin(), options.nullRatios.end());
+  options.vectorSize = FLAGS_vector_size;
+  options.iterations = FLAGS_iterations;
+  options.seed = FLAGS_seed;
+  options.aggregates = FLAGS_aggregates;
+  options.onlyFunctions = splitList(FLAGS_functions);
+  options.skipFunctions = splitList(FLAGS_skip_functions);
+  options.numSlowest = FLAGS_num_slowest;
+
+  auto pool = memory::memoryManager()->addLeafPool();
+  FunctionSignatureBenchmark benchmark(std::move(options), pool.get());
+  auto results = benchmark.run(std::cout);
+
+  size_t numRegressions = 0;
+  if (!FLAGS_baseline_json.empty()) {
+    std::string baselineJson;
+    VELOX_USER_CHECK(
+        folly::readFile(FLAGS_baseline_json.c_str(), baselineJson),
+        "Cannot read baseline {}",
+        FLAGS_baseline_json);
+    auto regressions = FunctionSignatureBenchmark::compare(
+        results,
+        folly::parseJson(baselineJson),
+        {FLAGS_max_regression_pct, FLAGS_min_regression_ns});
+    for (const auto& regression : regressions) {
+      std::cout << "Regression: " << regression["key"].asString() << " ";
+      if (regression["nsPerRow"].isNull()) {
+        std::cout << "failed: " << regression["error"].asString();
+      } else {
+        std::cout << fmt::format(
+            "{:.2f} ns/row", regression["nsPerRow"].asDouble());
+      }
+      std::cout << fmt::format(
+                       ", baseline {:.2f} ns/row",
+                       regression["baselineNsPerRow"].asDouble())
+                << std::endl;
+    }
+    numRegressions = regressions.size();
+    results["regressions"] = std::move(regressions);
+  }
+  if (!FLAGS_output_json.empty()) {
+    VELOX_CHECK(
+        folly::writeFile(
+            folly::toPrettyJson(results), FLAGS_output_json.c_str()),
+        "Cannot write {}",
+        FLAGS_output_json);
+  }
+  return numRegressions == 0 ? 0 : 1;
+}
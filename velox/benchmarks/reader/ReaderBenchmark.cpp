@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <iostream>
+#include <random>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/compression/Compression.h"
+#include "velox/common/file/File.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/time/Timer.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/dwrf/RegisterDwrfReader.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/type/Filter.h"
+#include "velox/type/fbhive/HiveTypeParser.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+#ifdef VELOX_ENABLE_PARQUET
+#include "velox/dwio/parquet/RegisterParquetReader.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#endif
+
+DEFINE_string(
+    formats,
+    "dwrf,parquet",
+    "Comma separated file formats to generate and scan.");
+DEFINE_string(
+    types,
+    "bigint;double;string;array<bigint>;map<int,string>;"
+    "struct<a:bigint,b:string>",
+    "Semicolon separated Hive types of the scanned column.");
+DEFINE_string(
+    null_ratios,
+    "0,0.2",
+    "Comma separated fractions of null values in the scanned column.");
+DEFINE_string(
+    selectivities,
+    "1,0.5,0.05",
+    "Comma separated fractions of the rows that pass a filter on a separate "
+    "BIGINT column. 1 reads without a filter.");
+DEFINE_string(
+    encodings,
+    "dictionary,plain",
+    "Comma separated encodings to write the files with: dictionary lets the "
+    "writer use dictionary encoding, plain disables it.");
+DEFINE_int32(
+    distinct_values,
+    0,
+    "If positive, the scanned column takes this many distinct values, so "
+    "that dictionary encoding pays off. 0 leaves the values random.");
+DEFINE_string(compression, "none", "The compression of the files.");
+DEFINE_int64(rows, 2'000'000, "Rows per file.");
+DEFINE_int32(write_batch_rows, 10'000, "Rows per batch written.");
+DEFINE_int32(read_batch_rows, 10'000, "Rows per batch read.");
+DEFINE_int32(
+    iterations,
+    3,
+    "Times each file is scanned. The fastest scan is reported.");
+DEFINE_int32(seed, 1, "Seed of the generated data.");
+
+using namespace facebook::velox;
+
+namespace {
+
+constexpr int64_t kFilterRange = 1'000'000;
+
+std::vector<std::string> split(const std::string& list, char delimiter) {
+  std::vector<std::string> items;
+  folly::split(delimiter, list, items, true);
+  return items;
+}
+
+std::vector<double> splitDoubles(const std::string& list) {
+  std::vector<double> values;
+  for (const auto& item : split(list, ',')) {
+    values.push_back(folly::to<double>(item));
+  }
+  return values;
+}
+
+// Generates files of a column of a given type in each format and measures
+// the scan throughput of the selective readers. The files are kept in memory
+// so that the decoding, not the storage, is measured. Each file has a BIGINT
+// column 'c0' of random values in [0, kFilterRange) to filter on and the
+// scanned column 'c1'.
+class ReaderBenchmark {
+ public:
+  ReaderBenchmark()
+      : rootPool_(memory::memoryManager()->addRootPool("ReaderBenchmark")),
+        pool_(rootPool_->addLeafChild("ReaderBenchmark")) {
+    dwrf::registerDwrfReaderFactory();
+#ifdef VELOX_ENABLE_PARQUET
+    parquet::registerParquetReaderFactory();
+#endif
+  }
+
+  void run() {
+    std::cout << fmt::format(
+                     "{:<8} {:<28} {:>6} {:<10} {:>6} {:>10} {:>12} {:>10} "
+                     "{:>12}",
+                     "format",
+                     "type",
+                     "nulls",
+                     "encoding",
+                     "select",
+                     "file",
+                     "time",
+                     "MB/s",
+                     "Mrows/s")
+              << std::endl;
+    const auto compression =
+        common::stringToCompressionKind(FLAGS_compression);
+    for (const auto& typeName : split(FLAGS_types, ';')) {
+      const auto type = type::fbhive::HiveTypeParser().parse(typeName);
+      for (const auto nullRatio : splitDoubles(FLAGS_null_ratios)) {
+        const auto data = makeData(type, nullRatio);
+        for (const auto& formatName : split(FLAGS_formats, ',')) {
+          const auto format = dwio::common::toFileFormat(formatName);
+          for (const auto& encoding : split(FLAGS_encodings, ',')) {
+            VELOX_USER_CHECK(
+                encoding == "dictionary" || encoding == "plain",
+                "Unknown encoding {}",
+                encoding);
+            const auto file = std::make_shared<InMemoryReadFile>(
+                write(format, encoding == "dictionary", compression, data));
+            for (const auto selectivity :
+                 splitDoubles(FLAGS_selectivities)) {
+              const double micros =
+                  std::max<uint64_t>(read(format, file, selectivity), 1);
+              std::cout << fmt::format(
+                               "{:<8} {:<28} {:>6} {:<10} {:>6} {:>10} "
+                               "{:>12} {:>10.1f} {:>12.2f}",
+                               formatName,
+                               typeName,
+                               nullRatio,
+                               encoding,
+                               selectivity,
+                               succinctBytes(file->size()),
+                               succinctMicros(micros),
+                               file->size() / micros,
+                               FLAGS_rows / micros)
+                        << std::endl;
+            }
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  std::vector<RowVectorPtr> makeData(const TypePtr& type, double nullRatio) {
+    VectorFuzzer::Options options;
+    options.vectorSize = FLAGS_write_batch_rows;
+    options.nullRatio = nullRatio;
+    options.stringLength = 16;
+    options.stringVariableLength = true;
+    options.containerLength = 5;
+    options.timestampPrecision =
+        VectorFuzzer::Options::TimestampPrecision::kMicroSeconds;
+    VectorFuzzer fuzzer(options, pool_.get(), FLAGS_seed);
+    std::mt19937 rng(FLAGS_seed);
+    VectorPtr distinct;
+    if (FLAGS_distinct_values > 0) {
+      distinct = fuzzer.fuzzFlat(type, FLAGS_distinct_values);
+    }
+
+    rowType_ = ROW({"c0", "c1"}, {BIGINT(), type});
+    std::vector<RowVectorPtr> batches;
+    for (int64_t row = 0; row < FLAGS_rows; row += FLAGS_write_batch_rows) {
+      const vector_size_t size =
+          std::min<int64_t>(FLAGS_write_batch_rows, FLAGS_rows - row);
+      auto filterColumn =
+          BaseVector::create<FlatVector<int64_t>>(BIGINT(), size, pool_.get());
+      for (auto i = 0; i < size; ++i) {
+        filterColumn->set(i, folly::Random::rand64(kFilterRange, rng));
+      }
+      auto column = distinct == nullptr
+          ? fuzzer.fuzzFlat(type, size)
+          : fuzzer.fuzzDictionary(distinct, size);
+      batches.push_back(std::make_shared<RowVector>(
+          pool_.get(),
+          rowType_,
+          nullptr,
+          size,
+          std::vector<VectorPtr>{filterColumn, column}));
+    }
+    return batches;
+  }
+
+  std::string write(
+      dwio::common::FileFormat format,
+      bool dictionary,
+      common::CompressionKind compression,
+      const std::vector<RowVectorPtr>& data) {
+    auto sink = std::make_unique<dwio::common::MemorySink>(
+        1 << 20, dwio::common::FileSink::Options{.pool = pool_.get()});
+    auto* sinkPtr = sink.get();
+    std::unique_ptr<dwio::common::Writer> writer;
+    switch (format) {
+      case dwio::common::FileFormat::DWRF: {
+        auto config = std::make_shared<dwrf::Config>();
+        config->set(dwrf::Config::COMPRESSION, compression);
+        config->set(
+            dwrf::Config::INTEGER_DICTIONARY_ENCODING_ENABLED, dictionary);
+        config->set(
+            dwrf::Config::STRING_DICTIONARY_ENCODING_ENABLED, dictionary);
+        dwrf::WriterOptions options;
+        options.config = std::move(config);
+        options.schema = rowType_;
+        options.memoryPool = rootPool_.get();
+        writer = std::make_unique<dwrf::Writer>(std::move(sink), options);
+        break;
+      }
+#ifdef VELOX_ENABLE_PARQUET
+      case dwio::common::FileFormat::PARQUET: {
+        parquet::WriterOptions options;
+        options.enableDictionary = dictionary;
+        options.compressionKind = compression;
+        options.memoryPool = rootPool_.get();
+        writer = std::make_unique<parquet::Writer>(
+            std::move(sink), options, rowType_);
+        break;
+      }
+#endif
+      default:
+        VELOX_USER_FAIL(
+            "Generating {} files is not supported",
+            dwio::common::toString(format));
+    }
+    for (const auto& batch : data) {
+      writer->write(batch);
+    }
+    writer->close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  }
+
+  // Returns the time of the fastest of FLAGS_iterations scans of 'file'.
+  uint64_t read(
+      dwio::common::FileFormat format,
+      const std::shared_ptr<ReadFile>& file,
+      double selectivity) {
+    uint64_t minMicros = std::numeric_limits<uint64_t>::max();
+    for (auto i = 0; i < FLAGS_iterations; ++i) {
+      auto scanSpec = std::make_shared<common::ScanSpec>("root");
+      scanSpec->addAllChildFields(*rowType_);
+      if (selectivity < 1) {
+        scanSpec->childByName("c0")->setFilter(
+            std::make_shared<common::BigintRange>(
+                0, selectivity * kFilterRange - 1, false));
+      }
+      dwio::common::ReaderOptions readerOptions(pool_.get());
+      dwio::common::RowReaderOptions rowReaderOptions;
+      rowReaderOptions.setScanSpec(scanSpec);
+
+      uint64_t micros{0};
+      {
+        MicrosecondTimer timer(&micros);
+        auto reader = dwio::common::getReaderFactory(format)->createReader(
+            std::make_unique<dwio::common::BufferedInput>(file, *pool_),
+            readerOptions);
+        auto rowReader = reader->createRowReader(rowReaderOptions);
+        VectorPtr result = BaseVector::create(rowType_, 0, pool_.get());
+        while (rowReader->next(FLAGS_read_batch_rows, result) > 0) {
+          // Loads the columns that the reader returns lazily.
+          for (auto& child : result->asUnchecked<RowVector>()->children()) {
+            child->loadedVector();
+          }
+        }
+      }
+      minMicros = std::min(minMicros, micros);
+    }
+    return minMicros;
+  }
+
+  const std::shared_ptr<memory::MemoryPool> rootPool_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  RowTypePtr rowType_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize(memory::MemoryManager::Options{});
+  ReaderBenchmark().run();
+  return 0;
+}
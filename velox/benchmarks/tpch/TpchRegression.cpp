@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/benchmarks/tpch/TpchRegression.h"
+
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/json.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/exec/OperatorType.h"
+#include "velox/exec/PlanNodeStats.h"
+
+using namespace facebook::velox::exec::test;
+
+DEFINE_string(
+    datasets,
+    "",
+    "Comma separated datasets to run the queries on, each as "
+    "name=format:path, e.g. sf1=parquet:/data/tpch1,sf10=dwrf:/data/tpch10. "
+    "The format is dwrf or parquet. The path is laid out as for "
+    "velox_tpch_benchmark --data_path");
+DEFINE_string(
+    queries,
+    "",
+    "Comma separated TPC-H query numbers to run. Runs all 22 if empty");
+DEFINE_string(
+    cache_states,
+    "cold",
+    "Comma separated cache states to run the queries in: cold, ram or ssd. "
+    "ram needs --cache_gb and ssd also --ssd_cache_gb");
+DEFINE_int32(
+    measured_runs,
+    3,
+    "Number of measured runs of each query in each cache state. The run with "
+    "the median wall time is recorded");
+DEFINE_string(output_json, "", "File to write the results to");
+DEFINE_string(
+    baseline_json,
+    "",
+    "Results of an earlier run to compare against. The program exits with an "
+    "error if any query regresses");
+DEFINE_double(
+    max_regression_pct,
+    10,
+    "Percentage of the baseline wall time by which a query may get slower");
+DEFINE_double(
+    min_regression_ms,
+    100,
+    "A query or operator slower than the baseline by less than this many "
+    "milliseconds does not regress");
+DEFINE_double(
+    operator_regression_pct,
+    0,
+    "Percentage of the baseline CPU time by which an operator may get "
+    "slower. 0 disables the check of operators");
+
+namespace facebook::velox {
+namespace {
+
+int64_t toMs(uint64_t nanos) {
+  return nanos / 1'000'000;
+}
+
+// Returns the key of a run in the results.
+std::string runKey(const folly::dynamic& run) {
+  return fmt::format(
+      "{}/{}/q{}",
+      run["dataset"].asString(),
+      run["cacheState"].asString(),
+      run["query"].asInt());
+}
+
+std::string operatorKey(const folly::dynamic& op) {
+  return fmt::format(
+      "{}:{}", op["planNodeId"].asString(), op["operatorType"].asString());
+}
+
+bool regressed(int64_t value, int64_t baseline, double maxPct, double minMs) {
+  return value - baseline >= minMs && value > baseline * (1 + maxPct / 100);
+}
+
+std::vector<std::string> split(std::string_view list) {
+  std::vector<std::string> items;
+  folly::split(',', list, items, true);
+  return items;
+}
+
+} // namespace
+
+// static
+std::string TpchRegression::cacheStateName(CacheState state) {
+  switch (state) {
+    case CacheState::kCold:
+      return "cold";
+    case CacheState::kRam:
+      return "ram";
+    case CacheState::kSsd:
+      return "ssd";
+  }
+  VELOX_UNREACHABLE();
+}
+
+// static
+std::vector<TpchRegression::Dataset> TpchRegression::parseDatasets(
+    std::string_view datasets) {
+  std::vector<Dataset> result;
+  for (const auto& item : split(datasets)) {
+    const auto equals = item.find('=');
+    const auto colon = item.find(':', equals);
+    VELOX_USER_CHECK(
+        equals != std::string::npos && colon != std::string::npos,
+        "Dataset must be name=format:path: {}",
+        item);
+    const auto format = item.substr(equals + 1, colon - equals - 1);
+    VELOX_USER_CHECK(
+        format == "dwrf" || format == "parquet",
+        "Dataset format must be dwrf or parquet: {}",
+        item);
+    result.push_back(
+        {item.substr(0, equals),
+         dwio::common::toFileFormat(format),
+         item.substr(colon + 1)});
+  }
+  VELOX_USER_CHECK(!result.empty(), "No datasets given");
+  return result;
+}
+
+// static
+std::vector<TpchRegression::CacheState> TpchRegression::parseCacheStates(
+    std::string_view states) {
+  std::vector<CacheState> result;
+  for (const auto& name : split(states)) {
+    if (name == "cold") {
+      result.push_back(CacheState::kCold);
+    } else if (name == "ram") {
+      result.push_back(CacheState::kRam);
+    } else if (name == "ssd") {
+      result.push_back(CacheState::kSsd);
+    } else {
+      VELOX_USER_FAIL("Unknown cache state: {}", name);
+    }
+  }
+  return result;
+}
+
+// static
+folly::dynamic TpchRegression::compare(
+    const folly::dynamic& results,
+    const folly::dynamic& baseline,
+    const Thresholds& thresholds) {
+  std::unordered_map<std::string, const folly::dynamic*> baselineRuns;
+  for (const auto& run : baseline["runs"]) {
+    baselineRuns[runKey(run)] = &run;
+  }
+  folly::dynamic regressions = folly::dynamic::array;
+  auto addRegression = [&](const std::string& key,
+                           const std::string& metric,
+                           int64_t value,
+                           int64_t baselineValue) {
+    regressions.push_back(
+        folly::dynamic::object("run", key)("metric", metric)("ms", value)(
+            "baselineMs", baselineValue));
+  };
+  for (const auto& run : results["runs"]) {
+    const auto key = runKey(run);
+    auto it = baselineRuns.find(key);
+    if (it == baselineRuns.end()) {
+      continue;
+    }
+    const auto& base = *it->second;
+    const auto wallMs = run["wallMs"].asInt();
+    const auto baseWallMs = base["wallMs"].asInt();
+    if (regressed(
+            wallMs, baseWallMs, thresholds.queryPct, thresholds.minMs)) {
+      addRegression(key, "wallMs", wallMs, baseWallMs);
+    }
+    if (thresholds.operatorPct <= 0) {
+      continue;
+    }
+    std::unordered_map<std::string, int64_t> baseCpuMs;
+    for (const auto& op : base["operators"]) {
+      baseCpuMs[operatorKey(op)] = op["cpuMs"].asInt();
+    }
+    for (const auto& op : run["operators"]) {
+      const auto opKey = operatorKey(op);
+      auto baseIt = baseCpuMs.find(opKey);
+      if (baseIt == baseCpuMs.end()) {
+        continue;
+      }
+      const auto cpuMs = op["cpuMs"].asInt();
+      if (regressed(
+              cpuMs,
+              baseIt->second,
+              thresholds.operatorPct,
+              thresholds.minMs)) {
+        addRegression(key, opKey + " cpuMs", cpuMs, baseIt->second);
+      }
+    }
+  }
+  return regressions;
+}
+
+folly::dynamic TpchRegression::measure(const TpchPlan& plan) {
+  auto [cursor, results] = run(plan);
+  if (!cursor) {
+    return nullptr;
+  }
+  const auto stats = cursor->task()->taskStats();
+  const auto planStats = exec::toPlanStats(stats);
+  // Sorted for a stable order in the output.
+  std::map<std::pair<std::string, std::string>, const exec::PlanNodeStats*>
+      operatorStats;
+  for (const auto& [nodeId, nodeStats] : planStats) {
+    for (const auto& [operatorType, opStats] : nodeStats.operatorStats) {
+      operatorStats[{nodeId, operatorType}] = opStats.get();
+    }
+  }
+  folly::dynamic operators = folly::dynamic::array;
+  uint64_t cpuNanos = 0;
+  uint64_t rawInputBytes = 0;
+  for (const auto& [key, opStats] : operatorStats) {
+    cpuNanos += opStats->cpuWallTiming.cpuNanos;
+    if (key.second == exec::OperatorType::kTableScan) {
+      rawInputBytes += opStats->rawInputBytes;
+    }
+    operators.push_back(
+        folly::dynamic::object("planNodeId", key.first)(
+            "operatorType", key.second)(
+            "wallMs", toMs(opStats->cpuWallTiming.wallNanos))(
+            "cpuMs", toMs(opStats->cpuWallTiming.cpuNanos))(
+            "inputRows", static_cast<int64_t>(opStats->inputRows))(
+            "outputRows", static_cast<int64_t>(opStats->outputRows)));
+  }
+  return folly::dynamic::object(
+      "wallMs",
+      static_cast<int64_t>(
+          stats.executionEndTimeMs - stats.executionStartTimeMs))(
+      "cpuMs", toMs(cpuNanos))(
+      "rawInputBytes", static_cast<int64_t>(rawInputBytes))(
+      "operators", std::move(operators));
+}
+
+folly::dynamic TpchRegression::runQuery(
+    const TpchPlan& plan,
+    CacheState state,
+    int32_t queryId) {
+  if (state != CacheState::kCold) {
+    clearCaches(true, true);
+    if (measure(plan).isNull()) {
+      return nullptr;
+    }
+  }
+  if (state == CacheState::kSsd) {
+    // Writes all the data of the warmup run to SSD before the measured runs
+    // read it back.
+    auto* ssdCache = cache_->ssdCache();
+    ssdCache->waitForWriteToFinish();
+    cache_->saveToSsd(true);
+    ssdCache->waitForWriteToFinish();
+  }
+  std::vector<folly::dynamic> runs;
+  for (auto i = 0; i < FLAGS_measured_runs; ++i) {
+    clearCaches(state != CacheState::kRam, state == CacheState::kCold);
+    auto result = measure(plan);
+    if (result.isNull()) {
+      return nullptr;
+    }
+    runs.push_back(std::move(result));
+  }
+  std::sort(runs.begin(), runs.end(), [](const auto& left, const auto& right) {
+    return left["wallMs"].asInt() < right["wallMs"].asInt();
+  });
+  auto median = std::move(runs[runs.size() / 2]);
+  median["query"] = queryId;
+  median["cacheState"] = cacheStateName(state);
+  return median;
+}
+
+void TpchRegression::runMain(std::ostream& out, RunStats& /*runStats*/) {
+  VELOX_USER_CHECK_GT(FLAGS_measured_runs, 0);
+  const auto datasets = parseDatasets(FLAGS_datasets);
+  const auto cacheStates = parseCacheStates(FLAGS_cache_states);
+  for (auto state : cacheStates) {
+    VELOX_USER_CHECK(
+        state == CacheState::kCold || cache_ != nullptr,
+        "Cache state {} needs --cache_gb",
+        cacheStateName(state));
+    VELOX_USER_CHECK(
+        state != CacheState::kSsd || cache_->ssdCache() != nullptr,
+        "Cache state ssd needs --ssd_cache_gb");
+  }
+  std::vector<int32_t> queryIds;
+  for (const auto& id : split(FLAGS_queries)) {
+    queryIds.push_back(folly::to<int32_t>(id));
+  }
+  if (queryIds.empty()) {
+    for (auto id = 1; id <= 22; ++id) {
+      queryIds.push_back(id);
+    }
+  }
+
+  folly::dynamic runs = folly::dynamic::array;
+  folly::dynamic failures = folly::dynamic::array;
+  for (const auto& dataset : datasets) {
+    TpchQueryBuilder queryBuilder(dataset.format);
+    queryBuilder.initialize(dataset.path);
+    for (auto state : cacheStates) {
+      for (auto queryId : queryIds) {
+        const auto plan = queryBuilder.getQueryPlan(queryId);
+        auto result = runQuery(plan, state, queryId);
+        const auto name = fmt::format(
+            "{}/{}/q{}", dataset.name, cacheStateName(state), queryId);
+        if (result.isNull()) {
+          failures.push_back(name);
+          out << name << ": failed" << std::endl;
+          continue;
+        }
+        result["dataset"] = dataset.name;
+        out << name << ": " << result["wallMs"].asInt() << "ms wall "
+            << result["cpuMs"].asInt() << "ms cpu" << std::endl;
+        runs.push_back(std::move(result));
+      }
+    }
+  }
+
+  folly::dynamic results = folly::dynamic::object("runs", std::move(runs))(
+      "failures", std::move(failures));
+  numRegressions_ = results["failures"].size();
+  if (!FLAGS_baseline_json.empty()) {
+    std::string baselineJson;
+    VELOX_USER_CHECK(
+        folly::readFile(FLAGS_baseline_json.c_str(), baselineJson),
+        "Cannot read baseline {}",
+        FLAGS_baseline_json);
+    auto regressions = compare(
+        results,
+        folly::parseJson(baselineJson),
+        {FLAGS_max_regression_pct,
+         FLAGS_min_regression_ms,
+         FLAGS_operator_regression_pct});
+    for (const auto& regression : regressions) {
+      out << "Regression: " << regression["run"].asString() << " "
+          << regression["metric"].asString() << " "
+          << regression["ms"].asInt() << "ms, baseline "
+          << regression["baselineMs"].asInt() << "ms" << std::endl;
+    }
+    numRegressions_ += regressions.size();
+    results["regressions"] = std::move(regressions);
+  }
+  if (!FLAGS_output_json.empty()) {
+    VELOX_CHECK(
+        folly::writeFile(
+            folly::toPrettyJson(results), FLAGS_output_json.c_str()),
+        "Cannot write {}",
+        FLAGS_output_json);
+  }
+}
+
+} // namespace facebook::velox
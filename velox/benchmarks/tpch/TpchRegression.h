@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/dynamic.h>
+
+#include "velox/benchmarks/QueryBenchmarkBase.h"
+
+namespace facebook::velox {
+
+/// Runs a fixed matrix of TPC-H queries over datasets of different scale
+/// factors and file formats, each with a cold cache, a warm in-process cache
+/// and a warm SSD cache. Records the wall and CPU time of each query and of
+/// each of its operators as JSON, and compares them against the JSON recorded
+/// by an earlier run. A query or operator that got slower than its baseline
+/// by more than the thresholds is reported as a regression.
+class TpchRegression : public QueryBenchmarkBase {
+ public:
+  /// A scale factor of the TPC-H tables in a file format.
+  struct Dataset {
+    std::string name;
+    dwio::common::FileFormat format;
+    std::string path;
+  };
+
+  enum class CacheState {
+    /// The OS file system cache, the in-process cache and the SSD cache are
+    /// cleared before each run.
+    kCold,
+    /// The data is in the in-process cache from a warmup run.
+    kRam,
+    /// The data is in the SSD cache from a warmup run. The in-process cache
+    /// is cleared before each run.
+    kSsd,
+  };
+
+  static std::string cacheStateName(CacheState state);
+
+  /// Parses a comma separated list of name=format:path, e.g.
+  /// "sf1=parquet:/data/tpch1,sf10=dwrf:/data/tpch10".
+  static std::vector<Dataset> parseDatasets(std::string_view datasets);
+
+  /// Parses a comma separated list of cache state names.
+  static std::vector<CacheState> parseCacheStates(std::string_view states);
+
+  struct Thresholds {
+    /// A query regresses if its wall time exceeds the baseline by this many
+    /// percent...
+    double queryPct{10};
+    /// ...and by at least this many milliseconds.
+    double minMs{100};
+    /// An operator regresses if its CPU time exceeds the baseline by this
+    /// many percent and by at least 'minMs'. 0 disables the operator check.
+    double operatorPct{0};
+  };
+
+  /// Returns the regressions of 'results' against 'baseline', both as
+  /// produced by runMain(). Runs without a baseline are not compared.
+  static folly::dynamic compare(
+      const folly::dynamic& results,
+      const folly::dynamic& baseline,
+      const Thresholds& thresholds);
+
+  /// Runs the matrix given by the flags, writes the results and prints the
+  /// regressions against the baseline, if any, to 'out'.
+  void runMain(std::ostream& out, RunStats& runStats) override;
+
+  /// The number of failed queries plus the number of regressions found by
+  /// the last runMain().
+  int32_t numRegressions() const {
+    return numRegressions_;
+  }
+
+ private:
+  // Runs 'queryId' in 'state' and returns the run with the median wall time.
+  folly::dynamic runQuery(
+      const exec::test::TpchPlan& plan,
+      CacheState state,
+      int32_t queryId);
+
+  // Runs 'plan' once and returns its times and operator stats. Returns null
+  // if the query failed.
+  folly::dynamic measure(const exec::test::TpchPlan& plan);
+
+  int32_t numRegressions_{0};
+};
+
+} // namespace facebook::velox
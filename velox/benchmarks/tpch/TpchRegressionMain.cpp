@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/benchmarks/tpch/TpchRegression.h"
+
+using namespace facebook::velox;
+
+int main(int argc, char** argv) {
+  std::string kUsage(
+      "This program runs TPC-H queries over several datasets and cache states "
+      "and compares their times against a baseline. Run "
+      "'velox_tpch_regression -helpon=TpchRegression' for available "
+      "options.\n");
+  gflags::SetUsageMessage(kUsage);
+  folly::Init init{&argc, &argv, false};
+  TpchRegression regression;
+  regression.initialize();
+  RunStats ignore;
+  regression.runMain(std::cout, ignore);
+  regression.shutdown();
+  return regression.numRegressions() == 0 ? 0 : 1;
+}
@@ -223,6 +223,30 @@ void registerVeloxMetrics() {
   // Total number of bytes read from SSD.
   DEFINE_METRIC(kMetricSsdCacheReadBytes, facebook::velox::StatType::SUM);
 
+  // The latency distributions below are quantile stats rather than bucketed
+  // histograms: the tail of IO latencies is orders of magnitude above the
+  // median, which fixed width buckets either cut off or cannot resolve.
+
+  // Latency of the reads of SSD cache entries, one per coalesced read.
+  DEFINE_QUANTILE_STAT(
+      kMetricSsdCacheReadLatencyUs,
+      statTypes(StatType::AVG, StatType::COUNT),
+      percentiles(0.5, 0.9, 0.99, 1.0),
+      slidingWindowsSeconds(60));
+
+  // Time a query thread waits for a coalesced load of cache entries from SSD
+  // and from storage.
+  DEFINE_QUANTILE_STAT(
+      kMetricCoalescedSsdLoadLatencyUs,
+      statTypes(StatType::AVG, StatType::COUNT),
+      percentiles(0.5, 0.9, 0.99, 1.0),
+      slidingWindowsSeconds(60));
+  DEFINE_QUANTILE_STAT(
+      kMetricCoalescedStorageLoadLatencyUs,
+      statTypes(StatType::AVG, StatType::COUNT),
+      percentiles(0.5, 0.9, 0.99, 1.0),
+      slidingWindowsSeconds(60));
+
   // Total number of entries written to SSD.
   DEFINE_METRIC(kMetricSsdCacheWrittenEntries, facebook::velox::StatType::SUM);
 
@@ -683,5 +707,13 @@ void registerVeloxMetrics() {
   // The number of times that storage IOs get throttled in a storage cluster.
   DEFINE_METRIC(
       kMetricStorageGlobalThrottled, facebook::velox::StatType::COUNT);
+
+  // Latency of the synchronous reads of file readers from storage. The
+  // storage adapters may add their own, e.g. velox.s3_get_object_latency_us.
+  DEFINE_QUANTILE_STAT(
+      kMetricStorageReadLatencyUs,
+      statTypes(StatType::AVG, StatType::COUNT),
+      percentiles(0.5, 0.9, 0.99, 1.0),
+      slidingWindowsSeconds(60));
 }
 } // namespace facebook::velox
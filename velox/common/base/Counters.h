@@ -265,6 +265,15 @@ constexpr std::string_view kMetricSsdCacheReadEntries{
 constexpr std::string_view kMetricSsdCacheReadBytes{
     "velox.ssd_cache_read_bytes"};
 
+constexpr std::string_view kMetricSsdCacheReadLatencyUs{
+    "velox.ssd_cache_read_latency_us"};
+
+constexpr std::string_view kMetricCoalescedSsdLoadLatencyUs{
+    "velox.coalesced_ssd_load_latency_us"};
+
+constexpr std::string_view kMetricCoalescedStorageLoadLatencyUs{
+    "velox.coalesced_storage_load_latency_us"};
+
 constexpr std::string_view kMetricSsdCacheWrittenEntries{
     "velox.ssd_cache_written_entries"};
 
@@ -360,6 +369,9 @@ constexpr std::string_view kMetricStorageLocalThrottled{
 constexpr std::string_view kMetricStorageGlobalThrottled{
     "velox.storage_global_throttled_count"};
 
+constexpr std::string_view kMetricStorageReadLatencyUs{
+    "velox.storage_read_latency_us"};
+
 constexpr std::string_view kMetricStorageNetworkThrottled{
     "velox.storage_network_throttled_count"};
 
@@ -47,6 +47,14 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  /// Halves the counts and the time, so that what is added after this weighs
+  /// twice as much in timeToDropValue() as what was added before.
+  void decay() {
+    numIn_ /= 2;
+    numOut_ /= 2;
+    timeClocks_ /= 2;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -1910,7 +1910,9 @@ simdStrstr(const char* s, size_t n, const char* needle, size_t k) {
       return 0;
 
     case 1: {
-      const char* res = strchr(s, needle[0]);
+      // 's' need not be null terminated, e.g. the data of a StringView.
+      const char* res =
+          static_cast<const char*>(std::memchr(s, needle[0], n));
 
       return (res != nullptr) ? res - s : std::string::npos;
     }
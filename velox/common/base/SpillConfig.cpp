@@ -15,9 +15,60 @@
  */
 
 #include "velox/common/base/SpillConfig.h"
+
+#include <sstream>
+
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
 
 namespace facebook::velox::common {
+SpillTiers::SpillTiers(std::vector<Tier> tiers)
+    : tiers_(std::move(tiers)), usedBytes_(tiers_.size()) {
+  VELOX_CHECK(!tiers_.empty(), "SpillTiers must have at least one tier");
+  for (const auto& tier : tiers_) {
+    VELOX_CHECK(!tier.path.empty(), "Spill tier path can't be empty");
+  }
+}
+
+uint32_t SpillTiers::pickTier() const {
+  for (uint32_t i = 0; i + 1 < tiers_.size(); ++i) {
+    if (usedBytes(i) < tiers_[i].quotaBytes) {
+      return i;
+    }
+  }
+  return tiers_.size() - 1;
+}
+
+void SpillTiers::addBytes(uint32_t tier, uint64_t bytes) {
+  VELOX_CHECK_LT(tier, tiers_.size());
+  usedBytes_[tier].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void SpillTiers::releaseBytes(uint32_t tier, uint64_t bytes) {
+  VELOX_CHECK_LT(tier, tiers_.size());
+  const auto previous =
+      usedBytes_[tier].fetch_sub(bytes, std::memory_order_relaxed);
+  VELOX_CHECK_GE(previous, bytes, "Released more bytes than spilled");
+}
+
+uint64_t SpillTiers::usedBytes(uint32_t tier) const {
+  VELOX_CHECK_LT(tier, tiers_.size());
+  return usedBytes_[tier].load(std::memory_order_relaxed);
+}
+
+std::string SpillTiers::toString() const {
+  std::stringstream out;
+  for (uint32_t i = 0; i < tiers_.size(); ++i) {
+    out << (i == 0 ? "" : " ") << "[" << tiers_[i].path << " used "
+        << succinctBytes(usedBytes(i));
+    if (i + 1 < tiers_.size()) {
+      out << " quota " << succinctBytes(tiers_[i].quotaBytes);
+    }
+    out << "]";
+  }
+  return out.str();
+}
+
 SpillConfig::SpillConfig(
     GetSpillDirectoryPathCB _getSpillDirPathCb,
     UpdateAndCheckSpillLimitCB _updateAndCheckSpillLimitCb,
@@ -37,7 +88,10 @@ SpillConfig::SpillConfig(
     uint32_t _numMaxMergeFiles,
     std::optional<PrefixSortConfig> _prefixSortConfig,
     const std::string& _fileCreateConfig,
-    uint32_t _windowMinReadBatchRows)
+    uint32_t _windowMinReadBatchRows,
+    bool _columnarFormat,
+    bool _readAheadEnabled,
+    bool _dictionaryCompression)
     : getSpillDirPathCb(std::move(_getSpillDirPathCb)),
       updateAndCheckSpillLimitCb(std::move(_updateAndCheckSpillLimitCb)),
       fileNamePrefix(std::move(_fileNamePrefix)),
@@ -58,7 +112,10 @@ SpillConfig::SpillConfig(
       numMaxMergeFiles(_numMaxMergeFiles),
       prefixSortConfig(_prefixSortConfig),
       fileCreateConfig(_fileCreateConfig),
-      windowMinReadBatchRows(_windowMinReadBatchRows) {
+      windowMinReadBatchRows(_windowMinReadBatchRows),
+      columnarFormat(_columnarFormat),
+      readAheadEnabled(_readAheadEnabled),
+      dictionaryCompression(_dictionaryCompression) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
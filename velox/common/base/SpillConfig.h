@@ -18,6 +18,9 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/base/PrefixSortConfig.h"
@@ -52,11 +55,81 @@ using GetSpillDirectoryPathCB = std::function<std::string_view()>;
 /// bytes exceed the set limit.
 using UpdateAndCheckSpillLimitCB = std::function<void(uint64_t)>;
 
+/// Node wide spill storage tiers, e.g. local NVMe followed by a remote object
+/// store. A new spill file goes to the first tier whose spilled bytes are
+/// below its quota. A file may exceed the quota of its tier by up to its size.
+/// The last tier has no quota. Thread safe.
+class SpillTiers {
+ public:
+  struct Tier {
+    /// The root directory of the tier, e.g. /mnt/nvme/spill or
+    /// s3://bucket/spill.
+    std::string path;
+    /// The max bytes of spill files on the tier. Ignored for the last tier.
+    uint64_t quotaBytes{0};
+    /// Options passed to velox::FileSystem to create the spill files on the
+    /// tier, e.g. the part size of multipart uploads to an object store. If
+    /// empty, the operator's spill file create config is used.
+    std::string fileCreateConfig;
+  };
+
+  explicit SpillTiers(std::vector<Tier> tiers);
+
+  uint32_t numTiers() const {
+    return tiers_.size();
+  }
+
+  const Tier& tier(uint32_t index) const {
+    return tiers_[index];
+  }
+
+  /// Returns the tier for a new spill file.
+  uint32_t pickTier() const;
+
+  /// Adds 'bytes' written to spill files on 'tier'.
+  void addBytes(uint32_t tier, uint64_t bytes);
+
+  /// Subtracts 'bytes' of spill files on 'tier' that have been removed.
+  void releaseBytes(uint32_t tier, uint64_t bytes);
+
+  /// Returns the bytes of the spill files on 'tier'.
+  uint64_t usedBytes(uint32_t tier) const;
+
+  std::string toString() const;
+
+ private:
+  const std::vector<Tier> tiers_;
+  std::vector<std::atomic_uint64_t> usedBytes_;
+};
+
+/// The placement of a new spill file on a SpillTiers tier.
+struct SpillFileTarget {
+  uint32_t tier{0};
+  /// The directory of the file on the tier.
+  std::string directory;
+  /// Options to create the file with. If empty, the spill file create config
+  /// of the operator is used.
+  std::string fileCreateConfig;
+};
+
+/// The callback that returns the placement of a new spill file. It creates
+/// the directory of the file if needed.
+using GetSpillFileTargetCB = std::function<SpillFileTarget()>;
+
+/// The callback used to update the bytes written to spill files on a tier.
+using UpdateSpillTierBytesCB =
+    std::function<void(uint32_t tier, uint64_t bytes)>;
+
 /// Specifies the options for spill to disk.
 struct SpillDiskOptions {
   std::string spillDirPath;
   bool spillDirCreated{true};
   std::function<std::string()> spillDirCreateCb{nullptr};
+  /// If set, the spill files of the task go to the directory 'spillTierDirName'
+  /// under the tier that 'spillTiers' picks for each file, instead of
+  /// 'spillDirPath'.
+  std::shared_ptr<SpillTiers> spillTiers{nullptr};
+  std::string spillTierDirName;
 };
 
 /// Specifies the config for spilling.
@@ -81,7 +154,10 @@ struct SpillConfig {
       uint32_t numMaxMergeFiles,
       std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
       const std::string& _fileCreateConfig = {},
-      uint32_t _windowMinReadBatchRows = 1'000);
+      uint32_t _windowMinReadBatchRows = 1'000,
+      bool _columnarFormat = false,
+      bool _readAheadEnabled = false,
+      bool _dictionaryCompression = false);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -98,6 +174,12 @@ struct SpillConfig {
     return prefixSortConfig.has_value();
   }
 
+  /// Returns the executor to read ahead spill files on, nullptr if read-ahead
+  /// is disabled or there is no spill executor.
+  folly::Executor* readAheadExecutor() const {
+    return readAheadEnabled ? executor : nullptr;
+  }
+
   /// A callback function that returns the spill directory path. Implementations
   /// can use it to ensure the path exists before returning.
   GetSpillDirectoryPathCB getSpillDirPathCb;
@@ -110,6 +192,14 @@ struct SpillConfig {
   /// Prefix for spill files.
   std::string fileNamePrefix;
 
+  /// If set, returns the tier and directory of each new spill file and
+  /// 'getSpillDirPathCb' is not used.
+  GetSpillFileTargetCB getSpillFileTargetCb;
+
+  /// Invoked with the bytes written to spill files on each tier if
+  /// 'getSpillFileTargetCb' is set.
+  UpdateSpillTierBytesCB updateSpillTierBytesCb;
+
   /// The max spill file size. If it is zero, there is no limit on the spill
   /// file size.
   uint64_t maxFileSize;
@@ -124,6 +214,7 @@ struct SpillConfig {
   uint64_t readBufferSize;
 
   /// Executor for spilling. If nullptr spilling writes on the Driver's thread.
+  /// Also used to read ahead spill files if 'readAheadEnabled' is true.
   folly::Executor* executor; // Not owned.
 
   /// The minimal spillable memory reservation in percentage of the current
@@ -177,5 +268,18 @@ struct SpillConfig {
 
   /// The minimum number of rows to read when processing spilled window data.
   uint32_t windowMinReadBatchRows;
+
+  /// If true, spill files store each column of a spilled batch as a separate
+  /// page which preserves the vector encodings and carries a checksum.
+  bool columnarFormat{false};
+
+  /// If true and 'executor' is set, the readers of spill files read the next
+  /// 'readBufferSize' bytes of each file on 'executor' while the current
+  /// buffer is consumed. This doubles the read buffer memory.
+  bool readAheadEnabled{false};
+
+  /// If true, the pages of each spilled partition are compressed with a ZSTD
+  /// dictionary trained from its first pages instead of 'compressionKind'.
+  bool dictionaryCompression{false};
 };
 } // namespace facebook::velox::common
@@ -558,6 +558,12 @@ TEST_F(SimdUtilTest, basicSimdStrStr) {
   checkOne(haystack3, needle12);
   // Find the empty string
   checkOne(haystack1, needle13);
+
+  // Only the first 'n' bytes are searched.
+  std::string haystack5("xxxxbxx");
+  EXPECT_EQ(simd::simdStrstr(haystack5.data(), 4, "b", 1), std::string::npos);
+  EXPECT_EQ(simd::simdStrstr(haystack5.data(), 5, "b", 1), 4);
+  EXPECT_EQ(simd::simdStrstr(haystack5.data(), 4, "bx", 2), std::string::npos);
   // Can't find in an empty haystack
   checkOne(haystack4, needle1);
 
@@ -197,6 +197,36 @@ TEST_P(SpillConfigTest, spillableReservationPercentages) {
   }
 }
 
+TEST(SpillTiersTest, pickTier) {
+  SpillTiers tiers({
+      {.path = "/local", .quotaBytes = 100},
+      {.path = "s3://bucket/spill", .quotaBytes = 0, .fileCreateConfig = "x"},
+  });
+  ASSERT_EQ(tiers.numTiers(), 2);
+  ASSERT_EQ(tiers.tier(1).fileCreateConfig, "x");
+  ASSERT_EQ(tiers.pickTier(), 0);
+  tiers.addBytes(0, 99);
+  ASSERT_EQ(tiers.pickTier(), 0);
+  tiers.addBytes(0, 10);
+  ASSERT_EQ(tiers.usedBytes(0), 109);
+  ASSERT_EQ(tiers.pickTier(), 1);
+  // The last tier has no quota.
+  tiers.addBytes(1, 1'000);
+  ASSERT_EQ(tiers.pickTier(), 1);
+  ASSERT_EQ(
+      tiers.toString(),
+      "[/local used 109B quota 100B] [s3://bucket/spill used 1000B]");
+
+  tiers.releaseBytes(0, 50);
+  ASSERT_EQ(tiers.pickTier(), 0);
+  VELOX_ASSERT_THROW(
+      tiers.releaseBytes(0, 100), "Released more bytes than spilled");
+
+  VELOX_ASSERT_THROW(SpillTiers({}), "SpillTiers must have at least one tier");
+  VELOX_ASSERT_THROW(
+      SpillTiers({{.path = ""}}), "Spill tier path can't be empty");
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     SpillConfigTest,
     SpillConfigTest,
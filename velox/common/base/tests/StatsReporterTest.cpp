@@ -264,6 +264,7 @@ class TestMemoryPool : public memory::MemoryPool {
   }
 
   void free(void* /* unused */, int64_t /* unused */) override {}
+  void flushAllocationCache() override {}
 
   void allocateNonContiguous(
       memory::MachinePageCount /* unused */,
@@ -718,6 +719,20 @@ TEST_F(StatsReporterTest, quantileStatMacros) {
   EXPECT_EQ(151, reporter_->counterMap["macro_test_stat"]);
 }
 
+TEST_F(StatsReporterTest, ioLatencyQuantileStats) {
+  registerVeloxMetrics();
+  const QuantileConfig expectedConfig = {
+      {StatType::AVG, StatType::COUNT}, {0.5, 0.9, 0.99, 1.0}, {60}};
+  for (const auto key :
+       {kMetricSsdCacheReadLatencyUs,
+        kMetricCoalescedSsdLoadLatencyUs,
+        kMetricCoalescedStorageLoadLatencyUs,
+        kMetricStorageReadLatencyUs}) {
+    SCOPED_TRACE(key);
+    verifyQuantileRegistration(std::string(key), expectedConfig);
+  }
+}
+
 TEST_F(StatsReporterTest, dynamicQuantileRegistrationWithValues) {
   // Test registration and value addition for different key types
   const char* charPattern = "test_metric_char.{}.{}";
@@ -187,6 +187,7 @@ std::optional<CachePin> CacheShard::lookupLocked(
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
   ++eventCounter_;
+  policy_->recordAccess(std::hash<RawFileCacheKey>()(key));
   auto it = entryMap_.find(key);
   if (it == entryMap_.end()) {
     return std::nullopt;
@@ -213,6 +214,7 @@ std::optional<CachePin> CacheShard::lookupLocked(
     return std::nullopt;
   }
   foundEntry->touch();
+  foundEntry->probation_ = false;
   if (foundEntry->isPrefetch()) {
     foundEntry->isFirstUse_ = true;
     foundEntry->setPrefetch(false);
@@ -242,6 +244,11 @@ CachePin CacheShard::findOrCreate(
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
     newEntry->promise_ = nullptr;
+    newEntry->readPct_ = 100;
+    newEntry->probation_ = !policy_->admit(std::hash<RawFileCacheKey>()(key));
+    if (newEntry->probation_) {
+      ++numAdmissionRejects_;
+    }
     entryToInit = newEntry.get();
     entryMap_[key] = newEntry.get();
     if (emptySlots_.empty()) {
@@ -465,7 +472,7 @@ uint64_t CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           (score = scoreLocked(*candidate, now)) >= evictionThreshold_)) {
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
@@ -473,6 +480,16 @@ uint64_t CacheShard::evict(
         if (candidate->ssdSaveable()) {
           ++numSavableEvict_;
         }
+        if (auto* attribution = cache_->attribution();
+            attribution != nullptr && candidate->key_.fileNum.hasValue()) {
+          attribution->record(
+              CacheAttribution::Event::kEviction,
+              candidate->key_.fileNum.id(),
+              candidate->key_.offset,
+              candidate->groupId_,
+              candidate->trackingId_,
+              candidate->size_);
+        }
         largeEvicted += candidate->data_.byteSize();
         if (pagesToAcquire > 0) {
           const auto candidatePages = candidate->data().numPages();
@@ -538,7 +555,27 @@ void CacheShard::freeAllocations(std::vector<memory::Allocation>& allocations) {
   allocations.clear();
 }
 
+int32_t CacheShard::scoreLocked(
+    const AsyncDataCacheEntry& entry,
+    AccessTime now) const {
+  const auto& accessStats = entry.accessStats_;
+  if (!accessStats.lastUse) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  return policy_->score(
+      EvictionCandidate{
+          .hash = std::hash<RawFileCacheKey>()(
+              RawFileCacheKey{entry.key_.fileNum.id(), entry.key_.offset}),
+          .age = now - accessStats.lastUse,
+          .numUses = accessStats.numUses,
+          .size = entry.size_,
+          .readPct = entry.readPct_,
+          // A prefetched entry is not hit before it is first used.
+          .probation = entry.probation_ && !entry.isPrefetch()});
+}
+
 void CacheShard::calibrateThresholdLocked() {
+  policy_->updateCapacity(entries_.size());
   auto numSamples = std::min<int32_t>(kMaxEvictionSamples, entries_.size());
   auto now = accessTime();
   auto entryIndex = (clockHand_ % entries_.size());
@@ -547,7 +584,7 @@ void CacheShard::calibrateThresholdLocked() {
   evictionThreshold_ = percentile<int32_t>(
       [&]() -> int32_t {
         AsyncDataCacheEntry* element = iter->get();
-        int32_t score = element ? element->score(now) : 0;
+        int32_t score = element ? scoreLocked(*element, now) : 0;
         if (entryIndex + step >= entries_.size()) {
           entryIndex = (entryIndex + step) % entries_.size();
           iter = entries_.begin() + entryIndex;
@@ -616,6 +653,7 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numAgedOut += numAgedOut_;
   stats.numStales += numStales_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numAdmissionRejects += numAdmissionRejects_;
   stats.allocClocks += allocClocks_;
 }
 
@@ -706,6 +744,8 @@ CacheStats CacheStats::operator-(const CacheStats& other) const {
   result.numStales = numStales - other.numStales;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numAdmissionRejects = numAdmissionRejects - other.numAdmissionRejects;
+  result.evictionPolicy = evictionPolicy;
   if (ssdStats != nullptr) {
     if (other.ssdStats != nullptr) {
       result.ssdStats =
@@ -731,6 +771,10 @@ AsyncDataCache::AsyncDataCache(
       shardMask_(numShards_ - 1),
       allocator_(allocator),
       ssdCache_(std::move(ssdCache)),
+      attribution_(
+          opts_.attributionSampleRate > 0
+              ? std::make_unique<CacheAttribution>(opts_.attributionSampleRate)
+              : nullptr),
       cachedPages_(0) {
   VELOX_CHECK_GT(numShards_, 0, "numShards must be positive");
   VELOX_CHECK_EQ(
@@ -739,7 +783,9 @@ AsyncDataCache::AsyncDataCache(
       "numShards must be a power of 2, got {}",
       numShards_);
   for (auto i = 0; i < numShards_; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
+    shards_.push_back(
+        std::make_unique<CacheShard>(
+            this, opts_.maxWriteRatio, opts_.evictionPolicy));
   }
 }
 
@@ -1015,6 +1061,18 @@ void AsyncDataCache::saveToSsd(bool saveAll) {
   for (auto& shard : shards_) {
     shard->appendSsdSaveable(saveAll, pins);
   }
+  if (attribution_ != nullptr) {
+    for (const auto& pin : pins) {
+      const auto* entry = pin.entry();
+      attribution_->record(
+          CacheAttribution::Event::kSsdWrite,
+          entry->key().fileNum.id(),
+          entry->offset(),
+          entry->groupId(),
+          entry->trackingId(),
+          entry->size());
+    }
+  }
   ssdCache_->write(std::move(pins));
 }
 
@@ -1041,6 +1099,7 @@ bool AsyncDataCache::removeFileEntries(
 
 CacheStats AsyncDataCache::refreshStats() const {
   CacheStats stats;
+  stats.evictionPolicy = opts_.evictionPolicy;
   for (auto& shard : shards_) {
     shard->updateStats(stats);
   }
@@ -1097,6 +1156,11 @@ std::string CacheStats::toString() const {
       << " eviction checks: " << numEvictChecks << " aged out: " << numAgedOut
       << " stales: " << numStales
       << "\n"
+      // Cache admission and eviction policy stats.
+      << "Eviction policy: " << CacheEvictionPolicy::kindString(evictionPolicy)
+      << " hit ratio: " << fmt::format("{:.2f}%", hitRatio() * 100)
+      << " admission rejects: " << numAdmissionRejects
+      << "\n"
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <deque>
 
 #include <fmt/format.h>
@@ -28,6 +29,8 @@
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CacheAttribution.h"
+#include "velox/common/caching/CacheEvictionPolicy.h"
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
@@ -261,10 +264,35 @@ class AsyncDataCacheEntry {
     trackingId_ = id;
   }
 
+  TrackingId trackingId() const {
+    return trackingId_;
+  }
+
   void setGroupId(uint64_t groupId) {
     groupId_ = groupId;
   }
 
+  uint64_t groupId() const {
+    return groupId_;
+  }
+
+  /// Sets the percentage of the referenced bytes of the column of 'this' that
+  /// are actually read, as tracked by ScanTracker. Used by eviction policies
+  /// that favor frequently read columns.
+  void setReadPct(int32_t readPct) {
+    readPct_ = std::clamp<int32_t>(readPct, 0, 100);
+  }
+
+  int32_t readPct() const {
+    return readPct_;
+  }
+
+  /// True if the admission filter of the eviction policy rejected 'this' and
+  /// it has not been hit since.
+  bool isProbation() const {
+    return probation_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -331,6 +359,13 @@ class AsyncDataCacheEntry {
   // Tracking id. Used for deciding if this should be written to SSD.
   TrackingId trackingId_;
 
+  // Read percentage of the column of 'this'. See setReadPct().
+  tsan_atomic<int32_t> readPct_{100};
+
+  // True if not admitted by the eviction policy and not hit since. Set and
+  // cleared inside the shard mutex.
+  bool probation_{false};
+
   // SSD file from which this was loaded or nullptr if not backed by
   // SsdFile. Used to avoid re-adding items that already come from
   // SSD. The exact file and offset are needed to include uses in RAM
@@ -559,12 +594,24 @@ struct CacheStats {
   /// Sum of scores of evicted entries. This serves to infer an average
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  /// Number of new entries that the admission filter of the eviction policy
+  /// put on probation.
+  int64_t numAdmissionRejects{0};
+
+  /// The eviction policy of the cache.
+  CacheEvictionPolicy::Kind evictionPolicy{CacheEvictionPolicy::Kind::kLru};
 
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
   CacheStats operator-(const CacheStats& other) const;
 
+  /// Returns the fraction of lookups that hit, 0 if there were no lookups.
+  double hitRatio() const {
+    const auto numLookups = numHit + numNew;
+    return numLookups == 0 ? 0 : static_cast<double>(numHit) / numLookups;
+  }
+
   std::string toString() const;
 };
 
@@ -576,8 +623,14 @@ class CacheShard {
  public:
   static constexpr uint64_t kMinBytesToEvict = 8UL << 20; // 8MB
 
-  CacheShard(AsyncDataCache* cache, double maxWriteRatio)
-      : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
+  CacheShard(
+      AsyncDataCache* cache,
+      double maxWriteRatio,
+      CacheEvictionPolicy::Kind evictionPolicy =
+          CacheEvictionPolicy::Kind::kLru)
+      : cache_(cache),
+        maxWriteRatio_(maxWriteRatio),
+        policy_(CacheEvictionPolicy::create(evictionPolicy)) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -665,6 +718,9 @@ class CacheShard {
 
   void calibrateThresholdLocked();
 
+  // Returns the retention score of 'entry' according to 'policy_'.
+  int32_t scoreLocked(const AsyncDataCacheEntry& entry, AccessTime now) const;
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -691,6 +747,8 @@ class CacheShard {
 
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
+  // Decides admission and retention of entries. Accessed under 'mutex_'.
+  const std::unique_ptr<CacheEvictionPolicy> policy_;
 
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
@@ -730,6 +788,8 @@ class CacheShard {
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Cumulative count of new entries put on probation by 'policy_'.
+  uint64_t numAdmissionRejects_{0};
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -747,12 +807,15 @@ class AsyncDataCache : public memory::Cache {
         double _ssdSavableRatio = 0.125,
         int32_t _minSsdSavableBytes = 1 << 24,
         int32_t _numShards = kDefaultNumShards,
-        uint64_t _ssdFlushThresholdBytes = 0)
+        uint64_t _ssdFlushThresholdBytes = 0,
+        CacheEvictionPolicy::Kind _evictionPolicy =
+            CacheEvictionPolicy::Kind::kLru)
         : maxWriteRatio(_maxWriteRatio),
           ssdSavableRatio(_ssdSavableRatio),
           minSsdSavableBytes(_minSsdSavableBytes),
           numShards(_numShards),
-          ssdFlushThresholdBytes(_ssdFlushThresholdBytes) {}
+          ssdFlushThresholdBytes(_ssdFlushThresholdBytes),
+          evictionPolicy(_evictionPolicy) {}
 
     /// The max ratio of the number of in-memory cache entries being written to
     /// SSD cache over the total number of cache entries. This is to control SSD
@@ -781,6 +844,14 @@ class AsyncDataCache : public memory::Cache {
     /// accumulated SSD-savable bytes exceed this value, a flush to SSD is
     /// triggered. Set to 0 to disable this threshold (default).
     uint64_t ssdFlushThresholdBytes;
+
+    /// The policy for admitting and evicting entries in each shard.
+    CacheEvictionPolicy::Kind evictionPolicy;
+
+    /// If non-0, one in this many entries has its hits, misses, evictions
+    /// and SSD writes attributed to its file group and column. See
+    /// CacheAttribution.
+    int32_t attributionSampleRate{0};
   };
 
   AsyncDataCache(
@@ -887,6 +958,12 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Returns the attribution of the cache traffic to file groups and columns,
+  /// or nullptr if Options::attributionSampleRate is 0.
+  CacheAttribution* attribution() const {
+    return attribution_.get();
+  }
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -966,6 +1043,7 @@ class AsyncDataCache : public memory::Cache {
   const int32_t shardMask_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  const std::unique_ptr<CacheAttribution> attribution_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
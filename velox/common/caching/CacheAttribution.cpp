@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheAttribution.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <fmt/format.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+
+double CacheAttribution::Stats::hitRate() const {
+  const auto total = ramHitBytes + ssdHitBytes + missBytes;
+  return total == 0 ? 0 : (ramHitBytes + ssdHitBytes) / double(total);
+}
+
+double CacheAttribution::Stats::ssdWriteAmplification() const {
+  if (ssdHitBytes == 0) {
+    return ssdWrittenBytes == 0 ? 0 : std::numeric_limits<double>::infinity();
+  }
+  return ssdWrittenBytes / double(ssdHitBytes);
+}
+
+double CacheAttribution::Stats::meanReuseDistanceBytes() const {
+  return numReuses == 0 ? 0 : sumReuseDistanceBytes / double(numReuses);
+}
+
+CacheAttribution::Stats& CacheAttribution::Stats::operator+=(
+    const Stats& other) {
+  ramHitBytes += other.ramHitBytes;
+  ssdHitBytes += other.ssdHitBytes;
+  missBytes += other.missBytes;
+  evictedBytes += other.evictedBytes;
+  ssdWrittenBytes += other.ssdWrittenBytes;
+  sumReuseDistanceBytes += other.sumReuseDistanceBytes;
+  numReuses += other.numReuses;
+  return *this;
+}
+
+CacheAttribution::CacheAttribution(
+    int32_t sampleRate,
+    int32_t maxTrackedEntries)
+    : sampleRate_(sampleRate), maxTrackedEntries_(maxTrackedEntries) {
+  VELOX_CHECK_GE(sampleRate_, 0);
+  VELOX_CHECK_GT(maxTrackedEntries_, 0);
+}
+
+bool CacheAttribution::isSampled(uint64_t fileId, uint64_t offset) const {
+  if (sampleRate_ == 0) {
+    return false;
+  }
+  return EntryKeyHasher()({fileId, offset}) % sampleRate_ == 0;
+}
+
+void CacheAttribution::record(
+    Event event,
+    uint64_t fileId,
+    uint64_t offset,
+    uint64_t groupId,
+    TrackingId trackingId,
+    uint64_t bytes) {
+  if (!isSampled(fileId, offset)) {
+    return;
+  }
+  const uint64_t scaledBytes = bytes * sampleRate_;
+  // The high bits of a TrackingId are the node id of the column, the low 5
+  // bits the kind of the stream.
+  const int32_t column = trackingId.empty() ? -1 : trackingId.id() >> 5;
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& stats = stats_[GroupColumn{groupId, column}];
+  switch (event) {
+    case Event::kRamHit:
+    case Event::kSsdHit:
+    case Event::kMiss: {
+      if (event == Event::kRamHit) {
+        stats.ramHitBytes += scaledBytes;
+      } else if (event == Event::kSsdHit) {
+        stats.ssdHitBytes += scaledBytes;
+      } else {
+        stats.missBytes += scaledBytes;
+      }
+      const EntryKey key{fileId, offset};
+      auto it = lastRead_.find(key);
+      if (it != lastRead_.end()) {
+        stats.sumReuseDistanceBytes += readClock_ - it->second;
+        ++stats.numReuses;
+      } else {
+        if (lastRead_.size() >= static_cast<size_t>(maxTrackedEntries_)) {
+          // Forgetting the entries undercounts the reuses but keeps the
+          // distances of those counted exact.
+          lastRead_.clear();
+        }
+        it = lastRead_.emplace(key, 0).first;
+      }
+      readClock_ += scaledBytes;
+      it->second = readClock_;
+      break;
+    }
+    case Event::kEviction:
+      stats.evictedBytes += scaledBytes;
+      break;
+    case Event::kSsdWrite:
+      stats.ssdWrittenBytes += scaledBytes;
+      break;
+  }
+}
+
+std::vector<CacheAttribution::GroupColumnStats> CacheAttribution::stats()
+    const {
+  std::vector<GroupColumnStats> result;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    result.reserve(stats_.size());
+    for (const auto& [key, stats] : stats_) {
+      result.push_back({key.groupId, "", key.column, stats});
+    }
+  }
+  for (auto& entry : result) {
+    entry.groupName = fileIds().string(entry.groupId);
+  }
+  return result;
+}
+
+std::vector<CacheAttribution::GroupColumnStats>
+CacheAttribution::groupStats() const {
+  folly::F14FastMap<uint64_t, GroupColumnStats> groups;
+  for (auto& entry : stats()) {
+    auto [it, inserted] = groups.emplace(entry.groupId, entry);
+    if (inserted) {
+      it->second.column = -1;
+    } else {
+      it->second.stats += entry.stats;
+    }
+  }
+  std::vector<GroupColumnStats> result;
+  result.reserve(groups.size());
+  for (auto& [_, entry] : groups) {
+    result.push_back(std::move(entry));
+  }
+  return result;
+}
+
+std::string CacheAttribution::toString(int32_t maxGroups) const {
+  auto groups = groupStats();
+  const auto readBytes = [](const Stats& stats) {
+    return stats.ramHitBytes + stats.ssdHitBytes + stats.missBytes;
+  };
+  std::sort(groups.begin(), groups.end(), [&](const auto& l, const auto& r) {
+    return readBytes(l.stats) > readBytes(r.stats);
+  });
+  std::string out = fmt::format(
+      "Cache attribution, 1 in {} entries sampled, {} file groups:\n",
+      sampleRate_,
+      groups.size());
+  for (auto i = 0; i < groups.size() && i < maxGroups; ++i) {
+    const auto& stats = groups[i].stats;
+    out += fmt::format(
+        "{}: read {} hit rate {:.1f}% ram {} ssd {} miss {} evicted {} "
+        "ssd written {} ssd write amplification {:.2f} "
+        "reuse distance {}\n",
+        groups[i].groupName.empty() ? std::to_string(groups[i].groupId)
+                                    : groups[i].groupName,
+        succinctBytes(readBytes(stats)),
+        stats.hitRate() * 100,
+        succinctBytes(stats.ramHitBytes),
+        succinctBytes(stats.ssdHitBytes),
+        succinctBytes(stats.missBytes),
+        succinctBytes(stats.evictedBytes),
+        succinctBytes(stats.ssdWrittenBytes),
+        stats.ssdWriteAmplification(),
+        succinctBytes(stats.meanReuseDistanceBytes()));
+  }
+  return out;
+}
+
+void CacheAttribution::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  stats_.clear();
+  lastRead_.clear();
+  readClock_ = 0;
+}
+
+} // namespace facebook::velox::cache
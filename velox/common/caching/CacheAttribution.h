@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/caching/ScanTracker.h"
+
+namespace facebook::velox::cache {
+
+/// Sampled attribution of the traffic of AsyncDataCache and SsdCache to file
+/// groups, e.g. the partitions of a table, and to the columns read from them,
+/// so that cache tiers can be sized and the groups that pollute the cache
+/// excluded. One in 'sampleRate' cache entries is sampled by a hash of its
+/// file and offset. All the events of a sampled entry are recorded, which
+/// makes the reuse distance and write amplification of an entry consistent,
+/// and the byte counts are scaled by 'sampleRate'. Thread safe.
+class CacheAttribution {
+ public:
+  enum class Event {
+    /// A read found the entry in AsyncDataCache.
+    kRamHit,
+    /// A read found the entry in SsdCache.
+    kSsdHit,
+    /// A read had to go to storage.
+    kMiss,
+    /// The entry was evicted from AsyncDataCache.
+    kEviction,
+    /// The entry was written to SsdCache.
+    kSsdWrite,
+  };
+
+  /// The estimated traffic of a file group and column.
+  struct Stats {
+    uint64_t ramHitBytes{0};
+    uint64_t ssdHitBytes{0};
+    uint64_t missBytes{0};
+    uint64_t evictedBytes{0};
+    uint64_t ssdWrittenBytes{0};
+    /// The sum over the reads of sampled entries read before of the bytes
+    /// read from the cache since their previous read, and the number of these
+    /// reads.
+    uint64_t sumReuseDistanceBytes{0};
+    uint64_t numReuses{0};
+
+    /// The fraction of the bytes read from AsyncDataCache or SsdCache.
+    double hitRate() const;
+
+    /// The bytes written to SsdCache per byte later read from it. Infinite
+    /// if the written entries were never read.
+    double ssdWriteAmplification() const;
+
+    /// The mean bytes read from the cache between two reads of an entry, an
+    /// estimate of the cache size that would hit the rereads.
+    double meanReuseDistanceBytes() const;
+
+    Stats& operator+=(const Stats& other);
+  };
+
+  struct GroupColumnStats {
+    uint64_t groupId;
+    /// The name of the group, e.g. the directory of its files. Empty if the
+    /// group id is no longer in use.
+    std::string groupName;
+    /// The node id of the column in the file schema, -1 for accesses not of a
+    /// column, e.g. of a file footer.
+    int32_t column;
+    Stats stats;
+  };
+
+  /// Sampling is disabled if 'sampleRate' is 0. 'maxTrackedEntries' bounds
+  /// the sampled entries remembered for the reuse distance estimate.
+  explicit CacheAttribution(
+      int32_t sampleRate,
+      int32_t maxTrackedEntries = 1 << 20);
+
+  /// Returns true if the entry at 'offset' in 'fileId' is sampled.
+  bool isSampled(uint64_t fileId, uint64_t offset) const;
+
+  /// Records 'event' for the 'bytes' of the entry at 'offset' in 'fileId' of
+  /// file group 'groupId' and stream 'trackingId'. Does nothing if the entry
+  /// is not sampled.
+  void record(
+      Event event,
+      uint64_t fileId,
+      uint64_t offset,
+      uint64_t groupId,
+      TrackingId trackingId,
+      uint64_t bytes);
+
+  /// Returns the stats of each file group and column.
+  std::vector<GroupColumnStats> stats() const;
+
+  /// Returns the stats of each file group over its columns.
+  std::vector<GroupColumnStats> groupStats() const;
+
+  /// Returns the stats of the 'maxGroups' file groups with the most bytes
+  /// read, one per line.
+  std::string toString(int32_t maxGroups = 10) const;
+
+  void clear();
+
+ private:
+  struct EntryKey {
+    uint64_t fileId;
+    uint64_t offset;
+
+    bool operator==(const EntryKey& other) const {
+      return fileId == other.fileId && offset == other.offset;
+    }
+  };
+
+  struct EntryKeyHasher {
+    size_t operator()(const EntryKey& key) const {
+      return bits::hashMix(key.fileId, key.offset);
+    }
+  };
+
+  struct GroupColumn {
+    uint64_t groupId;
+    int32_t column;
+
+    bool operator==(const GroupColumn& other) const {
+      return groupId == other.groupId && column == other.column;
+    }
+  };
+
+  struct GroupColumnHasher {
+    size_t operator()(const GroupColumn& key) const {
+      return bits::hashMix(key.groupId, key.column);
+    }
+  };
+
+  const int32_t sampleRate_;
+  const int32_t maxTrackedEntries_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<GroupColumn, Stats, GroupColumnHasher> stats_;
+  // The scaled bytes read from the cache by sampled reads.
+  uint64_t readClock_{0};
+  // The value of 'readClock_' at the last read of each sampled entry.
+  folly::F14FastMap<EntryKey, uint64_t, EntryKeyHasher> lastRead_;
+};
+
+} // namespace facebook::velox::cache
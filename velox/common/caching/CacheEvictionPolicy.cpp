@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheEvictionPolicy.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+namespace {
+// Seeds for the hash of each row of the sketch.
+constexpr uint64_t kRowSeeds[] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL,
+};
+} // namespace
+
+FrequencySketch::FrequencySketch(uint32_t numKeys) {
+  ensureCapacity(numKeys);
+}
+
+void FrequencySketch::ensureCapacity(uint32_t numKeys) {
+  const uint32_t capacity =
+      bits::nextPowerOfTwo(std::max<uint32_t>(numKeys, kMinCapacity));
+  if (capacity <= table_.size()) {
+    return;
+  }
+  table_.assign(capacity, 0);
+  sampleSize_ = kSampleFactor * capacity;
+  numIncrements_ = 0;
+}
+
+uint32_t FrequencySketch::counterIndex(uint64_t hash, int32_t row) const {
+  return bits::hashMix(hash, kRowSeeds[row]) & (table_.size() * 16 - 1);
+}
+
+uint32_t FrequencySketch::estimate(uint64_t hash) const {
+  uint32_t frequency = kMaxFrequency;
+  for (auto row = 0; row < kNumRows; ++row) {
+    frequency = std::min(frequency, counter(counterIndex(hash, row)));
+  }
+  return frequency;
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  bool added = false;
+  for (auto row = 0; row < kNumRows; ++row) {
+    const auto index = counterIndex(hash, row);
+    if (counter(index) < kMaxFrequency) {
+      table_[index / 16] += 1ULL << (4 * (index % 16));
+      added = true;
+    }
+  }
+  if (added && ++numIncrements_ >= sampleSize_) {
+    age();
+  }
+}
+
+void FrequencySketch::age() {
+  for (auto& word : table_) {
+    word = (word >> 1) & 0x7777777777777777ULL;
+  }
+  numIncrements_ /= 2;
+}
+
+// static
+std::string CacheEvictionPolicy::kindString(Kind kind) {
+  switch (kind) {
+    case Kind::kLru:
+      return "lru";
+    case Kind::kTinyLfu:
+      return "tinylfu";
+  }
+  VELOX_UNREACHABLE("Unknown cache eviction policy {}", static_cast<int>(kind));
+}
+
+// static
+std::unique_ptr<CacheEvictionPolicy> CacheEvictionPolicy::create(Kind kind) {
+  switch (kind) {
+    case Kind::kLru:
+      return std::make_unique<LruEvictionPolicy>();
+    case Kind::kTinyLfu:
+      return std::make_unique<TinyLfuEvictionPolicy>();
+  }
+  VELOX_UNREACHABLE("Unknown cache eviction policy {}", static_cast<int>(kind));
+}
+
+int32_t TinyLfuEvictionPolicy::score(const EvictionCandidate& candidate) const {
+  const int64_t age = std::max<int32_t>(0, candidate.age);
+  const int64_t sizeWeight =
+      1 + 64 - bits::countLeadingZeros<uint64_t>(candidate.size / kSizeUnit);
+  int64_t score = age * sizeWeight * 100 /
+      std::max<int32_t>(1, candidate.readPct) /
+      (1 + sketch_.estimate(candidate.hash));
+  if (candidate.probation) {
+    score *= kProbationFactor;
+  }
+  // The maximum is reserved for entries that are explicitly evictable.
+  return std::min<int64_t>(score, std::numeric_limits<int32_t>::max() - 1);
+}
+
+} // namespace facebook::velox::cache
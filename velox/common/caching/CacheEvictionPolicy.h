@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace facebook::velox::cache {
+
+/// Approximate access counts of cache keys in a count-min sketch of 4 bit
+/// counters, as used by TinyLFU. The counters are halved after a sample of
+/// accesses proportional to the number of tracked keys, so that the sketch
+/// forgets old history. The sketch remembers keys that are no longer cached,
+/// which lets a key that keeps coming back be told apart from a key that is
+/// seen once. Not thread safe.
+class FrequencySketch {
+ public:
+  static constexpr uint32_t kMaxFrequency = 15;
+
+  /// Makes a sketch for about 'numKeys' distinct keys.
+  explicit FrequencySketch(uint32_t numKeys = 0);
+
+  /// Counts an access to the key hashing to 'hash'.
+  void increment(uint64_t hash);
+
+  /// Returns the estimated number of accesses to the key hashing to 'hash',
+  /// at most kMaxFrequency.
+  uint32_t estimate(uint64_t hash) const;
+
+  /// Grows the sketch if 'numKeys' is larger than the number of keys it is
+  /// sized for. Growing clears the counts.
+  void ensureCapacity(uint32_t numKeys);
+
+  uint32_t capacity() const {
+    return table_.size();
+  }
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+  static constexpr uint32_t kMinCapacity = 64;
+  // Accesses per tracked key between halvings of the counters.
+  static constexpr uint32_t kSampleFactor = 10;
+
+  // Returns the index of the counter of 'hash' in row 'row'. The counter is
+  // the 4 bits at 4 * (index % 16) in the word at index / 16.
+  uint32_t counterIndex(uint64_t hash, int32_t row) const;
+
+  uint32_t counter(uint32_t index) const {
+    return (table_[index / 16] >> (4 * (index % 16))) & 0xf;
+  }
+
+  // Halves all counters.
+  void age();
+
+  // 16 counters per word, one word per tracked key.
+  std::vector<uint64_t> table_;
+  uint32_t sampleSize_{0};
+  uint32_t numIncrements_{0};
+};
+
+/// The state of a cache entry that CacheEvictionPolicy scores.
+struct EvictionCandidate {
+  /// Hash of the cache key.
+  uint64_t hash;
+  /// Time since last use in units of accessTime().
+  int32_t age;
+  /// Number of hits since the entry was filled.
+  int32_t numUses;
+  /// Size of the cached data in bytes.
+  int32_t size;
+  /// Percentage of the referenced bytes of the entry's column that queries
+  /// actually read, from ScanTracker. 100 if not known.
+  int32_t readPct;
+  /// True if the admission filter rejected the entry and it has not been hit
+  /// since.
+  bool probation;
+};
+
+/// Decides which entries a CacheShard retains. The shard consults the policy
+/// on each lookup, on each new entry and for scoring the entries in its clock
+/// sweep. Calls are serialized by the mutex of the shard and each shard has
+/// its own policy.
+class CacheEvictionPolicy {
+ public:
+  enum class Kind {
+    /// Scores by time since last use over use count. Admits everything.
+    kLru,
+    /// Admits a new entry only if its key has been seen before according to a
+    /// frequency sketch. Scores by age, size, read percentage and frequency.
+    kTinyLfu,
+  };
+
+  static std::string kindString(Kind kind);
+
+  static std::unique_ptr<CacheEvictionPolicy> create(Kind kind);
+
+  virtual ~CacheEvictionPolicy() = default;
+
+  virtual Kind kind() const = 0;
+
+  /// Records a lookup of the key hashing to 'hash', whether a hit or a miss.
+  virtual void recordAccess(uint64_t /*hash*/) {}
+
+  /// Returns true if a new entry for the key hashing to 'hash' is admitted.
+  /// An entry that is not admitted is still created but is put on probation
+  /// until its first hit.
+  virtual bool admit(uint64_t /*hash*/) {
+    return true;
+  }
+
+  /// Tells the policy the number of entries in the shard. Called from time to
+  /// time so that the policy can size its state.
+  virtual void updateCapacity(size_t /*numEntries*/) {}
+
+  /// Retention score of 'candidate'. A higher number means less worth
+  /// retaining.
+  virtual int32_t score(const EvictionCandidate& candidate) const = 0;
+};
+
+/// The clock policy AsyncDataCache has always used.
+class LruEvictionPolicy : public CacheEvictionPolicy {
+ public:
+  Kind kind() const override {
+    return Kind::kLru;
+  }
+
+  int32_t score(const EvictionCandidate& candidate) const override {
+    return candidate.age / (1 + candidate.numUses);
+  }
+};
+
+/// TinyLFU style admission in front of a size aware clock. New entries of keys
+/// the sketch has not seen before are put on probation, so that a scan of data
+/// that is read once does not push out data that is read repeatedly. The score
+/// grows with the size of the entry and falls with the estimated frequency of
+/// the key and the read percentage of its column.
+class TinyLfuEvictionPolicy : public CacheEvictionPolicy {
+ public:
+  /// A new entry is admitted if its key has been looked up at least this many
+  /// times, including the lookup that created the entry.
+  static constexpr uint32_t kAdmitFrequency = 2;
+  /// Factor by which the score of an entry on probation is multiplied.
+  static constexpr int32_t kProbationFactor = 8;
+  /// Entries of up to this size get the smallest size weight. The weight grows
+  /// by one for each doubling of the size above this.
+  static constexpr int32_t kSizeUnit = 64 << 10;
+
+  Kind kind() const override {
+    return Kind::kTinyLfu;
+  }
+
+  void recordAccess(uint64_t hash) override {
+    sketch_.increment(hash);
+  }
+
+  bool admit(uint64_t hash) override {
+    return sketch_.estimate(hash) >= kAdmitFrequency;
+  }
+
+  void updateCapacity(size_t numEntries) override {
+    sketch_.ensureCapacity(numEntries);
+  }
+
+  int32_t score(const EvictionCandidate& candidate) const override;
+
+  const FrequencySketch& sketch() const {
+    return sketch_;
+  }
+
+ private:
+  FrequencySketch sketch_;
+};
+
+} // namespace facebook::velox::cache
+
+template <>
+struct fmt::formatter<facebook::velox::cache::CacheEvictionPolicy::Kind>
+    : formatter<std::string> {
+  auto format(
+      facebook::velox::cache::CacheEvictionPolicy::Kind kind,
+      format_context& ctx) const {
+    return formatter<std::string>::format(
+        facebook::velox::cache::CacheEvictionPolicy::kindString(kind), ctx);
+  }
+};
@@ -15,6 +15,7 @@
  */
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
+#include <folly/futures/Future.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/caching/FileIds.h"
@@ -62,19 +63,51 @@ SsdCache::SsdCache(const Config& config)
   // Distribute maxEntries across shards
   const uint64_t maxEntriesPerShard =
       maxEntries_ == 0 ? 0 : bits::divRoundUp(maxEntries_, numShards_);
-  for (auto i = 0; i < numShards_; ++i) {
+  // Opening a shard reads its checkpoint, which takes seconds for a large
+  // shard. The shards are independent, so they are recovered in parallel.
+  auto openShard = [&](int32_t shard) {
     const auto fileConfig = SsdFile::Config(
-        fmt::format("{}{}", filePrefix_, i),
-        i,
+        fmt::format("{}{}", filePrefix_, shard),
+        shard,
         fileMaxRegions,
         config.checkpointIntervalBytes / config.numShards,
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
         maxEntriesPerShard,
-        executor_);
-    files_.push_back(std::make_unique<SsdFile>(fileConfig));
+        executor_,
+        config.compressionKind);
+    files_[shard] = std::make_unique<SsdFile>(fileConfig);
+  };
+  files_.resize(numShards_);
+  uint64_t openTimeUs{0};
+  {
+    MicrosecondTimer timer(&openTimeUs);
+    std::vector<folly::Future<folly::Unit>> opens;
+    opens.reserve(numShards_ - 1);
+    for (auto i = 1; i < numShards_; ++i) {
+      opens.push_back(folly::via(executor_, [&, i]() { openShard(i); }));
+    }
+    // The first shard is opened on this thread. All shards are waited for
+    // before rethrowing since the pending opens reference this frame.
+    std::exception_ptr error;
+    try {
+      openShard(0);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    for (auto& result : folly::collectAll(std::move(opens)).get()) {
+      if (result.hasException() && error == nullptr) {
+        error = result.exception().to_exception_ptr();
+      }
+    }
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
   }
+  VELOX_SSD_CACHE_LOG(INFO) << "Opened " << numShards_
+                            << " SSD cache shards in "
+                            << succinctMicros(openTimeUs);
 }
 
 SsdFile& SsdCache::file(uint64_t fileId) {
@@ -44,7 +44,8 @@ class SsdCache {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        uint64_t _maxEntries = 0)
+        uint64_t _maxEntries = 0,
+        common::CompressionKind _compressionKind = common::CompressionKind_NONE)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -53,7 +54,8 @@ class SsdCache {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
           executor(_executor),
-          maxEntries(_maxEntries) {}
+          maxEntries(_maxEntries),
+          compressionKind(_compressionKind) {}
 
     std::string filePrefix;
     uint64_t maxBytes;
@@ -72,22 +74,29 @@ class SsdCache {
     /// If true, checksum read verification from SSD is enabled.
     bool checksumReadVerificationEnabled;
 
-    /// Executor for async fsync in checkpoint.
+    /// Executor for async fsync in checkpoint. Shards are also opened and
+    /// recovered from their checkpoints on it, so the cache must not be
+    /// constructed from a thread of this executor.
     folly::Executor* executor;
 
     /// Maximum number of SSD cache entries allowed. A value of 0 means no
     /// limit. When the limit is reached, new entry writes will be skipped.
     uint64_t maxEntries;
 
+    /// Codec for compressing the entries that compress well. See
+    /// SsdFile::Config::compressionKind.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
+
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, compression {}",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          common::compressionKindToString(compressionKind));
     }
   };
 
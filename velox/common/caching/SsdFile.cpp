@@ -16,14 +16,19 @@
 
 #include "velox/common/caching/SsdFile.h"
 
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Counters.h"
 #include "velox/common/base/Crc.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -67,6 +72,33 @@ uint32_t numIoVectorsFromEntry(AsyncDataCacheEntry& entry) {
   }
   return entry.data().numRuns();
 }
+
+// Returns the data of 'entry' compressed with 'codec', or nullptr if the
+// compression does not save at least 1/8 of the size. Cached file data is
+// often compressed already and is then stored as is.
+std::unique_ptr<folly::IOBuf> compressEntry(
+    folly::compression::Codec& codec,
+    AsyncDataCacheEntry& entry) {
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(entry, iovecs);
+  const auto input = folly::IOBuf::wrapIov(iovecs.data(), iovecs.size());
+  auto compressed = codec.compress(input.get());
+  const uint64_t maxSize = entry.size() - entry.size() / 8;
+  if (compressed->computeChainDataLength() > maxSize) {
+    return nullptr;
+  }
+  return compressed;
+}
+
+// Copies the first entry.size() bytes of 'data' into 'entry'.
+void copyToEntry(const folly::IOBuf& data, AsyncDataCacheEntry& entry) {
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(entry, iovecs);
+  folly::io::Cursor cursor(&data);
+  for (const auto& iov : iovecs) {
+    cursor.pull(iov.iov_base, iov.iov_len);
+  }
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -114,6 +146,7 @@ SsdFile::SsdFile(const Config& config)
       shardId_(config.shardId),
       maxEntries_(config.maxEntries),
       executor_(config.executor),
+      compressionKind_(config.compressionKind),
       fs_(filesystems::getFileSystem(fileName_, nullptr)),
       checkpointIntervalBytes_(config.checkpointIntervalBytes) {
   process::TraceContext trace("SsdFile::SsdFile");
@@ -197,14 +230,17 @@ CoalesceIoStats SsdFile::load(
     return CoalesceIoStats();
   }
   size_t totalPayloadBytes = 0;
+  bool hasCompressed = false;
   for (auto i = 0; i < pins.size(); ++i) {
     const auto runSize = ssdPins[i].run().size();
+    const auto dataSize = ssdPins[i].run().uncompressedSize();
+    hasCompressed |= ssdPins[i].run().compressed();
     auto* entry = pins[i].checkedEntry();
-    if (FOLLY_UNLIKELY(runSize < entry->size())) {
+    if (FOLLY_UNLIKELY(dataSize < entry->size())) {
       ++stats_.readSsdErrors;
       VELOX_FAIL(
           "IOERR: SSD cache cache entry {} short than requested range {}",
-          succinctBytes(runSize),
+          succinctBytes(dataSize),
           succinctBytes(entry->size()));
     }
     totalPayloadBytes += entry->size();
@@ -213,24 +249,54 @@ CoalesceIoStats SsdFile::load(
     stats_.bytesRead += entry->size();
   }
 
+  // Compressed entries are read and decompressed one by one. The others are
+  // read into their cache entries with coalesced IO.
+  std::vector<CachePin> uncompressedPins;
+  std::vector<uint64_t> uncompressedOffsets;
+  CoalesceIoStats compressedStats;
+  if (hasCompressed) {
+    auto codec = common::compressionKindToCodec(compressionKind_);
+    for (auto i = 0; i < pins.size(); ++i) {
+      const auto run = ssdPins[i].run();
+      if (!run.compressed()) {
+        uncompressedPins.push_back(pins[i]);
+        uncompressedOffsets.push_back(run.offset());
+        continue;
+      }
+      auto data = readCompressed(*codec, run);
+      copyToEntry(*data, *pins[i].checkedEntry());
+      ++compressedStats.numIos;
+      compressedStats.payloadBytes += run.size();
+    }
+  }
+  const auto& coalescedPins = hasCompressed ? uncompressedPins : pins;
+
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
-  const auto stats = readPins(
-      pins,
-      totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
-      900,
-      [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
-          int32_t /*begin*/,
-          int32_t /*end*/,
-          uint64_t offset,
-          const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
-      });
+  CoalesceIoStats stats;
+  if (!coalescedPins.empty()) {
+    stats = readPins(
+        coalescedPins,
+        totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
+        // Max ranges in one preadv call. Longest gap + longest cache entry
+        // are under 12 ranges. If a system has a limit of 1K ranges, coalesce
+        // limit of 1000 is safe.
+        900,
+        [&](int32_t index) {
+          return hasCompressed ? uncompressedOffsets[index]
+                               : ssdPins[index].run().offset();
+        },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          read(offset, buffers);
+        });
+  }
+  stats.numIos += compressedStats.numIos;
+  stats.payloadBytes += compressedStats.payloadBytes;
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -245,11 +311,42 @@ void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
   process::TraceContext trace("SsdFile::read");
-  readFile_->preadv(offset, buffers);
+  uint64_t readUs{0};
+  {
+    MicrosecondTimer timer(&readUs);
+    readFile_->preadv(offset, buffers);
+  }
+  RECORD_QUANTILE_STAT_VALUE(kMetricSsdCacheReadLatencyUs, readUs);
+}
+
+std::unique_ptr<folly::IOBuf> SsdFile::readCompressed(
+    folly::compression::Codec& codec,
+    const SsdRun& run) {
+  VELOX_CHECK(run.compressed());
+  auto buffer = folly::IOBuf::create(run.size());
+  read(
+      run.offset(),
+      {folly::Range<char*>(
+          reinterpret_cast<char*>(buffer->writableData()), run.size())});
+  buffer->append(run.size());
+  std::unique_ptr<folly::IOBuf> data;
+  try {
+    data = codec.uncompress(buffer.get(), run.uncompressedSize());
+  } catch (const std::exception& e) {
+    ++stats_.readSsdCorruptions;
+    VELOX_FAIL(
+        "IOERR: Failed to decompress SSD cache entry - File: {}, Offset: {}, Size: {}: {}",
+        fileName_,
+        run.offset(),
+        run.size(),
+        e.what());
+  }
+  VELOX_CHECK_EQ(data->computeChainDataLength(), run.uncompressedSize());
+  return data;
 }
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<int32_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -264,13 +361,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < sizes.size(); ++next) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -382,9 +478,35 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // Compresses the entries first so that space is allocated for the sizes on
+  // SSD. An entry that is not compressed has a null element in 'compressed'.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  std::vector<int32_t> sizes(pins.size());
+  std::unique_ptr<folly::compression::Codec> codec;
+  if (compressionEnabled()) {
+    codec = common::compressionKindToCodec(compressionKind_);
+  }
+  for (auto i = 0; i < pins.size(); ++i) {
+    auto* entry = pins[i].checkedEntry();
+    sizes[i] = entry->size();
+    if (codec == nullptr) {
+      continue;
+    }
+    try {
+      compressed[i] = compressEntry(*codec, *entry);
+    } catch (const std::exception& e) {
+      VELOX_SSD_CACHE_LOG_EVERY_MS(WARNING, 10'000)
+          << "Failed to compress SSD cache entry, writing it uncompressed: "
+          << e.what();
+    }
+    if (compressed[i] != nullptr) {
+      sizes[i] = compressed[i]->computeChainDataLength();
+    }
+  }
+
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    auto space = getSpace(pins, writeIndex);
+    auto space = getSpace(sizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
@@ -398,8 +520,10 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     std::vector<iovec> writeIovecs;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const auto entrySize = sizes[i];
+      const auto numIovecs = compressed[i] != nullptr
+          ? compressed[i]->countChainElements()
+          : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
@@ -416,7 +540,14 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (compressed[i] != nullptr) {
+        for (const auto range : *compressed[i]) {
+          writeIovecs.push_back(
+              {const_cast<uint8_t*>(range.data()), range.size()});
+        }
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
@@ -438,16 +569,23 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
         entry->setSsdFile(this, offset);
-        const auto size = entry->size();
+        const auto size = sizes[i];
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
         uint32_t checksum = 0;
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
+        uint32_t uncompressedSize = 0;
+        if (compressed[i] != nullptr) {
+          uncompressedSize = entry->size();
+          ++stats_.entriesCompressed;
+          stats_.bytesSavedByCompression += entry->size() - size;
+        }
+        const SsdRun run(offset, size, checksum, uncompressedSize);
+        entries_[std::move(key)] = run;
         if (FLAGS_velox_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+          verifyWrite(*entry, run);
         }
         offset += size;
         ++stats_.entriesWritten;
@@ -508,9 +646,16 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   process::TraceContext trace("SsdFile::verifyWrite");
   auto testData = std::make_unique<char[]>(entry.size());
-  const auto rc =
-      readFile_->pread(ssdRun.offset(), entry.size(), testData.get());
-  VELOX_CHECK_EQ(rc.size(), entry.size());
+  if (ssdRun.compressed()) {
+    auto codec = common::compressionKindToCodec(compressionKind_);
+    auto data = readCompressed(*codec, ssdRun);
+    VELOX_CHECK_EQ(data->computeChainDataLength(), entry.size());
+    folly::io::Cursor(data.get()).pull(testData.get(), entry.size());
+  } else {
+    const auto rc =
+        readFile_->pread(ssdRun.offset(), entry.size(), testData.get());
+    VELOX_CHECK_EQ(rc.size(), entry.size());
+  }
   if (entry.tinyData() != nullptr) {
     if (::memcmp(testData.get(), entry.tinyData(), entry.size()) != 0) {
       VELOX_FAIL("bad read back");
@@ -570,6 +715,8 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
   stats.readSsdCorruptions += stats_.readSsdCorruptions;
   stats.readWithoutChecksumChecks += stats_.readWithoutChecksumChecks;
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.bytesSavedByCompression += stats_.bytesSavedByCompression;
 }
 
 void SsdFile::clear() {
@@ -801,12 +948,14 @@ void SsdFile::checkpoint(bool force) {
       truncateFile(checkpointWriteFile_.get());
       // The checkpoint state file contains:
       // int32_t The 4 bytes of checkpoint version,
+      // int32_t compression kind if compression is enabled,
       // int32_t maxRegions,
       // int32_t numRegions,
       // regionScores from the 'tracker_',
       // {fileId, fileName} pairs,
       // kMapMarker,
-      // {fileId, offset, SSdRun} triples,
+      // {fileId, offset, SSdRun} triples, where SsdRun has the uncompressed
+      // size if compression is enabled,
       // kEndMarker.
       allocateCheckpointBuffer();
       SCOPE_EXIT {
@@ -814,6 +963,10 @@ void SsdFile::checkpoint(bool force) {
       };
       const auto version = checkpointVersion();
       appendToCheckpointBuffer(checkpointVersion());
+      if (compressionEnabled()) {
+        const int32_t compressionKind = compressionKind_;
+        appendToCheckpointBuffer(compressionKind);
+      }
       appendToCheckpointBuffer(maxRegions_);
       appendToCheckpointBuffer(numRegions_);
 
@@ -842,6 +995,12 @@ void SsdFile::checkpoint(bool force) {
           const auto checksum = pair.second.checksum();
           appendToCheckpointBuffer(checksum);
         }
+        if (compressionEnabled()) {
+          const uint32_t uncompressedSize = pair.second.compressed()
+              ? pair.second.uncompressedSize()
+              : 0;
+          appendToCheckpointBuffer(uncompressedSize);
+        }
       }
 
       // NOTE: we need to ensure cache file data sync update completes before
@@ -960,12 +1119,12 @@ void SsdFile::maybeVerifyChecksum(
   if (!checksumReadVerificationEnabled_) {
     return;
   }
-  VELOX_DCHECK_EQ(ssdRun.size(), entry.size());
-  if (ssdRun.size() != entry.size()) {
+  VELOX_DCHECK_EQ(ssdRun.uncompressedSize(), entry.size());
+  if (ssdRun.uncompressedSize() != entry.size()) {
     ++stats_.readWithoutChecksumChecks;
     VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
         << "SSD read without checksum due to cache request size mismatch, SSD cache size "
-        << ssdRun.size() << " request size " << entry.size()
+        << ssdRun.uncompressedSize() << " request size " << entry.size()
         << ", cache request: " << entry.toString();
     return;
   }
@@ -1050,6 +1209,21 @@ void SsdFile::readCheckpoint() {
         checkpointPath);
     return;
   }
+  const auto checkpointHasCompression =
+      isCompressionEnabledOnCheckpointVersion(versionMagic);
+  if (checkpointHasCompression) {
+    const auto compressionKind =
+        static_cast<common::CompressionKind>(readNumber<int32_t>(stream.get()));
+    if (compressionKind != compressionKind_) {
+      VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+          "Starting shard {} without checkpoint: the checkpoint was made with compression {} but compression is {}, checkpoint file {}",
+          shardId_,
+          common::compressionKindToString(compressionKind),
+          common::compressionKindToString(compressionKind_),
+          checkpointPath);
+      return;
+    }
+  }
 
   const auto maxRegions = readNumber<int32_t>(stream.get());
   VELOX_CHECK_EQ(
@@ -1097,7 +1271,11 @@ void SsdFile::readCheckpoint() {
     if (checkpoinHasChecksum) {
       checksum = readNumber<uint32_t>(stream.get());
     }
-    const auto run = SsdRun(fileBits, checksum);
+    uint32_t uncompressedSize = 0;
+    if (checkpointHasCompression) {
+      uncompressedSize = readNumber<uint32_t>(stream.get());
+    }
+    const auto run = SsdRun(fileBits, checksum, uncompressedSize);
     const auto region = regionIndex(run.offset());
     // Check that the recovered entry does not fall in an evicted region.
     if (evictedMap.find(region) != evictedMap.end()) {
@@ -21,6 +21,7 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
@@ -36,21 +37,33 @@ class SsdCacheTestHelper;
 /// SsdFile. The low 23 bits are the size, for a maximum entry size of 8MB. The
 /// high 41 bits are the offset. The 'checksum_' field is optional and is used
 /// only when the checksum feature is enabled, otherwise, its value is always 0.
+/// The checksum is of the uncompressed data. The 'uncompressedSize_' field is
+/// non-zero only for a compressed entry. In this case the size in 'fileBits_'
+/// is the compressed size on SSD.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
   SsdRun() = default;
 
-  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
-      : fileBits_((offset << kSizeBits) | (size - 1)), checksum_(checksum) {
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum,
+      uint32_t uncompressedSize = 0)
+      : fileBits_((offset << kSizeBits) | (size - 1)),
+        checksum_(checksum),
+        uncompressedSize_(uncompressedSize) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
+    VELOX_CHECK_LE(uncompressedSize, 1 << kSizeBits);
   }
 
-  SsdRun(uint64_t fileBits, uint32_t checksum)
-      : fileBits_(fileBits), checksum_(checksum) {}
+  SsdRun(uint64_t fileBits, uint32_t checksum, uint32_t uncompressedSize = 0)
+      : fileBits_(fileBits),
+        checksum_(checksum),
+        uncompressedSize_(uncompressedSize) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
@@ -58,13 +71,16 @@ class SsdRun {
   void operator=(const SsdRun& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    uncompressedSize_ = other.uncompressedSize_;
   }
 
   void operator=(SsdRun&& other) noexcept {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    uncompressedSize_ = other.uncompressedSize_;
     other.fileBits_ = 0;
     other.checksum_ = 0;
+    other.uncompressedSize_ = 0;
   }
 
   uint64_t offset() const {
@@ -85,10 +101,22 @@ class SsdRun {
     return fileBits_;
   }
 
+  /// Returns true if the data on SSD is compressed.
+  bool compressed() const {
+    return uncompressedSize_ != 0;
+  }
+
+  /// Returns the size of the cached data, which is size() unless compressed.
+  uint32_t uncompressedSize() const {
+    return compressed() ? uncompressedSize_ : size();
+  }
+
  private:
   // Contains the file offset and size.
   uint64_t fileBits_{0};
   uint32_t checksum_{0};
+  // Size of the data before compression. 0 if not compressed.
+  uint32_t uncompressedSize_{0};
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -177,6 +205,8 @@ struct SsdCacheStats {
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
     readWithoutChecksumChecks =
         tsanAtomicValue(other.readWithoutChecksumChecks);
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    bytesSavedByCompression = tsanAtomicValue(other.bytesSavedByCompression);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
@@ -212,6 +242,9 @@ struct SsdCacheStats {
         readCheckpointErrors - other.readCheckpointErrors;
     result.readWithoutChecksumChecks =
         readWithoutChecksumChecks - other.readWithoutChecksumChecks;
+    result.entriesCompressed = entriesCompressed - other.entriesCompressed;
+    result.bytesSavedByCompression =
+        bytesSavedByCompression - other.bytesSavedByCompression;
     return result;
   }
 
@@ -250,6 +283,10 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> readCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdCorruptions{0};
   tsan_atomic<uint32_t> readWithoutChecksumChecks{0};
+  /// Number of entries written compressed.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  /// Bytes of SSD space saved by compressing entries on write.
+  tsan_atomic<uint64_t> bytesSavedByCompression{0};
 };
 
 /// A shard of SsdCache. Corresponds to one file on SSD. The data backed by each
@@ -270,7 +307,8 @@ class SsdFile {
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
         uint64_t _maxEntries = 0,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        common::CompressionKind _compressionKind = common::CompressionKind_NONE)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -280,7 +318,8 @@ class SsdFile {
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
           maxEntries(_maxEntries),
-          executor(_executor) {}
+          executor(_executor),
+          compressionKind(_compressionKind) {}
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -310,6 +349,11 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* const executor;
+
+    /// Codec for compressing entries on write. An entry is stored compressed
+    /// only if this saves space, so already compressed file data is stored
+    /// as is. CompressionKind_NONE disables compression.
+    const common::CompressionKind compressionKind;
   };
 
   enum class State : uint8_t {
@@ -441,11 +485,20 @@ class SsdFile {
   }
 
   // The first 4 bytes of a checkpoint file contains version string to indicate
-  // if checksum write is enabled or not.
+  // if checksum write and compression are enabled or not. With compression,
+  // the version is followed by the compression kind and each entry records
+  // its uncompressed size.
   std::string checkpointVersion() const {
+    if (compressionEnabled()) {
+      return checksumEnabled_ ? "CPZ2" : "CPZ1";
+    }
     return checksumEnabled_ ? "CPT2" : "CPT1";
   }
 
+  bool compressionEnabled() const {
+    return compressionKind_ != common::CompressionKind_NONE;
+  }
+
   // Increments the pin count of the region of 'offset'. Caller must hold
   // 'mutex_'.
   void pinRegionLocked(uint64_t offset) {
@@ -453,11 +506,12 @@ class SsdFile {
   }
 
   // Returns [offset, size] of contiguous space for storing data of a number of
-  // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
-  // if there is no space. The space does not necessarily cover all the pins, so
-  // multiple calls starting at the first unwritten pin may be needed.
+  // contiguous pins starting with the pin at index 'begin'. 'sizes' has the
+  // size on SSD of each pin. Returns nullopt if there is no space. The space
+  // does not necessarily cover all the pins, so multiple calls starting at the
+  // first unwritten pin may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<int32_t>& sizes,
       int32_t begin);
 
   // Removes all 'entries_' that reference data in regions described by
@@ -471,6 +525,11 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Reads the compressed entry at 'run' and returns the uncompressed data.
+  std::unique_ptr<folly::IOBuf> readCompressed(
+      folly::compression::Codec& codec,
+      const SsdRun& run);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -564,7 +623,13 @@ class SsdFile {
   // Returns true if checksum write is enabled for the given version.
   static bool isChecksumEnabledOnCheckpointVersion(
       const std::string& checkpointVersion) {
-    return checkpointVersion == "CPT2";
+    return checkpointVersion == "CPT2" || checkpointVersion == "CPZ2";
+  }
+
+  // Returns true if compression is enabled for the given version.
+  static bool isCompressionEnabledOnCheckpointVersion(
+      const std::string& checkpointVersion) {
+    return checkpointVersion == "CPZ1" || checkpointVersion == "CPZ2";
   }
 
   static constexpr const char* kLogExtension = ".log";
@@ -595,6 +660,9 @@ class SsdFile {
   // Executor for async fsync in checkpoint.
   folly::Executor* const executor_;
 
+  // Codec kind for compressing entries. CompressionKind_NONE if disabled.
+  const common::CompressionKind compressionKind_;
+
   // Serializes access to all private data members.
   mutable std::shared_mutex mutex_;
 
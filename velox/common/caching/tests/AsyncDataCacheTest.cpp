@@ -914,6 +914,8 @@ TEST_P(AsyncDataCacheTest, DISABLED_ssd) {
             << cache_->toString();
   const auto ssdStatsFromCP = cache_->ssdCache()->stats();
   ASSERT_EQ(ssdStatsFromCP.readCheckpointErrors, 1);
+  // The shards are recovered in parallel, each from its own checkpoint.
+  ASSERT_EQ(ssdStatsFromCP.checkpointsRead, kNumSsdShards - 1);
 }
 
 TEST_P(AsyncDataCacheTest, invalidSsdPath) {
@@ -957,6 +959,7 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
       "Cache entries: 100 read pins: 30 write pins: 20 pinned shared: 10.00MB pinned exclusive: 10.00MB\n"
       " num write wait: 244 empty entries: 20\n"
       "Cache access miss: 2041 hit: 46 hit bytes: 1.34KB eviction: 463 savable eviction: 0 eviction checks: 348 aged out: 10 stales: 100\n"
+      "Eviction policy: lru hit ratio: 2.20% admission rejects: 0\n"
       "Prefetch entries: 30 bytes: 100B\n"
       "Alloc Megaclocks 0");
 
@@ -993,6 +996,7 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
       "Cache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n"
       " num write wait: 0 empty entries: 0\n"
       "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0\n"
+      "Eviction policy: lru hit ratio: 0.00% admission rejects: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n"
@@ -1017,6 +1021,7 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
       "Cache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n"
       " num write wait: 0 empty entries: 0\n"
       "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0\n"
+      "Eviction policy: lru hit ratio: 0.00% admission rejects: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n";
@@ -1039,7 +1044,7 @@ TEST_P(AsyncDataCacheTest, cacheStatsWithSsd) {
   ASSERT_EQ(deltaStats.ssdStats->bytesWritten, 1);
   ASSERT_EQ(deltaStats.ssdStats->bytesRead, 1);
   const std::string expectedDeltaCacheStats =
-      "Cache size: 0B tinySize: 0B large size: 0B\nCache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n num write wait: 0 empty entries: 0\nCache access miss: 0 hit: 234 hit bytes: 0B eviction: 1024 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0\nPrefetch entries: 0 bytes: 0B\nAlloc Megaclocks 0";
+      "Cache size: 0B tinySize: 0B large size: 0B\nCache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n num write wait: 0 empty entries: 0\nCache access miss: 0 hit: 234 hit bytes: 0B eviction: 1024 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0\nEviction policy: lru hit ratio: 100.00% admission rejects: 0\nPrefetch entries: 0 bytes: 0B\nAlloc Megaclocks 0";
   ASSERT_EQ(deltaStats.toString(), expectedDeltaCacheStats);
 }
 
@@ -1929,6 +1934,76 @@ TEST_P(AsyncDataCacheTest, dataRanges) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, tinyLfuAdmission) {
+  constexpr int64_t kRamBytes = 32 << 20;
+  constexpr int32_t kEntrySize = 4096;
+  constexpr int32_t kNumEntries = 10;
+  initializeMemoryManager(kRamBytes);
+  AsyncDataCache::Options options;
+  options.evictionPolicy = CacheEvictionPolicy::Kind::kTinyLfu;
+  initializeCache(kRamBytes, 0, 0, false, options);
+
+  auto makeEntries = [&](uint64_t firstOffset) {
+    for (auto i = 0; i < kNumEntries; ++i) {
+      RawFileCacheKey key{filenames_[0].id(), firstOffset + i * kEntrySize};
+      auto pin = cache_->findOrCreate(key, kEntrySize, nullptr);
+      ASSERT_FALSE(pin.empty());
+      ASSERT_TRUE(pin.entry()->isExclusive());
+      pin.entry()->setReadPct(150);
+      ASSERT_EQ(pin.entry()->readPct(), 100);
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+  auto findEntries = [&](uint64_t firstOffset) {
+    for (auto i = 0; i < kNumEntries; ++i) {
+      RawFileCacheKey key{filenames_[0].id(), firstOffset + i * kEntrySize};
+      auto result = cache_->find(key);
+      ASSERT_TRUE(result.has_value());
+      ASSERT_FALSE(result->empty());
+      // The hit ends the probation.
+      ASSERT_FALSE(result->checkedEntry()->isProbation());
+    }
+  };
+
+  // Keys that were never seen are put on probation.
+  makeEntries(0);
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.evictionPolicy, CacheEvictionPolicy::Kind::kTinyLfu);
+  ASSERT_EQ(stats.numAdmissionRejects, kNumEntries);
+  for (const auto* entry : asyncDataCacheHelper_->cacheEntries()) {
+    ASSERT_TRUE(entry->isProbation());
+  }
+  findEntries(0);
+  for (const auto* entry : asyncDataCacheHelper_->cacheEntries()) {
+    ASSERT_FALSE(entry->isProbation());
+  }
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numHit, kNumEntries);
+  ASSERT_EQ(stats.hitRatio(), 0.5);
+
+  // Keys that come back after eviction are admitted.
+  cache_->clear();
+  makeEntries(0);
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numAdmissionRejects, kNumEntries);
+  for (const auto* entry : asyncDataCacheHelper_->cacheEntries()) {
+    if (entry != nullptr) {
+      ASSERT_FALSE(entry->isProbation());
+    }
+  }
+  ASSERT_NE(
+      stats.toString().find(
+          "Eviction policy: tinylfu hit ratio: 33.33% admission rejects: 10"),
+      std::string::npos);
+
+  // The default policy admits everything.
+  initializeCache(kRamBytes);
+  makeEntries(0);
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.evictionPolicy, CacheEvictionPolicy::Kind::kLru);
+  ASSERT_EQ(stats.numAdmissionRejects, 0);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     AsyncDataCacheTest,
     AsyncDataCacheTest,
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheAttribution.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/caching/FileIds.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+using Event = CacheAttribution::Event;
+
+// Returns the TrackingId of stream 'kind' of column 'node'.
+TrackingId trackingId(int32_t node, int32_t kind) {
+  return TrackingId((node << 5) | kind);
+}
+
+const CacheAttribution::Stats& findStats(
+    const std::vector<CacheAttribution::GroupColumnStats>& stats,
+    uint64_t groupId,
+    int32_t column) {
+  for (const auto& entry : stats) {
+    if (entry.groupId == groupId && entry.column == column) {
+      return entry.stats;
+    }
+  }
+  VELOX_FAIL("No stats for group {} column {}", groupId, column);
+}
+
+TEST(CacheAttributionTest, basic) {
+  StringIdLease group(fileIds(), "warehouse/t1/ds=2024-01-01");
+  const auto groupId = group.id();
+  CacheAttribution attribution(1);
+  attribution.record(Event::kMiss, 10, 0, groupId, trackingId(3, 1), 100);
+  attribution.record(Event::kMiss, 10, 100, groupId, trackingId(4, 2), 50);
+  attribution.record(Event::kRamHit, 10, 0, groupId, trackingId(3, 1), 100);
+  attribution.record(Event::kRamHit, 10, 100, groupId, trackingId(4, 2), 50);
+  attribution.record(Event::kSsdHit, 10, 0, groupId, trackingId(3, 1), 100);
+  attribution.record(Event::kSsdWrite, 10, 0, groupId, trackingId(3, 1), 100);
+  attribution.record(Event::kSsdWrite, 10, 0, groupId, trackingId(3, 2), 100);
+  attribution.record(Event::kEviction, 10, 100, groupId, trackingId(4, 2), 50);
+  attribution.record(Event::kSsdWrite, 10, 100, groupId, trackingId(4, 2), 50);
+  attribution.record(Event::kMiss, 10, 200, groupId, TrackingId(), 10);
+
+  const auto stats = attribution.stats();
+  ASSERT_EQ(stats.size(), 3);
+  EXPECT_EQ(stats[0].groupName, "warehouse/t1/ds=2024-01-01");
+
+  const auto& column3 = findStats(stats, groupId, 3);
+  EXPECT_EQ(column3.missBytes, 100);
+  EXPECT_EQ(column3.ramHitBytes, 100);
+  EXPECT_EQ(column3.ssdHitBytes, 100);
+  EXPECT_DOUBLE_EQ(column3.hitRate(), 2.0 / 3);
+  EXPECT_EQ(column3.ssdWrittenBytes, 200);
+  EXPECT_DOUBLE_EQ(column3.ssdWriteAmplification(), 2);
+  // 50 bytes are read between each read of offset 0 and the one before.
+  EXPECT_EQ(column3.numReuses, 2);
+  EXPECT_DOUBLE_EQ(column3.meanReuseDistanceBytes(), 50);
+
+  const auto& column4 = findStats(stats, groupId, 4);
+  EXPECT_EQ(column4.evictedBytes, 50);
+  EXPECT_EQ(column4.numReuses, 1);
+  EXPECT_DOUBLE_EQ(column4.meanReuseDistanceBytes(), 100);
+  EXPECT_EQ(
+      column4.ssdWriteAmplification(), std::numeric_limits<double>::infinity());
+
+  EXPECT_EQ(findStats(stats, groupId, -1).missBytes, 10);
+
+  const auto groups = attribution.groupStats();
+  ASSERT_EQ(groups.size(), 1);
+  EXPECT_EQ(groups[0].column, -1);
+  EXPECT_EQ(groups[0].stats.ramHitBytes, 150);
+  EXPECT_EQ(groups[0].stats.ssdHitBytes, 100);
+  EXPECT_EQ(groups[0].stats.missBytes, 160);
+  EXPECT_EQ(groups[0].stats.ssdWrittenBytes, 250);
+  EXPECT_NE(
+      attribution.toString().find("warehouse/t1/ds=2024-01-01: read 410B"),
+      std::string::npos);
+
+  attribution.clear();
+  EXPECT_TRUE(attribution.stats().empty());
+}
+
+TEST(CacheAttributionTest, sampling) {
+  CacheAttribution disabled(0);
+  EXPECT_FALSE(disabled.isSampled(1, 0));
+  disabled.record(Event::kMiss, 1, 0, 1, trackingId(1, 0), 100);
+  EXPECT_TRUE(disabled.stats().empty());
+
+  constexpr int32_t kSampleRate = 4;
+  CacheAttribution attribution(kSampleRate);
+  int32_t numSampled = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    numSampled += attribution.isSampled(1, i * 10);
+    attribution.record(Event::kMiss, 1, i * 10, 1, trackingId(1, 0), 10);
+  }
+  EXPECT_GT(numSampled, 150);
+  EXPECT_LT(numSampled, 350);
+  const auto stats = attribution.stats();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].stats.missBytes, numSampled * 10 * kSampleRate);
+}
+
+TEST(CacheAttributionTest, maxTrackedEntries) {
+  CacheAttribution attribution(1, 2);
+  attribution.record(Event::kMiss, 1, 0, 1, trackingId(1, 0), 10);
+  attribution.record(Event::kMiss, 1, 10, 1, trackingId(1, 0), 10);
+  // Forgets the first two entries.
+  attribution.record(Event::kMiss, 1, 20, 1, trackingId(1, 0), 10);
+  attribution.record(Event::kRamHit, 1, 0, 1, trackingId(1, 0), 10);
+  attribution.record(Event::kRamHit, 1, 20, 1, trackingId(1, 0), 10);
+  const auto stats = attribution.stats();
+  ASSERT_EQ(stats.size(), 1);
+  EXPECT_EQ(stats[0].stats.numReuses, 1);
+  EXPECT_EQ(stats[0].stats.sumReuseDistanceBytes, 10);
+}
+
+} // namespace
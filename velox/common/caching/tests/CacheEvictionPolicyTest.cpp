@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheEvictionPolicy.h"
+
+#include "gtest/gtest.h"
+#include "velox/common/base/BitUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+uint64_t keyHash(uint64_t key) {
+  return bits::hashMix(key, 0x1234);
+}
+} // namespace
+
+TEST(CacheEvictionPolicyTest, frequencySketch) {
+  FrequencySketch sketch(1'000);
+  EXPECT_EQ(sketch.capacity(), 1'024);
+  EXPECT_EQ(sketch.estimate(keyHash(1)), 0);
+  for (auto i = 0; i < 5; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  EXPECT_EQ(sketch.estimate(keyHash(1)), 5);
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(keyHash(2));
+  }
+  EXPECT_EQ(sketch.estimate(keyHash(2)), FrequencySketch::kMaxFrequency);
+
+  // Keys that are seen once stay at a low estimate. Count-min can only
+  // overestimate.
+  int32_t numOverestimates = 0;
+  for (auto key = 100; key < 600; ++key) {
+    sketch.increment(keyHash(key));
+  }
+  for (auto key = 100; key < 600; ++key) {
+    const auto estimate = sketch.estimate(keyHash(key));
+    EXPECT_GE(estimate, 1);
+    numOverestimates += estimate > 1;
+  }
+  EXPECT_LT(numOverestimates, 25);
+
+  // Growing clears the counts.
+  sketch.ensureCapacity(512);
+  EXPECT_EQ(sketch.estimate(keyHash(1)), 5);
+  sketch.ensureCapacity(5'000);
+  EXPECT_EQ(sketch.capacity(), 8'192);
+  EXPECT_EQ(sketch.estimate(keyHash(1)), 0);
+}
+
+TEST(CacheEvictionPolicyTest, frequencySketchAging) {
+  FrequencySketch sketch(64);
+  for (auto i = 0; i < 12; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  EXPECT_EQ(sketch.estimate(keyHash(1)), 12);
+  // Once the sample size of increments is reached the counters are halved.
+  // The other keys add a few collisions before the halving.
+  for (auto key = 100; key < 100 + 64 * 10; ++key) {
+    sketch.increment(keyHash(key));
+  }
+  EXPECT_GE(sketch.estimate(keyHash(1)), 6);
+  EXPECT_LE(sketch.estimate(keyHash(1)), 8);
+}
+
+TEST(CacheEvictionPolicyTest, kinds) {
+  EXPECT_EQ(
+      CacheEvictionPolicy::create(CacheEvictionPolicy::Kind::kLru)->kind(),
+      CacheEvictionPolicy::Kind::kLru);
+  EXPECT_EQ(
+      CacheEvictionPolicy::create(CacheEvictionPolicy::Kind::kTinyLfu)->kind(),
+      CacheEvictionPolicy::Kind::kTinyLfu);
+  EXPECT_EQ(
+      CacheEvictionPolicy::kindString(CacheEvictionPolicy::Kind::kLru), "lru");
+  EXPECT_EQ(
+      fmt::format("{}", CacheEvictionPolicy::Kind::kTinyLfu), "tinylfu");
+}
+
+TEST(CacheEvictionPolicyTest, lru) {
+  LruEvictionPolicy policy;
+  EXPECT_TRUE(policy.admit(keyHash(1)));
+  EvictionCandidate candidate{
+      .hash = keyHash(1),
+      .age = 1'000,
+      .numUses = 3,
+      .size = 1 << 20,
+      .readPct = 10,
+      .probation = false};
+  EXPECT_EQ(policy.score(candidate), 250);
+  // Size and read percentage do not matter.
+  candidate.size = 1'000;
+  candidate.readPct = 100;
+  EXPECT_EQ(policy.score(candidate), 250);
+}
+
+TEST(CacheEvictionPolicyTest, tinyLfuAdmission) {
+  TinyLfuEvictionPolicy policy;
+  policy.recordAccess(keyHash(1));
+  EXPECT_FALSE(policy.admit(keyHash(1)));
+  policy.recordAccess(keyHash(1));
+  EXPECT_TRUE(policy.admit(keyHash(1)));
+  EXPECT_FALSE(policy.admit(keyHash(2)));
+}
+
+TEST(CacheEvictionPolicyTest, tinyLfuScore) {
+  TinyLfuEvictionPolicy policy;
+  const EvictionCandidate base{
+      .hash = keyHash(1),
+      .age = 1'000,
+      .numUses = 0,
+      .size = 1'000,
+      .readPct = 100,
+      .probation = false};
+  const auto baseScore = policy.score(base);
+  EXPECT_EQ(baseScore, 1'000);
+
+  // Larger entries are less worth retaining. The weight grows by one per
+  // doubling of the size from 64KB.
+  auto large = base;
+  large.size = 64 << 10;
+  EXPECT_EQ(policy.score(large), 2 * baseScore);
+  large.size = 8 << 20;
+  EXPECT_EQ(policy.score(large), 9 * baseScore);
+
+  // Rarely read columns are less worth retaining.
+  auto rarelyRead = base;
+  rarelyRead.readPct = 10;
+  EXPECT_EQ(policy.score(rarelyRead), 10 * baseScore);
+  rarelyRead.readPct = 0;
+  EXPECT_EQ(policy.score(rarelyRead), 100 * baseScore);
+
+  auto probation = base;
+  probation.probation = true;
+  EXPECT_EQ(
+      policy.score(probation),
+      TinyLfuEvictionPolicy::kProbationFactor * baseScore);
+
+  // Frequently accessed keys are more worth retaining.
+  for (auto i = 0; i < 4; ++i) {
+    policy.recordAccess(base.hash);
+  }
+  EXPECT_EQ(policy.score(base), baseScore / 5);
+
+  // The score saturates below the value reserved for evictable entries.
+  auto old = rarelyRead;
+  old.hash = keyHash(2);
+  old.age = std::numeric_limits<int32_t>::max();
+  EXPECT_EQ(policy.score(old), std::numeric_limits<int32_t>::max() - 1);
+
+  // Negative age from wrap around counts as just used.
+  old.age = -1;
+  EXPECT_EQ(policy.score(old), 0);
+}
@@ -17,6 +17,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/tests/CacheTestUtil.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/common/memory/Memory.h"
@@ -24,6 +25,7 @@
 
 #include <fcntl.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/Random.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -97,7 +99,8 @@ class SsdFileTest : public testing::Test {
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
       bool disableFileCow = false,
-      uint64_t maxEntries = 0) {
+      uint64_t maxEntries = 0,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -107,7 +110,8 @@ class SsdFileTest : public testing::Test {
         checksumEnabled,
         checksumReadVerificationEnabled,
         maxEntries,
-        ssdExecutor());
+        ssdExecutor(),
+        compressionKind);
     ssdFile_ = std::make_unique<SsdFile>(config);
     if (ssdFile_ != nullptr) {
       ssdFileHelper_ =
@@ -141,6 +145,35 @@ class SsdFileTest : public testing::Test {
     }
   }
 
+  // Copies 'contents' into the memory of 'entry'.
+  static void setContents(
+      AsyncDataCacheEntry& entry,
+      const std::string& contents) {
+    auto& data = entry.data();
+    int64_t offset = 0;
+    for (auto i = 0; i < data.numRuns() && offset < contents.size(); ++i) {
+      const auto run = data.runAt(i);
+      const auto bytes =
+          std::min<int64_t>(run.numBytes(), contents.size() - offset);
+      ::memcpy(run.data<char>(), contents.data() + offset, bytes);
+      offset += bytes;
+    }
+  }
+
+  // Returns the first entry.size() bytes in the memory of 'entry'.
+  static std::string getContents(const AsyncDataCacheEntry& entry) {
+    std::string contents;
+    const auto& data = entry.data();
+    for (auto i = 0; i < data.numRuns() && contents.size() < entry.size();
+         ++i) {
+      const auto run = data.runAt(i);
+      const auto bytes =
+          std::min<int64_t>(run.numBytes(), entry.size() - contents.size());
+      contents.append(run.data<char>(), bytes);
+    }
+    return contents;
+  }
+
   // Checks that the contents are consistent with what is set in
   // initializeContents.
   static void checkContents(
@@ -1062,6 +1095,93 @@ TEST_F(SsdFileTest, evictlogFileErrorInjection) {
   ASSERT_GT(statsAfterRecovery.readCheckpointErrors, 0);
 }
 
+TEST_F(SsdFileTest, compression) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = SsdFile::kRegionSize;
+  const auto fileNameAlt = StringIdLease(fileIds(), "fileInStorageAlt");
+  FLAGS_velox_ssd_verify_write = true;
+  initializeCache(kSsdSize);
+
+  const std::vector<
+      std::pair<common::CompressionKind, folly::compression::CodecType>>
+      codecs = {
+          {common::CompressionKind_LZ4, folly::compression::CodecType::LZ4},
+          {common::CompressionKind_ZSTD, folly::compression::CodecType::ZSTD}};
+  uint64_t startOffset = 0;
+  for (const auto& [kind, codecType] : codecs) {
+    SCOPED_TRACE(common::compressionKindToString(kind));
+    if (!folly::compression::hasCodec(codecType)) {
+      continue;
+    }
+    startOffset += 100 * kMB;
+    initializeSsdFile(
+        kSsdSize, checkpointIntervalBytes, true, true, false, 0, kind);
+
+    // The entries of 'fileName_' compress well. The random entries of
+    // 'fileNameAlt' do not and are stored as is.
+    auto pins = makePins(fileName_.id(), startOffset, 4096, 256 << 10, 8 * kMB);
+    const auto numCompressible = pins.size();
+    folly::Random::DefaultGenerator rng(1);
+    std::vector<std::string> randomContents;
+    for (auto i = 0; i < 4; ++i) {
+      pins.push_back(cache_->findOrCreate(
+          RawFileCacheKey{fileNameAlt.id(), startOffset + i * 10'000},
+          10'000,
+          nullptr));
+      std::string contents(10'000, '\0');
+      for (auto& c : contents) {
+        c = folly::Random::rand32(rng);
+      }
+      setContents(*pins.back().entry(), contents);
+      randomContents.push_back(std::move(contents));
+    }
+    std::vector<std::string> expectedContents;
+    for (const auto& pin : pins) {
+      expectedContents.push_back(getContents(*pin.entry()));
+    }
+    ssdFile_->write(pins);
+
+    SsdCacheStats stats;
+    ssdFile_->updateStats(stats);
+    ASSERT_EQ(stats.entriesWritten, pins.size());
+    ASSERT_EQ(stats.entriesCompressed, numCompressible);
+    ASSERT_GT(stats.bytesSavedByCompression, 0);
+
+    auto checkLoad = [&]() {
+      std::vector<SsdPin> ssdPins;
+      for (const auto& pin : pins) {
+        ssdPins.push_back(ssdFile_->find(
+            RawFileCacheKey{
+                pin.entry()->key().fileNum.id(), pin.entry()->key().offset}));
+        ASSERT_FALSE(ssdPins.back().empty());
+        setContents(*pin.entry(), std::string(pin.entry()->size(), '\0'));
+      }
+      ssdFile_->load(ssdPins, pins);
+      for (auto i = 0; i < pins.size(); ++i) {
+        ASSERT_EQ(getContents(*pins[i].entry()), expectedContents[i]);
+      }
+    };
+    checkLoad();
+
+    // The compressed sizes are recovered from the checkpoint.
+    ssdFile_->checkpoint(true);
+    initializeSsdFile(
+        kSsdSize, checkpointIntervalBytes, true, true, false, 0, kind);
+    checkLoad();
+
+    // A checkpoint made with another compression is not used.
+    ssdFile_->checkpoint(true);
+    initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, true);
+    for (const auto& pin : pins) {
+      ASSERT_TRUE(ssdFile_
+                      ->find(RawFileCacheKey{
+                          pin.entry()->key().fileNum.id(),
+                          pin.entry()->key().offset})
+                      .empty());
+    }
+  }
+}
+
 TEST_F(SsdFileTest, maxEntriesLimit) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   constexpr uint64_t kMaxEntries = 100;
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/DecompressionAccelerator.h"
+
+#include <folly/Synchronized.h>
+
+namespace facebook::velox::common {
+
+namespace {
+folly::Synchronized<std::shared_ptr<DecompressionAccelerator>>&
+acceleratorSlot() {
+  static folly::Synchronized<std::shared_ptr<DecompressionAccelerator>> slot;
+  return slot;
+}
+} // namespace
+
+void registerDecompressionAccelerator(
+    std::shared_ptr<DecompressionAccelerator> accelerator) {
+  *acceleratorSlot().wlock() = std::move(accelerator);
+}
+
+std::shared_ptr<DecompressionAccelerator> decompressionAccelerator() {
+  return *acceleratorSlot().rlock();
+}
+
+std::vector<uint64_t> BatchDecompressor::decompress(
+    const std::vector<DecompressionRequest>& requests) {
+  std::vector<uint64_t> lengths(requests.size());
+  std::vector<std::optional<folly::SemiFuture<uint64_t>>> offloaded(
+      requests.size());
+
+  // Submit everything the device takes before decompressing anything on the
+  // CPU, so that the device and the CPU work at the same time.
+  if (accelerator_ != nullptr) {
+    for (auto i = 0; i < requests.size(); ++i) {
+      if (accelerator_->supports(requests[i].kind)) {
+        offloaded[i] = accelerator_->trySubmit(requests[i]);
+      }
+    }
+  }
+
+  for (auto i = 0; i < requests.size(); ++i) {
+    if (!offloaded[i].has_value()) {
+      lengths[i] = softwareDecompress_(requests[i]);
+      ++stats_.numSoftware;
+    }
+  }
+
+  for (auto i = 0; i < requests.size(); ++i) {
+    if (!offloaded[i].has_value()) {
+      continue;
+    }
+    auto result = std::move(offloaded[i].value()).getTry();
+    if (result.hasValue()) {
+      lengths[i] = result.value();
+      ++stats_.numOffloaded;
+    } else {
+      lengths[i] = softwareDecompress_(requests[i]);
+      ++stats_.numFailedOffloads;
+    }
+  }
+  return lengths;
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <folly/futures/Future.h>
+
+#include "velox/common/compression/Compression.h"
+
+namespace facebook::velox::common {
+
+/// A compressed block to be decompressed into 'output'.
+struct DecompressionRequest {
+  CompressionKind kind;
+  const uint8_t* input;
+  uint64_t inputLength;
+  uint8_t* output;
+  uint64_t outputLength;
+};
+
+/// A device that decompresses blocks off the CPU, e.g. Intel QAT or IAA.
+/// Implementations live outside of Velox next to the device libraries and
+/// are installed with registerDecompressionAccelerator(). Thread safe.
+class DecompressionAccelerator {
+ public:
+  virtual ~DecompressionAccelerator() = default;
+
+  virtual std::string_view name() const = 0;
+
+  /// Returns true if the device decompresses blocks of 'kind'.
+  virtual bool supports(CompressionKind kind) const = 0;
+
+  /// Queues 'request' on the device and returns a future of the decompressed
+  /// length. Returns std::nullopt without queueing if the device's queues are
+  /// full. The future is completed with an exception if the device cannot
+  /// decompress the block, e.g. because it uses a window the device does not
+  /// support. The buffers of 'request' must stay valid until the future
+  /// completes.
+  virtual std::optional<folly::SemiFuture<uint64_t>> trySubmit(
+      const DecompressionRequest& request) = 0;
+};
+
+/// Installs the process-wide accelerator. nullptr uninstalls it.
+void registerDecompressionAccelerator(
+    std::shared_ptr<DecompressionAccelerator> accelerator);
+
+/// Returns the process-wide accelerator, or nullptr if none is installed.
+std::shared_ptr<DecompressionAccelerator> decompressionAccelerator();
+
+/// Decompresses batches of blocks, e.g. the pages of a coalesced load,
+/// offloading as many as the accelerator accepts and decompressing the rest
+/// with 'softwareDecompress' while the device works. Blocks the device
+/// rejects or fails are decompressed in software, so the results do not
+/// depend on whether and how much the device is used. Not thread safe.
+class BatchDecompressor {
+ public:
+  /// Decompresses a block on the CPU and returns the decompressed length.
+  /// Throws on corrupt input.
+  using SoftwareDecompress =
+      std::function<uint64_t(const DecompressionRequest&)>;
+
+  struct Stats {
+    /// Blocks decompressed by the accelerator.
+    uint64_t numOffloaded{0};
+    /// Blocks decompressed in software because the accelerator was not
+    /// installed, did not support the kind or had its queues full.
+    uint64_t numSoftware{0};
+    /// Blocks decompressed in software after the accelerator failed them.
+    uint64_t numFailedOffloads{0};
+  };
+
+  BatchDecompressor(
+      SoftwareDecompress softwareDecompress,
+      std::shared_ptr<DecompressionAccelerator> accelerator =
+          decompressionAccelerator())
+      : softwareDecompress_(std::move(softwareDecompress)),
+        accelerator_(std::move(accelerator)) {}
+
+  /// Decompresses 'requests' and returns their decompressed lengths in the
+  /// same order.
+  std::vector<uint64_t> decompress(
+      const std::vector<DecompressionRequest>& requests);
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+ private:
+  const SoftwareDecompress softwareDecompress_;
+  const std::shared_ptr<DecompressionAccelerator> accelerator_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::common
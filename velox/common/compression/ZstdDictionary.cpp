@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/ZstdDictionary.h"
+
+#ifdef VELOX_ENABLE_ZSTD_DICTIONARY
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::common {
+
+#ifdef VELOX_ENABLE_ZSTD_DICTIONARY
+
+bool ZstdDictionary::supported() {
+  return true;
+}
+
+std::string ZstdDictionary::train(
+    const std::vector<std::string_view>& samples,
+    size_t maxSize) {
+  std::string buffer;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    buffer.append(sample);
+    sampleSizes.push_back(sample.size());
+  }
+  std::string dictionary(maxSize, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      dictionary.data(),
+      dictionary.size(),
+      buffer.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    return "";
+  }
+  dictionary.resize(size);
+  return dictionary;
+}
+
+ZstdDictionary::ZstdDictionary(std::string dictionary, int32_t compressionLevel)
+    : dictionary_(std::move(dictionary)), compressionLevel_(compressionLevel) {}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCCtx(cctx_);
+  ZSTD_freeDCtx(dctx_);
+  ZSTD_freeCDict(cdict_);
+  ZSTD_freeDDict(ddict_);
+}
+
+size_t ZstdDictionary::maxCompressedLength(size_t inputLength) const {
+  return ZSTD_compressBound(inputLength);
+}
+
+size_t ZstdDictionary::compress(
+    const char* input,
+    size_t inputLength,
+    char* output,
+    size_t outputLength) {
+  if (cctx_ == nullptr) {
+    cctx_ = ZSTD_createCCtx();
+    VELOX_CHECK_NOT_NULL(cctx_);
+    if (!dictionary_.empty()) {
+      cdict_ = ZSTD_createCDict(
+          dictionary_.data(), dictionary_.size(), compressionLevel_);
+      VELOX_CHECK_NOT_NULL(cdict_);
+    }
+  }
+  const auto size = cdict_ != nullptr
+      ? ZSTD_compress_usingCDict(
+            cctx_, output, outputLength, input, inputLength, cdict_)
+      : ZSTD_compressCCtx(
+            cctx_, output, outputLength, input, inputLength, compressionLevel_);
+  VELOX_CHECK(
+      !ZSTD_isError(size),
+      "ZSTD compression failed: {}",
+      ZSTD_getErrorName(size));
+  return size;
+}
+
+void ZstdDictionary::decompress(
+    const char* input,
+    size_t inputLength,
+    char* output,
+    size_t outputLength) {
+  if (dctx_ == nullptr) {
+    dctx_ = ZSTD_createDCtx();
+    VELOX_CHECK_NOT_NULL(dctx_);
+    if (!dictionary_.empty()) {
+      ddict_ = ZSTD_createDDict(dictionary_.data(), dictionary_.size());
+      VELOX_CHECK_NOT_NULL(ddict_);
+    }
+  }
+  const auto size = ddict_ != nullptr
+      ? ZSTD_decompress_usingDDict(
+            dctx_, output, outputLength, input, inputLength, ddict_)
+      : ZSTD_decompressDCtx(dctx_, output, outputLength, input, inputLength);
+  VELOX_CHECK(
+      !ZSTD_isError(size),
+      "ZSTD decompression failed: {}",
+      ZSTD_getErrorName(size));
+  VELOX_CHECK_EQ(size, outputLength, "Unexpected ZSTD decompressed size");
+}
+
+#else
+
+bool ZstdDictionary::supported() {
+  return false;
+}
+
+std::string ZstdDictionary::train(
+    const std::vector<std::string_view>& /*samples*/,
+    size_t /*maxSize*/) {
+  VELOX_UNSUPPORTED("Velox is built without ZSTD");
+}
+
+ZstdDictionary::ZstdDictionary(std::string dictionary, int32_t compressionLevel)
+    : dictionary_(std::move(dictionary)), compressionLevel_(compressionLevel) {
+  VELOX_UNSUPPORTED("Velox is built without ZSTD");
+}
+
+ZstdDictionary::~ZstdDictionary() = default;
+
+size_t ZstdDictionary::maxCompressedLength(size_t /*inputLength*/) const {
+  VELOX_UNSUPPORTED("Velox is built without ZSTD");
+}
+
+size_t ZstdDictionary::compress(
+    const char* /*input*/,
+    size_t /*inputLength*/,
+    char* /*output*/,
+    size_t /*outputLength*/) {
+  VELOX_UNSUPPORTED("Velox is built without ZSTD");
+}
+
+void ZstdDictionary::decompress(
+    const char* /*input*/,
+    size_t /*inputLength*/,
+    char* /*output*/,
+    size_t /*outputLength*/) {
+  VELOX_UNSUPPORTED("Velox is built without ZSTD");
+}
+
+#endif
+} // namespace facebook::velox::common
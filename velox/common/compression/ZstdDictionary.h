@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace facebook::velox::common {
+
+/// Compresses and decompresses many small, similar payloads with a ZSTD
+/// dictionary trained from samples of them. Each payload is a self-contained
+/// ZSTD frame that needs the same dictionary to be decompressed. Without a
+/// dictionary, a small payload compresses poorly because each frame starts
+/// with no history. The dictionary is created once and shared by all the
+/// frames, so it needs to be shipped only once per stream or file.
+///
+/// Not thread safe: the compression and decompression contexts are reused.
+class ZstdDictionary {
+ public:
+  /// Returns true if Velox is built with ZSTD. Otherwise, the other methods
+  /// throw.
+  static bool supported();
+
+  /// Trains a dictionary of at most 'maxSize' bytes from 'samples'. Returns
+  /// an empty string if the samples are too few or too small to train from.
+  /// An empty dictionary is valid and compresses without one.
+  static std::string train(
+      const std::vector<std::string_view>& samples,
+      size_t maxSize);
+
+  /// Creates a codec over 'dictionary'. 'compressionLevel' is the ZSTD
+  /// compression level, only used for compression.
+  ZstdDictionary(std::string dictionary, int32_t compressionLevel);
+
+  ~ZstdDictionary();
+
+  ZstdDictionary(const ZstdDictionary&) = delete;
+  ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+  const std::string& dictionary() const {
+    return dictionary_;
+  }
+
+  /// Returns the maximum compressed size of 'inputLength' bytes.
+  size_t maxCompressedLength(size_t inputLength) const;
+
+  /// Compresses 'inputLength' bytes of 'input' into 'output' of
+  /// 'outputLength' bytes and returns the compressed size. 'outputLength'
+  /// must be at least maxCompressedLength(inputLength).
+  size_t compress(
+      const char* input,
+      size_t inputLength,
+      char* output,
+      size_t outputLength);
+
+  /// Decompresses the frame of 'inputLength' bytes in 'input' into 'output'.
+  /// Throws if the decompressed size differs from 'outputLength'.
+  void decompress(
+      const char* input,
+      size_t inputLength,
+      char* output,
+      size_t outputLength);
+
+ private:
+  const std::string dictionary_;
+  const int32_t compressionLevel_;
+
+  // Created on first use so that a reader does not allocate the compression
+  // state and vice versa. The digested dictionaries are null if
+  // 'dictionary_' is empty.
+  ZSTD_CCtx_s* cctx_{nullptr};
+  ZSTD_DCtx_s* dctx_{nullptr};
+  ZSTD_CDict_s* cdict_{nullptr};
+  ZSTD_DDict_s* ddict_{nullptr};
+};
+} // namespace facebook::velox::common
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/DecompressionAccelerator.h"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::common {
+namespace {
+
+// Copies the input as if it were decompressed. Accepts up to 'capacity'
+// requests and fails the ones whose first byte is 'failByte'.
+class FakeAccelerator : public DecompressionAccelerator {
+ public:
+  explicit FakeAccelerator(int32_t capacity, uint8_t failByte = 0xff)
+      : capacity_(capacity), failByte_(failByte) {}
+
+  std::string_view name() const override {
+    return "fake";
+  }
+
+  bool supports(CompressionKind kind) const override {
+    return kind == CompressionKind_ZSTD;
+  }
+
+  std::optional<folly::SemiFuture<uint64_t>> trySubmit(
+      const DecompressionRequest& request) override {
+    if (capacity_ == 0) {
+      return std::nullopt;
+    }
+    --capacity_;
+    if (request.input[0] == failByte_) {
+      return folly::makeSemiFuture<uint64_t>(
+          std::runtime_error("Unsupported block"));
+    }
+    std::memcpy(request.output, request.input, request.inputLength);
+    return folly::makeSemiFuture<uint64_t>(request.inputLength);
+  }
+
+ private:
+  int32_t capacity_;
+  const uint8_t failByte_;
+};
+
+uint64_t copyDecompress(const DecompressionRequest& request) {
+  VELOX_CHECK_LE(request.inputLength, request.outputLength);
+  std::memcpy(request.output, request.input, request.inputLength);
+  return request.inputLength;
+}
+
+class DecompressionAcceleratorTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (auto i = 0; i < kNumBlocks; ++i) {
+      inputs_.push_back(std::vector<uint8_t>(10 + i, i));
+      outputs_.push_back(std::vector<uint8_t>(100));
+    }
+  }
+
+  std::vector<DecompressionRequest> makeRequests(CompressionKind kind) {
+    std::vector<DecompressionRequest> requests;
+    for (auto i = 0; i < kNumBlocks; ++i) {
+      requests.push_back(
+          {kind,
+           inputs_[i].data(),
+           inputs_[i].size(),
+           outputs_[i].data(),
+           outputs_[i].size()});
+    }
+    return requests;
+  }
+
+  void verifyOutputs(const std::vector<uint64_t>& lengths) {
+    ASSERT_EQ(lengths.size(), kNumBlocks);
+    for (auto i = 0; i < kNumBlocks; ++i) {
+      ASSERT_EQ(lengths[i], inputs_[i].size());
+      ASSERT_EQ(
+          0, std::memcmp(outputs_[i].data(), inputs_[i].data(), lengths[i]));
+    }
+  }
+
+  static constexpr int32_t kNumBlocks = 5;
+  std::vector<std::vector<uint8_t>> inputs_;
+  std::vector<std::vector<uint8_t>> outputs_;
+};
+
+TEST_F(DecompressionAcceleratorTest, noAccelerator) {
+  BatchDecompressor decompressor(copyDecompress, nullptr);
+  verifyOutputs(decompressor.decompress(makeRequests(CompressionKind_ZSTD)));
+  EXPECT_EQ(decompressor.stats().numSoftware, kNumBlocks);
+  EXPECT_EQ(decompressor.stats().numOffloaded, 0);
+}
+
+TEST_F(DecompressionAcceleratorTest, saturated) {
+  BatchDecompressor decompressor(
+      copyDecompress, std::make_shared<FakeAccelerator>(2));
+  verifyOutputs(decompressor.decompress(makeRequests(CompressionKind_ZSTD)));
+  EXPECT_EQ(decompressor.stats().numOffloaded, 2);
+  EXPECT_EQ(decompressor.stats().numSoftware, kNumBlocks - 2);
+  EXPECT_EQ(decompressor.stats().numFailedOffloads, 0);
+}
+
+TEST_F(DecompressionAcceleratorTest, unsupportedKind) {
+  BatchDecompressor decompressor(
+      copyDecompress, std::make_shared<FakeAccelerator>(kNumBlocks));
+  verifyOutputs(decompressor.decompress(makeRequests(CompressionKind_SNAPPY)));
+  EXPECT_EQ(decompressor.stats().numOffloaded, 0);
+  EXPECT_EQ(decompressor.stats().numSoftware, kNumBlocks);
+}
+
+TEST_F(DecompressionAcceleratorTest, failedOffload) {
+  // The block of byte 1 is failed by the device.
+  BatchDecompressor decompressor(
+      copyDecompress, std::make_shared<FakeAccelerator>(kNumBlocks, 1));
+  verifyOutputs(decompressor.decompress(makeRequests(CompressionKind_ZSTD)));
+  EXPECT_EQ(decompressor.stats().numOffloaded, kNumBlocks - 1);
+  EXPECT_EQ(decompressor.stats().numFailedOffloads, 1);
+  EXPECT_EQ(decompressor.stats().numSoftware, 0);
+}
+
+TEST_F(DecompressionAcceleratorTest, registry) {
+  EXPECT_EQ(decompressionAccelerator(), nullptr);
+  auto accelerator = std::make_shared<FakeAccelerator>(1);
+  registerDecompressionAccelerator(accelerator);
+  EXPECT_EQ(decompressionAccelerator(), accelerator);
+
+  BatchDecompressor decompressor(copyDecompress);
+  verifyOutputs(decompressor.decompress(makeRequests(CompressionKind_ZSTD)));
+  EXPECT_EQ(decompressor.stats().numOffloaded, 1);
+
+  registerDecompressionAccelerator(nullptr);
+  EXPECT_EQ(decompressionAccelerator(), nullptr);
+}
+
+} // namespace
+} // namespace facebook::velox::common
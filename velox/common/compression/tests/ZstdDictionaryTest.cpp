@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/ZstdDictionary.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace facebook::velox::common {
+namespace {
+
+class ZstdDictionaryTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    if (!ZstdDictionary::supported()) {
+      GTEST_SKIP() << "Built without ZSTD";
+    }
+  }
+
+  // Returns a small payload that shares most of its content with the other
+  // payloads.
+  static std::string makePayload(int32_t i) {
+    std::string payload;
+    for (auto row = 0; row < 20; ++row) {
+      payload += fmt::format(
+          "{{\"id\":{},\"status\":\"shipped\",\"region\":\"region-{}\"}}",
+          i * 20 + row,
+          row % 5);
+    }
+    return payload;
+  }
+};
+
+TEST_F(ZstdDictionaryTest, roundTrip) {
+  std::vector<std::string> payloads;
+  for (auto i = 0; i < 200; ++i) {
+    payloads.push_back(makePayload(i));
+  }
+  const std::vector<std::string_view> samples(
+      payloads.begin(), payloads.end());
+  auto dictionary = ZstdDictionary::train(samples, 4 << 10);
+  ASSERT_FALSE(dictionary.empty());
+  ASSERT_LE(dictionary.size(), 4 << 10);
+
+  ZstdDictionary withDictionary(dictionary, 1);
+  ZstdDictionary withoutDictionary("", 1);
+  ZstdDictionary reader(dictionary, 1);
+  const auto payload = makePayload(1'000);
+  std::string compressed(withDictionary.maxCompressedLength(payload.size()), 0);
+  const auto compressedSize = withDictionary.compress(
+      payload.data(), payload.size(), compressed.data(), compressed.size());
+  const auto sizeWithoutDictionary = withoutDictionary.compress(
+      payload.data(), payload.size(), compressed.data(), compressed.size());
+  ASSERT_LT(compressedSize, sizeWithoutDictionary);
+
+  // Compresses again as 'compressed' is overwritten above.
+  withDictionary.compress(
+      payload.data(), payload.size(), compressed.data(), compressed.size());
+  std::string decompressed(payload.size(), 0);
+  reader.decompress(
+      compressed.data(), compressedSize, decompressed.data(), payload.size());
+  ASSERT_EQ(decompressed, payload);
+
+  // The decompressed size is checked.
+  std::string tooLarge(payload.size() + 1, 0);
+  ASSERT_ANY_THROW(reader.decompress(
+      compressed.data(), compressedSize, tooLarge.data(), tooLarge.size()));
+}
+
+TEST_F(ZstdDictionaryTest, emptyDictionary) {
+  ASSERT_TRUE(ZstdDictionary::train({"a", "b"}, 4 << 10).empty());
+
+  ZstdDictionary codec("", 1);
+  const auto payload = makePayload(0);
+  std::string compressed(codec.maxCompressedLength(payload.size()), 0);
+  const auto compressedSize = codec.compress(
+      payload.data(), payload.size(), compressed.data(), compressed.size());
+  std::string decompressed(payload.size(), 0);
+  codec.decompress(
+      compressed.data(), compressedSize, decompressed.data(), payload.size());
+  ASSERT_EQ(decompressed, payload);
+}
+} // namespace
+} // namespace facebook::velox::common
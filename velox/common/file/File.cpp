@@ -172,8 +172,9 @@ uint64_t InMemoryWriteFile::size() const {
 LocalReadFile::LocalReadFile(
     std::string_view path,
     folly::Executor* executor,
-    bool bufferIo)
-    : executor_(executor), path_(path) {
+    bool bufferIo,
+    IoUring* ioUring)
+    : executor_(executor), ioUring_(ioUring), path_(path) {
   int32_t flags = O_RDONLY;
 #ifdef linux
   if (!bufferIo) {
@@ -203,8 +204,11 @@ LocalReadFile::LocalReadFile(
   size_ = ret;
 }
 
-LocalReadFile::LocalReadFile(int32_t fd, folly::Executor* executor)
-    : executor_(executor), fd_(fd) {}
+LocalReadFile::LocalReadFile(
+    int32_t fd,
+    folly::Executor* executor,
+    IoUring* ioUring)
+    : executor_(executor), ioUring_(ioUring), fd_(fd) {}
 
 LocalReadFile::~LocalReadFile() {
   const int ret = close(fd_);
@@ -297,6 +301,9 @@ folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers,
     const FileIoContext& context) const {
+  if (ioUring_) {
+    return preadvIoUring(offset, buffers);
+  }
   if (!executor_) {
     return ReadFile::preadvAsync(offset, buffers, context);
   }
@@ -312,6 +319,40 @@ folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
   return std::move(future);
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvIoUring(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  // Each run of consecutive buffers with data is one read. A dropped range
+  // only moves the offset of the next read.
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+  std::vector<struct iovec> iovecs;
+  uint64_t position = offset;
+  uint64_t readOffset = offset;
+  auto submit = [&]() {
+    if (!iovecs.empty()) {
+      reads.push_back(ioUring_->preadv(fd_, readOffset, std::move(iovecs)));
+      iovecs.clear();
+    }
+  };
+  for (const auto& range : buffers) {
+    if (!range.data() || iovecs.size() >= IOV_MAX) {
+      submit();
+    }
+    if (range.data()) {
+      if (iovecs.empty()) {
+        readOffset = position;
+      }
+      iovecs.push_back({range.data(), range.size()});
+    }
+    position += range.size();
+  }
+  submit();
+  return folly::collect(std::move(reads))
+      .deferValue([totalBytes = position - offset](auto&& /*unused*/) {
+        return totalBytes;
+      });
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
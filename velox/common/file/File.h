@@ -45,6 +45,7 @@
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileIoTracer.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/file/Region.h"
 #include "velox/common/io/IoStatistics.h"
 
@@ -331,14 +332,20 @@ class InMemoryWriteFile final : public WriteFile {
 /// files match against any filepath starting with '/'.
 class LocalReadFile final : public ReadFile {
  public:
+  /// If 'ioUring' is set, preadvAsync() submits the reads to it instead of
+  /// running preadv() on 'executor'.
   LocalReadFile(
       std::string_view path,
       folly::Executor* executor = nullptr,
-      bool bufferIo = true);
+      bool bufferIo = true,
+      IoUring* ioUring = nullptr);
 
   /// TODO: deprecate this after creating local file all through velox fs
   /// interface.
-  LocalReadFile(int32_t fd, folly::Executor* executor = nullptr);
+  LocalReadFile(
+      int32_t fd,
+      folly::Executor* executor = nullptr,
+      IoUring* ioUring = nullptr);
 
   ~LocalReadFile();
 
@@ -361,7 +368,7 @@ class LocalReadFile final : public ReadFile {
       const FileIoContext& context = {}) const override;
 
   bool hasPreadvAsync() const override {
-    return executor_ != nullptr;
+    return executor_ != nullptr || ioUring_ != nullptr;
   }
 
   uint64_t memoryUsage() const final;
@@ -384,7 +391,14 @@ class LocalReadFile final : public ReadFile {
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
+  // Reads 'buffers' with 'ioUring_'. Ranges without data are skipped instead
+  // of being read into a scratch buffer.
+  folly::SemiFuture<uint64_t> preadvIoUring(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const;
+
   folly::Executor* const executor_;
+  IoUring* const ioUring_;
   std::string path_;
   int32_t fd_;
   long size_;
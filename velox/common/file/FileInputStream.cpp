@@ -21,12 +21,16 @@ namespace facebook::velox::common {
 FileInputStream::FileInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    folly::Executor* readAheadExecutor)
     : file_(std::move(file)),
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize)),
       pool_(pool),
-      readAheadEnabled_((bufferSize_ < fileSize_) && file_->hasPreadvAsync()) {
+      readAheadExecutor_(readAheadExecutor),
+      readAheadEnabled_(
+          (bufferSize_ < fileSize_) &&
+          (file_->hasPreadvAsync() || readAheadExecutor_ != nullptr)) {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK_GT(fileSize_, 0, "Empty FileInputStream");
 
@@ -216,7 +220,19 @@ void FileInputStream::maybeIssueReadahead() {
   }
   std::vector<folly::Range<char*>> ranges;
   ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
-  readAheadWait_ = file_->preadvAsync(fileOffset_, ranges);
+  if (file_->hasPreadvAsync()) {
+    readAheadWait_ = file_->preadvAsync(fileOffset_, ranges);
+  } else {
+    // The destructor waits for the read-ahead so 'file_' and the buffer
+    // outlive the read.
+    readAheadWait_ =
+        folly::via(
+            readAheadExecutor_,
+            [file = file_.get(), offset = fileOffset_, ranges]() {
+              return file->preadv(offset, ranges);
+            })
+            .semi();
+  }
   VELOX_CHECK(readAheadWait_.valid());
 }
 
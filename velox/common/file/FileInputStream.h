@@ -27,10 +27,16 @@ namespace facebook::velox::common {
 /// Readonly byte input stream backed by file.
 class FileInputStream : public ByteInputStream {
  public:
+  /// Reads 'file' 'bufferSize' bytes at a time into buffers allocated from
+  /// 'pool'. If the file supports async read or 'readAheadExecutor' is set,
+  /// the next buffer is read ahead while the current one is consumed. The
+  /// read-ahead is done on 'readAheadExecutor' if the file does not support
+  /// async read.
   FileInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* readAheadExecutor = nullptr);
 
   ~FileInputStream() override;
 
@@ -77,10 +83,8 @@ class FileInputStream : public ByteInputStream {
   // Invoked to read the next byte range from the file in a buffer.
   void readNextRange();
 
-  // Issues readahead if underlying file system supports async mode read.
-  //
-  // TODO: we might consider to use AsyncSource to support read-ahead on
-  // filesystem which doesn't support async mode read.
+  // Issues readahead if underlying file system supports async mode read or
+  // 'readAheadExecutor_' is set.
   void maybeIssueReadahead();
 
   inline uint64_t readSize() const;
@@ -112,6 +116,7 @@ class FileInputStream : public ByteInputStream {
   const uint64_t fileSize_;
   const uint64_t bufferSize_;
   memory::MemoryPool* const pool_;
+  folly::Executor* const readAheadExecutor_;
   const bool readAheadEnabled_;
 
   // Offset of the next byte to read from file.
@@ -94,7 +94,8 @@ class LocalFileSystem : public FileSystem {
                               folly::available_concurrency() / 2)),
                       std::make_shared<folly::NamedThreadFactory>(
                           "LocalReadahead"))
-                : nullptr) {}
+                : nullptr),
+        ioUring_(options.ioUringEnabled ? IoUring::instance() : nullptr) {}
 
   ~LocalFileSystem() override {
     if (executor_) {
@@ -118,7 +119,7 @@ class LocalFileSystem : public FileSystem {
       std::string_view path,
       const FileOptions& options) override {
     return std::make_unique<LocalReadFile>(
-        extractPath(path), executor_.get(), options.bufferIo);
+        extractPath(path), executor_.get(), options.bufferIo, ioUring_);
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
@@ -252,6 +253,7 @@ class LocalFileSystem : public FileSystem {
 
  private:
   const std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  IoUring* const ioUring_;
 };
 } // namespace
 
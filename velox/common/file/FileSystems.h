@@ -110,6 +110,12 @@ struct FileSystemOptions {
   /// async read by using a background cpu executor. Some filesystem might has
   /// native async read-ahead support.
   bool readAheadEnabled{false};
+
+  /// If true and the kernel supports it, the local file system reads files
+  /// asynchronously through a process wide io_uring. Many reads can then be
+  /// outstanding without an executor thread blocking on each. Takes precedence
+  /// over 'readAheadEnabled' for async reads.
+  bool ioUringEnabled{false};
 };
 
 /// An abstract FileSystem
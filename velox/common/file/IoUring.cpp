@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <folly/String.h>
+#include <glog/logging.h>
+#include <cstring>
+
+#include "velox/common/base/Exceptions.h"
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __linux__
+
+namespace facebook::velox {
+
+struct IoUring::Request {
+  int32_t fd;
+  // File offset of the first byte not yet read.
+  uint64_t offset;
+  std::vector<struct iovec> iovecs;
+  // Index of the first element of 'iovecs' not completely read.
+  size_t firstIovec{0};
+  uint64_t bytesRead{0};
+  folly::Promise<uint64_t> promise;
+};
+
+namespace {
+
+void failRequest(folly::Promise<uint64_t>& promise, const std::string& error) {
+  try {
+    VELOX_FAIL("io_uring read failed: {}", error);
+  } catch (const std::exception&) {
+    promise.setException(folly::exception_wrapper(std::current_exception()));
+  }
+}
+
+} // namespace
+
+#ifdef __linux__
+
+namespace {
+
+int32_t ioUringSetup(uint32_t numEntries, struct io_uring_params* params) {
+  return syscall(__NR_io_uring_setup, numEntries, params);
+}
+
+int32_t ioUringEnter(
+    int32_t ringFd,
+    uint32_t toSubmit,
+    uint32_t minComplete,
+    uint32_t flags) {
+  return syscall(
+      __NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0);
+}
+
+void* mapRing(int32_t ringFd, size_t size, uint64_t offset) {
+  void* ring = mmap(
+      nullptr,
+      size,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      ringFd,
+      offset);
+  VELOX_CHECK(
+      ring != MAP_FAILED, "io_uring mmap failed: {}", folly::errnoStr(errno));
+  return ring;
+}
+
+template <typename T>
+T* ringPointer(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+} // namespace
+
+IoUring::IoUring(uint32_t numEntries) {
+  struct io_uring_params params {};
+  ringFd_ = ioUringSetup(numEntries, &params);
+  VELOX_CHECK_GE(
+      ringFd_, 0, "io_uring_setup failed: {}", folly::errnoStr(errno));
+  try {
+    numEntries_ = params.sq_entries;
+    // One completion is reserved for the wakeup at destruction.
+    maxInflight_ = params.cq_entries - 1;
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cqRingSize_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+      sqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+      cqRingSize_ = 0;
+    }
+    sqRing_ = mapRing(ringFd_, sqRingSize_, IORING_OFF_SQ_RING);
+    cqRing_ = singleMmap ? sqRing_
+                         : mapRing(ringFd_, cqRingSize_, IORING_OFF_CQ_RING);
+    sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes_ = mapRing(ringFd_, sqesSize_, IORING_OFF_SQES);
+  } catch (const std::exception&) {
+    release();
+    throw;
+  }
+
+  sqHead_ = ringPointer<uint32_t>(sqRing_, params.sq_off.head);
+  sqTail_ = ringPointer<uint32_t>(sqRing_, params.sq_off.tail);
+  sqMask_ = *ringPointer<uint32_t>(sqRing_, params.sq_off.ring_mask);
+  sqArray_ = ringPointer<uint32_t>(sqRing_, params.sq_off.array);
+  cqHead_ = ringPointer<uint32_t>(cqRing_, params.cq_off.head);
+  cqTail_ = ringPointer<uint32_t>(cqRing_, params.cq_off.tail);
+  cqMask_ = *ringPointer<uint32_t>(cqRing_, params.cq_off.ring_mask);
+  cqes_ = ringPointer<void>(cqRing_, params.cq_off.cqes);
+
+  reaper_ = std::thread([this]() { reapLoop(); });
+}
+
+IoUring::~IoUring() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stopping_ = true;
+    const auto error = enterLocked(nullptr);
+    if (error != 0) {
+      // The reaper cannot be woken up. Leave the ring to it.
+      LOG(ERROR) << "Failed to stop io_uring: " << strerror(-error);
+      reaper_.detach();
+      return;
+    }
+  }
+  reaper_.join();
+  release();
+}
+
+void IoUring::release() {
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqesSize_);
+  }
+  if (cqRing_ != nullptr && cqRing_ != sqRing_) {
+    munmap(cqRing_, cqRingSize_);
+  }
+  if (sqRing_ != nullptr) {
+    munmap(sqRing_, sqRingSize_);
+  }
+  if (ringFd_ >= 0) {
+    close(ringFd_);
+  }
+}
+
+// static
+bool IoUring::isSupported() {
+  static const bool supported = []() {
+    struct io_uring_params params {};
+    const auto fd = ioUringSetup(1, &params);
+    if (fd < 0) {
+      LOG(INFO) << "io_uring is not supported: " << folly::errnoStr(errno);
+      return false;
+    }
+    close(fd);
+    return true;
+  }();
+  return supported;
+}
+
+folly::SemiFuture<uint64_t> IoUring::preadv(
+    int32_t fd,
+    uint64_t offset,
+    std::vector<struct iovec> iovecs) {
+  auto request = std::make_unique<Request>();
+  request->fd = fd;
+  request->offset = offset;
+  request->iovecs = std::move(iovecs);
+  auto future = request->promise.getSemiFuture();
+  if (request->iovecs.empty()) {
+    request->promise.setValue(0);
+    return future;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!stopping_, "io_uring is stopping");
+  submitLocked(std::move(request));
+  return future;
+}
+
+void IoUring::submitLocked(std::unique_ptr<Request> request) {
+  if (numInflight_ >= maxInflight_) {
+    pending_.push_back(std::move(request));
+    return;
+  }
+  const auto error = enterLocked(request.get());
+  if (error != 0) {
+    failRequest(request->promise, strerror(-error));
+    return;
+  }
+  ++numInflight_;
+  // Owned by the kernel until its completion is reaped.
+  request.release();
+}
+
+int32_t IoUring::enterLocked(Request* request) {
+  const uint32_t tail = *sqTail_;
+  const uint32_t index = tail & sqMask_;
+  auto* sqe = static_cast<struct io_uring_sqe*>(sqes_) + index;
+  memset(sqe, 0, sizeof(*sqe));
+  if (request != nullptr) {
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = request->fd;
+    sqe->off = request->offset;
+    const auto* iovecs = request->iovecs.data() + request->firstIovec;
+    sqe->addr = reinterpret_cast<uint64_t>(iovecs);
+    sqe->len = request->iovecs.size() - request->firstIovec;
+  } else {
+    sqe->opcode = IORING_OP_NOP;
+  }
+  sqe->user_data = reinterpret_cast<uint64_t>(request);
+  sqArray_[index] = index;
+  __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+
+  int32_t submitted;
+  do {
+    submitted = ioUringEnter(ringFd_, 1, 0, 0);
+  } while (submitted < 0 && errno == EINTR);
+  if (submitted == 1) {
+    return 0;
+  }
+  const int32_t error = submitted < 0 ? errno : EAGAIN;
+  // Take back the entry if the kernel did not consume it.
+  if (__atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) == tail) {
+    __atomic_store_n(sqTail_, tail, __ATOMIC_RELEASE);
+  }
+  return -error;
+}
+
+void IoUring::complete(Request* request, int32_t result) {
+  if (result > 0) {
+    request->bytesRead += result;
+    request->offset += result;
+    uint64_t consumed = result;
+    auto& iovecs = request->iovecs;
+    while (request->firstIovec < iovecs.size() &&
+           consumed >= iovecs[request->firstIovec].iov_len) {
+      consumed -= iovecs[request->firstIovec].iov_len;
+      ++request->firstIovec;
+    }
+    if (request->firstIovec < iovecs.size()) {
+      // Short read. Read the rest.
+      auto& iov = iovecs[request->firstIovec];
+      iov.iov_base = static_cast<char*>(iov.iov_base) + consumed;
+      iov.iov_len -= consumed;
+      std::lock_guard<std::mutex> l(mutex_);
+      result = enterLocked(request);
+      if (result == 0) {
+        return;
+      }
+    }
+  }
+
+  std::unique_ptr<Request> finished(request);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    --numInflight_;
+    while (!pending_.empty() && numInflight_ < maxInflight_) {
+      auto next = std::move(pending_.front());
+      pending_.pop_front();
+      submitLocked(std::move(next));
+    }
+  }
+  if (result < 0) {
+    failRequest(finished->promise, strerror(-result));
+  } else if (finished->firstIovec < finished->iovecs.size()) {
+    failRequest(
+        finished->promise,
+        fmt::format(
+            "read past end of file at offset {} on fd {}",
+            finished->offset,
+            finished->fd));
+  } else {
+    finished->promise.setValue(finished->bytesRead);
+  }
+}
+
+void IoUring::reapLoop() {
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (stopping_ && numInflight_ == 0) {
+        return;
+      }
+    }
+    const auto ret = ioUringEnter(ringFd_, 0, 1, IORING_ENTER_GETEVENTS);
+    if (ret < 0 && errno != EINTR) {
+      LOG(ERROR) << "io_uring_enter failed: " << folly::errnoStr(errno);
+    }
+    // The reaper is the only consumer of completions.
+    uint32_t head = *cqHead_;
+    const uint32_t tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      const auto* cqe =
+          static_cast<struct io_uring_cqe*>(cqes_) + (head & cqMask_);
+      auto* request = reinterpret_cast<Request*>(cqe->user_data);
+      if (request != nullptr) {
+        complete(request, cqe->res);
+      }
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+  }
+}
+
+#else
+
+IoUring::IoUring(uint32_t /*numEntries*/) {
+  VELOX_UNSUPPORTED("io_uring is only supported on Linux");
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::release() {}
+
+// static
+bool IoUring::isSupported() {
+  return false;
+}
+
+folly::SemiFuture<uint64_t> IoUring::preadv(
+    int32_t /*fd*/,
+    uint64_t /*offset*/,
+    std::vector<struct iovec> /*iovecs*/) {
+  VELOX_UNSUPPORTED("io_uring is only supported on Linux");
+}
+
+void IoUring::submitLocked(std::unique_ptr<Request> /*request*/) {}
+
+int32_t IoUring::enterLocked(Request* /*request*/) {
+  return 0;
+}
+
+void IoUring::complete(Request* /*request*/, int32_t /*result*/) {}
+
+void IoUring::reapLoop() {}
+
+#endif // __linux__
+
+// static
+IoUring* IoUring::instance() {
+  // Leaked so that reads in flight at process exit do not race with static
+  // destruction.
+  static IoUring* ring = isSupported() ? new IoUring() : nullptr;
+  return ring;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <folly/futures/Future.h>
+
+namespace facebook::velox {
+
+/// Asynchronous reads of local files through a Linux io_uring. The reads of
+/// all threads are submitted to one shared ring and a background thread reaps
+/// the completions and fulfills the futures of the reads. This way, many reads
+/// are outstanding at the device without an executor thread blocking on each.
+/// The ring is set up with the raw system calls and does not depend on
+/// liburing.
+class IoUring {
+ public:
+  static constexpr uint32_t kDefaultNumEntries = 256;
+
+  /// Creates a ring with 'numEntries' submission queue entries. Throws if the
+  /// kernel does not support io_uring.
+  explicit IoUring(uint32_t numEntries = kDefaultNumEntries);
+
+  /// Waits for the outstanding reads to complete.
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  /// Returns true if io_uring is available, i.e. the platform is Linux, the
+  /// kernel supports io_uring and it is not disabled for the process.
+  static bool isSupported();
+
+  /// Returns the process wide ring, creating it on first use. Returns nullptr
+  /// if io_uring is not supported.
+  static IoUring* instance();
+
+  /// Reads into 'iovecs' from 'fd' starting at 'offset'. The returned future
+  /// is set to the number of bytes read once all of 'iovecs' are filled, or
+  /// to an exception if the read fails or reaches the end of the file. The
+  /// memory of 'iovecs' must stay valid until the future is set. Buffers for
+  /// files opened with O_DIRECT must have the alignment required by the file
+  /// system, as for preadv(2).
+  folly::SemiFuture<uint64_t> preadv(
+      int32_t fd,
+      uint64_t offset,
+      std::vector<struct iovec> iovecs);
+
+  /// Number of reads submitted and not yet completed.
+  uint32_t numInflight() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numInflight_;
+  }
+
+ private:
+  struct Request;
+
+  // Writes a submission queue entry for 'request' and submits it to the
+  // kernel. Queues 'request' in 'pending_' if the completion queue could
+  // overflow. 'mutex_' must be held.
+  void submitLocked(std::unique_ptr<Request> request);
+
+  // Writes an entry for 'request', or a no-op wakeup if 'request' is null,
+  // and enters the kernel. Returns the negative error code on failure.
+  int32_t enterLocked(Request* request);
+
+  // Completes 'request' with the result 'result' of a read. Resubmits the
+  // rest of a short read.
+  void complete(Request* request, int32_t result);
+
+  // Reaps completions until destruction.
+  void reapLoop();
+
+  // Unmaps the rings and closes the ring file descriptor.
+  void release();
+
+  int32_t ringFd_{-1};
+  uint32_t numEntries_{0};
+  uint32_t maxInflight_{0};
+
+  // Memory mappings of the submission and completion rings. 'cqRing_' may be
+  // the same mapping as 'sqRing_'.
+  void* sqRing_{nullptr};
+  size_t sqRingSize_{0};
+  void* cqRing_{nullptr};
+  size_t cqRingSize_{0};
+  void* sqes_{nullptr};
+  size_t sqesSize_{0};
+
+  // Pointers into the submission ring.
+  uint32_t* sqHead_{nullptr};
+  uint32_t* sqTail_{nullptr};
+  uint32_t sqMask_{0};
+  uint32_t* sqArray_{nullptr};
+
+  // Pointers into the completion ring.
+  uint32_t* cqHead_{nullptr};
+  uint32_t* cqTail_{nullptr};
+  uint32_t cqMask_{0};
+  void* cqes_{nullptr};
+
+  // Serializes submissions and guards the members below.
+  mutable std::mutex mutex_;
+  uint32_t numInflight_{0};
+  // Requests waiting for space in the completion queue.
+  std::deque<std::unique_ptr<Request>> pending_;
+  bool stopping_{false};
+
+  std::thread reaper_;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/MappedFileInputStream.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <folly/String.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::common {
+
+MappedFileInputStream::MappedFileInputStream(
+    const std::string& path,
+    uint64_t windowSize)
+    : path_(path) {
+  const int fd = ::open(path_.c_str(), O_RDONLY);
+  VELOX_CHECK_GE(
+      fd, 0, "Failed to open {}: {}", path_, folly::errnoStr(errno));
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0) {
+    ::close(fd);
+    VELOX_FAIL("Failed to stat {}: {}", path_, folly::errnoStr(errno));
+  }
+  fileSize_ = fileStat.st_size;
+  if (fileSize_ == 0) {
+    ::close(fd);
+    VELOX_FAIL("Empty MappedFileInputStream");
+  }
+  void* data = ::mmap(nullptr, fileSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file referenced.
+  ::close(fd);
+  VELOX_CHECK(
+      data != MAP_FAILED,
+      "Failed to map {}: {}",
+      path_,
+      folly::errnoStr(errno));
+  data_ = static_cast<uint8_t*>(data);
+  ::madvise(data_, fileSize_, MADV_SEQUENTIAL);
+
+  const uint64_t pageSize = ::sysconf(_SC_PAGESIZE);
+  windowSize_ = std::min(
+      fileSize_, bits::roundUp(std::max<uint64_t>(windowSize, 1), pageSize));
+  readNextRange();
+}
+
+MappedFileInputStream::~MappedFileInputStream() {
+  ::munmap(data_, fileSize_);
+}
+
+void MappedFileInputStream::readNextRange() {
+  VELOX_CHECK(current_ == nullptr || current_->availableBytes() == 0);
+  uint64_t adviseTimeNs{0};
+  {
+    NanosecondTimer timer{&adviseTimeNs};
+    if (current_ != nullptr) {
+      ::madvise(current_->buffer, current_->size, MADV_DONTNEED);
+    }
+    current_ = nullptr;
+
+    const auto readBytes = std::min(windowSize_, fileSize_ - fileOffset_);
+    VELOX_CHECK_LT(
+        0, readBytes, "Read past end of MappedFileInputStream {}", fileSize_);
+    range_ = {data_ + fileOffset_, static_cast<int64_t>(readBytes), 0};
+    current_ = &range_;
+    fileOffset_ += readBytes;
+
+    const auto nextBytes = std::min(windowSize_, fileSize_ - fileOffset_);
+    if (nextBytes > 0) {
+      ::madvise(data_ + fileOffset_, nextBytes, MADV_WILLNEED);
+    }
+  }
+  stats_.readBytes += current_->size;
+  stats_.readTimeNs += adviseTimeNs;
+  ++stats_.numReads;
+}
+
+size_t MappedFileInputStream::size() const {
+  return fileSize_;
+}
+
+bool MappedFileInputStream::atEnd() const {
+  return tellp() >= fileSize_;
+}
+
+std::streampos MappedFileInputStream::tellp() const {
+  return fileOffset_ - current_->availableBytes();
+}
+
+void MappedFileInputStream::seekp(std::streampos position) {
+  static_assert(sizeof(std::streamsize) <= sizeof(int64_t));
+  const int64_t seekPos = position;
+  const int64_t curPos = tellp();
+  VELOX_CHECK_GE(
+      seekPos,
+      curPos,
+      "Backward seek is not supported by MappedFileInputStream");
+  doSeek(seekPos - curPos);
+}
+
+void MappedFileInputStream::skip(int32_t size) {
+  doSeek(size);
+}
+
+void MappedFileInputStream::doSeek(int64_t skipBytes) {
+  VELOX_CHECK_GE(skipBytes, 0, "Attempting to skip negative number of bytes");
+  VELOX_CHECK_LE(
+      skipBytes,
+      remainingSize(),
+      "Skip past the end of MappedFileInputStream: {}",
+      fileSize_);
+
+  for (;;) {
+    const int64_t skippedBytes =
+        std::min<int64_t>(current_->availableBytes(), skipBytes);
+    skipBytes -= skippedBytes;
+    current_->position += skippedBytes;
+    if (skipBytes == 0) {
+      return;
+    }
+    readNextRange();
+  }
+}
+
+size_t MappedFileInputStream::remainingSize() const {
+  return fileSize_ - tellp();
+}
+
+uint8_t MappedFileInputStream::readByte() {
+  VELOX_CHECK_GT(
+      remainingSize(), 0, "Read past the end of input file {}", fileSize_);
+
+  if (current_->availableBytes() == 0) {
+    readNextRange();
+  }
+  return current_->buffer[current_->position++];
+}
+
+void MappedFileInputStream::readBytes(uint8_t* bytes, int32_t size) {
+  VELOX_CHECK_GE(size, 0, "Attempting to read negative number of bytes");
+  VELOX_CHECK_LE(
+      size, remainingSize(), "Read past the end of input file {}", fileSize_);
+
+  int32_t offset{0};
+  while (size > 0) {
+    if (current_->availableBytes() == 0) {
+      readNextRange();
+    }
+    const int32_t readBytes =
+        std::min<int64_t>(current_->availableBytes(), size);
+    simd::memcpy(
+        bytes + offset, current_->buffer + current_->position, readBytes);
+    offset += readBytes;
+    size -= readBytes;
+    current_->position += readBytes;
+  }
+}
+
+std::string_view MappedFileInputStream::nextView(int64_t size) {
+  VELOX_CHECK_GE(size, 0, "Attempting to view negative number of bytes");
+  if (remainingSize() == 0) {
+    return std::string_view(nullptr, 0);
+  }
+
+  if (current_->availableBytes() == 0) {
+    readNextRange();
+  }
+
+  const auto position = current_->position;
+  const auto viewSize = std::min<int64_t>(current_->availableBytes(), size);
+  current_->position += viewSize;
+  return std::string_view(
+      reinterpret_cast<char*>(current_->buffer) + position, viewSize);
+}
+
+std::string MappedFileInputStream::toString() const {
+  return fmt::format(
+      "mapped file {} (offset {}/size {}) current (position {}/ size {})",
+      path_,
+      succinctBytes(fileOffset_),
+      succinctBytes(fileSize_),
+      succinctBytes(current_->position),
+      succinctBytes(current_->size));
+}
+
+FileInputStream::Stats MappedFileInputStream::stats() const {
+  return stats_;
+}
+} // namespace facebook::velox::common
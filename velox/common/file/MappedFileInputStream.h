@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "velox/common/file/FileInputStream.h"
+#include "velox/common/memory/ByteStream.h"
+
+namespace facebook::velox::common {
+
+/// Readonly byte input stream over a memory mapped local file. The stream
+/// hands out the mapped pages 'windowSize' bytes at a time without copying
+/// them into read buffers. When the read moves to the next window, the pages
+/// of the previous one are dropped from the mapping with MADV_DONTNEED and
+/// the kernel is asked to fetch the next one with MADV_WILLNEED. The mapped
+/// pages are page cache and are not charged to a memory pool.
+class MappedFileInputStream : public ByteInputStream {
+ public:
+  /// 'path' is the path of the file in the local file system. 'windowSize' is
+  /// rounded up to a multiple of the page size.
+  MappedFileInputStream(const std::string& path, uint64_t windowSize);
+
+  ~MappedFileInputStream() override;
+
+  MappedFileInputStream(const MappedFileInputStream&) = delete;
+  MappedFileInputStream& operator=(const MappedFileInputStream& other) =
+      delete;
+  MappedFileInputStream(MappedFileInputStream&& other) noexcept = delete;
+  MappedFileInputStream& operator=(MappedFileInputStream&& other) noexcept =
+      delete;
+
+  size_t size() const override;
+
+  bool atEnd() const override;
+
+  std::streampos tellp() const override;
+
+  void seekp(std::streampos pos) override;
+
+  void skip(int32_t size) override;
+
+  size_t remainingSize() const override;
+
+  uint8_t readByte() override;
+
+  void readBytes(uint8_t* bytes, int32_t size) override;
+
+  std::string_view nextView(int64_t size) override;
+
+  std::string toString() const override;
+
+  /// Returns the stats with a read per window. 'readTimeNs' is the time spent
+  /// advising the kernel about the windows.
+  FileInputStream::Stats stats() const;
+
+ private:
+  void doSeek(int64_t skipBytes);
+
+  // Releases the pages of the current window and moves to the next one.
+  void readNextRange();
+
+  const std::string path_;
+  uint64_t fileSize_{0};
+  uint64_t windowSize_{0};
+  uint8_t* data_{nullptr};
+
+  // Offset of the first byte after the current window.
+  uint64_t fileOffset_{0};
+
+  ByteRange range_;
+
+  FileInputStream::Stats stats_;
+};
+} // namespace facebook::velox::common
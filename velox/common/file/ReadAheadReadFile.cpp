@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/ReadAheadReadFile.h"
+
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+#include "velox/common/config/Config.h"
+
+namespace facebook::velox {
+
+ReadAheadReadFile::ReadAheadReadFile(
+    std::shared_ptr<ReadFile> file,
+    folly::Executor* executor,
+    Options options)
+    : file_(std::move(file)),
+      executor_(executor),
+      options_(options),
+      size_(file_->size()),
+      requestSize_(
+          options_.requestSize > 0 ? options_.requestSize
+                                   : file_->getNaturalReadSize()) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(options_.numRequests, 0);
+  VELOX_CHECK_GT(requestSize_, 0);
+}
+
+std::string_view ReadAheadReadFile::pread(
+    uint64_t offset,
+    uint64_t length,
+    void* buf,
+    const FileIoContext& context) const {
+  const auto windows = windowsFor(offset, length);
+  if (windows.empty()) {
+    return file_->pread(offset, length, buf, context);
+  }
+  auto* pos = static_cast<char*>(buf);
+  const auto end = offset + length;
+  for (const auto& window : windows) {
+    try {
+      window->loaded.getSemiFuture().get();
+    } catch (const std::exception&) {
+      std::lock_guard<std::mutex> l(mutex_);
+      windows_.clear();
+      numSequentialReads_ = 0;
+      throw;
+    }
+    const auto begin = std::max(offset, window->offset);
+    const auto copySize = std::min(end, window->end()) - begin;
+    ::memcpy(pos, window->data.data() + (begin - window->offset), copySize);
+    pos += copySize;
+  }
+  return {static_cast<char*>(buf), length};
+}
+
+std::vector<std::shared_ptr<ReadAheadReadFile::Window>>
+ReadAheadReadFile::windowsFor(uint64_t offset, uint64_t length) const {
+  const auto end = offset + length;
+  std::lock_guard<std::mutex> l(mutex_);
+  // A pread that skips forward into the windows is also sequential.
+  const bool sequential = offset == nextOffset_ ||
+      (!windows_.empty() && offset >= windows_.front()->offset &&
+       offset < windows_.back()->end());
+  nextOffset_ = end;
+  if (!sequential) {
+    // The pread starts a new run of sequential preads.
+    windows_.clear();
+    numSequentialReads_ = 1;
+    return {};
+  }
+  if (++numSequentialReads_ < options_.minSequentialReads || end > size_) {
+    return {};
+  }
+  while (!windows_.empty() && windows_.front()->end() <= offset) {
+    windows_.pop_front();
+  }
+  if (!windows_.empty() && windows_.front()->offset > offset) {
+    windows_.clear();
+  }
+  scheduleLocked(
+      offset, std::min(size_, end + options_.numRequests * requestSize_));
+  std::vector<std::shared_ptr<Window>> windows;
+  for (const auto& window : windows_) {
+    if (window->offset >= end) {
+      break;
+    }
+    windows.push_back(window);
+  }
+  return windows;
+}
+
+void ReadAheadReadFile::scheduleLocked(uint64_t offset, uint64_t end) const {
+  if (!windows_.empty()) {
+    offset = windows_.back()->end();
+  }
+  while (offset < end) {
+    auto window = std::make_shared<Window>(
+        offset, std::min(requestSize_, size_ - offset));
+    executor_->add([file = file_, window]() {
+      try {
+        file->pread(window->offset, window->data.size(), window->data.data());
+        window->loaded.setValue();
+      } catch (const std::exception& e) {
+        window->loaded.setException(
+            folly::exception_wrapper(std::current_exception(), e));
+      }
+    });
+    offset = window->end();
+    windows_.push_back(std::move(window));
+  }
+}
+
+uint64_t ReadAheadReadFile::memoryUsage() const {
+  uint64_t windowBytes = 0;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& window : windows_) {
+      windowBytes += window->data.size();
+    }
+  }
+  return file_->memoryUsage() + windowBytes;
+}
+
+ReadAhead::ReadAhead(int32_t numThreads, ReadAheadReadFile::Options options)
+    : options_(options) {
+  if (numThreads > 0) {
+    executor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+        numThreads, std::make_shared<folly::NamedThreadFactory>("ReadAhead"));
+  }
+}
+
+// static
+std::unique_ptr<ReadAhead> ReadAhead::create(
+    const config::ConfigBase& config,
+    std::string_view prefix) {
+  auto key = [&](std::string_view name) {
+    return fmt::format("{}{}", prefix, name);
+  };
+  ReadAheadReadFile::Options options;
+  options.numRequests =
+      config.get<int32_t>(key("read-ahead-requests"), options.numRequests);
+  VELOX_USER_CHECK_GT(
+      options.numRequests,
+      0,
+      "{} must be positive",
+      key("read-ahead-requests"));
+  options.requestSize = config::toCapacity(
+      config.get<std::string>(key("read-ahead-size"), "0B"),
+      config::CapacityUnit::BYTE);
+  return std::make_unique<ReadAhead>(
+      config.get<int32_t>(key("read-ahead-threads"), 0), options);
+}
+
+std::unique_ptr<ReadFile> ReadAhead::wrap(
+    std::unique_ptr<ReadFile> file) const {
+  if (executor_ == nullptr) {
+    return file;
+  }
+  return std::make_unique<ReadAheadReadFile>(
+      std::move(file), executor_.get(), options_);
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/futures/SharedPromise.h>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+namespace config {
+class ConfigBase;
+}
+
+/// A ReadFile that reads ahead of sequential preads of another ReadFile. After
+/// 'minSequentialReads' preads that each start where the previous one ended,
+/// the file is read in windows of 'requestSize' bytes and 'numRequests'
+/// windows past the last pread are kept in flight on 'executor'. The preads
+/// covered by the windows are served from memory. A pread that is not
+/// sequential drops the windows and is passed through, so random access costs
+/// no more than without read-ahead.
+///
+/// Meant for remote files with a high latency per request, where sequential
+/// scans of text or row-oriented formats otherwise wait for each request in
+/// turn. preadv() and preadvAsync() are passed through: they come from readers
+/// that coalesce and prefetch their reads themselves.
+class ReadAheadReadFile final : public ReadFile {
+ public:
+  struct Options {
+    /// Number of windows read ahead of the last pread.
+    int32_t numRequests{2};
+
+    /// Size of a window. 0 means getNaturalReadSize() of the file.
+    uint64_t requestSize{0};
+
+    /// Number of consecutive sequential preads, including the first of the
+    /// run, from which the reads ahead start.
+    int32_t minSequentialReads{2};
+  };
+
+  ReadAheadReadFile(
+      std::shared_ptr<ReadFile> file,
+      folly::Executor* executor,
+      Options options);
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      const FileIoContext& context = {}) const final;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      const FileIoContext& context = {}) const final {
+    return file_->preadv(offset, buffers, context);
+  }
+
+  uint64_t preadv(
+      folly::Range<const common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs,
+      const FileIoContext& context = {}) const final {
+    return file_->preadv(regions, iobufs, context);
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      const FileIoContext& context = {}) const final {
+    return file_->preadvAsync(offset, buffers, context);
+  }
+
+  bool hasPreadvAsync() const final {
+    return file_->hasPreadvAsync();
+  }
+
+  bool shouldCoalesce() const final {
+    return file_->shouldCoalesce();
+  }
+
+  uint64_t size() const final {
+    return size_;
+  }
+
+  /// Includes the memory of the windows.
+  uint64_t memoryUsage() const final;
+
+  /// The bytes read from the wrapped file, including the reads ahead.
+  uint64_t bytesRead() const final {
+    return file_->bytesRead();
+  }
+
+  void resetBytesRead() final {
+    file_->resetBytesRead();
+  }
+
+  std::string getName() const final {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const final {
+    return file_->getNaturalReadSize();
+  }
+
+  const std::shared_ptr<ReadFile>& file() const {
+    return file_;
+  }
+
+ private:
+  // A range of the file read ahead.
+  struct Window {
+    Window(uint64_t _offset, uint64_t length)
+        : offset(_offset), data(length, 0) {}
+
+    uint64_t end() const {
+      return offset + data.size();
+    }
+
+    const uint64_t offset;
+    std::string data;
+    // Fulfilled when 'data' is read.
+    folly::SharedPromise<folly::Unit> loaded;
+  };
+
+  // Returns the windows covering [offset, offset + length) after scheduling
+  // the reads ahead of it, or an empty vector if the pread is to be passed
+  // through.
+  std::vector<std::shared_ptr<Window>> windowsFor(
+      uint64_t offset,
+      uint64_t length) const;
+
+  // Appends windows to 'windows_' until they reach 'end'. The first window
+  // starts at 'offset' if 'windows_' is empty.
+  void scheduleLocked(uint64_t offset, uint64_t end) const;
+
+  const std::shared_ptr<ReadFile> file_;
+  folly::Executor* const executor_;
+  const Options options_;
+  const uint64_t size_;
+  const uint64_t requestSize_;
+
+  mutable std::mutex mutex_;
+  // Contiguous windows in ascending offset.
+  mutable std::deque<std::shared_ptr<Window>> windows_;
+  // End of the last pread.
+  mutable uint64_t nextOffset_{0};
+  // Number of consecutive sequential preads.
+  mutable int32_t numSequentialReads_{0};
+};
+
+/// Read-ahead for the files of a file system. A file system opts in by owning
+/// a ReadAhead and passing the files it opens for read to wrap(). Owns the
+/// executor of the reads ahead, which is shared by the files.
+class ReadAhead {
+ public:
+  /// Read-ahead is enabled if 'numThreads' is positive.
+  ReadAhead(int32_t numThreads, ReadAheadReadFile::Options options);
+
+  /// Reads "<prefix>read-ahead-threads", "<prefix>read-ahead-requests" and
+  /// "<prefix>read-ahead-size" of 'config', e.g. "hive.gcs.read-ahead-threads"
+  /// for the "hive.gcs." prefix. Read-ahead is disabled by default.
+  static std::unique_ptr<ReadAhead> create(
+      const config::ConfigBase& config,
+      std::string_view prefix);
+
+  /// Returns 'file' wrapped in a ReadAheadReadFile, or 'file' if read-ahead is
+  /// disabled.
+  std::unique_ptr<ReadFile> wrap(std::unique_ptr<ReadFile> file) const;
+
+ private:
+  const ReadAheadReadFile::Options options_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
+};
+
+} // namespace facebook::velox
@@ -16,11 +16,14 @@
 #include "velox/common/memory/ByteStream.h"
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/MappedFileInputStream.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/common/testutil/TempDirectoryPath.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 
 using namespace facebook::velox;
@@ -49,9 +52,9 @@ class FileInputStreamTest : public testing::Test {
 
   void TearDown() override {}
 
-  std::unique_ptr<common::FileInputStream> createStream(
-      uint64_t streamSize,
-      uint32_t bufferSize = 1024) {
+  // Writes a file of 'streamSize' bytes where byte i has value i % 256 and
+  // returns its path.
+  std::string writeTestFile(uint64_t streamSize) {
     const auto filePath =
         fmt::format("{}/{}", tempDirPath_->getPath(), fileId_++);
     auto writeFile = fs_->openFileForWrite(filePath);
@@ -62,8 +65,18 @@ class FileInputStreamTest : public testing::Test {
     writeFile->append(
         std::string_view(reinterpret_cast<char*>(buffer.data()), streamSize));
     writeFile->close();
+    return filePath;
+  }
+
+  std::unique_ptr<common::FileInputStream> createStream(
+      uint64_t streamSize,
+      uint32_t bufferSize = 1024,
+      folly::Executor* readAheadExecutor = nullptr) {
     return std::make_unique<common::FileInputStream>(
-        fs_->openFileForRead(filePath), bufferSize, pool_.get());
+        fs_->openFileForRead(writeTestFile(streamSize)),
+        bufferSize,
+        pool_.get(),
+        readAheadExecutor);
   }
 
   folly::Random::DefaultGenerator rng_;
@@ -112,3 +125,73 @@ TEST_F(FileInputStreamTest, stats) {
     ASSERT_GT(byteStream->stats().readTimeNs, 0);
   }
 }
+
+TEST_F(FileInputStreamTest, readAheadWithExecutor) {
+  constexpr size_t kStreamSize = 64 << 10;
+  constexpr size_t kBufferSize = 4 << 10;
+  folly::CPUThreadPoolExecutor executor(2);
+  {
+    auto byteStream = createStream(kStreamSize, kBufferSize);
+    // The local file does not support async read so there is no read-ahead
+    // buffer without an executor.
+    ASSERT_LT(pool_->usedBytes(), 2 * kBufferSize);
+  }
+  auto byteStream = createStream(kStreamSize, kBufferSize, &executor);
+  ASSERT_GE(pool_->usedBytes(), 2 * kBufferSize);
+  std::vector<uint8_t> buffer(1000);
+  for (int offset = 0; offset < kStreamSize;) {
+    const auto size = std::min<int>(buffer.size(), kStreamSize - offset);
+    byteStream->readBytes(buffer.data(), size);
+    for (int i = 0; i < size; ++i, ++offset) {
+      ASSERT_EQ(buffer[i], offset % 256);
+    }
+  }
+  ASSERT_TRUE(byteStream->atEnd());
+  ASSERT_EQ(byteStream->stats().numReads, kStreamSize / kBufferSize);
+  ASSERT_EQ(byteStream->stats().readBytes, kStreamSize);
+
+  // Destruction waits for an outstanding read-ahead.
+  byteStream = createStream(kStreamSize, kBufferSize, &executor);
+  byteStream.reset();
+}
+
+TEST_F(FileInputStreamTest, mappedFile) {
+  constexpr size_t kStreamSize = 64 << 10;
+  constexpr size_t kWindowSize = 8 << 10;
+  const auto usedBytes = pool_->usedBytes();
+  common::MappedFileInputStream byteStream(
+      writeTestFile(kStreamSize), kWindowSize);
+  // The mapped pages are not allocated from a memory pool.
+  ASSERT_EQ(pool_->usedBytes(), usedBytes);
+  ASSERT_EQ(byteStream.size(), kStreamSize);
+  ASSERT_EQ(byteStream.stats().numReads, 1);
+
+  // Reads across the window boundaries.
+  std::vector<uint8_t> buffer(3000);
+  int offset{0};
+  for (; offset < kStreamSize / 2;) {
+    byteStream.readBytes(buffer.data(), buffer.size());
+    for (int i = 0; i < buffer.size(); ++i, ++offset) {
+      ASSERT_EQ(buffer[i], offset % 256);
+    }
+  }
+  ASSERT_EQ(byteStream.tellp(), offset);
+
+  byteStream.skip(kWindowSize + 10);
+  offset += kWindowSize + 10;
+  ASSERT_EQ(byteStream.readByte(), offset++ % 256);
+  ASSERT_EQ(byteStream.read<int8_t>(), static_cast<int8_t>(offset++ % 256));
+
+  while (!byteStream.atEnd()) {
+    const auto view = byteStream.nextView(5000);
+    ASSERT_GT(view.size(), 0);
+    for (auto byte : view) {
+      ASSERT_EQ(static_cast<uint8_t>(byte), offset++ % 256);
+    }
+  }
+  ASSERT_EQ(offset, kStreamSize);
+  ASSERT_EQ(byteStream.remainingSize(), 0);
+  ASSERT_EQ(byteStream.stats().numReads, kStreamSize / kWindowSize);
+  ASSERT_EQ(byteStream.stats().readBytes, kStreamSize);
+  VELOX_ASSERT_THROW(byteStream.readByte(), "Read past the end");
+}
@@ -239,12 +239,57 @@ TEST_P(LocalFileTest, writeAndRead) {
       readData(readFile.get(), true, true);
       auto readFileWithoutExecutor = std::make_shared<LocalReadFile>(filename);
       readData(readFileWithoutExecutor.get(), true, true);
+      if (IoUring::isSupported()) {
+        auto readFileWithIoUring = std::make_shared<LocalReadFile>(
+            filename, nullptr, true, IoUring::instance());
+        ASSERT_TRUE(readFileWithIoUring->hasPreadvAsync());
+        readData(readFileWithIoUring.get(), true, true);
+      }
     }
     auto readFile = fs->openFileForRead(filename);
     readData(readFile.get());
   }
 }
 
+TEST_P(LocalFileTest, ioUring) {
+  if (useFaultyFs_ || !IoUring::isSupported()) {
+    GTEST_SKIP() << "io_uring is not supported";
+  }
+  auto tempFile = TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  {
+    LocalWriteFile writeFile(filename, false, false);
+    writeFile.append(std::string(kOneMB, 'a'));
+    writeFile.close();
+  }
+  // A ring smaller than the number of reads queues the excess reads.
+  IoUring ioUring(4);
+  LocalReadFile readFile(filename, nullptr, true, &ioUring);
+  constexpr int32_t kNumReads = 64;
+  constexpr int32_t kReadSize = 1000;
+  std::vector<std::string> data(kNumReads, std::string(kReadSize, 'x'));
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  for (auto i = 0; i < kNumReads; ++i) {
+    std::vector<folly::Range<char*>> buffers = {
+        folly::Range<char*>(data[i].data(), kReadSize / 2),
+        folly::Range<char*>(nullptr, (char*)(uint64_t)100),
+        folly::Range<char*>(data[i].data() + kReadSize / 2, kReadSize / 2)};
+    futures.push_back(readFile.preadvAsync(i * kReadSize * 2, buffers));
+  }
+  for (auto i = 0; i < kNumReads; ++i) {
+    ASSERT_EQ(std::move(futures[i]).get(), kReadSize + 100);
+    ASSERT_EQ(data[i], std::string(kReadSize, 'a'));
+  }
+  ASSERT_EQ(ioUring.numInflight(), 0);
+
+  // Reading past the end of the file fails.
+  char buffer[100];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(buffer, sizeof(buffer))};
+  VELOX_ASSERT_THROW(
+      readFile.preadvAsync(kOneMB - 10, buffers).get(), "read past end");
+}
+
 TEST_P(LocalFileTest, viaRegistry) {
   auto tempFile = TempFilePath::create(useFaultyFs_);
   const auto& filename = tempFile->getPath();
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/ReadAheadReadFile.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/config/Config.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+// An in-memory file that records the preads it serves and fails the preads
+// at or past 'failOffset'.
+class RecordingReadFile : public InMemoryReadFile {
+ public:
+  explicit RecordingReadFile(std::string data)
+      : InMemoryReadFile(std::move(data)) {}
+
+  using InMemoryReadFile::pread;
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      const FileIoContext& context = {}) const override {
+    VELOX_CHECK_LT(offset, failOffset_, "Injected read error");
+    reads_.wlock()->emplace_back(offset, length);
+    return InMemoryReadFile::pread(offset, length, buf, context);
+  }
+
+  // Returns the preads in ascending offset. The reads ahead run in any order.
+  std::vector<std::pair<uint64_t, uint64_t>> reads() const {
+    auto reads = *reads_.rlock();
+    std::sort(reads.begin(), reads.end());
+    return reads;
+  }
+
+  void setFailOffset(uint64_t offset) {
+    failOffset_ = offset;
+  }
+
+ private:
+  mutable folly::Synchronized<std::vector<std::pair<uint64_t, uint64_t>>>
+      reads_;
+  std::atomic<uint64_t> failOffset_{std::numeric_limits<uint64_t>::max()};
+};
+
+class ReadAheadReadFileTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (auto i = 0; i < kFileSize; ++i) {
+      data_.push_back('a' + i % 26);
+    }
+    file_ = std::make_shared<RecordingReadFile>(data_);
+  }
+
+  std::unique_ptr<ReadAheadReadFile> makeReadAheadFile(
+      ReadAheadReadFile::Options options) {
+    return std::make_unique<ReadAheadReadFile>(
+        file_, executor_.get(), options);
+  }
+
+  void expectRead(const ReadFile& file, uint64_t offset, uint64_t length) {
+    EXPECT_EQ(file.pread(offset, length), data_.substr(offset, length));
+  }
+
+  static constexpr int32_t kFileSize = 10'000;
+
+  std::string data_;
+  std::shared_ptr<RecordingReadFile> file_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(2)};
+};
+
+TEST_F(ReadAheadReadFileTest, sequential) {
+  auto file = makeReadAheadFile({.numRequests = 2, .requestSize = 1'000});
+  EXPECT_EQ(file->size(), kFileSize);
+  // The first pread is passed through, the second starts the reads ahead.
+  expectRead(*file, 0, 300);
+  expectRead(*file, 300, 300);
+  executor_->join();
+  std::vector<std::pair<uint64_t, uint64_t>> expected = {
+      {0, 300}, {300, 1'000}, {1'300, 1'000}, {2'300, 1'000}};
+  EXPECT_EQ(file_->reads(), expected);
+  EXPECT_EQ(file->memoryUsage(), kFileSize + 3'000);
+
+  executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  file = makeReadAheadFile({.numRequests = 2, .requestSize = 1'000});
+  for (auto offset = 0; offset < kFileSize; offset += 700) {
+    expectRead(*file, offset, std::min(700, kFileSize - offset));
+  }
+  // A pread across three windows.
+  expectRead(*file, 0, 100);
+  expectRead(*file, 100, 100);
+  expectRead(*file, 200, 2'500);
+}
+
+TEST_F(ReadAheadReadFileTest, random) {
+  auto file = makeReadAheadFile({.numRequests = 2, .requestSize = 1'000});
+  expectRead(*file, 5'000, 100);
+  expectRead(*file, 1'000, 100);
+  expectRead(*file, 3'000, 100);
+  expectRead(*file, 3'100, 100);
+  // Skipping forward into the windows keeps reading ahead.
+  expectRead(*file, 3'500, 100);
+  // Skipping backward drops the windows.
+  expectRead(*file, 0, 100);
+  executor_->join();
+  std::vector<std::pair<uint64_t, uint64_t>> expected = {
+      {0, 100},
+      {1'000, 100},
+      {3'000, 100},
+      {3'100, 1'000},
+      {4'100, 1'000},
+      {5'000, 100},
+      {5'100, 1'000}};
+  EXPECT_EQ(file_->reads(), expected);
+  EXPECT_EQ(file->memoryUsage(), kFileSize);
+}
+
+TEST_F(ReadAheadReadFileTest, error) {
+  auto file = makeReadAheadFile({.numRequests = 1, .requestSize = 1'000});
+  file_->setFailOffset(1'100);
+  expectRead(*file, 0, 100);
+  expectRead(*file, 100, 100);
+  VELOX_ASSERT_THROW(file->pread(200, 1'000), "Injected read error");
+  file_->setFailOffset(std::numeric_limits<uint64_t>::max());
+  expectRead(*file, 1'200, 100);
+}
+
+TEST_F(ReadAheadReadFileTest, create) {
+  config::ConfigBase config(std::unordered_map<std::string, std::string>{});
+  auto inMemoryFile = std::make_unique<RecordingReadFile>(data_);
+  auto* rawFile = inMemoryFile.get();
+  auto file = ReadAhead::create(config, "fs.test.")->wrap(
+      std::move(inMemoryFile));
+  EXPECT_EQ(file.get(), rawFile);
+
+  config::ConfigBase enabled(
+      std::unordered_map<std::string, std::string>{
+          {"fs.test.read-ahead-threads", "2"},
+          {"fs.test.read-ahead-requests", "3"},
+          {"fs.test.read-ahead-size", "1kB"}});
+  auto readAhead = ReadAhead::create(enabled, "fs.test.");
+  file = readAhead->wrap(std::make_unique<RecordingReadFile>(data_));
+  auto* readAheadFile = dynamic_cast<ReadAheadReadFile*>(file.get());
+  ASSERT_NE(readAheadFile, nullptr);
+  for (auto offset = 0; offset < kFileSize; offset += 300) {
+    expectRead(*file, offset, std::min(300, kFileSize - offset));
+  }
+
+  config::ConfigBase invalid(
+      std::unordered_map<std::string, std::string>{
+          {"fs.test.read-ahead-threads", "2"},
+          {"fs.test.read-ahead-requests", "0"}});
+  VELOX_ASSERT_THROW(
+      ReadAhead::create(invalid, "fs.test."),
+      "fs.test.read-ahead-requests must be positive");
+}
+
+} // namespace
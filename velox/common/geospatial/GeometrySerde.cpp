@@ -90,6 +90,16 @@ GeometryDeserializer::deserializeEnvelope(const StringView& geometry) {
   }
 }
 
+std::optional<geos::geom::Coordinate> GeometryDeserializer::deserializePoint(
+    const StringView& geometry) {
+  velox::common::InputByteStream inputStream(geometry.data());
+  if (inputStream.read<GeometrySerializationType>() !=
+      GeometrySerializationType::POINT) {
+    return std::nullopt;
+  }
+  return readCoordinate(inputStream);
+}
+
 std::unique_ptr<geos::geom::Envelope> GeometryDeserializer::deserializeEnvelope(
     velox::common::InputByteStream& input) {
   auto xMin = input.read<double>();
@@ -20,6 +20,7 @@
 #include <geos/geom/CoordinateArraySequence.h>
 #include <geos/geom/Geometry.h>
 #include <geos/geom/GeometryFactory.h>
+#include <optional>
 
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/geospatial/GeometryConstants.h"
@@ -409,6 +410,12 @@ class GeometryDeserializer {
   static const std::unique_ptr<geos::geom::Envelope> deserializeEnvelope(
       const StringView& geometry);
 
+  /// Returns the coordinate of a serialized point without building a GEOS
+  /// geometry, or std::nullopt if 'geometry' is not a point. The coordinates
+  /// of an empty point are NaN.
+  static std::optional<geos::geom::Coordinate> deserializePoint(
+      const StringView& geometry);
+
   template <typename T>
   static std::unique_ptr<geos::geom::CoordinateArraySequence>
   deserializePointsToCoordinate(
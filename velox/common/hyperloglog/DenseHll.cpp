@@ -15,6 +15,8 @@
  */
 #include "velox/common/hyperloglog/DenseHll.h"
 
+#include <array>
+
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/hyperloglog/BiasCorrection.h"
@@ -216,15 +218,43 @@ struct DenseHllView {
   }
 };
 
-int64_t cardinalityImpl(const DenseHllView& hll) {
-  auto numBuckets = 1 << hll.indexBitLength;
+/// Returns the number of buckets with each delta value. 'deltas' has 2 deltas
+/// per byte. Full SIMD batches of bytes compare both halves of each byte to
+/// all delta values, the remaining bytes are counted one by one.
+std::array<int32_t, kMaxDelta + 1> countDeltas(
+    const int8_t* deltas,
+    int32_t numBytes) {
+  constexpr int32_t batchSize = xsimd::batch<int8_t>::size;
+  const auto bucketMaskBatch = xsimd::broadcast(kBucketMask);
 
-  int32_t baselineCount = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    if (hll.getDelta(i) == 0) {
-      baselineCount++;
+  std::array<int32_t, kMaxDelta + 1> counts{};
+  int32_t i = 0;
+  for (; i + batchSize <= numBytes; i += batchSize) {
+    const auto batch = xsimd::load_unaligned(deltas + i);
+    const auto evenBatch = xsimd::bitwise_and(
+        xsimd::kernel::bitwise_rshift(batch, 4, xsimd::default_arch{}),
+        bucketMaskBatch);
+    const auto oddBatch = xsimd::bitwise_and(batch, bucketMaskBatch);
+    for (int8_t delta = 0; delta <= kMaxDelta; ++delta) {
+      const auto deltaBatch = xsimd::broadcast(delta);
+      const uint64_t evenMask = xsimd::eq(evenBatch, deltaBatch).mask();
+      const uint64_t oddMask = xsimd::eq(oddBatch, deltaBatch).mask();
+      counts[delta] += bits::countBits(&evenMask, 0, batchSize) +
+          bits::countBits(&oddMask, 0, batchSize);
     }
   }
+  for (; i < numBytes; ++i) {
+    ++counts[(deltas[i] >> 4) & kBucketMask];
+    ++counts[deltas[i] & kBucketMask];
+  }
+  return counts;
+}
+
+int64_t cardinalityImpl(const DenseHllView& hll) {
+  auto numBuckets = 1 << hll.indexBitLength;
+
+  const auto deltaCounts = countDeltas(hll.deltas, numBuckets / 2);
+  const int32_t baselineCount = deltaCounts[0];
 
   // If baseline is zero, then baselineCount is the number of buckets with value
   // 0.
@@ -233,10 +263,23 @@ int64_t cardinalityImpl(const DenseHllView& hll) {
     return std::round(linearCounting(baselineCount, numBuckets));
   }
 
+  // Sum of 2 ^ -value over all buckets. Buckets with the same delta add up
+  // to one term. A bucket with an overflow moves from the kMaxDelta term to
+  // its own value.
   double sum = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    int value = hll.getValue(i);
-    sum += 1.0 / (1L << value);
+  for (int delta = 0; delta <= kMaxDelta; ++delta) {
+    if (deltaCounts[delta] == 0) {
+      continue;
+    }
+    sum += deltaCounts[delta] /
+        static_cast<double>(1L << (hll.baseline + delta));
+  }
+  for (int i = 0; i < hll.overflows; ++i) {
+    if (hll.getDelta(hll.overflowBuckets[i]) != kMaxDelta) {
+      continue;
+    }
+    const int value = hll.baseline + kMaxDelta + hll.overflowValues[i];
+    sum += 1.0 / (1L << value) - 1.0 / (1L << (hll.baseline + kMaxDelta));
   }
 
   double estimate = (alpha(hll.indexBitLength) * numBuckets * numBuckets) / sum;
@@ -586,6 +629,8 @@ void DenseHll<TAllocator>::mergeWith(const char* serialized) {
   auto numBuckets = 1 << indexBitLength_;
   auto deltas = stream.read<int8_t>(numBuckets / 2);
   auto overflows = stream.read<int16_t>();
+  VELOX_CHECK_GE(
+      overflows, 0, "Invalid DenseHll overflow count: {}", overflows);
   auto overflowBuckets = overflows ? stream.read<uint16_t>(overflows) : nullptr;
   auto overflowValues = overflows ? stream.read<int8_t>(overflows) : nullptr;
   mergeWith({baseline, deltas, overflows, overflowBuckets, overflowValues});
@@ -30,12 +30,15 @@ uint64_t hashOne(T value) {
   return XXH64(&value, sizeof(value), 0);
 }
 
-// A benchmark for DenseHll::mergeWith(serialized) API.
+// A benchmark for DenseHll::mergeWith(serialized) and cardinality APIs.
 //
 // Measures the time it takes to merge 2 serialized digests using different
 // values for hash bits. Larger values of hash bits corresponds to larger
 // digests that are more accurate, but slower to merge. The default number of
 // hash bits is 11, while in practice 16 is common.
+//
+// Also measures merging many small digests, like a final aggregation merging
+// the partial digests of many upstream groups, and the cardinality estimate.
 class DenseHllBenchmark {
  public:
   explicit DenseHllBenchmark(memory::MemoryPool* pool) : pool_(pool) {
@@ -43,6 +46,12 @@ class DenseHllBenchmark {
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 1));
       serializedHlls_[hashBits].push_back(makeSerializedHll(hashBits, 2));
     }
+    for (auto hashBits : {11, 16}) {
+      for (int32_t i = 0; i < kNumPartialHlls; ++i) {
+        partialHlls_[hashBits].push_back(
+            makeSerializedHll(hashBits, 1, i * 10'000, 10'000));
+      }
+    }
   }
 
   void run(int hashBits) {
@@ -58,11 +67,38 @@ class DenseHllBenchmark {
     }
   }
 
+  void runMergeMany(int hashBits) {
+    folly::BenchmarkSuspender suspender;
+
+    HashStringAllocator allocator(pool_);
+    common::hll::DenseHll<> hll(hashBits, &allocator);
+
+    suspender.dismiss();
+
+    for (const auto& serialized : partialHlls_.at(hashBits)) {
+      hll.mergeWith(serialized.data());
+    }
+  }
+
+  void runCardinality(int hashBits) {
+    for (const auto& serialized : serializedHlls_.at(hashBits)) {
+      folly::doNotOptimizeAway(
+          common::hll::DenseHlls::cardinality(serialized.data()));
+    }
+  }
+
  private:
-  std::string makeSerializedHll(int hashBits, int32_t step) {
+  static constexpr int32_t kNumPartialHlls = 1'000;
+
+  // Returns a digest of 'numValues' values from 'start' in steps of 'step'.
+  std::string makeSerializedHll(
+      int hashBits,
+      int32_t step,
+      int32_t start = 0,
+      int32_t numValues = 1'000'000) {
     HashStringAllocator allocator(pool_);
     common::hll::DenseHll<> hll(hashBits, &allocator);
-    for (int32_t i = 0; i < 1'000'000; ++i) {
+    for (int32_t i = start; i < start + numValues; ++i) {
       auto hash = hashOne(i * step);
       hll.insertHash(hash);
     }
@@ -82,6 +118,10 @@ class DenseHllBenchmark {
   // List of serialized HLLs to use for merging, keyed by the number of hash
   // bits.
   std::unordered_map<int, std::vector<std::string>> serializedHlls_;
+
+  // Digests of 'kNumPartialHlls' disjoint ranges of values, keyed by the
+  // number of hash bits.
+  std::unordered_map<int, std::vector<std::string>> partialHlls_;
 };
 
 } // namespace
@@ -100,6 +140,30 @@ BENCHMARK(mergeSerialized16) {
   benchmark->run(16);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(mergeManySerialized11) {
+  benchmark->runMergeMany(11);
+}
+
+BENCHMARK(mergeManySerialized16) {
+  benchmark->runMergeMany(16);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(cardinality11) {
+  benchmark->runCardinality(11);
+}
+
+BENCHMARK(cardinality12) {
+  benchmark->runCardinality(12);
+}
+
+BENCHMARK(cardinality16) {
+  benchmark->runCardinality(16);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
 
@@ -177,6 +177,39 @@ TYPED_TEST(DenseHllTest, highCardinality) {
   ASSERT_EQ(denseHll.cardinality(), DenseHlls::cardinality(serialized.data()));
 }
 
+TYPED_TEST(DenseHllTest, cardinalityWithOverflows) {
+  // The estimates are far above the range of the bias correction, so the
+  // expected value is the raw harmonic mean estimate. 4 index bits have fewer
+  // deltas than a SIMD batch.
+  for (int8_t indexBitLength : {4, 11, 16}) {
+    SCOPED_TRACE(fmt::format("indexBitLength {}", indexBitLength));
+    DenseHll hll{indexBitLength, this->allocator_};
+    const int32_t numBuckets = 1 << indexBitLength;
+    for (auto value : {10, 20}) {
+      for (int32_t i = 0; i < numBuckets; ++i) {
+        hll.insert(i, value);
+      }
+    }
+    hll.insert(1, 21);
+    // The largest value without an overflow.
+    hll.insert(2, 35);
+    hll.insert(3, 40);
+    hll.insert(numBuckets - 1, 45);
+
+    const double sum = (numBuckets - 4) / static_cast<double>(1L << 20) +
+        1.0 / (1L << 21) + 1.0 / (1L << 35) + 1.0 / (1L << 40) +
+        1.0 / (1L << 45);
+    const double alpha =
+        indexBitLength == 4 ? 0.673 : 0.7213 / (1 + 1.079 / numBuckets);
+    const int64_t expected = std::round(alpha * numBuckets * numBuckets / sum);
+
+    ASSERT_EQ(hll.cardinality(), expected);
+    ASSERT_EQ(this->roundTrip(hll).cardinality(), expected);
+    auto serialized = this->serialize(hll);
+    ASSERT_EQ(DenseHlls::cardinality(serialized.data()), expected);
+  }
+}
+
 namespace {
 template <typename T>
 std::vector<T> sequence(T start, T end) {
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoLatencyModel.h"
+
+#include <folly/container/F14Map.h>
+#include <algorithm>
+
+namespace facebook::velox::io {
+
+void IoLatencyModel::recordRead(uint64_t bytes, uint64_t durationUs) {
+  const double x = bytes;
+  const double y = durationUs;
+  std::lock_guard<std::mutex> l(mutex_);
+  count_ = count_ * kDecay + 1;
+  sumX_ = sumX_ * kDecay + x;
+  sumY_ = sumY_ * kDecay + y;
+  sumXX_ = sumXX_ * kDecay + x * x;
+  sumXY_ = sumXY_ * kDecay + x * y;
+  if (++numSamples_ < kMinSamples) {
+    return;
+  }
+  const auto [latencyUs, bytesPerUs] = fitLocked();
+  if (latencyUs == 0) {
+    distance_ = 0;
+    return;
+  }
+  distance_ = static_cast<int32_t>(std::clamp<double>(
+      latencyUs * bytesPerUs, kMinCoalesceDistance, kMaxCoalesceDistance));
+}
+
+std::pair<double, double> IoLatencyModel::fitLocked() const {
+  const double variance = count_ * sumXX_ - sumX_ * sumX_;
+  // All reads of about the same size do not separate latency from transfer
+  // time.
+  if (variance <= 1e-6 * count_ * sumXX_) {
+    return {0, 0};
+  }
+  const double usPerByte = (count_ * sumXY_ - sumX_ * sumY_) / variance;
+  const double latencyUs = (sumY_ - usPerByte * sumX_) / count_;
+  if (usPerByte <= 0 || latencyUs <= 0) {
+    return {0, 0};
+  }
+  return {latencyUs, 1 / usPerByte};
+}
+
+double IoLatencyModel::latencyUs() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numSamples_ < kMinSamples ? 0 : fitLocked().first;
+}
+
+double IoLatencyModel::bytesPerUs() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numSamples_ < kMinSamples ? 0 : fitLocked().second;
+}
+
+// static
+std::shared_ptr<IoLatencyModel> IoLatencyModel::forPath(
+    std::string_view path) {
+  static std::mutex mutex;
+  static folly::F14FastMap<std::string, std::shared_ptr<IoLatencyModel>>
+      models;
+  const auto schemeEnd = path.find("://");
+  const std::string scheme(
+      schemeEnd == std::string_view::npos ? std::string_view()
+                                          : path.substr(0, schemeEnd));
+  std::lock_guard<std::mutex> l(mutex);
+  auto& model = models[scheme];
+  if (model == nullptr) {
+    model = std::make_shared<IoLatencyModel>();
+  }
+  return model;
+}
+
+} // namespace facebook::velox::io
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace facebook::velox::io {
+
+/// Learns the fixed per-request latency and the transfer bandwidth of a
+/// storage backend from the reads made against it, and derives the distance
+/// up to which two ranges should be read in one request. Reading a gap of g
+/// bytes costs g / bandwidth, issuing a separate request costs the latency,
+/// so merging pays off while g < latency * bandwidth. On high latency object
+/// stores this is megabytes, on local flash a few kilobytes.
+///
+/// The model is a least squares fit of read time against read size over an
+/// exponentially decaying window of recent reads. Thread safe.
+class IoLatencyModel {
+ public:
+  /// Number of reads before the learned distance is used.
+  static constexpr int32_t kMinSamples = 32;
+
+  /// Bounds of the learned coalesce distance.
+  static constexpr int32_t kMinCoalesceDistance = 4 << 10;
+  static constexpr int32_t kMaxCoalesceDistance = 64 << 20;
+
+  /// Records that a single request for 'bytes' took 'durationUs'.
+  void recordRead(uint64_t bytes, uint64_t durationUs);
+
+  /// Returns the learned coalesce distance in bytes, or 'defaultDistance' if
+  /// there are not yet enough reads to fit the model.
+  int32_t coalesceDistance(int32_t defaultDistance) const {
+    const auto distance = distance_.load(std::memory_order_relaxed);
+    return distance == 0 ? defaultDistance : distance;
+  }
+
+  /// Returns the fitted per-request latency in microseconds, 0 if unknown.
+  double latencyUs() const;
+
+  /// Returns the fitted bandwidth in bytes per microsecond, 0 if unknown.
+  double bytesPerUs() const;
+
+  /// Returns the process wide model for the storage that 'path' is on. Paths
+  /// with the same scheme, e.g. 's3://' or 'hdfs://', share a model. Paths
+  /// without a scheme share the model of the local file system.
+  static std::shared_ptr<IoLatencyModel> forPath(std::string_view path);
+
+ private:
+  // Weight of the existing samples when a new one is added. Makes the fit
+  // follow roughly the last thousand reads.
+  static constexpr double kDecay = 0.999;
+
+  // Fits the model and returns the latency and bandwidth. Both are 0 if the
+  // samples do not determine a model with positive latency and bandwidth.
+  std::pair<double, double> fitLocked() const;
+
+  mutable std::mutex mutex_;
+  // Weighted sums over the samples of size x and time y.
+  double count_{0};
+  double sumX_{0};
+  double sumY_{0};
+  double sumXX_{0};
+  double sumXY_{0};
+  int64_t numSamples_{0};
+
+  // The coalesce distance derived from the last fit, 0 if not known.
+  std::atomic<int32_t> distance_{0};
+};
+
+} // namespace facebook::velox::io
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/io/IoLatencyModel.h"
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::io {
@@ -104,6 +105,14 @@ class ReaderOptions {
     return *this;
   }
 
+  /// Sets the model of the storage the file is read from. When set, reads
+  /// are coalesced up to the distance the model learns from the reads made
+  /// through it instead of up to maxCoalesceDistance().
+  ReaderOptions& setIoLatencyModel(std::shared_ptr<IoLatencyModel> model) {
+    ioLatencyModel_ = std::move(model);
+    return *this;
+  }
+
   /// Modifies the number of row groups to prefetch.
   ReaderOptions& setPrefetchRowGroups(int32_t numPrefetch) {
     prefetchRowGroups_ = numPrefetch;
@@ -135,6 +144,19 @@ class ReaderOptions {
     return maxCoalesceBytes_;
   }
 
+  const std::shared_ptr<IoLatencyModel>& ioLatencyModel() const {
+    return ioLatencyModel_;
+  }
+
+  /// Returns the distance up to which to coalesce reads. This is the distance
+  /// learned by ioLatencyModel() if set and trained, else
+  /// maxCoalesceDistance().
+  int32_t coalesceDistance() const {
+    return ioLatencyModel_ == nullptr
+        ? maxCoalesceDistance_
+        : ioLatencyModel_->coalesceDistance(maxCoalesceDistance_);
+  }
+
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
@@ -154,6 +176,7 @@ class ReaderOptions {
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
+  std::shared_ptr<IoLatencyModel> ioLatencyModel_;
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
   bool cacheable_{true};
 };
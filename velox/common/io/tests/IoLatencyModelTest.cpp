@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoLatencyModel.h"
+#include <gtest/gtest.h>
+
+#include "velox/common/io/Options.h"
+
+namespace facebook::velox::io {
+
+TEST(IoLatencyModelTest, fit) {
+  // 20ms per request and 100 bytes/us is roughly an object store.
+  IoLatencyModel objectStore;
+  // 100us per request and 2000 bytes/us is roughly local flash.
+  IoLatencyModel flash;
+  constexpr int32_t kDefault = 512 << 10;
+  for (auto i = 0; i < IoLatencyModel::kMinSamples; ++i) {
+    EXPECT_EQ(objectStore.coalesceDistance(kDefault), kDefault);
+    const uint64_t bytes = (1 + i % 8) << 20;
+    objectStore.recordRead(bytes, 20'000 + bytes / 100);
+    flash.recordRead(bytes, 100 + bytes / 2'000);
+  }
+  EXPECT_NEAR(objectStore.latencyUs(), 20'000, 1);
+  EXPECT_NEAR(objectStore.bytesPerUs(), 100, 0.01);
+  EXPECT_NEAR(objectStore.coalesceDistance(kDefault), 2'000'000, 1'000);
+  EXPECT_NEAR(flash.coalesceDistance(kDefault), 200'000, 2'000);
+}
+
+TEST(IoLatencyModelTest, unknown) {
+  constexpr int32_t kDefault = 512 << 10;
+  // Reads of one size do not separate latency from transfer time.
+  IoLatencyModel sameSize;
+  for (auto i = 0; i < 2 * IoLatencyModel::kMinSamples; ++i) {
+    sameSize.recordRead(1 << 20, 1'000);
+  }
+  EXPECT_EQ(sameSize.latencyUs(), 0);
+  EXPECT_EQ(sameSize.coalesceDistance(kDefault), kDefault);
+
+  // Larger reads that are faster do not fit a positive bandwidth.
+  IoLatencyModel noisy;
+  for (auto i = 0; i < 2 * IoLatencyModel::kMinSamples; ++i) {
+    const uint64_t bytes = (1 + i % 8) << 20;
+    noisy.recordRead(bytes, 100'000 - bytes / 100);
+  }
+  EXPECT_EQ(noisy.coalesceDistance(kDefault), kDefault);
+}
+
+TEST(IoLatencyModelTest, clamp) {
+  IoLatencyModel model;
+  for (auto i = 0; i < IoLatencyModel::kMinSamples; ++i) {
+    const uint64_t bytes = (1 + i % 8) << 10;
+    model.recordRead(bytes, 1 + bytes / 1'000);
+  }
+  EXPECT_EQ(model.coalesceDistance(1), IoLatencyModel::kMinCoalesceDistance);
+}
+
+TEST(IoLatencyModelTest, forPath) {
+  EXPECT_EQ(
+      IoLatencyModel::forPath("s3://bucket/a"),
+      IoLatencyModel::forPath("s3://other/b"));
+  EXPECT_NE(
+      IoLatencyModel::forPath("s3://bucket/a"),
+      IoLatencyModel::forPath("hdfs://host/a"));
+  EXPECT_EQ(
+      IoLatencyModel::forPath("/tmp/a"), IoLatencyModel::forPath("/data/b"));
+}
+
+TEST(IoLatencyModelTest, readerOptions) {
+  ReaderOptions options(nullptr);
+  options.setMaxCoalesceDistance(100);
+  EXPECT_EQ(options.coalesceDistance(), 100);
+  auto model = std::make_shared<IoLatencyModel>();
+  options.setIoLatencyModel(model);
+  EXPECT_EQ(options.coalesceDistance(), 100);
+  for (auto i = 0; i < IoLatencyModel::kMinSamples; ++i) {
+    const uint64_t bytes = (1 + i % 8) << 20;
+    model->recordRead(bytes, 20'000 + bytes / 100);
+  }
+  EXPECT_NEAR(options.coalesceDistance(), 2'000'000, 1'000);
+}
+
+} // namespace facebook::velox::io
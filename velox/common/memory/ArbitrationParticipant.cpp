@@ -315,6 +315,9 @@ bool ArbitrationParticipant::grow(
   const bool success = pool_->grow(growBytes, reservationBytes);
   if (success) {
     growBytes_ += growBytes;
+    if (growBytes > 0) {
+      lastGrowBytes_ = growBytes;
+    }
   }
   return success;
 }
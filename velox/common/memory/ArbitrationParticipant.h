@@ -259,6 +259,12 @@ class ArbitrationParticipant
 
   int64_t globalArbitrationGrowCapacity() const;
 
+  /// Returns the capacity added by the last successful growth. Used to
+  /// forecast the next capacity growth.
+  uint64_t lastGrowBytes() const {
+    return lastGrowBytes_;
+  }
+
   /// Returns true if there is a running arbitration operation on this
   /// participant.
   bool hasRunningOp() const;
@@ -358,6 +364,7 @@ class ArbitrationParticipant
   tsan_atomic<uint32_t> numGrows_{0};
   tsan_atomic<uint64_t> reclaimedBytes_{0};
   tsan_atomic<uint64_t> growBytes_{0};
+  tsan_atomic<uint64_t> lastGrowBytes_{0};
 
   mutable std::timed_mutex reclaimMutex_;
 
@@ -142,6 +142,14 @@ void HashStringAllocator::clear() {
 
   state_.currentBytes() = 0;
   state_.sizeFromPool() = 0;
+  state_.appendTail() = nullptr;
+}
+
+void HashStringAllocator::setAppendOnly(bool appendOnly) {
+  VELOX_CHECK(
+      state_.pool().numRanges() == 0 && state_.sizeFromPool() == 0,
+      "Append-only mode can only be set on an empty HashStringAllocator");
+  state_.appendOnly() = appendOnly;
 }
 
 void* HashStringAllocator::allocateFromPool(size_t size) {
@@ -275,6 +283,13 @@ void HashStringAllocator::newSlab() {
 
   // Write end marker.
   *reinterpret_cast<uint32_t*>(run + available) = Header::kArenaEnd;
+  if (state_.appendOnly()) {
+    // The free tail of the previous slab, if any, is left unused.
+    auto* tail = new (run) Header(available - kHeaderSize);
+    tail->setFree();
+    state_.appendTail() = tail;
+    return;
+  }
   state_.currentBytes() += available;
 
   // Add the new memory to the free list: Placement construct a header that
@@ -345,6 +360,23 @@ StringView HashStringAllocator::contiguousString(
 }
 
 void HashStringAllocator::freeRestOfBlock(Header* header, int32_t keepBytes) {
+  if (state_.appendOnly()) {
+    // Only the block right below the tail can give back its end.
+    keepBytes = std::max(keepBytes, kMinAppendOnlyAlloc);
+    auto* tail = state_.appendTail();
+    if (header->end() != reinterpret_cast<char*>(tail) ||
+        header->size() <= keepBytes) {
+      return;
+    }
+    const auto freeSize = header->size() - keepBytes;
+    const auto tailSize = tail->size();
+    header->setSize(keepBytes);
+    tail = new (header->end()) Header(tailSize + freeSize);
+    tail->setFree();
+    state_.appendTail() = tail;
+    state_.currentBytes() -= freeSize;
+    return;
+  }
   keepBytes = std::max(keepBytes, kMinAlloc);
   const int32_t freeSize = header->size() - keepBytes - kHeaderSize;
   if (freeSize <= kMinAlloc) {
@@ -380,6 +412,10 @@ HashStringAllocator::Header* HashStringAllocator::allocate(
     return header;
   }
 
+  if (state_.appendOnly()) {
+    return allocateAppendOnly(size, exactSize);
+  }
+
   auto* header = allocateFromFreeLists(size, exactSize, exactSize);
   if (header == nullptr) {
     newSlab();
@@ -390,6 +426,31 @@ HashStringAllocator::Header* HashStringAllocator::allocate(
   return header;
 }
 
+HashStringAllocator::Header* HashStringAllocator::allocateAppendOnly(
+    int64_t size,
+    bool exactSize) {
+  size = std::max<int64_t>(size, kMinAppendOnlyAlloc);
+  const int64_t minSize =
+      exactSize ? size : std::min<int64_t>(size, kMinContiguous);
+  auto* tail = state_.appendTail();
+  if (tail == nullptr || tail->size() < minSize + kHeaderSize) {
+    newSlab();
+    tail = state_.appendTail();
+    VELOX_CHECK_GE(tail->size(), minSize + kHeaderSize);
+  }
+  const auto allocationSize =
+      std::min<int64_t>(size, tail->size() - kHeaderSize);
+  const auto tailSize = tail->size() - allocationSize - kHeaderSize;
+  auto* header = tail;
+  header->clearFree();
+  header->setSize(allocationSize);
+  tail = new (header->end()) Header(tailSize);
+  tail->setFree();
+  state_.appendTail() = tail;
+  state_.currentBytes() += blockBytes(header);
+  return header;
+}
+
 HashStringAllocator::Header* HashStringAllocator::allocateFromFreeLists(
     int32_t preferredSize,
     bool mustHaveSize,
@@ -452,6 +513,16 @@ void HashStringAllocator::free(Header* header) {
         state_.allocationsFromPool().find(headerToFree) !=
             state_.allocationsFromPool().end()) {
       freeToPool(headerToFree, headerToFree->size() + kHeaderSize);
+    } else if (state_.appendOnly()) {
+      VELOX_CHECK(!headerToFree->isFree());
+      state_.currentBytes() -= blockBytes(headerToFree);
+      auto* tail = state_.appendTail();
+      if (headerToFree->end() == reinterpret_cast<char*>(tail)) {
+        // The block below the tail becomes part of the tail.
+        headerToFree->setSize(headerToFree->size() + blockBytes(tail));
+        state_.appendTail() = headerToFree;
+      }
+      headerToFree->setFree();
     } else {
       VELOX_CHECK(!headerToFree->isFree());
       state_.freeBytes() += blockBytes(headerToFree);
@@ -567,6 +638,16 @@ inline bool HashStringAllocator::storeStringFast(
     const char* bytes,
     int32_t numBytes,
     char* destination) {
+  if (state_.appendOnly()) {
+    if (numBytes >= kMaxAlloc) {
+      return false;
+    }
+    auto* header = allocateAppendOnly(numBytes, true);
+    simd::memcpy(header->begin(), bytes, numBytes);
+    *reinterpret_cast<StringView*>(destination) =
+        StringView(reinterpret_cast<char*>(header->begin()), numBytes);
+    return true;
+  }
   const auto roundedBytes = std::max(numBytes, kMinAlloc);
 
   Header* header = nullptr;
@@ -709,7 +790,10 @@ int64_t HashStringAllocator::checkConsistency() const {
             reinterpret_cast<char*>(end));
         VELOX_CHECK_EQ(header->isPreviousFree(), previousFree);
 
-        if (header->isFree()) {
+        if (header->isFree() && state_.appendOnly()) {
+          // Free blocks in append-only mode are not in the free lists.
+          VELOX_CHECK(!header->isContinued());
+        } else if (header->isFree()) {
           VELOX_CHECK(!previousFree);
           VELOX_CHECK(!header->isContinued());
           if (header->next() != nullptr) {
@@ -728,7 +812,7 @@ int64_t HashStringAllocator::checkConsistency() const {
         } else {
           allocatedBytes += blockBytes(header);
         }
-        previousFree = header->isFree();
+        previousFree = header->isFree() && !state_.appendOnly();
         header = castToHeader(header->end());
       }
     }
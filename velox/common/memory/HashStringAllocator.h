@@ -41,6 +41,13 @@ struct StlAllocator;
 /// immediately below is free. In this case the uint32_t below the header has
 /// the size of the previous free block. The last word of a Allocation::PageRun
 /// backing a HashStringAllocator is set to kArenaEnd.
+///
+/// In append-only mode, see setAppendOnly(), blocks are cut from the start of
+/// the free tail of the last slab and there are no free lists. A freed block
+/// is returned to the tail if it is right below it and is left unused
+/// otherwise. The memory is released in bulk by clear(). This saves the free
+/// list maintenance and the minimum block size of kMinAlloc for users that
+/// rarely free, like accumulators that only grow until the group is output.
 class HashStringAllocator : public StreamArena {
  public:
   template <typename T>
@@ -210,7 +217,9 @@ class HashStringAllocator : public StreamArena {
     VELOX_CHECK_NULL(
         state_.currentHeader(),
         "Do not call allocate() when a write is in progress");
-    return allocate(std::max(size, kMinAlloc), true);
+    return allocate(
+        std::max(size, state_.appendOnly() ? kMinAppendOnlyAlloc : kMinAlloc),
+        true);
   }
 
   /// Allocates a block that is independently freeable but is freed on
@@ -318,6 +327,15 @@ class HashStringAllocator : public StreamArena {
   /// Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear() override;
 
+  /// Switches append-only mode on or off. May only be called when 'this' has
+  /// no memory, e.g. after construction or clear(). The mode is kept by
+  /// clear().
+  void setAppendOnly(bool appendOnly);
+
+  bool appendOnly() const {
+    return state_.appendOnly();
+  }
+
   memory::MemoryPool* pool() const {
     return state_.pool().pool();
   }
@@ -356,6 +374,9 @@ class HashStringAllocator : public StreamArena {
   static constexpr int32_t kMinContiguous = 48;
   static constexpr int32_t kNumFreeLists = kMaxAlloc - kMinAlloc + 2;
   static constexpr uint32_t kHeaderSize = sizeof(Header);
+  // The minimum block size in append-only mode. Leaves space for the continue
+  // pointer of a multipart allocation.
+  static constexpr int32_t kMinAppendOnlyAlloc = Header::kContinuedPtrSize;
 
   void newRange(
       int64_t bytes,
@@ -374,6 +395,11 @@ class HashStringAllocator : public StreamArena {
   // be smaller or larger. Checks free list before allocating new memory.
   Header* allocate(int64_t size, bool exactSize);
 
+  // Allocates a block from the start of 'appendTail_' in append-only mode.
+  // Starts a new slab if the tail is too small. If 'exactSize' is false, the
+  // block may be smaller than 'size'.
+  Header* allocateAppendOnly(int64_t size, bool exactSize);
+
   // Allocates memory from free list. Returns nullptr if no memory in free list,
   // otherwise returns a header of a free block of some size. if 'mustHaveSize'
   // is true, the block will not be smaller than 'preferredSize'. If
@@ -494,6 +520,13 @@ class HashStringAllocator : public StreamArena {
     // Sum of sizes in 'allocationsFromPool_'.
     DECLARE_FIELD_WITH_INIT_VALUE(int64_t, sizeFromPool, 0);
 
+    // True in append-only mode.
+    DECLARE_FIELD_WITH_INIT_VALUE(bool, appendOnly, false);
+
+    // The free block at the end of the last slab from which append-only mode
+    // allocates. It has kFree set but is not in 'freeLists_'.
+    DECLARE_FIELD_WITH_INIT_VALUE(Header*, appendTail, nullptr);
+
 #undef DECLARE_FIELD_WITH_INIT_VALUE
 #undef DECLARE_FIELD
 #undef DECLARE_GETTERS
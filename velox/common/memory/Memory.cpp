@@ -52,6 +52,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     allocatorOptions.largestSizeClass = options.largestSizeClassPages;
     allocatorOptions.useMmapArena = options.useMmapArena;
     allocatorOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    allocatorOptions.useHugeTlb = options.useHugeTlb;
     allocatorOptions.smallAllocationReservePct =
         options.smallAllocationReservePct;
     allocatorOptions.maxMallocBytes = options.maxMallocBytes;
@@ -143,6 +144,7 @@ MemoryManager::MemoryManager(const MemoryManager::Options& options)
       alignment_(std::max(MemoryAllocator::kMinAlignment, options.alignment)),
       checkUsageLeak_(options.checkUsageLeak),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      smallAllocationCacheBytes_(options.smallAllocationCacheBytes),
       disableMemoryPoolTracking_(options.disableMemoryPoolTracking),
       getPreferredSize_(options.getPreferredSize),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
@@ -296,6 +298,7 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.maxCapacity = maxCapacity;
   options.trackUsage = true;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.smallAllocationCacheBytes = smallAllocationCacheBytes_;
   options.getPreferredSize = getPreferredSize_;
   options.debugOptions = poolDebugOpts;
 
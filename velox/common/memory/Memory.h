@@ -81,6 +81,12 @@ class MemoryManager {
     /// failure
     bool coreOnAllocationFailureEnabled{false};
 
+    /// Specifies the max bytes of small allocations that each leaf memory pool
+    /// that is not thread-safe keeps for reuse after they are freed. 0
+    /// disables the cache. See
+    /// MemoryPool::Options::smallAllocationCacheBytes.
+    int64_t smallAllocationCacheBytes{0};
+
     /// Disables the memory manager's tracking on memory pools.
     bool disableMemoryPoolTracking{false};
 
@@ -112,6 +118,14 @@ class MemoryManager {
     /// NOTE: this only applies for MmapAllocator.
     int32_t mmapArenaCapacityRatio{10};
 
+    /// If true, contiguous allocations that are a multiple of the huge page
+    /// size are backed by explicit huge pages (MAP_HUGETLB) while the system
+    /// has free ones, and fall back to regular pages otherwise.
+    ///
+    /// NOTE: this only applies for MmapAllocator without 'useMmapArena' on
+    /// Linux.
+    bool useHugeTlb{false};
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
     /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will
@@ -315,6 +329,7 @@ class MemoryManager {
   const uint16_t alignment_;
   const bool checkUsageLeak_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t smallAllocationCacheBytes_;
   const bool disableMemoryPoolTracking_;
   const std::function<size_t(size_t)> getPreferredSize_;
 
@@ -372,6 +372,10 @@ Stats Stats::operator-(const Stats& other) const {
     result.sizes[i] = sizes[i] - other.sizes[i];
   }
   result.numAdvise = numAdvise - other.numAdvise;
+  result.numHugePageAligned = numHugePageAligned - other.numHugePageAligned;
+  result.numHugeTlb = numHugeTlb - other.numHugeTlb;
+  result.numHugeTlbFallback = numHugeTlbFallback - other.numHugeTlbFallback;
+  result.hugePageBytes = hugePageBytes - other.hugePageBytes;
   return result;
 }
 
@@ -391,6 +395,14 @@ std::string Stats::toString() const {
       totalClocks >> 30,
       totalAllocations,
       numAdvise >> 8);
+  if (hugePageBytes > 0 || numHugeTlbFallback > 0) {
+    out << fmt::format(
+        "Huge pages: {}MB aligned={} hugetlb={} hugetlbFallback={}\n",
+        hugePageBytes >> 20,
+        numHugePageAligned,
+        numHugeTlb,
+        numHugeTlbFallback);
+  }
 
   // Sort the size classes by decreasing clocks.
   std::vector<int32_t> indices(sizes.size());
@@ -136,6 +136,19 @@ struct Stats {
 
   /// Cumulative count of pages advised away, if the allocator exposes this.
   int64_t numAdvise{0};
+
+  /// Cumulative counts of contiguous allocations that were mapped at a huge
+  /// page boundary for transparent huge pages, that were backed by explicit
+  /// huge pages and that fell back to regular pages because no explicit huge
+  /// pages were free, if the allocator exposes these.
+  int64_t numHugePageAligned{0};
+  int64_t numHugeTlb{0};
+  int64_t numHugeTlbFallback{0};
+
+  /// Cumulative bytes of contiguous allocations that were mapped at a huge
+  /// page boundary or with explicit huge pages. Each huge page covers 512
+  /// regular pages with one TLB entry.
+  int64_t hugePageBytes{0};
 };
 
 class MemoryAllocator;
@@ -219,6 +232,13 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
     /// memory capacity to single MmapArena capacity ratio.
     int32_t mmapArenaCapacityRatio{10};
 
+    /// If true, contiguous allocations whose size is a multiple of
+    /// AllocationTraits::kHugePageSize are mmapped with MAP_HUGETLB from the
+    /// explicit huge pages of the system. If there are not enough free huge
+    /// pages, the allocation falls back to regular pages. Does not apply with
+    /// 'useMmapArena'. Only on Linux.
+    bool useHugeTlb{false};
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'capacity' for ad hoc small allocations delegated to std::malloc.
     /// If 'maxMallocBytes' is 0, this value will be disregarded.
@@ -524,6 +524,15 @@ void testingRunArbitration(
   static_cast<MemoryPoolImpl*>(pool)->testingCheckIfAborted();
 }
 
+void forecastMemoryGrowth(MemoryPool* pool, uint64_t growBytes) {
+  if (growBytes == 0) {
+    return;
+  }
+  auto* root = pool->root();
+  static_cast<MemoryPoolImpl*>(root)->arbitrator()->forecastGrowth(
+      root, growBytes);
+}
+
 ScopedReclaimedBytesRecorder::ScopedReclaimedBytesRecorder(
     MemoryPool* pool,
     int64_t* reclaimedBytes)
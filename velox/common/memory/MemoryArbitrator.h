@@ -198,6 +198,13 @@ class MemoryArbitrator {
       bool allowSpill = true,
       bool allowAbort = false) = 0;
 
+  /// Invoked to hint that the root memory 'pool' is expected to request
+  /// about 'growBytes' more memory soon, e.g. for the next rehash of a hash
+  /// table. An arbitrator can use this to reclaim memory from other pools
+  /// ahead of the request so that the request does not wait for it. The
+  /// default is no-op.
+  virtual void forecastGrowth(MemoryPool* /*pool*/, uint64_t /*growBytes*/) {}
+
   /// The internal execution stats of the memory arbitrator.
   struct Stats {
     /// The number of arbitration requests.
@@ -559,6 +566,11 @@ void testingRunArbitration(
     MemoryPool* pool,
     uint64_t targetBytes = 0,
     bool allowSpill = true);
+
+/// Passes the forecast that 'pool' is about to grow by 'growBytes' to
+/// MemoryArbitrator::forecastGrowth() of its memory manager with the root of
+/// 'pool'. 'pool' can be any pool of a memory pool tree.
+void forecastMemoryGrowth(MemoryPool* pool, uint64_t growBytes);
 } // namespace facebook::velox::memory
 
 #if FMT_VERSION < 100100
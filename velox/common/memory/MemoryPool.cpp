@@ -228,6 +228,7 @@ MemoryPool::MemoryPool(
       threadSafe_(options.threadSafe),
       debugOptions_(options.debugOptions),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      smallAllocationCacheBytes_(options.smallAllocationCacheBytes),
       getPreferredSize_(
           options.getPreferredSize == nullptr
               ? [](size_t size) { return MemoryPool::getPreferredSize(size); }
@@ -448,9 +449,18 @@ MemoryPoolImpl::MemoryPoolImpl(
       // actually used memory arbitration policy.
       capacity_(parent_ != nullptr ? kMaxMemory : 0) {
   VELOX_CHECK(options.threadSafe || isLeaf());
+  VELOX_CHECK_GE(smallAllocationCacheBytes_, 0);
+  // The debug mode records each allocation and free, so it does not cache.
+  // The cache is not synchronized: taking 'mutex_' on each small allocation
+  // and free of a thread-safe pool would cost more than the cache saves.
+  if (isLeaf() && !threadSafe_ && smallAllocationCacheBytes_ > 0 &&
+      !debugOptions_.has_value()) {
+    allocationCache_.resize(kMaxCachedAllocationSize / alignment_);
+  }
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
+  flushAllocationCache();
   DEBUG_LEAK_CHECK();
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
@@ -524,6 +534,9 @@ void* MemoryPoolImpl::allocate(
 
   CHECK_AND_INC_MEM_OP_STATS(this, Allocs);
   const auto alignedSize = sizeAlign(size);
+  if (void* cached = popCachedAllocation(alignedSize)) {
+    return cached;
+  }
   reserve(alignedSize);
   void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
@@ -590,10 +603,58 @@ void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(this, Frees);
   const auto alignedSize = sizeAlign(size);
   DEBUG_RECORD_FREE(p, size);
+  if (pushCachedAllocation(p, alignedSize)) {
+    return;
+  }
   allocator_->freeBytes(p, alignedSize);
   release(alignedSize);
 }
 
+void* MemoryPoolImpl::popCachedAllocation(int64_t alignedSize) {
+  if (allocationCache_.empty() || alignedSize == 0 ||
+      alignedSize > kMaxCachedAllocationSize) {
+    return nullptr;
+  }
+  auto& freeList = allocationCache_[alignedSize / alignment_ - 1];
+  if (freeList.empty()) {
+    return nullptr;
+  }
+  void* buffer = freeList.back();
+  freeList.pop_back();
+  cachedAllocationBytes_ -= alignedSize;
+  // The cached allocation is still counted in 'usedReservationBytes_'.
+  cumulativeBytes_ += alignedSize;
+  return buffer;
+}
+
+bool MemoryPoolImpl::pushCachedAllocation(void* p, int64_t alignedSize) {
+  if (allocationCache_.empty() || alignedSize == 0 ||
+      alignedSize > kMaxCachedAllocationSize) {
+    return false;
+  }
+  if (cachedAllocationBytes_ + alignedSize > smallAllocationCacheBytes_) {
+    return false;
+  }
+  allocationCache_[alignedSize / alignment_ - 1].push_back(p);
+  cachedAllocationBytes_ += alignedSize;
+  return true;
+}
+
+void MemoryPoolImpl::flushAllocationCache() {
+  if (allocationCache_.empty() || cachedAllocationBytes_ == 0) {
+    return;
+  }
+  for (auto i = 0; i < allocationCache_.size(); ++i) {
+    const int64_t size = (i + 1) * alignment_;
+    for (auto* buffer : allocationCache_[i]) {
+      allocator_->freeBytes(buffer, size);
+    }
+    allocationCache_[i].clear();
+  }
+  release(cachedAllocationBytes_);
+  cachedAllocationBytes_ = 0;
+}
+
 bool MemoryPoolImpl::transferTo(MemoryPool* dest, void* buffer, uint64_t size) {
   if (!isLeaf() || !dest->isLeaf()) {
     return false;
@@ -799,6 +860,7 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .smallAllocationCacheBytes = smallAllocationCacheBytes_,
           .getPreferredSize = getPreferredSize,
           .debugOptions = debugOptions_});
 }
@@ -1122,6 +1184,7 @@ uint64_t MemoryPoolImpl::reclaim(
     uint64_t targetBytes,
     uint64_t maxWaitMs,
     memory::MemoryReclaimer::Stats& stats) {
+  flushAllocationCache();
   if (reclaimer() == nullptr) {
     return 0;
   }
@@ -157,6 +157,15 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// failure
     bool coreOnAllocationFailureEnabled{false};
 
+    /// Specifies the max bytes of freed small allocations that a leaf memory
+    /// pool keeps in its free lists to serve the next allocations of the same
+    /// size without going through the reservation and the allocator. The
+    /// cached allocations count as used memory of the pool until they are
+    /// returned to the allocator by flushAllocationCache(), reclaim() or
+    /// destruction. Only used by leaf pools that are not thread-safe. 0
+    /// disables the cache. Child pools inherit it.
+    int64_t smallAllocationCacheBytes{0};
+
     /// Provides the customized get preferred size function. If not set, uses
     /// the memory pool's default function.
     std::function<size_t(size_t)> getPreferredSize{nullptr};
@@ -251,6 +260,11 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Frees an allocated buffer.
   virtual void free(void* p, int64_t size) = 0;
 
+  /// Returns the freed small allocations cached by this leaf memory pool to
+  /// the allocator and releases their memory usage. No-op if the cache is
+  /// disabled or empty.
+  virtual void flushAllocationCache() = 0;
+
   /// Transfer the ownership of memory at 'buffer' for 'size' bytes to the
   /// memory pool 'dest'. Returns true if the transfer succeeds.
   virtual bool
@@ -565,6 +579,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const std::optional<DebugOptions> debugOptions_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t smallAllocationCacheBytes_;
   std::function<size_t(size_t)> getPreferredSize_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
@@ -622,6 +637,16 @@ class MemoryPoolImpl : public MemoryPool {
 
   void free(void* p, int64_t size) override;
 
+  void flushAllocationCache() override;
+
+  /// Returns the bytes of the freed allocations in the small allocation cache.
+  int64_t cachedAllocationBytes() const {
+    return cachedAllocationBytes_;
+  }
+
+  /// The largest allocation size kept by the small allocation cache.
+  static constexpr int64_t kMaxCachedAllocationSize = 2048;
+
   bool transferTo(MemoryPool* dest, void* buffer, uint64_t size) override;
 
   void allocateNonContiguous(
@@ -716,6 +741,10 @@ class MemoryPoolImpl : public MemoryPool {
 
   Stats stats() const override;
 
+  MemoryArbitrator* arbitrator() const {
+    return arbitrator_;
+  }
+
   void testingSetCapacity(int64_t bytes);
 
   void testingSetReservation(int64_t bytes);
@@ -832,6 +861,13 @@ class MemoryPoolImpl : public MemoryPool {
     }
   }
 
+  // Returns a cached allocation of 'alignedSize' or nullptr if there is none.
+  void* popCachedAllocation(int64_t alignedSize);
+
+  // Keeps 'p' of 'alignedSize' in the small allocation cache. Returns false
+  // if 'p' is not cacheable or the cache is full.
+  bool pushCachedAllocation(void* p, int64_t alignedSize);
+
   void reserveThreadSafe(uint64_t size, bool reserveOnly = false);
 
   // Increments the reservation and checks against limits at root memory pool.
@@ -1072,6 +1108,12 @@ class MemoryPoolImpl : public MemoryPool {
   tsan_atomic<int64_t> peakBytes_{0};
   tsan_atomic<int64_t> cumulativeBytes_{0};
 
+  // Free lists of the small allocation cache by aligned size. The list at
+  // index 'i' has the allocations of size (i + 1) * 'alignment_'. Empty if
+  // the cache is disabled, which it is for thread-safe pools.
+  std::vector<std::vector<void*>> allocationCache_;
+  tsan_atomic<int64_t> cachedAllocationBytes_{0};
+
   // Stats counters.
   // The number of memory allocations.
   std::atomic_uint64_t numAllocs_{0};
@@ -23,11 +23,14 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
 
+DECLARE_bool(velox_memory_use_hugepages);
+
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
     : MemoryAllocator(options.largestSizeClass),
       kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
+      useHugeTlb_(options.useHugeTlb),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
           maxMallocBytes_ == 0
@@ -333,13 +336,7 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mmapContiguous(AllocationTraits::pageBytes(maxPages));
     }
   }
   if (data == nullptr || data == MAP_FAILED) {
@@ -364,6 +361,59 @@ bool MmapAllocator::allocateContiguousImpl(
   return true;
 }
 
+void* MmapAllocator::mmapContiguous(size_t bytes) {
+  constexpr auto kHugePageSize = AllocationTraits::kHugePageSize;
+#ifdef MAP_HUGETLB
+  if (useHugeTlb_ && bytes % kHugePageSize == 0) {
+    void* data = ::mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+        -1,
+        0);
+    if (data != MAP_FAILED) {
+      ++numHugeTlb_;
+      hugePageBytes_ += bytes;
+      return data;
+    }
+    // The explicit huge pages have run out.
+    ++numHugeTlbFallback_;
+  }
+#endif
+  if (!FLAGS_velox_memory_use_hugepages || bytes < kHugePageSize) {
+    return ::mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+  }
+  // Maps an extra huge page and unmaps the unaligned head and tail.
+  const auto mappedBytes = bytes + kHugePageSize;
+  auto* mapped = ::mmap(
+      nullptr,
+      mappedBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (mapped == MAP_FAILED) {
+    return mapped;
+  }
+  auto* begin = reinterpret_cast<char*>(mapped);
+  auto* data = reinterpret_cast<char*>(
+      bits::roundUp(reinterpret_cast<uint64_t>(begin), kHugePageSize));
+  if (data > begin) {
+    ::munmap(begin, data - begin);
+  }
+  ::munmap(data + bytes, begin + mappedBytes - (data + bytes));
+  ++numHugePageAligned_;
+  hugePageBytes_ += bytes;
+  return data;
+}
+
 void MmapAllocator::freeContiguous(ContiguousAllocation& allocation) {
   stats_.recordFree(
       allocation.size(), [&]() { freeContiguousImpl(allocation); });
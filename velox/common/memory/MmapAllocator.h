@@ -125,6 +125,10 @@ class MmapAllocator : public MemoryAllocator {
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
+    stats.numHugePageAligned = numHugePageAligned_;
+    stats.numHugeTlb = numHugeTlb_;
+    stats.numHugeTlbFallback = numHugeTlbFallback_;
+    stats.hugePageBytes = hugePageBytes_;
     return stats;
   }
 
@@ -341,6 +345,13 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Mmaps 'bytes' for a contiguous allocation. Uses explicit huge pages if
+  // 'useHugeTlb_' and 'bytes' is a multiple of the huge page size and there
+  // are free huge pages. Otherwise, a mapping of at least one huge page starts
+  // at a huge page boundary, so that transparent huge pages can back all of
+  // it. Returns MAP_FAILED on failure.
+  void* mmapContiguous(size_t bytes);
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -348,6 +359,10 @@ class MmapAllocator : public MemoryAllocator {
   // issued for each such allocation.
   const bool useMmapArena_;
 
+  // If true, contiguous allocations that are a multiple of the huge page size
+  // are first mmapped with MAP_HUGETLB.
+  const bool useHugeTlb_;
+
   // Serializes moving capacity between size classes
   std::mutex sizeClassBalanceMutex_;
 
@@ -375,6 +390,10 @@ class MmapAllocator : public MemoryAllocator {
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
+  std::atomic<uint64_t> numHugePageAligned_ = 0;
+  std::atomic<uint64_t> numHugeTlb_ = 0;
+  std::atomic<uint64_t> numHugeTlbFallback_ = 0;
+  std::atomic<uint64_t> hugePageBytes_ = 0;
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
   // Allocations that are larger than largest size classes will be delegated to
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/QueryAdmissionController.h"
+
+#include <optional>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::memory {
+
+QueryAdmissionController::QueryAdmissionController(
+    MemoryArbitrator* arbitrator,
+    const Config& config)
+    : arbitrator_(arbitrator), config_(config) {
+  VELOX_CHECK_NOT_NULL(arbitrator_);
+  VELOX_CHECK_GT(config_.maxFreeCapacityRatio, 0);
+  VELOX_CHECK_LE(config_.maxFreeCapacityRatio, 1);
+}
+
+ContinueFuture QueryAdmissionController::admit(
+    MemoryPool* pool,
+    uint64_t estimatedBytes,
+    int32_t priority) {
+  VELOX_CHECK_NOT_NULL(pool);
+  VELOX_CHECK(pool->isRoot(), "Queries are admitted by their root pool");
+  const auto bytes = estimateOf(estimatedBytes);
+  std::vector<ContinuePromise> admitted;
+  ContinueFuture future;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_EQ(
+        running_.count(pool), 0, "Query {} is already admitted", pool->name());
+    if (queue_.empty() && (running_.empty() || bytes <= headroomLocked())) {
+      running_.emplace(pool, Running{bytes});
+      ++stats_.numAdmitted;
+      return folly::makeSemiFuture();
+    }
+    ContinuePromise promise(
+        fmt::format("QueryAdmissionController::admit {}", pool->name()));
+    future = promise.getSemiFuture();
+    queue_.emplace(
+        QueueKey{-static_cast<int64_t>(priority), nextSequence_++},
+        Queued{pool, bytes, std::move(promise), getCurrentTimeMicro()});
+    // A query of higher priority than the queued ones may fit.
+    admitted = admitQueuedLocked();
+  }
+  for (auto& promise : admitted) {
+    promise.setValue();
+  }
+  return future;
+}
+
+void QueryAdmissionController::release(MemoryPool* pool) {
+  std::vector<ContinuePromise> admitted;
+  std::optional<ContinuePromise> cancelled;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (running_.erase(pool) == 0) {
+      for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+        if (it->second.pool == pool) {
+          cancelled = std::move(it->second.promise);
+          queue_.erase(it);
+          break;
+        }
+      }
+      VELOX_CHECK(
+          cancelled.has_value(), "Query {} is not admitted", pool->name());
+    }
+    admitted = admitQueuedLocked();
+  }
+  if (cancelled.has_value()) {
+    try {
+      VELOX_FAIL("Query {} is released before admission", pool->name());
+    } catch (const VeloxException& e) {
+      cancelled->setException(
+          folly::exception_wrapper(std::current_exception(), e));
+    }
+  }
+  for (auto& promise : admitted) {
+    promise.setValue();
+  }
+}
+
+void QueryAdmissionController::update() {
+  std::vector<ContinuePromise> admitted;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    admitted = admitQueuedLocked();
+  }
+  for (auto& promise : admitted) {
+    promise.setValue();
+  }
+}
+
+QueryAdmissionController::Stats QueryAdmissionController::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numRunning = running_.size();
+  stats.numQueued = queue_.size();
+  return stats;
+}
+
+uint64_t QueryAdmissionController::headroomLocked() const {
+  uint64_t expectedGrowth{0};
+  for (const auto& [pool, running] : running_) {
+    const uint64_t capacity = pool->capacity();
+    if (running.estimatedBytes > capacity) {
+      expectedGrowth += running.estimatedBytes - capacity;
+    }
+  }
+  const uint64_t freeBytes =
+      arbitrator_->stats().freeCapacityBytes * config_.maxFreeCapacityRatio;
+  return freeBytes > expectedGrowth ? freeBytes - expectedGrowth : 0;
+}
+
+std::vector<ContinuePromise> QueryAdmissionController::admitQueuedLocked() {
+  std::vector<ContinuePromise> admitted;
+  const auto nowUs = getCurrentTimeMicro();
+  // Admits in queue order only, so that a large query is not starved by
+  // smaller ones behind it.
+  while (!queue_.empty()) {
+    auto it = queue_.begin();
+    auto& queued = it->second;
+    if (!running_.empty() && queued.estimatedBytes > headroomLocked()) {
+      break;
+    }
+    running_.emplace(queued.pool, Running{queued.estimatedBytes});
+    ++stats_.numAdmitted;
+    ++stats_.numWaited;
+    stats_.queuedTimeUs += nowUs - std::min(nowUs, queued.enqueueTimeUs);
+    admitted.push_back(std::move(queued.promise));
+    queue_.erase(it);
+  }
+  return admitted;
+}
+} // namespace facebook::velox::memory
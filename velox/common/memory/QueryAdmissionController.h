@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "velox/common/future/VeloxPromise.h"
+#include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::velox::memory {
+
+/// Admits queries to run based on the free capacity of a memory arbitrator
+/// and the expected memory use of the queries. A query asks for admission
+/// with the root memory pool it will run in and an estimate of its peak
+/// memory, e.g. from the runtime statistics of earlier runs of the same plan.
+/// An admitted query is expected to still grow by its estimate minus the
+/// current capacity of its pool. A queued query is admitted once its estimate
+/// fits in the free arbitrator capacity that the admitted queries are not
+/// expected to take. Queued queries are admitted by descending priority and
+/// in arrival order within a priority.
+///
+/// This avoids admitting a burst of queries that together need more memory
+/// than there is, which makes the arbitrator spill and eventually abort
+/// queries after they have done part of their work.
+class QueryAdmissionController {
+ public:
+  struct Config {
+    /// The fraction of the free arbitrator capacity that the admitted queries
+    /// are expected to grow into. Less than 1 leaves room for queries that
+    /// use more than their estimate.
+    double maxFreeCapacityRatio{0.9};
+
+    /// The estimate for a query that is admitted without one.
+    uint64_t defaultQueryBytes{256 << 20};
+  };
+
+  struct Stats {
+    /// The number of admitted queries that are not released.
+    uint32_t numRunning{0};
+    /// The number of queries waiting for admission.
+    uint32_t numQueued{0};
+    /// The number of queries that were admitted, with or without waiting.
+    uint64_t numAdmitted{0};
+    /// The number of queries that had to wait for admission.
+    uint64_t numWaited{0};
+    /// The total time queries waited for admission in microseconds.
+    uint64_t queuedTimeUs{0};
+  };
+
+  QueryAdmissionController(MemoryArbitrator* arbitrator, const Config& config);
+
+  /// Asks to run the query with root memory pool 'pool', which is expected to
+  /// need up to 'estimatedBytes'. 0 means no estimate. Returns a future that
+  /// is fulfilled when the query is admitted. A query is always admitted if no
+  /// other query is running. The caller must call release() before 'pool' is
+  /// destroyed.
+  ContinueFuture
+  admit(MemoryPool* pool, uint64_t estimatedBytes, int32_t priority = 0);
+
+  /// Called when the query with 'pool' finishes or fails. If the query is
+  /// still queued, its future is fulfilled with an error. Admits the queued
+  /// queries that fit.
+  void release(MemoryPool* pool);
+
+  /// Admits the queued queries that fit. To be called periodically, since the
+  /// free capacity also changes without admissions and releases.
+  void update();
+
+  Stats stats() const;
+
+ private:
+  struct Running {
+    uint64_t estimatedBytes;
+  };
+
+  struct Queued {
+    MemoryPool* pool;
+    uint64_t estimatedBytes;
+    ContinuePromise promise;
+    uint64_t enqueueTimeUs;
+  };
+
+  // Sorts by descending priority, then by arrival.
+  using QueueKey = std::pair<int64_t, uint64_t>;
+
+  uint64_t estimateOf(uint64_t estimatedBytes) const {
+    return estimatedBytes == 0 ? config_.defaultQueryBytes : estimatedBytes;
+  }
+
+  // Returns the free arbitrator capacity that is not expected to be taken by
+  // the running queries.
+  uint64_t headroomLocked() const;
+
+  // Moves the queued queries that fit to 'running_' and returns their
+  // promises to fulfill outside of 'mutex_'.
+  std::vector<ContinuePromise> admitQueuedLocked();
+
+  MemoryArbitrator* const arbitrator_;
+  const Config config_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<MemoryPool*, Running> running_;
+  std::map<QueueKey, Queued> queue_;
+  uint64_t nextSequence_{0};
+  Stats stats_;
+};
+} // namespace facebook::velox::memory
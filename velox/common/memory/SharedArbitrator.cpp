@@ -243,6 +243,12 @@ bool SharedArbitrator::ExtraConfig::globalArbitrationWithoutSpill(
       kDefaultGlobalArbitrationWithoutSpill);
 }
 
+bool SharedArbitrator::ExtraConfig::proactiveReclaimEnabled(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return getConfig<bool>(
+      configs, kProactiveReclaimEnabled, kDefaultProactiveReclaimEnabled);
+}
+
 double SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(
     const std::unordered_map<std::string, std::string>& configs) {
   return getConfig<double>(
@@ -279,6 +285,9 @@ SharedArbitrator::SharedArbitrator(const Config& config)
           ExtraConfig::globalArbitrationAbortTimeRatio(config.extraConfigs)),
       globalArbitrationWithoutSpill_(
           ExtraConfig::globalArbitrationWithoutSpill(config.extraConfigs)),
+      proactiveReclaimEnabled_(
+          globalArbitrationEnabled_ &&
+          ExtraConfig::proactiveReclaimEnabled(config.extraConfigs)),
       freeReservedCapacity_(reservedCapacity_),
       freeNonReservedCapacity_(capacity_ - freeReservedCapacity_) {
   VELOX_CHECK_EQ(kind_, config.kind);
@@ -320,7 +329,8 @@ SharedArbitrator::SharedArbitrator(const Config& config)
                         << ", global arbitration abort time ratio "
                         << globalArbitrationAbortTimeRatio_
                         << ", global arbitration skip spill "
-                        << globalArbitrationWithoutSpill_;
+                        << globalArbitrationWithoutSpill_
+                        << ", proactive reclaim " << proactiveReclaimEnabled_;
   }
   VELOX_MEM_LOG(INFO) << "Memory pool participant config: "
                       << participantConfig_.toString();
@@ -886,6 +896,55 @@ void SharedArbitrator::growCapacity(MemoryPool* pool, uint64_t requestBytes) {
     updateArbitrationFailureStats();
     std::rethrow_exception(std::current_exception());
   }
+
+  // A participant that keeps growing is likely to grow by about as much next
+  // time, e.g. by a hash table rehash or a doubling buffer.
+  if (proactiveReclaimEnabled_) {
+    maybeStartProactiveReclaim(
+        op.participant(), op.participant()->lastGrowBytes());
+  }
+}
+
+void SharedArbitrator::forecastGrowth(MemoryPool* pool, uint64_t growBytes) {
+  if (!proactiveReclaimEnabled_ || growBytes == 0) {
+    return;
+  }
+  VELOX_CHECK(pool->isRoot());
+  auto participant = getParticipant(pool->name());
+  if (!participant.has_value()) {
+    return;
+  }
+  maybeStartProactiveReclaim(participant.value(), growBytes);
+}
+
+void SharedArbitrator::maybeStartProactiveReclaim(
+    const ScopedArbitrationParticipant& participant,
+    uint64_t forecastBytes) {
+  const uint64_t capacity = participant->capacity();
+  const uint64_t reservedBytes = participant->pool()->reservedBytes();
+  const uint64_t freeBytes =
+      capacity > reservedBytes ? capacity - reservedBytes : 0;
+  if (forecastBytes <= freeBytes) {
+    return;
+  }
+  const uint64_t maxGrowBytes = participant->maxCapacity() > capacity
+      ? participant->maxCapacity() - capacity
+      : 0;
+  const uint64_t needBytes =
+      std::min<uint64_t>(forecastBytes - freeBytes, maxGrowBytes);
+  if (needBytes == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> l(stateMutex_);
+    if (hasShutdownLocked() || freeNonReservedCapacity_ >= needBytes) {
+      return;
+    }
+    proactiveReclaimBytes_ = std::max<uint64_t>(
+        proactiveReclaimBytes_, needBytes - freeNonReservedCapacity_);
+    proactiveReclaimRequestors_.insert(participant->id());
+  }
+  globalArbitrationThreadCv_.notify_one();
 }
 
 void SharedArbitrator::growCapacity(ArbitrationOperation& op) {
@@ -1045,18 +1104,25 @@ void SharedArbitrator::updateGlobalArbitrationStats(
 void SharedArbitrator::globalArbitrationMain() {
   VELOX_MEM_LOG(INFO) << "Global arbitration controller started";
   while (true) {
+    bool proactive{false};
     {
       std::unique_lock<std::mutex> l(stateMutex_);
       globalArbitrationThreadCv_.wait(l, [&] {
-        return hasShutdownLocked() || !globalArbitrationWaiters_.empty();
+        return hasShutdownLocked() || !globalArbitrationWaiters_.empty() ||
+            proactiveReclaimBytes_ > 0;
       });
       if (hasShutdownLocked()) {
         VELOX_CHECK(globalArbitrationWaiters_.empty());
         break;
       }
+      proactive = globalArbitrationWaiters_.empty();
     }
     GlobalArbitrationSection section{this};
-    runGlobalArbitration();
+    if (proactive) {
+      runProactiveReclaim();
+    } else {
+      runGlobalArbitration();
+    }
   }
   VELOX_MEM_LOG(INFO) << "Global arbitration controller stopped";
 }
@@ -1124,6 +1190,35 @@ void SharedArbitrator::runGlobalArbitration() {
                       << " with " << round << " rounds";
 }
 
+void SharedArbitrator::runProactiveReclaim() {
+  uint64_t targetBytes{0};
+  std::unordered_set<uint64_t> requestors;
+  {
+    std::lock_guard<std::mutex> l(stateMutex_);
+    targetBytes = std::exchange(proactiveReclaimBytes_, 0);
+    requestors.swap(proactiveReclaimRequestors_);
+    // The free capacity might have grown since the request.
+    targetBytes = targetBytes > freeNonReservedCapacity_
+        ? targetBytes - freeNonReservedCapacity_
+        : 0;
+  }
+  if (targetBytes == 0) {
+    return;
+  }
+
+  // The requestors are taken as reclaimed so that they are not spilled.
+  std::unordered_set<uint64_t> failedParticipants;
+  bool allParticipantsReclaimed{false};
+  const uint64_t reclaimedBytes = reclaimUsedMemoryBySpill(
+      targetBytes, requestors, failedParticipants, allParticipantsReclaimed);
+  reclaimUnusedCapacity();
+  ++numProactiveReclaims_;
+  proactiveReclaimedBytes_ += reclaimedBytes;
+  VELOX_MEM_LOG(INFO) << "Proactive reclaim reclaimed "
+                      << succinctBytes(reclaimedBytes) << " with target "
+                      << succinctBytes(targetBytes);
+}
+
 uint64_t SharedArbitrator::getGlobalArbitrationTarget() {
   uint64_t targetBytes{0};
   std::lock_guard<std::mutex> l(stateMutex_);
@@ -242,6 +242,18 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     static bool globalArbitrationWithoutSpill(
         const std::unordered_map<std::string, std::string>& configs);
 
+    /// If true, the global arbitration thread spills from other participants
+    /// at the background when the forecasted capacity growth of a participant
+    /// exceeds the free capacity, so that the growth does not have to wait
+    /// for the spill. The forecast is the last capacity growth of the
+    /// participant or the hint passed to forecastGrowth(). This flag is only
+    /// effective if 'global-arbitration-enabled' is true.
+    static constexpr std::string_view kProactiveReclaimEnabled{
+        "proactive-reclaim-enabled"};
+    static constexpr bool kDefaultProactiveReclaimEnabled{false};
+    static bool proactiveReclaimEnabled(
+        const std::unordered_map<std::string, std::string>& configs);
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -268,6 +280,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   void growCapacity(MemoryPool* pool, uint64_t requestBytes) final;
 
+  void forecastGrowth(MemoryPool* pool, uint64_t growBytes) final;
+
   /// NOTE: only support shrinking away all the unused free capacity for now.
   uint64_t shrinkCapacity(MemoryPool* pool, uint64_t requestBytes) final;
 
@@ -420,6 +434,20 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // Invoked by global arbitration control thread to run global arbitration.
   void runGlobalArbitration();
 
+  // Invoked when 'participant' is forecasted to grow by 'forecastBytes'. If
+  // the free capacity of the participant and the arbitrator can't cover it,
+  // wakes up the global arbitration thread to reclaim the shortfall from the
+  // other participants by spilling.
+  void maybeStartProactiveReclaim(
+      const ScopedArbitrationParticipant& participant,
+      uint64_t forecastBytes);
+
+  // Invoked by global arbitration control thread to reclaim the memory
+  // requested by 'maybeStartProactiveReclaim()' when there is no waiter. It
+  // only spills and never aborts, and skips the participants that requested
+  // it.
+  void runProactiveReclaim();
+
   // Helper method used by 'runGlobalArbitration()' to decide if current
   // iteration of global run should directly reclaim capacity by aborting
   // queries.
@@ -639,6 +667,7 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   const uint32_t globalArbitrationMemoryReclaimPct_;
   const double globalArbitrationAbortTimeRatio_;
   const bool globalArbitrationWithoutSpill_;
+  const bool proactiveReclaimEnabled_;
 
   // The executor used to reclaim memory from multiple participants in parallel
   // at the background for global arbitration or external memory reclamation.
@@ -697,9 +726,16 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // arbitration participants with old participants being served first.
   std::map<uint64_t, ArbitrationWait*> globalArbitrationWaiters_;
 
+  // The bytes to reclaim by the next proactive reclaim run and the ids of the
+  // participants that requested it.
+  uint64_t proactiveReclaimBytes_{0};
+  std::unordered_set<uint64_t> proactiveReclaimRequestors_;
+
   tsan_atomic<uint64_t> globalArbitrationRuns_{0};
   tsan_atomic<uint64_t> globalArbitrationTimeNs_{0};
   tsan_atomic<uint64_t> globalArbitrationBytes_{0};
+  tsan_atomic<uint64_t> numProactiveReclaims_{0};
+  tsan_atomic<uint64_t> proactiveReclaimedBytes_{0};
 
   std::atomic_uint64_t numRequests_{0};
   std::atomic_uint32_t numRunning_{0};
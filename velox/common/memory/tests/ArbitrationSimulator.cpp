@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include <thread>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/time/Timer.h"
+
+DEFINE_uint64(memory_capacity_mb, 4096, "The capacity of the memory in MB");
+DEFINE_string(
+    arbitrator_configs,
+    "",
+    "Semicolon separated SharedArbitrator configs to simulate one after "
+    "another. Each is a comma separated list of name=value, e.g. "
+    "'memory-pool-initial-capacity=64MB;global-arbitration-enabled=false'. "
+    "An empty config uses the defaults");
+DEFINE_uint32(num_threads, 16, "The number of queries running at a time");
+DEFINE_uint32(num_queries, 256, "The number of queries run per config");
+DEFINE_uint32(
+    hash_build_pct,
+    40,
+    "Percentage of the queries that build a hash table, that doubles as the "
+    "rows grow");
+DEFINE_uint32(
+    sort_pct,
+    40,
+    "Percentage of the queries that accumulate rows to sort. The other "
+    "queries hold memory that cannot be reclaimed");
+DEFINE_uint64(min_query_mb, 64, "The least memory a query needs in MB");
+DEFINE_uint64(max_query_mb, 1024, "The most memory a query needs in MB");
+DEFINE_uint64(chunk_kb, 1024, "The size of a row allocation of a query");
+DEFINE_uint32(
+    chunk_work_us,
+    50,
+    "The time a query computes between two row allocations");
+DEFINE_uint32(
+    spill_mb_per_sec,
+    500,
+    "The speed of spilling memory to disk and of reading it back");
+DEFINE_uint64(seed, 1234, "The seed of the query mix");
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+namespace {
+
+constexpr uint64_t kMB = 1 << 20;
+
+// Sleeps for the time to spill or read back 'bytes'. A MB per second moves
+// about a byte per microsecond.
+void sleepForBytes(uint64_t bytes) {
+  std::this_thread::sleep_for(
+      std::chrono::microseconds(bytes / FLAGS_spill_mb_per_sec));
+}
+
+struct SimulationStats {
+  std::atomic<uint64_t> numCompleted{0};
+  std::atomic<uint64_t> numAborted{0};
+  std::atomic<uint64_t> numFailed{0};
+  std::atomic<uint64_t> numSpills{0};
+  std::atomic<uint64_t> spilledBytes{0};
+  std::atomic<uint64_t> allocatedBytes{0};
+
+  std::mutex mutex;
+  // The time of each allocation in microseconds. Includes the time the
+  // allocation waits for arbitration.
+  std::vector<uint64_t> allocationUs;
+};
+
+/// A synthetic query whose root pool is an arbitration participant. It has a
+/// single operator that allocates rows in chunks until it has taken in
+/// 'targetBytes', and can spill them when the arbitrator reclaims it.
+class SimulatedQuery : public std::enable_shared_from_this<SimulatedQuery> {
+ public:
+  enum class Pattern {
+    /// Rows plus a hash table that doubles when the rows outgrow it.
+    kHashBuild,
+    /// Rows plus a final array of row pointers to sort.
+    kSort,
+    /// Rows that cannot be reclaimed.
+    kFixed,
+  };
+
+  static std::shared_ptr<SimulatedQuery> create(
+      MemoryManager* manager,
+      int32_t id,
+      Pattern pattern,
+      uint64_t targetBytes,
+      SimulationStats& stats) {
+    auto query =
+        std::make_shared<SimulatedQuery>(pattern, targetBytes, stats);
+    query->root_ = manager->addRootPool(
+        fmt::format("query{}", id), kMaxMemory, MemoryReclaimer::create());
+    query->leaf_ = query->root_->addLeafChild(
+        "operator", true, std::make_unique<Reclaimer>(query));
+    return query;
+  }
+
+  SimulatedQuery(Pattern pattern, uint64_t targetBytes, SimulationStats& stats)
+      : pattern_(pattern), targetBytes_(targetBytes), stats_(stats) {}
+
+  ~SimulatedQuery() {
+    freeAll();
+    leaf_.reset();
+    root_.reset();
+  }
+
+  /// Runs the query to completion or until it is aborted or fails to get
+  /// memory.
+  void run() {
+    try {
+      while (inputBytes_ < targetBytes_) {
+        addRows();
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(FLAGS_chunk_work_us));
+      }
+      if (pattern_ == Pattern::kSort) {
+        // 8 bytes per row pointer of rows of about 64 bytes.
+        allocate(Kind::kTable, rowBytes() / 8);
+      }
+      // Reads back what was spilled.
+      sleepForBytes(spilledBytes_);
+      ++stats_.numCompleted;
+    } catch (const VeloxException& e) {
+      if (e.errorCode() == error_code::kMemAborted) {
+        ++stats_.numAborted;
+      } else if (
+          e.errorCode() == error_code::kMemCapExceeded ||
+          e.errorCode() == error_code::kMemArbitrationTimeout) {
+        ++stats_.numFailed;
+      } else {
+        throw;
+      }
+    }
+    freeAll();
+  }
+
+ private:
+  // The arbitrator may still hold the pool of a query that has finished, so
+  // the reclaimer does not keep the query alive.
+  class Reclaimer : public MemoryReclaimer {
+   public:
+    explicit Reclaimer(const std::shared_ptr<SimulatedQuery>& query)
+        : MemoryReclaimer(0), query_(query) {}
+
+    bool reclaimableBytes(const MemoryPool& /*pool*/, uint64_t& bytes)
+        const override {
+      bytes = 0;
+      auto query = query_.lock();
+      if (query == nullptr || query->pattern_ == Pattern::kFixed) {
+        return false;
+      }
+      bytes = query->usedBytes();
+      return true;
+    }
+
+    uint64_t reclaim(
+        MemoryPool* /*pool*/,
+        uint64_t /*targetBytes*/,
+        uint64_t /*maxWaitMs*/,
+        Stats& stats) override {
+      auto query = query_.lock();
+      if (query == nullptr || query->pattern_ == Pattern::kFixed) {
+        return 0;
+      }
+      const auto bytes = query->spill();
+      stats.reclaimedBytes += bytes;
+      return bytes;
+    }
+
+    void abort(MemoryPool* /*pool*/, const std::exception_ptr& /*error*/)
+        override {
+      if (auto query = query_.lock()) {
+        query->abort();
+      }
+    }
+
+   private:
+    const std::weak_ptr<SimulatedQuery> query_;
+  };
+
+  enum class Kind { kRows, kTable };
+
+  struct Buffer {
+    void* data;
+    uint64_t size;
+  };
+
+  void addRows() {
+    const auto chunkBytes = FLAGS_chunk_kb << 10;
+    allocate(Kind::kRows, chunkBytes);
+    inputBytes_ += chunkBytes;
+    if (pattern_ != Pattern::kHashBuild) {
+      return;
+    }
+    uint64_t tableBytes;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      tableBytes = table_.has_value() ? table_->size : 0;
+    }
+    // A table of 16 byte entries at a load factor of 50% for rows of about
+    // 64 bytes.
+    const auto neededBytes = rowBytes() / 2;
+    if (neededBytes <= tableBytes) {
+      return;
+    }
+    // The old table is freed after the rows are moved to the new one.
+    allocate(Kind::kTable, std::max(2 * tableBytes, chunkBytes));
+  }
+
+  void allocate(Kind kind, uint64_t bytes) {
+    void* data;
+    {
+      uint64_t allocationUs = 0;
+      MicrosecondTimer timer(&allocationUs);
+      data = leaf_->allocate(bytes);
+      std::lock_guard<std::mutex> l(stats_.mutex);
+      stats_.allocationUs.push_back(allocationUs);
+    }
+    stats_.allocatedBytes += bytes;
+    std::optional<Buffer> oldTable;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (aborted_) {
+        leaf_->free(data, bytes);
+        VELOX_MEM_POOL_ABORTED("Aborted by the arbitrator");
+      }
+      if (kind == Kind::kRows) {
+        rows_.push_back({data, bytes});
+        rowBytes_ += bytes;
+      } else {
+        oldTable.swap(table_);
+        table_ = Buffer{data, bytes};
+      }
+    }
+    if (oldTable.has_value()) {
+      leaf_->free(oldTable->data, oldTable->size);
+    }
+  }
+
+  uint64_t rowBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return rowBytes_;
+  }
+
+  uint64_t usedBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return rowBytes_ + (table_.has_value() ? table_->size : 0);
+  }
+
+  // Frees the rows and the table. Returns their total size.
+  uint64_t freeAll() {
+    std::vector<Buffer> buffers;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      buffers.swap(rows_);
+      if (table_.has_value()) {
+        buffers.push_back(*table_);
+        table_.reset();
+      }
+      rowBytes_ = 0;
+    }
+    uint64_t bytes = 0;
+    for (const auto& buffer : buffers) {
+      leaf_->free(buffer.data, buffer.size);
+      bytes += buffer.size;
+    }
+    return bytes;
+  }
+
+  // Writes the rows to disk and frees them with the table, which is rebuilt
+  // from the rows that come after.
+  uint64_t spill() {
+    uint64_t spillBytes;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      spillBytes = rowBytes_;
+    }
+    sleepForBytes(spillBytes);
+    const auto bytes = freeAll();
+    spilledBytes_ += spillBytes;
+    ++stats_.numSpills;
+    stats_.spilledBytes += spillBytes;
+    return bytes;
+  }
+
+  void abort() {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      aborted_ = true;
+    }
+    freeAll();
+  }
+
+  const Pattern pattern_;
+  const uint64_t targetBytes_;
+  SimulationStats& stats_;
+  std::shared_ptr<MemoryPool> root_;
+  std::shared_ptr<MemoryPool> leaf_;
+
+  // The bytes of rows taken in, in memory or spilled.
+  uint64_t inputBytes_{0};
+  std::atomic<uint64_t> spilledBytes_{0};
+
+  mutable std::mutex mutex_;
+  bool aborted_{false};
+  std::vector<Buffer> rows_;
+  uint64_t rowBytes_{0};
+  std::optional<Buffer> table_;
+};
+
+std::unordered_map<std::string, std::string> parseConfig(
+    std::string_view config) {
+  std::vector<std::string> items;
+  folly::split(',', config, items, true);
+  std::unordered_map<std::string, std::string> result;
+  for (const auto& item : items) {
+    const auto equals = item.find('=');
+    VELOX_USER_CHECK(
+        equals != std::string::npos,
+        "Arbitrator config must be name=value: {}",
+        item);
+    result[item.substr(0, equals)] = item.substr(equals + 1);
+  }
+  return result;
+}
+
+uint64_t percentile(const std::vector<uint64_t>& sorted, double pct) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  return sorted[std::min<size_t>(
+      sorted.size() - 1, static_cast<size_t>(sorted.size() * pct / 100))];
+}
+
+void simulate(const std::string& config) {
+  MemoryManager::Options options;
+  options.allocatorCapacity = FLAGS_memory_capacity_mb * kMB;
+  options.arbitratorKind = "SHARED";
+  options.extraArbitratorConfigs = parseConfig(config);
+  MemoryManager manager(options);
+
+  SimulationStats stats;
+  std::atomic<uint32_t> nextQuery{0};
+  auto runQueries = [&]() {
+    uint32_t id;
+    while ((id = nextQuery++) < FLAGS_num_queries) {
+      // Seeded by the query so that every config runs the same queries.
+      folly::Random::DefaultGenerator rng(FLAGS_seed + id);
+      const auto kind = folly::Random::rand32(100, rng);
+      const auto pattern = kind < FLAGS_hash_build_pct
+          ? SimulatedQuery::Pattern::kHashBuild
+          : kind < FLAGS_hash_build_pct + FLAGS_sort_pct
+          ? SimulatedQuery::Pattern::kSort
+          : SimulatedQuery::Pattern::kFixed;
+      const auto targetBytes = kMB *
+          folly::Random::rand64(
+              FLAGS_min_query_mb, FLAGS_max_query_mb + 1, rng);
+      SimulatedQuery::create(&manager, id, pattern, targetBytes, stats)->run();
+    }
+  };
+
+  uint64_t wallUs = 0;
+  {
+    MicrosecondTimer timer(&wallUs);
+    std::vector<std::thread> threads;
+    threads.reserve(FLAGS_num_threads);
+    for (auto i = 0; i < FLAGS_num_threads; ++i) {
+      threads.emplace_back(runQueries);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  auto& allocationUs = stats.allocationUs;
+  std::sort(allocationUs.begin(), allocationUs.end());
+  uint64_t totalAllocationUs = 0;
+  for (auto us : allocationUs) {
+    totalAllocationUs += us;
+  }
+  const double wallSecs = wallUs / 1'000'000.0;
+  std::cout << "Config: " << (config.empty() ? "defaults" : config)
+            << std::endl
+            << fmt::format(
+                   "  {:.2f}s wall, {:.2f} queries/s, {}/s allocated",
+                   wallSecs,
+                   stats.numCompleted / wallSecs,
+                   succinctBytes(stats.allocatedBytes / wallSecs))
+            << std::endl
+            << "  " << stats.numCompleted << " completed, "
+            << stats.numAborted << " aborted, " << stats.numFailed
+            << " failed" << std::endl
+            << "  " << stats.numSpills << " spills of "
+            << succinctBytes(stats.spilledBytes) << std::endl
+            << "  allocation time p50 " << percentile(allocationUs, 50)
+            << "us, p99 " << percentile(allocationUs, 99) << "us, max "
+            << percentile(allocationUs, 100) << "us, total "
+            << succinctMicros(totalAllocationUs) << std::endl
+            << "  " << manager.arbitrator()->stats().toString() << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::SetUsageMessage(
+      "Simulates concurrent queries that grow, spill and get aborted under "
+      "the SharedArbitrator, and reports throughput, aborts and allocation "
+      "wait times for each arbitrator config.");
+  folly::Init init{&argc, &argv, false};
+  VELOX_USER_CHECK_LE(FLAGS_hash_build_pct + FLAGS_sort_pct, 100);
+  VELOX_USER_CHECK_LE(FLAGS_min_query_mb, FLAGS_max_query_mb);
+  VELOX_USER_CHECK_GT(FLAGS_spill_mb_per_sec, 0);
+  SharedArbitrator::registerFactory();
+
+  std::vector<std::string> configs;
+  folly::split(';', FLAGS_arbitrator_configs, configs);
+  for (const auto& config : configs) {
+    simulate(config);
+  }
+  return 0;
+}
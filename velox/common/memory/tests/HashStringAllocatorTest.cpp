@@ -731,6 +731,61 @@ TEST_F(HashStringAllocatorTest, storeStringFast) {
   ASSERT_EQ(allocatedBytes, allocator_->currentBytes());
 }
 
+TEST_F(HashStringAllocatorTest, appendOnly) {
+  allocator_->setAppendOnly(true);
+  ASSERT_TRUE(allocator_->appendOnly());
+
+  // Blocks are cut one after the other without rounding up to kMinAlloc.
+  auto* h1 = allocate(1);
+  auto* h2 = allocate(100);
+  ASSERT_EQ(h1->size(), 8);
+  ASSERT_EQ(h2->size(), 100);
+  ASSERT_EQ(h2, HSA::castToHeader(h1->end()));
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+  VELOX_ASSERT_THROW(
+      allocator_->setAppendOnly(false),
+      "Append-only mode can only be set on an empty HashStringAllocator");
+
+  // Freeing the last block gives its space back. Other freed blocks stay
+  // unused.
+  allocator_->free(h2);
+  ASSERT_EQ(allocate(100), h2);
+  allocator_->free(h1);
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+  ASSERT_NE(allocate(1), h1);
+
+  // Multipart writes and strings larger than a slab.
+  std::vector<Multipart> data(20);
+  for (auto i = 0; i < data.size(); ++i) {
+    data[i].reference.assign(i * 7'000 + 13, 'a' + i);
+    ByteOutputStream stream(allocator_.get());
+    data[i].start = allocator_->newWrite(stream);
+    stream.appendStringView(data[i].reference);
+    data[i].current = allocator_->finishWrite(stream, 0).second;
+  }
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+  for (auto& multipart : data) {
+    checkAndFree(multipart);
+  }
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+
+  char group[sizeof(StringView)];
+  const std::string str(100, 'x');
+  allocator_->copyMultipart(StringView(str), group, 0);
+  std::string storage;
+  ASSERT_EQ(
+      HSA::contiguousString(*reinterpret_cast<StringView*>(group), storage),
+      StringView(str));
+
+  // clear() releases all memory and keeps the mode.
+  allocator_->clear();
+  ASSERT_TRUE(allocator_->appendOnly());
+  ASSERT_TRUE(allocator_->isEmpty());
+  ASSERT_EQ(allocator_->currentBytes(), 0);
+  allocate(10);
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+}
+
 TEST_F(HashStringAllocatorTest, clear) {
   allocator_->allocate(HashStringAllocator::kMinAlloc);
   allocator_->allocate(HashStringAllocator::kMaxAlloc + 1);
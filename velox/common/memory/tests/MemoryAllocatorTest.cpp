@@ -1013,6 +1013,45 @@ TEST_P(MemoryAllocatorTest, allocContiguous) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, allocContiguousHugePages) {
+  if (!useMmap_) {
+    return;
+  }
+  for (const bool useHugeTlb : {false, true}) {
+    SCOPED_TRACE(fmt::format("useHugeTlb {}", useHugeTlb));
+    MemoryAllocator::Options options;
+    options.capacity = kCapacityBytes;
+    options.useHugeTlb = useHugeTlb;
+    MmapAllocator allocator(options);
+    ContiguousAllocation allocation;
+    const auto numPages = 2 * AllocationTraits::numPagesInHugePage();
+    ASSERT_TRUE(allocator.allocateContiguous(numPages, nullptr, allocation));
+    EXPECT_EQ(
+        reinterpret_cast<uint64_t>(allocation.data()) %
+            AllocationTraits::kHugePageSize,
+        0);
+    std::memset(allocation.data(), 1, allocation.size());
+    auto stats = allocator.stats();
+    EXPECT_EQ(stats.hugePageBytes, allocation.size());
+    if (useHugeTlb) {
+      // Falls back to aligned regular pages if the system has no free huge
+      // pages.
+      EXPECT_EQ(stats.numHugeTlb + stats.numHugeTlbFallback, 1);
+      EXPECT_EQ(stats.numHugePageAligned, stats.numHugeTlbFallback);
+    } else {
+      EXPECT_EQ(stats.numHugePageAligned, 1);
+      EXPECT_EQ(stats.numHugeTlb, 0);
+    }
+    allocator.freeContiguous(allocation);
+
+    // Allocations smaller than a huge page are mapped as before.
+    ASSERT_TRUE(allocator.allocateContiguous(100, nullptr, allocation));
+    EXPECT_EQ(allocator.stats().hugePageBytes, stats.hugePageBytes);
+    allocator.freeContiguous(allocation);
+    ASSERT_EQ(allocator.numExternalMapped(), 0);
+  }
+}
+
 TEST_P(MemoryAllocatorTest, allocContiguousFail) {
   struct {
     MachinePageCount nonContiguousPages;
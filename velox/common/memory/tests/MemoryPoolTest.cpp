@@ -770,7 +770,8 @@ TEST_P(MemoryPoolTest, memoryCapExceptions) {
                     "0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n "
                     "num write wait: 0 empty entries: 0\nCache access miss: 0 "
                     "hit: 0 hit bytes: 0B eviction: 0 savable eviction: 0 eviction checks: 0 "
-                    "aged out: 0 stales: 0\nPrefetch entries: 0 bytes: 0B\nAlloc Megaclocks 0\n"
+                    "aged out: 0 stales: 0\nEviction policy: lru hit ratio: 0.00% "
+                    "admission rejects: 0\nPrefetch entries: 0 bytes: 0B\nAlloc Megaclocks 0\n"
                     "Allocated pages: 0 cached pages: 0\n",
                     isLeafThreadSafe_ ? "thread-safe" : "non-thread-safe"),
                 ex.message());
@@ -804,7 +805,8 @@ TEST_P(MemoryPoolTest, memoryCapExceptions) {
                     "read pins: 0 write pins: 0 pinned shared: 0B pinned "
                     "exclusive: 0B\n num write wait: 0 empty entries: 0\nCache "
                     "access miss: 0 hit: 0 hit bytes: 0B eviction: 0 savable eviction: 0 eviction "
-                    "checks: 0 aged out: 0 stales: 0\nPrefetch entries: 0 bytes: 0B\nAlloc Megaclocks"
+                    "checks: 0 aged out: 0 stales: 0\nEviction policy: lru hit ratio: "
+                    "0.00% admission rejects: 0\nPrefetch entries: 0 bytes: 0B\nAlloc Megaclocks"
                     " 0\nAllocated pages: 0 cached pages: 0\n",
                     isLeafThreadSafe_ ? "thread-safe" : "non-thread-safe"),
                 ex.message());
@@ -4326,6 +4328,70 @@ TEST_P(MemoryPoolTest, transferTo) {
   }
 }
 
+TEST_P(MemoryPoolTest, smallAllocationCache) {
+  MemoryManager::Options options;
+  options.allocatorCapacity = kDefaultCapacity;
+  options.smallAllocationCacheBytes = 4 << 10;
+  setupMemory(options);
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool("smallAllocationCache");
+  auto leaf = root->addLeafChild("leaf", isLeafThreadSafe_);
+  auto* leafImpl = static_cast<MemoryPoolImpl*>(leaf.get());
+  const auto numAllocatedBytes = manager->allocator()->totalUsedBytes();
+
+  // A freed small allocation is reused by the next allocation of its size.
+  auto* buffer = leaf->allocate(1000);
+  const auto usedBytes = leaf->usedBytes();
+  leaf->free(buffer, 1000);
+  if (isLeafThreadSafe_) {
+    // Thread-safe pools do not cache.
+    EXPECT_EQ(leafImpl->cachedAllocationBytes(), 0);
+    EXPECT_EQ(leaf->usedBytes(), 0);
+    return;
+  }
+  EXPECT_EQ(leafImpl->cachedAllocationBytes(), usedBytes);
+  EXPECT_EQ(leaf->usedBytes(), usedBytes);
+  EXPECT_EQ(leaf->allocate(usedBytes), buffer);
+  EXPECT_EQ(leafImpl->cachedAllocationBytes(), 0);
+  leaf->free(buffer, usedBytes);
+  leaf->flushAllocationCache();
+
+  // Large allocations and allocations beyond the cache limit are not cached.
+  auto* large = leaf->allocate(MemoryPoolImpl::kMaxCachedAllocationSize + 1);
+  leaf->free(large, MemoryPoolImpl::kMaxCachedAllocationSize + 1);
+  std::vector<void*> buffers;
+  for (auto i = 0; i < 4; ++i) {
+    buffers.push_back(leaf->allocate(MemoryPoolImpl::kMaxCachedAllocationSize));
+  }
+  for (auto* small : buffers) {
+    leaf->free(small, MemoryPoolImpl::kMaxCachedAllocationSize);
+  }
+  EXPECT_EQ(
+      leafImpl->cachedAllocationBytes(), options.smallAllocationCacheBytes);
+
+  // Flushing returns the cached allocations to the allocator.
+  leaf->flushAllocationCache();
+  EXPECT_EQ(leafImpl->cachedAllocationBytes(), 0);
+  EXPECT_EQ(leaf->usedBytes(), 0);
+  EXPECT_EQ(root->usedBytes(), 0);
+  EXPECT_EQ(manager->allocator()->totalUsedBytes(), numAllocatedBytes);
+
+  // Reclaim flushes the cache too.
+  buffer = leaf->allocate(64);
+  leaf->free(buffer, 64);
+  ASSERT_GT(leaf->usedBytes(), 0);
+  MemoryReclaimer::Stats stats;
+  leaf->reclaim(0, 0, stats);
+  EXPECT_EQ(leaf->usedBytes(), 0);
+
+  // The destruction of the pool frees the cached allocations.
+  buffer = leaf->allocate(64);
+  leaf->free(buffer, 64);
+  leaf.reset();
+  EXPECT_EQ(root->usedBytes(), 0);
+  EXPECT_EQ(manager->allocator()->totalUsedBytes(), numAllocatedBytes);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     MemoryPoolTestSuite,
     MemoryPoolTest,
@@ -468,6 +468,7 @@ class MockSharedArbitrationTest : public testing::Test {
     // Set the globalArbitrationAbortTimeRatio to be very small so that the
     // query can be aborted sooner and the test would not timeout.
     double globalArbitrationAbortTimeRatio{0.005};
+    bool proactiveReclaimEnabled{false};
   };
 
   void setupMemory(ArbitratorOptions arbitratorOptions) {
@@ -526,7 +527,9 @@ class MockSharedArbitrationTest : public testing::Test {
              arbitratorOptions.globalArbitrationWithoutSpill)},
         {std::string(ExtraConfig::kGlobalArbitrationAbortTimeRatio),
          folly::to<std::string>(
-             arbitratorOptions.globalArbitrationAbortTimeRatio)}};
+             arbitratorOptions.globalArbitrationAbortTimeRatio)},
+        {std::string(ExtraConfig::kProactiveReclaimEnabled),
+         folly::to<std::string>(arbitratorOptions.proactiveReclaimEnabled)}};
     options.arbitrationStateCheckCb =
         std::move(arbitratorOptions.arbitrationStateCheckCb);
     options.checkUsageLeak = true;
@@ -696,6 +699,9 @@ TEST_F(MockSharedArbitrationTest, extraConfigs) {
       SharedArbitrator::ExtraConfig::memoryReclaimThreadsHwMultiplier(
           emptyConfigs),
       SharedArbitrator::ExtraConfig::kDefaultMemoryReclaimThreadsHwMultiplier);
+  ASSERT_EQ(
+      SharedArbitrator::ExtraConfig::proactiveReclaimEnabled(emptyConfigs),
+      SharedArbitrator::ExtraConfig::kDefaultProactiveReclaimEnabled);
   ASSERT_EQ(
       SharedArbitrator::ExtraConfig::globalArbitrationWithoutSpill(
           emptyConfigs),
@@ -2142,6 +2148,43 @@ TEST_F(MockSharedArbitrationTest, globalArbitrationWithoutSpill) {
       "Memory pool aborted to reclaim used memory");
 }
 
+TEST_F(MockSharedArbitrationTest, proactiveReclaim) {
+  const int64_t memoryCapacity = 512 << 20;
+  setupMemory(
+      {.memoryCapacity = memoryCapacity, .proactiveReclaimEnabled = true});
+  test::SharedArbitratorTestHelper arbitratorHelper(arbitrator_);
+
+  auto spillTask = addTask(memoryCapacity);
+  auto* spillOp = spillTask->addMemoryOp(true);
+  spillOp->allocate(memoryCapacity / 2);
+  auto growTask = addTask(memoryCapacity);
+  auto* growOp = growTask->addMemoryOp(true);
+  growOp->allocate(memoryCapacity / 4);
+  ASSERT_EQ(spillTask->capacity(), memoryCapacity / 2);
+  ASSERT_EQ(growTask->capacity(), memoryCapacity / 4);
+
+  // The free capacity covers the forecast, so nothing is reclaimed.
+  forecastMemoryGrowth(growOp->pool(), memoryCapacity / 8);
+  forecastMemoryGrowth(growOp->pool(), memoryCapacity / 4);
+  arbitratorHelper.waitForGlobalArbitrationToFinish();
+  ASSERT_EQ(arbitratorHelper.numProactiveReclaims(), 0);
+
+  // The forecast exceeds the free capacity. The other query is spilled at the
+  // background and the requestor is not.
+  forecastMemoryGrowth(growOp->pool(), memoryCapacity / 2);
+  while (arbitratorHelper.numProactiveReclaims() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  ASSERT_GT(arbitratorHelper.proactiveReclaimedBytes(), 0);
+  ASSERT_LT(spillTask->capacity(), memoryCapacity / 2);
+  ASSERT_EQ(growTask->capacity(), memoryCapacity / 4);
+
+  // The forecasted growth is served from the free capacity.
+  growOp->allocate(memoryCapacity / 2);
+  ASSERT_GE(growTask->capacity(), memoryCapacity * 3 / 4);
+  ASSERT_TRUE(growTask->error() == nullptr);
+}
+
 TEST_F(MockSharedArbitrationTest, globalArbitrationSmallParticipantLargeGrow) {
   // This test tests global arbitration takes into consideration the
   // additional attempting grow capacity when selecting abort partitipants.
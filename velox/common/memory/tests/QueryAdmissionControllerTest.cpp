@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/QueryAdmissionController.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/memory/SharedArbitrator.h"
+
+namespace facebook::velox::memory {
+namespace {
+
+constexpr int64_t MB = 1L << 20;
+
+class QueryAdmissionControllerTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    SharedArbitrator::registerFactory();
+  }
+
+  static void TearDownTestCase() {
+    SharedArbitrator::unregisterFactory();
+  }
+
+  void SetUp() override {
+    MemoryManager::Options options;
+    options.allocatorCapacity = 128 * MB;
+    options.arbitratorCapacity = 64 * MB;
+    options.arbitratorKind = "SHARED";
+    options.extraArbitratorConfigs = {
+        {std::string(SharedArbitrator::ExtraConfig::kMemoryPoolInitialCapacity),
+         "0B"}};
+    manager_ = std::make_unique<MemoryManager>(options);
+    QueryAdmissionController::Config config;
+    config.maxFreeCapacityRatio = 1.0;
+    controller_ = std::make_unique<QueryAdmissionController>(
+        manager_->arbitrator(), config);
+  }
+
+  std::shared_ptr<MemoryPool> addQueryPool(const std::string& name) {
+    return manager_->addRootPool(name, 64 * MB, MemoryReclaimer::create());
+  }
+
+  std::unique_ptr<MemoryManager> manager_;
+  std::unique_ptr<QueryAdmissionController> controller_;
+};
+
+TEST_F(QueryAdmissionControllerTest, admitByFreeCapacity) {
+  auto a = addQueryPool("a");
+  auto b = addQueryPool("b");
+  auto c = addQueryPool("c");
+  auto d = addQueryPool("d");
+  auto e = addQueryPool("e");
+
+  // 'a' and 'b' are expected to take 60MB of the 64MB.
+  ASSERT_TRUE(controller_->admit(a.get(), 40 * MB).isReady());
+  ASSERT_TRUE(controller_->admit(b.get(), 20 * MB).isReady());
+
+  // 'd' fits but waits behind 'c'. 'e' has a higher priority and fits.
+  auto futureC = controller_->admit(c.get(), 16 * MB);
+  auto futureD = controller_->admit(d.get(), 2 * MB);
+  ASSERT_FALSE(futureC.isReady());
+  ASSERT_FALSE(futureD.isReady());
+  ASSERT_TRUE(controller_->admit(e.get(), 2 * MB, 1).isReady());
+  auto stats = controller_->stats();
+  ASSERT_EQ(stats.numRunning, 3);
+  ASSERT_EQ(stats.numQueued, 2);
+
+  // Growing up to the estimate does not make room.
+  manager_->arbitrator()->growCapacity(a.get(), 40 * MB);
+  controller_->update();
+  ASSERT_FALSE(futureC.isReady());
+
+  controller_->release(b.get());
+  ASSERT_TRUE(futureC.isReady());
+  ASSERT_TRUE(futureD.isReady());
+  stats = controller_->stats();
+  ASSERT_EQ(stats.numRunning, 4);
+  ASSERT_EQ(stats.numQueued, 0);
+  ASSERT_EQ(stats.numAdmitted, 5);
+  ASSERT_EQ(stats.numWaited, 2);
+
+  for (auto* pool : {a.get(), c.get(), d.get(), e.get()}) {
+    controller_->release(pool);
+  }
+  ASSERT_EQ(controller_->stats().numRunning, 0);
+}
+
+TEST_F(QueryAdmissionControllerTest, admitWithoutEstimate) {
+  auto a = addQueryPool("a");
+  auto b = addQueryPool("b");
+  auto c = addQueryPool("c");
+
+  // A query is admitted when nothing else runs, even if it does not fit.
+  ASSERT_TRUE(controller_->admit(a.get(), 100 * MB).isReady());
+  auto futureB = controller_->admit(b.get(), 0);
+  ASSERT_FALSE(futureB.isReady());
+  controller_->release(a.get());
+  ASSERT_TRUE(futureB.isReady());
+
+  // 'b' has no estimate and is expected to take Config::defaultQueryBytes.
+  ASSERT_FALSE(controller_->admit(c.get(), 1).isReady());
+  controller_->release(b.get());
+  controller_->release(c.get());
+}
+
+TEST_F(QueryAdmissionControllerTest, releaseQueued) {
+  auto a = addQueryPool("a");
+  auto b = addQueryPool("b");
+  ASSERT_TRUE(controller_->admit(a.get(), 64 * MB).isReady());
+  auto futureB = controller_->admit(b.get(), 1 * MB);
+  ASSERT_FALSE(futureB.isReady());
+
+  controller_->release(b.get());
+  ASSERT_TRUE(futureB.isReady());
+  VELOX_ASSERT_THROW(
+      std::move(futureB).get(), "Query b is released before admission");
+  ASSERT_EQ(controller_->stats().numQueued, 0);
+
+  VELOX_ASSERT_THROW(controller_->release(b.get()), "Query b is not admitted");
+  VELOX_ASSERT_THROW(
+      controller_->admit(a.get(), 1 * MB), "Query a is already admitted");
+  auto leaf = a->addLeafChild("leaf");
+  VELOX_ASSERT_THROW(
+      controller_->admit(leaf.get(), 1 * MB),
+      "Queries are admitted by their root pool");
+  controller_->release(a.get());
+}
+} // namespace
+} // namespace facebook::velox::memory
@@ -54,6 +54,14 @@ class SharedArbitratorTestHelper {
     }
   }
 
+  uint64_t numProactiveReclaims() const {
+    return arbitrator_->numProactiveReclaims_;
+  }
+
+  uint64_t proactiveReclaimedBytes() const {
+    return arbitrator_->proactiveReclaimedBytes_;
+  }
+
   uint64_t maxArbitrationTimeNs() const {
     return arbitrator_->maxArbitrationTimeNs_;
   }
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+
+#ifdef __linux__
+namespace {
+
+// Opens 'config' of 'type' for the calling thread on any CPU, in the group of
+// 'groupFd' or as a new group leader if 'groupFd' is -1.
+int32_t openEvent(uint32_t type, uint64_t config, int32_t groupFd) {
+  struct perf_event_attr attr {};
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return syscall(
+      __NR_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+}
+
+constexpr uint64_t cacheMissConfig(uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+  positions_.fill(-1);
+  const std::array<std::pair<uint32_t, uint64_t>, kNumEvents> events = {{
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+      {PERF_TYPE_HW_CACHE, cacheMissConfig(PERF_COUNT_HW_CACHE_DTLB)},
+  }};
+  for (auto i = 0; i < kNumEvents; ++i) {
+    const auto fd = openEvent(events[i].first, events[i].second, leaderFd_);
+    if (fd < 0) {
+      if (i == kCycles) {
+        // Without cycles there is no group to add the other events to.
+        return;
+      }
+      continue;
+    }
+    if (leaderFd_ < 0) {
+      leaderFd_ = fd;
+    }
+    fds_[i] = fd;
+    positions_[i] = numOpened_++;
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (auto fd : fds_) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+PerfCounters::Values PerfCounters::read() const {
+  // The number of events followed by the value of each.
+  std::array<uint64_t, kNumEvents + 1> buffer{};
+  Values values{};
+  const ssize_t size = (numOpened_ + 1) * sizeof(uint64_t);
+  if (::read(leaderFd_, buffer.data(), size) != size) {
+    return values;
+  }
+  for (auto i = 0; i < kNumEvents; ++i) {
+    if (positions_[i] >= 0) {
+      values[i] = buffer[1 + positions_[i]];
+    }
+  }
+  return values;
+}
+
+// static
+PerfCounters* PerfCounters::forCurrentThread() {
+  thread_local PerfCounters counters;
+  if (counters.leaderFd_ < 0) {
+    static bool logged = [] {
+      LOG(WARNING) << "Hardware performance counters are not available";
+      return true;
+    }();
+    (void)logged;
+    return nullptr;
+  }
+  return &counters;
+}
+
+#else
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+  positions_.fill(-1);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+PerfCounters::Values PerfCounters::read() const {
+  return {};
+}
+
+// static
+PerfCounters* PerfCounters::forCurrentThread() {
+  return nullptr;
+}
+
+#endif
+
+// static
+std::string_view PerfCounters::name(Event event) {
+  switch (event) {
+    case kCycles:
+      return "perfCycles";
+    case kInstructions:
+      return "perfInstructions";
+    case kLlcMisses:
+      return "perfLlcMisses";
+    case kDtlbMisses:
+      return "perfDtlbMisses";
+    default:
+      return "perfUnknown";
+  }
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace facebook::velox::process {
+
+/// Hardware performance counters of the calling thread, read from a group of
+/// Linux perf events. Counts user space only, so that the default
+/// perf_event_paranoid setting of 2 allows it. The events are opened on first
+/// use by a thread and stay open until the thread exits.
+class PerfCounters {
+ public:
+  enum Event {
+    kCycles,
+    kInstructions,
+    kLlcMisses,
+    kDtlbMisses,
+    kNumEvents,
+  };
+
+  /// Counts of the events since the group was opened. An event the machine
+  /// does not support stays at 0.
+  using Values = std::array<uint64_t, kNumEvents>;
+
+  /// Returns the counters of the calling thread, or nullptr if perf events are
+  /// not available, e.g. not on Linux, in a container without access to perf
+  /// or without hardware counters.
+  static PerfCounters* forCurrentThread();
+
+  /// Runtime stat name of 'event', e.g. "perfCycles".
+  static std::string_view name(Event event);
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  ~PerfCounters();
+
+  /// Reads all events with one system call.
+  Values read() const;
+
+  /// True if 'event' was opened.
+  bool has(Event event) const {
+    return positions_[event] >= 0;
+  }
+
+ private:
+  PerfCounters();
+
+  // File descriptor of the group leader. -1 if the group could not be opened.
+  int32_t leaderFd_{-1};
+  // File descriptors of the opened events, -1 for the others.
+  std::array<int32_t, kNumEvents> fds_;
+  // Position of each event in the group read, -1 if not opened.
+  std::array<int32_t, kNumEvents> positions_;
+  int32_t numOpened_{0};
+};
+
+} // namespace facebook::velox::process
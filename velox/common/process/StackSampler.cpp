@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/StackSampler.h"
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+#include <fmt/format.h>
+#include <folly/experimental/symbolizer/StackTrace.h>
+
+#include "velox/common/process/StackTrace.h"
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+
+std::string StackProfile::toFolded() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::unordered_map<uintptr_t, std::string> names;
+  auto name = [&](uintptr_t address) -> const std::string& {
+    auto it = names.find(address);
+    if (it == names.end()) {
+      auto symbol =
+          StackTrace::translateFrame(reinterpret_cast<void*>(address));
+      if (symbol.empty()) {
+        symbol = fmt::format("{:#x}", address);
+      }
+      it = names.emplace(address, std::move(symbol)).first;
+    }
+    return it->second;
+  };
+  std::string folded;
+  for (const auto& [key, count] : stacks_) {
+    const auto& [label, frames] = key;
+    std::string line = label;
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+      if (!line.empty()) {
+        line += ';';
+      }
+      line += name(*it);
+    }
+    folded += fmt::format("{} {}\n", line, count);
+  }
+  return folded;
+}
+
+uint64_t StackProfile::numSamples() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numSamples_;
+}
+
+uint64_t StackProfile::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numDropped_;
+}
+
+void StackProfile::add(
+    const std::string& label,
+    std::vector<uintptr_t> frames,
+    uint64_t count) {
+  std::lock_guard<std::mutex> l(mutex_);
+  stacks_[{label, std::move(frames)}] += count;
+  numSamples_ += count;
+}
+
+void StackProfile::addDropped(uint64_t count) {
+  std::lock_guard<std::mutex> l(mutex_);
+  numDropped_ += count;
+}
+
+#ifdef __linux__
+namespace {
+
+constexpr int32_t kMaxSamples = 256;
+constexpr int32_t kMaxFrames = 64;
+// The frames of the signal handler and the signal trampoline.
+constexpr int32_t kSkipFrames = 2;
+
+struct Sample {
+  const std::string* label;
+  int32_t numFrames;
+  uintptr_t frames[kMaxFrames];
+};
+
+// The sampling state of a thread. Written by the signal handler, which runs
+// on the same thread, and read after the timer is stopped.
+struct ThreadState {
+  ~ThreadState();
+
+  timer_t timer{};
+  bool hasTimer{false};
+  std::atomic<bool> active{false};
+  std::atomic<const std::string*> label{nullptr};
+  std::atomic<int32_t> numSamples{0};
+  std::atomic<uint64_t> numDropped{0};
+  Sample samples[kMaxSamples];
+};
+
+// A plain pointer, so that the signal handler does not initialize a
+// thread_local.
+thread_local ThreadState* threadState = nullptr;
+thread_local std::unique_ptr<ThreadState> ownedThreadState;
+
+ThreadState::~ThreadState() {
+  threadState = nullptr;
+  if (hasTimer) {
+    timer_delete(timer);
+  }
+}
+
+void handleSignal(int /*signal*/, siginfo_t* /*info*/, void* /*context*/) {
+  auto* state = threadState;
+  if (state == nullptr || !state->active.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const auto index = state->numSamples.load(std::memory_order_relaxed);
+  if (index >= kMaxSamples) {
+    state->numDropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  auto& sample = state->samples[index];
+  const auto numFrames =
+      folly::symbolizer::getStackTraceSafe(sample.frames, kMaxFrames);
+  sample.numFrames = numFrames < 0 ? 0 : numFrames;
+  sample.label = state->label.load(std::memory_order_relaxed);
+  state->numSamples.store(index + 1, std::memory_order_release);
+}
+
+bool installSignalHandler() {
+  static const bool installed = [] {
+    // The first unwind may allocate, which a signal handler must not do.
+    uintptr_t frames[1];
+    folly::symbolizer::getStackTraceSafe(frames, 1);
+    struct sigaction action {};
+    action.sa_sigaction = handleSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    return sigaction(SIGPROF, &action, nullptr) == 0;
+  }();
+  return installed;
+}
+
+// Returns the state of the calling thread with a timer on the CPU time of the
+// thread, or nullptr if the timer cannot be created.
+ThreadState* stateForThread() {
+  if (threadState != nullptr) {
+    return threadState;
+  }
+  auto state = std::make_unique<ThreadState>();
+  struct sigevent event {};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event._sigev_un._tid = syscall(SYS_gettid);
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &state->timer) != 0) {
+    return nullptr;
+  }
+  state->hasTimer = true;
+  ownedThreadState = std::move(state);
+  threadState = ownedThreadState.get();
+  return threadState;
+}
+
+void setTimer(ThreadState& state, uint64_t intervalNanos) {
+  struct itimerspec spec {};
+  spec.it_interval.tv_sec = intervalNanos / 1'000'000'000;
+  spec.it_interval.tv_nsec = intervalNanos % 1'000'000'000;
+  spec.it_value = spec.it_interval;
+  timer_settime(state.timer, 0, &spec, nullptr);
+}
+
+} // namespace
+
+StackSampler::Scope::Scope(StackProfile* profile) {
+  if (profile == nullptr || profile->intervalNanos() == 0 || isActive() ||
+      !installSignalHandler()) {
+    return;
+  }
+  auto* state = stateForThread();
+  if (state == nullptr) {
+    return;
+  }
+  state->label = nullptr;
+  state->numSamples = 0;
+  state->numDropped = 0;
+  state->active = true;
+  setTimer(*state, profile->intervalNanos());
+  profile_ = profile;
+}
+
+StackSampler::Scope::~Scope() {
+  if (profile_ == nullptr) {
+    return;
+  }
+  auto* state = threadState;
+  setTimer(*state, 0);
+  state->active = false;
+  const auto numSamples = state->numSamples.load(std::memory_order_acquire);
+  for (auto i = 0; i < numSamples; ++i) {
+    const auto& sample = state->samples[i];
+    if (sample.numFrames <= kSkipFrames) {
+      continue;
+    }
+    profile_->add(
+        sample.label != nullptr ? *sample.label : std::string(),
+        std::vector<uintptr_t>(
+            sample.frames + kSkipFrames, sample.frames + sample.numFrames));
+  }
+  if (const auto numDropped = state->numDropped.load()) {
+    profile_->addDropped(numDropped);
+  }
+}
+
+StackSampler::ScopedLabel::ScopedLabel(const std::string* label) {
+  auto* state = threadState;
+  if (state == nullptr || !state->active.load(std::memory_order_relaxed)) {
+    return;
+  }
+  active_ = true;
+  previous_ = state->label;
+  state->label = label;
+}
+
+StackSampler::ScopedLabel::~ScopedLabel() {
+  if (active_) {
+    threadState->label = previous_;
+  }
+}
+
+// static
+bool StackSampler::isActive() {
+  return threadState != nullptr &&
+      threadState->active.load(std::memory_order_relaxed);
+}
+
+#else
+
+StackSampler::Scope::Scope(StackProfile* /*profile*/) {}
+
+StackSampler::Scope::~Scope() = default;
+
+StackSampler::ScopedLabel::ScopedLabel(const std::string* /*label*/) {}
+
+StackSampler::ScopedLabel::~ScopedLabel() = default;
+
+// static
+bool StackSampler::isActive() {
+  return false;
+}
+
+#endif
+
+} // namespace facebook::velox::process
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Stack samples aggregated over the threads that ran a unit of work, e.g. a
+/// Task. Thread safe.
+class StackProfile {
+ public:
+  /// Samples a thread every 'intervalNanos' of CPU time of the thread.
+  explicit StackProfile(uint64_t intervalNanos)
+      : intervalNanos_(intervalNanos) {}
+
+  uint64_t intervalNanos() const {
+    return intervalNanos_;
+  }
+
+  /// Returns the samples in the folded format of flame graph tools, one line
+  /// per distinct stack: the label of the sample followed by the frames from
+  /// the outermost, separated by ';', a space and the number of samples.
+  /// Frames are symbolized on the call.
+  std::string toFolded() const;
+
+  /// The number of samples taken.
+  uint64_t numSamples() const;
+
+  /// The number of samples lost because a thread took more of them than it
+  /// could buffer.
+  uint64_t numDropped() const;
+
+  /// Adds 'count' samples of 'frames', innermost first, taken under 'label'.
+  void add(
+      const std::string& label,
+      std::vector<uintptr_t> frames,
+      uint64_t count = 1);
+
+  void addDropped(uint64_t count);
+
+ private:
+  const uint64_t intervalNanos_;
+
+  mutable std::mutex mutex_;
+  std::map<std::pair<std::string, std::vector<uintptr_t>>, uint64_t> stacks_;
+  uint64_t numSamples_{0};
+  uint64_t numDropped_{0};
+};
+
+/// Signal based sampling of the stacks of the calling thread into a
+/// StackProfile. Each thread has a timer on its own CPU time that sends it
+/// SIGPROF, so only the threads that run profiled work are interrupted. The
+/// signal handler records the stack into a buffer of the thread, which is
+/// added to the profile when the sampling of the thread stops. Linux only;
+/// elsewhere no samples are taken.
+class StackSampler {
+ public:
+  /// Samples the calling thread into 'profile' for the lifetime of the
+  /// object. Does nothing if 'profile' is nullptr or the thread is already
+  /// sampled.
+  class Scope {
+   public:
+    explicit Scope(StackProfile* profile);
+
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    StackProfile* profile_{nullptr};
+  };
+
+  /// Labels the samples of the calling thread with 'label', e.g. the plan
+  /// node ID of the running operator, for the lifetime of the object.
+  /// 'label' must outlive the sampling of the thread. Does nothing if the
+  /// thread is not sampled.
+  class ScopedLabel {
+   public:
+    explicit ScopedLabel(const std::string* label);
+
+    ~ScopedLabel();
+
+    ScopedLabel(const ScopedLabel&) = delete;
+    ScopedLabel& operator=(const ScopedLabel&) = delete;
+
+   private:
+    bool active_{false};
+    const std::string* previous_{nullptr};
+  };
+
+  /// True if the calling thread is sampled.
+  static bool isActive();
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace facebook::velox::process;
+
+namespace {
+
+TEST(PerfCountersTest, basic) {
+  auto* counters = PerfCounters::forCurrentThread();
+  if (counters == nullptr) {
+    GTEST_SKIP() << "Hardware performance counters are not available";
+  }
+  EXPECT_EQ(PerfCounters::forCurrentThread(), counters);
+  ASSERT_TRUE(counters->has(PerfCounters::kCycles));
+
+  const auto start = counters->read();
+  volatile uint64_t sum = 0;
+  for (auto i = 0; i < 1'000'000; ++i) {
+    sum += i;
+  }
+  const auto end = counters->read();
+  for (auto i = 0; i < PerfCounters::kNumEvents; ++i) {
+    EXPECT_GE(end[i], start[i]);
+  }
+  EXPECT_GT(end[PerfCounters::kCycles], start[PerfCounters::kCycles]);
+  if (counters->has(PerfCounters::kInstructions)) {
+    // At least the loads, add and store of each iteration.
+    EXPECT_GT(
+        end[PerfCounters::kInstructions] - start[PerfCounters::kInstructions],
+        1'000'000);
+  }
+
+  // Each thread has its own counters.
+  std::thread([&]() {
+    EXPECT_NE(PerfCounters::forCurrentThread(), counters);
+  }).join();
+}
+
+TEST(PerfCountersTest, name) {
+  EXPECT_EQ(PerfCounters::name(PerfCounters::kCycles), "perfCycles");
+  EXPECT_EQ(PerfCounters::name(PerfCounters::kDtlbMisses), "perfDtlbMisses");
+}
+
+} // namespace
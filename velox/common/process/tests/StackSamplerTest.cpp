@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/StackSampler.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "velox/common/process/ProcessBase.h"
+
+using namespace facebook::velox::process;
+
+namespace {
+
+// Spins for at least 'nanos' of CPU time of the calling thread.
+void spin(uint64_t nanos) {
+  const auto startNanos = threadCpuNanos();
+  volatile uint64_t sum = 0;
+  while (threadCpuNanos() - startNanos < nanos) {
+    for (auto i = 0; i < 1'000; ++i) {
+      sum += i;
+    }
+  }
+}
+
+TEST(StackSamplerTest, sample) {
+#ifndef __linux__
+  GTEST_SKIP() << "Stack sampling needs Linux";
+#endif
+  StackProfile profile(1'000'000);
+  const std::string label = "label";
+  {
+    StackSampler::Scope scope(&profile);
+    ASSERT_TRUE(StackSampler::isActive());
+    // A nested scope does not sample into another profile.
+    StackProfile other(1'000'000);
+    {
+      StackSampler::Scope nested(&other);
+      StackSampler::ScopedLabel scopedLabel(&label);
+      spin(100'000'000);
+    }
+    ASSERT_TRUE(StackSampler::isActive());
+    EXPECT_EQ(other.numSamples(), 0);
+  }
+  EXPECT_FALSE(StackSampler::isActive());
+  // About 100 samples of 1ms in 100ms of CPU time.
+  EXPECT_GT(profile.numSamples(), 10);
+
+  const auto folded = profile.toFolded();
+  std::istringstream lines(folded);
+  std::string line;
+  uint64_t numSamples = 0;
+  while (std::getline(lines, line)) {
+    EXPECT_EQ(line.rfind("label;", 0), 0) << line;
+    numSamples += std::stoull(line.substr(line.rfind(' ') + 1));
+  }
+  EXPECT_EQ(numSamples, profile.numSamples());
+
+  // No samples outside of a scope.
+  spin(20'000'000);
+  EXPECT_EQ(profile.numSamples(), numSamples);
+}
+
+TEST(StackSamplerTest, profile) {
+  StackProfile profile(1'000'000);
+  EXPECT_EQ(profile.toFolded(), "");
+  profile.add("a", {1, 2});
+  profile.add("a", {1, 2}, 2);
+  profile.add("b", {1});
+  profile.addDropped(5);
+  EXPECT_EQ(profile.numSamples(), 4);
+  EXPECT_EQ(profile.numDropped(), 5);
+
+  std::istringstream lines(profile.toFolded());
+  std::string line;
+  std::vector<std::string> counts;
+  while (std::getline(lines, line)) {
+    counts.push_back(line.substr(0, 2) + line.substr(line.rfind(' ')));
+  }
+  EXPECT_EQ(counts, (std::vector<std::string>{"a; 3", "b; 1"}));
+}
+
+} // namespace
@@ -16,6 +16,8 @@
 
 #include "velox/connectors/Connector.h"
 
+#include "velox/common/base/SuccinctPrinter.h"
+
 namespace facebook::velox::connector {
 namespace {
 
@@ -37,6 +39,25 @@ std::string DataSink::Stats::toString() const {
       spillStats.toString());
 }
 
+uint64_t SplitTiming::decodeCpuNanos() const {
+  uint64_t total{0};
+  for (const auto& [_, nanos] : columnDecodeCpuNanos) {
+    total += nanos;
+  }
+  return total;
+}
+
+std::string SplitTiming::toString() const {
+  return fmt::format(
+      "open {} first batch {} IO wait {} decode {} filter {} output rows {}",
+      succinctNanos(openWallNanos),
+      succinctNanos(firstBatchWallNanos),
+      succinctNanos(ioWaitWallNanos),
+      succinctNanos(decodeCpuNanos()),
+      succinctNanos(filterCpuNanos),
+      outputRows);
+}
+
 bool registerConnector(std::shared_ptr<Connector> connector) {
   bool ok = connectors().insert({connector->connectorId(), connector}).second;
   VELOX_CHECK(
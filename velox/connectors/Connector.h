@@ -33,6 +33,8 @@
 
 #include <folly/Synchronized.h>
 
+#include <map>
+
 namespace facebook::velox {
 class Config;
 }
@@ -81,6 +83,13 @@ struct ConnectorSplit : public ISerializable {
     return 0;
   }
 
+  /// Returns true if the data of the split is likely in the local caches,
+  /// e.g. AsyncDataCache or SsdCache. Must be cheap: the task calls it on
+  /// queued splits to hand out the cached ones first.
+  virtual bool hasCachedData() const {
+    return false;
+  }
+
   virtual ~ConnectorSplit() {
     if (dataSource) {
       dataSource->close();
@@ -243,6 +252,29 @@ class DataSink {
   }
 };
 
+/// Where the time of reading a split by a DataSource went, from addSplit() to
+/// the end of the split.
+struct SplitTiming {
+  /// Wall time of addSplit(), which opens the file and reads its metadata.
+  uint64_t openWallNanos{0};
+  /// Wall time from the end of addSplit() to the first batch of rows.
+  uint64_t firstBatchWallNanos{0};
+  /// Wall time of the query threads waiting for IO.
+  uint64_t ioWaitWallNanos{0};
+  /// Decode and decompression CPU time of the columns, keyed by the node id
+  /// of the column in the file schema. Empty unless the reader collects
+  /// column stats.
+  std::map<uint32_t, uint64_t> columnDecodeCpuNanos;
+  /// CPU time of the filters not pushed down into the reader.
+  uint64_t filterCpuNanos{0};
+  /// Rows returned after the filters.
+  uint64_t outputRows{0};
+
+  uint64_t decodeCpuNanos() const;
+
+  std::string toString() const;
+};
+
 class DataSource {
  public:
   static constexpr int64_t kUnknownRowSize = -1;
@@ -254,6 +286,14 @@ class DataSource {
   /// processed.
   virtual void addSplit(std::shared_ptr<ConnectorSplit> split) = 0;
 
+  /// Loads the first unit of data of the split added via addSplit, e.g. the
+  /// first stripe, so that the first call to next does not wait for IO. Split
+  /// preload calls this on the IO executor after addSplit. Returns the number
+  /// of bytes loaded. The default loads nothing.
+  virtual uint64_t preloadSplitData() {
+    return 0;
+  }
+
   /// Process a split added via addSplit. Returns nullptr if split has been
   /// fully processed. Returns std::nullopt and sets the 'future' if started
   /// asynchronous work and needs to wait for it to complete to continue
@@ -285,6 +325,13 @@ class DataSource {
     return {};
   }
 
+  /// Returns the timing of the split that the last next() returned nullptr
+  /// for, or std::nullopt if the source does not time its splits. Returns
+  /// the timing of a split once.
+  virtual std::optional<SplitTiming> finishedSplitTiming() {
+    return std::nullopt;
+  }
+
   /// Returns true if 'this' has initiated all the prefetch this will initiate.
   /// This means that the caller should schedule next splits to prefetch in the
   /// background. false if the source does not prefetch.
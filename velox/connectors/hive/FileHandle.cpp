@@ -39,6 +39,35 @@ std::string groupName(const std::string& filename) {
 }
 } // namespace
 
+FileHandleGenerator::FileHandleGenerator(
+    std::shared_ptr<const config::ConfigBase> properties,
+    std::shared_ptr<dwio::common::FooterCache> footerCache,
+    uint64_t notFoundExpirationMs,
+    size_t maxNotFound)
+    : properties_(std::move(properties)), footerCache_(std::move(footerCache)) {
+  if (notFoundExpirationMs > 0 && maxNotFound > 0) {
+    notFound_ =
+        std::make_unique<NotFoundCache>(maxNotFound, notFoundExpirationMs);
+  }
+}
+
+void FileHandleGenerator::checkNotFound(const FileHandleKey& key) {
+  if (notFound_ == nullptr) {
+    return;
+  }
+  std::string message;
+  {
+    std::lock_guard<std::mutex> l(notFoundMutex_);
+    auto* value = notFound_->get(key);
+    if (value == nullptr) {
+      return;
+    }
+    message = *value;
+    notFound_->release(key);
+  }
+  VELOX_FILE_NOT_FOUND_ERROR("{}", message);
+}
+
 std::unique_ptr<FileHandle> FileHandleGenerator::operator()(
     const FileHandleKey& key,
     const FileProperties* properties,
@@ -61,8 +90,21 @@ std::unique_ptr<FileHandle> FileHandleGenerator::operator()(
       options.fileReadOps = properties->fileReadOps;
     }
     const auto& filename = key.filename;
-    fileHandle->file = filesystems::getFileSystem(filename, properties_)
-                           ->openFileForRead(filename, options);
+    checkNotFound(key);
+    try {
+      fileHandle->file = filesystems::getFileSystem(filename, properties_)
+                             ->openFileForRead(filename, options);
+    } catch (const VeloxRuntimeError& e) {
+      if (notFound_ != nullptr && e.errorCode() == error_code::kFileNotFound) {
+        auto message = std::make_unique<std::string>(e.message());
+        std::lock_guard<std::mutex> l(notFoundMutex_);
+        if (notFound_->add(key, message.get(), 1)) {
+          message.release();
+        }
+      }
+      throw;
+    }
+    fileHandle->footerCache = footerCache_;
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
     VLOG(1) << "Generating file handle for: " << filename
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string_view>
 
 #include "velox/common/base/BitUtil.h"
@@ -34,6 +35,7 @@
 #include "velox/common/file/File.h"
 #include "velox/common/file/TokenProvider.h"
 #include "velox/connectors/hive/FileProperties.h"
+#include "velox/dwio/common/FooterCache.h"
 
 namespace facebook::velox {
 
@@ -57,6 +59,10 @@ struct FileHandle {
   // example to decide placing on SSD.
   StringIdLease groupId;
 
+  // Cache of parsed footers shared by the readers of the files of the
+  // connector, or nullptr if footers are always read from the file.
+  std::shared_ptr<dwio::common::FooterCache> footerCache;
+
   // We'll want to have a hash map here to record the identifier->byte range
   // mappings. Different formats may have different identifiers, so we may need
   // a union of maps. For example in orc you need 3 integers (I think, to be
@@ -112,15 +118,33 @@ using FileHandleCache =
 class FileHandleGenerator {
  public:
   FileHandleGenerator() {}
-  FileHandleGenerator(std::shared_ptr<const config::ConfigBase> properties)
-      : properties_(std::move(properties)) {}
+
+  /// @param footerCache Set on the generated handles.
+  /// @param notFoundExpirationMs If positive, a file found missing is reported
+  ///   missing without opening it again for this long.
+  /// @param maxNotFound Maximum number of missing files remembered.
+  FileHandleGenerator(
+      std::shared_ptr<const config::ConfigBase> properties,
+      std::shared_ptr<dwio::common::FooterCache> footerCache = nullptr,
+      uint64_t notFoundExpirationMs = 0,
+      size_t maxNotFound = 0);
+
   std::unique_ptr<FileHandle> operator()(
       const FileHandleKey& filename,
       const FileProperties* properties,
       IoStats* stats);
 
  private:
+  using NotFoundCache = SimpleLRUCache<FileHandleKey, std::string>;
+
+  // Throws the error of 'key' if it was found missing recently.
+  void checkNotFound(const FileHandleKey& key);
+
   const std::shared_ptr<const config::ConfigBase> properties_;
+  const std::shared_ptr<dwio::common::FooterCache> footerCache_;
+  std::mutex notFoundMutex_;
+  // Error messages of the files found missing, keyed like the handles.
+  std::unique_ptr<NotFoundCache> notFound_;
 };
 
 using FileHandleFactory = CachedFactory<
@@ -67,6 +67,13 @@ uint32_t HiveConfig::maxPartitionsPerWriters(
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 128));
 }
 
+uint32_t HiveConfig::maxOpenPartitionWriters(
+    const config::ConfigBase* session) const {
+  return session->get<uint32_t>(
+      kMaxOpenPartitionWritersSession,
+      config_->get<uint32_t>(kMaxOpenPartitionWriters, 0));
+}
+
 uint32_t HiveConfig::maxBucketCount(const config::ConfigBase* session) const {
   return session->get<uint32_t>(
       kMaxBucketCountSession, config_->get<uint32_t>(kMaxBucketCount, 100'000));
@@ -155,6 +162,13 @@ int32_t HiveConfig::maxCoalescedDistanceBytes(
   return int32_t(distance);
 }
 
+bool HiveConfig::adaptiveCoalesceEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kAdaptiveCoalesceEnabledSession,
+      config_->get<bool>(kAdaptiveCoalesceEnabled, false));
+}
+
 int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
@@ -185,6 +199,28 @@ bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+uint64_t HiveConfig::fileNotFoundExpirationDurationMs() const {
+  return config_->get<uint64_t>(kFileNotFoundExpirationDurationMs, 0);
+}
+
+uint64_t HiveConfig::footerCacheMaxBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kFooterCacheMaxBytes, "0B"),
+      config::CapacityUnit::BYTE);
+}
+
+uint64_t HiveConfig::splitResultCacheMaxBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kSplitResultCacheMaxBytes, "0B"),
+      config::CapacityUnit::BYTE);
+}
+
+uint64_t HiveConfig::splitResultCacheMaxSplitBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kSplitResultCacheMaxSplitBytes, "16MB"),
+      config::CapacityUnit::BYTE);
+}
+
 std::string HiveConfig::writeFileCreateConfig() const {
   return config_->get<std::string>(kWriteFileCreateConfig, "");
 }
@@ -255,6 +291,13 @@ bool HiveConfig::preserveFlatMapsInMemory(
       config_->get<bool>(kPreserveFlatMapsInMemory, false));
 }
 
+bool HiveConfig::stringsFromCacheEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kStringsFromCacheEnabledSession,
+      config_->get<bool>(kStringsFromCacheEnabled, false));
+}
+
 bool HiveConfig::indexEnabled(const config::ConfigBase* session) const {
   return session->get<bool>(
       kIndexEnabledSession, config_->get<bool>(kIndexEnabled, false));
@@ -307,6 +350,51 @@ uint64_t HiveConfig::nimbleFooterSpeculativeIoSize(
       config_->get<uint64_t>(kNimbleFooterSpeculativeIoSize, 8UL << 20));
 }
 
+bool HiveConfig::parquetPageIndexFilterEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kParquetPageIndexFilterEnabledSession,
+      config_->get<bool>(kParquetPageIndexFilterEnabled, false));
+}
+
+bool HiveConfig::parquetBloomFilterEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kParquetBloomFilterEnabledSession,
+      config_->get<bool>(kParquetBloomFilterEnabled, false));
+}
+
+bool HiveConfig::parquetDictionaryFilterEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kParquetDictionaryFilterEnabledSession,
+      config_->get<bool>(kParquetDictionaryFilterEnabled, false));
+}
+
+int32_t HiveConfig::parquetDecompressionPagesAhead(
+    const config::ConfigBase* session) const {
+  const auto pages = session->get<int32_t>(
+      kParquetDecompressionPagesAheadSession,
+      config_->get<int32_t>(kParquetDecompressionPagesAhead, 0));
+  VELOX_USER_CHECK_GE(
+      pages, 0, "{} must not be negative", kParquetDecompressionPagesAhead);
+  return pages;
+}
+
+uint64_t HiveConfig::textDecompressionBlockSize(
+    const config::ConfigBase* session) const {
+  return session->get<uint64_t>(
+      kTextDecompressionBlockSizeSession,
+      config_->get<uint64_t>(kTextDecompressionBlockSize, 0));
+}
+
+uint64_t HiveConfig::splitPreloadMaxDataBytes(
+    const config::ConfigBase* session) const {
+  return session->get<uint64_t>(
+      kSplitPreloadMaxDataBytesSession,
+      config_->get<uint64_t>(kSplitPreloadMaxDataBytes, 0));
+}
+
 std::string HiveConfig::user(const config::ConfigBase* session) const {
   return session->get<std::string>(kUser, config_->get<std::string>(kUser, ""));
 }
@@ -49,6 +49,16 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// Maximum number of partition writers of a table writer that are open at
+  /// the same time. When a partition needs a writer beyond the limit, the
+  /// least recently written writer is closed, and its partition starts a new
+  /// file if it gets more rows. Does not apply to bucketed or sorted writes. 0
+  /// means no limit.
+  static constexpr const char* kMaxOpenPartitionWriters =
+      "max-open-partition-writers";
+  static constexpr const char* kMaxOpenPartitionWritersSession =
+      "max_open_partition_writers";
+
   /// Maximum number of buckets allowed to output by the table writers.
   static constexpr const char* kMaxBucketCount = "hive.max-bucket-count";
   static constexpr const char* kMaxBucketCountSession = "hive.max_bucket_count";
@@ -114,6 +124,14 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceSession =
       "orc_max_merge_distance";
 
+  /// If true, the merge distance is learned per storage scheme from the
+  /// latency and bandwidth of past reads, with 'max-coalesced-distance' used
+  /// until enough reads have been seen.
+  static constexpr const char* kAdaptiveCoalesceEnabled =
+      "adaptive-coalesce-enabled";
+  static constexpr const char* kAdaptiveCoalesceEnabledSession =
+      "adaptive_coalesce_enabled";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
@@ -135,6 +153,27 @@ class HiveConfig {
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// Expiration time in ms for a file found missing. Within this time the file
+  /// is reported missing without opening it again. 0 disables the negative
+  /// caching.
+  static constexpr const char* kFileNotFoundExpirationDurationMs =
+      "file-not-found-expiration-duration-ms";
+
+  /// Maximum total size of the serialized footers in the parsed footer cache
+  /// shared by the readers of the connector. Only Parquet footers of splits
+  /// with a modification time are cached. 0 disables the cache.
+  static constexpr const char* kFooterCacheMaxBytes = "footer-cache-max-bytes";
+
+  /// Maximum total size of the serialized output batches of splits cached
+  /// across queries. 0 disables the cache.
+  static constexpr const char* kSplitResultCacheMaxBytes =
+      "split-result-cache-max-bytes";
+
+  /// Maximum serialized output size of one split in the split result cache.
+  /// A split producing more is not cached.
+  static constexpr const char* kSplitResultCacheMaxSplitBytes =
+      "split-result-cache-max-split-bytes";
+
   /// The threshold of file size in bytes when the whole file is fetched with
   /// meta data together. Optimization to decrease the small IO requests
   static constexpr const char* kFilePreloadThreshold = "file-preload-threshold";
@@ -203,6 +242,14 @@ class HiveConfig {
   static constexpr const char* kPreserveFlatMapsInMemorySession =
       "hive.preserve_flat_maps_in_memory";
 
+  /// Whether string values read from the cache may reference the cache
+  /// entries instead of being copied. The entries stay pinned while the
+  /// vectors that reference them are alive.
+  static constexpr const char* kStringsFromCacheEnabled =
+      "strings-from-cache-enabled";
+  static constexpr const char* kStringsFromCacheEnabledSession =
+      "strings_from_cache_enabled";
+
   /// Whether to use the cluster index for filter-based row pruning.
   /// When enabled, filters from ScanSpec are converted to index bounds for
   /// efficient row skipping based on the file's cluster index.
@@ -258,6 +305,52 @@ class HiveConfig {
   static constexpr const char* kNimbleFooterSpeculativeIoSizeSession =
       "nimble_footer_speculative_io_size";
 
+  /// Whether to skip Parquet data pages whose ColumnIndex statistics show that
+  /// no row passes the filters. Only used for files written with a page index.
+  static constexpr const char* kParquetPageIndexFilterEnabled =
+      "hive.parquet.page-index-filter-enabled";
+  static constexpr const char* kParquetPageIndexFilterEnabledSession =
+      "parquet_page_index_filter_enabled";
+
+  /// Whether to skip Parquet row groups whose bloom filters show that no value
+  /// passes an equality or IN filter. Only used for files with bloom filters.
+  static constexpr const char* kParquetBloomFilterEnabled =
+      "hive.parquet.bloom-filter-enabled";
+  static constexpr const char* kParquetBloomFilterEnabledSession =
+      "parquet_bloom_filter_enabled";
+
+  /// Whether to skip Parquet row groups whose dictionary pages show that no
+  /// value passes the filter on a column. Only used for column chunks whose
+  /// data pages are all dictionary encoded.
+  static constexpr const char* kParquetDictionaryFilterEnabled =
+      "hive.parquet.dictionary-filter-enabled";
+  static constexpr const char* kParquetDictionaryFilterEnabledSession =
+      "parquet_dictionary_filter_enabled";
+
+  /// The number of data pages of each Parquet column chunk to decompress
+  /// ahead of the decoder on the IO executor. 0 disables.
+  static constexpr const char* kParquetDecompressionPagesAhead =
+      "hive.parquet.decompression-pages-ahead";
+  static constexpr const char* kParquetDecompressionPagesAheadSession =
+      "parquet_decompression_pages_ahead";
+
+  /// The size in bytes of the blocks of gzip and deflate compressed text
+  /// files. The next block is decompressed on the IO executor while the
+  /// current one is parsed. 0 disables.
+  static constexpr const char* kTextDecompressionBlockSize =
+      "hive.text.decompression-block-size";
+  static constexpr const char* kTextDecompressionBlockSizeSession =
+      "text_decompression_block_size";
+
+  /// The maximum IO size in bytes of the first stripe of a split that split
+  /// preload loads ahead of the scan, together with the file footer. The
+  /// stripe is only loaded if it also fits under the memory limit of the
+  /// query. 0 disables.
+  static constexpr const char* kSplitPreloadMaxDataBytes =
+      "split-preload-max-data-bytes";
+  static constexpr const char* kSplitPreloadMaxDataBytesSession =
+      "split_preload_max_data_bytes";
+
   static constexpr const char* kUser = "user";
   static constexpr const char* kSource = "source";
   static constexpr const char* kSchema = "schema";
@@ -267,6 +360,8 @@ class HiveConfig {
 
   uint32_t maxPartitionsPerWriters(const config::ConfigBase* session) const;
 
+  uint32_t maxOpenPartitionWriters(const config::ConfigBase* session) const;
+
   uint32_t maxBucketCount(const config::ConfigBase* session) const;
 
   bool immutablePartitions() const;
@@ -298,6 +393,8 @@ class HiveConfig {
 
   int32_t maxCoalescedDistanceBytes(const config::ConfigBase* session) const;
 
+  bool adaptiveCoalesceEnabled(const config::ConfigBase* session) const;
+
   int32_t prefetchRowGroups() const;
 
   size_t parallelUnitLoadCount(const config::ConfigBase* session) const;
@@ -310,6 +407,14 @@ class HiveConfig {
 
   bool isFileHandleCacheEnabled() const;
 
+  uint64_t fileNotFoundExpirationDurationMs() const;
+
+  uint64_t footerCacheMaxBytes() const;
+
+  uint64_t splitResultCacheMaxBytes() const;
+
+  uint64_t splitResultCacheMaxSplitBytes() const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   std::string writeFileCreateConfig() const;
@@ -341,6 +446,8 @@ class HiveConfig {
   /// converting them to MapVectors.
   bool preserveFlatMapsInMemory(const config::ConfigBase* session) const;
 
+  bool stringsFromCacheEnabled(const config::ConfigBase* session) const;
+
   /// Whether to use the cluster index for filter-based row pruning.
   bool indexEnabled(const config::ConfigBase* session) const;
 
@@ -366,6 +473,19 @@ class HiveConfig {
   uint64_t nimbleFooterSpeculativeIoSize(
       const config::ConfigBase* session) const;
 
+  bool parquetPageIndexFilterEnabled(const config::ConfigBase* session) const;
+
+  bool parquetBloomFilterEnabled(const config::ConfigBase* session) const;
+
+  bool parquetDictionaryFilterEnabled(const config::ConfigBase* session) const;
+
+  int32_t parquetDecompressionPagesAhead(
+      const config::ConfigBase* session) const;
+
+  uint64_t textDecompressionBlockSize(const config::ConfigBase* session) const;
+
+  uint64_t splitPreloadMaxDataBytes(const config::ConfigBase* session) const;
+
   /// User of the query. Used for storage logging.
   std::string user(const config::ConfigBase* session) const;
 
@@ -35,13 +35,28 @@ HiveConnector::HiveConnector(
     folly::Executor* ioExecutor)
     : Connector(id, std::move(config)),
       hiveConfig_(std::make_shared<HiveConfig>(connectorConfig())),
+      footerCache_(
+          hiveConfig_->footerCacheMaxBytes() > 0
+              ? std::make_shared<dwio::common::FooterCache>(
+                    hiveConfig_->footerCacheMaxBytes())
+              : nullptr),
       fileHandleFactory_(
           hiveConfig_->isFileHandleCacheEnabled()
               ? std::make_unique<SimpleLRUCache<FileHandleKey, FileHandle>>(
                     hiveConfig_->numCacheFileHandles())
               : nullptr,
-          std::make_unique<FileHandleGenerator>(hiveConfig_->config())),
-      ioExecutor_(ioExecutor) {
+          std::make_unique<FileHandleGenerator>(
+              hiveConfig_->config(),
+              footerCache_,
+              hiveConfig_->fileNotFoundExpirationDurationMs(),
+              hiveConfig_->numCacheFileHandles())),
+      ioExecutor_(ioExecutor),
+      splitResultCache_(
+          hiveConfig_->splitResultCacheMaxBytes() > 0
+              ? std::make_unique<SplitResultCache>(
+                    hiveConfig_->splitResultCacheMaxBytes(),
+                    hiveConfig_->splitResultCacheMaxSplitBytes())
+              : nullptr) {
   if (hiveConfig_->isFileHandleCacheEnabled()) {
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with maximum of "
@@ -66,7 +81,8 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       &fileHandleFactory_,
       ioExecutor_,
       connectorQueryCtx,
-      hiveConfig_);
+      hiveConfig_,
+      splitResultCache_.get());
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
@@ -18,6 +18,7 @@
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/SplitResultCache.h"
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::dwio::common {
@@ -81,12 +82,40 @@ class HiveConnector : public Connector {
     return fileHandleFactory_.clearCache();
   }
 
+  /// Returns the stats of the parsed footer cache, or empty stats if it is
+  /// disabled.
+  SimpleLRUCacheStats footerCacheStats() const {
+    return footerCache_ ? footerCache_->stats() : SimpleLRUCacheStats{};
+  }
+
+  // NOTE: this is to clear the parsed footer cache, and is only used for
+  // operational purposes.
+  SimpleLRUCacheStats clearFooterCache() {
+    return footerCache_ ? footerCache_->clear() : SimpleLRUCacheStats{};
+  }
+
+  /// Returns the stats of the split result cache, or empty stats if it is
+  /// disabled.
+  SimpleLRUCacheStats splitResultCacheStats() const {
+    return splitResultCache_ ? splitResultCache_->stats()
+                             : SimpleLRUCacheStats{};
+  }
+
+  // NOTE: this is to clear the split result cache, and is only used for
+  // operational purposes.
+  SimpleLRUCacheStats clearSplitResultCache() {
+    return splitResultCache_ ? splitResultCache_->clear()
+                             : SimpleLRUCacheStats{};
+  }
+
   static void registerSerDe();
 
  protected:
   const std::shared_ptr<HiveConfig> hiveConfig_;
+  const std::shared_ptr<dwio::common::FooterCache> footerCache_;
   FileHandleFactory fileHandleFactory_;
   folly::Executor* ioExecutor_;
+  const std::unique_ptr<SplitResultCache> splitResultCache_;
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 
+#include "velox/common/caching/FileIds.h"
+
 namespace facebook::velox::connector::hive {
 
 std::string HiveConnectorSplit::toString() const {
@@ -34,6 +36,10 @@ uint64_t HiveConnectorSplit::size() const {
   return length;
 }
 
+bool HiveConnectorSplit::hasCachedData() const {
+  return fileIds().id(filePath) != StringIdMap::kNoId;
+}
+
 std::string HiveConnectorSplit::getFileName() const {
   const auto i = filePath.rfind('/');
   return i == std::string::npos ? filePath : filePath.substr(i + 1);
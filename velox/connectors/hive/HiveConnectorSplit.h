@@ -110,6 +110,11 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
 
   uint64_t size() const override;
 
+  /// True if the file has an id in fileIds(). The id lives while the file has
+  /// entries in AsyncDataCache or SsdCache, including the ones recovered from
+  /// SSD after a restart, or has an open file handle.
+  bool hasCachedData() const override;
+
   std::string toString() const override;
 
   std::string getFileName() const;
@@ -602,6 +602,10 @@ void configureReaderOptions(
       hiveConfig->maxCoalescedBytes(sessionProperties));
   readerOptions.setMaxCoalesceDistance(
       hiveConfig->maxCoalescedDistanceBytes(sessionProperties));
+  if (hiveConfig->adaptiveCoalesceEnabled(sessionProperties)) {
+    readerOptions.setIoLatencyModel(
+        io::IoLatencyModel::forPath(hiveSplit->filePath));
+  }
   readerOptions.setFileColumnNamesReadAsLowerCase(
       hiveConfig->isFileColumnNamesReadAsLowerCase(sessionProperties));
   readerOptions.setAllowEmptyFile(true);
@@ -652,6 +656,20 @@ void configureReaderOptions(
     case dwio::common::FileFormat::PARQUET:
       readerOptions.setFooterSpeculativeIoSize(
           hiveConfig->parquetFooterSpeculativeIoSize(sessionProperties));
+      readerOptions.setPageIndexFilterEnabled(
+          hiveConfig->parquetPageIndexFilterEnabled(sessionProperties));
+      readerOptions.setBloomFilterEnabled(
+          hiveConfig->parquetBloomFilterEnabled(sessionProperties));
+      readerOptions.setDictionaryFilterEnabled(
+          hiveConfig->parquetDictionaryFilterEnabled(sessionProperties));
+      readerOptions.setDecompressionPagesAhead(
+          hiveConfig->parquetDecompressionPagesAhead(sessionProperties));
+      break;
+    case dwio::common::FileFormat::TEXT:
+      readerOptions.setFooterSpeculativeIoSize(
+          hiveConfig->orcFooterSpeculativeIoSize(sessionProperties));
+      readerOptions.setDecompressionBlockSize(
+          hiveConfig->textDecompressionBlockSize(sessionProperties));
       break;
     case dwio::common::FileFormat::NIMBLE:
       readerOptions.setFooterSpeculativeIoSize(
@@ -707,6 +725,8 @@ void configureRowReaderOptions(
             hiveConfig->readTimestampUnit(sessionProperties)));
     rowReaderOptions.setPreserveFlatMapsInMemory(
         hiveConfig->preserveFlatMapsInMemory(sessionProperties));
+    rowReaderOptions.setPassStringBuffersFromDecoder(
+        hiveConfig->stringsFromCacheEnabled(sessionProperties));
     rowReaderOptions.setParallelUnitLoadCount(
         hiveConfig->parallelUnitLoadCount(sessionProperties));
     rowReaderOptions.setIndexEnabled(
@@ -771,6 +791,50 @@ bool applyPartitionFilter(
 
 } // namespace
 
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<std::string, HiveColumnHandlePtr>&
+        partitionKeysHandle,
+    bool asLocalTime) {
+  if (partitionKeys.empty()) {
+    return true;
+  }
+  for (const auto& child : scanSpec->children()) {
+    if (!child->filter()) {
+      continue;
+    }
+    const auto iter = partitionKeys.find(child->fieldName());
+    if (iter == partitionKeys.end()) {
+      continue;
+    }
+    if (iter->second.has_value()) {
+      const auto handlesIter = partitionKeysHandle.find(child->fieldName());
+      VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+      if (!applyPartitionFilter(
+              handlesIter->second->dataType(),
+              iter->second.value(),
+              handlesIter->second->isPartitionDateValueDaysSinceEpoch(),
+              child->filter(),
+              asLocalTime)) {
+        VLOG(1) << "Skipping " << filePath
+                << " based on the value of partition key "
+                << child->fieldName();
+        return false;
+      }
+    } else if (
+        child->filter()->isDeterministic() && !child->filter()->testNull()) {
+      VLOG(1) << "Skipping " << filePath
+              << " because the filter testNull() failed for partition key "
+              << child->fieldName();
+      return false;
+    }
+  }
+  return true;
+}
+
 bool testFilters(
     const common::ScanSpec* scanSpec,
     const dwio::common::Reader* reader,
@@ -795,13 +859,17 @@ bool testFilters(
           const auto handlesIter = partitionKeysHandle.find(name);
           VELOX_CHECK(handlesIter != partitionKeysHandle.end());
 
-          // This is a non-null partition key
-          return applyPartitionFilter(
-              handlesIter->second->dataType(),
-              iter->second.value(),
-              handlesIter->second->isPartitionDateValueDaysSinceEpoch(),
-              child->filter(),
-              asLocalTime);
+          // This is a non-null partition key. The other filters still need
+          // to be tested if it passes.
+          if (!applyPartitionFilter(
+                  handlesIter->second->dataType(),
+                  iter->second.value(),
+                  handlesIter->second->isPartitionDateValueDaysSinceEpoch(),
+                  child->filter(),
+                  asLocalTime)) {
+            return false;
+          }
+          continue;
         }
         // Column is missing, most likely due to schema evolution. Or it's a
         // partition key but the partition value is NULL.
@@ -149,6 +149,19 @@ void configureRowReaderOptions(
     folly::Executor* ioExecutor,
     dwio::common::RowReaderOptions& rowReaderOptions);
 
+/// Returns false if the filters in 'scanSpec' on the partition keys of a split
+/// reject the values of those keys in 'partitionKeys'. Needs no file access, so
+/// a split can be pruned before its file is opened.
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKeys,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<const HiveColumnHandle>>& partitionKeysHandle,
+    bool asLocalTime);
+
 bool testFilters(
     const common::ScanSpec* scanSpec,
     const dwio::common::Reader* reader,
@@ -509,6 +509,8 @@ HiveDataSink::HiveDataSink(
       updateMode_(getUpdateMode()),
       maxOpenWriters_(hiveConfig_->maxPartitionsPerWriters(
           connectorQueryCtx->sessionProperties())),
+      maxOpenPartitionWriters_(hiveConfig_->maxOpenPartitionWriters(
+          connectorQueryCtx->sessionProperties())),
       partitionChannels_(partitionChannels),
       partitionIdGenerator_(std::move(partitionIdGenerator)),
       dataChannels_(dataChannels),
@@ -602,15 +604,18 @@ void HiveDataSink::appendData(RowVectorPtr input) {
 
   splitInputRowsAndEnsureWriters();
 
-  for (auto index = 0; index < writers_.size(); ++index) {
+  for (const auto index : inputWriters_) {
     const vector_size_t partitionSize = partitionSizes_[index];
-    if (partitionSize == 0) {
-      continue;
-    }
-
     RowVectorPtr writerInput = partitionSize == input->size()
         ? input
-        : exec::wrap(partitionSize, partitionRows_[index], input);
+        : exec::wrap(
+              partitionSize,
+              Buffer::slice<vector_size_t>(
+                  partitionRows_,
+                  partitionOffsets_[index] - partitionSize,
+                  partitionSize,
+                  connectorQueryCtx_->memoryPool()),
+              input);
     write(index, writerInput);
   }
 }
@@ -620,8 +625,10 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
   auto dataInput = makeDataInput(dataChannels_, input);
 
   if (writers_[index] == nullptr) {
+    maybeCloseColdWriter();
     writers_[index] = createWriterForIndex(index);
   }
+  lastWriteSequences_[index] = ++writeSequence_;
 
   writers_[index]->write(dataInput);
   writerInfo_[index]->inputSizeInBytes += dataInput->estimateFlatSize();
@@ -641,6 +648,37 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
   }
 }
 
+bool HiveDataSink::limitOpenWriters() const {
+  // Bucketed tables need one file per bucket and the sorting writers are not
+  // recreated, so their writers stay open.
+  return maxOpenPartitionWriters_ > 0 && isPartitioned() && !isBucketed() &&
+      !sortWrite();
+}
+
+void HiveDataSink::maybeCloseColdWriter() {
+  if (!limitOpenWriters()) {
+    return;
+  }
+  uint32_t numOpenWriters{0};
+  std::optional<size_t> coldIndex;
+  for (auto i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] == nullptr) {
+      continue;
+    }
+    ++numOpenWriters;
+    if (!coldIndex.has_value() ||
+        lastWriteSequences_[i] < lastWriteSequences_[coldIndex.value()]) {
+      coldIndex = i;
+    }
+  }
+  if (numOpenWriters < maxOpenPartitionWriters_) {
+    return;
+  }
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(coldIndex.value());
+  rotateWriter(coldIndex.value());
+  addThreadLocalRuntimeStat(kNumClosedColdWriters, RuntimeCounter(1));
+}
+
 uint64_t HiveDataSink::getCurrentFileBytes(size_t writerIndex) const {
   VELOX_CHECK_LT(writerIndex, ioStats_.size());
   VELOX_CHECK_LT(writerIndex, writerInfo_.size());
@@ -1035,16 +1073,20 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   ioStats_.emplace_back(std::make_unique<io::IoStatistics>());
 
   setMemoryReclaimers(writerInfo_.back().get(), ioStats_.back().get());
-  writers_.emplace_back(createWriterForIndex(writerInfo_.size() - 1));
+  // With capped open writers, the writer is created on its first write, which
+  // first closes a cold writer if needed.
+  writers_.emplace_back(
+      limitOpenWriters() ? nullptr
+                         : createWriterForIndex(writerInfo_.size() - 1));
   addThreadLocalRuntimeStat(
       fmt::format(
           "{}WriterCount",
           dwio::common::toString(insertTableHandle_->storageFormat())),
       RuntimeCounter(1));
-  // Extends the buffer used for partition rows calculations.
+  // Extends the buffers used for partition rows calculations.
   partitionSizes_.emplace_back(0);
-  partitionRows_.emplace_back(nullptr);
-  rawPartitionRows_.emplace_back(nullptr);
+  partitionOffsets_.emplace_back(0);
+  lastWriteSequences_.emplace_back(0);
 
   writerIndexMap_.emplace(id, writers_.size() - 1);
   return writerIndexMap_[id];
@@ -1134,22 +1176,19 @@ HiveWriterId HiveDataSink::getWriterId(size_t row) const {
   return HiveWriterId{partitionId, bucketId};
 }
 
-void HiveDataSink::updatePartitionRows(
-    uint32_t index,
-    vector_size_t numRows,
-    vector_size_t row) {
-  VELOX_DCHECK_LT(index, partitionSizes_.size());
-  VELOX_DCHECK_EQ(partitionSizes_.size(), partitionRows_.size());
-  VELOX_DCHECK_EQ(partitionRows_.size(), rawPartitionRows_.size());
-  if (FOLLY_UNLIKELY(partitionRows_[index] == nullptr) ||
-      (partitionRows_[index]->capacity() < numRows * sizeof(vector_size_t))) {
-    partitionRows_[index] =
-        allocateIndices(numRows, connectorQueryCtx_->memoryPool());
-    rawPartitionRows_[index] =
-        partitionRows_[index]->asMutable<vector_size_t>();
+uint32_t HiveDataSink::writerIndex(vector_size_t row) {
+  if (isBucketed()) {
+    return ensureWriter(getWriterId(row));
   }
-  rawPartitionRows_[index][partitionSizes_[index]] = row;
-  ++partitionSizes_[index];
+  const auto partitionId = partitionIds_[row];
+  if (partitionId >= partitionWriterIndices_.size()) {
+    partitionWriterIndices_.resize(partitionId + 1, kNoWriter);
+  }
+  auto& index = partitionWriterIndices_[partitionId];
+  if (FOLLY_UNLIKELY(index == kNoWriter)) {
+    index = ensureWriter(getWriterId(row));
+  }
+  return index;
 }
 
 void HiveDataSink::splitInputRowsAndEnsureWriters() {
@@ -1158,21 +1197,37 @@ void HiveDataSink::splitInputRowsAndEnsureWriters() {
     VELOX_CHECK_EQ(bucketIds_.size(), partitionIds_.size());
   }
 
-  std::fill(partitionSizes_.begin(), partitionSizes_.end(), 0);
+  for (const auto index : inputWriters_) {
+    partitionSizes_[index] = 0;
+  }
+  inputWriters_.clear();
 
-  const auto numRows =
+  const vector_size_t numRows =
       isPartitioned() ? partitionIds_.size() : bucketIds_.size();
+  rowWriterIndices_.resize(numRows);
   for (auto row = 0; row < numRows; ++row) {
-    const auto id = getWriterId(row);
-    const uint32_t index = ensureWriter(id);
-    updatePartitionRows(index, numRows, row);
+    const auto index = writerIndex(row);
+    rowWriterIndices_[row] = index;
+    if (partitionSizes_[index]++ == 0) {
+      inputWriters_.push_back(index);
+    }
   }
 
-  for (uint32_t i = 0; i < partitionSizes_.size(); ++i) {
-    if (partitionSizes_[i] != 0) {
-      VELOX_CHECK_NOT_NULL(partitionRows_[i]);
-      partitionRows_[i]->setSize(partitionSizes_[i] * sizeof(vector_size_t));
-    }
+  // The writers may hold on to the rows of the previous input.
+  if (partitionRows_ == nullptr || !partitionRows_->isMutable() ||
+      partitionRows_->capacity() < numRows * sizeof(vector_size_t)) {
+    partitionRows_ = allocateIndices(numRows, connectorQueryCtx_->memoryPool());
+  }
+  partitionRows_->setSize(numRows * sizeof(vector_size_t));
+  auto* rawPartitionRows = partitionRows_->asMutable<vector_size_t>();
+
+  vector_size_t offset = 0;
+  for (const auto index : inputWriters_) {
+    partitionOffsets_[index] = offset;
+    offset += partitionSizes_[index];
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    rawPartitionRows[partitionOffsets_[rowWriterIndices_[row]]++] = row;
   }
 }
 
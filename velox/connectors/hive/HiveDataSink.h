@@ -579,6 +579,9 @@ class HiveDataSink : public DataSink {
  public:
   /// The list of runtime stats reported by hive data sink
   static constexpr const char* kEarlyFlushedRawBytes = "earlyFlushedRawBytes";
+  /// Number of writers closed to stay within the cap on open partition
+  /// writers.
+  static constexpr const char* kNumClosedColdWriters = "numClosedColdWriters";
 
   /// Defines the execution states of a hive data sink running internally.
   enum class State {
@@ -753,9 +756,16 @@ class HiveDataSink : public DataSink {
   // Computes the number of input rows as well as the actual input row indices
   // to each corresponding (bucketed) partition based on the partition and
   // bucket ids calculated by 'computePartitionAndBucketIds'. The function also
-  // ensures that there is a writer created for each (bucketed) partition.
+  // ensures that there is a writer created for each (bucketed) partition. The
+  // rows are clustered by writer with a counting sort into 'partitionRows_',
+  // so that the cost does not grow with the number of writers.
   void splitInputRowsAndEnsureWriters();
 
+  // Returns the index in 'writers_' of the writer of 'row'. Partitions of a
+  // non-bucketed table are looked up in 'partitionWriterIndices_' instead of
+  // 'writerIndexMap_'.
+  uint32_t writerIndex(vector_size_t row);
+
   // Makes sure to create one writer for the given writer id. The function
   // returns the corresponding index in 'writers_'.
   virtual uint32_t ensureWriter(const HiveWriterId& id);
@@ -791,14 +801,6 @@ class HiveDataSink : public DataSink {
       size_t writerIndex,
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
 
-  // Records a row index for a specific partition. This method maintains the
-  // mapping of which input rows belong to which partition by storing row
-  // indices in partition-specific buffers. If the buffer for the partition
-  // doesn't exist or is too small, it allocates/reallocates the buffer to
-  // accommodate all rows.
-  void
-  updatePartitionRows(uint32_t index, vector_size_t numRows, vector_size_t row);
-
   HiveWriterParameters getWriterParameters(
       const std::optional<std::string>& partition,
       std::optional<uint32_t> bucketId) const;
@@ -822,6 +824,15 @@ class HiveDataSink : public DataSink {
   // Invoked to write 'input' to the specified file writer.
   void write(size_t index, RowVectorPtr input);
 
+  // Returns true if the number of concurrently open writers is capped by
+  // 'maxOpenPartitionWriters_'.
+  bool limitOpenWriters() const;
+
+  // Closes the least recently written open writer if opening one more writer
+  // would exceed 'maxOpenPartitionWriters_'. The closed writer's file is
+  // finalized and a new file is started on its next write.
+  void maybeCloseColdWriter();
+
   /// Rotates the writer at the given index to a new file. This is called when
   /// the current file exceeds maxTargetFileBytes_. The old writer is closed
   /// and a new writer is created for the same partition/bucket.
@@ -850,6 +861,9 @@ class HiveDataSink : public DataSink {
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const HiveWriterParameters::UpdateMode updateMode_;
   const uint32_t maxOpenWriters_;
+  // Maximum number of partition writers open at the same time. 0 means no
+  // limit.
+  const uint32_t maxOpenPartitionWriters_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   // Indices of dataChannel are stored in ascending order
@@ -878,13 +892,27 @@ class HiveDataSink : public DataSink {
   std::vector<std::shared_ptr<HiveWriterInfo>> writerInfo_;
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
 
+  // The writer index of each partition id of a non-bucketed table, or
+  // kNoWriter if the partition has no writer yet.
+  static constexpr uint32_t kNoWriter = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> partitionWriterIndices_;
+
+  // Write sequence number of the last write to each writer. Used to pick the
+  // writer to close when the open writers are capped.
+  std::vector<uint64_t> lastWriteSequences_;
+  uint64_t writeSequence_{0};
+
   // Below are structures updated when processing current input. partitionIds_
-  // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
-  // partitionSizes_ are indexed by partitionId.
+  // and rowWriterIndices_ are indexed by the row of input_. partitionRows_
+  // holds the input rows clustered by writer: the rows of writer i end at
+  // partitionOffsets_[i] and there are partitionSizes_[i] of them.
+  // inputWriters_ lists the writers with rows in the input.
   raw_vector<uint64_t> partitionIds_;
-  std::vector<BufferPtr> partitionRows_;
-  std::vector<vector_size_t*> rawPartitionRows_;
+  raw_vector<uint32_t> rowWriterIndices_;
+  BufferPtr partitionRows_;
+  std::vector<vector_size_t> partitionOffsets_;
   std::vector<vector_size_t> partitionSizes_;
+  std::vector<uint32_t> inputWriters_;
 
   // Reusable buffers for bucket id calculations.
   std::vector<uint32_t> bucketIds_;
@@ -17,12 +17,15 @@
 #include "velox/connectors/hive/HiveDataSource.h"
 
 #include <fmt/ranges.h>
+#include <folly/json.h>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 
 #include "velox/common/Casts.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/CpuWallTimer.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 
 #include "velox/expression/FieldReference.h"
@@ -30,6 +33,18 @@
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::connector::hive {
+namespace {
+
+// The serde of the pages in the split result cache.
+constexpr const char* kSplitResultSerde = "Presto";
+
+std::string toSortedJson(const folly::dynamic& obj) {
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  return folly::json::serialize(obj, opts);
+}
+
+} // namespace
 
 void HiveDataSource::processColumnHandle(const HiveColumnHandlePtr& handle) {
   switch (handle->columnType()) {
@@ -57,14 +72,16 @@ HiveDataSource::HiveDataSource(
     FileHandleFactory* fileHandleFactory,
     folly::Executor* ioExecutor,
     const ConnectorQueryCtx* connectorQueryCtx,
-    const std::shared_ptr<HiveConfig>& hiveConfig)
+    const std::shared_ptr<HiveConfig>& hiveConfig,
+    SplitResultCache* splitResultCache)
     : fileHandleFactory_(fileHandleFactory),
       ioExecutor_(ioExecutor),
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
       pool_(connectorQueryCtx->memoryPool()),
       outputType_(outputType),
-      expressionEvaluator_(connectorQueryCtx->expressionEvaluator()) {
+      expressionEvaluator_(connectorQueryCtx->expressionEvaluator()),
+      splitResultCache_(splitResultCache) {
   hiveTableHandle_ = checkedPointerCast<const HiveTableHandle>(tableHandle);
 
   folly::F14FastMap<std::string_view, const HiveColumnHandle*> columnHandles;
@@ -200,6 +217,62 @@ HiveDataSource::HiveDataSource(
 
   ioStatistics_ = std::make_shared<io::IoStatistics>();
   ioStats_ = std::make_shared<IoStats>();
+
+  if (isSplitResultCacheable()) {
+    folly::dynamic key = folly::dynamic::object;
+    key["tableHandle"] = hiveTableHandle_->serialize();
+    folly::dynamic columns = folly::dynamic::array;
+    for (const auto& name : outputType_->names()) {
+      columns.push_back(assignments.at(name)->serialize());
+    }
+    key["columns"] = std::move(columns);
+    key["outputType"] = outputType_->serialize();
+    key["sessionTimezone"] = connectorQueryCtx_->sessionTimezone();
+    key["adjustTimestampToTimezone"] =
+        connectorQueryCtx_->adjustTimestampToTimezone();
+    folly::dynamic session = folly::dynamic::object;
+    if (connectorQueryCtx_->sessionProperties() != nullptr) {
+      for (const auto& [name, value] :
+           connectorQueryCtx_->sessionProperties()->rawConfigsCopy()) {
+        session[name] = value;
+      }
+    }
+    key["session"] = std::move(session);
+    splitResultKeyPrefix_ = toSortedJson(key);
+  }
+}
+
+bool HiveDataSource::isSplitResultCacheable() const {
+  if (splitResultCache_ == nullptr || randomSkip_ != nullptr ||
+      specialColumns_.rowId.has_value() ||
+      !isRegisteredNamedVectorSerde(kSplitResultSerde)) {
+    return false;
+  }
+  for (const auto& postProcessor : columnPostProcessors_) {
+    if (postProcessor) {
+      return false;
+    }
+  }
+  for (const auto& [_, filter] : filters_) {
+    if (!filter->isDeterministic()) {
+      return false;
+    }
+  }
+  return remainingFilterExprSet_ == nullptr ||
+      remainingFilterExprSet_->expr(0)->isDeterministic();
+}
+
+std::optional<std::string> HiveDataSource::splitResultKey() const {
+  // Splits of table formats, e.g. Iceberg splits with delete files, carry
+  // more than HiveConnectorSplit::serialize() covers.
+  if (splitResultKeyPrefix_.empty() || !split_->cacheable ||
+      typeid(*split_) != typeid(HiveConnectorSplit) ||
+      !split_->properties.has_value() ||
+      !split_->properties->modificationTime.has_value()) {
+    return std::nullopt;
+  }
+  return fmt::format(
+      "{}\n{}", splitResultKeyPrefix_, toSortedJson(split_->serialize()));
 }
 
 std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
@@ -298,6 +371,7 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   VELOX_CHECK_NULL(
       split_,
       "Previous split has not been processed yet. Call next to process the split.");
+  const auto startNanos = getCurrentTimeNano();
   split_ = checkedPointerCast<HiveConnectorSplit>(split);
 
   VLOG(1) << "Adding split " << split_->toString();
@@ -308,6 +382,21 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     splitReader_.reset();
   }
 
+  cachedSplitResult_.reset();
+  newSplitResult_.reset();
+  if (auto key = splitResultKey()) {
+    splitResultKey_ = std::move(*key);
+    cachedSplitResult_ = splitResultCache_->find(splitResultKey_);
+    if (cachedSplitResult_ != nullptr) {
+      ++numSplitResultCacheHits_;
+      nextCachedPage_ = 0;
+      startSplitTiming(getCurrentTimeNano() - startNanos);
+      return;
+    }
+    newSplitResult_ = std::make_shared<SplitResult>();
+    newSplitResultBytes_ = 0;
+  }
+
   std::vector<column_index_t> bucketChannels;
   if (split_->bucketConversion.has_value()) {
     bucketChannels = setupBucketConversion();
@@ -326,18 +415,39 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   splitReader_->configureReaderOptions(randomSkip_);
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
   readerOutputType_ = splitReader_->readerOutputType();
+  startSplitTiming(getCurrentTimeNano() - startNanos);
+}
+
+uint64_t HiveDataSource::preloadSplitData() {
+  if (cachedSplitResult_ != nullptr) {
+    return 0;
+  }
+  VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
+  const auto maxBytes = hiveConfig_->splitPreloadMaxDataBytes(
+      connectorQueryCtx_->sessionProperties());
+  if (maxBytes == 0) {
+    return 0;
+  }
+  const auto bytes = splitReader_->preloadFirstUnit(maxBytes);
+  preloadedSplitDataBytes_ += bytes;
+  return bytes;
 }
 
 std::optional<RowVectorPtr> HiveDataSource::next(
     uint64_t size,
     velox::ContinueFuture& /*future*/) {
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+  if (cachedSplitResult_ != nullptr) {
+    return nextCachedBatch();
+  }
   VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
 
   TestValue::adjust(
       "facebook::velox::connector::hive::HiveDataSource::next", this);
 
   if (splitReader_->emptySplit()) {
+    finishSplitResult();
+    finishSplitTiming();
     resetSplit();
     return nullptr;
   }
@@ -355,9 +465,14 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   completedRows_ += rowsScanned;
   if (rowsScanned == 0) {
     splitReader_->updateRuntimeStats(runtimeStats_);
+    finishSplitResult();
+    finishSplitTiming();
     resetSplit();
     return nullptr;
   }
+  if (splitTiming_.firstBatchWallNanos == 0) {
+    splitTiming_.firstBatchWallNanos = getCurrentTimeNano() - splitAddedNanos_;
+  }
 
   VELOX_CHECK(
       !output_->mayHaveNulls(), "Top-level row vector cannot have nulls");
@@ -389,9 +504,14 @@ std::optional<RowVectorPtr> HiveDataSource::next(
       remainingIndices = filterEvalCtx_.selectedIndices;
     }
   }
+  splitTiming_.outputRows += rowsRemaining;
 
   if (outputType_->size() == 0) {
-    return exec::wrap(rowsRemaining, remainingIndices, rowVector);
+    auto result = exec::wrap(rowsRemaining, remainingIndices, rowVector);
+    if (newSplitResult_ != nullptr) {
+      addToSplitResult(result);
+    }
+    return result;
   }
 
   std::vector<VectorPtr> outputColumns;
@@ -410,19 +530,90 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     outputColumns.push_back(std::move(column));
   }
 
-  return std::make_shared<RowVector>(
+  auto result = std::make_shared<RowVector>(
       pool_, outputType_, BufferPtr(nullptr), rowsRemaining, outputColumns);
+  if (newSplitResult_ != nullptr) {
+    addToSplitResult(result);
+  }
+  return result;
+}
+
+RowVectorPtr HiveDataSource::nextCachedBatch() {
+  if (nextCachedPage_ == cachedSplitResult_->pages.size()) {
+    finishSplitTiming();
+    cachedSplitResult_.reset();
+    split_.reset();
+    return nullptr;
+  }
+  const auto& page = cachedSplitResult_->pages[nextCachedPage_++];
+  completedRows_ += page.numRows;
+  if (splitTiming_.firstBatchWallNanos == 0) {
+    splitTiming_.firstBatchWallNanos = getCurrentTimeNano() - splitAddedNanos_;
+  }
+  splitTiming_.outputRows += page.numRows;
+  if (outputType_->size() == 0) {
+    return std::make_shared<RowVector>(
+        pool_,
+        outputType_,
+        BufferPtr(nullptr),
+        page.numRows,
+        std::vector<VectorPtr>{});
+  }
+  BufferInputStream input({ByteRange{
+      reinterpret_cast<uint8_t*>(const_cast<char*>(page.data.data())),
+      static_cast<int32_t>(page.data.size()),
+      0}});
+  RowVectorPtr result;
+  getNamedVectorSerde(kSplitResultSerde)
+      ->deserialize(&input, pool_, outputType_, &result, nullptr);
+  return result;
+}
+
+void HiveDataSource::addToSplitResult(const RowVectorPtr& output) {
+  SplitResult::Page page{.numRows = output->size()};
+  if (outputType_->size() > 0) {
+    if (splitResultSerializer_ == nullptr) {
+      splitResultSerializer_ =
+          getNamedVectorSerde(kSplitResultSerde)->createBatchSerializer(pool_);
+    }
+    // The batch is returned loaded, the same as it is cached.
+    output->loadedVector();
+    std::ostringstream out;
+    OStreamOutputStream stream(&out);
+    splitResultSerializer_->serialize(output, &stream);
+    page.data = out.str();
+  }
+  newSplitResultBytes_ += page.data.size();
+  if (newSplitResultBytes_ > splitResultCache_->maxSplitBytes()) {
+    newSplitResult_.reset();
+    return;
+  }
+  newSplitResult_->pages.push_back(std::move(page));
+}
+
+void HiveDataSource::finishSplitResult() {
+  if (newSplitResult_ != nullptr) {
+    splitResultCache_->insert(splitResultKey_, std::move(newSplitResult_));
+  }
 }
 
 void HiveDataSource::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
-  fieldSpec.setFilter(filter);
+  // The same filter is added to all drivers of the pipeline. A stateful
+  // filter, e.g. a Bloom filter that tracks its selectivity, is copied so that
+  // each driver has its own state.
+  fieldSpec.setFilter(
+      filter->isStateful() ? std::shared_ptr<common::Filter>(filter->clone())
+                           : filter);
   scanSpec_->resetCachedValues(true);
   if (splitReader_) {
     splitReader_->resetFilterCaches();
   }
+  // The output now depends on the dynamic filter.
+  splitResultKeyPrefix_.clear();
+  newSplitResult_.reset();
 }
 
 std::unordered_map<std::string, RuntimeMetric>
@@ -552,6 +743,17 @@ HiveDataSource::getRuntimeStats() {
         {std::string(kNumBucketConversion),
          RuntimeMetric(numBucketConversion_)});
   }
+  if (preloadedSplitDataBytes_ > 0) {
+    res.insert(
+        {std::string(kPreloadedSplitDataBytes),
+         RuntimeMetric(
+             preloadedSplitDataBytes_, RuntimeCounter::Unit::kBytes)});
+  }
+  if (numSplitResultCacheHits_ > 0) {
+    res.insert(
+        {std::string(kNumSplitResultCacheHits),
+         RuntimeMetric(numSplitResultCacheHits_)});
+  }
 
   for (const auto& [format, count] : numSplitsByFileFormat_) {
     res.insert(
@@ -576,25 +778,60 @@ void HiveDataSource::setFromDataSource(
   runtimeStats_.processedSplits += source->runtimeStats_.processedSplits;
   runtimeStats_.skippedSplitBytes += source->runtimeStats_.skippedSplitBytes;
   readerOutputType_ = std::move(source->readerOutputType_);
-  source->scanSpec_->moveAdaptationFrom(*scanSpec_);
+  // The reader of the previous split restores the split specific filters it
+  // set on 'scanSpec_', e.g. for Iceberg equality deletes, so that only the
+  // adapted query filters move to 'source'.
+  splitReader_.reset();
+  if (source->splitReader_ != nullptr) {
+    source->splitReader_->moveAdaptationFrom(*scanSpec_);
+  } else {
+    source->scanSpec_->moveAdaptationFrom(*scanSpec_);
+  }
   scanSpec_ = std::move(source->scanSpec_);
   metadataFilter_ = std::move(source->metadataFilter_);
   splitReader_ = std::move(source->splitReader_);
-  splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  if (splitReader_ != nullptr) {
+    splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  }
+  splitResultKey_ = std::move(source->splitResultKey_);
+  cachedSplitResult_ = std::move(source->cachedSplitResult_);
+  nextCachedPage_ = source->nextCachedPage_;
+  newSplitResult_ = std::move(source->newSplitResult_);
+  newSplitResultBytes_ = source->newSplitResultBytes_;
+  numSplitResultCacheHits_ += source->numSplitResultCacheHits_;
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStatistics_->merge(*ioStatistics_);
   ioStatistics_ = std::move(source->ioStatistics_);
   source->ioStats_->merge(*ioStats_);
   ioStats_ = std::move(source->ioStats_);
+  // The IO of the split so far is in the open time of 'source'.
+  splitTiming_ = std::move(source->splitTiming_);
+  splitAddedNanos_ = source->splitAddedNanos_;
+  splitStartIoWaitUs_ = ioStatistics_->queryThreadIoLatencyUs().sum();
 
   numBucketConversion_ += source->numBucketConversion_;
+  preloadedSplitDataBytes_ += source->preloadedSplitDataBytes_;
 
   for (const auto& [format, count] : source->numSplitsByFileFormat_) {
     numSplitsByFileFormat_[format] += count;
   }
 }
 
+void HiveDataSource::cancel() {
+  TestValue::adjust(
+      "facebook::velox::connector::hive::HiveDataSource::cancel", this);
+  if (split_ != nullptr && splitReader_ != nullptr) {
+    splitReader_->updateRuntimeStats(runtimeStats_);
+  }
+  // Destroying the reader destroys its BufferedInput, which cancels the
+  // CoalescedLoads it has not started.
+  splitReader_.reset();
+  split_.reset();
+  newSplitResult_.reset();
+  cachedSplitResult_.reset();
+}
+
 int64_t HiveDataSource::estimatedRowSize() {
   if (splitReader_ == nullptr) {
     return kUnknownRowSize;
@@ -630,6 +867,41 @@ vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
   return rowsRemaining;
 }
 
+void HiveDataSource::startSplitTiming(uint64_t openWallNanos) {
+  splitTiming_ = SplitTiming{.openWallNanos = openWallNanos};
+  splitAddedNanos_ = getCurrentTimeNano();
+  splitStartIoWaitUs_ = ioStatistics_->queryThreadIoLatencyUs().sum();
+  splitStartFilterCpuNanos_ =
+      totalRemainingFilterCpuTime_.load(std::memory_order_relaxed);
+  const auto& columnMetrics = runtimeStats_.columnReaderStats.columnMetricsSet;
+  splitStartColumnCpuNanos_ = columnMetrics.has_value()
+      ? columnMetrics->cpuNanosByColumn()
+      : std::map<uint32_t, uint64_t>{};
+}
+
+void HiveDataSource::finishSplitTiming() {
+  splitTiming_.ioWaitWallNanos =
+      (ioStatistics_->queryThreadIoLatencyUs().sum() - splitStartIoWaitUs_) *
+      1'000;
+  splitTiming_.filterCpuNanos =
+      totalRemainingFilterCpuTime_.load(std::memory_order_relaxed) -
+      splitStartFilterCpuNanos_;
+  // The column stats of the split are added to 'runtimeStats_' at its end.
+  const auto& columnMetrics = runtimeStats_.columnReaderStats.columnMetricsSet;
+  if (columnMetrics.has_value()) {
+    for (const auto& [nodeId, nanos] : columnMetrics->cpuNanosByColumn()) {
+      auto it = splitStartColumnCpuNanos_.find(nodeId);
+      const auto startNanos =
+          it == splitStartColumnCpuNanos_.end() ? 0 : it->second;
+      if (nanos > startNanos) {
+        splitTiming_.columnDecodeCpuNanos.emplace(nodeId, nanos - startNanos);
+      }
+    }
+  }
+  finishedSplitTiming_ = std::move(splitTiming_);
+  splitTiming_ = SplitTiming{};
+}
+
 void HiveDataSource::resetSplit() {
   split_.reset();
   splitReader_->resetSplit();
@@ -23,10 +23,12 @@
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/SplitResultCache.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/dwio/common/Statistics.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/expression/Expr.h"
+#include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::connector::hive {
 
@@ -45,7 +47,11 @@ class HiveDataSource : public DataSource {
   static constexpr std::string_view kNumRamRead{"numRamRead"};
   static constexpr std::string_view kRamReadBytes{"ramReadBytes"};
   static constexpr std::string_view kNumBucketConversion{"numBucketConversion"};
+  static constexpr std::string_view kPreloadedSplitDataBytes{
+      "preloadedSplitDataBytes"};
   static constexpr std::string_view kFileFormat{"fileFormat."};
+  static constexpr std::string_view kNumSplitResultCacheHits{
+      "numSplitResultCacheHits"};
 
   HiveDataSource(
       const RowTypePtr& outputType,
@@ -54,10 +60,13 @@ class HiveDataSource : public DataSource {
       FileHandleFactory* fileHandleFactory,
       folly::Executor* ioExecutor,
       const ConnectorQueryCtx* connectorQueryCtx,
-      const std::shared_ptr<HiveConfig>& hiveConfig);
+      const std::shared_ptr<HiveConfig>& hiveConfig,
+      SplitResultCache* splitResultCache = nullptr);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
+  uint64_t preloadSplitData() override;
+
   std::optional<RowVectorPtr> next(uint64_t size, velox::ContinueFuture& future)
       override;
 
@@ -75,12 +84,22 @@ class HiveDataSource : public DataSource {
 
   std::unordered_map<std::string, RuntimeMetric> getRuntimeStats() override;
 
+  std::optional<SplitTiming> finishedSplitTiming() override {
+    return std::exchange(finishedSplitTiming_, std::nullopt);
+  }
+
   bool allPrefetchIssued() const override {
     return splitReader_ && splitReader_->allPrefetchIssued();
   }
 
   void setFromDataSource(std::unique_ptr<DataSource> sourceUnique) override;
 
+  /// Drops the reader of the split in progress, e.g. when a downstream Limit
+  /// is satisfied and the scan is closed mid-split. This cancels the reads of
+  /// the split that have been scheduled but not started and frees the data
+  /// already loaded for it.
+  void cancel() override;
+
   int64_t estimatedRowSize() override;
 
   const common::SubfieldFilters* getFilters() const override {
@@ -143,6 +162,24 @@ class HiveDataSource : public DataSource {
 
   void setupRowIdColumn();
 
+  // Returns true if the output of a split depends only on the split and the
+  // scan, so that it can be served from 'splitResultCache_'.
+  bool isSplitResultCacheable() const;
+
+  // Returns the key to cache the result of 'split_' under, or std::nullopt if
+  // 'split_' is not cached.
+  std::optional<std::string> splitResultKey() const;
+
+  // Returns the next batch of the cached result of 'split_', or nullptr at the
+  // end of the split.
+  RowVectorPtr nextCachedBatch();
+
+  // Appends 'output' to the result of 'split_' being built for the cache.
+  void addToSplitResult(const RowVectorPtr& output);
+
+  // Adds the result of 'split_' to the cache if it is being built.
+  void finishSplitResult();
+
   // Evaluates remainingFilter_ on the specified vector. Returns number of rows
   // passed. Populates filterEvalCtx_.selectedIndices and selectedBits if only
   // some rows passed the filter. If none or all rows passed
@@ -153,6 +190,12 @@ class HiveDataSource : public DataSource {
   // hold adaptation.
   void resetSplit();
 
+  // Starts the timing of 'split_' after addSplit() took 'openWallNanos'.
+  void startSplitTiming(uint64_t openWallNanos);
+
+  // Makes the timing of 'split_' the finished split timing.
+  void finishSplitTiming();
+
   const RowVectorPtr& getEmptyOutput() {
     if (!emptyOutput_) {
       emptyOutput_ = RowVector::createEmpty(outputType_, pool_);
@@ -195,6 +238,9 @@ class HiveDataSource : public DataSource {
 
   int64_t numBucketConversion_ = 0;
 
+  // Bytes of split data loaded by preloadSplitData().
+  int64_t preloadedSplitDataBytes_ = 0;
+
   // Tracks the number of splits read per file format.
   std::unordered_map<dwio::common::FileFormat, int64_t> numSplitsByFileFormat_;
 
@@ -205,6 +251,40 @@ class HiveDataSource : public DataSource {
   SelectivityVector filterLazyBaseRows_;
   exec::FilterEvalCtx filterEvalCtx_;
 
+  SplitResultCache* const splitResultCache_;
+
+  // The key of the split results of this data source, without the split part.
+  // Empty if the splits are not cached. Cleared when a dynamic filter is added.
+  std::string splitResultKeyPrefix_;
+
+  // The key of 'split_' in 'splitResultCache_'.
+  std::string splitResultKey_;
+
+  // The result of 'split_' found in the cache and the index of the next page
+  // to return.
+  std::shared_ptr<const SplitResult> cachedSplitResult_;
+  size_t nextCachedPage_{0};
+
+  // The result of 'split_' being built for the cache, or nullptr if 'split_'
+  // is not cached.
+  std::shared_ptr<SplitResult> newSplitResult_;
+  uint64_t newSplitResultBytes_{0};
+
+  std::unique_ptr<BatchVectorSerializer> splitResultSerializer_;
+
+  int64_t numSplitResultCacheHits_{0};
+
+  // The timing of 'split_', the time its addSplit() ended and the totals of
+  // the timed counters when it was added.
+  SplitTiming splitTiming_;
+  uint64_t splitAddedNanos_{0};
+  uint64_t splitStartIoWaitUs_{0};
+  uint64_t splitStartFilterCpuNanos_{0};
+  std::map<uint32_t, uint64_t> splitStartColumnCpuNanos_;
+
+  // The timing of the last finished split until finishedSplitTiming().
+  std::optional<SplitTiming> finishedSplitTiming_;
+
   // Remembers the WaveDataSource. Successive calls to toWaveDataSource() will
   // return the same.
   std::shared_ptr<wave::WaveDataSource> waveDataSource_;
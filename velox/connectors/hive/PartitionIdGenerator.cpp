@@ -68,8 +68,18 @@ void PartitionIdGenerator::run(
   // TODO Optimize common use case where all records belong to the same
   // partition. VectorHashers keep track of the number of unique values, hence,
   // we can find out if there is only one unique value for each partition key.
+  //
+  // Input is often clustered by partition, so a run of rows with the same
+  // value ID is mapped with one lookup.
+  std::optional<uint64_t> lastValueId;
+  uint64_t lastPartitionId{0};
   for (auto i = 0; i < numRows; ++i) {
     auto valueId = result[i];
+    if (valueId == lastValueId) {
+      result[i] = lastPartitionId;
+      continue;
+    }
+    lastValueId = valueId;
     auto it = partitionIds_.find(valueId);
     if (it != partitionIds_.end()) {
       result[i] = it->second;
@@ -86,6 +96,7 @@ void PartitionIdGenerator::run(
 
       result[i] = nextPartitionId;
     }
+    lastPartitionId = result[i];
   }
 }
 
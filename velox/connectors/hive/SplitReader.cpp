@@ -166,6 +166,10 @@ void SplitReader::prepareSplit(
   // This handles filter-only synthesized columns that are not in the scanSpec.
   validateSynthesizedColumnFilters();
 
+  if (!filterOnPartitionKeys(runtimeStats)) {
+    return;
+  }
+
   createReader(fileReadOps);
   if (emptySplit_) {
     return;
@@ -291,6 +295,10 @@ void SplitReader::resetSplit() {
   hiveSplit_.reset();
 }
 
+void SplitReader::moveAdaptationFrom(common::ScanSpec& other) {
+  scanSpec_->moveAdaptationFrom(other);
+}
+
 int64_t SplitReader::estimatedRowSize() const {
   if (!baseRowReader_) {
     return DataSource::kUnknownRowSize;
@@ -311,6 +319,21 @@ bool SplitReader::allPrefetchIssued() const {
   return baseRowReader_ && baseRowReader_->allPrefetchIssued();
 }
 
+uint64_t SplitReader::preloadFirstUnit(uint64_t maxBytes) {
+  if (emptySplit_ || baseRowReader_ == nullptr) {
+    return 0;
+  }
+  // The loaded stripe is held until the split is read, so it must not push
+  // the query over its memory limit.
+  const auto* root = pool_->root();
+  const auto headroom = root->maxCapacity() - root->reservedBytes();
+  if (headroom <= 0) {
+    return 0;
+  }
+  return baseRowReader_->loadFirstUnit(
+      std::min<uint64_t>(maxBytes, headroom));
+}
+
 void SplitReader::setConnectorQueryCtx(
     const ConnectorQueryCtx* connectorQueryCtx) {
   connectorQueryCtx_ = connectorQueryCtx;
@@ -372,6 +395,16 @@ void SplitReader::createReader(
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
+  // The footer of a file is only cached if a rewrite of the file can be told
+  // by its modification time.
+  if (fileHandleCachePtr->footerCache != nullptr &&
+      fileProperties.modificationTime.has_value()) {
+    baseReaderOpts_.setFooterCache(
+        fileHandleCachePtr->footerCache,
+        {.path = hiveSplit_->filePath,
+         .fileSize = fileHandleCachePtr->file->size(),
+         .modificationTime = fileProperties.modificationTime.value()});
+  }
   auto baseFileInput = BufferedInputBuilder::getInstance()->create(
       *fileHandleCachePtr,
       baseReaderOpts_,
@@ -413,6 +446,23 @@ bool SplitReader::filterOnStats(
   return false;
 }
 
+bool SplitReader::filterOnPartitionKeys(
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  if (testPartitionFilters(
+          scanSpec_.get(),
+          hiveSplit_->filePath,
+          hiveSplit_->partitionKeys,
+          *partitionKeys_,
+          hiveConfig_->readTimestampPartitionValueAsLocalTime(
+              connectorQueryCtx_->sessionProperties()))) {
+    return true;
+  }
+  ++runtimeStats.skippedSplits;
+  runtimeStats.skippedSplitBytes += hiveSplit_->length;
+  emptySplit_ = true;
+  return false;
+}
+
 bool SplitReader::checkIfSplitIsEmpty(
     dwio::common::RuntimeStatistics& runtimeStats) {
   // emptySplit_ may already be set if the data file is not found. In this case
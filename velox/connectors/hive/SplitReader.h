@@ -122,12 +122,23 @@ class SplitReader {
 
   void resetSplit();
 
+  /// Moves the adapted filters and filter order of 'other', the ScanSpec of
+  /// the previous split, to the ScanSpec of this reader. Called when this
+  /// reader was prepared ahead of the previous split being done, e.g. for
+  /// split preloading.
+  virtual void moveAdaptationFrom(common::ScanSpec& other);
+
   int64_t estimatedRowSize() const;
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const;
 
   bool allPrefetchIssued() const;
 
+  /// Loads the first unit of the split, e.g. the first stripe, if its IO size
+  /// is at most 'maxBytes' and fits under the max capacity of the query memory
+  /// pool. Returns the number of bytes loaded.
+  uint64_t preloadFirstUnit(uint64_t maxBytes);
+
   void setConnectorQueryCtx(const ConnectorQueryCtx* connectorQueryCtx);
 
   void setBucketConversion(std::vector<column_index_t> bucketChannels);
@@ -179,6 +190,12 @@ class SplitReader {
   // function.
   bool filterOnStats(dwio::common::RuntimeStatistics& runtimeStats) const;
 
+  /// Checks the filters, including the dynamic ones, against the partition
+  /// key values of the split. Returns false and sets 'emptySplit_' if they
+  /// can not match, so that the file is never opened. To be called before
+  /// createReader().
+  bool filterOnPartitionKeys(dwio::common::RuntimeStatistics& runtimeStats);
+
   /// Check if the hiveSplit_ is empty. The split is considered empty when
   ///   1) The data file is missing but the user chooses to ignore it
   ///   2) The file does not contain any rows
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/connectors/hive/SplitResultCache.h"
+
+namespace facebook::velox::connector::hive {
+
+std::shared_ptr<const SplitResult> SplitResultCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* entry = cache_.get(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  auto result = entry->result;
+  cache_.release(key);
+  return result;
+}
+
+void SplitResultCache::insert(
+    const std::string& key,
+    std::shared_ptr<const SplitResult> result) {
+  const auto bytes = result->bytes();
+  if (bytes > maxSplitBytes_) {
+    return;
+  }
+  auto entry = std::make_unique<Entry>(Entry{std::move(result)});
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, entry.get(), bytes + key.size())) {
+    entry.release();
+  }
+}
+
+SimpleLRUCacheStats SplitResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+SimpleLRUCacheStats SplitResultCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.maxSize());
+  return cache_.stats();
+}
+
+} // namespace facebook::velox::connector::hive
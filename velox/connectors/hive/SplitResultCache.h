@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/vector/TypeAliases.h"
+
+namespace facebook::velox::connector::hive {
+
+/// The output of a split, as the output batches of the data source serialized
+/// with the Presto serde.
+struct SplitResult {
+  struct Page {
+    /// Empty if the scan projects no columns.
+    std::string data;
+    vector_size_t numRows{0};
+  };
+
+  std::vector<Page> pages;
+
+  uint64_t bytes() const {
+    uint64_t bytes = 0;
+    for (const auto& page : pages) {
+      bytes += page.data.size();
+    }
+    return bytes;
+  }
+};
+
+/// Size-bounded LRU cache of split results, shared by the data sources of all
+/// queries of a connector. The key identifies the version of the file, the
+/// split range and everything of the scan that decides its output, so that a
+/// split scanned again with the same filters and projections is served without
+/// reading the file. The size of an entry is the size of its pages and key.
+/// Thread safe.
+class SplitResultCache {
+ public:
+  /// @param maxSplitBytes Maximum size of one entry.
+  SplitResultCache(uint64_t maxBytes, uint64_t maxSplitBytes)
+      : maxSplitBytes_(maxSplitBytes), cache_(maxBytes) {}
+
+  /// Returns the result of 'key', or nullptr if it is not cached.
+  std::shared_ptr<const SplitResult> find(const std::string& key);
+
+  /// Adds 'result' under 'key'. Evicts the least recently used entries to make
+  /// space. Does nothing if 'key' is already cached.
+  void insert(
+      const std::string& key,
+      std::shared_ptr<const SplitResult> result);
+
+  uint64_t maxSplitBytes() const {
+    return maxSplitBytes_;
+  }
+
+  SimpleLRUCacheStats stats() const;
+
+  /// Removes all entries and returns the stats after.
+  SimpleLRUCacheStats clear();
+
+ private:
+  struct Entry {
+    std::shared_ptr<const SplitResult> result;
+  };
+
+  const uint64_t maxSplitBytes_;
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, Entry> cache_;
+};
+
+} // namespace facebook::velox::connector::hive
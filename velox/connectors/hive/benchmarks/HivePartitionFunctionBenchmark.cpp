@@ -16,6 +16,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/connectors/hive/PartitionIdGenerator.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/type/Type.h"
 #include "velox/vector/ComplexVector.h"
@@ -27,6 +28,7 @@ DEFINE_int64(fuzzer_seed, 99887766, "Seed for random input dataset generator");
 using namespace facebook::velox;
 using namespace facebook::velox::test;
 using connector::hive::HivePartitionFunction;
+using connector::hive::PartitionIdGenerator;
 
 namespace {
 
@@ -68,6 +70,16 @@ class HivePartitionFunctionBenchmark
     // Prepare HivePartitionFunction
     fewBucketsFunction_ = createHivePartitionFunction(20);
     manyBucketsFunction_ = createHivePartitionFunction(100);
+    hugeBucketsFunction_ = createHivePartitionFunction(10'000);
+
+    // Nearly every row of the fuzzed keys is a distinct partition.
+    for (auto typeKind : {TypeKind::BIGINT, TypeKind::VARCHAR}) {
+      partitionIdGenerators_[typeKind] = std::make_unique<PartitionIdGenerator>(
+          asRowType(rowVectors_[typeKind]->type()),
+          std::vector<column_index_t>{0},
+          vectorSize,
+          pool());
+    }
 
     partitions_.resize(vectorSize);
   }
@@ -82,6 +94,18 @@ class HivePartitionFunctionBenchmark
     run<KIND>(manyBucketsFunction_.get());
   }
 
+  template <TypeKind KIND>
+  void runHuge() {
+    run<KIND>(hugeBucketsFunction_.get());
+  }
+
+  // Maps the keys to dynamic partition ids. After the first run, all
+  // partitions exist and every row is a lookup.
+  template <TypeKind KIND>
+  void runPartitionIds() {
+    partitionIdGenerators_.at(KIND)->run(rowVectors_[KIND], partitionIds_);
+  }
+
  private:
   std::unique_ptr<HivePartitionFunction> createHivePartitionFunction(
       size_t bucketCount) {
@@ -105,7 +129,11 @@ class HivePartitionFunctionBenchmark
   std::unordered_map<TypeKind, RowVectorPtr> rowVectors_;
   std::unique_ptr<HivePartitionFunction> fewBucketsFunction_;
   std::unique_ptr<HivePartitionFunction> manyBucketsFunction_;
+  std::unique_ptr<HivePartitionFunction> hugeBucketsFunction_;
+  std::unordered_map<TypeKind, std::unique_ptr<PartitionIdGenerator>>
+      partitionIdGenerators_;
   std::vector<uint32_t> partitions_;
+  raw_vector<uint64_t> partitionIds_;
 };
 
 std::unique_ptr<HivePartitionFunctionBenchmark> benchmarkFew;
@@ -199,6 +227,14 @@ BENCHMARK_RELATIVE(bigintManyRowsManyBuckets) {
   benchmarkMany->runMany<TypeKind::BIGINT>();
 }
 
+BENCHMARK_RELATIVE(bigintManyRowsHugeBuckets) {
+  benchmarkMany->runHuge<TypeKind::BIGINT>();
+}
+
+BENCHMARK_RELATIVE(bigintManyRowsPartitionIds) {
+  benchmarkMany->runPartitionIds<TypeKind::BIGINT>();
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(realFewRowsFewBuckets) {
@@ -253,6 +289,14 @@ BENCHMARK_RELATIVE(varcharManyRowsManyBuckets) {
   benchmarkMany->runMany<TypeKind::VARCHAR>();
 }
 
+BENCHMARK_RELATIVE(varcharManyRowsHugeBuckets) {
+  benchmarkMany->runHuge<TypeKind::VARCHAR>();
+}
+
+BENCHMARK_RELATIVE(varcharManyRowsPartitionIds) {
+  benchmarkMany->runPartitionIds<TypeKind::VARCHAR>();
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(timestampFewRowsFewBuckets) {
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include <algorithm>
+
+#include "velox/connectors/hive/BufferedInputBuilder.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+
+bool isSupportedKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+void appendBigints(const DecodedVector& decoded, EqualityDeletes& deletes) {
+  for (vector_size_t i = 0; i < decoded.size(); ++i) {
+    if (decoded.isNullAt(i)) {
+      deletes.hasNull = true;
+    } else {
+      deletes.bigints.push_back(decoded.valueAt<T>(i));
+    }
+  }
+}
+
+void appendStrings(const DecodedVector& decoded, EqualityDeletes& deletes) {
+  for (vector_size_t i = 0; i < decoded.size(); ++i) {
+    if (decoded.isNullAt(i)) {
+      deletes.hasNull = true;
+    } else {
+      deletes.strings.push_back(std::string(decoded.valueAt<StringView>(i)));
+    }
+  }
+}
+
+} // namespace
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStatistics,
+    const std::shared_ptr<IoStats>& ioStats,
+    const std::string& connectorId)
+    : deleteFile_(deleteFile), pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile_.content == FileContent::kEqualityDeletes);
+
+  deleteSplit_ = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile_.filePath,
+      deleteFile_.fileFormat,
+      0,
+      deleteFile_.fileSizeInBytes);
+
+  // The delete file schema is the projection of the table schema on the
+  // equality columns, so the columns are read with the file schema.
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      hiveConfig,
+      connectorQueryCtx,
+      /*fileSchema=*/nullptr,
+      deleteSplit_,
+      /*tableParameters=*/{},
+      deleteReaderOpts);
+
+  const FileHandleKey fileHandleKey{
+      .filename = deleteFile_.filePath,
+      .tokenProvider = connectorQueryCtx->fsTokenProvider()};
+  auto deleteFileHandleCachePtr = fileHandleFactory->generate(fileHandleKey);
+  auto deleteFileInput = BufferedInputBuilder::getInstance()->create(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStatistics,
+      ioStats,
+      executor);
+
+  deleteReader_ =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+}
+
+std::unique_ptr<EqualityDeletes> EqualityDeleteFileReader::readDeletes() {
+  const auto& fileType = deleteReader_->rowType();
+  VELOX_CHECK_EQ(
+      fileType->size(),
+      deleteFile_.equalityFieldIds.size(),
+      "Iceberg equality delete file {} must have one column per equality "
+      "field id",
+      deleteFile_.filePath);
+  if (fileType->size() != 1) {
+    VELOX_NYI(
+        "Iceberg equality delete files on more than one column are not "
+        "supported: {}",
+        deleteFile_.filePath);
+  }
+
+  auto deletes = std::make_unique<EqualityDeletes>();
+  deletes->columnName = fileType->nameOf(0);
+  deletes->kind = fileType->childAt(0)->kind();
+  if (!isSupportedKind(deletes->kind)) {
+    VELOX_NYI(
+        "Iceberg equality deletes on {} columns are not supported",
+        fileType->childAt(0)->toString());
+  }
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addField(deletes->columnName, 0);
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      {},
+      scanSpec,
+      nullptr,
+      fileType,
+      deleteSplit_,
+      nullptr,
+      nullptr,
+      nullptr,
+      deleteRowReaderOpts);
+  auto rowReader = deleteReader_->createRowReader(deleteRowReaderOpts);
+
+  VectorPtr output = BaseVector::create(fileType, 0, pool_);
+  DecodedVector decoded;
+  constexpr uint64_t kBatchSize = 10'000;
+  while (rowReader->next(kBatchSize, output) > 0) {
+    const auto* rowVector = output->asChecked<RowVector>();
+    if (rowVector->size() == 0) {
+      continue;
+    }
+    decoded.decode(*rowVector->childAt(0));
+    switch (deletes->kind) {
+      case TypeKind::TINYINT:
+        appendBigints<int8_t>(decoded, *deletes);
+        break;
+      case TypeKind::SMALLINT:
+        appendBigints<int16_t>(decoded, *deletes);
+        break;
+      case TypeKind::INTEGER:
+        appendBigints<int32_t>(decoded, *deletes);
+        break;
+      case TypeKind::BIGINT:
+        appendBigints<int64_t>(decoded, *deletes);
+        break;
+      default:
+        appendStrings(decoded, *deletes);
+        break;
+    }
+  }
+  return deletes;
+}
+
+// static
+std::unique_ptr<common::Filter> EqualityDeleteFileReader::makeFilter(
+    const std::vector<const EqualityDeletes*>& deletes) {
+  VELOX_CHECK(!deletes.empty());
+  const auto kind = deletes[0]->kind;
+  const bool isString =
+      kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+  bool hasNull = false;
+  std::vector<int64_t> bigints;
+  std::vector<std::string> strings;
+  for (const auto* fileDeletes : deletes) {
+    VELOX_CHECK_EQ(fileDeletes->columnName, deletes[0]->columnName);
+    VELOX_CHECK_EQ(
+        fileDeletes->kind == TypeKind::VARCHAR ||
+            fileDeletes->kind == TypeKind::VARBINARY,
+        isString,
+        "Iceberg equality delete files on column {} have different types",
+        fileDeletes->columnName);
+    hasNull |= fileDeletes->hasNull;
+    bigints.insert(
+        bigints.end(),
+        fileDeletes->bigints.begin(),
+        fileDeletes->bigints.end());
+    strings.insert(
+        strings.end(),
+        fileDeletes->strings.begin(),
+        fileDeletes->strings.end());
+  }
+
+  // Rows where the column is null are deleted if any delete row is null.
+  const bool nullAllowed = !hasNull;
+  if (!isString) {
+    std::sort(bigints.begin(), bigints.end());
+    bigints.erase(std::unique(bigints.begin(), bigints.end()), bigints.end());
+    return common::createNegatedBigintValues(bigints, nullAllowed);
+  }
+  if (strings.empty()) {
+    if (nullAllowed) {
+      return std::make_unique<common::AlwaysTrue>();
+    }
+    return std::make_unique<common::IsNotNull>();
+  }
+  return std::make_unique<common::NegatedBytesValues>(strings, nullAllowed);
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Map.h>
+#include <memory>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The decoded rows of an equality delete file on a single column.
+struct EqualityDeletes {
+  /// Name of the equality column.
+  std::string columnName;
+
+  /// Kind of the equality column in the delete file.
+  TypeKind kind;
+
+  /// Deleted values of integer columns.
+  std::vector<int64_t> bigints;
+
+  /// Deleted values of VARCHAR and VARBINARY columns.
+  std::vector<std::string> strings;
+
+  /// True if the delete file deletes the rows where the column is null.
+  bool hasNull{false};
+};
+
+/// Decoded equality delete files and the filters built from them, shared by
+/// the splits of a data source. The splits of a scan read the same snapshot,
+/// so a delete file is read and a filter is built once per data source.
+struct EqualityDeleteCache {
+  /// Decoded delete files keyed by delete file path.
+  folly::F14FastMap<std::string, std::shared_ptr<const EqualityDeletes>>
+      deleteFiles;
+
+  /// Filters keyed by the column name followed by the paths of the delete
+  /// files the filter is built from.
+  folly::F14FastMap<std::string, std::shared_ptr<common::Filter>> filters;
+};
+
+/// Reads an equality delete file. Per the Iceberg V2 spec, a row of the base
+/// data is deleted if its values of the equality columns are equal to the
+/// values of any row of the delete file, where null is equal to null.
+///
+/// Only delete files on a single column are supported. The deletes are
+/// applied as a negated IN filter on the column, so that the selective column
+/// readers skip the deleted rows without decoding the other columns. The
+/// delete file columns are matched to the table columns by name.
+class EqualityDeleteFileReader {
+ public:
+  /// Opens the delete file.
+  ///
+  /// @param deleteFile Metadata about the delete file.
+  /// @param fileHandleFactory Factory for creating file handles.
+  /// @param connectorQueryCtx Query context providing memory pool, session
+  ///   properties, and filesystem token.
+  /// @param executor Executor for async I/O operations.
+  /// @param hiveConfig Hive connector configuration.
+  /// @param ioStatistics Shared I/O statistics counters.
+  /// @param ioStats Shared I/O stats tracker.
+  /// @param connectorId Connector ID for constructing the internal split.
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStatistics,
+      const std::shared_ptr<IoStats>& ioStats,
+      const std::string& connectorId);
+
+  /// Reads all rows of the delete file.
+  std::unique_ptr<EqualityDeletes> readDeletes();
+
+  /// Returns a filter on the equality column that is false for the rows
+  /// deleted by 'deletes'. All of 'deletes' must be on the same column.
+  static std::unique_ptr<common::Filter> makeFilter(
+      const std::vector<const EqualityDeletes*>& deletes);
+
+ private:
+  const IcebergDeleteFile deleteFile_;
+  memory::MemoryPool* const pool_;
+
+  std::unique_ptr<dwio::common::Reader> deleteReader_;
+  std::shared_ptr<HiveConnectorSplit> deleteSplit_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -32,4 +32,10 @@ std::string IcebergConfig::functionPrefix() const {
       kFunctionPrefixConfig, kDefaultFunctionPrefix);
 }
 
+uint64_t IcebergConfig::positionalDeleteCacheMaxBytes() const {
+  return config::toCapacity(
+      config_->get<std::string>(kPositionalDeleteCacheMaxBytes, "0B"),
+      config::CapacityUnit::BYTE);
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
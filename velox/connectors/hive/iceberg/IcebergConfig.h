@@ -35,6 +35,12 @@ class IcebergConfig {
   /// connector config override is provided.
   static constexpr const char* kDefaultFunctionPrefix = "$internal$.iceberg.";
 
+  /// Maximum total size in bytes of the decoded positional delete files that
+  /// are cached by the connector across splits and queries. 0 disables the
+  /// cache.
+  static constexpr const char* kPositionalDeleteCacheMaxBytes =
+      "positional-delete-cache-max-bytes";
+
   explicit IcebergConfig(
       const std::shared_ptr<const config::ConfigBase>& config);
 
@@ -44,6 +50,8 @@ class IcebergConfig {
 
   std::string functionPrefix() const;
 
+  uint64_t positionalDeleteCacheMaxBytes() const;
+
  private:
   const std::shared_ptr<const config::ConfigBase> config_;
 };
@@ -44,7 +44,16 @@ IcebergConnector::IcebergConnector(
     std::shared_ptr<const config::ConfigBase> config,
     folly::Executor* ioExecutor)
     : HiveConnector(id, config, ioExecutor),
-      icebergConfig_(std::make_shared<IcebergConfig>(connectorConfig())) {
+      icebergConfig_(std::make_shared<IcebergConfig>(connectorConfig())),
+      positionalDeleteCache_(
+          icebergConfig_->positionalDeleteCacheMaxBytes() > 0
+              ? std::make_unique<PositionalDeleteCache>(
+                    std::make_unique<SimpleLRUCache<
+                        PositionalDeleteCacheKey,
+                        PositionalDeletes>>(
+                        icebergConfig_->positionalDeleteCacheMaxBytes()),
+                    std::make_unique<PositionalDeletesGenerator>())
+              : nullptr) {
   registerIcebergInternalFunctions(icebergConfig_->functionPrefix());
 }
 
@@ -60,7 +69,8 @@ std::unique_ptr<DataSource> IcebergConnector::createDataSource(
       &fileHandleFactory_,
       ioExecutor_,
       connectorQueryCtx,
-      hiveConfig_);
+      hiveConfig_,
+      positionalDeleteCache_.get());
 }
 
 std::unique_ptr<DataSink> IcebergConnector::createDataSink(
@@ -17,6 +17,7 @@
 
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/iceberg/IcebergConfig.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
 
 namespace facebook::velox::connector::hive::iceberg {
 
@@ -62,8 +63,25 @@ class IcebergConnector final : public HiveConnector {
       ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy) override;
 
+  /// Returns the stats of the cache of decoded positional delete files. Empty
+  /// if the cache is disabled.
+  SimpleLRUCacheStats positionalDeleteCacheStats() {
+    return positionalDeleteCache_ ? positionalDeleteCache_->cacheStats()
+                                  : SimpleLRUCacheStats{};
+  }
+
+  /// Clears the unpinned entries of the cache of decoded positional delete
+  /// files and returns the stats after clearing.
+  SimpleLRUCacheStats clearPositionalDeleteCache() {
+    return positionalDeleteCache_ ? positionalDeleteCache_->clearCache()
+                                  : SimpleLRUCacheStats{};
+  }
+
  private:
   const std::shared_ptr<IcebergConfig> icebergConfig_;
+  // Decoded positional delete files shared by the splits of all queries.
+  // nullptr if IcebergConfig::kPositionalDeleteCacheMaxBytes is 0.
+  const std::unique_ptr<PositionalDeleteCache> positionalDeleteCache_;
 };
 
 class IcebergConnectorFactory final : public ConnectorFactory {
@@ -27,7 +27,8 @@ IcebergDataSource::IcebergDataSource(
     FileHandleFactory* fileHandleFactory,
     folly::Executor* ioExecutor,
     const ConnectorQueryCtx* connectorQueryCtx,
-    const std::shared_ptr<HiveConfig>& hiveConfig)
+    const std::shared_ptr<HiveConfig>& hiveConfig,
+    PositionalDeleteCache* positionalDeleteCache)
     : HiveDataSource(
           outputType,
           tableHandle,
@@ -35,7 +36,8 @@ IcebergDataSource::IcebergDataSource(
           fileHandleFactory,
           ioExecutor,
           connectorQueryCtx,
-          hiveConfig) {}
+          hiveConfig),
+      positionalDeleteCache_(positionalDeleteCache) {}
 
 std::unique_ptr<SplitReader> IcebergDataSource::createSplitReader() {
   return std::make_unique<IcebergSplitReader>(
@@ -49,7 +51,9 @@ std::unique_ptr<SplitReader> IcebergDataSource::createSplitReader() {
       ioStats_,
       fileHandleFactory_,
       ioExecutor_,
-      scanSpec_);
+      scanSpec_,
+      positionalDeleteCache_,
+      &equalityDeleteCache_);
 }
 
 } // namespace facebook::velox::connector::hive::iceberg
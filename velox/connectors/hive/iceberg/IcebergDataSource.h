@@ -16,6 +16,8 @@
 #pragma once
 
 #include "velox/connectors/hive/HiveDataSource.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
 
 namespace facebook::velox::connector::hive::iceberg {
 
@@ -35,7 +37,8 @@ class IcebergDataSource : public HiveDataSource {
       FileHandleFactory* fileHandleFactory,
       folly::Executor* ioExecutor,
       const ConnectorQueryCtx* connectorQueryCtx,
-      const std::shared_ptr<HiveConfig>& hiveConfig);
+      const std::shared_ptr<HiveConfig>& hiveConfig,
+      PositionalDeleteCache* positionalDeleteCache = nullptr);
 
  protected:
   /// Creates an IcebergSplitReader for reading Iceberg data files.
@@ -44,6 +47,13 @@ class IcebergDataSource : public HiveDataSource {
   /// this method creates an IcebergSplitReader that handles Iceberg-specific
   /// features like positional delete files and schema evolution.
   std::unique_ptr<SplitReader> createSplitReader() override;
+
+ private:
+  PositionalDeleteCache* const positionalDeleteCache_;
+
+  // Equality delete files and filters shared by the splits of this data
+  // source.
+  EqualityDeleteCache equalityDeleteCache_;
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -39,7 +39,9 @@ IcebergSplitReader::IcebergSplitReader(
     const std::shared_ptr<IoStats>& ioStats,
     FileHandleFactory* const fileHandleFactory,
     folly::Executor* executor,
-    const std::shared_ptr<common::ScanSpec>& scanSpec)
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    PositionalDeleteCache* positionalDeleteCache,
+    EqualityDeleteCache* equalityDeleteCache)
     : SplitReader(
           hiveSplit,
           hiveTableHandle,
@@ -52,18 +54,35 @@ IcebergSplitReader::IcebergSplitReader(
           fileHandleFactory,
           executor,
           scanSpec),
+      positionalDeleteCache_(positionalDeleteCache),
+      equalityDeleteCache_(equalityDeleteCache),
       baseReadOffset_(0),
       splitOffset_(0),
       deleteBitmap_(nullptr) {}
 
+IcebergSplitReader::~IcebergSplitReader() {
+  if (equalityDeleteFields_.empty()) {
+    return;
+  }
+  for (auto& field : equalityDeleteFields_) {
+    field.spec->setFilter(std::move(field.filter));
+    field.spec->setConstantValue(std::move(field.constantValue));
+  }
+  scanSpec_->resetCachedValues(false);
+}
+
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats,
     const folly::F14FastMap<std::string, std::string>& fileReadOps) {
+  if (!filterOnPartitionKeys(runtimeStats)) {
+    return;
+  }
   createReader();
   if (emptySplit_) {
     return;
   }
+  applyEqualityDeletes();
   auto rowType = getAdaptedRowType();
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
@@ -113,14 +132,118 @@ void IcebergSplitReader::prepareSplit(
                 ioStats_,
                 runtimeStats,
                 splitOffset_,
-                hiveSplit_->connectorId));
+                hiveSplit_->connectorId,
+                positionalDeleteCache_));
       }
-    } else {
+    } else if (deleteFile.content != FileContent::kEqualityDeletes) {
       VELOX_NYI();
     }
   }
 }
 
+void IcebergSplitReader::applyEqualityDeletes() {
+  auto icebergSplit = checkedPointerCast<const HiveIcebergSplit>(hiveSplit_);
+  EqualityDeleteCache splitCache;
+  auto& cache = equalityDeleteCache_ ? *equalityDeleteCache_ : splitCache;
+
+  // The delete files of each equality column and the key of their filter in
+  // the cache.
+  std::vector<std::pair<std::string, std::vector<const EqualityDeletes*>>>
+      columnDeletes;
+  folly::F14FastMap<std::string, size_t> columnIndices;
+  std::vector<std::shared_ptr<const EqualityDeletes>> decodedDeletes;
+  for (const auto& deleteFile : icebergSplit->deleteFiles) {
+    if (deleteFile.content != FileContent::kEqualityDeletes ||
+        deleteFile.recordCount == 0) {
+      continue;
+    }
+    auto deletes = getEqualityDeletes(deleteFile, cache);
+    auto [it, inserted] =
+        columnIndices.emplace(deletes->columnName, columnDeletes.size());
+    if (inserted) {
+      columnDeletes.push_back({deletes->columnName, {}});
+    }
+    auto& [filterKey, fileDeletes] = columnDeletes[it->second];
+    filterKey.push_back('\0');
+    filterKey.append(deleteFile.filePath);
+    fileDeletes.push_back(deletes.get());
+    decodedDeletes.push_back(std::move(deletes));
+  }
+
+  const auto& tableSchema = baseReaderOpts_.fileSchema();
+  for (const auto& [filterKey, fileDeletes] : columnDeletes) {
+    auto& filter = cache.filters[filterKey];
+    if (filter == nullptr) {
+      filter = EqualityDeleteFileReader::makeFilter(fileDeletes);
+    }
+    const auto& columnName = fileDeletes[0]->columnName;
+    auto* childSpec = scanSpec_->childByName(columnName);
+    if (childSpec == nullptr) {
+      // The column is not read by the query. Reads it only to filter and
+      // makes it a null constant again when the split is done.
+      VELOX_USER_CHECK(
+          tableSchema && tableSchema->containsChild(columnName),
+          "Iceberg equality delete column {} is not a table column",
+          columnName);
+      childSpec = scanSpec_->getOrCreateChild(columnName);
+      childSpec->setConstantValue(
+          BaseVector::createNullConstant(
+              tableSchema->findChild(columnName),
+              1,
+              connectorQueryCtx_->memoryPool()));
+    }
+    auto& field = equalityDeleteFields_.emplace_back(
+        EqualityDeleteField{
+            childSpec, nullptr, childSpec->constantValue(), filter});
+    childSpec->setConstantValue(nullptr);
+    setEqualityDeleteFilter(field);
+  }
+}
+
+// static
+void IcebergSplitReader::setEqualityDeleteFilter(EqualityDeleteField& field) {
+  const auto* queryFilter = field.spec->filter();
+  if (queryFilter) {
+    field.filter = queryFilter->clone();
+    field.spec->setFilter(queryFilter->mergeWith(field.deleteFilter.get()));
+  } else {
+    field.filter = nullptr;
+    field.spec->setFilter(field.deleteFilter);
+  }
+}
+
+void IcebergSplitReader::moveAdaptationFrom(common::ScanSpec& other) {
+  // Puts the query filters back so that they, not the delete filters, are
+  // replaced by the adapted filters of 'other'.
+  for (auto& field : equalityDeleteFields_) {
+    field.spec->setFilter(std::move(field.filter));
+  }
+  SplitReader::moveAdaptationFrom(other);
+  for (auto& field : equalityDeleteFields_) {
+    setEqualityDeleteFilter(field);
+  }
+  scanSpec_->resetCachedValues(false);
+}
+
+std::shared_ptr<const EqualityDeletes> IcebergSplitReader::getEqualityDeletes(
+    const IcebergDeleteFile& deleteFile,
+    EqualityDeleteCache& cache) {
+  auto& deletes = cache.deleteFiles[deleteFile.filePath];
+  if (deletes == nullptr) {
+    EqualityDeleteFileReader reader(
+        deleteFile,
+        fileHandleFactory_,
+        connectorQueryCtx_,
+        ioExecutor_,
+        hiveConfig_,
+        ioStatistics_,
+        ioStats_,
+        hiveSplit_->connectorId);
+    deletes = reader.readDeletes();
+  }
+  return deletes;
+}
+
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -37,9 +38,13 @@ class IcebergSplitReader : public SplitReader {
       const std::shared_ptr<IoStats>& ioStats,
       FileHandleFactory* fileHandleFactory,
       folly::Executor* executor,
-      const std::shared_ptr<common::ScanSpec>& scanSpec);
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      PositionalDeleteCache* positionalDeleteCache = nullptr,
+      EqualityDeleteCache* equalityDeleteCache = nullptr);
 
-  ~IcebergSplitReader() override = default;
+  /// Restores the filters of the ScanSpec that were changed to apply equality
+  /// deletes. The ScanSpec is shared by the splits of the data source.
+  ~IcebergSplitReader() override;
 
   void prepareSplit(
       std::shared_ptr<common::MetadataFilter> metadataFilter,
@@ -49,7 +54,36 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  /// Keeps the equality delete filters of this split on top of the adapted
+  /// query filters moved from 'other'.
+  void moveAdaptationFrom(common::ScanSpec& other) override;
+
  private:
+  // The state of a field of the ScanSpec before a filter for equality deletes
+  // is set on it, and that filter.
+  struct EqualityDeleteField {
+    common::ScanSpec* spec;
+    std::shared_ptr<common::Filter> filter;
+    VectorPtr constantValue;
+    std::shared_ptr<common::Filter> deleteFilter;
+  };
+
+  // Saves the query filter of 'field' and replaces it with the query filter
+  // merged with the delete filter.
+  static void setEqualityDeleteFilter(EqualityDeleteField& field);
+
+  // Sets filters on the equality columns of the equality delete files of the
+  // split, so that the column readers skip the deleted rows. Must be called
+  // before adaptColumns(), which may change the constant values of the
+  // fields.
+  void applyEqualityDeletes();
+
+  // Returns the decoded equality delete file, reading it if it is not in
+  // 'cache'.
+  std::shared_ptr<const EqualityDeletes> getEqualityDeletes(
+      const IcebergDeleteFile& deleteFile,
+      EqualityDeleteCache& cache);
+
   /// Adapts the data file schema to match the table schema expected by the
   /// query.
   ///
@@ -93,6 +127,14 @@ class IcebergSplitReader : public SplitReader {
       const RowTypePtr& fileType,
       const RowTypePtr& tableSchema) const override;
 
+  // Cache of decoded positional delete files shared across splits. nullptr if
+  // disabled.
+  PositionalDeleteCache* const positionalDeleteCache_;
+  // Equality delete files and filters shared with the other splits of the
+  // data source. nullptr if not shared.
+  EqualityDeleteCache* const equalityDeleteCache_;
+  // Fields of 'scanSpec_' with filters for equality deletes.
+  std::vector<EqualityDeleteField> equalityDeleteFields_;
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+void PositionalDeletes::add(std::string_view dataFilePath, int64_t position) {
+  if (lastPositions_ == nullptr || dataFilePath != lastDataFilePath_) {
+    lastDataFilePath_ = std::string(dataFilePath);
+    lastPositions_ = &positions_[lastDataFilePath_];
+  }
+  lastPositions_->push_back(position);
+}
+
+void PositionalDeletes::finish() {
+  lastDataFilePath_.clear();
+  lastPositions_ = nullptr;
+  bytes_ = sizeof(*this);
+  for (auto& [dataFilePath, positions] : positions_) {
+    // Positions are sorted per data file by the Iceberg spec but a writer may
+    // produce several sorted runs.
+    if (!std::is_sorted(positions.begin(), positions.end())) {
+      std::sort(positions.begin(), positions.end());
+    }
+    positions.shrink_to_fit();
+    bytes_ += sizeof(dataFilePath) + dataFilePath.size() + sizeof(positions) +
+        positions.size() * sizeof(int64_t);
+  }
+}
+
+const std::vector<int64_t>* PositionalDeletes::find(
+    const std::string& dataFilePath) const {
+  auto it = positions_.find(dataFilePath);
+  return it == positions_.end() ? nullptr : &it->second;
+}
+
+std::unique_ptr<PositionalDeletes> PositionalDeletesGenerator::operator()(
+    const PositionalDeleteCacheKey& /*key*/,
+    const PositionalDeleteLoader* loader,
+    void* /*stats*/) {
+  VELOX_CHECK_NOT_NULL(loader);
+  return loader->load();
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
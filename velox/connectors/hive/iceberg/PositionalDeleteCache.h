@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/caching/CachedFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// Identifies the content of a positional delete file. Iceberg delete files
+/// are immutable, so the path together with the file size identifies a
+/// version of the file.
+struct PositionalDeleteCacheKey {
+  std::string filePath;
+  uint64_t fileSizeInBytes;
+
+  bool operator==(const PositionalDeleteCacheKey& other) const {
+    return fileSizeInBytes == other.fileSizeInBytes &&
+        filePath == other.filePath;
+  }
+};
+
+/// The decoded content of one positional delete file: the deleted row
+/// positions of each data file the delete file refers to.
+class PositionalDeletes {
+ public:
+  /// Adds the deleted row position 'position' of the data file 'dataFilePath'.
+  void add(std::string_view dataFilePath, int64_t position);
+
+  /// Sorts the positions of each data file and computes the memory usage.
+  /// Must be called after the last add().
+  void finish();
+
+  /// Returns the ascending deleted row positions of 'dataFilePath', or nullptr
+  /// if the delete file has no positions for it.
+  const std::vector<int64_t>* find(const std::string& dataFilePath) const;
+
+  /// Returns the approximate memory usage in bytes.
+  uint64_t bytes() const {
+    return bytes_;
+  }
+
+ private:
+  // Node map so that 'lastPositions_' stays valid when the map grows.
+  folly::F14NodeMap<std::string, std::vector<int64_t>> positions_;
+
+  // Positions of the data file of the last add() call. Delete files are
+  // sorted by data file path, so most calls do not look up 'positions_'.
+  std::string lastDataFilePath_;
+  std::vector<int64_t>* lastPositions_{nullptr};
+
+  uint64_t bytes_{0};
+};
+
+struct PositionalDeletesSizer {
+  uint64_t operator()(const PositionalDeletes& deletes) const {
+    return deletes.bytes();
+  }
+};
+
+/// Reads a positional delete file on a cache miss. Passed as the properties
+/// of PositionalDeleteCache::generate() since reading needs the query context
+/// of the split that misses.
+struct PositionalDeleteLoader {
+  std::function<std::unique_ptr<PositionalDeletes>()> load;
+};
+
+class PositionalDeletesGenerator {
+ public:
+  std::unique_ptr<PositionalDeletes> operator()(
+      const PositionalDeleteCacheKey& key,
+      const PositionalDeleteLoader* loader,
+      void* stats);
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
+
+namespace std {
+template <>
+struct hash<
+    facebook::velox::connector::hive::iceberg::PositionalDeleteCacheKey> {
+  size_t operator()(
+      const facebook::velox::connector::hive::iceberg::PositionalDeleteCacheKey&
+          key) const noexcept {
+    return facebook::velox::bits::hashMix(
+        std::hash<std::string>()(key.filePath), key.fileSizeInBytes);
+  }
+};
+} // namespace std
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// Process-wide cache of decoded positional delete files, shared by the
+/// splits of all queries of an Iceberg connector. A split whose delete file is
+/// cached applies the deletes without reading the file. The size of an entry
+/// is the memory of its positions, and least recently used entries are evicted
+/// when the cache exceeds its capacity. Entries in use by splits are pinned.
+using PositionalDeleteCache = CachedFactory<
+    PositionalDeleteCacheKey,
+    PositionalDeletes,
+    PositionalDeletesGenerator,
+    PositionalDeleteLoader,
+    void,
+    PositionalDeletesSizer>;
+
+using PositionalDeletesCachedPtr =
+    CachedPtr<PositionalDeleteCacheKey, PositionalDeletes>;
+
+} // namespace facebook::velox::connector::hive::iceberg
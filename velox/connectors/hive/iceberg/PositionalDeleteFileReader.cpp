@@ -22,6 +22,7 @@
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/dwio/common/ReaderFactory.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::connector::hive::iceberg {
 
@@ -36,7 +37,8 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     const std::shared_ptr<IoStats>& ioStats,
     dwio::common::RuntimeStatistics& runtimeStats,
     uint64_t splitOffset,
-    const std::string& connectorId)
+    const std::string& connectorId,
+    PositionalDeleteCache* deleteCache)
     : deleteFile_(deleteFile),
       baseFilePath_(baseFilePath),
       fileHandleFactory_(fileHandleFactory),
@@ -57,14 +59,6 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
   VELOX_CHECK(deleteFile_.content == FileContent::kPositionalDeletes);
   VELOX_CHECK(deleteFile_.recordCount);
 
-  // Create the ScanSpec for this delete file
-  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
-  scanSpec->addField(posColumn_->name, 0);
-  auto* pathSpec = scanSpec->getOrCreateChild(filePathColumn_->name);
-  pathSpec->setFilter(
-      std::make_unique<common::BytesValues>(
-          std::vector<std::string>({baseFilePath_}), false));
-
   // Create the file schema (in RowType) and split that will be used by readers
   std::vector<std::string> deleteColumnNames(
       {filePathColumn_->name, posColumn_->name});
@@ -80,32 +74,30 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       0,
       deleteFile_.fileSizeInBytes);
 
-  // Create the Reader and RowReader
-
-  dwio::common::ReaderOptions deleteReaderOpts(pool_);
-  configureReaderOptions(
-      hiveConfig_,
-      connectorQueryCtx,
-      deleteFileSchema,
-      deleteSplit_,
-      /*tableParameters=*/{},
-      deleteReaderOpts);
+  // Delete files whose positions cannot fit in the cache are read without it,
+  // so that only the positions of the base file are read.
+  if (deleteCache != nullptr &&
+      deleteFile_.recordCount * sizeof(int64_t) <=
+          static_cast<uint64_t>(deleteCache->maxSize())) {
+    PositionalDeleteLoader loader{[&]() {
+      return loadPositionalDeletes(deleteFileSchema);
+    }};
+    cachedDeletes_ = deleteCache->generate(
+        {deleteFile_.filePath, deleteFile_.fileSizeInBytes}, &loader);
+    cachedPositions_ = cachedDeletes_->find(baseFilePath_);
+    deleteSplit_.reset();
+    return;
+  }
 
-  const FileHandleKey fileHandleKey{
-      .filename = deleteFile_.filePath,
-      .tokenProvider = connectorQueryCtx_->fsTokenProvider()};
-  auto deleteFileHandleCachePtr = fileHandleFactory_->generate(fileHandleKey);
-  auto deleteFileInput = BufferedInputBuilder::getInstance()->create(
-      *deleteFileHandleCachePtr,
-      deleteReaderOpts,
-      connectorQueryCtx,
-      ioStatistics_,
-      ioStats_,
-      executor_);
+  // Create the ScanSpec for this delete file
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addField(posColumn_->name, 0);
+  auto* pathSpec = scanSpec->getOrCreateChild(filePathColumn_->name);
+  pathSpec->setFilter(
+      std::make_unique<common::BytesValues>(
+          std::vector<std::string>({baseFilePath_}), false));
 
-  auto deleteReader =
-      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
-          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+  auto deleteReader = createDeleteReader(deleteFileSchema);
 
   // Check if the whole delete file split can be skipped. This could happen when
   // 1) the delete file doesn't contain the base file that is being read; 2) The
@@ -127,6 +119,43 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     return;
   }
 
+  deleteRowReader_ =
+      createDeleteRowReader(*deleteReader, scanSpec, deleteFileSchema);
+}
+
+std::unique_ptr<dwio::common::Reader>
+PositionalDeleteFileReader::createDeleteReader(
+    const RowTypePtr& deleteFileSchema) {
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      hiveConfig_,
+      connectorQueryCtx_,
+      deleteFileSchema,
+      deleteSplit_,
+      /*tableParameters=*/{},
+      deleteReaderOpts);
+
+  const FileHandleKey fileHandleKey{
+      .filename = deleteFile_.filePath,
+      .tokenProvider = connectorQueryCtx_->fsTokenProvider()};
+  auto deleteFileHandleCachePtr = fileHandleFactory_->generate(fileHandleKey);
+  auto deleteFileInput = BufferedInputBuilder::getInstance()->create(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx_,
+      ioStatistics_,
+      ioStats_,
+      executor_);
+
+  return dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+      ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+}
+
+std::unique_ptr<dwio::common::RowReader>
+PositionalDeleteFileReader::createDeleteRowReader(
+    dwio::common::Reader& deleteReader,
+    const std::shared_ptr<common::ScanSpec>& scanSpec,
+    const RowTypePtr& deleteFileSchema) {
   dwio::common::RowReaderOptions deleteRowReaderOpts;
   configureRowReaderOptions(
       {},
@@ -138,15 +167,53 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       nullptr,
       nullptr,
       deleteRowReaderOpts);
+  return deleteReader.createRowReader(deleteRowReaderOpts);
+}
 
-  deleteRowReader_.reset();
-  deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
+std::unique_ptr<PositionalDeletes>
+PositionalDeleteFileReader::loadPositionalDeletes(
+    const RowTypePtr& deleteFileSchema) {
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addField(filePathColumn_->name, 0);
+  scanSpec->addField(posColumn_->name, 1);
+
+  auto deleteReader = createDeleteReader(deleteFileSchema);
+  auto rowReader =
+      createDeleteRowReader(*deleteReader, scanSpec, deleteFileSchema);
+
+  auto deletes = std::make_unique<PositionalDeletes>();
+  VectorPtr output = BaseVector::create(deleteFileSchema, 0, pool_);
+  DecodedVector filePaths;
+  DecodedVector positions;
+  constexpr uint64_t kBatchSize = 10'000;
+  while (rowReader->next(kBatchSize, output) > 0) {
+    const auto* rowVector = output->asChecked<RowVector>();
+    if (rowVector->size() == 0) {
+      continue;
+    }
+    filePaths.decode(*rowVector->childAt(0));
+    positions.decode(*rowVector->childAt(1));
+    VELOX_CHECK(
+        !filePaths.mayHaveNulls() && !positions.mayHaveNulls(),
+        "Iceberg delete file file_path and pos columns cannot have nulls");
+    for (vector_size_t i = 0; i < rowVector->size(); ++i) {
+      const auto filePath = filePaths.valueAt<StringView>(i);
+      deletes->add(filePath, positions.valueAt<int64_t>(i));
+    }
+  }
+  deletes->finish();
+  return deletes;
 }
 
 void PositionalDeleteFileReader::readDeletePositions(
     uint64_t baseReadOffset,
     uint64_t size,
     BufferPtr deleteBitmapBuffer) {
+  if (cachedDeletes_.get() != nullptr) {
+    updateDeleteBitmapFromCache(baseReadOffset, size, deleteBitmapBuffer);
+    return;
+  }
+
   // We are going to read to the row number up to the end of the batch. For the
   // same base file, the deleted rows are in ascending order in the same delete
   // file. rowNumberUpperBound is the upperbound for the row number in this
@@ -212,11 +279,48 @@ void PositionalDeleteFileReader::readDeletePositions(
 }
 
 bool PositionalDeleteFileReader::noMoreData() {
+  if (cachedDeletes_.get() != nullptr) {
+    return cachedPositions_ == nullptr ||
+        cachedPositionsOffset_ >= cachedPositions_->size();
+  }
   return totalNumRowsScanned_ >= deleteFile_.recordCount &&
       deletePositionsOutput_ &&
       deletePositionsOffset_ >= deletePositionsOutput_->size();
 }
 
+void PositionalDeleteFileReader::updateDeleteBitmapFromCache(
+    uint64_t baseReadOffset,
+    uint64_t size,
+    BufferPtr deleteBitmapBuffer) {
+  if (cachedPositions_ == nullptr) {
+    return;
+  }
+  const auto& positions = *cachedPositions_;
+  const int64_t rowNumberLowerBound = splitOffset_ + baseReadOffset;
+  const int64_t rowNumberUpperBound = rowNumberLowerBound + size;
+
+  // The first batch of a split that does not start at the beginning of the
+  // file skips the positions of the earlier splits.
+  auto begin = std::lower_bound(
+      positions.begin() + cachedPositionsOffset_,
+      positions.end(),
+      rowNumberLowerBound);
+  auto end = std::lower_bound(begin, positions.end(), rowNumberUpperBound);
+  cachedPositionsOffset_ = end - positions.begin();
+  if (begin == end) {
+    return;
+  }
+
+  auto* deleteBitmap = deleteBitmapBuffer->asMutable<uint8_t>();
+  for (auto it = begin; it != end; ++it) {
+    bits::setBit(deleteBitmap, *it - rowNumberLowerBound);
+  }
+  deleteBitmapBuffer->setSize(
+      std::max<uint64_t>(
+          deleteBitmapBuffer->size(),
+          bits::nbytes(*(end - 1) + 1 - rowNumberLowerBound)));
+}
+
 void PositionalDeleteFileReader::updateDeleteBitmap(
     VectorPtr deletePositionsVector,
     uint64_t baseReadOffset,
@@ -25,6 +25,7 @@
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
 #include "velox/dwio/common/Reader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -43,6 +44,11 @@ namespace facebook::velox::connector::hive::iceberg {
 /// Positions from the delete file that fall within the current batch range are
 /// converted to bitmap bits. Leftover positions beyond the current batch are
 /// preserved and carried over to the next readDeletePositions() call.
+///
+/// If a PositionalDeleteCache is given, the positions of all data files in the
+/// delete file are read once and cached, and readers of the other splits that
+/// refer to the same delete file look up the positions of their data file in
+/// the cache instead of reading the file.
 class PositionalDeleteFileReader {
  public:
   /// Constructs a reader for a single positional delete file.
@@ -69,6 +75,8 @@ class PositionalDeleteFileReader {
   ///   data file. Delete positions are absolute within the file, so this offset
   ///   is used to translate them to split-relative positions.
   /// @param connectorId Connector ID for constructing the internal split.
+  /// @param deleteCache Cache of decoded delete files shared across splits.
+  ///   nullptr reads the positions of 'baseFilePath' from the file.
   PositionalDeleteFileReader(
       const IcebergDeleteFile& deleteFile,
       const std::string& baseFilePath,
@@ -80,7 +88,8 @@ class PositionalDeleteFileReader {
       const std::shared_ptr<IoStats>& ioStats,
       dwio::common::RuntimeStatistics& runtimeStats,
       uint64_t splitOffset,
-      const std::string& connectorId);
+      const std::string& connectorId,
+      PositionalDeleteCache* deleteCache = nullptr);
 
   /// Reads delete positions for the current batch and sets corresponding bits
   /// in the deletion bitmap.
@@ -106,6 +115,28 @@ class PositionalDeleteFileReader {
   bool noMoreData();
 
  private:
+  // Opens the delete file with the file schema 'deleteFileSchema'.
+  std::unique_ptr<dwio::common::Reader> createDeleteReader(
+      const RowTypePtr& deleteFileSchema);
+
+  // Creates a row reader of 'deleteReader' that reads 'scanSpec'.
+  std::unique_ptr<dwio::common::RowReader> createDeleteRowReader(
+      dwio::common::Reader& deleteReader,
+      const std::shared_ptr<common::ScanSpec>& scanSpec,
+      const RowTypePtr& deleteFileSchema);
+
+  // Reads the positions of all data files from the delete file. Called on a
+  // miss in the PositionalDeleteCache.
+  std::unique_ptr<PositionalDeletes> loadPositionalDeletes(
+      const RowTypePtr& deleteFileSchema);
+
+  // Sets the bits of the cached positions of the base file in
+  // [splitOffset + baseReadOffset, splitOffset + baseReadOffset + size).
+  void updateDeleteBitmapFromCache(
+      uint64_t baseReadOffset,
+      uint64_t size,
+      BufferPtr deleteBitmapBuffer);
+
   // Converts delete positions from deletePositionsVector into set bits in the
   // deleteBitmapBuffer for positions within
   // [splitOffset + baseReadOffset, rowNumberUpperBound).
@@ -154,6 +185,17 @@ class PositionalDeleteFileReader {
   // Total number of rows read from this delete file, including rows filtered
   // out by the file_path filter. Used to detect end-of-file.
   uint64_t totalNumRowsScanned_;
+
+  // The delete file from the PositionalDeleteCache and the ascending positions
+  // of the base file in it. If 'cachedDeletes_' is set, the positions are not
+  // read by 'deleteRowReader_'. 'cachedPositions_' is nullptr if the delete
+  // file has no positions for the base file.
+  PositionalDeletesCachedPtr cachedDeletes_;
+  const std::vector<int64_t>* cachedPositions_{nullptr};
+
+  // Index of the first position in 'cachedPositions_' not yet converted into
+  // bitmap bits.
+  size_t cachedPositionsOffset_{0};
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
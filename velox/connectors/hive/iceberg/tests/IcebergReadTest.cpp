@@ -20,6 +20,7 @@
 #include "velox/common/encode/Base64.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/IcebergConfig.h"
 #include "velox/connectors/hive/iceberg/IcebergConnector.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
@@ -775,6 +776,211 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
   assertMultipleSplits({1000, 9000, 20000}, 1, 0, 20000, 3);
 }
 
+TEST_F(HiveIcebergTest, positionalDeleteCache) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  connector::unregisterConnector(kIcebergConnectorId);
+  IcebergConnectorFactory icebergFactory;
+  connector::registerConnector(icebergFactory.newConnector(
+      kIcebergConnectorId,
+      std::make_shared<config::ConfigBase>(
+          std::unordered_map<std::string, std::string>{
+              {IcebergConfig::kPositionalDeleteCacheMaxBytes, "1MB"}}),
+      ioExecutor_.get()));
+  auto* icebergConnector = dynamic_cast<IcebergConnector*>(
+      connector::getConnector(kIcebergConnectorId).get());
+  ASSERT_NE(icebergConnector, nullptr);
+
+  // One delete file with unsorted runs of positions for two data files, each
+  // read in 3 splits. The delete file is read once and the other splits hit
+  // the cache.
+  std::unordered_map<
+      std::string,
+      std::multimap<std::string, std::vector<int64_t>>>
+      deleteFilesForBaseDatafiles = {
+          {"delete_file_1",
+           {{"data_file_1", {0, 1, 99, 10'000, 19'999}},
+            {"data_file_1", {5, 6, 15'000}},
+            {"data_file_2", makeRandomIncreasingValues(0, 20'000)}}}};
+  assertPositionalDeletes(
+      {{"data_file_1", {10'000, 10'000}}, {"data_file_2", {20'000}}},
+      deleteFilesForBaseDatafiles,
+      0,
+      3);
+  const auto stats = icebergConnector->positionalDeleteCacheStats();
+  ASSERT_GE(stats.numLookups, 2);
+  ASSERT_GT(stats.numHits, 0);
+  ASSERT_EQ(stats.numElements, 1);
+  ASSERT_GT(stats.curSize, 0);
+
+  assertMultipleSplits(makeRandomIncreasingValues(0, 20'000), 10, 3);
+  assertMultipleSplits({}, 10, 3);
+  assertSingleBaseFileMultipleDeleteFiles(
+      {makeContinuousIncreasingValues(0, 10'000),
+       makeContinuousIncreasingValues(10'000, 20'000),
+       makeRandomIncreasingValues(5'000, 15'000)});
+}
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto dataFile1 = TempFilePath::create();
+  writeToFile(
+      dataFile1->getPath(),
+      {makeRowVector(
+          rowType->names(),
+          {makeNullableFlatVector<int64_t>(
+               {1, 2, 3, std::nullopt, 5, 6, 7, 8}),
+           makeFlatVector<std::string>(
+               {"a", "b", "c", "d", "e", "f", "g", "h"})})});
+  auto dataFile2 = TempFilePath::create();
+  writeToFile(
+      dataFile2->getPath(),
+      {makeRowVector(
+          rowType->names(),
+          {makeNullableFlatVector<int64_t>({2, std::nullopt, 9}),
+           makeFlatVector<std::string>({"a", "x", "y"})})});
+
+  std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths;
+  std::vector<IcebergDeleteFile> deleteFiles;
+  auto addDeleteFile = [&](const RowVectorPtr& deletes, int32_t fieldId) {
+    auto path = TempFilePath::create();
+    writeToFile(path->getPath(), {deletes});
+    deleteFiles.emplace_back(
+        FileContent::kEqualityDeletes,
+        path->getPath(),
+        fileFomat_,
+        deletes->size(),
+        testing::internal::GetFileSize(
+            std::fopen(path->getPath().c_str(), "r")),
+        std::vector<int32_t>{fieldId});
+    deleteFilePaths.push_back(std::move(path));
+  };
+  // Two delete files on c0, one of which deletes the nulls, and one on c1.
+  addDeleteFile(
+      makeRowVector({"c0"}, {makeFlatVector<int64_t>({2, 5, 100})}), 1);
+  addDeleteFile(
+      makeRowVector(
+          {"c0"}, {makeNullableFlatVector<int64_t>({std::nullopt, 7})}),
+      1);
+  addDeleteFile(
+      makeRowVector({"c1"}, {makeFlatVector<std::string>({"a", "zz"})}), 2);
+
+  // The second data file has no deletes, so the filters of the ScanSpec must
+  // be restored after the split of the first. The third split reuses the
+  // decoded delete files and the filters.
+  std::vector<std::shared_ptr<ConnectorSplit>> splits;
+  auto addSplits = [&](const std::string& path,
+                       const std::vector<IcebergDeleteFile>& fileDeletes) {
+    auto fileSplits = makeIcebergSplits(path, fileDeletes);
+    splits.insert(splits.end(), fileSplits.begin(), fileSplits.end());
+  };
+  addSplits(dataFile1->getPath(), deleteFiles);
+  addSplits(dataFile2->getPath(), {});
+  addSplits(dataFile1->getPath(), deleteFiles);
+
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .connectorId(kIcebergConnectorId)
+                  .outputType(rowType)
+                  .endTableScan()
+                  .planNode();
+  AssertQueryBuilder(plan).splits(splits).assertResults(makeRowVector(
+      rowType->names(),
+      {makeNullableFlatVector<int64_t>(
+           {3, 6, 8, 2, std::nullopt, 9, 3, 6, 8}),
+       makeFlatVector<std::string>(
+           {"c", "f", "h", "a", "x", "y", "c", "f", "h"})}));
+
+  // The delete column c0 is not projected.
+  plan = PlanBuilder()
+             .startTableScan()
+             .connectorId(kIcebergConnectorId)
+             .outputType(ROW({"c1"}, {VARCHAR()}))
+             .dataColumns(rowType)
+             .endTableScan()
+             .planNode();
+  AssertQueryBuilder(plan).splits(splits).assertResults(
+      makeRowVector(
+          {"c1"},
+          {makeFlatVector<std::string>(
+              {"c", "f", "h", "a", "x", "y", "c", "f", "h"})}));
+
+  // The deletes are merged with the filter of the query.
+  plan = PlanBuilder()
+             .startTableScan()
+             .connectorId(kIcebergConnectorId)
+             .outputType(rowType)
+             .subfieldFilter("c0 > 3")
+             .endTableScan()
+             .planNode();
+  AssertQueryBuilder(plan).splits(splits).assertResults(makeRowVector(
+      rowType->names(),
+      {makeFlatVector<int64_t>({6, 8, 9, 6, 8}),
+       makeFlatVector<std::string>({"f", "h", "y", "f", "h"})}));
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesWithSplitPreload) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto dataFile = TempFilePath::create();
+  writeToFile(
+      dataFile->getPath(),
+      {makeRowVector(
+          rowType->names(), {makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6})})});
+
+  std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths;
+  auto makeDeleteFile = [&](const std::vector<int64_t>& values) {
+    auto deletes = makeRowVector({"c0"}, {makeFlatVector<int64_t>(values)});
+    auto path = TempFilePath::create();
+    writeToFile(path->getPath(), {deletes});
+    IcebergDeleteFile deleteFile(
+        FileContent::kEqualityDeletes,
+        path->getPath(),
+        fileFomat_,
+        deletes->size(),
+        testing::internal::GetFileSize(
+            std::fopen(path->getPath().c_str(), "r")),
+        std::vector<int32_t>{1});
+    deleteFilePaths.push_back(std::move(path));
+    return deleteFile;
+  };
+  auto deletes1 = makeDeleteFile({2, 5});
+  auto deletes2 = makeDeleteFile({3, 6});
+
+  // Consecutive splits have different delete files. A preloaded split must
+  // keep its own delete filter when the adapted filters of the previous split
+  // move to it.
+  std::vector<std::shared_ptr<ConnectorSplit>> splits;
+  for (const auto& deleteFiles :
+       std::vector<std::vector<IcebergDeleteFile>>{
+           {deletes1}, {deletes2}, {}, {deletes1}}) {
+    auto fileSplits = makeIcebergSplits(dataFile->getPath(), deleteFiles);
+    splits.insert(splits.end(), fileSplits.begin(), fileSplits.end());
+  }
+
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .connectorId(kIcebergConnectorId)
+                  .outputType(rowType)
+                  .subfieldFilter("c0 > 1")
+                  .endTableScan()
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "2")
+          .splits(splits)
+          .assertResults(makeRowVector(
+              rowType->names(),
+              {makeFlatVector<int64_t>(
+                  {3, 4, 6, 2, 4, 5, 2, 3, 4, 5, 6, 3, 4, 6})}));
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_GT(
+      planStats.at(plan->id()).customStats.at("preloadedSplits").sum, 0);
+}
+
 TEST_F(HiveIcebergTest, schemaEvolutionRemoveColumn) {
   auto oldRowType = ROW({"c0", "c1", "c2"}, {BIGINT(), INTEGER(), VARCHAR()});
   auto newRowType = ROW({"c0", "c2"}, {BIGINT(), VARCHAR()});
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/paimon/PaimonMergeReader.h"
+
+#include <algorithm>
+
+#include "velox/connectors/hive/paimon/PaimonRowKind.h"
+#include "velox/exec/OperatorUtils.h"
+
+namespace facebook::velox::connector::hive::paimon {
+
+PaimonSortedRunStream::PaimonSortedRunStream(
+    std::unique_ptr<PaimonSortedRun> run,
+    int32_t priority,
+    const std::vector<column_index_t>& keyChannels)
+    : run_(std::move(run)), priority_(priority), keyChannels_(keyChannels) {
+  VELOX_CHECK_NOT_NULL(run_);
+  nextBatch();
+}
+
+int32_t PaimonSortedRunStream::compare(const MergeStream& other) const {
+  const auto& otherStream = static_cast<const PaimonSortedRunStream&>(other);
+  for (const auto channel : keyChannels_) {
+    const auto result = batch_->childAt(channel)
+                            ->compare(
+                                otherStream.batch_->childAt(channel).get(),
+                                index_,
+                                otherStream.index_,
+                                CompareFlags{})
+                            .value();
+    if (result != 0) {
+      return result;
+    }
+  }
+  return priority_ - otherStream.priority_;
+}
+
+void PaimonSortedRunStream::pop() {
+  VELOX_CHECK(hasData());
+  if (++index_ >= batch_->size()) {
+    nextBatch();
+  }
+}
+
+void PaimonSortedRunStream::nextBatch() {
+  index_ = 0;
+  do {
+    batch_ = run_->next();
+  } while (batch_ != nullptr && batch_->size() == 0);
+  if (batch_ != nullptr) {
+    batch_->loadedVector();
+  }
+}
+
+PaimonMergeReader::PaimonMergeReader(
+    std::vector<std::unique_ptr<PaimonSortedRun>> runs,
+    std::vector<column_index_t> keyChannels,
+    std::optional<column_index_t> rowKindChannel,
+    RowTypePtr outputType,
+    memory::MemoryPool* pool)
+    : keyChannels_(std::move(keyChannels)),
+      rowKindChannel_(rowKindChannel),
+      outputType_(std::move(outputType)),
+      pool_(pool) {
+  VELOX_CHECK(!keyChannels_.empty(), "Merge-on-read requires a primary key");
+  if (runs.empty()) {
+    return;
+  }
+  std::vector<std::unique_ptr<PaimonSortedRunStream>> streams;
+  streams.reserve(runs.size());
+  for (auto i = 0; i < runs.size(); ++i) {
+    streams.push_back(
+        std::make_unique<PaimonSortedRunStream>(
+            std::move(runs[i]), i, keyChannels_));
+  }
+  tree_ = std::make_unique<TreeOfLosers<PaimonSortedRunStream>>(
+      std::move(streams));
+}
+
+RowVectorPtr PaimonMergeReader::next(vector_size_t maxRows) {
+  VELOX_CHECK_GT(maxRows, 0);
+  if (tree_ == nullptr) {
+    return nullptr;
+  }
+  output_ = BaseVector::create<RowVector>(outputType_, maxRows, pool_);
+  numOutputRows_ = 0;
+  while (numOutputRows_ + sources_.size() < maxRows) {
+    auto* stream = tree_->next();
+    if (stream == nullptr) {
+      if (candidate_.has_value()) {
+        addCandidate();
+      }
+      tree_.reset();
+      break;
+    }
+    if (candidate_.has_value() &&
+        !keysEqual(
+            *candidate_->batch,
+            candidate_->index,
+            *stream->batch(),
+            stream->index())) {
+      addCandidate();
+    }
+    // Rows with equal keys come in ascending priority, so the current row
+    // replaces the candidate of the same key.
+    candidate_ = Candidate{stream->batch(), stream->index(), stream};
+    if (stream->isLastRow()) {
+      // The added rows of the batch must be copied out before pop() replaces
+      // it.
+      flush();
+    }
+    stream->pop();
+  }
+  flush();
+
+  if (numOutputRows_ == 0) {
+    output_.reset();
+    return nullptr;
+  }
+  output_->resize(numOutputRows_);
+  return std::move(output_);
+}
+
+bool PaimonMergeReader::keysEqual(
+    const RowVector& batch,
+    vector_size_t index,
+    const RowVector& otherBatch,
+    vector_size_t otherIndex) const {
+  for (const auto channel : keyChannels_) {
+    if (!batch.childAt(channel)->equalValueAt(
+            otherBatch.childAt(channel).get(), index, otherIndex)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PaimonMergeReader::addCandidate() {
+  auto candidate = std::move(candidate_.value());
+  candidate_.reset();
+  if (rowKindChannel_.has_value()) {
+    const auto& rowKinds = candidate.batch->childAt(rowKindChannel_.value());
+    const auto rowKind = paimonRowKindFromValue(
+        rowKinds->asUnchecked<SimpleVector<int8_t>>()->valueAt(
+            candidate.index));
+    if (rowKind == PaimonRowKind::kUpdateBefore ||
+        rowKind == PaimonRowKind::kDelete) {
+      return;
+    }
+  }
+  sources_.push_back(candidate.batch.get());
+  sourceIndices_.push_back(candidate.index);
+  if (candidate.batch != candidate.stream->batch()) {
+    // The stream has moved past the batch of the candidate, which is released
+    // with 'candidate'.
+    flush();
+  }
+}
+
+void PaimonMergeReader::flush() {
+  if (sources_.empty()) {
+    return;
+  }
+  exec::gatherCopy(
+      output_.get(), numOutputRows_, sources_.size(), sources_, sourceIndices_);
+  numOutputRows_ += sources_.size();
+  sources_.clear();
+  sourceIndices_.clear();
+}
+
+// static
+std::vector<std::pair<std::string, std::shared_ptr<common::Filter>>>
+PaimonMergeReader::extractNonKeyFilters(
+    common::ScanSpec& scanSpec,
+    const std::vector<std::string>& keyColumns) {
+  std::vector<std::pair<std::string, std::shared_ptr<common::Filter>>> filters;
+  for (const auto& child : scanSpec.children()) {
+    if (std::find(
+            keyColumns.begin(), keyColumns.end(), child->fieldName()) !=
+        keyColumns.end()) {
+      continue;
+    }
+    if (child->filter() != nullptr) {
+      filters.emplace_back(child->fieldName(), child->filter()->clone());
+      child->setFilter(nullptr);
+    }
+    child->resetCachedValues(false);
+    if (child->hasFilter()) {
+      VELOX_NYI(
+          "Merge-on-read with a filter on a subfield of non-key column: {}",
+          child->fieldName());
+    }
+  }
+  scanSpec.resetCachedValues(false);
+  return filters;
+}
+
+} // namespace facebook::velox::connector::hive::paimon
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "velox/common/base/TreeOfLosers.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive::paimon {
+
+/// Produces the rows of one sorted run of a bucket: a level 0 file, or the
+/// files of a level 1+ in key order. The rows are sorted by the primary key
+/// columns and, within a key, by ascending sequence number.
+class PaimonSortedRun {
+ public:
+  virtual ~PaimonSortedRun() = default;
+
+  /// Returns the next batch of rows, or nullptr at the end of the run.
+  virtual RowVectorPtr next() = 0;
+};
+
+/// A sorted run being merged by PaimonMergeReader.
+class PaimonSortedRunStream : public MergeStream {
+ public:
+  /// @param run The run to read.
+  /// @param priority Rank of the run among the merged runs. Of the rows with
+  ///   equal keys, the row of the run with the highest priority is the latest.
+  /// @param keyChannels Channels of the primary key columns in the batches.
+  PaimonSortedRunStream(
+      std::unique_ptr<PaimonSortedRun> run,
+      int32_t priority,
+      const std::vector<column_index_t>& keyChannels);
+
+  bool hasData() const override {
+    return batch_ != nullptr;
+  }
+
+  /// Compares the keys of the current rows. Rows with equal keys are ordered
+  /// by ascending priority, so the latest row of a key is returned last.
+  int32_t compare(const MergeStream& other) const override;
+
+  const RowVectorPtr& batch() const {
+    return batch_;
+  }
+
+  vector_size_t index() const {
+    return index_;
+  }
+
+  bool isLastRow() const {
+    return index_ == batch_->size() - 1;
+  }
+
+  /// Advances to the next row.
+  void pop();
+
+ private:
+  // Loads the next non-empty batch of 'run_'. Sets 'batch_' to nullptr at the
+  // end of the run.
+  void nextBatch();
+
+  const std::unique_ptr<PaimonSortedRun> run_;
+  const int32_t priority_;
+  const std::vector<column_index_t>& keyChannels_;
+
+  RowVectorPtr batch_;
+  vector_size_t index_{0};
+};
+
+/// Merge-on-read of the sorted runs of a bucket of a primary-key table with
+/// the deduplicate merge engine. The runs are k-way merged on the primary key
+/// with a tree of losers, and of the rows with equal keys only the latest is
+/// kept. The key is dropped if the latest row is an UPDATE_BEFORE or DELETE.
+/// Without a row kind column every row is an INSERT.
+///
+/// The rows of the same key are read one after another, so there is no
+/// buffering beyond the current batch of each run.
+class PaimonMergeReader {
+ public:
+  /// @param runs The sorted runs of the bucket, from the oldest to the latest.
+  ///   Level 0 files are the latest, in ascending sequence number, followed by
+  ///   the higher levels in descending level order.
+  /// @param keyChannels Channels of the primary key columns in the batches.
+  /// @param rowKindChannel Channel of the row kind column, if the files have
+  ///   one.
+  /// @param outputType Type of the batches of the runs.
+  /// @param pool Memory pool for the merged batches.
+  PaimonMergeReader(
+      std::vector<std::unique_ptr<PaimonSortedRun>> runs,
+      std::vector<column_index_t> keyChannels,
+      std::optional<column_index_t> rowKindChannel,
+      RowTypePtr outputType,
+      memory::MemoryPool* pool);
+
+  /// Returns up to 'maxRows' merged rows, or nullptr when all runs are at end.
+  RowVectorPtr next(vector_size_t maxRows);
+
+  /// Prepares 'scanSpec' for reading the runs. A filter on a primary key
+  /// column is kept, so that the run readers skip the rows before the merge:
+  /// all versions of a key have the same key and are dropped together. A
+  /// filter on another column would drop the latest version of a key but not
+  /// an older one, so it is removed from 'scanSpec' and returned to be applied
+  /// to the merged rows, keyed by column name.
+  static std::vector<std::pair<std::string, std::shared_ptr<common::Filter>>>
+  extractNonKeyFilters(
+      common::ScanSpec& scanSpec,
+      const std::vector<std::string>& keyColumns);
+
+ private:
+  // The latest row seen for the current key.
+  struct Candidate {
+    RowVectorPtr batch;
+    vector_size_t index;
+    PaimonSortedRunStream* stream;
+  };
+
+  // Returns true if the keys of the rows are equal.
+  bool keysEqual(
+      const RowVector& batch,
+      vector_size_t index,
+      const RowVector& otherBatch,
+      vector_size_t otherIndex) const;
+
+  // Adds 'candidate_' to the output unless it retracts its key.
+  void addCandidate();
+
+  // Copies the added rows to 'output_'.
+  void flush();
+
+  const std::vector<column_index_t> keyChannels_;
+  const std::optional<column_index_t> rowKindChannel_;
+  const RowTypePtr outputType_;
+  memory::MemoryPool* const pool_;
+
+  std::unique_ptr<TreeOfLosers<PaimonSortedRunStream>> tree_;
+
+  std::optional<Candidate> candidate_;
+
+  // The rows added to the output and not yet copied to 'output_'.
+  std::vector<const RowVector*> sources_;
+  std::vector<vector_size_t> sourceIndices_;
+
+  RowVectorPtr output_;
+  vector_size_t numOutputRows_{0};
+};
+
+} // namespace facebook::velox::connector::hive::paimon
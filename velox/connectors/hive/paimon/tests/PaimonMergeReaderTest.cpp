@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/paimon/PaimonMergeReader.h"
+#include "velox/connectors/hive/paimon/PaimonRowKind.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::connector::hive::paimon;
+
+namespace {
+
+class TestSortedRun : public PaimonSortedRun {
+ public:
+  explicit TestSortedRun(std::vector<RowVectorPtr> batches)
+      : batches_(std::move(batches)) {}
+
+  RowVectorPtr next() override {
+    if (nextBatch_ >= batches_.size()) {
+      return nullptr;
+    }
+    return batches_[nextBatch_++];
+  }
+
+ private:
+  const std::vector<RowVectorPtr> batches_;
+  size_t nextBatch_{0};
+};
+
+class PaimonMergeReaderTest : public testing::Test,
+                              public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  // Returns a batch of (key, value, _rowkind) rows.
+  RowVectorPtr makeBatch(
+      const std::vector<int64_t>& keys,
+      const std::vector<std::string>& values,
+      const std::vector<PaimonRowKind>& rowKinds = {}) {
+    std::vector<int8_t> kinds;
+    for (auto i = 0; i < keys.size(); ++i) {
+      kinds.push_back(
+          static_cast<int8_t>(
+              rowKinds.empty() ? PaimonRowKind::kInsert : rowKinds[i]));
+    }
+    return makeRowVector(
+        {"k", "v", std::string(kRowKindColumn)},
+        {makeFlatVector<int64_t>(keys),
+         makeFlatVector<std::string>(values),
+         makeFlatVector<int8_t>(kinds)});
+  }
+
+  // Merges 'runs', from the oldest to the latest, and returns all merged rows.
+  RowVectorPtr merge(
+      std::vector<std::vector<RowVectorPtr>> runs,
+      vector_size_t batchSize,
+      bool withRowKind = true) {
+    std::vector<std::unique_ptr<PaimonSortedRun>> sortedRuns;
+    for (auto& batches : runs) {
+      sortedRuns.push_back(
+          std::make_unique<TestSortedRun>(std::move(batches)));
+    }
+    PaimonMergeReader reader(
+        std::move(sortedRuns),
+        {0},
+        withRowKind ? std::optional<column_index_t>(2) : std::nullopt,
+        rowType_,
+        pool());
+    auto result = BaseVector::create<RowVector>(rowType_, 0, pool());
+    while (auto batch = reader.next(batchSize)) {
+      EXPECT_LE(batch->size(), batchSize);
+      result->append(batch.get());
+    }
+    EXPECT_EQ(reader.next(batchSize), nullptr);
+    return result;
+  }
+
+  const RowTypePtr rowType_{
+      ROW({"k", "v", std::string(kRowKindColumn)},
+          {BIGINT(), VARCHAR(), TINYINT()})};
+};
+
+TEST_F(PaimonMergeReaderTest, latestRowWins) {
+  // Level 1 run split across two batches, then two level 0 files.
+  std::vector<std::vector<RowVectorPtr>> runs = {
+      {makeBatch({1, 2, 3}, {"a1", "b1", "c1"}),
+       makeBatch({4, 5}, {"d1", "e1"})},
+      {makeBatch({2, 4}, {"b2", "d2"})},
+      {makeBatch({4, 6}, {"d3", "f3"})},
+  };
+  const auto expected = makeBatch(
+      {1, 2, 3, 4, 5, 6}, {"a1", "b2", "c1", "d3", "e1", "f3"});
+  for (auto batchSize : {1, 2, 4, 100}) {
+    SCOPED_TRACE(fmt::format("batchSize {}", batchSize));
+    test::assertEqualVectors(expected, merge(runs, batchSize));
+  }
+}
+
+TEST_F(PaimonMergeReaderTest, rowKind) {
+  std::vector<std::vector<RowVectorPtr>> runs = {
+      {makeBatch({1, 2, 3, 4}, {"a1", "b1", "c1", "d1"})},
+      {makeBatch(
+          {1, 2, 2, 3},
+          {"a2", "b1", "b2", "c1"},
+          {PaimonRowKind::kDelete,
+           PaimonRowKind::kUpdateBefore,
+           PaimonRowKind::kUpdateAfter,
+           PaimonRowKind::kUpdateBefore})},
+      {makeBatch({1}, {"a3"})},
+  };
+  test::assertEqualVectors(
+      makeBatch(
+          {1, 2, 4},
+          {"a3", "b2", "d1"},
+          {PaimonRowKind::kInsert,
+           PaimonRowKind::kUpdateAfter,
+           PaimonRowKind::kInsert}),
+      merge(runs, 2));
+
+  // Without a row kind column every row is an insert.
+  runs = {
+      {makeBatch({1, 2}, {"a1", "b1"})},
+      {makeBatch({1}, {"a2"}, {PaimonRowKind::kDelete})},
+  };
+  auto expected = makeBatch({1, 2}, {"a2", "b1"});
+  expected->childAt(2) = makeFlatVector<int8_t>({3, 0});
+  test::assertEqualVectors(expected, merge(runs, 10, false));
+}
+
+TEST_F(PaimonMergeReaderTest, emptyRuns) {
+  EXPECT_EQ(merge({}, 10)->size(), 0);
+  EXPECT_EQ(merge({{}, {makeBatch({}, {})}}, 10)->size(), 0);
+
+  std::vector<std::vector<RowVectorPtr>> runs = {
+      {makeBatch({}, {}), makeBatch({1}, {"a1"}), makeBatch({}, {})},
+      {},
+      {makeBatch({1}, {"a2"}, {PaimonRowKind::kDelete})},
+  };
+  EXPECT_EQ(merge(runs, 10)->size(), 0);
+}
+
+TEST_F(PaimonMergeReaderTest, extractNonKeyFilters) {
+  common::ScanSpec scanSpec("<root>");
+  scanSpec.getOrCreateChild("k")
+      ->setFilter(std::make_shared<common::BigintRange>(1, 10, false));
+  scanSpec.getOrCreateChild("v")
+      ->setFilter(std::make_shared<common::BytesValues>(
+          std::vector<std::string>{"a"}, false));
+  scanSpec.getOrCreateChild(std::string(kRowKindColumn));
+
+  const auto filters =
+      PaimonMergeReader::extractNonKeyFilters(scanSpec, {"k"});
+  ASSERT_EQ(filters.size(), 1);
+  EXPECT_EQ(filters[0].first, "v");
+  EXPECT_TRUE(filters[0].second->testBytes("a", 1));
+  EXPECT_FALSE(filters[0].second->testBytes("b", 1));
+  EXPECT_NE(scanSpec.childByName("k")->filter(), nullptr);
+  EXPECT_EQ(scanSpec.childByName("v")->filter(), nullptr);
+  EXPECT_TRUE(scanSpec.hasFilter());
+}
+
+} // namespace
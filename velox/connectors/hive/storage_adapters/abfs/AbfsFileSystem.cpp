@@ -31,6 +31,7 @@ namespace facebook::velox::filesystems {
 AbfsFileSystem::AbfsFileSystem(std::shared_ptr<const config::ConfigBase> config)
     : FileSystem(config) {
   VELOX_CHECK_NOT_NULL(config.get());
+  readAhead_ = ReadAhead::create(*config, "fs.azure.");
 }
 
 std::string AbfsFileSystem::name() const {
@@ -42,7 +43,7 @@ std::unique_ptr<ReadFile> AbfsFileSystem::openFileForRead(
     const FileOptions& options) {
   auto abfsfile = std::make_unique<AbfsReadFile>(path, *config_);
   abfsfile->initialize(options);
-  return abfsfile;
+  return readAhead_->wrap(std::move(abfsfile));
 }
 
 std::unique_ptr<WriteFile> AbfsFileSystem::openFileForWrite(
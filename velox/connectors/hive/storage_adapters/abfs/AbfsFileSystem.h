@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/ReadAheadReadFile.h"
 
 namespace facebook::velox::filesystems {
 
@@ -74,6 +75,9 @@ class AbfsFileSystem : public FileSystem {
   void rmdir(std::string_view path) override {
     VELOX_UNSUPPORTED("rmdir for abfs not implemented");
   }
+
+ private:
+  std::unique_ptr<ReadAhead> readAhead_;
 };
 
 } // namespace facebook::velox::filesystems
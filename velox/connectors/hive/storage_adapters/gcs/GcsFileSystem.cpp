@@ -17,6 +17,7 @@
 #include "velox/connectors/hive/storage_adapters/gcs/GcsFileSystem.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/config/Config.h"
+#include "velox/common/file/ReadAheadReadFile.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/gcs/GcsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/gcs/GcsUtil.h"
@@ -74,7 +75,8 @@ class GcsFileSystem::Impl {
       : bucket_(bucket),
         hiveConfig_(
             std::make_shared<HiveConfig>(std::make_shared<config::ConfigBase>(
-                config->rawConfigsCopy()))) {}
+                config->rawConfigsCopy()))),
+        readAhead_(ReadAhead::create(*config, "hive.gcs.")) {}
 
   ~Impl() = default;
 
@@ -145,9 +147,14 @@ class GcsFileSystem::Impl {
     return client_;
   }
 
+  const ReadAhead& readAhead() const {
+    return *readAhead_;
+  }
+
  private:
   const std::string bucket_;
   const std::shared_ptr<HiveConfig> hiveConfig_;
+  const std::unique_ptr<ReadAhead> readAhead_;
   std::shared_ptr<gcs::Client> client_;
 };
 
@@ -168,7 +175,7 @@ std::unique_ptr<ReadFile> GcsFileSystem::openFileForRead(
   const auto gcspath = gcsPath(path);
   auto gcsfile = std::make_unique<GcsReadFile>(gcspath, impl_->getClient());
   gcsfile->initialize(options);
-  return gcsfile;
+  return impl_->readAhead().wrap(std::move(gcsfile));
 }
 
 std::unique_ptr<WriteFile> GcsFileSystem::openFileForWrite(
@@ -15,6 +15,7 @@
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include "velox/common/config/Config.h"
+#include "velox/common/file/ReadAheadReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsWriteFile.h"
 #include "velox/external/hdfs/ArrowHdfsInternal.h"
@@ -26,10 +27,13 @@ std::string_view HdfsFileSystem::kViewfsScheme("viewfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(
       const config::ConfigBase* config,
-      const HdfsServiceEndpoint& endpoint) {
+      const HdfsServiceEndpoint& endpoint)
+      : readAhead_(
+            config != nullptr ? ReadAhead::create(*config, "hive.hdfs.")
+                              : std::make_unique<ReadAhead>(
+                                    0, ReadAheadReadFile::Options{})) {
     auto status = filesystems::arrow::io::internal::ConnectLibHdfs(&driver_);
     if (!status.ok()) {
       LOG(ERROR) << "ConnectLibHdfs failed due to: " << status.ToString();
@@ -90,7 +94,12 @@ class HdfsFileSystem::Impl {
     return driver_;
   }
 
+  const ReadAhead& readAhead() const {
+    return *readAhead_;
+  }
+
  private:
+  const std::unique_ptr<ReadAhead> readAhead_;
   hdfsFS hdfsClient_;
   filesystems::arrow::io::internal::LibHdfsShim* driver_;
   bool closed_ = false;
@@ -117,8 +126,9 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
       path.remove_prefix(index);
     }
   }
-  return std::make_unique<HdfsReadFile>(
-      impl_->hdfsShim(), impl_->hdfsClient(), path);
+  return impl_->readAhead().wrap(
+      std::make_unique<HdfsReadFile>(
+          impl_->hdfsShim(), impl_->hdfsClient(), path));
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
@@ -143,12 +143,24 @@ void registerS3Metrics() {
   DEFINE_METRIC(kMetricS3StartedUploads, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3FailedUploads, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3SuccessfulUploads, velox::StatType::COUNT);
+  DEFINE_METRIC(kMetricS3UploadedBytes, velox::StatType::SUM);
+  // Tracks the part upload throughput in range of [0, 2000] MB/s with 100
+  // buckets and reports P50, P90, P99, and P100.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricS3UploadPartThroughputMBps, 20, 0, 2'000, 50, 90, 99, 100);
   DEFINE_METRIC(kMetricS3MetadataCalls, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3GetObjectCalls, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3GetObjectErrors, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3GetMetadataErrors, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3GetObjectRetries, velox::StatType::COUNT);
   DEFINE_METRIC(kMetricS3GetMetadataRetries, velox::StatType::COUNT);
+  // Tracks the getObject latency. A quantile stat, since the tail of S3
+  // latencies is far above the median.
+  DEFINE_QUANTILE_STAT(
+      kMetricS3GetObjectLatencyUs,
+      velox::statTypes(velox::StatType::AVG, velox::StatType::COUNT),
+      velox::percentiles(0.5, 0.9, 0.99, 1.0),
+      velox::slidingWindowsSeconds(60));
 #endif
 }
 
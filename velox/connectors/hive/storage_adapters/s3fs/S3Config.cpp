@@ -87,4 +87,26 @@ std::optional<std::string> S3Config::endpointRegion() const {
   return region;
 }
 
+uint32_t S3Config::readParallelism() const {
+  const auto value = folly::to<uint32_t>(
+      config_.find(Keys::kReadParallelism)->second.value());
+  VELOX_USER_CHECK_GT(value, 0, "S3 read parallelism must be positive");
+  return value;
+}
+
+uint64_t S3Config::readPartSize() const {
+  const auto value = config::toCapacity(
+      config_.find(Keys::kReadPartSize)->second.value(),
+      config::CapacityUnit::BYTE);
+  VELOX_USER_CHECK_GT(value, 0, "S3 read part size must be positive");
+  return value;
+}
+
+uint32_t S3Config::maxInflightUploads() const {
+  const auto value = folly::to<uint32_t>(
+      config_.find(Keys::kMaxInflightUploads)->second.value());
+  VELOX_USER_CHECK_GT(value, 0, "S3 max inflight uploads must be positive");
+  return value;
+}
+
 } // namespace facebook::velox::filesystems
@@ -77,6 +77,11 @@ class S3Config {
     kUseProxyFromEnv,
     kCredentialsProvider,
     kIMDSEnabled,
+    kReadThreads,
+    kReadParallelism,
+    kReadPartSize,
+    kUploadThreads,
+    kMaxInflightUploads,
     kEnd
   };
 
@@ -116,6 +121,12 @@ class S3Config {
             {Keys::kCredentialsProvider,
              std::make_pair("aws-credentials-provider", std::nullopt)},
             {Keys::kIMDSEnabled, std::make_pair("aws-imds-enabled", "true")},
+            {Keys::kReadThreads, std::make_pair("read-threads", "0")},
+            {Keys::kReadParallelism, std::make_pair("read-parallelism", "4")},
+            {Keys::kReadPartSize, std::make_pair("read-part-size", "8MB")},
+            {Keys::kUploadThreads, std::make_pair("upload-threads", "0")},
+            {Keys::kMaxInflightUploads,
+             std::make_pair("max-inflight-uploads", "4")},
         };
     return config;
   }
@@ -251,6 +262,29 @@ class S3Config {
     return folly::to<bool>(value);
   }
 
+  /// Number of threads of the file system for parallel ranged reads. If 0,
+  /// reads are issued as a single GET on the calling thread.
+  uint32_t readThreads() const {
+    auto value = config_.find(Keys::kReadThreads)->second.value();
+    return folly::to<uint32_t>(value);
+  }
+
+  /// Maximum number of concurrent GETs of a single read.
+  uint32_t readParallelism() const;
+
+  /// Size of the parts a large read is split into for parallel GETs.
+  uint64_t readPartSize() const;
+
+  /// Number of threads of the file system for multipart uploads. If 0, parts
+  /// are uploaded synchronously by the writer.
+  uint32_t uploadThreads() const {
+    auto value = config_.find(Keys::kUploadThreads)->second.value();
+    return folly::to<uint32_t>(value);
+  }
+
+  /// Maximum number of part uploads in flight per written file.
+  uint32_t maxInflightUploads() const;
+
  private:
   std::unordered_map<Keys, std::optional<std::string>> config_;
   std::string payloadSigningPolicy_;
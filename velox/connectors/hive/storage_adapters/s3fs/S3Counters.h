@@ -31,6 +31,13 @@ constexpr std::string_view kMetricS3SuccessfulUploads{
 // The number of S3 upload calls that failed.
 constexpr std::string_view kMetricS3FailedUploads{"velox.s3_failed_uploads"};
 
+// The number of bytes uploaded by S3 part uploads.
+constexpr std::string_view kMetricS3UploadedBytes{"velox.s3_uploaded_bytes"};
+
+// The throughput of S3 part uploads in MB/s.
+constexpr std::string_view kMetricS3UploadPartThroughputMBps{
+    "velox.s3_upload_part_throughput_mbps"};
+
 // The number of S3 head (metadata) calls.
 constexpr std::string_view kMetricS3MetadataCalls{"velox.s3_metadata_calls"};
 
@@ -53,4 +60,8 @@ constexpr std::string_view kMetricS3GetObjectErrors{
 constexpr std::string_view kMetricS3GetObjectRetries{
     "velox.s3_get_object_retries"};
 
+// The latency of S3 getObject calls in microseconds, including retries.
+constexpr std::string_view kMetricS3GetObjectLatencyUs{
+    "velox.s3_get_object_latency_us"};
+
 } // namespace facebook::velox::filesystems
@@ -26,6 +26,8 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -302,10 +304,27 @@ class S3FileSystem::Impl {
 
     client_ = std::make_shared<Aws::S3::S3Client>(
         credentialsProvider, nullptr /* endpointProvider */, clientConfig);
+
+    if (s3Config.readThreads() > 0) {
+      readExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          s3Config.readThreads(),
+          std::make_shared<folly::NamedThreadFactory>("S3Read"));
+      readParallelism_ = s3Config.readParallelism();
+      readPartSize_ = s3Config.readPartSize();
+    }
+    if (s3Config.uploadThreads() > 0) {
+      uploadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          s3Config.uploadThreads(),
+          std::make_shared<folly::NamedThreadFactory>("S3Upload"));
+      maxInflightUploads_ = s3Config.maxInflightUploads();
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    // The reads and uploads in flight use 'client_'.
+    readExecutor_.reset();
+    uploadExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -439,6 +458,30 @@ class S3FileSystem::Impl {
     return client_.get();
   }
 
+  // Returns the executor of parallel ranged reads, or nullptr if reads are
+  // issued on the calling thread.
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
+  uint32_t readParallelism() const {
+    return readParallelism_;
+  }
+
+  uint64_t readPartSize() const {
+    return readPartSize_;
+  }
+
+  // Returns the executor of part uploads, or nullptr if parts are uploaded
+  // synchronously by the writer.
+  folly::Executor* uploadExecutor() const {
+    return uploadExecutor_.get();
+  }
+
+  uint32_t maxInflightUploads() const {
+    return maxInflightUploads_;
+  }
+
   std::string getLogLevelName() const {
     return getAwsInstance()->getLogLevelName();
   }
@@ -449,6 +492,11 @@ class S3FileSystem::Impl {
 
  private:
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> readExecutor_;
+  uint32_t readParallelism_{1};
+  uint64_t readPartSize_{0};
+  std::unique_ptr<folly::IOThreadPoolExecutor> uploadExecutor_;
+  uint32_t maxInflightUploads_{1};
 };
 
 S3FileSystem::S3FileSystem(
@@ -471,7 +519,12 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file = std::make_unique<S3ReadFile>(path, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      path,
+      impl_->s3Client(),
+      impl_->readExecutor(),
+      impl_->readParallelism(),
+      impl_->readPartSize());
   s3file->initialize(options);
   return s3file;
 }
@@ -480,8 +533,12 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view s3Path,
     const FileOptions& options) {
   const auto path = getPath(s3Path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(path, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      path,
+      impl_->s3Client(),
+      options.pool,
+      impl_->uploadExecutor(),
+      impl_->maxInflightUploads());
   return s3file;
 }
 
@@ -15,10 +15,15 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3ReadFile.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Counters.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
+
 #include <aws/core/Aws.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/GetObjectRequest.h>
@@ -38,11 +43,23 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
 
 } // namespace
 
-class S3ReadFile ::Impl {
+class S3ReadFile ::Impl : public std::enable_shared_from_this<Impl> {
  public:
-  explicit Impl(std::string_view path, Aws::S3::S3Client* client)
-      : client_(client) {
+  Impl(
+      std::string_view path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor,
+      uint32_t readParallelism,
+      uint64_t readPartSize)
+      : client_(client),
+        executor_(executor),
+        readParallelism_(readParallelism),
+        readPartSize_(readPartSize) {
     getBucketAndKeyFromPath(path, bucket_, key_);
+    if (executor_ != nullptr) {
+      VELOX_CHECK_GT(readParallelism_, 0);
+      VELOX_CHECK_GT(readPartSize_, 0);
+    }
   }
 
   // Gets the length of the file.
@@ -80,7 +97,7 @@ class S3ReadFile ::Impl {
       uint64_t length,
       void* buffer,
       const FileIoContext& context) const {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    read(offset, length, static_cast<char*>(buffer));
     return {static_cast<char*>(buffer), length};
   }
 
@@ -88,7 +105,7 @@ class S3ReadFile ::Impl {
   pread(uint64_t offset, uint64_t length, const FileIoContext& context) const {
     std::string result(length, 0);
     char* position = result.data();
-    preadInternal(offset, length, position);
+    read(offset, length, position);
     return result;
   }
 
@@ -102,23 +119,60 @@ class S3ReadFile ::Impl {
     // multi-range. AWS S3 also charges by number of read requests and not size.
     // The idea here is to use a single read spanning all the ranges and then
     // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
+    const auto length = totalLength(buffers);
+    if (buffers.size() == 1 && buffers[0].data() != nullptr) {
+      read(offset, length, buffers[0].data());
+      return length;
     }
     // TODO: allocate from a memory pool
     std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
+    read(offset, length, static_cast<char*>(result.data()));
+    copyToBuffers(result, buffers);
+    return length;
+  }
+
+  uint64_t preadv(
+      folly::Range<const common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs) const {
+    VELOX_CHECK_EQ(regions.size(), iobufs.size());
+    std::vector<folly::SemiFuture<folly::Unit>> reads;
+    reads.reserve(regions.size());
+    uint64_t length = 0;
+    for (size_t i = 0; i < regions.size(); ++i) {
+      const auto& region = regions[i];
+      auto& output = iobufs[i];
+      output = folly::IOBuf(folly::IOBuf::CREATE, region.length);
+      output.append(region.length);
+      reads.push_back(readAsync(
+          region.offset,
+          region.length,
+          reinterpret_cast<char*>(output.writableData())));
+      length += region.length;
     }
+    waitForReads(std::move(reads)).get();
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const {
+    const auto length = totalLength(buffers);
+    if (buffers.size() == 1 && buffers[0].data() != nullptr) {
+      return readAsync(offset, length, buffers[0].data())
+          .deferValue([length](auto&&) { return length; });
+    }
+    auto result = std::make_shared<std::string>(length, 0);
+    return readAsync(offset, length, result->data(), result)
+        .deferValue([result, buffers, length](auto&&) {
+          copyToBuffers(*result, buffers);
+          return length;
+        });
+  }
+
+  bool hasPreadvAsync() const {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const {
     return length_;
   }
@@ -138,6 +192,94 @@ class S3ReadFile ::Impl {
   }
 
  private:
+  static uint64_t totalLength(const std::vector<folly::Range<char*>>& buffers) {
+    uint64_t length = 0;
+    for (const auto& range : buffers) {
+      length += range.size();
+    }
+    return length;
+  }
+
+  // Copies 'data' read for the ranges of 'buffers' to the ranges that are not
+  // gaps.
+  static void copyToBuffers(
+      const std::string& data,
+      const std::vector<folly::Range<char*>>& buffers) {
+    size_t offset = 0;
+    for (const auto& range : buffers) {
+      if (range.data()) {
+        memcpy(range.data(), data.data() + offset, range.size());
+      }
+      offset += range.size();
+    }
+  }
+
+  // Reads 'length' bytes at 'offset' into 'position'. Splits the read into
+  // parallel parts if it is larger than the part size.
+  void read(uint64_t offset, uint64_t length, char* position) const {
+    if (executor_ == nullptr || readParallelism_ == 1 ||
+        length <= readPartSize_) {
+      preadInternal(offset, length, position);
+      return;
+    }
+    readAsync(offset, length, position).get();
+  }
+
+  // Reads 'length' bytes at 'offset' into 'position' on 'executor_'. The read
+  // is split into parts of at most 'readPartSize_' bytes, which are fetched by
+  // up to 'readParallelism_' tasks. 'buffer' is kept alive until all parts are
+  // read.
+  folly::SemiFuture<folly::Unit> readAsync(
+      uint64_t offset,
+      uint64_t length,
+      char* position,
+      std::shared_ptr<void> buffer = nullptr) const {
+    VELOX_CHECK_NOT_NULL(executor_);
+    if (length == 0) {
+      return folly::makeSemiFuture();
+    }
+    const uint64_t numParts = bits::divRoundUp(length, readPartSize_);
+    const uint64_t numTasks = std::min<uint64_t>(numParts, readParallelism_);
+    std::vector<folly::SemiFuture<folly::Unit>> reads;
+    reads.reserve(numTasks);
+    for (uint64_t task = 0; task < numTasks; ++task) {
+      reads.push_back(
+          folly::via(
+              executor_,
+              [self = shared_from_this(),
+               buffer,
+               task,
+               numTasks,
+               numParts,
+               offset,
+               length,
+               position]() {
+                for (auto part = task; part < numParts; part += numTasks) {
+                  const auto partOffset = part * self->readPartSize_;
+                  self->preadInternal(
+                      offset + partOffset,
+                      std::min(self->readPartSize_, length - partOffset),
+                      position + partOffset);
+                }
+              })
+              .semi());
+    }
+    return waitForReads(std::move(reads));
+  }
+
+  // Returns a future that is fulfilled when all 'reads' are finished. Waits
+  // for all reads even if one fails, since the others write to the same
+  // buffers.
+  static folly::SemiFuture<folly::Unit> waitForReads(
+      std::vector<folly::SemiFuture<folly::Unit>> reads) {
+    return folly::collectAll(std::move(reads))
+        .deferValue([](std::vector<folly::Try<folly::Unit>>&& results) {
+          for (auto& result : results) {
+            result.value();
+          }
+        });
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
@@ -154,7 +296,12 @@ class S3ReadFile ::Impl {
         AwsWriteableStreamFactory(position, length));
     RECORD_METRIC_VALUE(kMetricS3ActiveConnections);
     RECORD_METRIC_VALUE(kMetricS3GetObjectCalls);
-    auto outcome = client_->GetObject(request);
+    uint64_t getObjectUs{0};
+    auto outcome = [&]() {
+      MicrosecondTimer timer(&getObjectUs);
+      return client_->GetObject(request);
+    }();
+    RECORD_QUANTILE_STAT_VALUE(kMetricS3GetObjectLatencyUs, getObjectUs);
     if (!outcome.IsSuccess()) {
       RECORD_METRIC_VALUE(kMetricS3GetObjectErrors);
     }
@@ -163,14 +310,23 @@ class S3ReadFile ::Impl {
     VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
   }
 
-  Aws::S3::S3Client* client_;
+  Aws::S3::S3Client* const client_;
+  folly::Executor* const executor_;
+  const uint32_t readParallelism_;
+  const uint64_t readPartSize_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
 };
 
-S3ReadFile::S3ReadFile(std::string_view path, Aws::S3::S3Client* client) {
-  impl_ = std::make_shared<Impl>(path, client);
+S3ReadFile::S3ReadFile(
+    std::string_view path,
+    Aws::S3::S3Client* client,
+    folly::Executor* executor,
+    uint32_t readParallelism,
+    uint64_t readPartSize) {
+  impl_ = std::make_shared<Impl>(
+      path, client, executor, readParallelism, readPartSize);
 }
 
 S3ReadFile::~S3ReadFile() = default;
@@ -201,6 +357,30 @@ uint64_t S3ReadFile::preadv(
   return impl_->preadv(offset, buffers, context);
 }
 
+uint64_t S3ReadFile::preadv(
+    folly::Range<const common::Region*> regions,
+    folly::Range<folly::IOBuf*> iobufs,
+    const FileIoContext& context) const {
+  if (!impl_->hasPreadvAsync()) {
+    return ReadFile::preadv(regions, iobufs, context);
+  }
+  return impl_->preadv(regions, iobufs);
+}
+
+folly::SemiFuture<uint64_t> S3ReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    const FileIoContext& context) const {
+  if (!impl_->hasPreadvAsync()) {
+    return ReadFile::preadvAsync(offset, buffers, context);
+  }
+  return impl_->preadvAsync(offset, buffers);
+}
+
+bool S3ReadFile::hasPreadvAsync() const {
+  return impl_->hasPreadvAsync();
+}
+
 uint64_t S3ReadFile::size() const {
   return impl_->size();
 }
@@ -25,9 +25,20 @@ class S3Client;
 namespace facebook::velox::filesystems {
 
 /// Implementation of s3 read file.
+///
+/// If 'executor' is set, reads are issued as ranged GETs on 'executor': a
+/// read larger than 'readPartSize' is split into parts that are fetched with
+/// up to 'readParallelism' concurrent GETs, the regions of a vectorized read
+/// are fetched concurrently and preadvAsync() does not block the caller.
+/// Otherwise each read is a single GET on the calling thread.
 class S3ReadFile : public ReadFile {
  public:
-  S3ReadFile(std::string_view path, Aws::S3::S3Client* client);
+  S3ReadFile(
+      std::string_view path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor = nullptr,
+      uint32_t readParallelism = 1,
+      uint64_t readPartSize = 0);
 
   ~S3ReadFile() override;
 
@@ -47,6 +58,18 @@ class S3ReadFile : public ReadFile {
       const std::vector<folly::Range<char*>>& buffers,
       const FileIoContext& context = {}) const final;
 
+  uint64_t preadv(
+      folly::Range<const common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs,
+      const FileIoContext& context = {}) const final;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      const FileIoContext& context = {}) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -16,10 +16,15 @@
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Counters.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/dwio/common/DataBuffer.h"
 
+#include <deque>
+
+#include <folly/futures/Future.h>
+
 #include <aws/core/Aws.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
@@ -35,16 +40,21 @@ namespace facebook::velox::filesystems {
 
 class S3WriteFile::Impl {
  public:
-  explicit Impl(
+  Impl(
       std::string_view path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      folly::Executor* executor,
+      uint32_t maxInflightParts)
+      : client_(client),
+        pool_(pool),
+        executor_(executor),
+        maxInflightParts_(maxInflightParts) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
+    VELOX_CHECK_GT(maxInflightParts_, 0);
     getBucketAndKeyFromPath(path, bucket_, key_);
-    currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
-    currentPart_->reserve(kPartUploadSize);
+    currentPart_ = newPart();
     // Check that the object doesn't exist, if it does throw an error.
     {
       Aws::S3::Model::HeadObjectRequest request;
@@ -98,10 +108,22 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // The uploads in flight use 'this' and their part buffers are allocated
+    // from 'pool_'.
+    for (auto& part : inflightParts_) {
+      if (part.valid()) {
+        std::move(part).wait();
+      }
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
-    if (data.size() + currentPart_->size() >= kPartUploadSize) {
+    if (executor_ != nullptr) {
+      appendAsync(data);
+    } else if (data.size() + currentPart_->size() >= kPartUploadSize) {
       upload(data);
     } else {
       // Append to current part.
@@ -124,6 +146,9 @@ class S3WriteFile::Impl {
       return;
     }
     RECORD_METRIC_VALUE(kMetricS3StartedUploads);
+    while (!inflightParts_.empty()) {
+      waitForPart();
+    }
     uploadPart({currentPart_->data(), currentPart_->size()}, true);
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
@@ -166,6 +191,12 @@ class S3WriteFile::Impl {
     return (currentPart_->capacity() == 0);
   }
 
+  std::unique_ptr<dwio::common::DataBuffer<char>> newPart() const {
+    auto part = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
+    part->reserve(kPartUploadSize);
+    return part;
+  }
+
   // Holds state for the multipart upload.
   struct UploadState {
     Aws::Vector<Aws::S3::Model::CompletedPart> completedParts;
@@ -195,39 +226,99 @@ class S3WriteFile::Impl {
     currentPart_->unsafeAppend(0, dataPtr, dataSize);
   }
 
+  // Copies 'data' to the current part and submits each part that fills up.
+  void appendAsync(std::string_view data) {
+    while (!data.empty()) {
+      const auto size = std::min<size_t>(
+          data.size(), kPartUploadSize - currentPart_->size());
+      currentPart_->unsafeAppend(data.data(), size);
+      data.remove_prefix(size);
+      if (currentPart_->size() == kPartUploadSize) {
+        submitPart();
+      }
+    }
+  }
+
+  // Uploads the current part on 'executor_' and starts a new part. Waits for
+  // the oldest upload first if 'maxInflightParts_' are in flight.
+  void submitPart() {
+    if (inflightParts_.size() >= maxInflightParts_) {
+      waitForPart();
+    }
+    auto part = std::move(currentPart_);
+    currentPart_ = newPart();
+    const auto partNumber = ++uploadState_.partNumber;
+    inflightParts_.push_back(
+        folly::via(
+            executor_,
+            [this, part = std::move(part), partNumber]() {
+              return uploadPartRequest(
+                  {part->data(), part->size()}, partNumber);
+            })
+            .semi());
+  }
+
+  // Waits for the oldest upload in flight. Parts complete in submission
+  // order, which keeps 'completedParts' ordered by part number.
+  void waitForPart() {
+    auto part = std::move(inflightParts_.front());
+    inflightParts_.pop_front();
+    uploadState_.completedParts.push_back(std::move(part).get());
+  }
+
   void uploadPart(const std::string_view part, bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
     VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
-    {
-      Aws::S3::Model::UploadPartRequest request;
-      request.SetBucket(bucket_);
-      request.SetKey(key_);
-      request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
-      request.SetContentLength(part.size());
-      request.SetBody(
-          std::make_shared<StringViewStream>(part.data(), part.size()));
-      auto outcome = client_->UploadPart(request);
-      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
-      // Append ETag and part number for this uploaded part.
-      // This will be needed for upload completion in Close().
-      auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
-
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
-      // Don't add the checksum to the part if the checksum is empty.
-      // Some filesystems such as IBM COS require this to be not set.
-      if (!result.GetChecksumCRC32().empty()) {
-        part.SetChecksumCRC32(result.GetChecksumCRC32());
-      }
-      uploadState_.completedParts.push_back(std::move(part));
+    uploadState_.completedParts.push_back(
+        uploadPartRequest(part, ++uploadState_.partNumber));
+  }
+
+  // Uploads 'part' as part 'partNumber' and returns the completed part. Only
+  // reads the state set up by the constructor, so parts can be uploaded
+  // concurrently.
+  Aws::S3::Model::CompletedPart uploadPartRequest(
+      const std::string_view part,
+      int64_t partNumber) const {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(key_);
+    request.SetUploadId(uploadState_.id);
+    request.SetPartNumber(partNumber);
+    request.SetContentLength(part.size());
+    request.SetBody(
+        std::make_shared<StringViewStream>(part.data(), part.size()));
+    uint64_t uploadTimeUs{0};
+    auto outcome = [&]() {
+      MicrosecondTimer timer(&uploadTimeUs);
+      return client_->UploadPart(request);
+    }();
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
+    RECORD_METRIC_VALUE(kMetricS3UploadedBytes, part.size());
+    if (uploadTimeUs > 0) {
+      // Bytes per microsecond are MB per second.
+      RECORD_HISTOGRAM_METRIC_VALUE(
+          kMetricS3UploadPartThroughputMBps, part.size() / uploadTimeUs);
+    }
+    // Append ETag and part number for this uploaded part.
+    // This will be needed for upload completion in Close().
+    auto result = outcome.GetResult();
+    Aws::S3::Model::CompletedPart completedPart;
+
+    completedPart.SetPartNumber(partNumber);
+    completedPart.SetETag(result.GetETag());
+    // Don't add the checksum to the part if the checksum is empty.
+    // Some filesystems such as IBM COS require this to be not set.
+    if (!result.GetChecksumCRC32().empty()) {
+      completedPart.SetChecksumCRC32(result.GetChecksumCRC32());
     }
+    return completedPart;
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  folly::Executor* const executor_;
+  const uint32_t maxInflightParts_;
+  std::deque<folly::SemiFuture<Aws::S3::Model::CompletedPart>> inflightParts_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
   std::string bucket_;
   std::string key_;
@@ -237,14 +328,24 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     std::string_view path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    folly::Executor* executor,
+    uint32_t maxInflightParts) {
+  impl_ =
+      std::make_shared<Impl>(path, client, pool, executor, maxInflightParts);
 }
 
 void S3WriteFile::append(std::string_view data) {
   return impl_->append(data);
 }
 
+void S3WriteFile::append(std::unique_ptr<folly::IOBuf> data) {
+  for (const auto range : *data) {
+    impl_->append(
+        {reinterpret_cast<const char*>(range.data()), range.size()});
+  }
+}
+
 void S3WriteFile::flush() {
   impl_->flush();
 }
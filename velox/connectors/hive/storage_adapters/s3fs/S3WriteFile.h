@@ -42,20 +42,29 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// If 'executor' is not set, UploadPart is synchronous during append and
+/// close. Otherwise a filled part is uploaded on 'executor' while the next
+/// part is filled, with up to 'maxInflightParts' uploads in flight. The part
+/// buffers are allocated from 'pool', so the memory of the parts in flight is
+/// accounted to the writer, and append blocks on the oldest upload once
+/// 'maxInflightParts' are in flight.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       std::string_view path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* executor = nullptr,
+      uint32_t maxInflightParts = 1);
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
   void append(std::string_view data) override;
 
+  /// Appends the buffers of 'data' without coalescing the chain.
+  void append(std::unique_ptr<folly::IOBuf> data) override;
+
   /// No-op. Append handles the flush.
   void flush() override;
 
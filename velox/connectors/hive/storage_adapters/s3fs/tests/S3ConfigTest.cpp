@@ -38,6 +38,11 @@ TEST(S3ConfigTest, defaultConfig) {
   ASSERT_EQ(s3Config.cacheKey("foo", config), "foo");
   ASSERT_EQ(s3Config.bucket(), "");
   ASSERT_EQ(s3Config.useIMDS(), true);
+  ASSERT_EQ(s3Config.readThreads(), 0);
+  ASSERT_EQ(s3Config.readParallelism(), 4);
+  ASSERT_EQ(s3Config.readPartSize(), uint64_t{8} << 20);
+  ASSERT_EQ(s3Config.uploadThreads(), 0);
+  ASSERT_EQ(s3Config.maxInflightUploads(), 4);
 }
 
 TEST(S3ConfigTest, overrideConfig) {
@@ -55,7 +60,10 @@ TEST(S3ConfigTest, overrideConfig) {
       {S3Config::baseConfigKey(S3Config::Keys::kIamRoleSessionName), "velox"},
       {S3Config::baseConfigKey(S3Config::Keys::kCredentialsProvider),
        "my-credentials-provider"},
-      {S3Config::baseConfigKey(S3Config::Keys::kIMDSEnabled), "false"}};
+      {S3Config::baseConfigKey(S3Config::Keys::kIMDSEnabled), "false"},
+      {S3Config::baseConfigKey(S3Config::Keys::kReadThreads), "8"},
+      {S3Config::baseConfigKey(S3Config::Keys::kReadParallelism), "2"},
+      {S3Config::baseConfigKey(S3Config::Keys::kReadPartSize), "1MB"}};
   auto configBase =
       std::make_shared<config::ConfigBase>(std::move(configFromFile));
   auto s3Config = S3Config("bucket", configBase);
@@ -74,6 +82,9 @@ TEST(S3ConfigTest, overrideConfig) {
   ASSERT_EQ(s3Config.bucket(), "bucket");
   ASSERT_EQ(s3Config.credentialsProvider(), "my-credentials-provider");
   ASSERT_EQ(s3Config.useIMDS(), false);
+  ASSERT_EQ(s3Config.readThreads(), 8);
+  ASSERT_EQ(s3Config.readParallelism(), 2);
+  ASSERT_EQ(s3Config.readPartSize(), uint64_t{1} << 20);
 }
 
 TEST(S3ConfigTest, overrideBucketConfig) {
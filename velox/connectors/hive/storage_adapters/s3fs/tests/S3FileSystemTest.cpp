@@ -76,6 +76,44 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRead) {
+  const char* bucketName = "data";
+  const char* file = "test.txt";
+  const auto filename = localPath(bucketName) + "/" + file;
+  const auto s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-threads", "4"},
+       {"hive.s3.read-parallelism", "3"},
+       {"hive.s3.read-part-size", "100kB"}});
+  filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  // The reads with gaps are split into parts as well.
+  std::string head(10, 0);
+  std::string tail(kOneMB - 10, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head.data(), head.size()),
+      folly::Range<char*>(nullptr, 15),
+      folly::Range<char*>(tail.data(), tail.size())};
+  ASSERT_EQ(readFile->preadvAsync(0, buffers).get(), kOneMB + 15);
+  ASSERT_EQ(head, "aaaaabbbbb");
+  ASSERT_EQ(tail, std::string(kOneMB - 20, 'c') + "cccccddddd");
+
+  std::vector<common::Region> regions = {{10 + kOneMB, 5}, {0, 10}, {5, 0}};
+  std::vector<folly::IOBuf> iobufs(regions.size());
+  ASSERT_EQ(readFile->preadv(regions, {iobufs.data(), iobufs.size()}), 15);
+  ASSERT_EQ(iobufs[0].moveToFbString().toStdString(), "ddddd");
+  ASSERT_EQ(iobufs[1].moveToFbString().toStdString(), "aaaaabbbbb");
+  ASSERT_EQ(iobufs[2].length(), 0);
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     std::unordered_map<std::string, std::string> config(
@@ -321,6 +359,50 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_TRUE(s3fs.exists(s3File));
 }
 
+TEST_F(S3FileSystemTest, writeFileAsync) {
+  const auto bucketName = "writeasync";
+  const auto file = "test.txt";
+  const auto s3File = s3URI(bucketName, file);
+
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.upload-threads", "2"}, {"hive.s3.max-inflight-uploads", "2"}});
+  filesystems::S3FileSystem s3fs(bucketName, hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  auto writeFile =
+      s3fs.openFileForWrite(s3File, {{}, pool.get(), std::nullopt});
+  auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+  // Appends 1MiB chunks of different content, alternating between string
+  // views and IOBuf chains, for 4 full parts of 10MiB and a last part.
+  constexpr int32_t kNumChunks = 45;
+  std::vector<std::string> chunks;
+  for (int32_t i = 0; i < kNumChunks; ++i) {
+    chunks.push_back(std::string(kOneMB, 'a' + i % 26));
+  }
+  for (int32_t i = 0; i < kNumChunks; ++i) {
+    if (i % 2 == 0) {
+      writeFile->append(chunks[i]);
+    } else {
+      auto data = folly::IOBuf::copyBuffer(chunks[i].data(), kOneMB / 2);
+      data->appendToChain(folly::IOBuf::copyBuffer(
+          chunks[i].data() + kOneMB / 2, kOneMB / 2));
+      writeFile->append(std::move(data));
+    }
+    // At most 2 parts in flight and the current part are allocated.
+    EXPECT_LE(pool->usedBytes(), 3 * (10 << 20) + kOneMB);
+  }
+  EXPECT_EQ(writeFile->size(), kNumChunks * kOneMB);
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 4);
+  writeFile->close();
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 5);
+
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(readFile->size(), kNumChunks * kOneMB);
+  for (int32_t i = 0; i < kNumChunks; ++i) {
+    ASSERT_EQ(readFile->pread(i * kOneMB, kOneMB), chunks[i]);
+  }
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
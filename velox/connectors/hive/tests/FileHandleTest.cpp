@@ -17,6 +17,7 @@
 #include "velox/connectors/hive/FileHandle.h"
 
 #include "gtest/gtest.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
@@ -77,3 +78,38 @@ TEST(FileHandleTest, localFileWithProperties) {
   // Clean up
   remove(filename.c_str());
 }
+
+TEST(FileHandleTest, notFound) {
+  filesystems::registerLocalFileSystem();
+
+  auto tempFile = TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  remove(filename.c_str());
+
+  // No handle cache, so that each generate() goes to the generator.
+  FileHandleFactory factory(
+      nullptr,
+      std::make_unique<FileHandleGenerator>(nullptr, nullptr, 60'000, 10));
+  FileHandleKey key{filename};
+  VELOX_ASSERT_RUNTIME_THROW_CODE(
+      factory.generate(key),
+      error_code::kFileNotFound,
+      "No such file or directory");
+
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("foo");
+  }
+  // The file is reported missing until the entry expires.
+  VELOX_ASSERT_RUNTIME_THROW_CODE(
+      factory.generate(key),
+      error_code::kFileNotFound,
+      "No such file or directory");
+
+  FileHandleFactory uncached(
+      nullptr, std::make_unique<FileHandleGenerator>(nullptr));
+  ASSERT_EQ(uncached.generate(key)->file->size(), 3);
+
+  // Clean up
+  remove(filename.c_str());
+}
@@ -33,6 +33,7 @@ TEST(HiveConfigTest, defaultConfig) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kError);
   ASSERT_EQ(hiveConfig.maxPartitionsPerWriters(emptySession.get()), 128);
+  ASSERT_EQ(hiveConfig.maxOpenPartitionWriters(emptySession.get()), 0);
   ASSERT_EQ(hiveConfig.immutablePartitions(), false);
   ASSERT_EQ(hiveConfig.gcsEndpoint(), "");
   ASSERT_EQ(hiveConfig.gcsCredentialsPath(), "");
@@ -42,6 +43,7 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(emptySession.get()), 128 << 20);
   ASSERT_EQ(
       hiveConfig.maxCoalescedDistanceBytes(emptySession.get()), 512 << 10);
+  ASSERT_FALSE(hiveConfig.adaptiveCoalesceEnabled(emptySession.get()));
   ASSERT_FALSE(
       hiveConfig.readStatsBasedFilterReorderDisabled(emptySession.get()));
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
@@ -55,6 +57,7 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_TRUE(hiveConfig.allowNullPartitionKeys(emptySession.get()));
   ASSERT_EQ(hiveConfig.loadQuantum(emptySession.get()), 8 << 20);
   ASSERT_FALSE(hiveConfig.preserveFlatMapsInMemory(emptySession.get()));
+  ASSERT_FALSE(hiveConfig.stringsFromCacheEnabled(emptySession.get()));
   ASSERT_FALSE(hiveConfig.indexEnabled(emptySession.get()));
   ASSERT_FALSE(hiveConfig.fileMetadataCacheEnabled(emptySession.get()));
   ASSERT_EQ(
@@ -64,12 +67,16 @@ TEST(HiveConfigTest, defaultConfig) {
       256UL << 10);
   ASSERT_EQ(
       hiveConfig.nimbleFooterSpeculativeIoSize(emptySession.get()), 8UL << 20);
+  ASSERT_FALSE(hiveConfig.parquetPageIndexFilterEnabled(emptySession.get()));
+  ASSERT_FALSE(hiveConfig.parquetBloomFilterEnabled(emptySession.get()));
+  ASSERT_FALSE(hiveConfig.parquetDictionaryFilterEnabled(emptySession.get()));
 }
 
 TEST(HiveConfigTest, overrideConfig) {
   std::unordered_map<std::string, std::string> configFromFile = {
       {HiveConfig::kInsertExistingPartitionsBehavior, "OVERWRITE"},
       {HiveConfig::kMaxPartitionsPerWriters, "120"},
+      {HiveConfig::kMaxOpenPartitionWriters, "20"},
       {HiveConfig::kImmutablePartitions, "true"},
       {HiveConfig::kGcsEndpoint, "hey"},
       {HiveConfig::kGcsCredentialsPath, "hey"},
@@ -78,6 +85,7 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kAllowNullPartitionKeys, "false"},
       {HiveConfig::kMaxCoalescedBytes, "100"},
       {HiveConfig::kMaxCoalescedDistance, "100kB"},
+      {HiveConfig::kAdaptiveCoalesceEnabled, "true"},
       {HiveConfig::kNumCacheFileHandles, "100"},
       {HiveConfig::kFileHandleExpirationDurationMs, "200"},
       {HiveConfig::kEnableFileHandleCache, "false"},
@@ -92,7 +100,10 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kFileMetadataCacheEnabled, "true"},
       {HiveConfig::kOrcFooterSpeculativeIoSize, std::to_string(512UL << 10)},
       {HiveConfig::kParquetFooterSpeculativeIoSize, std::to_string(1UL << 20)},
-      {HiveConfig::kNimbleFooterSpeculativeIoSize, std::to_string(4UL << 20)}};
+      {HiveConfig::kNimbleFooterSpeculativeIoSize, std::to_string(4UL << 20)},
+      {HiveConfig::kParquetPageIndexFilterEnabled, "true"},
+      {HiveConfig::kParquetBloomFilterEnabled, "true"},
+      {HiveConfig::kParquetDictionaryFilterEnabled, "true"}};
   HiveConfig hiveConfig(
       std::make_shared<config::ConfigBase>(std::move(configFromFile)));
   auto emptySession = std::make_shared<config::ConfigBase>(
@@ -102,6 +113,7 @@ TEST(HiveConfigTest, overrideConfig) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kOverwrite);
   ASSERT_EQ(hiveConfig.maxPartitionsPerWriters(emptySession.get()), 120);
+  ASSERT_EQ(hiveConfig.maxOpenPartitionWriters(emptySession.get()), 20);
   ASSERT_TRUE(hiveConfig.immutablePartitions());
   ASSERT_EQ(hiveConfig.gcsEndpoint(), "hey");
   ASSERT_EQ(hiveConfig.gcsCredentialsPath(), "hey");
@@ -111,6 +123,7 @@ TEST(HiveConfigTest, overrideConfig) {
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(emptySession.get()), 100);
   ASSERT_EQ(
       hiveConfig.maxCoalescedDistanceBytes(emptySession.get()), 100 << 10);
+  ASSERT_TRUE(hiveConfig.adaptiveCoalesceEnabled(emptySession.get()));
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 100);
   ASSERT_EQ(hiveConfig.fileHandleExpirationDurationMs(), 200);
   ASSERT_FALSE(hiveConfig.isFileHandleCacheEnabled());
@@ -132,6 +145,9 @@ TEST(HiveConfigTest, overrideConfig) {
       hiveConfig.parquetFooterSpeculativeIoSize(emptySession.get()), 1UL << 20);
   ASSERT_EQ(
       hiveConfig.nimbleFooterSpeculativeIoSize(emptySession.get()), 4UL << 20);
+  ASSERT_TRUE(hiveConfig.parquetPageIndexFilterEnabled(emptySession.get()));
+  ASSERT_TRUE(hiveConfig.parquetBloomFilterEnabled(emptySession.get()));
+  ASSERT_TRUE(hiveConfig.parquetDictionaryFilterEnabled(emptySession.get()));
 }
 
 TEST(HiveConfigTest, overrideSession) {
@@ -145,6 +161,7 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kSortWriterMaxOutputRowsSession, "20"},
       {HiveConfig::kSortWriterMaxOutputBytesSession, "20MB"},
       {HiveConfig::kMaxCoalescedDistanceSession, "3MB"},
+      {HiveConfig::kAdaptiveCoalesceEnabledSession, "true"},
       {HiveConfig::kSortWriterFinishTimeSliceLimitMsSession, "300"},
       {HiveConfig::kPartitionPathAsLowerCaseSession, "false"},
       {HiveConfig::kAllowNullPartitionKeysSession, "false"},
@@ -160,6 +177,9 @@ TEST(HiveConfigTest, overrideSession) {
        std::to_string(512UL << 10)},
       {HiveConfig::kNimbleFooterSpeculativeIoSizeSession,
        std::to_string(2UL << 20)},
+      {HiveConfig::kParquetPageIndexFilterEnabledSession, "true"},
+      {HiveConfig::kParquetBloomFilterEnabledSession, "true"},
+      {HiveConfig::kParquetDictionaryFilterEnabledSession, "true"},
   };
   const auto session =
       std::make_unique<config::ConfigBase>(std::move(sessionOverride));
@@ -176,6 +196,7 @@ TEST(HiveConfigTest, overrideSession) {
 
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(session.get()), 128 << 20);
   ASSERT_EQ(hiveConfig.maxCoalescedDistanceBytes(session.get()), 3 << 20);
+  ASSERT_TRUE(hiveConfig.adaptiveCoalesceEnabled(session.get()));
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_TRUE(hiveConfig.isFileHandleCacheEnabled());
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(session.get()), 20);
@@ -193,4 +214,7 @@ TEST(HiveConfigTest, overrideSession) {
   ASSERT_EQ(
       hiveConfig.parquetFooterSpeculativeIoSize(session.get()), 512UL << 10);
   ASSERT_EQ(hiveConfig.nimbleFooterSpeculativeIoSize(session.get()), 2UL << 20);
+  ASSERT_TRUE(hiveConfig.parquetPageIndexFilterEnabled(session.get()));
+  ASSERT_TRUE(hiveConfig.parquetBloomFilterEnabled(session.get()));
+  ASSERT_TRUE(hiveConfig.parquetDictionaryFilterEnabled(session.get()));
 }
@@ -1100,4 +1100,42 @@ TEST_F(HiveConnectorUtilTest, createRangeFilter) {
   }
 }
 
+TEST_F(HiveConnectorUtilTest, testPartitionFilters) {
+  velox::common::ScanSpec scanSpec("");
+  scanSpec.addField("c0", 0)->setFilter(
+      std::make_shared<velox::common::BigintRange>(0, 10, false));
+  scanSpec.addField("p0", 1)->setFilter(
+      std::make_shared<velox::common::BigintRange>(5, 10, false));
+  scanSpec.addField("p1", 2)->setFilter(
+      std::make_shared<velox::common::BytesValues>(
+          std::vector<std::string>{"a", "b"}, false));
+  const std::unordered_map<std::string, hive::HiveColumnHandlePtr> handles = {
+      {"p0",
+       std::make_shared<hive::HiveColumnHandle>(
+           "p0",
+           hive::HiveColumnHandle::ColumnType::kPartitionKey,
+           BIGINT(),
+           BIGINT())},
+      {"p1",
+       std::make_shared<hive::HiveColumnHandle>(
+           "p1",
+           hive::HiveColumnHandle::ColumnType::kPartitionKey,
+           VARCHAR(),
+           VARCHAR())}};
+  auto test = [&](std::optional<std::string> p0,
+                  std::optional<std::string> p1) {
+    return hive::testPartitionFilters(
+        &scanSpec, "file", {{"p0", p0}, {"p1", p1}}, handles, false);
+  };
+
+  ASSERT_TRUE(test("7", "a"));
+  ASSERT_FALSE(test("1", "a"));
+  // Every partition key is tested, not only the first one.
+  ASSERT_FALSE(test("7", "c"));
+  ASSERT_FALSE(test(std::nullopt, "a"));
+  // The filter on data column c0 needs the file and is not tested.
+  ASSERT_TRUE(
+      hive::testPartitionFilters(&scanSpec, "file", {}, handles, false));
+}
+
 } // namespace facebook::velox::connector
@@ -1742,6 +1742,65 @@ TEST_F(HiveDataSinkTest, fileRotationWithPartitionedTable) {
   ASSERT_EQ(totalFilesFromPartitions, stats.numWrittenFiles);
 }
 
+TEST_F(HiveDataSinkTest, maxOpenPartitionWriters) {
+  const auto partitionedRowType =
+      ROW({"c0", "c1", "p0"}, {BIGINT(), INTEGER(), VARCHAR()});
+  const int32_t numPartitions = 10;
+  const int32_t numBatches = 4;
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    // Every batch has rows of all partitions, interleaved.
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(500, [](auto row) { return row; }),
+         makeFlatVector<int32_t>(500, [](auto row) { return row * 2; }),
+         makeFlatVector<std::string>(500, [&](auto row) {
+           return fmt::format("p{}", row % numPartitions);
+         })}));
+  }
+
+  for (const int32_t maxOpenWriters : {0, 3, 10}) {
+    SCOPED_TRACE(fmt::format("maxOpenWriters {}", maxOpenWriters));
+    const auto outputDirectory = TempDirectoryPath::create();
+    connectorConfig_ =
+        std::make_shared<HiveConfig>(std::make_shared<config::ConfigBase>(
+            std::unordered_map<std::string, std::string>{
+                {HiveConfig::kMaxOpenPartitionWriters,
+                 std::to_string(maxOpenWriters)}}));
+    auto dataSink = createDataSink(
+        partitionedRowType,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {"p0"});
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    ASSERT_TRUE(dataSink->finish());
+    const auto partitions = dataSink->close();
+    ASSERT_EQ(partitions.size(), numPartitions);
+
+    // With fewer open writers than partitions, each batch reopens the writer
+    // of every partition, which starts a new file.
+    const int32_t numFilesPerPartition =
+        maxOpenWriters == 0 || maxOpenWriters >= numPartitions ? 1
+                                                                : numBatches;
+    for (const auto& partition : partitions) {
+      const auto partitionJson = folly::parseJson(partition);
+      ASSERT_EQ(
+          partitionJson[HiveCommitMessage::kFileWriteInfos].size(),
+          numFilesPerPartition);
+      ASSERT_EQ(
+          partitionJson[HiveCommitMessage::kRowCount].asInt(),
+          numBatches * 500 / numPartitions);
+    }
+    ASSERT_EQ(
+        dataSink->stats().numWrittenFiles,
+        numPartitions * numFilesPerPartition);
+    ASSERT_EQ(
+        listFiles(outputDirectory->getPath()).size(),
+        numPartitions * numFilesPerPartition);
+  }
+}
+
 TEST_F(HiveDataSinkTest, fileRotationWriteIOTimeAccumulation) {
   // Tests that writeIOTimeUs is correctly accumulated across rotated files.
   const auto outputDirectory = TempDirectoryPath::create();
@@ -27,7 +27,45 @@ TpchConnector::TpchConnector(
     const std::string& id,
     std::shared_ptr<const config::ConfigBase> config,
     folly::Executor* /*executor*/)
-    : Connector(id, std::move(config)) {}
+    : Connector(id, std::move(config)) {
+  if (const auto capacity =
+          connectorConfig()->get<std::string>(kBatchCacheCapacity)) {
+    const auto bytes =
+        config::toCapacity(capacity.value(), config::CapacityUnit::BYTE);
+    if (bytes > 0) {
+      batchCache_ = std::make_unique<TpchBatchCache>(bytes);
+    }
+  }
+}
+
+TpchBatchCache::TpchBatchCache(uint64_t capacity)
+    : pool_(memory::memoryManager()->addLeafPool("tpchBatchCache")),
+      cache_(capacity) {}
+
+RowVectorPtr TpchBatchCache::get(const Key& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* batch = cache_.get(key);
+  if (batch == nullptr) {
+    return nullptr;
+  }
+  auto result = *batch;
+  cache_.release(key);
+  return result;
+}
+
+void TpchBatchCache::put(const Key& key, RowVectorPtr batch) {
+  const auto size = batch->retainedSize();
+  auto value = std::make_unique<RowVectorPtr>(std::move(batch));
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, value.get(), size)) {
+    value.release();
+  }
+}
+
+SimpleLRUCacheStats TpchBatchCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
 
 namespace {
 
@@ -73,9 +111,11 @@ TpchDataSource::TpchDataSource(
     const RowTypePtr& outputType,
     const connector::ConnectorTableHandlePtr& tableHandle,
     const connector::ColumnHandleMap& columnHandles,
-    ConnectorQueryCtx* connectorQueryCtx)
+    ConnectorQueryCtx* connectorQueryCtx,
+    TpchBatchCache* batchCache)
     : connectorQueryCtx_(connectorQueryCtx),
-      pool_(connectorQueryCtx->memoryPool()) {
+      pool_(connectorQueryCtx->memoryPool()),
+      batchCache_(batchCache) {
   auto tpchTableHandle =
       std::dynamic_pointer_cast<const TpchTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
@@ -223,8 +263,7 @@ std::optional<RowVectorPtr> TpchDataSource::next(
   }
 
   size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto outputVector = generate(maxRows);
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
@@ -243,6 +282,23 @@ std::optional<RowVectorPtr> TpchDataSource::next(
   return applyFilter(outputVector, filterExpression_.get());
 }
 
+RowVectorPtr TpchDataSource::generate(size_t maxRows) {
+  if (batchCache_ == nullptr || !currentSplit_->cacheable) {
+    return getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  }
+  const TpchBatchCache::Key key{
+      tpchTable_, scaleFactor_, splitOffset_, maxRows};
+  if (auto batch = batchCache_->get(key)) {
+    return batch;
+  }
+  auto batch = getTpchData(
+      tpchTable_, maxRows, splitOffset_, scaleFactor_, batchCache_->pool());
+  if (batch != nullptr && batch->size() > 0) {
+    batchCache_->put(key, batch);
+  }
+  return batch;
+}
+
 bool TpchDataSource::isLineItem() const {
   return tpchTable_ == Table::TBL_LINEITEM;
 }
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/common/config/Config.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/tpch/TpchConnectorSplit.h"
@@ -142,13 +143,72 @@ class TpchTableHandle : public ConnectorTableHandle {
   const velox::core::TypedExprPtr filterExpression_;
 };
 
+/// Keeps the batches generated by TpchDataSource in memory so that repeated
+/// scans of a table read them instead of generating them again. Generating
+/// the large tables is much slower than scanning them, so benchmarks with
+/// this cache measure the operators above the scan rather than dbgen. The
+/// batches are allocated from a pool of the cache and are shared by the
+/// queries that read them. Thread safe.
+class TpchBatchCache {
+ public:
+  /// Identifies a generated batch: 'numRows' rows of 'table' starting at row
+  /// 'offset'. For lineitem, the rows are those of orders.
+  struct Key {
+    velox::tpch::Table table;
+    double scaleFactor;
+    uint64_t offset;
+    uint64_t numRows;
+
+    bool operator==(const Key& other) const {
+      return table == other.table && scaleFactor == other.scaleFactor &&
+          offset == other.offset && numRows == other.numRows;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return bits::hashMix(
+          bits::hashMix(
+              static_cast<size_t>(key.table),
+              std::hash<double>()(key.scaleFactor)),
+          bits::hashMix(key.offset, key.numRows));
+    }
+  };
+
+  /// 'capacity' is the maximum retained size of the cached batches in bytes.
+  explicit TpchBatchCache(uint64_t capacity);
+
+  /// Returns the cached batch for 'key' or nullptr.
+  RowVectorPtr get(const Key& key);
+
+  /// Adds 'batch' for 'key', evicting the least recently used batches if
+  /// needed. Does nothing if 'batch' does not fit or 'key' is present.
+  void put(const Key& key, RowVectorPtr batch);
+
+  /// The pool to generate the batches to cache from.
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  SimpleLRUCacheStats stats() const;
+
+ private:
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<Key, RowVectorPtr, std::equal_to<Key>, KeyHash> cache_;
+};
+
 class TpchDataSource : public DataSource {
  public:
+  /// If 'batchCache' is set, the batches of cacheable splits are read from and
+  /// added to it.
   TpchDataSource(
       const RowTypePtr& outputType,
       const connector::ConnectorTableHandlePtr& tableHandle,
       const connector::ColumnHandleMap& columnHandles,
-      ConnectorQueryCtx* connectorQueryCtx);
+      ConnectorQueryCtx* connectorQueryCtx,
+      TpchBatchCache* batchCache = nullptr);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -177,6 +237,10 @@ class TpchDataSource : public DataSource {
  private:
   bool isLineItem() const;
 
+  // Returns the batch of 'maxRows' rows at 'splitOffset_', from 'batchCache_'
+  // if possible.
+  RowVectorPtr generate(size_t maxRows);
+
   RowVectorPtr projectOutputColumns(RowVectorPtr vector);
   RowVectorPtr applyFilter(RowVectorPtr& vector, exec::ExprSet* filter);
 
@@ -206,10 +270,16 @@ class TpchDataSource : public DataSource {
 
   ConnectorQueryCtx* connectorQueryCtx_;
   memory::MemoryPool* pool_;
+  TpchBatchCache* const batchCache_;
 };
 
 class TpchConnector final : public Connector {
  public:
+  /// The capacity of the cache of generated batches, e.g. "16GB". Batches are
+  /// not cached if 0, the default. See TpchBatchCache.
+  static constexpr const char* kBatchCacheCapacity =
+      "tpch.batch-cache-capacity";
+
   TpchConnector(
       const std::string& id,
       std::shared_ptr<const config::ConfigBase> config,
@@ -221,7 +291,11 @@ class TpchConnector final : public Connector {
       const connector::ColumnHandleMap& columnHandles,
       ConnectorQueryCtx* connectorQueryCtx) override final {
     return std::make_unique<TpchDataSource>(
-        outputType, tableHandle, columnHandles, connectorQueryCtx);
+        outputType,
+        tableHandle,
+        columnHandles,
+        connectorQueryCtx,
+        batchCache_.get());
   }
 
   std::unique_ptr<DataSink> createDataSink(
@@ -237,6 +311,14 @@ class TpchConnector final : public Connector {
     TpchColumnHandle::registerSerDe();
     TpchConnectorSplit::registerSerDe();
   }
+
+  /// Returns the cache of generated batches, nullptr if not enabled.
+  TpchBatchCache* batchCache() const {
+    return batchCache_.get();
+  }
+
+ private:
+  std::unique_ptr<TpchBatchCache> batchCache_;
 };
 
 class TpchConnectorFactory : public ConnectorFactory {
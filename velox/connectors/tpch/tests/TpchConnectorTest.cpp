@@ -15,6 +15,7 @@
  */
 
 #include "velox/connectors/tpch/TpchConnector.h"
+#include <folly/ScopeGuard.h>
 #include <folly/init/Init.h>
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -247,6 +248,64 @@ TEST_F(TpchConnectorTest, multipleSplits) {
   }
 }
 
+TEST_F(TpchConnectorTest, batchCache) {
+  const std::string kCachedConnectorId = "test-tpch-cached";
+  connector::tpch::TpchConnectorFactory factory;
+  auto connector = factory.newConnector(
+      kCachedConnectorId,
+      std::make_shared<config::ConfigBase>(
+          std::unordered_map<std::string, std::string>{
+              {TpchConnector::kBatchCacheCapacity, "64MB"}}));
+  connector::registerConnector(connector);
+  SCOPE_EXIT {
+    connector::unregisterConnector(kCachedConnectorId);
+  };
+  auto* cache =
+      std::dynamic_pointer_cast<TpchConnector>(connector)->batchCache();
+  ASSERT_NE(cache, nullptr);
+
+  auto plan = PlanBuilder()
+                  .tpchTableScan(
+                      Table::TBL_ORDERS,
+                      {"o_orderkey", "o_custkey", "o_comment"},
+                      0.01,
+                      kCachedConnectorId)
+                  .planNode();
+  auto expected = getResults(
+      PlanBuilder()
+          .tpchTableScan(
+              Table::TBL_ORDERS,
+              {"o_orderkey", "o_custkey", "o_comment"},
+              0.01,
+              kTpchConnectorId)
+          .planNode(),
+      {makeTpchSplit()});
+
+  auto split = [&](size_t totalParts, size_t partNumber) {
+    return exec::Split(
+        std::make_shared<TpchConnectorSplit>(
+            kCachedConnectorId, /*cacheable=*/true, totalParts, partNumber));
+  };
+  test::assertEqualVectors(
+      expected, getResults(plan, {split(2, 0), split(2, 1)}));
+  const auto numEntries = cache->stats().numElements;
+  ASSERT_GT(numEntries, 0);
+  ASSERT_EQ(cache->stats().numHits, 0);
+
+  // The second scan reads the cached batches.
+  test::assertEqualVectors(
+      expected, getResults(plan, {split(2, 0), split(2, 1)}));
+  ASSERT_EQ(cache->stats().numElements, numEntries);
+  ASSERT_EQ(cache->stats().numHits, numEntries);
+
+  // Non-cacheable splits are generated again.
+  auto uncached = exec::Split(
+      std::make_shared<TpchConnectorSplit>(
+          kCachedConnectorId, /*cacheable=*/false, 1, 0));
+  test::assertEqualVectors(expected, getResults(plan, {std::move(uncached)}));
+  ASSERT_EQ(cache->stats().numHits, numEntries);
+}
+
 // Test filtering in the TpchConnector.
 TEST_F(TpchConnectorTest, filterPushdown) {
   // Test equality filter
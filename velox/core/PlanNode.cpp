@@ -1323,7 +1323,9 @@ void ArrowStreamNode::accept(
 }
 
 void ArrowStreamNode::addDetails(std::stringstream& stream) const {
-  // Nothing to add.
+  if (arrowStreams_.size() > 1) {
+    stream << arrowStreams_.size() << " streams";
+  }
 }
 
 const std::vector<PlanNodePtr>& ExchangeNode::sources() const {
@@ -2419,24 +2421,62 @@ RowTypePtr getMarkDistinctOutputType(
   return ROW(std::move(names), std::move(types));
 }
 
+namespace {
+// Checks that 'preGroupedKeys' are distinct and a subset of 'keys'.
+void checkPreGroupedKeys(
+    const std::vector<FieldAccessTypedExprPtr>& keys,
+    const std::vector<FieldAccessTypedExprPtr>& preGroupedKeys) {
+  folly::F14FastSet<std::string> keyNames;
+  for (const auto& key : keys) {
+    keyNames.insert(key->name());
+  }
+  folly::F14FastSet<std::string> preGroupedKeyNames;
+  for (const auto& key : preGroupedKeys) {
+    VELOX_USER_CHECK(
+        preGroupedKeyNames.insert(key->name()).second,
+        "Duplicate pre-grouped key: {}.",
+        key->name());
+    VELOX_USER_CHECK(
+        keyNames.contains(key->name()),
+        "Pre-grouped key must be one of the keys: {}.",
+        key->name());
+  }
+}
+
+// Returns the "preGroupedKeys" of 'obj' or none if the plan was serialized
+// before they were added.
+std::vector<FieldAccessTypedExprPtr> deserializePreGroupedKeys(
+    const folly::dynamic& obj,
+    void* context) {
+  if (!obj.count("preGroupedKeys")) {
+    return {};
+  }
+  return deserializeFields(obj["preGroupedKeys"], context);
+}
+} // namespace
+
 MarkDistinctNode::MarkDistinctNode(
     PlanNodeId id,
     std::string markerName,
     std::vector<FieldAccessTypedExprPtr> distinctKeys,
+    std::vector<FieldAccessTypedExprPtr> preGroupedKeys,
     PlanNodePtr source)
     : PlanNode(std::move(id)),
       markerName_(std::move(markerName)),
       distinctKeys_(std::move(distinctKeys)),
+      preGroupedKeys_(std::move(preGroupedKeys)),
       sources_{std::move(source)},
       outputType_(
           getMarkDistinctOutputType(sources_[0]->outputType(), markerName_)) {
   VELOX_USER_CHECK_GT(markerName_.size(), 0);
   VELOX_USER_CHECK_GT(distinctKeys_.size(), 0);
+  checkPreGroupedKeys(distinctKeys_, preGroupedKeys_);
 }
 
 folly::dynamic MarkDistinctNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["distinctKeys"] = ISerializable::serialize(this->distinctKeys_);
+  obj["preGroupedKeys"] = ISerializable::serialize(this->preGroupedKeys_);
   obj["markerName"] = this->markerName_;
   return obj;
 }
@@ -2451,10 +2491,15 @@ void MarkDistinctNode::accept(
 PlanNodePtr MarkDistinctNode::create(const folly::dynamic& obj, void* context) {
   auto source = deserializeSingleSource(obj, context);
   auto distinctKeys = deserializeFields(obj["distinctKeys"], context);
+  auto preGroupedKeys = deserializePreGroupedKeys(obj, context);
   auto markerName = obj["markerName"].asString();
 
   return std::make_shared<MarkDistinctNode>(
-      deserializePlanNodeId(obj), markerName, distinctKeys, source);
+      deserializePlanNodeId(obj),
+      markerName,
+      distinctKeys,
+      preGroupedKeys,
+      source);
 }
 
 EnforceDistinctNode::EnforceDistinctNode(
@@ -2638,16 +2683,23 @@ RowNumberNode::RowNumberNode(
     std::vector<FieldAccessTypedExprPtr> partitionKeys,
     const std::optional<std::string>& rowNumberColumnName,
     std::optional<int32_t> limit,
+    std::vector<FieldAccessTypedExprPtr> preGroupedKeys,
     PlanNodePtr source)
     : PlanNode(std::move(id)),
       partitionKeys_{std::move(partitionKeys)},
       limit_{limit},
+      preGroupedKeys_{std::move(preGroupedKeys)},
       sources_{std::move(source)},
       outputType_(getOptionalRowNumberOutputType(
           sources_[0]->outputType(),
-          rowNumberColumnName)) {}
+          rowNumberColumnName)) {
+  checkPreGroupedKeys(partitionKeys_, preGroupedKeys_);
+}
 
 void RowNumberNode::addDetails(std::stringstream& stream) const {
+  if (isPreGrouped()) {
+    stream << "STREAMING ";
+  }
   if (!partitionKeys_.empty()) {
     stream << "partition by (";
     addFields(stream, partitionKeys_);
@@ -2665,6 +2717,7 @@ void RowNumberNode::addDetails(std::stringstream& stream) const {
 folly::dynamic RowNumberNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["partitionKeys"] = ISerializable::serialize(partitionKeys_);
+  obj["preGroupedKeys"] = ISerializable::serialize(preGroupedKeys_);
   if (generateRowNumber()) {
     obj["rowNumberColumnName"] = outputType_->names().back();
   }
@@ -2701,6 +2754,7 @@ PlanNodePtr RowNumberNode::create(const folly::dynamic& obj, void* context) {
       partitionKeys,
       rowNumberColumnName,
       limit,
+      deserializePreGroupedKeys(obj, context),
       source);
 }
 
@@ -3709,6 +3763,9 @@ PlanNodePtr OrderByNode::create(const folly::dynamic& obj, void* context) {
 }
 
 void MarkDistinctNode::addDetails(std::stringstream& stream) const {
+  if (isPreGrouped()) {
+    stream << "STREAMING ";
+  }
   addFields(stream, distinctKeys_);
 }
 
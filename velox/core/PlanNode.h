@@ -443,16 +443,33 @@ class ValuesNode : public PlanNode {
 
 using ValuesNodePtr = std::shared_ptr<const ValuesNode>;
 
+/// Reads the batches of one or more Arrow C streams. With several streams, the
+/// drivers of the pipeline share the streams, each reading one stream at a
+/// time until all are done. The streams are consumed, so the node can run
+/// once.
 class ArrowStreamNode : public PlanNode {
  public:
   ArrowStreamNode(
       const PlanNodeId& id,
       RowTypePtr outputType,
       std::shared_ptr<ArrowArrayStream> arrowStream)
+      : ArrowStreamNode(
+            id,
+            std::move(outputType),
+            std::vector<std::shared_ptr<ArrowArrayStream>>{
+                std::move(arrowStream)}) {}
+
+  ArrowStreamNode(
+      const PlanNodeId& id,
+      RowTypePtr outputType,
+      std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams)
       : PlanNode(id),
         outputType_(std::move(outputType)),
-        arrowStream_(std::move(arrowStream)) {
-    VELOX_USER_CHECK_NOT_NULL(arrowStream_);
+        arrowStreams_(std::move(arrowStreams)) {
+    VELOX_USER_CHECK(!arrowStreams_.empty());
+    for (const auto& arrowStream : arrowStreams_) {
+      VELOX_USER_CHECK_NOT_NULL(arrowStream);
+    }
   }
 
   class Builder {
@@ -462,7 +479,7 @@ class ArrowStreamNode : public PlanNode {
     explicit Builder(const ArrowStreamNode& other) {
       id_ = other.id();
       outputType_ = other.outputType();
-      arrowStream_ = other.arrowStream();
+      arrowStreams_ = other.arrowStreams();
     }
 
     Builder& id(PlanNodeId id) {
@@ -476,7 +493,14 @@ class ArrowStreamNode : public PlanNode {
     }
 
     Builder& arrowStream(std::shared_ptr<ArrowArrayStream> arrowStream) {
-      arrowStream_ = std::move(arrowStream);
+      arrowStreams_ = std::vector<std::shared_ptr<ArrowArrayStream>>{
+          std::move(arrowStream)};
+      return *this;
+    }
+
+    Builder& arrowStreams(
+        std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams) {
+      arrowStreams_ = std::move(arrowStreams);
       return *this;
     }
 
@@ -485,16 +509,17 @@ class ArrowStreamNode : public PlanNode {
       VELOX_USER_CHECK(
           outputType_.has_value(), "ArrowStreamNode outputType is not set");
       VELOX_USER_CHECK(
-          arrowStream_.has_value(), "ArrowStreamNode arrowStream is not set");
+          arrowStreams_.has_value(), "ArrowStreamNode arrowStream is not set");
 
       return std::make_shared<ArrowStreamNode>(
-          id_.value(), outputType_.value(), arrowStream_.value());
+          id_.value(), outputType_.value(), arrowStreams_.value());
     }
 
    private:
     std::optional<PlanNodeId> id_;
     std::optional<RowTypePtr> outputType_;
-    std::optional<std::shared_ptr<ArrowArrayStream>> arrowStream_;
+    std::optional<std::vector<std::shared_ptr<ArrowArrayStream>>>
+        arrowStreams_;
   };
 
   const RowTypePtr& outputType() const override {
@@ -506,12 +531,28 @@ class ArrowStreamNode : public PlanNode {
   void accept(const PlanNodeVisitor& visitor, PlanNodeVisitorContext& context)
       const override;
 
+  /// A single stream is read by a single driver.
   bool requiresSingleThread() const override {
-    return true;
+    return arrowStreams_.size() == 1;
   }
 
+  /// The first stream.
   const std::shared_ptr<ArrowArrayStream>& arrowStream() const {
-    return arrowStream_;
+    return arrowStreams_[0];
+  }
+
+  const std::vector<std::shared_ptr<ArrowArrayStream>>& arrowStreams() const {
+    return arrowStreams_;
+  }
+
+  /// Returns the next stream not yet taken by a driver, nullptr if all are
+  /// taken. Thread safe.
+  std::shared_ptr<ArrowArrayStream> nextArrowStream() const {
+    const auto index = nextStream_.fetch_add(1);
+    if (index >= arrowStreams_.size()) {
+      return nullptr;
+    }
+    return arrowStreams_[index];
   }
 
   std::string_view name() const override {
@@ -526,7 +567,8 @@ class ArrowStreamNode : public PlanNode {
   void addDetails(std::stringstream& stream) const override;
 
   const RowTypePtr outputType_;
-  std::shared_ptr<ArrowArrayStream> arrowStream_;
+  const std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams_;
+  mutable std::atomic<size_t> nextStream_{0};
 };
 
 using ArrowStreamNodePtr = std::shared_ptr<const ArrowStreamNode>;
@@ -1298,8 +1340,11 @@ class AggregationNode : public PlanNode {
     std::optional<PlanNodePtr> source_;
   };
 
+  /// A streaming aggregation produces its pending groups at a barrier. A hash
+  /// aggregation produces all the groups of the input since the previous
+  /// barrier and starts over, i.e. aggregates each barrier epoch separately.
   bool supportsBarrier() const override {
-    return isPreGrouped();
+    return true;
   }
 
   const std::vector<PlanNodePtr>& sources() const override {
@@ -5234,11 +5279,16 @@ class RowNumberNode : public PlanNode {
   /// @param limit Optional per-partition limit. If specified, the number of
   /// rows produced by this node will not exceed this value for any given
   /// partition. Extra rows will be dropped.
+  /// @param preGroupedKeys Subset of partitionKeys that input is already
+  /// clustered on. When non-empty and equal to partitionKeys, a streaming
+  /// implementation is used that compares consecutive rows instead of using a
+  /// hash table.
   RowNumberNode(
       PlanNodeId id,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
       const std::optional<std::string>& rowNumberColumnName,
       std::optional<int32_t> limit,
+      std::vector<FieldAccessTypedExprPtr> preGroupedKeys,
       PlanNodePtr source);
 
   class Builder {
@@ -5252,6 +5302,7 @@ class RowNumberNode : public PlanNode {
           ? std::make_optional(other.outputType()->names().back())
           : std::nullopt;
       limit_ = other.limit();
+      preGroupedKeys_ = other.preGroupedKeys();
       VELOX_CHECK_EQ(other.sources().size(), 1);
       source_ = other.sources()[0];
     }
@@ -5277,6 +5328,12 @@ class RowNumberNode : public PlanNode {
       return *this;
     }
 
+    Builder& preGroupedKeys(
+        std::vector<FieldAccessTypedExprPtr> preGroupedKeys) {
+      preGroupedKeys_ = std::move(preGroupedKeys);
+      return *this;
+    }
+
     Builder& source(PlanNodePtr source) {
       source_ = std::move(source);
       return *this;
@@ -5297,6 +5354,7 @@ class RowNumberNode : public PlanNode {
           partitionKeys_.value(),
           rowNumberColumnName_.value(),
           limit_.value(),
+          preGroupedKeys_,
           source_.value());
     }
 
@@ -5305,6 +5363,7 @@ class RowNumberNode : public PlanNode {
     std::optional<std::vector<FieldAccessTypedExprPtr>> partitionKeys_;
     std::optional<std::optional<std::string>> rowNumberColumnName_;
     std::optional<std::optional<int32_t>> limit_;
+    std::vector<FieldAccessTypedExprPtr> preGroupedKeys_;
     std::optional<PlanNodePtr> source_;
   };
 
@@ -5320,13 +5379,25 @@ class RowNumberNode : public PlanNode {
   }
 
   bool canSpill(const QueryConfig& queryConfig) const override {
-    return !partitionKeys_.empty() && queryConfig.rowNumberSpillEnabled();
+    return !partitionKeys_.empty() && !isPreGrouped() &&
+        queryConfig.rowNumberSpillEnabled();
   }
 
   const std::vector<FieldAccessTypedExprPtr>& partitionKeys() const {
     return partitionKeys_;
   }
 
+  const std::vector<FieldAccessTypedExprPtr>& preGroupedKeys() const {
+    return preGroupedKeys_;
+  }
+
+  /// Returns true if the input is clustered on all partition keys, so that
+  /// row numbers can be assigned by comparing consecutive rows.
+  bool isPreGrouped() const {
+    return !preGroupedKeys_.empty() &&
+        preGroupedKeys_.size() == partitionKeys_.size();
+  }
+
   std::optional<int32_t> limit() const {
     return limit_;
   }
@@ -5350,6 +5421,8 @@ class RowNumberNode : public PlanNode {
 
   const std::optional<int32_t> limit_;
 
+  const std::vector<FieldAccessTypedExprPtr> preGroupedKeys_;
+
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
@@ -5361,13 +5434,16 @@ using RowNumberNodePtr = std::shared_ptr<const RowNumberNode>;
 /// The result is put in a new markerName column alongside the original input.
 /// @param markerName Name of the output mask channel.
 /// @param distinctKeys Names of grouping keys.
-/// column.
+/// @param preGroupedKeys Subset of distinctKeys that input is already
+/// clustered on. When equal to distinctKeys, a streaming implementation is
+/// used that compares consecutive rows instead of using a hash table.
 class MarkDistinctNode : public PlanNode {
  public:
   MarkDistinctNode(
       PlanNodeId id,
       std::string markerName,
       std::vector<FieldAccessTypedExprPtr> distinctKeys,
+      std::vector<FieldAccessTypedExprPtr> preGroupedKeys,
       PlanNodePtr source);
 
   class Builder {
@@ -5378,6 +5454,7 @@ class MarkDistinctNode : public PlanNode {
       id_ = other.id();
       markerName_ = other.markerName();
       distinctKeys_ = other.distinctKeys();
+      preGroupedKeys_ = other.preGroupedKeys();
       VELOX_CHECK_EQ(other.sources().size(), 1);
       source_ = other.sources()[0];
     }
@@ -5397,6 +5474,12 @@ class MarkDistinctNode : public PlanNode {
       return *this;
     }
 
+    Builder& preGroupedKeys(
+        std::vector<FieldAccessTypedExprPtr> preGroupedKeys) {
+      preGroupedKeys_ = std::move(preGroupedKeys);
+      return *this;
+    }
+
     Builder& source(PlanNodePtr source) {
       source_ = std::move(source);
       return *this;
@@ -5416,6 +5499,7 @@ class MarkDistinctNode : public PlanNode {
           id_.value(),
           markerName_.value(),
           distinctKeys_.value(),
+          preGroupedKeys_,
           source_.value());
     }
 
@@ -5423,6 +5507,7 @@ class MarkDistinctNode : public PlanNode {
     std::optional<PlanNodeId> id_;
     std::optional<std::string> markerName_;
     std::optional<std::vector<FieldAccessTypedExprPtr>> distinctKeys_;
+    std::vector<FieldAccessTypedExprPtr> preGroupedKeys_;
     std::optional<PlanNodePtr> source_;
   };
 
@@ -5444,7 +5529,7 @@ class MarkDistinctNode : public PlanNode {
   }
 
   bool canSpill(const QueryConfig& queryConfig) const override {
-    return queryConfig.markDistinctSpillEnabled();
+    return !isPreGrouped() && queryConfig.markDistinctSpillEnabled();
   }
 
   const std::string& markerName() const {
@@ -5455,6 +5540,16 @@ class MarkDistinctNode : public PlanNode {
     return distinctKeys_;
   }
 
+  const std::vector<FieldAccessTypedExprPtr>& preGroupedKeys() const {
+    return preGroupedKeys_;
+  }
+
+  /// Returns true if the input is clustered on all distinct keys, so that
+  /// distinct rows can be marked by comparing consecutive rows.
+  bool isPreGrouped() const {
+    return preGroupedKeys_.size() == distinctKeys_.size();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -5466,6 +5561,8 @@ class MarkDistinctNode : public PlanNode {
 
   const std::vector<FieldAccessTypedExprPtr> distinctKeys_;
 
+  const std::vector<FieldAccessTypedExprPtr> preGroupedKeys_;
+
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
@@ -74,6 +74,20 @@ class QueryConfig {
   static constexpr const char* kExprEvalFlatNoNulls =
       "expression.eval_flat_no_nulls";
 
+  /// Whether to evaluate trees of arithmetic functions and comparisons over
+  /// columns of one primitive type, e.g. 'a * 2 + b > c', in one loop without
+  /// intermediate vectors. False by default.
+  static constexpr const char* kExprFuseArithmetic =
+      "expression.fuse_arithmetic";
+
+  /// Maximum number of distinct input values for which an expression over a
+  /// single string column keeps its results across batches. Helps expensive
+  /// functions like regexp_extract() on columns with few distinct values.
+  /// The cache of an expression disables itself if less than half of the
+  /// lookups are hits. 0 disables the cache. 0 by default.
+  static constexpr const char* kExprValueCacheMaxEntries =
+      "expression.value_cache_max_entries";
+
   /// Whether to track CPU usage for individual expressions (supported by call
   /// and cast expressions). False by default. Can be expensive when processing
   /// small batches, e.g. < 10K rows.
@@ -105,6 +119,40 @@ class QueryConfig {
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to count CPU cycles, instructions, last level cache misses and
+  /// data TLB misses of the calls to individual operators with hardware
+  /// performance counters. Reported as runtime stats of the operators. False
+  /// by default. Costs a system call before and after each call and needs
+  /// access to Linux perf events.
+  static constexpr const char* kOperatorTrackPerfCounters =
+      "track_operator_perf_counters";
+
+  /// If positive, the tasks sample the stacks of the threads that run their
+  /// drivers every this many milliseconds of CPU time of the threads. The
+  /// samples are returned by Task::foldedStacks(). 0, the default, disables
+  /// the sampling.
+  static constexpr const char* kTaskStackSampleIntervalMs =
+      "task_stack_sample_interval_ms";
+
+  /// If positive, the tasks record up to this many timestamped memory
+  /// arbitration, reclaim, spill and restore events in a MemoryTimeline. 0,
+  /// the default, disables the timeline.
+  static constexpr const char* kTaskMemoryTimelineMaxEvents =
+      "task_memory_timeline_max_events";
+
+  /// If positive, the tasks keep the timing of this many of the slowest
+  /// splits of their table scans in SlowestSplits. 0, the default, keeps
+  /// none.
+  static constexpr const char* kTaskMaxSlowestSplits =
+      "task_max_slowest_splits";
+
+  /// If true, finished tasks record the row counts, hash table sizes and
+  /// partial aggregation outcomes of their plan nodes in the process-wide
+  /// ExecutionFeedback, and new tasks size their hash aggregations and decide
+  /// on abandoning partial aggregation from the records of equal plan nodes.
+  static constexpr const char* kExecutionFeedbackEnabled =
+      "execution_feedback_enabled";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -124,6 +172,12 @@ class QueryConfig {
   static constexpr const char* kExprMaxCompiledRegexes =
       "expression.max_compiled_regexes";
 
+  /// The most memory in bytes that a regular expression compiled from a
+  /// constant pattern uses for its program and DFA states. A match that needs
+  /// more DFA states falls back to a slower matcher.
+  static constexpr const char* kExprRegexMaxMemory =
+      "expression.regex_max_memory";
+
   /// Used for backpressure to block local exchange producers when the local
   /// exchange buffer reaches or exceeds this size.
   static constexpr const char* kMaxLocalExchangeBufferSize =
@@ -211,6 +265,63 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Percentage of the groups of a partial aggregation that a flush keeps in
+  /// the hash table instead of sending them to the final aggregation. The
+  /// kept groups are the ones that received the most input rows since the
+  /// previous flush. 0 flushes all groups.
+  static constexpr const char* kPartialAggregationRetainedGroupsPct =
+      "partial_aggregation_retained_groups_pct";
+
+  /// The max number of distinct values of a grouping key that a hash
+  /// aggregation tracks to map the key to small integer ids. Above this the
+  /// hash table falls back to hashing the keys. Raising it keeps group bys
+  /// with key cardinality above the default in the array or normalized key
+  /// modes, at the cost of a larger set of distinct values per key.
+  static constexpr const char* kAggregationMaxDistinctValueIds =
+      "aggregation_max_distinct_value_ids";
+
+  /// If true, a final hash aggregation that runs on multiple drivers without
+  /// an upstream local partitioning by the grouping keys aggregates in two
+  /// phases. Each driver first aggregates its own input. At the end of input
+  /// the drivers hash partition their groups by the grouping keys and each
+  /// driver merges one partition of the groups of all drivers. Not used if
+  /// spilling is enabled.
+  static constexpr const char* kParallelFinalAggregationEnabled =
+      "parallel_final_aggregation_enabled";
+
+  /// If true, a partial or single hash aggregation over a GroupId aggregates
+  /// the input of the GroupId once by the union of the grouping keys and then
+  /// derives each grouping set from these groups by merging their
+  /// intermediate results. The GroupId then does not copy the input once per
+  /// grouping set. Used only for aggregations without distinct, masked,
+  /// sorted or lambda aggregates and if spilling is not enabled.
+  static constexpr const char* kGroupingSetsRollupEnabled =
+      "grouping_sets_rollup_enabled";
+
+  /// If true, a partial OrderBy that runs on multiple drivers under a
+  /// LocalMerge with the same sorting keys merges the sorted rows of all
+  /// drivers in parallel. At the end of input the drivers split the keys into
+  /// ranges by sampled splitter keys and each driver merges one range of the
+  /// rows of all drivers. The LocalMerge then concatenates the driver outputs
+  /// instead of merging them. Not used if spilling is enabled.
+  static constexpr const char* kOrderByParallelMergeEnabled =
+      "order_by_parallel_merge_enabled";
+
+  /// The minimum number of rows of an output batch of a hash aggregation or
+  /// an OrderBy for extracting the columns of the batch from the rows in
+  /// parallel on the query executor, one column per task. 0 disables. Not
+  /// used if spilling is enabled.
+  static constexpr const char* kParallelOutputExtractionMinRows =
+      "parallel_output_extraction_min_rows";
+
+  /// If true, a hash aggregation in array hash mode reorders the rows of an
+  /// input batch so that the rows of each group are next to each other before
+  /// updating the aggregates. The aggregates then update each group once per
+  /// batch. Used only if all aggregates support it and the batch has several
+  /// rows per group.
+  static constexpr const char* kAggregationClusterRowsByGroupEnabled =
+      "aggregation_cluster_rows_by_group_enabled";
+
   /// Memory threshold in bytes for triggering string compaction during
   /// global aggregation. When total string storage exceeds this limit with
   /// high unused memory ratio, compaction is triggered to reclaim dead strings.
@@ -237,12 +348,35 @@ class QueryConfig {
   static constexpr const char* kAggregationMemoryCompactionReclaimEnabled =
       "aggregation_memory_compaction_reclaim_enabled";
 
+  /// If true, the variable width keys and accumulators of a hash aggregation
+  /// are allocated in append-only mode of HashStringAllocator, which has no
+  /// free lists and releases the memory of the groups only when the hash
+  /// table is cleared. Saves memory and CPU for aggregates that only grow
+  /// their accumulators, like array_agg, map_agg and approx_percentile, but
+  /// keeps the memory of replaced values, e.g. of min and max on strings.
+  /// Disabled by default.
+  static constexpr const char* kAggregationAppendOnlyAllocatorEnabled =
+      "aggregation_append_only_allocator_enabled";
+
+  /// If true, a hash aggregation with more than one aggregate over distinct
+  /// inputs de-duplicates the inputs of each such aggregate in one hash table
+  /// keyed on the group and the inputs instead of keeping a set of distinct
+  /// inputs per group. Uses much less memory with many small groups. Not used
+  /// for global aggregations or when spilling is enabled. Disabled by default.
+  static constexpr const char* kAggregationSharedDistinctHashTableEnabled =
+      "aggregation_shared_distinct_hash_table_enabled";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
   static constexpr const char* kAbandonPartialTopNRowNumberMinPct =
       "abandon_partial_topn_row_number_min_pct";
 
+  /// Maximum amount of memory in bytes for the rows kept by a partial
+  /// TopNRowNumber. The rows are flushed to the output when it is exceeded.
+  static constexpr const char* kMaxPartialTopNRowNumberMemory =
+      "max_partial_topn_row_number_memory";
+
   /// Number of input rows to receive before starting to check whether to
   /// abandon building a HashTable without duplicates in HashBuild for left
   /// semi/anti join.
@@ -255,6 +389,14 @@ class QueryConfig {
   static constexpr const char* kAbandonDedupHashMapMinPct =
       "abandon_dedup_hashmap_min_pct";
 
+  /// Opaque token identifying the version of the data the build sides of hash
+  /// joins read. If not empty, hash joins with 'useHashTableCache' set share
+  /// their tables with other queries that have the same token and an equal
+  /// build side plan. The application is responsible for changing the token
+  /// when the data changes. Empty means tables are only shared within a query.
+  static constexpr const char* kHashTableCacheCrossQueryVersion =
+      "hash_table_cache_cross_query_version";
+
   static constexpr const char* kMaxElementsSizeInRepeatAndSequence =
       "max_elements_size_in_repeat_and_sequence";
 
@@ -263,6 +405,31 @@ class QueryConfig {
   static constexpr const char* kPartitionedOutputEagerFlush =
       "partitioned_output_eager_flush";
 
+  /// If true, PartitionedOutput enqueues its rows as vectors instead of
+  /// serializing them, and Exchange copies the vectors into its own memory
+  /// pool. Only valid if all consumers of the output run in the same process
+  /// as the producer and fetch the pages with OutputBufferManager::getPages().
+  static constexpr const char* kPartitionedOutputVectorPages =
+      "partitioned_output_vector_pages";
+
+  /// If true, PartitionedOutput with the Presto serde and more than one
+  /// destination serializes each input batch a column at a time across all
+  /// destinations, instead of a destination at a time. This reads each column
+  /// once per batch instead of once per destination, which matters with many
+  /// destinations and few rows per destination.
+  static constexpr const char* kPartitionedOutputScatterSerialization =
+      "partitioned_output_scatter_serialization";
+
+  /// If non-zero, PartitionedOutput with at least this many destinations
+  /// buffers its input up to kMaxPartitionedOutputBufferSize bytes, sorts the
+  /// buffered rows by destination and serializes the rows of each destination
+  /// as one run of pages. Only one destination has a page in progress at a
+  /// time, so the memory does not grow with the number of destinations and the
+  /// pages are not limited to kMaxPartitionedOutputBufferSize / number of
+  /// destinations. 0 disables the sorted runs.
+  static constexpr const char* kPartitionedOutputSortMinDestinations =
+      "partitioned_output_sort_min_destinations";
+
   /// The maximum number of bytes to buffer in PartitionedOutput operator to
   /// avoid creating tiny SerializedPages.
   ///
@@ -279,6 +446,14 @@ class QueryConfig {
   /// OutputBufferManager::kContinuePct % of this.
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// If true, a partitioned output buffer that reaches kMaxOutputBufferSize
+  /// writes further serialized pages to a file in the task's spill directory
+  /// instead of blocking the producers. The pages are read back in order when
+  /// the consumers fetch them. Has no effect if the task has no spill
+  /// directory.
+  static constexpr const char* kOutputBufferSpillEnabled =
+      "output_buffer_spill_enabled";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -346,6 +521,13 @@ class QueryConfig {
   static constexpr const char* kMixedGroupedModeHashJoinSpillEnabled =
       "mixed_grouped_mode_hash_join_spill_enabled";
 
+  /// If true and the hash join build has spilled, the build reads back as
+  /// many of the spilled partitions as fit in memory before handing the table
+  /// to the probe. The probe joins the rows of these partitions in memory and
+  /// only spills the rows of the partitions that stay on disk.
+  static constexpr const char* kHashJoinHybridSpillEnabled =
+      "hash_join_hybrid_spill_enabled";
+
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
@@ -412,6 +594,28 @@ class QueryConfig {
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// If true, spill files store each column of a spilled batch as a separate
+  /// compressed page with a checksum, preserving dictionary and constant
+  /// encodings. Readers can then skip the columns they do not need.
+  static constexpr const char* kSpillColumnarFormatEnabled =
+      "spill_columnar_format_enabled";
+
+  /// If true, the readers of spill files read the next read buffer of each
+  /// file on the spill executor while the current buffer is consumed. This
+  /// hides the read latency of the spill storage when restoring spilled data,
+  /// at the cost of a second read buffer per spill file.
+  static constexpr const char* kSpillReadAheadEnabled =
+      "spill_read_ahead_enabled";
+
+  /// If true, the pages of each spilled partition are compressed with a ZSTD
+  /// dictionary trained from its first pages. The dictionary is stored once
+  /// at the start of each spill file. Small pages compress much better than
+  /// with 'spill_compression_codec' which compresses each page on its own.
+  /// Ignored with 'spill_columnar_format_enabled' or if Velox is built
+  /// without ZSTD.
+  static constexpr const char* kSpillDictionaryCompressionEnabled =
+      "spill_dictionary_compression_enabled";
+
   /// The max number of files to merge at a time when merging sorted files into
   /// a single ordered stream. 0 means unlimited. This is used to reduce memory
   /// pressure by capping the number of open files when merging spilled sorted
@@ -576,6 +780,20 @@ class QueryConfig {
   static constexpr const char* kHashProbeStringDynamicFilterPushdownEnabled =
       "hash_probe_string_dynamic_filter_pushdown_enabled";
 
+  /// If true, hash probe outputs the build side columns as dictionaries over
+  /// the distinct build rows of an output batch when these repeat, e.g. for
+  /// skewed keys with many matches on both sides. The values of each build row
+  /// are then copied once per batch instead of once per output row.
+  static constexpr const char* kHashProbeDictionaryBuildOutputEnabled =
+      "hash_probe_dictionary_build_output_enabled";
+
+  /// Whether TopN and TopNRowNumber without partition keys push a filter on
+  /// the first sorting key that drops the rows after their current cutoff to
+  /// the source of the pipeline once they have as many rows as their limit.
+  /// Disabled by default.
+  static constexpr const char* kTopNDynamicFilterPushdownEnabled =
+      "topn_dynamic_filter_pushdown_enabled";
+
   /// The maximum byte size of Bloom filter that can be generated from hash
   /// probe.  When set to 0, no Bloom filter will be generated.  To achieve
   /// optimal performance, this should not be too larger than the CPU cache size
@@ -583,11 +801,37 @@ class QueryConfig {
   static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
       "hash_probe_bloom_filter_pushdown_max_size";
 
+  /// Number of values a table scan tests with a Bloom filter pushed down from
+  /// hash probe before it checks the fraction of values the filter passes.
+  /// The check repeats after each such number of values. When set to 0, the
+  /// filter is never turned off.
+  static constexpr const char* kHashProbeBloomFilterMinRowsToDisable =
+      "hash_probe_bloom_filter_min_rows_to_disable";
+
+  /// A table scan turns off a Bloom filter pushed down from hash probe if the
+  /// filter passes more than this percentage of the tested values.
+  static constexpr const char* kHashProbeBloomFilterMaxPassPct =
+      "hash_probe_bloom_filter_max_pass_pct";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// Size in bytes of the hash table ranges that a parallel hash join build
+  /// inserts one at a time. Each build thread sorts its rows by range before
+  /// inserting them, so that the random writes of the inserts stay within a
+  /// range that fits in the CPU cache. 0 disables this. Set to a fraction of
+  /// the per-core cache size.
+  static constexpr const char* kJoinBuildRadixPartitionBytes =
+      "join_build_radix_partition_bytes";
+
+  /// If true, the hash join build keeps one copy of equal non-inline strings
+  /// in the build side keys and dependent columns. Saves memory when the build
+  /// side has many repeated strings, at the cost of a hash lookup per string.
+  static constexpr const char* kJoinBuildInternStrings =
+      "join_build_intern_strings";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -615,18 +859,37 @@ class QueryConfig {
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Number of queued table scan splits looked at for one with data in the
+  /// local caches when a driver takes a split. The first such split is handed
+  /// out ahead of the splits queued before it. 0 hands out splits in arrival
+  /// order.
+  static constexpr const char* kCachedSplitLookahead =
+      "cached_split_lookahead";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// Weight of the query in the CPU scheduling of a DriverExecutor. A query
+  /// with weight N gets N times as much CPU time before its Drivers move to a
+  /// lower priority level.
+  static constexpr const char* kQuerySchedulingWeight =
+      "query_scheduling_weight";
+
   /// Window operator can be configured to sub-divide window partitions on each
   /// thread of execution into groups of partitions for sequential processing.
   /// This setting specifies how many sub-partitions to create for each thread.
   static constexpr const char* kWindowNumSubPartitions =
       "window_num_sub_partitions";
 
+  /// Number of output batches of small window partitions that the Window
+  /// operator evaluates in parallel on the query executor. Applies to the
+  /// sort based window build without spilling. Use 0 or 1 to disable.
+  static constexpr const char* kWindowParallelEvaluationBatches =
+      "window_parallel_evaluation_batches";
+
   /// Maximum number of bytes to use for the normalized key in prefix-sort. Use
   /// 0 to disable prefix-sort.
   static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
@@ -763,6 +1026,24 @@ class QueryConfig {
   static constexpr const char* kScaleWriterMinProcessedBytesRebalanceThreshold =
       "scaled_writer_min_processed_bytes_rebalance_threshold";
 
+  /// The min ratio of writer throughput gain from the last added writer to
+  /// keep scaling up writers by the unpartitioned scale writer exchange. If the
+  /// throughput measured from the writer queue drain rate after adding a
+  /// writer doesn't improve by this ratio, the table sink is considered as the
+  /// bottleneck: the last added writer is removed and no more writers are
+  /// added, which avoids producing more and smaller files without speeding up
+  /// the write. Zero disables the throughput check.
+  static constexpr const char* kScaleWriterMinThroughputGainRatio =
+      "scaled_writer_min_throughput_gain_ratio";
+
+  /// If the buffered bytes of the unpartitioned scale writer exchange drop
+  /// below this ratio of the max buffer size after the writers have processed
+  /// enough data since the last scaling, the exchange stops sending data to
+  /// the last added writer to produce fewer and larger files. The value is in
+  /// the range of [0, 0.5). Zero disables the writer scale down.
+  static constexpr const char* kScaleWriterScaleDownBufferUsageRatio =
+      "scaled_writer_scale_down_buffer_usage_ratio";
+
   /// If true, enables the scaled table scan processing. For each table scan
   /// plan node, a scan controller is used to control the number of running scan
   /// threads based on the query memory usage. It keeps increasing the number of
@@ -786,6 +1067,19 @@ class QueryConfig {
   static constexpr const char* kShuffleCompressionKind =
       "shuffle_compression_codec";
 
+  /// If true, PartitionedOutput with the Presto serde keeps constant and
+  /// dictionary encoded columns encoded on the wire as RLE and DICTIONARY,
+  /// instead of flattening them.
+  static constexpr const char* kShufflePreserveEncodings =
+      "shuffle_preserve_encodings";
+
+  /// If true, the PartitionedOutput operator with the Presto serde compresses
+  /// each column of a page on its own with 'shuffle_compression_codec'.
+  /// Columns that do not compress are sent uncompressed. The pages can only be
+  /// read by Velox.
+  static constexpr const char* kShuffleColumnCompression =
+      "shuffle_column_compression";
+
   /// If a key is found in multiple given maps, by default that key's value in
   /// the resulting map comes from the last one of those maps. When true, throw
   /// exception on duplicate map key.
@@ -803,6 +1097,21 @@ class QueryConfig {
   static constexpr const char* kIndexLookupJoinSplitOutput =
       "index_lookup_join_split_output";
 
+  /// If true, the index join operator starts with one prefetched input batch
+  /// and adapts the number of lookups in flight to the observed lookup
+  /// latency, up to 'index_lookup_join_max_prefetch_batches'. It adds a batch
+  /// when it has to wait for a lookup with all batches in flight, and removes
+  /// one when all lookups in flight have completed.
+  static constexpr const char* kIndexLookupJoinAdaptivePrefetch =
+      "index_lookup_join_adaptive_prefetch";
+
+  /// If true and 'index_lookup_join_split_output' is false, the index join
+  /// operator sends each distinct lookup key of an input batch to the index
+  /// source only once and copies the results to the probe rows with the same
+  /// key.
+  static constexpr const char* kIndexLookupJoinDedupKeys =
+      "index_lookup_join_dedup_keys";
+
   // Max wait time for exchange request in seconds.
   static constexpr const char* kRequestDataSizesMaxWaitSec =
       "request_data_sizes_max_wait_sec";
@@ -830,6 +1139,13 @@ class QueryConfig {
   static constexpr const char* kExchangeLazyFetchingEnabled =
       "exchange_lazy_fetching_enabled";
 
+  /// If true, exchange clients limit the bytes queued and in flight by a
+  /// credit that adapts to how fast the consumers take the data, up to
+  /// max_exchange_buffer_size, and give each producing source an even share of
+  /// the credit per request.
+  static constexpr const char* kExchangeFlowControlEnabled =
+      "exchange_flow_control_enabled";
+
   /// If this is true, then it allows you to get the struct field names
   /// as json element names when casting a row to json.
   static constexpr const char* kFieldNamesInJsonCastEnabled =
@@ -968,6 +1284,34 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t partialAggregationRetainedGroupsPct() const {
+    return get<int32_t>(kPartialAggregationRetainedGroupsPct, 0);
+  }
+
+  int32_t aggregationMaxDistinctValueIds() const {
+    return get<int32_t>(kAggregationMaxDistinctValueIds, 100'000);
+  }
+
+  bool parallelFinalAggregationEnabled() const {
+    return get<bool>(kParallelFinalAggregationEnabled, false);
+  }
+
+  bool groupingSetsRollupEnabled() const {
+    return get<bool>(kGroupingSetsRollupEnabled, false);
+  }
+
+  bool orderByParallelMergeEnabled() const {
+    return get<bool>(kOrderByParallelMergeEnabled, false);
+  }
+
+  uint32_t parallelOutputExtractionMinRows() const {
+    return get<uint32_t>(kParallelOutputExtractionMinRows, 0);
+  }
+
+  bool aggregationClusterRowsByGroupEnabled() const {
+    return get<bool>(kAggregationClusterRowsByGroupEnabled, false);
+  }
+
   uint64_t aggregationCompactionBytesThreshold() const {
     return get<uint64_t>(kAggregationCompactionBytesThreshold, 0);
   }
@@ -980,6 +1324,14 @@ class QueryConfig {
     return get<bool>(kAggregationMemoryCompactionReclaimEnabled, false);
   }
 
+  bool aggregationAppendOnlyAllocatorEnabled() const {
+    return get<bool>(kAggregationAppendOnlyAllocatorEnabled, false);
+  }
+
+  bool aggregationSharedDistinctHashTableEnabled() const {
+    return get<bool>(kAggregationSharedDistinctHashTableEnabled, false);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -988,6 +1340,12 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinPct, 80);
   }
 
+  uint64_t maxPartialTopNRowNumberMemory() const {
+    return config::toCapacity(
+        get<std::string>(kMaxPartialTopNRowNumberMemory, "16MB"),
+        config::CapacityUnit::BYTE);
+  }
+
   int32_t abandonHashBuildDedupMinRows() const {
     return get<int32_t>(kAbandonDedupHashMapMinRows, 100'000);
   }
@@ -996,6 +1354,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonDedupHashMapMinPct, 0);
   }
 
+  std::string hashTableCacheCrossQueryVersion() const {
+    return get<std::string>(kHashTableCacheCrossQueryVersion, "");
+  }
+
   int32_t maxElementsSizeInRepeatAndSequence() const {
     return get<int32_t>(kMaxElementsSizeInRepeatAndSequence, 10'000);
   }
@@ -1014,6 +1376,18 @@ class QueryConfig {
     return get<bool>(kPartitionedOutputEagerFlush, false);
   }
 
+  bool partitionedOutputVectorPages() const {
+    return get<bool>(kPartitionedOutputVectorPages, false);
+  }
+
+  bool partitionedOutputScatterSerialization() const {
+    return get<bool>(kPartitionedOutputScatterSerialization, false);
+  }
+
+  uint32_t partitionedOutputSortMinDestinations() const {
+    return get<uint32_t>(kPartitionedOutputSortMinDestinations, 0);
+  }
+
   uint64_t maxPartitionedOutputBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
@@ -1024,6 +1398,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
   }
 
+  bool outputBufferSpillEnabled() const {
+    return get<bool>(kOutputBufferSpillEnabled, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
@@ -1141,6 +1519,12 @@ class QueryConfig {
     return get<uint64_t>(kExprMaxCompiledRegexes, 100);
   }
 
+  uint64_t exprRegexMaxMemory() const {
+    return config::toCapacity(
+        get<std::string>(kExprRegexMaxMemory, "8MB"),
+        config::CapacityUnit::BYTE);
+  }
+
   bool adjustTimestampToTimezone() const {
     return get<bool>(kAdjustTimestampToTimezone, false);
   }
@@ -1163,6 +1547,14 @@ class QueryConfig {
     return get<bool>(kExprEvalFlatNoNulls, true);
   }
 
+  bool exprFuseArithmetic() const {
+    return get<bool>(kExprFuseArithmetic, false);
+  }
+
+  int32_t exprValueCacheMaxEntries() const {
+    return get<int32_t>(kExprValueCacheMaxEntries, 0);
+  }
+
   bool parallelOutputJoinBuildRowsEnabled() const {
     return get<bool>(kParallelOutputJoinBuildRowsEnabled, false);
   }
@@ -1183,6 +1575,10 @@ class QueryConfig {
     return get<bool>(kMixedGroupedModeHashJoinSpillEnabled, false);
   }
 
+  bool hashJoinHybridSpillEnabled() const {
+    return get<bool>(kHashJoinHybridSpillEnabled, false);
+  }
+
   bool orderBySpillEnabled() const {
     return get<bool>(kOrderBySpillEnabled, true);
   }
@@ -1251,6 +1647,18 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  bool spillColumnarFormatEnabled() const {
+    return get<bool>(kSpillColumnarFormatEnabled, false);
+  }
+
+  bool spillReadAheadEnabled() const {
+    return get<bool>(kSpillReadAheadEnabled, false);
+  }
+
+  bool spillDictionaryCompressionEnabled() const {
+    return get<bool>(kSpillDictionaryCompressionEnabled, false);
+  }
+
   uint32_t spillNumMaxMergeFiles() const {
     constexpr uint32_t kDefaultMergeFiles = 0;
     return get<uint32_t>(kSpillNumMaxMergeFiles, kDefaultMergeFiles);
@@ -1395,6 +1803,26 @@ class QueryConfig {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackPerfCounters() const {
+    return get<bool>(kOperatorTrackPerfCounters, false);
+  }
+
+  uint32_t taskStackSampleIntervalMs() const {
+    return get<uint32_t>(kTaskStackSampleIntervalMs, 0);
+  }
+
+  uint32_t taskMemoryTimelineMaxEvents() const {
+    return get<uint32_t>(kTaskMemoryTimelineMaxEvents, 0);
+  }
+
+  uint32_t taskMaxSlowestSplits() const {
+    return get<uint32_t>(kTaskMaxSlowestSplits, 0);
+  }
+
+  bool executionFeedbackEnabled() const {
+    return get<bool>(kExecutionFeedbackEnabled, false);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -1416,14 +1844,38 @@ class QueryConfig {
     return get<bool>(kHashProbeStringDynamicFilterPushdownEnabled, false);
   }
 
+  bool hashProbeDictionaryBuildOutputEnabled() const {
+    return get<bool>(kHashProbeDictionaryBuildOutputEnabled, false);
+  }
+
+  bool topNDynamicFilterPushdownEnabled() const {
+    return get<bool>(kTopNDynamicFilterPushdownEnabled, false);
+  }
+
   uint64_t hashProbeBloomFilterPushdownMaxSize() const {
     return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
   }
 
+  uint64_t hashProbeBloomFilterMinRowsToDisable() const {
+    return get<uint64_t>(kHashProbeBloomFilterMinRowsToDisable, 100'000);
+  }
+
+  int32_t hashProbeBloomFilterMaxPassPct() const {
+    return get<int32_t>(kHashProbeBloomFilterMaxPassPct, 80);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t joinBuildRadixPartitionBytes() const {
+    return get<uint64_t>(kJoinBuildRadixPartitionBytes, 0);
+  }
+
+  bool joinBuildInternStrings() const {
+    return get<bool>(kJoinBuildInternStrings, false);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -1452,14 +1904,26 @@ class QueryConfig {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  int32_t cachedSplitLookahead() const {
+    return get<int32_t>(kCachedSplitLookahead, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  int32_t querySchedulingWeight() const {
+    return get<int32_t>(kQuerySchedulingWeight, 1);
+  }
+
   uint32_t windowNumSubPartitions() const {
     return get<uint32_t>(kWindowNumSubPartitions, 1);
   }
 
+  uint32_t windowParallelEvaluationBatches() const {
+    return get<uint32_t>(kWindowParallelEvaluationBatches, 0);
+  }
+
   uint32_t prefixSortNormalizedKeyMaxBytes() const {
     return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
   }
@@ -1490,6 +1954,14 @@ class QueryConfig {
         kScaleWriterMinProcessedBytesRebalanceThreshold, 256 << 20);
   }
 
+  double scaleWriterMinThroughputGainRatio() const {
+    return get<double>(kScaleWriterMinThroughputGainRatio, 0.0);
+  }
+
+  double scaleWriterScaleDownBufferUsageRatio() const {
+    return get<double>(kScaleWriterScaleDownBufferUsageRatio, 0.0);
+  }
+
   bool tableScanScaledProcessingEnabled() const {
     return get<bool>(kTableScanScaledProcessingEnabled, false);
   }
@@ -1506,10 +1978,26 @@ class QueryConfig {
     return get<bool>(kIndexLookupJoinSplitOutput, true);
   }
 
+  bool indexLookupJoinAdaptivePrefetch() const {
+    return get<bool>(kIndexLookupJoinAdaptivePrefetch, false);
+  }
+
+  bool indexLookupJoinDedupKeys() const {
+    return get<bool>(kIndexLookupJoinDedupKeys, false);
+  }
+
   std::string shuffleCompressionKind() const {
     return get<std::string>(kShuffleCompressionKind, "none");
   }
 
+  bool shufflePreserveEncodings() const {
+    return get<bool>(kShufflePreserveEncodings, false);
+  }
+
+  bool shuffleColumnCompression() const {
+    return get<bool>(kShuffleColumnCompression, false);
+  }
+
   int32_t requestDataSizesMaxWaitSec() const {
     return get<int32_t>(kRequestDataSizesMaxWaitSec, 10);
   }
@@ -1535,6 +2023,10 @@ class QueryConfig {
     return get<bool>(kExchangeLazyFetchingEnabled, false);
   }
 
+  bool exchangeFlowControlEnabled() const {
+    return get<bool>(kExchangeFlowControlEnabled, false);
+  }
+
   bool isFieldNamesInJsonCastEnabled() const {
     return get<bool>(kFieldNamesInJsonCastEnabled, false);
   }
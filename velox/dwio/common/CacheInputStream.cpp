@@ -16,6 +16,8 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -29,6 +31,23 @@ using velox::cache::ScanTracker;
 using velox::cache::TrackingId;
 using velox::memory::MemoryAllocator;
 
+namespace {
+// Keeps a cache entry pinned for the lifetime of a BufferView over its data.
+class CachePinReleaser {
+ public:
+  explicit CachePinReleaser(const cache::CachePin& pin) : pin_(pin) {}
+
+  void addRef() const {}
+
+  void release() {
+    pin_.clear();
+  }
+
+ private:
+  cache::CachePin pin_;
+};
+} // namespace
+
 CacheInputStream::CacheInputStream(
     CachedBufferedInput* bufferedInput,
     IoStatistics* ioStats,
@@ -127,6 +146,14 @@ bool CacheInputStream::Next(const void** buffer, int32_t* size) {
   return true;
 }
 
+BufferPtr CacheInputStream::pinnedBuffer() {
+  if (pin_.empty() || pin_.checkedEntry()->isExclusive() || run_ == nullptr) {
+    return nullptr;
+  }
+  return BufferView<CachePinReleaser>::create(
+      run_, runSize_, CachePinReleaser(pin_));
+}
+
 void CacheInputStream::BackUp(int32_t count) {
   VELOX_CHECK_GE(count, 0, "can't backup negative distances");
 
@@ -230,6 +257,9 @@ void CacheInputStream::loadSync(const Region& region) {
     // missed, fall back to remote fetching.
     entry->setGroupId(groupId_);
     entry->setTrackingId(trackingId_);
+    if (tracker_ != nullptr) {
+      entry->setReadPct(tracker_->readPct(trackingId_));
+    }
     if (loadFromSsd(region, *entry)) {
       return;
     }
@@ -346,8 +376,11 @@ void CacheInputStream::loadPosition() {
       ioStats_->queryThreadIoLatencyUs().increment(loadUs);
       if (load->isSsdLoad()) {
         ioStats_->coalescedSsdLoadLatencyUs().increment(loadUs);
+        RECORD_QUANTILE_STAT_VALUE(kMetricCoalescedSsdLoadLatencyUs, loadUs);
       } else {
         ioStats_->coalescedStorageLoadLatencyUs().increment(loadUs);
+        RECORD_QUANTILE_STAT_VALUE(
+            kMetricCoalescedStorageLoadLatencyUs, loadUs);
       }
     }
 
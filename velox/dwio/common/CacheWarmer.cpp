@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/CacheWarmer.h"
+
+#include <thread>
+
+#include "velox/dwio/common/CachedBufferedInput.h"
+
+namespace facebook::velox::dwio::common {
+
+CacheWarmer::CacheWarmer(
+    cache::AsyncDataCache* cache,
+    memory::MemoryPool* pool,
+    Options options)
+    : cache_(cache),
+      options_(options),
+      readerOptions_(pool),
+      ioStatistics_(std::make_shared<io::IoStatistics>()),
+      startTime_(std::chrono::steady_clock::now()) {
+  VELOX_CHECK_NOT_NULL(cache_, "CacheWarmer requires a cache");
+}
+
+bool CacheWarmer::warm(
+    std::shared_ptr<ReadFile> file,
+    const StringIdLease& fileNum,
+    const StringIdLease& groupId,
+    const std::vector<velox::common::Region>& regions) {
+  // No tracker, so that warming does not count as references to the streams,
+  // and no executor, so that the loads run on this thread.
+  CachedBufferedInput input(
+      std::move(file),
+      MetricsLog::voidLog(),
+      fileNum,
+      cache_,
+      nullptr,
+      groupId,
+      ioStatistics_,
+      nullptr,
+      nullptr,
+      readerOptions_);
+  bool complete{true};
+  std::vector<std::unique_ptr<SeekableInputStream>> streams;
+  streams.reserve(regions.size());
+  for (auto i = 0; i < regions.size(); ++i) {
+    const auto& region = regions[i];
+    if (!input.shouldPreload(
+            memory::AllocationTraits::numPages(region.length))) {
+      for (auto j = i; j < regions.size(); ++j) {
+        stats_.skippedBytes += regions[j].length;
+      }
+      complete = false;
+      break;
+    }
+    streams.push_back(input.enqueue(region, nullptr));
+  }
+  input.load(LogType::FILE);
+
+  const void* data;
+  int32_t size;
+  for (auto& stream : streams) {
+    while (stream->Next(&data, &size)) {
+      stats_.warmedBytes += size;
+      throttle();
+    }
+  }
+  return complete;
+}
+
+void CacheWarmer::throttle() {
+  if (options_.maxBytesPerSecond == 0) {
+    return;
+  }
+  const auto targetUs =
+      stats_.warmedBytes * 1'000'000 / options_.maxBytesPerSecond;
+  const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - startTime_)
+                             .count();
+  if (targetUs > elapsedUs) {
+    std::this_thread::sleep_for(
+        std::chrono::microseconds(targetUs - elapsedUs));
+    stats_.throttledUs += targetUs - elapsedUs;
+  }
+}
+
+} // namespace facebook::velox::dwio::common
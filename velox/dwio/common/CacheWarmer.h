@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/StringIdMap.h"
+#include "velox/common/file/File.h"
+#include "velox/common/file/Region.h"
+#include "velox/common/io/IoStatistics.h"
+#include "velox/common/io/Options.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Loads declared hot ranges of files into AsyncDataCache ahead of queries, so
+/// that a freshly started worker does not serve its first queries from
+/// storage. The ranges are typically the column streams of the hot row groups
+/// of a table, as recorded from the file metadata by the caller. Data reaches
+/// SsdCache through the usual write-behind of AsyncDataCache.
+///
+/// Warming runs on the calling thread, which should be a background thread.
+/// It yields to foreground queries by stopping as soon as the cache has no
+/// free space and half of it is already held by data that has been read
+/// ahead but not yet accessed.
+class CacheWarmer {
+ public:
+  struct Options {
+    /// Upper bound on the bytes read from storage per second. 0 means no
+    /// limit.
+    uint64_t maxBytesPerSecond{0};
+  };
+
+  struct Stats {
+    /// Bytes of the requested ranges that were read through the cache.
+    uint64_t warmedBytes{0};
+
+    /// Bytes of the requested ranges that were not read because the cache
+    /// had no room for them.
+    uint64_t skippedBytes{0};
+
+    /// Time spent sleeping to stay under 'maxBytesPerSecond'.
+    uint64_t throttledUs{0};
+  };
+
+  CacheWarmer(
+      cache::AsyncDataCache* cache,
+      memory::MemoryPool* pool,
+      Options options);
+
+  /// Reads 'regions' of 'file' into the cache. 'fileNum' and 'groupId' must be
+  /// the ids scans use for the file, e.g. FileHandle::uuid and
+  /// FileHandle::groupId, and each region must start at the offset of a
+  /// stream as the reader enqueues it, otherwise the cache entries are never
+  /// hit. Returns false if warming stopped early because the cache is full.
+  bool warm(
+      std::shared_ptr<ReadFile> file,
+      const StringIdLease& fileNum,
+      const StringIdLease& groupId,
+      const std::vector<velox::common::Region>& regions);
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+  /// IO statistics of the loads issued by this, e.g. the bytes that were
+  /// already in memory or on SSD.
+  io::IoStatistics& ioStatistics() const {
+    return *ioStatistics_;
+  }
+
+ private:
+  // Sleeps as long as needed for the bytes warmed so far to stay within
+  // 'maxBytesPerSecond'.
+  void throttle();
+
+  cache::AsyncDataCache* const cache_;
+  const Options options_;
+  const io::ReaderOptions readerOptions_;
+  const std::shared_ptr<io::IoStatistics> ioStatistics_;
+  const std::chrono::steady_clock::time_point startTime_;
+
+  Stats stats_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -242,12 +242,20 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
     const int loadIndex =
         (prefetchAnyway || isPrefetchPct(adjustedReadPct(trackingData))) ? 1
                                                                          : 0;
+    // The read percentage is not known before the stream has been referenced
+    // once.
+    const int32_t readPct =
+        trackingData.referencedBytes > trackingData.lastReferencedBytes
+        ? adjustedReadPct(trackingData)
+        : 100;
     auto parts = makeRequestParts(
         request, trackingData, options_.loadQuantum(), extraRequests);
     for (auto part : parts) {
       if (cache_->exists(part->key)) {
+        recordAttribution(cache::CacheAttribution::Event::kRamHit, *part);
         continue;
       }
+      part->readPct = readPct;
       if (ssdFile != nullptr) {
         part->ssdPin = ssdFile->find(part->key);
         if (!part->ssdPin.empty() && part->ssdPin.run().size() < part->size) {
@@ -256,10 +264,12 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
           part->ssdPin.clear();
         }
         if (!part->ssdPin.empty()) {
+          recordAttribution(cache::CacheAttribution::Event::kSsdHit, *part);
           ssdLoad[loadIndex].push_back(part);
           continue;
         }
       }
+      recordAttribution(cache::CacheAttribution::Event::kMiss, *part);
       storageLoad[loadIndex].push_back(part);
     }
   }
@@ -294,7 +304,7 @@ std::vector<int32_t> CachedBufferedInput::groupRequests(
   if (requests.empty() || (requests.size() < 2 && !prefetch)) {
     return {};
   }
-  const int32_t maxDistance = kSsd ? 20'000 : options_.maxCoalesceDistance();
+  const int32_t maxDistance = kSsd ? 20'000 : options_.coalesceDistance();
 
   // Combine adjacent short reads.
   int64_t coalescedBytes = 0;
@@ -429,7 +439,8 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<velox::IoStats> ioStats,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
+      int32_t maxCoalesceDistance,
+      std::shared_ptr<io::IoLatencyModel> latencyModel)
       : DwioCoalescedLoadBase(
             cache,
             std::move(ioStatistics),
@@ -437,7 +448,8 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             groupId,
             std::move(requests)),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        latencyModel_(std::move(latencyModel)) {}
 
   bool isSsdLoad() const override {
     return false;
@@ -449,10 +461,13 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     cache_.makePins(
         keys_,
         [&](int32_t index) { return sizes_[index]; },
-        [&](int32_t /*index*/, CachePin pin) {
+        [&](int32_t index, CachePin pin) {
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setReadPct(requests_[index].readPct);
+          pin.checkedEntry()->setGroupId(groupId_);
+          pin.checkedEntry()->setTrackingId(requests_[index].trackingId);
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
@@ -468,7 +483,18 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t usecs{0};
+          {
+            MicrosecondTimer timer(&usecs);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          if (latencyModel_ != nullptr) {
+            uint64_t bytes{0};
+            for (const auto& buffer : buffers) {
+              bytes += buffer.size();
+            }
+            latencyModel_->recordRead(bytes, usecs);
+          }
         });
     updateStats(stats, prefetch, false);
     return pins;
@@ -476,6 +502,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
 
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  const std::shared_ptr<io::IoLatencyModel> latencyModel_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -508,6 +535,9 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setReadPct(requests_[index].readPct);
+          pin.checkedEntry()->setGroupId(groupId_);
+          pin.checkedEntry()->setTrackingId(requests_[index].trackingId);
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
@@ -542,7 +572,8 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_.id(),
         requests,
-        options_.maxCoalesceDistance());
+        options_.coalesceDistance(),
+        options_.ioLatencyModel());
   }
   coalescedLoads_.push_back(load);
   streamToCoalescedLoad_.withWLock([&](auto& loads) {
@@ -48,6 +48,10 @@ struct CacheRequest {
   /// adjacent pieces.
   bool coalesces{true};
   const SeekableInputStream* stream;
+
+  /// Percentage of the referenced bytes of the stream that are actually read.
+  /// Passed to the cache entry for its eviction policy.
+  int32_t readPct{100};
 };
 
 class CachedBufferedInput : public BufferedInput {
@@ -265,6 +269,21 @@ class CachedBufferedInput : public BufferedInput {
     }
   }
 
+  // Records the lookup of 'request' in the cache attribution, if enabled.
+  void recordAttribution(
+      cache::CacheAttribution::Event event,
+      const CacheRequest& request) {
+    if (auto* attribution = cache_->attribution()) {
+      attribution->record(
+          event,
+          request.key.fileNum,
+          request.key.offset,
+          groupId_.id(),
+          request.trackingId,
+          request.size);
+    }
+  }
+
   cache::AsyncDataCache* const cache_;
   const StringIdLease fileNum_;
   const std::shared_ptr<cache::ScanTracker> tracker_;
@@ -138,7 +138,7 @@ std::vector<int32_t> DirectBufferedInput::groupRequests(
     // eligible to prefetch. This will be loaded by itself on first use.
     return {};
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  const int32_t maxDistance = options_.coalesceDistance();
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
@@ -199,7 +199,8 @@ void DirectBufferedInput::readRegion(
       groupId_.id(),
       requests,
       pool_,
-      options_.loadQuantum());
+      options_.loadQuantum(),
+      options_.ioLatencyModel());
   coalescedLoads_.push_back(load);
   streamToCoalescedLoad_.withWLock([&](auto& loads) {
     for (auto& request : requests) {
@@ -394,6 +395,9 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
     MicrosecondTimer timer(&usecs);
     input_->read(buffers, requests_[0].region.offset, LogType::FILE);
   }
+  if (latencyModel_ != nullptr) {
+    latencyModel_->recordRead(size + overread, usecs);
+  }
 
   ioStatistics_->read().increment(size + overread);
   ioStatistics_->incRawBytesRead(size);
@@ -63,13 +63,15 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
       uint64_t /* groupId */,
       const std::vector<LoadRequest*>& requests,
       memory::MemoryPool* pool,
-      int32_t loadQuantum)
+      int32_t loadQuantum,
+      std::shared_ptr<io::IoLatencyModel> latencyModel = nullptr)
       : CoalescedLoad({}, {}),
         ioStatistics_(ioStatistics),
         ioStats_(ioStats),
         input_(std::move(input)),
         loadQuantum_(loadQuantum),
-        pool_(pool) {
+        pool_(pool),
+        latencyModel_(std::move(latencyModel)) {
     VELOX_DCHECK_NOT_NULL(pool_);
     VELOX_DCHECK(
         std::is_sorted(
@@ -115,6 +117,8 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   const std::shared_ptr<ReadFileInputStream> input_;
   const int32_t loadQuantum_;
   memory::MemoryPool* const pool_;
+  // Learns from the time of the read if set.
+  const std::shared_ptr<io::IoLatencyModel> latencyModel_;
   std::vector<LoadRequest> requests_;
 };
 
@@ -16,6 +16,8 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/DirectBufferedInput.h"
@@ -189,6 +191,7 @@ void DirectInputStream::loadPosition() {
       ioStats_->queryThreadIoLatencyUs().increment(loadUs);
       // DirectCoalescedLoad always reads from remote storage, not SSD.
       ioStats_->coalescedStorageLoadLatencyUs().increment(loadUs);
+      RECORD_QUANTILE_STAT_VALUE(kMetricCoalescedStorageLoadLatencyUs, loadUs);
     } else {
       // Standalone stream, not part of coalesced load.
       loadedRegion_.offset = 0;
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FooterCache.h"
+
+namespace facebook::velox::dwio::common {
+
+std::shared_ptr<const ParsedFooter> FooterCache::find(
+    const FooterCacheKey& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* entry = cache_.get(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  // The footer is shared, so the entry is not left pinned.
+  auto footer = entry->footer;
+  cache_.release(key);
+  return footer;
+}
+
+void FooterCache::insert(
+    const FooterCacheKey& key,
+    std::shared_ptr<const ParsedFooter> footer,
+    uint64_t bytes) {
+  auto entry = std::make_unique<Entry>(Entry{std::move(footer)});
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, entry.get(), bytes)) {
+    entry.release();
+  }
+}
+
+SimpleLRUCacheStats FooterCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+SimpleLRUCacheStats FooterCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.maxSize());
+  return cache_.stats();
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/caching/SimpleLRUCache.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Identifies a version of a file. A file rewritten in place has a new
+/// modification time, so its footer is not served from the cache.
+struct FooterCacheKey {
+  std::string path;
+  uint64_t fileSize{0};
+  int64_t modificationTime{0};
+
+  bool operator==(const FooterCacheKey& other) const {
+    return fileSize == other.fileSize &&
+        modificationTime == other.modificationTime && path == other.path;
+  }
+};
+
+} // namespace facebook::velox::dwio::common
+
+namespace std {
+template <>
+struct hash<facebook::velox::dwio::common::FooterCacheKey> {
+  size_t operator()(
+      const facebook::velox::dwio::common::FooterCacheKey& key) const noexcept {
+    return facebook::velox::bits::hashMix(
+        facebook::velox::bits::hashMix(
+            std::hash<std::string>()(key.path), key.fileSize),
+        key.modificationTime);
+  }
+};
+} // namespace std
+
+namespace facebook::velox::dwio::common {
+
+/// The parsed footer of a file. Subclassed by the file formats.
+class ParsedFooter {
+ public:
+  virtual ~ParsedFooter() = default;
+};
+
+/// Size-bounded LRU cache of parsed file footers, shared by the readers of
+/// all queries of a connector, so that a file opened by many splits or
+/// queries has its footer read and parsed once. The size of an entry is given
+/// by the format when the entry is added. A footer found in the cache is
+/// shared by the readers and must not be modified. Thread safe.
+class FooterCache {
+ public:
+  explicit FooterCache(uint64_t maxBytes) : cache_(maxBytes) {}
+
+  /// Returns the footer of 'key', or nullptr if it is not cached.
+  std::shared_ptr<const ParsedFooter> find(const FooterCacheKey& key);
+
+  /// Adds 'footer' of 'bytes' under 'key'. Evicts the least recently used
+  /// entries to make space. Does nothing if 'key' is already cached or
+  /// 'bytes' exceeds the capacity of the cache.
+  void insert(
+      const FooterCacheKey& key,
+      std::shared_ptr<const ParsedFooter> footer,
+      uint64_t bytes);
+
+  SimpleLRUCacheStats stats() const;
+
+  /// Removes all entries and returns the stats after. Readers holding a
+  /// footer keep it.
+  SimpleLRUCacheStats clear();
+
+ private:
+  struct Entry {
+    std::shared_ptr<const ParsedFooter> footer;
+  };
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<FooterCacheKey, Entry> cache_;
+};
+
+} // namespace facebook::velox::dwio::common
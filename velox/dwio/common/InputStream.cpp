@@ -27,6 +27,8 @@
 #include <string_view>
 #include <type_traits>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -84,6 +86,7 @@ void ReadFileInputStream::read(
     MicrosecondTimer timer(&readTimeUs);
     readData = readFile_->pread(offset, length, buf, fileIoContext_);
   }
+  RECORD_QUANTILE_STAT_VALUE(kMetricStorageReadLatencyUs, readTimeUs);
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime(readTimeUs * 1'000);
@@ -105,7 +108,13 @@ void ReadFileInputStream::read(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
-  const auto size = readFile_->preadv(offset, buffers, fileIoContext_);
+  uint64_t readTimeUs{0};
+  uint64_t size;
+  {
+    MicrosecondTimer timer(&readTimeUs);
+    size = readFile_->preadv(offset, buffers, fileIoContext_);
+  }
+  RECORD_QUANTILE_STAT_VALUE(kMetricStorageReadLatencyUs, readTimeUs);
   VELOX_CHECK_EQ(
       size,
       bufferSize,
@@ -142,9 +151,11 @@ void ReadFileInputStream::vread(
   logRead(regions[0].offset, length, purpose);
   auto readStartMicros = getCurrentTimeMicro();
   readFile_->preadv(regions, iobufs, fileIoContext_);
+  const auto readTimeUs = getCurrentTimeMicro() - readStartMicros;
+  RECORD_QUANTILE_STAT_VALUE(kMetricStorageReadLatencyUs, readTimeUs);
   if (stats_) {
     stats_->incRawBytesRead(length);
-    stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
+    stats_->incTotalScanTime(readTimeUs * 1000);
   }
 }
 
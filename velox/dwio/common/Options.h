@@ -31,6 +31,7 @@
 #include "velox/dwio/common/ErrorTolerance.h"
 #include "velox/dwio/common/FlatMapHelper.h"
 #include "velox/dwio/common/FlushPolicy.h"
+#include "velox/dwio/common/FooterCache.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/ScanSpec.h"
 #include "velox/dwio/common/UnitLoader.h"
@@ -223,6 +224,17 @@ class RowReaderOptions {
     return preloadStripe_;
   }
 
+  /// Requests that the encrypted streams of a stripe be decrypted when the
+  /// stripe is loaded instead of block by block as they are read. With a
+  /// parallel unit loader, the decryption then runs on the IO executor.
+  void setDecryptOnLoad(bool decryptOnLoad) {
+    decryptOnLoad_ = decryptOnLoad;
+  }
+
+  bool decryptOnLoad() const {
+    return decryptOnLoad_;
+  }
+
   /// Will load the first stripe on RowReader creation, if true.
   /// This behavior is already happening in DWRF, but isn't desired for some use
   /// cases. So this flag allows us to turn it off.
@@ -467,6 +479,10 @@ class RowReaderOptions {
     indexEnabled_ = enabled;
   }
 
+  /// Whether string values may reference the buffers of the decoder instead
+  /// of being copied. The DWRF direct string reader then references pinned
+  /// cache entries from the vectors it returns, which keeps the entries from
+  /// being evicted while the vectors are alive.
   bool passStringBuffersFromDecoder() const {
     return passStringBuffersFromDecoder_;
   }
@@ -490,6 +506,7 @@ class RowReaderOptions {
   bool preloadStripe_;
   bool projectSelectedType_;
   bool returnFlatVector_ = false;
+  bool decryptOnLoad_ = false;
   size_t parallelUnitLoadCount_ = 0;
   ErrorTolerance errorTolerance_;
   std::shared_ptr<ColumnSelector> selector_;
@@ -746,6 +763,22 @@ class ReaderOptions : public io::ReaderOptions {
     fileMetadataCacheEnabled_ = value;
   }
 
+  /// Cache of parsed footers to look up the footer of the file in, under
+  /// footerCacheKey(), and to add it to after parsing. nullptr if the footer
+  /// is always read from the file.
+  FooterCache* footerCache() const {
+    return footerCache_.get();
+  }
+
+  const FooterCacheKey& footerCacheKey() const {
+    return footerCacheKey_;
+  }
+
+  void setFooterCache(std::shared_ptr<FooterCache> cache, FooterCacheKey key) {
+    footerCache_ = std::move(cache);
+    footerCacheKey_ = std::move(key);
+  }
+
   /// If true, pins parsed metadata objects (e.g., StripeGroup, IndexGroup) in
   /// the reader's metadata cache with strong references so they are never
   /// evicted. This avoids re-reading and re-parsing metadata on every stripe
@@ -788,6 +821,65 @@ class ReaderOptions : public io::ReaderOptions {
     allowEmptyFile_ = value;
   }
 
+  /// Whether to read the page index (ColumnIndex/OffsetIndex) of row groups
+  /// and skip pages whose statistics do not match the filters. Currently only
+  /// supported by Parquet. Default false.
+  bool pageIndexFilterEnabled() const {
+    return pageIndexFilterEnabled_;
+  }
+
+  void setPageIndexFilterEnabled(bool value) {
+    pageIndexFilterEnabled_ = value;
+  }
+
+  /// Whether to read the bloom filters of filtered columns and skip row groups
+  /// that have none of the values of equality and IN filters. Currently only
+  /// supported by Parquet. Default false.
+  bool bloomFilterEnabled() const {
+    return bloomFilterEnabled_;
+  }
+
+  void setBloomFilterEnabled(bool value) {
+    bloomFilterEnabled_ = value;
+  }
+
+  /// Whether to read the dictionary pages of filtered columns and skip row
+  /// groups whose dictionaries have no value passing the filters. Only applies
+  /// to column chunks whose data pages are all dictionary encoded. Currently
+  /// only supported by Parquet. Default false.
+  bool dictionaryFilterEnabled() const {
+    return dictionaryFilterEnabled_;
+  }
+
+  void setDictionaryFilterEnabled(bool value) {
+    dictionaryFilterEnabled_ = value;
+  }
+
+  /// The number of data pages of a column chunk to decompress ahead of the
+  /// decoder on the IO executor of the row reader. 0 decompresses each page
+  /// when it is decoded. Currently only supported by Parquet. Default 0.
+  int32_t decompressionPagesAhead() const {
+    return decompressionPagesAhead_;
+  }
+
+  void setDecompressionPagesAhead(int32_t value) {
+    VELOX_CHECK_GE(value, 0);
+    decompressionPagesAhead_ = value;
+  }
+
+  /// The size of the blocks that a gzip or deflate compressed text file is
+  /// decompressed in. If the row reader has an IO executor, the next block is
+  /// decompressed on it while the current block is parsed. 0 decompresses
+  /// the file in blocks of three times its compressed size on the parsing
+  /// thread. Currently only supported by the text reader. Default 0.
+  uint64_t decompressionBlockSize() const {
+    return decompressionBlockSize_;
+  }
+
+  void setDecompressionBlockSize(uint64_t value) {
+    decompressionBlockSize_ = value;
+  }
+
  private:
   uint64_t tailLocation_;
   FileFormat fileFormat_;
@@ -806,10 +898,17 @@ class ReaderOptions : public io::ReaderOptions {
   bool adjustTimestampToTimezone_{false};
   bool selectiveNimbleReaderEnabled_{false};
   bool fileMetadataCacheEnabled_{false};
+  std::shared_ptr<FooterCache> footerCache_;
+  FooterCacheKey footerCacheKey_;
   bool pinFileMetadata_{false};
   bool loadClusterIndex_{true};
   bool loadChunkIndex_{true};
   bool allowEmptyFile_{false};
+  bool pageIndexFilterEnabled_{false};
+  bool bloomFilterEnabled_{false};
+  bool dictionaryFilterEnabled_{false};
+  int32_t decompressionPagesAhead_{0};
+  uint64_t decompressionBlockSize_{0};
 };
 
 struct WriterOptions {
@@ -151,6 +151,13 @@ class RowReader {
     return std::nullopt;
   }
 
+  /// Loads the first unit to read, e.g. the first stripe, if its IO size is
+  /// at most 'maxBytes'. Used to prepare a split ahead of reading it. Returns
+  /// the number of bytes loaded or 0 if nothing was loaded.
+  virtual uint64_t loadFirstUnit(uint64_t /*maxBytes*/) {
+    return 0;
+  }
+
   /**
    * Helper function used by non-selective reader to project top level columns
    * according to the scan spec and mutations.
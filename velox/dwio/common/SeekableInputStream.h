@@ -44,6 +44,14 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
 
   virtual bool SkipInt64(int64_t count) = 0;
 
+  /// Returns a buffer that keeps the bytes returned by the last call to Next()
+  /// valid for as long as it is referenced, e.g. by pinning the cache entry
+  /// they are in. Returns nullptr if the bytes may be overwritten or freed
+  /// after the next call to Next() or after 'this' is destroyed.
+  virtual BufferPtr pinnedBuffer() {
+    return nullptr;
+  }
+
   bool Skip(int32_t count) final override {
     VELOX_FAIL("Use SkipInt64 instead: {}", count);
   }
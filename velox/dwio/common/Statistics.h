@@ -20,6 +20,7 @@
 #include <folly/Hash.h>
 #include <folly/Synchronized.h>
 #include <folly/container/F14Map.h>
+#include <map>
 #include <type_traits>
 #include <utility>
 #include "velox/common/time/CpuWallTimer.h"
@@ -622,6 +623,21 @@ struct ColumnMetricsSet {
     }
   }
 
+  /// Returns the decode plus decompression CPU time of each column, keyed by
+  /// nodeId.
+  std::map<uint32_t, uint64_t> cpuNanosByColumn() const {
+    std::map<uint32_t, uint64_t> result;
+    auto statsLocked = map_.rlock();
+    for (const auto& [nodeId, stats] : *statsLocked) {
+      const auto nanos =
+          stats->decodeCPUTimeNanos.sum() + stats->decompressCPUTimeNanos.sum();
+      if (nanos > 0) {
+        result.emplace(nodeId, nanos);
+      }
+    }
+    return result;
+  }
+
   /// Exports per-column metrics into the runtime metrics result map.
   void toRuntimeMetrics(
       std::unordered_map<std::string, RuntimeMetric>& result) const {
@@ -752,6 +768,18 @@ struct RuntimeStatistics {
   // Number of strides (row groups) processed based on statistics.
   int64_t processedStrides{0};
 
+  // Number of strides (row groups) in 'skippedStrides' that were skipped
+  // because of bloom filters.
+  int64_t bloomFilterSkippedStrides{0};
+
+  // Number of strides (row groups) in 'skippedStrides' that were skipped
+  // because no dictionary value passed the filters.
+  int64_t dictionaryFilterSkippedStrides{0};
+
+  // Number of rows inside processed row groups that were skipped because the
+  // page index showed that no page of a filtered column could match.
+  int64_t skippedPageRows{0};
+
   int64_t footerBufferOverread{0};
 
   int64_t numStripes{0};
@@ -781,6 +809,19 @@ struct RuntimeStatistics {
     if (processedStrides > 0) {
       result.emplace("processedStrides", RuntimeMetric(processedStrides));
     }
+    if (bloomFilterSkippedStrides > 0) {
+      result.emplace(
+          "bloomFilterSkippedStrides",
+          RuntimeMetric(bloomFilterSkippedStrides));
+    }
+    if (dictionaryFilterSkippedStrides > 0) {
+      result.emplace(
+          "dictionaryFilterSkippedStrides",
+          RuntimeMetric(dictionaryFilterSkippedStrides));
+    }
+    if (skippedPageRows > 0) {
+      result.emplace("skippedPageRows", RuntimeMetric(skippedPageRows));
+    }
     if (footerBufferOverread > 0) {
       result.emplace(
           "footerBufferOverread",
@@ -759,7 +759,8 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       streamDebugInfo,
       useRawDecompression,
       compressedLength,
-      decompressCounter);
+      decompressCounter,
+      kind);
 }
 
 } // namespace facebook::velox::dwio::common::compression
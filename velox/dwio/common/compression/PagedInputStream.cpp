@@ -16,6 +16,7 @@
 
 #include "velox/dwio/common/compression/PagedInputStream.h"
 
+#include "velox/common/compression/DecompressionAccelerator.h"
 #include "velox/dwio/common/Statistics.h"
 
 namespace facebook::velox::dwio::common::compression {
@@ -130,6 +131,10 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
     return true;
   }
 
+  if (!aheadBlocks_.empty()) {
+    return readAhead(data, size);
+  }
+
   // release previous decryption buffer
   decryptionBuffer_ = nullptr;
 
@@ -216,6 +221,154 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+bool PagedInputStream::decompressAhead() {
+  if ((!decompressor_ && !decrypter_) || !aheadBlocks_.empty() ||
+      outputBufferLength_ > 0 ||
+      (state_ != State::HEADER && remainingLength_ > 0)) {
+    return false;
+  }
+
+  // Take the unread part of the last range from 'input_' and all the ranges
+  // after it.
+  const uint64_t startOffset =
+      input_->ByteCount() - (inputBufferPtrEnd_ - inputBufferPtr_);
+  aheadInput_ = std::make_unique<dwio::common::DataBuffer<char>>(pool_);
+  while (true) {
+    aheadInput_->extendAppend(
+        aheadInput_->size(),
+        inputBufferPtr_,
+        inputBufferPtrEnd_ - inputBufferPtr_);
+    inputBufferPtr_ = inputBufferPtrEnd_;
+    readBuffer(false);
+    if (state_ == State::END) {
+      break;
+    }
+  }
+
+  // Find the blocks and the space for decompressing them. The blocks of an
+  // encrypted stream are decrypted first, all in one pass, and 'input' then
+  // points to the decrypted block.
+  struct Block {
+    uint64_t headerOffset;
+    const char* input;
+    uint64_t inputLength;
+    bool original;
+    uint64_t outputOffset;
+    uint64_t outputLength;
+  };
+  std::vector<Block> blocks;
+  uint64_t outputSize = 0;
+  const char* const input = aheadInput_->data();
+  for (uint64_t offset = 0; offset < aheadInput_->size();) {
+    DWIO_ENSURE_LE(
+        offset + 3, aheadInput_->size(), getName(), ", read past EOF");
+    const uint32_t header = static_cast<unsigned char>(input[offset]) |
+        static_cast<unsigned char>(input[offset + 1]) << 8 |
+        static_cast<unsigned char>(input[offset + 2]) << 16;
+    Block block;
+    block.headerOffset = startOffset + offset;
+    block.input = input + offset + 3;
+    block.inputLength = header >> 1;
+    block.original = header & 1;
+    offset += 3 + block.inputLength;
+    DWIO_ENSURE_LE(offset, aheadInput_->size(), getName(), ", read past EOF");
+    blocks.push_back(block);
+  }
+
+  if (decrypter_) {
+    aheadDecrypted_.clear();
+    aheadDecrypted_.reserve(blocks.size());
+    for (auto& block : blocks) {
+      aheadDecrypted_.push_back(decrypter_->decrypt(
+          std::string_view{block.input, block.inputLength}));
+      block.input =
+          reinterpret_cast<const char*>(aheadDecrypted_.back()->data());
+      block.inputLength = aheadDecrypted_.back()->length();
+    }
+  }
+
+  for (auto& block : blocks) {
+    block.outputOffset = outputSize;
+    if (!block.original) {
+      DWIO_ENSURE_NOT_NULL(decompressor_.get(), "invalid stream state");
+      block.outputLength =
+          decompressor_->getDecompressedLength(block.input, block.inputLength)
+              .first;
+    } else {
+      block.outputLength = 0;
+    }
+    outputSize += block.outputLength;
+  }
+
+  aheadOutput_ =
+      std::make_unique<dwio::common::DataBuffer<char>>(pool_, outputSize);
+  std::vector<velox::common::DecompressionRequest> requests;
+  std::vector<size_t> requestBlocks;
+  for (auto i = 0; i < blocks.size(); ++i) {
+    if (blocks[i].original) {
+      continue;
+    }
+    requests.push_back(
+        {kind_,
+         reinterpret_cast<const uint8_t*>(blocks[i].input),
+         blocks[i].inputLength,
+         reinterpret_cast<uint8_t*>(
+             aheadOutput_->data() + blocks[i].outputOffset),
+         blocks[i].outputLength});
+    requestBlocks.push_back(i);
+  }
+
+  velox::common::BatchDecompressor decompressor(
+      [&](const velox::common::DecompressionRequest& request) {
+        return withDecompressStats(decompressCounter_, [&] {
+          return decompressor_->decompress(
+              reinterpret_cast<const char*>(request.input),
+              request.inputLength,
+              reinterpret_cast<char*>(request.output),
+              request.outputLength);
+        });
+      });
+  const auto lengths = decompressor.decompress(requests);
+  for (auto i = 0; i < requestBlocks.size(); ++i) {
+    blocks[requestBlocks[i]].outputLength = lengths[i];
+  }
+
+  for (const auto& block : blocks) {
+    aheadBlocks_.push_back(
+        {block.headerOffset,
+         block.original ? block.input
+                        : aheadOutput_->data() + block.outputOffset,
+         block.original ? block.inputLength : block.outputLength});
+  }
+  nextAheadBlock_ = 0;
+  // The blocks are returned from memory, so BackUp() is not limited to the
+  // last range of 'input_'.
+  state_ = State::START;
+  remainingLength_ = 0;
+  if (aheadBlocks_.empty()) {
+    state_ = State::END;
+  }
+  return true;
+}
+
+bool PagedInputStream::readAhead(const void** data, int32_t* size) {
+  if (nextAheadBlock_ == aheadBlocks_.size()) {
+    return false;
+  }
+  const auto& block = aheadBlocks_[nextAheadBlock_++];
+  lastHeaderOffset_ = block.headerOffset;
+  bytesReturnedAtLastHeaderOffset_ = bytesReturned_;
+  if (data) {
+    *data = block.data;
+  }
+  *size = static_cast<int32_t>(block.length);
+  outputBufferPtr_ = block.data + block.length;
+  outputBufferLength_ = 0;
+  bytesReturned_ += *size;
+  lastWindowSize_ = *size;
+  return true;
+}
+
 void PagedInputStream::BackUp(int32_t count) {
   VELOX_CHECK_GE(count, 0);
   if (pendingSkip_ > 0) {
@@ -284,6 +437,35 @@ void PagedInputStream::seekToPosition(
   auto compressedOffset = positionProvider.next();
   auto uncompressedOffset = positionProvider.next();
 
+  if (!aheadBlocks_.empty()) {
+    auto it = std::lower_bound(
+        aheadBlocks_.begin(),
+        aheadBlocks_.end(),
+        compressedOffset,
+        [](const AheadBlock& block, uint64_t offset) {
+          return block.headerOffset < offset;
+        });
+    if (it != aheadBlocks_.end() && it->headerOffset == compressedOffset) {
+      nextAheadBlock_ = it - aheadBlocks_.begin();
+      outputBufferLength_ = 0;
+      outputBufferPtr_ = nullptr;
+      pendingSkip_ = uncompressedOffset;
+      return;
+    }
+    // Outside of the decompressed blocks. Go back to reading 'input_'.
+    aheadBlocks_.clear();
+    aheadInput_.reset();
+    aheadOutput_.reset();
+    aheadDecrypted_.clear();
+    state_ = State::HEADER;
+    std::vector<uint64_t> positions = {compressedOffset};
+    auto provider = dwio::common::PositionProvider(positions);
+    input_->seekToPosition(provider);
+    clearDecompressionState();
+    pendingSkip_ = uncompressedOffset;
+    return;
+  }
+
   // If we are directly returning views into input, we can only backup
   // to the beginning of the last view or last header, whichever is
   // later. If we are returning views into the decompression buffer,
@@ -32,14 +32,17 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
       const std::string& streamDebugInfo,
       bool useRawDecompression = false,
       size_t compressedLength = 0,
-      io::IoCounter* decompressCounter = nullptr)
+      io::IoCounter* decompressCounter = nullptr,
+      velox::common::CompressionKind kind =
+          velox::common::CompressionKind_NONE)
       : input_(std::move(inStream)),
         pool_(memPool),
         inputBuffer_(pool_),
         decompressor_{std::move(decompressor)},
         decrypter_{decrypter},
         streamDebugInfo_{streamDebugInfo},
-        decompressCounter_{decompressCounter} {
+        decompressCounter_{decompressCounter},
+        kind_{kind} {
     DWIO_ENSURE(
         decompressor_ || decrypter_,
         "one of decompressor or decryptor is required");
@@ -64,6 +67,19 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   }
 
   void seekToPosition(dwio::common::PositionProvider& position) override;
+
+  /// Reads the rest of the input and decompresses all its blocks in one batch,
+  /// offloading them to the installed decompression accelerator, if any.
+  /// Next() then returns the decompressed blocks without further work. Meant
+  /// for streams whose range is already loaded, e.g. by a coalesced load, so
+  /// that the blocks are decompressed together instead of one per Next().
+  /// The blocks of an encrypted stream are all decrypted first, so that
+  /// decryption also happens here instead of on each Next(), e.g. on the
+  /// thread that loads a stripe. Returns false and does nothing if the stream
+  /// is not decompressed or decrypted block by block or is positioned inside a
+  /// block.
+  bool decompressAhead();
+
   std::string getName() const override {
     return folly::to<std::string>(
         "PagedInputStream StreamInfo (",
@@ -126,6 +142,17 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
 
   virtual bool readOrSkip(const void** data, int32_t* size);
 
+  // A block decompressed by decompressAhead().
+  struct AheadBlock {
+    // Offset of the header of the block in 'input_'.
+    uint64_t headerOffset;
+    const char* data;
+    uint64_t length;
+  };
+
+  // readOrSkip() after decompressAhead().
+  bool readAhead(const void** data, int32_t* size);
+
   // input stream where to read compressed/encrypted data
   std::unique_ptr<SeekableInputStream> input_;
   memory::MemoryPool& pool_;
@@ -182,6 +209,16 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
 
   int64_t pendingSkip_{0};
 
+  // The blocks decompressed by decompressAhead(), in stream order, and the
+  // next one to return. 'aheadInput_' holds the compressed blocks and the
+  // original ones, 'aheadOutput_' the decompressed ones.
+  std::vector<AheadBlock> aheadBlocks_;
+  size_t nextAheadBlock_{0};
+  std::unique_ptr<dwio::common::DataBuffer<char>> aheadInput_;
+  std::unique_ptr<dwio::common::DataBuffer<char>> aheadOutput_;
+  // The decrypted blocks of an encrypted stream after decompressAhead().
+  std::vector<std::unique_ptr<folly::IOBuf>> aheadDecrypted_;
+
  private:
   bool skipAllPending();
 
@@ -192,6 +229,10 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   // Owned by ColumnReaderStatistics. Valid for the lifetime of this stream
   // because ColumnReaderStatistics outlives all streams within a DwrfRowReader.
   io::IoCounter* const decompressCounter_{nullptr};
+
+  // The kind of 'decompressor_', for offloading in decompressAhead().
+  const velox::common::CompressionKind kind_{
+      velox::common::CompressionKind_NONE};
 };
 
 } // namespace facebook::velox::dwio::common::compression
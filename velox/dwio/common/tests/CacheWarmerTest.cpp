@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/CacheWarmer.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MallocAllocator.h"
+#include "velox/dwio/common/CachedBufferedInput.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::cache;
+using namespace facebook::velox::memory;
+
+namespace {
+
+class CacheWarmerTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    MemoryManager::testingSetInstance(MemoryManager::Options{});
+  }
+
+  void SetUp() override {
+    allocator_ = std::make_shared<MallocAllocator>(MemoryAllocator::Options{
+        .capacity = 64 << 20, .reservationByteLimit = 0});
+    cache_ = AsyncDataCache::create(allocator_.get());
+    pool_ = memoryManager()->addLeafPool();
+    content_.resize(4 << 20);
+    for (auto i = 0; i < content_.size(); ++i) {
+      content_[i] = static_cast<char>('a' + (i % 26));
+    }
+    file_ = std::make_shared<InMemoryReadFile>(content_);
+  }
+
+  void TearDown() override {
+    cache_->shutdown();
+    cache_.reset();
+    allocator_.reset();
+  }
+
+  std::shared_ptr<MemoryPool> pool_;
+  std::shared_ptr<MallocAllocator> allocator_;
+  std::shared_ptr<AsyncDataCache> cache_;
+  std::string content_;
+  std::shared_ptr<ReadFile> file_;
+};
+
+TEST_F(CacheWarmerTest, warm) {
+  StringIdLease fileNum(fileIds(), "warmFile");
+  StringIdLease groupId(fileIds(), "warmGroup");
+  const std::vector<velox::common::Region> regions = {
+      {0, 100 << 10}, {1 << 20, 300 << 10}, {3 << 20, 10 << 10}};
+
+  CacheWarmer warmer(cache_.get(), pool_.get(), {});
+  ASSERT_TRUE(warmer.warm(file_, fileNum, groupId, regions));
+  EXPECT_EQ(warmer.stats().warmedBytes, 410 << 10);
+  EXPECT_EQ(warmer.stats().skippedBytes, 0);
+  for (const auto& region : regions) {
+    EXPECT_TRUE(cache_->exists({fileNum.id(), region.offset}));
+  }
+
+  // A scan of the same streams is served from memory.
+  auto ioStatistics = std::make_shared<io::IoStatistics>();
+  CachedBufferedInput input(
+      file_,
+      MetricsLog::voidLog(),
+      fileNum,
+      cache_.get(),
+      nullptr,
+      groupId,
+      ioStatistics,
+      nullptr,
+      nullptr,
+      io::ReaderOptions(pool_.get()));
+  std::vector<std::unique_ptr<SeekableInputStream>> streams;
+  for (const auto& region : regions) {
+    streams.push_back(input.enqueue(region, nullptr));
+  }
+  input.load(LogType::TEST);
+  for (auto i = 0; i < regions.size(); ++i) {
+    const void* data;
+    int32_t size;
+    ASSERT_TRUE(streams[i]->Next(&data, &size));
+    EXPECT_EQ(
+        std::string_view(static_cast<const char*>(data), size),
+        std::string_view(content_).substr(regions[i].offset, size));
+  }
+  EXPECT_EQ(ioStatistics->read().sum(), 0);
+
+  // Warming again reads nothing from storage.
+  const auto readBytes = warmer.ioStatistics().read().sum();
+  ASSERT_TRUE(warmer.warm(file_, fileNum, groupId, regions));
+  EXPECT_EQ(warmer.ioStatistics().read().sum(), readBytes);
+}
+
+TEST_F(CacheWarmerTest, throttle) {
+  StringIdLease fileNum(fileIds(), "throttleFile");
+  StringIdLease groupId(fileIds(), "throttleGroup");
+  CacheWarmer warmer(
+      cache_.get(), pool_.get(), {.maxBytesPerSecond = 10 << 20});
+  ASSERT_TRUE(warmer.warm(file_, fileNum, groupId, {{0, 1 << 20}}));
+  EXPECT_EQ(warmer.stats().warmedBytes, 1 << 20);
+  // 1MB at 10MB/s takes about 100ms.
+  EXPECT_GT(warmer.stats().throttledUs, 50'000);
+}
+
+TEST_F(CacheWarmerTest, cacheFull) {
+  StringIdLease fileNum(fileIds(), "fullFile");
+  StringIdLease groupId(fileIds(), "fullGroup");
+  // Leave 2MB of the 64MB of cache memory free. Nothing is cached, so no
+  // read-ahead can be admitted beyond the free space.
+  Allocation allocation;
+  ASSERT_TRUE(allocator_->allocateNonContiguous(
+      AllocationTraits::numPages(62 << 20), allocation));
+  CacheWarmer warmer(cache_.get(), pool_.get(), {});
+  std::vector<velox::common::Region> regions;
+  for (auto i = 0; i < 4; ++i) {
+    regions.push_back({static_cast<uint64_t>(i) << 20, 1 << 20});
+  }
+  EXPECT_FALSE(warmer.warm(file_, fileNum, groupId, regions));
+  EXPECT_EQ(warmer.stats().warmedBytes, 1 << 20);
+  EXPECT_EQ(warmer.stats().skippedBytes, 3 << 20);
+  EXPECT_TRUE(cache_->exists({fileNum.id(), 0}));
+  EXPECT_FALSE(cache_->exists({fileNum.id(), 1 << 20}));
+  allocator_->freeNonContiguous(allocation);
+}
+
+} // namespace
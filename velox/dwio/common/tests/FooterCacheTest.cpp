@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FooterCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+struct TestFooter : ParsedFooter {
+  explicit TestFooter(int32_t _id) : id(_id) {}
+
+  const int32_t id;
+};
+
+int32_t idOf(const std::shared_ptr<const ParsedFooter>& footer) {
+  return dynamic_cast<const TestFooter&>(*footer).id;
+}
+
+TEST(FooterCacheTest, basic) {
+  FooterCache cache(100);
+  const FooterCacheKey key{"/a", 10, 1};
+  EXPECT_EQ(cache.find(key), nullptr);
+  cache.insert(key, std::make_shared<TestFooter>(1), 40);
+  ASSERT_NE(cache.find(key), nullptr);
+  EXPECT_EQ(idOf(cache.find(key)), 1);
+
+  // Another version of the same path is a different entry.
+  EXPECT_EQ(cache.find({"/a", 10, 2}), nullptr);
+  EXPECT_EQ(cache.find({"/a", 11, 1}), nullptr);
+
+  // An existing entry is kept.
+  cache.insert(key, std::make_shared<TestFooter>(2), 40);
+  EXPECT_EQ(idOf(cache.find(key)), 1);
+
+  // A footer larger than the cache is not added.
+  cache.insert({"/b", 10, 1}, std::make_shared<TestFooter>(3), 101);
+  EXPECT_EQ(cache.find({"/b", 10, 1}), nullptr);
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.curSize, 40);
+  EXPECT_EQ(stats.numElements, 1);
+  EXPECT_EQ(stats.numHits, 3);
+  EXPECT_EQ(stats.numLookups, 7);
+}
+
+TEST(FooterCacheTest, evict) {
+  FooterCache cache(100);
+  cache.insert({"/a", 10, 1}, std::make_shared<TestFooter>(1), 40);
+  cache.insert({"/b", 10, 1}, std::make_shared<TestFooter>(2), 40);
+  // Makes "/b" the least recently used.
+  EXPECT_NE(cache.find({"/a", 10, 1}), nullptr);
+  cache.insert({"/c", 10, 1}, std::make_shared<TestFooter>(3), 40);
+  EXPECT_EQ(cache.find({"/b", 10, 1}), nullptr);
+  auto footer = cache.find({"/a", 10, 1});
+  EXPECT_NE(cache.find({"/c", 10, 1}), nullptr);
+
+  const auto stats = cache.clear();
+  EXPECT_EQ(stats.curSize, 0);
+  EXPECT_EQ(stats.numElements, 0);
+  EXPECT_EQ(cache.find({"/a", 10, 1}), nullptr);
+  // A footer found before the clear stays valid.
+  EXPECT_EQ(idOf(footer), 1);
+}
+
+} // namespace
@@ -196,6 +196,10 @@ Config::Entry<bool> Config::STRING_DICTIONARY_ENCODING_ENABLED(
     "hive.exec.orc.string.dictionary.encoding.enabled",
     true);
 
+Config::Entry<bool> Config::STRING_DICTIONARY_EARLY_CHECK(
+    "hive.exec.orc.string.dictionary.early.check",
+    false);
+
 Config::Entry<uint64_t> Config::STRIPE_SIZE(
     "hive.exec.orc.stripe.size",
     256L * 1024L * 1024L);
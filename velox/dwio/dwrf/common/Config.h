@@ -63,6 +63,10 @@ class Config : public config::ConfigBase {
   static Entry<uint64_t> MAX_DICTIONARY_SIZE;
   static Entry<bool> INTEGER_DICTIONARY_ENCODING_ENABLED;
   static Entry<bool> STRING_DICTIONARY_ENCODING_ENABLED;
+  /// Decides whether to keep dictionary encoding a string column after the
+  /// first row index stride of the first stripe instead of at the stripe
+  /// flush. Saves building dictionaries for high cardinality columns.
+  static Entry<bool> STRING_DICTIONARY_EARLY_CHECK;
   static Entry<uint64_t> STRIPE_SIZE;
   static Entry<bool> LINEAR_STRIPE_SIZE_HEURISTICS;
   /// With this config, we don't even try the more memory intensive encodings on
@@ -101,6 +105,10 @@ class Config : public config::ConfigBase {
   static constexpr const char*
       kOrcWriterStringDictionaryEncodingEnabledSession =
           "orc_optimized_writer_string_dictionary_encoding_enabled";
+  static constexpr const char* kOrcWriterStringDictionaryEarlyCheck =
+      "hive.orc.writer.string-dictionary-early-check";
+  static constexpr const char* kOrcWriterStringDictionaryEarlyCheckSession =
+      "orc_optimized_writer_string_dictionary_early_check";
 
   /// Enables historical based stripe size estimation after compression.
   static constexpr const char* kOrcWriterLinearStripeSizeHeuristics =
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/OrcBloomFilter.h"
+
+#include <folly/lang/Bits.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwrf {
+namespace {
+
+// Constants of the Murmur3 hash used by ORC.
+constexpr uint64_t kC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kC2 = 0x4cf5ad432745937fULL;
+constexpr int kR1 = 31;
+constexpr int kR2 = 27;
+constexpr uint64_t kM = 5;
+constexpr uint64_t kN1 = 0x52dce729;
+constexpr uint64_t kSeed = 104729;
+
+inline uint64_t rotateLeft(uint64_t value, int shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t mixKey(uint64_t key) {
+  key *= kC1;
+  key = rotateLeft(key, kR1);
+  return key * kC2;
+}
+
+inline uint64_t fmix64(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Java's signed right shift.
+inline uint64_t signedShiftRight(uint64_t value, int shift) {
+  return static_cast<uint64_t>(static_cast<int64_t>(value) >> shift);
+}
+
+} // namespace
+
+OrcBloomFilter::OrcBloomFilter(
+    uint32_t numHashFunctions,
+    std::vector<uint64_t> bitset)
+    : numHashFunctions_{numHashFunctions}, bitset_{std::move(bitset)} {
+  VELOX_CHECK_GT(numHashFunctions_, 0, "Bloom filter without hash functions");
+  VELOX_CHECK(!bitset_.empty(), "Bloom filter without bits");
+  VELOX_CHECK_LE(
+      bitset_.size(),
+      std::numeric_limits<int32_t>::max() / 64,
+      "Bloom filter is too large");
+}
+
+OrcBloomFilter::OrcBloomFilter(const proto::orc::BloomFilter& proto)
+    : OrcBloomFilter{
+          proto.numhashfunctions(),
+          [&]() {
+            if (proto.bitset_size() > 0) {
+              return std::vector<uint64_t>(
+                  proto.bitset().begin(), proto.bitset().end());
+            }
+            const auto& bytes = proto.utf8bitset();
+            VELOX_CHECK_EQ(
+                bytes.size() % sizeof(uint64_t),
+                0,
+                "Corrupt bloom filter bitset");
+            std::vector<uint64_t> bitset(bytes.size() / sizeof(uint64_t));
+            for (size_t i = 0; i < bitset.size(); ++i) {
+              uint64_t word;
+              std::memcpy(&word, bytes.data() + i * sizeof(uint64_t), 8);
+              bitset[i] = folly::Endian::little(word);
+            }
+            return bitset;
+          }()} {}
+
+// static
+uint64_t OrcBloomFilter::hashLong(int64_t value) {
+  auto key = static_cast<uint64_t>(value);
+  key = (~key) + (key << 21);
+  key = key ^ signedShiftRight(key, 24);
+  key = (key + (key << 3)) + (key << 8);
+  key = key ^ signedShiftRight(key, 14);
+  key = (key + (key << 2)) + (key << 4);
+  key = key ^ signedShiftRight(key, 28);
+  key = key + (key << 31);
+  return key;
+}
+
+// static
+uint64_t OrcBloomFilter::hashDouble(double value) {
+  // Java's Double.doubleToLongBits() maps all NaNs to the canonical one.
+  if (std::isnan(value)) {
+    value = std::numeric_limits<double>::quiet_NaN();
+  }
+  int64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return hashLong(bits);
+}
+
+// static
+uint64_t OrcBloomFilter::hashBytes(std::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const auto length = value.size();
+  const auto numBlocks = length / 8;
+  uint64_t hash = kSeed;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    uint64_t block;
+    std::memcpy(&block, data + i * 8, sizeof(block));
+    hash ^= mixKey(folly::Endian::little(block));
+    hash = rotateLeft(hash, kR2) * kM + kN1;
+  }
+
+  const auto* tail = data + numBlocks * 8;
+  uint64_t key = 0;
+  switch (length - numBlocks * 8) {
+    case 7:
+      key ^= static_cast<uint64_t>(tail[6]) << 48;
+      [[fallthrough]];
+    case 6:
+      key ^= static_cast<uint64_t>(tail[5]) << 40;
+      [[fallthrough]];
+    case 5:
+      key ^= static_cast<uint64_t>(tail[4]) << 32;
+      [[fallthrough]];
+    case 4:
+      key ^= static_cast<uint64_t>(tail[3]) << 24;
+      [[fallthrough]];
+    case 3:
+      key ^= static_cast<uint64_t>(tail[2]) << 16;
+      [[fallthrough]];
+    case 2:
+      key ^= static_cast<uint64_t>(tail[1]) << 8;
+      [[fallthrough]];
+    case 1:
+      key ^= static_cast<uint64_t>(tail[0]);
+      hash ^= mixKey(key);
+      break;
+    default:
+      break;
+  }
+
+  hash ^= length;
+  return fmix64(hash);
+}
+
+template <typename Func>
+void OrcBloomFilter::forEachBit(uint64_t hash, Func func) const {
+  // The arithmetic is on Java ints, which wrap around.
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = static_cast<int32_t>(bitset_.size() * 64);
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combinedHash = static_cast<int32_t>(hash1 + i * hash2);
+    if (combinedHash < 0) {
+      combinedHash = ~combinedHash;
+    }
+    if (!func(combinedHash % numBits)) {
+      return;
+    }
+  }
+}
+
+void OrcBloomFilter::addHash(uint64_t hash) {
+  forEachBit(hash, [&](int32_t bit) {
+    bitset_[bit / 64] |= 1ULL << (bit % 64);
+    return true;
+  });
+}
+
+bool OrcBloomFilter::testHash(uint64_t hash) const {
+  bool found = true;
+  forEachBit(hash, [&](int32_t bit) {
+    found = (bitset_[bit / 64] & (1ULL << (bit % 64))) != 0;
+    return found;
+  });
+  return found;
+}
+
+} // namespace facebook::velox::dwrf
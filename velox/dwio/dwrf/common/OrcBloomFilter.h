@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/orc-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+/// The bloom filter of a row group in an ORC BLOOM_FILTER_UTF8 stream. Bit
+/// compatible with the Java and C++ ORC writers: integers and dates are
+/// hashed with Thomas Wang's 64 bit integer hash, floating point values as
+/// the bits of the double they widen to, and strings and binaries with the
+/// 64 bit Murmur3 hash of their bytes.
+class OrcBloomFilter {
+ public:
+  OrcBloomFilter(uint32_t numHashFunctions, std::vector<uint64_t> bitset);
+
+  /// Builds the filter from its proto, which stores the bits either in
+  /// 'bitset' or as little endian bytes in 'utf8bitset'.
+  explicit OrcBloomFilter(const proto::orc::BloomFilter& proto);
+
+  void addLong(int64_t value) {
+    addHash(hashLong(value));
+  }
+
+  void addDouble(double value) {
+    addHash(hashDouble(value));
+  }
+
+  void addBytes(std::string_view value) {
+    addHash(hashBytes(value));
+  }
+
+  /// False if 'value' was definitely not added.
+  bool testLong(int64_t value) const {
+    return testHash(hashLong(value));
+  }
+
+  bool testDouble(double value) const {
+    return testHash(hashDouble(value));
+  }
+
+  bool testBytes(std::string_view value) const {
+    return testHash(hashBytes(value));
+  }
+
+  uint32_t numHashFunctions() const {
+    return numHashFunctions_;
+  }
+
+  const std::vector<uint64_t>& bitset() const {
+    return bitset_;
+  }
+
+  static uint64_t hashLong(int64_t value);
+
+  static uint64_t hashDouble(double value);
+
+  static uint64_t hashBytes(std::string_view value);
+
+ private:
+  void addHash(uint64_t hash);
+
+  bool testHash(uint64_t hash) const;
+
+  // Calls 'func' with the position of each bit for 'hash' until it returns
+  // false.
+  template <typename Func>
+  void forEachBit(uint64_t hash, Func func) const;
+
+  uint32_t numHashFunctions_;
+  std::vector<uint64_t> bitset_;
+};
+
+} // namespace facebook::velox::dwrf
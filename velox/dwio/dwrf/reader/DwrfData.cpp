@@ -19,13 +19,108 @@
 #include "velox/dwio/common/BufferUtil.h"
 
 namespace facebook::velox::dwrf {
+namespace {
+
+// Upper bound on the values of an IN list probed in the bloom filters. Longer
+// lists are unlikely to be selective enough to skip row groups.
+constexpr size_t kMaxBloomFilterValues = 1'024;
+
+template <typename T, typename Test>
+bool anyMayMatch(const T& values, Test test) {
+  if (values.size() > kMaxBloomFilterValues) {
+    return true;
+  }
+  for (const auto& value : values) {
+    if (test(value)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns false if no value passing 'filter' can be in the row group of
+// 'bloomFilter'. Only filters that pass a known set of values are checked.
+bool testBloomFilter(
+    const common::Filter& filter,
+    const OrcBloomFilter& bloomFilter,
+    const Type& type) {
+  if (type.isDecimal()) {
+    // ORC adds the string representation of decimals.
+    return true;
+  }
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT: {
+      const auto test = [&](int64_t value) {
+        return bloomFilter.testLong(value);
+      };
+      switch (filter.kind()) {
+        case common::FilterKind::kBigintRange: {
+          const auto& range = *filter.as<common::BigintRange>();
+          return !range.isSingleValue() || test(range.lower());
+        }
+        case common::FilterKind::kBigintValuesUsingHashTable:
+          return anyMayMatch(
+              filter.as<common::BigintValuesUsingHashTable>()->values(), test);
+        case common::FilterKind::kBigintValuesUsingBitmask:
+          return anyMayMatch(
+              filter.as<common::BigintValuesUsingBitmask>()->values(), test);
+        default:
+          return true;
+      }
+    }
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE: {
+      const auto testRange = [&](const auto& range) {
+        if (range.lowerUnbounded() || range.upperUnbounded() ||
+            range.lowerExclusive() || range.upperExclusive() ||
+            range.lower() != range.upper()) {
+          return true;
+        }
+        return bloomFilter.testDouble(range.lower());
+      };
+      switch (filter.kind()) {
+        case common::FilterKind::kDoubleRange:
+          return testRange(*filter.as<common::DoubleRange>());
+        case common::FilterKind::kFloatRange:
+          return testRange(*filter.as<common::FloatRange>());
+        default:
+          return true;
+      }
+    }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      const auto test = [&](const std::string& value) {
+        return bloomFilter.testBytes(value);
+      };
+      switch (filter.kind()) {
+        case common::FilterKind::kBytesRange: {
+          const auto& range = *filter.as<common::BytesRange>();
+          return !range.isSingleValue() || test(range.lower());
+        }
+        case common::FilterKind::kBytesValues:
+          return anyMayMatch(
+              filter.as<common::BytesValues>()->values(), test);
+        default:
+          return true;
+      }
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace
 
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
     FlatMapContext flatMapContext)
-    : memoryPool_(stripe.getMemoryPool()),
+    : format_{stripe.format()},
+      memoryPool_(stripe.getMemoryPool()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
       stripeRows_{stripe.stripeRows()},
@@ -55,6 +150,15 @@ DwrfData::DwrfData(
           proto::orc::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+
+  // Velox does not write bloom filters for DWRF and the ones from other DWRF
+  // writers are not known to be compatible, so only ORC ones are used.
+  if (format_ == DwrfFormat::kOrc) {
+    bloomFilterStream_ = stripe.getStream(
+        encodingKey.forKind(proto::orc::Stream_Kind_BLOOM_FILTER_UTF8),
+        streamLabels.label(),
+        false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -93,17 +197,38 @@ uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
 }
 
 void DwrfData::ensureRowGroupIndex() {
-  VELOX_CHECK(index_ || indexStream_, "Reader needs to have an index stream");
-  if (indexStream_) {
+  VELOX_CHECK(
+      index_ || orcIndex_ || indexStream_,
+      "Reader needs to have an index stream");
+  if (!indexStream_) {
+    return;
+  }
+  if (format_ == DwrfFormat::kDwrf) {
     index_ = ProtoUtils::readProto<proto::RowIndex>(std::move(indexStream_));
+  } else {
+    orcIndex_ =
+        ProtoUtils::readProto<proto::orc::RowIndex>(std::move(indexStream_));
+  }
+}
+
+bool DwrfData::ensureBloomFilters() {
+  if (bloomFilterStream_) {
+    auto index = ProtoUtils::readProto<proto::orc::BloomFilterIndex>(
+        std::move(bloomFilterStream_));
+    bloomFilters_.reserve(index->bloomfilter_size());
+    for (const auto& bloomFilter : index->bloomfilter()) {
+      bloomFilters_.emplace_back(bloomFilter);
+    }
   }
+  return !bloomFilters_.empty();
 }
 
 dwio::common::PositionProvider DwrfData::seekToRowGroup(int64_t index) {
   ensureRowGroupIndex();
-  VELOX_CHECK_LT(index, index_->entry_size(), "RowGroup index is corrupted");
+  VELOX_CHECK_LT(index, rowIndexSize(), "RowGroup index is corrupted");
 
-  positionsHolder_ = toPositionsInner(index_->entry(index));
+  const auto& positions = rowIndexPositions(index);
+  positionsHolder_.assign(positions.cbegin(), positions.cend());
   dwio::common::PositionProvider positionProvider(positionsHolder_);
   if (flatMapContext_.inMapDecoder) {
     flatMapContext_.inMapDecoder->seekToRowGroup(positionProvider);
@@ -155,14 +280,19 @@ void DwrfData::filterRowGroups(
     uint64_t rowGroupSize,
     const dwio::common::StatsContext& writerContext,
     FilterRowGroupsResult& result) {
-  if (!index_ && !indexStream_) {
+  if (!index_ && !orcIndex_ && !indexStream_) {
     return;
   }
 
   ensureRowGroupIndex();
   auto* filter = scanSpec.filter();
   auto* dwrfContext = reinterpret_cast<const StatsContext*>(&writerContext);
-  result.totalCount = std::max(result.totalCount, index_->entry_size());
+  const auto numRowGroups = rowIndexSize();
+  result.totalCount = std::max(result.totalCount, numRowGroups);
+  // Row groups with nulls can pass a filter that accepts nulls whatever
+  // their bloom filter says.
+  const bool useBloomFilters =
+      filter && !filter->testNull() && ensureBloomFilters();
   const auto nwords = bits::nwords(result.totalCount);
   if (result.filterResult.size() < nwords) {
     result.filterResult.resize(nwords);
@@ -174,10 +304,9 @@ void DwrfData::filterRowGroups(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
 
-  for (auto i = 0; i < index_->entry_size(); ++i) {
-    const auto& entry = index_->entry(i);
-    const auto columnStats = buildColumnStatisticsFromProto(
-        ColumnStatisticsWrapper(&entry.statistics()), *dwrfContext);
+  for (auto i = 0; i < numRowGroups; ++i) {
+    const auto columnStats =
+        buildColumnStatisticsFromProto(rowIndexStatistics(i), *dwrfContext);
     if (filter &&
         !testFilter(
             filter, columnStats.get(), rowGroupSize, fileType_->type())) {
@@ -185,6 +314,13 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (useBloomFilters && i < static_cast<int32_t>(bloomFilters_.size()) &&
+        !testBloomFilter(*filter, bloomFilters_[i], *fileType_->type())) {
+      VLOG(1) << "Drop stride " << i << " on bloom filter of "
+              << scanSpec.toString();
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
 
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
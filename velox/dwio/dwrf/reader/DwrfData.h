@@ -21,6 +21,8 @@
 #include "velox/dwio/common/TypeWithId.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/dwrf/common/ByteRLE.h"
+#include "velox/dwio/dwrf/common/FileMetadata.h"
+#include "velox/dwio/dwrf/common/OrcBloomFilter.h"
 #include "velox/dwio/dwrf/common/RLEv1.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
 #include "velox/dwio/dwrf/reader/EncodingContext.h"
@@ -92,23 +94,48 @@ class DwrfData : public dwio::common::FormatData {
   // if not already decoded. Throws if no index.
   void ensureRowGroupIndex();
 
-  auto& index() const {
-    return *index_;
+  /// Number of row groups in the row group index. The index must have been
+  /// decoded by ensureRowGroupIndex().
+  int32_t rowIndexSize() const {
+    return format_ == DwrfFormat::kDwrf ? index_->entry_size()
+                                        : orcIndex_->entry_size();
   }
 
- private:
-  static std::vector<uint64_t> toPositionsInner(
-      const proto::RowIndexEntry& entry) {
-    return std::vector<uint64_t>(
-        entry.positions().cbegin(), entry.positions().cend());
+  /// Stream positions of row group 'index'.
+  const google::protobuf::RepeatedField<uint64_t>& rowIndexPositions(
+      int32_t index) const {
+    return format_ == DwrfFormat::kDwrf
+        ? index_->entry(index).positions()
+        : orcIndex_->entry(index).positions();
+  }
+
+  /// Column statistics of row group 'index'.
+  ColumnStatisticsWrapper rowIndexStatistics(int32_t index) const {
+    return format_ == DwrfFormat::kDwrf
+        ? ColumnStatisticsWrapper(&index_->entry(index).statistics())
+        : ColumnStatisticsWrapper(&orcIndex_->entry(index).statistics());
   }
 
+ private:
+  // Decodes the bloom filters of the row groups, if the stripe has them and
+  // they are not already decoded. Returns true if there are bloom filters.
+  bool ensureBloomFilters();
+
+  const DwrfFormat format_;
+
   memory::MemoryPool& memoryPool_;
   const std::shared_ptr<const dwio::common::TypeWithId> fileType_;
   FlatMapContext flatMapContext_;
   std::unique_ptr<BooleanRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
+  // The row group index of a DWRF or an ORC file, depending on 'format_'.
+  // ORC files have their own message because some statistics fields use
+  // different tags.
   std::unique_ptr<proto::RowIndex> index_;
+  std::unique_ptr<proto::orc::RowIndex> orcIndex_;
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  // One per row group, decoded from 'bloomFilterStream_'.
+  std::vector<OrcBloomFilter> bloomFilters_;
   int64_t stripeRows_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
@@ -217,6 +217,7 @@ void DwrfUnit::loadDecoders() {
     VLOG(1) << "[DWRF] Load read plan for stripe " << stripeIndex_;
     stripeStreams_->loadReadPlan();
   }
+  stripeStreams_->decryptLoadedStreams();
 
   stripeDictionaryCache_ = stripeStreams_->getStripeDictionaryCache();
 }
@@ -708,6 +709,23 @@ void DwrfRowReader::loadCurrentStripe() {
   ++processedStrides_;
 }
 
+uint64_t DwrfRowReader::loadFirstUnit(uint64_t maxBytes) {
+  // With random skip the first stripe may be skipped without being read.
+  if (emptyFile() || currentUnit_ || currentStripe_ >= stripeCeiling_ ||
+      currentRowInStripe_ != 0 || getReader().randomSkip()) {
+    return 0;
+  }
+  const auto stripe = getReader().footer().stripes(currentStripe_);
+  // Only the streams of the selected columns are read, so this is an upper
+  // bound of the IO.
+  const auto ioSize = stripe.indexLength() + stripe.dataLength();
+  if (ioSize > maxBytes) {
+    return 0;
+  }
+  loadCurrentStripe();
+  return ioSize;
+}
+
 size_t DwrfRowReader::estimatedReaderMemory() const {
   VELOX_CHECK_NOT_NULL(columnSelector_);
   return 2 * DwrfReader::getMemoryUse(getReader(), -1, *columnSelector_);
@@ -132,6 +132,8 @@ class DwrfRowReader : public StrideIndexProvider,
 
   void loadCurrentStripe();
 
+  uint64_t loadFirstUnit(uint64_t maxBytes) override;
+
   std::optional<std::vector<PrefetchUnit>> prefetchUnits() override {
     return std::nullopt;
   }
@@ -150,8 +150,8 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
   }
 
   // get stride dictionary size and load it if needed
-  auto& positions =
-      formatData_->as<DwrfData>().index().entry(nextStride).positions();
+  const auto& positions =
+      formatData_->as<DwrfData>().rowIndexPositions(nextStride);
   scanState_.dictionary2.numValues = positions.Get(strideDictSizeOffset_);
   if (scanState_.dictionary2.numValues > 0) {
     // seek stride dictionary related streams
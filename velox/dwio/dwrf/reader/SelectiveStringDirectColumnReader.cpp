@@ -26,7 +26,10 @@ SelectiveStringDirectColumnReader::SelectiveStringDirectColumnReader(
     const std::shared_ptr<const dwio::common::TypeWithId>& fileType,
     DwrfParams& params,
     common::ScanSpec& scanSpec)
-    : SelectiveColumnReader(fileType->type(), fileType, params, scanSpec) {
+    : SelectiveColumnReader(fileType->type(), fileType, params, scanSpec),
+      referenceBlob_(params.stripeStreams()
+                         .rowReaderOptions()
+                         .passStringBuffersFromDecoder()) {
   EncodingKey encodingKey{fileType->id(), params.flatMapContext().sequence};
   auto& stripe = params.stripeStreams();
   RleVersion rleVersion = convertRleVersion(stripe, encodingKey);
@@ -65,6 +68,35 @@ uint64_t SelectiveStringDirectColumnReader::skip(uint64_t numValues) {
   return numValues;
 }
 
+bool SelectiveStringDirectColumnReader::canReferenceBlob(
+    const char* data,
+    int32_t length) {
+  // Readers of string data may load up to simd::kPadding bytes past the end.
+  if (!referenceBlob_ || data + length + simd::kPadding > bufferEnd_) {
+    return false;
+  }
+  if (pinnedBufferEnd_ != bufferEnd_) {
+    auto buffer = blobStream_->pinnedBuffer();
+    if (buffer == nullptr) {
+      referenceBlob_ = false;
+      return false;
+    }
+    stringBuffers_.push_back(std::move(buffer));
+    pinnedBufferEnd_ = bufferEnd_;
+  }
+  return true;
+}
+
+StringView SelectiveStringDirectColumnReader::makeStringView(
+    std::string_view value) {
+  if (value.size() <= StringView::kInlineSize ||
+      (value.data() != tempString_.data() &&
+       canReferenceBlob(value.data(), value.size()))) {
+    return StringView(value.data(), value.size());
+  }
+  return StringView(copyStringValue(value), value.size());
+}
+
 void SelectiveStringDirectColumnReader::extractCrossBuffers(
     const int32_t* lengths,
     const int64_t* starts,
@@ -79,17 +111,15 @@ void SelectiveStringDirectColumnReader::extractCrossBuffers(
     auto value = readValue(size);
     current += size + gap;
     if (!scatter) {
-      addValue(value);
-    } else {
-      auto index = outerNonNullRows_[rowIndex + i];
-      if (size <= StringView::kInlineSize) {
-        reinterpret_cast<StringView*>(rawValues_)[index] =
-            StringView(value.data(), size);
+      if (referenceBlob_) {
+        reinterpret_cast<StringView*>(rawValues_)[numValues_++] =
+            makeStringView(value);
       } else {
-        auto copy = copyStringValue(value);
-        reinterpret_cast<StringView*>(rawValues_)[index] =
-            StringView(copy, size);
+        addValue(value);
       }
+    } else {
+      auto index = outerNonNullRows_[rowIndex + i];
+      reinterpret_cast<StringView*>(rawValues_)[index] = makeStringView(value);
     }
   }
   skipBytes(bytesToSkip_, blobStream_.get(), bufferStart_, bufferEnd_);
@@ -291,6 +321,11 @@ inline bool SelectiveStringDirectColumnReader::try8Consecutive(
           reinterpret_cast<char*>(result + resultIndex + 1) + length) = 0;
       continue;
     }
+    if (canReferenceBlob(data, length)) {
+      *reinterpret_cast<const char**>(result + resultIndex + 2) = data;
+      data += length;
+      continue;
+    }
     if (!rawStringBuffer_ || rawUsed + length > rawStringSize_) {
       // Slow path if no space in raw strings
       return false;
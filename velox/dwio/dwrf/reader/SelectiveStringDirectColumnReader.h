@@ -51,6 +51,7 @@ class SelectiveStringDirectColumnReader
     rawStringBuffer_ = nullptr;
     rawStringSize_ = 0;
     rawStringUsed_ = 0;
+    pinnedBufferEnd_ = nullptr;
     getFlatValues<StringView, StringView>(rows, result, requestedType());
   }
 
@@ -60,6 +61,15 @@ class SelectiveStringDirectColumnReader
 
   std::string_view readValue(int32_t length);
 
+  // Returns true if the 'length' bytes at 'data' in the current buffer of
+  // 'blobStream_' can be referenced by the result instead of being copied.
+  // Adds the buffer that keeps them valid to 'stringBuffers_' if needed.
+  bool canReferenceBlob(const char* data, int32_t length);
+
+  // Returns a StringView of 'value' that is inlined, references the buffer of
+  // 'blobStream_' or references a copy in 'stringBuffers_'.
+  StringView makeStringView(std::string_view value);
+
   template <bool hasNulls, typename Visitor>
   void decode(const uint64_t* nulls, Visitor visitor);
 
@@ -100,6 +110,13 @@ class SelectiveStringDirectColumnReader
   // Storage for a string straddling a buffer boundary. Needed for calling
   // the filter.
   std::string tempString_;
+  // True if values may reference the buffers of 'blobStream_', e.g. pinned
+  // cache entries, instead of being copied. Cleared if 'blobStream_' cannot
+  // provide a buffer to keep its bytes valid.
+  bool referenceBlob_;
+  // End of the buffer of 'blobStream_' that is kept valid by the last buffer
+  // added to 'stringBuffers_' by canReferenceBlob(). nullptr if none.
+  const char* pinnedBufferEnd_{nullptr};
 };
 
 } // namespace facebook::velox::dwrf
@@ -344,11 +344,20 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
   const auto streamDebugInfo =
       fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
 
-  return readState_->readerBase->createDecompressedStream(
+  const auto* decrypter = getDecrypter(si.encodingKey().node());
+  auto stream = readState_->readerBase->createDecompressedStream(
       std::move(streamInput),
       streamDebugInfo,
-      getDecrypter(si.encodingKey().node()),
+      decrypter,
       getDecompressCounter(si.encodingKey().node()));
+  if (decrypter != nullptr && opts_.decryptOnLoad()) {
+    if (auto* paged =
+            dynamic_cast<dwio::common::compression::PagedInputStream*>(
+                stream.get())) {
+      encryptedStreams_.push_back(paged);
+    }
+  }
+  return stream;
 }
 
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
@@ -415,4 +424,11 @@ void StripeStreamsImpl::loadReadPlan() {
   input->load(LogType::STREAM_BUNDLE);
 }
 
+void StripeStreamsImpl::decryptLoadedStreams() {
+  for (auto* stream : encryptedStreams_) {
+    stream->decompressAhead();
+  }
+  encryptedStreams_.clear();
+}
+
 } // namespace facebook::velox::dwrf
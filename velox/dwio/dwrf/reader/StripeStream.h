@@ -21,6 +21,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/reader/StreamLabels.h"
 #include "velox/dwio/dwrf/reader/StripeDictionaryCache.h"
@@ -300,6 +301,11 @@ class StripeStreamsImpl : public StripeStreamsBase {
   /// load data into buffer according to read plan
   void loadReadPlan();
 
+  /// Decrypts the loaded encrypted streams returned by getStream() if
+  /// RowReaderOptions::decryptOnLoad() is set. The streams must still be
+  /// alive, i.e. owned by the column readers built on 'this'.
+  void decryptLoadedStreams();
+
   std::unique_ptr<dwio::common::SeekableInputStream> getCompressedStream(
       const DwrfStreamIdentifier& si,
       std::string_view label) const;
@@ -398,6 +404,10 @@ class StripeStreamsImpl : public StripeStreamsBase {
   folly::F14FastMap<EncodingKey, uint32_t, EncodingKeyHash> encodings_;
   folly::F14FastMap<EncodingKey, proto::ColumnEncoding, EncodingKeyHash>
       decryptedEncodings_;
+
+  // The encrypted streams to decrypt in decryptLoadedStreams().
+  mutable std::vector<dwio::common::compression::PagedInputStream*>
+      encryptedStreams_;
 };
 
 /// StripeInformation Implementation
@@ -24,6 +24,7 @@
 #include <folly/Random.h>
 #include <gtest/gtest.h>
 #include "velox/common/compression/Compression.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 
 #include <algorithm>
 
@@ -81,7 +82,8 @@ void decompressAndVerify(
     const char* data,
     size_t size,
     MemoryPool& pool,
-    const Decrypter* decrypter) {
+    const Decrypter* decrypter,
+    bool decompressAhead = false) {
   std::unique_ptr<SeekableInputStream> inputStream(
       new SeekableArrayInputStream(memSink.data(), memSink.size()));
 
@@ -92,6 +94,16 @@ void decompressAndVerify(
       pool,
       "Test Comrpession",
       decrypter);
+  if (decompressAhead) {
+    auto* paged = dynamic_cast<compression::PagedInputStream*>(
+        decompressStream.get());
+    // An unencrypted zlib stream is decompressed as a stream.
+    ASSERT_EQ(
+        paged != nullptr && paged->decompressAhead(),
+        decrypter != nullptr ||
+            (kind != CompressionKind_ZLIB && kind != CompressionKind_GZIP &&
+             kind != CompressionKind_NONE));
+  }
 
   const char* decompressedBuffer;
   int32_t decompressedSize;
@@ -241,6 +253,28 @@ TEST_P(CompressionTest, compressRandomBytes) {
       memSink, kind_, block, testData, dataSize, *pool_, decrypter_);
 }
 
+TEST_P(CompressionTest, decompressAhead) {
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+
+  uint64_t block = 1024;
+  constexpr size_t dataSize = 64 * 1024;
+
+  // All the blocks are decrypted and decompressed before the first read.
+  char testData[dataSize];
+  generateRandomData(testData, dataSize, true);
+  compressAndVerify(
+      kind_, memSink, block, *pool_, testData, dataSize, encrypter_);
+  decompressAndVerify(
+      memSink,
+      kind_,
+      block,
+      testData,
+      dataSize,
+      *pool_,
+      decrypter_,
+      /*decompressAhead=*/true);
+}
+
 void verifyProto(
     const MemorySink& memSink,
     CompressionKind kind,
@@ -94,6 +94,7 @@ TEST(ConfigTests, writerOptionsDefaultConfig) {
       getConfig(config, Config::MAX_DICTIONARY_SIZE), 16L * 1024L * 1024L);
   ASSERT_TRUE(getConfig(config, Config::INTEGER_DICTIONARY_ENCODING_ENABLED));
   ASSERT_TRUE(getConfig(config, Config::STRING_DICTIONARY_ENCODING_ENABLED));
+  ASSERT_FALSE(getConfig(config, Config::STRING_DICTIONARY_EARLY_CHECK));
   ASSERT_EQ(getConfig(config, Config::COMPRESSION_BLOCK_SIZE_MIN), 1024);
   ASSERT_EQ(getConfig(config, Config::ZLIB_COMPRESSION_LEVEL), 4);
   ASSERT_EQ(getConfig(config, Config::ZSTD_COMPRESSION_LEVEL), 3);
@@ -106,6 +107,7 @@ TEST(ConfigTests, writerOptionsOverrideConfig) {
       {Config::kOrcWriterMaxDictionaryMemory, "100MB"},
       {Config::kOrcWriterIntegerDictionaryEncodingEnabled, "false"},
       {Config::kOrcWriterStringDictionaryEncodingEnabled, "false"},
+      {Config::kOrcWriterStringDictionaryEarlyCheck, "true"},
       {Config::kOrcWriterLinearStripeSizeHeuristics, "false"},
       {Config::kOrcWriterMinCompressionSize, "512"},
       {Config::kOrcWriterCompressionLevel, "1"}};
@@ -120,6 +122,7 @@ TEST(ConfigTests, writerOptionsOverrideConfig) {
       getConfig(config, Config::MAX_DICTIONARY_SIZE), 100L * 1024L * 1024L);
   ASSERT_FALSE(getConfig(config, Config::INTEGER_DICTIONARY_ENCODING_ENABLED));
   ASSERT_FALSE(getConfig(config, Config::STRING_DICTIONARY_ENCODING_ENABLED));
+  ASSERT_TRUE(getConfig(config, Config::STRING_DICTIONARY_EARLY_CHECK));
   ASSERT_EQ(getConfig(config, Config::COMPRESSION_BLOCK_SIZE_MIN), 512);
   ASSERT_EQ(getConfig(config, Config::ZLIB_COMPRESSION_LEVEL), 1);
   ASSERT_EQ(getConfig(config, Config::ZSTD_COMPRESSION_LEVEL), 1);
@@ -133,6 +136,7 @@ TEST(ConfigTests, writerOptionsOverrideSession) {
       {Config::kOrcWriterMaxDictionaryMemorySession, "24MB"},
       {Config::kOrcWriterIntegerDictionaryEncodingEnabledSession, "false"},
       {Config::kOrcWriterStringDictionaryEncodingEnabledSession, "false"},
+      {Config::kOrcWriterStringDictionaryEarlyCheckSession, "true"},
       {Config::kOrcWriterMinCompressionSizeSession, "512"},
       {Config::kOrcWriterCompressionLevelSession, "1"},
       {Config::kOrcWriterLinearStripeSizeHeuristicsSession, "false"}};
@@ -149,6 +153,7 @@ TEST(ConfigTests, writerOptionsOverrideSession) {
       getConfig(config, Config::MAX_DICTIONARY_SIZE), 24L * 1024L * 1024L);
   ASSERT_FALSE(getConfig(config, Config::INTEGER_DICTIONARY_ENCODING_ENABLED));
   ASSERT_FALSE(getConfig(config, Config::STRING_DICTIONARY_ENCODING_ENABLED));
+  ASSERT_TRUE(getConfig(config, Config::STRING_DICTIONARY_EARLY_CHECK));
   ASSERT_EQ(getConfig(config, Config::COMPRESSION_BLOCK_SIZE_MIN), 512);
   ASSERT_EQ(getConfig(config, Config::ZLIB_COMPRESSION_LEVEL), 1);
   ASSERT_EQ(getConfig(config, Config::ZSTD_COMPRESSION_LEVEL), 1);
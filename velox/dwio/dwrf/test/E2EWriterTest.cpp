@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -379,6 +380,122 @@ TEST_F(E2EWriterTest, E2E) {
   dwrf::E2EWriterTestUtil::testWriter(*leafPool_, type, batches, 1, 1, config);
 }
 
+TEST_F(E2EWriterTest, flushExecutor) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "array_val:array<float>,"
+      "map_val:map<int,double>,"
+      "flat_map_val:map<bigint,string>," /* this is column 6 */
+      "struct_val:struct<a:float,b:string>"
+      ">");
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set<const std::vector<uint32_t>>(dwrf::Config::MAP_FLAT_COLS, {6});
+
+  std::vector<VectorPtr> batches;
+  for (size_t i = 0; i < 4; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 2'000, *leafPool_, nullptr, i));
+  }
+
+  folly::CPUThreadPoolExecutor executor{4};
+  // The writer owns the sink, so it is returned to keep the sink alive.
+  auto write = [&](folly::Executor* flushExecutor, MemorySink*& sinkPtr) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.flushExecutor = flushExecutor;
+    auto writer = std::make_unique<dwrf::Writer>(std::move(sink), options);
+    for (const auto& batch : batches) {
+      writer->write(batch);
+      writer->flush();
+    }
+    writer->close();
+    return writer;
+  };
+
+  // Flushing the columns concurrently produces the same file.
+  MemorySink* serialSink;
+  auto serialWriter = write(nullptr, serialSink);
+  MemorySink* concurrentSink;
+  auto concurrentWriter = write(&executor, concurrentSink);
+  ASSERT_EQ(
+      std::string_view(serialSink->data(), serialSink->size()),
+      std::string_view(concurrentSink->data(), concurrentSink->size()));
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(*concurrentSink, readerOpts);
+  ASSERT_EQ(reader->getNumberOfStripes(), batches.size());
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  VectorPtr result;
+  for (const auto& batch : batches) {
+    ASSERT_TRUE(rowReader->next(batch->size(), result));
+    for (vector_size_t i = 0; i < batch->size(); ++i) {
+      ASSERT_TRUE(batch->equalValueAt(result.get(), i, i));
+    }
+  }
+}
+
+TEST_F(E2EWriterTest, stringDictionaryEarlyCheck) {
+  VectorMaker maker{leafPool_.get()};
+  const vector_size_t size = 5'000;
+  auto batch = maker.rowVector(
+      {"unique", "repeated"},
+      {maker.flatVector<std::string>(
+           size, [](auto row) { return fmt::format("unique_{}", row); }),
+       maker.flatVector<std::string>(
+           size, [](auto row) { return fmt::format("value_{}", row % 10); })});
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1000));
+  config->set(dwrf::Config::STRING_DICTIONARY_EARLY_CHECK, true);
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  dwrf::WriterOptions options;
+  options.config = config;
+  options.schema = batch->type();
+  options.memoryPool = rootPool_.get();
+  dwrf::Writer writer{std::move(sink), options};
+  writer.write(batch);
+  writer.close();
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(*sinkPtr, readerOpts);
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  auto* dwrfRowReader = dynamic_cast<dwrf::DwrfRowReader*>(rowReader.get());
+  auto stripeMetadata = dwrfRowReader->fetchStripe(0, /*preload=*/true);
+  const auto& footer = *stripeMetadata->footer;
+  std::unordered_map<uint32_t, dwrf::proto::ColumnEncoding_Kind> kinds;
+  for (int32_t i = 0; i < footer.columnEncodingSize(); ++i) {
+    const auto& encoding = footer.columnEncodingDwrf(i);
+    kinds[encoding.node()] = encoding.kind();
+  }
+  // The unique values abandon the dictionary after the first stride.
+  ASSERT_EQ(kinds.at(1), dwrf::proto::ColumnEncoding_Kind_DIRECT);
+  ASSERT_EQ(kinds.at(2), dwrf::proto::ColumnEncoding_Kind_DICTIONARY);
+
+  VectorPtr result;
+  auto dataReader = reader->createRowReader(RowReaderOptions{});
+  ASSERT_TRUE(dataReader->next(size, result));
+  ASSERT_EQ(result->size(), size);
+  for (vector_size_t i = 0; i < size; ++i) {
+    ASSERT_TRUE(batch->equalValueAt(result.get(), i, i));
+  }
+}
+
 // Disabled because test is failing in continuous runs T193531984.
 TEST_F(E2EWriterTest, DISABLED_DisableLinearHeuristics) {
   const size_t batchCount = 100;
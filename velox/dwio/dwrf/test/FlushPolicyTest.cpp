@@ -326,4 +326,68 @@ TEST_F(DefaultFlushPolicyTest, FlushTest) {
       exception::LoggedException)
       << "Out of Range Stripe";
 }
+
+TEST_F(DefaultFlushPolicyTest, adaptive) {
+  AdaptiveFlushPolicy::Options options{
+      .stripeSizeThreshold = 1000,
+      .dictionarySizeThreshold = std::numeric_limits<uint64_t>::max(),
+      .maxMemoryUsage = 10'000};
+  AdaptiveFlushPolicy policy{options};
+  auto decide = [&](int64_t stripeSize,
+                    const AdaptiveFlushPolicy::Signals& signals) {
+    return policy.shouldFlushDictionary(
+        /*flushStripe=*/false,
+        /*overMemoryBudget=*/false,
+        dwio::common::StripeProgress{.stripeSizeEstimate = stripeSize},
+        signals);
+  };
+
+  // No pressure: the default policy decides.
+  EXPECT_EQ(decide(100, {.memoryUsage = 1'000}), FlushDecision::SKIP);
+  EXPECT_EQ(
+      decide(400, {.memoryUsage = 1'000}), FlushDecision::EVALUATE_DICTIONARY);
+
+  // Pool pressure flushes stripes that are not too small.
+  EXPECT_EQ(
+      decide(200, {.memoryUsage = 1'000, .poolUsageRatio = 0.95}),
+      FlushDecision::SKIP);
+  EXPECT_EQ(
+      decide(500, {.memoryUsage = 1'000, .poolUsageRatio = 0.95}),
+      FlushDecision::FLUSH_STRIPE);
+
+  // Over the memory limit, a small stripe mostly made of dictionaries
+  // abandons them once, then flushes.
+  const AdaptiveFlushPolicy::Signals overLimit{
+      .memoryUsage = 12'000, .dictionaryMemoryUsage = 8'000};
+  EXPECT_EQ(decide(100, overLimit), FlushDecision::ABANDON_DICTIONARY);
+  EXPECT_EQ(decide(100, overLimit), FlushDecision::FLUSH_STRIPE);
+  EXPECT_EQ(
+      decide(100, {.memoryUsage = 12'000}), FlushDecision::FLUSH_STRIPE);
+
+  // The stripe is being flushed anyway.
+  EXPECT_EQ(
+      policy.shouldFlushDictionary(
+          /*flushStripe=*/true,
+          /*overMemoryBudget=*/false,
+          dwio::common::StripeProgress{.stripeSizeEstimate = 100},
+          overLimit),
+      FlushDecision::SKIP);
+}
+
+TEST_F(DefaultFlushPolicyTest, adaptiveWithContext) {
+  auto config = std::make_shared<Config>();
+  WriterContext context{
+      config, memory::memoryManager()->addRootPool("adaptiveWithContext")};
+  AdaptiveFlushPolicy policy{
+      {.stripeSizeThreshold = 1000,
+       .dictionarySizeThreshold = std::numeric_limits<uint64_t>::max()}};
+  // An empty writer in an unbounded pool is not under pressure.
+  EXPECT_EQ(
+      policy.shouldFlushDictionary(
+          /*flushStripe=*/false,
+          /*overMemoryBudget=*/false,
+          dwio::common::StripeProgress{.stripeSizeEstimate = 100},
+          context),
+      FlushDecision::SKIP);
+}
 } // namespace facebook::velox::dwrf
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/OrcBloomFilter.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+OrcBloomFilter makeFilter() {
+  // 1024 bits and the number of hash functions ORC uses for a 5% false
+  // positive rate.
+  return OrcBloomFilter(4, std::vector<uint64_t>(16));
+}
+
+} // namespace
+
+TEST(OrcBloomFilterTest, longs) {
+  auto filter = makeFilter();
+  for (int64_t i = 0; i < 100; i += 3) {
+    filter.addLong(i * 1'000'003);
+  }
+  filter.addLong(std::numeric_limits<int64_t>::min());
+  filter.addLong(-1);
+
+  for (int64_t i = 0; i < 100; i += 3) {
+    EXPECT_TRUE(filter.testLong(i * 1'000'003));
+  }
+  EXPECT_TRUE(filter.testLong(std::numeric_limits<int64_t>::min()));
+  EXPECT_TRUE(filter.testLong(-1));
+
+  int32_t falsePositives = 0;
+  for (int64_t i = 1; i < 1'000; i += 3) {
+    falsePositives += filter.testLong(i * 1'000'003);
+  }
+  EXPECT_LT(falsePositives, 100);
+}
+
+TEST(OrcBloomFilterTest, doubles) {
+  auto filter = makeFilter();
+  filter.addDouble(1.5);
+  filter.addDouble(std::nan(""));
+  // Floats are widened to double by the writer.
+  filter.addDouble(static_cast<float>(0.1));
+
+  EXPECT_TRUE(filter.testDouble(1.5));
+  EXPECT_TRUE(filter.testDouble(-std::nan("1")));
+  EXPECT_TRUE(filter.testDouble(0.1f));
+  EXPECT_FALSE(filter.testDouble(2.5));
+  EXPECT_FALSE(filter.testDouble(0.1));
+  EXPECT_EQ(OrcBloomFilter::hashDouble(0.5), OrcBloomFilter::hashDouble(0.5));
+  EXPECT_NE(OrcBloomFilter::hashDouble(0.5), OrcBloomFilter::hashLong(0));
+}
+
+TEST(OrcBloomFilterTest, bytes) {
+  auto filter = makeFilter();
+  // Lengths cover the tail of every size after the 8 byte blocks.
+  std::vector<std::string> values;
+  for (int32_t length = 0; length <= 17; ++length) {
+    values.push_back(std::string(length, 'a' + length));
+  }
+  for (const auto& value : values) {
+    filter.addBytes(value);
+  }
+  for (const auto& value : values) {
+    EXPECT_TRUE(filter.testBytes(value));
+  }
+  EXPECT_FALSE(filter.testBytes("not added"));
+  // Bytes with the high bit set must not be sign extended.
+  EXPECT_NE(
+      OrcBloomFilter::hashBytes("\x80\xff"),
+      OrcBloomFilter::hashBytes("\x80\x7f"));
+}
+
+TEST(OrcBloomFilterTest, proto) {
+  auto filter = makeFilter();
+  for (int64_t i = 0; i < 10; ++i) {
+    filter.addLong(i);
+  }
+
+  proto::orc::BloomFilter fixed;
+  fixed.set_numhashfunctions(filter.numHashFunctions());
+  for (auto word : filter.bitset()) {
+    fixed.add_bitset(word);
+  }
+  proto::orc::BloomFilter utf8;
+  utf8.set_numhashfunctions(filter.numHashFunctions());
+  utf8.set_utf8bitset(
+      reinterpret_cast<const char*>(filter.bitset().data()),
+      filter.bitset().size() * sizeof(uint64_t));
+
+  for (const auto& proto : {fixed, utf8}) {
+    OrcBloomFilter copy(proto);
+    EXPECT_EQ(copy.numHashFunctions(), filter.numHashFunctions());
+    EXPECT_EQ(copy.bitset(), filter.bitset());
+    for (int64_t i = 0; i < 10; ++i) {
+      EXPECT_TRUE(copy.testLong(i));
+    }
+  }
+
+  utf8.set_utf8bitset("123");
+  VELOX_ASSERT_THROW(OrcBloomFilter{utf8}, "Corrupt bloom filter bitset");
+  VELOX_ASSERT_THROW(
+      OrcBloomFilter(0, std::vector<uint64_t>(1)),
+      "Bloom filter without hash functions");
+}
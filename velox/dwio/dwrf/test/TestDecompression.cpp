@@ -23,6 +23,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <cstdio>
@@ -969,6 +970,58 @@ TEST_F(TestSeek, Snappy) {
   runTest(*codec, CompressionKind_SNAPPY);
 }
 
+TEST_F(TestSeek, decompressAhead) {
+  auto codec = getCodec(CodecType::ZSTD);
+  constexpr size_t kInputSize = 1024;
+  constexpr size_t kOutputSize = 4096;
+  char output[kOutputSize];
+  char input1[kInputSize];
+  char input2[kInputSize];
+  size_t offset1;
+  size_t offset2;
+  prepareTestData(
+      *codec, input1, input2, kInputSize, output, offset1, offset2);
+
+  auto stream = createTestDecompressor(
+      CompressionKind_ZSTD,
+      std::make_unique<SeekableArrayInputStream>(
+          output, offset2, kOutputSize / 10),
+      kOutputSize);
+  auto* paged =
+      dynamic_cast<dwio::common::compression::PagedInputStream*>(stream.get());
+  ASSERT_NE(paged, nullptr);
+  ASSERT_TRUE(paged->decompressAhead());
+  // The blocks are already decompressed.
+  ASSERT_FALSE(paged->decompressAhead());
+
+  const void* data;
+  int32_t size;
+  ASSERT_TRUE(stream->Next(&data, &size));
+  ASSERT_EQ(size, kInputSize);
+  EXPECT_EQ(0, memcmp(data, input1, kInputSize));
+  stream->BackUp(10);
+  ASSERT_TRUE(stream->Next(&data, &size));
+  ASSERT_EQ(size, 10);
+  EXPECT_EQ(0, memcmp(data, input1 + kInputSize - 10, 10));
+  ASSERT_TRUE(stream->Next(&data, &size));
+  ASSERT_EQ(size, kInputSize);
+  EXPECT_EQ(0, memcmp(data, input2, kInputSize));
+  ASSERT_FALSE(stream->Next(&data, &size));
+
+  const size_t seekPos = folly::Random::rand32() % 1000 + 1;
+  const size_t positions[][2]{
+      {offset1, seekPos}, {0, seekPos}, {0, 0}, {offset1, 0}};
+  const char* expected[]{input2, input1, input1, input2};
+  for (size_t i = 0; i < std::size(positions); ++i) {
+    std::vector<uint64_t> list{positions[i][0], positions[i][1]};
+    PositionProvider provider(list);
+    stream->seekToPosition(provider);
+    ASSERT_TRUE(stream->Next(&data, &size));
+    ASSERT_EQ(size, kInputSize - positions[i][1]);
+    EXPECT_EQ(0, memcmp(data, expected[i] + positions[i][1], size));
+  }
+}
+
 TEST_F(TestSeek, uncompressed) {
   constexpr int32_t kSize = 1000;
   constexpr int32_t kHeaderSize = 3;
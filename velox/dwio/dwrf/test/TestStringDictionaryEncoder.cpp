@@ -58,6 +58,33 @@ TEST_F(TestStringDictionaryEncoder, AddKey) {
   }
 }
 
+TEST_F(TestStringDictionaryEncoder, AddKeys) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  StringDictionaryEncoder batchEncoder{*pool, *pool};
+  StringDictionaryEncoder singleEncoder{*pool, *pool};
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 1'000; ++i) {
+    values.push_back("value_" + std::to_string(i % 37));
+  }
+  std::vector<std::string_view> keys{values.begin(), values.end()};
+
+  std::vector<uint32_t> indices(keys.size());
+  batchEncoder.addKeys(keys.data(), keys.size(), 1, indices.data());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(indices[i], singleEncoder.addKey(keys[i], 1));
+    ASSERT_EQ(batchEncoder.getKey(indices[i]), keys[i]);
+  }
+  ASSERT_EQ(batchEncoder.size(), 37);
+  for (uint32_t i = 0; i < batchEncoder.size(); ++i) {
+    ASSERT_EQ(batchEncoder.getCount(i), singleEncoder.getCount(i));
+    ASSERT_EQ(batchEncoder.getStride(i), 1);
+  }
+
+  // Empty batches are no-ops.
+  batchEncoder.addKeys(keys.data(), 0, 2, indices.data());
+  ASSERT_EQ(batchEncoder.size(), 37);
+}
+
 TEST_F(TestStringDictionaryEncoder, GetIndex) {
   struct TestCase {
     explicit TestCase(
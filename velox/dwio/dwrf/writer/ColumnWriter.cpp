@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+#include <folly/futures/Future.h>
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
@@ -931,6 +932,7 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_STRING_DICT_SAMPLE_FRACTION),
             getConfig(Config::ENTROPY_STRING_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
+        dictionaryEarlyCheck_{getConfig(Config::STRING_DICTIONARY_EARLY_CHECK)},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
     VELOX_CHECK(firstStripe_);
@@ -1033,6 +1035,14 @@ class StringColumnWriter : public BaseColumnWriter {
       // Record the stride boundaries so that we can backfill the stream
       // positions when actually writing the streams.
       strideOffsets_.append(rows_.size());
+      // The first stride of the first stripe is the sample deciding whether
+      // building the dictionary is worth it.
+      if (dictionaryEarlyCheck_ && firstStripe_ &&
+          strideOffsets_.size() == 2 && rows_.size() > 0 &&
+          encodingSelector_.exceedsDictionaryKeySizeThreshold(
+              dictEncoder_, rows_.size())) {
+        tryAbandonDictionaries(/*force=*/true);
+      }
     } else {
       recordDirectEncodingStreamPositions();
     }
@@ -1206,6 +1216,7 @@ class StringColumnWriter : public BaseColumnWriter {
   size_t finalDictionarySize_;
   EntropyEncodingSelector encodingSelector_;
   const bool sort_;
+  const bool dictionaryEarlyCheck_;
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
   // encoding.
@@ -1236,11 +1247,13 @@ uint64_t StringColumnWriter::writeDict(
   // make sure we have enough space
   rows_.reserve(rows_.size() + ranges.size());
   size_t strideIndex = strideOffsets_.size() - 1;
+  // The non-null values are added to the dictionary in one batch.
+  DataBuffer<StringView> keys{getMemoryPool(MemoryUsageCategory::GENERAL)};
+  keys.reserve(ranges.size());
   uint64_t rawSize = 0;
   auto processRow = [&](size_t pos) {
     auto sv = decodedVector.valueAt<StringView>(pos);
-    // TODO: Remove explicit std::string_view cast.
-    rows_.unsafeAppend(dictEncoder_.addKey(std::string_view(sv), strideIndex));
+    keys.unsafeAppend(sv);
     // TODO: Remove explicit std::string_view cast.
     statsBuilder.addValues(std::string_view(sv));
     rawSize += sv.size();
@@ -1261,6 +1274,13 @@ uint64_t StringColumnWriter::writeDict(
     }
   }
 
+  DataBuffer<uint32_t> indices{getMemoryPool(MemoryUsageCategory::GENERAL)};
+  indices.resize(keys.size());
+  dictEncoder_.addKeys(keys.data(), keys.size(), strideIndex, indices.data());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    rows_.unsafeAppend(indices[i]);
+  }
+
   if (nullCount > 0) {
     statsBuilder.setHasNull();
     rawSize += nullCount * NULL_SIZE;
@@ -1742,6 +1762,12 @@ class StructColumnWriter : public BaseColumnWriter {
       std::function<ColumnEncodingWriteWrapper(uint32_t)> encodingFactory,
       std::function<void(ColumnEncodingWriteWrapper&)> encodingOverride)
       override {
+    if (isRoot() && children_.size() > 1 &&
+        context_.flushExecutor() != nullptr &&
+        !context_.getEncryptionHandler().isEncrypted()) {
+      flushChildrenConcurrently(encodingFactory, encodingOverride);
+      return;
+    }
     BaseColumnWriter::flush(encodingFactory, encodingOverride);
     for (auto& c : children_) {
       c->flush(encodingFactory);
@@ -1749,12 +1775,76 @@ class StructColumnWriter : public BaseColumnWriter {
   }
 
  private:
+  // Flushes the children on the flush executor, one task per child, so that
+  // their streams are encoded and compressed concurrently. A flat map is
+  // flushed as a whole by one task. The encodings go to the footer in column
+  // order, so they are recorded per child and added after all tasks finish.
+  void flushChildrenConcurrently(
+      const std::function<ColumnEncodingWriteWrapper(uint32_t)>&
+          encodingFactory,
+      const std::function<void(ColumnEncodingWriteWrapper&)>&
+          encodingOverride);
+
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
 };
 
+void StructColumnWriter::flushChildrenConcurrently(
+    const std::function<ColumnEncodingWriteWrapper(uint32_t)>& encodingFactory,
+    const std::function<void(ColumnEncodingWriteWrapper&)>& encodingOverride) {
+  DwrfFormat format{DwrfFormat::kDwrf};
+  BaseColumnWriter::flush(
+      [&](uint32_t nodeId) {
+        auto encoding = encodingFactory(nodeId);
+        format = encoding.format();
+        return encoding;
+      },
+      encodingOverride);
+
+  using RecordedEncodings = std::vector<
+      std::pair<uint32_t, std::unique_ptr<google::protobuf::Message>>>;
+  std::vector<RecordedEncodings> recorded(children_.size());
+  std::vector<folly::Future<folly::Unit>> futures;
+  futures.reserve(children_.size());
+  for (size_t i = 0; i < children_.size(); ++i) {
+    futures.push_back(folly::via(context_.flushExecutor(), [&, i]() {
+      auto& encodings = recorded[i];
+      children_[i]->flush([&](uint32_t nodeId) {
+        if (format == DwrfFormat::kDwrf) {
+          auto encoding = std::make_unique<proto::ColumnEncoding>();
+          auto* rawEncoding = encoding.get();
+          encodings.emplace_back(nodeId, std::move(encoding));
+          return ColumnEncodingWriteWrapper(rawEncoding);
+        }
+        auto encoding = std::make_unique<proto::orc::ColumnEncoding>();
+        auto* rawEncoding = encoding.get();
+        encodings.emplace_back(nodeId, std::move(encoding));
+        return ColumnEncodingWriteWrapper(rawEncoding);
+      });
+    }));
+  }
+  // Waits for all tasks before rethrowing since they reference 'recorded'.
+  auto results = folly::collectAll(std::move(futures)).get();
+  context_.releaseSpareCompressionBuffers();
+  for (auto& result : results) {
+    result.throwUnlessValue();
+  }
+
+  for (const auto& encodings : recorded) {
+    for (const auto& [nodeId, encoding] : encodings) {
+      auto wrapper = encodingFactory(nodeId);
+      VELOX_CHECK(wrapper.format() == format);
+      google::protobuf::Message* target = format == DwrfFormat::kDwrf
+          ? static_cast<google::protobuf::Message*>(
+                static_cast<proto::ColumnEncoding*>(wrapper.rawProtoPtr()))
+          : static_cast<proto::orc::ColumnEncoding*>(wrapper.rawProtoPtr());
+      target->CopyFrom(*encoding);
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
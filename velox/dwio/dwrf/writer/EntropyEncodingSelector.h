@@ -54,18 +54,11 @@ class EntropyEncodingSelector {
       const StringDictionaryEncoder& dictEncoder,
       uint64_t valueCount) const {
     DWIO_ENSURE(valueCount, "No rows provided to encoding selector!");
-    // The fraction of non-null values in this column that are repeats of values
-    // in the dictionary
-    float repeatedValuesFraction =
-        static_cast<float>(valueCount - dictEncoder.size()) / valueCount;
-
-    // dictionaryKeySizeThreshold is the fraction of keys that are distinct
-    // beyond which dictionary encoding is turned off so 1 -
-    // dictionaryKeySizeThreshold is the number of repeated values below which
-    // dictionary encoding should be turned off
-    if (repeatedValuesFraction < 1.0 - dictionaryKeySizeThreshold_) {
+    if (exceedsDictionaryKeySizeThreshold(dictEncoder, valueCount)) {
       return false;
     }
+    const float repeatedValuesFraction =
+        repeatedValuesFractionOf(dictEncoder, valueCount);
 
     // If the number of repeated values is small enough, consider using the
     // entropy heuristic If the number of repeated values is high, even in the
@@ -76,7 +69,30 @@ class EntropyEncodingSelector {
         : true;
   }
 
+  /// Returns true if too few of 'valueCount' values are repeats for
+  /// dictionary encoding to pay off. Cheaper than useDictionary(), so that
+  /// dictionary encoding can be abandoned early on a sample of the values.
+  bool exceedsDictionaryKeySizeThreshold(
+      const StringDictionaryEncoder& dictEncoder,
+      uint64_t valueCount) const {
+    DWIO_ENSURE(valueCount, "No rows provided to encoding selector!");
+    // dictionaryKeySizeThreshold is the fraction of keys that are distinct
+    // beyond which dictionary encoding is turned off so 1 -
+    // dictionaryKeySizeThreshold is the number of repeated values below which
+    // dictionary encoding should be turned off
+    return repeatedValuesFractionOf(dictEncoder, valueCount) <
+        1.0 - dictionaryKeySizeThreshold_;
+  }
+
  private:
+  // The fraction of non-null values in this column that are repeats of values
+  // in the dictionary
+  static float repeatedValuesFractionOf(
+      const StringDictionaryEncoder& dictEncoder,
+      uint64_t valueCount) {
+    return static_cast<float>(valueCount - dictEncoder.size()) / valueCount;
+  }
+
   bool useDictionaryEncodingEntropyHeuristic(
       const StringDictionaryEncoder& dictEncoder) const {
     std::unordered_set<char> charSet;
@@ -68,6 +68,66 @@ FlushDecision DefaultFlushPolicy::shouldFlushDictionary(
       context.getMemoryUsage(MemoryUsageCategory::DICTIONARY));
 }
 
+AdaptiveFlushPolicy::AdaptiveFlushPolicy(const Options& options)
+    : DefaultFlushPolicy{
+          options.stripeSizeThreshold,
+          options.dictionarySizeThreshold},
+      options_{options} {}
+
+FlushDecision AdaptiveFlushPolicy::shouldFlushDictionary(
+    bool flushStripe,
+    bool overMemoryBudget,
+    const dwio::common::StripeProgress& stripeProgress,
+    const Signals& signals) {
+  if (flushStripe) {
+    return FlushDecision::SKIP;
+  }
+
+  const bool overMemoryLimit = options_.maxMemoryUsage > 0 &&
+      signals.memoryUsage >= options_.maxMemoryUsage;
+  const bool underPressure = signals.poolUsageRatio >= options_.poolUsageRatio;
+  if (overMemoryLimit || underPressure) {
+    const bool smallStripe = stripeProgress.stripeSizeEstimate <
+        options_.minStripeSizeRatio * stripeSizeThreshold_;
+    if (smallStripe && !abandonedDictionaries_ &&
+        signals.dictionaryMemoryUsage >=
+            options_.dictionaryMemoryRatio * signals.memoryUsage) {
+      abandonedDictionaries_ = true;
+      return FlushDecision::ABANDON_DICTIONARY;
+    }
+    // The memory limit is hard, the pool pressure is not worth a small
+    // stripe.
+    if (overMemoryLimit || !smallStripe) {
+      return FlushDecision::FLUSH_STRIPE;
+    }
+  }
+
+  return DefaultFlushPolicy::shouldFlushDictionary(
+      flushStripe,
+      overMemoryBudget,
+      stripeProgress,
+      signals.dictionaryMemoryUsage);
+}
+
+FlushDecision AdaptiveFlushPolicy::shouldFlushDictionary(
+    bool flushStripe,
+    bool overMemoryBudget,
+    const dwio::common::StripeProgress& stripeProgress,
+    const WriterContext& context) {
+  Signals signals;
+  signals.memoryUsage = context.getTotalMemoryUsage();
+  signals.dictionaryMemoryUsage =
+      context.getMemoryUsage(MemoryUsageCategory::DICTIONARY);
+  const auto& root = context.getRootPool();
+  const auto capacity = root.capacity();
+  if (capacity > 0) {
+    signals.poolUsageRatio =
+        static_cast<double>(root.reservedBytes()) / capacity;
+  }
+  return shouldFlushDictionary(
+      flushStripe, overMemoryBudget, stripeProgress, signals);
+}
+
 RowsPerStripeFlushPolicy::RowsPerStripeFlushPolicy(
     std::vector<uint64_t> rowsPerStripe)
     : rowsPerStripe_{std::move(rowsPerStripe)} {
@@ -26,6 +26,9 @@ enum class FlushDecision {
   EVALUATE_DICTIONARY,
   FLUSH_DICTIONARY,
   ABANDON_DICTIONARY,
+  /// Flushes the stripe for a reason other than its size, e.g. memory
+  /// pressure.
+  FLUSH_STRIPE,
 };
 
 class DWRFFlushPolicy : virtual public dwio::common::FlushPolicy {
@@ -75,14 +78,71 @@ class DefaultFlushPolicy : public DWRFFlushPolicy {
 
   void onClose() override {}
 
+ protected:
+  const uint64_t stripeSizeThreshold_;
+
  private:
   uint64_t getDictionaryAssessmentIncrement() const;
 
-  const uint64_t stripeSizeThreshold_;
   const uint64_t dictionarySizeThreshold_;
   uint64_t dictionaryAssessmentThreshold_;
 };
 
+/// DefaultFlushPolicy that also bounds the memory of the writer. The stripe
+/// is flushed before it reaches its target size if the writer uses more than
+/// 'maxMemoryUsage', or if the root memory pool of the writer, e.g. the one of
+/// the query, is close to its capacity, so that the next allocations would
+/// need arbitration. The estimated stripe size already accounts for the
+/// observed compression ratio, so stripes keep close to their target on disk
+/// as long as there is memory. If the stripe is still small and most of the
+/// memory is in dictionaries, the dictionaries are abandoned once instead,
+/// since they are not paying for themselves.
+class AdaptiveFlushPolicy : public DefaultFlushPolicy {
+ public:
+  struct Options {
+    uint64_t stripeSizeThreshold;
+    uint64_t dictionarySizeThreshold;
+    /// Memory of the writer above which the stripe is flushed. 0 means no
+    /// limit.
+    int64_t maxMemoryUsage{0};
+    /// Reserved bytes over capacity of the root pool above which the stripe
+    /// is flushed.
+    double poolUsageRatio{0.9};
+    /// Under pool pressure, stripes smaller than this fraction of
+    /// 'stripeSizeThreshold' are not flushed, to not write tiny stripes.
+    double minStripeSizeRatio{0.25};
+    /// Fraction of the memory of the writer in dictionaries above which the
+    /// dictionaries are abandoned rather than a small stripe flushed.
+    double dictionaryMemoryRatio{0.5};
+  };
+
+  /// The state of the writer a decision is based on.
+  struct Signals {
+    int64_t memoryUsage{0};
+    int64_t dictionaryMemoryUsage{0};
+    /// Reserved bytes over capacity of the root pool of the writer.
+    double poolUsageRatio{0};
+  };
+
+  explicit AdaptiveFlushPolicy(const Options& options);
+
+  FlushDecision shouldFlushDictionary(
+      bool flushStripe,
+      bool overMemoryBudget,
+      const dwio::common::StripeProgress& stripeProgress,
+      const Signals& signals);
+
+  FlushDecision shouldFlushDictionary(
+      bool flushStripe,
+      bool overMemoryBudget,
+      const dwio::common::StripeProgress& stripeProgress,
+      const WriterContext& context) override;
+
+ private:
+  const Options options_;
+  bool abandonedDictionaries_{false};
+};
+
 class RowsPerStripeFlushPolicy : public DWRFFlushPolicy {
  public:
   explicit RowsPerStripeFlushPolicy(std::vector<uint64_t> rowsPerStripe);
@@ -17,8 +17,8 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
-#include <folly/hash/Checksum.h>
 
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/GTestMacros.h"
 #include "velox/dwio/common/DataBuffer.h"
 
@@ -37,13 +37,16 @@ namespace detail {
 // Heterogeneous lookup is not available in standard CPP and proposed for CPP20.
 // Follys:F14* variant supports it, so leveraging folly for now.
 struct StringLookupKey {
+  // Same hash as VectorHasher and folly::hasher<StringView>.
+  static uint32_t hashKey(std::string_view sv) {
+    return bits::hashBytes(1, sv.data(), sv.size());
+  }
+
   StringLookupKey(std::string_view sv, uint32_t index)
-      : sv{sv},
-        index{index},
-        hash{folly::crc32c(
-            reinterpret_cast<const uint8_t*>(sv.data()),
-            sv.size(),
-            0 /* seed */)} {}
+      : StringLookupKey{sv, index, hashKey(sv)} {}
+
+  StringLookupKey(std::string_view sv, uint32_t index, uint32_t hash)
+      : sv{sv}, index{index}, hash{hash} {}
 
   const std::string_view sv;
   const uint32_t index;
@@ -108,7 +111,8 @@ class StringDictionaryEncoder {
         keyOffsets_{dictionaryDataPool},
         counts_{generalPool},
         firstSeenStrideIndex_{generalPool},
-        hash_{generalPool} {
+        hash_{generalPool},
+        batchHashes_{generalPool} {
     keyOffsets_.append(0);
   }
 
@@ -118,29 +122,28 @@ class StringDictionaryEncoder {
 
   uint32_t
   addKey(std::string_view sv, uint32_t strideIndex, uint32_t count = 1) {
-    auto newIndex = size();
-    detail::StringLookupKey key{sv, newIndex};
-    auto result = keyIndex_.insert(key);
-    if (!result.second) {
-      auto index = result.first->getIndex();
-      counts_[index] += count;
-      return index;
-    }
+    return addKeyWithHash(
+        sv, detail::StringLookupKey::hashKey(sv), strideIndex, count);
+  }
 
-    auto bytesCount = keyBytes_.size();
-    if (UNLIKELY(
-            newIndex == std::numeric_limits<uint32_t>::max() ||
-            (std::numeric_limits<uint32_t>::max() - bytesCount <= sv.size()))) {
-      DWIO_RAISE("exceeds dictionary size limit");
+  /// Adds 'numKeys' keys seen once each and writes their indices to
+  /// 'indices'. All keys are hashed in one pass before the lookups, which
+  /// keeps the hashing loop free of the table's branches and cache misses.
+  template <typename TKey>
+  void addKeys(
+      const TKey* keys,
+      size_t numKeys,
+      uint32_t strideIndex,
+      uint32_t* indices) {
+    batchHashes_.resize(numKeys);
+    auto* hashes = batchHashes_.data();
+    for (size_t i = 0; i < numKeys; ++i) {
+      hashes[i] = detail::StringLookupKey::hashKey(std::string_view(keys[i]));
+    }
+    for (size_t i = 0; i < numKeys; ++i) {
+      indices[i] = addKeyWithHash(
+          std::string_view(keys[i]), hashes[i], strideIndex, /*count=*/1);
     }
-
-    // append keys
-    keyBytes_.extendAppend(bytesCount, sv.data(), sv.size());
-    keyOffsets_.append(keyBytes_.size());
-    hash_.append(key.hash);
-    counts_.append(count);
-    firstSeenStrideIndex_.append(strideIndex);
-    return newIndex;
   }
 
   // Get the current frequency of a key by its index/encoded value.
@@ -169,9 +172,40 @@ class StringDictionaryEncoder {
     counts_.clear();
     firstSeenStrideIndex_.clear();
     hash_.clear();
+    batchHashes_.clear();
   }
 
  private:
+  uint32_t addKeyWithHash(
+      std::string_view sv,
+      uint32_t hash,
+      uint32_t strideIndex,
+      uint32_t count) {
+    auto newIndex = size();
+    detail::StringLookupKey key{sv, newIndex, hash};
+    auto result = keyIndex_.insert(key);
+    if (!result.second) {
+      auto index = result.first->getIndex();
+      counts_[index] += count;
+      return index;
+    }
+
+    auto bytesCount = keyBytes_.size();
+    if (UNLIKELY(
+            newIndex == std::numeric_limits<uint32_t>::max() ||
+            (std::numeric_limits<uint32_t>::max() - bytesCount <= sv.size()))) {
+      DWIO_RAISE("exceeds dictionary size limit");
+    }
+
+    // append keys
+    keyBytes_.extendAppend(bytesCount, sv.data(), sv.size());
+    keyOffsets_.append(keyBytes_.size());
+    hash_.append(key.hash);
+    counts_.append(count);
+    firstSeenStrideIndex_.append(strideIndex);
+    return newIndex;
+  }
+
   VELOX_FRIEND_TEST(TestStringDictionaryEncoder, GetCount);
   VELOX_FRIEND_TEST(TestStringDictionaryEncoder, GetIndex);
   VELOX_FRIEND_TEST(TestStringDictionaryEncoder, GetStride);
@@ -208,6 +242,8 @@ class StringDictionaryEncoder {
   dwio::common::DataBuffer<uint32_t> firstSeenStrideIndex_;
   // key index -> cached hash
   dwio::common::DataBuffer<uint32_t> hash_;
+  // Scratch for the hashes of the keys in addKeys().
+  dwio::common::DataBuffer<uint32_t> batchHashes_;
 
   friend struct DictStringIdHash;
 };
@@ -102,6 +102,17 @@ bool isOrcWriterStringDictionaryEncodingEnabled(
       .value_or(true);
 }
 
+bool isOrcWriterStringDictionaryEarlyCheck(
+    const config::ConfigBase& config,
+    const config::ConfigBase& session) {
+  return session
+      .getLegacyWithFallback<bool>(
+          dwrf::Config::kOrcWriterStringDictionaryEarlyCheckSession,
+          config,
+          dwrf::Config::kOrcWriterStringDictionaryEarlyCheck)
+      .value_or(false);
+}
+
 bool orcWriterLinearStripeSizeHeuristics(
     const config::ConfigBase& config,
     const config::ConfigBase& session) {
@@ -183,6 +194,7 @@ Writer::Writer(
       "Unexpected memory usage on dwrf writer construction");
   setMemoryReclaimers(pool);
   writerBase_->initBuffers();
+  context.setFlushExecutor(options.flushExecutor);
 
   context.buildPhysicalSizeAggregators(*schema_);
   if (options.flushPolicyFactory == nullptr) {
@@ -461,7 +473,8 @@ bool Writer::shouldFlush(const WriterContext& context, size_t nextWriteRows) {
   }
 
   const bool shouldFlush = overBudget || stripeProgressDecision ||
-      dictionaryFlushDecision == FlushDecision::FLUSH_DICTIONARY;
+      dictionaryFlushDecision == FlushDecision::FLUSH_DICTIONARY ||
+      dictionaryFlushDecision == FlushDecision::FLUSH_STRIPE;
   if (shouldFlush) {
     VLOG(1) << fmt::format(
         "overMemoryBudget: {}, dictionaryMemUsage: {}, outputStreamSize: {}, generalMemUsage: {}, estimatedStripeSize: {}",
@@ -948,6 +961,10 @@ void WriterOptions::processConfigs(
       dwrf::Config::STRING_DICTIONARY_ENCODING_ENABLED.key,
       std::to_string(isOrcWriterStringDictionaryEncodingEnabled(
           connectorConfig, session)));
+  configs.emplace(
+      dwrf::Config::STRING_DICTIONARY_EARLY_CHECK.key,
+      std::to_string(
+          isOrcWriterStringDictionaryEarlyCheck(connectorConfig, session)));
 
   configs.emplace(
       dwrf::Config::COMPRESSION_BLOCK_SIZE_MIN.key,
@@ -49,6 +49,10 @@ struct WriterOptions : public dwio::common::WriterOptions {
   const tz::TimeZone* sessionTimezone{nullptr};
   bool adjustTimestampToTimezone{false};
   DwrfFormat format{DwrfFormat::kDwrf};
+  /// If set, the columns of a stripe are encoded and compressed concurrently
+  /// on this executor when the stripe is flushed. Not used for encrypted
+  /// files. Must outlive the writer.
+  folly::Executor* flushExecutor{nullptr};
 
   void processConfigs(
       const config::ConfigBase& connectorConfig,
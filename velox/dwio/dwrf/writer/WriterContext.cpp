@@ -102,6 +102,41 @@ void WriterContext::initBuffer() {
   }
 }
 
+std::unique_ptr<dwio::common::DataBuffer<char>> WriterContext::getBuffer(
+    uint64_t size) {
+  std::unique_ptr<dwio::common::DataBuffer<char>> buffer;
+  {
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    if (compressionBuffer_ != nullptr) {
+      buffer = std::move(compressionBuffer_);
+    } else if (!spareCompressionBuffers_.empty()) {
+      buffer = std::move(spareCompressionBuffers_.back());
+      spareCompressionBuffers_.pop_back();
+    }
+  }
+  if (buffer == nullptr) {
+    VELOX_CHECK_NE(
+        compression_,
+        common::CompressionKind_NONE,
+        "No compression buffer without compression");
+    buffer = std::make_unique<dwio::common::DataBuffer<char>>(
+        *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+  }
+  VELOX_CHECK_GE(buffer->size(), size);
+  return buffer;
+}
+
+void WriterContext::returnBuffer(
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer) {
+  VELOX_CHECK_NOT_NULL(buffer);
+  std::lock_guard<std::mutex> l(compressionBufferMutex_);
+  if (compressionBuffer_ == nullptr) {
+    compressionBuffer_ = std::move(buffer);
+  } else {
+    spareCompressionBuffers_.push_back(std::move(buffer));
+  }
+}
+
 memory::MemoryPool& WriterContext::getMemoryPool(
     const MemoryUsageCategory& category) {
   switch (category) {
@@ -159,6 +194,7 @@ int64_t WriterContext::releaseMemoryReservation() {
 
 void WriterContext::abort() {
   compressionBuffer_.reset();
+  spareCompressionBuffers_.clear();
   physicalSizeAggregators_.clear();
   streams_.clear();
   dictEncoders_.clear();
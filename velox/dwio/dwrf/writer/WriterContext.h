@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -51,6 +53,7 @@ class WriterContext : public CompressionBufferPool {
   ~WriterContext() override;
 
   bool hasStream(const DwrfStreamIdentifier& stream) const {
+    std::lock_guard<std::mutex> l(streamsMutex_);
     return streams_.find(stream) != streams_.cend();
   }
 
@@ -72,23 +75,27 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(
-        !hasStream(stream), "Stream already exists: {}", stream.toString());
-
-    streams_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(stream),
-        std::forward_as_tuple(
-            getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
-            compressionBlockSize(),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
-    auto& holder = streams_.at(stream);
+    DataBufferHolder* holder;
+    {
+      // Column writers may create streams concurrently when a stripe is
+      // flushed on the flush executor.
+      std::lock_guard<std::mutex> l(streamsMutex_);
+      auto [it, inserted] = streams_.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(stream),
+          std::forward_as_tuple(
+              getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
+              compressionBlockSize(),
+              getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
+              getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
+      VELOX_CHECK(inserted, "Stream already exists: {}", stream.toString());
+      holder = &it->second;
+    }
     auto encrypter = handler_->isEncrypted(stream.encodingKey().node())
         ? std::addressof(
               handler_->getEncryptionProvider(stream.encodingKey().node()))
         : nullptr;
-    return newStream(compression_, holder, encrypter);
+    return newStream(compression_, *holder, encrypter);
   }
 
   std::unique_ptr<DataBufferHolder> newDataBufferHolder(
@@ -144,9 +151,10 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
-    VELOX_CHECK(hasStream(stream));
-    auto& collector = streams_.at(stream);
-    collector.suppress();
+    std::lock_guard<std::mutex> l(streamsMutex_);
+    auto it = streams_.find(stream);
+    VELOX_CHECK(it != streams_.end());
+    it->second.suppress();
   }
 
   bool isStreamPaged(uint32_t nodeId) const {
@@ -193,6 +201,11 @@ class WriterContext : public CompressionBufferPool {
     return pool_->maxCapacity();
   }
 
+  /// The root of the memory pool of the writer, e.g. the pool of the query.
+  const memory::MemoryPool& getRootPool() const {
+    return *pool_->root();
+  }
+
   /// Returns the available memory reservations from all the memory pools.
   int64_t availableMemoryReservation() const;
 
@@ -255,18 +268,28 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Returns the compression buffer. When it is taken by a stream that is
+  /// compressed concurrently, returns a spare one, allocating it if needed.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
-      uint64_t size) override {
-    VELOX_CHECK_NOT_NULL(compressionBuffer_);
-    VELOX_CHECK_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
-  }
+      uint64_t size) override;
 
   void returnBuffer(
-      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
-    VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+      std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override;
+
+  /// Frees the spare compression buffers allocated by getBuffer().
+  void releaseSpareCompressionBuffers() {
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    spareCompressionBuffers_.clear();
+  }
+
+  /// Executor on which the columns of a stripe are flushed concurrently. Null
+  /// if they are flushed serially on the writer thread.
+  folly::Executor* flushExecutor() const {
+    return flushExecutor_;
+  }
+
+  void setFlushExecutor(folly::Executor* executor) {
+    flushExecutor_ = executor;
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -657,7 +680,17 @@ class WriterContext : public CompressionBufferPool {
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
+  // Serializes the changes to 'streams_' by column writers flushed
+  // concurrently.
+  mutable std::mutex streamsMutex_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Serializes getBuffer() and returnBuffer().
+  std::mutex compressionBufferMutex_;
+  // Compression buffers used while 'compressionBuffer_' is taken by another
+  // stream.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      spareCompressionBuffers_;
+  folly::Executor* flushExecutor_{nullptr};
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ColumnPageIndex.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+template <typename T>
+std::unique_ptr<T> deserialize(std::string_view data) {
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      data.data(), data.size());
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  auto result = std::make_unique<T>();
+  result->read(&protocol);
+  return result;
+}
+
+// Appends 'range' to 'ranges', merging it with the last range if adjacent.
+void appendRange(std::vector<RowRange>& ranges, RowRange range) {
+  if (range.size() <= 0) {
+    return;
+  }
+  if (!ranges.empty() && ranges.back().end >= range.begin) {
+    ranges.back().end = std::max(ranges.back().end, range.end);
+    return;
+  }
+  ranges.push_back(range);
+}
+
+} // namespace
+
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right) {
+  std::vector<RowRange> result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    appendRange(
+        result,
+        {std::max(left[i].begin, right[j].begin),
+         std::min(left[i].end, right[j].end)});
+    if (left[i].end < right[j].end) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
+int64_t numRowsInRanges(const std::vector<RowRange>& ranges) {
+  int64_t numRows = 0;
+  for (const auto& range : ranges) {
+    numRows += range.size();
+  }
+  return numRows;
+}
+
+ColumnPageIndex::ColumnPageIndex(
+    std::string_view columnIndex,
+    std::string_view offsetIndex)
+    : offsetIndex_(deserialize<thrift::OffsetIndex>(offsetIndex)) {
+  if (!columnIndex.empty()) {
+    columnIndex_ = deserialize<thrift::ColumnIndex>(columnIndex);
+    VELOX_CHECK_EQ(
+        columnIndex_->null_pages.size(),
+        offsetIndex_->page_locations.size(),
+        "ColumnIndex and OffsetIndex disagree on the number of pages");
+  }
+}
+
+ColumnPageIndex::~ColumnPageIndex() = default;
+
+int32_t ColumnPageIndex::numPages() const {
+  return offsetIndex_->page_locations.size();
+}
+
+int64_t ColumnPageIndex::pageOffset(int32_t page) const {
+  return offsetIndex_->page_locations[page].offset;
+}
+
+int32_t ColumnPageIndex::pageSize(int32_t page) const {
+  return offsetIndex_->page_locations[page].compressed_page_size;
+}
+
+int64_t ColumnPageIndex::pageFirstRow(int32_t page) const {
+  return offsetIndex_->page_locations[page].first_row_index;
+}
+
+RowRange ColumnPageIndex::pageRows(int32_t page, int64_t numRows) const {
+  const auto end = page + 1 < numPages() ? pageFirstRow(page + 1) : numRows;
+  return {pageFirstRow(page), end};
+}
+
+std::vector<RowRange> ColumnPageIndex::filterPages(
+    const common::Filter& filter,
+    const TypePtr& type,
+    int64_t numRows) const {
+  VELOX_CHECK(hasColumnIndex());
+  std::vector<RowRange> ranges;
+  for (auto page = 0; page < numPages(); ++page) {
+    const auto rows = pageRows(page, numRows);
+    // Build the same statistics as for a column chunk so that the row group
+    // and page level pruning share the filter evaluation in testFilter().
+    thrift::Statistics pageStats;
+    if (columnIndex_->__isset.null_counts) {
+      pageStats.__set_null_count(columnIndex_->null_counts[page]);
+    }
+    if (columnIndex_->null_pages[page]) {
+      pageStats.__set_null_count(rows.size());
+    } else {
+      pageStats.__set_min_value(columnIndex_->min_values[page]);
+      pageStats.__set_max_value(columnIndex_->max_values[page]);
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type, rows.size());
+    if (common::testFilter(&filter, columnStats.get(), rows.size(), type)) {
+      appendRange(ranges, rows);
+    }
+  }
+  return ranges;
+}
+
+std::vector<int32_t> ColumnPageIndex::pagesInRanges(
+    const std::vector<RowRange>& ranges,
+    int64_t numRows) const {
+  std::vector<int32_t> pages;
+  size_t rangeIndex = 0;
+  for (auto page = 0; page < numPages() && rangeIndex < ranges.size();
+       ++page) {
+    const auto rows = pageRows(page, numRows);
+    while (rangeIndex < ranges.size() && ranges[rangeIndex].end <= rows.begin) {
+      ++rangeIndex;
+    }
+    if (rangeIndex < ranges.size() && ranges[rangeIndex].begin < rows.end) {
+      pages.push_back(page);
+    }
+  }
+  return pages;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "velox/type/Type.h"
+
+namespace facebook::velox::common {
+class Filter;
+} // namespace facebook::velox::common
+
+namespace facebook::velox::parquet::thrift {
+class ColumnIndex;
+class OffsetIndex;
+} // namespace facebook::velox::parquet::thrift
+
+namespace facebook::velox::parquet {
+
+/// Half-open range [begin, end) of row numbers relative to the start of a row
+/// group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  int64_t size() const {
+    return end - begin;
+  }
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// Returns the rows covered by both 'left' and 'right'. Both inputs must be
+/// sorted and non-overlapping. The result is sorted and non-overlapping.
+std::vector<RowRange> intersectRowRanges(
+    const std::vector<RowRange>& left,
+    const std::vector<RowRange>& right);
+
+/// Returns the total number of rows in 'ranges'.
+int64_t numRowsInRanges(const std::vector<RowRange>& ranges);
+
+/// Per-page statistics and locations of one column chunk, decoded from the
+/// Parquet ColumnIndex and OffsetIndex structures. See
+/// https://github.com/apache/parquet-format/blob/master/PageIndex.md.
+class ColumnPageIndex {
+ public:
+  /// Deserializes the thrift OffsetIndex in 'offsetIndex' and, if not empty,
+  /// the thrift ColumnIndex in 'columnIndex'. A column chunk may have an
+  /// OffsetIndex without a ColumnIndex, e.g. when its statistics were not
+  /// written. In this case locations are available but filtering is not.
+  ColumnPageIndex(std::string_view columnIndex, std::string_view offsetIndex);
+
+  ~ColumnPageIndex();
+
+  /// Number of data pages in the column chunk.
+  int32_t numPages() const;
+
+  /// True if per-page min/max statistics are available.
+  bool hasColumnIndex() const {
+    return columnIndex_ != nullptr;
+  }
+
+  /// File offset of the data page 'page', including its page header.
+  int64_t pageOffset(int32_t page) const;
+
+  /// Size of the data page 'page' in bytes, including its page header.
+  int32_t pageSize(int32_t page) const;
+
+  /// Row number of the first row of 'page' relative to the row group.
+  int64_t pageFirstRow(int32_t page) const;
+
+  /// Returns the rows of 'page' in a row group of 'numRows' rows.
+  RowRange pageRows(int32_t page, int64_t numRows) const;
+
+  /// Returns the sorted, coalesced row ranges of the pages that may contain
+  /// values passing 'filter' according to the per-page statistics. 'type' is
+  /// the Velox type of the column and 'numRows' the number of rows in the row
+  /// group. Must only be called if hasColumnIndex() is true.
+  std::vector<RowRange> filterPages(
+      const common::Filter& filter,
+      const TypePtr& type,
+      int64_t numRows) const;
+
+  /// Returns the indices of the pages that overlap with 'ranges' in a row group
+  /// of 'numRows' rows. 'ranges' must be sorted and non-overlapping.
+  std::vector<int32_t> pagesInRanges(
+      const std::vector<RowRange>& ranges,
+      int64_t numRows) const;
+
+ private:
+  std::unique_ptr<thrift::ColumnIndex> columnIndex_;
+  std::unique_ptr<thrift::OffsetIndex> offsetIndex_;
+};
+
+} // namespace facebook::velox::parquet
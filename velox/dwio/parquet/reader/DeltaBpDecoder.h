@@ -18,11 +18,17 @@
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/BitPackDecoder.h"
+
+#include <folly/lang/Bits.h>
 
 namespace facebook::velox::parquet {
 
 // DeltaBpDecoder is adapted from Apache Arrow:
 // https://github.com/apache/arrow/blob/apache-arrow-12.0.0/cpp/src/parquet/encoding.cc#LL2357C18-L2586C3
+//
+// The values of a miniblock are unpacked and prefix summed together when the
+// first of them is read. Reads and skips are then served from 'values_'.
 class DeltaBpDecoder {
  public:
   explicit DeltaBpDecoder(const char* start) : bufferStart_(start) {
@@ -38,8 +44,16 @@ class DeltaBpDecoder {
     if (hasNulls) {
       numValues = bits::countNonNulls(nulls, current, current + numValues);
     }
-    for (int32_t i = 0; i < numValues; ++i) {
-      readLong();
+    while (numValues > 0) {
+      const auto numInMiniBlock = valuesInMiniBlock(numValues);
+      if (numInMiniBlock == 0) {
+        readLong();
+        --numValues;
+        continue;
+      }
+      valuesRemainingCurrentMiniBlock_ -= numInMiniBlock;
+      totalValuesRemaining_ -= numInMiniBlock;
+      numValues -= numInMiniBlock;
     }
   }
 
@@ -89,12 +103,36 @@ class DeltaBpDecoder {
   template <typename T>
   void readValues(T* values, int32_t numValues) {
     VELOX_DCHECK_LE(numValues, totalValuesRemaining_);
-    for (auto i = 0; i < numValues; i++) {
-      values[i] = T(readLong());
+    while (numValues > 0) {
+      const auto numInMiniBlock = valuesInMiniBlock(numValues);
+      if (numInMiniBlock == 0) {
+        *values++ = T(readLong());
+        --numValues;
+        continue;
+      }
+      const auto* source = values_.data() + valuesPerMiniBlock_ -
+          valuesRemainingCurrentMiniBlock_;
+      for (auto i = 0; i < numInMiniBlock; ++i) {
+        values[i] = T(source[i]);
+      }
+      valuesRemainingCurrentMiniBlock_ -= numInMiniBlock;
+      totalValuesRemaining_ -= numInMiniBlock;
+      values += numInMiniBlock;
+      numValues -= numInMiniBlock;
     }
   }
 
  private:
+  // Returns how many of the next 'numValues' values are in the decoded part
+  // of the current miniblock. 0 means that the next value must be read with
+  // readLong().
+  int32_t valuesInMiniBlock(int32_t numValues) const {
+    return std::min<uint64_t>(
+        {static_cast<uint64_t>(numValues),
+         valuesRemainingCurrentMiniBlock_,
+         totalValuesRemaining_});
+  }
+
   bool getVlqInt(uint64_t& v) {
     uint64_t tmp = 0;
     for (int i = 0; i < folly::kMaxVarintLength64; i++) {
@@ -142,6 +180,7 @@ class DeltaBpDecoder {
 
     totalValuesRemaining_ = totalValueCount_;
     deltaBitWidths_.resize(miniBlocksPerBlock_);
+    values_.resize(valuesPerMiniBlock_);
     firstBlockInitialized_ = false;
     valuesRemainingCurrentMiniBlock_ = 0;
   }
@@ -166,20 +205,75 @@ class DeltaBpDecoder {
     initMiniBlock(deltaBitWidths_[0]);
   }
 
+  // Decodes the values of the miniblock at 'bufferStart_' into 'values_' and
+  // moves 'bufferStart_' past the miniblock.
   void initMiniBlock(int32_t bitWidth) {
-    VELOX_DCHECK_LE(
+    VELOX_CHECK_LE(
         bitWidth,
         kMaxDeltaBitWidth,
         "delta bit width larger than integer bit width");
     deltaBitWidth_ = bitWidth;
     valuesRemainingCurrentMiniBlock_ = valuesPerMiniBlock_;
+
+    // The last miniblock may have fewer values than 'valuesPerMiniBlock_'.
+    // 'valuesPerMiniBlock_' is a multiple of 32, so rounding up to 8 values
+    // stays in the miniblock.
+    const auto numValues = std::min<uint64_t>(
+        valuesPerMiniBlock_, bits::roundUp(totalValuesRemaining_, 8));
+    unpackDeltas(numValues);
+    // Addition between minDelta_, packed int and lastValue_ should be treated
+    // as unsigned addition. Overflow is as expected.
+    auto value = static_cast<uint64_t>(lastValue_);
+    const auto minDelta = static_cast<uint64_t>(minDelta_);
+    for (uint64_t i = 0; i < numValues; ++i) {
+      value += minDelta + static_cast<uint64_t>(values_[i]);
+      values_[i] = static_cast<int64_t>(value);
+    }
+    lastValue_ = values_[std::min(numValues, totalValuesRemaining_) - 1];
+    bufferStart_ += bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+  }
+
+  // Unpacks 'numValues' deltas of 'deltaBitWidth_' bits at 'bufferStart_'
+  // into 'values_'. 'numValues' is a multiple of 8.
+  void unpackDeltas(uint64_t numValues) {
+    if (deltaBitWidth_ == 0) {
+      std::fill_n(values_.begin(), numValues, 0);
+      return;
+    }
+    const auto* data = reinterpret_cast<const uint8_t*>(bufferStart_);
+    if (deltaBitWidth_ <= 32) {
+      // The 32 bit unpacking has fast paths for each bit width.
+      deltas32_.resize(valuesPerMiniBlock_);
+      auto* deltas = deltas32_.data();
+      dwio::common::unpack<uint32_t>(
+          data,
+          bits::nbytes(deltaBitWidth_ * numValues),
+          numValues,
+          deltaBitWidth_,
+          deltas);
+      std::copy_n(deltas32_.begin(), numValues, values_.begin());
+      return;
+    }
+    const uint64_t mask = deltaBitWidth_ == 64
+        ? ~0ULL
+        : bits::lowMask(static_cast<int32_t>(deltaBitWidth_));
+    for (uint64_t i = 0; i < numValues; ++i) {
+      const uint64_t bit = i * deltaBitWidth_;
+      const auto* word = data + bit / 8;
+      const auto shift = bit % 8;
+      uint64_t delta = folly::loadUnaligned<uint64_t>(word) >> shift;
+      if (shift + deltaBitWidth_ > 64) {
+        delta |= static_cast<uint64_t>(word[8]) << (64 - shift);
+      }
+      values_[i] = static_cast<int64_t>(delta & mask);
+    }
   }
 
   int64_t readLong() {
-    int64_t value = 0;
     if (valuesRemainingCurrentMiniBlock_ == 0) {
       if (!firstBlockInitialized_) {
-        value = lastValue_;
+        const auto value = lastValue_;
+        totalValuesRemaining_--;
         // When block is uninitialized we have two different possibilities:
         // 1. totalValueCount_ == 1, which means that the page may have only
         // one value (encoded in the header), and we should not initialize
@@ -189,7 +283,6 @@ class DeltaBpDecoder {
         if (totalValueCount_ != 1) {
           initBlock();
         }
-        totalValuesRemaining_--;
         return value;
       } else {
         ++miniBlockIdx_;
@@ -201,26 +294,10 @@ class DeltaBpDecoder {
       }
     }
 
-    uint64_t consumedBits =
-        (valuesPerMiniBlock_ - valuesRemainingCurrentMiniBlock_) *
-        deltaBitWidth_;
-    bits::copyBits(
-        reinterpret_cast<const uint64_t*>(bufferStart_),
-        consumedBits,
-        reinterpret_cast<uint64_t*>(&value),
-        0,
-        deltaBitWidth_);
-    // Addition between minDelta_, packed int and lastValue_ should be treated
-    // as unsigned addition. Overflow is as expected.
-    value = static_cast<uint64_t>(minDelta_) + static_cast<uint64_t>(value) +
-        static_cast<uint64_t>(lastValue_);
-    lastValue_ = value;
+    const auto value =
+        values_[valuesPerMiniBlock_ - valuesRemainingCurrentMiniBlock_];
     valuesRemainingCurrentMiniBlock_--;
     totalValuesRemaining_--;
-
-    if (valuesRemainingCurrentMiniBlock_ == 0 || totalValuesRemaining_ == 0) {
-      bufferStart_ += bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
-    }
     return value;
   }
 
@@ -248,7 +325,14 @@ class DeltaBpDecoder {
   std::vector<uint8_t> deltaBitWidths_;
   uint64_t deltaBitWidth_;
 
+  // The value before the first value of the next miniblock. This is the last
+  // value of the current miniblock once it is decoded.
   int64_t lastValue_;
+
+  // The values of the current miniblock.
+  std::vector<int64_t> values_;
+  // Scratch for unpacking deltas of up to 32 bits.
+  std::vector<uint32_t> deltas32_;
 };
 
 } // namespace facebook::velox::parquet
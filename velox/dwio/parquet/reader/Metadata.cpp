@@ -282,6 +282,72 @@ int64_t ColumnChunkMetaDataPtr::totalUncompressedSize() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.total_uncompressed_size;
 }
 
+bool ColumnChunkMetaDataPtr::hasColumnIndex() const {
+  const auto* columnChunk = thriftColumnChunkPtr(ptr_);
+  return columnChunk->__isset.column_index_offset &&
+      columnChunk->__isset.column_index_length &&
+      columnChunk->column_index_length > 0;
+}
+
+int64_t ColumnChunkMetaDataPtr::columnIndexOffset() const {
+  VELOX_CHECK(hasColumnIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::columnIndexLength() const {
+  VELOX_CHECK(hasColumnIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_length;
+}
+
+bool ColumnChunkMetaDataPtr::hasOffsetIndex() const {
+  const auto* columnChunk = thriftColumnChunkPtr(ptr_);
+  return columnChunk->__isset.offset_index_offset &&
+      columnChunk->__isset.offset_index_length &&
+      columnChunk->offset_index_length > 0;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  VELOX_CHECK(hasOffsetIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  VELOX_CHECK(hasOffsetIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
+bool ColumnChunkMetaDataPtr::hasBloomFilter() const {
+  return hasMetadata() &&
+      thriftColumnChunkPtr(ptr_)->meta_data.__isset.bloom_filter_offset;
+}
+
+int64_t ColumnChunkMetaDataPtr::bloomFilterOffset() const {
+  VELOX_CHECK(hasBloomFilter());
+  return thriftColumnChunkPtr(ptr_)->meta_data.bloom_filter_offset;
+}
+
+bool ColumnChunkMetaDataPtr::hasOnlyDictionaryDataPages() const {
+  if (!hasMetadata()) {
+    return false;
+  }
+  const auto& metadata = thriftColumnChunkPtr(ptr_)->meta_data;
+  if (!metadata.__isset.encoding_stats) {
+    return false;
+  }
+  for (const auto& stats : metadata.encoding_stats) {
+    if (stats.page_type != thrift::PageType::DATA_PAGE &&
+        stats.page_type != thrift::PageType::DATA_PAGE_V2) {
+      continue;
+    }
+    if (stats.count > 0 &&
+        stats.encoding != thrift::Encoding::PLAIN_DICTIONARY &&
+        stats.encoding != thrift::Encoding::RLE_DICTIONARY) {
+      return false;
+    }
+  }
+  return true;
+}
+
 FOLLY_ALWAYS_INLINE const thrift::RowGroup* thriftRowGroupPtr(
     const void* metadata) {
   return reinterpret_cast<const thrift::RowGroup*>(metadata);
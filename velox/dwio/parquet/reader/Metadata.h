@@ -19,8 +19,20 @@
 #include "velox/dwio/common/Statistics.h"
 #include "velox/dwio/common/compression/Compression.h"
 
+namespace facebook::velox::parquet::thrift {
+class Statistics;
+} // namespace facebook::velox::parquet::thrift
+
 namespace facebook::velox::parquet {
 
+/// Converts the thrift 'statistics' of a column of 'type' with
+/// 'numRowsInRowGroup' rows into Velox column statistics. Used for both column
+/// chunk statistics and the per-page statistics of the page index.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& statistics,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -74,6 +86,37 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of the ColumnIndex of the page index.
+  bool hasColumnIndex() const;
+
+  /// File offset of the ColumnIndex. Must check for its presence using
+  /// hasColumnIndex().
+  int64_t columnIndexOffset() const;
+
+  /// Size of the ColumnIndex in bytes.
+  int32_t columnIndexLength() const;
+
+  /// Check the presence of the OffsetIndex of the page index.
+  bool hasOffsetIndex() const;
+
+  /// File offset of the OffsetIndex. Must check for its presence using
+  /// hasOffsetIndex().
+  int64_t offsetIndexOffset() const;
+
+  /// Size of the OffsetIndex in bytes.
+  int32_t offsetIndexLength() const;
+
+  /// Check the presence of the bloom filter of the column chunk.
+  bool hasBloomFilter() const;
+
+  /// File offset of the bloom filter header. Must check for its presence
+  /// using hasBloomFilter().
+  int64_t bloomFilterOffset() const;
+
+  /// True if the page encoding stats show that all data pages of the column
+  /// chunk are dictionary encoded. False if there are no encoding stats.
+  bool hasOnlyDictionaryDataPages() const;
+
  private:
   const void* ptr_;
 };
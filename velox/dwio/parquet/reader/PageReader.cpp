@@ -38,12 +38,185 @@ struct __attribute__((__packed__)) Int96Timestamp {
   uint64_t nanos;
 };
 
+namespace {
+// Decompresses the 'compressedSize' bytes at 'data' into 'result'.
+void decompress(
+    common::CompressionKind codec,
+    const char* data,
+    uint32_t compressedSize,
+    uint32_t uncompressedSize,
+    memory::MemoryPool& pool,
+    const std::string& streamDebugInfo,
+    BufferPtr& result) {
+  std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          data, compressedSize, 0);
+  std::unique_ptr<dwio::common::SeekableInputStream> decompressedStream =
+      dwio::common::compression::createDecompressor(
+          codec,
+          std::move(inputStream),
+          uncompressedSize,
+          pool,
+          getParquetDecompressionOptions(codec),
+          streamDebugInfo,
+          nullptr,
+          true,
+          compressedSize);
+
+  dwio::common::ensureCapacity<char>(result, uncompressedSize, &pool);
+  decompressedStream->readFully(result->asMutable<char>(), uncompressedSize);
+}
+
+// Parses the page header at the start of the 'size' bytes at 'data' into
+// 'header' and sets 'headerSize' to its size. Returns false if the header
+// does not end within the bytes.
+bool peekPageHeader(
+    const char* data,
+    uint64_t size,
+    PageHeader& header,
+    uint32_t& headerSize) {
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, size);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  try {
+    headerSize = header.read(&protocol);
+  } catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+PageReader::~PageReader() {
+  for (auto& page : pagesAhead_) {
+    page.data->close();
+  }
+}
+
+void PageReader::setDecompressionAhead(
+    folly::Executor* executor,
+    int32_t pagesAhead) {
+  VELOX_CHECK_NOT_NULL(executor);
+  VELOX_CHECK_GT(pagesAhead, 0);
+  decompressionExecutor_ = executor;
+  decompressionPagesAhead_ = pagesAhead;
+}
+
+void PageReader::decompressAhead() {
+  if (codec_ == common::CompressionKind::CompressionKind_NONE ||
+      bufferStart_ == nullptr) {
+    return;
+  }
+  const auto chunkEnd = std::min<uint64_t>(chunkSize_, currentRunEnd_);
+  const char* position = bufferStart_;
+  uint64_t offset = pageStart_;
+  int32_t numAhead = 0;
+  while (numAhead < decompressionPagesAhead_ && offset < chunkEnd) {
+    const uint64_t available = bufferEnd_ - position;
+    PageHeader header;
+    uint32_t headerSize;
+    if (!peekPageHeader(position, available, header, headerSize) ||
+        header.compressed_page_size < 0 ||
+        available - headerSize <
+            static_cast<uint64_t>(header.compressed_page_size)) {
+      break;
+    }
+    // The levels of a v2 page are not compressed.
+    uint32_t levelsSize = 0;
+    if (header.type == thrift::PageType::DATA_PAGE_V2) {
+      const auto& v2Header = header.data_page_header_v2;
+      levelsSize = v2Header.definition_levels_byte_length +
+          v2Header.repetition_levels_byte_length;
+      if (!v2Header.__isset.is_compressed || !v2Header.is_compressed ||
+          static_cast<uint64_t>(header.compressed_page_size) <= levelsSize ||
+          header.uncompressed_page_size < static_cast<int64_t>(levelsSize)) {
+        break;
+      }
+    } else if (
+        header.type != thrift::PageType::DATA_PAGE ||
+        header.uncompressed_page_size < 0) {
+      break;
+    }
+    const auto dataStart = offset + headerSize;
+    if (numAhead < pagesAhead_.size() &&
+        pagesAhead_[numAhead].dataStart != dataStart) {
+      // Not the expected next pages, e.g. after a rewind.
+      while (pagesAhead_.size() > numAhead) {
+        pagesAhead_.back().data->close();
+        pagesAhead_.pop_back();
+      }
+    }
+    if (numAhead == pagesAhead_.size()) {
+      // The task decompresses a copy, since the bytes of the input stream may
+      // be released once the stream moves past them.
+      const uint32_t compressedSize = header.compressed_page_size - levelsSize;
+      const uint32_t uncompressedSize =
+          header.uncompressed_page_size - levelsSize;
+      auto compressed = AlignedBuffer::allocate<char>(compressedSize, &pool_);
+      memcpy(
+          compressed->asMutable<char>(),
+          position + headerSize + levelsSize,
+          compressedSize);
+      auto source = std::make_shared<AsyncSource<BufferPtr>>(
+          [codec = codec_,
+           &pool = pool_,
+           compressed = std::move(compressed),
+           compressedSize,
+           uncompressedSize,
+           streamDebugInfo = fmt::format(
+               "Page Reader: Stream {}", inputStream_->getName())]() {
+            BufferPtr result;
+            decompress(
+                codec,
+                compressed->as<char>(),
+                compressedSize,
+                uncompressedSize,
+                pool,
+                streamDebugInfo,
+                result);
+            return std::make_unique<BufferPtr>(std::move(result));
+          });
+      pagesAhead_.push_back({dataStart, source});
+      decompressionExecutor_->add([source]() { source->prepare(); });
+    }
+    ++numAhead;
+    position += headerSize + header.compressed_page_size;
+    offset = dataStart + header.compressed_page_size;
+  }
+}
+
+BufferPtr PageReader::takePageAhead() {
+  while (!pagesAhead_.empty() &&
+         pagesAhead_.front().dataStart < pageDataStart_) {
+    pagesAhead_.front().data->close();
+    pagesAhead_.pop_front();
+  }
+  if (pagesAhead_.empty() || pagesAhead_.front().dataStart != pageDataStart_) {
+    return nullptr;
+  }
+  auto data = pagesAhead_.front().data->move();
+  pagesAhead_.pop_front();
+  if (data == nullptr) {
+    return nullptr;
+  }
+  return std::move(*data);
+}
+
 void PageReader::seekToPage(int64_t row) {
   defineDecoder_.reset();
   repeatDecoder_.reset();
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
+    if (currentRunEnd_ <= pageStart_ && !startNextPageRun(row)) {
+      // The pages after the current run were dropped by the page index filter
+      // and 'row' is not in a later run. Behave as at the end of the chunk
+      // until seeking to a row of a later run.
+      numRepDefsInPage_ = 0;
+      numRowsInPage_ = 0;
+      break;
+    }
     if (chunkSize_ <= pageStart_) {
       // This may happen if seeking to exactly end of row group.
       numRepDefsInPage_ = 0;
@@ -79,6 +252,38 @@ void PageReader::seekToPage(int64_t row) {
     }
     updateRowInfoAfterPageSkipped();
   }
+  if (decompressionExecutor_ != nullptr && row != kRepDefOnly) {
+    decompressAhead();
+  }
+}
+
+void PageReader::setPageRuns(std::vector<PageRun> runs) {
+  VELOX_CHECK(
+      isTopLevel_, "Page runs are only supported for top level columns");
+  VELOX_CHECK_EQ(pageStart_, 0, "Page runs must be set before reading");
+  // The first seekToPage() starts the first run.
+  currentRunEnd_ = 0;
+  pageRuns_ = std::move(runs);
+  nextPageRun_ = 0;
+}
+
+bool PageReader::startNextPageRun(int64_t row) {
+  if (nextPageRun_ >= pageRuns_.size() ||
+      row < pageRuns_[nextPageRun_].firstRow) {
+    return false;
+  }
+  // Runs that end before 'row' are dropped unread.
+  while (nextPageRun_ > 0 && nextPageRun_ + 1 < pageRuns_.size() &&
+         pageRuns_[nextPageRun_ + 1].firstRow <= row) {
+    ++nextPageRun_;
+  }
+  auto& run = pageRuns_[nextPageRun_++];
+  inputStream_ = std::move(run.stream);
+  bufferStart_ = bufferEnd_ = nullptr;
+  pageStart_ = run.chunkOffset;
+  currentRunEnd_ = run.chunkOffset + run.size;
+  rowOfPage_ = run.firstRow;
+  return true;
 }
 
 PageHeader PageReader::readPageHeader() {
@@ -143,28 +348,19 @@ const char* PageReader::decompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
-  std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
-      std::make_unique<dwio::common::SeekableArrayInputStream>(
-          pageData, compressedSize, 0);
-  auto streamDebugInfo =
-      fmt::format("Page Reader: Stream {}", inputStream_->getName());
-  std::unique_ptr<dwio::common::SeekableInputStream> decompressedStream =
-      dwio::common::compression::createDecompressor(
-          codec_,
-          std::move(inputStream),
-          uncompressedSize,
-          pool_,
-          getParquetDecompressionOptions(codec_),
-          streamDebugInfo,
-          nullptr,
-          true,
-          compressedSize);
-
-  dwio::common::ensureCapacity<char>(
-      decompressedData_, uncompressedSize, &pool_);
-  decompressedStream->readFully(
-      decompressedData_->asMutable<char>(), uncompressedSize);
-
+  if (auto data = takePageAhead()) {
+    VELOX_CHECK_GE(data->size(), uncompressedSize);
+    decompressedData_ = std::move(data);
+    return decompressedData_->as<char>();
+  }
+  decompress(
+      codec_,
+      pageData,
+      compressedSize,
+      uncompressedSize,
+      pool_,
+      fmt::format("Page Reader: Stream {}", inputStream_->getName()),
+      decompressedData_);
   return decompressedData_->as<char>();
 }
 
@@ -365,6 +561,15 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   }
 }
 
+const dwio::common::DictionaryValues& PageReader::readDictionary() {
+  auto pageHeader = readPageHeader();
+  VELOX_CHECK(
+      pageHeader.type == thrift::PageType::DICTIONARY_PAGE,
+      "Expected a dictionary page");
+  prepareDictionary(pageHeader);
+  return dictionary_;
+}
+
 void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   dictionary_.numValues = pageHeader.dictionary_page_header.num_values;
   dictionaryEncoding_ = pageHeader.dictionary_page_header.encoding;
@@ -807,6 +1012,42 @@ void PageReader::makeDecoder() {
           VELOX_UNSUPPORTED("RLE decoder only supports BOOLEAN");
       }
       break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE: {
+          // The page has one stream per byte of the value. The streams are
+          // interleaved into PLAIN values and read with the direct decoder.
+          const int32_t width = parquetTypeBytes(parquetType);
+          VELOX_CHECK_EQ(
+              encodedDataSize_ % width,
+              0,
+              "Invalid BYTE_STREAM_SPLIT page size (corrupt data page?)");
+          const int32_t numValues = encodedDataSize_ / width;
+          dwio::common::ensureCapacity<char>(
+              byteStreamSplitData_, encodedDataSize_, &pool_);
+          auto* values = byteStreamSplitData_->asMutable<char>();
+          for (auto stream = 0; stream < width; ++stream) {
+            const char* streamData = pageData_ + stream * numValues;
+            for (auto i = 0; i < numValues; ++i) {
+              values[i * width + stream] = streamData[i];
+            }
+          }
+          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+              std::make_unique<dwio::common::SeekableArrayInputStream>(
+                  values, encodedDataSize_),
+              false,
+              width);
+          break;
+        }
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports INT32, INT64, FLOAT "
+              "and DOUBLE");
+      }
+      break;
     case Encoding::DELTA_BYTE_ARRAY:
       if (parquetType == thrift::Type::BYTE_ARRAY) {
         deltaByteArrDecoder_ =
@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <deque>
+
+#include <folly/Executor.h>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/BitConcatenation.h"
 #include "velox/dwio/common/DirectDecoder.h"
@@ -31,6 +36,23 @@
 
 namespace facebook::velox::parquet {
 
+/// A run of consecutive data pages of a column chunk read from its own stream.
+/// Used when the page index filter dropped the pages between runs, so that
+/// their bytes are never read.
+struct PageRun {
+  /// Offset of the first page of the run from the start of the column chunk.
+  uint64_t chunkOffset;
+
+  /// Size of the run in bytes, including the page headers.
+  uint64_t size;
+
+  /// Row number of the first row of the run relative to the row group.
+  int64_t firstRow;
+
+  /// Stream over the bytes of the run.
+  std::unique_ptr<dwio::common::SeekableInputStream> stream;
+};
+
 /// Manages access to pages inside a ColumnChunk. Interprets page headers and
 /// encodings and presents the combination of pages and encoded values as a
 /// continuous stream accessible via readWithVisitor().
@@ -79,6 +101,25 @@ class PageReader {
         stats_(stats),
         sessionTimezone_(sessionTimezone) {}
 
+  ~PageReader();
+
+  /// Reads the column chunk from 'runs' instead of the stream given at
+  /// construction, which may be null. 'runs' are in increasing offset order
+  /// and the first run starts with the dictionary page, if any. Rows between
+  /// runs must not be read, only skipped over. Only supported for top level
+  /// columns.
+  void setPageRuns(std::vector<PageRun> runs);
+
+  /// Decompresses up to 'pagesAhead' data pages after the current one on
+  /// 'executor' while the current page is decoded. Only the pages whose bytes
+  /// are already in the buffer of the input stream are decompressed ahead, so
+  /// that this does not read from storage ahead of the decoder.
+  void setDecompressionAhead(folly::Executor* executor, int32_t pagesAhead);
+
+  /// Reads the dictionary page at the start of the stream. Used for testing
+  /// filters on the dictionary without reading the data pages.
+  const dwio::common::DictionaryValues& readDictionary();
+
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
@@ -164,6 +205,24 @@ class PageReader {
   // consulted to determine number of leaf values.
   static constexpr int32_t kRowsUnknown = -1;
 
+  // A data page decompressed ahead of the decoder.
+  struct PageAhead {
+    // Offset of the page data from the start of the column chunk.
+    uint64_t dataStart;
+    std::shared_ptr<AsyncSource<BufferPtr>> data;
+  };
+
+  // Starts decompressing the data pages after the current page on
+  // 'decompressionExecutor_' until 'decompressionPagesAhead_' pages are in
+  // 'pagesAhead_'. Called when the bytes of the current page are consumed
+  // from the input stream, i.e. the next page header is at 'bufferStart_'.
+  void decompressAhead();
+
+  // Returns the decompressed data of the page at 'pageDataStart_' if it was
+  // decompressed ahead, nullptr otherwise. Drops the pages before it, which
+  // were skipped.
+  BufferPtr takePageAhead();
+
   // If the current page has nulls, returns a nulls bitmap owned by 'this'. This
   // is filled for 'numRows' bits.
   const uint64_t* readNulls(int32_t numRows, BufferPtr& buffer);
@@ -189,6 +248,11 @@ class PageReader {
   // allowed for non-top level columns.
   void seekToPage(int64_t row);
 
+  // Switches 'inputStream_' to the last of 'pageRuns_' that starts at or
+  // before 'row'. The first run is never skipped since it holds the dictionary.
+  // Returns false if there is no such run after the current one.
+  bool startNextPageRun(int64_t row);
+
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
   // reads ahead for repdefs and the other tracks the data. This is
@@ -452,6 +516,9 @@ class PageReader {
   // decompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr decompressedData_;
 
+  // Values of a BYTE_STREAM_SPLIT page interleaved into PLAIN layout.
+  BufferPtr byteStreamSplitData_;
+
   // First byte of decompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* pageData_{nullptr};
@@ -466,6 +533,16 @@ class PageReader {
   // Offset of first byte after current page' header.
   uint64_t pageDataStart_{0};
 
+  // Offset from start of ColumnChunk of the end of the bytes readable from
+  // 'inputStream_'. Only less than 'chunkSize_' if setPageRuns() was called.
+  uint64_t currentRunEnd_{std::numeric_limits<uint64_t>::max()};
+
+  // Runs of pages after the one in 'inputStream_'. Set by setPageRuns().
+  std::vector<PageRun> pageRuns_;
+
+  // Index of the first run in 'pageRuns_' that has not been started.
+  int32_t nextPageRun_{0};
+
   // Number of bytes starting at pageData_ for current encoded data.
   int32_t encodedDataSize_{0};
 
@@ -524,6 +601,15 @@ class PageReader {
   std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrDecoder_;
   std::unique_ptr<RleBpDataDecoder> rleBooleanDecoder_;
   // Add decoders for other encodings here.
+
+  // Executor for decompressing the next pages ahead of the decoder. nullptr
+  // if pages are decompressed when decoded.
+  folly::Executor* decompressionExecutor_{nullptr};
+  int32_t decompressionPagesAhead_{0};
+
+  // The next pages in chunk order that are decompressing on
+  // 'decompressionExecutor_'.
+  std::deque<PageAhead> pagesAhead_;
 };
 
 FOLLY_ALWAYS_INLINE dwio::common::compression::CompressionOptions
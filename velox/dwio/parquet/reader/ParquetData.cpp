@@ -17,15 +17,203 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetStatsContext.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+
+// Maximum number of values of a filter that are probed in a bloom filter.
+// Larger IN lists are unlikely to be pruned.
+constexpr int64_t kMaxBloomFilterProbes = 1'000;
+
+// Upper bound on the size of a serialized BloomFilterHeader.
+constexpr uint64_t kMaxBloomFilterHeaderSize = 256;
+
+// Sets 'values' to the integers that pass 'filter'. Returns false if these
+// cannot be enumerated or are too many to probe one by one.
+bool bigintValuesToProbe(
+    const common::Filter& filter,
+    std::vector<int64_t>& values) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = filter.as<common::BigintRange>();
+      if (!range->isSingleValue()) {
+        return false;
+      }
+      values = {range->lower()};
+      return true;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      values = filter.as<common::BigintValuesUsingHashTable>()->values();
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask: {
+      auto* bitmask = filter.as<common::BigintValuesUsingBitmask>();
+      if (bitmask->max() - bitmask->min() >= kMaxBloomFilterProbes) {
+        return false;
+      }
+      values = bitmask->values();
+      break;
+    }
+    default:
+      return false;
+  }
+  return values.size() <= kMaxBloomFilterProbes;
+}
+
+// Sets 'values' to the strings that pass 'filter'. 'values' reference the
+// strings of 'filter'. Returns false if these cannot be enumerated or are too
+// many to probe one by one.
+bool bytesValuesToProbe(
+    const common::Filter& filter,
+    std::vector<std::string_view>& values) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBytesRange: {
+      auto* range = filter.as<common::BytesRange>();
+      if (!range->isSingleValue()) {
+        return false;
+      }
+      values = {range->lower()};
+      return true;
+    }
+    case common::FilterKind::kBytesValues: {
+      const auto& filterValues = filter.as<common::BytesValues>()->values();
+      if (filterValues.size() > kMaxBloomFilterProbes) {
+        return false;
+      }
+      values.assign(filterValues.begin(), filterValues.end());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// True if the values of a filter on 'type' have the same plain encoding as the
+// values hashed into the bloom filter or held in the dictionary. This excludes
+// unsigned integers, which are reinterpreted on read, and logical types whose
+// Velox values differ from the stored ones, e.g. decimals and timestamps.
+bool filterAppliesToStoredValues(const ParquetTypeWithId& type) {
+  const auto& convertedType = type.convertedType_;
+  if (convertedType.has_value() &&
+      (convertedType == thrift::ConvertedType::UINT_8 ||
+       convertedType == thrift::ConvertedType::UINT_16 ||
+       convertedType == thrift::ConvertedType::UINT_32 ||
+       convertedType == thrift::ConvertedType::UINT_64)) {
+    return false;
+  }
+  const auto& logicalType = type.logicalType_;
+  if (logicalType.has_value() && logicalType->__isset.INTEGER &&
+      !logicalType->INTEGER.isSigned) {
+    return false;
+  }
+  const auto& veloxType = *type.type();
+  switch (type.parquetType_.value()) {
+    case thrift::Type::INT32:
+      return veloxType == *TINYINT() || veloxType == *SMALLINT() ||
+          veloxType == *INTEGER() || veloxType == *BIGINT() ||
+          veloxType.isDate();
+    case thrift::Type::INT64:
+      return veloxType == *BIGINT();
+    case thrift::Type::BYTE_ARRAY:
+      return veloxType.kind() == TypeKind::VARCHAR ||
+          veloxType.kind() == TypeKind::VARBINARY;
+    default:
+      return false;
+  }
+}
+
+// Returns true if a value of 'dictionary' of a column of physical type
+// 'parquetType' passes 'filter'.
+bool testFilterWithDictionary(
+    const common::Filter& filter,
+    const dwio::common::DictionaryValues& dictionary,
+    thrift::Type::type parquetType) {
+  switch (parquetType) {
+    case thrift::Type::INT32: {
+      const auto* values = dictionary.values->as<int32_t>();
+      for (auto i = 0; i < dictionary.numValues; ++i) {
+        if (filter.testInt64(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case thrift::Type::INT64: {
+      const auto* values = dictionary.values->as<int64_t>();
+      for (auto i = 0; i < dictionary.numValues; ++i) {
+        if (filter.testInt64(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case thrift::Type::BYTE_ARRAY: {
+      const auto* values = dictionary.values->as<StringView>();
+      for (auto i = 0; i < dictionary.numValues; ++i) {
+        if (filter.testBytes(values[i].data(), values[i].size())) {
+          return true;
+        }
+      }
+      return false;
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace
+
+bool testFilterWithBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type parquetType) {
+  switch (parquetType) {
+    case thrift::Type::INT32:
+    case thrift::Type::INT64: {
+      std::vector<int64_t> values;
+      if (!bigintValuesToProbe(filter, values)) {
+        return true;
+      }
+      return std::any_of(values.begin(), values.end(), [&](int64_t value) {
+        if (parquetType == thrift::Type::INT64) {
+          return bloomFilter.findHash(bloomFilter.hash(value));
+        }
+        // Values out of the range of the column are not in it.
+        return value >= std::numeric_limits<int32_t>::min() &&
+            value <= std::numeric_limits<int32_t>::max() &&
+            bloomFilter.findHash(
+                bloomFilter.hash(static_cast<int32_t>(value)));
+      });
+    }
+    case thrift::Type::BYTE_ARRAY: {
+      std::vector<std::string_view> values;
+      if (!bytesValuesToProbe(filter, values)) {
+        return true;
+      }
+      return std::any_of(
+          values.begin(), values.end(), [&](std::string_view value) {
+            const ByteArray byteArray(value);
+            return bloomFilter.findHash(bloomFilter.hash(&byteArray));
+          });
+    }
+    default:
+      return true;
+  }
+}
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
   return std::make_unique<ParquetData>(
-      type, metaData_, pool(), runtimeStatistics(), sessionTimezone_);
+      type,
+      metaData_,
+      pool(),
+      runtimeStatistics(),
+      sessionTimezone_,
+      decompressionExecutor_,
+      decompressionPagesAhead_);
 }
 
 void ParquetData::filterRowGroups(
@@ -91,6 +279,76 @@ bool ParquetData::rowGroupMatches(
   return true;
 }
 
+bool ParquetData::bloomFilterMayMatch(
+    uint32_t index,
+    const common::Filter& filter,
+    dwio::common::BufferedInput& input) const {
+  // Nulls are not in the bloom filter. The values of repeated columns do not
+  // correspond to top level rows.
+  if (filter.testNull() || maxRepeat_ > 0 || !type_->isLeaf() ||
+      !type_->parquetType_.has_value() ||
+      !filterAppliesToStoredValues(*type_)) {
+    return true;
+  }
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (!chunk.hasBloomFilter()) {
+    return true;
+  }
+  const uint64_t offset = chunk.bloomFilterOffset();
+  const uint64_t fileLength = input.getReadFile()->size();
+  VELOX_CHECK_LT(
+      offset,
+      fileLength,
+      "Bloom filter offset out of bounds for schema Id {}",
+      type_->column());
+  // The length of the bloom filter is not in the metadata. The stream covers
+  // the largest possible bloom filter and only the needed bytes are read.
+  auto stream = input.read(
+      offset,
+      std::min(
+          fileLength - offset,
+          kMaxBloomFilterHeaderSize + BloomFilter::kMaximumBloomFilterBytes),
+      dwio::common::LogType::STRIPE_INDEX);
+  auto bloomFilter = BlockSplitBloomFilter::deserialize(stream.get(), pool_);
+  return testFilterWithBloomFilter(
+      filter, bloomFilter, type_->parquetType_.value());
+}
+
+bool ParquetData::dictionaryMayMatch(
+    uint32_t index,
+    const common::Filter& filter,
+    dwio::common::BufferedInput& input) const {
+  // Nulls are not in the dictionary. The values of repeated columns do not
+  // correspond to top level rows.
+  if (filter.testNull() || maxRepeat_ > 0 || !type_->isLeaf() ||
+      !type_->parquetType_.has_value() ||
+      !filterAppliesToStoredValues(*type_)) {
+    return true;
+  }
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (!chunk.hasDictionaryPageOffset() || !chunk.hasOnlyDictionaryDataPages()) {
+    return true;
+  }
+  // The dictionary page is between the dictionary page offset and the first
+  // data page.
+  const int64_t offset = chunk.dictionaryPageOffset();
+  const int64_t dataPageOffset = chunk.dataPageOffset();
+  if (offset < 4 || offset >= dataPageOffset) {
+    return true;
+  }
+  const int64_t size = dataPageOffset - offset;
+  PageReader reader(
+      input.read(offset, size, dwio::common::LogType::STREAM),
+      pool_,
+      type_,
+      chunk.compression(),
+      size,
+      stats_,
+      sessionTimezone_);
+  return testFilterWithDictionary(
+      filter, reader.readDictionary(), type_->parquetType_.value());
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -108,19 +366,144 @@ void ParquetData::enqueueRowGroup(
     chunkReadOffset = chunk.dictionaryPageOffset();
   }
 
+  auto id = dwio::common::StreamIdentifier(type_->column());
+  auto rangesIt = rowRanges_.find(index);
+  if (rangesIt != rowRanges_.end()) {
+    enqueuePageRuns(index, chunkReadOffset, rangesIt->second, input);
+    rowRanges_.erase(rangesIt);
+    return;
+  }
+
   uint64_t readSize =
       (chunk.compression() == common::CompressionKind::CompressionKind_NONE)
       ? chunk.totalUncompressedSize()
       : chunk.totalCompressedSize();
 
-  auto id = dwio::common::StreamIdentifier(type_->column());
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
 }
 
+void ParquetData::enqueuePageRuns(
+    uint32_t index,
+    uint64_t chunkReadOffset,
+    const std::vector<RowRange>& ranges,
+    dwio::common::BufferedInput& input) {
+  const auto& pageIndex = pageIndexes_.at(index);
+  const auto numRows = fileMetaDataPtr_.rowGroup(index).numRows();
+  const auto pages = pageIndex->pagesInRanges(ranges, numRows);
+  if (pages.empty()) {
+    // The row group is skipped without seekToRowGroup().
+    pageIndexes_.erase(index);
+    return;
+  }
+  const uint64_t dictionarySize = pageIndex->numPages() > 0
+      ? pageIndex->pageOffset(0) - chunkReadOffset
+      : 0;
+  auto id = dwio::common::StreamIdentifier(type_->column());
+  const auto addRun = [&](uint64_t offset, uint64_t size, int64_t firstRow) {
+    pageRuns_[index].push_back(
+        {offset - chunkReadOffset,
+         size,
+         firstRow,
+         input.enqueue({offset, size}, &id)});
+  };
+
+  // Groups consecutive pages into runs. The dictionary page is always read
+  // and shares the first run if the first data page is also read.
+  size_t i = 0;
+  while (i < pages.size()) {
+    auto last = i;
+    while (last + 1 < pages.size() && pages[last + 1] == pages[last] + 1) {
+      ++last;
+    }
+    uint64_t begin = pageIndex->pageOffset(pages[i]);
+    const uint64_t end =
+        pageIndex->pageOffset(pages[last]) + pageIndex->pageSize(pages[last]);
+    if (i == 0 && dictionarySize > 0) {
+      if (pages[i] == 0) {
+        begin = chunkReadOffset;
+      } else {
+        addRun(chunkReadOffset, dictionarySize, 0);
+      }
+    }
+    addRun(begin, end - begin, pageIndex->pageFirstRow(pages[i]));
+    i = last + 1;
+  }
+}
+
+bool ParquetData::appendPageIndexRegions(
+    uint32_t index,
+    bool withColumnIndex,
+    std::vector<common::Region>& regions) const {
+  if (!type_->isLeaf() || maxRepeat_ > 0 || maxDefine_ > 1) {
+    return false;
+  }
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (!chunk.hasOffsetIndex()) {
+    return false;
+  }
+  regions.emplace_back(chunk.offsetIndexOffset(), chunk.offsetIndexLength());
+  if (withColumnIndex && chunk.hasColumnIndex()) {
+    regions.emplace_back(chunk.columnIndexOffset(), chunk.columnIndexLength());
+  }
+  return true;
+}
+
+void ParquetData::setPageIndex(
+    uint32_t index,
+    std::string_view data,
+    uint64_t dataOffset) {
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  const auto contains = [&](int64_t offset, int32_t length) {
+    return offset >= dataOffset && offset + length <= dataOffset + data.size();
+  };
+  VELOX_CHECK(
+      contains(chunk.offsetIndexOffset(), chunk.offsetIndexLength()),
+      "OffsetIndex not in page index data for schema Id {}",
+      type_->column());
+  auto offsetIndex = data.substr(
+      chunk.offsetIndexOffset() - dataOffset, chunk.offsetIndexLength());
+  // The ColumnIndex is only read for filtered columns.
+  std::string_view columnIndex;
+  if (chunk.hasColumnIndex() &&
+      contains(chunk.columnIndexOffset(), chunk.columnIndexLength())) {
+    columnIndex = data.substr(
+        chunk.columnIndexOffset() - dataOffset, chunk.columnIndexLength());
+  }
+  pageIndexes_[index] =
+      std::make_unique<ColumnPageIndex>(columnIndex, offsetIndex);
+}
+
+std::optional<std::vector<RowRange>> ParquetData::filterPages(
+    uint32_t index,
+    const common::Filter& filter,
+    const ParquetStatsContext& context) const {
+  if (type_->parquetType_.has_value() &&
+      context.shouldIgnoreStatistics(type_->parquetType_.value())) {
+    return std::nullopt;
+  }
+  const auto& pageIndex = pageIndexes_.at(index);
+  if (!pageIndex->hasColumnIndex()) {
+    return std::nullopt;
+  }
+  return pageIndex->filterPages(
+      filter, type_->type(), fileMetaDataPtr_.rowGroup(index).numRows());
+}
+
+void ParquetData::setRowRanges(
+    uint32_t index,
+    const std::vector<RowRange>& ranges) {
+  VELOX_CHECK(
+      pageIndexes_.count(index), "Page index not set for row group {}", index);
+  rowRanges_[index] = ranges;
+}
+
 dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
   static std::vector<uint64_t> empty;
   VELOX_CHECK_LT(index, streams_.size());
-  VELOX_CHECK(streams_[index], "Stream not enqueued for column");
+  auto runsIt = pageRuns_.find(index);
+  VELOX_CHECK(
+      streams_[index] || runsIt != pageRuns_.end(),
+      "Stream not enqueued for column");
   auto metadata = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
   reader_ = std::make_unique<PageReader>(
       std::move(streams_[index]),
@@ -130,6 +513,15 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
       metadata.totalCompressedSize(),
       stats_,
       sessionTimezone_);
+  if (runsIt != pageRuns_.end()) {
+    reader_->setPageRuns(std::move(runsIt->second));
+    pageRuns_.erase(runsIt);
+  }
+  if (decompressionExecutor_ != nullptr && decompressionPagesAhead_ > 0) {
+    reader_->setDecompressionAhead(
+        decompressionExecutor_, decompressionPagesAhead_);
+  }
+  pageIndexes_.erase(index);
   return dwio::common::PositionProvider(empty);
 }
 
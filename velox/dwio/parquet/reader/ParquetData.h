@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/parquet/reader/ColumnPageIndex.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 
@@ -30,6 +31,18 @@ class BufferedInput;
 
 namespace facebook::velox::parquet {
 
+class BloomFilter;
+class ParquetStatsContext;
+
+/// Returns false if no value passing 'filter' is in 'bloomFilter', which
+/// holds the hashes of the plain encoded values of a column of physical type
+/// 'parquetType'. Returns true if some value may be in the bloom filter or if
+/// the values passing 'filter' cannot be enumerated, e.g. for ranges.
+bool testFilterWithBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type parquetType);
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
   ParquetParams(
@@ -37,11 +50,15 @@ class ParquetParams : public dwio::common::FormatParams {
       dwio::common::ColumnReaderStatistics& stats,
       const FileMetaDataPtr metaData,
       const tz::TimeZone* sessionTimezone,
-      TimestampPrecision timestampPrecision)
+      TimestampPrecision timestampPrecision,
+      folly::Executor* decompressionExecutor = nullptr,
+      int32_t decompressionPagesAhead = 0)
       : FormatParams(pool, stats),
         metaData_(metaData),
         sessionTimezone_(sessionTimezone),
-        timestampPrecision_(timestampPrecision) {}
+        timestampPrecision_(timestampPrecision),
+        decompressionExecutor_(decompressionExecutor),
+        decompressionPagesAhead_(decompressionPagesAhead) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
@@ -54,6 +71,8 @@ class ParquetParams : public dwio::common::FormatParams {
   const FileMetaDataPtr metaData_;
   const tz::TimeZone* sessionTimezone_;
   const TimestampPrecision timestampPrecision_;
+  folly::Executor* const decompressionExecutor_;
+  const int32_t decompressionPagesAhead_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -64,7 +83,9 @@ class ParquetData : public dwio::common::FormatData {
       const FileMetaDataPtr fileMetadataPtr,
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
-      const tz::TimeZone* sessionTimezone)
+      const tz::TimeZone* sessionTimezone,
+      folly::Executor* decompressionExecutor = nullptr,
+      int32_t decompressionPagesAhead = 0)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
@@ -72,7 +93,9 @@ class ParquetData : public dwio::common::FormatData {
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1),
         stats_(stats),
-        sessionTimezone_(sessionTimezone) {}
+        sessionTimezone_(sessionTimezone),
+        decompressionExecutor_(decompressionExecutor),
+        decompressionPagesAhead_(decompressionPagesAhead) {}
 
   /// Prepares to read data for 'index'th row group.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
@@ -207,11 +230,65 @@ class ParquetData : public dwio::common::FormatData {
   // Returns the <offset, length> of the row group.
   std::pair<int64_t, int64_t> getRowGroupRegion(uint32_t index) const;
 
+  /// Appends to 'regions' the file regions of the page index of the column
+  /// chunk in row group 'index'. The OffsetIndex is always appended and the
+  /// ColumnIndex only if 'withColumnIndex' is true and it exists. Returns
+  /// false without appending if pages of the column cannot be skipped, i.e. it
+  /// is not a top level leaf or has no OffsetIndex.
+  bool appendPageIndexRegions(
+      uint32_t index,
+      bool withColumnIndex,
+      std::vector<common::Region>& regions) const;
+
+  /// Sets the page index for row group 'index' from the regions appended by
+  /// appendPageIndexRegions(). 'data' holds the bytes of the file starting at
+  /// offset 'dataOffset'.
+  void setPageIndex(uint32_t index, std::string_view data, uint64_t dataOffset);
+
+  /// Returns the rows of row group 'index' that may pass 'filter' according to
+  /// the per-page statistics. Returns std::nullopt if the page index has no
+  /// statistics or they must not be used. setPageIndex() must be called first.
+  std::optional<std::vector<RowRange>> filterPages(
+      uint32_t index,
+      const common::Filter& filter,
+      const ParquetStatsContext& context) const;
+
+  /// Returns false if the bloom filter of the column chunk in row group
+  /// 'index' shows that no value passes 'filter'. Reads the bloom filter from
+  /// 'input'. Returns true if the column chunk has no bloom filter or it
+  /// cannot be used for 'filter'.
+  bool bloomFilterMayMatch(
+      uint32_t index,
+      const common::Filter& filter,
+      dwio::common::BufferedInput& input) const;
+
+  /// Returns false if the dictionary page of the column chunk in row group
+  /// 'index' has no value that passes 'filter' and all data pages of the
+  /// chunk are dictionary encoded. Reads the dictionary page from 'input'.
+  /// Returns true if this cannot be determined from the dictionary.
+  bool dictionaryMayMatch(
+      uint32_t index,
+      const common::Filter& filter,
+      dwio::common::BufferedInput& input) const;
+
+  /// Restricts the reading of row group 'index' to 'ranges'. Only the pages
+  /// overlapping 'ranges' are enqueued by enqueueRowGroup() and other rows must
+  /// not be read. setPageIndex() must be called first.
+  void setRowRanges(uint32_t index, const std::vector<RowRange>& ranges);
+
  private:
   /// True if 'filter' may have hits for the column of 'this' according to the
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, const common::Filter* filter);
 
+  // Enqueues the runs of consecutive pages of row group 'index' that overlap
+  // 'ranges'. The dictionary page is enqueued with the first run.
+  void enqueuePageRuns(
+      uint32_t index,
+      uint64_t chunkReadOffset,
+      const std::vector<RowRange>& ranges,
+      dwio::common::BufferedInput& input);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
@@ -225,6 +302,10 @@ class ParquetData : public dwio::common::FormatData {
   int64_t rowsInRowGroup_;
   dwio::common::ColumnReaderStatistics& stats_;
   const tz::TimeZone* sessionTimezone_;
+  // Executor and number of pages for decompressing the pages of 'reader_'
+  // ahead of the decoder. See PageReader::setDecompressionAhead().
+  folly::Executor* const decompressionExecutor_;
+  const int32_t decompressionPagesAhead_;
   std::unique_ptr<PageReader> reader_;
 
   // Nulls derived from leaf repdefs for non-leaf readers.
@@ -235,6 +316,16 @@ class ParquetData : public dwio::common::FormatData {
 
   // Count of leading skipped positions in 'presetNulls_'
   int32_t presetNullsConsumed_{0};
+
+  // Page index of the column chunk for the row groups given to
+  // setPageIndex(). Erased when the row group is read.
+  std::unordered_map<uint32_t, std::unique_ptr<ColumnPageIndex>> pageIndexes_;
+
+  // Rows to read for the row groups given to setRowRanges().
+  std::unordered_map<uint32_t, std::vector<RowRange>> rowRanges_;
+
+  // Runs of pages enqueued for row groups that are read in part.
+  std::unordered_map<uint32_t, std::vector<PageRun>> pageRuns_;
 };
 
 } // namespace facebook::velox::parquet
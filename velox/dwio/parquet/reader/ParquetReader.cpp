@@ -61,6 +61,14 @@ bool isParquetReservedKeyword(
       : false;
 }
 
+// A parsed footer in the FooterCache.
+struct ParquetFooter : public dwio::common::ParsedFooter {
+  explicit ParquetFooter(std::shared_ptr<thrift::FileMetaData> _fileMetaData)
+      : fileMetaData(std::move(_fileMetaData)) {}
+
+  const std::shared_ptr<thrift::FileMetaData> fileMetaData;
+};
+
 // An unannotated array in Parquet is a repeated field that is not explicitly
 // marked as a LIST logical type. If current schema element is a repeated field
 // and the requested type is an array, we treat the current schema element as an
@@ -106,6 +114,12 @@ class ReaderBase {
     return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_.get()));
   }
 
+  /// True if the file metadata is shared with other readers through the
+  /// footer cache, so it must not be modified.
+  bool isFileMetaDataShared() const {
+    return fileMetaDataShared_;
+  }
+
   const dwio::common::ReaderOptions& options() const {
     return options_;
   }
@@ -148,7 +162,7 @@ class ReaderBase {
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
  private:
-  // Reads and parses file footer.
+  // Reads and parses file footer, or gets it from the footer cache.
   void loadFileMetaData();
 
   void initializeSchema();
@@ -182,7 +196,8 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<thrift::FileMetaData> fileMetaData_;
+  bool fileMetaDataShared_{false};
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -215,6 +230,20 @@ void ReaderBase::loadFileMetaData() {
       fileLength_ <= std::max(filePreloadThreshold_, footerSpeculativeIoSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerSpeculativeIoSize_;
 
+  auto* footerCache = options_.footerCache();
+  if (footerCache != nullptr) {
+    if (auto footer = std::dynamic_pointer_cast<const ParquetFooter>(
+            footerCache->find(options_.footerCacheKey()))) {
+      fileMetaData_ = footer->fileMetaData;
+      fileMetaDataShared_ = true;
+      if (preloadFile) {
+        // A small file is still read in one IO, now without the footer parse.
+        input_->loadCompleteFile();
+      }
+      return;
+    }
+  }
+
   std::unique_ptr<dwio::common::SeekableInputStream> stream;
   if (preloadFile) {
     stream = input_->loadCompleteFile();
@@ -257,8 +286,17 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
+  fileMetaData_ = std::make_shared<thrift::FileMetaData>();
   fileMetaData_->read(thriftProtocol.get());
+  if (footerCache != nullptr) {
+    // The size of the entry is the size of the serialized footer. The parsed
+    // footer takes a few times more memory.
+    footerCache->insert(
+        options_.footerCacheKey(),
+        std::make_shared<ParquetFooter>(fileMetaData_),
+        footerLength);
+    fileMetaDataShared_ = true;
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -1179,6 +1217,9 @@ void ReaderBase::scheduleRowGroups(
   for (auto i = 0; i < numRowGroupsToLoad; i++) {
     auto thisGroup = rowGroupIds[currentGroup + i];
     if (!inputs_[thisGroup]) {
+      if (options_.pageIndexFilterEnabled()) {
+        reader.filterPages(thisGroup, ParquetStatsContext(version_), *input_);
+      }
       inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
     }
   }
@@ -1245,7 +1286,9 @@ class ParquetRowReader::Impl {
         columnReaderStats_,
         readerBase_->fileMetaData(),
         readerBase->sessionTimezone(),
-        options_.timestampPrecision());
+        options_.timestampPrecision(),
+        options_.ioExecutor(),
+        readerBase_->options().decompressionPagesAhead());
     requestedType_ = options_.requestedType() ? options_.requestedType()
                                               : readerBase_->schema();
     columnReader_ = ParquetColumnReader::build(
@@ -1293,6 +1336,20 @@ class ParquetRowReader::Impl {
       auto isExcluded =
           (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i));
       auto isEmpty = rowGroups_[i].num_rows == 0;
+      if (rowGroupInRange && !isExcluded && !isEmpty &&
+          readerBase_->options().bloomFilterEnabled() &&
+          !static_cast<StructColumnReader&>(*columnReader_)
+               .bloomFiltersMayMatch(i, readerBase_->bufferedInput())) {
+        isExcluded = true;
+        ++bloomFilterSkippedStrides_;
+      }
+      if (rowGroupInRange && !isExcluded && !isEmpty &&
+          readerBase_->options().dictionaryFilterEnabled() &&
+          !static_cast<StructColumnReader&>(*columnReader_)
+               .dictionariesMayMatch(i, readerBase_->bufferedInput())) {
+        isExcluded = true;
+        ++dictionaryFilterSkippedStrides_;
+      }
 
       // Add a row group to read if it is within range and not empty and not in
       // the excluded list.
@@ -1300,7 +1357,7 @@ class ParquetRowReader::Impl {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
       } else {
-        if (i != 0) {
+        if (i != 0 && !readerBase_->isFileMetaDataShared()) {
           // Clear the metadata of row groups that are not read. This helps
           // reduce the memory consumption. ColumnChunks consume the most
           // memory. Skip the 0th RowGroup as it is used by estimatedRowSize().
@@ -1316,10 +1373,12 @@ class ParquetRowReader::Impl {
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
-    }
+    do {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+    } while (!skipToNextRowRange());
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
 
@@ -1328,7 +1387,11 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    uint64_t end = rowsInCurrentRowGroup_;
+    if (rowRanges_.has_value()) {
+      end = (*rowRanges_)[nextRowRange_].end;
+    }
+    return std::min(size, end - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -1372,7 +1435,10 @@ class ParquetRowReader::Impl {
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += skippedStrides_;
+    stats.bloomFilterSkippedStrides += bloomFilterSkippedStrides_;
+    stats.dictionaryFilterSkippedStrides += dictionaryFilterSkippedStrides_;
     stats.processedStrides += rowGroupIds_.size();
+    stats.skippedPageRows += skippedPageRows_;
     stats.columnReaderStats.pageLoadTimeNs.merge(
         columnReaderStats_.pageLoadTimeNs);
   }
@@ -1400,10 +1466,44 @@ class ParquetRowReader::Impl {
     rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
+    rowRanges_ = static_cast<StructColumnReader&>(*columnReader_)
+                     .takePageRowRanges(nextRowGroupIndex);
+    nextRowRange_ = 0;
+    if (rowRanges_.has_value() && rowRanges_->empty()) {
+      // No page passes the filters, so no stream is enqueued for the row
+      // group and the column readers must not be positioned on it.
+      skippedPageRows_ += rowsInCurrentRowGroup_;
+      currentRowInGroup_ = rowsInCurrentRowGroup_;
+      return advanceToNextRowGroup();
+    }
     columnReader_->seekToRowGroup(nextRowGroupIndex);
     return true;
   }
 
+  // Moves 'currentRowInGroup_' to the first row of 'rowRanges_' at or after
+  // it. The skipped rows are not read by the column readers. Returns false
+  // if no rows are left in the current row group.
+  bool skipToNextRowRange() {
+    if (!rowRanges_.has_value()) {
+      return true;
+    }
+    const auto& ranges = *rowRanges_;
+    while (nextRowRange_ < ranges.size() &&
+           ranges[nextRowRange_].end <= currentRowInGroup_) {
+      ++nextRowRange_;
+    }
+    const uint64_t target = nextRowRange_ < ranges.size()
+        ? std::max<uint64_t>(ranges[nextRowRange_].begin, currentRowInGroup_)
+        : rowsInCurrentRowGroup_;
+    if (target > currentRowInGroup_) {
+      skippedPageRows_ += target - currentRowInGroup_;
+      currentRowInGroup_ = target;
+      // The column readers skip to the new position on the next read.
+      columnReader_->setReadOffset(target);
+    }
+    return currentRowInGroup_ < rowsInCurrentRowGroup_;
+  }
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -1419,6 +1519,19 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
   uint32_t skippedStrides_{0};
+  // Number of row groups in 'skippedStrides_' pruned by bloom filters.
+  uint32_t bloomFilterSkippedStrides_{0};
+  // Number of row groups in 'skippedStrides_' pruned by dictionaries.
+  uint32_t dictionaryFilterSkippedStrides_{0};
+
+  // Rows to read in the current row group if pages are skipped using the page
+  // index. All rows are read if not set.
+  std::optional<std::vector<RowRange>> rowRanges_;
+  // Index in 'rowRanges_' of the range containing or following
+  // 'currentRowInGroup_'.
+  size_t nextRowRange_{0};
+  // Number of rows skipped by 'rowRanges_'.
+  int64_t skippedPageRows_{0};
 
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
@@ -17,6 +17,7 @@
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/StreamUtil.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/RepeatedColumnReader.h"
 
@@ -151,6 +152,119 @@ void StructColumnReader::enqueueRowGroup(
   }
 }
 
+void StructColumnReader::filterPages(
+    uint32_t index,
+    const ParquetStatsContext& context,
+    dwio::common::BufferedInput& input) {
+  VELOX_CHECK_NULL(
+      reinterpret_cast<const ParquetTypeWithId*>(fileType_.get())->parent(),
+      "Pages are only filtered from the root");
+  std::vector<ParquetData*> leaves;
+  std::vector<const common::Filter*> filters;
+  std::vector<common::Region> regions;
+  bool hasFilter = false;
+  for (auto* child : children_) {
+    auto* filter = child->scanSpec()->filter();
+    auto& data = child->formatData().as<ParquetData>();
+    if (data.appendPageIndexRegions(index, filter != nullptr, regions)) {
+      leaves.push_back(&data);
+      filters.push_back(filter);
+      hasFilter |= filter != nullptr;
+    }
+  }
+  if (!hasFilter) {
+    return;
+  }
+
+  // The page indices of a row group are written together after the row group,
+  // so they are read with a single IO.
+  uint64_t begin = std::numeric_limits<uint64_t>::max();
+  uint64_t end = 0;
+  for (const auto& region : regions) {
+    begin = std::min(begin, region.offset);
+    end = std::max(end, region.offset + region.length);
+  }
+  auto stream =
+      input.read(begin, end - begin, dwio::common::LogType::STRIPE_INDEX);
+  std::string data(end - begin, '\0');
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      data.size(), stream.get(), data.data(), bufferStart, bufferEnd);
+
+  std::optional<std::vector<RowRange>> ranges;
+  for (auto i = 0; i < leaves.size(); ++i) {
+    leaves[i]->setPageIndex(index, data, begin);
+    if (!filters[i]) {
+      continue;
+    }
+    auto leafRanges = leaves[i]->filterPages(index, *filters[i], context);
+    if (!leafRanges.has_value()) {
+      continue;
+    }
+    ranges = ranges.has_value() ? intersectRowRanges(*ranges, *leafRanges)
+                                : std::move(*leafRanges);
+  }
+  if (!ranges.has_value()) {
+    return;
+  }
+  for (auto* leaf : leaves) {
+    leaf->setRowRanges(index, *ranges);
+  }
+  pageRowRanges_[index] = std::move(*ranges);
+}
+
+bool StructColumnReader::bloomFiltersMayMatch(
+    uint32_t index,
+    dwio::common::BufferedInput& input) const {
+  for (auto* child : children_) {
+    if (auto* structChild = dynamic_cast<StructColumnReader*>(child)) {
+      if (!structChild->bloomFiltersMayMatch(index, input)) {
+        return false;
+      }
+      continue;
+    }
+    auto* filter = child->scanSpec()->filter();
+    if (filter &&
+        !child->formatData().as<ParquetData>().bloomFilterMayMatch(
+            index, *filter, input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool StructColumnReader::dictionariesMayMatch(
+    uint32_t index,
+    dwio::common::BufferedInput& input) const {
+  for (auto* child : children_) {
+    if (auto* structChild = dynamic_cast<StructColumnReader*>(child)) {
+      if (!structChild->dictionariesMayMatch(index, input)) {
+        return false;
+      }
+      continue;
+    }
+    auto* filter = child->scanSpec()->filter();
+    if (filter &&
+        !child->formatData().as<ParquetData>().dictionaryMayMatch(
+            index, *filter, input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<std::vector<RowRange>> StructColumnReader::takePageRowRanges(
+    uint32_t index) {
+  auto it = pageRowRanges_.find(index);
+  if (it == pageRowRanges_.end()) {
+    return std::nullopt;
+  }
+  auto ranges = std::move(it->second);
+  pageRowRanges_.erase(it);
+  return ranges;
+}
+
 void StructColumnReader::seekToRowGroup(int64_t index) {
   SelectiveStructColumnReader::seekToRowGroup(index);
   BufferPtr noBuffer;
@@ -19,6 +19,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SelectiveStructColumnReader.h"
 #include "velox/dwio/parquet/common/LevelConversion.h"
+#include "velox/dwio/parquet/reader/ColumnPageIndex.h"
 
 namespace facebook::velox::dwio::common {
 class BufferedInput;
@@ -29,6 +30,7 @@ namespace facebook::velox::parquet {
 enum class LevelMode;
 class PageReader;
 class ParquetParams;
+class ParquetStatsContext;
 
 class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
  public:
@@ -51,6 +53,33 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       uint32_t index,
       const std::shared_ptr<dwio::common::BufferedInput>& input);
 
+  /// Reads the page index of row group 'index' for the top level leaves and
+  /// restricts them to the pages that may pass the filters on these leaves.
+  /// The rows to read are retrieved with takePageRowRanges(). Must be called
+  /// on the root before loadRowGroup() for the same row group.
+  void filterPages(
+      uint32_t index,
+      const ParquetStatsContext& context,
+      dwio::common::BufferedInput& input);
+
+  /// Returns false if the bloom filter of a leaf shows that no row of row
+  /// group 'index' passes the filter on the leaf. Only leaves reached through
+  /// structs are checked. Bloom filters are read from 'input'.
+  bool bloomFiltersMayMatch(
+      uint32_t index,
+      dwio::common::BufferedInput& input) const;
+
+  /// Returns false if the dictionary of a leaf shows that no row of row group
+  /// 'index' passes the filter on the leaf. Only leaves reached through
+  /// structs are checked. Dictionary pages are read from 'input'.
+  bool dictionariesMayMatch(
+      uint32_t index,
+      dwio::common::BufferedInput& input) const;
+
+  /// Returns the rows of row group 'index' selected by filterPages() or
+  /// std::nullopt if all rows are to be read.
+  std::optional<std::vector<RowRange>> takePageRowRanges(uint32_t index);
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
@@ -95,6 +124,10 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   // The level information for extracting nulls for 'this' from the
   // repdefs in a leaf PageReader.
   LevelInfo levelInfo_;
+
+  // Rows to read for the row groups given to filterPages(). Only set on the
+  // root.
+  std::unordered_map<uint32_t, std::vector<RowRange>> pageRowRanges_;
 };
 
 } // namespace facebook::velox::parquet
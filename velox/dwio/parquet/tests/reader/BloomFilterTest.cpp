@@ -31,6 +31,7 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/expression/ExprToSubfieldFilter.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::parquet;
@@ -395,3 +396,56 @@ TEST_F(BloomFilterTest, TestBloomFilterHashes) {
         << "Hash with seed 0 Error: " << i;
   }
 }
+
+TEST_F(BloomFilterTest, testFilter) {
+  BlockSplitBloomFilter bloomFilter(leafPool_.get());
+  bloomFilter.init(1024);
+  for (int64_t i = 0; i < 100; i += 10) {
+    bloomFilter.insertHash(bloomFilter.hash(i));
+    bloomFilter.insertHash(bloomFilter.hash(static_cast<int32_t>(i + 1)));
+  }
+  const std::string kHello = "hello";
+  const ByteArray hello(kHello);
+  bloomFilter.insertHash(bloomFilter.hash(&hello));
+
+  const auto test = [&](const common::Filter& filter,
+                        thrift::Type::type parquetType) {
+    return testFilterWithBloomFilter(filter, bloomFilter, parquetType);
+  };
+
+  // Single value ranges.
+  EXPECT_TRUE(test(*exec::equal(20), thrift::Type::INT64));
+  EXPECT_FALSE(test(*exec::equal(25), thrift::Type::INT64));
+  EXPECT_TRUE(test(*exec::equal(21), thrift::Type::INT32));
+  EXPECT_FALSE(test(*exec::equal(20), thrift::Type::INT32));
+  EXPECT_FALSE(test(
+      *exec::equal(std::numeric_limits<int64_t>::max()), thrift::Type::INT32));
+  EXPECT_TRUE(test(*exec::equal("hello"), thrift::Type::BYTE_ARRAY));
+  EXPECT_FALSE(test(*exec::equal("world"), thrift::Type::BYTE_ARRAY));
+  EXPECT_FALSE(test(
+      common::BytesRange("world", false, false, "world", false, false, false),
+      thrift::Type::BYTE_ARRAY));
+
+  // IN lists.
+  EXPECT_TRUE(test(
+      common::BigintValuesUsingHashTable(5, 1'000, {5, 30, 1'000}, false),
+      thrift::Type::INT64));
+  EXPECT_FALSE(test(
+      common::BigintValuesUsingHashTable(5, 1'000, {5, 35, 1'000}, false),
+      thrift::Type::INT64));
+  EXPECT_TRUE(test(
+      common::BigintValuesUsingBitmask(0, 20, {0, 10, 20}, false),
+      thrift::Type::INT64));
+  EXPECT_FALSE(test(
+      common::BigintValuesUsingBitmask(3, 7, {3, 5, 7}, false),
+      thrift::Type::INT64));
+  EXPECT_TRUE(test(
+      common::BytesValues({"a", "hello"}, false), thrift::Type::BYTE_ARRAY));
+  EXPECT_FALSE(
+      test(common::BytesValues({"a", "b"}, false), thrift::Type::BYTE_ARRAY));
+
+  // Filters whose values cannot be enumerated are not pruned.
+  EXPECT_TRUE(test(*exec::between(21, 29), thrift::Type::INT64));
+  EXPECT_TRUE(test(*exec::lessThan("a"), thrift::Type::BYTE_ARRAY));
+  EXPECT_TRUE(test(*exec::equal(25), thrift::Type::DOUBLE));
+}
@@ -149,6 +149,26 @@ TEST_F(E2EFilterTest, integerDeltaBinaryPack) {
       true,
       {"short_val", "int_val", "long_val"},
       20);
+
+  // Small deltas with occasional large negative outliers give miniblocks of
+  // bit widths below and above 32.
+  options_.dataPageSize = 4 * 1024;
+  testWithTypes(
+      "long_val:bigint",
+      [&]() {
+        makeIntDistribution<int64_t>(
+            "long_val",
+            0, // min
+            1'000, // max
+            10, // repeats
+            97, // rareFrequency
+            -1'000'000'000'000, // rareMin
+            0, // rareMax
+            true); // keepNulls
+      },
+      true,
+      {"long_val"},
+      20);
 }
 
 TEST_F(E2EFilterTest, compression) {
@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/Mutation.h"
+#include "velox/dwio/parquet/reader/ColumnPageIndex.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -1913,6 +1916,218 @@ TEST_F(ParquetReaderTest, columnStatisticsMultipleRowGroups) {
   EXPECT_EQ(intStats->getMaximum(), 50);
 }
 
+TEST_F(ParquetReaderTest, intersectRowRanges) {
+  std::vector<RowRange> left = {{0, 10}, {20, 30}, {40, 50}};
+  std::vector<RowRange> right = {{5, 25}, {30, 45}};
+  EXPECT_EQ(
+      intersectRowRanges(left, right),
+      (std::vector<RowRange>{{5, 10}, {20, 25}, {40, 45}}));
+  EXPECT_EQ(intersectRowRanges(left, {}), std::vector<RowRange>{});
+  EXPECT_EQ(intersectRowRanges(left, {{10, 20}}), std::vector<RowRange>{});
+  EXPECT_EQ(intersectRowRanges(left, {{0, 50}}), left);
+  EXPECT_EQ(numRowsInRanges(left), 30);
+}
+
+TEST_F(ParquetReaderTest, pageIndexFilter) {
+  constexpr int32_t kNumRows = 20'000;
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.enableDictionary = false;
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.enablePageIndex = true;
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<parquet::LambdaFlushPolicy>(
+        /*rowsInRowGroup=*/kNumRows / 2,
+        /*bytesInRowGroup=*/128 * 1'024 * 1'024,
+        []() { return false; });
+  };
+  auto data = makeRowVector(
+      {"a", "b"},
+      {
+          makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+          makeFlatVector<int64_t>(kNumRows, [](auto row) { return row * 2; }),
+      });
+  auto* sink = write(data, writerOptions);
+  const auto rowType = asRowType(data->type());
+
+  const auto read = [&](bool enabled,
+                        FilterMap filters,
+                        const RowVectorPtr& expected) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setPageIndexFilterEnabled(enabled);
+    auto reader = createReaderInMemory(*sink, readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    for (auto&& [column, filter] : filters) {
+      scanSpec->getOrCreateChild(common::Subfield(column))
+          ->setFilter(std::move(filter));
+    }
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.skippedPageRows;
+  };
+  const auto expectedRows = [&](int32_t begin, int32_t end) {
+    return std::dynamic_pointer_cast<RowVector>(
+        data->slice(begin, end - begin));
+  };
+
+  const auto makeFilters = [](int64_t aMin, int64_t aMax) {
+    FilterMap filters;
+    filters.insert({"a", exec::between(aMin, aMax)});
+    return filters;
+  };
+
+  // A range in the middle of the first row group.
+  EXPECT_EQ(
+      read(false, makeFilters(3'000, 3'999), expectedRows(3'000, 4'000)), 0);
+  const auto skipped =
+      read(true, makeFilters(3'000, 3'999), expectedRows(3'000, 4'000));
+  EXPECT_GT(skipped, 0);
+  EXPECT_LT(skipped, kNumRows / 2);
+
+  // The ranges of both filters are intersected.
+  auto filters = makeFilters(2'000, 16'000);
+  filters.insert({"b", exec::between(15'000, 20'000)});
+  EXPECT_GT(read(true, std::move(filters), expectedRows(7'500, 10'001)), 0);
+
+  // The row group stats pass but no page of the first row group passes both
+  // filters, so that no page of it is read and all its rows are skipped.
+  FilterMap inFilters;
+  inFilters.insert({"a", exec::in(std::vector<int64_t>{100, 12'000})});
+  inFilters.insert({"b", exec::in(std::vector<int64_t>{9'000, 24'000})});
+  EXPECT_GE(
+      read(true, std::move(inFilters), expectedRows(12'000, 12'001)),
+      kNumRows / 2);
+}
+
+TEST_F(ParquetReaderTest, dictionaryFilter) {
+  constexpr int32_t kNumRows = 20'000;
+  constexpr int32_t kRowsPerGroup = kNumRows / 2;
+  parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<parquet::LambdaFlushPolicy>(
+        /*rowsInRowGroup=*/kRowsPerGroup,
+        /*bytesInRowGroup=*/128 * 1'024 * 1'024,
+        []() { return false; });
+  };
+  // The first row group has "a" and "c" and the second has "b" and "c", so
+  // that the min/max statistics of both row groups pass a filter on "b". The
+  // same holds for 0 and 20 and 10 and 20 in 'n'.
+  const auto firstGroup = [&](auto row) { return row < kRowsPerGroup; };
+  auto data = makeRowVector(
+      {"s", "n"},
+      {
+          makeFlatVector<std::string>(
+              kNumRows,
+              [&](auto row) {
+                return row % 2 == 0 ? "c" : (firstGroup(row) ? "a" : "b");
+              }),
+          makeFlatVector<int64_t>(
+              kNumRows,
+              [&](auto row) {
+                return row % 2 == 0 ? 20 : (firstGroup(row) ? 0 : 10);
+              }),
+      });
+  auto* sink = write(data, writerOptions);
+  const auto rowType = asRowType(data->type());
+
+  const auto read = [&](bool enabled,
+                        const std::string& column,
+                        std::unique_ptr<common::Filter> filter,
+                        const RowVectorPtr& expected) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setDictionaryFilterEnabled(enabled);
+    auto reader = createReaderInMemory(*sink, readerOptions);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 2);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->getOrCreateChild(common::Subfield(column))
+        ->setFilter(std::move(filter));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(stats.dictionaryFilterSkippedStrides, enabled ? 1 : 0);
+  };
+  // The odd rows of the second row group.
+  auto expected = makeRowVector(
+      {"s", "n"},
+      {
+          makeFlatVector<std::string>(
+              kRowsPerGroup / 2, [](auto /*row*/) { return "b"; }),
+          makeFlatVector<int64_t>(
+              kRowsPerGroup / 2, [](auto /*row*/) { return 10; }),
+      });
+
+  for (bool enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    read(enabled, "s", exec::equal("b"), expected);
+    read(enabled, "s", exec::in(std::vector<std::string>{"b", "d"}), expected);
+    read(enabled, "n", exec::between(5, 15), expected);
+  }
+}
+
+TEST_F(ParquetReaderTest, decompressionPagesAhead) {
+  constexpr int32_t kNumRows = 20'000;
+  auto data = makeRowVector(
+      {"a", "b"},
+      {
+          makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              kNumRows,
+              [](auto row) { return fmt::format("value {}", row % 1'000); },
+              nullEvery(7)),
+      });
+  const auto rowType = asRowType(data->type());
+  folly::CPUThreadPoolExecutor executor(2);
+
+  for (const bool v2 : {false, true}) {
+    SCOPED_TRACE(fmt::format("v2: {}", v2));
+    parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = rootPool_.get();
+    writerOptions.compressionKind = common::CompressionKind_SNAPPY;
+    writerOptions.enableDictionary = false;
+    writerOptions.dataPageSize = 1'024;
+    writerOptions.useParquetDataPageV2 = v2;
+    auto* sink = write(data, writerOptions);
+
+    const auto read = [&](int32_t pagesAhead,
+                          std::unique_ptr<common::Filter> filter,
+                          const RowVectorPtr& expected) {
+      dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+      readerOptions.setDecompressionPagesAhead(pagesAhead);
+      auto reader = createReaderInMemory(*sink, readerOptions);
+      auto scanSpec = makeScanSpec(rowType);
+      if (filter != nullptr) {
+        scanSpec->getOrCreateChild(common::Subfield("a"))
+            ->setFilter(std::move(filter));
+      }
+      auto rowReaderOpts = getReaderOpts(rowType);
+      rowReaderOpts.setScanSpec(scanSpec);
+      rowReaderOpts.setIOExecutor(&executor);
+      auto rowReader = reader->createRowReader(rowReaderOpts);
+      assertReadWithReaderAndExpected(
+          rowType, *rowReader, expected, *leafPool_);
+    };
+
+    for (const auto pagesAhead : {0, 1, 4}) {
+      SCOPED_TRACE(fmt::format("pagesAhead: {}", pagesAhead));
+      read(pagesAhead, nullptr, data);
+      // The filter skips the pages before and after the passing rows,
+      // including pages that are decompressing ahead.
+      read(
+          pagesAhead,
+          exec::between(5'000, 5'999),
+          std::dynamic_pointer_cast<RowVector>(data->slice(5'000, 1'000)));
+    }
+  }
+}
+
 TEST_F(ParquetReaderTest, readTimeMillis) {
   // Write TIME data using the parquet writer.
   // The writer exports Velox TIME as Arrow time32 with milliseconds unit,
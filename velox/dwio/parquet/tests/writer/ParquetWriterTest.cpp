@@ -15,6 +15,7 @@
  */
 
 #include <arrow/type.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include "velox/dwio/parquet/writer/arrow/tests/TestUtil.h"
 
@@ -85,11 +86,13 @@ class ParquetWriterTest : public ParquetTestBase {
 
   thrift::PageHeader readPageHeader(
       MemorySink* sinkPtr,
-      int64_t offsetFromDataPage) {
+      int64_t offsetFromDataPage,
+      int32_t column = 0) {
     dwio::common::ReaderOptions readerOptions{leafPool_.get()};
     auto reader = createReaderInMemory(*sinkPtr, readerOptions);
 
-    auto colChunkPtr = reader->fileMetaData().rowGroup(0).columnChunk(0);
+    auto colChunkPtr =
+        reader->fileMetaData().rowGroup(0).columnChunk(column);
     std::string_view sinkData(sinkPtr->data(), sinkPtr->size());
 
     auto readFile = std::make_shared<InMemoryReadFile>(sinkData);
@@ -664,6 +667,111 @@ TEST_F(ParquetWriterTest, parquetWriteWithArrowMemoryPool) {
   write(data, writerOptions);
 }
 
+TEST_F(ParquetWriterTest, parallelColumnEncoding) {
+  constexpr int64_t kRows = 10'000;
+  const uint64_t rowsInRowGroup = 1'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row * 3; }),
+      makeFlatVector<double>(
+          kRows, [](auto row) { return row / 7.0; }, nullEvery(11)),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("s{}", row % 123); }),
+      makeArrayVector<int32_t>(
+          kRows,
+          [](auto row) { return row % 5; },
+          [](auto row) { return row; }),
+  });
+  const auto rowType = asRowType(data->type());
+
+  folly::CPUThreadPoolExecutor executor(4);
+  for (auto* columnEncodingExecutor :
+       {static_cast<folly::Executor*>(nullptr),
+        static_cast<folly::Executor*>(&executor)}) {
+    SCOPED_TRACE(
+        fmt::format("executor: {}", columnEncodingExecutor != nullptr));
+    parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = rootPool_.get();
+    writerOptions.compressionKind = CompressionKind::CompressionKind_ZSTD;
+    writerOptions.parallelColumnEncoding = true;
+    writerOptions.columnEncodingExecutor = columnEncodingExecutor;
+    writerOptions.flushPolicyFactory = [rowsInRowGroup]() {
+      return std::make_unique<DefaultFlushPolicy>(
+          rowsInRowGroup, kBytesInRowGroup);
+    };
+    auto* sinkPtr = write(data, writerOptions);
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), kRows);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), kRows / rowsInRowGroup);
+    // The column chunks of each row group are in column order.
+    for (auto i = 0; i < reader->fileMetaData().numRowGroups(); ++i) {
+      auto rowGroup = reader->fileMetaData().rowGroup(i);
+      for (auto j = 1; j < rowGroup.numColumns(); ++j) {
+        EXPECT_LT(
+            rowGroup.columnChunk(j - 1).dataPageOffset(),
+            rowGroup.columnChunk(j).dataPageOffset());
+      }
+    }
+    auto rowReader = createRowReaderWithSchema(std::move(reader), rowType);
+    assertReadWithReaderAndExpected(rowType, *rowReader, data, *leafPool_);
+  }
+}
+
+TEST_F(ParquetWriterTest, adaptiveEncoding) {
+  constexpr int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      // Sorted timestamps in milliseconds.
+      makeFlatVector<int64_t>(
+          kRows, [](auto row) { return 1'700'000'000'000 + row * 1'000; }),
+      makeFlatVector<double>(kRows, [](auto row) { return 100 + row * 0.001; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("k{}", row % 10); }),
+      makeFlatVector<std::string>(
+          kRows,
+          [](auto row) {
+            return fmt::format("https://example.com/items/{}", 100'000 + row);
+          },
+          nullEvery(13)),
+  });
+  const auto rowType = asRowType(data->type());
+
+  const auto writeAndGetEncodings = [&](bool adaptiveEncoding) {
+    parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = rootPool_.get();
+    writerOptions.compressionKind = CompressionKind::CompressionKind_ZSTD;
+    writerOptions.adaptiveEncoding = adaptiveEncoding;
+    auto* sinkPtr = write(data, writerOptions);
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto rowReader = createRowReaderWithSchema(
+        createReaderInMemory(*sinkPtr, readerOptions), rowType);
+    assertReadWithReaderAndExpected(rowType, *rowReader, data, *leafPool_);
+
+    std::vector<thrift::Encoding::type> encodings;
+    for (auto i = 0; i < rowType->size(); ++i) {
+      encodings.push_back(
+          readPageHeader(sinkPtr, 0, i).data_page_header.encoding);
+    }
+    return encodings;
+  };
+
+  EXPECT_EQ(
+      writeAndGetEncodings(true),
+      std::vector<thrift::Encoding::type>(
+          {thrift::Encoding::DELTA_BINARY_PACKED,
+           thrift::Encoding::BYTE_STREAM_SPLIT,
+           thrift::Encoding::RLE_DICTIONARY,
+           thrift::Encoding::DELTA_BYTE_ARRAY}));
+  EXPECT_EQ(
+      writeAndGetEncodings(false),
+      std::vector<thrift::Encoding::type>(
+          {thrift::Encoding::RLE_DICTIONARY,
+           thrift::Encoding::RLE_DICTIONARY,
+           thrift::Encoding::RLE_DICTIONARY,
+           thrift::Encoding::RLE_DICTIONARY}));
+}
+
 TEST_F(ParquetWriterTest, updateWriterOptionsFromHiveConfig) {
   std::unordered_map<std::string, std::string> configFromFile = {
       {config::ConfigBase::toConfigKey(
@@ -17,11 +17,15 @@
 #include "velox/dwio/parquet/writer/Writer.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <exception>
+#include <thread>
 
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
+#include <arrow/util/thread_pool.h>
 #include "velox/common/base/Pointers.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/testutil/TestValue.h"
@@ -131,9 +135,110 @@ Compression::type getArrowParquetCompression(
 
 namespace {
 
+// Arrow memory pool over a Velox leaf pool. Used for the pages that parallel
+// column encoding buffers so that they count against the writer's pool.
+// Allocation failures are returned as a Status since the allocations may be
+// made on the encoding executor threads.
+class VeloxArrowMemoryPool final : public ::arrow::MemoryPool {
+ public:
+  explicit VeloxArrowMemoryPool(memory::MemoryPool* pool) : pool_(pool) {}
+
+  ::arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out)
+      override {
+    if (size == 0) {
+      *out = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    try {
+      *out = reinterpret_cast<uint8_t*>(pool_->allocate(size, alignment));
+    } catch (const std::exception& e) {
+      return ::arrow::Status::OutOfMemory(e.what());
+    }
+    totalBytesAllocated_ += size;
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  ::arrow::Status Reallocate(
+      int64_t oldSize,
+      int64_t newSize,
+      int64_t alignment,
+      uint8_t** ptr) override {
+    uint8_t* newBuffer;
+    ARROW_RETURN_NOT_OK(Allocate(newSize, alignment, &newBuffer));
+    if (oldSize > 0 && newSize > 0) {
+      std::memcpy(newBuffer, *ptr, std::min(oldSize, newSize));
+    }
+    Free(*ptr, oldSize, alignment);
+    *ptr = newBuffer;
+    return ::arrow::Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size, int64_t /*alignment*/) override {
+    if (size > 0) {
+      pool_->free(buffer, size);
+    }
+  }
+
+  int64_t bytes_allocated() const override {
+    return pool_->usedBytes();
+  }
+
+  int64_t max_memory() const override {
+    return pool_->peakBytes();
+  }
+
+  int64_t total_bytes_allocated() const override {
+    return totalBytesAllocated_;
+  }
+
+  int64_t num_allocations() const override {
+    return numAllocations_;
+  }
+
+  std::string backend_name() const override {
+    return "velox";
+  }
+
+ private:
+  static uint8_t* zeroSizeArea() {
+    alignas(memory::MemoryAllocator::kMaxAlignment) static uint8_t area[1];
+    return area;
+  }
+
+  memory::MemoryPool* const pool_;
+  std::atomic<int64_t> totalBytesAllocated_{0};
+  std::atomic<int64_t> numAllocations_{0};
+};
+
+// Arrow executor that runs the column encoding tasks on a folly executor.
+class FollyArrowExecutor final : public ::arrow::internal::Executor {
+ public:
+  explicit FollyArrowExecutor(folly::Executor* executor)
+      : executor_(executor) {}
+
+  int GetCapacity() override {
+    return std::thread::hardware_concurrency();
+  }
+
+ protected:
+  ::arrow::Status SpawnReal(
+      ::arrow::internal::TaskHints /*hints*/,
+      ::arrow::internal::FnOnce<void()> task,
+      ::arrow::StopToken /*stopToken*/,
+      ::arrow::internal::StopCallback&& /*stopCallback*/) override {
+    executor_->add([task = std::move(task)]() mutable { std::move(task)(); });
+    return ::arrow::Status::OK();
+  }
+
+ private:
+  folly::Executor* const executor_;
+};
+
 std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     const parquet::WriterOptions& options,
-    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy) {
+    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy,
+    ::arrow::MemoryPool* encodingPool) {
   auto builder = WriterProperties::Builder();
   WriterProperties::Builder* properties = &builder;
   if (options.enableDictionary.value_or(
@@ -170,6 +275,15 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   if (options.createdBy.has_value()) {
     properties = properties->createdBy(options.createdBy.value());
   }
+  if (options.enablePageIndex.value_or(false)) {
+    properties = properties->enableWritePageIndex();
+  }
+  if (options.adaptiveEncoding.value_or(false)) {
+    properties = properties->enableAdaptiveEncoding();
+  }
+  if (encodingPool != nullptr) {
+    properties = properties->memoryPool(encodingPool);
+  }
   return properties->build();
 }
 
@@ -337,6 +451,33 @@ std::optional<bool> toParquetEnableDictionary(
   }
 }
 
+std::optional<bool> toParquetParallelColumnEncoding(
+    std::optional<std::string> parallelColumnEncoding) {
+  if (!parallelColumnEncoding) {
+    return std::nullopt;
+  }
+  try {
+    return folly::to<bool>(*parallelColumnEncoding);
+  } catch (const std::exception& e) {
+    VELOX_USER_FAIL(
+        "Invalid parquet writer parallel column encoding option: {}",
+        e.what());
+  }
+}
+
+std::optional<bool> toParquetAdaptiveEncoding(
+    std::optional<std::string> adaptiveEncoding) {
+  if (!adaptiveEncoding) {
+    return std::nullopt;
+  }
+  try {
+    return folly::to<bool>(*adaptiveEncoding);
+  } catch (const std::exception& e) {
+    VELOX_USER_FAIL(
+        "Invalid parquet writer adaptive encoding option: {}", e.what());
+  }
+}
+
 std::optional<int64_t> toParquetBatchSize(
     std::optional<std::string> batchSize) {
   if (!batchSize) {
@@ -378,11 +519,28 @@ Writer::Writer(
   options_.timestampTimeZone = options.parquetWriteTimestampTimeZone;
   common::testutil::TestValue::adjust(
       "facebook::velox::parquet::Writer::Writer", &options_);
-  arrowContext_->properties =
-      getArrowParquetWriterOptions(options, flushPolicy_);
+  arrowMemoryPool_ = options.arrowMemoryPool;
+  parallelColumnEncoding_ = options.parallelColumnEncoding.value_or(false);
+  if (parallelColumnEncoding_) {
+    // The encoded pages of a row group stay in memory until all its columns
+    // are encoded. They are allocated from the writer's pool so that the
+    // flush and spill decisions of the caller see them.
+    if (arrowMemoryPool_ == nullptr) {
+      encodingPool_ = pool_->addLeafChild(".encoding");
+      arrowMemoryPool_ =
+          std::make_shared<VeloxArrowMemoryPool>(encodingPool_.get());
+    }
+    if (options.columnEncodingExecutor != nullptr) {
+      encodingExecutor_ =
+          std::make_shared<FollyArrowExecutor>(options.columnEncodingExecutor);
+    }
+  }
+  arrowContext_->properties = getArrowParquetWriterOptions(
+      options,
+      flushPolicy_,
+      parallelColumnEncoding_ ? arrowMemoryPool_.get() : nullptr);
   setMemoryReclaimers();
   writeInt96AsTimestamp_ = options.writeInt96AsTimestamp;
-  arrowMemoryPool_ = options.arrowMemoryPool;
   parquetFieldIds_ = std::move(options.parquetFieldIds);
 }
 
@@ -406,6 +564,10 @@ void Writer::flush() {
       if (writeInt96AsTimestamp_) {
         builder.enableDeprecatedInt96Timestamps();
       }
+      if (parallelColumnEncoding_) {
+        builder.setUseThreads(true);
+        builder.setExecutor(encodingExecutor_.get());
+      }
       auto arrowProperties = builder.build();
       PARQUET_ASSIGN_OR_THROW(
           arrowContext_->writer,
@@ -564,6 +726,9 @@ void Writer::setMemoryReclaimers() {
   // TODO https://github.com/facebookincubator/velox/issues/8190
   pool_->setReclaimer(exec::MemoryReclaimer::create());
   generalPool_->setReclaimer(exec::MemoryReclaimer::create());
+  if (encodingPool_ != nullptr) {
+    encodingPool_->setReclaimer(exec::MemoryReclaimer::create());
+  }
 }
 
 bool Writer::needFlatten(const VectorPtr& data) const {
@@ -665,6 +830,18 @@ void WriterOptions::processConfigs(
         kParquetCreatedBy, connectorConfig);
   }
 
+  if (!parallelColumnEncoding) {
+    parallelColumnEncoding = toParquetParallelColumnEncoding(
+        session.getWithFallback<std::string>(
+            kParquetParallelColumnEncoding, connectorConfig));
+  }
+
+  if (!adaptiveEncoding) {
+    adaptiveEncoding =
+        toParquetAdaptiveEncoding(session.getWithFallback<std::string>(
+            kParquetAdaptiveEncoding, connectorConfig));
+  }
+
   // Parquet only updates ioStats_->rawBytesWritten() when a row group is
   // flushed. With the default flush policy (1M rows / 128MB), small
   // maxTargetFileBytes_ would never trigger rotation because rawBytesWritten()
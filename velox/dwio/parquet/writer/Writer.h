@@ -34,6 +34,10 @@
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/arrow/Bridge.h"
 
+namespace arrow::internal {
+class Executor;
+} // namespace arrow::internal
+
 namespace facebook::velox::parquet {
 
 using facebook::velox::parquet::arrow::util::CodecOptions;
@@ -135,7 +139,21 @@ struct WriterOptions : public dwio::common::WriterOptions, public WriterConfig {
   std::optional<int64_t> dictionaryPageSizeLimit;
   std::optional<bool> enableDictionary;
   std::optional<bool> useParquetDataPageV2;
+  /// Whether to write the ColumnIndex and OffsetIndex of each column chunk.
+  /// Readers use them to skip pages. Not written by default.
+  std::optional<bool> enablePageIndex;
+  /// Whether to choose the encoding of each column chunk from a sample of its
+  /// values: dictionary, PLAIN, DELTA_BINARY_PACKED, DELTA_BYTE_ARRAY or
+  /// BYTE_STREAM_SPLIT. Dictionary encoding is only chosen if enabled.
+  std::optional<bool> adaptiveEncoding;
   std::optional<std::string> createdBy;
+  /// Whether to encode and compress the column chunks of a row group in
+  /// parallel. The pages of a row group are buffered in memory until all its
+  /// columns are encoded and are then written to the file in column order.
+  std::optional<bool> parallelColumnEncoding;
+  /// Executor for parallel column encoding. Arrow's CPU thread pool is used
+  /// if not set.
+  folly::Executor* columnEncodingExecutor{nullptr};
 
   std::shared_ptr<arrow::MemoryPool> arrowMemoryPool;
 
@@ -163,6 +181,10 @@ struct WriterOptions : public dwio::common::WriterOptions, public WriterConfig {
       "hive.parquet.writer.batch_size";
   static constexpr const char* kParquetCreatedBy =
       "hive.parquet.writer.created_by";
+  static constexpr const char* kParquetParallelColumnEncoding =
+      "hive.parquet.writer.parallel_column_encoding";
+  static constexpr const char* kParquetAdaptiveEncoding =
+      "hive.parquet.writer.adaptive_encoding";
   static constexpr const char* kParquetMaxTargetFileSize =
       "max_target_file_size";
   // Serde parameter keys for timestamp settings. These can be set via
@@ -235,7 +257,14 @@ class Writer : public dwio::common::Writer {
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
+  // Pool for the pages buffered by parallel column encoding. Null if the
+  // encoding is serial or 'arrowMemoryPool' is given in the options.
+  std::shared_ptr<memory::MemoryPool> encodingPool_;
   std::shared_ptr<arrow::MemoryPool> arrowMemoryPool_;
+  // Runs the column encoding tasks on 'columnEncodingExecutor'. Null if the
+  // encoding is serial or uses Arrow's CPU thread pool.
+  std::shared_ptr<::arrow::internal::Executor> encodingExecutor_;
+  bool parallelColumnEncoding_{false};
 
   // Temporary Arrow stream for capturing the output.
   std::shared_ptr<ArrowDataBufferSink> stream_;
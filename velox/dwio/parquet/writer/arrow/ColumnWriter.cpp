@@ -44,6 +44,7 @@
 #include "velox/dwio/parquet/common/LevelConversion.h"
 #include "velox/dwio/parquet/writer/arrow/ColumnPage.h"
 #include "velox/dwio/parquet/writer/arrow/Encoding.h"
+#include "velox/dwio/parquet/writer/arrow/EncodingSelector.h"
 #include "velox/dwio/parquet/writer/arrow/Encryption.h"
 #include "velox/dwio/parquet/writer/arrow/EncryptionInternal.h"
 #include "velox/dwio/parquet/writer/arrow/FileEncryptorInternal.h"
@@ -1441,6 +1442,66 @@ static inline bool isDictionaryEncoding(Encoding::type encoding) {
   return encoding == Encoding::kPlainDictionary;
 }
 
+// Returns the encoding that 'selector' chooses for a column chunk of 'DType'
+// that starts with 'array'. Returns std::nullopt if 'array' has no non-null
+// values or its values are not stored as the physical type, e.g. int8 values
+// of an INT32 column.
+template <typename DType>
+std::optional<EncodingChoice> chooseEncoding(
+    const ::arrow::Array& array,
+    const EncodingSelector& selector) {
+  using T = typename DType::CType;
+  const auto sampleSize = std::min<int64_t>(
+      array.length(), EncodingSelector::kMaxSampleSize);
+  if constexpr (std::is_same_v<DType, ByteArrayType>) {
+    if (array.type_id() != ::arrow::Type::STRING &&
+        array.type_id() != ::arrow::Type::BINARY) {
+      return std::nullopt;
+    }
+    const auto& binaryArray =
+        checked_cast<const ::arrow::BinaryArray&>(array);
+    std::vector<std::string_view> sample;
+    sample.reserve(sampleSize);
+    for (int64_t i = 0; i < sampleSize; ++i) {
+      if (binaryArray.IsValid(i)) {
+        sample.push_back(binaryArray.GetView(i));
+      }
+    }
+    if (sample.empty()) {
+      return std::nullopt;
+    }
+    return selector.select(
+        sample.data(), static_cast<int32_t>(sample.size()));
+  } else if constexpr (
+      std::is_same_v<DType, Int32Type> || std::is_same_v<DType, Int64Type> ||
+      std::is_same_v<DType, FloatType> || std::is_same_v<DType, DoubleType>) {
+    const auto* type =
+        dynamic_cast<const ::arrow::FixedWidthType*>(array.type().get());
+    if (type == nullptr ||
+        type->bit_width() != static_cast<int>(sizeof(T) * 8) ||
+        ::arrow::is_floating(array.type_id()) !=
+            std::is_floating_point_v<T> ||
+        ::arrow::is_decimal(array.type_id())) {
+      return std::nullopt;
+    }
+    const auto* values = array.data()->GetValues<T>(1);
+    std::vector<T> sample;
+    sample.reserve(sampleSize);
+    for (int64_t i = 0; i < sampleSize; ++i) {
+      if (array.IsValid(i)) {
+        sample.push_back(values[i]);
+      }
+    }
+    if (sample.empty()) {
+      return std::nullopt;
+    }
+    return selector.select(
+        sample.data(), static_cast<int32_t>(sample.size()));
+  } else {
+    return std::nullopt;
+  }
+}
+
 template <typename DType>
 class TypedColumnWriterImpl : public ColumnWriterImpl,
                               public TypedColumnWriter<DType> {
@@ -1599,6 +1660,12 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
       ArrowWriteContext* ctx,
       bool leafFieldNullable) override {
     BEGIN_PARQUET_CATCH_EXCEPTIONS
+    if (properties_->adaptiveEncoding() && !encodingSelected_) {
+      encodingSelected_ = true;
+      if (leafArray.type_id() != ::arrow::Type::DICTIONARY) {
+        selectEncoding(leafArray);
+      }
+    }
     // Leaf nulls are canonical when there is only a single null element after
     // a list and it is at the leaf.
     bool singleNullableElement =
@@ -1732,6 +1799,8 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
   std::shared_ptr<TypedStats> pageStatistics_;
   std::shared_ptr<TypedStats> chunkStatistics_;
   bool pagesChangeOnRecordBoundaries_;
+  // True once the encoding of the column chunk is chosen from its values.
+  bool encodingSelected_{false};
 
   // If writing a sequence of ::arrow::DictionaryArray to the writer, we keep
   // the dictionary passed to DictEncoder<T>::putDictionary so we can check
@@ -1891,6 +1960,32 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
     }
   }
 
+  // Chooses the encoding of the column chunk from the values of the first
+  // array written to it. Dictionary encoding is kept only if the column chunk
+  // was created with it.
+  void selectEncoding(const ::arrow::Array& array) {
+    VELOX_DCHECK_EQ(numBufferedValues_, 0);
+    const EncodingSelector selector(
+        hasDictionary_,
+        properties_->compression(descr_->path()) != Compression::UNCOMPRESSED);
+    const auto choice = chooseEncoding<DType>(array, selector);
+    if (!choice.has_value() || choice->useDictionary ||
+        (!hasDictionary_ && choice->encoding == encoding_)) {
+      return;
+    }
+    currentEncoder_ = makeEncoder(
+        DType::typeNum,
+        choice->encoding,
+        false,
+        descr_,
+        properties_->memoryPool());
+    currentValueEncoder_ =
+        dynamic_cast<ValueEncoderType*>(currentEncoder_.get());
+    currentDictEncoder_ = nullptr;
+    hasDictionary_ = false;
+    encoding_ = choice->encoding;
+  }
+
   void fallbackToPlainEncoding() {
     if (isDictionaryEncoding(currentEncoder_->encoding())) {
       writeDictionaryPage();
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/arrow/EncodingSelector.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <folly/container/F14Set.h>
+
+namespace facebook::velox::parquet::arrow {
+
+namespace {
+
+// BYTE_STREAM_SPLIT is only chosen if its estimated compressed size is below
+// this fraction of the estimate for PLAIN.
+constexpr double kByteStreamSplitMaxRatio = 0.9;
+
+// DELTA_BYTE_ARRAY is only chosen if the values share prefixes, i.e. the
+// suffixes are below this fraction of the value bytes.
+constexpr double kDeltaByteArrayMaxSuffixRatio = 0.75;
+
+// Returns the number of bits needed for a dictionary index below 'size'.
+int32_t indexBits(int64_t size) {
+  int32_t bits = 0;
+  while (bits < 32 && (int64_t{1} << bits) < size) {
+    ++bits;
+  }
+  return bits;
+}
+
+// Returns the size of 'numValues' dictionary-encoded values with 'numDistinct'
+// distinct values that take 'distinctBytes' bytes in PLAIN encoding.
+int64_t dictionarySize(
+    int64_t numValues,
+    int64_t numDistinct,
+    int64_t distinctBytes) {
+  return distinctBytes + 1 + (numValues * indexBits(numDistinct) + 7) / 8;
+}
+
+// Returns the Shannon entropy in bits of the bytes data[0], data[stride],
+// data[2 * stride], ... data[(count - 1) * stride].
+double byteEntropy(const uint8_t* data, int64_t count, int32_t stride) {
+  std::array<int64_t, 256> counts{};
+  for (int64_t i = 0; i < count; ++i) {
+    ++counts[data[i * stride]];
+  }
+  double entropy = 0;
+  for (auto n : counts) {
+    if (n > 0) {
+      const double p = static_cast<double>(n) / count;
+      entropy -= p * std::log2(p);
+    }
+  }
+  return entropy;
+}
+
+// Returns the estimated compressed size of 'numValues' floating point values
+// in PLAIN and BYTE_STREAM_SPLIT encoding. The entropy of all bytes is used
+// for PLAIN and the entropy of each byte position for BYTE_STREAM_SPLIT.
+template <typename T>
+std::pair<double, double> floatingPointCompressedSizes(
+    const T* values,
+    int32_t numValues) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(values);
+  const int64_t numBytes = static_cast<int64_t>(numValues) * sizeof(T);
+  const double plain = numBytes * byteEntropy(bytes, numBytes, 1) / 8;
+  double byteStreamSplit = 0;
+  for (int32_t i = 0; i < static_cast<int32_t>(sizeof(T)); ++i) {
+    byteStreamSplit +=
+        numValues * byteEntropy(bytes + i, numValues, sizeof(T)) / 8;
+  }
+  return {plain, byteStreamSplit};
+}
+
+// Returns the bits of 'value' as an unsigned integer so that NaNs and
+// negative zero are distinct from other values.
+template <typename T>
+auto toBits(T value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    return bits;
+  } else {
+    return value;
+  }
+}
+
+} // namespace
+
+// static
+template <typename T>
+int64_t EncodingSelector::deltaBinaryPackedSize(
+    const T* values,
+    int32_t numValues) {
+  static_assert(std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>);
+  using U = std::make_unsigned_t<T>;
+  // Matches the block sizes of DeltaBitPackEncoder.
+  constexpr int32_t kValuesPerBlock = std::is_same_v<T, int32_t> ? 128 : 256;
+  constexpr int32_t kValuesPerMiniBlock = kValuesPerBlock / 4;
+  // Block size, number of miniblocks, number of values and first value.
+  constexpr int64_t kHeaderSize = 2 + 1 + 5 + 10;
+  // Minimum delta and the bit widths of the miniblocks.
+  constexpr int64_t kBlockHeaderSize = 10 + 4;
+  constexpr int32_t kMaxWidth = sizeof(U) * 8;
+
+  int64_t size = kHeaderSize;
+  std::array<T, kValuesPerBlock> deltas;
+  for (int32_t begin = 1; begin < numValues; begin += kValuesPerBlock) {
+    const int32_t end = std::min(begin + kValuesPerBlock, numValues);
+    T minDelta = std::numeric_limits<T>::max();
+    for (auto i = begin; i < end; ++i) {
+      // Deltas wrap around like in the encoder.
+      deltas[i - begin] = static_cast<T>(
+          static_cast<U>(values[i]) - static_cast<U>(values[i - 1]));
+      minDelta = std::min(minDelta, deltas[i - begin]);
+    }
+    size += kBlockHeaderSize;
+    for (auto miniBegin = begin; miniBegin < end;
+         miniBegin += kValuesPerMiniBlock) {
+      const auto miniEnd = std::min(miniBegin + kValuesPerMiniBlock, end);
+      U maxOffset = 0;
+      for (auto i = miniBegin; i < miniEnd; ++i) {
+        maxOffset = std::max(
+            maxOffset,
+            static_cast<U>(
+                static_cast<U>(deltas[i - begin]) -
+                static_cast<U>(minDelta)));
+      }
+      int32_t width = 0;
+      while (width < kMaxWidth && (maxOffset >> width) != 0) {
+        ++width;
+      }
+      // Miniblocks are padded to their full size.
+      size += width * kValuesPerMiniBlock / 8;
+    }
+  }
+  return size;
+}
+
+template <typename T>
+EncodingChoice EncodingSelector::select(const T* values, int32_t numValues)
+    const {
+  folly::F14FastSet<decltype(toBits(T()))> distinct;
+  for (auto i = 0; i < numValues; ++i) {
+    distinct.insert(toBits(values[i]));
+  }
+  const int64_t plainSize = static_cast<int64_t>(numValues) * sizeof(T);
+  const int64_t dictSize =
+      dictionarySize(numValues, distinct.size(), distinct.size() * sizeof(T));
+
+  if constexpr (std::is_floating_point_v<T>) {
+    if (compressed_) {
+      const auto [plain, byteStreamSplit] =
+          floatingPointCompressedSizes(values, numValues);
+      if (byteStreamSplit < kByteStreamSplitMaxRatio * plain) {
+        return chooseDictionary(
+            dictSize, plainSize, Encoding::kByteStreamSplit);
+      }
+    }
+    return chooseDictionary(dictSize, plainSize, Encoding::kPlain);
+  } else {
+    const int64_t deltaSize = deltaBinaryPackedSize(values, numValues);
+    if (deltaSize < plainSize) {
+      return chooseDictionary(
+          dictSize, deltaSize, Encoding::kDeltaBinaryPacked);
+    }
+    return chooseDictionary(dictSize, plainSize, Encoding::kPlain);
+  }
+}
+
+EncodingChoice EncodingSelector::select(
+    const std::string_view* values,
+    int32_t numValues) const {
+  folly::F14FastSet<std::string_view> distinct;
+  int64_t distinctBytes = 0;
+  int64_t plainSize = 0;
+  int64_t valueBytes = 0;
+  int64_t suffixBytes = 0;
+  std::vector<int32_t> prefixLengths(numValues);
+  std::vector<int32_t> suffixLengths(numValues);
+  for (auto i = 0; i < numValues; ++i) {
+    const auto value = values[i];
+    if (distinct.insert(value).second) {
+      distinctBytes += sizeof(int32_t) + value.size();
+    }
+    plainSize += sizeof(int32_t) + value.size();
+    valueBytes += value.size();
+
+    int32_t prefix = 0;
+    if (i > 0) {
+      const auto previous = values[i - 1];
+      const int32_t maxPrefix = std::min(previous.size(), value.size());
+      while (prefix < maxPrefix && previous[prefix] == value[prefix]) {
+        ++prefix;
+      }
+    }
+    prefixLengths[i] = prefix;
+    suffixLengths[i] = value.size() - prefix;
+    suffixBytes += value.size() - prefix;
+  }
+  const int64_t dictSize =
+      dictionarySize(numValues, distinct.size(), distinctBytes);
+  const int64_t deltaSize = suffixBytes +
+      deltaBinaryPackedSize(prefixLengths.data(), numValues) +
+      deltaBinaryPackedSize(suffixLengths.data(), numValues);
+  if (deltaSize < plainSize &&
+      suffixBytes < kDeltaByteArrayMaxSuffixRatio * valueBytes) {
+    return chooseDictionary(dictSize, deltaSize, Encoding::kDeltaByteArray);
+  }
+  return chooseDictionary(dictSize, plainSize, Encoding::kPlain);
+}
+
+EncodingChoice EncodingSelector::chooseDictionary(
+    int64_t dictionarySize,
+    int64_t otherSize,
+    Encoding::type other) const {
+  if (dictionaryAllowed_ && dictionarySize < otherSize) {
+    return {true, other};
+  }
+  return {false, other};
+}
+
+template EncodingChoice EncodingSelector::select(
+    const int32_t* values,
+    int32_t numValues) const;
+template EncodingChoice EncodingSelector::select(
+    const int64_t* values,
+    int32_t numValues) const;
+template EncodingChoice EncodingSelector::select(
+    const float* values,
+    int32_t numValues) const;
+template EncodingChoice EncodingSelector::select(
+    const double* values,
+    int32_t numValues) const;
+template int64_t EncodingSelector::deltaBinaryPackedSize(
+    const int32_t* values,
+    int32_t numValues);
+template int64_t EncodingSelector::deltaBinaryPackedSize(
+    const int64_t* values,
+    int32_t numValues);
+
+} // namespace facebook::velox::parquet::arrow
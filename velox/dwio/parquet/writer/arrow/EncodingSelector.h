@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "velox/dwio/parquet/writer/arrow/Types.h"
+
+namespace facebook::velox::parquet::arrow {
+
+/// The encoding chosen for a column chunk.
+struct EncodingChoice {
+  bool useDictionary;
+  /// Encoding of the values. Only meaningful if 'useDictionary' is false.
+  Encoding::type encoding;
+};
+
+/// Chooses the encoding of a column chunk from a sample of its first non-null
+/// values. The encoded size of the sample is estimated for dictionary, PLAIN
+/// and the delta or byte stream split encoding that applies to the type, and
+/// the smallest is chosen:
+///
+/// - Integers use DELTA_BINARY_PACKED when the deltas are narrower than the
+///   values, e.g. for sorted timestamps or ids.
+/// - Strings use DELTA_BYTE_ARRAY when consecutive values share prefixes.
+/// - Floating point values use BYTE_STREAM_SPLIT when the pages are
+///   compressed and the per-byte streams have lower entropy than the values.
+///   BYTE_STREAM_SPLIT does not make the values smaller by itself.
+///
+/// Dictionary encoding is chosen when the dictionary and the indices are
+/// smaller than the best of the other encodings.
+class EncodingSelector {
+ public:
+  /// Maximum number of values sampled from the start of a column chunk.
+  static constexpr int32_t kMaxSampleSize = 1'024;
+
+  /// @param dictionaryAllowed Whether dictionary encoding may be chosen.
+  /// @param compressed Whether the pages of the column chunk are compressed.
+  EncodingSelector(bool dictionaryAllowed, bool compressed)
+      : dictionaryAllowed_(dictionaryAllowed), compressed_(compressed) {}
+
+  /// Returns the encoding for a column chunk that starts with 'values'. T is
+  /// int32_t, int64_t, float or double.
+  template <typename T>
+  EncodingChoice select(const T* values, int32_t numValues) const;
+
+  EncodingChoice select(const std::string_view* values, int32_t numValues)
+      const;
+
+  /// Returns the size in bytes of 'values' in DELTA_BINARY_PACKED encoding
+  /// with the block and miniblock sizes of the writer.
+  template <typename T>
+  static int64_t deltaBinaryPackedSize(const T* values, int32_t numValues);
+
+ private:
+  // Returns the dictionary choice if dictionary encoding is allowed and
+  // 'dictionarySize' is less than 'otherSize'. Otherwise returns 'other'.
+  EncodingChoice chooseDictionary(
+      int64_t dictionarySize,
+      int64_t otherSize,
+      Encoding::type other) const;
+
+  const bool dictionaryAllowed_;
+  const bool compressed_;
+};
+
+} // namespace facebook::velox::parquet::arrow
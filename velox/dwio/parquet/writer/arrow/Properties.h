@@ -327,7 +327,8 @@ class PARQUET_EXPORT WriterProperties {
           createdBy_(
               DEFAULT_CREATED_BY + std::string(" version ") + VELOX_VERSION),
           storeDecimalAsInteger_(false),
-          pageChecksumEnabled_(false) {}
+          pageChecksumEnabled_(false),
+          adaptiveEncoding_(false) {}
     virtual ~Builder() {}
 
     /// Specify the memory pool for the writer. Default default_memory_pool.
@@ -685,6 +686,25 @@ class PARQUET_EXPORT WriterProperties {
       return this;
     }
 
+    /// Enable choosing the encoding of each column chunk from a sample of
+    /// its first values. Dictionary, PLAIN, DELTA_BINARY_PACKED,
+    /// DELTA_BYTE_ARRAY and BYTE_STREAM_SPLIT are considered. Dictionary
+    /// encoding is only chosen for the columns that have it enabled.
+    ///
+    /// Default disabled.
+    Builder* enableAdaptiveEncoding() {
+      adaptiveEncoding_ = true;
+      return this;
+    }
+
+    /// Disable choosing the encoding of each column chunk from its values.
+    ///
+    /// Default disabled.
+    Builder* disableAdaptiveEncoding() {
+      adaptiveEncoding_ = false;
+      return this;
+    }
+
     /// Enable writing page index in general for all columns. Default
     /// disabled.
     ///
@@ -775,7 +795,8 @@ class PARQUET_EXPORT WriterProperties {
           columnProperties,
           dataPageVersion_,
           storeDecimalAsInteger_,
-          std::move(sortingColumns_)));
+          std::move(sortingColumns_),
+          adaptiveEncoding_));
     }
 
    private:
@@ -789,6 +810,7 @@ class PARQUET_EXPORT WriterProperties {
     std::string createdBy_;
     bool storeDecimalAsInteger_;
     bool pageChecksumEnabled_;
+    bool adaptiveEncoding_;
 
     std::shared_ptr<FileEncryptionProperties> fileEncryptionProperties_;
 
@@ -847,6 +869,10 @@ class PARQUET_EXPORT WriterProperties {
     return pageChecksumEnabled_;
   }
 
+  inline bool adaptiveEncoding() const {
+    return adaptiveEncoding_;
+  }
+
   inline Encoding::type dictionaryIndexEncoding() const {
     if (parquetVersion_ == ParquetVersion::PARQUET_1_0) {
       return Encoding::kPlainDictionary;
@@ -953,7 +979,8 @@ class PARQUET_EXPORT WriterProperties {
       const std::unordered_map<std::string, ColumnProperties>& columnProperties,
       ParquetDataPageVersion dataPageVersion,
       bool storeShortDecimalAsInteger,
-      std::vector<SortingColumn> sortingColumns)
+      std::vector<SortingColumn> sortingColumns,
+      bool adaptiveEncoding)
       : pool_(pool),
         dictionaryPagesizeLimit_(dictionaryPagesizeLimit),
         writeBatchSize_(writeBatchSize),
@@ -964,6 +991,7 @@ class PARQUET_EXPORT WriterProperties {
         parquetCreatedBy_(createdBy),
         storeDecimalAsInteger_(storeShortDecimalAsInteger),
         pageChecksumEnabled_(pageWriteChecksumEnabled),
+        adaptiveEncoding_(adaptiveEncoding),
         fileEncryptionProperties_(std::move(fileEncryptionProperties)),
         sortingColumns_(std::move(sortingColumns)),
         defaultColumnProperties_(defaultColumnProperties),
@@ -979,6 +1007,7 @@ class PARQUET_EXPORT WriterProperties {
   std::string parquetCreatedBy_;
   bool storeDecimalAsInteger_;
   bool pageChecksumEnabled_;
+  bool adaptiveEncoding_;
 
   std::shared_ptr<FileEncryptionProperties> fileEncryptionProperties_;
 
@@ -408,6 +408,9 @@ class FileWriterImpl : public FileWriter {
     }
 
     auto writeRowGroup = [&](int64_t offset, int64_t size) {
+      if (arrowProperties_->useThreads()) {
+        return writeBufferedRowGroup(table, offset, size);
+      }
       RETURN_NOT_OK(newRowGroup(size));
       for (int i = 0; i < table.num_columns(); i++) {
         RETURN_NOT_OK(writeColumnChunk(table.column(i), offset, size));
@@ -430,6 +433,38 @@ class FileWriterImpl : public FileWriter {
     return Status::OK();
   }
 
+  // Writes rows [offset, offset + size) of 'table' into a new buffered row
+  // group. The column chunks are encoded and compressed in parallel on the
+  // executor of 'arrowProperties_'. The buffered pages are written to the
+  // sink in column order when the row group is closed.
+  Status
+  writeBufferedRowGroup(const Table& table, int64_t offset, int64_t size) {
+    RETURN_NOT_OK(newBufferedRowGroup());
+    std::vector<std::unique_ptr<ArrowColumnWriterV2>> writers;
+    writers.reserve(table.num_columns());
+    int columnIndexStart = 0;
+    for (int i = 0; i < table.num_columns(); i++) {
+      ARROW_ASSIGN_OR_RAISE(
+          std::unique_ptr<ArrowColumnWriterV2> writer,
+          ArrowColumnWriterV2::make(
+              *table.column(i),
+              offset,
+              size,
+              schemaManifest_,
+              rowGroupWriter_,
+              columnIndexStart));
+      columnIndexStart += writer->leafCount();
+      writers.emplace_back(std::move(writer));
+    }
+    VELOX_DCHECK_EQ(parallelColumnWriteContexts_.size(), writers.size());
+    return ::arrow::internal::ParallelFor(
+        static_cast<int>(writers.size()),
+        [&](int i) {
+          return writers[i]->write(&parallelColumnWriteContexts_[i]);
+        },
+        arrowProperties_->executor());
+  }
+
   Status newBufferedRowGroup() override {
     if (rowGroupWriter_ != nullptr) {
       PARQUET_CATCH_NOT_OK(rowGroupWriter_->close());
@@ -19,7 +19,9 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <string>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/encode/Base64.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/common/exception/Exceptions.h"
 #include "velox/type/fbhive/HiveTypeParser.h"
 
@@ -120,6 +122,90 @@ void setCompressionSettings(
   }
 }
 
+// Finds the bytes of a text buffer that end a field or a line or need the
+// byte at a time parser, i.e. separators, '\n', '\r' and escape characters.
+// As in simdcsv, a SIMD register of bytes is compared at a time and the
+// matches are returned in order from the bit mask of the register.
+class FieldEndFinder {
+ public:
+  FieldEndFinder(
+      std::string_view data,
+      size_t begin,
+      uint8_t separator,
+      std::optional<uint8_t> escapeChar)
+      : data_{data},
+        separator_{separator},
+        escapeChar_{escapeChar.value_or('\n')},
+        blockBegin_{begin} {
+    classifyBlock();
+  }
+
+  // Returns the index of the next byte of interest or the size of the buffer
+  // if there is none.
+  size_t next() {
+    while (mask_ == 0) {
+      if (blockBegin_ + kBlockSize >= data_.size()) {
+        return data_.size();
+      }
+      blockBegin_ += kBlockSize;
+      classifyBlock();
+    }
+    const auto index = blockBegin_ + __builtin_ctzll(mask_);
+    mask_ &= mask_ - 1;
+    return index;
+  }
+
+ private:
+  using Batch = xsimd::batch<uint8_t>;
+  static constexpr size_t kBlockSize = Batch::size;
+  static_assert(kBlockSize <= 64);
+
+  bool isFieldEnd(uint8_t c) const {
+    return c == separator_ || c == '\n' || c == '\r' || c == escapeChar_;
+  }
+
+  void classifyBlock() {
+    mask_ = 0;
+    if (blockBegin_ + kBlockSize <= data_.size()) {
+      const auto bytes = Batch::load_unaligned(
+          reinterpret_cast<const uint8_t*>(data_.data() + blockBegin_));
+      const auto matches = (bytes == xsimd::broadcast<uint8_t>(separator_)) |
+          (bytes == xsimd::broadcast<uint8_t>('\n')) |
+          (bytes == xsimd::broadcast<uint8_t>('\r')) |
+          (bytes == xsimd::broadcast<uint8_t>(escapeChar_));
+      mask_ = static_cast<uint32_t>(simd::toBitMask(matches));
+      return;
+    }
+    for (auto i = blockBegin_; i < data_.size(); ++i) {
+      if (isFieldEnd(static_cast<uint8_t>(data_[i]))) {
+        mask_ |= 1ULL << (i - blockBegin_);
+      }
+    }
+  }
+
+  const std::string_view data_;
+  const uint8_t separator_;
+  const uint8_t escapeChar_;
+  // Index of the first byte of the register in 'mask_'.
+  size_t blockBegin_;
+  // A bit for each byte of interest in the register that is not returned yet.
+  uint64_t mask_;
+};
+
+// Returns the decimal with 'precision' and 'scale' in 's' or std::nullopt if
+// 's' is not a valid decimal.
+template <typename T>
+std::optional<T>
+parseDecimal(const std::string& s, uint8_t precision, uint8_t scale) {
+  T v = 0;
+  const auto status = DecimalUtil::castFromString(
+      StringView(s.data(), static_cast<int32_t>(s.size())),
+      precision,
+      scale,
+      v);
+  return status.ok() ? std::optional<T>(v) : std::nullopt;
+}
+
 } // namespace
 
 FileContents::FileContents(
@@ -193,15 +279,25 @@ TextRowReader::TextRowReader(
     }
     limit_ = std::numeric_limits<uint64_t>::max();
 
+    // An estimated value used as the output buffer size for the zlib
+    // decompressor, and as the fallback value of the decompressed length
+    // for other decompressors.
+    uint64_t blockSize = kDecompressionBufferFactor * contents_->fileLength;
+    // Only zlib decompresses a block at a time. The other decompressors
+    // decompress the whole file at once.
+    if (contents_->decompressionBlockSize > 0 &&
+        (contents_->compression == CompressionKind::CompressionKind_ZLIB ||
+         contents_->compression == CompressionKind::CompressionKind_GZIP)) {
+      blockSize = contents_->decompressionBlockSize;
+      decompressionExecutor_ = opts.ioExecutor();
+    }
+
     contents_->inputStream = contents_->input->loadCompleteFile();
     auto name = contents_->inputStream->getName();
     contents_->decompressedInputStream = createDecompressor(
         contents_->compression,
         std::move(contents_->inputStream),
-        // An estimated value used as the output buffer size for the zlib
-        // decompressor, and as the fallback value of the decompressed length
-        // for other decompressors.
-        kDecompressionBufferFactor * contents_->fileLength,
+        blockSize,
         contents_->pool,
         contents_->compressionOptions,
         fmt::format("Text Reader: Stream {}", name),
@@ -215,6 +311,12 @@ TextRowReader::TextRowReader(
   }
 }
 
+TextRowReader::~TextRowReader() {
+  if (blockAhead_ != nullptr) {
+    blockAhead_->close();
+  }
+}
+
 uint64_t TextRowReader::next(
     uint64_t rows,
     VectorPtr& result,
@@ -244,52 +346,67 @@ uint64_t TextRowReader::next(
   auto rowVecPtr = BaseVector::create<RowVector>(
       reqT->type(), (vector_size_t)rows, &contents_->pool);
 
+  // The vectors the columns of the file are read into. The columns after the
+  // last requested one are not read and a nullptr vector is parsed but not
+  // read.
+  std::vector<BaseVector*> columns;
+  uint64_t colIndex = 0;
+  for (vector_size_t i = 0; i < childCount; i++) {
+    if (colIndex >= reqT->size()) {
+      break;
+    }
+
+    const auto& ct = t->childAt(i);
+    BaseVector* childVector = nullptr;
+
+    if (isSelectedField(ct)) {
+      childVector = rowVecPtr->childAt(i).get();
+      ++colIndex;
+    } else if (colIndex < reqChildCount && !projectSelectedType) {
+      // Not selected and not projecting: discard the child by setting it to
+      // nullptr. The projectColumns() function will later filter out unneeded
+      // columns based on the ScanSpec.
+      rowVecPtr->childAt(i) = nullptr;
+      ++colIndex;
+    } else {
+      // Not selected and projecting: discard the child. Same reasoning as
+      // above.
+      rowVecPtr->childAt(i) = nullptr;
+    }
+    columns.push_back(childVector);
+  }
+  const bool tokenize = canTokenize(*t, columns.size());
+
   vector_size_t rowsRead = 0;
   const auto initialPos = pos_;
   while (!atEOF_ && rowsRead < rows) {
-    resetLine();
-    uint64_t colIndex = 0;
-    for (vector_size_t i = 0; i < childCount; i++) {
-      if (colIndex >= reqT->size()) {
+    if (tokenize) {
+      // Read the complete lines in the buffer a column at a time and the line
+      // that continues in the next buffer or needs unescaping byte by byte.
+      rowsRead +=
+          readTokenizedRows(*t, *reqT, columns, rowsRead, rows - rowsRead);
+      if (atEOF_ || rowsRead == rows) {
         break;
       }
+    }
 
+    resetLine();
+    for (vector_size_t i = 0; i < columns.size(); i++) {
       DelimType delim = DelimTypeNone;
-      const auto& ct = t->childAt(i);
-      const auto& rct = reqT->childAt(i);
-      BaseVector* childVector = nullptr;
-
-      if (isSelectedField(ct)) {
-        childVector = rowVecPtr->childAt(i).get();
-        ++colIndex;
-      } else if (colIndex < reqChildCount && !projectSelectedType) {
-        // Not selected and not projecting: discard the child by setting it to
-        // nullptr. The projectColumns() function will later filter out unneeded
-        // columns based on the ScanSpec.
-        rowVecPtr->childAt(i) = nullptr;
-        ++colIndex;
-      } else {
-        // Not selected and projecting: discard the child. Same reasoning as
-        // above.
-        rowVecPtr->childAt(i) = nullptr;
-      }
-
-      resizeVector(childVector, rowsRead);
-      readElement(ct->type(), rct->type(), childVector, rowsRead, delim);
+      resizeVector(columns[i], rowsRead);
+      readElement(
+          t->childAt(i)->type(),
+          reqT->childAt(i)->type(),
+          columns[i],
+          rowsRead,
+          delim);
     }
 
     (void)skipLine();
     ++currentRow_;
     ++rowsRead;
 
-    bool eof = false;
-    if (contents_->compression == CompressionKind::CompressionKind_NONE) {
-      eof = pos_ >= getLength();
-    } else if (atPhysicalEOF_) {
-      eof = pos_ >= contents_->decompressedInputStream->ByteCount();
-    }
-
-    if (eof) {
+    if (pos_ >= getDataEnd()) {
       setEOF();
     }
 
@@ -382,6 +499,62 @@ uint64_t TextRowReader::getStreamLength() const {
   return contents_->input->getInputStream()->getLength();
 }
 
+uint64_t TextRowReader::getDataEnd() {
+  if (contents_->compression == CompressionKind::CompressionKind_NONE) {
+    return getLength();
+  }
+  if (atPhysicalEOF_) {
+    return contents_->decompressedInputStream->ByteCount();
+  }
+  return std::numeric_limits<uint64_t>::max();
+}
+
+void TextRowReader::preloadDecompressedData() {
+  if (contents_->compression == CompressionKind::CompressionKind_NONE ||
+      !preLoadedUnreadData_.empty()) {
+    return;
+  }
+  if (blockAhead_ == nullptr) {
+    int length = 0;
+    const void* buffer = nullptr;
+    atPhysicalEOF_ =
+        !contents_->decompressedInputStream->Next(&buffer, &length);
+    if (!atPhysicalEOF_) {
+      preLoadedUnreadData_ =
+          std::string_view(reinterpret_cast<const char*>(buffer), length);
+    }
+    if (decompressionExecutor_ != nullptr) {
+      preLoadedBlock_.assign(preLoadedUnreadData_);
+      preLoadedUnreadData_ = preLoadedBlock_;
+    }
+  } else {
+    auto block = blockAhead_->move();
+    blockAhead_.reset();
+    VELOX_CHECK_NOT_NULL(block);
+    atPhysicalEOF_ = block->atEnd;
+    preLoadedBlock_ = std::move(block->data);
+    preLoadedUnreadData_ = preLoadedBlock_;
+  }
+  if (decompressionExecutor_ != nullptr && !atPhysicalEOF_) {
+    decompressAhead();
+  }
+}
+
+void TextRowReader::decompressAhead() {
+  blockAhead_ = std::make_shared<AsyncSource<DecompressedBlock>>(
+      [stream = contents_->decompressedInputStream.get()]() {
+        auto block = std::make_unique<DecompressedBlock>();
+        int length = 0;
+        const void* buffer = nullptr;
+        block->atEnd = !stream->Next(&buffer, &length);
+        if (!block->atEnd) {
+          block->data.assign(reinterpret_cast<const char*>(buffer), length);
+        }
+        return block;
+      });
+  decompressionExecutor_->add([source = blockAhead_]() { source->prepare(); });
+}
+
 void TextRowReader::setEOF() {
   atEOF_ = true;
   atEOL_ = true;
@@ -603,17 +776,7 @@ char TextRowReader::getByteUncheckedOptimized(DelimType& delim) {
 
   try {
     char v;
-    if (contents_->compression != CompressionKind::CompressionKind_NONE &&
-        preLoadedUnreadData_.empty()) {
-      int length = 0;
-      const void* buffer = nullptr;
-      atPhysicalEOF_ =
-          !contents_->decompressedInputStream->Next(&buffer, &length);
-      if (!atPhysicalEOF_) {
-        preLoadedUnreadData_ =
-            std::string_view(reinterpret_cast<const char*>(buffer), length);
-      }
-    }
+    preloadDecompressedData();
 
     if (unreadData_.empty() || unreadIdx_ >= unreadData_.size()) {
       bool updated = false;
@@ -742,8 +905,11 @@ void TextRowReader::resetLine() {
 
 template <typename T>
 T TextRowReader::getInteger(TextRowReader& th, bool& isNull, DelimType& delim) {
-  const std::string& str = getString(th, isNull, delim);
+  return parseInteger<T>(getString(th, isNull, delim), isNull);
+}
 
+template <typename T>
+T TextRowReader::parseInteger(std::string& str, bool& isNull) {
   if (str.empty()) {
     isNull = true;
   }
@@ -801,7 +967,10 @@ bool TextRowReader::getBoolean(
     TextRowReader& th,
     bool& isNull,
     DelimType& delim) {
-  const std::string& str = getString(th, isNull, delim);
+  return parseBoolean(getString(th, isNull, delim), isNull);
+}
+
+bool TextRowReader::parseBoolean(std::string& str, bool& isNull) {
   if (str.empty()) {
     isNull = true;
   }
@@ -894,7 +1063,10 @@ float TextRowReader::getFloat(
     TextRowReader& th,
     bool& isNull,
     DelimType& delim) {
-  std::string& str = getString(th, isNull, delim);
+  return parseFloat(getString(th, isNull, delim), isNull);
+}
+
+float TextRowReader::parseFloat(std::string& str, bool& isNull) {
   if (str.empty()) {
     isNull = true;
   }
@@ -905,8 +1077,7 @@ float TextRowReader::getFloat(
   trimStringInPlace(str);
 
   if (str.data()[0] == '.') {
-    th.ownedString_.insert(th.ownedString_.begin(), '0');
-    str = th.ownedString_;
+    str.insert(str.begin(), '0');
   }
 
   if (unacceptableFloatingPoint(str)) {
@@ -928,7 +1099,10 @@ float TextRowReader::getFloat(
 
 double
 TextRowReader::getDouble(TextRowReader& th, bool& isNull, DelimType& delim) {
-  std::string& str = getString(th, isNull, delim);
+  return parseDouble(getString(th, isNull, delim), isNull);
+}
+
+double TextRowReader::parseDouble(std::string& str, bool& isNull) {
   if (str.empty()) {
     isNull = true;
   }
@@ -940,8 +1114,7 @@ TextRowReader::getDouble(TextRowReader& th, bool& isNull, DelimType& delim) {
   trimStringInPlace(str);
 
   if (str.data()[0] == '.') {
-    th.ownedString_.insert(th.ownedString_.begin(), '0');
-    str = th.ownedString_;
+    str.insert(str.begin(), '0');
   }
 
   // Filter out values from non-warehouse sources which
@@ -1019,14 +1192,8 @@ void TextRowReader::readElement(
             str,
             data,
             insertionRow,
-            [precision, scale](const std::string& s) -> std::optional<int64_t> {
-              int64_t v = 0;
-              const auto status = DecimalUtil::castFromString(
-                  StringView(s.data(), static_cast<int32_t>(s.size())),
-                  precision,
-                  scale,
-                  v);
-              return status.ok() ? std::optional<int64_t>(v) : std::nullopt;
+            [precision, scale](const std::string& s) {
+              return parseDecimal<int64_t>(s, precision, scale);
             });
       } else {
         putValue<int64_t, int64_t>(
@@ -1044,15 +1211,8 @@ void TextRowReader::readElement(
             str,
             data,
             insertionRow,
-            [precision,
-             scale](const std::string& s) -> std::optional<int128_t> {
-              int128_t v = 0;
-              const auto status = DecimalUtil::castFromString(
-                  StringView(s.data(), static_cast<int32_t>(s.size())),
-                  precision,
-                  scale,
-                  v);
-              return status.ok() ? std::optional<int128_t>(v) : std::nullopt;
+            [precision, scale](const std::string& s) {
+              return parseDecimal<int128_t>(s, precision, scale);
             });
       } else {
         setValueFromString<int128_t>(
@@ -1527,6 +1687,393 @@ void TextRowReader::putValue(
   flatVector->set(insertionRow, v);
 }
 
+bool TextRowReader::canTokenize(const TypeWithId& type, size_t numColumns)
+    const {
+  for (size_t i = 0; i < numColumns; ++i) {
+    switch (type.childAt(i)->type()->kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::HUGEINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+      case TypeKind::TIMESTAMP:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+vector_size_t TextRowReader::readTokenizedRows(
+    const TypeWithId& type,
+    const TypeWithId& reqType,
+    const std::vector<BaseVector*>& columns,
+    vector_size_t firstRow,
+    vector_size_t maxRows) {
+  // The end of a compressed stream is only known once the next buffer is
+  // preloaded, which is left to the byte at a time parser.
+  if (unreadIdx_ >= unreadData_.size() ||
+      (contents_->compression != CompressionKind::CompressionKind_NONE &&
+       preLoadedUnreadData_.empty() && !atPhysicalEOF_)) {
+    return 0;
+  }
+
+  size_t end = 0;
+  bool atEnd = false;
+  const auto numRows = tokenizeRows(columns.size(), maxRows, end, atEnd);
+  if (numRows == 0) {
+    return 0;
+  }
+
+  // VARCHAR values reference a copy of the lines instead of being copied one
+  // by one.
+  BufferPtr strings;
+  std::vector<size_t> readColumns;
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (columns[i] == nullptr) {
+      continue;
+    }
+    readColumns.push_back(i);
+    if (!strings && type.childAt(i)->type()->kind() == TypeKind::VARCHAR) {
+      strings =
+          AlignedBuffer::allocate<char>(end - unreadIdx_, &contents_->pool);
+      memcpy(
+          strings->asMutable<char>(),
+          unreadData_.data() + unreadIdx_,
+          end - unreadIdx_);
+    }
+  }
+
+  dwio::common::ParallelFor(
+      options_.decodingExecutor(),
+      0,
+      readColumns.size(),
+      options_.decodingParallelismFactor())
+      .execute([&](size_t i) {
+        const auto column = readColumns[i];
+        convertColumn(
+            *type.childAt(column)->type(),
+            *reqType.childAt(column)->type(),
+            *columns[column],
+            column,
+            columns.size(),
+            firstRow,
+            numRows,
+            strings);
+      });
+
+  pos_ += end - unreadIdx_;
+  unreadIdx_ = end;
+  currentRow_ += numRows;
+  atSOL_ = false;
+  atEOL_ = true;
+  if (atEnd) {
+    setEOF();
+  }
+  return numRows;
+}
+
+vector_size_t TextRowReader::tokenizeRows(
+    size_t numColumns,
+    vector_size_t maxRows,
+    size_t& end,
+    bool& atEnd) {
+  const auto& serDeOptions = contents_->serDeOptions;
+  const uint8_t separator = serDeOptions.separators.at(0);
+  const std::string_view data{unreadData_};
+  FieldEndFinder finder{
+      data,
+      static_cast<size_t>(unreadIdx_),
+      separator,
+      serDeOptions.isEscaped
+          ? std::optional<uint8_t>(serDeOptions.escapeChar)
+          : std::nullopt};
+  const auto dataEnd = getDataEnd();
+
+  fields_.clear();
+  end = unreadIdx_;
+  atEnd = false;
+  vector_size_t numRows = 0;
+  size_t fieldBegin = unreadIdx_;
+  size_t column = 0;
+  while (numRows < maxRows) {
+    auto index = finder.next();
+    if (index == data.size()) {
+      // The line continues in the next buffer.
+      break;
+    }
+    const auto fieldEnd = index;
+    const auto c = static_cast<uint8_t>(data[index]);
+    // The bytes are checked in the order of getByteOptimized(),
+    // getDelimType() and getString().
+    if (c == '\r') {
+      // "\r\n" ends a line like '\n'. Other uses of '\r' are left to the byte
+      // at a time parser.
+      if (index + 1 == data.size() || data[index + 1] != '\n') {
+        break;
+      }
+      index = finder.next();
+    } else if (c != '\n') {
+      if (c != separator) {
+        // An escape character.
+        break;
+      }
+      if (column < numColumns) {
+        fields_.push_back(
+            {static_cast<int32_t>(fieldBegin),
+             static_cast<int32_t>(fieldEnd - fieldBegin)});
+        ++column;
+      }
+      fieldBegin = index + 1;
+      continue;
+    }
+
+    if (column < numColumns) {
+      fields_.push_back(
+          {static_cast<int32_t>(fieldBegin),
+           static_cast<int32_t>(fieldEnd - fieldBegin)});
+      ++column;
+    }
+    for (; column < numColumns; ++column) {
+      fields_.push_back({0, -1});
+    }
+    column = 0;
+    ++numRows;
+    end = index + 1;
+    fieldBegin = end;
+
+    const auto endPos = pos_ + (end - unreadIdx_);
+    /// TODO: Logically should be >=, kept as it is to align with presto reader.
+    if (endPos > limit_ || endPos >= dataEnd) {
+      atEnd = true;
+      break;
+    }
+  }
+  fields_.resize(numRows * numColumns);
+  return numRows;
+}
+
+namespace {
+
+// Returns a function that converts a field with 'parse' to ReqT or returns
+// std::nullopt if 'parse' sets its 'isNull' argument.
+template <typename ReqT, typename T>
+auto parsedAs(T (*parse)(std::string&, bool&)) {
+  return [parse](std::string& str) -> std::optional<ReqT> {
+    bool isNull = false;
+    const T value = parse(str, isNull);
+    return isNull ? std::nullopt : std::optional<ReqT>(value);
+  };
+}
+
+} // namespace
+
+template <typename T, typename Convert>
+void TextRowReader::convertFields(
+    FlatVector<T>& data,
+    size_t column,
+    size_t numColumns,
+    vector_size_t firstRow,
+    vector_size_t numRows,
+    Convert convert) {
+  const auto& nullString = contents_->serDeOptions.nullString;
+  std::string str;
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    const auto& field = fields_[i * numColumns + column];
+    std::optional<T> value;
+    if (field.size >= 0) {
+      str.assign(unreadData_.data() + field.offset, field.size);
+      if (str != nullString) {
+        value = convert(str);
+      }
+    }
+    if (value.has_value()) {
+      data.set(firstRow + i, *value);
+    } else {
+      data.setNull(firstRow + i, true);
+    }
+  }
+}
+
+void TextRowReader::convertColumn(
+    const Type& type,
+    const Type& reqType,
+    BaseVector& data,
+    size_t column,
+    size_t numColumns,
+    vector_size_t firstRow,
+    vector_size_t numRows,
+    const BufferPtr& strings) {
+  const auto convert = [&](auto convertField) {
+    using ReqT = typename std::invoke_result_t<
+        decltype(convertField),
+        std::string&>::value_type;
+    convertFields(
+        *data.asChecked<FlatVector<ReqT>>(),
+        column,
+        numColumns,
+        firstRow,
+        numRows,
+        convertField);
+  };
+  const auto unsupported = [&]() {
+    VELOX_FAIL(
+        "Requested type {} is not supported to be read as type {}",
+        reqType.toString(),
+        type.toString());
+  };
+  // Converts with 'parse' to the requested integer type, which must be at
+  // least as wide as the type of 'parse'.
+  const auto convertToInteger = [&](auto parse) {
+    using T = decltype(parse(
+        std::declval<std::string&>(), std::declval<bool&>()));
+    switch (reqType.kind()) {
+      case TypeKind::BIGINT:
+        return convert(parsedAs<int64_t>(parse));
+      case TypeKind::INTEGER:
+        if constexpr (sizeof(T) <= sizeof(int32_t)) {
+          return convert(parsedAs<int32_t>(parse));
+        }
+        break;
+      case TypeKind::SMALLINT:
+        if constexpr (sizeof(T) <= sizeof(int16_t)) {
+          return convert(parsedAs<int16_t>(parse));
+        }
+        break;
+      case TypeKind::TINYINT:
+        if constexpr (sizeof(T) <= sizeof(int8_t)) {
+          return convert(parsedAs<int8_t>(parse));
+        }
+        break;
+      case TypeKind::BOOLEAN:
+        if constexpr (std::is_same_v<T, bool>) {
+          return convert(parsedAs<bool>(parse));
+        }
+        break;
+      default:
+        break;
+    }
+    unsupported();
+  };
+
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+      return convertToInteger(&parseBoolean);
+    case TypeKind::TINYINT:
+      return convertToInteger(&parseInteger<int8_t>);
+    case TypeKind::SMALLINT:
+      return convertToInteger(&parseInteger<int16_t>);
+    case TypeKind::INTEGER:
+      if (reqType.isDate()) {
+        return convert([](std::string& str) -> std::optional<int32_t> {
+          if (str.empty()) {
+            return std::nullopt;
+          }
+          return DATE()->toDays(str);
+        });
+      }
+      return convertToInteger(&parseInteger<int32_t>);
+    case TypeKind::BIGINT:
+      if (reqType.isShortDecimal()) {
+        auto decimalParams = getDecimalPrecisionScale(reqType);
+        const auto precision = decimalParams.first;
+        const auto scale = decimalParams.second;
+        return convert([&](std::string& str) -> std::optional<int64_t> {
+          if (str.empty()) {
+            return std::nullopt;
+          }
+          return parseDecimal<int64_t>(str, precision, scale);
+        });
+      }
+      return convert(parsedAs<int64_t>(&parseInteger<int64_t>));
+    case TypeKind::HUGEINT:
+      if (reqType.isLongDecimal()) {
+        auto decimalParams = getDecimalPrecisionScale(reqType);
+        const auto precision = decimalParams.first;
+        const auto scale = decimalParams.second;
+        return convert([&](std::string& str) -> std::optional<int128_t> {
+          if (str.empty()) {
+            return std::nullopt;
+          }
+          return parseDecimal<int128_t>(str, precision, scale);
+        });
+      }
+      return convert([](std::string& str) -> std::optional<int128_t> {
+        if (str.empty()) {
+          return std::nullopt;
+        }
+        return HugeInt::parse(str);
+      });
+    case TypeKind::REAL:
+      switch (reqType.kind()) {
+        case TypeKind::REAL:
+          return convert(parsedAs<float>(&parseFloat));
+        case TypeKind::DOUBLE:
+          return convert(parsedAs<double>(&parseDouble));
+        default:
+          return unsupported();
+      }
+    case TypeKind::DOUBLE:
+      return convert(parsedAs<double>(&parseDouble));
+    case TypeKind::VARCHAR: {
+      auto& flatVector = *data.asChecked<FlatVector<StringView>>();
+      flatVector.addStringBuffer(strings);
+      const auto& nullString = contents_->serDeOptions.nullString;
+      for (vector_size_t i = 0; i < numRows; ++i) {
+        const auto& field = fields_[i * numColumns + column];
+        const std::string_view value{
+            strings->as<char>() + field.offset - unreadIdx_,
+            static_cast<size_t>(std::max(field.size, 0))};
+        if (field.size < 0 || value == nullString) {
+          flatVector.setNull(firstRow + i, true);
+        } else {
+          flatVector.setNoCopy(
+              firstRow + i, StringView(value.data(), field.size));
+        }
+      }
+      return;
+    }
+    case TypeKind::VARBINARY: {
+      std::string decoded;
+      return convert([&](std::string& str) -> std::optional<StringView> {
+        size_t size = str.size();
+        const auto decodedSize =
+            encoding::Base64::calculateDecodedSize(str.data(), size)
+                .value_or(0);
+        decoded.resize(decodedSize);
+        if (encoding::Base64::decode(
+                str.data(), str.size(), decoded.data(), decodedSize)
+                .ok()) {
+          return StringView(decoded.data(), decodedSize);
+        }
+        // Not valid base64: keep the value as is like readElement().
+        return StringView(str.data(), str.size());
+      });
+    }
+    case TypeKind::TIMESTAMP:
+      return convert([](std::string& str) -> std::optional<Timestamp> {
+        if (str.empty()) {
+          return std::nullopt;
+        }
+        auto ts =
+            util::Converter<TypeKind::TIMESTAMP>::tryCast(str).thenOrThrow(
+                folly::identity, [&](const Status& status) {
+                  VELOX_USER_FAIL(status.message());
+                });
+        ts.toGMT(Timestamp::defaultTimezone());
+        return Timestamp{ts.getSeconds(), ts.getNanos()};
+      });
+    default:
+      VELOX_NYI("readElement unhandled type (kind code {})", type.kind());
+  }
+}
+
 const std::shared_ptr<const RowType>& TextRowReader::getType() const {
   return contents_->schema;
 }
@@ -1553,6 +2100,7 @@ TextReader::TextReader(
   }
 
   contents_->input = std::move(input);
+  contents_->decompressionBlockSize = options_.decompressionBlockSize();
 
   // Find the size of the file using the option or filesystem.
   contents_->fileLength = std::min(
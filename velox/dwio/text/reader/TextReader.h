@@ -19,12 +19,15 @@
 #include <array>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "folly/CppAttributes.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/Reader.h"
 #include "velox/dwio/common/TypeWithId.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::text {
 
@@ -54,6 +57,8 @@ struct FileContents {
   uint64_t fileLength;
   CompressionKind compression;
   dwio::common::compression::CompressionOptions compressionOptions;
+  // Size of the blocks of a gzip or deflate file. 0 if not set.
+  uint64_t decompressionBlockSize{0};
   SerDeOptions serDeOptions;
   std::array<bool, 128> needsEscape;
 };
@@ -99,6 +104,8 @@ class TextRowReader : public dwio::common::RowReader {
       std::shared_ptr<FileContents> fileContents,
       const RowReaderOptions& options);
 
+  ~TextRowReader() override;
+
   uint64_t next(
       uint64_t size,
       VectorPtr& result,
@@ -177,6 +184,19 @@ class TextRowReader : public dwio::common::RowReader {
 
   void resetLine();
 
+  // Returns the position after the last byte of the file or the
+  // decompressed stream, or the maximum uint64_t if it is not known yet.
+  uint64_t getDataEnd();
+
+  // Reads the next decompressed buffer ahead of 'unreadData_' so that the end
+  // of a compressed stream is detected at its last row. Takes the buffer from
+  // 'blockAhead_' if set and then starts decompressing the following one.
+  void preloadDecompressedData();
+
+  // Starts decompressing the next block into 'blockAhead_' on
+  // 'decompressionExecutor_'.
+  void decompressAhead();
+
   static std::string&
   getString(TextRowReader& th, bool& isNull, DelimType& delim);
 
@@ -189,6 +209,68 @@ class TextRowReader : public dwio::common::RowReader {
 
   static double getDouble(TextRowReader& th, bool& isNull, DelimType& delim);
 
+  // The parse functions convert a field returned by getString(). They set
+  // 'isNull' if 'str' is null or not a valid value and may modify 'str'.
+  template <typename T>
+  static T parseInteger(std::string& str, bool& isNull);
+
+  static bool parseBoolean(std::string& str, bool& isNull);
+
+  static float parseFloat(std::string& str, bool& isNull);
+
+  static double parseDouble(std::string& str, bool& isNull);
+
+  // Returns true if all top-level columns up to 'numColumns' are primitive
+  // types that readTokenizedRows() can convert.
+  bool canTokenize(const TypeWithId& type, size_t numColumns) const;
+
+  // Reads up to 'maxRows' rows from the complete lines in 'unreadData_'
+  // without going through the byte at a time parser. The lines are split into
+  // fields first and 'columns' are then converted one column at a time,
+  // starting at row 'firstRow'. The columns are converted on the decoding
+  // executor of the row reader options if there is one. Returns the number of
+  // rows read, which is 0 if the next line needs the byte at a time parser,
+  // e.g. because it has escaped characters or continues in the next buffer.
+  vector_size_t readTokenizedRows(
+      const TypeWithId& type,
+      const TypeWithId& reqType,
+      const std::vector<BaseVector*>& columns,
+      vector_size_t firstRow,
+      vector_size_t maxRows);
+
+  // Splits up to 'maxRows' complete lines at 'unreadIdx_' into the first
+  // 'numColumns' fields of each and appends these to 'fields_'. Sets 'end'
+  // to the index in 'unreadData_' after the last line and 'atEnd' if the
+  // last line is the last one of the split or the file. Returns the number
+  // of lines.
+  vector_size_t tokenizeRows(
+      size_t numColumns,
+      vector_size_t maxRows,
+      size_t& end,
+      bool& atEnd);
+
+  // Converts the fields of column 'column' of the tokenized rows into 'data'
+  // starting at row 'firstRow'. 'strings' holds a copy of the tokenized bytes
+  // and is referenced by VARCHAR results.
+  void convertColumn(
+      const Type& type,
+      const Type& reqType,
+      BaseVector& data,
+      size_t column,
+      size_t numColumns,
+      vector_size_t firstRow,
+      vector_size_t numRows,
+      const BufferPtr& strings);
+
+  template <typename T, typename Convert>
+  void convertFields(
+      FlatVector<T>& data,
+      size_t column,
+      size_t numColumns,
+      vector_size_t firstRow,
+      vector_size_t numRows,
+      Convert convert);
+
   void readElement(
       const std::shared_ptr<const Type>& t,
       const std::shared_ptr<const Type>& reqT,
@@ -233,6 +315,32 @@ class TextRowReader : public dwio::common::RowReader {
   uint64_t fileLength_;
   std::string ownedString_;
   std::shared_ptr<dwio::common::DataBuffer<char>> varBinBuf_;
+
+  // Offset and size of a field of a tokenized line in 'unreadData_'. The
+  // size is -1 if the line has fewer fields.
+  struct Field {
+    int32_t offset;
+    int32_t size;
+  };
+
+  // The fields of the lines split by tokenizeRows(), row by row.
+  std::vector<Field> fields_;
+
+  // A block of a compressed file decompressed ahead of the parser.
+  struct DecompressedBlock {
+    // True if the decompressed stream has no more data.
+    bool atEnd;
+    std::string data;
+  };
+
+  // Executor to decompress the next block of a compressed file on while the
+  // current one is parsed. nullptr to decompress on the parsing thread.
+  folly::Executor* decompressionExecutor_{nullptr};
+  std::shared_ptr<AsyncSource<DecompressedBlock>> blockAhead_;
+  // Owns the bytes 'preLoadedUnreadData_' points to if blocks are
+  // decompressed ahead, since the next Next() of the stream reuses its
+  // buffer.
+  std::string preLoadedBlock_;
 };
 
 } // namespace facebook::velox::text
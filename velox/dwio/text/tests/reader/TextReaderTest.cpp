@@ -14,6 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include <fstream>
+
+#include "velox/common/testutil/TempFilePath.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/text/RegisterTextReader.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -1278,6 +1283,104 @@ TEST_F(TextReaderTest, primitiveLimitsStressTest) {
   ASSERT_EQ(rowReader->next(10, result), 0);
 }
 
+TEST_F(TextReaderTest, tokenizedRows) {
+  // Lines with escaped separators, missing and extra fields and "\r\n" are
+  // mixed with lines that are split into fields in bulk.
+  constexpr int32_t kNumRows = 1'000;
+  std::vector<int64_t> ids;
+  std::vector<std::optional<std::string>> names;
+  std::vector<std::optional<double>> scores;
+  std::vector<std::optional<bool>> flags;
+  std::vector<std::optional<int16_t>> smalls;
+  std::string text;
+  for (int32_t i = 0; i < kNumRows; ++i) {
+    ids.push_back(i);
+    text += std::to_string(i) + "\t";
+    if (i % 11 == 0) {
+      names.push_back(std::nullopt);
+      text += "\\N";
+    } else if (i % 7 == 0) {
+      names.push_back(fmt::format("escaped\tname_{}", i));
+      text += fmt::format("escaped\\\tname_{}", i);
+    } else {
+      names.push_back(fmt::format("a_longer_name_{}", i));
+      text += *names.back();
+    }
+    text += "\t";
+    if (i % 13 == 0) {
+      scores.push_back(std::nullopt);
+    } else {
+      scores.push_back(i * 0.5);
+      text += fmt::format("{}", i * 0.5);
+    }
+    if (i % 17 == 0) {
+      flags.push_back(std::nullopt);
+      smalls.push_back(std::nullopt);
+    } else {
+      flags.push_back(i % 2 == 1);
+      smalls.push_back(i % 100);
+      text += fmt::format("\t{}\t{}", i % 2 == 1 ? "TRUE" : "false", i % 100);
+    }
+    if (i % 19 == 0) {
+      text += "\textra";
+    }
+    text += i % 5 == 0 ? "\r\n" : "\n";
+  }
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(ids),
+       makeNullableFlatVector<std::string>(names),
+       makeNullableFlatVector<double>(scores),
+       makeNullableFlatVector<bool>(flags),
+       makeNullableFlatVector<int16_t>(smalls)});
+
+  auto tempFile = common::testutil::TempFilePath::create();
+  {
+    std::ofstream out(tempFile->getPath(), std::ios::binary);
+    out << text;
+  }
+
+  auto type = ROW(
+      {{"id", BIGINT()},
+       {"name", VARCHAR()},
+       {"score", DOUBLE()},
+       {"flag", BOOLEAN()},
+       {"small", SMALLINT()}});
+  auto factory = dwio::common::getReaderFactory(dwio::common::FileFormat::TEXT);
+  auto readFile = std::make_shared<LocalReadFile>(tempFile->getPath());
+  auto readerOptions = dwio::common::ReaderOptions(pool());
+  readerOptions.setFileSchema(type);
+  readerOptions.setSerDeOptions(
+      dwio::common::SerDeOptions('\t', '\2', '\3', '\\', true));
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+
+  for (auto parallel : {false, true}) {
+    SCOPED_TRACE(fmt::format("parallel: {}", parallel));
+    auto input =
+        std::make_unique<dwio::common::BufferedInput>(readFile, poolRef());
+    auto reader = factory->createReader(std::move(input), readerOptions);
+    dwio::common::RowReaderOptions rowReaderOptions;
+    setScanSpec(*type, rowReaderOptions);
+    if (parallel) {
+      rowReaderOptions.setDecodingExecutor(executor);
+      rowReaderOptions.setDecodingParallelismFactor(4);
+    }
+    auto rowReader = reader->createRowReader(rowReaderOptions);
+
+    VectorPtr result;
+    int32_t numRead = 0;
+    while (auto numRows = rowReader->next(97, result)) {
+      ASSERT_EQ(result->size(), numRows);
+      for (int32_t i = 0; i < numRows; ++i) {
+        ASSERT_TRUE(result->equalValueAt(expected.get(), i, numRead + i))
+            << "row " << numRead + i << ": " << result->toString(i)
+            << " vs " << expected->toString(numRead + i);
+      }
+      numRead += numRows;
+    }
+    EXPECT_EQ(numRead, kNumRows);
+  }
+}
+
 TEST_F(TextReaderTest, DISABLED_nestedComplexTypesWithCustomDelimiters) {
   // Inner maps for the arrays
   const auto innerMapKeys1 = makeFlatVector<int64_t>({1, 11, 22});
@@ -1898,6 +2001,23 @@ TEST_P(TextReaderDecompressionTest, tests) {
     EXPECT_TRUE(result->equalValueAt(expected.get(), i, 9 + i));
   }
   ASSERT_EQ(rowReader->next(10, result), 0);
+
+  // Decompress blocks of 16 bytes ahead of the parser.
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(2);
+  readerOptions.setDecompressionBlockSize(16);
+  rowReaderOptions.setIOExecutor(executor.get());
+  input = std::make_unique<dwio::common::BufferedInput>(readFile, poolRef());
+  reader = factory->createReader(std::move(input), readerOptions);
+  rowReader = reader->createRowReader(rowReaderOptions);
+  ASSERT_EQ(rowReader->next(5, result), 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(result->equalValueAt(expected.get(), i, i));
+  }
+  ASSERT_EQ(rowReader->next(10, result), 7);
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_TRUE(result->equalValueAt(expected.get(), i, 5 + i));
+  }
+  ASSERT_EQ(rowReader->next(10, result), 0);
 }
 
 std::vector<TestCompressionParam> params = {
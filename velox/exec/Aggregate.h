@@ -89,6 +89,13 @@ class Aggregate {
     return false;
   }
 
+  /// Returns true if the aggregate updates each run of consecutive rows of the
+  /// same group with a single accumulator update when its input is clustered
+  /// by group. See setGroupRuns().
+  virtual bool supportsGroupRuns() const {
+    return false;
+  }
+
   void setAllocator(HashStringAllocator* allocator) {
     setAllocatorInternal(allocator);
   }
@@ -190,6 +197,14 @@ class Aggregate {
     clusteredInput_ = value;
   }
 
+  /// Called by GroupingSet around the addRawInput() and
+  /// addIntermediateResults() calls for a batch it has reordered so that the
+  /// rows of each group are consecutive. Only called if supportsGroupRuns() is
+  /// true. Unlike setClusteredInput(), this applies to a single batch.
+  void setGroupRuns(bool value) {
+    groupRuns_ = value;
+  }
+
   /// Whether the function itself supports clustered input optimization.
   ///
   /// When this returns true, `addRawClusteredInput` should be implemented.
@@ -262,6 +277,27 @@ class Aggregate {
       const std::vector<VectorPtr>& args,
       bool mayPushdown) = 0;
 
+  // Returns true if the aggregate implements retractSingleGroupRawInput().
+  // Such an aggregate must ignore null inputs, so that its result over rows
+  // that are all null is the same as over no rows.
+  virtual bool supportsRetract() const {
+    return false;
+  }
+
+  // Removes raw input from the single accumulator. Used by sliding window
+  // frames to drop the rows that leave the frame instead of aggregating over
+  // the whole frame again.
+  // @param group Pointer to the start of the group row.
+  // @param rows Rows of the 'args' to remove. These must have been added
+  // before with addSingleGroupRawInput().
+  // @param args Raw input to remove.
+  virtual void retractSingleGroupRawInput(
+      char* /*group*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/) {
+    VELOX_NYI("retractSingleGroupRawInput not supported");
+  }
+
   // Extracts final results (used for final and single aggregations).
   // @param groups Pointers to the start of the group rows.
   // @param numGroups Number of groups to extract results from.
@@ -520,6 +556,10 @@ class Aggregate {
   bool validateIntermediateInputs_ = false;
 
   bool clusteredInput_ = false;
+
+  // True if the rows of each group in the current batch are consecutive. See
+  // setGroupRuns().
+  bool groupRuns_ = false;
 };
 
 using AggregateFunctionFactory = std::function<std::unique_ptr<Aggregate>(
@@ -15,8 +15,12 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+
+#include <numeric>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/AggregateFunctionRegistry.h"
 #include "velox/exec/WindowFunction.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/vector/FlatVector.h"
@@ -67,6 +71,13 @@ class AggregateWindowFunction : public exec::WindowFunction {
         config);
     aggregate_->setAllocator(stringAllocator_);
 
+    // Frames of order insensitive aggregates can be merged from the
+    // accumulators of parts of the frame in any order.
+    const auto* entry = exec::getAggregateFunctionEntry(name);
+    if (entry != nullptr && !entry->metadata.orderSensitive) {
+      intermediateType_ = exec::resolveIntermediateType(name, argTypes_);
+    }
+
     // Aggregate initialization.
     // Row layout is:
     //  - null flags - one bit per aggregate.
@@ -116,6 +127,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    slidingFrame_.reset();
+    segmentTree_.clear();
+    segmentTreeBuilt_ = false;
   }
 
   void apply(
@@ -163,9 +177,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
-    } else {
-      fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
-      simpleAggregation(
+      slidingFrame_.reset();
+    } else if (canSlide(validRows, rawFrameStarts, rawFrameEnds)) {
+      slidingAggregation(
           validRows,
           frameMetadata.firstRow,
           frameMetadata.lastRow,
@@ -173,6 +187,32 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else {
+      slidingFrame_.reset();
+      const bool useSegmentTree =
+          shouldUseSegmentTree(validRows, rawFrameStarts, rawFrameEnds);
+      if (useSegmentTree && !segmentTreeBuilt_) {
+        buildSegmentTree();
+      }
+      fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
+      if (useSegmentTree) {
+        segmentTreeAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      } else {
+        simpleAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            frameMetadata.lastRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      }
     }
     previousFrameMetadata_ = frameMetadata;
   }
@@ -317,6 +357,287 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' can be computed by adding the
+  // rows that enter the frame and retracting the rows that leave it. This
+  // needs an aggregate that supports retraction and frame starts and ends
+  // that do not decrease, also from the previous block of the partition.
+  bool canSlide(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) {
+    if (!aggregate_->supportsRetract() || argIndices_.size() > 1) {
+      return false;
+    }
+    vector_size_t previousStart = rawFrameStarts[validRows.begin()];
+    vector_size_t previousEnd = rawFrameEnds[validRows.begin()];
+    if (slidingFrame_.has_value() &&
+        (previousStart < slidingFrame_->start ||
+         previousEnd < slidingFrame_->end)) {
+      slidingFrame_.reset();
+    }
+    bool nonDecreasing = true;
+    validRows.applyToSelected([&](auto i) {
+      nonDecreasing &= rawFrameStarts[i] >= previousStart &&
+          rawFrameEnds[i] >= previousEnd;
+      previousStart = rawFrameStarts[i];
+      previousEnd = rawFrameEnds[i];
+    });
+    return nonDecreasing;
+  }
+
+  // Returns the number of rows in [start, end) of 'argVectors_' that the
+  // aggregate does not ignore as null.
+  vector_size_t countNonNullRows(vector_size_t start, vector_size_t end) {
+    if (argVectors_.empty() || !argVectors_[0]->mayHaveNulls()) {
+      return end - start;
+    }
+    if (argIndices_[0] == kConstantChannel) {
+      return argVectors_[0]->isNullAt(0) ? 0 : end - start;
+    }
+    vector_size_t numNonNull = 0;
+    for (auto i = start; i < end; ++i) {
+      numNonNull += !argVectors_[0]->isNullAt(i);
+    }
+    return numNonNull;
+  }
+
+  // Adds or retracts the rows in [start, end) of 'argVectors_'.
+  void updateSlidingAggregate(
+      SelectivityVector& rows,
+      vector_size_t start,
+      vector_size_t end,
+      bool retract) {
+    if (start >= end) {
+      return;
+    }
+    rows.clearAll();
+    rows.setValidRange(start, end, true);
+    rows.updateBounds();
+    if (retract) {
+      aggregate_->retractSingleGroupRawInput(
+          rawSingleGroupRow_, rows, argVectors_);
+      slidingFrame_->numNonNullRows -= countNonNullRows(start, end);
+    } else {
+      aggregate_->addSingleGroupRawInput(
+          rawSingleGroupRow_, rows, argVectors_, false);
+      slidingFrame_->numNonNullRows += countNonNullRows(start, end);
+    }
+  }
+
+  // Computes frames with non-decreasing starts and ends, e.g. 'ROWS BETWEEN k
+  // PRECEDING AND CURRENT ROW', by moving the frame of the accumulator from
+  // row to row. Each input row is added and retracted once, instead of once
+  // per frame it is in. The moving frame carries over to the next block of
+  // the partition.
+  void slidingAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    if (!slidingFrame_.has_value()) {
+      aggregate_->destroy(folly::Range<char**>(&rawSingleGroupRow_, 1));
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+      slidingFrame_ = SlidingFrame{minFrame, minFrame - 1, 0};
+    }
+
+    // The argument vectors start at the first row of the frame carried over
+    // from the previous block, which is still in the accumulator.
+    const auto firstRow = std::min(minFrame, slidingFrame_->start);
+    fillArgVectors(firstRow, maxFrame);
+    SelectivityVector rows(maxFrame + 1 - firstRow);
+
+    validRows.applyToSelected([&](auto i) {
+      const auto frameStart = frameStartsVector[i] - firstRow;
+      const auto frameEnd = frameEndsVector[i] - firstRow + 1;
+      const auto previousStart = slidingFrame_->start - firstRow;
+      const auto previousEnd = slidingFrame_->end - firstRow + 1;
+      updateSlidingAggregate(
+          rows, previousStart, std::min(previousEnd, frameStart), true);
+      updateSlidingAggregate(
+          rows, std::max(previousEnd, frameStart), frameEnd, false);
+      slidingFrame_->start = frameStartsVector[i];
+      slidingFrame_->end = frameEndsVector[i];
+
+      if (slidingFrame_->numNonNullRows == 0) {
+        // Only null rows are left, which the aggregate ignores.
+        result->copy(emptyResult_.get(), resultOffset + i, 0, 1);
+        return;
+      }
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
+  // Returns true if the frames of 'validRows' are aggregated from the
+  // segment tree. The tree needs all rows of the partition and pays off for
+  // frames that are much larger than its fanout.
+  bool shouldUseSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (intermediateType_ == nullptr || partition_->partial()) {
+      return false;
+    }
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] + 1 - rawFrameStarts[i];
+    });
+    return numFrameRows >=
+        static_cast<int64_t>(validRows.countSelected()) * kMinTreeFrameRows;
+  }
+
+  // Allocates 'numGroups' accumulators in 'treeGroups_'.
+  void initializeTreeGroups(vector_size_t numGroups) {
+    const auto groupSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    treeGroupsBuffer_ =
+        AlignedBuffer::allocate<char>(numGroups * groupSize, pool_, 0);
+    treeGroups_.resize(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      treeGroups_[i] = treeGroupsBuffer_->asMutable<char>() + i * groupSize;
+    }
+    std::vector<vector_size_t> indices(numGroups);
+    std::iota(indices.begin(), indices.end(), 0);
+    aggregate_->initializeNewGroups(treeGroups_.data(), indices);
+  }
+
+  // Extracts the accumulators in 'treeGroups_' as the next level of
+  // 'segmentTree_' and frees them.
+  void addTreeLevel() {
+    auto level =
+        BaseVector::create(intermediateType_, treeGroups_.size(), pool_);
+    aggregate_->extractAccumulators(
+        treeGroups_.data(), treeGroups_.size(), &level);
+    aggregate_->destroy(folly::Range(treeGroups_.data(), treeGroups_.size()));
+    segmentTree_.push_back(std::move(level));
+  }
+
+  // Builds 'segmentTree_' over the rows of the partition. Level 0 holds the
+  // intermediate results of blocks of kTreeFanout rows, level l + 1 those of
+  // blocks of kTreeFanout level l nodes. Stops at a level of at most
+  // kTreeFanout nodes.
+  void buildSegmentTree() {
+    segmentTree_.clear();
+    const auto numRows = partition_->numRows();
+    if (numRows > kTreeFanout) {
+      initializeTreeGroups(bits::divRoundUp(numRows, kTreeFanout));
+      std::vector<char*> rowGroups;
+      for (vector_size_t start = 0; start < numRows;
+           start += kTreeBuildBatchRows) {
+        const auto end = std::min(start + kTreeBuildBatchRows, numRows);
+        fillArgVectors(start, end - 1);
+        rowGroups.resize(end - start);
+        for (auto row = start; row < end; ++row) {
+          rowGroups[row - start] = treeGroups_[row / kTreeFanout];
+        }
+        aggregate_->addRawInput(
+            rowGroups.data(),
+            SelectivityVector(end - start),
+            argVectors_,
+            false);
+      }
+      addTreeLevel();
+    }
+
+    while (!segmentTree_.empty() &&
+           segmentTree_.back()->size() > kTreeFanout) {
+      const auto previous = segmentTree_.back();
+      const auto numNodes = previous->size();
+      initializeTreeGroups(bits::divRoundUp(numNodes, kTreeFanout));
+      std::vector<char*> nodeGroups(numNodes);
+      for (auto node = 0; node < numNodes; ++node) {
+        nodeGroups[node] = treeGroups_[node / kTreeFanout];
+      }
+      aggregate_->addIntermediateResults(
+          nodeGroups.data(), SelectivityVector(numNodes), {previous}, false);
+      addTreeLevel();
+    }
+    segmentTreeBuilt_ = true;
+  }
+
+  // Adds the nodes in [start, end) of 'level' to the single accumulator.
+  // Level -1 is the raw input in 'argVectors_', which starts at partition row
+  // 'firstRow'.
+  void addTreeNodes(
+      int32_t level,
+      vector_size_t start,
+      vector_size_t end,
+      vector_size_t firstRow) {
+    if (start >= end) {
+      return;
+    }
+    const SelectivityVector rows(end - start);
+    if (level < 0) {
+      std::vector<VectorPtr> args;
+      args.reserve(argVectors_.size());
+      for (const auto& argVector : argVectors_) {
+        args.push_back(argVector->slice(start - firstRow, end - start));
+      }
+      aggregate_->addSingleGroupRawInput(rawSingleGroupRow_, rows, args, false);
+    } else {
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_,
+          rows,
+          {segmentTree_[level]->slice(start, end - start)},
+          false);
+    }
+  }
+
+  // Computes each frame from at most 2 * kTreeFanout raw rows or nodes per
+  // level of the segment tree, instead of from all the rows of the frame.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t firstRow,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    const int32_t numLevels = segmentTree_.size();
+
+    validRows.applyToSelected([&](auto i) {
+      aggregate_->destroy(folly::Range<char**>(&rawSingleGroupRow_, 1));
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+
+      // Walks up the tree from the raw rows. At each level adds the partial
+      // blocks at the ends of [start, end) and continues with the whole
+      // blocks in between on the level above.
+      vector_size_t start = frameStartsVector[i];
+      vector_size_t end = frameEndsVector[i] + 1;
+      for (int32_t level = -1; start < end; ++level) {
+        const auto blocksStart = bits::roundUp(start, kTreeFanout);
+        const auto blocksEnd = end / kTreeFanout * kTreeFanout;
+        if (level + 1 == numLevels || blocksStart >= blocksEnd) {
+          addTreeNodes(level, start, end, firstRow);
+          break;
+        }
+        addTreeNodes(level, start, blocksStart, firstRow);
+        addTreeNodes(level, blocksEnd, end, firstRow);
+        start = blocksStart / kTreeFanout;
+        end = blocksEnd / kTreeFanout;
+      }
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   void simpleAggregation(
       const SelectivityVector& validRows,
       vector_size_t minFrame,
@@ -363,6 +684,13 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregate_->clear();
   }
 
+  // Fanout of the segment tree.
+  static constexpr vector_size_t kTreeFanout = 16;
+  // Minimum average frame size for using the segment tree.
+  static constexpr vector_size_t kMinTreeFrameRows = 4 * kTreeFanout;
+  // Number of rows the segment tree is built from at a time.
+  static constexpr vector_size_t kTreeBuildBatchRows = 1'024 * kTreeFanout;
+
   // Aggregate function object required for this window function evaluation.
   std::unique_ptr<exec::Aggregate> aggregate_;
 
@@ -394,6 +722,29 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
 
+  // The frame of partition rows in the accumulator in slidingAggregation().
+  // 'end' is 'start - 1' for an empty frame.
+  struct SlidingFrame {
+    vector_size_t start;
+    vector_size_t end;
+    // Number of the rows in the frame with a non-null argument.
+    vector_size_t numNonNullRows;
+  };
+  std::optional<SlidingFrame> slidingFrame_;
+
+  // Intermediate type of the aggregate if it is order insensitive, else null.
+  // Frames are computed from the segment tree only if set.
+  TypePtr intermediateType_;
+
+  // Intermediate results of blocks of partition rows, one vector per level of
+  // the tree. Built on first use for each partition.
+  std::vector<VectorPtr> segmentTree_;
+  bool segmentTreeBuilt_{false};
+
+  // Accumulators used to build a level of 'segmentTree_'.
+  BufferPtr treeGroupsBuffer_;
+  std::vector<char*> treeGroups_;
+
   // Stores default result value for empty frame aggregation. Window functions
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
@@ -28,15 +28,28 @@ ArrowStream::ArrowStream(
           arrowStreamNode->outputType(),
           operatorId,
           arrowStreamNode->id(),
-          OperatorType::kArrowStream) {
-  arrowStream_ = arrowStreamNode->arrowStream();
+          OperatorType::kArrowStream),
+      node_(arrowStreamNode) {
+  arrowStream_ = node_->nextArrowStream();
+  finished_ = arrowStream_ == nullptr;
 }
 
 ArrowStream::~ArrowStream() {
   close();
 }
 
+void ArrowStream::nextStream() {
+  if (arrowStream_->release) {
+    arrowStream_->release(arrowStream_.get());
+  }
+  arrowStream_ = node_->nextArrowStream();
+  finished_ = arrowStream_ == nullptr;
+}
+
 RowVectorPtr ArrowStream::getOutput() {
+  if (finished_) {
+    return nullptr;
+  }
   // Get Arrow array.
   struct ArrowArray arrowArray;
   if (arrowStream_->get_next(arrowStream_.get(), &arrowArray)) {
@@ -48,7 +61,7 @@ RowVectorPtr ArrowStream::getOutput() {
   }
   if (arrowArray.release == nullptr) {
     // End of Stream.
-    finished_ = true;
+    nextStream();
     return nullptr;
   }
 
@@ -66,7 +79,8 @@ RowVectorPtr ArrowStream::getOutput() {
         std::string(getError()));
   }
 
-  // Convert Arrow Array into RowVector and return.
+  // Convert Arrow Array into RowVector and return. The vector wraps the
+  // buffers of the array and releases it when destroyed.
   return std::dynamic_pointer_cast<RowVector>(
       importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
 }
@@ -82,8 +96,10 @@ const char* ArrowStream::getError() const {
 }
 
 void ArrowStream::close() {
-  if (arrowStream_->release) {
-    arrowStream_->release(arrowStream_.get());
+  // Releases the current stream and, if the task ends early, the streams not
+  // yet taken by any driver.
+  while (arrowStream_ != nullptr) {
+    nextStream();
   }
   SourceOperator::close();
 }
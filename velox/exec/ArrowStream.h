@@ -20,6 +20,8 @@
 
 namespace facebook::velox::exec {
 
+/// Reads the streams of an ArrowStreamNode. Takes a stream from the node,
+/// reads it to the end, then takes the next until the node has none left.
 class ArrowStream : public SourceOperator {
  public:
   ArrowStream(
@@ -43,6 +45,10 @@ class ArrowStream : public SourceOperator {
   /// Return last error in Arrow array stream.
   const char* getError() const;
 
+  // Releases 'arrowStream_' and takes the next stream of the node.
+  void nextStream();
+
+  const std::shared_ptr<const core::ArrowStreamNode> node_;
   bool finished_ = false;
   std::shared_ptr<ArrowArrayStream> arrowStream_;
 };
@@ -27,6 +27,8 @@ enum class BlockingReason {
   /// Some operators can get blocked due to the producer(s) (they are
   /// currently waiting data from) not having anything produced. Used by
   /// LocalExchange, LocalMergeExchange, Exchange and MergeExchange operators.
+  /// Also used by a two-phase final HashAggregation waiting for its peers to
+  /// partition their groups.
   kWaitForProducer,
   kWaitForJoinBuild,
   /// For a build operator, it is blocked waiting for the probe operators to
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/DistinctAggregations.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/SetAccumulator.h"
 
 namespace facebook::velox::exec {
@@ -261,6 +262,195 @@ class TypedDistinctAggregations : public DistinctAggregations {
   VectorPtr inputForAccumulator_;
 };
 
+// De-duplicates the inputs of all groups in one hash table keyed on the
+// address of the group followed by the inputs of the aggregates. The rows that
+// are new to the table are added to the aggregates right away, so that there
+// is no per-group state besides the accumulators of the aggregates.
+class SharedDistinctAggregations : public DistinctAggregations {
+ public:
+  SharedDistinctAggregations(
+      std::vector<AggregateInfo*> aggregates,
+      const RowTypePtr& inputType,
+      memory::MemoryPool* pool)
+      : pool_{pool},
+        aggregates_{std::move(aggregates)},
+        inputs_{aggregates_[0]->inputs},
+        keyType_{makeKeyType(inputType, inputs_)} {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.reserve(keyType_->size());
+    for (column_index_t i = 0; i < keyType_->size(); ++i) {
+      hashers.push_back(VectorHasher::create(keyType_->childAt(i), i));
+    }
+    table_ = HashTable<false>::createForAggregation(
+        std::move(hashers), /*accumulators=*/{}, pool_);
+    lookup_ = std::make_unique<HashLookup>(table_->hashers(), pool_);
+  }
+
+  /// The accumulator has no state. Destroying the groups clears the hash
+  /// table since the groups are always destroyed together.
+  Accumulator accumulator() const override {
+    return {/*isFixedSize=*/true,
+            /*fixedSize=*/0,
+            /*usesExternalMemory=*/true,
+            /*alignment=*/1,
+            ARRAY(keyType_),
+            /*spillExtractFunction=*/
+            [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
+              VELOX_UNSUPPORTED(
+                  "Spilling of distinct aggregations over a shared hash "
+                  "table is not supported");
+            },
+            /*destroyFunction=*/
+            [this](folly::Range<char**> /*groups*/) {
+              table_->clear(/*freeTable=*/true);
+            }};
+  }
+
+  void addInput(
+      char** groups,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    if (!findNewRows(
+            input, rows, [&](vector_size_t row) { return groups[row]; })) {
+      return;
+    }
+    const auto inputs = makeInputForAggregation(input);
+    for (const auto* aggregate : aggregates_) {
+      aggregate->function->addRawInput(groups, newRows_, inputs, false);
+    }
+  }
+
+  void addSingleGroupInput(
+      char* group,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    if (!findNewRows(input, rows, [&](vector_size_t /*row*/) {
+          return group;
+        })) {
+      return;
+    }
+    const auto inputs = makeInputForAggregation(input);
+    for (const auto* aggregate : aggregates_) {
+      aggregate->function->addSingleGroupRawInput(
+          group, newRows_, inputs, false);
+    }
+  }
+
+  void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
+      override {
+    for (const auto* aggregate : aggregates_) {
+      aggregate->function->extractValues(
+          groups.data(), groups.size(), &result->childAt(aggregate->output));
+    }
+  }
+
+  void addSingleGroupSpillInput(
+      char* /*group*/,
+      const VectorPtr& /*input*/,
+      vector_size_t /*index*/) override {
+    VELOX_UNSUPPORTED(
+        "Spilling of distinct aggregations over a shared hash table is not "
+        "supported");
+  }
+
+ protected:
+  void initializeNewGroupsInternal(
+      char** groups,
+      folly::Range<const vector_size_t*> indices) override {
+    for (const auto* aggregate : aggregates_) {
+      aggregate->function->initializeNewGroups(groups, indices);
+    }
+  }
+
+ private:
+  static RowTypePtr makeKeyType(
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& inputs) {
+    std::vector<std::string> names{"group"};
+    std::vector<TypePtr> types{BIGINT()};
+    for (auto input : inputs) {
+      names.push_back(inputType->nameOf(input));
+      types.push_back(inputType->childAt(input));
+    }
+    return ROW(std::move(names), std::move(types));
+  }
+
+  // Adds the group and the inputs of 'rows' to the hash table and sets
+  // 'newRows_' to the rows that were not in the table yet. 'groupAt' returns
+  // the group of a row. Returns false if there is no new row.
+  template <typename GroupAt>
+  bool findNewRows(
+      const RowVectorPtr& input,
+      const SelectivityVector& rows,
+      GroupAt groupAt) {
+    const auto numRows = input->size();
+    if (groupKeys_ == nullptr || groupKeys_.use_count() != 1) {
+      groupKeys_ = BaseVector::create<FlatVector<int64_t>>(
+          BIGINT(), numRows, pool_);
+    } else {
+      groupKeys_->resize(numRows);
+    }
+    auto* rawGroupKeys = groupKeys_->mutableRawValues();
+    rows.applyToSelected([&](vector_size_t row) {
+      rawGroupKeys[row] = reinterpret_cast<int64_t>(groupAt(row));
+    });
+
+    std::vector<VectorPtr> keys;
+    keys.reserve(keyType_->size());
+    keys.push_back(groupKeys_);
+    for (auto channel : inputs_) {
+      keys.push_back(input->childAt(channel));
+    }
+    const auto keyVector = std::make_shared<RowVector>(
+        pool_, keyType_, nullptr, numRows, std::move(keys));
+
+    activeRows_ = rows;
+    table_->prepareForGroupProbe(
+        *lookup_,
+        keyVector,
+        activeRows_,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    if (lookup_->rows.empty()) {
+      return false;
+    }
+    table_->groupProbe(
+        *lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
+
+    const auto& newGroups = lookup_->newGroups;
+    if (newGroups.empty()) {
+      return false;
+    }
+    newRows_.resizeFill(numRows, false);
+    for (auto row : newGroups) {
+      newRows_.setValid(row, true);
+    }
+    newRows_.updateBounds();
+    return true;
+  }
+
+  std::vector<VectorPtr> makeInputForAggregation(
+      const RowVectorPtr& input) const {
+    std::vector<VectorPtr> inputs;
+    inputs.reserve(inputs_.size());
+    for (auto channel : inputs_) {
+      inputs.push_back(input->childAt(channel));
+    }
+    return inputs;
+  }
+
+  memory::MemoryPool* const pool_;
+  const std::vector<AggregateInfo*> aggregates_;
+  const std::vector<column_index_t> inputs_;
+  // The group address followed by 'inputs_'.
+  const RowTypePtr keyType_;
+
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+  FlatVectorPtr<int64_t> groupKeys_;
+  SelectivityVector activeRows_;
+  SelectivityVector newRows_;
+};
+
 template <TypeKind Kind>
 std::unique_ptr<DistinctAggregations>
 createDistinctAggregationsWithCustomCompare(
@@ -345,4 +535,15 @@ std::unique_ptr<DistinctAggregations> DistinctAggregations::create(
   }
 }
 
+// static
+std::unique_ptr<DistinctAggregations> DistinctAggregations::createShared(
+    std::vector<AggregateInfo*> aggregates,
+    const RowTypePtr& inputType,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK_EQ(aggregates.size(), 1);
+  VELOX_CHECK(!aggregates[0]->inputs.empty());
+  return std::make_unique<SharedDistinctAggregations>(
+      std::move(aggregates), inputType, pool);
+}
+
 } // namespace facebook::velox::exec
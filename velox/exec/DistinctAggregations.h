@@ -37,6 +37,17 @@ class DistinctAggregations {
       const RowTypePtr& inputType,
       memory::MemoryPool* pool);
 
+  /// Same as 'create' but de-duplicates the inputs of all groups in one hash
+  /// table keyed on the group and the inputs. Each input that is new for its
+  /// group is added to the aggregate right away, so no per-group state is kept
+  /// besides the one of the aggregate. The hash table is keyed on the
+  /// addresses of the groups. Hence, the groups must not move and are all
+  /// destroyed together. Does not support spilling.
+  static std::unique_ptr<DistinctAggregations> createShared(
+      std::vector<AggregateInfo*> aggregates,
+      const RowTypePtr& inputType,
+      memory::MemoryPool* pool);
+
   virtual ~DistinctAggregations() = default;
 
   virtual Accumulator accumulator() const = 0;
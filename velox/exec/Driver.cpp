@@ -18,7 +18,13 @@
 
 #include <atomic>
 
+#include <folly/ScopeGuard.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/process/PerfCounters.h"
+#include "velox/common/process/StackSampler.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/exec/DriverExecutor.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorType.h"
 #include "velox/exec/Task.h"
@@ -128,6 +134,24 @@ bool isAggregationSpillOperator(std::string_view operatorType) {
 bool isRowNumberSpillOperator(std::string_view operatorType) {
   return operatorType == OperatorType::kRowNumber;
 }
+
+// Adds the counts of 'counters' since 'start' to the runtime stats of 'op'.
+void addPerfCounterStats(
+    Operator& op,
+    const process::PerfCounters& counters,
+    const process::PerfCounters::Values& start) {
+  const auto end = counters.read();
+  op.stats().withWLock([&](auto& stats) {
+    for (auto i = 0; i < process::PerfCounters::kNumEvents; ++i) {
+      const auto event = static_cast<process::PerfCounters::Event>(i);
+      if (counters.has(event)) {
+        stats.addRuntimeStat(
+            process::PerfCounters::name(event),
+            RuntimeCounter(static_cast<int64_t>(end[i] - start[i])));
+      }
+    }
+  });
+}
 } // namespace
 
 std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
@@ -137,7 +161,8 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
   if (!queryConfig.spillEnabled()) {
     return std::nullopt;
   }
-  if (task->spillDirectory().empty() && !task->hasCreateSpillDirectoryCb()) {
+  if (task->spillDirectory().empty() && !task->hasCreateSpillDirectoryCb() &&
+      !task->hasSpillTiers()) {
     return std::nullopt;
   }
   common::GetSpillDirectoryPathCB getSpillDirPathCb =
@@ -170,7 +195,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
     }
   }
 
-  return common::SpillConfig(
+  common::SpillConfig spillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
       spillFilePrefix,
@@ -191,7 +216,19 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
           ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
           : std::nullopt,
       fileCreateConfig,
-      queryConfig.windowSpillMinReadBatchRows());
+      queryConfig.windowSpillMinReadBatchRows(),
+      queryConfig.spillColumnarFormatEnabled(),
+      queryConfig.spillReadAheadEnabled(),
+      queryConfig.spillDictionaryCompressionEnabled());
+  if (task->hasSpillTiers()) {
+    spillConfig.getSpillFileTargetCb = [this]() {
+      return task->getOrCreateSpillFileTarget();
+    };
+    spillConfig.updateSpillTierBytesCb = [this](uint32_t tier, uint64_t bytes) {
+      task->addSpillTierBytes(tier, bytes);
+    };
+  }
+  return spillConfig;
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -287,6 +324,13 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
+  if (driver->driverExecutor_ != nullptr) {
+    driver->driverExecutor_->addWithAffinity(
+        [driver]() { Driver::run(driver); },
+        driver->affinity_,
+        driver->schedulingGroup_);
+    return;
+  }
   driver->task()->queryCtx()->executor()->add(
       [driver]() { Driver::run(driver); });
 }
@@ -299,10 +343,20 @@ void Driver::init(
   enableOperatorBatchSizeStats_ =
       ctx_->queryConfig().enableOperatorBatchSizeStats();
   cpuSliceMs_ = task()->driverCpuTimeSliceLimitMs();
+  driverExecutor_ =
+      dynamic_cast<DriverExecutor*>(task()->queryCtx()->executor());
+  if (driverExecutor_ != nullptr) {
+    affinity_ = folly::hash::hash_combine(task()->taskId(), ctx_->pipelineId);
+    schedulingGroup_ = driverExecutor_->schedulingGroup(
+        task()->queryCtx()->queryId(),
+        ctx_->queryConfig().querySchedulingWeight());
+  }
   VELOX_CHECK(operators_.empty());
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorPerfCounters_ =
+      ctx_->queryConfig().operatorTrackPerfCounters();
 }
 
 void Driver::initializeOperators() {
@@ -323,6 +377,8 @@ RowVectorPtr Driver::next(
   auto self = shared_from_this();
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
+  const auto stackProfile = self->task()->stackProfileIfSampling();
+  process::StackSampler::Scope stackSampler(stackProfile.get());
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr result;
@@ -806,6 +862,8 @@ void Driver::run(std::shared_ptr<Driver> self) {
   process::TraceContext trace("Driver::run");
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
+  const auto stackProfile = self->task()->stackProfileIfSampling();
+  process::StackSampler::Scope stackSampler(stackProfile.get());
   ScopedDriverThreadContext scopedDriverThreadContext(self->driverCtx());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
@@ -836,6 +894,11 @@ void Driver::run(std::shared_ptr<Driver> self) {
       return;
 
     case StopReason::kYield:
+      // Returns the cached small allocations of the operators so that the
+      // Driver does not hold them while it waits in the queue.
+      for (auto& op : self->operators_) {
+        op->pool()->flushAllocationCache();
+      }
       // Go to the end of the queue.
       enqueue(self);
       return;
@@ -1278,6 +1341,22 @@ void Driver::withDeltaCpuWallTimer(
     Operator* op,
     TimingMemberPtr opTimingMember,
     Func&& opFunction) {
+  process::StackSampler::ScopedLabel stackLabel(&op->planNodeId());
+  // The counters of the thread running the call. Unlike the CPU time, the
+  // counts of lazy loads triggered by the call stay with 'op'.
+  auto* perfCounters = trackOperatorPerfCounters_
+      ? process::PerfCounters::forCurrentThread()
+      : nullptr;
+  process::PerfCounters::Values perfStart{};
+  if (perfCounters != nullptr) {
+    perfStart = perfCounters->read();
+  }
+  SCOPE_EXIT {
+    if (perfCounters != nullptr) {
+      addPerfCounterStats(*op, *perfCounters, perfStart);
+    }
+  };
+
   // If 'trackOperatorCpuUsage_' is true, create and initialize the timer object
   // to track cpu and wall time of the opFunction.
   if (!trackOperatorCpuUsage_) {
@@ -34,9 +34,11 @@
 namespace facebook::velox::exec {
 
 class Driver;
+class DriverExecutor;
 class ExchangeClient;
 class Operator;
 struct OperatorStats;
+class SchedulingGroup;
 class Task;
 
 enum class StopReason {
@@ -683,6 +685,16 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // If not zero, specifies the driver cpu time slice.
   size_t cpuSliceMs_{0};
 
+  // The executor of the QueryCtx if it is a DriverExecutor.
+  DriverExecutor* driverExecutor_{nullptr};
+
+  // Same for all Drivers of a pipeline of the Task. Places the Drivers on the
+  // same NUMA node of 'driverExecutor_'.
+  uint64_t affinity_{0};
+
+  // The group of the query in 'driverExecutor_'.
+  std::shared_ptr<SchedulingGroup> schedulingGroup_;
+
   bool operatorsInitialized_{false};
 
   std::atomic_bool closed_{false};
@@ -719,6 +731,8 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  bool trackOperatorPerfCounters_;
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
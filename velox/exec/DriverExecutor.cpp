@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DriverExecutor.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <fstream>
+#include <limits>
+
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <folly/system/ThreadName.h>
+#include <glog/logging.h>
+
+#include "velox/common/process/ProcessBase.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+thread_local const DriverExecutor* currentExecutor{nullptr};
+thread_local int32_t currentWorkerIndex{-1};
+thread_local int32_t currentWorkerNodeIndex{-1};
+
+std::vector<NumaNode> makeNodes(std::vector<NumaNode> nodes) {
+  if (nodes.empty()) {
+    nodes = numaTopology();
+  }
+  // Nodes with memory but without CPUs get no threads.
+  std::erase_if(nodes, [](const auto& node) { return node.cpus.empty(); });
+  VELOX_CHECK(!nodes.empty(), "DriverExecutor needs at least one CPU");
+  return nodes;
+}
+
+void pinThread(std::thread& thread, const NumaNode& node) {
+#ifdef __linux__
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (auto cpu : node.cpus) {
+    CPU_SET(cpu, &cpus);
+  }
+  const auto result =
+      pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+  LOG_IF(WARNING, result != 0)
+      << "Failed to pin DriverExecutor thread to NUMA node " << node.id
+      << ": " << result;
+#endif
+}
+} // namespace
+
+std::vector<int32_t> parseCpuList(std::string_view cpuList) {
+  std::vector<int32_t> cpus;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(cpuList), ranges, true);
+  for (const auto& range : ranges) {
+    const auto dash = range.find('-');
+    const auto first = folly::to<int32_t>(range.subpiece(0, dash));
+    const auto last = dash == folly::StringPiece::npos
+        ? first
+        : folly::to<int32_t>(range.subpiece(dash + 1));
+    VELOX_CHECK_LE(first, last, "Bad CPU list: {}", cpuList);
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::vector<NumaNode> numaTopology() {
+  std::vector<NumaNode> nodes;
+  for (int32_t id = 0;; ++id) {
+    std::ifstream file(
+        fmt::format("/sys/devices/system/node/node{}/cpulist", id));
+    if (!file.is_open()) {
+      break;
+    }
+    std::string cpuList;
+    std::getline(file, cpuList);
+    nodes.push_back({id, parseCpuList(cpuList)});
+  }
+  if (nodes.empty()) {
+    NumaNode node{0, {}};
+    const int32_t numCpus = std::max(1u, std::thread::hardware_concurrency());
+    for (auto cpu = 0; cpu < numCpus; ++cpu) {
+      node.cpus.push_back(cpu);
+    }
+    nodes.push_back(std::move(node));
+  }
+  return nodes;
+}
+
+DriverExecutor::DriverExecutor(Options options)
+    : nodes_(makeNodes(std::move(options.nodes))),
+      nodeWorkers_(nodes_.size()),
+      nextWorker_(nodes_.size() + 1) {
+  int32_t numThreads = options.numThreads;
+  if (numThreads == 0) {
+    for (const auto& node : nodes_) {
+      numThreads += node.cpus.size();
+    }
+  }
+  VELOX_CHECK_GT(numThreads, 0);
+  // Worker i is on node i % number of nodes.
+  for (auto i = 0; i < numThreads; ++i) {
+    const int32_t nodeIndex = i % nodes_.size();
+    nodeWorkers_[nodeIndex].push_back(i);
+    workers_.push_back(std::make_unique<Worker>(nodeIndex));
+  }
+  for (auto i = 0; i < numThreads; ++i) {
+    auto& worker = *workers_[i];
+    worker.thread = std::thread([this, i, prefix = options.threadNamePrefix]() {
+      folly::setThreadName(fmt::format("{}{}", prefix, i));
+      run(i);
+    });
+    if (options.pinThreads) {
+      pinThread(worker.thread, nodes_[worker.nodeIndex]);
+    }
+  }
+}
+
+DriverExecutor::~DriverExecutor() {
+  joinKeepAlive();
+  {
+    std::lock_guard<std::mutex> l(sleepMutex_);
+    stop_ = true;
+  }
+  sleepCv_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+// static
+int32_t DriverExecutor::currentNodeIndex() {
+  return currentWorkerNodeIndex;
+}
+
+int32_t DriverExecutor::currentWorker() const {
+  return currentExecutor == this ? currentWorkerIndex : -1;
+}
+
+void DriverExecutor::add(folly::Func func) {
+  auto worker = currentWorker();
+  if (worker < 0) {
+    worker = nextWorker_.back()++ % workers_.size();
+  }
+  enqueue(worker, std::move(func), nullptr);
+}
+
+void DriverExecutor::addWithAffinity(
+    folly::Func func,
+    uint64_t affinity,
+    std::shared_ptr<SchedulingGroup> group) {
+  const auto nodeIndex = this->nodeIndex(affinity);
+  auto worker = currentWorker();
+  if (worker < 0 || workers_[worker]->nodeIndex != nodeIndex) {
+    const auto& candidates = nodeWorkers_[nodeIndex];
+    worker = candidates[nextWorker_[nodeIndex]++ % candidates.size()];
+  }
+  enqueue(worker, std::move(func), std::move(group));
+}
+
+std::shared_ptr<SchedulingGroup> DriverExecutor::schedulingGroup(
+    const std::string& queryId,
+    int32_t weight) {
+  std::lock_guard<std::mutex> l(groupsMutex_);
+  auto& group = groups_[queryId];
+  if (auto existing = group.lock()) {
+    return existing;
+  }
+  auto newGroup = std::make_shared<SchedulingGroup>(weight);
+  group = newGroup;
+  // Drops the groups of finished queries.
+  std::erase_if(
+      groups_, [](const auto& pair) { return pair.second.expired(); });
+  return newGroup;
+}
+
+// static
+int32_t DriverExecutor::level(const SchedulingGroup* group) {
+  if (group == nullptr) {
+    return 0;
+  }
+  const auto weightedCpuNanos = group->weightedCpuNanos();
+  int32_t level = 0;
+  while (level + 1 < kNumLevels &&
+         weightedCpuNanos >= kLevelThresholdNanos[level + 1]) {
+    ++level;
+  }
+  return level;
+}
+
+void DriverExecutor::activateLevel(int32_t level) {
+  // The CPU time of a level over its share is levelCpuNanos_ << level.
+  uint64_t minNormalized = std::numeric_limits<uint64_t>::max();
+  for (auto other = 0; other < kNumLevels; ++other) {
+    if (other != level && levelNumQueued_[other] > 0) {
+      minNormalized =
+          std::min<uint64_t>(minNormalized, levelCpuNanos_[other] << other);
+    }
+  }
+  if (minNormalized == std::numeric_limits<uint64_t>::max()) {
+    return;
+  }
+  const uint64_t target = minNormalized >> level;
+  auto current = levelCpuNanos_[level].load();
+  while (current < target &&
+         !levelCpuNanos_[level].compare_exchange_weak(current, target)) {
+  }
+}
+
+void DriverExecutor::enqueue(
+    int32_t worker,
+    folly::Func func,
+    std::shared_ptr<SchedulingGroup> group) {
+  const auto level = DriverExecutor::level(group.get());
+  if (levelNumQueued_[level]++ == 0) {
+    activateLevel(level);
+  }
+  {
+    std::lock_guard<std::mutex> l(workers_[worker]->mutex);
+    workers_[worker]->queues[level].push_back(
+        {std::move(func), std::move(group)});
+  }
+  ++numQueued_;
+  if (numSleeping_ > 0) {
+    // Taking the mutex makes sure that a worker that is about to sleep either
+    // sees 'numQueued_' or is waiting on 'sleepCv_'.
+    std::lock_guard<std::mutex> l(sleepMutex_);
+    sleepCv_.notify_one();
+  }
+}
+
+bool DriverExecutor::take(int32_t worker, Entry& entry, int32_t& level) {
+  auto& victim = *workers_[worker];
+  std::lock_guard<std::mutex> l(victim.mutex);
+  level = -1;
+  uint64_t minNormalized = std::numeric_limits<uint64_t>::max();
+  for (auto i = 0; i < kNumLevels; ++i) {
+    if (victim.queues[i].empty()) {
+      continue;
+    }
+    const uint64_t normalized = levelCpuNanos_[i] << i;
+    if (level < 0 || normalized < minNormalized) {
+      level = i;
+      minNormalized = normalized;
+    }
+  }
+  if (level < 0) {
+    return false;
+  }
+  auto& queue = victim.queues[level];
+  entry = std::move(queue.front());
+  queue.pop_front();
+  --levelNumQueued_[level];
+  --numQueued_;
+  return true;
+}
+
+bool DriverExecutor::next(int32_t worker, Entry& entry, int32_t& level) {
+  if (take(worker, entry, level)) {
+    return true;
+  }
+  const auto nodeIndex = workers_[worker]->nodeIndex;
+  const auto& sameNode = nodeWorkers_[nodeIndex];
+  for (auto other : sameNode) {
+    if (other != worker && take(other, entry, level)) {
+      ++numStolen_;
+      return true;
+    }
+  }
+  for (auto i = 1; i < nodes_.size(); ++i) {
+    for (auto other : nodeWorkers_[(nodeIndex + i) % nodes_.size()]) {
+      if (take(other, entry, level)) {
+        ++numStolen_;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void DriverExecutor::run(int32_t worker) {
+  currentExecutor = this;
+  currentWorkerIndex = worker;
+  currentWorkerNodeIndex = workers_[worker]->nodeIndex;
+  Entry entry;
+  int32_t level;
+  for (;;) {
+    if (next(worker, entry, level)) {
+      const auto startNanos = process::threadCpuNanos();
+      try {
+        entry.func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "DriverExecutor function threw: " << e.what();
+      }
+      const auto cpuNanos = process::threadCpuNanos() - startNanos;
+      levelCpuNanos_[level] += cpuNanos;
+      if (entry.group != nullptr) {
+        entry.group->addCpuNanos(cpuNanos);
+      }
+      entry = {};
+      continue;
+    }
+    std::unique_lock<std::mutex> l(sleepMutex_);
+    ++numSleeping_;
+    sleepCv_.wait(l, [&]() { return stop_ || numQueued_ > 0; });
+    --numSleeping_;
+    if (stop_ && numQueued_ == 0) {
+      return;
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/DefaultKeepAliveExecutor.h>
+#include <folly/Function.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+
+/// The CPUs of a NUMA node.
+struct NumaNode {
+  int32_t id;
+  std::vector<int32_t> cpus;
+};
+
+/// Parses a CPU list like "0-3,8,10-11" as in
+/// /sys/devices/system/node/node<N>/cpulist.
+std::vector<int32_t> parseCpuList(std::string_view cpuList);
+
+/// Returns the NUMA nodes of the machine from /sys/devices/system/node. If
+/// these are not available, returns a single node with all CPUs.
+std::vector<NumaNode> numaTopology();
+
+/// The Drivers of a query that DriverExecutor schedules together. Keeps the CPU
+/// time of the functions of the group that ran on the executor. A group with a
+/// larger weight gets a larger share of the CPU.
+class SchedulingGroup {
+ public:
+  explicit SchedulingGroup(int32_t weight) : weight_(weight) {
+    VELOX_CHECK_GT(weight, 0);
+  }
+
+  int32_t weight() const {
+    return weight_;
+  }
+
+  uint64_t cpuNanos() const {
+    return cpuNanos_;
+  }
+
+  void addCpuNanos(uint64_t nanos) {
+    cpuNanos_ += nanos;
+  }
+
+  /// CPU time over weight. Decides the level of the group in DriverExecutor.
+  uint64_t weightedCpuNanos() const {
+    return cpuNanos_ / weight_;
+  }
+
+ private:
+  const int32_t weight_;
+  std::atomic<uint64_t> cpuNanos_{0};
+};
+
+/// Executor for Drivers with a run queue per thread and work stealing. The
+/// threads are spread over NUMA nodes and may be pinned to the CPUs of their
+/// node. Drivers that are added with the same affinity, e.g. all Drivers of a
+/// pipeline of a Task, are queued on the threads of the same node, so that
+/// they share the caches and the local memory of the node. Memory that a
+/// Driver allocates and touches first is then local to the node by the
+/// default first touch policy of the OS. A thread with an empty queue steals
+/// from the threads of its own node first and then from the other nodes, so
+/// that no thread idles while there is work.
+///
+/// The queues are multilevel feedback queues. A function added with a
+/// SchedulingGroup goes to the level of the weighted CPU time of its group, so
+/// that the Drivers of a query move to lower levels as the query uses CPU. A
+/// thread takes from the level that has used the least CPU relative to its
+/// share, and each level has half the share of the level above. This way short
+/// queries are not starved by long running ones. A query with weight N runs N
+/// times as long before it goes down a level.
+///
+/// Driver::enqueue() uses addWithAffinity() with the SchedulingGroup of the
+/// query if the executor of the QueryCtx is a DriverExecutor.
+class DriverExecutor : public folly::DefaultKeepAliveExecutor {
+ public:
+  static constexpr int32_t kNumLevels = 5;
+
+  /// The weighted CPU time of a SchedulingGroup from which on its functions
+  /// go to each level.
+  static constexpr std::array<uint64_t, kNumLevels> kLevelThresholdNanos = {
+      0,
+      1'000'000'000,
+      10'000'000'000,
+      60'000'000'000,
+      300'000'000'000};
+
+  struct Options {
+    /// Number of threads. Spread evenly over 'nodes'. 0 means one per CPU.
+    int32_t numThreads{0};
+
+    /// The NUMA nodes to place the threads on. Empty means numaTopology().
+    std::vector<NumaNode> nodes;
+
+    /// If true, each thread is pinned to the CPUs of its node. Only on Linux.
+    bool pinThreads{true};
+
+    std::string threadNamePrefix{"Driver"};
+  };
+
+  explicit DriverExecutor(Options options);
+
+  ~DriverExecutor() override;
+
+  /// Queues 'func' on the calling thread if it is a thread of 'this' and on
+  /// the threads round robin otherwise.
+  void add(folly::Func func) override;
+
+  /// Queues 'func' on a thread of the node for 'affinity'. If the calling
+  /// thread is a thread of that node, 'func' is queued on it. If 'group' is
+  /// set, 'func' goes to the level of 'group' and its CPU time is added to
+  /// 'group'. Otherwise 'func' goes to the first level.
+  void addWithAffinity(
+      folly::Func func,
+      uint64_t affinity,
+      std::shared_ptr<SchedulingGroup> group = nullptr);
+
+  /// Returns the SchedulingGroup for 'queryId'. Makes a group with 'weight'
+  /// if there is none. The group lives as long as there are references to it.
+  std::shared_ptr<SchedulingGroup> schedulingGroup(
+      const std::string& queryId,
+      int32_t weight);
+
+  /// Returns the level of the functions of 'group'.
+  static int32_t level(const SchedulingGroup* group);
+
+  /// CPU time of the functions that ran from 'level', adjusted up when the
+  /// level gets work after being empty.
+  uint64_t levelCpuNanos(int32_t level) const {
+    return levelCpuNanos_[level];
+  }
+
+  /// Returns the index of the node in 'nodes()' for 'affinity'. Worker i is
+  /// on node i % nodes().size(), so with fewer threads than nodes only the
+  /// first nodes have threads.
+  int32_t nodeIndex(uint64_t affinity) const {
+    return affinity % std::min(nodes_.size(), workers_.size());
+  }
+
+  const std::vector<NumaNode>& nodes() const {
+    return nodes_;
+  }
+
+  int32_t numThreads() const {
+    return workers_.size();
+  }
+
+  /// Number of functions that ran on a thread other than the one they were
+  /// queued on.
+  uint64_t numStolen() const {
+    return numStolen_;
+  }
+
+  /// Returns the index of the node of the calling thread in 'nodes()' of its
+  /// DriverExecutor, or -1 if the caller is not a thread of a DriverExecutor.
+  static int32_t currentNodeIndex();
+
+ private:
+  struct Entry {
+    folly::Func func;
+    std::shared_ptr<SchedulingGroup> group;
+  };
+
+  struct Worker {
+    explicit Worker(int32_t _nodeIndex) : nodeIndex(_nodeIndex) {}
+
+    const int32_t nodeIndex;
+    std::mutex mutex;
+    std::array<std::deque<Entry>, kNumLevels> queues;
+    std::thread thread;
+  };
+
+  // Returns the index of the worker that is the calling thread, or -1.
+  int32_t currentWorker() const;
+
+  void enqueue(
+      int32_t worker,
+      folly::Func func,
+      std::shared_ptr<SchedulingGroup> group);
+
+  // Raises the CPU time of 'level' when it gets work after being empty, so
+  // that it does not take more than its share for catching up on the time it
+  // was empty.
+  void activateLevel(int32_t level);
+
+  // Takes the first function from the level of the queue of 'worker' that is
+  // the furthest behind its share. Returns false if the queue is empty.
+  bool take(int32_t worker, Entry& entry, int32_t& level);
+
+  // Takes a function from the queue of 'worker' or steals one, first from the
+  // same node and then from the other nodes.
+  bool next(int32_t worker, Entry& entry, int32_t& level);
+
+  void run(int32_t worker);
+
+  const std::vector<NumaNode> nodes_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Indices in 'workers_' of the workers of each node.
+  std::vector<std::vector<int32_t>> nodeWorkers_;
+  // Round robin counters for adding from outside of the workers, one for each
+  // node and one more for add().
+  std::vector<std::atomic<uint32_t>> nextWorker_;
+
+  // Number of queued functions. Incremented before waking a sleeping worker
+  // and read by a worker before it sleeps, so that one of the two sees the
+  // other.
+  std::atomic<int64_t> numQueued_{0};
+  std::atomic<int32_t> numSleeping_{0};
+  std::atomic<uint64_t> numStolen_{0};
+  std::array<std::atomic<uint64_t>, kNumLevels> levelCpuNanos_{};
+  std::array<std::atomic<int64_t>, kNumLevels> levelNumQueued_{};
+
+  std::mutex groupsMutex_;
+  std::unordered_map<std::string, std::weak_ptr<SchedulingGroup>> groups_;
+
+  std::mutex sleepMutex_;
+  std::condition_variable sleepCv_;
+  bool stop_{false};
+};
+
+} // namespace facebook::velox::exec
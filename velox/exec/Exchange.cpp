@@ -179,6 +179,10 @@ bool Exchange::isFinished() {
 }
 
 RowVectorPtr Exchange::getOutput() {
+  if (inputStream_ == nullptr && columnarPageIdx_ < currentPages_.size() &&
+      currentPages_[columnarPageIdx_]->vector() != nullptr) {
+    return getOutputFromVectorPages();
+  }
   auto* serde = getSerde();
   if (serde->supportsAppendInDeserialize()) {
     return getOutputFromColumnarPages(serde);
@@ -321,6 +325,51 @@ RowVectorPtr Exchange::getOutputFromRowPages(VectorSerde* serde) {
   return result_;
 }
 
+RowVectorPtr Exchange::getOutputFromVectorPages() {
+  const auto maxRows = estimatedRowSize_.has_value()
+      ? std::max(
+            (preferredOutputBatchBytes_ / estimatedRowSize_.value()),
+            kInitialOutputRows)
+      : kInitialOutputRows;
+
+  // Takes whole pages, at least one.
+  uint64_t rawInputBytes = 0;
+  vector_size_t numRows = 0;
+  auto endPageIdx = columnarPageIdx_;
+  while (endPageIdx < currentPages_.size() && numRows < maxRows) {
+    const auto& page = currentPages_[endPageIdx];
+    VELOX_CHECK_NOT_NULL(
+        page->vector(), "Serialized page mixed with VectorPages");
+    numRows += page->numRows().value();
+    rawInputBytes += page->size();
+    ++endPageIdx;
+  }
+
+  // The vectors are in the memory of the producer. The copy is in the memory
+  // of this operator and the pages are freed right after.
+  result_ = BaseVector::create<RowVector>(outputType_, numRows, pool());
+  vector_size_t offset = 0;
+  for (; columnarPageIdx_ < endPageIdx; ++columnarPageIdx_) {
+    auto& page = currentPages_[columnarPageIdx_];
+    const auto& vector = page->vector();
+    result_->copy(vector.get(), offset, 0, vector->size());
+    offset += vector->size();
+    page.reset();
+  }
+
+  VELOX_CHECK_GT(numRows, 0);
+  estimatedRowSize_ = std::max(
+      result_->estimateFlatSize() / numRows, estimatedRowSize_.value_or(1L));
+
+  if (columnarPageIdx_ >= currentPages_.size()) {
+    currentPages_.clear();
+    columnarPageIdx_ = 0;
+  }
+
+  recordInputStats(rawInputBytes);
+  return result_;
+}
+
 void Exchange::recordInputStats(uint64_t rawInputBytes) {
   auto lockedStats = stats_.wlock();
   lockedStats->rawInputBytes += rawInputBytes;
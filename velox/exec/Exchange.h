@@ -95,6 +95,10 @@ class Exchange : public SourceOperator {
 
   RowVectorPtr getOutputFromRowPages(VectorSerde* serde);
 
+  // Copies the vectors of VectorPages in 'currentPages_' into 'result_' until
+  // it has about preferredOutputBatchBytes_.
+  RowVectorPtr getOutputFromVectorPages();
+
   const uint64_t preferredOutputBatchBytes_;
 
   const std::string serdeKind_;
@@ -15,6 +15,8 @@
  */
 #include "velox/exec/ExchangeClient.h"
 
+#include <limits>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 
@@ -140,6 +142,20 @@ ExchangeClient::collectStatsLocked() const {
       "averageReceivedPageBytes",
       RuntimeMetric(
           queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes));
+  if (flowControl_) {
+    stats.insert_or_assign(
+        "exchangeCreditBytes",
+        RuntimeMetric(creditBytes_, RuntimeCounter::Unit::kBytes));
+    stats.insert_or_assign(
+        "numExchangeCreditIncreases", RuntimeMetric(numCreditIncreases_));
+    stats.insert_or_assign(
+        "numExchangeCreditDecreases", RuntimeMetric(numCreditDecreases_));
+    stats.insert_or_assign(
+        "numExchangeCreditLimitedRequests",
+        RuntimeMetric(numCreditLimitedRequests_));
+    stats.insert_or_assign(
+        "numExchangeConsumerWaits", RuntimeMetric(queue_->numConsumerWaits()));
+  }
 
   return stats;
 }
@@ -166,7 +182,7 @@ std::vector<std::unique_ptr<SerializedPageBase>> ExchangeClient::next(
       return pages;
     }
 
-    if (!pages.empty() && queue_->totalBytes() > maxQueuedBytes_) {
+    if (!pages.empty() && queue_->totalBytes() > capacityLocked()) {
       return pages;
     }
 
@@ -257,6 +273,9 @@ ExchangeClient::pickSourcesToRequestLocked() {
   if (closed_) {
     return {};
   }
+  if (flowControl_) {
+    updateCreditLocked();
+  }
   if (skipRequestDataSizeWithSingleSource()) {
     return pickupSingleSourceToRequestLocked();
   }
@@ -268,11 +287,20 @@ ExchangeClient::pickSourcesToRequestLocked() {
     emptySources_.pop();
   }
   int64_t availableSpace =
-      maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
+      capacityLocked() - queue_->totalBytes() - totalPendingBytes_;
+  // With flow control, a request gets at most an even share of the credit, so
+  // that a source with much data does not take the capacity from the others.
+  const int64_t sourceCredit = flowControl_
+      ? creditBytes_ / std::max<int64_t>(1, producingSources_.size())
+      : std::numeric_limits<int64_t>::max();
   while (availableSpace > 0 && !producingSources_.empty()) {
     auto& source = producingSources_.front().source;
     int64_t requestBytes = 0;
     for (auto bytes : producingSources_.front().remainingBytes) {
+      if (requestBytes > 0 && requestBytes + bytes > sourceCredit) {
+        ++numCreditLimitedRequests_;
+        break;
+      }
       availableSpace -= bytes;
       if (availableSpace < 0) {
         break;
@@ -321,7 +349,7 @@ ExchangeClient::pickupSingleSourceToRequestLocked() {
 
   VELOX_CHECK_EQ(totalPendingBytes_, 0);
   VELOX_CHECK_LE(!!emptySources_.empty() + !!producingSources_.empty(), 1);
-  const auto requestBytes = maxQueuedBytes_ - queue_->totalBytes();
+  const auto requestBytes = capacityLocked() - queue_->totalBytes();
 
   if (requestBytes <= 0) {
     return {};
@@ -348,6 +376,29 @@ ExchangeClient::pickupSingleSourceToRequestLocked() {
   return requestSpecs;
 }
 
+void ExchangeClient::updateCreditLocked() {
+  if (queue_->hasWaitingConsumersLocked()) {
+    if (creditBytes_ < maxQueuedBytes_) {
+      creditBytes_ = std::min(maxQueuedBytes_, creditBytes_ * 2);
+      ++numCreditIncreases_;
+    }
+    return;
+  }
+  const auto consumedBytesPerSecond = queue_->consumedBytesPerSecond();
+  if (consumedBytesPerSecond == 0) {
+    return;
+  }
+  const int64_t minCreditBytes = std::min<int64_t>(
+      maxQueuedBytes_,
+      std::max<int64_t>(kMinCreditBytes, 2 * minOutputBatchBytes_));
+  const int64_t targetBytes = std::max(
+      minCreditBytes, consumedBytesPerSecond * kMaxQueuedTimeMs / 1'000);
+  if (queue_->totalBytes() > targetBytes && creditBytes_ > targetBytes) {
+    creditBytes_ = std::max(targetBytes, creditBytes_ / 2);
+    ++numCreditDecreases_;
+  }
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
@@ -26,6 +26,11 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
  public:
   static constexpr int32_t kDefaultMaxQueuedBytes = 32 << 20; // 32 MB.
   static constexpr std::chrono::milliseconds kRequestDataMaxWait{100};
+  /// With flow control, the credit is lowered while the queue holds more data
+  /// than consumers take in this time.
+  static constexpr int64_t kMaxQueuedTimeMs = 1'000;
+  /// Lower bound of the credit with flow control, if 'maxQueuedBytes' allows.
+  static constexpr int64_t kMinCreditBytes = 1 << 20;
 
   ExchangeClient(
       std::string taskId,
@@ -37,7 +42,8 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
       folly::Executor* executor,
       int32_t requestDataSizesMaxWaitSec = 10,
       bool skipRequestDataSizeWithSingleSource = false,
-      bool lazyFetching = false)
+      bool lazyFetching = false,
+      bool flowControl = false)
       : taskId_{std::move(taskId)},
         destination_(destination),
         maxQueuedBytes_{maxQueuedBytes},
@@ -57,7 +63,9 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
             std::max(static_cast<uint64_t>(1), minOutputBatchBytes)),
         skipRequestDataSizeWithSingleSource_(
             skipRequestDataSizeWithSingleSource),
-        lazyFetching_(lazyFetching) {
+        lazyFetching_(lazyFetching),
+        flowControl_(flowControl),
+        creditBytes_(maxQueuedBytes) {
     VELOX_CHECK_NOT_NULL(pool_);
     VELOX_CHECK_NOT_NULL(executor_);
     // NOTE: the executor is used to run async response callback from the
@@ -156,6 +164,19 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // capacity is unavailable or requests are already pending, returns empty
   // vector.
   std::vector<RequestSpec> pickupSingleSourceToRequestLocked();
+
+  // Returns the number of bytes that may be queued or in flight. This is
+  // 'creditBytes_' with flow control, else 'maxQueuedBytes_'.
+  int64_t capacityLocked() const {
+    return flowControl_ ? creditBytes_ : maxQueuedBytes_;
+  }
+
+  // Adjusts 'creditBytes_' to the consumers. Doubles the credit up to
+  // 'maxQueuedBytes_' while a consumer waits for data. Halves it, but not
+  // below what consumers take in kMaxQueuedTimeMs, while the queue holds more
+  // than that.
+  void updateCreditLocked();
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   /// Returns true if skip request data size optimization is enabled for single
@@ -196,6 +217,19 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   // added.
   const bool lazyFetching_;
 
+  // If true, the bytes queued and in flight are limited by 'creditBytes_'
+  // instead of 'maxQueuedBytes_' and each request by an even share of the
+  // credit among the producing sources.
+  const bool flowControl_;
+
+  // The bytes that may be queued and in flight if 'flowControl_'.
+  int64_t creditBytes_;
+  int64_t numCreditIncreases_{0};
+  int64_t numCreditDecreases_{0};
+  // Number of requests that got less than the remaining bytes of the source
+  // because of the per source share of the credit.
+  int64_t numCreditLimitedRequests_{0};
+
   // Total number of bytes in flight.
   int64_t totalPendingBytes_{0};
 
@@ -17,6 +17,7 @@
 #include <algorithm>
 
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -89,10 +90,30 @@ void ExchangeQueue::enqueueLocked(
   }
 }
 
+void ExchangeQueue::recordConsumedLocked(int64_t bytes) {
+  const auto nowUs = getCurrentTimeMicro();
+  if (rateIntervalStartUs_ == 0) {
+    rateIntervalStartUs_ = nowUs;
+  }
+  rateIntervalBytes_ += bytes;
+  const int64_t elapsedUs = nowUs - rateIntervalStartUs_;
+  if (elapsedUs < kRateIntervalUs) {
+    return;
+  }
+  const int64_t rate = rateIntervalBytes_ * 1'000'000 / elapsedUs;
+  // The latest interval weighs 1/4.
+  consumedBytesPerSecond_ = consumedBytesPerSecond_ == 0
+      ? rate
+      : (3 * consumedBytesPerSecond_ + rate) / 4;
+  rateIntervalStartUs_ = nowUs;
+  rateIntervalBytes_ = 0;
+}
+
 void ExchangeQueue::addPromiseLocked(
     int consumerId,
     ContinueFuture* future,
     ContinuePromise* stalePromise) {
+  ++numConsumerWaits_;
   ContinuePromise promise{"ExchangeQueue::dequeue"};
   *future = promise.getSemiFuture();
   auto it = promises_.find(consumerId);
@@ -138,10 +159,14 @@ std::vector<std::unique_ptr<SerializedPageBase>> ExchangeQueue::dequeueLocked(
       } else if (pages.empty()) {
         addPromiseLocked(consumerId, future, stalePromise);
       }
+      if (pageBytes > 0) {
+        recordConsumedLocked(pageBytes);
+      }
       return pages;
     }
 
     if (pageBytes > 0 && pageBytes + queue_.front()->size() > maxBytes) {
+      recordConsumedLocked(pageBytes);
       return pages;
     }
 
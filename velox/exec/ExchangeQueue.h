@@ -100,6 +100,23 @@ class ExchangeQueue {
     return receivedPages_ > 0 ? receivedBytes_ / receivedPages_ : 0;
   }
 
+  /// Returns the rate at which consumers dequeue data in bytes per second,
+  /// smoothed over intervals of at least kRateIntervalUs. 0 until the first
+  /// interval completes.
+  int64_t consumedBytesPerSecond() const {
+    return consumedBytesPerSecond_;
+  }
+
+  /// Returns the number of times a consumer found too little data and waited.
+  int64_t numConsumerWaits() const {
+    return numConsumerWaits_;
+  }
+
+  /// Returns true if a consumer is waiting for data.
+  bool hasWaitingConsumersLocked() const {
+    return !promises_.empty();
+  }
+
   void addSourceLocked() {
     VELOX_CHECK(!noMoreSources_, "addSource called after noMoreSources");
     numSources_++;
@@ -162,6 +179,11 @@ class ExchangeQueue {
 
   int64_t minOutputBatchBytesLocked() const;
 
+  // Adds 'bytes' dequeued by a consumer to the consumption rate.
+  void recordConsumedLocked(int64_t bytes);
+
+  static constexpr int64_t kRateIntervalUs = 100'000;
+
   const int32_t numberOfConsumers_;
   const uint64_t minOutputBatchBytes_;
 
@@ -190,5 +212,10 @@ class ExchangeQueue {
   int64_t receivedBytes_{0};
   // Maximum value of totalBytes_.
   int64_t peakBytes_{0};
+  int64_t numConsumerWaits_{0};
+  // Start of the current rate interval and bytes dequeued in it.
+  uint64_t rateIntervalStartUs_{0};
+  int64_t rateIntervalBytes_{0};
+  int64_t consumedBytesPerSecond_{0};
 };
 } // namespace facebook::velox::exec
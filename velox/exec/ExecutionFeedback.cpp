@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/ExecutionFeedback.h"
+
+#include <folly/json.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/exec/HashAggregation.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Adds the fingerprints of 'node', a serialized plan node, and of its sources
+// to 'fingerprints'. Returns the fingerprint of 'node'. Erases the ids and the
+// sources from 'node'.
+uint64_t addFingerprints(
+    folly::dynamic& node,
+    folly::F14FastMap<core::PlanNodeId, uint64_t>& fingerprints) {
+  uint64_t fingerprint = 0;
+  if (auto* sources = node.get_ptr("sources")) {
+    for (auto& source : *sources) {
+      fingerprint =
+          bits::hashMix(fingerprint, addFingerprints(source, fingerprints));
+    }
+    node.erase("sources");
+  }
+  const auto id = node["id"].asString();
+  node.erase("id");
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  const auto json = folly::json::serialize(node, opts);
+  fingerprint = bits::hashMix(fingerprint, std::hash<std::string>()(json));
+  fingerprints[id] = fingerprint;
+  return fingerprint;
+}
+} // namespace
+
+double PlanNodeFeedback::selectivity() const {
+  return inputRows == 0 ? 1 : outputRows / static_cast<double>(inputRows);
+}
+
+std::string PlanNodeFeedback::toString() const {
+  return fmt::format(
+      "inputRows: {} rawInputRows: {} outputRows: {} maxNumDistinct: {} "
+      "abandonedPartialAggregation: {} spilledBytes: {} numRuns: {}",
+      inputRows,
+      rawInputRows,
+      outputRows,
+      maxNumDistinct,
+      abandonedPartialAggregation,
+      spilledBytes,
+      numRuns);
+}
+
+ExecutionFeedback::ExecutionFeedback(size_t maxEntries)
+    : entries_(maxEntries) {}
+
+// static
+ExecutionFeedback* ExecutionFeedback::instance() {
+  static ExecutionFeedback instance;
+  return &instance;
+}
+
+// static
+folly::F14FastMap<core::PlanNodeId, uint64_t> ExecutionFeedback::fingerprints(
+    const core::PlanNode& plan) {
+  folly::F14FastMap<core::PlanNodeId, uint64_t> result;
+  folly::dynamic serialized;
+  try {
+    serialized = plan.serialize();
+  } catch (const std::exception&) {
+    // A node of 'plan' does not support serialization.
+    for (const auto& source : plan.sources()) {
+      auto sourceFingerprints = fingerprints(*source);
+      result.insert(sourceFingerprints.begin(), sourceFingerprints.end());
+    }
+    return result;
+  }
+  addFingerprints(serialized, result);
+  return result;
+}
+
+std::optional<PlanNodeFeedback> ExecutionFeedback::find(
+    uint64_t fingerprint) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.findWithoutPromotion(fingerprint);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void ExecutionFeedback::record(
+    uint64_t fingerprint,
+    PlanNodeFeedback feedback) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.findWithoutPromotion(fingerprint);
+  feedback.numRuns = it == entries_.end() ? 1 : it->second.numRuns + 1;
+  entries_.set(fingerprint, feedback);
+}
+
+void ExecutionFeedback::record(
+    const folly::F14FastMap<core::PlanNodeId, uint64_t>& fingerprints,
+    const std::unordered_map<core::PlanNodeId, PlanNodeStats>& stats) {
+  for (const auto& [planNodeId, nodeStats] : stats) {
+    auto it = fingerprints.find(planNodeId);
+    if (it == fingerprints.end()) {
+      continue;
+    }
+    PlanNodeFeedback feedback;
+    feedback.inputRows = nodeStats.inputRows;
+    feedback.rawInputRows = nodeStats.rawInputRows;
+    feedback.outputRows = nodeStats.outputRows;
+    feedback.spilledBytes = nodeStats.spilledBytes;
+    const auto& customStats = nodeStats.customStats;
+    auto numDistinct =
+        customStats.find(std::string(BaseHashTable::kNumDistinct));
+    if (numDistinct != customStats.end()) {
+      feedback.maxNumDistinct = std::max<int64_t>(numDistinct->second.max, 0);
+    }
+    feedback.abandonedPartialAggregation =
+        customStats.count(
+            std::string(HashAggregation::kAbandonedPartialAggregation)) > 0;
+    record(it->second, feedback);
+  }
+}
+
+size_t ExecutionFeedback::size() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return entries_.size();
+}
+
+void ExecutionFeedback::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+}
+
+} // namespace facebook::velox::exec
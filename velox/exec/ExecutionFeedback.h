@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <folly/container/EvictingCacheMap.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/PlanNodeStats.h"
+
+namespace facebook::velox::exec {
+
+/// What the last finished run of a plan node observed.
+struct PlanNodeFeedback {
+  uint64_t inputRows{0};
+  uint64_t rawInputRows{0};
+  uint64_t outputRows{0};
+  /// The most distinct keys in the hash table of one driver of a hash
+  /// aggregation or hash join. 0 for nodes without a hash table.
+  uint64_t maxNumDistinct{0};
+  /// True if a driver of a partial aggregation abandoned it.
+  bool abandonedPartialAggregation{false};
+  uint64_t spilledBytes{0};
+  /// The number of finished runs recorded.
+  uint64_t numRuns{0};
+
+  /// The fraction of the input rows output, e.g. the selectivity of a filter.
+  /// 1 if there was no input.
+  double selectivity() const;
+
+  std::string toString() const;
+};
+
+/// Process-wide store of the PlanNodeFeedback of finished tasks, keyed by a
+/// fingerprint of the plan node and its sources that does not depend on plan
+/// node ids. The tasks of recurring queries thereby start from what earlier
+/// runs of the same plan observed, e.g. with hash tables sized for the number
+/// of groups. Enabled by QueryConfig::kExecutionFeedbackEnabled. Holds the
+/// most recently recorded 'maxEntries' nodes. Thread safe.
+class ExecutionFeedback {
+ public:
+  explicit ExecutionFeedback(size_t maxEntries = 10'000);
+
+  static ExecutionFeedback* instance();
+
+  /// Returns the fingerprints of the nodes of 'plan' by plan node id. The
+  /// fingerprint of a node hashes its serialization without plan node ids and
+  /// the fingerprints of its sources. Nodes that do not support serialization
+  /// and the nodes above them have no fingerprint.
+  static folly::F14FastMap<core::PlanNodeId, uint64_t> fingerprints(
+      const core::PlanNode& plan);
+
+  /// Returns the feedback of the node with 'fingerprint', or nullopt.
+  std::optional<PlanNodeFeedback> find(uint64_t fingerprint) const;
+
+  /// Records 'feedback' for the node with 'fingerprint', replacing the
+  /// earlier record.
+  void record(uint64_t fingerprint, PlanNodeFeedback feedback);
+
+  /// Records the 'stats' of the nodes of a finished task that have
+  /// 'fingerprints'.
+  void record(
+      const folly::F14FastMap<core::PlanNodeId, uint64_t>& fingerprints,
+      const std::unordered_map<core::PlanNodeId, PlanNodeStats>& stats);
+
+  size_t size() const;
+
+  void clear();
+
+ private:
+  mutable std::mutex mutex_;
+  folly::EvictingCacheMap<uint64_t, PlanNodeFeedback> entries_;
+};
+
+} // namespace facebook::velox::exec
@@ -199,10 +199,22 @@ void FilterProject::initialize() {
       auto fieldIndex = inputType->getChildIdx(field->name());
       distinctFieldIndices.insert(fieldIndex);
     }
+    std::unordered_set<uint32_t> filterFieldIndices;
+    if (hasFilter_) {
+      for (auto field : exprs_->expr(0)->distinctFields()) {
+        filterFieldIndices.insert(inputType->getChildIdx(field->name()));
+      }
+    }
     for (auto identityField : identityProjections_) {
-      if (distinctFieldIndices.find(identityField.inputChannel) !=
-          distinctFieldIndices.end()) {
-        multiplyReferencedFieldIndices_.push_back(identityField.inputChannel);
+      const auto channel = identityField.inputChannel;
+      if (distinctFieldIndices.find(channel) == distinctFieldIndices.end()) {
+        continue;
+      }
+      if (hasFilter_ &&
+          filterFieldIndices.find(channel) == filterFieldIndices.end()) {
+        multiplyReferencedProjectFieldIndices_.push_back(channel);
+      } else {
+        multiplyReferencedFieldIndices_.push_back(channel);
       }
     }
   }
@@ -264,6 +276,9 @@ RowVectorPtr FilterProject::getOutput() {
     if (!allRowsSelected) {
       rows->setFromBits(filterEvalCtx_.selectedBits->as<uint64_t>(), size);
     }
+    for (auto fieldIdx : multiplyReferencedProjectFieldIndices_) {
+      evalCtx.ensureFieldLoaded(fieldIdx, *rows);
+    }
     results = project(*rows, evalCtx);
   }
 
@@ -125,7 +125,14 @@ class FilterProject : public Operator {
   // Consider projection with 2 expressions: f(c0) AND g(c1), c1
   // If c1 is a LazyVector and f(c0) AND g(c1) expression is evaluated first, it
   // will load c1 only for rows where f(c0) is true. However, c1 identity
-  // projection needs all rows.
+  // projection needs all rows. The fields that the filter references are
+  // loaded for all input rows before evaluating the filter. The others are in
+  // 'multiplyReferencedProjectFieldIndices_'.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  // The multiply referenced fields that only projections reference. These are
+  // loaded after the filter for the rows that passed it, since the identity
+  // projections wrap only these rows.
+  std::vector<column_index_t> multiplyReferencedProjectFieldIndices_;
 };
 } // namespace facebook::velox::exec
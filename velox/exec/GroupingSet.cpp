@@ -113,13 +113,27 @@ GroupingSet::GroupingSet(
         "Partial aggregations over sorted inputs are not supported");
   }
 
+  // With several distinct aggregates, per-group sets of distinct inputs are
+  // costly for many small groups. Optionally de-duplicate over all groups at
+  // once. This requires that the groups are not spilled.
+  const auto numDistinctAggregates = std::count_if(
+      aggregates_.begin(), aggregates_.end(), [](const auto& aggregate) {
+        return aggregate.distinct;
+      });
+  const bool sharedDistinct = numDistinctAggregates > 1 && !isGlobal_ &&
+      spillConfig_ == nullptr && queryConfig_ != nullptr &&
+      queryConfig_->aggregationSharedDistinctHashTableEnabled();
+
   for (auto& aggregate : aggregates_) {
     if (aggregate.distinct) {
       VELOX_USER_CHECK(
           !isPartial_,
           "Partial aggregations over distinct inputs are not supported");
       distinctAggregations_.emplace_back(
-          DistinctAggregations::create({&aggregate}, inputType, pool_));
+          sharedDistinct
+              ? DistinctAggregations::createShared(
+                    {&aggregate}, inputType, pool_)
+              : DistinctAggregations::create({&aggregate}, inputType, pool_));
     } else {
       distinctAggregations_.push_back(nullptr);
     }
@@ -128,6 +142,29 @@ GroupingSet::GroupingSet(
       hasCompactableAggregates_ = true;
     }
   }
+
+  if (isPartial_ && !isGlobal_ && !isDistinct() &&
+      preGroupedKeyChannels_.empty()) {
+    retainedGroupsPct_ = queryConfig_->partialAggregationRetainedGroupsPct();
+    VELOX_USER_CHECK(
+        retainedGroupsPct_ >= 0 && retainedGroupsPct_ < 100,
+        "{} must be in [0, 100): {}",
+        core::QueryConfig::kPartialAggregationRetainedGroupsPct,
+        retainedGroupsPct_);
+  }
+
+  if (!isGlobal_ && queryConfig_ != nullptr &&
+      queryConfig_->aggregationClusterRowsByGroupEnabled()) {
+    clusterRowsByGroup_ = !aggregates_.empty() && !sortedAggregations_;
+    for (const auto& aggregate : aggregates_) {
+      if (aggregate.distinct || aggregate.mask.has_value() ||
+          !aggregate.sortingKeys.empty() ||
+          !aggregate.function->supportsGroupRuns()) {
+        clusterRowsByGroup_ = false;
+        break;
+      }
+    }
+  }
 }
 
 GroupingSet::~GroupingSet() {
@@ -296,10 +333,14 @@ void GroupingSet::addInputForActiveRows(
   }
 
   table_->groupProbe(*lookup_, BaseHashTable::kNoSpillInputStartPartitionBit);
+  if (retainedGroupsPct_ > 0) {
+    updateGroupHits();
+  }
   masks_.addInput(input, activeRows_);
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
+  const auto numClusteredRows = clusterRowsByGroup();
 
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
@@ -330,6 +371,25 @@ void GroupingSet::addInputForActiveRows(
     }
 
     populateTempVectors(i, input);
+    if (numClusteredRows > 0) {
+      for (auto& vector : tempVectors_) {
+        vector = BaseVector::wrapInDictionary(
+            nullptr,
+            clusteredRowIndices_,
+            numClusteredRows,
+            BaseVector::loadedVectorShared(vector));
+      }
+      function->setGroupRuns(true);
+      if (isRawInput_) {
+        function->addRawInput(
+            clusteredGroups_.data(), clusteredRows_, tempVectors_, false);
+      } else {
+        function->addIntermediateResults(
+            clusteredGroups_.data(), clusteredRows_, tempVectors_, false);
+      }
+      function->setGroupRuns(false);
+      continue;
+    }
     // TODO(spershin): We disable the pushdown at the moment if selectivity
     // vector has changed after groups generation, we might want to revisit
     // this.
@@ -351,6 +411,115 @@ void GroupingSet::addInputForActiveRows(
   }
 }
 
+void GroupingSet::updateGroupHits() {
+  const auto* rows = table_->rows();
+  for (const auto row : lookup_->rows) {
+    char* group = lookup_->hits[row];
+    if (rows->count(group) < std::numeric_limits<int32_t>::max()) {
+      rows->incrementCount(group);
+    }
+  }
+}
+
+vector_size_t GroupingSet::clusterRowsByGroup() {
+  // Below these sizes the reordering costs more than the per-row accumulator
+  // updates it saves.
+  constexpr vector_size_t kMinRows = 1'000;
+  constexpr int32_t kMinRowsPerGroup = 4;
+  if (!clusterRowsByGroup_ ||
+      table_->hashMode() != BaseHashTable::HashMode::kArray) {
+    return 0;
+  }
+  const auto& rows = lookup_->rows;
+  const vector_size_t numRows = rows.size();
+  if (numRows < kMinRows ||
+      table_->capacity() > static_cast<uint64_t>(numRows) * kMinRowsPerGroup) {
+    return 0;
+  }
+
+  // In array mode the hash of a row is the index of its group in the table.
+  // Counting sort of the rows by that index gives runs of rows of the same
+  // group.
+  const auto& hashes = lookup_->hashes;
+  groupRowCounts_.assign(table_->capacity() + 1, 0);
+  int32_t numGroups = 0;
+  for (const auto row : rows) {
+    numGroups += groupRowCounts_[hashes[row] + 1]++ == 0;
+  }
+  if (static_cast<int64_t>(numGroups) * kMinRowsPerGroup > numRows) {
+    return 0;
+  }
+  for (auto i = 1; i < groupRowCounts_.size(); ++i) {
+    groupRowCounts_[i] += groupRowCounts_[i - 1];
+  }
+
+  if (clusteredRowIndices_ == nullptr || !clusteredRowIndices_->unique() ||
+      clusteredRowIndices_->capacity() < numRows * sizeof(vector_size_t)) {
+    clusteredRowIndices_ = allocateIndices(numRows, pool_);
+  }
+  auto* indices = clusteredRowIndices_->asMutable<vector_size_t>();
+  clusteredGroups_.resize(numRows);
+  for (const auto row : rows) {
+    const auto index = groupRowCounts_[hashes[row]]++;
+    indices[index] = row;
+    clusteredGroups_[index] = lookup_->hits[row];
+  }
+  clusteredRows_.resizeFill(numRows, true);
+  return numRows;
+}
+
+int64_t GroupingSet::startRetainingFlush() {
+  VELOX_CHECK(!retainingFlush_);
+  if (retainedGroupsPct_ == 0 || table_ == nullptr) {
+    return 0;
+  }
+  // A group must have had at least this many input rows to be kept.
+  constexpr int32_t kMinRetainedGroupRows = 2;
+  auto* rows = table_->rows();
+  const int64_t numGroups = rows->numRows();
+  const int64_t maxRetained = numGroups * retainedGroupsPct_ / 100;
+  if (maxRetained == 0) {
+    return 0;
+  }
+
+  std::vector<char*> groups(numGroups);
+  RowContainerIterator iter;
+  VELOX_CHECK_EQ(rows->listRows(&iter, numGroups, groups.data()), numGroups);
+  std::vector<int32_t> counts(numGroups);
+  for (auto i = 0; i < numGroups; ++i) {
+    counts[i] = rows->count(groups[i]);
+  }
+  std::nth_element(
+      counts.begin(),
+      counts.begin() + maxRetained - 1,
+      counts.end(),
+      std::greater<int32_t>());
+  const int32_t minCount =
+      std::max(counts[maxRetained - 1], 1 + kMinRetainedGroupRows);
+
+  flushGroups_.clear();
+  flushGroups_.reserve(numGroups - maxRetained);
+  int64_t numRetained{0};
+  for (auto* group : groups) {
+    const auto count = rows->count(group);
+    if (count >= minCount && numRetained < maxRetained) {
+      ++numRetained;
+      // Halve the count so that a group that stops being hot is flushed by a
+      // later flush.
+      rows->setCount(group, 1 + (count - 1) / 2);
+    } else {
+      flushGroups_.push_back(group);
+    }
+  }
+  if (numRetained == 0) {
+    flushGroups_.clear();
+    return 0;
+  }
+  flushGroupsCursor_ = 0;
+  retainingFlush_ = true;
+  return numRetained;
+}
+
 void GroupingSet::addRemainingInput() {
   activeRows_.resize(remainingInput_->size());
   activeRows_.clearAll();
@@ -414,13 +583,27 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
 void GroupingSet::createHashTable() {
   if (ignoreNullKeys_) {
     table_ = HashTable<true>::createForAggregation(
-        std::move(hashers_), accumulators(false), pool_);
+        std::move(hashers_),
+        accumulators(false),
+        pool_,
+        /*hasCountFlag=*/retainedGroupsPct_ > 0);
   } else {
     table_ = HashTable<false>::createForAggregation(
-        std::move(hashers_), accumulators(false), pool_);
+        std::move(hashers_),
+        accumulators(false),
+        pool_,
+        /*hasCountFlag=*/retainedGroupsPct_ > 0);
+  }
+
+  if (expectedNumDistinct_ > 0) {
+    table_->setExpectedNumDistinct(expectedNumDistinct_);
   }
 
   RowContainer& rows = *table_->rows();
+  if (queryConfig_ != nullptr &&
+      queryConfig_->aggregationAppendOnlyAllocatorEnabled()) {
+    rows.stringAllocator().setAppendOnly(true);
+  }
   initializeAggregates(aggregates_, rows, false);
 
   auto numColumns = rows.keyTypes().size() + aggregates_.size();
@@ -793,6 +976,10 @@ bool GroupingSet::getOutput(
   }
   VELOX_CHECK(!isDistinct());
 
+  if (retainingFlush_) {
+    return getRetainingFlushOutput(maxOutputRows, maxOutputBytes, result);
+  }
+
   // @lint-ignore CLANGTIDY
   std::vector<char*> groups(maxOutputRows);
   const int32_t numGroups = table_
@@ -803,6 +990,7 @@ bool GroupingSet::getOutput(
     if (table_ != nullptr) {
       table_->clear(/*freeTable=*/true);
     }
+    hasErasedGroups_ = false;
     return false;
   }
   extractGroups(
@@ -810,6 +998,33 @@ bool GroupingSet::getOutput(
   return true;
 }
 
+bool GroupingSet::getRetainingFlushOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes,
+    RowVectorPtr& result) {
+  if (flushGroupsCursor_ == flushGroups_.size()) {
+    table_->erase(
+        folly::Range<char**>(flushGroups_.data(), flushGroups_.size()));
+    flushGroups_.clear();
+    retainingFlush_ = false;
+    hasErasedGroups_ = true;
+    return false;
+  }
+  const auto* rows = table_->rows();
+  const auto first = flushGroupsCursor_;
+  const auto end = std::min<size_t>(flushGroups_.size(), first + maxOutputRows);
+  int64_t numBytes{0};
+  while (flushGroupsCursor_ < end && numBytes < maxOutputBytes) {
+    numBytes += rows->rowSize(flushGroups_[flushGroupsCursor_++]);
+  }
+  extractGroups(
+      table_->rows(),
+      folly::Range<char**>(
+          flushGroups_.data() + first, flushGroupsCursor_ - first),
+      result);
+  return true;
+}
+
 void GroupingSet::extractGroups(
     RowContainer* rowContainer,
     folly::Range<char**> groups,
@@ -819,13 +1034,22 @@ void GroupingSet::extractGroups(
     return;
   }
   const auto totalKeys = rowContainer->keyTypes().size();
-  for (int32_t i = 0; i < totalKeys; ++i) {
-    auto& keyVector = result->childAt(i);
-    rowContainer->extractColumn(
+  if (outputExtractionExecutor_ != nullptr &&
+      groups.size() >= parallelExtractionMinRows_) {
+    // The aggregates are extracted after the keys, since extracting them may
+    // allocate from the string allocator that holds the keys.
+    rowContainer->extractColumnsParallel(
+        groups.data(),
+        groups.size(),
+        folly::Range(groupingKeyOutputProjections_.data(), totalKeys),
+        folly::Range(result->children().data(), totalKeys),
+        outputExtractionExecutor_);
+  } else {
+    rowContainer->extractColumns(
         groups.data(),
         groups.size(),
-        groupingKeyOutputProjections_[i],
-        keyVector);
+        folly::Range(groupingKeyOutputProjections_.data(), totalKeys),
+        folly::Range(result->children().data(), totalKeys));
   }
   for (int32_t i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
@@ -857,11 +1081,24 @@ void GroupingSet::resetTable(bool freeTable) {
   if (table_ != nullptr) {
     table_->clear(freeTable);
   }
+  hasErasedGroups_ = false;
+}
+
+uint64_t GroupingSet::partialUsedBytes() const {
+  const auto totalBytes = allocatedBytes();
+  if (!hasErasedGroups_) {
+    return totalBytes;
+  }
+  const auto* rows = table_->rows();
+  const auto [numFreeRows, freeStringBytes] = rows->freeSpace();
+  const uint64_t freeBytes =
+      numFreeRows * rows->fixedRowSize() + freeStringBytes;
+  return totalBytes - std::min(totalBytes, freeBytes);
 }
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
   VELOX_CHECK(isPartial_);
-  if (!table_ || allocatedBytes() <= maxBytes) {
+  if (!table_ || partialUsedBytes() <= maxBytes) {
     return false;
   }
   if (table_->hashMode() != BaseHashTable::HashMode::kArray) {
@@ -878,7 +1115,7 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
     table_->decideHashMode(
         0, BaseHashTable::kNoSpillInputStartPartitionBit, true);
   }
-  return allocatedBytes() > maxBytes;
+  return partialUsedBytes() > maxBytes;
 }
 
 uint64_t GroupingSet::allocatedBytes() const {
@@ -924,6 +1161,16 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
     return;
   }
 
+  // Once the table is half way to its next rehash, forecasts the memory of
+  // the rehash so that the arbitrator can free it up at the background.
+  if (forecastedTableCapacity_ != table_->capacity()) {
+    const auto rehashBytes = table_->hashTableSizeIncrease(numDistinct);
+    if (rehashBytes > 0) {
+      forecastedTableCapacity_ = table_->capacity();
+      memory::forecastMemoryGrowth(pool_, rehashBytes);
+    }
+  }
+
   const auto currentUsage = pool_->usedBytes();
   const auto minReservationBytes =
       currentUsage * spillConfig_->minSpillableReservationPct / 100;
@@ -99,6 +99,15 @@ class GroupingSet {
   /// based on value ranges to one based on value ids can save a lot.
   bool isPartialFull(int64_t maxBytes);
 
+  /// Starts a partial aggregation flush that keeps the hottest groups in the
+  /// hash table. Keeps up to 'partial_aggregation_retained_groups_pct' percent
+  /// of the groups, picking the ones with the most input rows since the
+  /// previous flush among the ones with more than one. getOutput() then
+  /// returns the other groups and erases them from the table after the last
+  /// batch. Returns the number of kept groups. If none is kept, the flush
+  /// returns all groups as usual.
+  int64_t startRetainingFlush();
+
   /// Returns the count of the hash table, if any.
   int64_t numDistinct() const {
     return table_ ? table_->numDistinct() : 0;
@@ -177,6 +186,22 @@ class GroupingSet {
 
   std::optional<int64_t> estimateOutputRowSize() const;
 
+  /// Extracts the grouping keys of output batches of at least 'minRows' rows
+  /// in parallel on 'executor'. Must not be used with spilling.
+  void setParallelOutputExtraction(
+      folly::Executor* executor,
+      vector_size_t minRows) {
+    VELOX_CHECK_NULL(spillConfig_);
+    outputExtractionExecutor_ = executor;
+    parallelExtractionMinRows_ = minRows;
+  }
+
+  /// Sizes the hash table for 'numDistinct' groups when it is made. See
+  /// BaseHashTable::setExpectedNumDistinct().
+  void setExpectedNumDistinct(uint64_t numDistinct) {
+    expectedNumDistinct_ = numDistinct;
+  }
+
  private:
   bool isDistinct() const {
     return aggregates_.empty();
@@ -311,6 +336,26 @@ class GroupingSet {
   // 'toIntermediate'.
   std::vector<Accumulator> accumulators(bool excludeToIntermediate);
 
+  // Counts the input rows of each group in 'lookup_' for a retaining flush.
+  void updateGroupHits();
+
+  // Orders the rows of 'lookup_' by group into 'clusteredRowIndices_' and
+  // 'clusteredGroups_' if the aggregates support group runs, the table is in
+  // array mode and the batch has enough rows per group. Returns the number of
+  // clustered rows or 0 if the rows are not clustered.
+  vector_size_t clusterRowsByGroup();
+
+  // Returns the next batch of 'flushGroups_' in a retaining flush. Erases the
+  // groups from the table and returns false after the last batch.
+  bool getRetainingFlushOutput(
+      int32_t maxOutputRows,
+      int32_t maxOutputBytes,
+      RowVectorPtr& result);
+
+  // Returns the memory used by the hash table and its rows, not counting the
+  // free rows and string space left by the erased groups of retaining flushes.
+  uint64_t partialUsedBytes() const;
+
   // A subset of grouping keys on which the input is clustered.
   const std::vector<column_index_t> preGroupedKeyChannels_;
 
@@ -347,6 +392,10 @@ class GroupingSet {
 
   uint64_t numInputRows_ = 0;
 
+  // The capacity of 'table_' for which the memory of its next rehash has been
+  // forecasted to the memory arbitrator.
+  uint64_t forecastedTableCapacity_{0};
+
   // Column for groupId for a GROUPING SET.
   std::optional<column_index_t> groupIdChannel_;
 
@@ -421,6 +470,32 @@ class GroupingSet {
   // to merge.
   SelectivityVector mergeSelection_;
 
+  // True if the input rows may be clustered by group before updating the
+  // aggregates. See QueryConfig::kAggregationClusterRowsByGroupEnabled.
+  bool clusterRowsByGroup_{false};
+  // Row numbers of the input ordered by group and the group of each. Set by
+  // clusterRowsByGroup().
+  BufferPtr clusteredRowIndices_;
+  std::vector<char*> clusteredGroups_;
+  SelectivityVector clusteredRows_;
+  // Number of rows per group bucket of the table in clusterRowsByGroup().
+  std::vector<vector_size_t> groupRowCounts_;
+
+  // Percentage of the groups that a partial aggregation flush keeps. 0 if
+  // not a partial aggregation with retaining flushes. If non-zero, the count
+  // of each row of 'table_' is 1 plus the number of input rows of the group
+  // since the previous flush.
+  int32_t retainedGroupsPct_{0};
+  // The groups that a retaining flush returns and erases.
+  std::vector<char*> flushGroups_;
+  // Position in 'flushGroups_' of the next group to return.
+  size_t flushGroupsCursor_{0};
+  // True while getOutput() returns 'flushGroups_'.
+  bool retainingFlush_{false};
+  // True if retaining flushes have erased groups since the table was last
+  // cleared.
+  bool hasErasedGroups_{false};
+
   // True if partial aggregation has been given up as non-productive.
   bool abandonedPartialAggregation_{false};
 
@@ -436,6 +511,14 @@ class GroupingSet {
   // Temporary for case where an aggregate in toIntermediate() outputs post-init
   // state of aggregate for all rows.
   std::vector<char*> firstGroup_;
+
+  // Executor for extracting the grouping keys of output batches of at least
+  // 'parallelExtractionMinRows_' rows in parallel. nullptr if not used.
+  folly::Executor* outputExtractionExecutor_{nullptr};
+  vector_size_t parallelExtractionMinRows_{0};
+
+  // Passed to 'table_' when it is made.
+  uint64_t expectedNumDistinct_{0};
 };
 
 class AggregationInputSpiller : public SpillerBase {
@@ -16,7 +16,10 @@
 #include "velox/exec/HashAggregation.h"
 
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/OperatorType.h"
 #include "velox/exec/PrefixSort.h"
 #include "velox/exec/Task.h"
@@ -29,7 +32,8 @@ namespace facebook::velox::exec {
 HashAggregation::HashAggregation(
     int32_t operatorId,
     DriverCtx* driverCtx,
-    const std::shared_ptr<const core::AggregationNode>& aggregationNode)
+    const std::shared_ptr<const core::AggregationNode>& aggregationNode,
+    const std::shared_ptr<const core::GroupIdNode>& groupIdNode)
     : Operator(
           driverCtx,
           aggregationNode->outputType(),
@@ -59,29 +63,79 @@ HashAggregation::HashAggregation(
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()),
+      groupIdNode_(groupIdNode) {
+  if (groupIdNode_ != nullptr) {
+    VELOX_CHECK(canRollupGroupingSets(
+        *aggregationNode_, *groupIdNode_, driverCtx->queryConfig()));
+  }
+}
+
+bool HashAggregation::canRollupGroupingSets(
+    const core::AggregationNode& aggregationNode,
+    const core::GroupIdNode& groupIdNode,
+    const core::QueryConfig& queryConfig) {
+  const auto step = aggregationNode.step();
+  if (!queryConfig.groupingSetsRollupEnabled() ||
+      (step != core::AggregationNode::Step::kPartial &&
+       step != core::AggregationNode::Step::kSingle) ||
+      aggregationNode.sources()[0].get() != &groupIdNode ||
+      aggregationNode.canSpill(queryConfig) ||
+      aggregationNode.ignoreNullKeys() ||
+      aggregationNode.groupingKeys().empty() ||
+      aggregationNode.aggregates().empty() ||
+      !aggregationNode.preGroupedKeys().empty() ||
+      !aggregationNode.globalGroupingSets().empty() ||
+      aggregationNode.groupId().has_value()) {
+    return false;
+  }
+  std::unordered_set<std::string> keys;
+  for (const auto& info : groupIdNode.groupingKeyInfos()) {
+    keys.insert(info.output);
+  }
+  for (const auto& key : aggregationNode.groupingKeys()) {
+    if (keys.count(key->name()) == 0 &&
+        key->name() != groupIdNode.groupIdName()) {
+      return false;
+    }
+  }
+  // The aggregates must read the same values in all grouping sets.
+  for (const auto& aggregate : aggregationNode.aggregates()) {
+    if (aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    for (const auto& input : aggregate.call->inputs()) {
+      if (input->isConstantKind()) {
+        continue;
+      }
+      if (!input->isFieldAccessKind()) {
+        return false;
+      }
+      const auto& name =
+          input->asUnchecked<core::FieldAccessTypedExpr>()->name();
+      if (keys.count(name) > 0 || name == groupIdNode.groupIdName()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
 
 void HashAggregation::initialize() {
   Operator::initialize();
 
   VELOX_CHECK(pool()->trackUsage());
 
-  const auto& inputType = aggregationNode_->sources()[0]->outputType();
   std::vector<column_index_t> groupingKeyInputChannels;
   std::vector<column_index_t> groupingKeyOutputChannels;
   setupGroupingKeyChannelProjections(
       groupingKeyInputChannels, groupingKeyOutputChannels);
 
-  auto hashers = createVectorHashers(inputType, groupingKeyInputChannels);
+  auto hashers = createHashers(
+      aggregationNode_->sources()[0]->outputType(), groupingKeyInputChannels);
   const auto numHashers = hashers.size();
 
-  std::vector<column_index_t> preGroupedChannels;
-  preGroupedChannels.reserve(aggregationNode_->preGroupedKeys().size());
-  for (const auto& key : aggregationNode_->preGroupedKeys()) {
-    auto channel = exprToChannel(key.get(), inputType);
-    preGroupedChannels.push_back(channel);
-  }
-
   std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
   std::vector<AggregateInfo> aggregateInfos = toAggregateInfo(
       *aggregationNode_, *operatorCtx_, numHashers, expressionEvaluator);
@@ -98,11 +152,70 @@ void HashAggregation::initialize() {
         core::AggregationNode::toName(aggregationNode_->step()));
   }
 
+  if (groupIdNode_ != nullptr) {
+    setupRollup(std::move(aggregateInfos));
+    hasCompactableAggregates_ = groupingSet_->hasCompactableAggregates();
+    return;
+  }
+
   for (auto i = 0; i < hashers.size(); ++i) {
     identityProjections_.emplace_back(
         hashers[groupingKeyOutputChannels[i]]->channel(), i);
   }
 
+  parallelMerge_ = useParallelMerge(aggregateInfos, groupingKeyInputChannels);
+  if (parallelMerge_) {
+    setupParallelMerge(
+        aggregateInfos,
+        groupingKeyInputChannels,
+        groupingKeyOutputChannels,
+        expressionEvaluator);
+  }
+
+  createGroupingSet(
+      std::move(hashers),
+      std::move(groupingKeyOutputChannels),
+      std::move(aggregateInfos));
+  applyExecutionFeedback();
+
+  const auto minExtractionRows = operatorCtx_->driverCtx()
+                                     ->queryConfig()
+                                     .parallelOutputExtractionMinRows();
+  auto* executor = operatorCtx_->task()->queryCtx()->executor();
+  if (mergeGroupingSet_ != nullptr && minExtractionRows > 0 &&
+      executor != nullptr) {
+    mergeGroupingSet_->setParallelOutputExtraction(executor, minExtractionRows);
+  }
+
+  hasCompactableAggregates_ = groupingSet_->hasCompactableAggregates();
+}
+
+std::vector<std::unique_ptr<VectorHasher>> HashAggregation::createHashers(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& groupingKeyInputChannels) const {
+  auto hashers = createVectorHashers(inputType, groupingKeyInputChannels);
+  const auto maxDistinctValueIds =
+      operatorCtx_->driverCtx()->queryConfig().aggregationMaxDistinctValueIds();
+  if (maxDistinctValueIds != VectorHasher::kMaxDistinct) {
+    for (auto& hasher : hashers) {
+      hasher->setMaxDistinct(maxDistinctValueIds);
+    }
+  }
+  return hashers;
+}
+
+void HashAggregation::createGroupingSet(
+    std::vector<std::unique_ptr<VectorHasher>> hashers,
+    std::vector<column_index_t> groupingKeyOutputChannels,
+    std::vector<AggregateInfo> aggregateInfos) {
+  const auto& inputType = aggregationNode_->sources()[0]->outputType();
+  std::vector<column_index_t> preGroupedChannels;
+  preGroupedChannels.reserve(aggregationNode_->preGroupedKeys().size());
+  for (const auto& key : aggregationNode_->preGroupedKeys()) {
+    auto channel = exprToChannel(key.get(), inputType);
+    preGroupedChannels.push_back(channel);
+  }
+
   std::optional<column_index_t> groupIdChannel;
   if (aggregationNode_->groupId().has_value()) {
     groupIdChannel = outputType_->getChildIdxIfExists(
@@ -110,6 +223,7 @@ void HashAggregation::initialize() {
     VELOX_CHECK(groupIdChannel.has_value());
   }
 
+  // The first phase of a two-phase aggregation produces intermediate results.
   groupingSet_ = std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
@@ -117,7 +231,7 @@ void HashAggregation::initialize() {
       std::move(groupingKeyOutputChannels),
       std::move(aggregateInfos),
       aggregationNode_->ignoreNullKeys(),
-      isPartialOutput_,
+      isPartialOutput_ || parallelMerge_,
       isRawInput(aggregationNode_->step()),
       aggregationNode_->globalGroupingSets(),
       groupIdChannel,
@@ -127,9 +241,245 @@ void HashAggregation::initialize() {
       operatorCtx_->pool(),
       spillStats_.get());
 
-  hasCompactableAggregates_ = groupingSet_->hasCompactableAggregates();
+  const auto minExtractionRows = operatorCtx_->driverCtx()
+                                     ->queryConfig()
+                                     .parallelOutputExtractionMinRows();
+  auto* executor = operatorCtx_->task()->queryCtx()->executor();
+  if (minExtractionRows > 0 && executor != nullptr && !canSpill()) {
+    groupingSet_->setParallelOutputExtraction(executor, minExtractionRows);
+  }
+}
 
-  aggregationNode_.reset();
+void HashAggregation::resetGroupingSet() {
+  std::vector<column_index_t> groupingKeyInputChannels;
+  std::vector<column_index_t> groupingKeyOutputChannels;
+  setupGroupingKeyChannelProjections(
+      groupingKeyInputChannels, groupingKeyOutputChannels);
+  auto hashers = createHashers(
+      aggregationNode_->sources()[0]->outputType(), groupingKeyInputChannels);
+  std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
+  auto aggregateInfos = toAggregateInfo(
+      *aggregationNode_, *operatorCtx_, hashers.size(), expressionEvaluator);
+
+  // Frees the groups of the previous epoch before allocating new ones.
+  groupingSet_.reset();
+  pool()->release();
+  createGroupingSet(
+      std::move(hashers),
+      std::move(groupingKeyOutputChannels),
+      std::move(aggregateInfos));
+  // The next epoch likely has about as many groups as the previous one.
+  if (!isGlobal_ && drainNumDistinct_ > 0) {
+    groupingSet_->setExpectedNumDistinct(std::min<uint64_t>(
+        drainNumDistinct_, kMaxFeedbackNumDistinct));
+  }
+}
+
+bool HashAggregation::useParallelMerge(
+    const std::vector<AggregateInfo>& aggregateInfos,
+    const std::vector<column_index_t>& groupingKeyInputChannels) const {
+  if (aggregationNode_->step() != core::AggregationNode::Step::kFinal ||
+      isGlobal_ || isDistinct_ || canSpill() ||
+      !operatorCtx_->driverCtx()
+           ->queryConfig()
+           .parallelFinalAggregationEnabled() ||
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver()) <= 1 ||
+      // A barrier drains each driver on its own, while a parallel merge
+      // needs all the drivers to finish their input.
+      operatorCtx_->task()->supportsBarrier() ||
+      !aggregationNode_->preGroupedKeys().empty() ||
+      !aggregationNode_->globalGroupingSets().empty() ||
+      aggregationNode_->groupId().has_value()) {
+    return false;
+  }
+  // Each aggregate must read its intermediate result from one input column
+  // that no other key or aggregate uses.
+  std::unordered_set<column_index_t> channels(
+      groupingKeyInputChannels.begin(), groupingKeyInputChannels.end());
+  for (const auto& info : aggregateInfos) {
+    if (info.mask.has_value() || info.distinct || !info.sortingKeys.empty()) {
+      return false;
+    }
+    const auto numColumnInputs = std::count_if(
+        info.inputs.begin(), info.inputs.end(), [](auto channel) {
+          return channel != kConstantChannel;
+        });
+    if (numColumnInputs != 1) {
+      return false;
+    }
+    for (const auto channel : info.inputs) {
+      if (channel != kConstantChannel && !channels.insert(channel).second) {
+        return false;
+      }
+    }
+  }
+  return channels.size() ==
+      groupingKeyInputChannels.size() + aggregateInfos.size();
+}
+
+void HashAggregation::setupParallelMerge(
+    const std::vector<AggregateInfo>& aggregateInfos,
+    const std::vector<column_index_t>& groupingKeyInputChannels,
+    const std::vector<column_index_t>& groupingKeyOutputChannels,
+    std::shared_ptr<core::ExpressionEvaluator>& expressionEvaluator) {
+  mergeInputType_ = aggregationNode_->sources()[0]->outputType();
+  mergeKeyChannels_ = groupingKeyInputChannels;
+
+  // The intermediate results of the first phase have the grouping keys in
+  // output order followed by the aggregates.
+  const auto numKeys = groupingKeyInputChannels.size();
+  std::vector<TypePtr> intermediateTypes;
+  for (auto i = 0; i < numKeys; ++i) {
+    mergeInputChannels_.push_back(
+        groupingKeyInputChannels[groupingKeyOutputChannels[i]]);
+    intermediateTypes.push_back(outputType_->childAt(i));
+  }
+  for (const auto& info : aggregateInfos) {
+    for (const auto channel : info.inputs) {
+      if (channel != kConstantChannel) {
+        mergeInputChannels_.push_back(channel);
+      }
+    }
+    intermediateTypes.push_back(
+        mergeInputType_->childAt(mergeInputChannels_.back()));
+  }
+  intermediateType_ =
+      ROW(std::vector<std::string>(outputType_->names()),
+          std::move(intermediateTypes));
+
+  // The second phase aggregates the intermediate results in the input layout,
+  // the same way as the first phase aggregates the input.
+  mergeGroupingSet_ = std::make_unique<GroupingSet>(
+      mergeInputType_,
+      createVectorHashers(mergeInputType_, groupingKeyInputChannels),
+      std::vector<column_index_t>{},
+      std::vector<column_index_t>(groupingKeyOutputChannels),
+      toAggregateInfo(
+          *aggregationNode_, *operatorCtx_, numKeys, expressionEvaluator),
+      aggregationNode_->ignoreNullKeys(),
+      /*isPartial=*/false,
+      /*isRawInput=*/false,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      nullptr,
+      &nonReclaimableSection_,
+      &operatorCtx_->driverCtx()->queryConfig(),
+      operatorCtx_->pool(),
+      spillStats_.get());
+}
+
+void HashAggregation::setupRollup(std::vector<AggregateInfo> aggregateInfos) {
+  const auto& inputType = groupIdNode_->sources()[0]->outputType();
+  const auto& groupIdType = groupIdNode_->outputType();
+
+  // The first phase groups by the distinct input columns of the grouping keys.
+  // One input column may be the input of several grouping keys.
+  std::vector<column_index_t> keyChannels;
+  std::unordered_map<std::string, column_index_t> keyToIntermediateChannel;
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto& info : groupIdNode_->groupingKeyInfos()) {
+    const auto channel = inputType->getChildIdx(info.input->name());
+    auto it = std::find(keyChannels.begin(), keyChannels.end(), channel);
+    if (it == keyChannels.end()) {
+      it = keyChannels.insert(keyChannels.end(), channel);
+      names.push_back(inputType->nameOf(channel));
+      types.push_back(inputType->childAt(channel));
+    }
+    keyToIntermediateChannel[info.output] = it - keyChannels.begin();
+  }
+  const auto numKeys = aggregationNode_->groupingKeys().size();
+  const auto numIntermediateKeys = keyChannels.size();
+
+  // The aggregates read the input columns that the GroupId passes through.
+  std::vector<TypePtr> rollupInputTypes;
+  for (auto i = 0; i < numKeys; ++i) {
+    rollupInputTypes.push_back(outputType_->childAt(i));
+  }
+  for (auto i = 0; i < aggregateInfos.size(); ++i) {
+    auto& info = aggregateInfos[i];
+    for (auto& channel : info.inputs) {
+      if (channel != kConstantChannel) {
+        channel = inputType->getChildIdx(groupIdType->nameOf(channel));
+      }
+    }
+    names.push_back(outputType_->nameOf(numKeys + i));
+    types.push_back(info.intermediateType);
+    rollupInputTypes.push_back(info.intermediateType);
+  }
+  rollupIntermediateType_ = ROW(std::move(names), std::move(types));
+  rollupInputType_ =
+      ROW(std::vector<std::string>(outputType_->names()),
+          std::move(rollupInputTypes));
+
+  const auto& groupingKeys = aggregationNode_->groupingKeys();
+  for (const auto& groupingSet : groupIdNode_->groupingSets()) {
+    std::vector<column_index_t> channels(numKeys, kConstantChannel);
+    for (auto i = 0; i < numKeys; ++i) {
+      const auto& name = groupingKeys[i]->name();
+      if (std::find(groupingSet.begin(), groupingSet.end(), name) !=
+          groupingSet.end()) {
+        channels[i] = keyToIntermediateChannel.at(name);
+      }
+    }
+    rollupKeyChannels_.push_back(std::move(channels));
+  }
+  for (auto i = 0; i < numKeys; ++i) {
+    if (groupingKeys[i]->name() == groupIdNode_->groupIdName()) {
+      rollupGroupIdKey_ = i;
+    }
+  }
+
+  std::vector<column_index_t> intermediateKeyProjections(numIntermediateKeys);
+  std::iota(
+      intermediateKeyProjections.begin(), intermediateKeyProjections.end(), 0);
+  groupingSet_ = std::make_unique<GroupingSet>(
+      inputType,
+      createHashers(inputType, keyChannels),
+      std::vector<column_index_t>{},
+      std::move(intermediateKeyProjections),
+      std::move(aggregateInfos),
+      /*ignoreNullKeys=*/false,
+      /*isPartial=*/true,
+      /*isRawInput=*/true,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      nullptr,
+      &nonReclaimableSection_,
+      &operatorCtx_->driverCtx()->queryConfig(),
+      operatorCtx_->pool(),
+      spillStats_.get());
+
+  // The second phase merges the intermediate results like a final or
+  // intermediate aggregation.
+  std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
+  auto rollupAggregateInfos = toAggregateInfo(
+      *aggregationNode_, *operatorCtx_, numKeys, expressionEvaluator);
+  for (auto i = 0; i < rollupAggregateInfos.size(); ++i) {
+    rollupAggregateInfos[i].inputs = {static_cast<column_index_t>(numKeys + i)};
+    rollupAggregateInfos[i].constantInputs = {nullptr};
+  }
+  std::vector<column_index_t> keyProjections(numKeys);
+  std::iota(keyProjections.begin(), keyProjections.end(), 0);
+  rollupGroupingSet_ = std::make_unique<GroupingSet>(
+      rollupInputType_,
+      createHashers(rollupInputType_, keyProjections),
+      std::vector<column_index_t>{},
+      std::vector<column_index_t>(keyProjections),
+      std::move(rollupAggregateInfos),
+      /*ignoreNullKeys=*/false,
+      isPartialOutput_,
+      /*isRawInput=*/false,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      nullptr,
+      &nonReclaimableSection_,
+      &operatorCtx_->driverCtx()->queryConfig(),
+      operatorCtx_->pool(),
+      spillStats_.get());
+  addRuntimeStat(
+      std::string(kRollupGroupingSets),
+      RuntimeCounter(rollupKeyChannels_.size()));
 }
 
 void HashAggregation::setupGroupingKeyChannelProjections(
@@ -180,6 +530,24 @@ void HashAggregation::setupGroupingKeyChannelProjections(
   }
 }
 
+void HashAggregation::applyExecutionFeedback() {
+  if (isGlobal_) {
+    return;
+  }
+  const auto feedback = operatorCtx_->task()->executionFeedback(planNodeId());
+  if (!feedback.has_value()) {
+    return;
+  }
+  if (feedback->maxNumDistinct > 0) {
+    groupingSet_->setExpectedNumDistinct(
+        std::min(feedback->maxNumDistinct, kMaxFeedbackNumDistinct));
+  }
+  if (isPartialOutput_ && feedback->abandonedPartialAggregation) {
+    abandonPartialAggregationMinRows_ =
+        std::min(abandonPartialAggregationMinRows_, kFeedbackAbandonMinRows);
+  }
+}
+
 bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
   VELOX_CHECK(isPartialOutput_ && !isGlobal_);
   return numInputRows_ > abandonPartialAggregationMinRows_ &&
@@ -187,6 +555,12 @@ bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
 }
 
 void HashAggregation::addInput(RowVectorPtr input) {
+  if (groupIdNode_ != nullptr) {
+    groupingSet_->addInput(input, /*mayPushdown=*/false);
+    numInputRows_ += input->size();
+    updateRuntimeStats();
+    return;
+  }
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
@@ -287,11 +661,19 @@ void HashAggregation::resetPartialOutputIfNeed() {
         std::string(HashAggregation::kPartialAggregationPct),
         RuntimeCounter(static_cast<int64_t>(aggregationPct)));
   }
-  groupingSet_->resetTable(/*freeTable=*/false);
+  if (numRetainedGroups_ > 0) {
+    addRuntimeStat(
+        std::string(HashAggregation::kRetainedGroupCount),
+        RuntimeCounter(numRetainedGroups_));
+  } else {
+    groupingSet_->resetTable(/*freeTable=*/false);
+  }
   partialFull_ = false;
+  partialFlushStarted_ = false;
   if (!finished_) {
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
   }
+  numRetainedGroups_ = 0;
   numOutputRows_ = 0;
   numInputRows_ = 0;
 }
@@ -307,6 +689,11 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
+    if (numRetainedGroups_ > 0) {
+      // The kept groups must be flushed before giving up.
+      retainingFlushDisabled_ = true;
+      return;
+    }
     groupingSet_->abandonPartialAggregation();
     pool()->release();
     addRuntimeStat(
@@ -341,11 +728,20 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (parallelMerge_) {
+    return getParallelMergeOutput();
+  }
+  if (groupIdNode_ != nullptr) {
+    return getRollupOutput();
+  }
   if (abandonedPartialAggregation_) {
     if (noMoreInput_) {
       finished_ = true;
     }
     if (!input_) {
+      if (isDraining()) {
+        finishDrain();
+      }
       return nullptr;
     }
     prepareOutput(input_->size());
@@ -356,7 +752,7 @@ RowVectorPtr HashAggregation::getOutput() {
   }
 
   // Produce results if one of the following is true:
-  // - received no-more-input message;
+  // - received no-more-input message or is draining for a barrier;
   // - partial aggregation reached memory limit;
   // - distinct aggregation has new keys;
   // - running in partial streaming mode and have some output ready.
@@ -376,6 +772,13 @@ RowVectorPtr HashAggregation::getOutput() {
   // Reuse output vectors if possible.
   prepareOutput(maxOutputRows);
 
+  if (partialFull_ && !partialFlushStarted_) {
+    partialFlushStarted_ = true;
+    if (!noMoreInput_ && !isDraining() && !retainingFlushDisabled_) {
+      numRetainedGroups_ = groupingSet_->startRetainingFlush();
+    }
+  }
+
   const bool hasData = groupingSet_->getOutput(
       maxOutputRows,
       queryConfig.preferredOutputBatchBytes(),
@@ -383,10 +786,18 @@ RowVectorPtr HashAggregation::getOutput() {
       output_);
   if (!hasData) {
     resultIterator_.reset();
-    if (noMoreInput_) {
+    if (noMoreInput_ && numRetainedGroups_ == 0) {
       finished_ = true;
     }
+    const bool retainedGroups = numRetainedGroups_ > 0;
     resetPartialOutputIfNeed();
+    if ((noMoreInput_ || isDraining()) && retainedGroups) {
+      // The input ended during a flush that kept groups. Return them now.
+      return getOutput();
+    }
+    if (isDraining()) {
+      finishDrain();
+    }
     return nullptr;
   }
   numOutputRows_ += output_->size();
@@ -419,8 +830,8 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
   VELOX_CHECK(!newDistincts_);
 
   if (!groupingSet_->hasSpilled()) {
-    if (noMoreInput_) {
-      finished_ = true;
+    if (noMoreInput_ || isDraining()) {
+      finished_ = noMoreInput_;
       if (auto numRows = groupingSet_->numDefaultGlobalGroupingSetRows()) {
         prepareOutput(numRows.value());
         if (groupingSet_->getDefaultGlobalGroupingSetOutput(
@@ -429,11 +840,14 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
           return output_;
         }
       }
+      if (isDraining()) {
+        finishDrain();
+      }
     }
     return nullptr;
   }
 
-  if (!noMoreInput_) {
+  if (!noMoreInput_ && !isDraining()) {
     return nullptr;
   }
 
@@ -445,7 +859,11 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
           queryConfig.preferredOutputBatchBytes(),
           resultIterator_,
           output_)) {
-    finished_ = true;
+    if (noMoreInput_) {
+      finished_ = true;
+    } else {
+      finishDrain();
+    }
     return nullptr;
   }
   numOutputRows_ += output_->size();
@@ -456,8 +874,270 @@ void HashAggregation::noMoreInput() {
   updateEstimatedOutputRowSize();
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
+  if (parallelMerge_) {
+    partitionGroupsForMerge();
+  }
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
+  if (parallelMerge_) {
+    finishPartitionGroupsForMerge();
+  }
+}
+
+bool HashAggregation::startDrain() {
+  VELOX_CHECK(isDraining());
+  VELOX_CHECK(!noMoreInput_);
+  VELOX_CHECK(!parallelMerge_);
+  VELOX_CHECK_NULL(groupIdNode_);
+  if (abandonedPartialAggregation_) {
+    return input_ != nullptr;
+  }
+  updateEstimatedOutputRowSize();
+  drainNumDistinct_ = groupingSet_->numDistinct();
+  // Produces the groups of the input since the last barrier the same way as at
+  // the end of the input. Global aggregations produce one row per barrier.
+  groupingSet_->noMoreInput();
+  return true;
+}
+
+void HashAggregation::finishDrain() {
+  VELOX_CHECK(isDraining());
+  // An abandoned partial aggregation keeps 'groupingSet_' to convert its input
+  // to intermediate results.
+  if (!abandonedPartialAggregation_) {
+    resetGroupingSet();
+  }
+  resultIterator_.reset();
+  numInputRows_ = 0;
+  numOutputRows_ = 0;
+  Operator::finishDrain();
+}
+
+void HashAggregation::partitionGroupsForMerge() {
+  const auto numPartitions =
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver());
+  {
+    std::lock_guard<std::mutex> l(mergeMutex_);
+    mergePartitions_.resize(numPartitions);
+  }
+  HashPartitionFunction partitionFunction(
+      /*localExchange=*/true,
+      numPartitions,
+      mergeInputType_,
+      mergeKeyChannels_);
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxOutputRows = outputBatchRows(estimatedOutputRowSize_);
+  RowContainerIterator iterator;
+  std::vector<uint32_t> partitions;
+  std::vector<vector_size_t> partitionSizes(numPartitions);
+  std::vector<BufferPtr> partitionIndices(numPartitions);
+  for (;;) {
+    auto intermediate = std::static_pointer_cast<RowVector>(
+        BaseVector::create(intermediateType_, maxOutputRows, pool()));
+    if (!groupingSet_->getOutput(
+            maxOutputRows,
+            queryConfig.preferredOutputBatchBytes(),
+            iterator,
+            intermediate)) {
+      break;
+    }
+    // Lays out the intermediate results as the input of the aggregation. The
+    // columns that the aggregation does not read are null.
+    const auto numRows = intermediate->size();
+    std::vector<VectorPtr> children(mergeInputType_->size());
+    for (auto i = 0; i < mergeInputChannels_.size(); ++i) {
+      children[mergeInputChannels_[i]] = intermediate->childAt(i);
+    }
+    for (auto i = 0; i < children.size(); ++i) {
+      if (children[i] == nullptr) {
+        children[i] = BaseVector::createNullConstant(
+            mergeInputType_->childAt(i), numRows, pool());
+      }
+    }
+    auto input = std::make_shared<RowVector>(
+        pool(), mergeInputType_, nullptr, numRows, std::move(children));
+
+    std::lock_guard<std::mutex> l(mergeMutex_);
+    const auto singlePartition =
+        partitionFunction.partition(*input, partitions);
+    if (singlePartition.has_value()) {
+      mergePartitions_[singlePartition.value()].push_back(std::move(input));
+      continue;
+    }
+    std::fill(partitionSizes.begin(), partitionSizes.end(), 0);
+    for (auto i = 0; i < numPartitions; ++i) {
+      partitionIndices[i] = allocateIndices(numRows, pool());
+    }
+    for (auto row = 0; row < numRows; ++row) {
+      const auto partition = partitions[row];
+      partitionIndices[partition]
+          ->asMutable<vector_size_t>()[partitionSizes[partition]++] = row;
+    }
+    for (auto i = 0; i < numPartitions; ++i) {
+      if (partitionSizes[i] > 0) {
+        mergePartitions_[i].push_back(
+            wrap(partitionSizes[i], std::move(partitionIndices[i]), input));
+      }
+    }
+  }
+}
+
+void HashAggregation::finishPartitionGroupsForMerge() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last driver to finish its input hands each driver its partition of the
+  // groups of all drivers. The other drivers wait for it.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  SCOPE_EXIT {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+
+  std::vector<HashAggregation*> aggregations;
+  aggregations.reserve(peers.size() + 1);
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    aggregations.push_back(aggregation);
+  }
+  aggregations.push_back(this);
+  for (auto* source : aggregations) {
+    std::vector<std::vector<RowVectorPtr>> partitions;
+    {
+      std::lock_guard<std::mutex> l(source->mergeMutex_);
+      partitions = std::move(source->mergePartitions_);
+    }
+    VELOX_CHECK_EQ(partitions.size(), aggregations.size());
+    for (auto i = 0; i < aggregations.size(); ++i) {
+      auto* target = aggregations[i];
+      std::lock_guard<std::mutex> l(target->mergeMutex_);
+      std::move(
+          partitions[i].begin(),
+          partitions[i].end(),
+          std::back_inserter(target->mergeInput_));
+    }
+  }
+}
+
+void HashAggregation::addRollupInput() {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxOutputRows = outputBatchRows(estimatedOutputRowSize_);
+  const auto numAggregates = aggregationNode_->aggregates().size();
+  const column_index_t numKeys = rollupInputType_->size() - numAggregates;
+  const auto numIntermediateKeys =
+      rollupIntermediateType_->size() - numAggregates;
+  RowContainerIterator iterator;
+  for (;;) {
+    auto intermediate = std::static_pointer_cast<RowVector>(
+        BaseVector::create(rollupIntermediateType_, maxOutputRows, pool()));
+    if (!groupingSet_->getOutput(
+            maxOutputRows,
+            queryConfig.preferredOutputBatchBytes(),
+            iterator,
+            intermediate)) {
+      break;
+    }
+    const auto numRows = intermediate->size();
+    for (auto set = 0; set < rollupKeyChannels_.size(); ++set) {
+      const auto& keyChannels = rollupKeyChannels_[set];
+      std::vector<VectorPtr> children(rollupInputType_->size());
+      for (column_index_t i = 0; i < numKeys; ++i) {
+        if (rollupGroupIdKey_ == i) {
+          children[i] = std::make_shared<ConstantVector<int64_t>>(
+              pool(), numRows, false, BIGINT(), static_cast<int64_t>(set));
+        } else if (keyChannels[i] == kConstantChannel) {
+          children[i] = BaseVector::createNullConstant(
+              rollupInputType_->childAt(i), numRows, pool());
+        } else {
+          children[i] = intermediate->childAt(keyChannels[i]);
+        }
+      }
+      for (auto i = numKeys; i < children.size(); ++i) {
+        children[i] =
+            intermediate->childAt(numIntermediateKeys + i - numKeys);
+      }
+      rollupGroupingSet_->addInput(
+          std::make_shared<RowVector>(
+              pool(), rollupInputType_, nullptr, numRows, std::move(children)),
+          /*mayPushdown=*/false);
+    }
+  }
+  rollupGroupingSet_->noMoreInput();
+  // The groups of all the grouping keys are no longer needed.
+  groupingSet_->resetTable(/*freeTable=*/true);
+  pool()->release();
+}
+
+RowVectorPtr HashAggregation::getRollupOutput() {
+  if (!noMoreInput_) {
+    return nullptr;
+  }
+  if (!rollupInputAdded_) {
+    addRollupInput();
+    rollupInputAdded_ = true;
+  }
+
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxOutputRows = outputBatchRows(estimatedOutputRowSize_);
+  prepareOutput(maxOutputRows);
+  if (!rollupGroupingSet_->getOutput(
+          maxOutputRows,
+          queryConfig.preferredOutputBatchBytes(),
+          resultIterator_,
+          output_)) {
+    finished_ = true;
+    return nullptr;
+  }
+  numOutputRows_ += output_->size();
+  return output_;
+}
+
+RowVectorPtr HashAggregation::getParallelMergeOutput() {
+  if (!noMoreInput_ || future_.valid()) {
+    return nullptr;
+  }
+  if (!mergeInputAdded_) {
+    std::vector<RowVectorPtr> mergeInput;
+    {
+      std::lock_guard<std::mutex> l(mergeMutex_);
+      mergeInput = std::move(mergeInput_);
+    }
+    for (auto& input : mergeInput) {
+      mergeGroupingSet_->addInput(input, /*mayPushdown=*/false);
+      input.reset();
+    }
+    mergeGroupingSet_->noMoreInput();
+    mergeInputAdded_ = true;
+  }
+
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxOutputRows = outputBatchRows(estimatedOutputRowSize_);
+  prepareOutput(maxOutputRows);
+  if (!mergeGroupingSet_->getOutput(
+          maxOutputRows,
+          queryConfig.preferredOutputBatchBytes(),
+          resultIterator_,
+          output_)) {
+    finished_ = true;
+    return nullptr;
+  }
+  numOutputRows_ += output_->size();
+  return output_;
+}
+
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForProducer;
+  }
+  return BlockingReason::kNotBlocked;
 }
 
 bool HashAggregation::isFinished() {
@@ -498,7 +1178,7 @@ void HashAggregation::reclaim(
     return;
   }
 
-  if (noMoreInput_) {
+  if (noMoreInput_ || isDraining()) {
     if (groupingSet_->hasSpilled()) {
       LOG(WARNING)
           << "Can't reclaim from aggregation operator which has spilled and is under output processing, pool "
@@ -534,6 +1214,15 @@ void HashAggregation::close() {
 
   output_ = nullptr;
   groupingSet_.reset();
+  rollupGroupingSet_.reset();
+  if (parallelMerge_) {
+    {
+      std::lock_guard<std::mutex> l(mergeMutex_);
+      mergePartitions_.clear();
+      mergeInput_.clear();
+    }
+    mergeGroupingSet_.reset();
+  }
 }
 
 void HashAggregation::updateEstimatedOutputRowSize() {
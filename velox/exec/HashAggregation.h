@@ -35,11 +35,38 @@ class HashAggregation : public Operator {
   /// Whether partial aggregation was abandoned due to insufficient reduction.
   static constexpr std::string_view kAbandonedPartialAggregation =
       "abandonedPartialAggregation";
-
+  /// Number of groups that partial aggregation flushes kept in memory.
+  static constexpr std::string_view kRetainedGroupCount = "retainedGroupCount";
+  /// Number of grouping sets derived from the groups of all grouping keys.
+  static constexpr std::string_view kRollupGroupingSets = "rollupGroupingSets";
+
+  /// The rows to see before deciding to abandon partial aggregation if an
+  /// earlier run of the plan abandoned it. The reduction is still checked so
+  /// that a change in the data is noticed.
+  static constexpr int32_t kFeedbackAbandonMinRows = 10'000;
+
+  /// Caps the number of groups an earlier run of the plan sizes the hash
+  /// table for.
+  static constexpr uint64_t kMaxFeedbackNumDistinct = 1 << 20;
+
+  /// If 'groupIdNode' is set, it is the source of 'aggregationNode' and the
+  /// input is the input of 'groupIdNode'. See canRollupGroupingSets().
   HashAggregation(
       int32_t operatorId,
       DriverCtx* driverCtx,
-      const std::shared_ptr<const core::AggregationNode>& aggregationNode);
+      const std::shared_ptr<const core::AggregationNode>& aggregationNode,
+      const std::shared_ptr<const core::GroupIdNode>& groupIdNode = nullptr);
+
+  /// Returns true if 'aggregationNode' over 'groupIdNode' can run as one
+  /// HashAggregation that aggregates the input of 'groupIdNode' by all the
+  /// grouping keys and then merges the intermediate results of these groups
+  /// into the groups of each grouping set. This replaces copying the input
+  /// once per grouping set with copying the usually much fewer groups. See
+  /// QueryConfig::kGroupingSetsRollupEnabled.
+  static bool canRollupGroupingSets(
+      const core::AggregationNode& aggregationNode,
+      const core::GroupIdNode& groupIdNode,
+      const core::QueryConfig& queryConfig);
 
   void initialize() override;
 
@@ -53,9 +80,15 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  /// Produces the groups of the input since the previous barrier, if any, as
+  /// at the end of the input, then starts over with no groups. So each barrier
+  /// emits the aggregation of one epoch of the input, e.g. a tumbling window
+  /// or, for a partial aggregation, a delta to merge into a running result.
+  bool startDrain() override;
+
+  void finishDrain() override;
+
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -72,6 +105,21 @@ class HashAggregation : public Operator {
   void close() override;
 
  private:
+  // Creates the hashers of the grouping keys, see
+  // setupGroupingKeyChannelProjections().
+  std::vector<std::unique_ptr<VectorHasher>> createHashers(
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& groupingKeyInputChannels) const;
+
+  // Creates 'groupingSet_' for the input of 'aggregationNode_'.
+  void createGroupingSet(
+      std::vector<std::unique_ptr<VectorHasher>> hashers,
+      std::vector<column_index_t> groupingKeyOutputChannels,
+      std::vector<AggregateInfo> aggregateInfos);
+
+  // Replaces 'groupingSet_' with an empty one after a barrier drain.
+  void resetGroupingSet();
+
   void updateRuntimeStats();
 
   void prepareOutput(vector_size_t size);
@@ -91,6 +139,11 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Sizes the hash table and lowers the rows to see before abandoning partial
+  // aggregation from the ExecutionFeedback of earlier runs of the plan, if
+  // any.
+  void applyExecutionFeedback();
+
   RowVectorPtr getDistinctOutput();
 
   // Setups the projections for accessing grouping keys stored in grouping
@@ -105,6 +158,41 @@ class HashAggregation : public Operator {
 
   void updateEstimatedOutputRowSize();
 
+  // Returns true if this final aggregation aggregates in two phases across
+  // its drivers. See QueryConfig::kParallelFinalAggregationEnabled.
+  bool useParallelMerge(
+      const std::vector<AggregateInfo>& aggregateInfos,
+      const std::vector<column_index_t>& groupingKeyInputChannels) const;
+
+  // Sets up 'mergeGroupingSet_' and the layout of its input for a two-phase
+  // aggregation.
+  void setupParallelMerge(
+      const std::vector<AggregateInfo>& aggregateInfos,
+      const std::vector<column_index_t>& groupingKeyInputChannels,
+      const std::vector<column_index_t>& groupingKeyOutputChannels,
+      std::shared_ptr<core::ExpressionEvaluator>& expressionEvaluator);
+
+  // Extracts the groups of 'groupingSet_' as intermediate results and hash
+  // partitions them into 'mergePartitions_'.
+  void partitionGroupsForMerge();
+
+  // Waits for the peer drivers to partition their groups. The last driver to
+  // finish hands each driver its partition of the groups of all drivers.
+  void finishPartitionGroupsForMerge();
+
+  RowVectorPtr getParallelMergeOutput();
+
+  // Sets up 'groupingSet_' to aggregate the input of 'groupIdNode_' by all the
+  // grouping keys and 'rollupGroupingSet_' to merge these groups into the
+  // groups of each grouping set.
+  void setupRollup(std::vector<AggregateInfo> aggregateInfos);
+
+  // Adds the groups of 'groupingSet_' to 'rollupGroupingSet_' once per
+  // grouping set, with the keys outside of the grouping set set to null.
+  void addRollupInput();
+
+  RowVectorPtr getRollupOutput();
+
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
 
   const bool isPartialOutput_;
@@ -113,8 +201,8 @@ class HashAggregation : public Operator {
   const bool memoryCompactionEnabled_;
   const int64_t maxExtendedPartialAggregationMemoryUsage_;
   // Minimum number of rows to see before deciding to give up on partial
-  // aggregation.
-  const int32_t abandonPartialAggregationMinRows_;
+  // aggregation. Lowered if an earlier run of the plan gave up.
+  int32_t abandonPartialAggregationMinRows_;
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
@@ -132,11 +220,23 @@ class HashAggregation : public Operator {
   // 'groupingSet_->estimateRowSize()' across all accumulated data set.
   std::optional<int64_t> estimatedOutputRowSize_;
 
+  // Number of groups when the last barrier drain started. Sizes the hash
+  // table of the next epoch.
+  int64_t drainNumDistinct_{0};
+
   bool partialFull_ = false;
   bool newDistincts_ = false;
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
+  // True once the current partial output flush has decided which groups to
+  // keep in memory.
+  bool partialFlushStarted_{false};
+  // Number of groups the current partial output flush keeps in memory.
+  int64_t numRetainedGroups_{0};
+  // Set when partial aggregation is to be abandoned while flushes keep
+  // groups. The next flush then returns all groups before abandoning.
+  bool retainingFlushDisabled_{false};
 
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
@@ -151,6 +251,56 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // True if the aggregation runs in two phases across the drivers. The first
+  // phase aggregates the input of this driver into 'groupingSet_'. The second
+  // merges one hash partition of the groups of all drivers into
+  // 'mergeGroupingSet_'.
+  bool parallelMerge_{false};
+  std::unique_ptr<GroupingSet> mergeGroupingSet_;
+  // Protects 'mergePartitions_' and 'mergeInput_', which the last driver to
+  // finish its input moves across drivers.
+  std::mutex mergeMutex_;
+  // The input type of the aggregation, which is also the input type of
+  // 'mergeGroupingSet_'.
+  RowTypePtr mergeInputType_;
+  // The type of the intermediate results of 'groupingSet_': the grouping keys
+  // followed by one intermediate column per aggregate.
+  RowTypePtr intermediateType_;
+  // The input channel of each column of 'intermediateType_'.
+  std::vector<column_index_t> mergeInputChannels_;
+  // The input channels of the grouping keys.
+  std::vector<column_index_t> mergeKeyChannels_;
+  // The groups of this driver per merge partition. Set on no more input and
+  // handed over to the peers by the last driver to finish its input.
+  std::vector<std::vector<RowVectorPtr>> mergePartitions_;
+  // The groups of all drivers in the merge partition of this driver.
+  std::vector<RowVectorPtr> mergeInput_;
+  // True after 'mergeInput_' has been added to 'mergeGroupingSet_'.
+  bool mergeInputAdded_{false};
+  // Set while waiting for the peer drivers to partition their groups.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  // Set if the aggregation also does the work of its source GroupId.
+  const std::shared_ptr<const core::GroupIdNode> groupIdNode_;
+  // Merges the groups of all grouping keys in 'groupingSet_' into the groups
+  // of each grouping set. Its input has the grouping keys of the aggregation
+  // followed by one intermediate result column per aggregate.
+  std::unique_ptr<GroupingSet> rollupGroupingSet_;
+  // The type of the groups of 'groupingSet_': the distinct input columns of
+  // the grouping keys followed by one intermediate column per aggregate.
+  RowTypePtr rollupIntermediateType_;
+  // The input type of 'rollupGroupingSet_'.
+  RowTypePtr rollupInputType_;
+  // For each grouping set, the column of 'rollupIntermediateType_' of each
+  // grouping key of the aggregation. kConstantChannel for the keys that are
+  // null in the grouping set and the groupId key.
+  std::vector<std::vector<column_index_t>> rollupKeyChannels_;
+  // The index of the groupId column among the grouping keys, if any.
+  std::optional<column_index_t> rollupGroupIdKey_;
+  // True after the groups of 'groupingSet_' have been added to
+  // 'rollupGroupingSet_'.
+  bool rollupInputAdded_{false};
 };
 
 } // namespace facebook::velox::exec
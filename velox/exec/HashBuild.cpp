@@ -72,6 +72,8 @@ HashBuild::HashBuild(
           driverCtx->queryConfig().abandonHashBuildDedupMinRows()),
       abandonHashBuildDedupMinPct_(
           driverCtx->queryConfig().abandonHashBuildDedupMinPct()),
+      hybridSpillEnabled_(
+          driverCtx->queryConfig().hashJoinHybridSpillEnabled()),
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
@@ -141,14 +143,29 @@ bool HashBuild::setupCachedHashTable() {
     return false;
   }
 
-  const auto& queryId = operatorCtx_->task()->queryCtx()->queryId();
-  cacheKey_ = fmt::format("{}:{}", queryId, planNodeId());
-
-  // Get or create the cache entry (which includes the pool).
-  // If another task is already building, future_ will be set.
   auto* cache = HashTableCache::instance();
   auto* queryCtx = operatorCtx_->task()->queryCtx().get();
-  cacheEntry_ = cache->get(cacheKey_, taskId(), queryCtx, &future_);
+  const auto dataVersion =
+      queryCtx->queryConfig().hashTableCacheCrossQueryVersion();
+  if (!dataVersion.empty()) {
+    cacheKey_ = HashTableCache::sharedKey(*joinNode_, dataVersion);
+  }
+
+  if (!cacheKey_.empty()) {
+    cacheEntry_ = cache->getShared(
+        cacheKey_, taskId(), planNodeId(), queryCtx, &future_);
+    if (cacheEntry_ == nullptr) {
+      // Another query is building the table. Build a private table rather
+      // than wait on it.
+      cacheKey_.clear();
+      return false;
+    }
+  } else {
+    cacheKey_ = fmt::format("{}:{}", queryCtx->queryId(), planNodeId());
+    // Get or create the cache entry (which includes the pool).
+    // If another task is already building, future_ will be set.
+    cacheEntry_ = cache->get(cacheKey_, taskId(), queryCtx, &future_);
+  }
   VELOX_CHECK_NOT_NULL(cacheEntry_);
   VELOX_CHECK_NOT_NULL(cacheEntry_->tablePool);
 
@@ -244,7 +261,9 @@ void HashBuild::setupTable() {
         true, // hasProbedFlag
         false, // hasCountFlag
         queryConfig.minTableRowsForParallelJoinBuild(),
-        tableMemoryPool());
+        tableMemoryPool(),
+        0, // bloomFilterMaxSize
+        queryConfig.joinBuildRadixPartitionBytes());
   } else {
     // Right semi join needs to tag build rows that were probed.
     const bool needProbedFlag = joinNode_->isRightSemiFilterJoin();
@@ -259,7 +278,9 @@ void HashBuild::setupTable() {
           needProbedFlag, // hasProbedFlag
           hasCountFlag,
           queryConfig.minTableRowsForParallelJoinBuild(),
-          tableMemoryPool());
+          tableMemoryPool(),
+          0, // bloomFilterMaxSize
+          queryConfig.joinBuildRadixPartitionBytes());
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -270,9 +291,13 @@ void HashBuild::setupTable() {
           hasCountFlag,
           queryConfig.minTableRowsForParallelJoinBuild(),
           tableMemoryPool(),
-          queryConfig.hashProbeBloomFilterPushdownMaxSize());
+          queryConfig.hashProbeBloomFilterPushdownMaxSize(),
+          queryConfig.joinBuildRadixPartitionBytes());
     }
   }
+  if (queryConfig.joinBuildInternStrings()) {
+    table_->rows()->enableStringInterning();
+  }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
   if (abandonHashBuildDedupMinPct_ == 0 && !joinNode_->isCountingJoin()) {
     // Building a HashTable without duplicates is disabled if
@@ -308,7 +333,10 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   uint8_t startPartitionBit = config->startPartitionBit;
   if (spillPartition != nullptr) {
     spillInputReader_ = spillPartition->createUnorderedReader(
-        config->readBufferSize, pool(), spillStats_.get());
+        config->readBufferSize,
+        pool(),
+        spillStats_.get(),
+        config->readAheadExecutor());
     VELOX_CHECK(!restoringPartitionId_.has_value());
     restoringPartitionId_ = spillPartition->id();
     const auto numPartitionBits = config->numPartitionBits;
@@ -522,10 +550,21 @@ void HashBuild::addInput(RowVectorPtr input) {
     abandonHashBuildDedup();
   }
 
+  FlatVector<bool>* spillProbedFlagVector{nullptr};
+  if (isInputFromSpill() && needProbedFlagSpill_) {
+    spillProbedFlagVector =
+        input->childAt(spillProbedFlagChannel_)->asFlatVector<bool>();
+  }
+  storeActiveRows(spillProbedFlagVector);
+}
+
+void HashBuild::storeActiveRows(
+    const FlatVector<bool>* spillProbedFlagVector) {
   if (analyzeKeys_ && hashes_.size() < activeRows_.end()) {
     hashes_.resize(activeRows_.end());
   }
 
+  auto& hashers = table_->hashers();
   // As long as analyzeKeys is true, we keep running the keys through
   // the Vectorhashers so that we get a possible mapping of the keys
   // to small ints for array or normalized key. When mayUseValueIds is
@@ -541,12 +580,6 @@ void HashBuild::addInput(RowVectorPtr input) {
   }
   auto rows = table_->rows();
   auto nextOffset = rows->nextOffset();
-  FlatVector<bool>* spillProbedFlagVector{nullptr};
-  if (isInputFromSpill() && needProbedFlagSpill_) {
-    spillProbedFlagVector =
-        input->childAt(spillProbedFlagChannel_)->asFlatVector<bool>();
-  }
-
   activeRows_.applyToSelected([&](auto rowIndex) {
     char* newRow = rows->newRow();
     if (nextOffset) {
@@ -882,6 +915,7 @@ bool HashBuild::finishHashBuild() {
   if (spiller_ != nullptr) {
     spiller_->finishSpill(spillPartitions);
     removeEmptyPartitions(spillPartitions);
+    restoreResidentPartitions(spillPartitions);
   }
 
   // TODO: Get accurate signal if parallel join build is going to be applied
@@ -952,6 +986,77 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+void HashBuild::restoreResidentPartitions(SpillPartitionSet& spillPartitions) {
+  // Null-aware joins need the whole build side to decide on null keys, and
+  // the deduplicated build inserts through the hash table, so both read back
+  // the spilled partitions one at a time after the probe.
+  if (!hybridSpillEnabled_ || spillPartitions.empty() || nullAware_ ||
+      (dropDuplicates_ && !abandonHashBuildDedup_)) {
+    return;
+  }
+  VELOX_CHECK_EQ(table_->rows()->numRows(), 0);
+
+  // The rows and the hash table take about twice the serialized size.
+  constexpr uint64_t kMemoryPerSpillByte = 2;
+  std::vector<SpillPartition*> partitions;
+  partitions.reserve(spillPartitions.size());
+  for (const auto& [id, partition] : spillPartitions) {
+    partitions.push_back(partition.get());
+  }
+  // Reads back the smallest partitions first to keep as many of them in
+  // memory as possible.
+  std::sort(
+      partitions.begin(),
+      partitions.end(),
+      [](const SpillPartition* lhs, const SpillPartition* rhs) {
+        return lhs->size() < rhs->size();
+      });
+
+  const auto* config = spillConfig();
+  int32_t numResidentPartitions{0};
+  for (auto* partition : partitions) {
+    if (!pool()->maybeReserve(partition->size() * kMemoryPerSpillByte)) {
+      break;
+    }
+    auto reader = partition->createUnorderedReader(
+        config->readBufferSize,
+        pool(),
+        spillStats_.get(),
+        config->readAheadExecutor());
+    RowVectorPtr input;
+    while (reader->nextBatch(input)) {
+      addSpilledRows(input);
+    }
+    const auto id = partition->id();
+    spillPartitions.erase(id);
+    ++numResidentPartitions;
+  }
+  if (numResidentPartitions > 0) {
+    stats_.wlock()->addRuntimeStat(
+        std::string(kNumResidentSpillPartitions),
+        RuntimeCounter(numResidentPartitions));
+  }
+}
+
+void HashBuild::addSpilledRows(const RowVectorPtr& input) {
+  activeRows_.resize(input->size());
+  activeRows_.setAll();
+
+  // The spilled columns are in the order of the table columns.
+  auto& hashers = table_->hashers();
+  for (auto i = 0; i < hashers.size(); ++i) {
+    hashers[i]->decode(*input->childAt(i)->loadedVector(), activeRows_);
+  }
+  for (auto i = 0; i < decoders_.size(); ++i) {
+    decoders_[i]->decode(
+        *input->childAt(i + hashers.size())->loadedVector(), activeRows_);
+  }
+  storeActiveRows(
+      needProbedFlagSpill_
+          ? input->childAt(spillProbedFlagChannel_)->asFlatVector<bool>()
+          : nullptr);
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -1086,6 +1191,15 @@ void HashBuild::addRuntimeStats() {
         RuntimeCounter(timing.cpuNanos, RuntimeCounter::Unit::kNanos));
   }
 
+  for (const auto numRadixPartitions :
+       table_->parallelJoinBuildStats().radixPartitions) {
+    if (numRadixPartitions > 1) {
+      lockedStats->addRuntimeStat(
+          std::string(BaseHashTable::kParallelJoinRadixPartitions),
+          RuntimeCounter(numRadixPartitions));
+    }
+  }
+
   for (const auto& timing :
        table_->parallelJoinBuildStats().bloomFilterPartitionTimings) {
     lockedStats->getOutputTiming.add(timing);
@@ -1452,9 +1566,13 @@ void HashBuildSpiller::extractSpill(
 
   auto* result = resultPtr.get();
   const auto& types = container_->columnTypes();
-  for (auto i = 0; i < types.size(); ++i) {
-    container_->extractColumn(rows.data(), rows.size(), i, result->childAt(i));
-  }
+  std::vector<column_index_t> columnIndices(types.size());
+  std::iota(columnIndices.begin(), columnIndices.end(), 0);
+  container_->extractColumns(
+      rows.data(),
+      rows.size(),
+      columnIndices,
+      folly::Range(result->children().data(), types.size()));
   if (spillProbeFlag_) {
     container_->extractProbedFlags(
         rows.data(), rows.size(), false, false, result->childAt(types.size()));
@@ -63,6 +63,9 @@ class HashBuild final : public Operator {
   /// Whether dedup hash build was abandoned.
   static constexpr std::string_view kAbandonBuildNoDupHash =
       "abandonBuildNoDupHash";
+  /// Number of spilled partitions read back into the table by hybrid spill.
+  static constexpr std::string_view kNumResidentSpillPartitions =
+      "numResidentSpillPartitions";
 
   HashBuild(
       int32_t operatorId,
@@ -150,6 +153,20 @@ class HashBuild final : public Operator {
   // process which will be set by the join probe side.
   void postHashBuildProcess();
 
+  // Invoked by the last build driver if 'hash_join_hybrid_spill_enabled' is
+  // set to read back the smallest partitions of 'spillPartitions' into
+  // 'table_' while memory can be reserved for them. Removes the read back
+  // partitions from 'spillPartitions'. The probe joins the rows of these
+  // partitions in memory instead of spilling them.
+  void restoreResidentPartitions(SpillPartitionSet& spillPartitions);
+
+  // Adds the rows of 'input' read from a spilled partition to 'table_'.
+  void addSpilledRows(const RowVectorPtr& input);
+
+  // Stores the 'activeRows_' of the decoded input in 'table_'. If
+  // 'spillProbedFlagVector' is set, sets the probed flag of the rows from it.
+  void storeActiveRows(const FlatVector<bool>* spillProbedFlagVector);
+
   bool canSpill() const override;
 
   // Indicates if the input is read from spill data or not.
@@ -291,6 +308,10 @@ class HashBuild final : public Operator {
   // worthwhile.
   const int32_t abandonHashBuildDedupMinPct_;
 
+  // If true, the last build driver reads back spilled partitions that fit in
+  // memory. See 'restoreResidentPartitions()'.
+  const bool hybridSpillEnabled_;
+
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
   tsan_atomic<bool> exceededMaxSpillLevelLimit_{false};
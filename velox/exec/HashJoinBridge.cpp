@@ -87,7 +87,10 @@ void HashJoinBridge::reclaim() {
   buildResult_->table->clear(true);
 
   appendSpilledHashTablePartitionsLocked(std::move(spillPartitionSet));
-  buildResult_->spillPartitionIds = spillPartitionIdSet;
+  // With hybrid spill, the table might only have the partitions that have
+  // not been spilled by the build.
+  buildResult_->spillPartitionIds.insert(
+      spillPartitionIdSet.begin(), spillPartitionIdSet.end());
   VELOX_CHECK(!restoringSpillPartitionId_.has_value());
 }
 
@@ -221,7 +224,6 @@ void HashJoinBridge::setHashTable(
     bool hasNullKeys,
     HashJoinTableSpillFunc&& tableSpillFunc) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
-  VELOX_CHECK(table->numDistinct() == 0 || spillPartitionSet.empty());
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
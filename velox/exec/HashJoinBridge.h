@@ -103,9 +103,10 @@ class HashJoinBridge : public JoinBridge {
     /// not built from restoration.
     std::optional<SpillPartitionId> restoredPartitionId;
 
-    /// Spilled partitions while building hash table. Since we don't support
-    /// fine-grained spilling for hash table, either 'table' is empty or
-    /// 'spillPartitionIds' is empty.
+    /// Spilled partitions while building hash table. Either 'table' is empty
+    /// or 'spillPartitionIds' is empty, unless 'hash_join_hybrid_spill_enabled'
+    /// is set. Then 'table' has the rows of the partitions not in
+    /// 'spillPartitionIds'.
     SpillPartitionIdSet spillPartitionIds;
   };
 
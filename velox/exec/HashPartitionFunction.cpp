@@ -37,9 +37,16 @@ HashPartitionFunction::HashPartitionFunction(
     int numPartitions,
     const RowTypePtr& inputType,
     const std::vector<column_index_t>& keyChannels,
-    const std::vector<VectorPtr>& constValues)
-    : localExchange_{localExchange}, numPartitions_{numPartitions} {
+    const std::vector<VectorPtr>& constValues,
+    bool spreadHeavyHitters)
+    : localExchange_{localExchange},
+      numPartitions_{numPartitions},
+      spreadHeavyHitters_{spreadHeavyHitters && numPartitions > 1} {
+  VELOX_CHECK(!spreadHeavyHitters || localExchange);
   init(inputType, keyChannels, constValues);
+  if (spreadHeavyHitters_) {
+    sketch_.resize(kSketchDepth << kSketchWidthBits, 0);
+  }
 }
 
 HashPartitionFunction::HashPartitionFunction(
@@ -107,7 +114,16 @@ std::optional<uint32_t> HashPartitionFunction::partition(
       }
     }
   } else {
-    if (localExchange_) {
+    if (spreadHeavyHitters_) {
+      for (auto i = 0; i < size; ++i) {
+        if (addToSketch(hashes_[i])) {
+          partitions[i] = nextSpreadPartition_++ % numPartitions_;
+          ++numSpreadRows_;
+        } else {
+          partitions[i] = localExchangeHash(hashes_[i]) % numPartitions_;
+        }
+      }
+    } else if (localExchange_) {
       for (auto i = 0; i < size; ++i) {
         partitions[i] = localExchangeHash(hashes_[i]) % numPartitions_;
       }
@@ -121,11 +137,38 @@ std::optional<uint32_t> HashPartitionFunction::partition(
   return std::nullopt;
 }
 
+bool HashPartitionFunction::addToSketch(uint64_t hash) {
+  constexpr uint64_t kWidthMask = (1 << kSketchWidthBits) - 1;
+  uint32_t count = std::numeric_limits<uint32_t>::max();
+  for (auto i = 0; i < kSketchDepth; ++i) {
+    auto& counter =
+        sketch_[(i << kSketchWidthBits) +
+                ((hash >> (i * kSketchWidthBits)) & kWidthMask)];
+    count = std::min(count, ++counter);
+  }
+  if (++numSketchRows_ == kSketchDecayRows) {
+    for (auto& counter : sketch_) {
+      counter /= 2;
+    }
+    numSketchRows_ /= 2;
+  }
+  return numSketchRows_ >= kMinSketchRows &&
+      uint64_t{count} * 2 * numPartitions_ > numSketchRows_;
+}
+
 std::unique_ptr<core::PartitionFunction> HashPartitionFunctionSpec::create(
     int numPartitions,
     bool localExchange) const {
+  VELOX_USER_CHECK(
+      !spreadHeavyHitters_ || localExchange,
+      "Spreading heavy hitters is only supported for local exchange");
   return std::make_unique<exec::HashPartitionFunction>(
-      localExchange, numPartitions, inputType_, keyChannels_, constValues_);
+      localExchange,
+      numPartitions,
+      inputType_,
+      keyChannels_,
+      constValues_,
+      spreadHeavyHitters_);
 }
 
 std::string HashPartitionFunctionSpec::toString() const {
@@ -143,7 +186,10 @@ std::string HashPartitionFunctionSpec::toString() const {
     }
   }
 
-  return fmt::format("HASH({})", keys.str());
+  return fmt::format(
+      "HASH({}){}",
+      keys.str(),
+      spreadHeavyHitters_ ? " SPREAD HEAVY HITTERS" : "");
 }
 
 folly::dynamic HashPartitionFunctionSpec::serialize() const {
@@ -158,6 +204,7 @@ folly::dynamic HashPartitionFunctionSpec::serialize() const {
     constValues.emplace_back(value);
   }
   obj["constants"] = ISerializable::serialize(constValues);
+  obj["spreadHeavyHitters"] = spreadHeavyHitters_;
   return obj;
 }
 
@@ -178,6 +225,9 @@ core::PartitionFunctionSpecPtr HashPartitionFunctionSpec::deserialize(
     constValues.emplace_back(value->toConstantVector(pool));
   }
   return std::make_shared<HashPartitionFunctionSpec>(
-      ISerializable::deserialize<RowType>(obj["inputType"]), keys, constValues);
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      keys,
+      constValues,
+      obj.getDefault("spreadHeavyHitters", false).asBool());
 }
 } // namespace facebook::velox::exec
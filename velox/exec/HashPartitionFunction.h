@@ -27,6 +27,14 @@ namespace facebook::velox::exec {
 /// numPartitions allows the keyChannels argument to be empty. If keyChannels is
 /// empty, then the resulting partition number of partition() will always be
 /// zero.
+///
+/// If 'spreadHeavyHitters' is true, the rows of a key that has more than half
+/// the fair share of a partition of the rows seen so far go to all partitions
+/// round robin instead of to the partition of the key. The keys are counted
+/// with a count-min sketch over their hashes. This is for a local exchange in
+/// front of a hash join probe, which does not need the rows of a key in one
+/// partition since all the probe drivers share one hash table, and otherwise
+/// has one consumer do the probe work of a skewed key.
 class HashPartitionFunction : public core::PartitionFunction {
  public:
   HashPartitionFunction(
@@ -34,7 +42,8 @@ class HashPartitionFunction : public core::PartitionFunction {
       int numPartitions,
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
-      const std::vector<VectorPtr>& constValues = {});
+      const std::vector<VectorPtr>& constValues = {},
+      bool spreadHeavyHitters = false);
 
   HashPartitionFunction(
       const HashBitRange& hashBitRange,
@@ -52,17 +61,41 @@ class HashPartitionFunction : public core::PartitionFunction {
     return numPartitions_;
   }
 
+  /// Number of rows that were spread round robin as heavy hitters.
+  uint64_t numSpreadRows() const {
+    return numSpreadRows_;
+  }
+
  private:
+  // Depth and width of 'sketch_'.
+  static constexpr int32_t kSketchDepth = 4;
+  static constexpr int32_t kSketchWidthBits = 10;
+  // Minimum number of rows seen before keys are counted as heavy hitters.
+  static constexpr uint64_t kMinSketchRows = 1'024;
+  // Number of rows seen after which the counts are halved, so that keys stop
+  // being heavy hitters when they become rare.
+  static constexpr uint64_t kSketchDecayRows = 1 << 20;
+
   void init(
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
       const std::vector<VectorPtr>& constValues);
 
+  // Adds 'hash' to 'sketch_' and returns true if its key is a heavy hitter.
+  bool addToSketch(uint64_t hash);
+
   const bool localExchange_;
   const int numPartitions_;
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
+  const bool spreadHeavyHitters_{false};
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
+  // Count-min sketch of the key hashes if 'spreadHeavyHitters_' is set.
+  std::vector<uint32_t> sketch_;
+  uint64_t numSketchRows_{0};
+  uint32_t nextSpreadPartition_{0};
+  uint64_t numSpreadRows_{0};
+
   // Reusable memory.
   SelectivityVector rows_;
   raw_vector<uint64_t> hashes_;
@@ -73,15 +106,19 @@ class HashPartitionFunction : public core::PartitionFunction {
 /// constant, use index 'kConstantChannel' to indicate so and store the constant
 /// value as a base vector in 'constValues'
 /// The 'constValues' size is less than or equal to 'keyChannels' size
+/// 'spreadHeavyHitters' is only supported for local exchange. See
+/// HashPartitionFunction.
 class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
  public:
   HashPartitionFunctionSpec(
       RowTypePtr inputType,
       std::vector<column_index_t> keyChannels,
-      std::vector<VectorPtr> constValues = {})
+      std::vector<VectorPtr> constValues = {},
+      bool spreadHeavyHitters = false)
       : inputType_{std::move(inputType)},
         keyChannels_{std::move(keyChannels)},
-        constValues_{std::move(constValues)} {}
+        constValues_{std::move(constValues)},
+        spreadHeavyHitters_{spreadHeavyHitters} {}
 
   std::unique_ptr<core::PartitionFunction> create(
       int numPartitions,
@@ -99,5 +136,6 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   const RowTypePtr inputType_;
   const std::vector<column_index_t> keyChannels_;
   const std::vector<VectorPtr> constValues_;
+  const bool spreadHeavyHitters_;
 };
 } // namespace facebook::velox::exec
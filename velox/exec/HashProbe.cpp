@@ -129,6 +129,8 @@ HashProbe::HashProbe(
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
       probeType_(joinNode_->sources()[0]->outputType()),
+      dictionaryBuildOutput_(
+          driverCtx->queryConfig().hashProbeDictionaryBuildOutputEnabled()),
       canOutputBuildRowsInParallel_(
           driverCtx->queryConfig().parallelOutputJoinBuildRowsEnabled() &&
           !canSpill()),
@@ -381,10 +383,9 @@ void HashProbe::initializeResultIter() {
 
 void HashProbe::pushdownDynamicFilters() {
   auto* driver = operatorCtx_->driverCtx()->driver;
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
   const bool hashProbeStringDynamicFilterPushdownEnabled =
-      operatorCtx_->driverCtx()
-          ->queryConfig()
-          .hashProbeStringDynamicFilterPushdownEnabled();
+      queryConfig.hashProbeStringDynamicFilterPushdownEnabled();
   auto numFilters = driver->pushdownFilters(
       this,
       keyChannels_,
@@ -402,16 +403,18 @@ void HashProbe::pushdownDynamicFilters() {
         }
         filter = hasher.getFilter(false);
         if (!filter) {
-          filter = hasher.getBloomFilter();
-          if (!filter) {
+          if (!hasher.getBloomFilter()) {
             return false;
           }
           auto* bloomFilter =
-              checkedPointerCast<const common::BigintValuesUsingBloomFilter>(
-                  filter.get());
+              checkedPointerCast<const common::RuntimeBloomFilter>(
+                  hasher.getBloomFilter().get());
           addRuntimeStat(
               std::string(HashProbe::kBloomFilterSize),
               RuntimeCounter(bloomFilter->blocksByteSize()));
+          filter = bloomFilter->withSelectivity(
+              queryConfig.hashProbeBloomFilterMinRowsToDisable(),
+              queryConfig.hashProbeBloomFilterMaxPassPct());
         }
         dynamicFiltersProducedOnChannels_.insert(sourceChannel);
         for (auto* peer : findPeerOperators()) {
@@ -880,7 +883,7 @@ void HashProbe::fillOutput(vector_size_t size) {
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
-  } else {
+  } else if (!dictionaryBuildOutput_ || !fillDictionaryBuildOutput(size)) {
     extractColumns(
         table_.get(),
         folly::Range<char* const*>(outputTableRows_->as<char*>(), size),
@@ -891,6 +894,42 @@ void HashProbe::fillOutput(vector_size_t size) {
   }
 }
 
+bool HashProbe::fillDictionaryBuildOutput(vector_size_t size) {
+  if (tableOutputProjections_.empty()) {
+    return false;
+  }
+  auto indices = allocateIndices(size, pool());
+  if (!findDistinctRows(
+          folly::Range<char* const*>(outputTableRows_->as<char*>(), size),
+          size / 2,
+          distinctRowIndices_,
+          distinctOutputRows_,
+          indices->asMutable<vector_size_t>())) {
+    return false;
+  }
+
+  // Misses of outer joins are nullptr rows, which extract as nulls.
+  distinctOutputValues_.resize(outputType_->size());
+  extractColumns(
+      table_.get(),
+      folly::Range<char* const*>(
+          distinctOutputRows_.data(), distinctOutputRows_.size()),
+      tableOutputProjections_,
+      pool(),
+      outputType_->children(),
+      distinctOutputValues_);
+  for (const auto& projection : tableOutputProjections_) {
+    output_->childAt(projection.outputChannel) = BaseVector::wrapInDictionary(
+        nullptr,
+        indices,
+        size,
+        distinctOutputValues_[projection.outputChannel]);
+  }
+  addRuntimeStat(
+      std::string(kDictionaryBuildOutputBatches), RuntimeCounter(1));
+  return true;
+}
+
 RowVectorPtr HashProbe::getBuildSideOutput() {
   if (buildSideOutputRowContainerId_ == -1) {
     buildSideOutputRowContainerId_ =
@@ -17,6 +17,8 @@
 
 #include <string_view>
 
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
@@ -34,6 +36,10 @@ class HashProbe : public Operator {
   /// Number of rows bypassed via dynamic filter replacement.
   static constexpr std::string_view kReplacedWithDynamicFilterRows =
       "replacedWithDynamicFilterRows";
+  /// Number of output batches with the build side columns as dictionaries
+  /// over the distinct build rows.
+  static constexpr std::string_view kDictionaryBuildOutputBatches =
+      "dictionaryBuildOutputBatches";
 
   HashProbe(
       int32_t operatorId,
@@ -164,6 +170,11 @@ class HashProbe : public Operator {
   // Populate output columns.
   void fillOutput(vector_size_t size);
 
+  // Populates the build side output columns as dictionaries over the distinct
+  // rows of 'outputTableRows_'. Returns false without populating the columns
+  // if less than half of the rows repeat.
+  bool fillDictionaryBuildOutput(vector_size_t size);
+
   // Populate 'match' output column for the left semi join project,
   void fillLeftSemiProjectMatchColumn(vector_size_t size);
 
@@ -399,6 +410,9 @@ class HashProbe : public Operator {
 
   const RowTypePtr probeType_;
 
+  // True if QueryConfig::kHashProbeDictionaryBuildOutputEnabled is set.
+  const bool dictionaryBuildOutput_;
+
   // Flag to indicate whether this hash probe operator can output build-side
   // rows in parallel with the peer operators for the current hash table.
   // Outputting build-side rows in parallel is currently not allowed in either
@@ -528,6 +542,13 @@ class HashProbe : public Operator {
   BufferPtr outputTableRows_;
   vector_size_t outputTableRowsCapacity_;
 
+  // Scratch memory for the distinct rows of 'outputTableRows_' and their
+  // values in the build side output columns if 'dictionaryBuildOutput_' is
+  // set. 'distinctOutputValues_' is indexed by output channel.
+  folly::F14FastMap<const char*, vector_size_t> distinctRowIndices_;
+  std::vector<char*> distinctOutputRows_;
+  std::vector<VectorPtr> distinctOutputValues_;
+
   // For left join with filter, we could overwrite the row which we have not
   // checked if there is a carryover.  Use a temporary buffer in this case.
   BufferPtr tempOutputTableRows_;
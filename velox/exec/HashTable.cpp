@@ -54,11 +54,13 @@ HashTable<ignoreNullKeys>::HashTable(
     bool hasCountFlag,
     uint32_t minTableSizeForParallelJoinBuild,
     memory::MemoryPool* pool,
-    uint64_t bloomFilterMaxSize)
+    uint64_t bloomFilterMaxSize,
+    uint64_t joinBuildRadixPartitionBytes)
     : BaseHashTable(std::move(hashers)),
       pool_(pool),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
       bloomFilterMaxSize_(bloomFilterMaxSize),
+      joinBuildRadixPartitionBytes_(joinBuildRadixPartitionBytes),
       isJoinBuild_(isJoinBuild),
       allowDuplicates_(allowDuplicates),
       buildPartitionBounds_(raw_vector<PartitionBoundIndexType>(pool)) {
@@ -435,8 +437,61 @@ namespace {
 // Group prefetch size for join build & probe.
 constexpr int32_t kPrefetchSize = 64;
 
+// Number of rows between the tag load and the full probe of a row in
+// pipelinedProbe(). The bucket of a row is prefetched twice this many rows
+// before its full probe and the first hit row is prefetched this many rows
+// before. With tables much larger than the LLC this keeps enough misses in
+// flight to cover memory latency.
+constexpr int32_t kProbeDistance = 16;
+
+// Probes 'numProbes' rows with a software pipeline over a ring of probe
+// states. 'preProbe(state, i)' computes the bucket of the i-th row and
+// prefetches it, 'firstProbe(state)' compares the 16 tags of the bucket with
+// one SIMD compare and prefetches the first candidate row and
+// 'fullProbe(state)' compares the keys and follows collisions. Each row is in
+// flight for 2 * kProbeDistance rows. If 'fullProbe' inserts, it must reload
+// tags since a row in flight may have inserted into the same bucket after
+// the tags of a later row were loaded.
+template <typename PreProbe, typename FirstProbe, typename FullProbe>
+FOLLY_ALWAYS_INLINE void pipelinedProbe(
+    int32_t numProbes,
+    PreProbe preProbe,
+    FirstProbe firstProbe,
+    FullProbe fullProbe) {
+  constexpr int32_t kNumStates = 2 * kProbeDistance;
+  constexpr int32_t kMask = kNumStates - 1;
+  static_assert((kNumStates & kMask) == 0);
+  ProbeState states[kNumStates];
+  const int32_t numPreProbed = std::min(numProbes, kNumStates);
+  for (int32_t i = 0; i < numPreProbed; ++i) {
+    preProbe(states[i], i);
+  }
+  const int32_t numFirstProbed = std::min(numProbes, kProbeDistance);
+  for (int32_t i = 0; i < numFirstProbed; ++i) {
+    firstProbe(states[i]);
+  }
+  for (int32_t i = 0; i < numProbes; ++i) {
+    if (i + kProbeDistance < numProbes) {
+      firstProbe(states[(i + kProbeDistance) & kMask]);
+    }
+    auto& state = states[i & kMask];
+    fullProbe(state);
+    if (i + kNumStates < numProbes) {
+      preProbe(state, i + kNumStates);
+    }
+  }
+}
+
 constexpr int32_t kHashBatchSize = 1024;
 
+// Number of rows a radix partitioned join build sorts by radix partition before
+// inserting them.
+constexpr int32_t kRadixChunkRows = 64 * 1024;
+
+// Minimum average number of rows per radix partition in a chunk. Fewer rows per
+// insert step would lose the locality the partitioning is for.
+constexpr int32_t kMinRowsPerRadixPartition = 64;
+
 // Normalized keys have non0-random bits. Bits need to be propagated
 // up to make a tag byte and down so that non-lowest bits of
 // normalized key affect the hash table index.
@@ -485,76 +540,38 @@ void HashTable<ignoreNullKeys>::groupProbe(
     groupNormalizedKeyProbe(lookup);
     return;
   }
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  auto rows = lookup.rows.data();
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-
-    state1.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state2.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state3.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-    state4.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
-
-    fullProbe<false>(lookup, state1, false);
-    fullProbe<false>(lookup, state2, true);
-    fullProbe<false>(lookup, state3, true);
-    fullProbe<false>(lookup, state4, true);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<false>(lookup, state1, false);
-  }
+  const auto* rows = lookup.rows.data();
+  const auto* hashes = lookup.hashes.data();
+  pipelinedProbe(
+      lookup.rows.size(),
+      [&](ProbeState& state, int32_t i) INLINE_LAMBDA {
+        state.preProbe(*this, hashes[rows[i]], rows[i]);
+      },
+      [&](ProbeState& state) INLINE_LAMBDA {
+        state.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+      },
+      [&](ProbeState& state) INLINE_LAMBDA {
+        fullProbe<false>(lookup, state, true);
+      });
 }
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  auto rows = lookup.rows.data();
+  const auto* rows = lookup.rows.data();
+  const auto* hashes = lookup.hashes.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    state2.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    state3.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    state4.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    fullProbe<false, true>(lookup, state1, false);
-    fullProbe<false, true>(lookup, state2, true);
-    fullProbe<false, true>(lookup, state3, true);
-    fullProbe<false, true>(lookup, state4, true);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, kKeyOffset);
-    fullProbe<false, true>(lookup, state1, false);
-  }
+  pipelinedProbe(
+      lookup.rows.size(),
+      [&](ProbeState& state, int32_t i) INLINE_LAMBDA {
+        state.preProbe(*this, hashes[rows[i]], rows[i]);
+      },
+      [&](ProbeState& state) INLINE_LAMBDA {
+        state.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
+      },
+      [&](ProbeState& state) INLINE_LAMBDA {
+        fullProbe<false, true>(lookup, state, true);
+      });
 }
 
 template <bool ignoreNullKeys>
@@ -619,37 +636,17 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    state2.firstProbe(*this, 0);
-    state3.firstProbe(*this, 0);
-    state4.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-    fullProbe<true>(lookup, state2, false);
-    fullProbe<true>(lookup, state3, false);
-    fullProbe<true>(lookup, state4, false);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-  }
+  const uint64_t* hashes = lookup.hashes.data();
+  pipelinedProbe(
+      lookup.rows.size(),
+      [&](ProbeState& state, int32_t i) INLINE_LAMBDA {
+        state.preProbe(*this, hashes[rows[i]], rows[i]);
+      },
+      [&](ProbeState& state) INLINE_LAMBDA { state.firstProbe(*this, 0); },
+      [&](ProbeState& state) INLINE_LAMBDA {
+        fullProbe<true>(lookup, state, false);
+      });
 }
 
 template <bool ignoreNullKeys>
@@ -696,33 +693,23 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
-  ProbeState states[kPrefetchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
-  for (; probeIndex + kPrefetchSize <= numProbes; probeIndex += kPrefetchSize) {
-    for (int32_t i = 0; i < kPrefetchSize; ++i) {
-      int32_t row = rows[probeIndex + i];
-      states[i].preProbe(*this, hashes[row], row);
-    }
-    for (int32_t i = 0; i < kPrefetchSize; ++i) {
-      states[i].firstProbe(*this, kKeyOffset);
-    }
-    for (int32_t i = 0; i < kPrefetchSize; ++i) {
-      hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(*this, keys);
-    }
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    states[0].preProbe(*this, lookup.hashes[row], row);
-    states[0].firstProbe(*this, 0);
-    hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
-  }
+  pipelinedProbe(
+      lookup.rows.size(),
+      [&](ProbeState& state, int32_t i) INLINE_LAMBDA {
+        state.preProbe(*this, hashes[rows[i]], rows[i]);
+      },
+      [&](ProbeState& state) INLINE_LAMBDA {
+        state.firstProbe(*this, kKeyOffset);
+      },
+      [&](ProbeState& state) INLINE_LAMBDA {
+        hits[state.row()] = state.joinNormalizedKeyFullProbe(*this, keys);
+      });
 }
 
 template <bool ignoreNullKeys>
@@ -786,7 +773,11 @@ void HashTable<ignoreNullKeys>::checkSize(
 
   const int64_t newNumDistincts = numNew + numDistinct_;
   if (table_ == nullptr || capacity_ == 0) {
-    const auto newSize = newHashTableEntries(numDistinct_, numNew);
+    const uint64_t expectedNew = expectedNumDistinct_ > numDistinct_
+        ? expectedNumDistinct_ - numDistinct_
+        : 0;
+    const auto newSize = newHashTableEntries(
+        numDistinct_, std::max<uint64_t>(numNew, expectedNew));
     allocateTables(newSize, spillInputStartPartitionBit);
     if (numDistinct_ > 0) {
       rehash(initNormalizedKeys, spillInputStartPartitionBit);
@@ -852,20 +843,36 @@ bool HashTable<ignoreNullKeys>::hashRows(
 
 namespace {
 
+// Returns the value of a bloom filter key column at 'offset' in 'row'. Strings
+// that are not contiguous in the RowContainer are copied into 'storage'.
 template <typename T>
+auto loadBloomFilterValue(
+    const char* row,
+    int32_t offset,
+    std::string& storage) {
+  if constexpr (std::is_same_v<T, StringView>) {
+    return std::string_view(HashStringAllocator::contiguousString(
+        folly::loadUnaligned<StringView>(row + offset), storage));
+  } else {
+    return folly::loadUnaligned<T>(row + offset);
+  }
+}
+
+template <typename T, typename TFilter>
 void partitionBloomFilterRowsImpl(
     int32_t offset,
-    const common::BigintValuesUsingBloomFilter& filter,
+    const TFilter& filter,
     const RowContainer& rowContainer,
     uint8_t partitionMask,
     RowPartitions& rowPartitions) {
   char* rows[kHashBatchSize];
   uint8_t partitions[kHashBatchSize];
+  std::string storage;
   RowContainerIterator iter;
   while (auto numRows = rowContainer.listRows(
              &iter, kHashBatchSize, RowContainer::kUnlimited, rows)) {
     for (int i = 0; i < numRows; ++i) {
-      auto value = folly::loadUnaligned<T>(rows[i] + offset);
+      auto value = loadBloomFilterValue<T>(rows[i], offset, storage);
       partitions[i] = filter.blockIndex(value) & partitionMask;
     }
     rowPartitions.appendPartitions(
@@ -876,34 +883,53 @@ void partitionBloomFilterRowsImpl(
 void partitionBloomFilterRows(
     const VectorHasher& hasher,
     int32_t offset,
-    const common::BigintValuesUsingBloomFilter& filter,
+    const common::RuntimeBloomFilter& filter,
     const RowContainer& rowContainer,
     uint8_t numPartitions,
     RowPartitions& rowPartitions) {
   VELOX_DCHECK(hasher.supportsBloomFilter());
   VELOX_DCHECK(bits::isPowerOfTwo(numPartitions));
+  const uint8_t mask = numPartitions - 1;
   switch (hasher.typeKind()) {
     case TypeKind::INTEGER:
       partitionBloomFilterRowsImpl<int32_t>(
-          offset, filter, rowContainer, numPartitions - 1, rowPartitions);
+          offset,
+          *filter.as<common::BigintValuesUsingBloomFilter>(),
+          rowContainer,
+          mask,
+          rowPartitions);
       break;
     case TypeKind::BIGINT:
       partitionBloomFilterRowsImpl<int64_t>(
-          offset, filter, rowContainer, numPartitions - 1, rowPartitions);
+          offset,
+          *filter.as<common::BigintValuesUsingBloomFilter>(),
+          rowContainer,
+          mask,
+          rowPartitions);
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      partitionBloomFilterRowsImpl<StringView>(
+          offset,
+          *filter.as<common::BytesValuesUsingBloomFilter>(),
+          rowContainer,
+          mask,
+          rowPartitions);
       break;
     default:
       VELOX_UNREACHABLE();
   }
 }
 
-template <typename T>
+template <typename T, typename TFilter>
 void buildBloomFilterImpl(
     int32_t offset,
     char** rows,
     int numRows,
-    common::BigintValuesUsingBloomFilter& filter) {
+    TFilter& filter) {
+  std::string storage;
   for (int i = 0; i < numRows; ++i) {
-    filter.insert(folly::loadUnaligned<T>(rows[i] + offset));
+    filter.insert(loadBloomFilterValue<T>(rows[i], offset, storage));
   }
 }
 
@@ -912,20 +938,49 @@ void buildBloomFilter(
     int32_t offset,
     char** rows,
     int numRows,
-    common::BigintValuesUsingBloomFilter& filter) {
+    common::RuntimeBloomFilter& filter) {
   VELOX_DCHECK(hasher.supportsBloomFilter());
   switch (hasher.typeKind()) {
     case TypeKind::INTEGER:
-      buildBloomFilterImpl<int32_t>(offset, rows, numRows, filter);
+      buildBloomFilterImpl<int32_t>(
+          offset,
+          rows,
+          numRows,
+          *filter.as<common::BigintValuesUsingBloomFilter>());
       break;
     case TypeKind::BIGINT:
-      buildBloomFilterImpl<int64_t>(offset, rows, numRows, filter);
+      buildBloomFilterImpl<int64_t>(
+          offset,
+          rows,
+          numRows,
+          *filter.as<common::BigintValuesUsingBloomFilter>());
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      buildBloomFilterImpl<StringView>(
+          offset,
+          rows,
+          numRows,
+          *filter.as<common::BytesValuesUsingBloomFilter>());
       break;
     default:
       VELOX_UNREACHABLE();
   }
 }
 
+// Makes an empty bloom filter for the values of 'hasher'.
+std::shared_ptr<common::RuntimeBloomFilter> makeBloomFilter(
+    const VectorHasher& hasher,
+    int64_t capacity) {
+  if (hasher.typeKind() == TypeKind::VARCHAR ||
+      hasher.typeKind() == TypeKind::VARBINARY) {
+    return std::make_shared<common::BytesValuesUsingBloomFilter>(
+        capacity, false);
+  }
+  return std::make_shared<common::BigintValuesUsingBloomFilter>(
+      capacity, false);
+}
+
 template <typename Source>
 void syncWorkItems(
     std::vector<std::shared_ptr<Source>>& items,
@@ -959,7 +1014,7 @@ void syncWorkItems(
 template <>
 bool HashTable<true>::bloomFilterSupported() const {
   if (!(bloomFilterMaxSize_ > 0 &&
-        common::BigintValuesUsingBloomFilter::numBlocks(numDistinct_) *
+        common::RuntimeBloomFilter::numBlocks(numDistinct_) *
                 sizeof(SplitBlockBloomFilter::Block) <=
             bloomFilterMaxSize_)) {
     return false;
@@ -1025,6 +1080,7 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
         "Turn on VELOX_ENABLE_INT64_BUILD_PARTITION_BOUND to avoid integer overflow in buildPartitionBounds_");
   }
   buildPartitionBounds_.back() = sizeMask_ + 1;
+  parallelJoinBuildStats_.radixPartitions.assign(numPartitions, 1);
   std::vector<std::shared_ptr<AsyncSource<bool>>> partitionSteps;
   std::vector<std::shared_ptr<AsyncSource<bool>>> buildSteps;
   std::vector<std::shared_ptr<AsyncSource<bool>>> bloomFilterPartitionSteps;
@@ -1125,8 +1181,7 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
       if (!hashers_[i]->supportsBloomFilter()) {
         continue;
       }
-      auto filter = std::make_shared<common::BigintValuesUsingBloomFilter>(
-          numDistinct_, false);
+      auto filter = makeBloomFilter(*hashers_[i], numDistinct_);
       hashers_[i]->setBloomFilter(filter);
       for (auto j = 0; j < numPartitions; ++j) {
         bool last = j == numPartitions - 1;
@@ -1249,6 +1304,12 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
       buildPartitionBounds_[partition],
       buildPartitionBounds_[partition + 1],
       overflow};
+  const auto radixShift = radixPartitionShift(partitionInfo);
+  if (radixShift >= 0) {
+    buildJoinPartitionByRadix(
+        partition, rowPartitions, radixShift, partitionInfo);
+    return;
+  }
   for (auto i = 0; i < numPartitions; ++i) {
     auto* table = i == 0 ? this : otherTables_[i - 1].get();
     RowContainerIterator iter;
@@ -1262,6 +1323,138 @@ void HashTable<ignoreNullKeys>::buildJoinPartition(
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::buildJoinPartitionByRadix(
+    uint8_t partition,
+    const std::vector<std::unique_ptr<RowPartitions>>& rowPartitions,
+    int32_t radixShift,
+    TableInsertPartitionInfo& partitionInfo) {
+  const int32_t numPartitions = 1 + otherTables_.size();
+  parallelJoinBuildStats_.radixPartitions[partition] =
+      ((partitionInfo.end - partitionInfo.start - 1) >> radixShift) + 1;
+  raw_vector<char*> rows(kRadixChunkRows, pool_);
+  raw_vector<uint64_t> hashes(kRadixChunkRows, pool_);
+  raw_vector<uint64_t> batchHashes(kHashBatchSize, pool_);
+  raw_vector<char*> sortedRows(kRadixChunkRows, pool_);
+  raw_vector<uint64_t> sortedHashes(kRadixChunkRows, pool_);
+  std::vector<int32_t> radixBounds;
+  int32_t numRows = 0;
+  // Collects chunks of rows with their hashes and inserts each chunk one radix
+  // partition at a time.
+  for (auto i = 0; i < numPartitions; ++i) {
+    auto* table = i == 0 ? this : otherTables_[i - 1].get();
+    RowContainerIterator iter;
+    for (;;) {
+      if (numRows + kHashBatchSize > kRadixChunkRows) {
+        insertForJoinByRadix(
+            rows,
+            hashes,
+            numRows,
+            radixShift,
+            sortedRows,
+            sortedHashes,
+            radixBounds,
+            partitionInfo);
+        numRows = 0;
+      }
+      const auto numBatchRows = table->rows_->listPartitionRows(
+          iter,
+          partition,
+          kHashBatchSize,
+          *rowPartitions[i],
+          rows.data() + numRows);
+      if (numBatchRows == 0) {
+        break;
+      }
+      VELOX_CHECK(hashRows(
+          folly::Range(rows.data() + numRows, numBatchRows),
+          false,
+          batchHashes));
+      std::copy(
+          batchHashes.data(),
+          batchHashes.data() + numBatchRows,
+          hashes.data() + numRows);
+      numRows += numBatchRows;
+      table->numParallelBuildRows_ += numBatchRows;
+    }
+  }
+  insertForJoinByRadix(
+      rows,
+      hashes,
+      numRows,
+      radixShift,
+      sortedRows,
+      sortedHashes,
+      radixBounds,
+      partitionInfo);
+}
+
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::radixPartitionShift(
+    const TableInsertPartitionInfo& partitionInfo) const {
+  if (joinBuildRadixPartitionBytes_ == 0 ||
+      hashMode_ == HashMode::kArray) {
+    return -1;
+  }
+  const uint64_t rangeBytes = partitionInfo.end - partitionInfo.start;
+  if (rangeBytes <= joinBuildRadixPartitionBytes_) {
+    return -1;
+  }
+  // Caps the number of radix partitions so that a chunk has enough rows for
+  // each.
+  const uint64_t minRadixBytes = bits::divRoundUp(
+      rangeBytes, kRadixChunkRows / kMinRowsPerRadixPartition);
+  const auto radixBytes = bits::nextPowerOfTwo(std::max<uint64_t>(
+      {joinBuildRadixPartitionBytes_, minRadixBytes, kBucketSize}));
+  return __builtin_ctzll(radixBytes);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::insertForJoinByRadix(
+    raw_vector<char*>& rows,
+    raw_vector<uint64_t>& hashes,
+    int32_t numRows,
+    int32_t radixShift,
+    raw_vector<char*>& sortedRows,
+    raw_vector<uint64_t>& sortedHashes,
+    std::vector<int32_t>& radixBounds,
+    TableInsertPartitionInfo& partitionInfo) {
+  if (numRows == 0) {
+    return;
+  }
+  const auto radixPartition = [&](uint64_t hash) INLINE_LAMBDA {
+    return (bucketOffset(hash) - partitionInfo.start) >> radixShift;
+  };
+  const int32_t numRadixPartitions =
+      ((partitionInfo.end - partitionInfo.start - 1) >> radixShift) + 1;
+  radixBounds.assign(numRadixPartitions + 1, 0);
+  for (auto i = 0; i < numRows; ++i) {
+    ++radixBounds[radixPartition(hashes[i]) + 1];
+  }
+  for (auto i = 1; i <= numRadixPartitions; ++i) {
+    radixBounds[i] += radixBounds[i - 1];
+  }
+  // Scatters the rows to their radix partitions. 'radixBounds[i]' ends up at
+  // the end of partition i.
+  for (auto i = 0; i < numRows; ++i) {
+    const auto index = radixBounds[radixPartition(hashes[i])]++;
+    sortedRows[index] = rows[i];
+    sortedHashes[index] = hashes[i];
+  }
+  int32_t start = 0;
+  for (auto i = 0; i < numRadixPartitions; ++i) {
+    const auto end = radixBounds[i];
+    if (end > start) {
+      insertForJoin(
+          sortedRows.data() + start,
+          sortedHashes.data() + start,
+          end - start,
+          &partitionInfo);
+    }
+    start = end;
+  }
+}
+
 template <>
 void HashTable<true>::buildBloomFilterPartition(
     column_index_t columnIndex,
@@ -1271,7 +1464,7 @@ void HashTable<true>::buildBloomFilterPartition(
   for (auto i = 0; i < 1 + otherTables_.size(); ++i) {
     auto* table = i == 0 ? this : otherTables_[i - 1].get();
     auto rowColumn = table->rows_->columnAt(columnIndex);
-    auto* filter = checkedPointerCast<common::BigintValuesUsingBloomFilter>(
+    auto* filter = checkedPointerCast<common::RuntimeBloomFilter>(
         hashers_[columnIndex]->getBloomFilter().get());
     RowContainerIterator iter;
     while (auto numRows = table->rows_->listPartitionRows(
@@ -1528,15 +1721,14 @@ void HashTable<ignoreNullKeys>::rehash(
   hashes.resize(kHashBatchSize);
   char* groups[kHashBatchSize];
   const bool shouldBuildBloomFilter = bloomFilterSupported();
-  std::vector<common::BigintValuesUsingBloomFilter*> bloomFilters;
+  std::vector<common::RuntimeBloomFilter*> bloomFilters;
   if (shouldBuildBloomFilter) {
     bloomFilters.resize(hashers_.size());
     for (int i = 0; i < hashers_.size(); ++i) {
       if (!hashers_[i]->supportsBloomFilter()) {
         continue;
       }
-      auto filter = std::make_shared<common::BigintValuesUsingBloomFilter>(
-          numDistinct_, false);
+      auto filter = makeBloomFilter(*hashers_[i], numDistinct_);
       bloomFilters[i] = filter.get();
       hashers_[i]->setBloomFilter(filter);
     }
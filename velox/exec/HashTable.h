@@ -113,6 +113,9 @@ struct HashTableStats {
 struct ParallelJoinBuildStats {
   std::vector<CpuWallTiming> partitionTimings;
   std::vector<CpuWallTiming> buildTimings;
+  /// Number of radix partitions each build partition was inserted in. 1 if
+  /// radix insertion was not used for the partition.
+  std::vector<int32_t> radixPartitions;
   std::vector<CpuWallTiming> bloomFilterPartitionTimings;
   std::vector<CpuWallTiming> bloomFilterBuildTimings;
 };
@@ -155,6 +158,8 @@ class BaseHashTable {
       "hashtable.parallelJoinBuildWallNanos"};
   static constexpr std::string_view kParallelJoinBuildCpuNanos{
       "hashtable.parallelJoinBuildCpuNanos"};
+  static constexpr std::string_view kParallelJoinRadixPartitions{
+      "hashtable.parallelJoinRadixPartitions"};
   static constexpr std::string_view kParallelJoinBloomFilterPartitionWallNanos{
       "hashtable.parallelJoinBloomFilterPartitionWallNanos"};
   static constexpr std::string_view kParallelJoinBloomFilterPartitionCpuNanos{
@@ -404,6 +409,14 @@ class BaseHashTable {
   /// VectorHashers of 'this'.
   virtual HashMode hashMode() const = 0;
 
+  /// Sets the number of distinct keys the table is expected to reach, e.g. as
+  /// observed by an earlier run of the same plan. A hash or normalized key
+  /// mode table is then allocated for this many keys when first made, so that
+  /// it does not rehash on the way.
+  void setExpectedNumDistinct(uint64_t numDistinct) {
+    expectedNumDistinct_ = numDistinct;
+  }
+
   /// Disables use of array or normalized key hash modes.
   void forceGenericHashMode(int8_t spillInputStartPartitionBit) {
     setHashMode(HashMode::kHash, 0, spillInputStartPartitionBit);
@@ -509,6 +522,7 @@ class BaseHashTable {
 
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   std::unique_ptr<RowContainer> rows_;
+  uint64_t expectedNumDistinct_{0};
 
   ParallelJoinBuildStats parallelJoinBuildStats_;
   CpuWallTiming vectorHasherMergeTiming_;
@@ -537,6 +551,8 @@ class HashTable : public BaseHashTable {
   // not occur. In this case the row does not need a link to the next
   // match. 'hasProbedFlag' adds an extra bit in every row for tracking rows
   // that matches join condition for right and full outer joins.
+  // 'joinBuildRadixPartitionBytes' is the size of the table ranges that a
+  // parallel join build inserts one at a time, 0 to disable radix insertion.
   HashTable(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
@@ -547,14 +563,18 @@ class HashTable : public BaseHashTable {
       bool hasCountFlag,
       uint32_t minTableSizeForParallelJoinBuild,
       memory::MemoryPool* pool,
-      uint64_t bloomFilterMaxSize = 0);
+      uint64_t bloomFilterMaxSize = 0,
+      uint64_t joinBuildRadixPartitionBytes = 0);
 
   ~HashTable() override = default;
 
+  /// 'hasCountFlag' reserves a per-group count that the caller can use to
+  /// track the number of input rows of each group.
   static std::unique_ptr<HashTable> createForAggregation(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool hasCountFlag = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         accumulators,
@@ -562,7 +582,7 @@ class HashTable : public BaseHashTable {
         false, // allowDuplicates
         false, // isJoinBuild
         false, // hasProbedFlag
-        false, // hasCountFlag
+        hasCountFlag,
         0, // minTableSizeForParallelJoinBuild
         pool);
   }
@@ -575,7 +595,8 @@ class HashTable : public BaseHashTable {
       bool hasCountFlag,
       uint32_t minTableSizeForParallelJoinBuild,
       memory::MemoryPool* pool,
-      uint64_t bloomFilterMaxSize = 0) {
+      uint64_t bloomFilterMaxSize = 0,
+      uint64_t joinBuildRadixPartitionBytes = 0) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         std::vector<Accumulator>{},
@@ -586,7 +607,8 @@ class HashTable : public BaseHashTable {
         hasCountFlag,
         minTableSizeForParallelJoinBuild,
         pool,
-        bloomFilterMaxSize);
+        bloomFilterMaxSize,
+        joinBuildRadixPartitionBytes);
   }
 
   void groupProbe(HashLookup& lookup, int8_t spillInputStartPartitionBit)
@@ -990,6 +1012,34 @@ class HashTable : public BaseHashTable {
       const std::vector<std::unique_ptr<RowPartitions>>& rowPartitions,
       std::vector<char*>& overflow);
 
+  // Like buildJoinPartition() but inserts the rows in chunks, each chunk one
+  // radix partition at a time. Radix partitions are table ranges of
+  // 2^'radixShift' bytes.
+  void buildJoinPartitionByRadix(
+      uint8_t partition,
+      const std::vector<std::unique_ptr<RowPartitions>>& rowPartitions,
+      int32_t radixShift,
+      TableInsertPartitionInfo& partitionInfo);
+
+  // Returns the log2 of the size of the radix partitions of the table range
+  // of 'partitionInfo', or -1 if the range is not radix partitioned.
+  int32_t radixPartitionShift(
+      const TableInsertPartitionInfo& partitionInfo) const;
+
+  // Radix sorts the first 'numRows' of 'rows' and 'hashes' by the radix
+  // partition of their bucket in the range of 'partitionInfo' and inserts one
+  // radix partition at a time, so that the inserts of each step hit a cache
+  // sized range of the table. 'sortedRows' and 'sortedHashes' are scratch.
+  void insertForJoinByRadix(
+      raw_vector<char*>& rows,
+      raw_vector<uint64_t>& hashes,
+      int32_t numRows,
+      int32_t radixShift,
+      raw_vector<char*>& sortedRows,
+      raw_vector<uint64_t>& sortedHashes,
+      std::vector<int32_t>& radixBounds,
+      TableInsertPartitionInfo& partitionInfo);
+
   // Assigns a partition to each row of 'subtable' in RowPartitions of
   // subtable's RowContainer. If 'hashMode_' is kNormalizedKeys, records the
   // normalized key of each row below the row in its container.
@@ -1164,6 +1214,10 @@ class HashTable : public BaseHashTable {
 
   const uint64_t bloomFilterMaxSize_;
 
+  // Size in bytes of the table ranges a parallel join build inserts one at a
+  // time. 0 if radix insertion is disabled.
+  const uint64_t joinBuildRadixPartitionBytes_;
+
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
   bool allowDuplicates_ = true;
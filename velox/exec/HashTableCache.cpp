@@ -16,17 +16,120 @@
 
 #include "velox/exec/HashTableCache.h"
 
+#include <algorithm>
+
 #include <fmt/format.h>
+#include <folly/json.h>
 
+#include "velox/common/time/Timer.h"
+#include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+// Lets the memory arbitrator reclaim the idle tables of the shared pool. Tables
+// in use by a query cannot be freed and are not reclaimable.
+class HashTableCacheReclaimer : public memory::MemoryReclaimer {
+ public:
+  static std::unique_ptr<memory::MemoryReclaimer> create() {
+    return std::unique_ptr<memory::MemoryReclaimer>(
+        new HashTableCacheReclaimer());
+  }
+
+  bool reclaimableBytes(const memory::MemoryPool& /*pool*/, uint64_t& bytes)
+      const override {
+    bytes = HashTableCache::instance()->idleBytes();
+    return true;
+  }
+
+  uint64_t reclaim(
+      memory::MemoryPool* pool,
+      uint64_t targetBytes,
+      uint64_t /*maxWaitMs*/,
+      memory::MemoryReclaimer::Stats& stats) override {
+    return run(
+        [&]() {
+          int64_t reclaimedBytes{0};
+          {
+            memory::ScopedReclaimedBytesRecorder recorder(
+                pool, &reclaimedBytes);
+            HashTableCache::instance()->evictIdle(targetBytes);
+          }
+          return reclaimedBytes;
+        },
+        stats);
+  }
+
+  void abort(memory::MemoryPool* /*pool*/, const std::exception_ptr& /*error*/)
+      override {
+    HashTableCache::instance()->evictIdle(0);
+  }
+
+ private:
+  HashTableCacheReclaimer() : MemoryReclaimer(0) {}
+};
+
+bool readsExchange(const core::PlanNode& node) {
+  if (dynamic_cast<const core::ExchangeNode*>(&node) != nullptr) {
+    return true;
+  }
+  for (const auto& source : node.sources()) {
+    if (readsExchange(*source)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Removes the plan node ids from a serialized plan so that equal plans of
+// different queries serialize the same.
+void removePlanNodeIds(folly::dynamic& node) {
+  node.erase("id");
+  if (auto* sources = node.get_ptr("sources")) {
+    for (auto& source : *sources) {
+      removePlanNodeIds(source);
+    }
+  }
+}
+
+uint64_t entryBytes(const HashTableCacheEntry& entry) {
+  return entry.tablePool->reservedBytes();
+}
+} // namespace
+
 HashTableCache* HashTableCache::instance() {
   static HashTableCache instance;
   return &instance;
 }
 
+// static
+std::string HashTableCache::sharedKey(
+    const core::HashJoinNode& joinNode,
+    const std::string& dataVersion) {
+  const auto& buildSource = joinNode.sources()[1];
+  if (readsExchange(*buildSource)) {
+    return "";
+  }
+  folly::dynamic obj;
+  try {
+    obj = joinNode.serialize();
+    // The probe side does not affect the table.
+    obj.erase("sources");
+    obj.erase("leftKeys");
+    removePlanNodeIds(obj);
+    auto build = buildSource->serialize();
+    removePlanNodeIds(build);
+    obj["build"] = std::move(build);
+  } catch (const std::exception&) {
+    // Some plan nodes do not support serialization.
+    return "";
+  }
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  return fmt::format("{}:{}", dataVersion, folly::json::serialize(obj, opts));
+}
+
 std::shared_ptr<HashTableCacheEntry> HashTableCache::get(
     const std::string& key,
     const std::string& taskId,
@@ -130,4 +233,238 @@ void HashTableCache::drop(const std::string& key) {
   }
 }
 
+
+std::shared_ptr<HashTableCacheEntry> HashTableCache::getShared(
+    const std::string& key,
+    const std::string& taskId,
+    const std::string& planNodeId,
+    core::QueryCtx* queryCtx,
+    ContinueFuture* future) {
+  VELOX_CHECK_NOT_NULL(future, "future parameter must not be null");
+  VELOX_CHECK_NOT_NULL(queryCtx, "queryCtx parameter must not be null");
+  VELOX_CHECK(!key.empty());
+
+  const auto& queryId = queryCtx->queryId();
+  const auto nowMs = getCurrentTimeMs();
+  std::vector<std::shared_ptr<HashTableCacheEntry>> evicted;
+  std::shared_ptr<HashTableCacheEntry> entry;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    evictLocked(nowMs, evicted);
+
+    auto it = tables_.find(key);
+    if (it == tables_.end()) {
+      ++numSharedMisses_;
+      entry = std::make_shared<HashTableCacheEntry>(
+          key,
+          taskId,
+          sharedPoolLocked()->addLeafChild(
+              fmt::format("cached_table_{}", numSharedPools_++)),
+          queryId,
+          planNodeId,
+          true);
+      entry->lastUseMs = nowMs;
+      tables_.insert({key, entry});
+      addSharedUserLocked(*entry, queryCtx);
+    } else if (it->second->buildComplete) {
+      ++numSharedHits_;
+      entry = it->second;
+      VELOX_CHECK(entry->shared);
+      entry->lastUseMs = nowMs;
+      addSharedUserLocked(*entry, queryCtx);
+    } else if (
+        it->second->builderQueryId != queryId ||
+        (it->second->builderTaskId == taskId &&
+         it->second->builderPlanNodeId != planNodeId)) {
+      // Another query or another join of the same task is building the table.
+      ++numSharedMisses_;
+    } else {
+      entry = it->second;
+      VELOX_CHECK(entry->shared);
+      if (entry->builderTaskId != taskId) {
+        auto [promise, _future] = makeVeloxContinuePromiseContract(
+            fmt::format("HashTableCache::{}", entry->tablePool->name()));
+        entry->buildPromises.push_back(std::move(promise));
+        *future = std::move(_future);
+      }
+    }
+  }
+  freeEntries(evicted);
+  return entry;
+}
+
+void HashTableCache::setSharedOptions(const SharedOptions& options) {
+  std::vector<std::shared_ptr<HashTableCacheEntry>> evicted;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    sharedOptions_ = options;
+    evictLocked(getCurrentTimeMs(), evicted);
+  }
+  freeEntries(evicted);
+}
+
+HashTableCache::SharedStats HashTableCache::sharedStats() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  SharedStats stats;
+  stats.numHits = numSharedHits_;
+  stats.numMisses = numSharedMisses_;
+  stats.numEvictions = numSharedEvictions_;
+  for (const auto& [_, entry] : tables_) {
+    if (entry->shared) {
+      ++stats.numEntries;
+      stats.bytes += entryBytes(*entry);
+    }
+  }
+  return stats;
+}
+
+uint64_t HashTableCache::evictIdle(uint64_t targetBytes) {
+  std::vector<std::shared_ptr<HashTableCacheEntry>> evicted;
+  uint64_t freedBytes;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    freedBytes = evictIdleLocked(targetBytes, evicted);
+  }
+  freeEntries(evicted);
+  return freedBytes;
+}
+
+uint64_t HashTableCache::idleBytes() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  uint64_t bytes{0};
+  for (const auto& entry : idleEntriesLocked()) {
+    bytes += entryBytes(*entry);
+  }
+  return bytes;
+}
+
+void HashTableCache::testingClearShared() {
+  std::vector<std::shared_ptr<HashTableCacheEntry>> evicted;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto it = tables_.begin(); it != tables_.end();) {
+      if (it->second->shared) {
+        evicted.push_back(std::move(it->second));
+        it = tables_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    numSharedHits_ = 0;
+    numSharedMisses_ = 0;
+    numSharedEvictions_ = 0;
+  }
+  freeEntries(evicted);
+  std::lock_guard<std::mutex> guard(lock_);
+  sharedPool_.reset();
+}
+
+memory::MemoryPool* HashTableCache::sharedPoolLocked() {
+  if (sharedPool_ == nullptr) {
+    sharedPool_ = memory::memoryManager()->addRootPool(
+        "hash_table_cache",
+        memory::kMaxMemory,
+        HashTableCacheReclaimer::create());
+  }
+  return sharedPool_.get();
+}
+
+void HashTableCache::addSharedUserLocked(
+    HashTableCacheEntry& entry,
+    core::QueryCtx* queryCtx) {
+  if (!entry.userQueryIds.insert(queryCtx->queryId()).second) {
+    return;
+  }
+  queryCtx->addReleaseCallback(
+      [cacheKey = entry.cacheKey, queryId = queryCtx->queryId()]() {
+        HashTableCache::instance()->releaseShared(cacheKey, queryId);
+      });
+}
+
+void HashTableCache::releaseShared(
+    const std::string& key,
+    const std::string& queryId) {
+  std::vector<std::shared_ptr<HashTableCacheEntry>> evicted;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = tables_.find(key);
+    if (it != tables_.end() && it->second->shared) {
+      auto& entry = it->second;
+      entry->userQueryIds.erase(queryId);
+      if (!entry->buildComplete && entry->builderQueryId == queryId) {
+        // The builder query is gone without building the table.
+        evicted.push_back(std::move(entry));
+        tables_.erase(it);
+      } else {
+        const auto nowMs = getCurrentTimeMs();
+        entry->lastUseMs = nowMs;
+        evictLocked(nowMs, evicted);
+      }
+    }
+  }
+  freeEntries(evicted);
+}
+
+void HashTableCache::evictLocked(
+    uint64_t nowMs,
+    std::vector<std::shared_ptr<HashTableCacheEntry>>& evicted) {
+  uint64_t totalBytes{0};
+  for (const auto& [_, entry] : tables_) {
+    if (entry->shared) {
+      totalBytes += entryBytes(*entry);
+    }
+  }
+  for (auto& entry : idleEntriesLocked()) {
+    const bool expired = nowMs >= entry->lastUseMs + sharedOptions_.ttlMs;
+    if (!expired && totalBytes <= sharedOptions_.maxBytes) {
+      // Entries are in LRU order, so the rest are not expired either.
+      break;
+    }
+    totalBytes -= entryBytes(*entry);
+    tables_.erase(entry->cacheKey);
+    evicted.push_back(std::move(entry));
+    ++numSharedEvictions_;
+  }
+}
+
+uint64_t HashTableCache::evictIdleLocked(
+    uint64_t targetBytes,
+    std::vector<std::shared_ptr<HashTableCacheEntry>>& evicted) {
+  uint64_t freedBytes{0};
+  for (auto& entry : idleEntriesLocked()) {
+    if (targetBytes != 0 && freedBytes >= targetBytes) {
+      break;
+    }
+    freedBytes += entryBytes(*entry);
+    tables_.erase(entry->cacheKey);
+    evicted.push_back(std::move(entry));
+    ++numSharedEvictions_;
+  }
+  return freedBytes;
+}
+
+std::vector<std::shared_ptr<HashTableCacheEntry>>
+HashTableCache::idleEntriesLocked() const {
+  std::vector<std::shared_ptr<HashTableCacheEntry>> idle;
+  for (const auto& [_, entry] : tables_) {
+    if (entry->shared && entry->buildComplete && entry->userQueryIds.empty()) {
+      idle.push_back(entry);
+    }
+  }
+  std::sort(idle.begin(), idle.end(), [](const auto& left, const auto& right) {
+    return left->lastUseMs < right->lastUseMs;
+  });
+  return idle;
+}
+
+// static
+void HashTableCache::freeEntries(
+    std::vector<std::shared_ptr<HashTableCacheEntry>>& entries) {
+  // Frees the tables before the pools they allocate from, as in drop().
+  for (auto& entry : entries) {
+    entry->table.reset();
+  }
+  entries.clear();
+}
+
 } // namespace facebook::velox::exec
@@ -19,12 +19,14 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "velox/exec/HashTable.h"
 
 namespace facebook::velox::core {
+class HashJoinNode;
 class QueryCtx;
-}
+} // namespace facebook::velox::core
 
 namespace facebook::velox::exec {
 
@@ -33,26 +35,82 @@ struct HashTableCacheEntry {
   HashTableCacheEntry(
       std::string _cacheKey,
       std::string _builderTaskId,
-      std::shared_ptr<memory::MemoryPool> _tablePool)
+      std::shared_ptr<memory::MemoryPool> _tablePool,
+      std::string _builderQueryId = "",
+      std::string _builderPlanNodeId = "",
+      bool _shared = false)
       : cacheKey(std::move(_cacheKey)),
         builderTaskId(std::move(_builderTaskId)),
-        tablePool(std::move(_tablePool)) {}
+        tablePool(std::move(_tablePool)),
+        builderQueryId(std::move(_builderQueryId)),
+        builderPlanNodeId(std::move(_builderPlanNodeId)),
+        shared(_shared) {}
 
   const std::string cacheKey;
   const std::string builderTaskId;
   const std::shared_ptr<memory::MemoryPool> tablePool;
+  /// The query and join node that build the table. Only set for shared
+  /// entries.
+  const std::string builderQueryId;
+  const std::string builderPlanNodeId;
+  /// True if the entry is shared across queries, see
+  /// HashTableCache::getShared().
+  const bool shared;
   std::shared_ptr<BaseHashTable> table;
   bool hasNullKeys{false};
   tsan_atomic<bool> buildComplete{false};
   std::vector<ContinuePromise> buildPromises;
+  /// Shared entries only: the ids of the live queries that use the table and
+  /// the time of the last use in ms. An entry without users is idle and can be
+  /// evicted. Guarded by the lock of HashTableCache.
+  std::unordered_set<std::string> userQueryIds;
+  uint64_t lastUseMs{0};
 };
 
 /// Global cache for hash tables shared across tasks within the same query.
 /// First task builds the table, subsequent tasks wait and reuse it.
+///
+/// Tables may also be shared across queries, see getShared(). Shared tables
+/// are allocated from a process-wide 'hash_table_cache' memory pool and stay
+/// cached after the queries that use them have finished. Idle shared tables
+/// are evicted after a TTL, in LRU order when their total size exceeds a
+/// limit, and by the memory arbitrator under memory pressure.
 class HashTableCache {
  public:
+  struct SharedOptions {
+    /// Idle shared tables are evicted in LRU order while the total memory of
+    /// the shared tables exceeds this.
+    uint64_t maxBytes{256UL << 20};
+    /// Idle shared tables that have not been used for this long are evicted.
+    uint64_t ttlMs{10 * 60 * 1'000};
+  };
+
+  struct SharedStats {
+    /// Number of getShared() calls that found a built table.
+    uint64_t numHits{0};
+    /// Number of getShared() calls that did not find a built table. The
+    /// caller builds the table, either into the cache or privately.
+    uint64_t numMisses{0};
+    /// Number of idle shared tables evicted.
+    uint64_t numEvictions{0};
+    /// Number of shared tables in the cache.
+    uint64_t numEntries{0};
+    /// Memory reserved by the shared tables.
+    uint64_t bytes{0};
+  };
+
   static HashTableCache* instance();
 
+  /// Returns the key under which the build side of 'joinNode' is shared across
+  /// queries. The key is a canonical form of the join and its build side plan
+  /// without plan node ids, prefixed with 'dataVersion'. 'dataVersion' is an
+  /// opaque token supplied by the application that identifies the version of
+  /// the files and splits the build side reads. Returns an empty string if the
+  /// build side cannot be shared, e.g. because it reads from an exchange.
+  static std::string sharedKey(
+      const core::HashJoinNode& joinNode,
+      const std::string& dataVersion);
+
   /// Gets or creates a cache entry. First caller becomes the builder.
   /// Subsequent callers from different tasks get a future to wait on.
   /// When a new entry is created, a release callback is registered on queryCtx
@@ -73,11 +131,79 @@ class HashTableCache {
   /// Removes a cache entry.
   void drop(const std::string& key);
 
+  /// Like get() for a table shared across queries under 'key' from
+  /// sharedKey(). The first caller's query and join node become the builder
+  /// and the tasks of the builder query coordinate as in get(). A caller from
+  /// another query that finds the table still being built gets nullptr and
+  /// should build a private table rather than wait on a query it does not
+  /// control. A caller that finds a built table gets it and its query is
+  /// registered as a user of the entry until the query is released.
+  std::shared_ptr<HashTableCacheEntry> getShared(
+      const std::string& key,
+      const std::string& taskId,
+      const std::string& planNodeId,
+      core::QueryCtx* queryCtx,
+      ContinueFuture* future);
+
+  void setSharedOptions(const SharedOptions& options);
+
+  SharedStats sharedStats() const;
+
+  /// Evicts idle shared tables, least recently used first, until at least
+  /// 'targetBytes' are freed or no idle table is left. Evicts all idle tables
+  /// if 'targetBytes' is 0. Returns the freed bytes.
+  uint64_t evictIdle(uint64_t targetBytes);
+
+  /// Returns the memory of the idle shared tables.
+  uint64_t idleBytes() const;
+
+  /// Drops all shared tables and the shared memory pool.
+  void testingClearShared();
+
  private:
   HashTableCache() = default;
 
-  std::mutex lock_;
+  // Returns the pool that the shared tables allocate from, creating it on
+  // first use.
+  memory::MemoryPool* sharedPoolLocked();
+
+  // Registers the query of 'queryCtx' as a user of the shared 'entry'.
+  void addSharedUserLocked(
+      HashTableCacheEntry& entry,
+      core::QueryCtx* queryCtx);
+
+  // Unregisters 'queryId' from the shared entry of 'key'. Drops the entry if
+  // 'queryId' is the builder and the table is not built.
+  void releaseShared(const std::string& key, const std::string& queryId);
+
+  // Moves the idle shared entries that are past the TTL or over the size limit
+  // to 'evicted'.
+  void evictLocked(
+      uint64_t nowMs,
+      std::vector<std::shared_ptr<HashTableCacheEntry>>& evicted);
+
+  // Moves idle shared entries to 'evicted', oldest first, until their memory
+  // is at least 'targetBytes', or all of them if 'targetBytes' is 0. Returns
+  // the memory of the moved entries.
+  uint64_t evictIdleLocked(
+      uint64_t targetBytes,
+      std::vector<std::shared_ptr<HashTableCacheEntry>>& evicted);
+
+  // Returns the idle shared entries, least recently used first.
+  std::vector<std::shared_ptr<HashTableCacheEntry>> idleEntriesLocked() const;
+
+  // Frees the tables of 'entries'. Called without holding 'lock_'.
+  static void freeEntries(
+      std::vector<std::shared_ptr<HashTableCacheEntry>>& entries);
+
+  mutable std::mutex lock_;
   std::unordered_map<std::string, std::shared_ptr<HashTableCacheEntry>> tables_;
+  SharedOptions sharedOptions_;
+  std::shared_ptr<memory::MemoryPool> sharedPool_;
+  uint64_t numSharedPools_{0};
+  uint64_t numSharedHits_{0};
+  uint64_t numSharedMisses_{0};
+  uint64_t numSharedEvictions_{0};
 };
 
 } // namespace facebook::velox::exec
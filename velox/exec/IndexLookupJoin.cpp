@@ -15,6 +15,8 @@
  */
 #include "velox/exec/IndexLookupJoin.h"
 
+#include <folly/container/F14Map.h>
+
 #include "velox/buffer/Buffer.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/Connector.h"
@@ -347,7 +349,15 @@ IndexLookupJoin::IndexLookupJoin(
       connector_(connector::getConnector(lookupTableHandle_->connectorId())),
       maxNumInputBatches_(
           1 + driverCtx->queryConfig().indexLookupJoinMaxPrefetchBatches()),
-      joinNode_{joinNode} {
+      adaptivePrefetch_(
+          driverCtx->queryConfig().indexLookupJoinAdaptivePrefetch()),
+      dedupLookupKeys_(
+          !splitOutput_ &&
+          driverCtx->queryConfig().indexLookupJoinDedupKeys()),
+      joinNode_{joinNode},
+      maxInFlightBatches_(
+          adaptivePrefetch_ ? std::min<size_t>(2, maxNumInputBatches_)
+                            : maxNumInputBatches_) {
   duplicateJoinKeyCheck(joinNode_->leftKeys());
   duplicateJoinKeyCheck(joinNode_->rightKeys());
 
@@ -649,7 +659,7 @@ bool IndexLookupJoin::needsInput() const {
   if (needsIndexSplits()) {
     return false;
   }
-  if (numInputBatches() >= maxNumInputBatches_) {
+  if (numInputBatches() >= maxInFlightBatches_) {
     return false;
   }
   if (numInputBatches() == 0) {
@@ -671,15 +681,33 @@ BlockingReason IndexLookupJoin::isBlocked(ContinueFuture* future) {
     }
   }
 
+  advancePrefetchedLookups();
   auto& batch = currentInputBatch();
   if (!batch.lookupFuture.valid()) {
     endLookupBlockWait();
+    if (adaptivePrefetch_ && maxInFlightBatches_ > 2 &&
+        numInputBatches() == maxInFlightBatches_) {
+      // All the lookups in flight have completed, so fewer batches in flight
+      // would do.
+      bool allCompleted = true;
+      for (auto i = startBatchIndex_ + 1; i < endBatchIndex_; ++i) {
+        allCompleted &=
+            !inputBatches_[i % maxNumInputBatches_].lookupFuture.valid();
+      }
+      maxInFlightBatches_ -= allCompleted;
+    }
     return BlockingReason::kNotBlocked;
   }
-  if (lookupPrefetchEnabled() && (numInputBatches() < maxNumInputBatches_) &&
+  if (lookupPrefetchEnabled() && (numInputBatches() < maxInFlightBatches_) &&
       !noMoreInput_) {
     return BlockingReason::kNotBlocked;
   }
+  if (adaptivePrefetch_ && !noMoreInput_ &&
+      maxInFlightBatches_ < maxNumInputBatches_) {
+    // The lookups take longer than producing the output of the batches in
+    // flight, so more batches in flight would hide more of the latency.
+    ++maxInFlightBatches_;
+  }
   *future = std::move(batch.lookupFuture);
   VELOX_CHECK(!batch.lookupFuture.valid());
   startLookupBlockWait();
@@ -713,6 +741,7 @@ void IndexLookupJoin::addInput(RowVectorPtr input) {
   ensureInputLoaded(batch);
   decodeAndDetectNonNullKeys(batch);
   prepareLookup(batch);
+  dedupLookupInput(batch);
   startLookup(batch);
 }
 
@@ -723,6 +752,7 @@ RowVectorPtr IndexLookupJoin::getOutput() {
     }
   };
 
+  advancePrefetchedLookups();
   auto& batch = currentInputBatch();
   if (batch.empty()) {
     return nullptr;
@@ -788,6 +818,122 @@ void IndexLookupJoin::prepareLookup(InputBatchState& batch) {
   }
 }
 
+namespace {
+// Hashes and compares the rows of a lookup input by value for deduplication.
+struct LookupRowHasher {
+  const uint64_t* hashes;
+
+  size_t operator()(vector_size_t row) const {
+    return hashes[row];
+  }
+};
+
+struct LookupRowComparer {
+  const RowVector* input;
+
+  bool operator()(vector_size_t left, vector_size_t right) const {
+    return input->equalValueAt(input, left, right);
+  }
+};
+} // namespace
+
+void IndexLookupJoin::dedupLookupInput(InputBatchState& batch) {
+  batch.dedupRowMappings.clear();
+  const auto numRows = batch.lookupInput->size();
+  if (!dedupLookupKeys_ || numRows < 2) {
+    return;
+  }
+
+  dedupHashes_.resize(numRows);
+  for (auto row = 0; row < numRows; ++row) {
+    dedupHashes_[row] = batch.lookupInput->hashValueAt(row);
+  }
+  folly::F14FastMap<
+      vector_size_t,
+      vector_size_t,
+      LookupRowHasher,
+      LookupRowComparer>
+      distinctRows(
+          numRows,
+          LookupRowHasher{dedupHashes_.data()},
+          LookupRowComparer{batch.lookupInput.get()});
+  auto distinctIndices = allocateIndices(numRows, pool());
+  auto* rawDistinctIndices = distinctIndices->asMutable<vector_size_t>();
+  batch.dedupRowMappings.resize(numRows);
+  vector_size_t numDistinct = 0;
+  for (auto row = 0; row < numRows; ++row) {
+    const auto [it, inserted] = distinctRows.emplace(row, numDistinct);
+    if (inserted) {
+      rawDistinctIndices[numDistinct++] = row;
+    }
+    batch.dedupRowMappings[row] = it->second;
+  }
+  if (numDistinct == numRows) {
+    batch.dedupRowMappings.clear();
+    return;
+  }
+
+  distinctIndices->setSize(numDistinct * sizeof(vector_size_t));
+  std::vector<VectorPtr> children;
+  children.reserve(lookupInputType_->size());
+  for (const auto& child : batch.lookupInput->children()) {
+    children.push_back(BaseVector::wrapInDictionary(
+        nullptr, distinctIndices, numDistinct, child));
+  }
+  batch.lookupInput = std::make_shared<RowVector>(
+      pool(), lookupInputType_, nullptr, numDistinct, std::move(children));
+}
+
+void IndexLookupJoin::expandDedupLookupResult(InputBatchState& batch) {
+  if (batch.dedupRowMappings.empty() || batch.lookupResult == nullptr) {
+    return;
+  }
+  const auto& result = *batch.lookupResult;
+  const auto* rawInputHits = result.inputHits->as<vector_size_t>();
+  // The result rows of distinct row 'i' are [offsets[i], offsets[i + 1]) as
+  // the input hits are in the order of the distinct rows.
+  std::vector<vector_size_t> offsets(batch.lookupInput->size() + 1, 0);
+  for (auto i = 0; i < result.size(); ++i) {
+    ++offsets[rawInputHits[i] + 1];
+  }
+  for (auto i = 1; i < offsets.size(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  vector_size_t numResultRows = 0;
+  for (auto distinctRow : batch.dedupRowMappings) {
+    numResultRows += offsets[distinctRow + 1] - offsets[distinctRow];
+  }
+
+  auto inputHits = allocateIndices(numResultRows, pool());
+  auto* rawExpandedHits = inputHits->asMutable<vector_size_t>();
+  auto indices = allocateIndices(numResultRows, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t resultRow = 0;
+  for (auto row = 0; row < batch.dedupRowMappings.size(); ++row) {
+    const auto distinctRow = batch.dedupRowMappings[row];
+    for (auto i = offsets[distinctRow]; i < offsets[distinctRow + 1]; ++i) {
+      rawExpandedHits[resultRow] = row;
+      rawIndices[resultRow++] = i;
+    }
+  }
+  VELOX_CHECK_EQ(resultRow, numResultRows);
+
+  std::vector<VectorPtr> children;
+  children.reserve(result.output->childrenSize());
+  for (const auto& child : result.output->children()) {
+    children.push_back(
+        BaseVector::wrapInDictionary(nullptr, indices, numResultRows, child));
+  }
+  auto output = std::make_shared<RowVector>(
+      pool(),
+      result.output->type(),
+      nullptr,
+      numResultRows,
+      std::move(children));
+  batch.lookupResult = std::make_unique<connector::IndexSource::Result>(
+      std::move(inputHits), std::move(output));
+}
+
 void IndexLookupJoin::mergeLookupResults(InputBatchState& batch) {
   VELOX_CHECK(!batch.partialOutputs.empty());
   VELOX_CHECK_NULL(batch.lookupResult);
@@ -858,6 +1004,7 @@ bool IndexLookupJoin::getLookupResults(InputBatchState& batch) {
     // Either splitOutput_ is true, or no more results, or first result is null.
     if (splitOutput_ || !batch.lookupResultIter->hasNext()) {
       batch.lookupResult = std::move(lookupResultOr).value();
+      expandDedupLookupResult(batch);
       return true;
     }
 
@@ -889,9 +1036,25 @@ bool IndexLookupJoin::getLookupResults(InputBatchState& batch) {
 
   // All results accumulated, merge them.
   mergeLookupResults(batch);
+  expandDedupLookupResult(batch);
   return true;
 }
 
+void IndexLookupJoin::advancePrefetchedLookups() {
+  if (!lookupPrefetchEnabled()) {
+    return;
+  }
+  for (auto i = startBatchIndex_ + 1; i < endBatchIndex_; ++i) {
+    auto& batch = inputBatches_[i % maxNumInputBatches_];
+    if (!batch.lookupFuture.valid() || !batch.lookupFuture.isReady()) {
+      continue;
+    }
+    VELOX_CHECK_NOT_NULL(batch.lookupResultIter);
+    batch.lookupFuture = ContinueFuture::makeEmpty();
+    getLookupResults(batch);
+  }
+}
+
 void IndexLookupJoin::decodeAndDetectNonNullKeys(InputBatchState& batch) {
   const auto numRows = batch.input->size();
   batch.nonNullInputRows.resize(numRows);
@@ -915,8 +1078,10 @@ void IndexLookupJoin::startLookup(InputBatchState& batch) {
   VELOX_CHECK_NOT_NULL(batch.lookupInput);
   if (batch.lookupInputHasNullKeys) {
     VELOX_CHECK_LT(batch.lookupInput->size(), batch.input->size());
-  } else {
+  } else if (batch.dedupRowMappings.empty()) {
     VELOX_CHECK_EQ(batch.lookupInput->size(), batch.input->size());
+  } else {
+    VELOX_CHECK_LT(batch.lookupInput->size(), batch.input->size());
   }
   VELOX_CHECK_NULL(batch.lookupResultIter);
   VELOX_CHECK_NULL(batch.lookupResult);
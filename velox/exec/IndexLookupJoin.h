@@ -102,6 +102,11 @@ class IndexLookupJoin : public Operator {
 
     // The reusable vector projected from 'input' as index lookup input.
     RowVectorPtr lookupInput;
+    // If not empty, 'lookupInput' has the distinct rows of the projected
+    // lookup input and this maps each projected row to its row in
+    // 'lookupInput'. Set if 'dedupLookupKeys_' is true and the batch has
+    // repeated keys.
+    std::vector<vector_size_t> dedupRowMappings;
     // Used to fetch lookup results for an input batch.
     std::shared_ptr<ResultIterator> lookupResultIter;
     // Used for synchronization with the async fetch result from index source
@@ -168,18 +173,32 @@ class IndexLookupJoin : public Operator {
   void ensureInputLoaded(const InputBatchState& batch);
   // Prepare index source lookup for a given 'input_'.
   void prepareLookup(InputBatchState& batch);
+  // Replaces 'lookupInput' of 'batch' with its distinct rows and sets
+  // 'dedupRowMappings' if 'lookupInput' has repeated rows.
+  void dedupLookupInput(InputBatchState& batch);
   void startLookup(InputBatchState& batch);
 
   // Helper function to merge batch.partialOutputs into a single
   // batch.lookupResult. This is used when splitOutput_ is false to ensure all
   // results from an iterator are combined into one output batch.
   void mergeLookupResults(InputBatchState& batch);
+  // Copies the results of each distinct lookup row to all the lookup rows
+  // that 'dedupRowMappings' maps to it, so that the result looks as if the
+  // rows had not been deduplicated.
+  void expandDedupLookupResult(InputBatchState& batch);
   // Helper function to get all lookup results. Fetches the first result if not
   // already fetched, and when splitOutput_ is false, accumulates all remaining
   // results into a single batch. Handles both initial lookup and resuming
   // accumulation after async interruption. Returns true if results are ready,
   // false if an async operation is pending.
   bool getLookupResults(InputBatchState& batch);
+  // Continues the lookups of the prefetched input batches after the current
+  // one whose async fetches have completed. A lookup that returns its results
+  // in more than one fetch then issues its next fetch while the current batch
+  // produces output, instead of only after it becomes the current batch. This
+  // keeps up to 'maxNumInputBatches_' remote lookups in flight on the driver
+  // thread.
+  void advancePrefetchedLookups();
 
   void startLookupBlockWait();
   void endLookupBlockWait();
@@ -297,6 +316,8 @@ class IndexLookupJoin : public Operator {
   const std::shared_ptr<connector::ConnectorQueryCtx> connectorQueryCtx_;
   const std::shared_ptr<connector::Connector> connector_;
   const size_t maxNumInputBatches_;
+  const bool adaptivePrefetch_;
+  const bool dedupLookupKeys_;
 
   // The lookup join plan node used to initialize this operator and reset after
   // that.
@@ -321,6 +342,12 @@ class IndexLookupJoin : public Operator {
   // maxNumInputBatches_ - 1)'.
   uint64_t startBatchIndex_{0};
   uint64_t endBatchIndex_{0};
+  // The max number of input batches to have in flight. Adapts to the lookup
+  // latency between 2 and 'maxNumInputBatches_' if 'adaptivePrefetch_' is
+  // true, otherwise it is 'maxNumInputBatches_'.
+  size_t maxInFlightBatches_;
+  // The hashes of the lookup input rows used by dedupLookupInput().
+  std::vector<uint64_t> dedupHashes_;
 
   // The data type of the lookup output from the lookup source.
   RowTypePtr lookupOutputType_;
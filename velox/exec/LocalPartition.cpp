@@ -32,30 +32,35 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  hasWaiters_ = true;
+  // A consumer may have gone below the limit before seeing 'hasWaiters_'.
+  if (bufferedBytes_ < maxBufferSize_) {
+    hasWaiters_ = !promises_.empty();
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
-  std::vector<ContinuePromise> promises;
-  {
-    std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasWaiters_) {
+    return {};
+  }
 
-    if (bufferedBytes_ < maxBufferSize_) {
-      promises = std::move(promises_);
-    }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (bufferedBytes_ >= maxBufferSize_) {
+    return {};
   }
-  return promises;
+  hasWaiters_ = false;
+  return std::move(promises_);
 }
 
 void LocalExchangeVectorPool::push(const RowVectorPtr& vector, int64_t size) {
@@ -130,6 +135,8 @@ BlockingReason LocalExchangeQueue::enqueue(
     queue.emplace(std::move(input), inputBytes);
     consumerPromises = std::move(consumerPromises_);
 
+    // Only an atomic add unless over the limit. Done under the lock so that
+    // close() cannot free 'input' before it is accounted for.
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
       blockedOnConsumer = true;
     }
@@ -170,7 +177,6 @@ BlockingReason LocalExchangeQueue::next(
     bool& drained) {
   drained = false;
   int64_t size{0};
-  std::vector<ContinuePromise> memoryPromises;
   const auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -190,13 +196,13 @@ BlockingReason LocalExchangeQueue::next(
 
     std::tie(*data, size) = std::move(queue.front());
     queue.pop();
-
-    memoryPromises = memoryManager_->decreaseMemoryUsage(size);
     return BlockingReason::kNotBlocked;
   });
 
-  notify(memoryPromises);
   if (*data != nullptr) {
+    consumedBytes_ += size;
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(size);
+    notify(memoryPromises);
     vectorPool_->push(*data, size);
   }
   return blockingReason;
@@ -225,7 +231,7 @@ bool LocalExchangeQueue::testAndClearDrainedLocked() {
 }
 
 bool LocalExchangeQueue::isFinished() {
-  return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
+  return queue_.withRLock([&](auto& queue) { return isFinishedLocked(queue); });
 }
 
 bool LocalExchangeQueue::testingProducersDone() const {
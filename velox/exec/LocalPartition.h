@@ -21,7 +21,10 @@
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. All queues of a local exchange and all their producers
+/// and consumers share the manager, so the usage is updated without a lock.
+/// The mutex is only taken when a producer goes over the limit or when a
+/// consumer goes under the limit while producers wait.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -33,7 +36,7 @@ class LocalExchangeMemoryManager {
 
   /// Decreases the memory usage by 'removed' bytes. If the memory usage goes
   /// below the limit after the decrease, the function returns 'promises_' to
-  /// caller to fulfill.
+  /// caller to fulfill. All waiting producers are woken at once.
   std::vector<ContinuePromise> decreaseMemoryUsage(int64_t removed);
 
   /// Returns the maximum buffer size in bytes.
@@ -48,8 +51,12 @@ class LocalExchangeMemoryManager {
 
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True while 'promises_' may be non-empty. Set by a producer before it
+  // checks 'bufferedBytes_' under 'mutex_' and read by a consumer after it
+  // decreases 'bufferedBytes_', so that one of the two sees the other.
+  std::atomic_bool hasWaiters_{false};
   std::mutex mutex_;
-  tsan_atomic<int64_t> bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -135,6 +142,12 @@ class LocalExchangeQueue {
     return vectorPool_->pop();
   }
 
+  /// Returns the total bytes of data fetched by the consumer so far. The scale
+  /// writer exchange uses it to measure the writer throughput.
+  uint64_t consumedBytes() const {
+    return consumedBytes_;
+  }
+
   /// Returns true if all producers have sent no more data signal.
   bool testingProducersDone() const;
 
@@ -162,6 +175,7 @@ class LocalExchangeQueue {
   // 'drainedProducers_' is reset to zero.
   int drainedProducers_{0};
   bool closed_{false};
+  std::atomic_uint64_t consumedBytes_{0};
 };
 
 /// Fetches data for a single partition produced by local exchange from
@@ -47,6 +47,8 @@
 #include "velox/exec/SpatialJoinProbe.h"
 #include "velox/exec/StreamingAggregation.h"
 #include "velox/exec/StreamingEnforceDistinct.h"
+#include "velox/exec/StreamingMarkDistinct.h"
+#include "velox/exec/StreamingRowNumber.h"
 #include "velox/exec/TableScan.h"
 #include "velox/exec/TableWriteMerge.h"
 #include "velox/exec/TableWriter.h"
@@ -595,6 +597,20 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto groupIdNode =
             std::dynamic_pointer_cast<const core::GroupIdNode>(planNode)) {
+      if (i < planNodes.size() - 1) {
+        auto aggregationNode =
+            std::dynamic_pointer_cast<const core::AggregationNode>(
+                planNodes[i + 1]);
+        if (aggregationNode != nullptr &&
+            HashAggregation::canRollupGroupingSets(
+                *aggregationNode, *groupIdNode, ctx->queryConfig())) {
+          operators.push_back(
+              std::make_unique<HashAggregation>(
+                  id, ctx.get(), aggregationNode, groupIdNode));
+          i++;
+          continue;
+        }
+      }
       operators.push_back(
           std::make_unique<GroupId>(id, ctx.get(), groupIdNode));
     } else if (
@@ -617,8 +633,14 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto rowNumberNode =
             std::dynamic_pointer_cast<const core::RowNumberNode>(planNode)) {
-      operators.push_back(
-          std::make_unique<RowNumber>(id, ctx.get(), rowNumberNode));
+      if (rowNumberNode->isPreGrouped()) {
+        operators.push_back(
+            std::make_unique<StreamingRowNumber>(
+                id, ctx.get(), rowNumberNode));
+      } else {
+        operators.push_back(
+            std::make_unique<RowNumber>(id, ctx.get(), rowNumberNode));
+      }
     } else if (
         auto topNRowNumberNode =
             std::dynamic_pointer_cast<const core::TopNRowNumberNode>(
@@ -628,8 +650,14 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto markDistinctNode =
             std::dynamic_pointer_cast<const core::MarkDistinctNode>(planNode)) {
-      operators.push_back(
-          std::make_unique<MarkDistinct>(id, ctx.get(), markDistinctNode));
+      if (markDistinctNode->isPreGrouped()) {
+        operators.push_back(
+            std::make_unique<StreamingMarkDistinct>(
+                id, ctx.get(), markDistinctNode));
+      } else {
+        operators.push_back(
+            std::make_unique<MarkDistinct>(id, ctx.get(), markDistinctNode));
+      }
     } else if (
         auto enforceDistinctNode =
             std::dynamic_pointer_cast<const core::EnforceDistinctNode>(
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/MemoryTimeline.h"
+
+#include <folly/dynamic.h>
+#include <folly/json.h>
+#include <unordered_map>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Operator.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+std::string_view MemoryTimeline::eventTypeName(EventType type) {
+  switch (type) {
+    case EventType::kArbitration:
+      return "arbitration";
+    case EventType::kReclaim:
+      return "reclaim";
+    case EventType::kSpill:
+      return "spill";
+    case EventType::kRestore:
+      return "restore";
+  }
+  VELOX_UNREACHABLE();
+}
+
+void MemoryTimeline::add(Event event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() >= maxEvents_) {
+    ++numDropped_;
+    return;
+  }
+  events_.push_back(std::move(event));
+}
+
+std::vector<MemoryTimeline::Event> MemoryTimeline::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return events_;
+}
+
+uint64_t MemoryTimeline::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numDropped_;
+}
+
+std::string MemoryTimeline::toChromeTrace() const {
+  std::vector<Event> events;
+  uint64_t numDropped;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    events = events_;
+    numDropped = numDropped_;
+  }
+
+  folly::dynamic traceEvents = folly::dynamic::array;
+  // The track of each operator, named by a metadata event.
+  std::unordered_map<std::string, int32_t> tracks;
+  for (const auto& event : events) {
+    auto [it, inserted] = tracks.emplace(event.operatorName, tracks.size());
+    if (inserted) {
+      folly::dynamic track = folly::dynamic::object;
+      track["name"] = "thread_name";
+      track["ph"] = "M";
+      track["pid"] = 0;
+      track["tid"] = it->second;
+      track["args"] = folly::dynamic::object("name", event.operatorName);
+      traceEvents.push_back(std::move(track));
+    }
+    folly::dynamic traceEvent = folly::dynamic::object;
+    traceEvent["name"] = std::string(eventTypeName(event.type));
+    traceEvent["cat"] = "memory";
+    traceEvent["ph"] = "X";
+    traceEvent["ts"] = event.startUs;
+    traceEvent["dur"] = event.durationUs;
+    traceEvent["pid"] = 0;
+    traceEvent["tid"] = it->second;
+    traceEvent["args"] = folly::dynamic::object("bytes", event.bytes);
+    if (!event.partition.empty()) {
+      traceEvent["args"]["partition"] = event.partition;
+    }
+    traceEvents.push_back(std::move(traceEvent));
+  }
+  return folly::toJson(
+      folly::dynamic::object("traceEvents", std::move(traceEvents))(
+          "otherData", folly::dynamic::object("numDropped", numDropped)));
+}
+
+MemoryTimelineRecorder::MemoryTimelineRecorder(const Operator& op) {
+  const auto& task = op.operatorCtx()->task();
+  if (task == nullptr || task->memoryTimeline() == nullptr) {
+    return;
+  }
+  timeline_ = task->memoryTimeline();
+  operatorName_ = op.toString();
+}
+
+// static
+MemoryTimelineRecorder MemoryTimelineRecorder::forCurrentOperator() {
+  const auto* op = dynamic_cast<const Operator*>(
+      getThreadLocalRunTimeStatWriter());
+  if (op == nullptr) {
+    return MemoryTimelineRecorder();
+  }
+  return MemoryTimelineRecorder(*op);
+}
+
+void MemoryTimelineRecorder::record(
+    MemoryTimeline::EventType type,
+    uint64_t startUs,
+    uint64_t bytes,
+    std::string partition) const {
+  if (timeline_ == nullptr) {
+    return;
+  }
+  const auto nowUs = getCurrentTimeMicro();
+  timeline_->add(
+      {type,
+       operatorName_,
+       startUs,
+       nowUs > startUs ? nowUs - startUs : 0,
+       bytes,
+       std::move(partition)});
+}
+
+} // namespace facebook::velox::exec
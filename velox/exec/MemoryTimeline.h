@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+class Operator;
+
+/// Timestamped memory events of a task: the memory arbitration requests of
+/// its operators, the reclaims from them and the spill runs and restores they
+/// do. Complements the totals of SpillStats and MemoryArbitrator::Stats with
+/// when and where the time went. Keeps up to 'maxEvents' events and counts
+/// the ones after. Thread safe.
+class MemoryTimeline {
+ public:
+  enum class EventType {
+    /// An operator waited for the arbitrator to grow the capacity of its
+    /// query. 'bytes' is the capacity granted.
+    kArbitration,
+    /// Memory was reclaimed from an operator, by spilling or otherwise.
+    /// 'bytes' is the memory freed.
+    kReclaim,
+    /// A spill run wrote a partition to disk. 'bytes' is the size of the rows
+    /// in memory.
+    kSpill,
+    /// A spill file was read back, from its first read to its end. 'bytes' is
+    /// the size of the file.
+    kRestore,
+  };
+
+  static std::string_view eventTypeName(EventType type);
+
+  struct Event {
+    EventType type;
+    /// Operator::toString() of the operator the event is for.
+    std::string operatorName;
+    /// Microseconds since epoch.
+    uint64_t startUs{0};
+    uint64_t durationUs{0};
+    uint64_t bytes{0};
+    /// The spill partition of a kSpill event, empty otherwise.
+    std::string partition;
+  };
+
+  explicit MemoryTimeline(uint32_t maxEvents) : maxEvents_(maxEvents) {}
+
+  void add(Event event);
+
+  /// Returns the events in the order they ended.
+  std::vector<Event> events() const;
+
+  /// The number of events not kept because 'maxEvents' was reached.
+  uint64_t numDropped() const;
+
+  /// Returns the events in the JSON trace event format of chrome://tracing
+  /// and Perfetto, with a track per operator.
+  std::string toChromeTrace() const;
+
+ private:
+  const uint32_t maxEvents_;
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  uint64_t numDropped_{0};
+};
+
+/// Adds the events of an operator to the timeline of its task. Inactive if
+/// the task keeps no timeline.
+class MemoryTimelineRecorder {
+ public:
+  MemoryTimelineRecorder() = default;
+
+  explicit MemoryTimelineRecorder(const Operator& op);
+
+  /// Returns the recorder for the operator whose call runs on this thread,
+  /// found through the runtime stat writer of the thread. Used by the spill
+  /// code, which does not know its operator.
+  static MemoryTimelineRecorder forCurrentOperator();
+
+  bool active() const {
+    return timeline_ != nullptr;
+  }
+
+  /// Adds an event from 'startUs' to now if active.
+  void record(
+      MemoryTimeline::EventType type,
+      uint64_t startUs,
+      uint64_t bytes,
+      std::string partition = {}) const;
+
+ private:
+  std::shared_ptr<MemoryTimeline> timeline_;
+  std::string operatorName_;
+};
+
+} // namespace facebook::velox::exec
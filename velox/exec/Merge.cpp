@@ -20,6 +20,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorType.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/OrderBy.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -214,9 +215,16 @@ void Merge::maybeStartNextMergeSourceGroup() {
       maxOutputBatchRows_,
       maxOutputBatchBytes_,
       pool());
-  // Start sources.
-  for (const auto& source : sources) {
-    source->start();
+  // Start sources. All sources of a concatenation start at once so that the
+  // producers of the later sources are not blocked waiting for the start.
+  if (!concatenateSources_) {
+    for (const auto& source : sources) {
+      source->start();
+    }
+  } else if (numStartedSources_ == 0) {
+    for (const auto& source : sources_) {
+      source->start();
+    }
   }
   numStartedSources_ += sources.size();
 }
@@ -252,8 +260,12 @@ RowVectorPtr Merge::getOutputFromSource() {
 
   finishMergeSourceGroup();
   if (numStartedSources_ < sources_.size()) {
-    VELOX_CHECK_NULL(output_);
-    return nullptr;
+    // The last rows of a concatenated source are output as is. A spilled merge
+    // run has no output.
+    if (!concatenateSources_) {
+      VELOX_CHECK_NULL(output_);
+    }
+    return std::move(output_);
   }
 
   VELOX_CHECK_EQ(mergeStats_.streamingSourceReadEndTimeUs, 0);
@@ -729,6 +741,34 @@ void SpillMerger::checkError() {
   }
 }
 
+namespace {
+// Returns true if the single source of 'localMergeNode' is an OrderBy with the
+// same sorting keys that merges the rows of its drivers in parallel. The
+// sources of the local merge are then sorted key ranges in source order.
+bool sourcesAreKeyRanges(
+    const core::LocalMergeNode& localMergeNode,
+    const core::QueryConfig& queryConfig) {
+  if (localMergeNode.sources().size() != 1) {
+    return false;
+  }
+  const auto orderBy = std::dynamic_pointer_cast<const core::OrderByNode>(
+      localMergeNode.sources()[0]);
+  if (orderBy == nullptr ||
+      !OrderBy::parallelMergeEnabled(*orderBy, queryConfig) ||
+      orderBy->sortingOrders() != localMergeNode.sortingOrders() ||
+      orderBy->sortingKeys().size() != localMergeNode.sortingKeys().size()) {
+    return false;
+  }
+  for (auto i = 0; i < orderBy->sortingKeys().size(); ++i) {
+    if (orderBy->sortingKeys()[i]->name() !=
+        localMergeNode.sortingKeys()[i]->name()) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 LocalMerge::LocalMerge(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -758,6 +798,10 @@ LocalMerge::LocalMerge(
                               ->queryConfig()
                               .localMergeMaxNumMergeSources();
   }
+  if (sourcesAreKeyRanges(*localMergeNode, driverCtx->queryConfig())) {
+    concatenateSources_ = true;
+    maxNumMergeSources_ = 1;
+  }
 }
 
 BlockingReason LocalMerge::addMergeSources(ContinueFuture* /* future */) {
@@ -76,6 +76,9 @@ class Merge : public SourceOperator {
   size_t numStartedSources_{0};
   /// Maximum number of merge sources per run.
   uint32_t maxNumMergeSources_{std::numeric_limits<uint32_t>::max()};
+  /// True if the sources are sorted and ascend in key order, so that the
+  /// output is their concatenation. The sources are then read one at a time.
+  bool concatenateSources_{false};
 
  private:
   // Tracks the internal execution stats for a merge operator.
@@ -100,7 +103,7 @@ class Merge : public SourceOperator {
   // Returns true if needs to spill the merged source output if all sources can
   // not be merged at once.
   bool needSpill() const {
-    return maxNumMergeSources_ < sources_.size();
+    return !concatenateSources_ && maxNumMergeSources_ < sources_.size();
   }
 
   void maybeSetupOutputSpiller();
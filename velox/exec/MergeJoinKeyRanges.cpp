@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/MergeJoinKeyRanges.h"
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+struct SplitRange {
+  const MergeJoinKeyRange* range;
+  // Where to store the group of the split.
+  int32_t* group;
+};
+
+} // namespace
+
+MergeJoinSplitGroups assignMergeJoinSplitGroups(
+    const std::vector<MergeJoinKeyRange>& leftRanges,
+    const std::vector<MergeJoinKeyRange>& rightRanges,
+    int32_t maxGroups) {
+  VELOX_USER_CHECK_GT(maxGroups, 0);
+
+  MergeJoinSplitGroups result;
+  result.leftGroups.resize(leftRanges.size(), 0);
+  result.rightGroups.resize(rightRanges.size(), 0);
+
+  std::vector<SplitRange> splits;
+  splits.reserve(leftRanges.size() + rightRanges.size());
+  for (size_t i = 0; i < leftRanges.size(); ++i) {
+    splits.push_back({&leftRanges[i], &result.leftGroups[i]});
+  }
+  for (size_t i = 0; i < rightRanges.size(); ++i) {
+    splits.push_back({&rightRanges[i], &result.rightGroups[i]});
+  }
+  for (const auto& split : splits) {
+    if (split.range->min.isNull() || split.range->max.isNull()) {
+      return result;
+    }
+    VELOX_USER_CHECK(
+        !(split.range->max < split.range->min),
+        "Merge join key range has min {} greater than max {}",
+        split.range->min.toJsonUnsafe(),
+        split.range->max.toJsonUnsafe());
+  }
+
+  std::sort(splits.begin(), splits.end(), [](const auto& a, const auto& b) {
+    return a.range->min < b.range->min;
+  });
+
+  // Splits overlapping with the previous ones, transitively, form a run that
+  // must stay in one group. 'runEnds[i]' is the end of the i-th run.
+  std::vector<size_t> runEnds;
+  const Variant* runMax = nullptr;
+  for (size_t i = 0; i < splits.size(); ++i) {
+    const auto& range = *splits[i].range;
+    if (runMax != nullptr && *runMax < range.min) {
+      runEnds.push_back(i);
+      runMax = nullptr;
+    }
+    if (runMax == nullptr || *runMax < range.max) {
+      runMax = &range.max;
+    }
+  }
+  if (!splits.empty()) {
+    runEnds.push_back(splits.size());
+  }
+
+  // Packs consecutive runs into groups of about 'targetSize' splits.
+  const auto numGroups =
+      std::min<size_t>(maxGroups, std::max<size_t>(runEnds.size(), 1));
+  const auto targetSize = (splits.size() + numGroups - 1) / numGroups;
+  int32_t group = 0;
+  size_t groupStart = 0;
+  size_t runStart = 0;
+  for (auto runEnd : runEnds) {
+    if (runStart > groupStart && runStart - groupStart >= targetSize &&
+        group + 1 < numGroups) {
+      ++group;
+      groupStart = runStart;
+    }
+    for (auto i = runStart; i < runEnd; ++i) {
+      *splits[i].group = group;
+    }
+    runStart = runEnd;
+  }
+  result.numGroups = group + 1;
+  return result;
+}
+
+} // namespace facebook::velox::exec
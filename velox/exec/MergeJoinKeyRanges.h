@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "velox/type/Variant.h"
+
+namespace facebook::velox::exec {
+
+/// The range of the leading join key in a split of a sorted merge join
+/// input, e.g. from the min/max statistics of its file. Null 'min' or 'max'
+/// means the range is not known.
+struct MergeJoinKeyRange {
+  Variant min;
+  Variant max;
+};
+
+/// Split groups for the two inputs of a merge join, see
+/// assignMergeJoinSplitGroups().
+struct MergeJoinSplitGroups {
+  /// The group of each left split.
+  std::vector<int32_t> leftGroups;
+  /// The group of each right split.
+  std::vector<int32_t> rightGroups;
+  /// At least 1.
+  int32_t numGroups{1};
+};
+
+/// Assigns the splits of the sorted inputs of a merge join to up to
+/// 'maxGroups' split groups so that the key ranges of different groups do
+/// not overlap and the keys of group i are smaller than the ones of group
+/// i + 1. Splits whose ranges overlap, directly or through splits of the
+/// other input, are in the same group, so a group has all the rows that can
+/// match each other. The groups hold about the same number of splits.
+///
+/// Running the join with grouped execution over both table scans then
+/// merges the groups in parallel, one driver per group, with
+/// numSplitGroups = 'numGroups'. The output of each group is sorted and
+/// concatenating the groups in order gives the sorted output of the join.
+///
+/// The splits of a group must still be added in key order for the input of
+/// the group to be sorted. If a range is not known, all splits are in group
+/// 0.
+MergeJoinSplitGroups assignMergeJoinSplitGroups(
+    const std::vector<MergeJoinKeyRange>& leftRanges,
+    const std::vector<MergeJoinKeyRange>& rightRanges,
+    int32_t maxGroups);
+
+} // namespace facebook::velox::exec
@@ -265,6 +265,21 @@ class MergeExchangeSource : public MergeSource {
         return BlockingReason::kWaitForProducer;
       }
     }
+    if (auto vector = currentPage_->vector()) {
+      // Copies the rows of a VectorPage into the memory of MergeExchange.
+      data = BaseVector::create<RowVector>(
+          mergeExchange_->outputType(), vector->size(), mergeExchange_->pool());
+      data->copy(vector.get(), 0, 0, vector->size());
+      const auto rawInputBytes = currentPage_->size();
+      currentPage_ = nullptr;
+
+      auto lockedStats = mergeExchange_->stats().wlock();
+      lockedStats->rawInputBytes += rawInputBytes;
+      lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+      lockedStats->rawInputPositions += data->size();
+      return BlockingReason::kNotBlocked;
+    }
+
     if (inputStream_ == nullptr) {
       mergeExchange_->stats().wlock()->rawInputBytes += currentPage_->size();
       inputStream_ = currentPage_->prepareStreamForDeserialize();
@@ -46,6 +46,53 @@ std::vector<IdentityProjection> extractProjections(
   return projections;
 }
 
+// Returns the input column 'expr' reads, or nullptr if it is not one.
+const core::FieldAccessTypedExpr* asInputColumn(
+    const core::TypedExprPtr& expr) {
+  const auto* field =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  return field != nullptr && field->isInputColumn() ? field : nullptr;
+}
+
+// Whether BaseVector::compare() orders values of 'type' like the comparison
+// functions do.
+bool isBandKeyType(const Type& type) {
+  if (type.providesCustomComparison()) {
+    return false;
+  }
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the first of positions [0, size) for which 'predicate' is true, or
+// 'size' if there is none. 'predicate' must be false for a prefix of the
+// positions and true for the rest.
+template <typename Predicate>
+vector_size_t firstTrue(vector_size_t size, Predicate predicate) {
+  vector_size_t begin = 0;
+  vector_size_t end = size;
+  while (begin < end) {
+    const auto middle = begin + (end - begin) / 2;
+    if (predicate(middle)) {
+      end = middle;
+    } else {
+      begin = middle + 1;
+    }
+  }
+  return begin;
+}
+
 } // namespace
 
 NestedLoopJoinProbe::NestedLoopJoinProbe(
@@ -76,11 +123,163 @@ void NestedLoopJoinProbe::initialize() {
         joinNode_->joinCondition(),
         joinNode_->sources()[0]->outputType(),
         joinNode_->sources()[1]->outputType());
+    initializeBand(
+        joinNode_->joinCondition(),
+        joinNode_->sources()[0]->outputType(),
+        joinNode_->sources()[1]->outputType());
   }
 
   joinNode_.reset();
 }
 
+void NestedLoopJoinProbe::initializeBand(
+    const core::TypedExprPtr& condition,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(condition.get());
+  if (call == nullptr) {
+    return;
+  }
+  const auto& inputs = call->inputs();
+  if (call->name() == "and") {
+    for (const auto& input : inputs) {
+      initializeBand(input, probeType, buildType);
+    }
+  } else if (call->name() == "between" && inputs.size() == 3) {
+    addBandKey(inputs[0], inputs[1], false, probeType, buildType);
+    addBandKey(inputs[0], inputs[2], true, probeType, buildType);
+  } else if (inputs.size() == 2) {
+    if (call->name() == "lt" || call->name() == "lte") {
+      addBandKey(inputs[0], inputs[1], true, probeType, buildType);
+    } else if (call->name() == "gt" || call->name() == "gte") {
+      addBandKey(inputs[0], inputs[1], false, probeType, buildType);
+    }
+  }
+}
+
+void NestedLoopJoinProbe::addBandKey(
+    const core::TypedExprPtr& left,
+    const core::TypedExprPtr& right,
+    bool lessOrEqual,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  const auto* probeField = asInputColumn(left);
+  const auto* buildField = asInputColumn(right);
+  if (probeField == nullptr || buildField == nullptr) {
+    return;
+  }
+  // Field names are looked up on the probe side first, like in
+  // initializeFilter().
+  auto probeChannel = probeType->getChildIdxIfExists(probeField->name());
+  if (!probeChannel.has_value()) {
+    std::swap(probeField, buildField);
+    lessOrEqual = !lessOrEqual;
+    probeChannel = probeType->getChildIdxIfExists(probeField->name());
+    if (!probeChannel.has_value()) {
+      return;
+    }
+  }
+  if (probeType->containsChild(buildField->name())) {
+    return;
+  }
+  const auto buildChannel = buildType->getChildIdxIfExists(buildField->name());
+  if (!buildChannel.has_value()) {
+    return;
+  }
+  const auto& type = probeType->childAt(probeChannel.value());
+  if (!isBandKeyType(*type) ||
+      !type->equivalent(*buildType->childAt(buildChannel.value()))) {
+    return;
+  }
+
+  // 'probe <= build' bounds the build column from below.
+  auto& key = lessOrEqual ? bandEnd_ : bandStart_;
+  if (!key.has_value()) {
+    key = BandKey{probeChannel.value(), buildChannel.value()};
+  }
+}
+
+void NestedLoopJoinProbe::prepareBand() {
+  const auto& sortKey = bandStart_.has_value() ? *bandStart_ : *bandEnd_;
+  const auto& buildVectors = buildVectors_.value();
+  bandSortedRows_.resize(buildVectors.size());
+  if (bandStart_.has_value() && bandEnd_.has_value()) {
+    bandMaxEndRows_.resize(buildVectors.size());
+  }
+  for (auto i = 0; i < buildVectors.size(); ++i) {
+    const auto& build = buildVectors[i];
+    const auto* key = build->childAt(sortKey.buildChannel).get();
+    auto& rows = bandSortedRows_[i];
+    for (vector_size_t row = 0; row < build->size(); ++row) {
+      if (!key->isNullAt(row)) {
+        rows.push_back(row);
+      }
+    }
+    key->sortIndices(rows, CompareFlags());
+
+    if (bandMaxEndRows_.empty()) {
+      continue;
+    }
+    const auto* end = build->childAt(bandEnd_->buildChannel).get();
+    auto& maxEndRows = bandMaxEndRows_[i];
+    maxEndRows.resize(rows.size());
+    vector_size_t maxEndRow = -1;
+    for (auto j = 0; j < rows.size(); ++j) {
+      const auto row = rows[j];
+      if (!end->isNullAt(row) &&
+          (maxEndRow < 0 || end->compare(end, row, maxEndRow) > 0)) {
+        maxEndRow = row;
+      }
+      maxEndRows[j] = maxEndRow;
+    }
+  }
+}
+
+void NestedLoopJoinProbe::selectBandRows(vector_size_t numRows) {
+  filterInputRows_.resizeFill(numRows, false);
+
+  const auto& build = buildVectors_.value()[buildIndex_];
+  const auto& sortedRows = bandSortedRows_[buildIndex_];
+  const auto numSorted = static_cast<vector_size_t>(sortedRows.size());
+  // Compares the build column of 'key' at 'buildRow' to the probe column at
+  // 'probeRow_'.
+  const auto compareToProbe = [&](const BandKey& key, vector_size_t buildRow) {
+    return build->childAt(key.buildChannel)
+        ->compare(
+            input_->childAt(key.probeChannel).get(), buildRow, probeRow_);
+  };
+  const auto probeIsNull = [&](const std::optional<BandKey>& key) {
+    return key.has_value() &&
+        input_->childAt(key->probeChannel)->isNullAt(probeRow_);
+  };
+
+  vector_size_t begin = 0;
+  vector_size_t end = numSorted;
+  if (probeIsNull(bandStart_) || probeIsNull(bandEnd_)) {
+    end = 0;
+  } else if (bandStart_.has_value()) {
+    end = firstTrue(numSorted, [&](auto i) {
+      return compareToProbe(*bandStart_, sortedRows[i]) > 0;
+    });
+    if (bandEnd_.has_value()) {
+      const auto& maxEndRows = bandMaxEndRows_[buildIndex_];
+      begin = firstTrue(end, [&](auto i) {
+        return maxEndRows[i] >= 0 &&
+            compareToProbe(*bandEnd_, maxEndRows[i]) >= 0;
+      });
+    }
+  } else {
+    begin = firstTrue(numSorted, [&](auto i) {
+      return compareToProbe(*bandEnd_, sortedRows[i]) >= 0;
+    });
+  }
+
+  for (auto i = begin; i < end; ++i) {
+    filterInputRows_.setValid(sortedRows[i], true);
+  }
+  filterInputRows_.updateBounds();
+}
+
 void NestedLoopJoinProbe::initializeFilter(
     const core::TypedExprPtr& filter,
     const RowTypePtr& probeType,
@@ -154,6 +353,9 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
           buildMatched_[i].resizeFill(buildVectors_.value()[i]->size(), false);
         }
       }
+      if (hasBand()) {
+        prepareBand();
+      }
 
       setState(ProbeOperatorState::kRunning);
       return BlockingReason::kNotBlocked;
@@ -381,7 +583,9 @@ bool NestedLoopJoinProbe::addToOutput() {
     }
 
     // Iterate over the filter results. For each match, add an output record.
-    for (size_t i = buildRow_; i < decodedFilterResult_.size(); ++i) {
+    const vector_size_t numCandidates =
+        hasBand() ? filterInputRows_.end() : currentBuild->size();
+    for (size_t i = buildRow_; i < numCandidates; ++i) {
       if (!isJoinConditionMatch(i)) {
         continue;
       }
@@ -487,6 +691,15 @@ void NestedLoopJoinProbe::prepareOutput() {
 }
 
 void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
+  if (useFilterTiles()) {
+    if (probeRow_ < filterTileBegin_ || probeRow_ >= filterTileEnd_) {
+      evaluateJoinFilterTile(buildVector);
+    }
+    filterResultOffset_ = (probeRow_ - filterTileBegin_) * buildVector->size();
+    return;
+  }
+  filterResultOffset_ = 0;
+
   // First step to process is to get a batch so we can evaluate the join
   // filter.
   auto filterInput = getNextCrossProductBatch(
@@ -495,11 +708,70 @@ void NestedLoopJoinProbe::evaluateJoinFilter(const RowVectorPtr& buildVector) {
       filterProbeProjections_,
       filterBuildProjections_);
 
-  if (filterInputRows_.size() != filterInput->size()) {
+  if (hasBand()) {
+    selectBandRows(filterInput->size());
+    if (!filterInputRows_.hasSelections()) {
+      return;
+    }
+  } else if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
   }
-  VELOX_CHECK(filterInputRows_.isAllSelected());
+  VELOX_CHECK(hasBand() || filterInputRows_.isAllSelected());
+  evalJoinCondition(filterInput);
+}
+
+void NestedLoopJoinProbe::evaluateJoinFilterTile(
+    const RowVectorPtr& buildVector) {
+  const auto numBuildRows = buildVector->size();
+  const auto numProbeRows = std::min(
+      std::max<vector_size_t>(kMaxFilterTileRows / numBuildRows, 1),
+      input_->size() - probeRow_);
+  const auto numRows = numProbeRows * numBuildRows;
+
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, numRows, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, numRows, pool());
+  for (auto i = 0; i < numProbeRows; ++i) {
+    std::fill(
+        rawProbeIndices.begin() + i * numBuildRows,
+        rawProbeIndices.begin() + (i + 1) * numBuildRows,
+        probeRow_ + i);
+    std::iota(
+        rawBuildIndices.begin() + i * numBuildRows,
+        rawBuildIndices.begin() + (i + 1) * numBuildRows,
+        0);
+  }
+
+  std::vector<VectorPtr> projectedChildren(filterInputType_->size());
+  projectChildren(
+      projectedChildren,
+      input_,
+      filterProbeProjections_,
+      numRows,
+      probeIndices_);
+  projectChildren(
+      projectedChildren,
+      buildVector,
+      filterBuildProjections_,
+      numRows,
+      buildIndices_);
+  auto filterInput = std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      nullptr,
+      numRows,
+      std::move(projectedChildren));
+
+  if (filterInputRows_.size() != numRows) {
+    filterInputRows_.resizeFill(numRows, true);
+  }
+  evalJoinCondition(filterInput);
+  filterTileBegin_ = probeRow_;
+  filterTileEnd_ = probeRow_ + numProbeRows;
+}
 
+void NestedLoopJoinProbe::evalJoinCondition(const RowVectorPtr& filterInput) {
   std::vector<VectorPtr> filterResult;
   EvalCtx evalCtx(
       operatorCtx_->execCtx(), joinCondition_.get(), filterInput.get());
@@ -693,6 +965,8 @@ void NestedLoopJoinProbe::finishProbeInput() {
   input_.reset();
   buildIndex_ = 0;
   probeRow_ = 0;
+  filterTileBegin_ = 0;
+  filterTileEnd_ = 0;
 
   if (!noMoreInput_) {
     return;
@@ -65,6 +65,20 @@ namespace facebook::velox::exec {
 /// to be copied, then performs the copies in batch, column-by-column. It
 /// produces at most `outputBatchSize_` records, but it may produce fewer since
 /// the output needs to follow the probe vector boundaries.
+///
+/// If the join condition is a conjunction with range comparisons between a
+/// probe and a build column, e.g. "t.ts BETWEEN u.start AND u.end", the build
+/// rows of each build vector are sorted on one of these build columns. For
+/// each probe row the join condition is then only evaluated on the build rows
+/// that can pass the comparisons, which are found by binary search. With both
+/// a lower and an upper bound on the build rows, the running maximum of the
+/// upper bound column in the sort order of the lower bound one narrows the
+/// range further. The output order does not change.
+///
+/// Otherwise, if the build side has a single vector, the join condition is
+/// evaluated on a tile of several probe rows times all build rows at once,
+/// wrapped in dictionaries, instead of once per probe row. The results of the
+/// tile are then consumed one probe row at a time.
 class NestedLoopJoinProbe : public Operator {
  public:
   NestedLoopJoinProbe(
@@ -101,6 +115,36 @@ class NestedLoopJoinProbe : public Operator {
       const RowTypePtr& leftType,
       const RowTypePtr& rightType);
 
+  // Finds the comparisons between a probe and a build column in 'condition'
+  // that can narrow the build rows to evaluate the join condition on, and
+  // sets 'bandStart_' and 'bandEnd_'.
+  void initializeBand(
+      const core::TypedExprPtr& condition,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  // Records 'left <= right', or 'left >= right' if 'lessOrEqual' is false, as
+  // a band key if one side is a probe column and the other a build column of
+  // the same orderable type.
+  void addBandKey(
+      const core::TypedExprPtr& left,
+      const core::TypedExprPtr& right,
+      bool lessOrEqual,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  bool hasBand() const {
+    return bandStart_.has_value() || bandEnd_.has_value();
+  }
+
+  // Sorts the rows of each build vector on the band key once the build data
+  // is available.
+  void prepareBand();
+
+  // Selects in 'filterInputRows_' the rows of the current build vector, of
+  // 'numRows' rows, that can match the current probe row.
+  void selectBandRows(vector_size_t numRows);
+
   // Materializes build data from nested loop join bridge into `buildVectors_`.
   // Returns whether the data has been materialized and is ready for use. Nested
   // loop join requires all build data to be materialized and available in
@@ -146,11 +190,29 @@ class NestedLoopJoinProbe : public Operator {
   // by `isJoinConditionMatch(buildRow)` below.
   void evaluateJoinFilter(const RowVectorPtr& buildVector);
 
-  // Checks if the join condition matched for a particular row.
+  // Evaluates the joinCondition on a tile of the probe rows from `probeRow_`
+  // on times all rows of 'buildVector', which is the only build vector.
+  void evaluateJoinFilterTile(const RowVectorPtr& buildVector);
+
+  // Evaluates the joinCondition on the rows of 'filterInput' selected in
+  // `filterInputRows_`.
+  void evalJoinCondition(const RowVectorPtr& filterInput);
+
+  // Whether the joinCondition is evaluated on tiles of probe and build rows.
+  bool useFilterTiles() const {
+    return !hasBand() && isSingleBuildVector();
+  }
+
+  // Checks if the join condition matched for build row 'i' of the current
+  // build vector and the current probe row.
   bool isJoinConditionMatch(vector_size_t i) const {
+    if (hasBand() && !filterInputRows_.isValid(i)) {
+      return false;
+    }
+    const auto row = filterResultOffset_ + i;
     return (
-        !decodedFilterResult_.isNullAt(i) &&
-        decodedFilterResult_.valueAt<bool>(i));
+        !decodedFilterResult_.isNullAt(row) &&
+        decodedFilterResult_.valueAt<bool>(row));
   }
 
   // Generates the next batch of a cross product between probe and build. It
@@ -321,6 +383,20 @@ class NestedLoopJoinProbe : public Operator {
   VectorPtr filterOutput_;
   DecodedVector decodedFilterResult_;
 
+  // Maximum number of probe and build row pairs in a tile the joinCondition
+  // is evaluated on, see evaluateJoinFilterTile(). Keeps the dictionary
+  // indices and filter results of a tile in L2.
+  static constexpr vector_size_t kMaxFilterTileRows = 8'192;
+
+  // The probe rows of `input_` in the last tile the joinCondition was
+  // evaluated on.
+  vector_size_t filterTileBegin_{0};
+  vector_size_t filterTileEnd_{0};
+
+  // Offset in `decodedFilterResult_` of the results for the current probe
+  // row.
+  vector_size_t filterResultOffset_{0};
+
   // Join metadata and state.
   std::shared_ptr<const core::NestedLoopJoinNode> joinNode_;
 
@@ -380,6 +456,29 @@ class NestedLoopJoinProbe : public Operator {
   std::vector<IdentityProjection> filterBuildProjections_;
 
   BufferPtr buildOutMapping_;
+
+  // A probe and a build column compared in the join condition.
+  struct BandKey {
+    column_index_t probeChannel;
+    column_index_t buildChannel;
+  };
+
+  // Build rows can only match if their 'bandStart_' column is not greater
+  // than the probe one.
+  std::optional<BandKey> bandStart_;
+
+  // Build rows can only match if their 'bandEnd_' column is not less than the
+  // probe one.
+  std::optional<BandKey> bandEnd_;
+
+  // For each build vector, the rows with a non-null band key ('bandStart_' if
+  // set, else 'bandEnd_') in the order of the key.
+  std::vector<std::vector<vector_size_t>> bandSortedRows_;
+
+  // With both 'bandStart_' and 'bandEnd_', for each build vector and position
+  // i in 'bandSortedRows_', the row with the largest end among the first i + 1
+  // rows, or -1 if all their ends are null.
+  std::vector<std::vector<vector_size_t>> bandMaxEndRows_;
 };
 
 } // namespace facebook::velox::exec
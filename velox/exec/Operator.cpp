@@ -19,7 +19,9 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Driver.h"
+#include "velox/exec/MemoryTimeline.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
@@ -47,6 +49,12 @@ core::ExecCtx* OperatorCtx::execCtx() const {
   return execCtx_.get();
 }
 
+void OperatorCtx::clearVectorPool() {
+  if (execCtx_ != nullptr && execCtx_->vectorPool() != nullptr) {
+    execCtx_->vectorPool()->clear();
+  }
+}
+
 std::shared_ptr<connector::ConnectorQueryCtx>
 OperatorCtx::createConnectorQueryCtx(
     const std::string& connectorId,
@@ -418,6 +426,24 @@ void Operator::recordSpillStats() {
         RuntimeCounter{
             static_cast<int64_t>(writeTime), RuntimeCounter::Unit::kNanos});
   }
+  const auto overflowBytes =
+      spillStats_->spilledOverflowBytes.load(std::memory_order_relaxed);
+  if (overflowBytes != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillOverflowBytes,
+        RuntimeCounter{
+            static_cast<int64_t>(overflowBytes),
+            RuntimeCounter::Unit::kBytes});
+  }
+  const auto overflowWriteTime =
+      spillStats_->spillOverflowWriteTimeNanos.load(std::memory_order_relaxed);
+  if (overflowWriteTime != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillOverflowWriteTime,
+        RuntimeCounter{
+            static_cast<int64_t>(overflowWriteTime),
+            RuntimeCounter::Unit::kNanos});
+  }
   const auto runs = spillStats_->spillRuns.load(std::memory_order_relaxed);
   if (runs != 0) {
     lockedStats->addRuntimeStat(
@@ -661,6 +687,8 @@ std::unique_ptr<memory::MemoryReclaimer> Operator::MemoryReclaimer::create(
 }
 
 void Operator::MemoryReclaimer::enterArbitration() {
+  arbitrationStartUs_ = getCurrentTimeMicro();
+  arbitrationStartCapacity_ = op_->pool()->root()->capacity();
   DriverThreadContext* driverThreadCtx = driverThreadContext();
   if (FOLLY_UNLIKELY(driverThreadCtx == nullptr)) {
     // Skips the driver suspension handling if this memory arbitration request
@@ -694,6 +722,15 @@ void Operator::MemoryReclaimer::enterArbitration() {
 }
 
 void Operator::MemoryReclaimer::leaveArbitration() noexcept {
+  if (ensureDriver() != nullptr) {
+    const auto capacity = op_->pool()->root()->capacity();
+    MemoryTimelineRecorder(*op_).record(
+        MemoryTimeline::EventType::kArbitration,
+        arbitrationStartUs_,
+        capacity > arbitrationStartCapacity_
+            ? capacity - arbitrationStartCapacity_
+            : 0);
+  }
   DriverThreadContext* driverThreadCtx = driverThreadContext();
   if (FOLLY_UNLIKELY(driverThreadCtx == nullptr)) {
     // Skips the driver suspension handling if this memory arbitration request
@@ -765,11 +802,13 @@ uint64_t Operator::MemoryReclaimer::reclaim(
 
   RuntimeStatWriterScopeGuard opStatsGuard(op_);
 
-  return memory::MemoryReclaimer::run(
+  const auto startUs = getCurrentTimeMicro();
+  const auto reclaimed = memory::MemoryReclaimer::run(
       [&]() {
         int64_t reclaimedBytes{0};
         {
           memory::ScopedReclaimedBytesRecorder recoder(pool, &reclaimedBytes);
+          op_->operatorCtx_->clearVectorPool();
           op_->reclaim(targetBytes, stats);
         }
         VELOX_CHECK_GE(
@@ -780,6 +819,9 @@ uint64_t Operator::MemoryReclaimer::reclaim(
         return reclaimedBytes;
       },
       stats);
+  MemoryTimelineRecorder(*op_).record(
+      MemoryTimeline::EventType::kReclaim, startUs, reclaimed);
+  return reclaimed;
 }
 
 void Operator::MemoryReclaimer::abort(
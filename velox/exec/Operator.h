@@ -85,6 +85,10 @@ class OperatorCtx {
 
   core::ExecCtx* execCtx() const;
 
+  /// Frees the vectors that the VectorPool of 'execCtx()' keeps for reuse.
+  /// Called when memory is reclaimed from the operator.
+  void clearVectorPool();
+
   /// Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   /// is the id of the calling TableScan. This and the task id identify the scan
   /// for column access tracking. 'connectorPool' is an aggregate memory pool
@@ -176,6 +180,10 @@ class Operator : public BaseRuntimeStatWriter {
   static constexpr std::string_view kSpillFlushTime{"spillFlushWallNanos"};
   static constexpr std::string_view kSpillWrites{"spillWrites"};
   static constexpr std::string_view kSpillWriteTime{"spillWriteWallNanos"};
+  static constexpr std::string_view kSpillOverflowBytes{
+      "spilledOverflowBytes"};
+  static constexpr std::string_view kSpillOverflowWriteTime{
+      "spillOverflowWriteWallNanos"};
   static constexpr std::string_view kSpillRuns{"spillRuns"};
   static constexpr std::string_view kExceededMaxSpillLevel{
       "exceededMaxSpillLevel"};
@@ -572,6 +580,12 @@ class Operator : public BaseRuntimeStatWriter {
 
     const std::weak_ptr<Driver> driver_;
     Operator* const op_;
+
+   private:
+    // The time and the query capacity when the operator entered the current
+    // arbitration, for the event in the memory timeline of the task.
+    uint64_t arbitrationStartUs_{0};
+    uint64_t arbitrationStartCapacity_{0};
   };
 
   /// Invoked to setup memory reclaimer for this operator's memory pool if its
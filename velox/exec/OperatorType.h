@@ -59,6 +59,9 @@ struct OperatorType {
   static constexpr std::string_view kSpatialJoinProbe = "SpatialJoinProbe";
   static constexpr std::string_view kStreamingEnforceDistinct =
       "StreamingEnforceDistinct";
+  static constexpr std::string_view kStreamingMarkDistinct =
+      "StreamingMarkDistinct";
+  static constexpr std::string_view kStreamingRowNumber = "StreamingRowNumber";
   static constexpr std::string_view kTableScan = "TableScan";
   static constexpr std::string_view kTableWrite = "TableWrite";
   static constexpr std::string_view kTableWriteMerge = "TableWriteMerge";
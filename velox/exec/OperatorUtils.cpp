@@ -170,6 +170,45 @@ void deselectRowsWithNulls(
   }
 }
 
+bool equalKeys(
+    const std::vector<column_index_t>& keyChannels,
+    const RowVectorPtr& batch,
+    vector_size_t index,
+    const RowVectorPtr& otherBatch,
+    vector_size_t otherIndex) {
+  for (auto channel : keyChannels) {
+    if (!batch->childAt(channel)->equalValueAt(
+            otherBatch->childAt(channel).get(), index, otherIndex)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void copyLastKeys(
+    const std::vector<column_index_t>& keyChannels,
+    const RowVectorPtr& input,
+    RowVectorPtr& lastKeys,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK_GT(input->size(), 0);
+  if (lastKeys == nullptr) {
+    const auto& inputType = asRowType(input->type());
+    std::vector<VectorPtr> keyVectors(inputType->size());
+    for (auto channel : keyChannels) {
+      keyVectors[channel] =
+          BaseVector::create(inputType->childAt(channel), 1, pool);
+    }
+    lastKeys = std::make_shared<RowVector>(
+        pool, inputType, nullptr, 1, std::move(keyVectors));
+  }
+
+  const auto lastRow = input->size() - 1;
+  for (auto channel : keyChannels) {
+    lastKeys->childAt(channel)->copy(
+        input->childAt(channel).get(), 0, lastRow, 1);
+  }
+}
+
 uint64_t* FilterEvalCtx::getRawSelectedBits(
     vector_size_t size,
     memory::MemoryPool* pool) {
@@ -510,6 +549,27 @@ folly::Range<vector_size_t*> initializeRowNumberMapping(
   return folly::Range(mapping->asMutable<vector_size_t>(), size);
 }
 
+bool findDistinctRows(
+    folly::Range<char* const*> rows,
+    vector_size_t maxDistinct,
+    folly::F14FastMap<const char*, vector_size_t>& positions,
+    std::vector<char*>& distinctRows,
+    vector_size_t* indices) {
+  positions.clear();
+  distinctRows.clear();
+  for (auto i = 0; i < rows.size(); ++i) {
+    auto [it, inserted] = positions.emplace(rows[i], distinctRows.size());
+    if (inserted) {
+      if (distinctRows.size() == maxDistinct) {
+        return false;
+      }
+      distinctRows.push_back(rows[i]);
+    }
+    indices[i] = it->second;
+  }
+  return true;
+}
+
 void projectChildren(
     std::vector<VectorPtr>& projectedChildren,
     const RowVectorPtr& src,
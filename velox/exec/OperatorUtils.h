@@ -16,6 +16,9 @@
 #pragma once
 
 #include <optional>
+
+#include <folly/container/F14Map.h>
+
 #include "velox/core/QueryConfig.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorType.h"
@@ -32,6 +35,26 @@ void deselectRowsWithNulls(
     const std::vector<std::unique_ptr<VectorHasher>>& hashers,
     SelectivityVector& rows);
 
+/// Returns true if row 'index' of 'batch' and row 'otherIndex' of 'otherBatch'
+/// have equal values in all 'keyChannels'. Nulls are equal to each other. Used
+/// by streaming operators over input clustered on the keys.
+bool equalKeys(
+    const std::vector<column_index_t>& keyChannels,
+    const RowVectorPtr& batch,
+    vector_size_t index,
+    const RowVectorPtr& otherBatch,
+    vector_size_t otherIndex);
+
+/// Copies the 'keyChannels' of the last row of non-empty 'input' into
+/// 'lastKeys' for comparison with the next batch. 'lastKeys' is a single row
+/// vector of the type of 'input', created on first use, whose other children
+/// are null.
+void copyLastKeys(
+    const std::vector<column_index_t>& keyChannels,
+    const RowVectorPtr& input,
+    RowVectorPtr& lastKeys,
+    memory::MemoryPool* pool);
+
 /// Reusable memory needed for processing filter results.
 struct FilterEvalCtx {
   DecodedVector decodedResult;
@@ -175,6 +198,18 @@ folly::Range<vector_size_t*> initializeRowNumberMapping(
     vector_size_t size,
     memory::MemoryPool* pool);
 
+/// Sets 'distinctRows' to the distinct entries of 'rows' in the order of their
+/// first occurrence and 'indices[i]' to the index of 'rows[i]' in
+/// 'distinctRows'. 'indices' must fit 'rows.size()' entries. Returns false and
+/// stops early if there are more than 'maxDistinct' distinct entries.
+/// 'positions' is scratch memory that can be reused across calls.
+bool findDistinctRows(
+    folly::Range<char* const*> rows,
+    vector_size_t maxDistinct,
+    folly::F14FastMap<const char*, vector_size_t>& positions,
+    std::vector<char*>& distinctRows,
+    vector_size_t* indices);
+
 /// Projects children of 'src' row vector according to 'projections'. Optionally
 /// takes a 'mapping' and 'size' that represent the indices and size,
 /// respectively, of a dictionary wrapping that should be applied to the
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/OrderBy.h"
+
+#include <algorithm>
+
 #include "velox/exec/OperatorType.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
@@ -29,6 +32,10 @@ CompareFlags fromSortOrderToCompareFlags(const core::SortOrder& sortOrder) {
       false,
       CompareFlags::NullHandlingMode::kNullAsValue};
 }
+
+// Number of rows sampled from the sorted rows of all drivers per key range for
+// choosing the splitter keys of a parallel merge.
+constexpr int32_t kSamplesPerRange = 256;
 } // namespace
 
 OrderBy::OrderBy(
@@ -43,7 +50,10 @@ OrderBy::OrderBy(
           OperatorType::kOrderBy,
           orderByNode->canSpill(driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId, OperatorType::kOrderBy)
-              : std::nullopt) {
+              : std::nullopt),
+      parallelMerge_(parallelMergeEnabled(
+          *orderByNode,
+          driverCtx->queryConfig())) {
   maxOutputRows_ = outputBatchRows(std::nullopt);
   VELOX_CHECK(pool()->trackUsage());
   std::vector<column_index_t> sortColumnIndices;
@@ -60,7 +70,7 @@ OrderBy::OrderBy(
     sortCompareFlags.push_back(
         fromSortOrderToCompareFlags(orderByNode->sortingOrders()[i]));
   }
-  sortBuffer_ = std::make_unique<SortBuffer>(
+  sortBuffer_ = std::make_shared<SortBuffer>(
       outputType_,
       sortColumnIndices,
       sortCompareFlags,
@@ -69,6 +79,13 @@ OrderBy::OrderBy(
       driverCtx->prefixSortConfig(),
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
       spillStats_.get());
+  const auto minExtractionRows =
+      driverCtx->queryConfig().parallelOutputExtractionMinRows();
+  auto* executor = operatorCtx_->task()->queryCtx()->executor();
+  if (minExtractionRows > 0 && executor != nullptr &&
+      !sortBuffer_->canSpill()) {
+    sortBuffer_->setParallelOutputExtraction(executor, minExtractionRows);
+  }
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
@@ -90,16 +107,136 @@ void OrderBy::reclaim(
   pool()->release();
 }
 
+// static
+bool OrderBy::parallelMergeEnabled(
+    const core::OrderByNode& orderByNode,
+    const core::QueryConfig& queryConfig) {
+  return orderByNode.isPartial() &&
+      queryConfig.orderByParallelMergeEnabled() &&
+      !orderByNode.canSpill(queryConfig);
+}
+
 void OrderBy::noMoreInput() {
   Operator::noMoreInput();
   sortBuffer_->noMoreInput();
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
+  if (parallelMerge_ &&
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver()) > 1) {
+    finishParallelSort();
+  } else {
+    runsMerged_ = true;
+  }
+}
+
+void OrderBy::finishParallelSort() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last driver to finish its input splits the sorted rows of all drivers
+  // into key ranges. The other drivers wait for it.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  SCOPE_EXIT {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  };
+
+  // The drivers by partition id, which is the index of their key range.
+  std::vector<OrderBy*> orderBys(peers.size() + 1);
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    const auto partitionId = orderBy->operatorCtx_->driverCtx()->partitionId;
+    VELOX_CHECK_LT(partitionId, orderBys.size());
+    VELOX_CHECK_NULL(orderBys[partitionId]);
+    orderBys[partitionId] = orderBy;
+  }
+  const auto partitionId = operatorCtx_->driverCtx()->partitionId;
+  VELOX_CHECK_LT(partitionId, orderBys.size());
+  VELOX_CHECK_NULL(orderBys[partitionId]);
+  orderBys[partitionId] = this;
+
+  auto sortedRuns = std::make_shared<SortedRuns>();
+  for (auto* orderBy : orderBys) {
+    sortedRuns->sortBuffers.push_back(orderBy->sortBuffer_);
+    sortedRuns->runs.push_back(orderBy->sortBuffer_->takeSortedRows());
+  }
+  const auto numRanges = orderBys.size();
+  const auto splitters = sampleSplitters(sortedRuns->runs, numRanges);
+  const auto less = [&](const char* left, const char* right) {
+    return sortBuffer_->compareRows(left, right) < 0;
+  };
+  for (const auto& run : sortedRuns->runs) {
+    // Rows equal to a splitter go to the range that starts at the splitter.
+    char* const* rangeStart = run.data();
+    char* const* runEnd = run.data() + run.size();
+    for (auto i = 0; i < numRanges; ++i) {
+      char* const* rangeEnd = i < splitters.size()
+          ? std::lower_bound(rangeStart, runEnd, splitters[i], less)
+          : runEnd;
+      orderBys[i]->mergeRuns_.emplace_back(rangeStart, rangeEnd);
+      rangeStart = rangeEnd;
+    }
+  }
+  for (auto* orderBy : orderBys) {
+    orderBy->sortedRuns_ = sortedRuns;
+  }
+}
+
+std::vector<char*> OrderBy::sampleSplitters(
+    const std::vector<std::vector<char*, memory::StlAllocator<char*>>>& runs,
+    int32_t numRanges) const {
+  size_t numRows = 0;
+  for (const auto& run : runs) {
+    numRows += run.size();
+  }
+  // Samples each run in proportion to its size.
+  const size_t step =
+      std::max<size_t>(1, numRows / (kSamplesPerRange * numRanges));
+  std::vector<char*> samples;
+  for (const auto& run : runs) {
+    for (auto i = step / 2; i < run.size(); i += step) {
+      samples.push_back(run[i]);
+    }
+  }
+  std::vector<char*> splitters;
+  if (samples.empty()) {
+    return splitters;
+  }
+  std::sort(
+      samples.begin(),
+      samples.end(),
+      [&](const char* left, const char* right) {
+        return sortBuffer_->compareRows(left, right) < 0;
+      });
+  splitters.reserve(numRanges - 1);
+  for (auto i = 1; i < numRanges; ++i) {
+    splitters.push_back(samples[samples.size() * i / numRanges]);
+  }
+  return splitters;
+}
+
+BlockingReason OrderBy::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForProducer;
+  }
+  return BlockingReason::kNotBlocked;
 }
 
 RowVectorPtr OrderBy::getOutput() {
-  if (finished_ || !noMoreInput_) {
+  if (finished_ || !noMoreInput_ || future_.valid()) {
     return nullptr;
   }
+  if (!runsMerged_) {
+    sortBuffer_->mergeSortedRuns(mergeRuns_);
+    mergeRuns_.clear();
+    runsMerged_ = true;
+  }
 
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputRows_);
   finished_ = (output == nullptr);
@@ -108,6 +245,8 @@ RowVectorPtr OrderBy::getOutput() {
 
 void OrderBy::close() {
   Operator::close();
+  mergeRuns_.clear();
+  sortedRuns_.reset();
   sortBuffer_.reset();
 }
 } // namespace facebook::velox::exec
@@ -48,9 +48,7 @@ class OrderBy : public Operator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
     return finished_;
@@ -61,8 +59,45 @@ class OrderBy : public Operator {
 
   void close() override;
 
+  /// Returns true if the drivers of 'orderByNode' merge their sorted rows in
+  /// parallel. Each driver then outputs one key range of the rows of all
+  /// drivers and the ranges ascend with the partition id of the driver, so
+  /// that the outputs of the drivers concatenated in that order are sorted.
+  static bool parallelMergeEnabled(
+      const core::OrderByNode& orderByNode,
+      const core::QueryConfig& queryConfig);
+
  private:
-  std::unique_ptr<SortBuffer> sortBuffer_;
+  // The sorted rows of all drivers of a parallel merge, kept alive until the
+  // last driver closes.
+  struct SortedRuns {
+    std::vector<std::shared_ptr<SortBuffer>> sortBuffers;
+    std::vector<std::vector<char*, memory::StlAllocator<char*>>> runs;
+  };
+
+  // Waits for the peer drivers to sort their input. The last driver splits
+  // the sorted rows of all drivers into key ranges by sampled splitter keys
+  // and gives each driver its range of each run.
+  void finishParallelSort();
+
+  // Samples the keys of 'runs' and returns 'numRanges' - 1 splitter rows in
+  // ascending order.
+  std::vector<char*> sampleSplitters(
+      const std::vector<std::vector<char*, memory::StlAllocator<char*>>>&
+          runs,
+      int32_t numRanges) const;
+
+  bool parallelMerge_;
+  std::shared_ptr<SortBuffer> sortBuffer_;
+  // Set by the last driver to finish its input in a parallel merge.
+  // 'mergeRuns_' are the slices of 'sortedRuns_' in the key range of this
+  // driver, which it merges into 'sortBuffer_' before producing output.
+  std::shared_ptr<const SortedRuns> sortedRuns_;
+  std::vector<folly::Range<char* const*>> mergeRuns_;
+  // True after 'mergeRuns_' has been merged into 'sortBuffer_'.
+  bool runsMerged_{false};
+  // Set while waiting for the peer drivers to sort their input.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
   bool finished_ = false;
   vector_size_t maxOutputRows_;
 };
@@ -14,14 +14,128 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/exec/Task.h"
+#include "velox/serializers/SerializedPageFile.h"
 
 namespace facebook::velox::exec {
 
 using core::PartitionedOutputNode;
 
+/// The file an OutputBuffer writes pages to when it is full. Pages are
+/// appended under the OutputBuffer mutex and read back by the consumers
+/// through separate file handles. The file is deleted on destruction.
+class OutputBufferSpillFile {
+ public:
+  explicit OutputBufferSpillFile(const std::string& pathPrefix)
+      : file_(serializer::SerializedPageFile::create(
+            0, pathPrefix, /*fileCreateConfig=*/"", /*ioStats=*/nullptr)),
+        path_(file_->path()) {}
+
+  ~OutputBufferSpillFile() {
+    try {
+      file_->finish();
+      filesystems::getFileSystem(path_, nullptr)->remove(path_);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to remove output buffer spill file " << path_
+                   << ": " << e.what();
+    }
+  }
+
+  /// Appends 'iobuf' and returns its offset in the file.
+  uint64_t append(std::unique_ptr<folly::IOBuf> iobuf) {
+    const auto offset = file_->size();
+    file_->write(std::move(iobuf));
+    file_->file()->flush();
+    return offset;
+  }
+
+  /// Reads 'size' bytes at 'offset'. Thread safe.
+  std::unique_ptr<folly::IOBuf> read(uint64_t offset, uint64_t size) const {
+    auto readFile =
+        filesystems::getFileSystem(path_, nullptr)->openFileForRead(path_);
+    auto iobuf = folly::IOBuf::create(size);
+    readFile->pread(offset, size, iobuf->writableData());
+    iobuf->append(size);
+    return iobuf;
+  }
+
+ private:
+  const std::unique_ptr<serializer::SerializedPageFile> file_;
+  const std::string path_;
+};
+
+namespace {
+// A page in an OutputBufferSpillFile. The data is read back from the file each
+// time the page is fetched, so the page takes no memory while buffered.
+class SpilledPage : public SerializedPageBase {
+ public:
+  SpilledPage(
+      std::shared_ptr<OutputBufferSpillFile> file,
+      uint64_t offset,
+      uint64_t size,
+      std::optional<int64_t> numRows)
+      : file_(std::move(file)),
+        offset_(offset),
+        size_(size),
+        numRows_(numRows) {}
+
+  uint64_t size() const override {
+    return size_;
+  }
+
+  std::optional<int64_t> numRows() const override {
+    return numRows_;
+  }
+
+  std::unique_ptr<ByteInputStream> prepareStreamForDeserialize() override {
+    loaded_ = std::make_unique<PrestoSerializedPage>(getIOBuf());
+    return loaded_->prepareStreamForDeserialize();
+  }
+
+  std::unique_ptr<folly::IOBuf> getIOBuf() const override {
+    return file_->read(offset_, size_);
+  }
+
+ private:
+  const std::shared_ptr<OutputBufferSpillFile> file_;
+  const uint64_t offset_;
+  const uint64_t size_;
+  const std::optional<int64_t> numRows_;
+
+  // Holds the data read by prepareStreamForDeserialize().
+  std::unique_ptr<PrestoSerializedPage> loaded_;
+};
+
+bool isSpilled(const SerializedPageBase& page) {
+  return dynamic_cast<const SpilledPage*>(&page) != nullptr;
+}
+std::vector<std::unique_ptr<folly::IOBuf>> toIOBufs(
+    const std::vector<std::shared_ptr<SerializedPageBase>>& pages) {
+  std::vector<std::unique_ptr<folly::IOBuf>> iobufs;
+  iobufs.reserve(pages.size());
+  for (const auto& page : pages) {
+    // nullptr is used as end marker
+    iobufs.push_back(page == nullptr ? nullptr : page->getIOBuf());
+  }
+  return iobufs;
+}
+
+PagesAvailableCallback toPagesCallback(DataAvailableCallback notify) {
+  if (notify == nullptr) {
+    return nullptr;
+  }
+  return [notify = std::move(notify)](
+             std::vector<std::shared_ptr<SerializedPageBase>> pages,
+             int64_t sequence,
+             std::vector<int64_t> remainingBytes) {
+    notify(toIOBufs(pages), sequence, std::move(remainingBytes));
+  };
+}
+} // namespace
+
 void ArbitraryBuffer::noMoreData() {
   // Drop duplicate end markers.
   if (!pages_.empty() && pages_.back() == nullptr) {
@@ -115,6 +229,22 @@ DestinationBuffer::Data DestinationBuffer::getData(
     DataAvailableCallback notify,
     DataConsumerActiveCheckCallback activeCheck,
     ArbitraryBuffer* arbitraryBuffer) {
+  auto pages = getPages(
+      maxBytes,
+      sequence,
+      toPagesCallback(std::move(notify)),
+      std::move(activeCheck),
+      arbitraryBuffer);
+  return {
+      toIOBufs(pages.pages), std::move(pages.remainingBytes), pages.immediate};
+}
+
+DestinationBuffer::Pages DestinationBuffer::getPages(
+    uint64_t maxBytes,
+    int64_t sequence,
+    PagesAvailableCallback notify,
+    DataConsumerActiveCheckCallback activeCheck,
+    ArbitraryBuffer* arbitraryBuffer) {
   VELOX_CHECK_GE(
       sequence, sequence_, "Get received for an already acknowledged item");
   if (arbitraryBuffer != nullptr) {
@@ -147,7 +277,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
     return {};
   }
 
-  std::vector<std::unique_ptr<folly::IOBuf>> data;
+  std::vector<std::shared_ptr<SerializedPageBase>> data;
   uint64_t resultBytes = 0;
   auto i = sequence - sequence_;
   if (maxBytes > 0) {
@@ -158,7 +288,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
         data.push_back(nullptr);
         break;
       }
-      data.push_back(data_[i]->getIOBuf());
+      data.push_back(data_[i]);
       resultBytes += data_[i]->size();
       if (resultBytes >= maxBytes) {
         ++i;
@@ -206,8 +336,8 @@ DataAvailable DestinationBuffer::getAndClearNotify() {
   DataAvailable result;
   result.callback = notify_;
   result.sequence = notifySequence_;
-  auto data = getData(notifyMaxBytes_, notifySequence_, nullptr, nullptr);
-  result.data = std::move(data.data);
+  auto data = getPages(notifyMaxBytes_, notifySequence_, nullptr, nullptr);
+  result.data = std::move(data.pages);
   result.remainingBytes = std::move(data.remainingBytes);
   clearNotify();
   return result;
@@ -334,6 +464,11 @@ OutputBuffer::OutputBuffer(
       kind_(kind),
       maxSize_(task_->queryCtx()->queryConfig().maxOutputBufferSize()),
       continueSize_((maxSize_ * kContinuePct) / 100),
+      spillEnabled_(
+          isPartitioned() &&
+          task_->queryCtx()->queryConfig().outputBufferSpillEnabled() &&
+          (!task_->spillDirectory().empty() ||
+           task_->hasCreateSpillDirectoryCb())),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
       numDrivers_(numDrivers) {
@@ -412,11 +547,14 @@ void OutputBuffer::addOutputBuffersLocked(int numBuffers) {
 
 void OutputBuffer::updateStatsWithEnqueuedPageLocked(
     int64_t pageBytes,
-    int64_t pageRows) {
+    int64_t pageRows,
+    bool spilled) {
   updateTotalBufferedBytesMsLocked();
 
-  bufferedBytes_ += pageBytes;
-  ++bufferedPages_;
+  if (!spilled) {
+    bufferedBytes_ += pageBytes;
+    ++bufferedPages_;
+  }
 
   ++numOutputPages_;
   numOutputRows_ += pageRows;
@@ -457,7 +595,12 @@ bool OutputBuffer::enqueue(
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK_LT(destination, buffers_.size());
 
-    updateStatsWithEnqueuedPageLocked(data->size(), data->numRows().value());
+    const bool spilled = shouldSpillLocked(destination, *data);
+    if (spilled) {
+      data = spillLocked(std::move(data));
+    }
+    updateStatsWithEnqueuedPageLocked(
+        data->size(), data->numRows().value(), spilled);
 
     switch (kind_) {
       case PartitionedOutputNode::Kind::kBroadcast:
@@ -560,6 +703,30 @@ void OutputBuffer::enqueuePartitionedOutputLocked(
   }
 }
 
+bool OutputBuffer::shouldSpillLocked(
+    int destination,
+    const SerializedPageBase& data) const {
+  // VectorPages reference the producer's memory and can not be written out.
+  // Pages for deleted destinations are dropped, not spilled.
+  return spillEnabled_ && data.vector() == nullptr &&
+      buffers_[destination] != nullptr &&
+      bufferedBytes_ + data.size() > maxSize_;
+}
+
+std::unique_ptr<SerializedPageBase> OutputBuffer::spillLocked(
+    std::unique_ptr<SerializedPageBase> data) {
+  if (spillFile_ == nullptr) {
+    spillFile_ = std::make_shared<OutputBufferSpillFile>(
+        fmt::format("{}/output_buffer", task_->getOrCreateSpillDirectory()));
+  }
+  const auto size = data->size();
+  const auto offset = spillFile_->append(data->getIOBuf());
+  spilledBytes_ += size;
+  ++spilledPages_;
+  return std::make_unique<SpilledPage>(
+      spillFile_, offset, size, data->numRows());
+}
+
 void OutputBuffer::noMoreData() {
   // Increment number of finished drivers.
   checkIfDone(true);
@@ -655,7 +822,7 @@ void OutputBuffer::updateAfterAcknowledgeLocked(
   uint64_t freedBytes{0};
   int freedPages{0};
   for (const auto& free : freed) {
-    if (free.use_count() == 1) {
+    if (free.use_count() == 1 && !isSpilled(*free)) {
       ++freedPages;
       freedBytes += free->size();
     }
@@ -717,7 +884,21 @@ void OutputBuffer::getData(
     int64_t sequence,
     DataAvailableCallback notify,
     DataConsumerActiveCheckCallback activeCheck) {
-  DestinationBuffer::Data data;
+  getPages(
+      destination,
+      maxBytes,
+      sequence,
+      toPagesCallback(std::move(notify)),
+      std::move(activeCheck));
+}
+
+void OutputBuffer::getPages(
+    int destination,
+    uint64_t maxBytes,
+    int64_t sequence,
+    PagesAvailableCallback notify,
+    DataConsumerActiveCheckCallback activeCheck) {
+  DestinationBuffer::Pages data;
   std::vector<std::shared_ptr<SerializedPageBase>> freed;
   std::vector<ContinuePromise> promises;
   {
@@ -732,10 +913,10 @@ void OutputBuffer::getData(
     if (buffer) {
       freed = buffer->acknowledge(sequence, true);
       updateAfterAcknowledgeLocked(freed, promises);
-      data = buffer->getData(
+      data = buffer->getPages(
           maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
     } else {
-      data.data.emplace_back(nullptr);
+      data.pages.emplace_back(nullptr);
       data.immediate = true;
       VLOG(1) << "getData received after deleteResults for destination "
               << destination << " and sequence " << sequence;
@@ -743,7 +924,7 @@ void OutputBuffer::getData(
   }
   releaseAfterAcknowledge(freed, promises);
   if (data.immediate) {
-    notify(std::move(data.data), sequence, std::move(data.remainingBytes));
+    notify(std::move(data.pages), sequence, std::move(data.remainingBytes));
   }
 }
 
@@ -768,7 +949,8 @@ std::string OutputBuffer::toString() {
 std::string OutputBuffer::toStringLocked() const {
   std::stringstream out;
   out << "[OutputBuffer[" << kind_ << "] bufferedBytes_=" << bufferedBytes_
-      << "b, num producers blocked=" << promises_.size()
+      << "b, spilled=" << spilledBytes_ << "b/" << spilledPages_
+      << " pages, num producers blocked=" << promises_.size()
       << ", completed=" << numFinished_ << "/" << numDrivers_ << ", "
       << (atEnd_ ? "at end, " : "") << "destinations: " << std::endl;
   for (auto i = 0; i < buffers_.size(); ++i) {
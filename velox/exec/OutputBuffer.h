@@ -29,6 +29,14 @@ using DataAvailableCallback = std::function<void(
     int64_t sequence,
     std::vector<int64_t> remainingBytes)>;
 
+/// Same as DataAvailableCallback but with the pages instead of their IOBufs.
+/// Used by consumers in the same process as the producer. These can also
+/// receive VectorPages, which have no IOBuf.
+using PagesAvailableCallback = std::function<void(
+    std::vector<std::shared_ptr<SerializedPageBase>> pages,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes)>;
+
 /// Callback provided to indicate if the consumer of a destination buffer is
 /// currently active or not. It is used by arbitrary output buffer to optimize
 /// the http based streaming shuffle in Prestissimo. For instance, the arbitrary
@@ -40,9 +48,9 @@ using DataAvailableCallback = std::function<void(
 using DataConsumerActiveCheckCallback = std::function<bool()>;
 
 struct DataAvailable {
-  DataAvailableCallback callback{nullptr};
+  PagesAvailableCallback callback{nullptr};
   int64_t sequence{0};
-  std::vector<std::unique_ptr<folly::IOBuf>> data;
+  std::vector<std::shared_ptr<SerializedPageBase>> data;
   std::vector<int64_t> remainingBytes;
 
   void notify() {
@@ -161,6 +169,27 @@ class DestinationBuffer {
       DataConsumerActiveCheckCallback activeCheck,
       ArbitraryBuffer* arbitraryBuffer = nullptr);
 
+  struct Pages {
+    /// The pages available at this buffer. nullptr marks the end of data.
+    std::vector<std::shared_ptr<SerializedPageBase>> pages;
+
+    /// The byte sizes of pages that can be fetched.
+    std::vector<int64_t> remainingBytes;
+
+    /// Whether the result is returned immediately without invoking the `notify'
+    /// callback.
+    bool immediate{false};
+  };
+
+  /// Same as getData() but returns the pages instead of clones of their
+  /// IOBufs.
+  Pages getPages(
+      uint64_t maxBytes,
+      int64_t sequence,
+      PagesAvailableCallback notify,
+      DataConsumerActiveCheckCallback activeCheck,
+      ArbitraryBuffer* arbitraryBuffer = nullptr);
+
   /// Removes data from the queue and returns removed data. If 'fromGetData' we
   /// do not give a warning for the case where no data is removed, otherwise we
   /// expect that data does get freed. We cannot assert that data gets deleted
@@ -190,7 +219,7 @@ class DestinationBuffer {
   std::vector<std::shared_ptr<SerializedPageBase>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
-  DataAvailableCallback notify_{nullptr};
+  PagesAvailableCallback notify_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
   // The sequence number of the first item to pass to 'notify'.
   int64_t notifySequence_{0};
@@ -199,6 +228,7 @@ class DestinationBuffer {
 };
 
 class Task;
+class OutputBufferSpillFile;
 
 class OutputBuffer {
  public:
@@ -306,6 +336,15 @@ class OutputBuffer {
       DataAvailableCallback notify,
       DataConsumerActiveCheckCallback activeCheck);
 
+  /// Same as getData() but 'notify' receives the pages instead of clones of
+  /// their IOBufs.
+  void getPages(
+      int destination,
+      uint64_t maxSize,
+      int64_t sequence,
+      PagesAvailableCallback notify,
+      DataConsumerActiveCheckCallback activeCheck);
+
   /// Continues any possibly waiting producers. Called when the producer task
   /// has an error or cancellation.
   void terminate();
@@ -329,7 +368,12 @@ class OutputBuffer {
   // be unblocked.
   static constexpr int32_t kContinuePct = 90;
 
-  void updateStatsWithEnqueuedPageLocked(int64_t pageBytes, int64_t pageRows);
+  // 'spilled' is true if the page is in a spill file and does not count
+  // towards 'bufferedBytes_'.
+  void updateStatsWithEnqueuedPageLocked(
+      int64_t pageBytes,
+      int64_t pageRows,
+      bool spilled);
 
   void updateStatsWithFreedPagesLocked(int numPages, int64_t pageBytes);
 
@@ -365,6 +409,15 @@ class OutputBuffer {
       std::unique_ptr<SerializedPageBase> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
+  // Returns true if 'data' for 'destination' should go to the spill file
+  // instead of memory because the buffer is full.
+  bool shouldSpillLocked(int destination, const SerializedPageBase& data)
+      const;
+
+  // Writes 'data' to 'spillFile_' and returns the page that reads it back.
+  std::unique_ptr<SerializedPageBase> spillLocked(
+      std::unique_ptr<SerializedPageBase> data);
+
   std::string toStringLocked() const;
 
   FOLLY_ALWAYS_INLINE bool isBroadcast() const {
@@ -387,6 +440,9 @@ class OutputBuffer {
   // When 'bufferedBytes_' goes below 'continueSize_', blocked producers are
   // resumed.
   const uint64_t continueSize_;
+  // If true, pages beyond 'maxSize_' go to 'spillFile_' instead of blocking
+  // the producers. Only set for partitioned output with a spill directory.
+  const bool spillEnabled_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
 
   // Total number of drivers expected to produce results. This number will
@@ -404,8 +460,14 @@ class OutputBuffer {
   std::vector<std::shared_ptr<SerializedPageBase>> dataToBroadcast_;
 
   std::mutex mutex_;
-  // Actual data size in 'buffers_'.
+  // Actual data size in 'buffers_', not counting spilled pages.
   int64_t bufferedBytes_{0};
+  // Created on first spill. Spilled pages hold a reference, so the file is
+  // deleted when both 'this' and the pages are gone.
+  std::shared_ptr<OutputBufferSpillFile> spillFile_;
+  // The total number of bytes and pages written to 'spillFile_'.
+  uint64_t spilledBytes_{0};
+  uint64_t spilledPages_{0};
   // The number of buffered pages which corresponds to 'bufferedBytes_'.
   int64_t bufferedPages_{0};
   // The total number of output bytes, rows and pages.
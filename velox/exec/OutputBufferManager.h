@@ -92,6 +92,18 @@ class OutputBufferManager {
       DataAvailableCallback notify,
       DataConsumerActiveCheckCallback activeCheck = nullptr);
 
+  /// Same as getData() but 'notify' receives the pages instead of clones of
+  /// their IOBufs. This is for consumers in the same process as the producer
+  /// and supports VectorPages. The consumer must not modify the pages, which
+  /// stay in the buffer until acknowledged.
+  bool getPages(
+      const std::string& taskId,
+      int destination,
+      uint64_t maxBytes,
+      int64_t sequence,
+      PagesAvailableCallback notify,
+      DataConsumerActiveCheckCallback activeCheck = nullptr);
+
   void removeTask(const std::string& taskId);
 
   static const std::shared_ptr<OutputBufferManager>& getInstanceRef();
@@ -15,10 +15,12 @@
  */
 
 #include "velox/exec/ParallelProject.h"
+#include <folly/container/F14Map.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorType.h"
 #include "velox/exec/Task.h"
+#include "velox/expression/ExprConstants.h"
 
 namespace facebook::velox::exec {
 
@@ -53,6 +55,79 @@ bool checkAddIdentityProjection(
 
   return false;
 }
+
+using ExprIndexMap = folly::F14FastMap<
+    const core::ITypedExpr*,
+    int32_t,
+    core::ITypedExprHasher,
+    core::ITypedExprComparer>;
+
+// Returns true if the inputs of 'expr' are evaluated for all the rows 'expr'
+// is evaluated for and errors in them are not suppressed.
+bool evaluatesAllInputs(const core::ITypedExpr& expr) {
+  if (expr.isCastKind()) {
+    return !static_cast<const core::CastTypedExpr&>(expr).isTryCast();
+  }
+  if (!expr.isCallKind()) {
+    return false;
+  }
+  const auto& name = static_cast<const core::CallTypedExpr&>(expr).name();
+  return name != expression::kIf && name != expression::kSwitch &&
+      name != expression::kAnd && name != expression::kOr &&
+      name != expression::kCoalesce && name != expression::kTry &&
+      name != expression::kTryCast;
+}
+
+// Adds the call and cast subtrees of 'expr' that are evaluated whenever 'expr'
+// is evaluated to 'subexprs'. Stops at lambdas, conditionals and try.
+void collectSubexprs(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& subexprs) {
+  if (!expr->isCallKind() && !expr->isCastKind()) {
+    return;
+  }
+  subexprs.push_back(expr);
+  if (evaluatesAllInputs(*expr)) {
+    for (const auto& input : expr->inputs()) {
+      collectSubexprs(input, subexprs);
+    }
+  }
+}
+
+// Returns 'expr' with the outermost subtrees found in 'shared' replaced by
+// field accesses to 'names'. Sets 'used' for the replaced ones.
+core::TypedExprPtr replaceShared(
+    const core::TypedExprPtr& expr,
+    const ExprIndexMap& shared,
+    const std::vector<std::string>& names,
+    std::vector<bool>& used) {
+  auto it = shared.find(expr.get());
+  if (it != shared.end()) {
+    used[it->second] = true;
+    return std::make_shared<core::FieldAccessTypedExpr>(
+        expr->type(), names[it->second]);
+  }
+  if (!evaluatesAllInputs(*expr)) {
+    return expr;
+  }
+  bool changed = false;
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(replaceShared(input, shared, names, used));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+  if (expr->isCastKind()) {
+    return std::make_shared<core::CastTypedExpr>(expr->type(), inputs, false);
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      expr->type(),
+      std::move(inputs),
+      static_cast<const core::CallTypedExpr&>(*expr).name());
+}
 } // namespace
 
 void ParallelProject::initialize() {
@@ -69,6 +144,7 @@ void ParallelProject::initialize() {
   work_.back().execCtx = std::make_unique<core::ExecCtx>(
       operatorCtx_->pool(), operatorCtx_->driverCtx()->task->queryCtx().get());
 
+  std::vector<std::vector<core::TypedExprPtr>> groupExprs;
   std::vector<core::TypedExprPtr> unitExprs;
   for (column_index_t i = 0; i < node_->exprNames().size(); i++) {
     const auto& projection = exprGroups[unitIdx][exprIdx];
@@ -82,11 +158,8 @@ void ParallelProject::initialize() {
     }
     ++exprIdx;
     if (exprIdx == unitSize) {
-      // It may be that the only work is loading lazies.
-      auto tempExprs =
-          makeExprSetFromFlag(std::move(unitExprs), operatorCtx_->execCtx());
-      std::shared_ptr<ExprSet> shared(tempExprs.release());
-      work_.back().exprSet = std::move(shared);
+      groupExprs.push_back(std::move(unitExprs));
+      unitExprs.clear();
       ++unitIdx;
       exprIdx = 0;
       if (unitIdx == exprGroups.size()) {
@@ -100,6 +173,24 @@ void ParallelProject::initialize() {
     }
   }
 
+  const auto unsharedExprs = groupExprs;
+  const bool hasShared =
+      groupExprs.size() > 1 &&
+      operatorCtx_->execCtx()
+          ->optimizationParams()
+          .sharedSubExpressionReuseEnabled &&
+      shareSubexprs(inputType, groupExprs);
+  for (auto i = 0; i < work_.size(); ++i) {
+    // It may be that the only work is loading lazies.
+    work_[i].exprSet =
+        makeExprSetFromFlag(std::move(groupExprs[i]), operatorCtx_->execCtx());
+    if (hasShared) {
+      work_[i].unsharedExprSet = makeExprSetFromFlag(
+          std::vector<core::TypedExprPtr>(unsharedExprs[i]),
+          operatorCtx_->execCtx());
+    }
+  }
+
   int32_t outputIdx = node_->exprNames().size();
   auto sourceType = node_->sources()[0]->outputType();
   for (auto& name : node_->noLoadIdentities()) {
@@ -108,6 +199,73 @@ void ParallelProject::initialize() {
   }
 }
 
+bool ParallelProject::shareSubexprs(
+    const RowTypePtr& inputType,
+    std::vector<std::vector<core::TypedExprPtr>>& groupExprs) {
+  // Maps each subexpression to the first group that has it and to -1 once a
+  // second group has it.
+  ExprIndexMap firstGroup;
+  std::vector<core::TypedExprPtr> candidates;
+  for (auto group = 0; group < groupExprs.size(); ++group) {
+    std::vector<core::TypedExprPtr> subexprs;
+    for (const auto& expr : groupExprs[group]) {
+      collectSubexprs(expr, subexprs);
+    }
+    for (const auto& subexpr : subexprs) {
+      auto [it, inserted] = firstGroup.try_emplace(subexpr.get(), group);
+      if (!inserted && it->second != group && it->second != -1) {
+        it->second = -1;
+        candidates.push_back(subexpr);
+      }
+    }
+  }
+  if (candidates.empty()) {
+    return false;
+  }
+
+  // Non-deterministic subexpressions must be evaluated once per occurrence.
+  auto compiled = makeExprSetFromFlag(
+      std::vector<core::TypedExprPtr>(candidates), operatorCtx_->execCtx());
+  ExprIndexMap shared;
+  std::vector<core::TypedExprPtr> sharedExprs;
+  std::vector<std::string> names;
+  for (auto i = 0; i < candidates.size(); ++i) {
+    if (compiled->expr(i)->isDeterministic()) {
+      shared.emplace(candidates[i].get(), sharedExprs.size());
+      sharedExprs.push_back(candidates[i]);
+      names.push_back(fmt::format("__shared_{}", names.size()));
+      VELOX_CHECK(!inputType->containsChild(names.back()));
+    }
+  }
+  compiled.reset();
+  if (names.empty()) {
+    return false;
+  }
+
+  std::vector<bool> used(names.size(), false);
+  for (auto& exprs : groupExprs) {
+    for (auto& expr : exprs) {
+      expr = replaceShared(expr, shared, names, used);
+    }
+  }
+
+  // A candidate that only occurs inside other candidates is not referenced.
+  auto sharedNames = inputType->names();
+  auto sharedTypes = inputType->children();
+  std::vector<core::TypedExprPtr> usedExprs;
+  for (auto i = 0; i < names.size(); ++i) {
+    if (used[i]) {
+      usedExprs.push_back(sharedExprs[i]);
+      sharedNames.push_back(names[i]);
+      sharedTypes.push_back(sharedExprs[i]->type());
+    }
+  }
+  sharedInputType_ = ROW(std::move(sharedNames), std::move(sharedTypes));
+  sharedExprs_ =
+      makeExprSetFromFlag(std::move(usedExprs), operatorCtx_->execCtx());
+  return true;
+}
+
 void ParallelProject::addInput(RowVectorPtr input) {
   input_ = std::move(input);
   numProcessedInputRows_ = 0;
@@ -139,10 +297,17 @@ RowVectorPtr ParallelProject::getOutput() {
   std::vector<std::shared_ptr<AsyncSource<WorkResult>>> pending;
   std::vector<VectorPtr> results(outputType_->size());
 
+  RowVectorPtr sharedInput;
+  if (sharedExprs_) {
+    sharedInput = evaluateShared();
+  }
+  const auto& input = sharedInput ? sharedInput : input_;
   for (auto i = 0; i < work_.size(); ++i) {
     pending.push_back(
         std::make_shared<AsyncSource<WorkResult>>(
-            [i, &results, this]() { return doWork(i, results); }));
+            [i, &input, &results, this]() {
+              return doWork(i, input, results);
+            }));
     auto item = pending.back();
     operatorCtx_->task()->queryCtx()->executor()->add(
         [item]() { item->prepare(); });
@@ -169,19 +334,46 @@ RowVectorPtr ParallelProject::getOutput() {
       operatorCtx_->pool(), outputType_, nullptr, size, std::move(results));
 }
 
+RowVectorPtr ParallelProject::evaluateShared() {
+  EvalCtx evalCtx(operatorCtx_->execCtx(), sharedExprs_.get(), input_.get());
+  std::vector<VectorPtr> sharedResults;
+  try {
+    sharedExprs_->eval(allRows_, evalCtx, sharedResults);
+  } catch (const VeloxException&) {
+    // An error may be one that the groups would not raise, e.g. in a row for
+    // which another argument of the enclosing call is null.
+    return nullptr;
+  }
+  auto children = input_->children();
+  for (auto& result : sharedResults) {
+    children.push_back(std::move(result));
+  }
+  return std::make_shared<RowVector>(
+      operatorCtx_->pool(),
+      sharedInputType_,
+      nullptr,
+      input_->size(),
+      std::move(children));
+}
+
 std::unique_ptr<ParallelProject::WorkResult> ParallelProject::doWork(
     int32_t workIdx,
+    const RowVectorPtr& input,
     std::vector<VectorPtr>& results) {
   auto& work = work_[workIdx];
-  EvalCtx evalCtx(work.execCtx.get(), work.exprSet.get(), input_.get());
+  // 'input' is 'input_' itself if evaluating 'sharedExprs_' failed.
+  auto* exprSet = sharedExprs_ && input == input_
+      ? work.unsharedExprSet.get()
+      : work.exprSet.get();
+  EvalCtx evalCtx(work.execCtx.get(), exprSet, input.get());
   try {
     for (auto channel : work.loadOnly) {
       evalCtx.ensureFieldLoaded(channel, allRows_);
     }
 
     std::vector<VectorPtr> localResults;
-    work.exprSet->eval(
-        0, work.exprSet->exprs().size(), true, allRows_, evalCtx, localResults);
+    exprSet->eval(
+        0, exprSet->exprs().size(), true, allRows_, evalCtx, localResults);
     for (auto& projection : work.resultProjections) {
       results[projection.outputChannel] =
           std::move(localResults[projection.inputChannel]);
@@ -57,6 +57,12 @@ class ParallelProject : public Operator {
       if (work.exprSet) {
         work.exprSet->clear();
       }
+      if (work.unsharedExprSet) {
+        work.unsharedExprSet->clear();
+      }
+    }
+    if (sharedExprs_) {
+      sharedExprs_->clear();
     }
   }
 
@@ -70,6 +76,11 @@ class ParallelProject : public Operator {
     std::vector<column_index_t> loadOnly;
     std::unique_ptr<core::ExecCtx> execCtx;
     std::shared_ptr<ExprSet> exprSet;
+    // The group's expressions before the subexpressions it shares with other
+    // groups were replaced by references to 'sharedExprs_' results. Set only
+    // if 'sharedExprs_' is set. Used for batches where evaluating
+    // 'sharedExprs_' fails.
+    std::shared_ptr<ExprSet> unsharedExprSet;
   };
 
   struct WorkResult {
@@ -82,8 +93,22 @@ class ParallelProject : public Operator {
   // should return nullptr.
   bool allInputProcessed();
 
+  // Finds the subexpressions that appear in more than one of 'groupExprs'
+  // and are evaluated on all rows. Sets 'sharedExprs_' to these and replaces
+  // them in 'groupExprs' by references to columns appended to the input.
+  // Returns true if anything was replaced.
+  bool shareSubexprs(
+      const RowTypePtr& inputType,
+      std::vector<std::vector<core::TypedExprPtr>>& groupExprs);
+
+  // Evaluates 'sharedExprs_' on 'input_' and returns 'input_' with the results
+  // appended. Returns nullptr if the evaluation fails, in which case the
+  // groups evaluate their unshared expressions.
+  RowVectorPtr evaluateShared();
+
   std::unique_ptr<WorkResult> doWork(
       int32_t workIdx,
+      const RowVectorPtr& input,
       std::vector<VectorPtr>& result);
 
   // Cached ParallelProject node for lazy initialization. After
@@ -93,6 +118,12 @@ class ParallelProject : public Operator {
   bool initialized_{false};
 
   std::vector<WorkUnit> work_;
+
+  // Subexpressions used by more than one group, evaluated once per batch
+  // before the groups run.
+  std::unique_ptr<ExprSet> sharedExprs_;
+  // Input type followed by the names and types of the 'sharedExprs_' results.
+  RowTypePtr sharedInputType_;
   SelectivityVector allRows_;
   int32_t numProcessedInputRows_{0};
 };
@@ -19,6 +19,7 @@
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -30,7 +31,8 @@ Destination::Destination(
     VectorSerde::Options* serdeOptions,
     memory::MemoryPool* pool,
     bool eagerFlush,
-    std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+    std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+    bool vectorPages)
     : taskId_(taskId),
       destination_(destination),
       serde_(serde),
@@ -38,6 +40,7 @@ Destination::Destination(
       pool_(pool),
       eagerFlush_(eagerFlush),
       recordEnqueued_(std::move(recordEnqueued)),
+      vectorPages_(vectorPages),
       rows_(raw_vector<vector_size_t>(pool)) {
   setTargetSizePct();
 }
@@ -59,26 +62,24 @@ BlockingReason Destination::advance(
     return BlockingReason::kNotBlocked;
   }
 
-  const auto firstRow = rowIdx_;
-  const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
-  if (bytesInCurrent_ >= adjustedMaxBytes) {
+  bool shouldFlush = false;
+  const auto rows = takeRows(maxBytes, sizes, shouldFlush);
+  if (rows.empty()) {
     return flush(bufferManager, bufferReleaseFn, future);
   }
 
-  // Collect rows to serialize.
-  bool shouldFlush = false;
-  while (rowIdx_ < rows_.size() && !shouldFlush) {
-    bytesInCurrent_ += sizes[rows_[rowIdx_]];
-    ++rowIdx_;
-    ++rowsInCurrent_;
-    shouldFlush =
-        bytesInCurrent_ >= adjustedMaxBytes || rowsInCurrent_ >= targetNumRows_;
+  if (vectorPages_) {
+    // The rows refer to 'output', so these can not wait for the next batch.
+    if (rowIdx_ == rows_.size()) {
+      *atEnd = true;
+    }
+    return enqueueVectorPage(
+        output, rows, bufferManager, bufferReleaseFn, future);
   }
 
   // Serialize
   createVectorStreamGroup(output);
 
-  const auto rows = folly::Range(&rows_[firstRow], rowIdx_ - firstRow);
   if (serde_->kind() == "CompactRow") {
     VELOX_CHECK_NOT_NULL(outputCompactRow);
     current_->append(*outputCompactRow, rows, sizes);
@@ -94,12 +95,82 @@ BlockingReason Destination::advance(
   if (rowIdx_ == rows_.size()) {
     *atEnd = true;
   }
+  return finishAppend(shouldFlush, bufferManager, bufferReleaseFn, future);
+}
+
+folly::Range<const vector_size_t*> Destination::takeRows(
+    uint64_t maxBytes,
+    const std::vector<vector_size_t>& sizes,
+    bool& shouldFlush) {
+  const auto firstRow = rowIdx_;
+  const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
+  shouldFlush = false;
+  if (bytesInCurrent_ >= adjustedMaxBytes) {
+    return {};
+  }
+  while (rowIdx_ < rows_.size() && !shouldFlush) {
+    bytesInCurrent_ += sizes[rows_[rowIdx_]];
+    ++rowIdx_;
+    ++rowsInCurrent_;
+    shouldFlush =
+        bytesInCurrent_ >= adjustedMaxBytes || rowsInCurrent_ >= targetNumRows_;
+  }
+  return folly::Range(rows_.data() + firstRow, rowIdx_ - firstRow);
+}
+
+BlockingReason Destination::finishAppend(
+    bool shouldFlush,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
   if (shouldFlush || (eagerFlush_ && rowsInCurrent_ > 0)) {
     return flush(bufferManager, bufferReleaseFn, future);
   }
   return BlockingReason::kNotBlocked;
 }
 
+BlockingReason Destination::enqueueVectorPage(
+    const RowVectorPtr& output,
+    folly::Range<const vector_size_t*> rows,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  const auto numRows = rows.size();
+  const auto& rowType = asRowType(output->type());
+  std::vector<VectorPtr> children;
+  children.reserve(output->childrenSize());
+  for (const auto& child : output->children()) {
+    children.push_back(BaseVector::loadedVectorShared(child));
+  }
+  RowVectorPtr page;
+  if (numRows == output->size()) {
+    // The rows are ascending and unique, so these are all rows.
+    page = std::make_shared<RowVector>(
+        output->pool(), rowType, nullptr, numRows, std::move(children));
+  } else {
+    auto indices = allocateIndices(numRows, pool_);
+    std::copy(
+        rows.begin(), rows.end(), indices->asMutable<vector_size_t>());
+    page = wrap(numRows, std::move(indices), rowType, children, pool_);
+  }
+
+  const auto bytes = bytesInCurrent_;
+  bytesInCurrent_ = 0;
+  rowsInCurrent_ = 0;
+  setTargetSizePct();
+
+  const bool blocked = bufferManager.enqueue(
+      taskId_,
+      destination_,
+      std::make_unique<VectorPage>(std::move(page), bytes, bufferReleaseFn),
+      future);
+
+  recordEnqueued_(bytes, numRows);
+
+  return blocked ? BlockingReason::kWaitForConsumer
+                 : BlockingReason::kNotBlocked;
+}
+
 void Destination::createVectorStreamGroup(const RowVectorPtr& output) {
   if (current_ == nullptr || needsStreamTreeRecreation_) {
     if (current_ == nullptr) {
@@ -233,7 +304,36 @@ PartitionedOutput::PartitionedOutput(
                                               ->queryConfig()
                                               .shuffleCompressionKind()),
           planNode->serdeKind(),
-          PartitionedOutput::minCompressionRatio())) {
+          PartitionedOutput::minCompressionRatio())),
+      vectorPages_(ctx->task->queryCtx()
+                       ->queryConfig()
+                       .partitionedOutputVectorPages()),
+      sortedRuns_(
+          numDestinations_ > 1 && !vectorPages_ &&
+          ctx->task->queryCtx()
+                  ->queryConfig()
+                  .partitionedOutputSortMinDestinations() > 0 &&
+          numDestinations_ >= ctx->task->queryCtx()
+                                  ->queryConfig()
+                                  .partitionedOutputSortMinDestinations()),
+      scatterSerialization_(
+          numDestinations_ > 1 && !vectorPages_ && !sortedRuns_ &&
+          serde_->kind() == "Presto" &&
+          ctx->task->queryCtx()
+              ->queryConfig()
+              .partitionedOutputScatterSerialization()) {
+  if (serde_->kind() == "Presto" &&
+      ctx->task->queryCtx()->queryConfig().shufflePreserveEncodings()) {
+    static_cast<serializer::presto::PrestoVectorSerde::PrestoOptions*>(
+        serdeOptions_.get())
+        ->encodeOnAppend = true;
+  }
+  if (serde_->kind() == "Presto" &&
+      ctx->task->queryCtx()->queryConfig().shuffleColumnCompression()) {
+    static_cast<serializer::presto::PrestoVectorSerde::PrestoOptions*>(
+        serdeOptions_.get())
+        ->columnCompression = true;
+  }
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -296,7 +396,8 @@ void PartitionedOutput::initializeDestinations() {
               [&](uint64_t bytes, uint64_t rows) {
                 auto lockedStats = stats_.wlock();
                 lockedStats->addOutputVector(bytes, rows);
-              }));
+              },
+              vectorPages_));
     }
   }
 }
@@ -335,6 +436,42 @@ void PartitionedOutput::estimateRowSizes() {
 }
 
 void PartitionedOutput::addInput(RowVectorPtr input) {
+  if (!sortedRuns_) {
+    partitionInput(std::move(input));
+    return;
+  }
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+  bufferedBytes_ += input->estimateFlatSize();
+  bufferedInputs_.push_back(std::move(input));
+}
+
+void PartitionedOutput::startSortedRun() {
+  VELOX_CHECK(!bufferedInputs_.empty());
+  RowVectorPtr input;
+  if (bufferedInputs_.size() == 1) {
+    input = std::move(bufferedInputs_[0]);
+  } else {
+    vector_size_t numRows = 0;
+    for (const auto& buffered : bufferedInputs_) {
+      numRows += buffered->size();
+    }
+    input = BaseVector::create<RowVector>(
+        bufferedInputs_[0]->type(), numRows, pool());
+    vector_size_t offset = 0;
+    for (const auto& buffered : bufferedInputs_) {
+      input->copy(buffered.get(), offset, 0, buffered->size());
+      offset += buffered->size();
+    }
+  }
+  bufferedInputs_.clear();
+  bufferedBytes_ = 0;
+  runDestination_ = 0;
+  partitionInput(std::move(input));
+}
+
+void PartitionedOutput::partitionInput(RowVectorPtr input) {
   initializeInput(std::move(input));
   initializeDestinations();
   initializeSizeBuffers();
@@ -343,6 +480,7 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
   for (auto& destination : destinations_) {
     destination->beginBatch();
   }
+  scatterPending_ = scatterSerialization_;
 
   auto numInput = input_->size();
   if (numDestinations_ == 1) {
@@ -417,11 +555,90 @@ void PartitionedOutput::collectNullRows() {
   nullRows_.updateBounds();
 }
 
+detail::Destination* PartitionedOutput::scatter(
+    uint64_t maxPageSize,
+    OutputBufferManager& bufferManager) {
+  scatterDestinations_.clear();
+  scatterGroups_.clear();
+  scatterRows_.clear();
+  scatterFlushes_.clear();
+  for (auto& destination : destinations_) {
+    bool shouldFlush = false;
+    const auto rows = destination->takeRows(maxPageSize, rowSize_, shouldFlush);
+    if (rows.empty()) {
+      continue;
+    }
+    scatterDestinations_.push_back(destination.get());
+    scatterGroups_.push_back(destination->streamGroup(output_));
+    scatterRows_.push_back(rows);
+    scatterFlushes_.push_back(shouldFlush);
+  }
+  VectorStreamGroup::scatter(output_, scatterGroups_, scatterRows_, scratch_);
+
+  // The pages are serialized already, so the destinations after a blocked one
+  // still flush their full pages but without waiting.
+  detail::Destination* blockedDestination = nullptr;
+  for (auto i = 0; i < scatterDestinations_.size(); ++i) {
+    const auto reason = scatterDestinations_[i]->finishAppend(
+        scatterFlushes_[i],
+        bufferManager,
+        bufferReleaseFn_,
+        blockedDestination == nullptr ? &future_ : nullptr);
+    if (reason != BlockingReason::kNotBlocked) {
+      blockingReason_ = reason;
+      blockedDestination = scatterDestinations_[i];
+    }
+  }
+  return blockedDestination;
+}
+
+detail::Destination* PartitionedOutput::advanceSortedRun(
+    uint64_t maxPageSize,
+    OutputBufferManager& bufferManager) {
+  for (; runDestination_ < numDestinations_; ++runDestination_) {
+    auto* destination = destinations_[runDestination_].get();
+    bool atEnd = false;
+    while (!atEnd) {
+      blockingReason_ = destination->advance(
+          maxPageSize,
+          rowSize_,
+          output_,
+          outputCompactRow_.get(),
+          outputUnsafeRow_.get(),
+          bufferManager,
+          bufferReleaseFn_,
+          &atEnd,
+          &future_,
+          scratch_);
+      if (blockingReason_ != BlockingReason::kNotBlocked) {
+        return destination;
+      }
+    }
+    // The rest of the run goes to other destinations, so the last page is
+    // flushed instead of waiting for the next run.
+    blockingReason_ =
+        destination->flush(bufferManager, bufferReleaseFn_, &future_);
+    if (blockingReason_ != BlockingReason::kNotBlocked) {
+      ++runDestination_;
+      return destination;
+    }
+  }
+  return nullptr;
+}
+
 RowVectorPtr PartitionedOutput::getOutput() {
   if (finished_) {
     return nullptr;
   }
 
+  if (sortedRuns_ && output_ == nullptr) {
+    if (sortedRunReady()) {
+      startSortedRun();
+    } else if (!noMoreInput_) {
+      return nullptr;
+    }
+  }
+
   blockingReason_ = BlockingReason::kNotBlocked;
   detail::Destination* blockedDestination = nullptr;
   auto bufferManager = bufferManager_.lock();
@@ -430,12 +647,31 @@ RowVectorPtr PartitionedOutput::getOutput() {
 
   // Limit serialized pages to 1MB.
   static const uint64_t kMaxPageSize = 1 << 20;
-  const uint64_t maxPageSize = std::max<uint64_t>(
-      kMinDestinationSize,
-      std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
+  // A sorted run has a page in progress for one destination at a time.
+  const uint64_t maxPageSize = sortedRuns_
+      ? kMaxPageSize
+      : std::max<uint64_t>(
+            kMinDestinationSize,
+            std::min<uint64_t>(
+                kMaxPageSize, maxBufferedBytes_ / numDestinations_));
+
+  if (scatterPending_) {
+    scatterPending_ = false;
+    blockedDestination = scatter(maxPageSize, *bufferManager);
+  }
 
-  bool workLeft;
-  do {
+  if (sortedRuns_ && output_ != nullptr) {
+    for (;;) {
+      blockedDestination = advanceSortedRun(maxPageSize, *bufferManager);
+      if (blockedDestination != nullptr || !sortedRunReady()) {
+        break;
+      }
+      startSortedRun();
+    }
+  }
+
+  bool workLeft = !sortedRuns_ && blockedDestination == nullptr;
+  while (workLeft) {
     workLeft = false;
     for (auto& destination : destinations_) {
       bool atEnd = false;
@@ -462,7 +698,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
         workLeft = true;
       }
     }
-  } while (workLeft);
+  }
 
   if (blockedDestination) {
     // If we are going off-thread, we may as well make the output in
@@ -36,7 +36,8 @@ class Destination {
       VectorSerde::Options* options,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued);
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      bool vectorPages = false);
 
   /// Resets the destination before starting a new batch.
   void beginBatch() {
@@ -54,8 +55,8 @@ class Destination {
     }
   }
 
-  /// Serializes row from 'output' till either 'maxBytes' have been serialized
-  /// or
+  /// Serializes rows from 'output' till either 'maxBytes' have been
+  /// serialized or the rows of the batch are exhausted.
   BlockingReason advance(
       uint64_t maxBytes,
       const std::vector<vector_size_t>& sizes,
@@ -68,6 +69,29 @@ class Destination {
       ContinueFuture* future,
       Scratch& scratch);
 
+  /// Takes the next rows of the batch to serialize into the current page,
+  /// stopping when the page reaches its target size. Returns an empty range if
+  /// no rows are left or the page is full and must be flushed first. Sets
+  /// 'shouldFlush' if the page is full after the returned rows.
+  folly::Range<const vector_size_t*> takeRows(
+      uint64_t maxBytes,
+      const std::vector<vector_size_t>& sizes,
+      bool& shouldFlush);
+
+  /// Returns the stream group to append the rows from takeRows() to.
+  VectorStreamGroup* streamGroup(const RowVectorPtr& output) {
+    createVectorStreamGroup(output);
+    return current_.get();
+  }
+
+  /// Called after appending the rows from takeRows() to streamGroup(). Flushes
+  /// if 'shouldFlush' or if flushing eagerly.
+  BlockingReason finishAppend(
+      bool shouldFlush,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
   BlockingReason flush(
       OutputBufferManager& bufferManager,
       const std::function<void()>& bufferReleaseFn,
@@ -106,6 +130,15 @@ class Destination {
   // after flush() to reinitialize the serializer.
   void createVectorStreamGroup(const RowVectorPtr& output);
 
+  // Enqueues 'rows' of 'output' as a VectorPage. The page is 'output' itself
+  // if 'rows' are all rows, else a dictionary over 'output'.
+  BlockingReason enqueueVectorPage(
+      const RowVectorPtr& output,
+      folly::Range<const vector_size_t*> rows,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
   // Clears the VectorStreamGroup and marks it for recreation.
   // This ensures the serializer is properly reinitialized before the next
   // append to avoid crashes from stale references to freed StreamArena memory.
@@ -118,6 +151,9 @@ class Destination {
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
+  // If true, rows are enqueued as VectorPages at the end of each advance()
+  // instead of being serialized.
+  const bool vectorPages_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
@@ -215,6 +251,27 @@ class PartitionedOutput : public Operator {
  private:
   void initializeInput(RowVectorPtr input);
 
+  // Assigns the rows of 'input' to the destinations.
+  void partitionInput(RowVectorPtr input);
+
+  // True if 'bufferedInputs_' are to be serialized as a sorted run.
+  bool sortedRunReady() const {
+    return !bufferedInputs_.empty() &&
+        (noMoreInput_ || bufferedBytes_ >= maxBufferedBytes_);
+  }
+
+  // Concatenates 'bufferedInputs_' and assigns the rows to the destinations.
+  // Adding the rows to the destinations in row order is a counting sort by
+  // destination.
+  void startSortedRun();
+
+  // Serializes and flushes the rows of the run a destination at a time,
+  // starting from 'runDestination_'. Returns the destination that blocked,
+  // nullptr if the run is complete.
+  detail::Destination* advanceSortedRun(
+      uint64_t maxPageSize,
+      OutputBufferManager& bufferManager);
+
   void initializeDestinations();
 
   void initializeSizeBuffers();
@@ -224,6 +281,14 @@ class PartitionedOutput : public Operator {
   // Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Serializes the rows of 'output_' for all destinations a column at a time.
+  // Each destination takes rows up to its page size, the rest is left for
+  // Destination::advance(). Returns the first destination that blocked on
+  // flush, nullptr if none did.
+  detail::Destination* scatter(
+      uint64_t maxPageSize,
+      OutputBufferManager& bufferManager);
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -240,10 +305,26 @@ class PartitionedOutput : public Operator {
   const bool eagerFlush_;
   VectorSerde* const serde_;
   const std::unique_ptr<VectorSerde::Options> serdeOptions_;
+  // Enqueues VectorPages instead of serialized pages. See
+  // QueryConfig::kPartitionedOutputVectorPages.
+  const bool vectorPages_;
+  // True if the input is buffered and serialized in runs sorted by
+  // destination. See QueryConfig::kPartitionedOutputSortMinDestinations.
+  const bool sortedRuns_;
+  // True if the input is serialized by scatter(). See
+  // QueryConfig::kPartitionedOutputScatterSerialization.
+  const bool scatterSerialization_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
   bool finished_{false};
+  // True if 'output_' is not yet serialized by scatter().
+  bool scatterPending_{false};
+  // Input not yet added to a sorted run and its estimated flat size.
+  std::vector<RowVectorPtr> bufferedInputs_;
+  uint64_t bufferedBytes_{0};
+  // The destination of the sorted run to serialize next.
+  int32_t runDestination_{0};
   // Contains pointers to 'rowSize_' elements. 'sizePointers_[i]' contains a
   // pointer to 'rowSize_[i]'.
   std::vector<vector_size_t*> sizePointers_;
@@ -268,6 +349,10 @@ class PartitionedOutput : public Operator {
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
   std::vector<DecodedVector> decodedVectors_;
+  std::vector<detail::Destination*> scatterDestinations_;
+  std::vector<VectorStreamGroup*> scatterGroups_;
+  std::vector<folly::Range<const vector_size_t*>> scatterRows_;
+  std::vector<bool> scatterFlushes_;
   Scratch scratch_;
 };
 
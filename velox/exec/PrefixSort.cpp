@@ -26,6 +26,39 @@ namespace {
 // to bitswap32.
 static constexpr int32_t kAlignment = 8;
 
+// Radix sort is used for fully normalized keys of up to this many bytes and at
+// least this many rows. Each byte of the keys is a pass over the entries.
+static constexpr uint32_t kMaxRadixSortKeyBytes = 16;
+static constexpr uint64_t kMinRadixSortRows = 1'024;
+
+// The next 8 bytes of a tied string and its size capped to one more than
+// these bytes.
+struct StringTieEntry {
+  uint64_t word;
+  uint32_t size;
+  char* row;
+};
+
+// Returns the 8 bytes of 'value' from 'offset' as a big endian word, padded
+// with zeros.
+FOLLY_ALWAYS_INLINE uint64_t stringWordAt(StringView value, uint32_t offset) {
+  uint64_t word = 0;
+  if (offset >= value.size()) {
+    return word;
+  }
+  const auto size = std::min<uint32_t>(sizeof(word), value.size() - offset);
+  if (value.isInline() ||
+      HashStringAllocator::headerOf(value.data())->size() >= value.size()) {
+    std::memcpy(&word, value.data() + offset, size);
+  } else {
+    HashStringAllocator::InputStream stream(
+        HashStringAllocator::headerOf(value.data()));
+    stream.skip(offset);
+    stream.ByteInputStream::readBytes(reinterpret_cast<char*>(&word), size);
+  }
+  return __builtin_bswap64(word);
+}
+
 template <typename T>
 FOLLY_ALWAYS_INLINE void encodeRowColumn(
     const PrefixSortLayout& prefixSortLayout,
@@ -254,24 +287,144 @@ FOLLY_ALWAYS_INLINE int PrefixSort::compareAllNormalizedKeys(
       (uint64_t*)left, (uint64_t*)right, sortLayout_.normalizedBufferSize);
 }
 
-int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
-  int result = compareAllNormalizedKeys(left, right);
-  if (result != 0) {
-    return result;
+bool PrefixSort::useRadixSort(uint64_t numRows) const {
+  return !sortLayout_.hasNonNormalizedKey &&
+      sortLayout_.nonPrefixSortStartIndex == sortLayout_.numNormalizedKeys &&
+      sortLayout_.normalizedBufferSize <= kMaxRadixSortKeyBytes &&
+      numRows >= kMinRadixSortRows;
+}
+
+void PrefixSort::sortTies(char* prefixBuffer, uint64_t numRows) {
+  const auto entrySize = sortLayout_.entrySize;
+  const auto lastKey = sortLayout_.numNormalizedKeys - 1;
+  const bool partialString =
+      sortLayout_.nonPrefixSortStartIndex == lastKey;
+  // The number of string bytes in the normalized keys.
+  const uint32_t stringOffset = partialString
+      ? sortLayout_.encodeSizes[lastKey] -
+          (sortLayout_.normalizedKeyHasNullByte[lastKey] ? 1 : 0)
+      : 0;
+  std::vector<char*> tiedRows;
+  uint64_t start = 0;
+  while (start < numRows) {
+    auto end = start + 1;
+    while (end < numRows &&
+           compareAllNormalizedKeys(
+               prefixBuffer + start * entrySize,
+               prefixBuffer + end * entrySize) == 0) {
+      ++end;
+    }
+    if (end - start > 1) {
+      tiedRows.resize(end - start);
+      for (auto i = start; i < end; ++i) {
+        tiedRows[i - start] =
+            getRowAddrFromPrefixBuffer(prefixBuffer + i * entrySize);
+      }
+      if (partialString) {
+        sortTiedStrings(tiedRows.data(), tiedRows.size(), stringOffset);
+      } else {
+        sortByKeys(
+            tiedRows.data(), tiedRows.size(), sortLayout_.numNormalizedKeys);
+      }
+      for (auto i = start; i < end; ++i) {
+        getRowAddrFromPrefixBuffer(prefixBuffer + i * entrySize) =
+            tiedRows[i - start];
+      }
+    }
+    start = end;
+  }
+}
+
+void PrefixSort::sortTiedStrings(
+    char** rows,
+    uint64_t numRows,
+    uint32_t offset) {
+  const auto keyIndex = sortLayout_.numNormalizedKeys - 1;
+  const auto& column = rowContainer_->columnAt(keyIndex);
+  // The rows are tied on the null byte, so either all strings are null or
+  // none is.
+  if (sortLayout_.normalizedKeyHasNullByte[keyIndex] &&
+      RowContainer::isNullAt(rows[0], column.nullByte(), column.nullMask())) {
+    sortByKeys(rows, numRows, keyIndex + 1);
+    return;
+  }
+  const bool ascending = sortLayout_.compareFlags[keyIndex].ascending;
+  const auto less = [&](const StringTieEntry& left,
+                        const StringTieEntry& right) {
+    return ascending
+        ? std::tie(left.word, left.size) < std::tie(right.word, right.size)
+        : std::tie(right.word, right.size) < std::tie(left.word, left.size);
+  };
+  const auto equal = [](const StringTieEntry& left,
+                        const StringTieEntry& right) {
+    return left.word == right.word && left.size == right.size;
+  };
+  std::vector<StringTieEntry> entries(numRows);
+  for (;;) {
+    // A string that ends within the next 8 bytes sorts before a longer string
+    // with the same bytes followed by zeros.
+    const uint64_t maxSize = static_cast<uint64_t>(offset) + sizeof(uint64_t);
+    for (auto i = 0; i < numRows; ++i) {
+      const auto& value =
+          *reinterpret_cast<const StringView*>(rows[i] + column.offset());
+      entries[i] = {
+          stringWordAt(value, offset),
+          static_cast<uint32_t>(
+              std::min<uint64_t>(value.size(), maxSize + 1)),
+          rows[i]};
+    }
+    std::sort(entries.begin(), entries.end(), less);
+    if (!equal(entries.front(), entries.back())) {
+      break;
+    }
+    // All rows are still tied.
+    if (entries.front().size <= maxSize) {
+      sortByKeys(rows, numRows, keyIndex + 1);
+      return;
+    }
+    offset += sizeof(uint64_t);
   }
 
-  // If prefixes are equal, compare the remaining sort keys with rowContainer.
-  char* leftRow = getRowAddrFromPrefixBuffer(left);
-  char* rightRow = getRowAddrFromPrefixBuffer(right);
-  for (auto i = sortLayout_.nonPrefixSortStartIndex; i < sortLayout_.numKeys;
-       ++i) {
-    result = rowContainer_->compare(
-        leftRow, rightRow, i, sortLayout_.compareFlags[i]);
-    if (result != 0) {
-      return result;
+  for (auto i = 0; i < numRows; ++i) {
+    rows[i] = entries[i].row;
+  }
+  const uint64_t maxSize = static_cast<uint64_t>(offset) + sizeof(uint64_t);
+  uint64_t start = 0;
+  while (start < numRows) {
+    auto end = start + 1;
+    while (end < numRows && equal(entries[start], entries[end])) {
+      ++end;
     }
+    if (end - start > 1) {
+      if (entries[start].size > maxSize) {
+        sortTiedStrings(rows + start, end - start, offset + sizeof(uint64_t));
+      } else {
+        sortByKeys(rows + start, end - start, keyIndex + 1);
+      }
+    }
+    start = end;
+  }
+}
+
+void PrefixSort::sortByKeys(char** rows, uint64_t numRows, uint32_t startKey)
+    const {
+  if (startKey >= sortLayout_.numKeys) {
+    return;
   }
-  return result;
+  std::vector<RowContainer::ColumnComparer> comparers;
+  comparers.reserve(sortLayout_.numKeys - startKey);
+  for (auto i = startKey; i < sortLayout_.numKeys; ++i) {
+    comparers.push_back(
+        rowContainer_->columnComparer(i, sortLayout_.compareFlags[i]));
+  }
+  std::sort(rows, rows + numRows, [&](const char* left, const char* right) {
+    for (const auto& comparer : comparers) {
+      if (auto result = comparer(left, right)) {
+        return result < 0;
+      }
+    }
+    return false;
+  });
 }
 
 PrefixSort::PrefixSort(
@@ -333,11 +486,16 @@ void PrefixSort::stdSort(
     std::vector<char*, memory::StlAllocator<char*>>& rows,
     const RowContainer* rowContainer,
     const std::vector<CompareFlags>& compareFlags) {
+  // Resolve the per-key type dispatch once instead of on every comparison.
+  std::vector<RowContainer::ColumnComparer> comparers;
+  comparers.reserve(compareFlags.size());
+  for (auto i = 0; i < compareFlags.size(); ++i) {
+    comparers.push_back(rowContainer->columnComparer(i, compareFlags[i]));
+  }
   std::sort(
       rows.begin(), rows.end(), [&](const char* leftRow, const char* rightRow) {
-        for (auto i = 0; i < compareFlags.size(); ++i) {
-          if (auto result = rowContainer->compare(
-                  leftRow, rightRow, i, compareFlags[i])) {
+        for (const auto& comparer : comparers) {
+          if (auto result = comparer(leftRow, rightRow)) {
             return result < 0;
           }
         }
@@ -349,8 +507,9 @@ uint64_t PrefixSort::maxRequiredBytes() const {
   const auto numRows = rowContainer_->numRows();
   const auto numPages =
       memory::AllocationTraits::numPages(numRows * sortLayout_.entrySize);
-  // Prefix data size + swap buffer size.
-  return memory::AllocationTraits::pageBytes(numPages) +
+  // Prefix data size, once more for radix sort, + swap buffer size.
+  return memory::AllocationTraits::pageBytes(numPages) *
+      (useRadixSort(numRows) ? 2 : 1) +
       pool_->preferredSize(
           checkedPlus<size_t>(
               sortLayout_.entrySize, AlignedBuffer::kPaddedSize)) +
@@ -377,28 +536,37 @@ void PrefixSort::sortInternal(
   }
 
   // Sort rows with the normalized prefix keys.
-  {
+  memory::ContiguousAllocation radixBufferAlloc;
+  if (sortLayout_.numNormalizedKeys > 0) {
+    addThreadLocalRuntimeStat(
+        PrefixSort::kNumPrefixSortKeys,
+        RuntimeCounter(
+            sortLayout_.numNormalizedKeys, RuntimeCounter::Unit::kNone));
+  }
+  if (useRadixSort(numRows)) {
+    pool_->allocateContiguous(
+        prefixBufferAlloc.numPages(), radixBufferAlloc);
+    prefixBuffer = PrefixSortRunner::radixSort(
+        prefixBuffer,
+        prefixBuffer + numRows * entrySize,
+        entrySize,
+        sortLayout_.normalizedBufferSize,
+        radixBufferAlloc.data<char>());
+  } else {
     const auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool_);
     PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
     auto* prefixBufferStart = prefixBuffer;
     auto* prefixBufferEnd = prefixBuffer + numRows * entrySize;
-    if (sortLayout_.numNormalizedKeys > 0) {
-      addThreadLocalRuntimeStat(
-          PrefixSort::kNumPrefixSortKeys,
-          RuntimeCounter(
-              sortLayout_.numNormalizedKeys, RuntimeCounter::Unit::kNone));
-    }
+    sortRunner.quickSort(
+        prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
+          return compareAllNormalizedKeys(lhs, rhs);
+        });
+    // Sorts the entries with equal normalized keys by the other keys. This
+    // compares rows in the RowContainer only for the ties instead of in every
+    // comparison of the quick sort.
     if (sortLayout_.hasNonNormalizedKey ||
         sortLayout_.nonPrefixSortStartIndex < sortLayout_.numNormalizedKeys) {
-      sortRunner.quickSort(
-          prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
-            return comparePartNormalizedKeys(lhs, rhs);
-          });
-    } else {
-      sortRunner.quickSort(
-          prefixBufferStart, prefixBufferEnd, [&](char* lhs, char* rhs) {
-            return compareAllNormalizedKeys(lhs, rhs);
-          });
+      sortTies(prefixBuffer, numRows);
     }
   }
 
@@ -211,7 +211,25 @@ class PrefixSort {
 
   int compareAllNormalizedKeys(char* left, char* right);
 
-  int comparePartNormalizedKeys(char* left, char* right);
+  // Returns true if 'numRows' rows are sorted with a radix sort on the
+  // normalized keys instead of a quick sort. This needs a second prefix
+  // buffer.
+  bool useRadixSort(uint64_t numRows) const;
+
+  // Sorts the runs of entries of 'prefixBuffer' that have equal normalized
+  // keys by the keys that are not or only partly in the normalized keys.
+  // 'prefixBuffer' is sorted by the normalized keys.
+  void sortTies(char* prefixBuffer, uint64_t numRows);
+
+  // Sorts 'rows' whose normalized keys are equal. The last normalized key is a
+  // string of which the first 'offset' bytes are equal. Sorts by the next 8
+  // bytes of the string and then each run of rows that are still tied by the
+  // following 8 bytes, MSD radix sort style, until the strings end. Rows with
+  // equal strings are sorted by the remaining keys.
+  void sortTiedStrings(char** rows, uint64_t numRows, uint32_t offset);
+
+  // Sorts 'rows' by the keys from 'startKey' on with RowContainer compare.
+  void sortByKeys(char** rows, uint64_t numRows, uint32_t startKey) const;
 
   void extractRowAndEncodePrefixKeys(char* row, char* prefixBuffer);
 
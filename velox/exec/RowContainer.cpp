@@ -16,6 +16,7 @@
 
 #include "velox/exec/RowContainer.h"
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/memory/RawVector.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/ContainerRowSerde.h"
@@ -785,6 +786,87 @@ void RowContainer::storeSerializedRow(
   }
 }
 
+void RowContainer::extractColumns(
+    const char* const* rows,
+    int32_t numRows,
+    folly::Range<const column_index_t*> columnIndices,
+    folly::Range<const VectorPtr*> results) const {
+  VELOX_CHECK_EQ(columnIndices.size(), results.size());
+  const int32_t blockRows = std::max(
+      kMinExtractBlockRows, kExtractBlockBytes / std::max(1, fixedRowSize_));
+  if (columnIndices.size() == 1 || numRows <= blockRows) {
+    for (auto i = 0; i < columnIndices.size(); ++i) {
+      extractColumn(rows, numRows, columnIndices[i], results[i]);
+    }
+    return;
+  }
+
+  // Complex type values are extracted one column at a time, since their
+  // deserialization does not gain from the rows being in the cache as much.
+  std::vector<int32_t> blockColumns;
+  for (auto i = 0; i < columnIndices.size(); ++i) {
+    if (results[i]->type()->isPrimitiveType()) {
+      // Sizes the result once. The blocks then resize within capacity.
+      results[i]->resize(numRows);
+      blockColumns.push_back(i);
+    } else {
+      extractColumn(rows, numRows, columnIndices[i], results[i]);
+    }
+  }
+  for (auto begin = 0; begin < numRows; begin += blockRows) {
+    const auto size = std::min(blockRows, numRows - begin);
+    for (auto i : blockColumns) {
+      extractColumn(rows + begin, size, columnIndices[i], begin, results[i]);
+    }
+  }
+}
+
+void RowContainer::extractColumnsParallel(
+    const char* const* rows,
+    int32_t numRows,
+    folly::Range<const column_index_t*> columnIndices,
+    folly::Range<const VectorPtr*> results,
+    folly::Executor* executor) const {
+  VELOX_CHECK_EQ(columnIndices.size(), results.size());
+  if (executor == nullptr || columnIndices.size() < 2) {
+    extractColumns(rows, numRows, columnIndices, results);
+    return;
+  }
+  std::vector<std::shared_ptr<AsyncSource<bool>>> pending;
+  pending.reserve(columnIndices.size() - 1);
+  for (auto i = 1; i < columnIndices.size(); ++i) {
+    const auto column = columnIndices[i];
+    const auto& result = results[i];
+    pending.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, rows, numRows, column, result]() {
+          extractColumn(rows, numRows, column, result);
+          return std::make_unique<bool>(true);
+        }));
+    executor->add([source = pending.back()]() { source->prepare(); });
+  }
+
+  // Waits for all the columns before rethrowing an error, since the pending
+  // ones reference 'rows' and 'results'.
+  std::exception_ptr error;
+  try {
+    extractColumn(rows, numRows, columnIndices[0], results[0]);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  for (auto& source : pending) {
+    try {
+      source->move();
+    } catch (...) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 void RowContainer::extractString(
     StringView value,
     FlatVector<StringView>* values,
@@ -829,6 +911,23 @@ void RowContainer::storeComplexType(
       reinterpret_cast<char*>(position.position), stream.size());
 }
 
+void RowContainer::storeInternedString(
+    StringView value,
+    char* row,
+    int32_t offset) {
+  auto it = internedStrings_->find(value);
+  if (it != internedStrings_->end()) {
+    valueAt<StringView>(row, offset) = *it;
+    internedStringBytes_ += value.size();
+    return;
+  }
+  auto* header = stringAllocator_->allocate(value.size());
+  ::memcpy(header->begin(), value.data(), value.size());
+  const StringView interned(header->begin(), value.size());
+  internedStrings_->insert(interned);
+  valueAt<StringView>(row, offset) = interned;
+}
+
 //   static
 int32_t RowContainer::compareStringAsc(
     StringView left,
@@ -853,6 +952,10 @@ int RowContainer::compareComplexType(
 }
 
 int32_t RowContainer::compareStringAsc(StringView left, StringView right) {
+  // Interned strings are equal if they are the same string.
+  if (left.data() == right.data() && left.size() == right.size()) {
+    return 0;
+  }
   std::string leftStorage;
   std::string rightStorage;
   return HashStringAllocator::contiguousString(left, leftStorage)
@@ -979,6 +1082,11 @@ void RowContainer::clear() {
   rows_.clear();
   rowPointers_.clear();
   rowPointers_.shrink_to_fit();
+  // The interned strings and their set are in 'stringAllocator_'.
+  if (internedStrings_ != nullptr) {
+    internedStrings_.reset();
+    enableStringInterning();
+  }
   stringAllocator_->clear();
   numRows_ = 0;
   numRowsWithNormalizedKey_ = 0;
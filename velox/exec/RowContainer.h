@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <folly/Executor.h>
+#include <folly/container/F14Set.h>
+
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/core/PlanNode.h"
@@ -542,6 +545,30 @@ class RowContainer {
         result);
   }
 
+  /// Copies the values at 'columnIndices[i]' into 'results[i]' for the
+  /// 'numRows' rows pointed to by 'rows'. Same as extractColumn() for each
+  /// column, but copies the primitive type columns for a block of rows at a
+  /// time. Reading the rows for the first column of a block brings them into
+  /// the cache for the other columns, whereas extracting one column after the
+  /// other reads each row from memory once per column when 'rows' are more
+  /// than fit in the cache, e.g. when they are sorted.
+  void extractColumns(
+      const char* const* rows,
+      int32_t numRows,
+      folly::Range<const column_index_t*> columnIndices,
+      folly::Range<const VectorPtr*> results) const;
+
+  /// Same as extractColumns() but extracts the columns in parallel, one column
+  /// per task on 'executor' and the first column on the calling thread. Returns
+  /// after all columns are extracted. The caller must not modify the rows or
+  /// allocate from the string allocator of this container meanwhile.
+  void extractColumnsParallel(
+      const char* const* rows,
+      int32_t numRows,
+      folly::Range<const column_index_t*> columnIndices,
+      folly::Range<const VectorPtr*> results,
+      folly::Executor* executor) const;
+
   /// Sets in result all locations with null values in columnIndex for rows.
   void extractNulls(
       const char* const* rows,
@@ -731,6 +758,50 @@ class RowContainer {
       int32_t columnIndex,
       CompareFlags flags = CompareFlags()) const;
 
+  /// Compares the values of one column of two rows, with the type dispatch of
+  /// compare() resolved up front. Sorts that compare the same key columns
+  /// O(n log n) times use this to skip the dispatch on each comparison.
+  class ColumnComparer {
+   public:
+    /// Returns 0 for equal, < 0 for left < right, > 0 otherwise.
+    int32_t operator()(const char* left, const char* right) const {
+      return compare_(container_, left, right, type_, column_, flags_);
+    }
+
+   private:
+    using CompareFunction = int32_t (*)(
+        const RowContainer*,
+        const char*,
+        const char*,
+        const Type*,
+        RowColumn,
+        CompareFlags);
+
+    ColumnComparer(
+        const RowContainer* container,
+        CompareFunction compare,
+        const Type* type,
+        RowColumn column,
+        CompareFlags flags)
+        : container_(container),
+          compare_(compare),
+          type_(type),
+          column_(column),
+          flags_(flags) {}
+
+    const RowContainer* container_;
+    CompareFunction compare_;
+    const Type* type_;
+    RowColumn column_;
+    CompareFlags flags_;
+
+    friend class RowContainer;
+  };
+
+  /// Returns a comparer equivalent to compare(left, right, columnIndex,
+  /// flags).
+  ColumnComparer columnComparer(int32_t columnIndex, CompareFlags flags) const;
+
   /// Compares the value between 'left' at 'leftIndex' and 'right' and
   /// 'rightIndex'. Returns 0 for equal, < 0 for left < right, > 0 otherwise.
   /// Both columns should have the same type.
@@ -768,7 +839,8 @@ class RowContainer {
     return probedFlagOffset_;
   }
 
-  /// Byte offset of the per-row count for counting joins. 0 if not applicable.
+  /// Byte offset of the per-row count for counting joins and for the group hit
+  /// counts of partial aggregations. 0 if not applicable.
   int32_t countOffset() const {
     return countOffset_;
   }
@@ -793,6 +865,12 @@ class RowContainer {
     --countRef(row);
   }
 
+  /// Sets the count at the given row.
+  void setCount(char* row, int32_t count) const {
+    VELOX_DCHECK_NE(countOffset_, 0);
+    countRef(row) = count;
+  }
+
   /// Returns the offset of a uint32_t row size or 0 if the row has no variable
   /// width fields or accumulators.
   int32_t rowSizeOffset() const {
@@ -843,6 +921,26 @@ class RowContainer {
   /// Resets the state to be as after construction. Frees memory for payload.
   void clear();
 
+  /// Makes the rows stored from now on share one copy of equal non-inline
+  /// strings of up to kMaxInternedStringSize bytes. Meant for containers
+  /// with many repeated strings whose rows are rarely erased, e.g. a hash
+  /// join build: the interned strings are freed only by clear().
+  void enableStringInterning() {
+    if (internedStrings_ == nullptr) {
+      internedStrings_ = std::make_unique<InternedStrings>(
+          AlignedStlAllocator<StringView, 16>(stringAllocator_.get()));
+    }
+  }
+
+  /// The longest string that enableStringInterning() interns.
+  static constexpr int32_t kMaxInternedStringSize = 4 << 10;
+
+  /// Returns the bytes of strings that were stored as a reference to an equal
+  /// interned string instead of a copy.
+  uint64_t internedStringBytes() const {
+    return internedStringBytes_;
+  }
+
   int32_t compareRows(
       const char* left,
       const char* right,
@@ -956,6 +1054,11 @@ class RowContainer {
   // Offset of the pointer to the next free row on a free row.
   static constexpr int32_t kNextFreeOffset = 0;
 
+  // Bytes of rows that extractColumns() copies a block at a time and the
+  // minimum number of rows of a block.
+  static constexpr int32_t kExtractBlockBytes = 128 << 10;
+  static constexpr int32_t kMinExtractBlockRows = 32;
+
   template <typename T>
   static inline T valueAt(const char* group, int32_t offset) {
     return *reinterpret_cast<const T*>(group + offset);
@@ -1090,8 +1193,7 @@ class RowContainer {
     }
     if constexpr (std::is_same_v<T, StringView>) {
       RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
-      stringAllocator_->copyMultipart(
-          decoded.valueAt<T>(rowIndex), row, offset);
+      storeString(decoded.valueAt<T>(rowIndex), row, offset);
     } else {
       *reinterpret_cast<T*>(row + offset) = decoded.valueAt<T>(rowIndex);
     }
@@ -1107,13 +1209,35 @@ class RowContainer {
     using T = typename TypeTraits<Kind>::NativeType;
     if constexpr (std::is_same_v<T, StringView>) {
       RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
-      stringAllocator_->copyMultipart(
-          decoded.valueAt<T>(rowIndex), row, offset);
+      storeString(decoded.valueAt<T>(rowIndex), row, offset);
     } else {
       *reinterpret_cast<T*>(row + offset) = decoded.valueAt<T>(rowIndex);
     }
   }
 
+  inline void storeString(StringView value, char* row, int32_t offset) {
+    if (internedStrings_ != nullptr && !value.isInline() &&
+        value.size() <= kMaxInternedStringSize) {
+      storeInternedString(value, row, offset);
+      return;
+    }
+    stringAllocator_->copyMultipart(value, row, offset);
+  }
+
+  // Sets the string at 'offset' in 'row' to the interned copy of 'value'.
+  // Makes the copy if there is none.
+  void storeInternedString(StringView value, char* row, int32_t offset);
+
+  // Returns true if 'value' is an interned string. These are not freed with
+  // the rows that refer to them.
+  bool isInternedString(StringView value) const {
+    if (internedStrings_ == nullptr) {
+      return false;
+    }
+    auto it = internedStrings_->find(value);
+    return it != internedStrings_->end() && it->data() == value.data();
+  }
+
   template <TypeKind Kind>
   inline void storeWithNullsBatch(
       const DecodedVector& decoded,
@@ -1402,6 +1526,23 @@ class RowContainer {
         left, right, type, column, column, flags);
   }
 
+  template <bool typeProvidesCustomComparison, TypeKind Kind>
+  static int32_t compareColumn(
+      const RowContainer* container,
+      const char* left,
+      const char* right,
+      const Type* type,
+      RowColumn column,
+      CompareFlags flags) {
+    return container->compare<typeProvidesCustomComparison, Kind>(
+        left, right, type, column, flags);
+  }
+
+  template <bool typeProvidesCustomComparison, TypeKind Kind>
+  static ColumnComparer::CompareFunction columnCompareFunction() {
+    return &compareColumn<typeProvidesCustomComparison, Kind>;
+  }
+
   void storeComplexType(
       const DecodedVector& decoded,
       vector_size_t index,
@@ -1497,7 +1638,7 @@ class RowContainer {
 
       auto& view = valueAt<FieldType>(row, column.offset());
       if constexpr (std::is_same_v<FieldType, StringView>) {
-        if (view.isInline()) {
+        if (view.isInline() || isInternedString(view)) {
           continue;
         }
       } else {
@@ -1548,6 +1689,16 @@ class RowContainer {
   const bool useListRowIndex_;
   const std::unique_ptr<HashStringAllocator> stringAllocator_;
 
+  using InternedStrings = folly::F14FastSet<
+      StringView,
+      std::hash<StringView>,
+      std::equal_to<StringView>,
+      AlignedStlAllocator<StringView, 16>>;
+  // The interned copies of strings, if enableStringInterning() was called.
+  // Allocated from 'stringAllocator_'.
+  std::unique_ptr<InternedStrings> internedStrings_;
+  uint64_t internedStringBytes_{0};
+
   // Indicates if we can add new row to this row container. It is set to false
   // after user calls 'getRowPartitions()' to create 'rowPartitions' object for
   // parallel join build.
@@ -1838,6 +1989,18 @@ inline int RowContainer::compare(
   }
 }
 
+inline RowContainer::ColumnComparer RowContainer::columnComparer(
+    int32_t columnIndex,
+    CompareFlags flags) const {
+  const auto* type = types_[columnIndex].get();
+  const auto compare = type->providesCustomComparison()
+      ? VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH_ALL(
+            columnCompareFunction, true, type->kind())
+      : VELOX_DYNAMIC_TEMPLATE_TYPE_DISPATCH_ALL(
+            columnCompareFunction, false, type->kind());
+  return ColumnComparer(this, compare, type, columnAt(columnIndex), flags);
+}
+
 inline int RowContainer::compare(
     const char* left,
     const char* right,
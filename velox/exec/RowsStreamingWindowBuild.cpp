@@ -17,6 +17,7 @@
 #include "velox/exec/RowsStreamingWindowBuild.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/WindowFunction.h"
+#include "velox/type/Variant.h"
 
 namespace facebook::velox::exec {
 
@@ -29,15 +30,95 @@ bool hasRangeFrame(const std::shared_ptr<const core::WindowNode>& windowNode) {
   }
   return false;
 }
+
+vector_size_t maxPrecedingRows(
+    const std::shared_ptr<const core::WindowNode>& windowNode) {
+  vector_size_t maxRows = 0;
+  for (const auto& function : windowNode->windowFunctions()) {
+    if (!getWindowFunctionMetadata(function.functionCall->name())
+             .isAggregate) {
+      continue;
+    }
+    const auto numRows =
+        RowsStreamingWindowBuild::numPrecedingRows(function.frame);
+    VELOX_CHECK(numRows.has_value());
+    maxRows = std::max(maxRows, numRows.value());
+  }
+  return maxRows;
+}
+
+// Returns the constant offset of a k PRECEDING frame bound or std::nullopt for
+// a column offset.
+std::optional<int64_t> constantFrameOffset(const core::TypedExprPtr& value) {
+  const auto constant = core::TypedExprs::asConstant(value);
+  if (constant == nullptr || constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return VariantConverter::convert(constant->value(), TypeKind::BIGINT)
+      .value<int64_t>();
+}
 } // namespace
 
+// static
+std::optional<vector_size_t> RowsStreamingWindowBuild::numPrecedingRows(
+    const core::WindowNode::Frame& frame) {
+  using BoundType = core::WindowNode::BoundType;
+  if (frame.startType == BoundType::kUnboundedPreceding &&
+      frame.endType == BoundType::kCurrentRow) {
+    return 0;
+  }
+  if (frame.type != core::WindowNode::WindowType::kRows) {
+    return std::nullopt;
+  }
+
+  // The frame of a row can start one row before the frame of the previous
+  // row ends, so that the rows leaving the frame can be retracted.
+  int64_t numRows;
+  switch (frame.startType) {
+    case BoundType::kUnboundedPreceding:
+      numRows = 0;
+      break;
+    case BoundType::kCurrentRow:
+      numRows = 1;
+      break;
+    case BoundType::kPreceding: {
+      const auto offset = constantFrameOffset(frame.startValue);
+      if (!offset.has_value() || offset.value() < 0) {
+        return std::nullopt;
+      }
+      numRows = offset.value() + 1;
+      break;
+    }
+    default:
+      return std::nullopt;
+  }
+  switch (frame.endType) {
+    case BoundType::kCurrentRow:
+      break;
+    case BoundType::kPreceding: {
+      const auto offset = constantFrameOffset(frame.endValue);
+      if (!offset.has_value() || offset.value() < 0) {
+        return std::nullopt;
+      }
+      // An empty frame before the first rows keeps them for the first
+      // non-empty frame.
+      numRows = std::max(numRows, offset.value() + 1);
+      break;
+    }
+    default:
+      return std::nullopt;
+  }
+  return std::min<int64_t>(numRows, std::numeric_limits<vector_size_t>::max());
+}
+
 RowsStreamingWindowBuild::RowsStreamingWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection)
     : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection),
-      hasRangeFrame_(hasRangeFrame(windowNode)) {
+      hasRangeFrame_(hasRangeFrame(windowNode)),
+      numPrecedingRows_(maxPrecedingRows(windowNode)) {
   velox::common::testutil::TestValue::adjust(
       "facebook::velox::exec::RowsStreamingWindowBuild::RowsStreamingWindowBuild",
       this);
@@ -52,7 +133,10 @@ void RowsStreamingWindowBuild::ensureInputPartition() {
   if (windowPartitions_.empty() || windowPartitions_.back()->complete()) {
     windowPartitions_.emplace_back(
         std::make_shared<WindowPartition>(
-            data_.get(), inversedInputChannels_, sortKeyInfo_));
+            data_.get(),
+            inversedInputChannels_,
+            sortKeyInfo_,
+            numPrecedingRows_));
   }
 }
 
@@ -26,7 +26,10 @@ namespace facebook::velox::exec {
 /// approach can significantly reduce memory usage, especially when a single
 /// partition contains a large amount of data. It is particularly suited for
 /// optimizing rank, dense_rank and row_number functions, as well as aggregate
-/// window functions with a default frame.
+/// window functions with a default frame or a ROWS frame that ends at or
+/// before the current row, e.g. 'ROWS BETWEEN 100 PRECEDING AND CURRENT ROW'.
+/// For the latter, the partition keeps a sliding window of the last processed
+/// rows that the frames of the following rows need.
 class RowsStreamingWindowBuild : public WindowBuild {
  public:
   RowsStreamingWindowBuild(
@@ -35,6 +38,13 @@ class RowsStreamingWindowBuild : public WindowBuild {
       const common::SpillConfig* spillConfig,
       tsan_atomic<bool>* nonReclaimableSection);
 
+  /// Returns the number of processed rows that a partition must keep for the
+  /// aggregate window function frame 'frame' of the following rows, or
+  /// std::nullopt if the frame needs rows after the current row or has
+  /// non-constant offsets.
+  static std::optional<vector_size_t> numPrecedingRows(
+      const core::WindowNode::Frame& frame);
+
   void addInput(RowVectorPtr input) override;
 
   void spill() override {
@@ -67,6 +77,11 @@ class RowsStreamingWindowBuild : public WindowBuild {
   // Sets to true if this window node has range frames.
   const bool hasRangeFrame_;
 
+  // Number of processed rows each partition keeps for the frames of the
+  // following rows. The maximum of numPrecedingRows() over the aggregate
+  // window functions.
+  const vector_size_t numPrecedingRows_;
+
   // Points to the input rows in the current partition.
   std::vector<char*> inputRows_;
 
@@ -16,6 +16,7 @@
 
 #include "velox/exec/ScaleWriterLocalPartition.h"
 
+#include "velox/common/time/Timer.h"
 #include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/RoundRobinPartitionFunction.h"
 #include "velox/exec/Task.h"
@@ -234,7 +235,14 @@ ScaleWriterLocalPartition::ScaleWriterLocalPartition(
       queryPool_(pool()->root()),
       minDataProcessedBytes_(
           ctx->queryConfig()
-              .scaleWriterMinPartitionProcessedBytesRebalanceThreshold()) {
+              .scaleWriterMinPartitionProcessedBytesRebalanceThreshold()),
+      minThroughputGainRatio_(
+          ctx->queryConfig().scaleWriterMinThroughputGainRatio()),
+      scaleDownBufferUsageRatio_(
+          ctx->queryConfig().scaleWriterScaleDownBufferUsageRatio()) {
+  VELOX_CHECK_GE(minThroughputGainRatio_, 0);
+  VELOX_CHECK_GE(scaleDownBufferUsageRatio_, 0);
+  VELOX_CHECK_LT(scaleDownBufferUsageRatio_, 0.5);
   if (partitionFunction_ != nullptr) {
     VELOX_CHECK_NOT_NULL(
         dynamic_cast<RoundRobinPartitionFunction*>(partitionFunction_.get()));
@@ -247,6 +255,7 @@ void ScaleWriterLocalPartition::initialize() {
   memoryManager_ =
       operatorCtx_->driver()->task()->getLocalExchangeMemoryManager(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+  lastScaleTimeUs_ = getCurrentTimeMicro();
 }
 
 void ScaleWriterLocalPartition::addInput(RowVectorPtr input) {
@@ -284,33 +293,92 @@ uint32_t ScaleWriterLocalPartition::getNextWriterId() {
   // when the worker is overloaded which might cause a lot of queuing on both
   // producer and consumer sides. The buffered memory ratio is not a reliable
   // signal in that case.
-  if ((numWriters_ < numPartitions_) &&
-      (memoryManager_->bufferedBytes() >=
-       memoryManager_->maxBufferBytes() / 2) &&
+  const bool processedEnough =
+      (processedDataBytes_ - processedBytesAtLastScale_ >=
+       numWriters_ * minDataProcessedBytes_);
+  const auto bufferedBytes = memoryManager_->bufferedBytes();
+  if (!throughputBound_ && (numWriters_ < numPartitions_) &&
+      (bufferedBytes >= memoryManager_->maxBufferBytes() / 2) &&
       // Do not scale up if total memory used is greater than
       // 'maxQueryMemoryUsageRatio_' of max query memory capacity. We have to be
       // conservative here otherwise scaling of writers will happen first
       // before we hit the query memory capacity limit, and then we won't be
       // able to do anything to prevent query OOM.
-      (processedDataBytes_ - processedBytesAtLastScale_ >=
-       numWriters_ * minDataProcessedBytes_) &&
+      processedEnough &&
       (queryPool_->reservedBytes() <
        queryPool_->maxCapacity() * maxQueryMemoryUsageRatio_)) {
-    ++numWriters_;
-    processedBytesAtLastScale_ = processedDataBytes_;
-    LOG(INFO) << "Scaled task writer count to: " << numWriters_
-              << " with max of " << numPartitions_;
+    const auto nowUs = getCurrentTimeMicro();
+    const double throughput = throughputSinceLastScale(nowUs);
+    // The buffer is still filling up after the last scale up. If the writers
+    // didn't drain it noticeably faster with the added writer, then the table
+    // sink is bound by something shared across the writers such as the
+    // storage upload bandwidth. More writers only produce more and smaller
+    // files, so we remove the last added writer and stop scaling.
+    if (minThroughputGainRatio_ > 0 && throughputBeforeLastScaleUp_ > 0 &&
+        throughput <
+            throughputBeforeLastScaleUp_ * (1 + minThroughputGainRatio_)) {
+      throughputBound_ = true;
+      ++numScaledDownWriters_;
+      scaleWriters(numWriters_ - 1, nowUs);
+      return (nextWriterIndex_++) % numWriters_;
+    }
+    ++numScaledUpWriters_;
+    scaleWriters(numWriters_ + 1, nowUs);
+    throughputBeforeLastScaleUp_ = throughput;
+  } else if (
+      scaleDownBufferUsageRatio_ > 0 && numWriters_ > 1 && processedEnough &&
+      bufferedBytes <
+          memoryManager_->maxBufferBytes() * scaleDownBufferUsageRatio_) {
+    // The writers keep up with the incoming data with a mostly empty buffer,
+    // so stop sending data to the last added writer to produce larger files.
+    // The writer's open files are only closed when the writer finishes, but no
+    // more data goes into them.
+    ++numScaledDownWriters_;
+    scaleWriters(numWriters_ - 1, getCurrentTimeMicro());
   }
   return (nextWriterIndex_++) % numWriters_;
 }
 
+uint64_t ScaleWriterLocalPartition::consumedBytes() const {
+  uint64_t bytes{0};
+  for (const auto& queue : queues_) {
+    bytes += queue->consumedBytes();
+  }
+  return bytes;
+}
+
+double ScaleWriterLocalPartition::throughputSinceLastScale(
+    uint64_t nowUs) const {
+  VELOX_CHECK_GE(nowUs, lastScaleTimeUs_);
+  return static_cast<double>(consumedBytes() - consumedBytesAtLastScale_) /
+      std::max<uint64_t>(1, nowUs - lastScaleTimeUs_);
+}
+
+void ScaleWriterLocalPartition::scaleWriters(
+    uint32_t numWriters,
+    uint64_t nowUs) {
+  VELOX_CHECK_GE(numWriters, 1);
+  VELOX_CHECK_LE(numWriters, numPartitions_);
+  numWriters_ = numWriters;
+  processedBytesAtLastScale_ = processedDataBytes_;
+  consumedBytesAtLastScale_ = consumedBytes();
+  lastScaleTimeUs_ = nowUs;
+  throughputBeforeLastScaleUp_ = 0;
+  LOG(INFO) << "Scaled task writer count to: " << numWriters_
+            << " with max of " << numPartitions_;
+}
+
 void ScaleWriterLocalPartition::close() {
   LocalPartition::close();
 
-  if (numWriters_ == 1) {
-    return;
+  auto lockedStats = stats_.wlock();
+  if (numScaledUpWriters_ > 0) {
+    lockedStats->addRuntimeStat(
+        kScaledWriters, RuntimeCounter(numScaledUpWriters_));
+  }
+  if (numScaledDownWriters_ > 0) {
+    lockedStats->addRuntimeStat(
+        kScaledDownWriters, RuntimeCounter(numScaledDownWriters_));
   }
-  stats_.wlock()->addRuntimeStat(
-      kScaledWriters, RuntimeCounter(numWriters_ - 1));
 }
 } // namespace facebook::velox::exec
@@ -99,17 +99,37 @@ class ScaleWriterLocalPartition : public LocalPartition {
   /// The name of the runtime stats of writer scaling.
   /// The number of scaled writers.
   static constexpr std::string_view kScaledWriters{"scaledWriters"};
+  /// The number of writers removed from the round-robin because they didn't
+  /// increase the write throughput or were idle.
+  static constexpr std::string_view kScaledDownWriters{"scaledDownWriters"};
 
  private:
   // Gets the writer id to process the next input in a round-robin manner.
   uint32_t getNextWriterId();
 
+  // Returns the total bytes consumed from all the writer queues.
+  uint64_t consumedBytes() const;
+
+  // Returns the writer throughput in bytes per microsecond since the last
+  // writer scaling.
+  double throughputSinceLastScale(uint64_t nowUs) const;
+
+  // Sets the number of assigned writers to 'numWriters' and starts a new
+  // throughput measurement window at 'nowUs'.
+  void scaleWriters(uint32_t numWriters, uint64_t nowUs);
+
   // The max query memory usage ratio before we stop writer scaling.
   const double maxQueryMemoryUsageRatio_;
   memory::MemoryPool* const queryPool_;
   // The minimal amount of processed data bytes before we trigger next writer
   // scaling.
   const uint64_t minDataProcessedBytes_;
+  // The min throughput gain ratio from the last added writer to keep scaling
+  // up. Zero disables the throughput check.
+  const double minThroughputGainRatio_;
+  // The buffer usage ratio below which we remove the last added writer. Zero
+  // disables the writer scale down.
+  const double scaleDownBufferUsageRatio_;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
 
@@ -122,5 +142,17 @@ class ScaleWriterLocalPartition : public LocalPartition {
   uint64_t processedDataBytes_{0};
   // The total processed data bytes at the last writer scaling.
   uint64_t processedBytesAtLastScale_{0};
+  // The total consumed bytes from all the writer queues and the time at the
+  // last writer scaling.
+  uint64_t consumedBytesAtLastScale_{0};
+  uint64_t lastScaleTimeUs_{0};
+  // The writer throughput measured right before the last scale up. Zero if
+  // the last scaling was not a scale up.
+  double throughputBeforeLastScaleUp_{0};
+  // Set if the last added writer didn't increase the throughput by
+  // 'minThroughputGainRatio_' and we stop scaling up writers.
+  bool throughputBound_{false};
+  uint32_t numScaledUpWriters_{0};
+  uint32_t numScaledDownWriters_{0};
 };
 } // namespace facebook::velox::exec
@@ -49,4 +49,27 @@ PrestoSerializedPage::prepareStreamForDeserialize() {
   return std::make_unique<BufferInputStream>(std::move(ranges_));
 }
 
+VectorPage::VectorPage(
+    RowVectorPtr vector,
+    uint64_t bytes,
+    std::function<void()> releaseFn)
+    : releaseFn_(std::move(releaseFn)),
+      vector_(std::move(vector)),
+      bytes_(bytes) {
+  VELOX_CHECK_NOT_NULL(vector_);
+}
+
+VectorPage::~VectorPage() {
+  // Frees the buffers of the vector before the owner of their pools may go.
+  vector_.reset();
+  if (releaseFn_) {
+    releaseFn_();
+  }
+}
+
+void VectorPage::copyTo(RowVector& result, vector_size_t offset) const {
+  VELOX_CHECK_LE(offset + vector_->size(), result.size());
+  result.copy(vector_.get(), offset, 0, vector_->size());
+}
+
 } // namespace facebook::velox::exec
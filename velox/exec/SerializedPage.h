@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/memory/ByteStream.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
 
@@ -36,6 +37,12 @@ class SerializedPageBase {
 
   /// Returns a clone of the IOBuf.
   virtual std::unique_ptr<folly::IOBuf> getIOBuf() const = 0;
+
+  /// Returns the vector of a VectorPage, nullptr for pages of serialized
+  /// data.
+  virtual RowVectorPtr vector() const {
+    return nullptr;
+  }
 };
 
 /// Corresponds to Presto SerializedPage, i.e. a container for serialized
@@ -92,6 +99,63 @@ class PrestoSerializedPage : public SerializedPageBase {
   std::function<void(folly::IOBuf&)> onDestructionCb_;
 };
 
+/// A page of an exchange between tasks in the same process that holds the
+/// rows as a vector instead of serializing them. The consumer copies the rows
+/// into its own memory pool, so that the data is neither serialized nor
+/// deserialized and the memory of the producer is released as soon as the
+/// page is consumed. The page can not be sent over the network:
+/// prepareStreamForDeserialize() and getIOBuf() throw.
+class VectorPage : public SerializedPageBase {
+ public:
+  /// 'bytes' is the estimated serialized size of 'vector', used for flow
+  /// control. 'releaseFn' is kept until the page is destroyed. It must hold a
+  /// reference to whatever owns the memory pools of 'vector', e.g. the
+  /// producer task.
+  VectorPage(
+      RowVectorPtr vector,
+      uint64_t bytes,
+      std::function<void()> releaseFn = nullptr);
+
+  ~VectorPage() override;
+
+  uint64_t size() const override {
+    return bytes_;
+  }
+
+  std::optional<int64_t> numRows() const override {
+    return vector_->size();
+  }
+
+  std::unique_ptr<ByteInputStream> prepareStreamForDeserialize() override {
+    VELOX_UNSUPPORTED("VectorPage can not be deserialized");
+  }
+
+  std::unique_ptr<folly::IOBuf> getIOBuf() const override {
+    VELOX_UNSUPPORTED("VectorPage can not be serialized");
+  }
+
+  RowVectorPtr vector() const override {
+    return vector_;
+  }
+
+  /// Returns another page with the same vector, for handing the page to a
+  /// consumer while the output buffer keeps it until acknowledged.
+  std::unique_ptr<VectorPage> share() const {
+    return std::make_unique<VectorPage>(vector_, bytes_, releaseFn_);
+  }
+
+  /// Copies the rows into 'result' starting at 'offset' of 'result'. 'result'
+  /// must have at least 'offset' + numRows() rows. If 'result' is in a
+  /// different memory pool than the vector, strings are copied as well, so
+  /// that 'result' does not reference the memory of the producer.
+  void copyTo(RowVector& result, vector_size_t offset) const;
+
+ private:
+  const std::function<void()> releaseFn_;
+  RowVectorPtr vector_;
+  const uint64_t bytes_;
+};
+
 // TODO: Remove after fully migration to new SerializedPageBase and
 // PrestoSerializedPage API.
 using SerializedPage = PrestoSerializedPage;
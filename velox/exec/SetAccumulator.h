@@ -218,6 +218,14 @@ struct StringViewSetAccumulator {
     }
   }
 
+  /// Adds a non-null string without copying it. The caller keeps the string
+  /// alive until free() is called. No-op if the value was added before.
+  void addUnownedValue(StringView value) {
+    const auto cnt = base.uniqueValues.size();
+    base.uniqueValues.insert(
+        {value, base.nullIndex.has_value() ? cnt + 1 : cnt});
+  }
+
   size_t size() const {
     return base.size();
   }
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SlowestSplits.h"
+
+#include <algorithm>
+
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+bool slower(const ScanSplitTiming& lhs, const ScanSplitTiming& rhs) {
+  return lhs.wallNanos > rhs.wallNanos;
+}
+
+} // namespace
+
+std::string ScanSplitTiming::toString() const {
+  return fmt::format(
+      "{} in node {}: wall {} queue {} {}",
+      split,
+      planNodeId,
+      succinctNanos(wallNanos),
+      succinctNanos(queueWallNanos),
+      reader.toString());
+}
+
+void SlowestSplits::add(ScanSplitTiming timing) {
+  if (maxSplits_ == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (splits_.size() < maxSplits_) {
+    splits_.push_back(std::move(timing));
+    std::push_heap(splits_.begin(), splits_.end(), slower);
+    return;
+  }
+  if (timing.wallNanos <= splits_.front().wallNanos) {
+    return;
+  }
+  std::pop_heap(splits_.begin(), splits_.end(), slower);
+  splits_.back() = std::move(timing);
+  std::push_heap(splits_.begin(), splits_.end(), slower);
+}
+
+std::vector<ScanSplitTiming> SlowestSplits::splits() const {
+  std::vector<ScanSplitTiming> result;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    result = splits_;
+  }
+  std::sort(result.begin(), result.end(), slower);
+  return result;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/connectors/Connector.h"
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// The timing of a split read by a TableScan.
+struct ScanSplitTiming {
+  core::PlanNodeId planNodeId;
+  /// ConnectorSplit::toString() of the split.
+  std::string split;
+  /// Wall time from Task::addSplit() to the TableScan taking the split.
+  uint64_t queueWallNanos{0};
+  /// Wall time from the TableScan taking the split to the end of the split.
+  uint64_t wallNanos{0};
+  /// The timing of the split in the DataSource.
+  connector::SplitTiming reader;
+
+  std::string toString() const;
+};
+
+/// The slowest splits by wall time of the table scans of a task, to find the
+/// files behind scan stragglers. Keeps up to 'maxSplits' splits. Thread safe.
+class SlowestSplits {
+ public:
+  explicit SlowestSplits(uint32_t maxSplits) : maxSplits_(maxSplits) {}
+
+  /// Keeps 'timing' if it is among the 'maxSplits' slowest splits so far.
+  void add(ScanSplitTiming timing);
+
+  /// Returns the splits from the slowest.
+  std::vector<ScanSplitTiming> splits() const;
+
+ private:
+  const uint32_t maxSplits_;
+
+  mutable std::mutex mutex_;
+  // Heap with the fastest of the kept splits on top.
+  std::vector<ScanSplitTiming> splits_;
+};
+
+} // namespace facebook::velox::exec
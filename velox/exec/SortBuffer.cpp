@@ -15,6 +15,9 @@
  */
 
 #include "SortBuffer.h"
+
+#include <algorithm>
+
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Spiller.h"
 
@@ -148,6 +151,56 @@ void SortBuffer::noMoreInput() {
   pool_->release();
 }
 
+std::vector<char*, memory::StlAllocator<char*>> SortBuffer::takeSortedRows() {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK(!hasSpilled());
+  VELOX_CHECK_EQ(numOutputRows_, 0);
+  VELOX_CHECK_EQ(numInputRows_, sortedRows_.size());
+  auto rows = std::move(sortedRows_);
+  sortedRows_.clear();
+  numInputRows_ = 0;
+  return rows;
+}
+
+void SortBuffer::mergeSortedRuns(
+    const std::vector<folly::Range<char* const*>>& runs) {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK_EQ(numInputRows_, 0);
+  VELOX_CHECK(sortedRows_.empty());
+  size_t numRows = 0;
+  for (const auto& run : runs) {
+    numRows += run.size();
+  }
+  sortedRows_.reserve(numRows);
+  // Concatenates the runs and merges adjacent runs pairwise until one is left.
+  std::vector<size_t> runEnds{0};
+  for (const auto& run : runs) {
+    if (!run.empty()) {
+      sortedRows_.insert(sortedRows_.end(), run.begin(), run.end());
+      runEnds.push_back(sortedRows_.size());
+    }
+  }
+  const auto less = [&](const char* left, const char* right) {
+    return compareRows(left, right) < 0;
+  };
+  while (runEnds.size() > 2) {
+    std::vector<size_t> mergedEnds{0};
+    for (auto i = 2; i < runEnds.size(); i += 2) {
+      std::inplace_merge(
+          sortedRows_.begin() + runEnds[i - 2],
+          sortedRows_.begin() + runEnds[i - 1],
+          sortedRows_.begin() + runEnds[i],
+          less);
+      mergedEnds.push_back(runEnds[i]);
+    }
+    if (runEnds.size() % 2 == 0) {
+      mergedEnds.push_back(runEnds.back());
+    }
+    runEnds = std::move(mergedEnds);
+  }
+  numInputRows_ = sortedRows_.size();
+}
+
 RowVectorPtr SortBuffer::getOutput(vector_size_t maxOutputRows) {
   SCOPE_EXIT {
     pool_->release();
@@ -402,12 +455,28 @@ void SortBuffer::prepareOutput(vector_size_t batchSize) {
 
 void SortBuffer::getOutputWithoutSpill() {
   VELOX_DCHECK_EQ(numInputRows_, sortedRows_.size());
+  std::vector<column_index_t> columnIndices;
+  std::vector<VectorPtr> results;
+  columnIndices.reserve(columnMap_.size());
+  results.reserve(columnMap_.size());
   for (const auto& columnProjection : columnMap_) {
-    data_->extractColumn(
+    columnIndices.push_back(columnProjection.inputChannel);
+    results.push_back(output_->childAt(columnProjection.outputChannel));
+  }
+  if (outputExtractionExecutor_ != nullptr &&
+      output_->size() >= parallelExtractionMinRows_) {
+    data_->extractColumnsParallel(
+        sortedRows_.data() + numOutputRows_,
+        output_->size(),
+        columnIndices,
+        results,
+        outputExtractionExecutor_);
+  } else {
+    data_->extractColumns(
         sortedRows_.data() + numOutputRows_,
         output_->size(),
-        columnProjection.inputChannel,
-        output_->childAt(columnProjection.outputChannel));
+        columnIndices,
+        results);
   }
   numOutputRows_ += output_->size();
 }
@@ -69,6 +69,33 @@ class SortBuffer {
 
   std::optional<uint64_t> estimateOutputRowSize() const;
 
+  /// Returns the sorted rows and leaves this buffer without rows. Used for
+  /// merging the sorted rows of peer drivers in parallel. May only be called
+  /// after noMoreInput() if the buffer has not spilled and before any output.
+  std::vector<char*, memory::StlAllocator<char*>> takeSortedRows();
+
+  /// Sets the output of this buffer to the merge of 'runs'. Each run is sorted
+  /// by the sorting keys and consists of rows of sort buffers with the same
+  /// layout as this, which the caller keeps alive until the output is
+  /// produced. May only be called after takeSortedRows().
+  void mergeSortedRuns(const std::vector<folly::Range<char* const*>>& runs);
+
+  /// Compares 'left' and 'right' by the sorting keys. The rows may belong to
+  /// any sort buffer with the same layout as this.
+  int32_t compareRows(const char* left, const char* right) const {
+    return data_->compareRows(left, right, sortCompareFlags_);
+  }
+
+  /// Extracts the columns of output batches of at least 'minRows' rows in
+  /// parallel on 'executor'. Must not be used with spilling.
+  void setParallelOutputExtraction(
+      folly::Executor* executor,
+      vector_size_t minRows) {
+    VELOX_CHECK(!canSpill());
+    outputExtractionExecutor_ = executor;
+    parallelExtractionMinRows_ = minRows;
+  }
+
  private:
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
@@ -170,5 +197,10 @@ class SortBuffer {
 
   // The number of rows that has been returned.
   uint64_t numOutputRows_{0};
+
+  // Executor for extracting the columns of output batches of at least
+  // 'parallelExtractionMinRows_' rows in parallel. nullptr if not used.
+  folly::Executor* outputExtractionExecutor_{nullptr};
+  vector_size_t parallelExtractionMinRows_{0};
 };
 } // namespace facebook::velox::exec
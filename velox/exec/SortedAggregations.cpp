@@ -292,7 +292,7 @@ bool SortedAggregations::compareRowsWithKeys(
 }
 
 void SortedAggregations::sortSingleGroup(
-    std::vector<char*>& groupRows,
+    folly::Range<char**> groupRows,
     const SortingSpec& sortingSpec) {
   std::sort(
       groupRows.begin(),
@@ -302,123 +302,89 @@ void SortedAggregations::sortSingleGroup(
       });
 }
 
-vector_size_t SortedAggregations::extractSingleGroup(
-    std::vector<char*>& groupRows,
+void SortedAggregations::addSortedRows(
+    const std::vector<char*>& rows,
+    std::vector<char*>& rowGroups,
     const AggregateInfo& aggregate,
     std::vector<VectorPtr>& inputVectors) {
-  const auto numGroupRows = groupRows.size();
-
-  std::vector<vector_size_t> rowNumbers;
+  const auto numRows = rows.size();
+  SelectivityVector selectedRows(numRows);
   if (aggregate.mask) {
     FlatVectorPtr<bool> mask = BaseVector::create<FlatVector<bool>>(
-        BOOLEAN(), numGroupRows, inputData_->pool());
+        BOOLEAN(), numRows, inputData_->pool());
     inputData_->extractColumn(
-        groupRows.data(),
-        numGroupRows,
-        inputMapping_[aggregate.mask.value()],
-        mask);
-
-    rowNumbers.reserve(numGroupRows);
-    for (auto i = 0; i < numGroupRows; ++i) {
-      if (!mask->isNullAt(i) && mask->valueAt(i)) {
-        rowNumbers.push_back(i);
+        rows.data(), numRows, inputMapping_[aggregate.mask.value()], mask);
+    for (auto i = 0; i < numRows; ++i) {
+      if (mask->isNullAt(i) || !mask->valueAt(i)) {
+        selectedRows.setValid(i, false);
       }
     }
-
-    if (rowNumbers.empty()) {
-      return 0;
+    selectedRows.updateBounds();
+    if (!selectedRows.hasSelections()) {
+      return;
     }
   }
 
   const auto numInputs = aggregate.inputs.size();
   VELOX_CHECK_EQ(numInputs, inputVectors.size());
-
-  const auto numRows = aggregate.mask ? rowNumbers.size() : numGroupRows;
-
   for (auto i = 0; i < numInputs; ++i) {
     if (aggregate.inputs[i] == kConstantChannel) {
-      inputVectors[i] = aggregate.constantInputs[i];
+      inputVectors[i] =
+          BaseVector::wrapInConstant(numRows, 0, aggregate.constantInputs[i]);
+      continue;
+    }
+    const auto columnIndex = inputMapping_[aggregate.inputs[i]];
+    if (inputVectors[i] == nullptr) {
+      inputVectors[i] = BaseVector::create(
+          inputData_->keyTypes()[columnIndex], numRows, inputData_->pool());
     } else {
-      const auto columnIndex = inputMapping_[aggregate.inputs[i]];
-      if (inputVectors[i] == nullptr) {
-        inputVectors[i] = BaseVector::create(
-            inputData_->keyTypes()[columnIndex], numRows, inputData_->pool());
-      } else {
-        BaseVector::prepareForReuse(inputVectors[i], numRows);
-      }
-
-      if (aggregate.mask) {
-        inputData_->extractColumn(
-            groupRows.data(),
-            folly::Range(rowNumbers.data(), rowNumbers.size()),
-            columnIndex,
-            0, // resultOffset
-            inputVectors[i]);
-      } else {
-        inputData_->extractColumn(
-            groupRows.data(), numRows, columnIndex, inputVectors[i]);
-      }
+      BaseVector::prepareForReuse(inputVectors[i], numRows);
     }
+    inputData_->extractColumn(
+        rows.data(), numRows, columnIndex, inputVectors[i]);
   }
 
-  return numRows;
+  // The aggregate sees the rows of each group in order.
+  aggregate.function->addRawInput(
+      rowGroups.data(), selectedRows, inputVectors, false);
 }
 
 void SortedAggregations::extractValues(
     folly::Range<char**> groups,
     const RowVectorPtr& result) {
   raw_vector<int32_t> indices(pool_);
-  SelectivityVector rows;
-  std::vector<char*> groupRows;
+  // The sorted rows of consecutive groups and the group of each row.
+  std::vector<char*> rows;
+  std::vector<char*> rowGroups;
   for (const auto& [sortingSpec, aggregates] : aggregates_) {
-    std::vector<VectorPtr> inputVectors;
-    size_t numInputColumns = 0;
+    std::vector<std::vector<VectorPtr>> inputVectors;
+    inputVectors.reserve(aggregates.size());
     for (const auto& aggregate : aggregates) {
-      numInputColumns += aggregate->inputs.size();
+      inputVectors.emplace_back(aggregate->inputs.size());
     }
-    inputVectors.resize(numInputColumns);
 
-    // For each group, sort inputs, add them to aggregate.
-    for (auto* group : groups) {
-      auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
-      if (accumulator->size == 0) {
+    // Sorts the rows of each group and adds the rows of many small groups to
+    // the aggregates at a time. The per-call cost of extracting the inputs
+    // and adding them to an aggregate is then paid per batch, not per group.
+    for (auto i = 0; i < groups.size(); ++i) {
+      auto* accumulator = reinterpret_cast<RowPointers*>(groups[i] + offset_);
+      if (accumulator->size > 0) {
+        const auto offset = rows.size();
+        rows.resize(offset + accumulator->size);
+        rowGroups.resize(rows.size(), groups[i]);
+        folly::Range<char**> groupRows(rows.data() + offset, accumulator->size);
+        accumulator->read(groupRows);
+        sortSingleGroup(groupRows, sortingSpec);
+      }
+      if (rows.empty() ||
+          (rows.size() < kMaxBatchRows && i + 1 < groups.size())) {
         continue;
       }
-
-      groupRows.resize(accumulator->size);
-      accumulator->read(folly::Range(groupRows.data(), groupRows.size()));
-
-      sortSingleGroup(groupRows, sortingSpec);
-
-      size_t firstInputColumn = 0;
-      for (const auto& aggregate : aggregates) {
-        std::vector<VectorPtr> aggregateInputs;
-        aggregateInputs.reserve(aggregate->inputs.size());
-        for (auto i = 0; i < aggregate->inputs.size(); ++i) {
-          aggregateInputs.push_back(
-              std::move(inputVectors[firstInputColumn + i]));
-        }
-
-        // TODO Process group rows in batches to avoid creating very large input
-        // vectors.
-        const auto numRows =
-            extractSingleGroup(groupRows, *aggregate, aggregateInputs);
-        if (numRows == 0) {
-          firstInputColumn += aggregateInputs.size();
-          // Mask must be false for all 'groupRows'.
-          continue;
-        }
-
-        rows.resize(numRows);
-        aggregate->function->addSingleGroupRawInput(
-            group, rows, aggregateInputs, false);
-
-        for (auto i = 0; i < aggregate->inputs.size(); ++i) {
-          inputVectors[firstInputColumn + i] = std::move(aggregateInputs[i]);
-        }
-
-        firstInputColumn += aggregateInputs.size();
+      for (auto j = 0; j < aggregates.size(); ++j) {
+        addSortedRows(rows, rowGroups, *aggregates[j], inputVectors[j]);
       }
+      rows.clear();
+      rowGroups.clear();
     }
 
     for (const auto& aggregate : aggregates) {
@@ -79,7 +79,8 @@ class SortedAggregations {
       vector_size_t index);
 
   /// Sorts input row for the specified groups, computes aggregations and stores
-  /// results in the specified 'result' vector.
+  /// results in the specified 'result' vector. The sorted rows of many groups
+  /// are added to each aggregate in one batch of up to kMaxBatchRows rows.
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result);
 
   uint64_t inputRowBytes() const {
@@ -89,6 +90,10 @@ class SortedAggregations {
   /// Clears all data accumulated so far. Used to release memory after spilling.
   void clear();
 
+  /// The number of rows after which the sorted rows of the groups so far are
+  /// added to the aggregates. A larger group is added in one batch.
+  static constexpr vector_size_t kMaxBatchRows = 10'000;
+
  private:
   void addNewRow(char* group, char* newRow);
 
@@ -103,11 +108,14 @@ class SortedAggregations {
       const SortingSpec& sortingSpec);
 
   void sortSingleGroup(
-      std::vector<char*>& groupRows,
+      folly::Range<char**> groupRows,
       const SortingSpec& sortingSpec);
 
-  vector_size_t extractSingleGroup(
-      std::vector<char*>& groupRows,
+  // Adds 'rows' to 'aggregate'. 'rowGroups' has the group of each row. The
+  // rows of each group are sorted and next to each other.
+  void addSortedRows(
+      const std::vector<char*>& rows,
+      std::vector<char*>& rowGroups,
       const AggregateInfo& aggregate,
       std::vector<VectorPtr>& inputVectors);
 
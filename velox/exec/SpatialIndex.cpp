@@ -27,20 +27,10 @@ std::vector<size_t> RTreeLevel::query(
     const Envelope& queryEnv,
     const std::vector<size_t>& branchIndices) const {
   std::vector<size_t> result;
-
   for (size_t branchIdx : branchIndices) {
-    size_t startIdx = branchIdx * branchSize_;
-    size_t endIdx = std::min(startIdx + branchSize_, minXs_.size());
-    for (size_t idx = startIdx; idx < endIdx; ++idx) {
-      bool intersects = (queryEnv.maxX >= minXs_[idx]) &&
-          (queryEnv.maxY >= minYs_[idx]) && (queryEnv.minX <= maxXs_[idx]) &&
-          (queryEnv.minY <= maxYs_[idx]);
-      if (intersects) {
-        result.push_back(idx);
-      }
-    }
+    forEachIntersecting(
+        queryEnv, branchIdx, [&](size_t idx) { result.push_back(idx); });
   }
-
   return result;
 }
 
@@ -142,34 +132,39 @@ SpatialIndex::SpatialIndex(
 
 std::vector<vector_size_t> SpatialIndex::query(const Envelope& queryEnv) const {
   std::vector<vector_size_t> result;
+  query(queryEnv, result);
+  return result;
+}
+
+void SpatialIndex::query(
+    const Envelope& queryEnv,
+    std::vector<vector_size_t>& result) const {
   if (!Envelope::intersects(queryEnv, bounds_)) {
-    return result;
+    return;
   }
 
-  size_t thisLevel = levels_.size() - 1;
-  VELOX_CHECK_GT(levels_[thisLevel].size(), 0);
-  VELOX_CHECK_GT(branchSize_ + 1, levels_[thisLevel].size());
+  const size_t topLevel = levels_.size() - 1;
+  VELOX_CHECK_GT(levels_[topLevel].size(), 0);
+  VELOX_CHECK_GT(branchSize_ + 1, levels_[topLevel].size());
 
   // The top level should have only one branch.
-  std::vector<size_t> childIndices = {0};
-  for (; thisLevel > 0; --thisLevel) {
-    // Avoiding thisLevel = 0 due to int underflow
-    childIndices = levels_[thisLevel].query(queryEnv, childIndices);
-    // If we have no matches, return.
-    if (childIndices.empty()) {
-      return result;
-    }
-  }
-
-  // We're at level 0 now.  The indices index into rowIndices.
-  VELOX_DCHECK_EQ(thisLevel, 0);
-  childIndices = levels_[thisLevel].query(queryEnv, childIndices);
-  result.reserve(childIndices.size());
-  for (auto idx : childIndices) {
-    result.push_back(rowIndices_[idx]);
-  }
+  queryBranch(topLevel, 0, queryEnv, result);
+}
 
-  return result;
+void SpatialIndex::queryBranch(
+    size_t level,
+    size_t branchIndex,
+    const Envelope& queryEnv,
+    std::vector<vector_size_t>& result) const {
+  // Entry 'idx' of a level is the envelope of branch 'idx' of the level
+  // below. The entries of level 0 index into rowIndices_.
+  levels_[level].forEachIntersecting(queryEnv, branchIndex, [&](size_t idx) {
+    if (level == 0) {
+      result.push_back(rowIndices_[idx]);
+    } else {
+      queryBranch(level - 1, idx, queryEnv, result);
+    }
+  });
 }
 
 Envelope SpatialIndex::bounds() const {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <limits>
@@ -170,6 +171,27 @@ class RTreeLevel {
       const Envelope& queryEnv,
       const std::vector<size_t>& branchIndices) const;
 
+  /// Calls 'func' with the internal index of each envelope of branch
+  /// 'branchIndex' that 'queryEnv' intersects, in ascending order.
+  template <typename Func>
+  void forEachIntersecting(
+      const Envelope& queryEnv,
+      size_t branchIndex,
+      Func func) const {
+    const size_t startIdx = branchIndex * branchSize_;
+    const size_t endIdx = std::min(startIdx + branchSize_, minXs_.size());
+    for (size_t idx = startIdx; idx < endIdx; ++idx) {
+      // '&' instead of '&&' evaluates the four comparisons without branches,
+      // which the compiler vectorizes over the columns.
+      const bool intersects = (queryEnv.maxX >= minXs_[idx]) &
+          (queryEnv.maxY >= minYs_[idx]) & (queryEnv.minX <= maxXs_[idx]) &
+          (queryEnv.minY <= maxYs_[idx]);
+      if (intersects) {
+        func(idx);
+      }
+    }
+  }
+
   size_t size() const {
     return minXs_.size();
   }
@@ -216,11 +238,25 @@ class SpatialIndex {
   /// relied upon.
   std::vector<vector_size_t> query(const Envelope& queryEnv) const;
 
+  /// Like query(), but appends the row indices to 'result'. Allocates nothing
+  /// but the growth of 'result', so that a caller probing many envelopes
+  /// reuses one vector.
+  void query(const Envelope& queryEnv, std::vector<vector_size_t>& result)
+      const;
+
   /// Returns the envelope of the all envelopes in the index.
   /// The returned envelope will have index = -1.
   Envelope bounds() const;
 
  private:
+  // Appends to 'result' the row indices of the envelopes under branch
+  // 'branchIndex' of levels_[level] that 'queryEnv' intersects.
+  void queryBranch(
+      size_t level,
+      size_t branchIndex,
+      const Envelope& queryEnv,
+      std::vector<vector_size_t>& result) const;
+
   uint32_t branchSize_ = kDefaultRTreeBranchSize;
 
   Envelope bounds_ = Envelope::empty();
@@ -403,7 +403,7 @@ void SpatialJoinProbe::addProbeRowOutput() {
   // Find the candidates for each probe row from the spatial index.  Only do
   // this at the start for each row.
   if (buildVectorIndex_ == 0 && candidateIndex_ == 0) {
-    candidateBuildRows_ = querySpatialIndex();
+    querySpatialIndex();
   }
 
   while (!isProbeRowDone()) {
@@ -450,21 +450,20 @@ void SpatialJoinProbe::addBuildVectorOutput(const RowVectorPtr& buildVector) {
   outputBuilder_.copyBuildValues(buildVector);
 }
 
-std::vector<int32_t> SpatialJoinProbe::querySpatialIndex() {
+void SpatialJoinProbe::querySpatialIndex() {
   VELOX_CHECK(spatialIndex_.has_value());
   VELOX_CHECK_NOT_NULL(spatialIndex_.value());
 
+  candidateBuildRows_.clear();
   if (decodedGeometryCol_.isNullAt(probeRow_)) {
-    return std::vector<int32_t>{};
+    return;
   }
 
   // Always apply radius to build side, not probe side.
   Envelope envelope = SpatialJoinBuild::readEnvelope(
       decodedGeometryCol_.valueAt<StringView>(probeRow_), 0 /* radius */);
-  std::vector<int32_t> candidates = spatialIndex_.value()->query(envelope);
-  std::sort(candidates.begin(), candidates.end());
-
-  return candidates;
+  spatialIndex_.value()->query(envelope, candidateBuildRows_);
+  std::sort(candidateBuildRows_.begin(), candidateBuildRows_.end());
 }
 
 BufferPtr SpatialJoinProbe::makeBuildVectorIndices(vector_size_t vectorSize) {
@@ -216,9 +216,10 @@ class SpatialJoinProbe : public Operator {
     candidateOffsetForCurrentBuildVector_ = candidateIndex_;
   }
 
-  // Calculate candidate build rows from spatialIndex_ for the current probe
-  // row. This should be done each time the probe is advanced.
-  std::vector<int32_t> querySpatialIndex();
+  // Sets candidateBuildRows_ to the build rows from spatialIndex_ for the
+  // current probe row, reusing its memory. This should be done each time the
+  // probe is advanced.
+  void querySpatialIndex();
 
   // Evaluates the spatial joinCondition for a given build vector. This method
   // sets `filterOutput_` and `decodedFilterResult_`, which will be ready to
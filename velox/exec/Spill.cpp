@@ -139,14 +139,22 @@ SpillState::SpillState(
     const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     memory::MemoryPool* pool,
     exec::SpillStats* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    bool columnarFormat,
+    const common::GetSpillFileTargetCB& getSpillFileTargetCb,
+    const common::UpdateSpillTierBytesCB& updateSpillTierBytesCb,
+    bool dictionaryCompression)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
+      getSpillFileTargetCb_(getSpillFileTargetCb),
+      updateSpillTierBytesCb_(updateSpillTierBytesCb),
       fileNamePrefix_(fileNamePrefix),
       sortingKeys_(sortingKeys),
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       compressionKind_(compressionKind),
+      columnarFormat_(columnarFormat),
+      dictionaryCompression_(dictionaryCompression),
       prefixSortConfig_(prefixSortConfig),
       fileCreateConfig_(fileCreateConfig),
       pool_(pool),
@@ -209,10 +217,17 @@ uint64_t SpillState::appendToPartition(
   TestValue::adjust(
       "facebook::velox::exec::SpillState::appendToPartition", this);
 
-  VELOX_CHECK_NOT_NULL(
-      getSpillDirPathCb_, "Spill directory callback not specified.");
-  auto spillDir = getSpillDirPathCb_();
-  VELOX_CHECK(!spillDir.empty(), "Spill directory does not exist");
+  // With tiered spill storage, the writer picks the directory of each file
+  // and the path prefix is just the file name prefix.
+  std::string pathPrefix =
+      fmt::format("{}-spill-{}", fileNamePrefix_, id.encodedId());
+  if (getSpillFileTargetCb_ == nullptr) {
+    VELOX_CHECK_NOT_NULL(
+        getSpillDirPathCb_, "Spill directory callback not specified.");
+    auto spillDir = getSpillDirPathCb_();
+    VELOX_CHECK(!spillDir.empty(), "Spill directory does not exist");
+    pathPrefix = fmt::format("{}/{}", spillDir, pathPrefix);
+  }
 
   partitionWriters_.withWLock([&](auto& lockedWriters) {
     // Ensure that partition exist before writing.
@@ -223,14 +238,17 @@ uint64_t SpillState::appendToPartition(
               std::static_pointer_cast<const RowType>(rows->type()),
               sortingKeys_,
               compressionKind_,
-              fmt::format(
-                  "{}/{}-spill-{}", spillDir, fileNamePrefix_, id.encodedId()),
+              columnarFormat_,
+              pathPrefix,
               targetFileSize_,
               writeBufferSize_,
               fileCreateConfig_,
               updateAndCheckSpillLimitCb_,
               pool_,
-              stats_));
+              stats_,
+              getSpillFileTargetCb_,
+              updateSpillTierBytesCb_,
+              dictionaryCompression_));
     }
   });
 
@@ -346,14 +364,15 @@ std::unique_ptr<UnorderedStreamReader<BatchStream>>
 SpillPartition::createUnorderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    exec::SpillStats* spillStats) {
+    exec::SpillStats* spillStats,
+    folly::Executor* readAheadExecutor) {
   VELOX_CHECK_NOT_NULL(pool);
   std::vector<std::unique_ptr<BatchStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
     streams.push_back(
-        FileSpillBatchStream::create(
-            SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+        FileSpillBatchStream::create(SpillReadFile::create(
+            fileInfo, bufferSize, pool, spillStats, readAheadExecutor)));
   }
   files_.clear();
   return std::make_unique<UnorderedStreamReader<BatchStream>>(
@@ -364,13 +383,14 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReaderInternal(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    exec::SpillStats* spillStats) {
+    exec::SpillStats* spillStats,
+    folly::Executor* readAheadExecutor) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
     streams.push_back(
-        FileSpillMergeStream::create(
-            SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+        FileSpillMergeStream::create(SpillReadFile::create(
+            fileInfo, bufferSize, pool, spillStats, readAheadExecutor)));
   }
   files_.clear();
   // Check if the partition is empty or not.
@@ -439,14 +459,15 @@ SpillFileInfo mergeSpillFiles(
     uint64_t writeBufferSize,
     SpillFileMergeParams& mergeParams,
     memory::MemoryPool* pool,
-    exec::SpillStats* spillStats) {
+    exec::SpillStats* spillStats,
+    folly::Executor* readAheadExecutor) {
   VELOX_CHECK_GT(files.size(), 0);
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files.size());
   for (const auto& fileInfo : files) {
     streams.push_back(
-        FileSpillMergeStream::create(
-            SpillReadFile::create(fileInfo, readBufferSize, pool, spillStats)));
+        FileSpillMergeStream::create(SpillReadFile::create(
+            fileInfo, readBufferSize, pool, spillStats, readAheadExecutor)));
   }
   const auto batchRows = estimateOutputBatchRows(
       streams, mergeParams.maxBatchRows, mergeParams.maxBatchBytes);
@@ -459,13 +480,17 @@ SpillFileInfo mergeSpillFiles(
       type,
       files[0].sortingKeys,
       files[0].compressionKind,
+      files[0].columnarFormat,
       pathPrefix,
       std::numeric_limits<uint64_t>::max(),
       writeBufferSize,
       fileCreateConfig,
       updateAndCheckSpillLimitCb,
       pool,
-      spillStats);
+      spillStats,
+      nullptr,
+      nullptr,
+      files[0].dictionaryCompression);
 
   while (mergeTree->next()) {
     VectorPtr tmpRowVector = std::move(mergeParams.rowVector);
@@ -506,7 +531,10 @@ SpillPartition::createOrderedReader(
   VELOX_CHECK_NE(numMaxMergeFiles, 1);
   if (numMaxMergeFiles == 0 || files_.size() <= numMaxMergeFiles) {
     return createOrderedReaderInternal(
-        spillConfig.readBufferSize, pool, spillStats);
+        spillConfig.readBufferSize,
+        pool,
+        spillStats,
+        spillConfig.readAheadExecutor());
   }
 
   SpillFileHeap orderedFiles(files_.begin(), files_.end());
@@ -534,7 +562,8 @@ SpillPartition::createOrderedReader(
         spillConfig.writeBufferSize,
         mergeParams,
         pool,
-        spillStats);
+        spillStats,
+        spillConfig.readAheadExecutor());
     orderedFiles.push(mergedFile);
     files.clear();
   }
@@ -545,7 +574,10 @@ SpillPartition::createOrderedReader(
     orderedFiles.pop();
   }
   return createOrderedReaderInternal(
-      spillConfig.readBufferSize, pool, spillStats);
+      spillConfig.readBufferSize,
+      pool,
+      spillStats,
+      spillConfig.readAheadExecutor());
 }
 
 IterableSpillPartitionSet::IterableSpillPartitionSet() {
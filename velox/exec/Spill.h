@@ -498,12 +498,14 @@ class SpillPartition {
   /// The created reader will take the ownership of the spill files.
   /// 'bufferSize' specifies the read size from the storage. If the file
   /// system supports async read mode, then reader allocates two buffers with
-  /// one buffer prefetch ahead. 'spillStats' is provided to collect the spill
+  /// one buffer prefetch ahead. Otherwise, if 'readAheadExecutor' is set, the
+  /// prefetch is done on it. 'spillStats' is provided to collect the spill
   /// stats when reading data from spilled files.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createUnorderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      exec::SpillStats* spillStats);
+      exec::SpillStats* spillStats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   /// Create an ordered stream reader from this spill partition. If the
   /// partition has more than spillConfig.numMaxMergeFiles files, the files will
@@ -523,12 +525,14 @@ class SpillPartition {
   /// The created reader will take the ownership of the spill files.
   /// 'bufferSize' specifies the read size from the storage. If the file
   /// system supports async read mode, then reader allocates two buffers with
-  /// one buffer prefetch ahead. 'spillStats' is provided to collect the spill
+  /// one buffer prefetch ahead. Otherwise, if 'readAheadExecutor' is set, the
+  /// prefetch is done on it. 'spillStats' is provided to collect the spill
   /// stats when reading data from spilled files.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReaderInternal(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      exec::SpillStats* spillStats);
+      exec::SpillStats* spillStats,
+      folly::Executor* readAheadExecutor);
 
   SpillPartitionId id_;
   SpillFiles files_;
@@ -587,6 +591,11 @@ class SpillState {
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
   /// results. 'ioStats' is used to collect filesystem I/O stats.
+  /// 'columnarFormat' selects the spill file format, see SpillWriter. If
+  /// 'getSpillFileTargetCb' is set, it places each spill file on a tier of
+  /// the spill storage instead of 'getSpillDirectoryPath'.
+  /// 'dictionaryCompression' compresses the pages of each partition with a
+  /// trained ZSTD dictionary, see SpillWriter.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -598,7 +607,11 @@ class SpillState {
       const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       memory::MemoryPool* pool,
       exec::SpillStats* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      bool columnarFormat = false,
+      const common::GetSpillFileTargetCB& getSpillFileTargetCb = nullptr,
+      const common::UpdateSpillTierBytesCB& updateSpillTierBytesCb = nullptr,
+      bool dictionaryCompression = false);
 
   static std::vector<SpillSortKey> makeSortingKeys(
       const std::vector<CompareFlags>& compareFlags = {});
@@ -693,12 +706,17 @@ class SpillState {
   // the max spill bytes limit.
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
 
+  const common::GetSpillFileTargetCB getSpillFileTargetCb_;
+  const common::UpdateSpillTierBytesCB updateSpillTierBytesCb_;
+
   // Prefix for spill files.
   const std::string fileNamePrefix_;
   const std::vector<SpillSortKey> sortingKeys_;
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const common::CompressionKind compressionKind_;
+  const bool columnarFormat_;
+  const bool dictionaryCompression_;
   const std::optional<common::PrefixSortConfig> prefixSortConfig_;
   const std::string fileCreateConfig_;
   memory::MemoryPool* const pool_;
@@ -15,9 +15,19 @@
  */
 
 #include "velox/exec/SpillFile.h"
+#include <gflags/gflags.h>
+
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
 #include "velox/serializers/SerializedPageFile.h"
 
+DEFINE_bool(
+    velox_spill_read_mmap,
+    false,
+    "Reads spill files in the local file system from a memory mapping "
+    "instead of copying them into read buffers");
+
 namespace facebook::velox::exec {
 namespace {
 // Spilling currently uses the default PrestoSerializer which by default
@@ -26,37 +36,262 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+std::unique_ptr<serializer::presto::PrestoVectorSerde::PrestoOptions>
+makeSerdeOptions(common::CompressionKind compressionKind, bool columnarFormat) {
+  auto options =
+      std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>(
+          kDefaultUseLosslessTimestamp,
+          compressionKind,
+          0.8,
+          /*_nullsFirst=*/true,
+          /*_preserveEncodings=*/columnarFormat);
+  // Spill files are read back by the same process, so they can use the Velox
+  // only 8 byte timestamps.
+  options->compactTimestamp = true;
+  return options;
+}
+
+// Returns the single column row type of each column page of 'type' in
+// columnar format.
+std::vector<RowTypePtr> makeColumnTypes(const RowTypePtr& type) {
+  std::vector<RowTypePtr> columnTypes;
+  columnTypes.reserve(type->size());
+  for (auto i = 0; i < type->size(); ++i) {
+    columnTypes.push_back(ROW({type->nameOf(i)}, {type->childAt(i)}));
+  }
+  return columnTypes;
+}
+
+// Starts the header of a dictionary compressed spill file. The header is
+// followed by the dictionary size and the dictionary. Each page is then
+// stored as its uncompressed size, its compressed size and the compressed
+// bytes.
+constexpr int32_t kDictionaryFileMagic = 0x5a535044;
+
+// The limits of the pages buffered to train the dictionary of a writer from.
+// The dictionary is trained once per writer, i.e. per spill partition, and
+// shared by all its files. The pages are split into chunks of 'kSampleSize'
+// bytes as the trainer wants many small samples.
+constexpr size_t kMaxSamplePages = 8;
+constexpr uint64_t kMaxSampleBytes = 1 << 20;
+constexpr size_t kSampleSize = 4 << 10;
+
+constexpr size_t kMaxDictionarySize = 16 << 10;
+constexpr int32_t kDictionaryCompressionLevel = 1;
+
+bool useDictionaryCompression(bool dictionaryCompression, bool columnarFormat) {
+  return dictionaryCompression && !columnarFormat &&
+      common::ZstdDictionary::supported();
+}
+
+// Makes 'buffer' hold at least 'size' bytes. The content is not preserved.
+char* ensureBuffer(BufferPtr& buffer, size_t size, memory::MemoryPool* pool) {
+  if (buffer == nullptr || buffer->capacity() < size) {
+    buffer = AlignedBuffer::allocate<char>(size, pool);
+  }
+  return buffer->asMutable<char>();
+}
+
+template <typename T>
+void writeValue(IOBufOutputStream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
 } // namespace
 
 SpillWriter::SpillWriter(
     const RowTypePtr& type,
     const std::vector<SpillSortKey>& sortingKeys,
     common::CompressionKind compressionKind,
+    bool columnarFormat,
     const std::string& pathPrefix,
     uint64_t targetFileSize,
     uint64_t writeBufferSize,
     const std::string& fileCreateConfig,
     const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    exec::SpillStats* stats)
+    exec::SpillStats* stats,
+    const common::GetSpillFileTargetCB& getSpillFileTargetCb,
+    const common::UpdateSpillTierBytesCB& updateSpillTierBytesCb,
+    bool dictionaryCompression)
     : serializer::SerializedPageFileWriter(
           pathPrefix,
           targetFileSize,
           writeBufferSize,
           fileCreateConfig,
-          std::make_unique<
-              serializer::presto::PrestoVectorSerde::PrestoOptions>(
-              kDefaultUseLosslessTimestamp,
-              compressionKind,
-              0.8,
-              /*_nullsFirst=*/true),
+          makeSerdeOptions(
+              useDictionaryCompression(dictionaryCompression, columnarFormat)
+                  ? common::CompressionKind_NONE
+                  : compressionKind,
+              columnarFormat),
           getNamedVectorSerde("Presto"),
           pool,
           &stats->ioStats),
       type_(type),
       sortingKeys_(sortingKeys),
+      columnarFormat_(columnarFormat),
+      dictionaryCompression_(
+          useDictionaryCompression(dictionaryCompression, columnarFormat)),
       stats_(stats),
-      updateAndCheckLimitCb_(updateAndCheckSpillLimitCb) {}
+      updateAndCheckLimitCb_(updateAndCheckSpillLimitCb),
+      getSpillFileTargetCb_(getSpillFileTargetCb),
+      updateSpillTierBytesCb_(updateSpillTierBytesCb) {
+  if (columnarFormat_) {
+    columnTypes_ = makeColumnTypes(type_);
+    columnSerializer_ =
+        serde_->createBatchSerializer(pool_, serdeOptions_.get());
+  }
+}
+
+uint64_t SpillWriter::append(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  if (!columnarFormat_) {
+    return SerializedPageFileWriter::append(rows, indices);
+  }
+  VELOX_CHECK_EQ(rows->childrenSize(), columnTypes_.size());
+  for (auto i = 0; i < columnTypes_.size(); ++i) {
+    const auto column = std::make_shared<RowVector>(
+        pool_,
+        columnTypes_[i],
+        nullptr,
+        rows->size(),
+        std::vector<VectorPtr>{rows->childAt(i)});
+    // The listener makes the serializer add a checksum to the page.
+    serializer::presto::PrestoOutputStreamListener listener;
+    IOBufOutputStream out(*pool_, &listener);
+    columnSerializer_->serialize(column, indices, scratch_, &out);
+    auto page = out.getIOBuf();
+    pendingBytes_ += page->computeChainDataLength();
+    if (pendingPages_ == nullptr) {
+      pendingPages_ = std::move(page);
+    } else {
+      pendingPages_->appendToChain(std::move(page));
+    }
+  }
+  return pendingBytes_;
+}
+
+uint64_t SpillWriter::flush() {
+  if (dictionaryCompression_) {
+    if (batch_ != nullptr) {
+      IOBufOutputStream out(
+          *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+      {
+        NanosecondTimer timer(&uncompressedFlushTimeNs_);
+        batch_->flush(&out);
+      }
+      batch_.reset();
+      auto page = out.getIOBuf();
+      uncompressedBytes_ += page->computeChainDataLength();
+      uncompressedPages_.push_back(std::move(page));
+    }
+    if (dictionary_ == nullptr &&
+        uncompressedPages_.size() < kMaxSamplePages &&
+        uncompressedBytes_ < kMaxSampleBytes) {
+      return 0;
+    }
+    return writeCompressedPages();
+  }
+  if (!columnarFormat_) {
+    return SerializedPageFileWriter::flush();
+  }
+  if (pendingPages_ == nullptr) {
+    return 0;
+  }
+
+  auto* file = ensureFile();
+  VELOX_CHECK_NOT_NULL(file);
+
+  uint64_t writeTimeNs{0};
+  uint64_t writtenBytes{0};
+  {
+    NanosecondTimer timer(&writeTimeNs);
+    writtenBytes = file->write(std::move(pendingPages_));
+  }
+  pendingBytes_ = 0;
+  // The column pages are serialized on append so there is no flush time.
+  updateWriteStats(writtenBytes, 0, writeTimeNs);
+  return writtenBytes;
+}
+
+uint64_t SpillWriter::writeCompressedPages() {
+  if (uncompressedPages_.empty()) {
+    return 0;
+  }
+  // Takes the pages first as ensureFile() may close the current file, which
+  // writes the pending pages.
+  auto pages = std::move(uncompressedPages_);
+  uncompressedPages_.clear();
+  uncompressedBytes_ = 0;
+
+  uint64_t flushTimeNs{0};
+  std::swap(flushTimeNs, uncompressedFlushTimeNs_);
+  size_t maxSize{0};
+  {
+    NanosecondTimer timer(&flushTimeNs);
+    for (auto& page : pages) {
+      page->coalesce();
+      maxSize = std::max(maxSize, page->length());
+    }
+    if (dictionary_ == nullptr) {
+      std::vector<std::string_view> samples;
+      for (const auto& page : pages) {
+        for (size_t offset = 0; offset < page->length();
+             offset += kSampleSize) {
+          samples.emplace_back(
+              reinterpret_cast<const char*>(page->data()) + offset,
+              std::min(kSampleSize, page->length() - offset));
+        }
+      }
+      dictionary_ = std::make_unique<common::ZstdDictionary>(
+          common::ZstdDictionary::train(samples, kMaxDictionarySize),
+          kDictionaryCompressionLevel);
+    }
+  }
+
+  auto* file = ensureFile();
+  VELOX_CHECK_NOT_NULL(file);
+
+  const auto maxCompressedSize = dictionary_->maxCompressedLength(maxSize);
+  auto* compressed = ensureBuffer(compressionBuffer_, maxCompressedSize, pool_);
+  IOBufOutputStream out(*pool_, nullptr, 64 * 1024);
+  {
+    NanosecondTimer timer(&flushTimeNs);
+    if (file->size() == 0) {
+      const auto& dictionary = dictionary_->dictionary();
+      writeValue<int32_t>(out, kDictionaryFileMagic);
+      writeValue<int32_t>(out, dictionary.size());
+      out.write(dictionary.data(), dictionary.size());
+    }
+    for (const auto& page : pages) {
+      const auto compressedSize = dictionary_->compress(
+          reinterpret_cast<const char*>(page->data()),
+          page->length(),
+          compressed,
+          maxCompressedSize);
+      writeValue<int32_t>(out, page->length());
+      writeValue<int32_t>(out, compressedSize);
+      out.write(compressed, compressedSize);
+    }
+  }
+
+  uint64_t writeTimeNs{0};
+  uint64_t writtenBytes{0};
+  {
+    NanosecondTimer timer(&writeTimeNs);
+    writtenBytes = file->write(out.getIOBuf());
+  }
+  updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
+  return writtenBytes;
+}
+
+void SpillWriter::closeFile() {
+  if (dictionaryCompression_) {
+    writeCompressedPages();
+  }
+  SerializedPageFileWriter::closeFile();
+}
 
 void SpillWriter::updateAppendStats(
     uint64_t numRows,
@@ -67,10 +302,36 @@ void SpillWriter::updateAppendStats(
   updateGlobalSpillAppendStats(numRows, serializationTimeNs);
 }
 
+std::unique_ptr<serializer::SerializedPageFile> SpillWriter::createFile() {
+  if (getSpillFileTargetCb_ == nullptr) {
+    return SerializedPageFileWriter::createFile();
+  }
+  const auto target = getSpillFileTargetCb_();
+  currentTier_ = target.tier;
+  return serializer::SerializedPageFile::create(
+      nextFileId_++,
+      fmt::format(
+          "{}/{}-{}", target.directory, pathPrefix_, finishedFiles_.size()),
+      target.fileCreateConfig.empty() ? fileCreateConfig_
+                                      : target.fileCreateConfig,
+      ioStats_);
+}
+
 void SpillWriter::updateWriteStats(
     uint64_t spilledBytes,
     uint64_t flushTimeNs,
     uint64_t fileWriteTimeNs) {
+  if (getSpillFileTargetCb_ != nullptr) {
+    if (updateSpillTierBytesCb_ != nullptr) {
+      updateSpillTierBytesCb_(currentTier_, spilledBytes);
+    }
+    if (currentTier_ > 0) {
+      stats_->spilledOverflowBytes.fetch_add(
+          spilledBytes, std::memory_order_relaxed);
+      stats_->spillOverflowWriteTimeNanos.fetch_add(
+          fileWriteTimeNs, std::memory_order_relaxed);
+    }
+  }
   stats_->spillWrites.fetch_add(1, std::memory_order_relaxed);
   stats_->spilledBytes.fetch_add(spilledBytes, std::memory_order_relaxed);
   stats_->spillFlushTimeNanos.fetch_add(flushTimeNs, std::memory_order_relaxed);
@@ -101,7 +362,9 @@ SpillFiles SpillWriter::finish() {
             .path = fileInfo.path,
             .size = fileInfo.size,
             .sortingKeys = sortingKeys_,
-            .compressionKind = serdeOptions_->compressionKind});
+            .compressionKind = serdeOptions_->compressionKind,
+            .columnarFormat = columnarFormat_,
+            .dictionaryCompression = dictionaryCompression_});
   }
   return spillFiles;
 }
@@ -138,7 +401,9 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    exec::SpillStats* stats) {
+    exec::SpillStats* stats,
+    folly::Executor* readAheadExecutor,
+    const std::vector<column_index_t>& columns) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -147,8 +412,12 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.type,
       fileInfo.sortingKeys,
       fileInfo.compressionKind,
+      fileInfo.columnarFormat,
+      fileInfo.dictionaryCompression,
+      columns,
       pool,
-      stats));
+      stats,
+      readAheadExecutor));
 }
 
 SpillReadFile::SpillReadFile(
@@ -159,30 +428,134 @@ SpillReadFile::SpillReadFile(
     const RowTypePtr& type,
     const std::vector<SpillSortKey>& sortingKeys,
     common::CompressionKind compressionKind,
+    bool columnarFormat,
+    bool dictionaryCompression,
+    const std::vector<column_index_t>& columns,
     memory::MemoryPool* pool,
-    exec::SpillStats* stats)
+    exec::SpillStats* stats,
+    folly::Executor* readAheadExecutor)
     : serializer::SerializedPageFileReader(
           path,
           bufferSize,
           type,
           getNamedVectorSerde("Presto"),
-          std::make_unique<
-              serializer::presto::PrestoVectorSerde::PrestoOptions>(
-              kDefaultUseLosslessTimestamp,
-              compressionKind,
-              0.8,
-              /*_nullsFirst=*/true),
+          makeSerdeOptions(compressionKind, columnarFormat),
           pool,
-          &stats->ioStats),
+          &stats->ioStats,
+          readAheadExecutor,
+          FLAGS_velox_spill_read_mmap &&
+              filesystems::getFileSystem(path, nullptr)->name() == "Local FS"),
       id_(id),
       path_(path),
       size_(size),
       sortingKeys_(sortingKeys),
-      stats_(stats) {}
+      columnarFormat_(columnarFormat),
+      stats_(stats),
+      recorder_(MemoryTimelineRecorder::forCurrentOperator()) {
+  if (dictionaryCompression) {
+    readDictionary();
+  }
+  if (!columnarFormat_) {
+    return;
+  }
+  columnTypes_ = makeColumnTypes(type_);
+  readColumns_.resize(type_->size(), columns.empty());
+  for (const auto column : columns) {
+    VELOX_CHECK_LT(column, type_->size());
+    readColumns_[column] = true;
+  }
+}
+
+void SpillReadFile::readBatch(RowVectorPtr& rowVector) {
+  if (recorder_.active() && firstReadUs_ == 0) {
+    firstReadUs_ = getCurrentTimeMicro();
+  }
+  if (dictionary_ != nullptr) {
+    readCompressedBatch(rowVector);
+    return;
+  }
+  if (!columnarFormat_) {
+    SerializedPageFileReader::readBatch(rowVector);
+    return;
+  }
+
+  std::vector<VectorPtr> children(columnTypes_.size());
+  std::optional<vector_size_t> numRows;
+  for (auto i = 0; i < columnTypes_.size(); ++i) {
+    vector_size_t columnRows;
+    if (readColumns_[i]) {
+      RowVectorPtr column;
+      VectorStreamGroup::read(
+          input_.get(),
+          pool_,
+          columnTypes_[i],
+          serde_,
+          &column,
+          readOptions_.get());
+      columnRows = column->size();
+      children[i] = column->childAt(0);
+    } else {
+      columnRows = skipPage();
+      children[i] =
+          BaseVector::createNullConstant(type_->childAt(i), columnRows, pool_);
+    }
+    if (numRows.has_value()) {
+      VELOX_CHECK_EQ(
+          numRows.value(),
+          columnRows,
+          "Mismatched column page sizes in spill file {}",
+          path_);
+    }
+    numRows = columnRows;
+  }
+  rowVector = std::make_shared<RowVector>(
+      pool_, type_, nullptr, numRows.value_or(0), std::move(children));
+}
+
+vector_size_t SpillReadFile::skipPage() {
+  // A page starts with the number of rows, the codec marker, the uncompressed
+  // size, the compressed size and the checksum, followed by the compressed
+  // size bytes of data.
+  const auto numRows = input_->read<int32_t>();
+  input_->read<int8_t>();
+  input_->read<int32_t>();
+  const auto compressedSize = input_->read<int32_t>();
+  input_->read<int64_t>();
+  input_->skip(compressedSize);
+  return numRows;
+}
+
+void SpillReadFile::readDictionary() {
+  const auto magic = input_->read<int32_t>();
+  VELOX_CHECK_EQ(
+      magic,
+      kDictionaryFileMagic,
+      "Bad dictionary compressed spill file header in {}",
+      path_);
+  const auto size = input_->read<int32_t>();
+  std::string dictionary(size, '\0');
+  input_->readBytes(dictionary.data(), size);
+  dictionary_ = std::make_unique<common::ZstdDictionary>(
+      std::move(dictionary), kDictionaryCompressionLevel);
+}
+
+void SpillReadFile::readCompressedBatch(RowVectorPtr& rowVector) {
+  const auto uncompressedSize = input_->read<int32_t>();
+  const auto compressedSize = input_->read<int32_t>();
+  auto* compressed = ensureBuffer(compressedPage_, compressedSize, pool_);
+  input_->readBytes(compressed, compressedSize);
+  auto* uncompressed = ensureBuffer(uncompressedPage_, uncompressedSize, pool_);
+  dictionary_->decompress(
+      compressed, compressedSize, uncompressed, uncompressedSize);
+  BufferInputStream page({ByteRange{
+      reinterpret_cast<uint8_t*>(uncompressed), uncompressedSize, 0}});
+  VectorStreamGroup::read(
+      &page, pool_, type_, serde_, &rowVector, readOptions_.get());
+}
 
 void SpillReadFile::updateFinalStats() {
   VELOX_CHECK(input_->atEnd());
-  const auto readStats = input_->stats();
+  const auto readStats = this->readStats();
   updateGlobalSpillReadStats(
       readStats.numReads, readStats.readBytes, readStats.readTimeNs);
   stats_->spillReads.fetch_add(readStats.numReads, std::memory_order_relaxed);
@@ -190,6 +563,9 @@ void SpillReadFile::updateFinalStats() {
       readStats.readBytes, std::memory_order_relaxed);
   stats_->spillReadTimeNanos.fetch_add(
       readStats.readTimeNs, std::memory_order_relaxed);
+  if (firstReadUs_ != 0) {
+    recorder_.record(MemoryTimeline::EventType::kRestore, firstReadUs_, size_);
+  }
 };
 
 void SpillReadFile::updateSerializationTimeStats(uint64_t timeNs) {
@@ -22,8 +22,10 @@
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/TreeOfLosers.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
+#include "velox/exec/MemoryTimeline.h"
 #include "velox/exec/SpillStats.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/serializers/SerializedPageFile.h"
@@ -43,6 +45,11 @@ struct SpillFileInfo {
   uint64_t size;
   std::vector<SpillSortKey> sortingKeys;
   common::CompressionKind compressionKind;
+  /// True if the file is written in the columnar format. See SpillWriter.
+  bool columnarFormat{false};
+  /// True if the pages are compressed with a ZSTD dictionary stored in the
+  /// file header. See SpillWriter.
+  bool dictionaryCompression{false};
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -63,17 +70,38 @@ class SpillWriter : public serializer::SerializedPageFileWriter {
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
+  ///
+  /// If 'columnarFormat' is true, each column of each write() is serialized
+  /// as a separate page with its own compression and checksum. Dictionary and
+  /// constant encodings are preserved. This lets the reader skip the columns
+  /// it does not need, e.g. read only the sort keys of a file.
+  ///
+  /// If 'getSpillFileTargetCb' is set, each new file is created in the
+  /// directory it returns and 'pathPrefix' is the file name prefix. The bytes
+  /// written are reported to 'updateSpillTierBytesCb' for the tier of the
+  /// file.
+  ///
+  /// If 'dictionaryCompression' is true, the pages are serialized without
+  /// compression and the first few are buffered to train a ZSTD dictionary
+  /// from. Each file then starts with the dictionary and every page is
+  /// compressed with it, which compresses small pages much better than
+  /// 'compressionKind'. Ignored in columnar format or if Velox is built
+  /// without ZSTD.
   SpillWriter(
       const RowTypePtr& type,
       const std::vector<SpillSortKey>& sortingKeys,
       common::CompressionKind compressionKind,
+      bool columnarFormat,
       const std::string& pathPrefix,
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
       const std::string& fileCreateConfig,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      exec::SpillStats* stats);
+      exec::SpillStats* stats,
+      const common::GetSpillFileTargetCB& getSpillFileTargetCb = nullptr,
+      const common::UpdateSpillTierBytesCB& updateSpillTierBytesCb = nullptr,
+      bool dictionaryCompression = false);
 
   /// Finishes this file writer and returns the written spill files info.
   ///
@@ -85,6 +113,21 @@ class SpillWriter : public serializer::SerializedPageFileWriter {
   std::vector<uint32_t> testingSpilledFileIds() const;
 
  private:
+  uint64_t append(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices) override;
+
+  uint64_t flush() override;
+
+  std::unique_ptr<serializer::SerializedPageFile> createFile() override;
+
+  void closeFile() override;
+
+  // Compresses 'uncompressedPages_' with 'dictionary_' and writes them to the
+  // current file. Trains 'dictionary_' from the pages if not yet trained.
+  // Returns the written size.
+  uint64_t writeCompressedPages();
+
   // Invoked to increment the number of spilled files and the file size.
   void updateFileStats(
       const serializer::SerializedPageFile::FileInfo& fileInfo) override;
@@ -103,11 +146,49 @@ class SpillWriter : public serializer::SerializedPageFileWriter {
 
   const std::vector<SpillSortKey> sortingKeys_;
 
+  const bool columnarFormat_;
+
+  const bool dictionaryCompression_;
+
   exec::SpillStats* const stats_;
 
   // Updates the aggregated bytes of this query, and throws if exceeds
   // the max bytes limit.
   const common::UpdateAndCheckSpillLimitCB updateAndCheckLimitCb_;
+
+  const common::GetSpillFileTargetCB getSpillFileTargetCb_;
+
+  const common::UpdateSpillTierBytesCB updateSpillTierBytesCb_;
+
+  // The tier of the current file if 'getSpillFileTargetCb_' is set.
+  uint32_t currentTier_{0};
+
+  // The single column row types of the column pages in columnar format.
+  std::vector<RowTypePtr> columnTypes_;
+
+  // Serializes the column pages in columnar format.
+  std::unique_ptr<BatchVectorSerializer> columnSerializer_;
+
+  Scratch scratch_;
+
+  // The serialized column pages not yet written to file in columnar format.
+  std::unique_ptr<folly::IOBuf> pendingPages_;
+  uint64_t pendingBytes_{0};
+
+  // Compresses the pages of all the files of 'this' if
+  // 'dictionaryCompression_' is true. Null until trained.
+  std::unique_ptr<common::ZstdDictionary> dictionary_;
+
+  // The serialized pages not yet compressed and written to file with
+  // dictionary compression. Also the samples to train 'dictionary_' from.
+  std::vector<std::unique_ptr<folly::IOBuf>> uncompressedPages_;
+  uint64_t uncompressedBytes_{0};
+
+  // The time to serialize 'uncompressedPages_'.
+  uint64_t uncompressedFlushTimeNs_{0};
+
+  // Holds the compressed pages before they are written.
+  BufferPtr compressionBuffer_;
 };
 
 /// Represents a spill file for read which turns the serialized spilled data
@@ -119,11 +200,19 @@ class SpillWriter : public serializer::SerializedPageFileWriter {
 /// rmdir() call.
 class SpillReadFile : public serializer::SerializedPageFileReader {
  public:
+  /// If 'readAheadExecutor' is set, the next 'bufferSize' bytes of the file
+  /// are read on it while the current buffer is consumed. The read-ahead
+  /// buffer is allocated from 'pool'. 'columns' are the indices of the columns
+  /// to read. If not empty, the other columns of a columnar format file are
+  /// not deserialized and are returned as null constants. All columns are
+  /// read from row format files.
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      exec::SpillStats* stats);
+      exec::SpillStats* stats,
+      folly::Executor* readAheadExecutor = nullptr,
+      const std::vector<column_index_t>& columns = {});
 
   uint32_t id() const {
     return id_;
@@ -151,12 +240,29 @@ class SpillReadFile : public serializer::SerializedPageFileReader {
       const RowTypePtr& type,
       const std::vector<SpillSortKey>& sortingKeys,
       common::CompressionKind compressionKind,
+      bool columnarFormat,
+      bool dictionaryCompression,
+      const std::vector<column_index_t>& columns,
       memory::MemoryPool* pool,
-      exec::SpillStats* stats);
+      exec::SpillStats* stats,
+      folly::Executor* readAheadExecutor);
 
   // Records spill read stats at the end of read input.
   void updateFinalStats() override;
 
+  void readBatch(RowVectorPtr& rowVector) override;
+
+  // Skips the next page in 'input_' without deserializing it. Returns the
+  // number of rows in the page.
+  vector_size_t skipPage();
+
+  // Reads the dictionary from the file header into 'dictionary_'.
+  void readDictionary();
+
+  // Decompresses the next page in 'input_' with 'dictionary_' and
+  // deserializes it into 'rowVector'.
+  void readCompressedBatch(RowVectorPtr& rowVector);
+
   void updateSerializationTimeStats(uint64_t timeNs) override;
 
   // The spill file id which is monotonically increasing and unique for each
@@ -170,7 +276,29 @@ class SpillReadFile : public serializer::SerializedPageFileReader {
 
   const std::vector<SpillSortKey> sortingKeys_;
 
+  const bool columnarFormat_;
+
   exec::SpillStats* const stats_;
+
+  // Records the read of the file as a restore of the operator that opened it.
+  const MemoryTimelineRecorder recorder_;
+
+  // The time of the first read if 'recorder_' is active.
+  uint64_t firstReadUs_{0};
+
+  // The single column row types of the column pages in columnar format.
+  std::vector<RowTypePtr> columnTypes_;
+
+  // True for the columns to deserialize in columnar format.
+  std::vector<bool> readColumns_;
+
+  // Decompresses the pages of a dictionary compressed file.
+  std::unique_ptr<common::ZstdDictionary> dictionary_;
+
+  // The compressed and decompressed bytes of the current page of a
+  // dictionary compressed file.
+  BufferPtr compressedPage_;
+  BufferPtr uncompressedPage_;
 };
 
 } // namespace facebook::velox::exec
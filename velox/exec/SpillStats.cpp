@@ -53,7 +53,9 @@ SpillStats::SpillStats(
     uint64_t _spillReadBytes,
     uint64_t _spillReads,
     uint64_t _spillReadTimeNanos,
-    uint64_t _spillDeserializationTimeNanos) {
+    uint64_t _spillDeserializationTimeNanos,
+    uint64_t _spilledOverflowBytes,
+    uint64_t _spillOverflowWriteTimeNanos) {
   spillRuns.store(_spillRuns, std::memory_order_relaxed);
   spilledInputBytes.store(_spilledInputBytes, std::memory_order_relaxed);
   spilledBytes.store(_spilledBytes, std::memory_order_relaxed);
@@ -76,6 +78,9 @@ SpillStats::SpillStats(
   spillReadTimeNanos.store(_spillReadTimeNanos, std::memory_order_relaxed);
   spillDeserializationTimeNanos.store(
       _spillDeserializationTimeNanos, std::memory_order_relaxed);
+  spilledOverflowBytes.store(_spilledOverflowBytes, std::memory_order_relaxed);
+  spillOverflowWriteTimeNanos.store(
+      _spillOverflowWriteTimeNanos, std::memory_order_relaxed);
 }
 
 SpillStats::SpillStats(const SpillStats& other) {
@@ -144,6 +149,12 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillDeserializationTimeNanos.fetch_add(
       other.spillDeserializationTimeNanos.load(std::memory_order_relaxed),
       std::memory_order_relaxed);
+  spilledOverflowBytes.fetch_add(
+      other.spilledOverflowBytes.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+  spillOverflowWriteTimeNanos.fetch_add(
+      other.spillOverflowWriteTimeNanos.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
   ioStats.merge(other.ioStats);
   return *this;
 }
@@ -207,6 +218,12 @@ void SpillStats::copyFrom(const SpillStats& other) {
   spillDeserializationTimeNanos.store(
       other.spillDeserializationTimeNanos.load(std::memory_order_relaxed),
       std::memory_order_relaxed);
+  spilledOverflowBytes.store(
+      other.spilledOverflowBytes.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+  spillOverflowWriteTimeNanos.store(
+      other.spillOverflowWriteTimeNanos.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
   ioStats.merge(other.ioStats);
 }
 
@@ -284,6 +301,14 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
       spillDeserializationTimeNanos.load(std::memory_order_relaxed) -
           other.spillDeserializationTimeNanos.load(std::memory_order_relaxed),
       std::memory_order_relaxed);
+  result.spilledOverflowBytes.store(
+      spilledOverflowBytes.load(std::memory_order_relaxed) -
+          other.spilledOverflowBytes.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+  result.spillOverflowWriteTimeNanos.store(
+      spillOverflowWriteTimeNanos.load(std::memory_order_relaxed) -
+          other.spillOverflowWriteTimeNanos.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
   return result;
 }
 
@@ -323,7 +348,11 @@ bool SpillStats::operator==(const SpillStats& other) const {
       spillReadTimeNanos.load(std::memory_order_relaxed) ==
       other.spillReadTimeNanos.load(std::memory_order_relaxed) &&
       spillDeserializationTimeNanos.load(std::memory_order_relaxed) ==
-      other.spillDeserializationTimeNanos.load(std::memory_order_relaxed);
+      other.spillDeserializationTimeNanos.load(std::memory_order_relaxed) &&
+      spilledOverflowBytes.load(std::memory_order_relaxed) ==
+      other.spilledOverflowBytes.load(std::memory_order_relaxed) &&
+      spillOverflowWriteTimeNanos.load(std::memory_order_relaxed) ==
+      other.spillOverflowWriteTimeNanos.load(std::memory_order_relaxed);
 }
 
 void SpillStats::reset() {
@@ -345,6 +374,8 @@ void SpillStats::reset() {
   spillReads.store(0, std::memory_order_relaxed);
   spillReadTimeNanos.store(0, std::memory_order_relaxed);
   spillDeserializationTimeNanos.store(0, std::memory_order_relaxed);
+  spilledOverflowBytes.store(0, std::memory_order_relaxed);
+  spillOverflowWriteTimeNanos.store(0, std::memory_order_relaxed);
   ioStats = IoStats();
 }
 
@@ -392,6 +423,15 @@ std::string SpillStats::toString() const {
      << succinctNanos(
             spillDeserializationTimeNanos.load(std::memory_order_relaxed))
      << "]";
+  const auto overflowBytes =
+      spilledOverflowBytes.load(std::memory_order_relaxed);
+  if (overflowBytes != 0) {
+    ss << " spilledOverflowBytes[" << succinctBytes(overflowBytes) << "] "
+       << "spillOverflowWriteTimeNanos["
+       << succinctNanos(
+              spillOverflowWriteTimeNanos.load(std::memory_order_relaxed))
+       << "]";
+  }
 
   const auto ioStatsMap = ioStats.stats();
   if (!ioStatsMap.empty()) {
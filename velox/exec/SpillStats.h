@@ -67,6 +67,12 @@ struct SpillStats {
   std::atomic_uint64_t spillReadTimeNanos{0};
   /// The time spent on deserializing rows read from spilled files.
   std::atomic_uint64_t spillDeserializationTimeNanos{0};
+  /// The number of bytes spilled to the tiers after the first one when the
+  /// spill storage is tiered. Included in 'spilledBytes'.
+  std::atomic_uint64_t spilledOverflowBytes{0};
+  /// The time spent on writing to the tiers after the first one. Included in
+  /// 'spillWriteTimeNanos'.
+  std::atomic_uint64_t spillOverflowWriteTimeNanos{0};
   /// Filesystem I/O stats for spill operations.
   IoStats ioStats;
 
@@ -90,7 +96,9 @@ struct SpillStats {
       uint64_t _spillReadBytes,
       uint64_t _spillReads,
       uint64_t _spillReadTimeNanos,
-      uint64_t _spillDeserializationTimeNanos);
+      uint64_t _spillDeserializationTimeNanos,
+      uint64_t _spilledOverflowBytes = 0,
+      uint64_t _spillOverflowWriteTimeNanos = 0);
 
   SpillStats(const SpillStats& other);
 
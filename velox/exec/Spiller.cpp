@@ -15,12 +15,15 @@
  */
 
 #include "velox/exec/Spiller.h"
+#include <numeric>
 #include <folly/ScopeGuard.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/MemoryTimeline.h"
 #include "velox/exec/PrefixSort.h"
 #include "velox/external/timsort/TimSort.hpp"
 
@@ -64,7 +67,11 @@ SpillerBase::SpillerBase(
           spillConfig->prefixSortConfig,
           memory::spillMemoryPool(),
           spillStats,
-          spillConfig->fileCreateConfig) {
+          spillConfig->fileCreateConfig,
+          spillConfig->columnarFormat,
+          spillConfig->getSpillFileTargetCb,
+          spillConfig->updateSpillTierBytesCb,
+          spillConfig->dictionaryCompression) {
   TestValue::adjust("facebook::velox::exec::SpillerBase", this);
 }
 
@@ -145,6 +152,9 @@ bool SpillerBase::fillSpillRuns(RowContainerIterator* iterator) {
 
 void SpillerBase::runSpill(bool lastRun) {
   spillStats_->spillRuns.fetch_add(1, std::memory_order_relaxed);
+  // The writes may run on 'executor_', so the operator is found on this
+  // thread.
+  const auto recorder = MemoryTimelineRecorder::forCurrentOperator();
 
   std::vector<std::shared_ptr<AsyncSource<SpillStatus>>> writes;
   for (const auto& [id, spillRun] : spillRuns_) {
@@ -157,7 +167,9 @@ void SpillerBase::runSpill(bool lastRun) {
     }
     writes.push_back(
         memory::createAsyncMemoryReclaimTask<SpillStatus>(
-            [partitionId = id, this]() { return writeSpill(partitionId); }));
+            [partitionId = id, &recorder, this]() {
+              return writeSpill(partitionId, recorder);
+            }));
     if ((writes.size() > 1) && executor_ != nullptr) {
       executor_->add([source = writes.back()]() { source->prepare(); });
     }
@@ -196,7 +208,8 @@ void SpillerBase::runSpill(bool lastRun) {
 }
 
 std::unique_ptr<SpillerBase::SpillStatus> SpillerBase::writeSpill(
-    const SpillPartitionId& id) {
+    const SpillPartitionId& id,
+    const MemoryTimelineRecorder& recorder) {
   // Target size of a single vector of spilled content. One of
   // these will be materialized at a time for each stream of the
   // merge.
@@ -205,6 +218,7 @@ std::unique_ptr<SpillerBase::SpillStatus> SpillerBase::writeSpill(
 
   RowVectorPtr spillVector;
   auto& run = spillRuns_.at(id);
+  const auto startUs = recorder.active() ? getCurrentTimeMicro() : 0;
   try {
     ensureSorted(run);
     size_t written = 0;
@@ -213,6 +227,11 @@ std::unique_ptr<SpillerBase::SpillStatus> SpillerBase::writeSpill(
           run.rows, kTargetBatchRows, kTargetBatchBytes, spillVector, written);
       state_.appendToPartition(id, spillVector);
     }
+    recorder.record(
+        MemoryTimeline::EventType::kSpill,
+        startUs,
+        run.numBytes,
+        id.toString());
     return std::make_unique<SpillStatus>(id, written, nullptr);
   } catch (const std::exception&) {
     // The exception is passed to the caller thread which checks this in
@@ -297,9 +316,13 @@ void SpillerBase::extractSpill(
 
   auto* result = resultPtr.get();
   const auto& types = container_->columnTypes();
-  for (auto i = 0; i < types.size(); ++i) {
-    container_->extractColumn(rows.data(), rows.size(), i, result->childAt(i));
-  }
+  std::vector<column_index_t> columnIndices(types.size());
+  std::iota(columnIndices.begin(), columnIndices.end(), 0);
+  container_->extractColumns(
+      rows.data(),
+      rows.size(),
+      columnIndices,
+      folly::Range(result->children().data(), types.size()));
   const auto& accumulators = container_->accumulators();
   column_index_t accumulatorColumnOffset = types.size();
   for (auto i = 0; i < accumulators.size(); ++i) {
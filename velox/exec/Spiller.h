@@ -26,6 +26,8 @@ namespace test {
 class SpillerTest;
 }
 
+class MemoryTimelineRecorder;
+
 class SpillerBase {
  public:
   using SpillRows = std::vector<char*, memory::StlAllocator<char*>>;
@@ -166,8 +168,10 @@ class SpillerBase {
   // Function for writing a spill partition on an executor. Writes to
   // partition with 'id' until all rows in spillRuns_[id] are written
   // or spill file size limit is exceeded. Returns the number of rows
-  // written.
-  std::unique_ptr<SpillStatus> writeSpill(const SpillPartitionId& id);
+  // written. Adds the write to the memory timeline of 'recorder'.
+  std::unique_ptr<SpillStatus> writeSpill(
+      const SpillPartitionId& id,
+      const MemoryTimelineRecorder& recorder);
 
   // Prepares spill runs for the spillable data from all the hash partitions.
   // If 'startRowIter' is not null, we prepare runs starting from the offset
@@ -30,6 +30,9 @@ struct Split {
   /// Indicates if this is a barrier split.
   std::optional<BarrierSplit> barrier;
 
+  /// Microseconds since epoch when the split was added to the task.
+  uint64_t addedTimeUs{0};
+
   Split() = default;
 
   explicit Split(
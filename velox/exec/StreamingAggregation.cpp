@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/StreamingAggregation.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/testutil/TestValue.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -139,8 +140,99 @@ bool equalKeys(
 
   return true;
 }
+
+bool isFlatIntegerWithoutNulls(const BaseVector& vector) {
+  if (!vector.isFlatEncoding() || vector.mayHaveNulls()) {
+    return false;
+  }
+  switch (vector.typeKind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Compares 'values' with themselves shifted by one row and sets the bits of
+// the rows in ('begin', 'end') that differ from the previous row.
+template <typename T>
+void setKeyChanges(
+    const T* values,
+    vector_size_t begin,
+    vector_size_t end,
+    uint64_t* keyChanges) {
+  using Batch = xsimd::batch<T>;
+  auto row = begin + 1;
+  for (; row + static_cast<vector_size_t>(Batch::size) <= end;
+       row += Batch::size) {
+    uint64_t changes = simd::toBitMask(
+        Batch::load_unaligned(values + row) !=
+        Batch::load_unaligned(values + row - 1));
+    while (changes) {
+      bits::setBit(keyChanges, row + __builtin_ctzll(changes));
+      changes &= changes - 1;
+    }
+  }
+  for (; row < end; ++row) {
+    if (values[row] != values[row - 1]) {
+      bits::setBit(keyChanges, row);
+    }
+  }
+}
 } // namespace
 
+bool StreamingAggregation::findKeyChanges(
+    vector_size_t begin,
+    vector_size_t end) {
+  for (auto key : groupingKeys_) {
+    if (!isFlatIntegerWithoutNulls(*input_->childAt(key))) {
+      return false;
+    }
+  }
+
+  keyChanges_.resize(bits::nwords(end));
+  std::fill(keyChanges_.begin(), keyChanges_.end(), 0);
+  for (auto key : groupingKeys_) {
+    const auto& vector = input_->childAt(key);
+    switch (vector->typeKind()) {
+      case TypeKind::TINYINT:
+        setKeyChanges(
+            vector->asUnchecked<FlatVector<int8_t>>()->rawValues(),
+            begin,
+            end,
+            keyChanges_.data());
+        break;
+      case TypeKind::SMALLINT:
+        setKeyChanges(
+            vector->asUnchecked<FlatVector<int16_t>>()->rawValues(),
+            begin,
+            end,
+            keyChanges_.data());
+        break;
+      case TypeKind::INTEGER:
+        setKeyChanges(
+            vector->asUnchecked<FlatVector<int32_t>>()->rawValues(),
+            begin,
+            end,
+            keyChanges_.data());
+        break;
+      case TypeKind::BIGINT:
+        setKeyChanges(
+            vector->asUnchecked<FlatVector<int64_t>>()->rawValues(),
+            begin,
+            end,
+            keyChanges_.data());
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  return true;
+}
+
 char* StreamingAggregation::startNewGroup(vector_size_t index) {
   if (numGroups_ < groups_.size()) {
     auto* group = groups_[numGroups_++];
@@ -249,6 +341,29 @@ bool StreamingAggregation::assignGroups() {
     auto* newGroup = startNewGroup(index);
     inputGroups_[index] = newGroup;
 
+    if (findKeyChanges(index, numInput)) {
+      // Assigns whole runs of rows with the same keys at once.
+      groupBoundaries_.clear();
+      if (index > 0) {
+        groupBoundaries_.push_back(index);
+      }
+      auto runStart = index;
+      bits::forEachSetBit(
+          keyChanges_.data(), index + 1, numInput, [&](vector_size_t row) {
+            std::fill(
+                inputGroups_.begin() + runStart,
+                inputGroups_.begin() + row,
+                newGroup);
+            groupBoundaries_.push_back(row);
+            newGroup = startNewGroup(row);
+            runStart = row;
+          });
+      std::fill(
+          inputGroups_.begin() + runStart, inputGroups_.end(), newGroup);
+      groupBoundaries_.push_back(numInput);
+      return prevGroupAssigned;
+    }
+
     for (auto i = index + 1; i < numInput; ++i) {
       if (equalKeys(groupingKeys_, input_, index, input_, i)) {
         inputGroups_[i] = inputGroups_[index];
@@ -77,6 +77,12 @@ class StreamingAggregation : public Operator {
   // assigned to the previously last group.
   bool assignGroups();
 
+  // Sets the bits of 'keyChanges_' for the rows in ('begin', 'end') whose
+  // grouping keys differ from the previous row. Returns false without
+  // changing 'keyChanges_' if some grouping key is not a flat integer vector
+  // without nulls.
+  bool findKeyChanges(vector_size_t begin, vector_size_t end);
+
   // Add input data to accumulators.
   void evaluateAggregates();
 
@@ -151,6 +157,10 @@ class StreamingAggregation : public Operator {
   // last element of this is the total size of input.
   std::vector<vector_size_t> groupBoundaries_;
 
+  // Bits set for the input rows that start a new group. Filled by
+  // findKeyChanges().
+  std::vector<uint64_t> keyChanges_;
+
   // A subset of input rows to evaluate the aggregate function on. Rows
   // where aggregation mask is false are excluded.
   SelectivityVector inputRows_;
@@ -17,28 +17,10 @@
 #include "velox/exec/StreamingEnforceDistinct.h"
 
 #include "velox/exec/OperatorType.h"
+#include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
 
-namespace {
-// Compares two rows in the same or different vectors and returns true if they
-// match in all key columns.
-bool equalKeys(
-    const std::vector<column_index_t>& keyChannels,
-    const RowVectorPtr& batch,
-    vector_size_t index,
-    const RowVectorPtr& otherBatch,
-    vector_size_t otherIndex) {
-  for (auto channel : keyChannels) {
-    if (!batch->childAt(channel)->equalValueAt(
-            otherBatch->childAt(channel).get(), index, otherIndex)) {
-      return false;
-    }
-  }
-  return true;
-}
-} // namespace
-
 StreamingEnforceDistinct::StreamingEnforceDistinct(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -80,22 +62,7 @@ void StreamingEnforceDistinct::addInput(RowVectorPtr input) {
   }
 
   // Save key values from the last row for comparison with next batch.
-
-  if (prevKeyValues_ == nullptr) {
-    std::vector<VectorPtr> keyVectors(inputType_->size());
-    for (auto channel : keyChannels_) {
-      keyVectors[channel] =
-          BaseVector::create(inputType_->childAt(channel), 1, pool());
-    }
-    prevKeyValues_ = std::make_shared<RowVector>(
-        pool(), inputType_, nullptr, 1, std::move(keyVectors));
-  }
-
-  const auto lastRow = input->size() - 1;
-  for (auto channel : keyChannels_) {
-    prevKeyValues_->childAt(channel)->copy(
-        input->childAt(channel).get(), 0, lastRow, 1);
-  }
+  copyLastKeys(keyChannels_, input, prevKeyValues_, pool());
 
   input_ = std::move(input);
 }
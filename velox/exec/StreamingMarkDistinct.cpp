@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/StreamingMarkDistinct.h"
+
+#include "velox/exec/OperatorType.h"
+#include "velox/exec/OperatorUtils.h"
+
+namespace facebook::velox::exec {
+
+StreamingMarkDistinct::StreamingMarkDistinct(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::MarkDistinctNode>& planNode)
+    : Operator(
+          driverCtx,
+          planNode->outputType(),
+          operatorId,
+          planNode->id(),
+          OperatorType::kStreamingMarkDistinct),
+      keyChannels_{toChannels(
+          planNode->sources()[0]->outputType(),
+          std::vector<core::TypedExprPtr>{
+              planNode->distinctKeys().begin(),
+              planNode->distinctKeys().end()})} {
+  const auto& inputType = planNode->sources()[0]->outputType();
+  for (auto i = 0; i < inputType->size(); ++i) {
+    identityProjections_.emplace_back(i, i);
+  }
+
+  // Use result[0] for distinct mask output.
+  resultProjections_.emplace_back(0, inputType->size());
+  results_.resize(1);
+}
+
+void StreamingMarkDistinct::addInput(RowVectorPtr input) {
+  if (input->size() == 0) {
+    return;
+  }
+  input_ = std::move(input);
+}
+
+RowVectorPtr StreamingMarkDistinct::getOutput() {
+  if (isFinished() || !input_) {
+    return nullptr;
+  }
+
+  const auto numInput = input_->size();
+  VectorPtr& result = results_[0];
+  if (result && result.use_count() == 1) {
+    BaseVector::prepareForReuse(result, numInput);
+  } else {
+    result = BaseVector::create(BOOLEAN(), numInput, pool());
+  }
+  auto* resultBits =
+      result->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
+
+  // The first row continues the last group of the previous batch if the keys
+  // are equal.
+  bits::setBit(
+      resultBits,
+      0,
+      prevKeyValues_ == nullptr ||
+          !equalKeys(keyChannels_, input_, 0, prevKeyValues_, 0));
+  for (vector_size_t i = 1; i < numInput; ++i) {
+    bits::setBit(
+        resultBits, i, !equalKeys(keyChannels_, input_, i, input_, i - 1));
+  }
+
+  copyLastKeys(keyChannels_, input_, prevKeyValues_, pool());
+
+  auto output = fillOutput(numInput, nullptr);
+  input_ = nullptr;
+  return output;
+}
+
+bool StreamingMarkDistinct::isFinished() {
+  return noMoreInput_ && !input_;
+}
+
+} // namespace facebook::velox::exec
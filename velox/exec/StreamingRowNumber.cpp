@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/StreamingRowNumber.h"
+
+#include "velox/exec/OperatorType.h"
+#include "velox/exec/OperatorUtils.h"
+
+namespace facebook::velox::exec {
+
+StreamingRowNumber::StreamingRowNumber(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::RowNumberNode>& rowNumberNode)
+    : Operator(
+          driverCtx,
+          rowNumberNode->outputType(),
+          operatorId,
+          rowNumberNode->id(),
+          OperatorType::kStreamingRowNumber),
+      limit_{rowNumberNode->limit()},
+      generateRowNumber_{rowNumberNode->generateRowNumber()},
+      keyChannels_{toChannels(
+          rowNumberNode->sources()[0]->outputType(),
+          std::vector<core::TypedExprPtr>{
+              rowNumberNode->partitionKeys().begin(),
+              rowNumberNode->partitionKeys().end()})} {
+  const auto& inputType = rowNumberNode->sources()[0]->outputType();
+  identityProjections_.reserve(inputType->size());
+  for (auto i = 0; i < inputType->size(); ++i) {
+    identityProjections_.emplace_back(i, i);
+  }
+
+  if (generateRowNumber_) {
+    resultProjections_.emplace_back(0, inputType->size());
+    results_.resize(1);
+  }
+}
+
+void StreamingRowNumber::addInput(RowVectorPtr input) {
+  if (input->size() == 0) {
+    return;
+  }
+  input_ = std::move(input);
+}
+
+RowVectorPtr StreamingRowNumber::getOutput() {
+  if (isFinished() || !input_) {
+    return nullptr;
+  }
+
+  const auto numInput = input_->size();
+
+  // Maps output rows to input rows if 'limit_' drops rows.
+  BufferPtr mapping;
+  vector_size_t* rawMapping = nullptr;
+  if (limit_) {
+    mapping = allocateIndices(numInput, pool());
+    rawMapping = mapping->asMutable<vector_size_t>();
+  }
+
+  FlatVector<int64_t>* rowNumbers = nullptr;
+  if (generateRowNumber_) {
+    auto& result = results_[0];
+    if (result && result.use_count() == 1) {
+      BaseVector::prepareForReuse(result, numInput);
+    } else {
+      result = BaseVector::create(BIGINT(), numInput, pool());
+    }
+    rowNumbers = result->asFlatVector<int64_t>();
+  }
+
+  vector_size_t numOutput{0};
+  int64_t rowNumber = prevRowNumber_;
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    const bool samePartition = i == 0
+        ? prevKeyValues_ != nullptr &&
+            equalKeys(keyChannels_, input_, 0, prevKeyValues_, 0)
+        : equalKeys(keyChannels_, input_, i, input_, i - 1);
+    rowNumber = samePartition ? rowNumber + 1 : 1;
+
+    if (limit_) {
+      if (rowNumber > limit_.value()) {
+        // Exceeded the limit for this partition. Drop the row.
+        continue;
+      }
+      rawMapping[numOutput] = i;
+    }
+    if (generateRowNumber_) {
+      rowNumbers->set(i, rowNumber);
+    }
+    ++numOutput;
+  }
+  prevRowNumber_ = rowNumber;
+  copyLastKeys(keyChannels_, input_, prevKeyValues_, pool());
+
+  RowVectorPtr output;
+  if (!limit_) {
+    output = fillOutput(numInput, nullptr);
+  } else if (numOutput > 0) {
+    output = fillOutput(numOutput, mapping);
+  }
+  input_ = nullptr;
+  return output;
+}
+
+bool StreamingRowNumber::isFinished() {
+  return noMoreInput_ && !input_;
+}
+
+} // namespace facebook::velox::exec
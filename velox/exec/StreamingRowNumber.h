@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Streaming implementation of RowNumber for input clustered on the partition
+/// keys. Restarts the row number at each change of the keys between
+/// consecutive rows instead of keeping the number of rows of each partition in
+/// a hash table. Memory usage is O(1) - only stores the previous row's key
+/// values and row number.
+class StreamingRowNumber : public Operator {
+ public:
+  StreamingRowNumber(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::RowNumberNode>& rowNumberNode);
+
+  bool preservesOrder() const override {
+    return true;
+  }
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !input_;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override;
+
+ private:
+  const std::optional<int32_t> limit_;
+  const bool generateRowNumber_;
+  const std::vector<column_index_t> keyChannels_;
+
+  // Key values from the last row of the previous batch for cross-batch
+  // comparison. Lazily initialized on first input batch.
+  RowVectorPtr prevKeyValues_;
+
+  // Row number of the last row of the previous batch.
+  int64_t prevRowNumber_{0};
+};
+
+} // namespace facebook::velox::exec
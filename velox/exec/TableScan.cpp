@@ -263,6 +263,7 @@ RowVectorPtr TableScan::getOutput() {
 
     driverCtx_->task->splitFinished(true, currentSplitWeight_);
     needNewSplit_ = true;
+    recordSplitTiming();
 
     // We only update scaled controller when we have finished a non-empty split.
     // Otherwise, it can lead to the wrong scale up decisions if the first few
@@ -325,6 +326,13 @@ bool TableScan::getSplit() {
   const auto& connectorSplit = split.connectorSplit;
   currentSplitWeight_ = connectorSplit->splitWeight;
   needNewSplit_ = false;
+  splitStartNanos_ = getCurrentTimeNano();
+  splitQueueWallNanos_ = split.addedTimeUs == 0
+      ? 0
+      : std::max<int64_t>(0, splitStartNanos_ - split.addedTimeUs * 1'000);
+  if (operatorCtx_->task()->slowestSplits() != nullptr) {
+    splitName_ = connectorSplit->toString();
+  }
 
   // A point for test code injection.
   TestValue::adjust(
@@ -395,6 +403,41 @@ bool TableScan::getSplit() {
   return true;
 }
 
+void TableScan::recordSplitTiming() {
+  auto timing = dataSource_->finishedSplitTiming();
+  if (!timing.has_value()) {
+    return;
+  }
+  const auto wallNanos = getCurrentTimeNano() - splitStartNanos_;
+  {
+    auto lockedStats = stats_.wlock();
+    auto addNanos = [&](std::string_view name, uint64_t nanos) {
+      lockedStats->addRuntimeStat(
+          std::string(name),
+          RuntimeCounter(
+              static_cast<int64_t>(nanos), RuntimeCounter::Unit::kNanos));
+    };
+    addNanos(kSplitQueueWallNanos, splitQueueWallNanos_);
+    addNanos(kSplitWallNanos, wallNanos);
+    addNanos(kSplitOpenWallNanos, timing->openWallNanos);
+    addNanos(kSplitFirstBatchWallNanos, timing->firstBatchWallNanos);
+    addNanos(kSplitIoWaitWallNanos, timing->ioWaitWallNanos);
+    addNanos(kSplitDecodeCpuNanos, timing->decodeCpuNanos());
+    addNanos(kSplitFilterCpuNanos, timing->filterCpuNanos);
+    lockedStats->addRuntimeStat(
+        std::string(kSplitOutputRows),
+        RuntimeCounter(static_cast<int64_t>(timing->outputRows)));
+  }
+  if (const auto& slowestSplits = operatorCtx_->task()->slowestSplits()) {
+    slowestSplits->add(
+        {.planNodeId = planNodeId(),
+         .split = std::move(splitName_),
+         .queueWallNanos = splitQueueWallNanos_,
+         .wallNanos = wallNanos,
+         .reader = std::move(*timing)});
+  }
+}
+
 bool TableScan::shouldWaitForScaleUp() {
   if (scaledController_ == nullptr) {
     return false;
@@ -459,6 +502,7 @@ void TableScan::preload(
         {
           auto lk = pushdownFilters->at(0).rlock();
           dataSource->addSplit(split);
+          dataSource->preloadSplitData();
         }
         return dataSource;
       });
@@ -92,6 +92,24 @@ class TableScan : public SourceOperator {
   static constexpr std::string_view kDataSourceAddSplitWallNanos =
       "dataSourceAddSplitWallNanos";
 
+  /// The timing of each split, added when the split ends, for data sources
+  /// that time their splits. See connector::SplitTiming. Wall time in the
+  /// split queue of the task.
+  static constexpr std::string_view kSplitQueueWallNanos =
+      "splitQueueWallNanos";
+  /// Wall time from taking the split to its end.
+  static constexpr std::string_view kSplitWallNanos = "splitWallNanos";
+  static constexpr std::string_view kSplitOpenWallNanos = "splitOpenWallNanos";
+  static constexpr std::string_view kSplitFirstBatchWallNanos =
+      "splitFirstBatchWallNanos";
+  static constexpr std::string_view kSplitIoWaitWallNanos =
+      "splitIoWaitWallNanos";
+  static constexpr std::string_view kSplitDecodeCpuNanos =
+      "splitDecodeCpuNanos";
+  static constexpr std::string_view kSplitFilterCpuNanos =
+      "splitFilterCpuNanos";
+  static constexpr std::string_view kSplitOutputRows = "splitOutputRows";
+
   std::shared_ptr<ScaledScanController> testingScaledController() const {
     return scaledController_;
   }
@@ -113,6 +131,10 @@ class TableScan : public SourceOperator {
   // Returns true if a new split is fetched from the task otherwise false.
   bool getSplit();
 
+  // Adds the timing of the split that just ended to the runtime stats and to
+  // the slowest splits of the task.
+  void recordSplitTiming();
+
   // Sets 'maxPreloadSplits' and 'splitPreloader' if prefetching splits is
   // appropriate. The preloader will be applied to the 'first 'maxPreloadSplits'
   // of the Task's split queue for 'this' when getting splits.
@@ -187,6 +209,15 @@ class TableScan : public SourceOperator {
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
   std::string debugString_;
 
+  // Nanoseconds since epoch when the current split was taken, and the time it
+  // was queued in the task.
+  uint64_t splitStartNanos_{0};
+  uint64_t splitQueueWallNanos_{0};
+
+  // ConnectorSplit::toString() of the current split if the task keeps its
+  // slowest splits.
+  std::string splitName_;
+
   // The total number of raw input rows read up till the last finished split.
   // This is used to detect if a finished split is empty or not.
   uint64_t rawInputRowsSinceLastSplit_{0};
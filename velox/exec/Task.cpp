@@ -416,6 +416,33 @@ Task::Task(
   maybeInitTrace();
 
   initSplitListeners();
+
+  if (const auto intervalMs =
+          queryCtx_->queryConfig().taskStackSampleIntervalMs()) {
+    startStackSampling(intervalMs);
+  }
+  if (const auto maxEvents =
+          queryCtx_->queryConfig().taskMemoryTimelineMaxEvents()) {
+    memoryTimeline_ = std::make_shared<MemoryTimeline>(maxEvents);
+    taskStats_.memoryTimeline = memoryTimeline_;
+  }
+  if (const auto maxSplits = queryCtx_->queryConfig().taskMaxSlowestSplits()) {
+    slowestSplits_ = std::make_shared<SlowestSplits>(maxSplits);
+    taskStats_.slowestSplits = slowestSplits_;
+  }
+  if (queryCtx_->queryConfig().executionFeedbackEnabled()) {
+    feedbackFingerprints_ =
+        ExecutionFeedback::fingerprints(*planFragment_.planNode);
+  }
+}
+
+std::optional<PlanNodeFeedback> Task::executionFeedback(
+    const core::PlanNodeId& planNodeId) const {
+  auto it = feedbackFingerprints_.find(planNodeId);
+  if (it == feedbackFingerprints_.end()) {
+    return std::nullopt;
+  }
+  return ExecutionFeedback::instance()->find(it->second);
 }
 
 void Task::initSplitListeners() {
@@ -544,6 +571,17 @@ void Task::setSpillDiskConfig(
   if (!spillDiskOpts.has_value()) {
     return;
   }
+  if (spillDiskOpts->spillTiers != nullptr) {
+    VELOX_CHECK(
+        !spillDiskOpts->spillTierDirName.empty(),
+        "Spill tier directory name can't be empty");
+    spillTiers_ = std::move(spillDiskOpts->spillTiers);
+    spillTierDirName_ = std::move(spillDiskOpts->spillTierDirName);
+    spillTierDirs_.resize(spillTiers_->numTiers());
+    spillTierBytes_ =
+        std::vector<std::atomic_uint64_t>(spillTiers_->numTiers());
+    return;
+  }
   VELOX_CHECK(
       !spillDiskOpts->spillDirPath.empty(), "Spill directory can't be empty");
   VELOX_CHECK(
@@ -666,7 +704,53 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
+common::SpillFileTarget Task::getOrCreateSpillFileTarget() {
+  VELOX_CHECK_NOT_NULL(spillTiers_);
+  const auto tier = spillTiers_->pickTier();
+  const auto& tierConfig = spillTiers_->tier(tier);
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  auto& directory = spillTierDirs_[tier];
+  if (directory.empty()) {
+    const auto path = fmt::format("{}/{}", tierConfig.path, spillTierDirName_);
+    try {
+      auto fileSystem = filesystems::getFileSystem(path, nullptr);
+      fileSystem->mkdir(path);
+    } catch (const std::exception& e) {
+      VELOX_FAIL(
+          "Failed to create spill directory '{}' for Task {}: {}",
+          path,
+          taskId(),
+          e.what());
+    }
+    directory = path;
+  }
+  return {tier, directory, tierConfig.fileCreateConfig};
+}
+
+void Task::addSpillTierBytes(uint32_t tier, uint64_t bytes) {
+  VELOX_CHECK_LT(tier, spillTierBytes_.size());
+  spillTierBytes_[tier].fetch_add(bytes, std::memory_order_relaxed);
+  spillTiers_->addBytes(tier, bytes);
+}
+
 void Task::removeSpillDirectoryIfExists() {
+  for (uint32_t tier = 0; tier < spillTierDirs_.size(); ++tier) {
+    if (spillTierDirs_[tier].empty()) {
+      continue;
+    }
+    try {
+      auto fs = filesystems::getFileSystem(spillTierDirs_[tier], nullptr);
+      fs->rmdir(spillTierDirs_[tier]);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove spill directory '"
+                 << spillTierDirs_[tier] << "' for Task " << taskId() << ": "
+                 << e.what();
+    }
+    spillTiers_->releaseBytes(tier, spillTierBytes_[tier].exchange(0));
+    spillTierDirs_[tier].clear();
+  }
+
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
   }
@@ -822,6 +906,17 @@ bool Task::supportSerialExecutionMode() const {
     return false;
   }
 
+  // A serial mode task has already planned its driver factories in init() and
+  // they don't change afterwards, so check them instead of planning the
+  // fragment again. This keeps the local planning off the startup path of the
+  // single threaded task cursor.
+  if (mode_ == ExecutionMode::kSerial) {
+    return std::all_of(
+        driverFactories_.begin(),
+        driverFactories_.end(),
+        [](const auto& factory) { return factory->supportsSerialExecution(); });
+  }
+
   std::vector<std::unique_ptr<DriverFactory>> driverFactories;
   LocalPlanner::plan(
       planFragment_, nullptr, &driverFactories, queryCtx_->queryConfig(), 1);
@@ -1522,6 +1617,7 @@ bool Task::addSplitWithSequence(
     exec::Split&& split,
     long sequenceId) {
   RECORD_METRIC_VALUE(kMetricTaskSplitsCount, 1);
+  split.addedTimeUs = getCurrentTimeMicro();
   std::vector<ContinuePromise> promises;
   bool added = false;
   bool isTaskRunning;
@@ -1561,6 +1657,7 @@ bool Task::addSplitWithSequence(
 
 void Task::addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split) {
   RECORD_METRIC_VALUE(kMetricTaskSplitsCount, 1);
+  split.addedTimeUs = getCurrentTimeMicro();
   bool isTaskRunning;
   bool shouldLogSplit = false;
   std::vector<ContinuePromise> promises;
@@ -1770,6 +1867,8 @@ void Task::setSplitsStore(
   splitsStore = std::move(newSplitsStore);
   splitsStore->setTaskStats(taskStats_);
   splitsStore->setPreloadingSplits(preloadingSplits_);
+  splitsStore->setCachedSplitLookahead(
+      queryCtx_->queryConfig().cachedSplitLookahead());
 }
 
 ContinueFuture Task::requestBarrier() {
@@ -2677,6 +2776,29 @@ void Task::addDriverStats(int pipelineId, DriverStats stats) {
   taskStats_.pipelineStats[pipelineId].driverStats.push_back(std::move(stats));
 }
 
+void Task::startStackSampling(uint32_t intervalMs) {
+  VELOX_USER_CHECK_GT(intervalMs, 0);
+  *stackProfile_.wlock() =
+      std::make_shared<process::StackProfile>(intervalMs * 1'000'000ULL);
+  stackSampling_ = true;
+}
+
+void Task::stopStackSampling() {
+  stackSampling_ = false;
+}
+
+std::string Task::foldedStacks() const {
+  const auto profile = *stackProfile_.rlock();
+  return profile == nullptr ? std::string() : profile->toFolded();
+}
+
+std::shared_ptr<process::StackProfile> Task::stackProfileIfSampling() const {
+  if (!stackSampling_) {
+    return nullptr;
+  }
+  return *stackProfile_.rlock();
+}
+
 TaskStats Task::taskStats() const {
   std::lock_guard<std::timed_mutex> l(mutex_);
 
@@ -2815,6 +2937,23 @@ Task::DriverCounts Task::driverCounts() const {
 }
 
 void Task::onTaskCompletion() {
+  if (!feedbackFingerprints_.empty()) {
+    // Only the runs that finished are representative.
+    bool finished;
+    TaskStats stats;
+    {
+      std::lock_guard<std::timed_mutex> l(mutex_);
+      finished = state_ == TaskState::kFinished;
+      if (finished) {
+        stats = taskStats_;
+      }
+    }
+    if (finished) {
+      ExecutionFeedback::instance()->record(
+          feedbackFingerprints_, toPlanStats(stats));
+    }
+  }
+
   listeners().withRLock([&](auto& listeners) {
     if (listeners.empty()) {
       return;
@@ -3460,7 +3599,8 @@ void Task::createExchangeClientLocked(
       queryCtx()->executor(),
       queryCtx()->queryConfig().requestDataSizesMaxWaitSec(),
       queryCtx()->queryConfig().singleSourceExchangeOptimizationEnabled(),
-      queryCtx()->queryConfig().exchangeLazyFetchingEnabled());
+      queryCtx()->queryConfig().exchangeLazyFetchingEnabled(),
+      queryCtx()->queryConfig().exchangeFlowControlEnabled());
   exchangeClientByPlanNode_.emplace(planNodeId, exchangeClients_[pipelineId]);
 }
 
@@ -18,11 +18,15 @@
 #include <folly/container/IntrusiveList.h>
 
 #include "velox/common/base/SkewedPartitionBalancer.h"
+#include "velox/common/process/StackSampler.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
+#include "velox/exec/ExecutionFeedback.h"
 #include "velox/exec/LocalPartition.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/MemoryTimeline.h"
+#include "velox/exec/SlowestSplits.h"
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/ScaledScanController.h"
 #include "velox/exec/TaskStats.h"
@@ -327,6 +331,42 @@ class Task : public std::enable_shared_from_this<Task> {
   /// structure.
   TaskStats taskStats() const;
 
+  /// Starts sampling the stacks of the threads that run the drivers of this
+  /// task every 'intervalMs' of their CPU time, to see where the CPU time of
+  /// the task goes without profiling the whole process. Drops the samples of
+  /// an earlier start. Applies to the drivers from the next time they are
+  /// run.
+  void startStackSampling(uint32_t intervalMs);
+
+  /// Stops sampling the stacks. The samples taken so far remain available.
+  void stopStackSampling();
+
+  /// Returns the stack samples of the task in the folded format of flame
+  /// graph tools. The stacks are rooted at the plan node ID of the operator
+  /// that was called. Empty if the stacks were never sampled.
+  std::string foldedStacks() const;
+
+  /// Returns the profile to add stack samples to, or nullptr if the stacks
+  /// are not sampled.
+  std::shared_ptr<process::StackProfile> stackProfileIfSampling() const;
+
+  /// Returns the timeline of the memory events of the task, or nullptr if
+  /// task_memory_timeline_max_events is not set.
+  const std::shared_ptr<MemoryTimeline>& memoryTimeline() const {
+    return memoryTimeline_;
+  }
+
+  /// Returns the slowest splits of the table scans of the task, or nullptr if
+  /// task_max_slowest_splits is not set.
+  const std::shared_ptr<SlowestSplits>& slowestSplits() const {
+    return slowestSplits_;
+  }
+
+  /// Returns what earlier runs of plan node 'planNodeId' observed, or nullopt
+  /// if execution_feedback_enabled is not set or there were none.
+  std::optional<PlanNodeFeedback> executionFeedback(
+      const core::PlanNodeId& planNodeId) const;
+
   /// Information about an operator call that helps debugging stuck calls.
   struct OpCallInfo {
     size_t durationMs;
@@ -663,6 +703,12 @@ class Task : public std::enable_shared_from_this<Task> {
   /// nodes support barrier processing.
   ContinueFuture requestBarrier();
 
+  /// Returns true if all the plan nodes of this task support barrier
+  /// processing, so that requestBarrier() may be called.
+  bool supportsBarrier() const {
+    return firstNodeNotSupportingBarrier_ == nullptr;
+  }
+
   /// Returns true if this task is under barrier processing.
   bool underBarrier() const {
     return barrierRequested_;
@@ -741,6 +787,19 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  /// True if the spill files of 'this' are placed on spill tiers.
+  bool hasSpillTiers() const {
+    return spillTiers_ != nullptr;
+  }
+
+  /// Returns the placement of a new spill file on the spill tiers. Creates
+  /// the spill directory of 'this' on the picked tier if needed. Is thread
+  /// safe.
+  common::SpillFileTarget getOrCreateSpillFileTarget();
+
+  /// Records 'bytes' written to the spill files of 'this' on 'tier'.
+  void addSpillTierBytes(uint32_t tier, uint64_t bytes);
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -1380,6 +1439,18 @@ class Task : public std::enable_shared_from_this<Task> {
   std::vector<ContinuePromise> barrierFinishPromises_;
 
   std::atomic_int32_t toYield_ = 0;
+
+  // True while the drivers sample their stacks into 'stackProfile_'. Tested
+  // by the drivers each time they run.
+  std::atomic_bool stackSampling_{false};
+  folly::Synchronized<std::shared_ptr<process::StackProfile>> stackProfile_;
+  // Set in the constructor.
+  std::shared_ptr<MemoryTimeline> memoryTimeline_;
+  // Set in the constructor.
+  std::shared_ptr<SlowestSplits> slowestSplits_;
+  // The ExecutionFeedback fingerprints of the plan nodes. Set in the
+  // constructor if execution_feedback_enabled is set.
+  folly::F14FastMap<core::PlanNodeId, uint64_t> feedbackFingerprints_;
   int32_t numThreads_ = 0;
   // Microsecond real time when 'this' last went from no threads to
   // one thread running. Used to decide if continuous run should be
@@ -1406,6 +1477,20 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // Node wide spill tiers if the spill storage is tiered.
+  std::shared_ptr<common::SpillTiers> spillTiers_;
+
+  // The name of the spill directory of 'this' on each tier.
+  std::string spillTierDirName_;
+
+  // The spill directory of 'this' on each tier, empty if not created yet.
+  // Guarded by 'spillDirCreateMutex_'.
+  std::vector<std::string> spillTierDirs_;
+
+  // The bytes spilled by 'this' to each tier. They are released from
+  // 'spillTiers_' when the spill directories are removed.
+  std::vector<std::atomic_uint64_t> spillTierBytes_;
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
@@ -22,6 +22,8 @@
 
 #include "velox/exec/BlockingReason.h"
 #include "velox/exec/DriverStats.h"
+#include "velox/exec/MemoryTimeline.h"
+#include "velox/exec/SlowestSplits.h"
 #include "velox/exec/OperatorStats.h"
 #include "velox/exec/OutputBuffer.h"
 
@@ -65,6 +67,9 @@ struct TaskStats {
   int32_t numQueuedTableScanSplits{0};
   int64_t runningTableScanSplitWeights{0};
   int64_t queuedTableScanSplitWeights{0};
+  /// Table scan splits handed out ahead of splits queued before them because
+  /// their data was in the local caches. See cached_split_lookahead.
+  int32_t numCachedTableScanSplitsFirst{0};
 
   /// The subscript is given by each Operator's
   /// DriverCtx::pipelineId. This is a sum total reflecting fully
@@ -126,6 +131,13 @@ struct TaskStats {
   uint32_t memoryReclaimCount{0};
   /// The total memory reclamation time.
   uint64_t memoryReclaimMs{0};
+
+  /// The memory events of the task if task_memory_timeline_max_events is set.
+  std::shared_ptr<const MemoryTimeline> memoryTimeline;
+
+  /// The slowest table scan splits of the task if task_max_slowest_splits is
+  /// set.
+  std::shared_ptr<const SlowestSplits> slowestSplits;
 };
 
 } // namespace facebook::velox::exec
@@ -73,6 +73,23 @@ Split SplitsStore::getSplit(
       }
     }
   }
+  if (readySplitIndex == -1 && !remoteSplit_) {
+    // A split with a preloaded data source is ready to run, otherwise the
+    // first split with cached data goes first.
+    for (int i = 0,
+             end = std::min<size_t>(cachedSplitLookahead_, splits_.size());
+         i < end;
+         ++i) {
+      const auto& connectorSplit = splits_[i].connectorSplit;
+      if (connectorSplit != nullptr && connectorSplit->hasCachedData()) {
+        readySplitIndex = i;
+        if (i > 0) {
+          ++taskStats_->numCachedTableScanSplitsFirst;
+        }
+        break;
+      }
+    }
+  }
   if (readySplitIndex == -1) {
     readySplitIndex = 0;
   }
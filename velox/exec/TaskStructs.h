@@ -146,6 +146,12 @@ class SplitsStore {
     preloadingSplits_ = &preloadingSplits;
   }
 
+  /// Sets the number of queued splits getSplit() looks at for one with cached
+  /// data. Applies to table scan splits only.
+  void setCachedSplitLookahead(int32_t cachedSplitLookahead) {
+    cachedSplitLookahead_ = cachedSplitLookahead;
+  }
+
  protected:
   Split getSplit(
       int maxPreloadSplits,
@@ -159,6 +165,7 @@ class SplitsStore {
   TaskStats* taskStats_{};
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>*
       preloadingSplits_{};
+  int32_t cachedSplitLookahead_{0};
 
   // Arrived (added), but not distributed yet, splits.
   std::deque<Split> splits_;
@@ -48,6 +48,14 @@ TopN::TopN(
     sortingKeyColumns_.emplace_back(exprToChannel(key.get(), outputType_));
     isSortingKey[sortingKeyColumns_.back()] = true;
   }
+  cutoff_ = TopNCutoff::create(
+      this,
+      sortingKeyColumns_[0],
+      outputType_->childAt(sortingKeyColumns_[0]),
+      data_.get(),
+      sortingKeyColumns_[0],
+      topNNode->sortingOrders()[0],
+      /*strict=*/numSortingKeys == 1);
   if (numColumns > numSortingKeys) {
     nonKeyColumns_.reserve(numColumns - numSortingKeys);
     for (column_index_t i = 0; i < numColumns; ++i) {
@@ -67,7 +75,14 @@ void TopN::addInput(RowVectorPtr input) {
   // Maps passed rows of 'data_' to the corresponding input row number. These
   // input rows of non-key columns are later stored into data_.
   folly::F14FastMap<void*, vector_size_t> passedRows;
-  for (auto row = 0; row < input->size(); ++row) {
+  cutoffRows_.resizeFill(input->size());
+  if (cutoff_ != nullptr && topRows_.size() == count_) {
+    cutoff_->filter(decodedVectors_[sortingKeyColumns_[0]], cutoffRows_);
+  }
+  for (auto row = cutoffRows_.begin(); row < cutoffRows_.end(); ++row) {
+    if (!cutoffRows_.isValid(row)) {
+      continue;
+    }
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -93,6 +108,10 @@ void TopN::addInput(RowVectorPtr input) {
     }
   }
 
+  if (cutoff_ != nullptr && topRows_.size() == count_) {
+    cutoff_->update(topRows_.top());
+  }
+
   if (hasNonKeyColumn && !passedRows.empty()) {
     for (const auto col : nonKeyColumns_) {
       decodedVectors_[col].decode(*input->childAt(col));
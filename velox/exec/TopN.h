@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/TopNCutoff.h"
 
 namespace facebook::velox::exec {
 
@@ -67,6 +68,10 @@ class TopN : public Operator {
   std::vector<char*> rows_;
 
   std::vector<DecodedVector> decodedVectors_;
+  // Drops the input rows after the first key of 'topRows_.top()' once
+  // 'topRows_' is full. Null if the first key type is not supported.
+  std::unique_ptr<TopNCutoff> cutoff_;
+  SelectivityVector cutoffRows_;
   vector_size_t outputBatchSize_;
 };
 } // namespace facebook::velox::exec
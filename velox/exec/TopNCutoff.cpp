@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TopNCutoff.h"
+
+#include "velox/exec/Driver.h"
+#include "velox/exec/OperatorType.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::exec {
+
+// static
+std::unique_ptr<TopNCutoff> TopNCutoff::create(
+    Operator* op,
+    column_index_t keyChannel,
+    const TypePtr& keyType,
+    const RowContainer* data,
+    column_index_t keyColumn,
+    const core::SortOrder& sortOrder,
+    bool strict) {
+  switch (keyType->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    default:
+      return nullptr;
+  }
+  if (keyType->isDecimal()) {
+    return nullptr;
+  }
+  return std::make_unique<TopNCutoff>(
+      op, keyChannel, keyType, data, keyColumn, sortOrder, strict);
+}
+
+TopNCutoff::TopNCutoff(
+    Operator* op,
+    column_index_t keyChannel,
+    const TypePtr& keyType,
+    const RowContainer* data,
+    column_index_t keyColumn,
+    const core::SortOrder& sortOrder,
+    bool strict)
+    : op_(op),
+      keyChannel_(keyChannel),
+      keyKind_(keyType->kind()),
+      keyColumn_(data->columnAt(keyColumn)),
+      ascending_(sortOrder.isAscending()),
+      nullsFirst_(sortOrder.isNullsFirst()),
+      strict_(strict) {}
+
+void TopNCutoff::update(const char* row) {
+  std::optional<int64_t> cutoff;
+  if (!RowContainer::isNullAt(
+          row, keyColumn_.nullByte(), keyColumn_.nullMask())) {
+    const auto offset = keyColumn_.offset();
+    switch (keyKind_) {
+      case TypeKind::TINYINT:
+        cutoff = RowContainer::valueAt<int8_t>(row, offset);
+        break;
+      case TypeKind::SMALLINT:
+        cutoff = RowContainer::valueAt<int16_t>(row, offset);
+        break;
+      case TypeKind::INTEGER:
+        cutoff = RowContainer::valueAt<int32_t>(row, offset);
+        break;
+      case TypeKind::BIGINT:
+        cutoff = RowContainer::valueAt<int64_t>(row, offset);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  if (!hasCutoff_ || cutoff != cutoff_) {
+    hasCutoff_ = true;
+    cutoff_ = cutoff;
+    cutoffChanged_ = true;
+  }
+  ++numBatchesSincePushdown_;
+  if (cutoffChanged_ &&
+      (!canPushdown_.has_value() ||
+       numBatchesSincePushdown_ >= kPushdownIntervalBatches)) {
+    pushdown();
+  }
+}
+
+bool TopNCutoff::canPushdown() const {
+  if (!op_->operatorCtx()
+           ->driverCtx()
+           ->queryConfig()
+           .topNDynamicFilterPushdownEnabled()) {
+    return false;
+  }
+  // A filter below an operator that depends on the set of rows it sees, e.g.
+  // Limit or RowNumber, would change the rows that the operator outputs.
+  const auto* driver = op_->operatorCtx()->driver();
+  const auto index = driver->operatorIndex(op_);
+  for (auto i = 1; i < index; ++i) {
+    const auto& type = driver->findOperator(i)->operatorType();
+    if (type != OperatorType::kFilterProject &&
+        type != OperatorType::kParallelProject) {
+      return false;
+    }
+  }
+  return !driver->canPushdownFilters(op_, {keyChannel_}).empty();
+}
+
+void TopNCutoff::pushdown() {
+  if (!canPushdown_.has_value()) {
+    canPushdown_ = canPushdown();
+  }
+  cutoffChanged_ = false;
+  numBatchesSincePushdown_ = 0;
+  if (!canPushdown_.value()) {
+    return;
+  }
+  auto filter = makeFilter();
+  if (filter == nullptr) {
+    return;
+  }
+  op_->operatorCtx()->driver()->pushdownFilters(
+      op_, {keyChannel_}, [&](column_index_t, common::FilterPtr& newFilter) {
+        newFilter = std::move(filter);
+        return true;
+      });
+}
+
+common::FilterPtr TopNCutoff::makeFilter() const {
+  if (!cutoff_.has_value()) {
+    // All non-null rows sort after a null cutoff if nulls sort first.
+    if (nullsFirst_) {
+      return std::make_shared<common::IsNull>();
+    }
+    return nullptr;
+  }
+  const auto cutoff = cutoff_.value();
+  constexpr auto kMin = std::numeric_limits<int64_t>::min();
+  constexpr auto kMax = std::numeric_limits<int64_t>::max();
+  if (ascending_) {
+    const auto upper = strict_ && cutoff > kMin ? cutoff - 1 : cutoff;
+    return std::make_shared<common::BigintRange>(kMin, upper, nullsFirst_);
+  }
+  const auto lower = strict_ && cutoff < kMax ? cutoff + 1 : cutoff;
+  return std::make_shared<common::BigintRange>(lower, kMax, nullsFirst_);
+}
+
+void TopNCutoff::filter(const DecodedVector& keys, SelectivityVector& rows)
+    const {
+  if (!hasCutoff_) {
+    return;
+  }
+  switch (keyKind_) {
+    case TypeKind::TINYINT:
+      filter<int8_t>(keys, rows);
+      break;
+    case TypeKind::SMALLINT:
+      filter<int16_t>(keys, rows);
+      break;
+    case TypeKind::INTEGER:
+      filter<int32_t>(keys, rows);
+      break;
+    case TypeKind::BIGINT:
+      filter<int64_t>(keys, rows);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+void TopNCutoff::filter(const DecodedVector& keys, SelectivityVector& rows)
+    const {
+  if (!cutoff_.has_value()) {
+    if (nullsFirst_) {
+      // Only nulls are not after a null cutoff. These are equal to it.
+      for (auto row = rows.begin(); row < rows.end(); ++row) {
+        if (strict_ || !keys.isNullAt(row)) {
+          rows.setValid(row, false);
+        }
+      }
+      rows.updateBounds();
+    }
+    return;
+  }
+  const auto cutoff = static_cast<T>(cutoff_.value());
+  const auto keep = [&](T value) {
+    if (ascending_) {
+      return strict_ ? value < cutoff : value <= cutoff;
+    }
+    return strict_ ? value > cutoff : value >= cutoff;
+  };
+  if (keys.isIdentityMapping() && !keys.mayHaveNulls()) {
+    // Computes a word of the selection at a time in a loop without branches.
+    const auto* values = keys.data<T>();
+    auto* bits = rows.asMutableRange().bits();
+    const auto end = rows.end();
+    for (auto word = rows.begin() / 64; word * 64 < end; ++word) {
+      const auto start = word * 64;
+      const auto numRows = std::min<vector_size_t>(64, end - start);
+      uint64_t mask = 0;
+      for (auto i = 0; i < numRows; ++i) {
+        mask |= static_cast<uint64_t>(keep(values[start + i])) << i;
+      }
+      bits[word] &= mask;
+    }
+  } else {
+    for (auto row = rows.begin(); row < rows.end(); ++row) {
+      if (rows.isValid(row) &&
+          !(keys.isNullAt(row) ? nullsFirst_ : keep(keys.valueAt<T>(row)))) {
+        rows.setValid(row, false);
+      }
+    }
+  }
+  rows.updateBounds();
+}
+
+} // namespace facebook::velox::exec
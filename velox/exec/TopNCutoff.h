@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/Operator.h"
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// The cutoff of a TopN style operator that has collected as many rows as its
+/// limit: the first sorting key of the kept row that sorts last. Input rows
+/// whose first key sorts after the cutoff can not make it into the result.
+/// TopNCutoff removes such rows from input batches before the operator
+/// compares them row by row. It also pushes a filter that drops them into the
+/// source of the pipeline, typically TableScan, so that the source can skip
+/// them. Supports first keys of integer types.
+class TopNCutoff {
+ public:
+  /// Returns the cutoff of 'op' or nullptr if the type of the first sorting
+  /// key is not supported. 'keyChannel' is the input channel of the first
+  /// sorting key. 'keyColumn' is its column in 'data', the rows of 'op'. If
+  /// 'strict', rows equal to the cutoff are also removed. This requires the
+  /// first key to be the only sorting key and 'op' to drop new rows that tie
+  /// with its last kept row.
+  static std::unique_ptr<TopNCutoff> create(
+      Operator* op,
+      column_index_t keyChannel,
+      const TypePtr& keyType,
+      const RowContainer* data,
+      column_index_t keyColumn,
+      const core::SortOrder& sortOrder,
+      bool strict);
+
+  TopNCutoff(
+      Operator* op,
+      column_index_t keyChannel,
+      const TypePtr& keyType,
+      const RowContainer* data,
+      column_index_t keyColumn,
+      const core::SortOrder& sortOrder,
+      bool strict);
+
+  /// Sets the cutoff to the first key of 'row', the kept row that sorts last.
+  /// Called after each input batch. Pushes down a new filter if the cutoff
+  /// changed and a few batches passed since the last pushdown.
+  void update(const char* row);
+
+  /// Removes from 'rows' the rows whose first key in 'keys' sorts after the
+  /// cutoff. No-op before the first update().
+  void filter(const DecodedVector& keys, SelectivityVector& rows) const;
+
+  /// The number of input batches between pushdowns of changed cutoffs. Each
+  /// pushdown resets the filter caches of the source.
+  static constexpr int32_t kPushdownIntervalBatches = 8;
+
+ private:
+  template <typename T>
+  void filter(const DecodedVector& keys, SelectivityVector& rows) const;
+
+  // Returns true if 'op_' can push filters into the source of its pipeline.
+  // The operators in between must not depend on which rows they see.
+  bool canPushdown() const;
+
+  // Returns a filter for the rows that do not sort after the cutoff or
+  // nullptr if all rows pass.
+  common::FilterPtr makeFilter() const;
+
+  void pushdown();
+
+  Operator* const op_;
+  const column_index_t keyChannel_;
+  const TypeKind keyKind_;
+  const RowColumn keyColumn_;
+  const bool ascending_;
+  const bool nullsFirst_;
+  const bool strict_;
+
+  bool hasCutoff_{false};
+  // The cutoff, nullopt if it is null.
+  std::optional<int64_t> cutoff_;
+  // True if the cutoff changed since the last pushdown.
+  bool cutoffChanged_{false};
+  // Set on the first pushdown.
+  std::optional<bool> canPushdown_;
+  int32_t numBatchesSincePushdown_{0};
+};
+
+} // namespace facebook::velox::exec
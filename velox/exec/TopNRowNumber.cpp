@@ -155,6 +155,8 @@ TopNRowNumber::TopNRowNumber(
           driverCtx->queryConfig().abandonPartialTopNRowNumberMinRows()),
       abandonPartialMinPct_(
           driverCtx->queryConfig().abandonPartialTopNRowNumberMinPct()),
+      maxPartialMemory_(
+          driverCtx->queryConfig().maxPartialTopNRowNumberMemory()),
       data_(
           std::make_unique<RowContainer>(
               slice(inputType_->children(), 0, spillCompareFlags_.size()),
@@ -197,6 +199,14 @@ TopNRowNumber::TopNRowNumber(
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
     singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    cutoff_ = TopNCutoff::create(
+        this,
+        inputChannels_[0],
+        inputType_->childAt(0),
+        data_.get(),
+        0,
+        node->sortingOrders()[0],
+        /*strict=*/false);
   }
 
   if (generateRowNumber_) {
@@ -259,12 +269,29 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
       addRuntimeStat(
           std::string(TopNRowNumber::kAbandonedPartial), RuntimeCounter(1));
 
+      updateEstimatedOutputRowSize();
+      outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
+      outputRows_.resize(outputBatchSize_);
+    } else if (flushPartial()) {
+      // The rows kept so far are valid partial results. Output them and
+      // start over, the final TopN merges the rows of all the flushes.
+      flushing_ = true;
+      addRuntimeStat(
+          std::string(TopNRowNumber::kPartialFlushes), RuntimeCounter(1));
+
       updateEstimatedOutputRowSize();
       outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
       outputRows_.resize(outputBatchSize_);
     }
   } else {
+    cutoffRows_.resizeFill(numInput);
+    if (cutoff_ != nullptr && singlePartition_->topRank >= limit_) {
+      cutoff_->filter(decodedVectors_[0], cutoffRows_);
+    }
     RANK_FUNCTION_DISPATCH(processInputRowLoop, rankFunction_, numInput);
+    if (cutoff_ != nullptr && singlePartition_->topRank >= limit_) {
+      cutoff_->update(singlePartition_->rows.top());
+    }
   }
 }
 
@@ -282,6 +309,15 @@ bool TopNRowNumber::abandonPartialEarly() const {
   return (100 * numOutput / numInput) >= abandonPartialMinPct_;
 }
 
+bool TopNRowNumber::flushPartial() const {
+  if (table_ == nullptr || generateRowNumber_ || spiller_ != nullptr) {
+    return false;
+  }
+
+  return table_->allocatedBytes() + data_->allocatedBytes() >
+      maxPartialMemory_;
+}
+
 void TopNRowNumber::initializeNewPartitions() {
   for (auto index : lookup_->newGroups) {
     new (lookup_->hits[index] + partitionOffset_)
@@ -466,9 +502,8 @@ void TopNRowNumber::processInputRowLoop(vector_size_t numInput) {
       processInputRow<TRank>(i, partitionAt(lookup_->hits[i]));
     }
   } else {
-    for (auto i = 0; i < numInput; ++i) {
-      processInputRow<TRank>(i, *singlePartition_);
-    }
+    cutoffRows_.applyToSelected(
+        [&](auto i) { processInputRow<TRank>(i, *singlePartition_); });
   }
 }
 
@@ -655,6 +690,15 @@ RowVectorPtr TopNRowNumber::getOutput() {
     return nullptr;
   }
 
+  if (flushing_) {
+    if (auto output = getOutputFromMemory()) {
+      return output;
+    }
+    // getOutputFromMemory() cleared 'data_' and 'table_'.
+    flushing_ = false;
+    partitionIt_.reset();
+  }
+
   if (!noMoreInput_) {
     return nullptr;
   }
@@ -986,7 +1030,7 @@ void TopNRowNumber::reclaim(
     return;
   }
 
-  if (abandonedPartial_) {
+  if (abandonedPartial_ || flushing_) {
     return;
   }
 
@@ -20,6 +20,7 @@
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spiller.h"
+#include "velox/exec/TopNCutoff.h"
 
 namespace facebook::velox::exec {
 class TopNRowNumberSpiller;
@@ -81,6 +82,10 @@ class TopNRowNumber : public Operator {
   /// Runtime stat key indicating partial TopN was abandoned.
   static constexpr std::string_view kAbandonedPartial = "abandonedPartial";
 
+  /// Runtime stat key counting the flushes of a partial TopN that reached
+  /// its memory limit.
+  static constexpr std::string_view kPartialFlushes = "partialFlushes";
+
   TopNRowNumber(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -93,7 +98,8 @@ class TopNRowNumber : public Operator {
       return false;
     }
 
-    return true;
+    // Produces the flushed rows before accepting more input.
+    return !flushing_;
   }
 
   void addInput(RowVectorPtr input) override;
@@ -296,6 +302,11 @@ class TopNRowNumber : public Operator {
   // cardinality sufficiently. Returns false if spilling was triggered earlier.
   bool abandonPartialEarly() const;
 
+  // Returns true if this operator runs a 'partial' stage and the rows it
+  // holds exceed 'maxPartialMemory_'. Returns false if spilling was triggered
+  // earlier.
+  bool flushPartial() const;
+
   // Rank function semantics of operator.
   const core::TopNRowNumberNode::RankFunction rankFunction_;
 
@@ -327,6 +338,12 @@ class TopNRowNumber : public Operator {
   // in cardinality. In this case, it becomes a pass-through.
   bool abandonedPartial_{false};
 
+  const uint64_t maxPartialMemory_;
+
+  // True while a 'partial' stage outputs the rows collected before reaching
+  // 'maxPartialMemory_'. Ends when 'data_' and 'table_' are cleared.
+  bool flushing_{false};
+
   // Hash table to keep track of partitions. Not used if there are no
   // partitioning keys. For each partition, stores an instance of TopRows
   // struct.
@@ -342,6 +359,12 @@ class TopNRowNumber : public Operator {
 
   std::unique_ptr<TopRows> singlePartition_;
 
+  // Drops the input rows after the first sorting key of the top row of
+  // 'singlePartition_' once it has 'limit_' ranks. Null if there are
+  // partitioning keys or the first sorting key type is not supported.
+  std::unique_ptr<TopNCutoff> cutoff_;
+  SelectivityVector cutoffRows_;
+
   // Stores input data. For each partition, only up to 'limit_' rows are stored.
   // Order of columns matches 'inputChannels_': partition keys, sorting keys,
   // the rest.
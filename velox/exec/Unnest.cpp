@@ -44,15 +44,16 @@ Unnest::Unnest(
           OperatorType::kUnnest),
       withOrdinality_(unnestNode->hasOrdinality()),
       withMarker_(unnestNode->hasMarker()),
+      // If splitOutput is set to true in the UnnestNode or it's not set at
+      // all and it's enabled in the QueryConfig.
+      splitOutput_(
+          (unnestNode->splitOutput().has_value() &&
+           unnestNode->splitOutput().value()) ||
+          (!unnestNode->splitOutput().has_value() &&
+           driverCtx->queryConfig().unnestSplitOutput())),
       maxOutputSize_(
-          // If splitOutput is set to true in the UnnestNode or it's not set at
-          // all and it's enabled in the QueryConfig.
-          ((unnestNode->splitOutput().has_value() &&
-            unnestNode->splitOutput().value()) ||
-           (!unnestNode->splitOutput().has_value() &&
-            driverCtx->queryConfig().unnestSplitOutput()))
-              ? outputBatchRows()
-              : std::numeric_limits<vector_size_t>::max()) {
+          splitOutput_ ? outputBatchRows()
+                       : std::numeric_limits<vector_size_t>::max()) {
   const auto& inputType = unnestNode->sources()[0]->outputType();
   const auto& unnestVariables = unnestNode->unnestVariables();
   for (const auto& variable : unnestVariables) {
@@ -135,6 +136,36 @@ void Unnest::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  if (splitOutput_) {
+    maxOutputSize_ =
+        std::min(outputBatchRows(), outputBatchRows(estimateOutputRowSize()));
+  }
+}
+
+uint64_t Unnest::estimateOutputRowSize() const {
+  const auto averageSize = [](const BaseVector& vector, vector_size_t size) {
+    return size == 0 ? 0 : vector.estimateFlatSize() / size;
+  };
+
+  uint64_t rowSize{0};
+  for (const auto& decoded : unnestDecoded_) {
+    if (const auto* array = decoded.base()->as<ArrayVector>()) {
+      const auto& elements = *array->elements();
+      rowSize += averageSize(elements, elements.size());
+    } else {
+      const auto* map = decoded.base()->as<MapVector>();
+      const auto& keys = *map->mapKeys();
+      const auto& values = *map->mapValues();
+      rowSize += averageSize(keys, keys.size());
+      rowSize += averageSize(values, values.size());
+    }
+  }
+  for (const auto& projection : identityProjections_) {
+    rowSize += averageSize(
+        *input_->childAt(projection.inputChannel), input_->size());
+  }
+  return rowSize;
 }
 
 void Unnest::maybeFinishDrain() {
@@ -237,6 +268,18 @@ Unnest::RowRange Unnest::extractRowRange(vector_size_t inputSize) const {
 void Unnest::generateRepeatedColumns(
     const RowRange& range,
     std::vector<VectorPtr>& outputs) {
+  VELOX_CHECK_GT(range.numInputRows, 0);
+  if (range.numInputRows == 1) {
+    // All output rows repeat the same input row.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          range.numInnerRows,
+          range.startInputRow,
+          input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
   auto repeatedIndices = allocateIndices(range.numInnerRows, pool());
@@ -245,7 +288,6 @@ void Unnest::generateRepeatedColumns(
 
   const bool generateMarker = withMarker_ && range.hasEmptyUnnestValue;
   vector_size_t index{0};
-  VELOX_CHECK_GT(range.numInputRows, 0);
   // Record the row number to process.
   if (generateMarker) {
     range.forEachRow(
@@ -302,6 +344,9 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
   bool identityMapping = true;
+  // Offset in the base vector of the next value if the values so far are
+  // contiguous.
+  vector_size_t nextOffset = 0;
   VELOX_DCHECK_GT(range.numInputRows, 0);
 
   range.forEachRow(
@@ -313,11 +358,14 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
         } else if (!currentDecoded.isNullAt(row)) {
           const auto offset = currentOffsets[currentIndices[row]];
           const auto unnestSize = currentSizes[currentIndices[row]];
-          // The 'identityMapping' is false when there exists a partially
-          // processed row.
-          if (index != offset || start != 0 || end != rawMaxSizes_[row] ||
-              unnestSize < end) {
-            identityMapping = false;
+          // The 'identityMapping' is false when the row is padded with nulls
+          // or its values do not follow the ones of the previous rows.
+          if (size > 0) {
+            if (unnestSize < end ||
+                (index > 0 && offset + start != nextOffset)) {
+              identityMapping = false;
+            }
+            nextOffset = offset + end;
           }
           const auto currentUnnestSize = std::min(end, unnestSize);
           for (auto i = start; i < currentUnnestSize; ++i) {
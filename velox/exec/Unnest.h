@@ -120,6 +120,8 @@ class Unnest : public Operator {
   struct UnnestChannelEncoding {
     BufferPtr indices;
     BufferPtr nulls;
+    // True if the unnested values are a contiguous range of the base vector
+    // without nulls, so that they can be sliced instead of wrapped.
     bool identityMapping;
 
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
@@ -141,10 +143,21 @@ class Unnest : public Operator {
   // execution state for the next batch.
   void finishInput();
 
+  // Returns the estimated flat size of an output row for 'input_': the
+  // average size of the unnested values plus the average size of an input row
+  // of the replicated columns.
+  uint64_t estimateOutputRowSize() const;
+
   const bool withOrdinality_;
   const bool withMarker_;
-  // The maximum number of output batch rows.
-  const vector_size_t maxOutputSize_;
+  // Whether the output of an input batch is split into batches of at most
+  // 'maxOutputSize_' rows.
+  const bool splitOutput_;
+  // The maximum number of output batch rows. If 'splitOutput_' is set, this is
+  // the preferred number of output rows, lowered for each input batch so that
+  // the output batches do not exceed the preferred output batch size in bytes
+  // when the unnested values are large.
+  vector_size_t maxOutputSize_;
 
   std::vector<column_index_t> unnestChannels_;
 
@@ -110,6 +110,9 @@ void VectorHasher::hashValues(
       }
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
+  } else if (
+      hashFlatNoNulls<typeProvidesCustomComparison, Kind>(rows, mix, result)) {
+    return;
   } else {
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
@@ -122,6 +125,48 @@ void VectorHasher::hashValues(
   }
 }
 
+template <bool typeProvidesCustomComparison, TypeKind Kind>
+bool VectorHasher::hashFlatNoNulls(
+    const SelectivityVector& rows,
+    bool mix,
+    uint64_t* result) {
+  if constexpr (
+      typeProvidesCustomComparison || Kind == TypeKind::BOOLEAN ||
+      Kind == TypeKind::OPAQUE || Kind == TypeKind::ROW ||
+      Kind == TypeKind::ARRAY || Kind == TypeKind::MAP) {
+    return false;
+  } else {
+    if (!decoded_.isIdentityMapping() || decoded_.mayHaveNulls() ||
+        !rows.isAllSelected()) {
+      return false;
+    }
+    // Hash the contiguous values column at a time without the per row null
+    // and index checks, so that the compiler can unroll and vectorize the
+    // mixing of fixed width values.
+    using T = typename KindToFlatVector<Kind>::HashRowType;
+    const auto* values = decoded_.data<T>();
+    const auto begin = rows.begin();
+    const auto end = rows.end();
+    auto hashValue = [](T value) INLINE_LAMBDA -> uint64_t {
+      if constexpr (std::is_floating_point_v<T>) {
+        return util::floating_point::NaNAwareHash<T>()(value);
+      } else {
+        return folly::hasher<T>()(value);
+      }
+    };
+    if (mix) {
+      for (auto row = begin; row < end; ++row) {
+        result[row] = bits::hashMix(result[row], hashValue(values[row]));
+      }
+    } else {
+      for (auto row = begin; row < end; ++row) {
+        result[row] = hashValue(values[row]);
+      }
+    }
+    return true;
+  }
+}
+
 template <TypeKind Kind>
 bool VectorHasher::makeValueIds(
     const SelectivityVector& rows,
@@ -228,6 +273,9 @@ bool VectorHasher::makeValueIdsFlatNoNulls(
   if (isRange_ && tryMapToRange(values, rows, result)) {
     return true;
   }
+  if constexpr (std::is_same_v<T, StringView>) {
+    return makeStringValueIdsFlat<false>(rows, result);
+  }
 
   bool success = true;
   rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
@@ -241,6 +289,9 @@ template <typename T>
 bool VectorHasher::makeValueIdsFlatWithNulls(
     const SelectivityVector& rows,
     uint64_t* result) {
+  if constexpr (std::is_same_v<T, StringView>) {
+    return makeStringValueIdsFlat<true>(rows, result);
+  }
   const auto* values = decoded_.data<T>();
   const auto* nulls = decoded_.nulls(&rows);
 
@@ -251,6 +302,49 @@ bool VectorHasher::makeValueIdsFlatWithNulls(
   return success;
 }
 
+template <bool mayHaveNulls>
+bool VectorHasher::makeStringValueIdsFlat(
+    const SelectivityVector& rows,
+    uint64_t* result) {
+  const auto* values = decoded_.data<StringView>();
+  const auto* nulls = mayHaveNulls ? decoded_.nulls(&rows) : nullptr;
+  bool success = true;
+  bool hasPrevious = false;
+  StringView previous;
+  uint64_t previousId = 0;
+  rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
+    if constexpr (mayHaveNulls) {
+      if (bits::isBitNull(nulls, row)) {
+        if (multiplier_ == 1) {
+          result[row] = 0;
+        }
+        return;
+      }
+    }
+    const auto value = values[row];
+    if (!success) {
+      analyzeValue(value);
+      return;
+    }
+    // Most different strings differ in the size or the prefix, which the
+    // comparison checks first.
+    if (!hasPrevious || !(value == previous)) {
+      const auto id = valueId(value);
+      if (id == kUnmappable) {
+        success = false;
+        analyzeValue(value);
+        return;
+      }
+      hasPrevious = true;
+      previous = value;
+      previousId = id;
+    }
+    result[row] =
+        multiplier_ == 1 ? previousId : result[row] + multiplier_ * previousId;
+  });
+  return success;
+}
+
 template <typename T, bool mayHaveNulls>
 bool VectorHasher::makeValueIdsDecoded(
     const SelectivityVector& rows,
@@ -637,7 +731,7 @@ void VectorHasher::analyzeValue(StringView value) {
     unique.setId(uniqueValues_.size() + 1);
     auto pair = uniqueValues_.insert(unique);
     if (pair.second) {
-      if (uniqueValues_.size() > kMaxDistinct) {
+      if (uniqueValues_.size() > maxDistinct_) {
         setDistinctOverflow();
         return;
       }
@@ -651,7 +745,7 @@ void VectorHasher::copyStringToLocal(const UniqueValue* unique) {
   if (size <= sizeof(int64_t)) {
     return;
   }
-  if (distinctStringsBytes_ > kMaxDistinctStringsBytes) {
+  if (distinctStringsBytes_ > maxDistinctStringsBytes_) {
     setDistinctOverflow();
     return;
   }
@@ -782,19 +876,20 @@ void extendRange(
   }
 }
 
-int64_t addIdReserve(size_t numDistinct, int32_t reservePct) {
+int64_t
+addIdReserve(size_t numDistinct, int32_t reservePct, size_t maxDistinct) {
   // A merge of hashers in a hash join build may end up over the limit, so
   // return that.
-  if (numDistinct > VectorHasher::kMaxDistinct) {
+  if (numDistinct > maxDistinct) {
     return numDistinct;
   }
   if (reservePct == VectorHasher::kNoLimit) {
-    return VectorHasher::kMaxDistinct;
+    return maxDistinct;
   }
-  // NOTE: 'kMaxDistinct' is a small value so no need to check overflow for
+  // NOTE: 'maxDistinct' fits in int32_t so no need to check overflow for
   // reservation here.
   return std::min<int64_t>(
-      VectorHasher::kMaxDistinct, numDistinct * (1 + (reservePct / 100.0)));
+      maxDistinct, numDistinct * (1 + (reservePct / 100.0)));
 }
 } // namespace
 
@@ -841,7 +936,8 @@ void VectorHasher::cardinality(
     return;
   }
   // Padded count of values + 1 for null.
-  asDistincts = addIdReserve(uniqueValues_.size(), reservePct) + 1;
+  asDistincts =
+      addIdReserve(uniqueValues_.size(), reservePct, maxDistinct_) + 1;
 }
 
 uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
@@ -852,7 +948,8 @@ uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
   checkTypeSupportsValueIds();
 
   multiplier_ = multiplier;
-  rangeSize_ = addIdReserve(uniqueValues_.size(), reservePct) + 1;
+  rangeSize_ =
+      addIdReserve(uniqueValues_.size(), reservePct, maxDistinct_) + 1;
   isRange_ = false;
   uint64_t result;
   if (__builtin_mul_overflow(multiplier_, rangeSize_, &result)) {
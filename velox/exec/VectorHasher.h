@@ -133,9 +133,10 @@ class VectorHasher {
   static constexpr int64_t kMaxRange = ~0UL >> 5;
   static constexpr uint64_t kRangeTooLarge = ~0UL;
   // Stop counting distinct values after this many and revert to regular hash.
+  // This is the default, see setMaxDistinct().
   static constexpr int32_t kMaxDistinct = 100'000;
 
-  // Indicates reserving kMaxDistinct possible values when supplied as
+  // Indicates reserving the max number of distinct values when supplied as
   // reservePct to enableValueIds().
   static constexpr int32_t kNoLimit = -1;
 
@@ -269,6 +270,8 @@ class VectorHasher {
       // Smaller integers would never overflow 100'000 distinct values.
       case TypeKind::INTEGER:
       case TypeKind::BIGINT:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
         return distinctOverflow_;
       default:
         return false;
@@ -301,7 +304,7 @@ class VectorHasher {
   // integer id times 'multiplier'. Leaves 'reservePct' % values at
   // the end of the distinct ids range. Returns 'multiplier' times the
   // number of distinct values reserved. 'reservePct' = kNoLimit means
-  // that we reserve kMaxDistinct distinct values.
+  // that we reserve 'maxDistinct_' distinct values.
   uint64_t enableValueIds(uint64_t multiplier, int32_t reservePct);
 
   // Returns the number of distinct values in range and distinct-values modes.
@@ -359,6 +362,24 @@ class VectorHasher {
     return uniqueValues_.size();
   }
 
+  /// Sets the max number of distinct values to track before reverting to
+  /// regular hash. The limit on the bytes of the tracked distinct strings
+  /// scales with it. A group by with a single or few keys whose cardinality
+  /// is above the default kMaxDistinct can still use value ids this way, at
+  /// the cost of a larger set of unique values. Must be called before any
+  /// values are analyzed.
+  void setMaxDistinct(int32_t maxDistinct) {
+    VELOX_CHECK_GT(maxDistinct, 0);
+    VELOX_CHECK(uniqueValues_.empty());
+    maxDistinct_ = maxDistinct;
+    maxDistinctStringsBytes_ = kMaxDistinctStringsBytes *
+        std::max<double>(1, static_cast<double>(maxDistinct) / kMaxDistinct);
+  }
+
+  size_t maxDistinct() const {
+    return maxDistinct_;
+  }
+
  private:
   static constexpr uint32_t kStringASRangeMaxSize = 7;
   static constexpr uint32_t kStringBufferUnitSize = 1024;
@@ -404,6 +425,13 @@ class VectorHasher {
       const SelectivityVector& rows,
       uint64_t* result);
 
+  // Same as makeValueIdsFlatNoNulls() or makeValueIdsFlatWithNulls() for
+  // strings. Reuses the id of the previous row for an equal string, so that
+  // a run of the same key, e.g. in input clustered by the key, looks up the
+  // distinct values once.
+  template <bool mayHaveNulls>
+  bool makeStringValueIdsFlat(const SelectivityVector& rows, uint64_t* result);
+
   template <typename T, bool mayHaveNulls>
   bool makeValueIdsDecoded(const SelectivityVector& rows, uint64_t* result);
 
@@ -474,7 +502,7 @@ class VectorHasher {
       UniqueValue unique(normalized);
       unique.setId(uniqueValues_.size() + 1);
       if (uniqueValues_.insert(unique).second) {
-        if (uniqueValues_.size() > kMaxDistinct) {
+        if (uniqueValues_.size() > maxDistinct_) {
           setDistinctOverflow();
         }
       }
@@ -599,6 +627,14 @@ class VectorHasher {
   template <bool typeProvidesCustomComparison, TypeKind Kind>
   void hashValues(const SelectivityVector& rows, bool mix, uint64_t* result);
 
+  // Hashes all the 'rows' of a flat decoded vector without nulls in one pass
+  // over the values. Returns false if 'decoded_' or the type doesn't qualify.
+  template <bool typeProvidesCustomComparison, TypeKind Kind>
+  bool hashFlatNoNulls(
+      const SelectivityVector& rows,
+      bool mix,
+      uint64_t* result);
+
   const column_index_t channel_;
   const TypePtr type_;
   const TypeKind typeKind_;
@@ -640,6 +676,11 @@ class VectorHasher {
   std::vector<std::string> uniqueValuesStorage_;
   uint64_t distinctStringsBytes_ = 0;
 
+  // Limits on the number of distinct values and on the bytes of distinct
+  // strings before we set 'distinctOverflow_'.
+  size_t maxDistinct_{kMaxDistinct};
+  uint64_t maxDistinctStringsBytes_{kMaxDistinctStringsBytes};
+
   common::FilterPtr bloomFilter_;
 };
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/Window.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/OperatorType.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PartitionStreamingWindowBuild.h"
@@ -49,9 +50,7 @@ Window::Window(
               ? driverCtx->makeSpillConfig(operatorId, OperatorType::kWindow)
               : std::nullopt),
       numInputColumns_(windowNode->inputType()->size()),
-      windowNode_(windowNode),
-      currentPartition_(nullptr),
-      stringAllocator_(pool()) {
+      windowNode_(windowNode) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (spillConfig == nullptr &&
@@ -90,6 +89,14 @@ Window::Window(
           &nonReclaimableSection_,
           &stats_,
           spillStats_.get());
+      // The partitions of a SortWindowBuild that does not spill are ranges of
+      // rows that stay in memory until the operator finishes.
+      const auto numParallelBatches =
+          driverCtx->queryConfig().windowParallelEvaluationBatches();
+      if (numParallelBatches > 1 && spillConfig == nullptr &&
+          operatorCtx_->task()->queryCtx()->executor() != nullptr) {
+        numParallelBatches_ = numParallelBatches;
+      }
     }
   }
 }
@@ -97,8 +104,13 @@ Window::Window(
 void Window::initialize() {
   Operator::initialize();
   VELOX_CHECK_NOT_NULL(windowNode_);
-  createWindowFunctions();
-  createPeerAndFrameBuffers();
+  // TODO: This computation needs to be revised. It only takes into account
+  // the input columns size. We need to also account for the output columns.
+  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
+  evaluator_ = createEvaluator();
+  for (auto i = 0; i < numParallelBatches_; ++i) {
+    parallelEvaluators_.push_back(createEvaluator());
+  }
   windowBuild_->setNumRowsPerOutput(numRowsPerOutput_);
   windowNode_.reset();
 }
@@ -203,10 +215,9 @@ Window::WindowFrame Window::createWindowFrame(
        std::move(endFrameArg)});
 }
 
-void Window::createWindowFunctions() {
+std::unique_ptr<Window::Evaluator> Window::createEvaluator() {
   VELOX_CHECK_NOT_NULL(windowNode_);
-  VELOX_CHECK(windowFunctions_.empty());
-  VELOX_CHECK(windowFrames_.empty());
+  auto evaluator = std::make_unique<Evaluator>(numInputColumns_, pool());
 
   const auto& inputType = windowNode_->sources()[0]->outputType();
   for (const auto& windowNodeFunction : windowNode_->windowFunctions()) {
@@ -223,19 +234,34 @@ void Window::createWindowFunctions() {
       }
     }
 
-    windowFunctions_.push_back(
+    evaluator->addFunction(
         WindowFunction::create(
             windowNodeFunction.functionCall->name(),
             functionArgs,
             windowNodeFunction.functionCall->type(),
             windowNodeFunction.ignoreNulls,
             operatorCtx_->pool(),
-            &stringAllocator_,
-            operatorCtx_->driverCtx()->queryConfig()));
-
-    windowFrames_.push_back(
+            evaluator->stringAllocator(),
+            operatorCtx_->driverCtx()->queryConfig()),
         createWindowFrame(windowNode_, windowNodeFunction.frame, inputType));
   }
+  evaluator->createPeerAndFrameBuffers(numRowsPerOutput_);
+  return evaluator;
+}
+
+Window::Evaluator::Evaluator(
+    vector_size_t numInputColumns,
+    memory::MemoryPool* pool)
+    : numInputColumns_(numInputColumns),
+      pool_(pool),
+      currentPartition_(nullptr),
+      stringAllocator_(pool) {}
+
+void Window::Evaluator::addFunction(
+    std::unique_ptr<exec::WindowFunction> function,
+    WindowFrame frame) {
+  windowFunctions_.push_back(std::move(function));
+  windowFrames_.push_back(std::move(frame));
 }
 
 bool Window::supportRowsStreaming() {
@@ -249,13 +275,10 @@ bool Window::supportRowsStreaming() {
       return false;
     }
 
-    const auto& frame = windowFunction.frame;
-    // The default frame spans from the start of the partition to current row.
-    const bool isDefaultFrame =
-        (frame.startType == core::WindowNode::BoundType::kUnboundedPreceding &&
-         frame.endType == core::WindowNode::BoundType::kCurrentRow);
-
-    if (windowFunctionMetadata.isAggregate && !isDefaultFrame) {
+    // Aggregates need frames that end at or before the current row.
+    if (windowFunctionMetadata.isAggregate &&
+        !RowsStreamingWindowBuild::numPrecedingRows(windowFunction.frame)
+             .has_value()) {
       return false;
     }
   }
@@ -287,15 +310,12 @@ void Window::reclaim(
   windowBuild_->spill();
 }
 
-void Window::createPeerAndFrameBuffers() {
-  // TODO: This computation needs to be revised. It only takes into account
-  // the input columns size. We need to also account for the output columns.
-  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
-
-  peerStartBuffer_ = AlignedBuffer::allocate<vector_size_t>(
-      numRowsPerOutput_, operatorCtx_->pool());
-  peerEndBuffer_ = AlignedBuffer::allocate<vector_size_t>(
-      numRowsPerOutput_, operatorCtx_->pool());
+void Window::Evaluator::createPeerAndFrameBuffers(
+    vector_size_t numRowsPerOutput) {
+  peerStartBuffer_ =
+      AlignedBuffer::allocate<vector_size_t>(numRowsPerOutput, pool_);
+  peerEndBuffer_ =
+      AlignedBuffer::allocate<vector_size_t>(numRowsPerOutput, pool_);
 
   const auto numFuncs = windowFunctions_.size();
   frameStartBuffers_.reserve(numFuncs);
@@ -303,13 +323,13 @@ void Window::createPeerAndFrameBuffers() {
   validFrames_.reserve(numFuncs);
 
   for (auto i = 0; i < numFuncs; i++) {
-    BufferPtr frameStartBuffer = AlignedBuffer::allocate<vector_size_t>(
-        numRowsPerOutput_, operatorCtx_->pool());
-    BufferPtr frameEndBuffer = AlignedBuffer::allocate<vector_size_t>(
-        numRowsPerOutput_, operatorCtx_->pool());
+    BufferPtr frameStartBuffer =
+        AlignedBuffer::allocate<vector_size_t>(numRowsPerOutput, pool_);
+    BufferPtr frameEndBuffer =
+        AlignedBuffer::allocate<vector_size_t>(numRowsPerOutput, pool_);
     frameStartBuffers_.push_back(frameStartBuffer);
     frameEndBuffers_.push_back(frameEndBuffer);
-    validFrames_.push_back(SelectivityVector(numRowsPerOutput_));
+    validFrames_.push_back(SelectivityVector(numRowsPerOutput));
   }
 }
 
@@ -318,19 +338,33 @@ void Window::noMoreInput() {
   windowBuild_->noMoreInput();
 }
 
-void Window::callResetPartition() {
+void Window::Evaluator::resetPartition(
+    std::shared_ptr<WindowPartition> partition) {
   partitionOffset_ = 0;
   peerStartRow_ = 0;
   peerEndRow_ = 0;
-  currentPartition_ = nullptr;
-  if (windowBuild_->hasNextPartition()) {
-    currentPartition_ = windowBuild_->nextPartition();
+  currentPartition_ = std::move(partition);
+  if (currentPartition_ != nullptr) {
     for (int i = 0; i < windowFunctions_.size(); ++i) {
       windowFunctions_[i]->resetPartition(currentPartition_.get());
     }
   }
 }
 
+std::shared_ptr<WindowPartition> Window::nextPartition() {
+  if (nextPartition_ != nullptr) {
+    return std::move(nextPartition_);
+  }
+  if (windowBuild_->hasNextPartition()) {
+    return windowBuild_->nextPartition();
+  }
+  return nullptr;
+}
+
+void Window::callResetPartition() {
+  evaluator_->resetPartition(nextPartition());
+}
+
 namespace {
 
 template <typename T>
@@ -373,7 +407,7 @@ void updateKRowsOffsetsColumn(
 
 } // namespace
 
-void Window::updateKRowsFrameBounds(
+void Window::Evaluator::updateKRowsFrameBounds(
     bool isKPreceding,
     const FrameChannelArg& frameArg,
     vector_size_t startRow,
@@ -431,7 +465,7 @@ void Window::updateKRowsFrameBounds(
   }
 }
 
-void Window::updateFrameBounds(
+void Window::Evaluator::updateFrameBounds(
     const WindowFrame& windowFrame,
     const bool isStartBound,
     const vector_size_t startRow,
@@ -538,7 +572,7 @@ void computeValidFrames(
 }
 } // namespace
 
-void Window::computePeerAndFrameBuffers(
+void Window::Evaluator::computePeerAndFrameBuffers(
     vector_size_t startRow,
     vector_size_t endRow) {
   const vector_size_t numRows = endRow - startRow;
@@ -599,7 +633,7 @@ void Window::computePeerAndFrameBuffers(
       // do not care about frames. So the function decides further what to do
       // with empty frames.
       computeValidFrames(
-          currentPartition_->numRows() - 1,
+          currentPartition_->lastRow(),
           numRows,
           rawFrameStarts[i],
           rawFrameEnds[i],
@@ -608,7 +642,7 @@ void Window::computePeerAndFrameBuffers(
   }
 }
 
-void Window::getInputColumns(
+void Window::Evaluator::getInputColumns(
     vector_size_t startRow,
     vector_size_t endRow,
     vector_size_t resultOffset,
@@ -620,7 +654,7 @@ void Window::getInputColumns(
   }
 }
 
-void Window::callApplyForPartitionRows(
+void Window::Evaluator::callApplyForPartitionRows(
     vector_size_t startRow,
     vector_size_t endRow,
     vector_size_t resultOffset,
@@ -645,7 +679,6 @@ void Window::callApplyForPartitionRows(
   }
 
   const vector_size_t numRows = endRow - startRow;
-  numProcessedRows_ += numRows;
   partitionOffset_ += numRows;
 
   if (currentPartition_->partial()) {
@@ -653,6 +686,15 @@ void Window::callApplyForPartitionRows(
   }
 }
 
+void Window::callApplyForPartitionRows(
+    vector_size_t startRow,
+    vector_size_t endRow,
+    vector_size_t resultOffset,
+    const RowVectorPtr& result) {
+  evaluator_->callApplyForPartitionRows(startRow, endRow, resultOffset, result);
+  numProcessedRows_ += endRow - startRow;
+}
+
 vector_size_t Window::callApplyLoop(
     vector_size_t numOutputRows,
     const RowVectorPtr& result) {
@@ -661,30 +703,37 @@ vector_size_t Window::callApplyLoop(
   vector_size_t resultIndex = 0;
   vector_size_t numOutputRowsLeft = numOutputRows;
 
-  // This function requires that the currentPartition_ is available for output.
-  VELOX_DCHECK_NOT_NULL(currentPartition_);
+  // This function requires that the current partition is available for output.
+  VELOX_DCHECK_NOT_NULL(evaluator_->partition());
   while (numOutputRowsLeft > 0) {
+    const auto& currentPartition = evaluator_->partition();
+    const auto partitionOffset = evaluator_->partitionOffset();
     const auto numPartitionRows =
-        currentPartition_->numRowsForProcessing(partitionOffset_);
+        currentPartition->numRowsForProcessing(partitionOffset);
     if (numPartitionRows <= numOutputRowsLeft) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
       callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + numPartitionRows,
+          partitionOffset,
+          partitionOffset + numPartitionRows,
           resultIndex,
           result);
       resultIndex += numPartitionRows;
       numOutputRowsLeft -= numPartitionRows;
 
-      if (!currentPartition_->complete()) {
+      if (!evaluator_->partition()->complete()) {
         // There are more data need to process for a partial partition.
-        VELOX_CHECK(currentPartition_->partial());
+        VELOX_CHECK(evaluator_->partition()->partial());
         break;
       }
 
+      if (numParallelBatches_ > 0) {
+        // Leaves the next partitions to evaluatePartitionsInParallel().
+        evaluator_->resetPartition(nullptr);
+        break;
+      }
       callResetPartition();
-      if (currentPartition_ == nullptr) {
+      if (evaluator_->partition() == nullptr) {
         // The WindowBuild doesn't have any more partitions to process right
         // now. So break until the next getOutput call.
         break;
@@ -694,8 +743,8 @@ vector_size_t Window::callApplyLoop(
       // Call apply for the rows that can fit in the buffer and break from
       // outputting.
       callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + numOutputRowsLeft,
+          partitionOffset,
+          partitionOffset + numOutputRowsLeft,
           resultIndex,
           result);
       numOutputRowsLeft = 0;
@@ -720,16 +769,29 @@ RowVectorPtr Window::getOutput() {
     return nullptr;
   }
 
-  if (currentPartition_ == nullptr) {
+  if (numParallelBatches_ > 0 && evaluator_->partition() == nullptr) {
+    if (parallelOutputs_.empty()) {
+      evaluatePartitionsInParallel();
+    }
+    if (!parallelOutputs_.empty()) {
+      auto output = std::move(parallelOutputs_.front());
+      parallelOutputs_.pop_front();
+      numProcessedRows_ += output->size();
+      return output;
+    }
+  }
+
+  if (evaluator_->partition() == nullptr) {
     callResetPartition();
-    if (currentPartition_ == nullptr) {
+    if (evaluator_->partition() == nullptr) {
       // WindowBuild doesn't have a partition to output.
       return nullptr;
     }
   }
 
-  if (!currentPartition_->complete() &&
-      (currentPartition_->numRowsForProcessing(partitionOffset_) == 0)) {
+  if (!evaluator_->partition()->complete() &&
+      (evaluator_->partition()->numRowsForProcessing(
+           evaluator_->partitionOffset()) == 0)) {
     return nullptr;
   }
 
@@ -744,4 +806,87 @@ RowVectorPtr Window::getOutput() {
       : result;
 }
 
+void Window::evaluatePartitionsInParallel() {
+  VELOX_CHECK(parallelOutputs_.empty());
+  std::vector<std::vector<std::shared_ptr<WindowPartition>>> runs;
+  vector_size_t runRows{0};
+  while (auto partition = nextPartition()) {
+    const auto numRows = partition->numRows();
+    if (numRows > numRowsPerOutput_) {
+      // 'evaluator_' splits the partition over output batches.
+      nextPartition_ = std::move(partition);
+      break;
+    }
+    if (runs.empty() || runRows + numRows > numRowsPerOutput_) {
+      if (runs.size() == parallelEvaluators_.size()) {
+        nextPartition_ = std::move(partition);
+        break;
+      }
+      runs.emplace_back();
+      runRows = 0;
+    }
+    runs.back().push_back(std::move(partition));
+    runRows += numRows;
+  }
+  if (runs.empty()) {
+    return;
+  }
+
+  auto* executor = operatorCtx_->task()->queryCtx()->executor();
+  std::vector<std::shared_ptr<AsyncSource<RowVectorPtr>>> pending;
+  pending.reserve(runs.size() - 1);
+  for (auto i = 1; i < runs.size(); ++i) {
+    pending.push_back(std::make_shared<AsyncSource<RowVectorPtr>>(
+        [this, evaluator = parallelEvaluators_[i].get(), run = &runs[i]]() {
+          return std::make_unique<RowVectorPtr>(evaluateRun(*evaluator, *run));
+        }));
+    executor->add([source = pending.back()]() { source->prepare(); });
+  }
+
+  // Waits for all the runs before rethrowing an error, since the pending ones
+  // reference 'runs' and the evaluators.
+  std::exception_ptr error;
+  try {
+    parallelOutputs_.push_back(evaluateRun(*parallelEvaluators_[0], runs[0]));
+  } catch (...) {
+    error = std::current_exception();
+  }
+  for (auto& source : pending) {
+    try {
+      auto output = source->move();
+      parallelOutputs_.push_back(std::move(*output));
+    } catch (...) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  addRuntimeStat(kWindowParallelBatches, RuntimeCounter(runs.size()));
+}
+
+RowVectorPtr Window::evaluateRun(
+    Evaluator& evaluator,
+    const std::vector<std::shared_ptr<WindowPartition>>& partitions) {
+  vector_size_t numRows{0};
+  for (const auto& partition : partitions) {
+    numRows += partition->numRows();
+  }
+  auto result =
+      BaseVector::create<RowVector>(outputType_, numRows, operatorCtx_->pool());
+  vector_size_t resultOffset{0};
+  for (const auto& partition : partitions) {
+    const auto numPartitionRows = partition->numRows();
+    evaluator.resetPartition(partition);
+    evaluator.callApplyForPartitionRows(
+        0, numPartitionRows, resultOffset, result);
+    resultOffset += numPartitionRows;
+  }
+  evaluator.resetPartition(nullptr);
+  return result;
+}
+
 } // namespace facebook::velox::exec
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/WindowBuild.h"
@@ -72,6 +74,11 @@ class Window : public Operator {
   static constexpr std::string_view kWindowSpillReadNumBatches{
       "windowSpillReadNumBatches"};
 
+  /// Runtime statistics holding the number of output batches of whole
+  /// partitions that were evaluated in parallel.
+  static constexpr std::string_view kWindowParallelBatches{
+      "windowParallelBatches"};
+
  private:
   // Used for k preceding/following frames. Index is the column index if k is a
   // column. value is used to read column values from the column index when k
@@ -98,8 +105,146 @@ class Window : public Operator {
   // any frame type. Also supports the agg window function with default frame.
   bool supportRowsStreaming();
 
-  // Creates WindowFunction and frame objects for this operator.
-  void createWindowFunctions();
+  // The window functions of the operator and the state for evaluating them
+  // over the rows of one partition at a time.
+  class Evaluator {
+   public:
+    Evaluator(vector_size_t numInputColumns, memory::MemoryPool* pool);
+
+    // The allocator for the functions' out of line buffers.
+    HashStringAllocator* stringAllocator() {
+      return &stringAllocator_;
+    }
+
+    void addFunction(
+        std::unique_ptr<exec::WindowFunction> function,
+        WindowFrame frame);
+
+    // Creates the buffers for peer and frame row
+    // indices to send in window function apply invocations.
+    void createPeerAndFrameBuffers(vector_size_t numRowsPerOutput);
+
+    // The partition being evaluated. nullptr if none.
+    const std::shared_ptr<WindowPartition>& partition() const {
+      return currentPartition_;
+    }
+
+    // Tracks how far along the partition rows have been output.
+    vector_size_t partitionOffset() const {
+      return partitionOffset_;
+    }
+
+    // Updates all the state for 'partition'. nullptr clears the state.
+    void resetPartition(std::shared_ptr<WindowPartition> partition);
+
+    // Computes the result vector for a subset of the current
+    // partition rows starting from startRow to endRow. A single partition
+    // could span multiple output blocks and a single output block could
+    // also have multiple partitions in it. So resultOffset is the
+    // offset in the result vector corresponding to the current range of
+    // partition rows.
+    void callApplyForPartitionRows(
+        vector_size_t startRow,
+        vector_size_t endRow,
+        vector_size_t resultOffset,
+        const RowVectorPtr& result);
+
+   private:
+    // Compute the peer and frame buffers for rows between
+    // startRow and endRow in the current partition.
+    void computePeerAndFrameBuffers(
+        vector_size_t startRow,
+        vector_size_t endRow);
+
+    // Gets the input columns of the current window partition
+    // between startRow and endRow in result at resultOffset.
+    void getInputColumns(
+        vector_size_t startRow,
+        vector_size_t endRow,
+        vector_size_t resultOffset,
+        const RowVectorPtr& result);
+
+    // Update frame bounds for kPreceding, kFollowing row frames.
+    void updateKRowsFrameBounds(
+        bool isKPreceding,
+        const FrameChannelArg& frameArg,
+        vector_size_t startRow,
+        vector_size_t numRows,
+        vector_size_t* rawFrameBounds);
+
+    // Populate frame bounds in the current partition into rawFrameBounds.
+    // Unselect rows from validFrames where the frame bounds are NaN that are
+    // invalid.
+    void updateFrameBounds(
+        const WindowFrame& windowFrame,
+        const bool isStartBound,
+        const vector_size_t startRow,
+        const vector_size_t numRows,
+        const vector_size_t* rawPeerStarts,
+        const vector_size_t* rawPeerEnds,
+        vector_size_t* rawFrameBounds,
+        SelectivityVector& validFrames);
+
+    const vector_size_t numInputColumns_;
+
+    memory::MemoryPool* const pool_;
+
+    // Used to access window partition rows and columns by the window
+    // operator and functions. This structure is owned by the WindowBuild.
+    std::shared_ptr<WindowPartition> currentPartition_;
+
+    // HashStringAllocator required by functions that allocate out of line
+    // buffers.
+    HashStringAllocator stringAllocator_;
+
+    // Vector of WindowFunction objects required by this operator.
+    // WindowFunction is the base API implemented by all the window functions.
+    // The functions are ordered by their positions in the output columns.
+    std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions_;
+
+    // Vector of WindowFrames corresponding to each windowFunction above.
+    // It represents the frame spec for the function computation.
+    std::vector<WindowFrame> windowFrames_;
+
+    // The following 4 Buffers are used to pass peer and frame start and end
+    // values to the WindowFunction::apply method. These buffers can be
+    // allocated once and reused across all the getOutput calls.
+    // Only a single peer start and peer end buffer is needed across all
+    // functions (as the peer values are based on the ORDER BY clause).
+    BufferPtr peerStartBuffer_;
+    BufferPtr peerEndBuffer_;
+    // A separate BufferPtr is required for the frame indexes of each function.
+    // Each function has its own frame clause and style. So we have as many
+    // buffers as the number of functions.
+    std::vector<BufferPtr> frameStartBuffers_;
+    std::vector<BufferPtr> frameEndBuffers_;
+
+    // Frame types for kPreceding or kFollowing could result in empty frames
+    // if the frameStart > frameEnds, or frameEnds < firstPartitionRow or
+    // frameStarts > lastPartitionRow. Such frames usually evaluate to NULL in
+    // the window function.
+    // This SelectivityVector captures the valid (non-empty) frames in the
+    // buffer being worked on. The window function can use this to compute
+    // output values. There is one SelectivityVector per window function.
+    std::vector<SelectivityVector> validFrames_;
+
+    // Tracks how far along the partition rows have been output.
+    vector_size_t partitionOffset_ = 0;
+
+    // When traversing input partition rows, the peers are the rows with the
+    // same values for the ORDER BY clause. These rows are equal in some ways
+    // and affect the results of ranking functions. Since all rows between the
+    // peerStartRow_ and peerEndRow_ have the same values for peerStartRow_ and
+    // peerEndRow_, we needn't compute them for each row independently. Since
+    // these rows might cross getOutput boundaries and be called in subsequent
+    // calls to computePeerBuffers they are saved here.
+    vector_size_t peerStartRow_ = 0;
+    vector_size_t peerEndRow_ = 0;
+  };
+
+  // Creates an Evaluator with the WindowFunction and frame objects for this
+  // operator.
+  std::unique_ptr<Evaluator> createEvaluator();
 
   // Converts WindowNode::Frame to Window::WindowFrame.
   WindowFrame createWindowFrame(
@@ -107,37 +252,20 @@ class Window : public Operator {
       const core::WindowNode::Frame& frame,
       const RowTypePtr& inputType);
 
-  // Creates the buffers for peer and frame row
-  // indices to send in window function apply invocations.
-  void createPeerAndFrameBuffers();
-
-  // Compute the peer and frame buffers for rows between
-  // startRow and endRow in the current partition.
-  void computePeerAndFrameBuffers(vector_size_t startRow, vector_size_t endRow);
+  // Returns the next partition to evaluate, nullptr if there is none now.
+  std::shared_ptr<WindowPartition> nextPartition();
 
   // Updates all the state for the next partition.
   void callResetPartition();
 
-  // Computes the result vector for a subset of the current
-  // partition rows starting from startRow to endRow. A single partition
-  // could span multiple output blocks and a single output block could
-  // also have multiple partitions in it. So resultOffset is the
-  // offset in the result vector corresponding to the current range of
-  // partition rows.
+  // Computes the result vector for a subset of the current partition rows
+  // with 'evaluator_'.
   void callApplyForPartitionRows(
       vector_size_t startRow,
       vector_size_t endRow,
       vector_size_t resultOffset,
       const RowVectorPtr& result);
 
-  // Gets the input columns of the current window partition
-  // between startRow and endRow in result at resultOffset.
-  void getInputColumns(
-      vector_size_t startRow,
-      vector_size_t endRow,
-      vector_size_t resultOffset,
-      const RowVectorPtr& result);
-
   // Computes the result vector for a single output block. The result
   // consists of all the input columns followed by the results of the
   // window function.
@@ -146,26 +274,16 @@ class Window : public Operator {
       vector_size_t numOutputRows,
       const RowVectorPtr& result);
 
-  // Update frame bounds for kPreceding, kFollowing row frames.
-  void updateKRowsFrameBounds(
-      bool isKPreceding,
-      const FrameChannelArg& frameArg,
-      vector_size_t startRow,
-      vector_size_t numRows,
-      vector_size_t* rawFrameBounds);
-
-  // Populate frame bounds in the current partition into rawFrameBounds.
-  // Unselect rows from validFrames where the frame bounds are NaN that are
-  // invalid.
-  void updateFrameBounds(
-      const WindowFrame& windowFrame,
-      const bool isStartBound,
-      const vector_size_t startRow,
-      const vector_size_t numRows,
-      const vector_size_t* rawPeerStarts,
-      const vector_size_t* rawPeerEnds,
-      vector_size_t* rawFrameBounds,
-      SelectivityVector& validFrames);
+  // Takes runs of consecutive whole partitions that each fit in an output
+  // batch, one run per 'parallelEvaluators_', and evaluates the runs in
+  // parallel on the query executor into 'parallelOutputs_'. Leaves a partition
+  // larger than an output batch to 'evaluator_'.
+  void evaluatePartitionsInParallel();
+
+  // Evaluates 'partitions' with 'evaluator' into one output batch.
+  RowVectorPtr evaluateRun(
+      Evaluator& evaluator,
+      const std::vector<std::shared_ptr<WindowPartition>>& partitions);
 
   const vector_size_t numInputColumns_;
 
@@ -177,44 +295,21 @@ class Window : public Operator {
   // reset after the initialization.
   std::shared_ptr<const core::WindowNode> windowNode_;
 
-  // Used to access window partition rows and columns by the window
-  // operator and functions. This structure is owned by the WindowBuild.
-  std::shared_ptr<WindowPartition> currentPartition_;
-
-  // HashStringAllocator required by functions that allocate out of line
-  // buffers.
-  HashStringAllocator stringAllocator_;
-
-  // Vector of WindowFunction objects required by this operator.
-  // WindowFunction is the base API implemented by all the window functions.
-  // The functions are ordered by their positions in the output columns.
-  std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions_;
-
-  // Vector of WindowFrames corresponding to each windowFunction above.
-  // It represents the frame spec for the function computation.
-  std::vector<WindowFrame> windowFrames_;
-
-  // The following 4 Buffers are used to pass peer and frame start and end
-  // values to the WindowFunction::apply method. These buffers can be allocated
-  // once and reused across all the getOutput calls.
-  // Only a single peer start and peer end buffer is needed across all
-  // functions (as the peer values are based on the ORDER BY clause).
-  BufferPtr peerStartBuffer_;
-  BufferPtr peerEndBuffer_;
-  // A separate BufferPtr is required for the frame indexes of each function.
-  // Each function has its own frame clause and style. So we have as many
-  // buffers as the number of functions.
-  std::vector<BufferPtr> frameStartBuffers_;
-  std::vector<BufferPtr> frameEndBuffers_;
-
-  // Frame types for kPreceding or kFollowing could result in empty frames if
-  // the frameStart > frameEnds, or frameEnds < firstPartitionRow or frameStarts
-  // > lastPartitionRow. Such frames usually evaluate to NULL in the window
-  // function.
-  // This SelectivityVector captures the valid (non-empty) frames in the buffer
-  // being worked on. The window function can use this to compute output values.
-  // There is one SelectivityVector per window function.
-  std::vector<SelectivityVector> validFrames_;
+  // Evaluates the partitions one after the other.
+  std::unique_ptr<Evaluator> evaluator_;
+
+  // The number of output batches of whole partitions to evaluate at a time in
+  // parallel. 0 if the partitions are evaluated by 'evaluator_' only.
+  uint32_t numParallelBatches_{0};
+
+  // One per parallel output batch. Empty if 'numParallelBatches_' is 0.
+  std::vector<std::unique_ptr<Evaluator>> parallelEvaluators_;
+
+  // The batches from evaluatePartitionsInParallel() that are not returned yet.
+  std::deque<RowVectorPtr> parallelOutputs_;
+
+  // A partition taken from 'windowBuild_' that is not evaluated yet.
+  std::shared_ptr<WindowPartition> nextPartition_;
 
   // Number of input rows.
   vector_size_t numRows_ = 0;
@@ -227,19 +322,6 @@ class Window : public Operator {
   // value is updated as the WindowFunction::apply() function is
   // called on the partition blocks.
   vector_size_t numProcessedRows_ = 0;
-
-  // Tracks how far along the partition rows have been output.
-  vector_size_t partitionOffset_ = 0;
-
-  // When traversing input partition rows, the peers are the rows with the same
-  // values for the ORDER BY clause. These rows are equal in some ways and
-  // affect the results of ranking functions. Since all rows between the
-  // peerStartRow_ and peerEndRow_ have the same values for peerStartRow_ and
-  // peerEndRow_, we needn't compute them for each row independently. Since
-  // these rows might cross getOutput boundaries and be called in subsequent
-  // calls to computePeerBuffers they are saved here.
-  vector_size_t peerStartRow_ = 0;
-  vector_size_t peerEndRow_ = 0;
 };
 
 } // namespace facebook::velox::exec
@@ -23,8 +23,10 @@ WindowPartition::WindowPartition(
     const std::vector<column_index_t>& inputMapping,
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo,
     bool partial,
-    bool complete)
+    bool complete,
+    vector_size_t numPrecedingRows)
     : partial_(partial),
+      numPrecedingRows_(numPrecedingRows),
       data_(data),
       partition_(rows),
       complete_(complete),
@@ -43,13 +45,21 @@ WindowPartition::WindowPartition(
     const folly::Range<char**>& rows,
     const std::vector<column_index_t>& inputMapping,
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
-    : WindowPartition(data, rows, inputMapping, sortKeyInfo, false, true) {}
+    : WindowPartition(data, rows, inputMapping, sortKeyInfo, false, true, 0) {}
 
 WindowPartition::WindowPartition(
     RowContainer* data,
     const std::vector<column_index_t>& inputMapping,
-    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
-    : WindowPartition(data, {}, inputMapping, sortKeyInfo, true, false) {}
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo,
+    vector_size_t numPrecedingRows)
+    : WindowPartition(
+          data,
+          {},
+          inputMapping,
+          sortKeyInfo,
+          true,
+          false,
+          numPrecedingRows) {}
 
 void WindowPartition::addRows(const std::vector<char*>& rows) {
   checkPartial();
@@ -67,22 +77,33 @@ void WindowPartition::removeProcessedRows(vector_size_t numRows) {
   checkPartial();
 
   VELOX_CHECK_NULL(previousRow_);
-  if (complete_ && rows_.size() == numRows) {
-    eraseRows(numRows);
+  const vector_size_t numProcessedRows = numRetainedRows_ + numRows;
+  VELOX_CHECK_LE(numProcessedRows, rows_.size());
+  vector_size_t numRemovedRows;
+  if (complete_ && rows_.size() == numProcessedRows) {
+    numRetainedRows_ = 0;
+    numRemovedRows = numProcessedRows;
+    eraseRows(numRemovedRows);
+  } else if (numPrecedingRows_ == 0) {
+    numRemovedRows = numProcessedRows;
+    eraseRows(numRemovedRows - 1);
+    previousRow_ = rows_[numRemovedRows - 1];
   } else {
-    eraseRows(numRows - 1);
-    previousRow_ = rows_[numRows - 1];
+    // The kept rows also serve as the previous row for the peer groups.
+    numRetainedRows_ = std::min(numPrecedingRows_, numProcessedRows);
+    numRemovedRows = numProcessedRows - numRetainedRows_;
+    eraseRows(numRemovedRows);
   }
 
-  rows_.erase(rows_.cbegin(), rows_.cbegin() + numRows);
+  rows_.erase(rows_.cbegin(), rows_.cbegin() + numRemovedRows);
   partition_ = folly::Range(rows_.data(), rows_.size());
-  startRow_ += numRows;
+  startRow_ += numRemovedRows;
 }
 
 vector_size_t WindowPartition::numRowsForProcessing(
     vector_size_t partitionOffset) const {
   if (partial_) {
-    return partition_.size();
+    return partition_.size() - numRetainedRows_;
   } else {
     return partition_.size() - partitionOffset;
   }
@@ -123,8 +144,9 @@ void WindowPartition::extractNulls(
     vector_size_t partitionOffset,
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
+  VELOX_CHECK_GE(partitionOffset, startRow_);
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -232,11 +254,17 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
   size_t next = start;
   size_t index{0};
   if (partial_ && start > 0) {
-    const auto peerGroup = peerCompare(previousRow_, partition_[0]);
+    const auto* previousRow = previousRow_ != nullptr
+        ? previousRow_
+        : partition_[start - startRow_ - 1];
+    const auto peerGroup =
+        peerCompare(previousRow, partition_[start - startRow_]);
 
     // The first row is the last row in previous batch so delete it after used
     // for the first peer group detection.
-    removePreviousRow();
+    if (previousRow_ != nullptr) {
+      removePreviousRow();
+    }
 
     if (!peerGroup) {
       peerEnd = findPeerRowEndIndex(start, lastPartitionRow, peerCompare);
@@ -49,18 +49,22 @@ class WindowPartition {
 
   /// The WindowPartition is used for RowStreamingWindowBuild which allows to
   /// start data processing with a subset of partition rows. 'partial_' flag is
-  /// set for the constructed window partition.
+  /// set for the constructed window partition. 'numPrecedingRows' is the
+  /// number of processed rows that are kept for the frames of the following
+  /// rows, e.g. k + 1 for 'ROWS BETWEEN k PRECEDING AND CURRENT ROW'.
   WindowPartition(
       RowContainer* data,
       const std::vector<column_index_t>& inputMapping,
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
-          sortKeyInfo);
+          sortKeyInfo,
+      vector_size_t numPrecedingRows = 0);
 
   /// Adds remaining input 'rows' for a partial window partition.
   void addRows(const std::vector<char*>& rows);
 
-  /// Removes the first 'numRows' in 'rows_' from a partial window partition
-  /// after been processed.
+  /// Removes the first 'numRows' unprocessed rows in 'rows_' from a partial
+  /// window partition after been processed. Keeps the last
+  /// 'numPrecedingRows_' processed rows.
   void removeProcessedRows(vector_size_t numRows);
 
   /// Returns the number of rows in the current WindowPartition.
@@ -68,6 +72,13 @@ class WindowPartition {
     return partition_.size();
   }
 
+  /// Returns the partition offset of the last row in the current
+  /// WindowPartition. Differs from numRows() - 1 for a partial partition that
+  /// has removed processed rows.
+  vector_size_t lastRow() const {
+    return startRow_ + partition_.size() - 1;
+  }
+
   /// Returns the number of rows in a window partition remaining for data
   /// processing.
   vector_size_t numRowsForProcessing(vector_size_t partitionOffset) const;
@@ -179,7 +190,8 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo,
       bool partial,
-      bool complete);
+      bool complete,
+      vector_size_t numPrecedingRows);
 
   bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
 
@@ -242,6 +254,10 @@ class WindowPartition {
   // processing.
   const bool partial_;
 
+  // Number of processed rows a partial partition keeps for the frames of the
+  // following rows.
+  const vector_size_t numPrecedingRows_;
+
   // The RowContainer associated with the partition.
   // It is owned by the WindowBuild that creates the partition.
   RowContainer* const data_;
@@ -282,9 +298,13 @@ class WindowPartition {
   // non-partial partition.
   vector_size_t startRow_{0};
 
+  // Number of processed rows at the start of 'rows_' that are kept for the
+  // frames of the following rows. At most 'numPrecedingRows_'.
+  vector_size_t numRetainedRows_{0};
+
   // Points to the last row from the previous processed peer group if not null.
-  // This is only set for a partial window partition and always null for a
-  // non-partial one.
+  // This is only set for a partial window partition that keeps no processed
+  // rows and always null for a non-partial one.
   char* previousRow_{nullptr};
 };
 } // namespace facebook::velox::exec
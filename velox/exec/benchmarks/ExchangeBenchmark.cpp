@@ -41,6 +41,15 @@ DEFINE_int64(
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
+DEFINE_bool(
+    scatter_serialization,
+    false,
+    "Serialize PartitionedOutput batches a column at a time across "
+    "destinations");
+DEFINE_int32(
+    scatter_partitions,
+    1024,
+    "Number of destinations in the scatter serialization benchmarks");
 // Add the following definitions to allow Clion runs
 DEFINE_bool(gtest_color, false, "");
 DEFINE_string(gtest_filter, "*", "");
@@ -139,6 +148,9 @@ class ExchangeBenchmark : public VectorTestBase {
       assert(!vectors.empty());
       configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
           fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+      configSettings_
+          [core::QueryConfig::kPartitionedOutputScatterSerialization] =
+              FLAGS_scatter_serialization ? "true" : "false";
       const auto iteration = ++iteration_;
 
       // leafPlan: PartitionedOutput/kPartitioned(1) <-- Values(0)
@@ -224,6 +236,53 @@ class ExchangeBenchmark : public VectorTestBase {
     };
   }
 
+  /// Serializes each of 'vectors' into 'numGroups' stream groups, row i
+  /// going to group i % numGroups, as PartitionedOutput does with that many
+  /// destinations. Appends a group at a time or, if 'scatter' is true, with
+  /// VectorStreamGroup::scatter().
+  void runScatter(
+      const std::vector<RowVectorPtr>& vectors,
+      int32_t numGroups,
+      bool scatter) {
+    std::vector<std::unique_ptr<VectorStreamGroup>> groups;
+    std::vector<VectorStreamGroup*> groupPtrs;
+    std::vector<std::vector<vector_size_t>> groupRows(numGroups);
+    std::vector<folly::Range<const vector_size_t*>> ranges;
+    Scratch scratch;
+    BENCHMARK_SUSPEND {
+      assert(!vectors.empty());
+      auto* serde = getNamedVectorSerde("Presto");
+      const auto rowType = asRowType(vectors[0]->type());
+      for (auto i = 0; i < numGroups; ++i) {
+        groups.push_back(
+            std::make_unique<VectorStreamGroup>(pool_.get(), serde));
+        groups.back()->createStreamTree(rowType, vectors[0]->size());
+        groupPtrs.push_back(groups.back().get());
+      }
+      // All vectors have the same size.
+      for (vector_size_t row = 0; row < vectors[0]->size(); ++row) {
+        groupRows[row % numGroups].push_back(row);
+      }
+      for (const auto& rows : groupRows) {
+        ranges.emplace_back(rows.data(), rows.size());
+      }
+    };
+
+    for (const auto& vector : vectors) {
+      if (scatter) {
+        VectorStreamGroup::scatter(vector, groupPtrs, ranges, scratch);
+      } else {
+        for (auto i = 0; i < numGroups; ++i) {
+          groupPtrs[i]->append(vector, ranges[i], scratch);
+        }
+      }
+    }
+
+    BENCHMARK_SUSPEND {
+      groups.clear();
+    };
+  }
+
   void runLocal(
       std::vector<RowVectorPtr>& vectors,
       int32_t taskWidth,
@@ -508,6 +567,29 @@ void runBenchmarks() {
     return 1;
   });
 
+  // Serialization into many destinations with few rows each. A row is
+  // serialized once either way. Column at a time goes over each column of the
+  // batch once instead of once per destination.
+  folly::addBenchmark(__FILE__, "appendFlat10k", [&]() {
+    bm->runScatter(flat10k, FLAGS_scatter_partitions, false);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "scatterFlat10k", [&]() {
+    bm->runScatter(flat10k, FLAGS_scatter_partitions, true);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "appendDeep10k", [&]() {
+    bm->runScatter(deep10k, FLAGS_scatter_partitions, false);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "scatterDeep10k", [&]() {
+    bm->runScatter(deep10k, FLAGS_scatter_partitions, true);
+    return 1;
+  });
+
   int64_t localPartitionWallUs;
   PlanNodeStats localPartitionStatsFlat10K;
   LocalPartitionWaitStats localPartitionWaitStats;
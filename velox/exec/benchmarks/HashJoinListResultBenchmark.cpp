@@ -44,13 +44,17 @@ struct HashTableBenchmarkParams {
       int64_t probeSize,
       const std::vector<std::pair<int32_t, int32_t>>&
           keyRepeatTimesDistribution,
-      bool runErase)
+      bool runErase,
+      bool skewedProbe = false,
+      bool dictionaryOutput = false)
       : mode{mode},
         buildType{buildType},
         hashTableSize{hashTableSize},
         probeSize{probeSize},
         keyRepeatTimesDistribution{keyRepeatTimesDistribution},
-        runErase{runErase} {
+        runErase{runErase},
+        skewedProbe{skewedProbe},
+        dictionaryOutput{dictionaryOutput} {
     int32_t distSum = 0;
     buildSize = 0;
     buildKeyRepeat.reserve(keyRepeatTimesDistribution.size());
@@ -93,6 +97,12 @@ struct HashTableBenchmarkParams {
     if (runErase) {
       title += ",withErase";
     }
+    if (skewedProbe) {
+      title += ",skewedProbe";
+    }
+    if (dictionaryOutput) {
+      title += ",dictionaryOutput";
+    }
   }
 
   // Expected mode.
@@ -113,6 +123,16 @@ struct HashTableBenchmarkParams {
 
   bool runErase;
 
+  // If true, the probe keys are the first 'kNumSkewedProbeKeys' keys, which
+  // repeat most in the build side, and the dependent columns of the join
+  // results are extracted in batches of 'kSkewedOutputBatchRows' like
+  // HashProbe does.
+  bool skewedProbe;
+
+  // If true, the dependent columns of the join results are extracted once per
+  // distinct build row and wrapped in dictionaries when the rows repeat.
+  bool dictionaryOutput;
+
   // Title for reporting
   std::string title;
 
@@ -166,6 +186,8 @@ struct HashTableBenchmarkResult {
 
   double eraseClock{0};
 
+  double extractClock{0};
+
   uint64_t peakMemoryBytes{0};
 
   // The mode of the table.
@@ -177,6 +199,7 @@ struct HashTableBenchmarkResult {
     listJoinResultClocks += other.listJoinResultClocks;
     totalClock += other.totalClock;
     eraseClock += other.eraseClock;
+    extractClock += other.extractClock;
     peakMemoryBytes += other.peakMemoryBytes;
   }
 
@@ -195,6 +218,10 @@ struct HashTableBenchmarkResult {
       out << " eraseClock=" << eraseClock << "("
           << (eraseClock / totalClock * 100) << "%)";
     }
+    if (params.skewedProbe) {
+      out << " extractClock=" << extractClock << "("
+          << (extractClock / totalClock * 100) << "%)";
+    }
     return out.str();
   }
 };
@@ -231,6 +258,7 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     }
     result.buildClocks += buildTime_;
     result.listJoinResultClocks += listJoinResultTime_;
+    result.extractClock += extractTime_;
     result.totalClock = totalClocks;
     result.peakMemoryBytes = tableAggregatePool->peakBytes();
     return result;
@@ -309,13 +337,17 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
   // Create the row vector for the probe side, where the first column is used
   // as the join key, and the remaining columns are dependent fields.
   // Probe key is within the range [0, hashTableSize].
+  // If 'skewedProbe' is set, the probe key is one of the first
+  // 'kNumSkewedProbeKeys' keys.
   RowVectorPtr
   makeProbeVector(int32_t size, int64_t hashTableSize, int64_t& sequence) {
+    const auto numKeys =
+        params_.skewedProbe ? kNumSkewedProbeKeys : hashTableSize;
     std::vector<VectorPtr> children;
     children.push_back(
         makeFlatVector<int64_t>(
             size,
-            [&](vector_size_t row) { return (sequence + row) % hashTableSize; },
+            [&](vector_size_t row) { return (sequence + row) % numKeys; },
             nullptr));
     sequence += size;
     for (int32_t i = 0; i < params_.numDependentFields; ++i) {
@@ -334,8 +366,7 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     auto numKeys = hashers.size();
     auto numDependentFields = batch->childrenSize() - numKeys;
 
-    std::vector<DecodedVector> decoders;
-    decoders.reserve(numDependentFields);
+    std::vector<DecodedVector> decoders(numDependentFields);
     SelectivityVector rows(batchSize);
 
     for (auto i = 0; i < batch->childrenSize(); ++i) {
@@ -365,7 +396,9 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
   // Prepare join table.
   void buildTable(
       const std::vector<std::shared_ptr<memory::MemoryPool>>& tablePools) {
-    std::vector<TypePtr> dependentTypes;
+    std::vector<TypePtr> dependentTypes(
+        params_.buildType->children().begin() + 1,
+        params_.buildType->children().end());
     std::vector<std::unique_ptr<BaseHashTable>> otherTables;
     std::vector<RowVectorPtr> batches;
     makeBuildBatches(batches);
@@ -453,7 +486,8 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     const auto numBatch = params_.probeSize / params_.hashTableSize;
     const auto batchSize = params_.hashTableSize;
     BufferPtr outputRowMapping;
-    auto outputBatchSize = batchSize;
+    auto outputBatchSize =
+        params_.skewedProbe ? kSkewedOutputBatchRows : batchSize;
     std::vector<char*> outputTableRows;
     int64_t sequence = 0;
     int64_t numJoinListResult = 0;
@@ -466,22 +500,70 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
           outputRowMapping, outputBatchSize, pool_.get());
       outputTableRows.resize(outputBatchSize);
       uint64_t listJoinResultClocks{0};
-      {
-        ClockTimer timer(listJoinResultClocks);
-        while (!resultsIter.atEnd()) {
-          numJoinListResult += topTable_->listJoinResults(
+      uint64_t extractClocks{0};
+      while (!resultsIter.atEnd()) {
+        int32_t numOut;
+        {
+          ClockTimer timer(listJoinResultClocks);
+          numOut = topTable_->listJoinResults(
               resultsIter,
               false,
               mapping,
               folly::Range(outputTableRows.data(), outputTableRows.size()),
               std::numeric_limits<uint64_t>::max());
         }
+        numJoinListResult += numOut;
+        if (params_.skewedProbe) {
+          ClockTimer timer(extractClocks);
+          extractOutput(
+              folly::Range<char* const*>(outputTableRows.data(), numOut));
+        }
       }
       listJoinResultTime_ += listJoinResultClocks;
+      extractTime_ += extractClocks;
     }
     return numJoinListResult;
   }
 
+  // Extracts the dependent columns of 'rows' as HashProbe does for its output.
+  void extractOutput(folly::Range<char* const*> rows) {
+    if (params_.dictionaryOutput) {
+      auto indices = allocateIndices(rows.size(), pool());
+      if (findDistinctRows(
+              rows,
+              rows.size() / 2,
+              distinctRowIndices_,
+              distinctRows_,
+              indices->asMutable<vector_size_t>())) {
+        extractColumns(
+            folly::Range<char* const*>(
+                distinctRows_.data(), distinctRows_.size()));
+        for (auto i = 1; i < extractedColumns_.size(); ++i) {
+          outputColumns_[i] = BaseVector::wrapInDictionary(
+              nullptr, indices, rows.size(), extractedColumns_[i]);
+        }
+        return;
+      }
+    }
+    extractColumns(rows);
+  }
+
+  void extractColumns(folly::Range<char* const*> rows) {
+    const auto& types = topTable_->rows()->columnTypes();
+    extractedColumns_.resize(types.size());
+    outputColumns_.resize(types.size());
+    // Column 0 is the key.
+    for (auto i = 1; i < types.size(); ++i) {
+      outputColumns_[i] = nullptr;
+      auto& column = extractedColumns_[i];
+      if (column == nullptr) {
+        column = BaseVector::create(types[i], rows.size(), pool());
+      }
+      column->resize(rows.size());
+      topTable_->extractColumn(rows, i, column);
+    }
+  }
+
   void eraseTable() {
     auto lookup =
         std::make_unique<HashLookup>(topTable_->hashers(), pool_.get());
@@ -512,12 +594,24 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     eraseTime_ = eraseClocks;
   }
 
+  // Number of distinct probe keys if 'skewedProbe' is set.
+  static constexpr int64_t kNumSkewedProbeKeys = 4;
+  // The default of QueryConfig::kPreferredOutputBatchRows.
+  static constexpr int32_t kSkewedOutputBatchRows = 1'024;
+
   std::default_random_engine randomEngine_;
   std::unique_ptr<HashTable<true>> topTable_;
   HashTableBenchmarkParams params_;
 
+  // Scratch memory for extractOutput().
+  folly::F14FastMap<const char*, vector_size_t> distinctRowIndices_;
+  std::vector<char*> distinctRows_;
+  std::vector<VectorPtr> extractedColumns_;
+  std::vector<VectorPtr> outputColumns_;
+
   double buildTime_{0};
   double eraseTime_{0};
+  double extractTime_{0};
   double listJoinResultTime_{0};
 };
 
@@ -585,6 +679,26 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Skewed fanout: the probe keys are 4 of the 1% of keys that have 20
+  // duplicates each, so each probe row matches 21 build rows and each output
+  // batch repeats the same 84 build rows.
+  const int64_t fanoutTableSize = 100'000;
+  const int64_t fanoutProbeSize = 2'000'000;
+  for (auto mode :
+       {BaseHashTable::HashMode::kArray, BaseHashTable::HashMode::kHash}) {
+    for (auto dictionaryOutput : {false, true}) {
+      params.emplace_back(HashTableBenchmarkParams(
+          mode,
+          keyAndDependentType,
+          fanoutTableSize,
+          fanoutProbeSize,
+          {{1, 20}, {99, 0}},
+          false,
+          true,
+          dictionaryOutput));
+    }
+  }
+
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm, &results]() {
       combineResults(results, bm->run(param));
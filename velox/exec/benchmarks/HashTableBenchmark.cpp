@@ -131,6 +131,9 @@ struct HashTableBenchmarkRun {
                                                      : "normalized key";
     out << std::endl
         << " numDistinct=" << numDistinct << " mode=" << modeString;
+    if (probeClocks > 0) {
+      out << " probes/Gclock=" << static_cast<int64_t>(1e9 / probeClocks);
+    }
     return out.str();
   }
 };
@@ -663,6 +666,18 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
       HashTableBenchmarkParams("Hit128M", 128000000, 100)};
+
+  // Tables of string keys in kHash mode, much larger than the LLC. These
+  // measure the pipelined probe with full key compares, where each probe
+  // misses the cache for the bucket and for the row.
+  for (auto [title, hitPct] :
+       {std::pair<const char*, int32_t>{"HashHit16M", 100},
+        std::pair<const char*, int32_t>{"HashMiss16M", 5}}) {
+    HashTableBenchmarkParams hashParams(title, 16000000, hitPct);
+    hashParams.mode = BaseHashTable::HashMode::kHash;
+    hashParams.buildType = ROW({"k1"}, {VARCHAR()});
+    params.push_back(std::move(hashParams));
+  }
   if (FLAGS_custom_size != 0) {
     params.push_back(HashTableBenchmarkParams(
         "Custom",
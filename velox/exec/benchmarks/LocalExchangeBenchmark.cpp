@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <thread>
+#include <vector>
+
+#include "velox/exec/LocalPartition.h"
+
+DEFINE_int32(
+    local_exchange_vectors,
+    20'000,
+    "Number of vectors each producer enqueues");
+DEFINE_int64(
+    local_exchange_max_buffer_kb,
+    1'024,
+    "Limit of the LocalExchangeMemoryManager shared by all queues");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+// Measures the contention on LocalExchangeQueues and their shared
+// LocalExchangeMemoryManager without the rest of a Task. Each of
+// 'numProducers' threads enqueues small vectors round robin to the queues of
+// 'numConsumers' threads, as LocalPartition does when repartitioning. Blocked
+// threads wait on their future.
+void runLocalExchange(int32_t numProducers, int32_t numConsumers) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto vector = BaseVector::create<RowVector>(
+      ROW({"c0"}, {BIGINT()}), 100, pool.get());
+  constexpr int64_t kVectorBytes = 1'000;
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(
+      FLAGS_local_exchange_max_buffer_kb << 10);
+  auto vectorPool = std::make_shared<LocalExchangeVectorPool>(0);
+  std::vector<std::shared_ptr<LocalExchangeQueue>> queues;
+  for (auto i = 0; i < numConsumers; ++i) {
+    queues.push_back(
+        std::make_shared<LocalExchangeQueue>(memoryManager, vectorPool, i));
+    for (auto j = 0; j < numProducers; ++j) {
+      queues.back()->addProducer();
+    }
+    queues.back()->noMoreProducers();
+  }
+  suspender.dismiss();
+
+  std::vector<std::thread> threads;
+  threads.reserve(numProducers + numConsumers);
+  for (auto i = 0; i < numProducers; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto n = 0; n < FLAGS_local_exchange_vectors; ++n) {
+        ContinueFuture future;
+        if (queues[(i + n) % numConsumers]->enqueue(
+                vector, kVectorBytes, &future) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+        }
+      }
+      for (auto& queue : queues) {
+        queue->noMoreData();
+      }
+    });
+  }
+  for (auto i = 0; i < numConsumers; ++i) {
+    threads.emplace_back([&, i]() {
+      for (;;) {
+        ContinueFuture future;
+        RowVectorPtr data;
+        bool drained;
+        if (queues[i]->next(&future, pool.get(), &data, drained) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+          continue;
+        }
+        if (data == nullptr) {
+          break;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+BENCHMARK(producers4Consumers4) {
+  runLocalExchange(4, 4);
+}
+
+BENCHMARK(producers16Consumers16) {
+  runLocalExchange(16, 16);
+}
+
+BENCHMARK(producers64Consumers64) {
+  runLocalExchange(64, 64);
+}
+
+BENCHMARK(producers64Consumers1) {
+  runLocalExchange(64, 1);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize(memory::MemoryManager::Options{});
+  folly::runBenchmarks();
+  return 0;
+}
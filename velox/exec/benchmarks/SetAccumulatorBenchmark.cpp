@@ -16,7 +16,10 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 
+#include <deque>
+
 #include "velox/common/memory/Memory.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/SetAccumulator.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -40,6 +43,20 @@ class SetAccumulatorBenchmark : public velox::test::VectorTestBase {
     for (auto i = 0; i < 10; ++i) {
       rowVectors_.emplace_back(fuzzer.fuzzInputRow(rowType));
     }
+
+    // Groups of 'kGroupSize' consecutive rows with 'kNumDistinct' low
+    // cardinality columns, as for several COUNT(DISTINCT) over small groups.
+    for (auto i = 0; i < 10; ++i) {
+      const auto firstRow = i * kBatchSize;
+      std::vector<VectorPtr> columns{makeFlatVector<int64_t>(
+          kBatchSize,
+          [&](auto row) { return (firstRow + row) / kGroupSize; })};
+      for (auto j = 0; j < kNumDistinct; ++j) {
+        columns.push_back(makeFlatVector<int64_t>(
+            kBatchSize, [&](auto row) { return (firstRow + row) % (j + 3); }));
+      }
+      multiDistinctVectors_.push_back(makeRowVector(columns));
+    }
   }
 
   void runBigint() {
@@ -70,7 +87,66 @@ class SetAccumulatorBenchmark : public velox::test::VectorTestBase {
     folly::doNotOptimizeAway(result);
   }
 
+  // Counts the distinct values of each column per group with one
+  // SetAccumulator per group and column.
+  void runMultiDistinctSets() {
+    HashStringAllocator allocator(pool());
+    std::deque<aggregate::prestosql::SetAccumulator<int64_t>> accumulators;
+    for (auto i = 0; i < kNumGroups * kNumDistinct; ++i) {
+      accumulators.emplace_back(BIGINT(), &allocator);
+    }
+
+    for (const auto& rowVector : multiDistinctVectors_) {
+      auto* groups = rowVector->childAt(0)->asFlatVector<int64_t>();
+      for (auto j = 0; j < kNumDistinct; ++j) {
+        DecodedVector decoded(*rowVector->childAt(j + 1));
+        for (auto i = 0; i < rowVector->size(); ++i) {
+          accumulators[groups->valueAt(i) * kNumDistinct + j].addValue(
+              decoded, i, &allocator);
+        }
+      }
+    }
+
+    uint64_t numDistinct{0};
+    for (auto& accumulator : accumulators) {
+      numDistinct += accumulator.size();
+      accumulator.free(allocator);
+    }
+    folly::doNotOptimizeAway(numDistinct);
+  }
+
+  // Counts the distinct values of each column per group with one hash table
+  // per column keyed on the group and the value.
+  void runMultiDistinctSharedTable() {
+    uint64_t numDistinct{0};
+    for (auto j = 0; j < kNumDistinct; ++j) {
+      std::vector<std::unique_ptr<VectorHasher>> hashers;
+      hashers.push_back(VectorHasher::create(BIGINT(), 0));
+      hashers.push_back(VectorHasher::create(BIGINT(), 1));
+      auto table = HashTable<false>::createForAggregation(
+          std::move(hashers), /*accumulators=*/{}, pool());
+      HashLookup lookup(table->hashers(), pool());
+
+      for (const auto& rowVector : multiDistinctVectors_) {
+        const auto keys =
+            makeRowVector({rowVector->childAt(0), rowVector->childAt(j + 1)});
+        SelectivityVector rows(keys->size());
+        table->prepareForGroupProbe(
+            lookup, keys, rows, BaseHashTable::kNoSpillInputStartPartitionBit);
+        table->groupProbe(
+            lookup, BaseHashTable::kNoSpillInputStartPartitionBit);
+        numDistinct += lookup.newGroups.size();
+      }
+    }
+    folly::doNotOptimizeAway(numDistinct);
+  }
+
  private:
+  static constexpr vector_size_t kBatchSize = 100'000;
+  static constexpr int32_t kGroupSize = 8;
+  static constexpr int32_t kNumGroups = 10 * kBatchSize / kGroupSize;
+  static constexpr int32_t kNumDistinct = 4;
+
   template <typename T>
   void runPrimitive(const std::string& name) {
     const auto& type = rowVectors_[0]->childAt(name)->type();
@@ -92,6 +168,7 @@ class SetAccumulatorBenchmark : public velox::test::VectorTestBase {
   }
 
   std::vector<RowVectorPtr> rowVectors_;
+  std::vector<RowVectorPtr> multiDistinctVectors_;
 };
 
 std::unique_ptr<SetAccumulatorBenchmark> bm;
@@ -108,6 +185,14 @@ BENCHMARK(twoBigints) {
   bm->runTwoBigints();
 }
 
+BENCHMARK(multiDistinctSets) {
+  bm->runMultiDistinctSets();
+}
+
+BENCHMARK_RELATIVE(multiDistinctSharedTable) {
+  bm->runMultiDistinctSharedTable();
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -68,6 +68,9 @@ constexpr int32_t kMediumProbeBenchmarkSize = 50000;
 constexpr int32_t kMediumBuildBenchmarkSize = 5000;
 constexpr int32_t kLargeProbeBenchmarkSize = 200000;
 constexpr int32_t kLargeBuildBenchmarkSize = 50000;
+constexpr int32_t kGeofenceProbeBenchmarkSize = 100000;
+constexpr int32_t kGeofenceBuildBenchmarkSize = 1000000;
+constexpr double kGeofencePolygonSize = 0.5;
 
 /// Parameters for a spatial join benchmark test case.
 struct SpatialJoinBenchmarkParams {
@@ -86,19 +89,26 @@ struct SpatialJoinBenchmarkParams {
   /// Spatial distribution pattern for geometry generation.
   Distribution distribution;
 
+  /// Half the side of the square build polygons.
+  double polygonSize{kPolygonSize};
+
   /// Description for benchmark naming.
   std::string toString() const {
     std::string joinTypeStr =
         (joinType == core::JoinType::kInner) ? "Inner" : "Left";
     std::string distributionStr =
         (distribution == Distribution::kUniform) ? "uniform" : "clustered";
-    return fmt::format(
+    auto name = fmt::format(
         "{}x{}_{}_{}_{}",
         probeSize,
         buildSize,
         predicate,
         joinTypeStr,
         distributionStr);
+    if (polygonSize != kPolygonSize) {
+      name += fmt::format("_size{}", polygonSize);
+    }
+    return name;
   }
 };
 
@@ -143,6 +153,7 @@ class SpatialJoinBenchmark : public facebook::velox::test::VectorTestBase {
   VectorPtr makePolygonVector(
       int32_t size,
       Distribution distribution,
+      double polygonSize,
       bool nulls = false) {
     return makeFlatVector<std::string>(
         size,
@@ -163,16 +174,16 @@ class SpatialJoinBenchmark : public facebook::velox::test::VectorTestBase {
           }
           return fmt::format(
               "POLYGON (({} {}, {} {}, {} {}, {} {}, {} {}))",
-              centerX - kPolygonSize,
-              centerY - kPolygonSize,
-              centerX + kPolygonSize,
-              centerY - kPolygonSize,
-              centerX + kPolygonSize,
-              centerY + kPolygonSize,
-              centerX - kPolygonSize,
-              centerY + kPolygonSize,
-              centerX - kPolygonSize,
-              centerY - kPolygonSize);
+              centerX - polygonSize,
+              centerY - polygonSize,
+              centerX + polygonSize,
+              centerY - polygonSize,
+              centerX + polygonSize,
+              centerY + polygonSize,
+              centerX - polygonSize,
+              centerY + polygonSize,
+              centerX - polygonSize,
+              centerY - polygonSize);
         },
         [&](vector_size_t row) {
           return nulls && (row % kNullPatternModulo == 0);
@@ -225,8 +236,8 @@ class SpatialJoinBenchmark : public facebook::velox::test::VectorTestBase {
     for (int32_t i = 0; i < numBuildBatches; ++i) {
       int32_t currentBatchSize =
           std::min(buildBatchSize, params.buildSize - (i * buildBatchSize));
-      auto geomVector =
-          makePolygonVector(currentBatchSize, params.distribution, false);
+      auto geomVector = makePolygonVector(
+          currentBatchSize, params.distribution, params.polygonSize, false);
       auto idVector = makeFlatVector<int64_t>(
           currentBatchSize, [i, buildBatchSize](vector_size_t row) {
             return (i * buildBatchSize) + row;
@@ -355,6 +366,16 @@ int main(int argc, char** argv) {
        core::JoinType::kInner,
        Distribution::kUniform});
 
+  // Geofence benchmark: points against 1M small polygons (100K x 1M). Most
+  // points fall in a polygon or two, so the time goes to the index.
+  bm.addBenchmark(
+      {kGeofenceProbeBenchmarkSize,
+       kGeofenceBuildBenchmarkSize,
+       "ST_Intersects",
+       core::JoinType::kInner,
+       Distribution::kUniform,
+       kGeofencePolygonSize});
+
   folly::runBenchmarks();
   return 0;
 }
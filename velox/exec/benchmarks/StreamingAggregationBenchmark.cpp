@@ -56,6 +56,9 @@ struct BenchmarkParams {
 // payloads of different data types. For each combination of aggregate and
 // payload type, run 4 benchmarks by repeating the grouping key 1 (baseline,
 // should be the slowest), 5, 10, and 15 times.
+//
+// The clustered benchmarks use large batches with a flat sorted key to
+// measure finding the group boundaries with a few payloads.
 class StreamingAggregationBenchmark : public VectorTestBase {
  public:
   // Make a single benchmark.
@@ -93,6 +96,56 @@ class StreamingAggregationBenchmark : public VectorTestBase {
     cases_.push_back(std::move(test));
   }
 
+  // Make a benchmark over 100 batches of 10K rows with a flat sorted BIGINT
+  // key repeated 'numRowsPerGroup' times and 4 BIGINT payloads.
+  void makeClusteredBenchmark(
+      const std::string& aggregate,
+      int32_t numRowsPerGroup) {
+    constexpr int32_t kNumBatches = 100;
+    constexpr vector_size_t kBatchSize = 10'000;
+    constexpr int32_t kNumPayloads = 4;
+
+    auto test = std::make_unique<TestCase>();
+    std::vector<std::string> names{"k0"};
+    for (auto i = 0; i < kNumPayloads; ++i) {
+      names.push_back(fmt::format("c{}", i));
+    }
+    for (auto i = 0; i < kNumBatches; ++i) {
+      const int64_t offset = i * kBatchSize;
+      std::vector<VectorPtr> children;
+      children.push_back(makeFlatVector<int64_t>(kBatchSize, [&](auto row) {
+        return (offset + row) / numRowsPerGroup;
+      }));
+      for (auto j = 0; j < kNumPayloads; ++j) {
+        children.push_back(makeFlatVector<int64_t>(
+            kBatchSize, [&](auto row) { return (row * 7 + j) % 1'000; }));
+      }
+      test->data.push_back(makeRowVector(names, children));
+    }
+    test->aggregates = makeAggregates(aggregate, kNumPayloads);
+    test->plan = exec::test::PlanBuilder()
+                     .values(test->data)
+                     .streamingAggregation(
+                         {"k0"},
+                         test->aggregates,
+                         {},
+                         core::AggregationNode::Step::kSingle,
+                         false)
+                     .planNode();
+
+    auto name = fmt::format(
+        "[{}]_clustered_{}_rows_per_group", aggregate, numRowsPerGroup);
+
+    folly::addBenchmark(__FILE__, name, [plan = &test->plan]() {
+      exec::test::AssertQueryBuilder(*plan)
+          .serialExecution(true)
+          .countResults();
+      return 1;
+    });
+
+    cases_.push_back(std::move(test));
+  }
+
   // Make a set of benchmarks for a given aggregate function and payload type.
   // Assume 1000 payload columns and a total of 150 rows.
   void makeBenchmarks(
@@ -179,6 +232,12 @@ int main(int argc, char** argv) {
   bm.makeBenchmarks("arbitrary", REAL());
   BENCHMARK_DRAW_LINE();
   bm.makeBenchmarks("arbitrary", ARRAY(BIGINT()));
+  for (const auto* aggregate : {"sum", "count", "min", "max"}) {
+    BENCHMARK_DRAW_LINE();
+    for (auto numRowsPerGroup : {1, 10, 1'000}) {
+      bm.makeClusteredBenchmark(aggregate, numRowsPerGroup);
+    }
+  }
 
   folly::runBenchmarks();
 
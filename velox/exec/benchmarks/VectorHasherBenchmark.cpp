@@ -115,6 +115,56 @@ BENCHMARK_RELATIVE(computeValueIdsSmallintWithNulls) {
   benchmarkComputeValueIds<int16_t>(true);
 }
 
+template <typename T>
+void benchmarkHash(bool withNulls) {
+  folly::BenchmarkSuspender suspender;
+  vector_size_t size = 1'000;
+  BenchmarkBase base;
+  // Hash the column twice to measure both the first key and the mixing of
+  // the following keys.
+  VectorHasher hasher(CppToType<T>::create(), 0);
+  auto values = base.vectorMaker().flatVector<T>(
+      size,
+      [](vector_size_t row) { return row * 31; },
+      withNulls ? velox::test::VectorMaker::nullEvery(7) : nullptr);
+
+  raw_vector<uint64_t> hashes(size, base.pool());
+  SelectivityVector rows(size);
+  suspender.dismiss();
+
+  for (int i = 0; i < 10'000; i++) {
+    hasher.decode(*values, rows);
+    hasher.hash(rows, false, hashes);
+    hasher.hash(rows, true, hashes);
+    folly::doNotOptimizeAway(hashes);
+  }
+}
+
+// Hashes the flat values in one pass over the buffer.
+BENCHMARK(hashBigintNoNulls) {
+  benchmarkHash<int64_t>(false);
+}
+
+BENCHMARK_RELATIVE(hashBigintWithNulls) {
+  benchmarkHash<int64_t>(true);
+}
+
+BENCHMARK(hashIntegerNoNulls) {
+  benchmarkHash<int32_t>(false);
+}
+
+BENCHMARK_RELATIVE(hashIntegerWithNulls) {
+  benchmarkHash<int32_t>(true);
+}
+
+BENCHMARK(hashDoubleNoNulls) {
+  benchmarkHash<double>(false);
+}
+
+BENCHMARK_RELATIVE(hashDoubleWithNulls) {
+  benchmarkHash<double>(true);
+}
+
 void benchmarkComputeValueIdsForStrings(bool flattenDictionaries) {
   folly::BenchmarkSuspender suspender;
   BenchmarkBase base;
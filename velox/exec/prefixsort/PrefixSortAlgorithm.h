@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -143,6 +145,54 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts the entries of 'entrySize' bytes in [start, end) by their first
+  /// 'keyBytes' bytes with a least significant digit radix sort. The key is
+  /// 'keyBytes' / 8 native uint64_t words, compared most significant word
+  /// first, as for the normalized keys of PrefixSort. 'buffer' must have room
+  /// for the entries. A byte that is the same in all entries takes no pass.
+  /// Returns the start of the sorted entries, which is 'start' or 'buffer'.
+  static char* radixSort(
+      char* start,
+      char* end,
+      uint64_t entrySize,
+      uint32_t keyBytes,
+      char* buffer) {
+    VELOX_DCHECK_EQ(keyBytes % sizeof(uint64_t), 0);
+    const uint64_t numEntries = (end - start) / entrySize;
+    char* source = start;
+    char* target = buffer;
+    std::array<uint64_t, 256> offsets;
+    for (int32_t word = keyBytes / sizeof(uint64_t) - 1; word >= 0; --word) {
+      // Bytes of a little endian word from least to most significant.
+      for (int32_t byte = 0; byte < sizeof(uint64_t); ++byte) {
+        const auto keyOffset = word * sizeof(uint64_t) + byte;
+        offsets.fill(0);
+        for (uint64_t i = 0; i < numEntries; ++i) {
+          ++offsets[static_cast<uint8_t>(source[i * entrySize + keyOffset])];
+        }
+        if (*std::max_element(offsets.begin(), offsets.end()) == numEntries) {
+          continue;
+        }
+        uint64_t offset = 0;
+        for (auto& count : offsets) {
+          const auto numBucketEntries = count;
+          count = offset;
+          offset += numBucketEntries;
+        }
+        for (uint64_t i = 0; i < numEntries; ++i) {
+          const auto* entry = source + i * entrySize;
+          simd::memcpy(
+              target +
+                  offsets[static_cast<uint8_t>(entry[keyOffset])]++ * entrySize,
+              entry,
+              entrySize);
+        }
+        std::swap(source, target);
+      }
+    }
+    return source;
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -70,6 +70,47 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  for (const auto size : {0, 1, 100, 10'000}) {
+    SCOPED_TRACE(fmt::format("size: {}", size));
+    // Entries of two key words compared as unsigned, as the normalized keys are
+    // after byte swapping, and a payload word. Few distinct values in the
+    // first word leave passes that skip equal bytes.
+    constexpr uint64_t kEntryWords = 3;
+    std::vector<uint64_t> data(size * kEntryWords);
+    for (auto i = 0; i < size; ++i) {
+      data[i * kEntryWords] = folly::Random::rand64() % 4;
+      data[i * kEntryWords + 1] = folly::Random::rand64();
+      data[i * kEntryWords + 2] = i;
+    }
+    std::vector<std::array<uint64_t, kEntryWords>> expected(size);
+    for (auto i = 0; i < size; ++i) {
+      std::copy_n(&data[i * kEntryWords], kEntryWords, expected[i].begin());
+    }
+    std::stable_sort(
+        expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+          return std::tie(a[0], a[1]) < std::tie(b[0], b[1]);
+        });
+
+    const uint64_t entrySize = kEntryWords * sizeof(uint64_t);
+    std::vector<uint64_t> buffer(data.size());
+    auto* start = reinterpret_cast<char*>(data.data());
+    const auto* sorted =
+        reinterpret_cast<const uint64_t*>(PrefixSortRunner::radixSort(
+            start,
+            start + size * entrySize,
+            entrySize,
+            2 * sizeof(uint64_t),
+            reinterpret_cast<char*>(buffer.data())));
+    // The radix sort is stable, so the payloads match too.
+    for (auto i = 0; i < size; ++i) {
+      for (auto j = 0; j < kEntryWords; ++j) {
+        ASSERT_EQ(sorted[i * kEntryWords + j], expected[i][j]);
+      }
+    }
+  }
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
@@ -161,10 +161,12 @@ void RPCOperator::addInput(RowVectorPtr input) {
           std::move(future)
               .within(kBatchRpcTimeout)
               .deferValue([rowId, token](RPCResponse resp) {
+                token->complete(!resp.hasError());
                 resp.rowId = rowId;
                 return resp;
               })
               .deferError([token](folly::exception_wrapper ew) {
+                token->complete(false);
                 return folly::makeSemiFuture<RPCResponse>(std::move(ew));
               });
 
@@ -225,6 +227,7 @@ void RPCOperator::flushBatchRequests() {
           .within(kBatchRpcTimeout)
           .deferValue([rowIds = std::move(rowIds),
                        token](std::vector<RPCResponse> resps) {
+            token->complete(true);
             VELOX_CHECK_EQ(
                 resps.size(),
                 rowIds.size(),
@@ -237,6 +240,7 @@ void RPCOperator::flushBatchRequests() {
             return resps;
           })
           .deferError([token](folly::exception_wrapper ew) {
+            token->complete(false);
             RPC_OP_LOG(ERROR) << "RPC batch failed: " << ew.what();
             return folly::makeSemiFuture<std::vector<RPCResponse>>(
                 std::move(ew));
@@ -16,6 +16,11 @@
 
 #include "velox/exec/rpc/RPCRateLimiter.h"
 
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
 #define RPC_RATE_LIMITER_LOG(severity) LOG(severity) << "[RPC_RATE_LIMITER] "
 #define RPC_RATE_LIMITER_VLOG(level) VLOG(level) << "[RPC_RATE_LIMITER] "
 
@@ -24,7 +29,7 @@ namespace facebook::velox::exec::rpc {
 // --- Token implementation ---
 
 RPCRateLimiter::Token::Token(const std::string& tierKey)
-    : tierKey_(tierKey), valid_(true) {}
+    : tierKey_(tierKey), startUs_(getCurrentTimeMicro()), valid_(true) {}
 
 RPCRateLimiter::Token& RPCRateLimiter::Token::operator=(
     Token&& other) noexcept {
@@ -33,7 +38,9 @@ RPCRateLimiter::Token& RPCRateLimiter::Token::operator=(
       decrementPending(tierKey_);
     }
     tierKey_ = std::move(other.tierKey_);
+    startUs_ = other.startUs_;
     valid_ = other.valid_;
+    completed_ = other.completed_;
     other.valid_ = false;
   }
   return *this;
@@ -45,6 +52,14 @@ RPCRateLimiter::Token::~Token() {
   }
 }
 
+void RPCRateLimiter::Token::complete(bool success) {
+  if (!valid_ || completed_) {
+    return;
+  }
+  completed_ = true;
+  recordResult(tierKey_, startUs_, success);
+}
+
 // --- Function-local statics ---
 
 std::mutex& RPCRateLimiter::mapMutex() {
@@ -92,8 +107,7 @@ std::optional<ContinueFuture> RPCRateLimiter::checkBackpressure(
   std::lock_guard<std::mutex> l(state.mutex);
 
   int64_t pending = state.pendingCount.load();
-  int64_t maxPending =
-      state.maxPending > 0 ? state.maxPending : defaultMaxPendingRef().load();
+  int64_t maxPending = maxPendingLocked(state);
 
   if (pending < maxPending) {
     RPC_RATE_LIMITER_VLOG(2)
@@ -120,10 +134,46 @@ void RPCRateLimiter::setMaxPending(const std::string& tierKey, int64_t limit) {
   auto& state = getOrCreateTierState(tierKey);
   std::lock_guard<std::mutex> l(state.mutex);
   state.maxPending = limit;
+  state.adaptiveLimit = 0;
   RPC_RATE_LIMITER_VLOG(1) << "setMaxPending[" << tierKey << "]: set to "
                            << limit;
 }
 
+void RPCRateLimiter::setAdaptive(
+    const std::string& tierKey,
+    const AdaptiveConfig& config) {
+  VELOX_CHECK_GT(config.minLimit, 0);
+  VELOX_CHECK_LE(config.minLimit, config.maxLimit);
+  VELOX_CHECK(
+      config.backoffRatio > 0 && config.backoffRatio < 1,
+      "backoffRatio must be in (0, 1): {}",
+      config.backoffRatio);
+  auto& state = getOrCreateTierState(tierKey);
+  std::vector<ContinuePromise> waitersToNotify;
+  {
+    std::lock_guard<std::mutex> l(state.mutex);
+    const auto initialLimit = std::clamp(
+        maxPendingLocked(state), config.minLimit, config.maxLimit);
+    state.adaptiveConfig = config;
+    state.adaptiveLimit = initialLimit;
+    state.lastDecreaseUs = 0;
+    waitersToNotify = takeWaitersLocked(state);
+  }
+  for (auto& waiter : waitersToNotify) {
+    waiter.setValue();
+  }
+  RPC_RATE_LIMITER_VLOG(1) << "setAdaptive[" << tierKey
+                           << "]: min=" << config.minLimit
+                           << ", max=" << config.maxLimit
+                           << ", latencyTargetUs=" << config.latencyTargetUs;
+}
+
+int64_t RPCRateLimiter::maxPending(const std::string& tierKey) {
+  auto& state = getOrCreateTierState(tierKey);
+  std::lock_guard<std::mutex> l(state.mutex);
+  return maxPendingLocked(state);
+}
+
 void RPCRateLimiter::setDefaultMaxPending(int64_t limit) {
   defaultMaxPendingRef().store(limit);
   RPC_RATE_LIMITER_VLOG(1) << "setDefaultMaxPending: set to " << limit;
@@ -168,8 +218,7 @@ void RPCRateLimiter::decrementPending(const std::string& tierKey) {
   std::optional<ContinuePromise> waiterToNotify;
   {
     std::lock_guard<std::mutex> l(state.mutex);
-    int64_t maxPending =
-        state.maxPending > 0 ? state.maxPending : defaultMaxPendingRef().load();
+    int64_t maxPending = maxPendingLocked(state);
     if (newCount < maxPending && !state.waiters.empty()) {
       RPC_RATE_LIMITER_VLOG(1)
           << "decrementPending[" << tierKey << "]: notifying 1 of "
@@ -183,4 +232,62 @@ void RPCRateLimiter::decrementPending(const std::string& tierKey) {
   }
 }
 
+void RPCRateLimiter::recordResult(
+    const std::string& tierKey,
+    uint64_t startUs,
+    bool success) {
+  auto& state = getOrCreateTierState(tierKey);
+  std::vector<ContinuePromise> waitersToNotify;
+  {
+    std::lock_guard<std::mutex> l(state.mutex);
+    if (state.adaptiveLimit == 0) {
+      return;
+    }
+    const auto& config = state.adaptiveConfig;
+    const auto nowUs = getCurrentTimeMicro();
+    const bool overloaded = !success ||
+        (config.latencyTargetUs > 0 &&
+         nowUs - startUs > config.latencyTargetUs);
+    if (overloaded) {
+      if (startUs <= state.lastDecreaseUs) {
+        // Already backed off for the overload this call ran into.
+        return;
+      }
+      state.adaptiveLimit = std::max<double>(
+          config.minLimit, state.adaptiveLimit * config.backoffRatio);
+      state.lastDecreaseUs = nowUs;
+      RPC_RATE_LIMITER_VLOG(1)
+          << "recordResult[" << tierKey << "]: decreased limit to "
+          << state.adaptiveLimit << (success ? " on latency" : " on error");
+      return;
+    }
+    state.adaptiveLimit = std::min<double>(
+        config.maxLimit, state.adaptiveLimit + 1 / state.adaptiveLimit);
+    waitersToNotify = takeWaitersLocked(state);
+  }
+  for (auto& waiter : waitersToNotify) {
+    waiter.setValue();
+  }
+}
+
+int64_t RPCRateLimiter::maxPendingLocked(const TierState& state) {
+  if (state.adaptiveLimit > 0) {
+    return static_cast<int64_t>(state.adaptiveLimit);
+  }
+  return state.maxPending > 0 ? state.maxPending
+                              : defaultMaxPendingRef().load();
+}
+
+std::vector<ContinuePromise> RPCRateLimiter::takeWaitersLocked(
+    TierState& state) {
+  std::vector<ContinuePromise> waiters;
+  const auto available = maxPendingLocked(state) - state.pendingCount.load();
+  while (!state.waiters.empty() &&
+         static_cast<int64_t>(waiters.size()) < available) {
+    waiters.push_back(std::move(state.waiters.front()));
+    state.waiters.pop_front();
+  }
+  return waiters;
+}
+
 } // namespace facebook::velox::exec::rpc
@@ -41,6 +41,10 @@ namespace facebook::velox::exec::rpc {
 ///
 /// The tier key comes from IRPCClient::tierKey(). Empty string means
 /// "no tier configured" and falls back to the global default limit.
+///
+/// A tier can instead use an adaptive limit (see setAdaptive()) that follows
+/// the capacity of the backend from the outcomes reported through
+/// Token::complete().
 class RPCRateLimiter {
  public:
   /// RAII token representing one in-flight request slot.
@@ -51,7 +55,10 @@ class RPCRateLimiter {
     Token() = default;
 
     Token(Token&& other) noexcept
-        : tierKey_(std::move(other.tierKey_)), valid_(other.valid_) {
+        : tierKey_(std::move(other.tierKey_)),
+          startUs_(other.startUs_),
+          valid_(other.valid_),
+          completed_(other.completed_) {
       other.valid_ = false;
     }
 
@@ -63,12 +70,33 @@ class RPCRateLimiter {
     Token(const Token&) = delete;
     Token& operator=(const Token&) = delete;
 
+    /// Reports whether the call this slot was acquired for succeeded. Feeds
+    /// the adaptive limit of the tier, if any. Only the first report counts.
+    /// The slot itself is released on destruction.
+    void complete(bool success);
+
    private:
     friend class RPCRateLimiter;
     explicit Token(const std::string& tierKey);
 
     std::string tierKey_;
+    uint64_t startUs_{0};
     bool valid_{false};
+    bool completed_{false};
+  };
+
+  /// Settings of an adaptive per-tier limit. The limit grows additively, by
+  /// one per limit's worth of calls that succeed within 'latencyTargetUs',
+  /// i.e. by about one per round trip. It shrinks multiplicatively by
+  /// 'backoffRatio' on a failed or slower call. Calls that started before
+  /// the last decrease do not decrease it again, so a burst of failures from
+  /// one overload backs off once.
+  struct AdaptiveConfig {
+    int64_t minLimit{1};
+    int64_t maxLimit{1'000};
+    /// Calls slower than this count as overload. 0 means only failures do.
+    uint64_t latencyTargetUs{0};
+    double backoffRatio{0.9};
   };
 
   /// Acquire a slot for the given tier. Increments pending count and
@@ -85,9 +113,19 @@ class RPCRateLimiter {
   static int64_t pendingCount(const std::string& tierKey);
 
   /// Configure the max pending limit for a specific tier.
-  /// If not configured, falls back to the global default.
+  /// If not configured, falls back to the global default. Turns off the
+  /// adaptive limit of the tier.
   static void setMaxPending(const std::string& tierKey, int64_t limit);
 
+  /// Makes the limit of 'tierKey' adaptive. It starts from the current limit
+  /// of the tier, clamped to the configured bounds.
+  static void setAdaptive(
+      const std::string& tierKey,
+      const AdaptiveConfig& config);
+
+  /// Returns the current limit of a tier, adaptive or fixed.
+  static int64_t maxPending(const std::string& tierKey);
+
   /// Set the global default max pending (used when no per-tier config).
   static void setDefaultMaxPending(int64_t limit);
 
@@ -107,11 +145,27 @@ class RPCRateLimiter {
     std::atomic<int64_t> pendingCount{0};
     int64_t maxPending{0}; // 0 = use global default
     std::deque<ContinuePromise> waiters;
+    // Current adaptive limit. 0 if the tier uses a fixed limit.
+    double adaptiveLimit{0};
+    AdaptiveConfig adaptiveConfig;
+    // Time of the last decrease of 'adaptiveLimit'.
+    uint64_t lastDecreaseUs{0};
   };
 
   static void incrementPending(const std::string& tierKey);
   static void decrementPending(const std::string& tierKey);
 
+  // Adjusts the adaptive limit of a tier with the outcome of a call started at
+  // 'startUs'.
+  static void
+  recordResult(const std::string& tierKey, uint64_t startUs, bool success);
+
+  static int64_t maxPendingLocked(const TierState& state);
+
+  // Removes waiters that fit under the limit. The returned promises are
+  // fulfilled by the caller outside of the tier mutex.
+  static std::vector<ContinuePromise> takeWaitersLocked(TierState& state);
+
   static TierState& getOrCreateTierState(const std::string& tierKey);
 
   // Global mutex protects only the tier map for inserts/lookups.
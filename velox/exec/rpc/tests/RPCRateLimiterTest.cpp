@@ -29,11 +29,14 @@
 /// - defaultMaxPending: setDefaultMaxPending affects tiers without override.
 /// - tokenMoveSemantics: Move constructor/assignment transfer ownership.
 /// - testingResetAllState: Reset clears all tiers and restores defaults.
+/// - adaptive*: The adaptive limit grows on success and backs off on errors
+///   and slow calls.
 
 #include "velox/exec/rpc/RPCRateLimiter.h"
 
 #include <gtest/gtest.h>
 
+#include <thread>
 #include <vector>
 
 namespace facebook::velox::exec::rpc {
@@ -224,5 +227,97 @@ TEST_F(RPCRateLimiterTest, noBackpressureBelowLimit) {
   EXPECT_EQ(RPCRateLimiter::pendingCount(tier), 4);
 }
 
+TEST_F(RPCRateLimiterTest, adaptiveIncrease) {
+  const std::string tier = "test.tier";
+  RPCRateLimiter::setMaxPending(tier, 4);
+  RPCRateLimiter::setAdaptive(tier, {.minLimit = 1, .maxLimit = 6});
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 4);
+
+  std::vector<RPCRateLimiter::Token> tokens;
+  for (int i = 0; i < 4; ++i) {
+    tokens.push_back(RPCRateLimiter::acquire(tier));
+  }
+  auto future = RPCRateLimiter::checkBackpressure(tier);
+  ASSERT_TRUE(future.has_value());
+
+  // Each success at limit n adds 1/n, so about a limit's worth of successes
+  // raise it by one.
+  for (auto& token : tokens) {
+    token.complete(true);
+  }
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 4);
+  EXPECT_FALSE(future->isReady());
+  RPCRateLimiter::acquire(tier).complete(true);
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 5);
+  // The waiter is admitted while the first four slots are still held.
+  EXPECT_TRUE(future->isReady());
+  EXPECT_EQ(RPCRateLimiter::pendingCount(tier), 4);
+
+  // Reports after the first one do not count.
+  tokens[0].complete(true);
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 5);
+
+  // The limit stops at maxLimit.
+  for (int i = 0; i < 100; ++i) {
+    RPCRateLimiter::acquire(tier).complete(true);
+  }
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 6);
+}
+
+TEST_F(RPCRateLimiterTest, adaptiveBackoffOnError) {
+  const std::string tier = "test.tier";
+  RPCRateLimiter::setMaxPending(tier, 10);
+  RPCRateLimiter::setAdaptive(
+      tier, {.minLimit = 2, .maxLimit = 10, .backoffRatio = 0.5});
+
+  std::vector<RPCRateLimiter::Token> tokens;
+  for (int i = 0; i < 3; ++i) {
+    tokens.push_back(RPCRateLimiter::acquire(tier));
+  }
+
+  // Calls that were in flight together back off once.
+  for (auto& token : tokens) {
+    token.complete(false);
+  }
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 5);
+
+  // A call started after the decrease backs off again, down to minLimit.
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  RPCRateLimiter::acquire(tier).complete(false);
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 2);
+}
+
+TEST_F(RPCRateLimiterTest, adaptiveLatencyTarget) {
+  const std::string tier = "test.tier";
+  RPCRateLimiter::setMaxPending(tier, 10);
+  RPCRateLimiter::setAdaptive(
+      tier,
+      {.minLimit = 1,
+       .maxLimit = 10,
+       .latencyTargetUs = 1'000,
+       .backoffRatio = 0.5});
+  auto token = RPCRateLimiter::acquire(tier);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  // A successful call over the latency target counts as overload.
+  token.complete(true);
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 5);
+}
+
+TEST_F(RPCRateLimiterTest, adaptiveDisabled) {
+  const std::string tier = "test.tier";
+  RPCRateLimiter::setMaxPending(tier, 3);
+  RPCRateLimiter::acquire(tier).complete(false);
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 3);
+
+  RPCRateLimiter::setAdaptive(tier, {.minLimit = 5, .maxLimit = 8});
+  // Starts from the fixed limit raised to minLimit.
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 5);
+
+  // setMaxPending() goes back to a fixed limit.
+  RPCRateLimiter::setMaxPending(tier, 3);
+  RPCRateLimiter::acquire(tier).complete(false);
+  EXPECT_EQ(RPCRateLimiter::maxPending(tier), 3);
+}
+
 } // namespace
 } // namespace facebook::velox::exec::rpc
@@ -29,12 +29,14 @@
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregateCompanionSignatures.h"
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashAggregation.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/PrefixSort.h"
 #include "velox/exec/Values.h"
 #include "velox/exec/prefixsort/PrefixSortEncoder.h"
 #include "velox/exec/tests/utils/ArbitratorTestUtil.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/SumNonPODAggregate.h"
@@ -953,6 +955,217 @@ TEST_F(AggregationTest, partialAggregationMemoryLimit) {
           .customStats.count("flushRowCount"));
 }
 
+TEST_F(AggregationTest, partialAggregationRetainedGroups) {
+  // Half of the rows go to two hot keys, the others are unique.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return row % 2 == 0 ? row % 4 : i * 1'000 + row; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto runQuery = [&](int32_t retainedGroupsPct) {
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kMaxPartialAggregationMemory, 1)
+            .config(
+                QueryConfig::kPartialAggregationRetainedGroupsPct,
+                std::to_string(retainedGroupsPct))
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"count(1)", "sum(c1)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, count(1), sum(c1) FROM tmp GROUP BY 1");
+    return toPlanStats(task->taskStats()).at(aggNodeId);
+  };
+
+  const auto stats = runQuery(0);
+  ASSERT_EQ(stats.customStats.count("retainedGroupCount"), 0);
+  ASSERT_GT(stats.customStats.at("flushRowCount").count, 1);
+
+  // The hot keys stay in the partial aggregation and are sent once.
+  const auto retainedStats = runQuery(10);
+  ASSERT_GT(retainedStats.customStats.at("retainedGroupCount").sum, 0);
+  ASSERT_GT(retainedStats.customStats.at("flushRowCount").count, 1);
+  ASSERT_LT(retainedStats.outputRows, stats.outputRows);
+
+  VELOX_ASSERT_THROW(
+      runQuery(100), "partial_aggregation_retained_groups_pct must be in");
+}
+
+TEST_F(AggregationTest, parallelFinalAggregation) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) % 1'500; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // Each driver reads all of 'vectors' and aggregates the 4 copies of each
+  // group in its own table. The two-phase aggregation merges these.
+  core::PlanNodeId aggNodeId;
+  const auto plan = PlanBuilder()
+                        .values(vectors, true)
+                        .partialAggregation({"c0"}, {"count(1)", "sum(c1)"})
+                        .finalAggregation()
+                        .capturePlanNodeId(aggNodeId)
+                        .planNode();
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .config(QueryConfig::kParallelFinalAggregationEnabled, true)
+          .maxDrivers(4)
+          .plan(plan)
+          .assertResults(
+              "SELECT c0, count(1) * 4, sum(c1) * 4 FROM tmp GROUP BY 1");
+  ASSERT_EQ(toPlanStats(task->taskStats()).at(aggNodeId).outputRows, 1'500);
+
+  // With one driver the aggregation runs in one phase.
+  AssertQueryBuilder(duckDbQueryRunner_)
+      .config(QueryConfig::kParallelFinalAggregationEnabled, true)
+      .maxDrivers(1)
+      .plan(plan)
+      .assertResults("SELECT c0, count(1), sum(c1) FROM tmp GROUP BY 1");
+}
+
+TEST_F(AggregationTest, parallelOutputExtraction) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            2'000, [&](auto row) { return (i * 2'000 + row) % 3'000; }),
+        makeFlatVector<std::string>(
+            2'000,
+            [](auto row) { return fmt::format("non-inline key {}", row % 3); },
+            nullEvery(13)),
+        makeFlatVector<int64_t>(2'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // The batches of more than 100 groups extract the keys in parallel.
+  AssertQueryBuilder(duckDbQueryRunner_)
+      .config(QueryConfig::kParallelOutputExtractionMinRows, "100")
+      .plan(PlanBuilder()
+                .values(vectors)
+                .singleAggregation({"c0", "c1"}, {"sum(c2)", "max(c1)"})
+                .planNode())
+      .assertResults(
+          "SELECT c0, c1, sum(c2), max(c1) FROM tmp GROUP BY 1, 2");
+}
+
+TEST_F(AggregationTest, clusterRowsByGroup) {
+  // Few distinct small keys make the hash table use array mode.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(5'000, [](auto row) { return row % 17; }),
+        makeFlatVector<int64_t>(
+            5'000,
+            [&](auto row) { return row * 7 % 1'000 - i; },
+            nullEvery(11)),
+        makeFlatVector<double>(5'000, [](auto row) { return row * 0.1; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto enabled : {"false", "true"}) {
+    SCOPED_TRACE(enabled);
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationClusterRowsByGroupEnabled, enabled)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation(
+                      {"c0"}, {"min(c1)", "max(c1)", "max(c2)"})
+                  .finalAggregation()
+                  .planNode())
+        .assertResults(
+            "SELECT c0, min(c1), max(c1), max(c2) FROM tmp GROUP BY 1");
+  }
+}
+
+TEST_F(AggregationTest, clusterRowsByGroupCheckedSum) {
+  // The second batch starts with a run [INT64_MAX, 5] for a group whose sum
+  // is -10. Adding up the run first would overflow, row by row it does not.
+  constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 2; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(2'000, [](auto /*row*/) { return 1; }),
+        makeFlatVector<int64_t>(
+            2'000,
+            [&](auto row) -> int64_t {
+              if (row > 1) {
+                return 0;
+              }
+              if (i == 0) {
+                return row == 0 ? -10 : 0;
+              }
+              return row == 0 ? kMax : 5;
+            }),
+    }));
+  }
+
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>({1}),
+      makeFlatVector<int64_t>({kMax - 5}),
+      makeFlatVector<int64_t>({kMax}),
+  });
+  AssertQueryBuilder(
+      PlanBuilder()
+          .values(vectors)
+          .singleAggregation({"c0"}, {"sum(c1)", "max(c1)"})
+          .planNode())
+      .config(QueryConfig::kAggregationClusterRowsByGroupEnabled, "true")
+      .assertResults(expected);
+}
+
+TEST_F(AggregationTest, appendOnlyAllocator) {
+  // Non-inline string keys and min and max on strings, which replace their
+  // accumulators, allocate from the HashStringAllocator of the hash table.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<std::string>(
+            3'000,
+            [](auto row) {
+              return fmt::format("key-of-group-{}", row % 713);
+            }),
+        makeFlatVector<std::string>(
+            3'000,
+            [&](auto row) {
+              return std::string(row % 50 + i, 'a' + row % 26);
+            },
+            nullEvery(7)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto enabled : {"false", "true"}) {
+    SCOPED_TRACE(enabled);
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationAppendOnlyAllocatorEnabled, enabled)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation(
+                      {"c0"}, {"min(c1)", "max(c1)", "count(c1)"})
+                  .finalAggregation()
+                  .planNode())
+        .assertResults(
+            "SELECT c0, min(c1), max(c1), count(c1) FROM tmp GROUP BY 1");
+  }
+}
+
 TEST_F(AggregationTest, partialDistinctWithAbandon) {
   auto vectors = {
       // 1st batch will produce 100 distinct groups from 10 rows.
@@ -1001,6 +1214,47 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, distinctSharedHashTable) {
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 300; }),
+        makeFlatVector<int32_t>(
+            1'000, [i](auto row) { return (row + i) % 7; }, nullEvery(11)),
+        makeFlatVector<StringView>(
+            1'000,
+            [i](auto row) {
+              return StringView::makeInline(
+                  fmt::format("s{}", (row * 3 + i) % 13));
+            }),
+        makeFlatVector<double>(1'000, [](auto row) { return row % 5; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .singleAggregation(
+                            {"c0"},
+                            {"count(distinct c1)",
+                             "count(distinct c2)",
+                             "sum(distinct c1)",
+                             "max(c3)",
+                             "sum(distinct c3)"})
+                        .planNode();
+  const std::string sql =
+      "SELECT c0, count(distinct c1), count(distinct c2), sum(distinct c1), "
+      "max(c3), sum(distinct c3) FROM tmp GROUP BY c0";
+
+  for (const auto enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            QueryConfig::kAggregationSharedDistinctHashTableEnabled, enabled)
+        .assertResults(sql);
+  }
+}
+
 TEST_F(AggregationTest, distinctWithGroupingKeysReordered) {
   rowType_ =
       ROW({"c0", "c1", "c2", "c3", "c4"},
@@ -1503,6 +1757,116 @@ TEST_F(AggregationTest, groupingSetsSameKey) {
       "select o_key, o_key as o_key_1, o_status FROM tmp) GROUP BY GROUPING SETS ((o_key, o_key_1), (o_key), (o_key_1), ())");
 }
 
+TEST_F(AggregationTest, groupingSetsRollup) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector(
+        {"k1", "k2", "a", "b"},
+        {
+            makeFlatVector<int64_t>(1'000, [](auto row) { return row % 11; }),
+            makeFlatVector<int64_t>(
+                1'000, [&](auto row) { return (i + row) % 17; }, nullEvery(7)),
+            makeFlatVector<int64_t>(1'000, [&](auto row) { return i + row; }),
+            makeFlatVector<std::string>(
+                1'000, [](auto row) { return std::string(row % 12, 'x'); }),
+        }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto rollupGroupingSets = [](const std::shared_ptr<Task>& task,
+                                     const core::PlanNodeId& nodeId) {
+    auto stats = toPlanStats(task->taskStats()).at(nodeId).customStats;
+    const auto it =
+        stats.find(std::string(HashAggregation::kRollupGroupingSets));
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  // The aggregation aggregates the input of the GroupId once by k1 and k2 and
+  // merges these groups into the groups of each grouping set.
+  core::PlanNodeId groupIdNodeId;
+  core::PlanNodeId aggNodeId;
+  auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .groupId({"k1", "k2"}, {{"k1", "k2"}, {"k1"}, {"k2"}, {}}, {"a", "b"})
+          .capturePlanNodeId(groupIdNodeId)
+          .singleAggregation(
+              {"k1", "k2", "group_id"},
+              {"count(1) as count_1",
+               "sum(a) as sum_a",
+               "max(b) as max_b",
+               "avg(a) as avg_a"})
+          .capturePlanNodeId(aggNodeId)
+          .project({"k1", "k2", "count_1", "sum_a", "max_b", "avg_a"})
+          .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(QueryConfig::kGroupingSetsRollupEnabled, true)
+          .assertResults(
+              "SELECT k1, k2, count(1), sum(a), max(b), avg(a) FROM tmp "
+              "GROUP BY CUBE (k1, k2)");
+  ASSERT_EQ(rollupGroupingSets(task, aggNodeId), 4);
+  ASSERT_EQ(toPlanStats(task->taskStats()).count(groupIdNodeId), 0);
+
+  // A partial aggregation produces the intermediate results of each grouping
+  // set.
+  plan = PlanBuilder()
+             .values(vectors)
+             .groupId({"k1", "k2"}, {{"k1", "k2"}, {"k1"}, {}}, {"a", "b"})
+             .partialAggregation(
+                 {"k1", "k2", "group_id"},
+                 {"count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"})
+             .capturePlanNodeId(aggNodeId)
+             .finalAggregation()
+             .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+             .planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(QueryConfig::kGroupingSetsRollupEnabled, true)
+             .assertResults(
+                 "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp "
+                 "GROUP BY ROLLUP (k1, k2)");
+  ASSERT_EQ(rollupGroupingSets(task, aggNodeId), 3);
+
+  // One input column is the input of two grouping keys.
+  plan = PlanBuilder()
+             .values(vectors)
+             .groupId(
+                 {"k1", "k1 as k1_1"},
+                 {{"k1", "k1_1"}, {"k1"}, {"k1_1"}},
+                 {"a"})
+             .singleAggregation(
+                 {"k1", "k1_1", "group_id"}, {"sum(a) as sum_a"})
+             .capturePlanNodeId(aggNodeId)
+             .project({"k1", "k1_1", "sum_a"})
+             .planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(QueryConfig::kGroupingSetsRollupEnabled, true)
+             .assertResults(
+                 "SELECT k1, k1_1, sum(a) FROM ("
+                 "SELECT k1, k1 as k1_1, a FROM tmp) "
+                 "GROUP BY GROUPING SETS ((k1, k1_1), (k1), (k1_1))");
+  ASSERT_EQ(rollupGroupingSets(task, aggNodeId), 3);
+
+  // Masks read the groupId, so the aggregation aggregates the copies of the
+  // input made by the GroupId.
+  plan = PlanBuilder()
+             .values(vectors)
+             .groupId({"k1", "k2"}, {{"k1"}, {"k2"}}, {"a"})
+             .project({"k1", "k2", "group_id", "a", "group_id = 0 as mask_a"})
+             .singleAggregation(
+                 {"k1", "k2", "group_id"}, {"sum(a) as sum_a"}, {"mask_a"})
+             .capturePlanNodeId(aggNodeId)
+             .project({"k1", "k2", "sum_a"})
+             .planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(QueryConfig::kGroupingSetsRollupEnabled, true)
+             .assertResults(
+                 "SELECT k1, null, sum(a) FROM tmp GROUP BY k1 "
+                 "UNION ALL "
+                 "SELECT null, k2, null FROM tmp GROUP BY k2");
+  ASSERT_EQ(rollupGroupingSets(task, aggNodeId), 0);
+}
+
 TEST_F(AggregationTest, groupingSetsEmptyInput) {
   auto data = makeRowVector(
       {"c1", "c2"},
@@ -4428,4 +4792,103 @@ DEBUG_ONLY_TEST_F(AggregationTest, aggregationSpillFileCreateConfig) {
   ASSERT_TRUE(aggregationConfigVerified.load());
   ASSERT_TRUE(defaultConfigVerified.load());
 }
+
+class HashAggregationBarrierTest : public HiveConnectorTestBase {};
+
+TEST_F(HashAggregationBarrierTest, groupsPerBarrier) {
+  // Each split is followed by a barrier. c2 is the number of the split.
+  const int32_t numSplits = 4;
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (auto i = 0; i < numSplits; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row + i) % 17; }),
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row * i; }),
+        makeFlatVector<int32_t>(1'000, [&](auto /*row*/) { return i; }),
+    }));
+    tempFiles.push_back(TempFilePath::create());
+  }
+  writeToFiles(toFilePaths(tempFiles), vectors);
+  createDuckDbTable(vectors);
+  const auto rowType = asRowType(vectors[0]->type());
+  auto spillDirectory = TempDirectoryPath::create();
+
+  struct {
+    std::function<void(PlanBuilder&)> addAggregation;
+    std::string expectedSql;
+  } testSettings[] = {
+      {[](auto& builder) {
+         builder.singleAggregation({"c0"}, {"sum(c1)", "count(1)"});
+       },
+       "SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c2, c0"},
+      {[](auto& builder) {
+         builder.partialAggregation({"c0"}, {"sum(c1)"}).finalAggregation();
+       },
+       "SELECT c0, sum(c1) FROM tmp GROUP BY c2, c0"},
+      {[](auto& builder) {
+         builder.singleAggregation({}, {"sum(c1)", "max(c0)"});
+       },
+       // The input after the last barrier is empty.
+       "SELECT sum(c1), max(c0) FROM tmp GROUP BY c2 "
+       "UNION ALL SELECT NULL::BIGINT, NULL::BIGINT"},
+      {[](auto& builder) { builder.singleAggregation({"c0"}, {}); },
+       "SELECT c0 FROM tmp GROUP BY c2, c0"},
+  };
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.expectedSql);
+    PlanBuilder builder;
+    builder.tableScan(rowType);
+    testData.addAggregation(builder);
+    const auto plan = builder.planNode();
+    for (const bool spill : {false, true}) {
+      SCOPED_TRACE(fmt::format("spill: {}", spill));
+      TestScopedSpillInjection scopedSpillInjection(spill ? 100 : 0);
+      auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                      .splits(makeHiveConnectorSplits(tempFiles))
+                      .serialExecution(true)
+                      .barrierExecution(true)
+                      .spillDirectory(spillDirectory->getPath())
+                      .config(QueryConfig::kSpillEnabled, spill)
+                      .config(QueryConfig::kAggregationSpillEnabled, spill)
+                      .assertResults(testData.expectedSql);
+      ASSERT_EQ(task->taskStats().numBarriers, numSplits);
+    }
+  }
+}
+
+TEST_F(HashAggregationBarrierTest, parallelFinalAggregation) {
+  // A final aggregation with several drivers in a task that supports barriers
+  // does not merge the groups of its drivers in parallel. Each barrier drains
+  // each driver separately. Each split is followed by a barrier and is read by
+  // one of the drivers.
+  const int32_t numSplits = 4;
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (auto i = 0; i < numSplits; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row + i) % 17; }),
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row * i; }),
+        makeFlatVector<int32_t>(1'000, [&](auto /*row*/) { return i; }),
+    }));
+    tempFiles.push_back(TempFilePath::create());
+  }
+  writeToFiles(toFilePaths(tempFiles), vectors);
+  createDuckDbTable(vectors);
+
+  const auto plan = PlanBuilder()
+                        .tableScan(asRowType(vectors[0]->type()))
+                        .partialAggregation({"c0"}, {"sum(c1)"})
+                        .finalAggregation()
+                        .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .splits(makeHiveConnectorSplits(tempFiles))
+                  .barrierExecution(true)
+                  .maxDrivers(2)
+                  .config(QueryConfig::kParallelFinalAggregationEnabled, true)
+                  .assertResults(
+                      "SELECT c0, sum(c1) FROM tmp GROUP BY c2, c0");
+  ASSERT_EQ(task->taskStats().numBarriers, numSplits);
+}
 } // namespace facebook::velox::exec::test
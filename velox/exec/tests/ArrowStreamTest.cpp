@@ -232,3 +232,44 @@ TEST_F(ArrowStreamTest, error) {
       AssertQueryBuilder(plan).copyResults(pool_.get()),
       "Failed to call get_schema on ArrowStream: get_schema failed.");
 }
+
+TEST_F(ArrowStreamTest, multipleStreams) {
+  constexpr int32_t kNumStreams = 7;
+  // The readers refer to the vectors of their stream.
+  std::vector<std::vector<RowVectorPtr>> streamVectors(kNumStreams);
+  std::vector<RowVectorPtr> allVectors;
+  for (int32_t i = 0; i < kNumStreams; ++i) {
+    for (int32_t j = 0; j < 3; ++j) {
+      streamVectors[i].push_back(makeRowVector(
+          {makeFlatVector<int32_t>(
+               100, [&](auto row) { return (i * 3 + j) * 100 + row; }),
+           makeFlatVector<StringView>(
+               100,
+               [](auto row) {
+                 return StringView::makeInline(std::to_string(row));
+               },
+               nullEvery(7))}));
+      allVectors.push_back(streamVectors[i].back());
+    }
+  }
+  createDuckDbTable(allVectors);
+  auto type = asRowType(allVectors[0]->type());
+
+  // More drivers than streams leaves some drivers without a stream.
+  for (const auto numDrivers : {3, 10}) {
+    SCOPED_TRACE(fmt::format("numDrivers: {}", numDrivers));
+    std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams;
+    for (const auto& vectors : streamVectors) {
+      arrowStreams.push_back(std::make_shared<ArrowArrayStream>());
+      exportArrowStream(
+          std::make_shared<ArrowReader>(pool_, vectors, type),
+          arrowStreams.back().get());
+    }
+    auto plan =
+        std::make_shared<core::ArrowStreamNode>("0", type, arrowStreams);
+    ASSERT_FALSE(plan->requiresSingleThread());
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .maxDrivers(numDrivers)
+        .assertResults("SELECT * FROM tmp");
+  }
+}
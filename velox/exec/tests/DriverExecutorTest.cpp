@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverExecutor.h"
+
+#include <algorithm>
+
+#include <folly/synchronization/Baton.h>
+#include <folly/synchronization/Latch.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/ProcessBase.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+DriverExecutor::Options twoNodes(int32_t numThreads) {
+  DriverExecutor::Options options;
+  options.numThreads = numThreads;
+  options.nodes = {{0, {0}}, {1, {0}}};
+  options.pinThreads = false;
+  return options;
+}
+
+TEST(DriverExecutorTest, parseCpuList) {
+  EXPECT_EQ(
+      parseCpuList("0-3,8,10-11\n"),
+      std::vector<int32_t>({0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(parseCpuList("5"), std::vector<int32_t>({5}));
+  EXPECT_TRUE(parseCpuList("").empty());
+  VELOX_ASSERT_THROW(parseCpuList("3-1"), "Bad CPU list: 3-1");
+}
+
+TEST(DriverExecutorTest, topology) {
+  const auto nodes = numaTopology();
+  ASSERT_FALSE(nodes.empty());
+  DriverExecutor executor({.numThreads = 0, .pinThreads = false});
+  int32_t numCpus = 0;
+  for (const auto& node : executor.nodes()) {
+    numCpus += node.cpus.size();
+  }
+  EXPECT_EQ(executor.numThreads(), numCpus);
+  EXPECT_EQ(DriverExecutor::currentNodeIndex(), -1);
+}
+
+TEST(DriverExecutorTest, runAll) {
+  constexpr int32_t kNumFuncs = 10'000;
+  std::atomic_int32_t numRun{0};
+  {
+    DriverExecutor executor(twoNodes(4));
+    ASSERT_EQ(executor.numThreads(), 4);
+    for (auto i = 0; i < kNumFuncs; ++i) {
+      if (i % 2 == 0) {
+        executor.add([&]() { ++numRun; });
+      } else {
+        // Functions added from a thread of the executor go on its queue.
+        executor.addWithAffinity(
+            [&]() { executor.add([&]() { ++numRun; }); }, i);
+      }
+    }
+    // The destructor runs the queued functions.
+  }
+  EXPECT_EQ(numRun, kNumFuncs);
+}
+
+TEST(DriverExecutorTest, affinity) {
+  DriverExecutor executor(twoNodes(2));
+  EXPECT_EQ(executor.nodeIndex(0), 0);
+  EXPECT_EQ(executor.nodeIndex(3), 1);
+
+  // Keeps the thread of node 0 busy.
+  folly::Baton<> started;
+  folly::Baton<> release;
+  executor.addWithAffinity(
+      [&]() {
+        started.post();
+        release.wait();
+      },
+      0);
+  started.wait();
+
+  // Functions for node 1 run on node 1.
+  std::atomic_int32_t numOnNode1{0};
+  folly::Latch node1Done(10);
+  for (auto i = 0; i < 10; ++i) {
+    executor.addWithAffinity(
+        [&]() {
+          numOnNode1 += DriverExecutor::currentNodeIndex() == 1;
+          node1Done.count_down();
+        },
+        1);
+  }
+  node1Done.wait();
+  EXPECT_EQ(numOnNode1, 10);
+
+  // Functions for the busy node 0 are stolen by node 1.
+  const auto numStolen = executor.numStolen();
+  folly::Latch node0Done(10);
+  for (auto i = 0; i < 10; ++i) {
+    executor.addWithAffinity([&]() { node0Done.count_down(); }, 0);
+  }
+  node0Done.wait();
+  EXPECT_EQ(executor.numStolen(), numStolen + 10);
+  release.post();
+}
+
+TEST(DriverExecutorTest, schedulingGroup) {
+  DriverExecutor executor(twoNodes(1));
+  EXPECT_EQ(executor.nodeIndex(1), 0);
+  auto group = executor.schedulingGroup("q1", 4);
+  EXPECT_EQ(group->weight(), 4);
+  EXPECT_EQ(executor.schedulingGroup("q1", 1), group);
+  EXPECT_NE(executor.schedulingGroup("q2", 1), group);
+
+  EXPECT_EQ(DriverExecutor::level(nullptr), 0);
+  EXPECT_EQ(DriverExecutor::level(group.get()), 0);
+  // 2s of CPU over weight 4 is still in the first level.
+  group->addCpuNanos(2'000'000'000);
+  EXPECT_EQ(DriverExecutor::level(group.get()), 0);
+  SchedulingGroup other(1);
+  other.addCpuNanos(2'000'000'000);
+  EXPECT_EQ(DriverExecutor::level(&other), 1);
+  other.addCpuNanos(1'000'000'000'000);
+  EXPECT_EQ(DriverExecutor::level(&other), DriverExecutor::kNumLevels - 1);
+
+  // A group lives as long as it is referenced.
+  group.reset();
+  EXPECT_EQ(executor.schedulingGroup("q1", 2)->weight(), 2);
+}
+
+TEST(DriverExecutorTest, levels) {
+  DriverExecutor::Options options;
+  options.numThreads = 1;
+  options.nodes = {{0, {0}}};
+  options.pinThreads = false;
+  DriverExecutor executor(options);
+
+  // A long running query in the last level keeps the thread busy.
+  auto etl = std::make_shared<SchedulingGroup>(1);
+  etl->addCpuNanos(1'000'000'000'000);
+  folly::Baton<> started;
+  folly::Baton<> release;
+  executor.addWithAffinity(
+      [&]() {
+        started.post();
+        release.wait();
+      },
+      0,
+      etl);
+  started.wait();
+
+  // Queues work of a query in level 2 before work of a new query in level 0.
+  auto batch = std::make_shared<SchedulingGroup>(1);
+  batch->addCpuNanos(20'000'000'000);
+  auto interactive = std::make_shared<SchedulingGroup>(1);
+  ASSERT_EQ(DriverExecutor::level(batch.get()), 2);
+  ASSERT_EQ(DriverExecutor::level(interactive.get()), 0);
+  std::vector<int32_t> levels;
+  auto spin = [&](int32_t level) {
+    const auto start = process::threadCpuNanos();
+    while (process::threadCpuNanos() - start < 1'000'000) {
+    }
+    levels.push_back(level);
+  };
+  constexpr int32_t kNumFuncs = 10;
+  folly::Latch done(2 * kNumFuncs);
+  for (auto i = 0; i < kNumFuncs; ++i) {
+    executor.addWithAffinity(
+        [&]() {
+          spin(2);
+          done.count_down();
+        },
+        0,
+        batch);
+  }
+  for (auto i = 0; i < kNumFuncs; ++i) {
+    executor.addWithAffinity(
+        [&]() {
+          spin(0);
+          done.count_down();
+        },
+        0,
+        interactive);
+  }
+  release.post();
+  done.wait();
+
+  // Level 0 has 4 times the share of level 2, so most of the first half is
+  // from level 0 though it was queued last. Level 2 is not starved.
+  ASSERT_EQ(levels.size(), 2 * kNumFuncs);
+  EXPECT_EQ(levels[0], 0);
+  EXPECT_GE(std::count(levels.begin(), levels.begin() + kNumFuncs, 0), 6);
+  EXPECT_GE(std::count(levels.begin(), levels.begin() + kNumFuncs, 2), 1);
+  EXPECT_GT(executor.levelCpuNanos(0), 0);
+  EXPECT_GT(executor.levelCpuNanos(2), 0);
+  EXPECT_GE(interactive->cpuNanos(), kNumFuncs * 1'000'000);
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
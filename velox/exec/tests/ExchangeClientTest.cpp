@@ -285,6 +285,93 @@ TEST_P(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+// Same as flowControl with the credit based limit. The credit starts at the
+// queue limit and each request gets an even share of it among the producing
+// sources.
+TEST_P(ExchangeClientTest, creditFlowControl) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  auto page = test::toSerializedPage(data, serdeKind_, bufferManager_, pool());
+  const int64_t maxQueuedBytes = page->size() * 3.5;
+  auto client = std::make_shared<ExchangeClient>(
+      "credit.flow.control",
+      17,
+      maxQueuedBytes,
+      1,
+      1024,
+      pool(),
+      executor(),
+      10,
+      false,
+      false,
+      /*flowControl=*/true);
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 10; ++i) {
+    auto taskId = fmt::format("local://t{}", i);
+    auto task = makeTask(taskId);
+
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+
+    for (auto j = 0; j < 3; ++j) {
+      enqueue(taskId, 17, data);
+    }
+
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  fetchPages(1, *client, 3 * tasks.size());
+
+  const auto stats = client->stats();
+  EXPECT_LE(stats.at("peakBytes").sum, page->size() * 4);
+  EXPECT_EQ(30, stats.at("numReceivedPages").sum);
+  EXPECT_LE(stats.at("exchangeCreditBytes").sum, maxQueuedBytes);
+  EXPECT_GT(stats.at("exchangeCreditBytes").sum, 0);
+  EXPECT_EQ(1, stats.count("numExchangeConsumerWaits"));
+  EXPECT_EQ(1, stats.count("numExchangeCreditLimitedRequests"));
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+
+  client->close();
+}
+
+TEST_P(ExchangeClientTest, consumedBytesPerSecond) {
+  auto queue = std::make_shared<ExchangeQueue>(1, 0);
+  addSources(*queue, 1);
+  bool atEnd;
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ContinuePromise stalePromise = ContinuePromise::makeEmpty();
+  auto dequeue = [&]() {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    return queue->dequeueLocked(1, 1 << 20, &atEnd, &future, &stalePromise);
+  };
+
+  // A consumer that finds no data waits.
+  ASSERT_TRUE(dequeue().empty());
+  ASSERT_EQ(1, queue->numConsumerWaits());
+
+  enqueue(*queue, makePage(1'000));
+  ASSERT_EQ(1, dequeue().size());
+  // The rate is known after the first interval.
+  ASSERT_EQ(0, queue->consumedBytesPerSecond());
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  enqueue(*queue, makePage(1'000));
+  ASSERT_EQ(1, dequeue().size());
+  // 2000 bytes in at least 150ms.
+  ASSERT_LT(0, queue->consumedBytesPerSecond());
+  ASSERT_GE(2'000 * 1'000 / 150, queue->consumedBytesPerSecond());
+  ASSERT_EQ(1, queue->numConsumerWaits());
+
+  queue->close();
+}
+
 // Test that small pages will block and we will keep
 // requesting from the queue if we do not have enough buffer
 // to fillout minOutputBatchBytes
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/ExecutionFeedback.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "velox/exec/HashAggregation.h"
+#include "velox/exec/HashTable.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+using namespace facebook::velox::exec::test;
+
+class ExecutionFeedbackTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    ExecutionFeedback::instance()->clear();
+  }
+
+  void TearDown() override {
+    ExecutionFeedback::instance()->clear();
+    OperatorTestBase::TearDown();
+  }
+
+  // Returns 'numBatches' batches of 'batchSize' distinct keys in a range too
+  // large for an array hash table.
+  std::vector<RowVectorPtr> makeDistinctKeys(
+      int32_t numBatches,
+      int32_t batchSize) {
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < numBatches; ++i) {
+      batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+          batchSize,
+          [&](auto row) { return (i * batchSize + row) * 1'000'003L; })}));
+    }
+    return batches;
+  }
+
+  // Runs 'plan' with execution feedback enabled if 'feedback' is true and
+  // waits for the feedback of the run to be recorded.
+  std::shared_ptr<Task> run(
+      const core::PlanNodePtr& plan,
+      bool feedback = true,
+      int32_t abandonPartialAggregationMinRows = 100'000) {
+    const auto fingerprint =
+        ExecutionFeedback::fingerprints(*plan).at(plan->id());
+    const auto previous = ExecutionFeedback::instance()->find(fingerprint);
+    const auto numRuns = previous.has_value() ? previous->numRuns : 0;
+    std::shared_ptr<Task> task;
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kExecutionFeedbackEnabled,
+            feedback ? "true" : "false")
+        .config(
+            core::QueryConfig::kAbandonPartialAggregationMinRows,
+            abandonPartialAggregationMinRows)
+        .maxDrivers(1)
+        .copyResults(pool(), task);
+    if (!feedback) {
+      return task;
+    }
+    // The feedback is recorded after the task completion is signaled.
+    for (auto i = 0; i < 3'000; ++i) {
+      const auto current = ExecutionFeedback::instance()->find(fingerprint);
+      if (current.has_value() && current->numRuns > numRuns) {
+        return task;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    VELOX_FAIL("The feedback of the run was not recorded");
+  }
+
+  static RuntimeMetric runtimeStat(
+      const std::shared_ptr<Task>& task,
+      const core::PlanNodeId& planNodeId,
+      std::string_view name) {
+    const auto& customStats =
+        toPlanStats(task->taskStats()).at(planNodeId).customStats;
+    auto it = customStats.find(std::string(name));
+    return it == customStats.end() ? RuntimeMetric() : it->second;
+  }
+};
+
+TEST_F(ExecutionFeedbackTest, fingerprints) {
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  auto idGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId valuesId;
+  core::PlanNodeId filterId;
+  core::PlanNodeId aggregationId;
+  auto makePlan = [&](const std::string& filter) {
+    return PlanBuilder(idGenerator)
+        .values({data})
+        .capturePlanNodeId(valuesId)
+        .filter(filter)
+        .capturePlanNodeId(filterId)
+        .singleAggregation({"c0"}, {"count(1)"})
+        .capturePlanNodeId(aggregationId)
+        .planNode();
+  };
+
+  const auto plan = makePlan("c0 > 1");
+  const auto fingerprints = ExecutionFeedback::fingerprints(*plan);
+  ASSERT_EQ(fingerprints.size(), 3);
+  const auto values = fingerprints.at(valuesId);
+  const auto filter = fingerprints.at(filterId);
+  const auto aggregation = fingerprints.at(aggregationId);
+  EXPECT_NE(values, filter);
+  EXPECT_NE(filter, aggregation);
+
+  // The same plan with other plan node ids.
+  const auto samePlan = makePlan("c0 > 1");
+  ASSERT_NE(samePlan->id(), plan->id());
+  const auto sameFingerprints = ExecutionFeedback::fingerprints(*samePlan);
+  EXPECT_EQ(sameFingerprints.at(valuesId), values);
+  EXPECT_EQ(sameFingerprints.at(filterId), filter);
+  EXPECT_EQ(sameFingerprints.at(aggregationId), aggregation);
+
+  // A different filter changes the fingerprints of the filter and the nodes
+  // above it.
+  const auto otherFingerprints =
+      ExecutionFeedback::fingerprints(*makePlan("c0 > 2"));
+  EXPECT_EQ(otherFingerprints.at(valuesId), values);
+  EXPECT_NE(otherFingerprints.at(filterId), filter);
+  EXPECT_NE(otherFingerprints.at(aggregationId), aggregation);
+}
+
+TEST_F(ExecutionFeedbackTest, record) {
+  ExecutionFeedback feedback(2);
+  EXPECT_FALSE(feedback.find(1).has_value());
+  feedback.record(1, {.inputRows = 100, .outputRows = 10});
+  feedback.record(1, {.inputRows = 200, .outputRows = 50});
+  auto entry = feedback.find(1);
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(entry->inputRows, 200);
+  EXPECT_EQ(entry->numRuns, 2);
+  EXPECT_DOUBLE_EQ(entry->selectivity(), 0.25);
+  EXPECT_EQ(
+      entry->toString(),
+      "inputRows: 200 rawInputRows: 0 outputRows: 50 maxNumDistinct: 0 "
+      "abandonedPartialAggregation: false spilledBytes: 0 numRuns: 2");
+
+  // Holds the 2 most recently recorded nodes.
+  feedback.record(2, {});
+  feedback.record(3, {});
+  EXPECT_EQ(feedback.size(), 2);
+  EXPECT_FALSE(feedback.find(1).has_value());
+  EXPECT_TRUE(feedback.find(3).has_value());
+
+  feedback.clear();
+  EXPECT_EQ(feedback.size(), 0);
+}
+
+TEST_F(ExecutionFeedbackTest, hashAggregationSize) {
+  const auto plan = PlanBuilder()
+                        .values(makeDistinctKeys(10, 1'000))
+                        .singleAggregation({"c0"}, {"count(1)"})
+                        .planNode();
+  auto task = run(plan);
+  const auto numRehashes =
+      runtimeStat(task, plan->id(), BaseHashTable::kNumRehashes).sum;
+  ASSERT_GE(numRehashes, 2);
+  auto feedback = task->executionFeedback(plan->id());
+  ASSERT_TRUE(feedback.has_value());
+  EXPECT_EQ(feedback->maxNumDistinct, 10'000);
+  EXPECT_EQ(feedback->inputRows, 10'000);
+  EXPECT_EQ(feedback->outputRows, 10'000);
+
+  // The second run makes the table for 10K groups and does not grow it.
+  task = run(plan);
+  EXPECT_LT(
+      runtimeStat(task, plan->id(), BaseHashTable::kNumRehashes).sum,
+      numRehashes);
+  EXPECT_GE(
+      runtimeStat(task, plan->id(), BaseHashTable::kCapacity).sum, 10'000);
+  EXPECT_EQ(task->executionFeedback(plan->id())->numRuns, 2);
+
+  // Without feedback the table grows as before.
+  task = run(plan, false);
+  EXPECT_EQ(
+      runtimeStat(task, plan->id(), BaseHashTable::kNumRehashes).sum,
+      numRehashes);
+}
+
+TEST_F(ExecutionFeedbackTest, abandonPartialAggregation) {
+  core::PlanNodeId partialId;
+  const auto plan = PlanBuilder()
+                        .values(makeDistinctKeys(5, 5'000))
+                        .partialAggregation({"c0"}, {"count(1)"})
+                        .capturePlanNodeId(partialId)
+                        .finalAggregation()
+                        .planNode();
+  const auto abandoned = [&](const std::shared_ptr<Task>& task) {
+    return runtimeStat(
+               task, partialId, HashAggregation::kAbandonedPartialAggregation)
+               .count > 0;
+  };
+
+  // 25K rows are too few to abandon partial aggregation by default.
+  EXPECT_FALSE(abandoned(run(plan)));
+  EXPECT_TRUE(abandoned(run(plan, true, 100)));
+  // The earlier run abandoned partial aggregation, so this one checks the
+  // reduction after 10K rows.
+  EXPECT_TRUE(abandoned(run(plan)));
+  EXPECT_FALSE(abandoned(run(plan, false)));
+}
+
+} // namespace
+} // namespace facebook::velox::exec
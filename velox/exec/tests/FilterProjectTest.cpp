@@ -295,6 +295,40 @@ TEST_F(FilterProjectTest, projectAndIdentityOverLazy) {
   assertQuery(plan, "SELECT c0 < 10 AND c1 < 10, c1 FROM tmp");
 }
 
+TEST_F(FilterProjectTest, filterProjectAndIdentityOverLazy) {
+  // A lazy column that is not referenced by the filter but by a projection
+  // and an identity projection is loaded only for the rows that pass the
+  // filter.
+  vector_size_t size = 100;
+  auto valueAt = [](auto row) -> int32_t { return row; };
+  std::atomic_int32_t numLoaded{0};
+  auto lazyVectors = makeRowVector({
+      makeFlatVector<int32_t>(size, valueAt),
+      vectorMaker_.lazyFlatVector<int32_t>(
+          size,
+          [&](auto row) {
+            ++numLoaded;
+            return row;
+          }),
+  });
+
+  auto vectors = makeRowVector({
+      makeFlatVector<int32_t>(size, valueAt),
+      makeFlatVector<int32_t>(size, valueAt),
+  });
+
+  createDuckDbTable({vectors});
+
+  auto plan = test::PlanBuilder()
+                  .values({lazyVectors})
+                  .filter("c0 % 10 = 0")
+                  .project({"c0 < 50 AND c1 % 20 = 0", "c1"})
+                  .planNode();
+  assertQuery(
+      plan, "SELECT c0 < 50 AND c1 % 20 = 0, c1 FROM tmp WHERE c0 % 10 = 0");
+  EXPECT_EQ(numLoaded, 10);
+}
+
 // Verify the optimization of avoiding copy in null propagation does not break
 // the case when the field is shared between multiple parents.
 TEST_F(FilterProjectTest, nestedFieldReferenceSharedChild) {
@@ -333,6 +367,37 @@ TEST_F(FilterProjectTest, numSilentThrow) {
   ASSERT_EQ(100, planStats.at(filterId).customStats.at("numSilentThrow").sum);
 }
 
+TEST_F(FilterProjectTest, sharedSubexprWithFilter) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(100, folly::identity),
+  });
+
+  // The projection reuses 'c0 * 3' computed by the filter for the passing
+  // rows instead of evaluating it again.
+  core::PlanNodeId projectId;
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .filter("(c0 * 3) % 2 = 0")
+                  .project({"c0 * 3 + 1"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+
+  std::shared_ptr<Task> task;
+  auto result =
+      test::AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kOperatorTrackExpressionStats, "true")
+          .copyResults(pool(), task);
+  velox::test::assertEqualVectors(
+      makeRowVector({makeFlatVector<int32_t>(
+          50, [](auto row) { return row * 6 + 1; })}),
+      result);
+
+  auto planStats = toPlanStats(task->taskStats());
+  const auto& expressionStats = planStats.at(projectId).expressionStats;
+  ASSERT_EQ(expressionStats.at("multiply").numProcessedRows, 100);
+  ASSERT_EQ(expressionStats.at("plus").numProcessedRows, 50);
+}
+
 TEST_F(FilterProjectTest, statsSplitter) {
   auto data = makeRowVector({
       makeFlatVector<int32_t>(100, folly::identity),
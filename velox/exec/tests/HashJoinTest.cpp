@@ -256,6 +256,31 @@ DEBUG_ONLY_TEST_P(MultiThreadedHashJoinTest, parallelJoinBuildCheck) {
   ASSERT_EQ(numDrivers_ == 1, !isParallelBuild);
 }
 
+TEST_P(MultiThreadedHashJoinTest, radixPartitionedJoinBuild) {
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .parallelizeJoinBuildRows(parallelBuildSideRowsEnabled_)
+      .keyTypes({BIGINT(), VARCHAR()})
+      .probeVectors(1600, 5)
+      .buildVectors(1500, 5)
+      .config(core::QueryConfig::kJoinBuildRadixPartitionBytes, "1024")
+      .referenceQuery(
+          "SELECT t_k0, t_k1, t_data, u_k0, u_k1, u_data FROM t, u WHERE t_k0 = u_k0 AND t_k1 = u_k1")
+      .injectSpill(false)
+      .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+        auto joinStats = task->taskStats()
+                             .pipelineStats.back()
+                             .operatorStats.back()
+                             .runtimeStats;
+        ASSERT_EQ(
+            numDrivers_ == 1,
+            joinStats.count(
+                std::string(BaseHashTable::kParallelJoinRadixPartitions)) ==
+                0);
+      })
+      .run();
+}
+
 DEBUG_ONLY_TEST_P(
     MultiThreadedHashJoinTest,
     raceBetweenTaskTerminateAndTableBuild) {
@@ -2845,6 +2870,46 @@ TEST_P(MultiThreadedHashJoinTest, noSpillLevelLimit) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, hybridSpill) {
+  // Without a memory limit, the build reads back all the spilled partitions
+  // and the probe does not spill.
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .parallelizeJoinBuildRows(parallelBuildSideRowsEnabled_)
+      .keyTypes({BIGINT(), VARCHAR()})
+      .probeVectors(1600, 5)
+      .buildVectors(1500, 5)
+      .referenceQuery(
+          "SELECT t_k0, t_k1, t_data, u_k0, u_k1, u_data FROM t, u "
+          "WHERE t_k0 = u_k0 AND t_k1 = u_k1")
+      .config(core::QueryConfig::kHashJoinHybridSpillEnabled, "true")
+      .checkSpillStats(false)
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        if (!hasSpill) {
+          return;
+        }
+        uint64_t numBuildSpilledRows{0};
+        int64_t numResidentPartitions{0};
+        for (auto& pipelineStat : task->taskStats().pipelineStats) {
+          for (auto& operatorStat : pipelineStat.operatorStats) {
+            if (operatorStat.operatorType != OperatorType::kHashBuild) {
+              continue;
+            }
+            numBuildSpilledRows += operatorStat.spilledRows;
+            auto it = operatorStat.runtimeStats.find(
+                std::string(HashBuild::kNumResidentSpillPartitions));
+            if (it != operatorStat.runtimeStats.end()) {
+              numResidentPartitions += it->second.sum;
+            }
+          }
+        }
+        if (numBuildSpilledRows > 0) {
+          ASSERT_GT(numResidentPartitions, 0);
+        }
+      })
+      .run();
+}
+
 // Verify that dynamic filter pushed down is turned off for null-aware right
 // semi project join.
 TEST_P(HashJoinTest, nullAwareRightSemiProjectOverScan) {
@@ -7057,6 +7122,65 @@ TEST_P(HashJoinTest, leftJoinWithMissAtEndOfBatchMultipleBuildMatches) {
   test("t_k2 != 4 and t_k2 != 8");
 }
 
+TEST_P(HashJoinTest, dictionaryBuildOutput) {
+  // Each probe key but the last matches 10 build rows, so the build rows
+  // repeat in the output batches.
+  auto probeVectors = std::vector<RowVectorPtr>{makeRowVector(
+      {"t_k0", "t_v0"},
+      {makeFlatVector<int32_t>(2'000, [](auto row) { return row % 4; }),
+       makeFlatVector<int64_t>(2'000, [](auto row) { return row; })})};
+  auto buildVectors = std::vector<RowVectorPtr>{makeRowVector(
+      {"u_k0", "u_v0", "u_v1"},
+      {makeFlatVector<int32_t>(30, [](auto row) { return row % 3; }),
+       makeFlatVector<std::string>(
+           30,
+           [](auto row) { return fmt::format("build string {}", row); },
+           nullEvery(7)),
+       makeFlatVector<int64_t>(30, [](auto row) { return row * 10; })})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::JoinTypeName::toName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors, true)
+                    .hashJoin(
+                        {"t_k0"},
+                        {"u_k0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors, true)
+                            .planNode(),
+                        "",
+                        {"t_k0", "t_v0", "u_v0", "u_v1"},
+                        joinType)
+                    .capturePlanNodeId(joinNodeId)
+                    .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .injectSpill(false)
+        .numDrivers(1)
+        .config(
+            core::QueryConfig::kHashProbeDictionaryBuildOutputEnabled, "true")
+        .referenceQuery(
+            fmt::format(
+                "SELECT t_k0, t_v0, u_v0, u_v1 FROM t {} JOIN u ON t_k0 = u_k0",
+                joinType == core::JoinType::kInner ? "INNER" : "LEFT"))
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          const auto runtimeStats =
+              toPlanStats(task->taskStats()).at(joinNodeId).customStats;
+          ASSERT_GT(
+              runtimeStats
+                  .at(std::string(HashProbe::kDictionaryBuildOutputBatches))
+                  .sum,
+              0);
+        })
+        .run();
+  }
+}
+
 TEST_P(HashJoinTest, leftJoinPreserveProbeOrder) {
   const std::vector<RowVectorPtr> probeVectors = {
       makeRowVector(
@@ -339,6 +339,125 @@ TEST_F(HashJoinWithCacheTest, concurrent) {
   HashTableCache::instance()->drop(cacheKey);
 }
 
+// Tests that queries with the same data version share the hash table across
+// queries and that the table stays cached after the queries finish until it is
+// evicted.
+TEST_F(HashJoinWithCacheTest, crossQuery) {
+  auto* cache = HashTableCache::instance();
+  cache->testingClearShared();
+
+  std::vector<RowVectorPtr> probeVectors = makeBatches(10, [&](int32_t) {
+    return makeRowVector(
+        {"t_k", "t_v"},
+        {
+            makeFlatVector<int32_t>(100, [](auto row) { return row % 23; }),
+            makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+        });
+  });
+
+  std::vector<RowVectorPtr> buildVectors = makeBatches(5, [&](int32_t) {
+    return makeRowVector(
+        {"u_k", "u_v"},
+        {
+            makeFlatVector<int32_t>(50, [](auto row) { return row % 31; }),
+            makeFlatVector<int64_t>(50, [](auto row) { return row * 10; }),
+        });
+  });
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto outputType = ROW(
+      {"t_k", "t_v", "u_k", "u_v"}, {INTEGER(), BIGINT(), INTEGER(), BIGINT()});
+
+  // Each query gets its own plan. The plan node ids differ between the plans.
+  auto makePlan = [&](int32_t firstId) {
+    auto planNodeIdGenerator =
+        std::make_shared<core::PlanNodeIdGenerator>(firstId);
+    auto buildPlanNode =
+        PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode();
+    auto probePlanNode =
+        PlanBuilder(planNodeIdGenerator).values(probeVectors).planNode();
+    return core::HashJoinNode::Builder()
+        .id(planNodeIdGenerator->next())
+        .joinType(core::JoinType::kInner)
+        .nullAware(false)
+        .leftKeys(
+            {std::make_shared<core::FieldAccessTypedExpr>(INTEGER(), "t_k")})
+        .rightKeys(
+            {std::make_shared<core::FieldAccessTypedExpr>(INTEGER(), "u_k")})
+        .left(probePlanNode)
+        .right(buildPlanNode)
+        .outputType(outputType)
+        .useHashTableCache(true)
+        .build();
+  };
+
+  auto makeQueryCtx = [&](const std::string& queryId,
+                          const std::string& dataVersion) {
+    return core::QueryCtx::create(
+        driverExecutor_.get(),
+        core::QueryConfig(
+            {{core::QueryConfig::kHashTableCacheCrossQueryVersion,
+              dataVersion}}),
+        std::unordered_map<std::string, std::shared_ptr<config::ConfigBase>>{},
+        cache::AsyncDataCache::getInstance(),
+        nullptr,
+        nullptr,
+        queryId);
+  };
+
+  auto runQuery = [&](const std::shared_ptr<core::QueryCtx>& queryCtx,
+                      int32_t firstId) {
+    auto task = AssertQueryBuilder(makePlan(firstId), duckDbQueryRunner_)
+                    .queryCtx(queryCtx)
+                    .maxDrivers(3)
+                    .assertResults(
+                        "SELECT t.t_k, t.t_v, u.u_k, u.u_v FROM t, u "
+                        "WHERE t.t_k = u.u_k");
+    const auto opStats = toOperatorStats(task->taskStats());
+    const auto& stats = opStats.at("HashBuild");
+    return std::make_pair(
+        stats.runtimeStats.count(
+            std::string(BaseHashTable::kHashTableCacheMiss)),
+        stats.runtimeStats.count(
+            std::string(BaseHashTable::kHashTableCacheHit)));
+  };
+
+  auto queryCtx1 = makeQueryCtx("crossQuery1", "v1");
+  EXPECT_EQ(runQuery(queryCtx1, 0), std::make_pair(1UL, 0UL));
+  waitForAllTasksToBeDeleted();
+  queryCtx1.reset();
+
+  // The table outlives the query that built it and is hit by another query.
+  auto stats = cache->sharedStats();
+  EXPECT_EQ(stats.numEntries, 1);
+  EXPECT_GT(stats.bytes, 0);
+  EXPECT_EQ(cache->idleBytes(), stats.bytes);
+  auto queryCtx2 = makeQueryCtx("crossQuery2", "v1");
+  EXPECT_EQ(runQuery(queryCtx2, 100), std::make_pair(0UL, 1UL));
+  EXPECT_EQ(cache->sharedStats().numHits, 1);
+  // The table is in use by the second query and cannot be evicted.
+  waitForAllTasksToBeDeleted();
+  EXPECT_EQ(cache->idleBytes(), 0);
+  EXPECT_EQ(cache->evictIdle(0), 0);
+
+  // A query with another data version builds its own table.
+  auto queryCtx3 = makeQueryCtx("crossQuery3", "v2");
+  EXPECT_EQ(runQuery(queryCtx3, 0), std::make_pair(1UL, 0UL));
+  waitForAllTasksToBeDeleted();
+  EXPECT_EQ(cache->sharedStats().numEntries, 2);
+
+  queryCtx2.reset();
+  queryCtx3.reset();
+  EXPECT_EQ(cache->idleBytes(), cache->sharedStats().bytes);
+  EXPECT_GT(cache->evictIdle(0), 0);
+  stats = cache->sharedStats();
+  EXPECT_EQ(stats.numEntries, 0);
+  EXPECT_EQ(stats.bytes, 0);
+  EXPECT_EQ(stats.numEvictions, 2);
+}
+
 // Tests that HashBuild and HashProbe cannot reclaim when using a cached hash
 // table. When useHashTableCache() is true, canReclaim() returns false for both
 // operators because spilling would clear the cached table and corrupt it for
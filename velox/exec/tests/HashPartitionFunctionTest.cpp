@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -264,3 +265,49 @@ TEST_F(HashPartitionFunctionTest, noKeyAndBitRange) {
     EXPECT_EQ(singlePartition.value(), 0u);
   }
 }
+
+TEST_F(HashPartitionFunctionTest, spreadHeavyHitters) {
+  constexpr int32_t kNumPartitions = 8;
+  constexpr int32_t kBatchSize = 10'000;
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  HashPartitionFunction function(true, kNumPartitions, rowType, {0});
+  HashPartitionFunction spreadFunction(
+      true, kNumPartitions, rowType, {0}, {}, true);
+
+  // 30% of the rows have key -1 and the other keys are unique.
+  std::vector<int64_t> numRowsPerPartition(kNumPartitions, 0);
+  int64_t numRows{0};
+  for (auto batch = 0; batch < 10; ++batch) {
+    auto vector = makeRowVector({makeFlatVector<int64_t>(
+        kBatchSize, [&](auto row) -> int64_t {
+          return row % 10 < 3 ? -1 : batch * kBatchSize + row;
+        })});
+    std::vector<uint32_t> partitions;
+    std::vector<uint32_t> spreadPartitions;
+    ASSERT_FALSE(function.partition(*vector, partitions).has_value());
+    ASSERT_FALSE(
+        spreadFunction.partition(*vector, spreadPartitions).has_value());
+    for (auto row = 0; row < kBatchSize; ++row) {
+      if (row % 10 >= 3) {
+        // Keys that are not heavy hitters stay in their partition.
+        ASSERT_EQ(spreadPartitions[row], partitions[row]);
+      }
+      ++numRowsPerPartition[spreadPartitions[row]];
+    }
+    numRows += kBatchSize;
+  }
+  EXPECT_GT(spreadFunction.numSpreadRows(), numRows * 29 / 100);
+  EXPECT_EQ(function.numSpreadRows(), 0);
+  for (auto count : numRowsPerPartition) {
+    EXPECT_LT(count, numRows / kNumPartitions * 12 / 10);
+  }
+
+  auto spec = std::make_unique<HashPartitionFunctionSpec>(
+      rowType, std::vector<column_index_t>{0}, std::vector<VectorPtr>{}, true);
+  ASSERT_EQ("HASH(c0) SPREAD HEAVY HITTERS", spec->toString());
+  auto copy = HashPartitionFunctionSpec::deserialize(spec->serialize(), pool());
+  ASSERT_EQ(spec->toString(), copy->toString());
+  VELOX_ASSERT_USER_THROW(
+      spec->create(kNumPartitions, false),
+      "Spreading heavy hitters is only supported for local exchange");
+}
@@ -20,7 +20,9 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec::test {
 
@@ -43,6 +45,8 @@ class HashTableCacheTest : public testing::Test {
     }
     createdKeys_.clear();
     queryCtx_.reset();
+    cache->testingClearShared();
+    cache->setSharedOptions({});
   }
 
   // Helper to track keys for cleanup.
@@ -50,6 +54,11 @@ class HashTableCacheTest : public testing::Test {
     createdKeys_.push_back(key);
   }
 
+  static std::shared_ptr<core::QueryCtx> makeQueryCtx(
+      const std::string& queryId) {
+    return core::QueryCtx::Builder().queryId(queryId).build();
+  }
+
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<core::QueryCtx> queryCtx_;
   std::vector<std::string> createdKeys_;
@@ -222,4 +231,164 @@ TEST_F(HashTableCacheTest, builderTaskDriversDoNotWait) {
   EXPECT_FALSE(future2.valid());
 }
 
+TEST_F(HashTableCacheTest, sharedEntryOutlivesQuery) {
+  auto* cache = HashTableCache::instance();
+  const std::string key = "v1:plan1";
+  auto queryCtx1 = makeQueryCtx("sharedQuery1");
+
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  auto entry =
+      cache->getShared(key, "task1", "node1", queryCtx1.get(), &future);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_TRUE(entry->shared);
+  EXPECT_EQ(entry->builderQueryId, "sharedQuery1");
+  EXPECT_FALSE(future.valid());
+
+  // Another task of the builder query waits for the build.
+  ContinueFuture waitFuture = ContinueFuture::makeEmpty();
+  EXPECT_EQ(
+      cache->getShared(key, "task2", "node1", queryCtx1.get(), &waitFuture),
+      entry);
+  EXPECT_TRUE(waitFuture.valid());
+
+  cache->put(key, nullptr, false);
+  EXPECT_TRUE(waitFuture.isReady());
+  queryCtx1.reset();
+  EXPECT_EQ(cache->sharedStats().numEntries, 1);
+  EXPECT_TRUE(entry->userQueryIds.empty());
+
+  // A later query finds the built table.
+  auto queryCtx2 = makeQueryCtx("sharedQuery2");
+  future = ContinueFuture::makeEmpty();
+  EXPECT_EQ(
+      cache->getShared(key, "task3", "node2", queryCtx2.get(), &future),
+      entry);
+  EXPECT_FALSE(future.valid());
+  EXPECT_EQ(entry->userQueryIds.count("sharedQuery2"), 1);
+
+  // An entry in use is not evicted.
+  EXPECT_EQ(cache->evictIdle(0), 0);
+  EXPECT_EQ(cache->sharedStats().numEntries, 1);
+  queryCtx2.reset();
+  cache->evictIdle(0);
+
+  const auto stats = cache->sharedStats();
+  EXPECT_EQ(stats.numEntries, 0);
+  EXPECT_EQ(stats.numHits, 1);
+  EXPECT_EQ(stats.numMisses, 1);
+  EXPECT_EQ(stats.numEvictions, 1);
+}
+
+TEST_F(HashTableCacheTest, sharedOtherQueryDoesNotWait) {
+  auto* cache = HashTableCache::instance();
+  const std::string key = "v1:plan2";
+  auto queryCtx1 = makeQueryCtx("sharedQuery1");
+  auto queryCtx2 = makeQueryCtx("sharedQuery2");
+
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_NE(
+      cache->getShared(key, "task1", "node1", queryCtx1.get(), &future),
+      nullptr);
+  // Another query builds privately rather than wait.
+  EXPECT_EQ(
+      cache->getShared(key, "task2", "node1", queryCtx2.get(), &future),
+      nullptr);
+  EXPECT_FALSE(future.valid());
+  // So does another join of the builder task with the same build side.
+  EXPECT_EQ(
+      cache->getShared(key, "task1", "node2", queryCtx1.get(), &future),
+      nullptr);
+  EXPECT_FALSE(future.valid());
+
+  // The unbuilt entry is dropped with the builder query.
+  queryCtx1.reset();
+  EXPECT_EQ(cache->sharedStats().numEntries, 0);
+  auto entry =
+      cache->getShared(key, "task2", "node1", queryCtx2.get(), &future);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->builderQueryId, "sharedQuery2");
+}
+
+TEST_F(HashTableCacheTest, sharedTtl) {
+  auto* cache = HashTableCache::instance();
+  cache->setSharedOptions({.ttlMs = 0});
+  auto queryCtx = makeQueryCtx("sharedQuery1");
+
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  cache->getShared("v1:plan3", "task1", "node1", queryCtx.get(), &future);
+  cache->put("v1:plan3", nullptr, false);
+  EXPECT_EQ(cache->sharedStats().numEntries, 1);
+  // The entry expires as soon as it is idle.
+  queryCtx.reset();
+  const auto stats = cache->sharedStats();
+  EXPECT_EQ(stats.numEntries, 0);
+  EXPECT_EQ(stats.numEvictions, 1);
+}
+
+TEST_F(HashTableCacheTest, sharedKey) {
+  auto leafPool = pool_->addLeafChild("sharedKey");
+  auto makeValues = [&](const std::string& id,
+                        const std::string& name,
+                        vector_size_t size) {
+    auto values =
+        BaseVector::create<FlatVector<int64_t>>(BIGINT(), size, leafPool.get());
+    for (auto i = 0; i < size; ++i) {
+      values->set(i, i);
+    }
+    return std::make_shared<core::ValuesNode>(
+        id,
+        std::vector<RowVectorPtr>{std::make_shared<RowVector>(
+            leafPool.get(),
+            ROW({name}, {BIGINT()}),
+            nullptr,
+            size,
+            std::vector<VectorPtr>{values})});
+  };
+  auto makeJoin = [&](const std::string& idPrefix,
+                      const core::PlanNodePtr& probe,
+                      const core::PlanNodePtr& build) {
+    return core::HashJoinNode::Builder()
+        .id(idPrefix + "join")
+        .joinType(core::JoinType::kInner)
+        .nullAware(false)
+        .leftKeys({std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "p")})
+        .rightKeys(
+            {std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "b")})
+        .left(probe)
+        .right(build)
+        .outputType(ROW({"p", "b"}, {BIGINT(), BIGINT()}))
+        .useHashTableCache(true)
+        .build();
+  };
+
+  const auto key = HashTableCache::sharedKey(
+      *makeJoin("a", makeValues("a1", "p", 10), makeValues("a2", "b", 5)),
+      "v1");
+  EXPECT_EQ(key.rfind("v1:", 0), 0);
+  // Plan node ids and the probe side do not matter.
+  EXPECT_EQ(
+      HashTableCache::sharedKey(
+          *makeJoin("b", makeValues("b1", "p", 20), makeValues("b2", "b", 5)),
+          "v1"),
+      key);
+  // The data version and the build side do.
+  EXPECT_NE(
+      HashTableCache::sharedKey(
+          *makeJoin("a", makeValues("a1", "p", 10), makeValues("a2", "b", 5)),
+          "v2"),
+      key);
+  EXPECT_NE(
+      HashTableCache::sharedKey(
+          *makeJoin("a", makeValues("a1", "p", 10), makeValues("a2", "b", 6)),
+          "v1"),
+      key);
+
+  // Build sides that read an exchange are not shared.
+  auto exchange = std::make_shared<core::ExchangeNode>(
+      "e", ROW({"b"}, {BIGINT()}), "Presto");
+  EXPECT_TRUE(HashTableCache::sharedKey(
+                  *makeJoin("a", makeValues("a1", "p", 10), exchange), "v1")
+                  .empty());
+}
+
 } // namespace facebook::velox::exec::test
@@ -28,6 +28,7 @@
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 #include <memory>
+#include <unordered_set>
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -143,7 +144,9 @@ class HashTableTest : public testing::TestWithParam<bool>,
           false,
           false,
           1'000,
-          pool());
+          pool(),
+          0,
+          joinBuildRadixPartitionBytes_);
 
       makeRows(size, 1, sequence, buildType, batches);
       copyVectorsToTable(batches, startOffset, table.get());
@@ -178,6 +181,15 @@ class HashTableTest : public testing::TestWithParam<bool>,
       rowCount += rowContainer->numRows();
     }
     ASSERT_EQ(rowCount, numRows);
+    if (joinBuildRadixPartitionBytes_ > 0 && executor_ != nullptr &&
+        mode != BaseHashTable::HashMode::kArray) {
+      const auto& radixPartitions =
+          topTable_->parallelJoinBuildStats().radixPartitions;
+      ASSERT_EQ(radixPartitions.size(), numWays);
+      for (auto numRadixPartitions : radixPartitions) {
+        ASSERT_GT(numRadixPartitions, 1);
+      }
+    }
 
     LOG(INFO) << "Made table " << describeTable();
     testProbe();
@@ -599,6 +611,9 @@ class HashTableTest : public testing::TestWithParam<bool>,
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // Size of the table ranges a parallel join build inserts one at a time. 0
+  // disables radix partitioned insertion.
+  uint64_t joinBuildRadixPartitionBytes_ = 0;
   // Base string for varchar fields when making string vector.
   std::string baseString_;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
@@ -653,6 +668,21 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, string2NormalizedRadix) {
+  auto type = ROW({"k1", "k2"}, {VARCHAR(), VARCHAR()});
+  joinBuildRadixPartitionBytes_ = 1 << 10;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 5000, 19, type, 2);
+}
+
+TEST_P(HashTableTest, mixed6SparseRadix) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  joinBuildRadixPartitionBytes_ = 1 << 10;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clearBeforeInsert) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -839,6 +869,39 @@ TEST_P(HashTableTest, arrayProbeNormalizedKey) {
   ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kNormalizedKey);
 }
 
+TEST_P(HashTableTest, groupProbeRepeatedKeysInFlight) {
+  // The group probe has several rows in flight. A row may find the group
+  // that a row just before it inserted. Covers repeats at distances around
+  // the prefetch distances of the probe.
+  const auto type = ROW({"key"}, {ROW({"k1"}, {BIGINT()})});
+  for (const auto numKeys : {1, 5, 15, 16, 17, 31, 32, 33, 1'000}) {
+    SCOPED_TRACE(fmt::format("numKeys: {}", numKeys));
+    auto table = createHashTableForAggregation(type, 1);
+    auto lookup = std::make_unique<HashLookup>(table->hashers(), pool());
+    auto data = makeRowVector({makeRowVector({makeFlatVector<int64_t>(
+        5'000, [&](auto row) { return row % numKeys; })})});
+
+    insertGroups(*data, *lookup, *table);
+    ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+    ASSERT_EQ(table->numDistinct(), numKeys);
+    ASSERT_EQ(lookup->newGroups.size(), numKeys);
+    std::vector<char*> groups(lookup->hits.begin(), lookup->hits.end());
+    for (auto row = 0; row < data->size(); ++row) {
+      ASSERT_EQ(groups[row], groups[row % numKeys]);
+    }
+    std::unordered_set<char*> distinctGroups(groups.begin(), groups.end());
+    ASSERT_EQ(distinctGroups.size(), numKeys);
+
+    // All the keys are found the second time.
+    insertGroups(*data, *lookup, *table);
+    ASSERT_EQ(table->numDistinct(), numKeys);
+    ASSERT_TRUE(lookup->newGroups.empty());
+    for (auto row = 0; row < data->size(); ++row) {
+      ASSERT_EQ(lookup->hits[row], groups[row]);
+    }
+  }
+}
+
 TEST_P(HashTableTest, regularHashingTableSize) {
   keySpacing_ = 1000;
   auto checkTableSize = [&](BaseHashTable::HashMode mode,
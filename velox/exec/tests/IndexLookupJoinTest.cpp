@@ -2413,6 +2413,108 @@ DEBUG_ONLY_TEST_P(IndexLookupJoinTest, prefetch) {
   queryThread.join();
 }
 
+DEBUG_ONLY_TEST_P(IndexLookupJoinTest, prefetchedLookupsWithLateResult) {
+  if (!GetParam().asyncLookup || GetParam().serialExecution ||
+      GetParam().numPrefetches == 0) {
+    // This test only works for async lookup with prefetch.
+    return;
+  }
+  IndexTableData tableData;
+  generateIndexTableData({100, 1, 1}, tableData, pool_);
+  // Some probe rows have no match. Each batch needs several fetches since
+  // the output batch size is a tenth of a probe batch.
+  const std::vector<RowVectorPtr> probeVectors = generateProbeInput(
+      10,
+      100,
+      1,
+      tableData,
+      pool_,
+      {"t0", "t1", "t2"},
+      GetParam().hasNullKeys,
+      {},
+      {},
+      30);
+  std::vector<std::shared_ptr<TempFilePath>> probeFiles =
+      createProbeFiles(probeVectors);
+
+  const auto indexTable = TestIndexTable::create(
+      /*numEqualJoinKeys=*/3,
+      tableData.keyVectors,
+      tableData.valueVectors,
+      *pool());
+  const auto indexTableHandle = makeIndexTableHandle(
+      indexTable, GetParam().asyncLookup, GetParam().needsIndexSplit);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const auto indexScanNode = makeIndexScanNode(
+      planNodeIdGenerator,
+      indexTableHandle,
+      makeScanOutputType({"u0", "u1", "u2", "u5"}),
+      makeIndexColumnHandles({"u0", "u1", "u2", "u5"}));
+  const auto plan = makeLookupPlan(
+      planNodeIdGenerator,
+      indexScanNode,
+      {"t0", "t1", "t2"},
+      {"u0", "u1", "u2"},
+      {},
+      /*filter=*/"",
+      /*hasMarker=*/false,
+      core::JoinType::kLeft,
+      {"t4", "u5"});
+
+  const auto runQuery = [&](int32_t numPrefetches) {
+    AssertQueryBuilder queryBuilder(plan);
+    queryBuilder
+        .config(
+            core::QueryConfig::kIndexLookupJoinMaxPrefetchBatches,
+            std::to_string(numPrefetches))
+        .config(core::QueryConfig::kPreferredOutputBatchRows, "10")
+        .config(core::QueryConfig::kIndexLookupJoinSplitOutput, "false")
+        .splits(probeScanNodeId_, makeHiveConnectorSplits(probeFiles));
+    if (GetParam().needsIndexSplit) {
+      queryBuilder.split(
+          indexScanNodeId_,
+          Split(
+              std::make_shared<TestIndexConnectorSplit>(
+                  kTestIndexConnectorName)));
+    }
+    return queryBuilder.copyResults(pool());
+  };
+  // Without prefetch the lookups run one after another in input order.
+  const auto expected = runQuery(0);
+
+  // The first fetch of the first batch and the third fetch of every other
+  // batch complete late, after the fetches of the batches behind them.
+  std::mutex mutex;
+  std::unordered_map<void*, int32_t> numCalls;
+  void* firstIterator{nullptr};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::test::TestIndexSource::ResultIterator::asyncLookup",
+      std::function<void(void*)>([&](void* iterator) {
+        int32_t numCall;
+        bool first;
+        {
+          std::lock_guard<std::mutex> l(mutex);
+          if (firstIterator == nullptr) {
+            firstIterator = iterator;
+          }
+          first = iterator == firstIterator;
+          numCall = ++numCalls[iterator];
+        }
+        // asyncLookup() runs this twice per fetch.
+        if ((first && numCall == 1) || (!first && numCall == 5)) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(100)); // NOLINT
+        }
+      }));
+  const auto result = runQuery(GetParam().numPrefetches);
+  {
+    std::lock_guard<std::mutex> l(mutex);
+    ASSERT_GT(numCalls.size(), 1);
+  }
+  // The output follows the input order although the lookups of several
+  // batches are in flight at a time.
+  facebook::velox::test::assertEqualVectors(expected, result);
+}
+
 TEST_P(IndexLookupJoinTest, outputBatchSizeWithInnerJoin) {
   IndexTableData tableData;
   generateIndexTableData({3'000, 1, 1}, tableData, pool_);
@@ -3449,6 +3551,81 @@ TEST_P(IndexLookupJoinTest, tableRowsWithDuplicateKeys) {
       "SELECT u.c0, u.c1, u.c2, u.c3, u.c4, u.c5 FROM t, u WHERE t.c0 = u.c0 AND t.c1 = u.c1 AND u.c2 = t.c2");
 }
 
+TEST_P(IndexLookupJoinTest, dedupKeysWithAdaptivePrefetch) {
+  IndexTableData tableData;
+  generateIndexTableData({10, 1, 1}, tableData, pool_);
+  // 10 distinct keys in each probe batch of 256 rows.
+  const auto probeVectors = generateProbeInput(
+      4,
+      256,
+      1,
+      tableData,
+      pool_,
+      {"t0", "t1", "t2"},
+      GetParam().hasNullKeys,
+      {},
+      {},
+      /*equalMatchPct=*/100);
+  std::vector<std::shared_ptr<TempFilePath>> probeFiles =
+      createProbeFiles(probeVectors);
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", {tableData.tableVectors});
+
+  const auto indexTable = TestIndexTable::create(
+      /*numEqualJoinKeys=*/3,
+      tableData.keyVectors,
+      tableData.valueVectors,
+      *pool());
+  const auto indexTableHandle = makeIndexTableHandle(
+      indexTable, GetParam().asyncLookup, GetParam().needsIndexSplit);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const auto indexScanNode = makeIndexScanNode(
+      planNodeIdGenerator,
+      indexTableHandle,
+      makeScanOutputType({"u0", "u1", "u2", "u5"}),
+      makeIndexColumnHandles({"u0", "u1", "u2", "u5"}));
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::JoinTypeName::toName(joinType));
+    auto plan = makeLookupPlan(
+        planNodeIdGenerator,
+        indexScanNode,
+        {"t0", "t1", "t2"},
+        {"u0", "u1", "u2"},
+        {},
+        /*filter=*/"",
+        /*hasMarker=*/false,
+        joinType,
+        {"t4", "u5"});
+    AssertQueryBuilder queryBuilder(duckDbQueryRunner_);
+    queryBuilder.plan(plan)
+        .config(
+            core::QueryConfig::kIndexLookupJoinMaxPrefetchBatches,
+            std::to_string(GetParam().numPrefetches))
+        .config(core::QueryConfig::kIndexLookupJoinAdaptivePrefetch, "true")
+        .config(core::QueryConfig::kIndexLookupJoinDedupKeys, "true")
+        .config(core::QueryConfig::kIndexLookupJoinSplitOutput, "false")
+        .splits(probeScanNodeId_, makeHiveConnectorSplits(probeFiles))
+        .serialExecution(GetParam().serialExecution)
+        .barrierExecution(GetParam().serialExecution);
+    if (GetParam().needsIndexSplit) {
+      queryBuilder.split(
+          indexScanNodeId_,
+          Split(
+              std::make_shared<TestIndexConnectorSplit>(
+                  kTestIndexConnectorName)));
+    }
+    const auto task = queryBuilder.assertResults(fmt::format(
+        "SELECT t.c4, u.c5 FROM t {} JOIN u ON t.c0 = u.c0 AND t.c1 = u.c1 AND t.c2 = u.c2",
+        joinType == core::JoinType::kLeft ? "LEFT" : "INNER"));
+
+    // Each batch sends at most its distinct keys to the index source.
+    const auto planStats = toPlanStats(task->taskStats());
+    EXPECT_EQ(planStats.at(joinNodeId_).inputRows, 4 * 256);
+    EXPECT_LE(planStats.at(indexScanNodeId_).inputRows, 4 * 10);
+  }
+}
+
 TEST_P(IndexLookupJoinTest, withFilter) {
   struct {
     std::vector<int> keyCardinalities;
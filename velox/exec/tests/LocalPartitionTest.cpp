@@ -1180,6 +1180,91 @@ TEST_F(LocalPartitionTest, vectorPool) {
   ASSERT_FALSE(vectorPool.pop());
 }
 
+TEST_F(LocalPartitionTest, memoryManager) {
+  LocalExchangeMemoryManager memoryManager(100);
+  ContinueFuture future;
+  ASSERT_FALSE(memoryManager.increaseMemoryUsage(&future, 60));
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&future, 60));
+  ContinueFuture otherFuture;
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&otherFuture, 10));
+  ASSERT_EQ(memoryManager.bufferedBytes(), 130);
+
+  // All waiters are woken once the usage goes below the limit.
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(30).empty());
+  auto promises = memoryManager.decreaseMemoryUsage(1);
+  ASSERT_EQ(promises.size(), 2);
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  ASSERT_TRUE(future.isReady());
+  ASSERT_TRUE(otherFuture.isReady());
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(99).empty());
+  ASSERT_EQ(memoryManager.bufferedBytes(), 0);
+}
+
+TEST_F(LocalPartitionTest, concurrentQueues) {
+  // Many producers and consumers with a limit that keeps blocking the
+  // producers. A lost wakeup hangs the test.
+  constexpr int32_t kNumProducers = 8;
+  constexpr int32_t kNumConsumers = 4;
+  constexpr int32_t kNumVectors = 2'000;
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(1'000);
+  auto vectorPool = std::make_shared<LocalExchangeVectorPool>(0);
+  std::vector<std::shared_ptr<LocalExchangeQueue>> queues;
+  for (auto i = 0; i < kNumConsumers; ++i) {
+    queues.push_back(
+        std::make_shared<LocalExchangeQueue>(memoryManager, vectorPool, i));
+    for (auto j = 0; j < kNumProducers; ++j) {
+      queues.back()->addProducer();
+    }
+    queues.back()->noMoreProducers();
+  }
+  auto vector = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+
+  std::atomic_int32_t numReceived{0};
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumProducers; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto n = 0; n < kNumVectors; ++n) {
+        ContinueFuture future;
+        if (queues[(i + n) % kNumConsumers]->enqueue(vector, 100, &future) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+        }
+      }
+      for (auto& queue : queues) {
+        queue->noMoreData();
+      }
+    });
+  }
+  for (auto i = 0; i < kNumConsumers; ++i) {
+    threads.emplace_back([&, i]() {
+      for (;;) {
+        ContinueFuture future;
+        RowVectorPtr data;
+        bool drained;
+        if (queues[i]->next(&future, pool(), &data, drained) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+          continue;
+        }
+        if (data == nullptr) {
+          break;
+        }
+        ++numReceived;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(numReceived, kNumProducers * kNumVectors);
+  ASSERT_EQ(memoryManager->bufferedBytes(), 0);
+  for (const auto& queue : queues) {
+    ASSERT_TRUE(queue->isFinished());
+  }
+}
+
 TEST_F(LocalPartitionTest, barrier) {
   const auto rowType = ROW({"c0"}, {BIGINT()});
   std::vector<RowVectorPtr> vectors;
@@ -161,6 +161,40 @@ TEST_F(MarkDistinctTest, aggregation) {
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
 
+TEST_F(MarkDistinctTest, streaming) {
+  // Input clustered on (c0, c1) with runs of keys spanning batches.
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < 4; ++i) {
+    const auto offset = i * 7;
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            7, [&](auto row) { return (offset + row) / 5; }),
+        makeFlatVector<int64_t>(
+            7,
+            [&](auto row) { return (offset + row) / 2; },
+            [&](auto row) { return (offset + row) / 2 % 4 == 0; }),
+    }));
+  }
+
+  for (const auto& keys : std::vector<std::vector<std::string>>{
+           {"c0"}, {"c0", "c1"}}) {
+    SCOPED_TRACE(fmt::format("numKeys: {}", keys.size()));
+    const auto hashPlan =
+        PlanBuilder().values(vectors).markDistinct("marker", keys).planNode();
+    const auto expected = AssertQueryBuilder(hashPlan).copyResults(pool());
+
+    auto task = AssertQueryBuilder(
+                    PlanBuilder()
+                        .values(vectors)
+                        .streamingMarkDistinct("marker", keys)
+                        .planNode())
+                    .assertResults(expected);
+    ASSERT_EQ(
+        task->taskStats().pipelineStats[0].operatorStats[1].operatorType,
+        "StreamingMarkDistinct");
+  }
+}
+
 TEST_F(MarkDistinctTest, spill) {
   auto vectors = createVectors(8, rowType_, fuzzerOpts_);
   createDuckDbTable(vectors);
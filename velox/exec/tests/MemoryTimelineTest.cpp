@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/MemoryTimeline.h"
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::exec;
+
+namespace {
+
+TEST(MemoryTimelineTest, addAndDrop) {
+  MemoryTimeline timeline(2);
+  timeline.add({MemoryTimeline::EventType::kSpill, "OrderBy[1] 0", 10, 5, 100});
+  timeline.add(
+      {MemoryTimeline::EventType::kRestore, "OrderBy[1] 0", 20, 3, 50});
+  timeline.add(
+      {MemoryTimeline::EventType::kReclaim, "OrderBy[1] 0", 30, 1, 10});
+  const auto events = timeline.events();
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_EQ(events[0].type, MemoryTimeline::EventType::kSpill);
+  EXPECT_EQ(events[1].type, MemoryTimeline::EventType::kRestore);
+  EXPECT_EQ(events[1].bytes, 50);
+  EXPECT_EQ(timeline.numDropped(), 1);
+}
+
+TEST(MemoryTimelineTest, eventTypeName) {
+  EXPECT_EQ(
+      MemoryTimeline::eventTypeName(MemoryTimeline::EventType::kArbitration),
+      "arbitration");
+  EXPECT_EQ(
+      MemoryTimeline::eventTypeName(MemoryTimeline::EventType::kReclaim),
+      "reclaim");
+  EXPECT_EQ(
+      MemoryTimeline::eventTypeName(MemoryTimeline::EventType::kSpill),
+      "spill");
+  EXPECT_EQ(
+      MemoryTimeline::eventTypeName(MemoryTimeline::EventType::kRestore),
+      "restore");
+}
+
+TEST(MemoryTimelineTest, chromeTrace) {
+  MemoryTimeline timeline(10);
+  timeline.add(
+      {MemoryTimeline::EventType::kArbitration, "HashBuild[2] 1", 10, 5, 64});
+  timeline.add(
+      {MemoryTimeline::EventType::kSpill, "OrderBy[1] 0", 20, 7, 100, "p3"});
+  timeline.add(
+      {MemoryTimeline::EventType::kReclaim, "HashBuild[2] 1", 30, 2, 32});
+
+  const auto trace = folly::parseJson(timeline.toChromeTrace());
+  const auto& traceEvents = trace["traceEvents"];
+  // A track name for each of the two operators and the three events.
+  ASSERT_EQ(traceEvents.size(), 5);
+  EXPECT_EQ(traceEvents[0]["ph"], "M");
+  EXPECT_EQ(traceEvents[0]["args"]["name"], "HashBuild[2] 1");
+  EXPECT_EQ(traceEvents[1]["name"], "arbitration");
+  EXPECT_EQ(traceEvents[1]["ph"], "X");
+  EXPECT_EQ(traceEvents[1]["ts"], 10);
+  EXPECT_EQ(traceEvents[1]["dur"], 5);
+  EXPECT_EQ(traceEvents[1]["args"]["bytes"], 64);
+  EXPECT_EQ(traceEvents[2]["args"]["name"], "OrderBy[1] 0");
+  EXPECT_EQ(traceEvents[3]["name"], "spill");
+  EXPECT_EQ(traceEvents[3]["args"]["partition"], "p3");
+  EXPECT_NE(traceEvents[3]["tid"], traceEvents[1]["tid"]);
+  EXPECT_EQ(traceEvents[4]["name"], "reclaim");
+  EXPECT_EQ(traceEvents[4]["tid"], traceEvents[1]["tid"]);
+  EXPECT_EQ(trace["otherData"]["numDropped"], 0);
+}
+
+} // namespace
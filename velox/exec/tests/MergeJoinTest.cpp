@@ -16,6 +16,7 @@
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/MergeJoinKeyRanges.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -889,6 +890,126 @@ TEST_F(MergeJoinTest, numDrivers) {
   EXPECT_EQ(2, task->numFinishedDrivers());
 }
 
+TEST_F(MergeJoinTest, assignSplitGroups) {
+  const auto range = [](int64_t min, int64_t max) {
+    return MergeJoinKeyRange{Variant(min), Variant(max)};
+  };
+
+  // Left splits [0, 9], [10, 19], [20, 29] and [30, 39]. The right split
+  // [15, 25] joins the middle two.
+  auto groups = assignMergeJoinSplitGroups(
+      {range(0, 9), range(10, 19), range(20, 29), range(30, 39)},
+      {range(15, 25), range(35, 35)},
+      10);
+  EXPECT_EQ(groups.numGroups, 3);
+  EXPECT_EQ(groups.leftGroups, std::vector<int32_t>({0, 1, 1, 2}));
+  EXPECT_EQ(groups.rightGroups, std::vector<int32_t>({1, 2}));
+
+  // Runs are packed in order into fewer groups.
+  groups = assignMergeJoinSplitGroups(
+      {range(0, 9), range(10, 19), range(20, 29), range(30, 39)}, {}, 2);
+  EXPECT_EQ(groups.numGroups, 2);
+  EXPECT_EQ(groups.leftGroups, std::vector<int32_t>({0, 0, 1, 1}));
+
+  // Equal keys at the boundary of two splits keep them together.
+  groups = assignMergeJoinSplitGroups({range(0, 10)}, {range(10, 20)}, 2);
+  EXPECT_EQ(groups.numGroups, 1);
+
+  // Unknown ranges put everything in one group.
+  groups = assignMergeJoinSplitGroups(
+      {range(0, 9), MergeJoinKeyRange{}}, {range(20, 29)}, 4);
+  EXPECT_EQ(groups.numGroups, 1);
+  EXPECT_EQ(groups.leftGroups, std::vector<int32_t>({0, 0}));
+  EXPECT_EQ(groups.rightGroups, std::vector<int32_t>({0}));
+
+  VELOX_ASSERT_THROW(
+      assignMergeJoinSplitGroups({range(2, 1)}, {}, 2),
+      "Merge join key range has min 2 greater than max 1");
+}
+
+TEST_F(MergeJoinTest, parallelKeyRanges) {
+  // Six left files of 100 consecutive keys and three right files of 200
+  // even keys, each overlapping two left files.
+  std::vector<RowVectorPtr> leftVectors;
+  std::vector<std::shared_ptr<TempFilePath>> leftFiles;
+  std::vector<MergeJoinKeyRange> leftRanges;
+  for (auto i = 0; i < 6; ++i) {
+    leftVectors.push_back(makeRowVector(
+        {"c0", "c1"},
+        {makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row % 7; })}));
+    leftFiles.push_back(TempFilePath::create());
+    writeToFile(leftFiles.back()->getPath(), leftVectors.back());
+    leftRanges.push_back(
+        {Variant(int64_t(i * 100)), Variant(int64_t(i * 100 + 99))});
+  }
+  std::vector<RowVectorPtr> rightVectors;
+  std::vector<std::shared_ptr<TempFilePath>> rightFiles;
+  std::vector<MergeJoinKeyRange> rightRanges;
+  for (auto i = 0; i < 3; ++i) {
+    rightVectors.push_back(makeRowVector(
+        {"rc0", "rc1"},
+        {makeFlatVector<int64_t>(
+             100, [&](auto row) { return i * 200 + row * 2; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row % 5; })}));
+    rightFiles.push_back(TempFilePath::create());
+    writeToFile(rightFiles.back()->getPath(), rightVectors.back());
+    rightRanges.push_back(
+        {Variant(int64_t(i * 200)), Variant(int64_t(i * 200 + 198))});
+  }
+  createDuckDbTable("t", leftVectors);
+  createDuckDbTable("u", rightVectors);
+
+  const auto groups = assignMergeJoinSplitGroups(leftRanges, rightRanges, 4);
+  ASSERT_EQ(groups.numGroups, 3);
+
+  const auto makeSplits = [&](const auto& files, const auto& splitGroups) {
+    std::vector<Split> splits;
+    for (size_t i = 0; i < files.size(); ++i) {
+      splits.emplace_back(
+          makeHiveConnectorSplit(files[i]->getPath()), splitGroups[i]);
+    }
+    return splits;
+  };
+
+  for (auto joinType :
+       {core::JoinType::kInner, core::JoinType::kLeft, core::JoinType::kFull}) {
+    SCOPED_TRACE(core::JoinTypeName::toName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId leftScanId;
+    core::PlanNodeId rightScanId;
+    auto rightScan = PlanBuilder(planNodeIdGenerator)
+                         .tableScan(ROW({"rc0", "rc1"}, {BIGINT(), BIGINT()}))
+                         .capturePlanNodeId(rightScanId)
+                         .planNode();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .tableScan(ROW({"c0", "c1"}, {BIGINT(), BIGINT()}))
+                    .capturePlanNodeId(leftScanId)
+                    .mergeJoin(
+                        {"c0"},
+                        {"rc0"},
+                        rightScan,
+                        "",
+                        {"c0", "c1", "rc0", "rc1"},
+                        joinType)
+                    .planNode();
+
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .splits(leftScanId, makeSplits(leftFiles, groups.leftGroups))
+            .splits(rightScanId, makeSplits(rightFiles, groups.rightGroups))
+            .executionStrategy(core::ExecutionStrategy::kGrouped)
+            .groupedExecutionLeafNodeIds({leftScanId, rightScanId})
+            .numSplitGroups(groups.numGroups)
+            .numConcurrentSplitGroups(groups.numGroups)
+            .assertResults(
+                fmt::format(
+                    "SELECT c0, c1, rc0, rc1 FROM t {} JOIN u ON c0 = rc0",
+                    core::JoinTypeName::toName(joinType)));
+    EXPECT_EQ(task->taskStats().completedSplitGroups.size(), 3);
+  }
+}
+
 TEST_F(MergeJoinTest, lazyVectors) {
   // A dataset of multiple row groups with multiple columns. We create
   // different dictionary wrappings for different columns and load the
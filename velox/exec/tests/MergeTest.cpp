@@ -909,6 +909,62 @@ TEST_F(MergeTest, offByOne) {
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
 
+TEST_F(MergeTest, orderByParallelMerge) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return (row * 7 + i) % 301; },
+            nullEvery(13)),
+        makeFlatVector<StringView>(
+            1'000,
+            [&](auto row) {
+              return StringView::makeInline(std::to_string(row % 17));
+            }),
+    }));
+  }
+  // Each driver reads all of 'vectors'.
+  constexpr int32_t kNumDrivers = 4;
+  std::vector<RowVectorPtr> expected;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    expected.insert(expected.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(expected);
+
+  for (const auto& orderByClauses : std::vector<std::vector<std::string>>{
+           {"c0 NULLS LAST"},
+           {"c0 DESC NULLS FIRST"},
+           {"c1", "c0 NULLS FIRST"}}) {
+    SCOPED_TRACE(folly::join(", ", orderByClauses));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    const auto plan = PlanBuilder(planNodeIdGenerator)
+                          .localMerge(
+                              orderByClauses,
+                              {PlanBuilder(planNodeIdGenerator)
+                                   .values(vectors, true)
+                                   .orderBy(orderByClauses, true)
+                                   .planNode()})
+                          .planNode();
+    std::vector<uint32_t> sortingKeys;
+    for (const auto& clause : orderByClauses) {
+      sortingKeys.push_back(clause[1] == '0' ? 0 : 1);
+    }
+    const auto sql =
+        "SELECT * FROM tmp ORDER BY " + folly::join(", ", orderByClauses);
+    for (const auto* enabled : {"false", "true"}) {
+      CursorParameters params;
+      params.planNode = plan;
+      params.maxDrivers = kNumDrivers;
+      params.queryCtx = core::QueryCtx::create(executor_.get());
+      params.queryCtx->testingOverrideConfigUnsafe(
+          {{core::QueryConfig::kOrderByParallelMergeEnabled, enabled},
+           {core::QueryConfig::kPreferredOutputBatchRows, "100"}});
+      assertQueryOrdered(params, sql, sortingKeys);
+    }
+  }
+}
+
 TEST_F(MergeTest, localMergeOutputSizeWithoutSpill) {
   struct TestParam {
     int numSources;
@@ -1500,14 +1500,13 @@ TEST_F(MixedUnionBarrierTest, barrierWithAggregation) {
       std::vector<core::PlanNodePtr>{leftScan, rightScan});
 
   // Add a single aggregation on top of the union.
-  // Note: Only non-barrier mode works with singleAggregation since hash
-  // aggregation doesn't support barriers (only streaming aggregation does).
   auto plan = PlanBuilder(planNodeIdGenerator)
                   .addNode([&](const auto&, auto) { return unionNode; })
                   .singleAggregation({"c0"}, {"sum(c1)"})
                   .planNode();
 
-  // Aggregation doesn't support barriers, so only test non-barrier mode.
+  // With barriers, a hash aggregation would produce the groups of each split,
+  // so only test non-barrier mode.
   AssertQueryBuilder queryBuilder(plan);
   queryBuilder.serialExecution(true);
   queryBuilder.split(
@@ -1008,6 +1008,185 @@ TEST_P(MultiFragmentTest, mergeExchangeWithSpill) {
       static_cast<int64_t>(VectorSerde::kindByName(GetParam().serdeKind)));
 }
 
+TEST_P(MultiFragmentTest, vectorPages) {
+  setupSources(10, 1000);
+  std::unordered_map<std::string, std::string> vectorPagesConfig{
+      {core::QueryConfig::kPartitionedOutputVectorPages, "true"}};
+  std::vector<std::shared_ptr<Task>> tasks;
+
+  // The leaf task hands dictionaries over its input to 3 destinations.
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan = PlanBuilder()
+                      .tableScan(rowType_)
+                      .partitionedOutput(
+                          {"c0"}, 3, /*outputLayout=*/{}, GetParam().serdeKind)
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, vectorPagesConfig, 0);
+  tasks.push_back(leafTask);
+  leafTask->start(4);
+  addHiveSplits(leafTask, filePaths_);
+
+  // The sort tasks copy the pages into their own memory and hand their whole
+  // output batches to a merge exchange.
+  std::vector<std::string> sortTaskIds;
+  core::PlanNodeId exchangeNodeId;
+  for (int i = 0; i < 3; ++i) {
+    auto sortPlan =
+        PlanBuilder()
+            .exchange(leafPlan->outputType(), GetParam().serdeKind)
+            .capturePlanNodeId(exchangeNodeId)
+            .orderBy({"c0"}, false)
+            .partitionedOutput({}, 1, /*outputLayout=*/{}, GetParam().serdeKind)
+            .planNode();
+    sortTaskIds.push_back(makeTaskId("orderby", i));
+    auto task = makeTask(sortTaskIds.back(), sortPlan, vectorPagesConfig, i);
+    tasks.push_back(task);
+    task->start(1);
+    addRemoteSplits(task, {leafTaskId});
+  }
+
+  auto op =
+      PlanBuilder()
+          .mergeExchange(leafPlan->outputType(), {"c0"}, GetParam().serdeKind)
+          .planNode();
+  std::vector<Split> sortTaskSplits;
+  for (const auto& sortTaskId : sortTaskIds) {
+    sortTaskSplits.emplace_back(remoteSplit(sortTaskId));
+  }
+  test::AssertQueryBuilder(op, duckDbQueryRunner_)
+      .splits(std::move(sortTaskSplits))
+      .assertResults(
+          "SELECT * FROM tmp ORDER BY 1 NULLS LAST", std::vector<uint32_t>{0});
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+  int64_t numRows = 0;
+  for (auto i = 1; i < tasks.size(); ++i) {
+    const auto& exchangeStats =
+        toPlanStats(tasks[i]->taskStats()).at(exchangeNodeId);
+    EXPECT_LT(0, exchangeStats.rawInputBytes);
+    numRows += exchangeStats.inputRows;
+  }
+  EXPECT_EQ(numRows, 10'000);
+}
+
+TEST_P(MultiFragmentTest, scatterSerialization) {
+  setupSources(10, 1000);
+  std::unordered_map<std::string, std::string> scatterConfig{
+      {core::QueryConfig::kPartitionedOutputScatterSerialization, "true"},
+      {core::QueryConfig::kMaxPartitionedOutputBufferSize, "1000000"}};
+  std::vector<std::shared_ptr<Task>> tasks;
+
+  // The leaf task serializes each batch for all destinations a column at a
+  // time. The small buffer limits the pages to the minimum size.
+  constexpr int32_t kNumPartitions = 16;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan = PlanBuilder()
+                      .tableScan(rowType_)
+                      .partitionedOutput(
+                          {"c0"},
+                          kNumPartitions,
+                          /*outputLayout=*/{},
+                          GetParam().serdeKind)
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, scatterConfig, 0);
+  tasks.push_back(leafTask);
+  leafTask->start(4);
+  addHiveSplits(leafTask, filePaths_);
+
+  std::vector<std::string> intermediateTaskIds;
+  for (int i = 0; i < kNumPartitions; ++i) {
+    auto intermediatePlan =
+        PlanBuilder()
+            .exchange(leafPlan->outputType(), GetParam().serdeKind)
+            .partitionedOutput({}, 1, /*outputLayout=*/{}, GetParam().serdeKind)
+            .planNode();
+    intermediateTaskIds.push_back(makeTaskId("intermediate", i));
+    auto task = makeTask(intermediateTaskIds.back(), intermediatePlan, i);
+    tasks.push_back(task);
+    task->start(1);
+    addRemoteSplits(task, {leafTaskId});
+  }
+
+  auto op = PlanBuilder()
+                .exchange(leafPlan->outputType(), GetParam().serdeKind)
+                .planNode();
+  std::vector<Split> intermediateSplits;
+  for (const auto& taskId : intermediateTaskIds) {
+    intermediateSplits.emplace_back(remoteSplit(taskId));
+  }
+  test::AssertQueryBuilder(op, duckDbQueryRunner_)
+      .splits(std::move(intermediateSplits))
+      .assertResults("SELECT * FROM tmp");
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+}
+
+TEST_P(MultiFragmentTest, sortedRuns) {
+  setupSources(10, 1000);
+  std::unordered_map<std::string, std::string> sortConfig{
+      {core::QueryConfig::kPartitionedOutputSortMinDestinations, "16"},
+      {core::QueryConfig::kMaxPartitionedOutputBufferSize, "100000"}};
+  std::vector<std::shared_ptr<Task>> tasks;
+
+  // The leaf task buffers its input and serializes it a destination at a
+  // time. The small buffer makes several runs per driver.
+  constexpr int32_t kNumPartitions = 16;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan = PlanBuilder()
+                      .tableScan(rowType_)
+                      .partitionedOutput(
+                          {"c0"},
+                          kNumPartitions,
+                          /*outputLayout=*/{},
+                          GetParam().serdeKind)
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, sortConfig, 0);
+  tasks.push_back(leafTask);
+  leafTask->start(4);
+  addHiveSplits(leafTask, filePaths_);
+
+  std::vector<std::string> intermediateTaskIds;
+  core::PlanNodeId exchangeNodeId;
+  for (int i = 0; i < kNumPartitions; ++i) {
+    auto intermediatePlan =
+        PlanBuilder()
+            .exchange(leafPlan->outputType(), GetParam().serdeKind)
+            .capturePlanNodeId(exchangeNodeId)
+            .partitionedOutput({}, 1, /*outputLayout=*/{}, GetParam().serdeKind)
+            .planNode();
+    intermediateTaskIds.push_back(makeTaskId("intermediate", i));
+    auto task = makeTask(intermediateTaskIds.back(), intermediatePlan, i);
+    tasks.push_back(task);
+    task->start(1);
+    addRemoteSplits(task, {leafTaskId});
+  }
+
+  auto op = PlanBuilder()
+                .exchange(leafPlan->outputType(), GetParam().serdeKind)
+                .planNode();
+  std::vector<Split> intermediateSplits;
+  for (const auto& taskId : intermediateTaskIds) {
+    intermediateSplits.emplace_back(remoteSplit(taskId));
+  }
+  test::AssertQueryBuilder(op, duckDbQueryRunner_)
+      .splits(std::move(intermediateSplits))
+      .assertResults("SELECT * FROM tmp");
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+  int64_t numRows = 0;
+  for (auto i = 1; i < tasks.size(); ++i) {
+    numRows +=
+        toPlanStats(tasks[i]->taskStats()).at(exchangeNodeId).inputRows;
+  }
+  EXPECT_EQ(numRows, 10'000);
+}
+
 TEST_P(MultiFragmentTest, noHashPartitionSkew) {
   setupSources(10, 1000);
 
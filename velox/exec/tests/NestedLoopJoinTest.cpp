@@ -235,6 +235,60 @@ TEST_F(NestedLoopJoinTest, emptyBuild) {
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
 
+TEST_F(NestedLoopJoinTest, bandCondition) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0"},
+        {makeFlatVector<int64_t>(
+            50,
+            [&](auto row) { return (i * 50 + row) * 7 % 100; },
+            nullEvery(11))}));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 4; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             30,
+             [&](auto row) { return (i * 30 + row) * 13 % 90; },
+             nullEvery(7)),
+         makeFlatVector<int64_t>(
+             30,
+             [&](auto row) { return (i * 30 + row) * 13 % 90 + row % 15; },
+             nullEvery(9))}));
+  }
+
+  setComparisons({
+      "t0 BETWEEN u0 AND u1",
+      "u0 <= t0 AND t0 < u1",
+      "u1 > t0 AND u0 < t0 AND t0 + u1 > 50",
+      "t0 >= u0",
+      "u1 >= t0",
+  });
+  setJoinConditionStr("{}");
+  setOutputLayout({"t0", "u0", "u1"});
+  setQueryStr("SELECT t0, u0, u1 FROM t {} JOIN u ON {}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
+TEST_F(NestedLoopJoinTest, filterTiles) {
+  // A single build vector of 5 rows makes tiles of 1638 probe rows, so the
+  // probe vector takes several tiles and the last one is partial.
+  auto probeVectors = {makeRowVector(
+      {"t0"},
+      {makeFlatVector<int64_t>(
+          5'000, [](auto row) { return row % 13; }, nullEvery(17))})};
+  auto buildVectors = {makeRowVector(
+      {"u0"},
+      {makeNullableFlatVector<int64_t>({0, 3, std::nullopt, 7, 3})})};
+
+  setComparisons({"t0 % 7 = u0", "t0 + u0 > 15"});
+  setJoinConditionStr("{}");
+  setQueryStr("SELECT t0, u0 FROM t {} JOIN u ON {}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
 TEST_F(NestedLoopJoinTest, basicCrossJoin) {
   auto probeVectors = {
       makeRowVector({sequence<int32_t>(10)}),
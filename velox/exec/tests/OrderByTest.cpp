@@ -390,6 +390,30 @@ TEST_F(OrderByTest, varfields) {
   testSingleKey(vectors, "c2");
 }
 
+TEST_F(OrderByTest, parallelOutputExtraction) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            2'000, [&](auto row) { return (row * 7 + i) % 3'001; }),
+        makeFlatVector<double>(
+            2'000, [](auto row) { return row * 0.1; }, nullEvery(11)),
+        makeFlatVector<std::string>(
+            2'000,
+            [](auto row) { return fmt::format("non-inline string {}", row); },
+            nullEvery(7)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto plan =
+      PlanBuilder().values(vectors).orderBy({"c0", "c1"}, false).planNode();
+  // The batches of more than 100 rows extract their columns in parallel.
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kParallelOutputExtractionMinRows, "100")
+      .assertResults("SELECT * FROM tmp ORDER BY c0, c1", {{0, 1}});
+}
+
 TEST_F(OrderByTest, unknown) {
   vector_size_t size = 1'000;
   auto vector = makeRowVector({
@@ -536,6 +560,47 @@ TEST_F(OrderByTest, spill) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(OrderByTest, memoryTimeline) {
+  const auto rowType =
+      ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
+  const auto vectors = createVectors(rowType, 1024, 16 << 20);
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .orderBy({"c0 ASC NULLS LAST"}, false)
+                        .planNode();
+  const auto expectedResult = AssertQueryBuilder(plan).copyResults(pool_.get());
+
+  auto spillDirectory = TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(plan)
+          .spillDirectory(spillDirectory->getPath())
+          .config(core::QueryConfig::kSpillEnabled, true)
+          .config(core::QueryConfig::kOrderBySpillEnabled, true)
+          .config(core::QueryConfig::kTaskMemoryTimelineMaxEvents, 10'000)
+          .assertResults(expectedResult);
+  const auto timeline = task->taskStats().memoryTimeline;
+  ASSERT_NE(timeline, nullptr);
+  int32_t numSpills{0};
+  int32_t numRestores{0};
+  for (const auto& event : timeline->events()) {
+    EXPECT_NE(event.operatorName.find("OrderBy"), std::string::npos);
+    EXPECT_GT(event.startUs, 0);
+    if (event.type == MemoryTimeline::EventType::kSpill) {
+      ++numSpills;
+      EXPECT_GT(event.bytes, 0);
+      EXPECT_FALSE(event.partition.empty());
+    } else if (event.type == MemoryTimeline::EventType::kRestore) {
+      ++numRestores;
+      EXPECT_GT(event.bytes, 0);
+    }
+  }
+  EXPECT_GT(numSpills, 0);
+  EXPECT_GT(numRestores, 0);
+  EXPECT_NE(timeline->toChromeTrace().find("traceEvents"), std::string::npos);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
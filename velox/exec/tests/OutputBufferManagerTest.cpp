@@ -16,8 +16,10 @@
 #include "velox/exec/OutputBufferManager.h"
 #include <folly/system/HardwareConcurrency.h>
 #include <gtest/gtest.h>
+#include <filesystem>
 #include "folly/synchronization/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/testutil/TempDirectoryPath.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -1457,6 +1459,82 @@ TEST_F(OutputBufferManagerTest, errorInQueue) {
       "Forced failure");
 }
 
+TEST_F(OutputBufferManagerTest, spillWhenFull) {
+  const std::string taskId = "spillWhenFull";
+  const auto spillDirectory = common::testutil::TempDirectoryPath::create();
+  const uint64_t maxSize = 2 * makeSerializedPage(rowType_, 100)->size();
+  bufferManager_->removeTask(taskId);
+
+  auto planFragment = exec::test::PlanBuilder()
+                          .values({std::dynamic_pointer_cast<RowVector>(
+                              BatchMaker::createBatch(rowType_, 100, *pool_))})
+                          .planFragment();
+  auto queryCtx = core::QueryCtx::create(
+      executor_.get(),
+      core::QueryConfig(
+          {{core::QueryConfig::kMaxOutputBufferSize, std::to_string(maxSize)},
+           {core::QueryConfig::kOutputBufferSpillEnabled, "true"}}));
+  auto task = Task::create(
+      taskId,
+      std::move(planFragment),
+      0,
+      std::move(queryCtx),
+      Task::ExecutionMode::kParallel,
+      exec::Consumer{},
+      0,
+      common::SpillDiskOptions{
+          .spillDirPath = spillDirectory->getPath(),
+          .spillDirCreated = true,
+          .spillDirCreateCb = nullptr});
+  bufferManager_->initializeTask(
+      task, PartitionedOutputNode::Kind::kPartitioned, 1, 1);
+
+  // The producer is never blocked. The pages beyond 'maxSize' go to disk.
+  constexpr int kNumPages = 10;
+  std::vector<std::string> expected;
+  for (int i = 0; i < kNumPages; ++i) {
+    auto page = makeSerializedPage(rowType_, 100);
+    expected.push_back(page->getIOBuf()->moveToFbString().toStdString());
+    ContinueFuture future;
+    ASSERT_FALSE(bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+  }
+  noMoreData(taskId);
+  {
+    const auto stats = getStats(taskId);
+    ASSERT_LE(stats.bufferedBytes, maxSize);
+    ASSERT_LT(stats.bufferedPages, kNumPages);
+    ASSERT_EQ(stats.buffersStats[0].pagesBuffered, kNumPages);
+  }
+  ASSERT_FALSE(std::filesystem::is_empty(spillDirectory->getPath()));
+
+  // The spilled pages come back in order.
+  std::vector<std::string> fetched;
+  bool atEnd = false;
+  while (!atEnd) {
+    ASSERT_TRUE(bufferManager_->getData(
+        taskId,
+        0,
+        1,
+        fetched.size(),
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t /*sequence*/,
+            std::vector<int64_t> /*remainingBytes*/) {
+          for (auto& page : pages) {
+            if (page == nullptr) {
+              atEnd = true;
+            } else {
+              fetched.push_back(page->moveToFbString().toStdString());
+            }
+          }
+        }));
+  }
+  ASSERT_EQ(fetched, expected);
+
+  deleteResults(taskId, 0);
+  bufferManager_->removeTask(taskId);
+  ASSERT_TRUE(std::filesystem::is_empty(spillDirectory->getPath()));
+}
+
 TEST_P(
     OutputBufferManagerWithDifferentSerdeKindsTest,
     setQueueErrorWithPendingPages) {
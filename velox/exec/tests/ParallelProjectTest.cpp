@@ -44,5 +44,36 @@ TEST_F(ParallelProjectTest, basic) {
   assertQuery(plan, "SELECT c0 + 1, c0 * 2, c1 + 10, c1 * 3 FROM tmp");
 }
 
+TEST_F(ParallelProjectTest, sharedSubexprs) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(100, folly::identity),
+      makeFlatVector<int32_t>(100, [](auto row) { return row % 7; }),
+  });
+
+  createDuckDbTable({data});
+
+  // 'c0 * 3' is computed once for both groups. 'c0 + c1' only appears in one
+  // group.
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .parallelProject(
+                      {{"c0 * 3 + 1", "c0 + c1"}, {"c0 * 3 - c1", "c0 * 3"}})
+                  .planNode();
+  assertQuery(
+      plan, "SELECT c0 * 3 + 1, c0 + c1, c0 * 3 - c1, c0 * 3 FROM tmp");
+
+  // Subexpressions under conditionals and try are not hoisted since they are
+  // not evaluated for all rows. Hoisting '10 / c1' would fail on c1 = 0.
+  plan = test::PlanBuilder()
+             .values({data})
+             .parallelProject(
+                 {{"if(c1 = 0, 0, 10 / c1)"}, {"try(10 / c1)"}})
+             .planNode();
+  assertQuery(
+      plan,
+      "SELECT CASE WHEN c1 = 0 THEN 0 ELSE 10 // c1 END, "
+      "CASE WHEN c1 = 0 THEN NULL ELSE 10 // c1 END FROM tmp");
+}
+
 } // namespace
 } // namespace facebook::velox::exec
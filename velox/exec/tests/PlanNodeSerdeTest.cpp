@@ -175,6 +175,12 @@ TEST_F(PlanNodeSerdeTest, markDistinct) {
                   .markDistinct("marker", {"c0", "c1", "c2"})
                   .planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .streamingMarkDistinct("marker", {"c0", "c1"})
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, enforceDistinct) {
@@ -638,6 +644,12 @@ TEST_F(PlanNodeSerdeTest, rowNumber) {
   plan = PlanBuilder().values({data_}).rowNumber({"c1", "c2"}, 10).planNode();
   testSerde(plan);
 
+  plan = PlanBuilder()
+             .values({data_})
+             .streamingRowNumber({"c1", "c2"}, 10)
+             .planNode();
+  testSerde(plan);
+
   // Test without emitting the row number.
   plan = PlanBuilder()
              .values({data_})
@@ -267,6 +267,36 @@ TEST_F(PrefixSortTest, multipleKeys) {
   }
 }
 
+TEST_F(PrefixSortTest, stringTies) {
+  // Strings longer than the prefix that share the prefix and differ at
+  // varying positions past it, including in trailing zero bytes.
+  const std::string common = "https://example.com/";
+  std::vector<std::optional<std::string>> urls;
+  for (auto i = 0; i < 500; ++i) {
+    std::string url = common + std::string(i % 37, 'a');
+    url += std::to_string(i % 23);
+    if (i % 11 == 0) {
+      url += std::string(i % 3, '\0');
+    }
+    urls.push_back(i % 29 == 0 ? std::nullopt : std::make_optional(url));
+  }
+  std::vector<std::optional<StringView>> urlViews;
+  for (const auto& url : urls) {
+    urlViews.push_back(
+        url.has_value() ? std::make_optional(StringView(url.value()))
+                        : std::nullopt);
+  }
+  const auto data = makeRowVector({
+      makeNullableFlatVector<StringView>(urlViews),
+      makeFlatVector<int32_t>(500, [](auto row) { return row % 7; }),
+  });
+
+  testPrefixSort({kAsc}, data);
+  testPrefixSort({kDesc}, data);
+  testPrefixSort({kAsc, kAsc}, data);
+  testPrefixSort({kDesc, kAsc}, data);
+}
+
 TEST_F(PrefixSortTest, fuzz) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
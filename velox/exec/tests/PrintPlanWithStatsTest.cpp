@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/testutil/TempDirectoryPath.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -568,3 +569,36 @@ TEST_F(PrintPlanWithStatsTest, taskAPI) {
   ASSERT_TRUE(waitForTaskAborted(task.get()));
   checkOutput(task.get());
 }
+
+TEST_F(PrintPlanWithStatsTest, perfCounters) {
+  if (process::PerfCounters::forCurrentThread() == nullptr) {
+    GTEST_SKIP() << "Hardware performance counters are not available";
+  }
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, folly::identity),
+  });
+  const auto plan = PlanBuilder()
+                        .values({data})
+                        .project({"c0 * 2 AS c1"})
+                        .planNode();
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOperatorTrackPerfCounters, "true")
+      .copyResults(pool(), task);
+
+  const auto stats = exec::toPlanStats(task->taskStats());
+  const auto& projectStats = stats.at(plan->id()).customStats;
+  ASSERT_EQ(projectStats.count("perfCycles"), 1);
+  EXPECT_GT(projectStats.at("perfCycles").sum, 0);
+  EXPECT_NE(
+      task->printPlanWithStats(true).find("perfCycles"),
+      std::string::npos);
+
+  // Off by default.
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  EXPECT_EQ(
+      exec::toPlanStats(task->taskStats())
+          .at(plan->id())
+          .customStats.count("perfCycles"),
+      0);
+}
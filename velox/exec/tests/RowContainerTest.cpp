@@ -522,6 +522,21 @@ class RowContainerTest : public exec::test::RowContainerTestBase,
       assertEqualVectors(expected, result);
     }
 
+    // Verify the pre-dispatched column comparer gives the same order.
+    {
+      const auto comparer =
+          rowContainer->columnComparer(0, flags.value_or(CompareFlags()));
+      auto sortedRows = rows;
+      std::reverse(sortedRows.begin(), sortedRows.end());
+      std::stable_sort(
+          sortedRows.begin(),
+          sortedRows.end(),
+          [&](const char* l, const char* r) { return comparer(l, r) < 0; });
+      VectorPtr result = BaseVector::create(type, numRows, pool_.get());
+      rowContainer->extractColumn(sortedRows.data(), numRows, 0, result);
+      assertEqualVectors(expected, result);
+    }
+
     std::function<int(
         const std::pair<int, char*>&, const std::pair<int, char*>&)>
         compareDecodedAndRows = [&](const auto& l, const auto& r) {
@@ -1203,6 +1218,8 @@ TEST_P(RowContainerTest, types) {
         EXPECT_EQ(result, sign(data->compare(rows[i], rows[i - 1], column)));
         EXPECT_EQ(
             result, sign(data->compare(rows[i], rows[i - 1], column, column)));
+        const auto comparer = data->columnComparer(column, CompareFlags());
+        EXPECT_EQ(result, sign(comparer(rows[i], rows[i - 1])));
 
         // This variation of the API compares the values on consecutive rows
         // between the same column type (used as a key and as a dependent) in
@@ -1500,6 +1517,49 @@ TEST_F(RowContainerTest, estimateRowSize) {
   EXPECT_EQ(0x440000, rowContainer->stringAllocator().retainedSize());
 }
 
+TEST_F(RowContainerTest, extractColumns) {
+  constexpr vector_size_t kNumRows = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return fmt::format("string value {}", row); },
+          nullEvery(7)),
+      makeArrayVector<int32_t>(
+          kNumRows,
+          [](auto row) { return row % 5; },
+          [](auto row) { return row; },
+          nullEvery(11)),
+      makeFlatVector<double>(
+          kNumRows, [](auto row) { return row * 0.5; }, nullEvery(3)),
+  });
+  RowContainer rowContainer(
+      asRowType(data->type())->children(), pool_.get());
+  auto rows = store(rowContainer, data);
+  // Extracts in an order other than the order of storing, as for sorted
+  // output.
+  std::reverse(rows.begin(), rows.end());
+
+  // More rows than fit in one block of extraction.
+  ASSERT_GT(kNumRows * rowContainer.fixedRowSize(), 128 << 10);
+  const std::vector<column_index_t> columnIndices = {3, 0, 2, 1};
+  for (const auto numRows : {kNumRows, 10}) {
+    SCOPED_TRACE(fmt::format("numRows: {}", numRows));
+    std::vector<VectorPtr> results;
+    for (auto column : columnIndices) {
+      results.push_back(
+          BaseVector::create(data->childAt(column)->type(), 1, pool()));
+    }
+    rowContainer.extractColumns(rows.data(), numRows, columnIndices, results);
+    for (auto i = 0; i < columnIndices.size(); ++i) {
+      auto expected = BaseVector::create(results[i]->type(), numRows, pool());
+      rowContainer.extractColumn(
+          rows.data(), numRows, columnIndices[i], expected);
+      assertEqualVectors(expected, results[i]);
+    }
+  }
+}
+
 TEST_F(RowContainerTest, alignment) {
   std::vector<Accumulator> accumulators{Accumulator(
       true, // isFixedSize
@@ -2794,6 +2854,83 @@ TEST_F(RowContainerTest, setAllNull) {
       (row[accColumn.initializedByte()] & accColumn.initializedMask()), 0);
 }
 
+TEST_F(RowContainerTest, stringInterning) {
+  constexpr vector_size_t kNumRows = 1'000;
+  auto data = makeFlatVector<std::string>(
+      kNumRows,
+      [](auto row) {
+        // Ten distinct long strings and some short and very long ones.
+        if (row % 7 == 0) {
+          return fmt::format("s{}", row % 3);
+        }
+        if (row % 101 == 0) {
+          return std::string(RowContainer::kMaxInternedStringSize + 1, 'x');
+        }
+        return fmt::format("a long string number {}", row % 10);
+      },
+      nullEvery(11));
+  DecodedVector decoded(*data);
+
+  auto storeAll = [&](RowContainer& container) {
+    std::vector<char*> rows(kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      rows[i] = container.newRow();
+      container.store(decoded, i, rows[i], 0);
+      container.store(decoded, i, rows[i], 1);
+    }
+    return rows;
+  };
+
+  auto plain = makeRowContainer({VARCHAR()}, {VARCHAR()});
+  storeAll(*plain);
+  ASSERT_EQ(plain->internedStringBytes(), 0);
+
+  auto interned = makeRowContainer({VARCHAR()}, {VARCHAR()});
+  interned->enableStringInterning();
+  auto rows = storeAll(*interned);
+  ASSERT_GT(interned->internedStringBytes(), 0);
+  ASSERT_LT(
+      interned->stringAllocator().currentBytes(),
+      plain->stringAllocator().currentBytes());
+
+  auto checkRows = [&](const std::vector<char*>& rows) {
+    for (auto column = 0; column < 2; ++column) {
+      auto result = BaseVector::create(VARCHAR(), rows.size(), pool_.get());
+      interned->extractColumn(rows.data(), rows.size(), column, result);
+      assertEqualVectors(data, result);
+    }
+  };
+  checkRows(rows);
+
+  // Equal interned strings share their bytes between rows and columns.
+  const auto offset = interned->columnAt(0).offset();
+  const auto dependentOffset = interned->columnAt(1).offset();
+  auto valueAt = [&](int32_t row, int32_t columnOffset) {
+    return *reinterpret_cast<const StringView*>(rows[row] + columnOffset);
+  };
+  ASSERT_EQ(valueAt(1, offset).data(), valueAt(31, offset).data());
+  ASSERT_EQ(valueAt(1, offset).data(), valueAt(1, dependentOffset).data());
+  ASSERT_EQ(0, interned->compare(rows[1], rows[31], 0));
+  ASSERT_NE(valueAt(1, offset).data(), valueAt(2, offset).data());
+  ASSERT_NE(valueAt(101, offset).data(), valueAt(202, offset).data());
+
+  // Erasing rows does not free the strings that other rows refer to.
+  std::vector<char*> erased;
+  std::vector<char*> kept;
+  for (auto i = 0; i < kNumRows; ++i) {
+    (i < kNumRows / 2 ? erased : kept).push_back(rows[i]);
+  }
+  interned->eraseRows(folly::Range<char**>(erased.data(), erased.size()));
+  auto result = BaseVector::create(VARCHAR(), kept.size(), pool_.get());
+  interned->extractColumn(kept.data(), kept.size(), 0, result);
+  assertEqualVectors(data->slice(kNumRows / 2, kept.size()), result);
+
+  // The interned strings are freed and made again after clear().
+  interned->clear();
+  rows = storeAll(*interned);
+  checkRows(rows);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     RowContainerTest,
     RowContainerTest,
@@ -93,6 +93,49 @@ TEST_F(RowNumberTest, basic) {
   testLimit(5);
 }
 
+TEST_F(RowNumberTest, streaming) {
+  // Input clustered on c0 with partitions spanning batches.
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < 4; ++i) {
+    const auto offset = i * 10;
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            10,
+            [&](auto row) { return (offset + row) / 7; },
+            [&](auto row) { return (offset + row) / 7 == 2; }),
+        makeFlatVector<int64_t>(10, [&](auto row) { return offset + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto testStreaming = [&](std::optional<int32_t> limit,
+                           bool generateRowNumber) {
+    SCOPED_TRACE(fmt::format(
+        "limit: {}, generateRowNumber: {}",
+        limit.has_value() ? std::to_string(limit.value()) : "none",
+        generateRowNumber));
+    const auto plan = PlanBuilder()
+                          .values(vectors)
+                          .streamingRowNumber({"c0"}, limit, generateRowNumber)
+                          .planNode();
+    const auto sql = fmt::format(
+        "SELECT {} FROM (SELECT *, row_number() over "
+        "(partition by c0 order by c1) as rn FROM tmp) WHERE rn <= {}",
+        generateRowNumber ? "*" : "c0, c1",
+        limit.value_or(std::numeric_limits<int32_t>::max()));
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_).assertResults(sql);
+    ASSERT_EQ(
+        task->taskStats().pipelineStats[0].operatorStats[1].operatorType,
+        "StreamingRowNumber");
+  };
+
+  for (const auto generateRowNumber : {true, false}) {
+    testStreaming(std::nullopt, generateRowNumber);
+    testStreaming(1, generateRowNumber);
+    testStreaming(3, generateRowNumber);
+  }
+}
+
 TEST_F(RowNumberTest, noPartitionKeys) {
   auto data = makeRowVector({
       makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
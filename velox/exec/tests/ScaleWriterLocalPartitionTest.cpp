@@ -712,6 +712,89 @@ TEST_F(ScaleWriterLocalPartitionTest, unpartitionBasic) {
   }
 }
 
+TEST_F(ScaleWriterLocalPartitionTest, unpartitionScaleDown) {
+  const std::vector<RowVectorPtr> inputVectors = makeVectors(256, 512);
+  const uint64_t queryCapacity = 256 << 20;
+  const uint32_t maxExchanegBufferSize = 2 << 20;
+
+  for (bool fastConsumer : {false, true}) {
+    SCOPED_TRACE(fmt::format("fastConsumer: {}", fastConsumer));
+    Operator::unregisterAllOperators();
+
+    auto testController = std::make_shared<TestExchangeController>(
+        4,
+        4,
+        0,
+        std::nullopt,
+        std::nullopt,
+        fastConsumer ? 4 : 64,
+        fastConsumer ? 64 : 4,
+        inputVectors,
+        /*keepConsumerInput=*/false);
+    Operator::registerOperator(
+        std::make_unique<FakeWriteNodeFactory>(testController));
+    Operator::registerOperator(
+        std::make_unique<FakeSourceNodeFactory>(testController));
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId exchnangeNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .addNode([&](const core::PlanNodeId& id,
+                                 const core::PlanNodePtr& input) {
+                      return std::make_shared<FakeSourceNode>(id, rowType_);
+                    })
+                    .scaleWriterlocalPartitionRoundRobin()
+                    .capturePlanNodeId(exchnangeNodeId)
+                    .addNode([](const core::PlanNodeId& id,
+                                const core::PlanNodePtr& input) {
+                      return std::make_shared<FakeWriteNode>(id, input);
+                    })
+                    .planNode();
+    testController->setExchangeNodeId(exchnangeNodeId);
+
+    std::shared_ptr<Task> task;
+    const auto result =
+        AssertQueryBuilder(plan)
+            .maxDrivers(32)
+            .maxQueryCapacity(queryCapacity)
+            .config(
+                core::QueryConfig::kMaxLocalExchangeBufferSize,
+                std::to_string(maxExchanegBufferSize))
+            .config(
+                core::QueryConfig::kScaleWriterRebalanceMaxMemoryUsageRatio,
+                "1.0")
+            .config(
+                core::QueryConfig::
+                    kScaleWriterMinPartitionProcessedBytesRebalanceThreshold,
+                "256")
+            .config(
+                core::QueryConfig::kScaleWriterMinThroughputGainRatio, "0.1")
+            .config(
+                core::QueryConfig::kScaleWriterScaleDownBufferUsageRatio,
+                "0.25")
+            .copyResults(pool_.get(), task);
+
+    // A writer can only be scaled down after it has been scaled up.
+    const auto& customStats =
+        toPlanStats(task->taskStats()).at(exchnangeNodeId).customStats;
+    const auto scaledDownIt = customStats.find(
+        std::string(ScaleWriterLocalPartition::kScaledDownWriters));
+    if (scaledDownIt != customStats.end()) {
+      ASSERT_LE(
+          scaledDownIt->second.sum,
+          customStats
+              .at(std::string(ScaleWriterLocalPartition::kScaledWriters))
+              .sum);
+    }
+
+    testController->clear();
+    task.reset();
+
+    verifyResults(inputVectors, {result});
+    waitForAllTasksToBeDeleted();
+  }
+}
+
 TEST_P(ScaleWriterLocalPartitionTestParametrized, unpartitionFuzzer) {
   const std::vector<RowVectorPtr> inputVectors = makeVectors(256, 512);
   const uint64_t queryCapacity = 256 << 20;
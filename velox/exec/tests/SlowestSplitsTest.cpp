@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SlowestSplits.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::exec;
+
+namespace {
+
+ScanSplitTiming makeTiming(const std::string& split, uint64_t wallNanos) {
+  return {.planNodeId = "0", .split = split, .wallNanos = wallNanos};
+}
+
+TEST(SlowestSplitsTest, keepsSlowest) {
+  SlowestSplits slowestSplits(3);
+  slowestSplits.add(makeTiming("a", 10));
+  slowestSplits.add(makeTiming("b", 50));
+  slowestSplits.add(makeTiming("c", 20));
+  slowestSplits.add(makeTiming("d", 5));
+  slowestSplits.add(makeTiming("e", 40));
+  const auto splits = slowestSplits.splits();
+  ASSERT_EQ(splits.size(), 3);
+  EXPECT_EQ(splits[0].split, "b");
+  EXPECT_EQ(splits[1].split, "e");
+  EXPECT_EQ(splits[2].split, "c");
+}
+
+TEST(SlowestSplitsTest, disabled) {
+  SlowestSplits slowestSplits(0);
+  slowestSplits.add(makeTiming("a", 10));
+  EXPECT_TRUE(slowestSplits.splits().empty());
+}
+
+TEST(SlowestSplitsTest, toString) {
+  auto timing = makeTiming("Hive: /data/file 0 - 100", 2'000'000);
+  timing.queueWallNanos = 1'000;
+  timing.reader.ioWaitWallNanos = 1'500'000;
+  timing.reader.columnDecodeCpuNanos = {{1, 100}, {2, 200}};
+  timing.reader.outputRows = 10;
+  EXPECT_EQ(timing.reader.decodeCpuNanos(), 300);
+  EXPECT_EQ(
+      timing.toString(),
+      "Hive: /data/file 0 - 100 in node 0: wall 2.00ms queue 1.00us open 0ns "
+      "first batch 0ns IO wait 1.50ms decode 300ns filter 0ns output rows 10");
+}
+
+} // namespace
@@ -547,4 +547,38 @@ TEST_F(SpatialIndexTest, testLargeBranchSize) {
   assertQuery(13, 13, 13, 13, {1});
 }
 
+TEST_F(SpatialIndexTest, testAppendingQuery) {
+  // A grid of 40 x 40 unit squares, in 4 levels with a branch size of 4.
+  std::vector<Envelope> envelopes;
+  for (int i = 0; i < 1'600; ++i) {
+    const auto x = static_cast<float>(i % 40);
+    const auto y = static_cast<float>(i / 40);
+    envelopes.push_back(
+        Envelope{
+            .minX = x, .minY = y, .maxX = x + 1, .maxY = y + 1, .rowIndex = i});
+  }
+  makeIndex(envelopes, 4);
+
+  std::vector<int32_t> result;
+  for (const auto& queryEnv :
+       {Envelope::from(0.5, 0.5, 0.5, 0.5),
+        Envelope::from(10.5, 20.5, 13.5, 21.5),
+        Envelope::from(-5, -5, -1, -1),
+        Envelope::from(39.5, 0.5, 45, 3.5)}) {
+    std::vector<int32_t> expected;
+    for (const auto& envelope : envelopes) {
+      if (Envelope::intersects(queryEnv, envelope)) {
+        expected.push_back(envelope.rowIndex);
+      }
+    }
+    // The rows are appended after the existing content of 'result'.
+    result.assign({-1});
+    index_.query(queryEnv, result);
+    ASSERT_EQ(result[0], -1);
+    result.erase(result.begin());
+    std::sort(result.begin(), result.end());
+    ASSERT_EQ(result, expected);
+  }
+}
+
 } // namespace facebook::velox::exec::test
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -29,6 +30,8 @@
 #include "velox/type/Timestamp.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
+DECLARE_bool(velox_spill_read_mmap);
+
 using namespace facebook;
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -769,6 +772,223 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, columnarFormat) {
+  auto tempDirectory = TempDirectoryPath::create();
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      kGB,
+      0,
+      compressionKind_,
+      std::nullopt,
+      pool(),
+      &spillStats_,
+      "",
+      /*columnarFormat=*/true);
+  const SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+
+  const auto strings = makeFlatVector<std::string>(
+      4, [](auto row) { return std::string(100, 'a' + row); });
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 2; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return i + row; }),
+        wrapInDictionary(
+            makeIndices(1'000, [](auto row) { return row % 4; }), strings),
+        makeConstant<int32_t>(i, 1'000),
+    }));
+    state.appendToPartition(partitionId, batches.back());
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_EQ(files.size(), 1);
+  ASSERT_TRUE(files[0].columnarFormat);
+
+  auto readFile =
+      SpillReadFile::create(files[0], 1 << 20, pool(), &spillStats_);
+  RowVectorPtr result;
+  for (const auto& batch : batches) {
+    ASSERT_TRUE(readFile->nextBatch(result));
+    assertEqualVectors(batch, result);
+    // The encodings are preserved.
+    ASSERT_EQ(
+        result->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+    ASSERT_TRUE(result->childAt(2)->isConstantEncoding());
+  }
+  ASSERT_FALSE(readFile->nextBatch(result));
+
+  // Reads only the sort key column.
+  readFile = SpillReadFile::create(
+      files[0], 1 << 20, pool(), &spillStats_, nullptr, {0});
+  for (const auto& batch : batches) {
+    ASSERT_TRUE(readFile->nextBatch(result));
+    ASSERT_EQ(result->size(), batch->size());
+    assertEqualVectors(batch->childAt(0), result->childAt(0));
+    for (auto column = 1; column < batch->childrenSize(); ++column) {
+      ASSERT_TRUE(result->childAt(column)->isConstantEncoding());
+      ASSERT_TRUE(result->childAt(column)->isNullAt(0));
+    }
+  }
+  ASSERT_FALSE(readFile->nextBatch(result));
+}
+
+TEST_P(SpillTest, mappedRead) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_spill_read_mmap = true;
+  auto tempDirectory = TempDirectoryPath::create();
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      kGB,
+      0,
+      compressionKind_,
+      std::nullopt,
+      pool(),
+      &spillStats_);
+  const SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return i + row; }),
+        makeFlatVector<std::string>(
+            1'000, [](auto row) { return std::string(row % 50, 'x'); }),
+    }));
+    state.appendToPartition(partitionId, batches.back());
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_EQ(files.size(), 1);
+
+  const auto numReads = spillStats_.spillReads.load();
+  // Reads the file through many windows of the mapping.
+  auto readFile = SpillReadFile::create(files[0], 4096, pool(), &spillStats_);
+  RowVectorPtr result;
+  for (const auto& batch : batches) {
+    ASSERT_TRUE(readFile->nextBatch(result));
+    assertEqualVectors(batch, result);
+  }
+  ASSERT_FALSE(readFile->nextBatch(result));
+  ASSERT_EQ(
+      spillStats_.spillReads.load() - numReads,
+      bits::roundUp(files[0].size, 4096) / 4096);
+}
+
+TEST_P(SpillTest, dictionaryCompression) {
+  if (!common::ZstdDictionary::supported()) {
+    GTEST_SKIP() << "Built without ZSTD";
+  }
+  auto tempDirectory = TempDirectoryPath::create();
+  // Each append is written as a separate page and each file after the first
+  // holds a single page. The first file holds the pages the dictionary is
+  // trained from.
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      /*targetFileSize=*/1,
+      0,
+      compressionKind_,
+      std::nullopt,
+      pool(),
+      &spillStats_,
+      "",
+      /*columnarFormat=*/false,
+      nullptr,
+      nullptr,
+      /*dictionaryCompression=*/true);
+  const SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 12; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+        makeFlatVector<std::string>(
+            100,
+            [&](auto row) { return fmt::format("customer-{}", row % 7); }),
+    }));
+    state.appendToPartition(partitionId, batches.back());
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_EQ(files.size(), 5);
+
+  auto batchIt = batches.begin();
+  for (const auto& file : files) {
+    ASSERT_TRUE(file.dictionaryCompression);
+    ASSERT_EQ(file.compressionKind, common::CompressionKind_NONE);
+    auto readFile = SpillReadFile::create(file, 1 << 20, pool(), &spillStats_);
+    RowVectorPtr result;
+    while (readFile->nextBatch(result)) {
+      ASSERT_NE(batchIt, batches.end());
+      assertEqualVectors(*batchIt++, result);
+    }
+  }
+  ASSERT_EQ(batchIt, batches.end());
+}
+
+TEST_P(SpillTest, spillTiers) {
+  auto localDir = TempDirectoryPath::create();
+  auto remoteDir = TempDirectoryPath::create();
+  std::vector<uint64_t> tierBytes(2, 0);
+  // The first tier takes two files, then the files overflow to the second.
+  int32_t numFiles{0};
+  SpillState state(
+      nullptr,
+      updateSpilledBytesCb_,
+      "test",
+      SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+      /*targetFileSize=*/1,
+      0,
+      compressionKind_,
+      std::nullopt,
+      pool(),
+      &spillStats_,
+      "",
+      /*columnarFormat=*/false,
+      [&]() {
+        const uint32_t tier = numFiles++ < 2 ? 0 : 1;
+        return common::SpillFileTarget{
+            tier,
+            tier == 0 ? localDir->getPath() : remoteDir->getPath(),
+            ""};
+      },
+      [&](uint32_t tier, uint64_t bytes) { tierBytes[tier] += bytes; });
+  const SpillPartitionId partitionId{0};
+  state.setPartitionSpilled(partitionId);
+
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+    }));
+    state.appendToPartition(partitionId, batches.back());
+  }
+  const auto files = state.finish(partitionId);
+  ASSERT_EQ(files.size(), 4);
+  for (auto i = 0; i < files.size(); ++i) {
+    const auto& dir = i < 2 ? localDir->getPath() : remoteDir->getPath();
+    ASSERT_EQ(files[i].path.rfind(dir, 0), 0) << files[i].path;
+  }
+  ASSERT_GT(tierBytes[0], 0);
+  ASSERT_GT(tierBytes[1], 0);
+  ASSERT_EQ(spillStats_.spilledOverflowBytes, tierBytes[1]);
+  ASSERT_EQ(spillStats_.spilledBytes, tierBytes[0] + tierBytes[1]);
+
+  for (auto i = 0; i < files.size(); ++i) {
+    auto readFile =
+        SpillReadFile::create(files[i], 1 << 20, pool(), &spillStats_);
+    RowVectorPtr result;
+    ASSERT_TRUE(readFile->nextBatch(result));
+    assertEqualVectors(batches[i], result);
+  }
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -740,6 +740,33 @@ TEST_P(StreamingAggregationTest, multipleKeys) {
   testMultiKeyAggregation(keys, 3);
 }
 
+TEST_P(StreamingAggregationTest, flatIntegerKeys) {
+  // Runs of different lengths so that the key changes fall on all the lanes
+  // of the SIMD comparisons, both within and across batches.
+  const vector_size_t size = 1'000;
+  std::vector<int64_t> runIds;
+  for (auto run = 0; runIds.size() < 3 * size; ++run) {
+    runIds.resize(runIds.size() + 1 + run % 13, run);
+  }
+  std::vector<RowVectorPtr> keys;
+  for (auto batch = 0; batch < 3; ++batch) {
+    const auto offset = batch * size;
+    keys.push_back(makeRowVector({
+        makeFlatVector<int8_t>(
+            size, [&](auto row) { return (offset + row) / 1'200; }),
+        makeFlatVector<int16_t>(
+            size, [&](auto row) { return (offset + row) / 250; }),
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return runIds[offset + row]; }),
+    }));
+  }
+
+  testMultiKeyAggregation(keys, 1024);
+
+  // Cut output into small batches of size 100.
+  testMultiKeyAggregation(keys, 100);
+}
+
 TEST_P(StreamingAggregationTest, regularSizeInputBatches) {
   auto size = 1'024;
 
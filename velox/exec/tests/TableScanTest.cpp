@@ -1592,6 +1592,76 @@ TEST_F(TableScanTest, preloadSplits) {
   ASSERT_EQ(stats.at("preloadedSplits").sum, 10);
 }
 
+TEST_F(TableScanTest, stringsFromCache) {
+  constexpr int32_t kSize = 10'000;
+  auto vector = makeRowVector({
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto row) {
+            return fmt::format("{}{}", std::string(row % 50, 'x'), row);
+          },
+          nullEvery(11)),
+      makeFlatVector<int64_t>(kSize, folly::identity),
+  });
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::COMPRESSION, common::CompressionKind_NONE);
+  config->set(dwrf::Config::STRING_DICTIONARY_ENCODING_ENABLED, false);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {vector}, config);
+  createDuckDbTable({vector});
+
+  for (const auto& enabled : {"false", "true"}) {
+    SCOPED_TRACE(fmt::format("enabled {}", enabled));
+    for (const auto& filter : {"", "c1 % 3 = 0"}) {
+      const std::string where =
+          std::string(filter).empty() ? "" : fmt::format(" WHERE {}", filter);
+      auto plan = PlanBuilder()
+                      .tableScan(asRowType(vector->type()), {}, filter)
+                      .planNode();
+      // The second run reads from the cache.
+      for (auto i = 0; i < 2; ++i) {
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .connectorSessionProperty(
+                kHiveConnectorId,
+                connector::hive::HiveConfig::kStringsFromCacheEnabledSession,
+                enabled)
+            .split(makeHiveConnectorSplit(filePath->getPath()))
+            .assertResults("SELECT * FROM tmp" + where);
+      }
+    }
+  }
+}
+
+TEST_F(TableScanTest, preloadSplitData) {
+  auto filePaths = makeFilePaths(10);
+  auto vectors = makeVectors(10, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto& maxBytes : {"0", "1", "1000000000"}) {
+    SCOPED_TRACE(fmt::format("maxBytes {}", maxBytes));
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "10")
+            .connectorSessionProperty(
+                kHiveConnectorId,
+                connector::hive::HiveConfig::kSplitPreloadMaxDataBytesSession,
+                maxBytes)
+            .splits(makeHiveConnectorSplits(filePaths))
+            .assertResults("SELECT * FROM tmp");
+    auto stats = getTableScanRuntimeStats(task);
+    ASSERT_GT(stats.at("preloadedSplits").sum, 0);
+    // Stripes larger than the limit are left to the scan.
+    if (std::string(maxBytes) == "1000000000") {
+      ASSERT_GT(stats.at("preloadedSplitDataBytes").sum, 0);
+    } else {
+      ASSERT_EQ(stats.count("preloadedSplitDataBytes"), 0);
+    }
+  }
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
@@ -1627,6 +1697,37 @@ TEST_F(TableScanTest, preloadingSplitClose) {
   latch.wait();
 }
 
+DEBUG_ONLY_TEST_F(TableScanTest, limitCancelsSplit) {
+  auto filePaths = makeFilePaths(10);
+  auto vectors = makeVectors(10, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+
+  std::atomic_int32_t numCancels{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::connector::hive::HiveDataSource::cancel",
+      std::function<void(connector::hive::HiveDataSource*)>(
+          [&](connector::hive::HiveDataSource* /*source*/) { ++numCancels; }));
+
+  // The Limit is satisfied by the first batch of the first split. The scan is
+  // closed mid-split and the data source drops the rest of that split.
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .capturePlanNodeId(scanNodeId)
+                  .limit(0, 10, false)
+                  .singleAggregation({}, {"count(1)"})
+                  .planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .assertResults(
+                      makeRowVector({makeFlatVector<int64_t>(
+                          std::vector<int64_t>{10})}));
+  ASSERT_EQ(numCancels, 1);
+  ASSERT_EQ(toPlanStats(task->taskStats()).at(scanNodeId).numSplits, 1);
+}
+
 TEST_F(TableScanTest, waitForSplit) {
   auto filePaths = makeFilePaths(10);
   auto vectors = makeVectors(10, 1'000);
@@ -1826,6 +1927,59 @@ DEBUG_ONLY_TEST_F(TableScanTest, tableScanSplitsAndWeights) {
   EXPECT_EQ(numAcquiredSplits, numSplits);
 }
 
+TEST_F(TableScanTest, splitTiming) {
+  auto filePaths = makeFilePaths(4);
+  auto vectors = makeVectors(4, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .tableScan(
+                      ROW({"c0", "c1"}, {BIGINT(), INTEGER()}),
+                      {},
+                      "c0 % 3 = 0")
+                  .planNode();
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(plan)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .config(QueryConfig::kTaskMaxSlowestSplits, "2")
+                  .assertResults("SELECT c0, c1 FROM tmp WHERE c0 % 3 = 0");
+
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_EQ(stats.at(std::string(TableScan::kSplitWallNanos)).count, 4);
+  ASSERT_EQ(stats.at(std::string(TableScan::kSplitQueueWallNanos)).count, 4);
+  ASSERT_GT(stats.at(std::string(TableScan::kSplitOpenWallNanos)).sum, 0);
+  ASSERT_GT(stats.at(std::string(TableScan::kSplitFilterCpuNanos)).sum, 0);
+  const auto numOutputRows =
+      task->taskStats().pipelineStats[0].operatorStats[0].outputPositions;
+  ASSERT_EQ(
+      stats.at(std::string(TableScan::kSplitOutputRows)).sum, numOutputRows);
+
+  const auto slowestSplits = task->taskStats().slowestSplits;
+  ASSERT_NE(slowestSplits, nullptr);
+  const auto splits = slowestSplits->splits();
+  ASSERT_EQ(splits.size(), 2);
+  ASSERT_GE(splits[0].wallNanos, splits[1].wallNanos);
+  for (const auto& split : splits) {
+    ASSERT_EQ(split.planNodeId, plan->id());
+    ASSERT_TRUE(std::any_of(
+        filePaths.begin(), filePaths.end(), [&](const auto& filePath) {
+          return split.split.find(filePath->getPath()) != std::string::npos;
+        }));
+    ASSERT_GT(split.reader.outputRows, 0);
+    ASSERT_GE(split.wallNanos, split.reader.firstBatchWallNanos);
+  }
+
+  // The slowest splits are not kept by default.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .plan(plan)
+             .splits(makeHiveConnectorSplits(filePaths))
+             .assertResults("SELECT c0, c1 FROM tmp WHERE c0 % 3 = 0");
+  ASSERT_EQ(task->taskStats().slowestSplits, nullptr);
+}
+
 TEST_F(TableScanTest, splitOffsetAndLength) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -5662,6 +5816,82 @@ TEST_F(TableScanTest, bloomFilterPushdown) {
   }
 }
 
+TEST_F(TableScanTest, stringBloomFilterPushdown) {
+  auto build = makeRowVector(
+      {"b", "c"},
+      {
+          makeFlatVector<std::string>(
+              10'001 + VectorHasher::kMaxDistinct,
+              [](auto i) { return fmt::format("key-{}", 1000 * i); }),
+          makeFlatVector<int64_t>(
+              10'001 + VectorHasher::kMaxDistinct, [](auto i) { return i; }),
+      });
+  auto probe = makeRowVector(
+      {"a", "d"},
+      {
+          makeFlatVector<std::string>(
+              4 * build->size(),
+              [](auto i) { return fmt::format("key-{}", 250 * i); }),
+          makeFlatVector<int64_t>(
+              4 * build->size(), [](auto i) { return i / 4; }),
+      });
+  std::shared_ptr<TempFilePath> files[2];
+  files[0] = TempFilePath::create();
+  writeToFile(files[0]->getPath(), {probe});
+  files[1] = TempFilePath::create();
+  writeToFile(files[1]->getPath(), {build});
+  auto idGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId, buildScanId, joinId;
+  // Both key columns get a filter. The string key gets a Bloom filter.
+  auto plan = PlanBuilder(idGenerator)
+                  .tableScan(ROW({"a", "d"}, {VARCHAR(), BIGINT()}))
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin(
+                      {"a", "d"},
+                      {"b", "c"},
+                      PlanBuilder(idGenerator)
+                          .tableScan(ROW({"b", "c"}, {VARCHAR(), BIGINT()}))
+                          .capturePlanNodeId(buildScanId)
+                          .planNode(),
+                      /*filter=*/"",
+                      {"a"})
+                  .capturePlanNodeId(joinId)
+                  .planNode();
+  auto expected = makeRowVector({build->childAt(0)});
+  // One in 4 probe keys has a match. The Bloom filter stays on with the
+  // default pass percentage and turns itself off when any pass percentage is
+  // too high. The result is the same.
+  for (auto maxPassPct : {80, 0}) {
+    SCOPED_TRACE(fmt::format("maxPassPct={}", maxPassPct));
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(
+                core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+                std::to_string(4 * build->size()))
+            .config(
+                core::QueryConfig::kHashProbeStringDynamicFilterPushdownEnabled,
+                "true")
+            .config(
+                core::QueryConfig::kHashProbeBloomFilterMinRowsToDisable,
+                "1000")
+            .config(
+                core::QueryConfig::kHashProbeBloomFilterMaxPassPct,
+                std::to_string(maxPassPct))
+            .split(probeScanId, makeHiveConnectorSplit(files[0]->getPath()))
+            .split(buildScanId, makeHiveConnectorSplit(files[1]->getPath()))
+            .assertResults(expected);
+    auto planStats = toPlanStats(task->taskStats());
+    ASSERT_EQ(
+        planStats.at(joinId).customStats.at("dynamicFiltersProduced").sum, 2);
+    ASSERT_GT(planStats.at(joinId).customStats.at("bloomFilterSize").sum, 0);
+    if (maxPassPct > 0) {
+      ASSERT_LT(planStats.at(probeScanId).outputRows, probe->size() / 2);
+    } else {
+      ASSERT_GT(planStats.at(probeScanId).outputRows, probe->size() / 2);
+    }
+  }
+}
+
 // TODO: re-enable this test once we add back driver suspension support for
 // table scan.
 TEST_F(TableScanTest, DISABLED_memoryArbitrationWithSlowTableScan) {
@@ -6777,5 +7007,141 @@ TEST_F(TableScanTest, fileFormatRuntimeStats) {
   ASSERT_EQ(stats.at("fileFormat.dwrf").sum, 3);
 }
 
+TEST_F(TableScanTest, splitResultCache) {
+  resetHiveConnector(
+      std::make_shared<config::ConfigBase>(
+          std::unordered_map<std::string, std::string>{
+              {connector::hive::HiveConfig::kSplitResultCacheMaxBytes,
+               "64MB"}}));
+  auto hiveConnector =
+      std::dynamic_pointer_cast<connector::hive::HiveConnector>(
+          connector::getConnector(kHiveConnectorId));
+  ASSERT_NE(hiveConnector, nullptr);
+
+  auto vectors = makeVectors(3, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto makeSplit = [&](bool withModificationTime) {
+    FileProperties properties{
+        .fileSize = filePath->fileSize()};
+    if (withModificationTime) {
+      properties.modificationTime = filePath->fileModifiedTime();
+    }
+    return exec::test::HiveConnectorSplitBuilder(filePath->getPath())
+        .fileProperties(properties)
+        .build();
+  };
+  auto scan = [&](const std::string& remainingFilter,
+                  bool withModificationTime = true) {
+    auto plan = PlanBuilder()
+                    .tableScan(
+                        ROW({"c0", "c1"}, {BIGINT(), INTEGER()}),
+                        {"c0 > 100"},
+                        remainingFilter)
+                    .planNode();
+    return AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .split(makeSplit(withModificationTime))
+        .assertResults(fmt::format(
+            "SELECT c0, c1 FROM tmp WHERE c0 > 100 AND {}", remainingFilter));
+  };
+  auto numHits = [&](const std::shared_ptr<Task>& task) {
+    const auto stats = getTableScanRuntimeStats(task);
+    auto it = stats.find("numSplitResultCacheHits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  ASSERT_EQ(numHits(scan("c1 % 3 = 0")), 0);
+  ASSERT_EQ(hiveConnector->splitResultCacheStats().numElements, 1);
+  ASSERT_EQ(numHits(scan("c1 % 3 = 0")), 1);
+
+  // A different filter is a different entry.
+  ASSERT_EQ(numHits(scan("c1 % 3 = 1")), 0);
+  ASSERT_EQ(hiveConnector->splitResultCacheStats().numElements, 2);
+
+  // Splits without a file version are not cached.
+  ASSERT_EQ(numHits(scan("c1 % 3 = 2", false)), 0);
+  ASSERT_EQ(numHits(scan("c1 % 3 = 2", false)), 0);
+  ASSERT_EQ(hiveConnector->splitResultCacheStats().numElements, 2);
+
+  // A scan without columns caches the row counts.
+  auto countPlan = PlanBuilder()
+                       .tableScan(ROW({}, {}), {"c0 > 100"}, "", rowType_)
+                       .singleAggregation({}, {"count(1)"})
+                       .planNode();
+  for (auto i = 0; i < 2; ++i) {
+    auto task = AssertQueryBuilder(countPlan, duckDbQueryRunner_)
+                    .split(makeSplit(true))
+                    .assertResults("SELECT count(*) FROM tmp WHERE c0 > 100");
+    ASSERT_EQ(numHits(task), i);
+  }
+
+  const auto stats = hiveConnector->clearSplitResultCache();
+  ASSERT_EQ(stats.numElements, 0);
+  ASSERT_EQ(stats.curSize, 0);
+}
+
+TEST_F(TableScanTest, topNDynamicFilterWithTiesAtCutoff) {
+  // Each file has 10 rows for each value of c0 and the top 25 rows all have
+  // c0 = 0, so the cutoff of TopN falls inside a run of ties. c1 gets smaller
+  // from file to file so that the tied rows of the later files replace the
+  // kept ones and must not be dropped by the filter pushed into the scan.
+  constexpr int32_t kNumFiles = 5;
+  constexpr vector_size_t kSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (int32_t i = 0; i < kNumFiles; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kSize, [](vector_size_t row) { return row % 100; }),
+        makeFlatVector<int64_t>(
+            kSize,
+            [&](vector_size_t row) { return (kNumFiles - i) * kSize - row; }),
+    }));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), vectors.back());
+  }
+  createDuckDbTable(vectors);
+
+  const auto rowType = asRowType(vectors[0]->type());
+  core::PlanNodeId scanNodeId;
+  core::PlanNodeId topNNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType)
+                  .capturePlanNodeId(scanNodeId)
+                  .topN({"c0", "c1"}, 25, false)
+                  .capturePlanNodeId(topNNodeId)
+                  .planNode();
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .config(
+                      QueryConfig::kTopNDynamicFilterPushdownEnabled, "true")
+                  .assertResults("SELECT * FROM tmp ORDER BY c0, c1 LIMIT 25");
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      planStats.at(scanNodeId).dynamicFilterStats.producerNodeIds,
+      std::unordered_set<core::PlanNodeId>({topNNodeId}));
+
+  // With a single key the tied rows are interchangeable.
+  plan = PlanBuilder()
+             .tableScan(ROW({"c0"}, {BIGINT()}))
+             .topN({"c0 DESC"}, 25, false)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .splits(makeHiveConnectorSplits(filePaths))
+      .config(QueryConfig::kTopNDynamicFilterPushdownEnabled, "true")
+      .assertResults("SELECT c0 FROM tmp ORDER BY c0 DESC LIMIT 25");
+
+  // The filter is not pushed down by default.
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .splits(makeHiveConnectorSplits(filePaths))
+             .assertResults("SELECT c0 FROM tmp ORDER BY c0 DESC LIMIT 25");
+  planStats = toPlanStats(task->taskStats());
+  const auto& singleKeyScanId = plan->sources()[0]->id();
+  ASSERT_TRUE(planStats.at(singleKeyScanId).dynamicFilterStats.empty());
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -16,7 +16,9 @@
 
 #include "velox/exec/Task.h"
 #include "folly/synchronization/EventCount.h"
+#include "velox/common/Casts.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/FileIds.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/MemoryArbitrator.h"
@@ -709,6 +711,64 @@ TEST_F(TaskTest, wrongPlanNodeForSplit) {
       errorMessage)
 }
 
+TEST_F(TaskTest, cachedSplitsFirst) {
+  auto makeSplit = [](const std::string& path) {
+    return exec::Split(
+        std::make_shared<connector::hive::HiveConnectorSplit>(
+            "test", path, dwio::common::FileFormat::DWRF, 0, 100));
+  };
+  auto nextPath = [](Task& task) {
+    exec::Split split;
+    ContinueFuture future;
+    EXPECT_EQ(
+        task.getSplitOrFuture(0, kUngroupedGroupId, "0", 0, {}, split, future),
+        BlockingReason::kNotBlocked);
+    return checkedPointerCast<connector::hive::HiveConnectorSplit>(
+               split.connectorSplit)
+        ->filePath;
+  };
+  const std::vector<std::string> paths = {
+      "file:/tmp/cachedSplitsFirst/a",
+      "file:/tmp/cachedSplitsFirst/b",
+      "file:/tmp/cachedSplitsFirst/c"};
+  // Gives the last file an id, as its cache entries would.
+  StringIdLease cachedFile(fileIds(), paths[2]);
+
+  for (const auto lookahead : {0, 3}) {
+    SCOPED_TRACE(fmt::format("lookahead {}", lookahead));
+    auto task = Task::create(
+        "task-1",
+        PlanBuilder()
+            .tableScan(ROW({"a"}, {INTEGER()}))
+            .project({"a * a"})
+            .planFragment(),
+        0,
+        core::QueryCtx::create(
+            driverExecutor_.get(),
+            core::QueryConfig(
+                std::unordered_map<std::string, std::string>{
+                    {core::QueryConfig::kCachedSplitLookahead,
+                     std::to_string(lookahead)}})),
+        Task::ExecutionMode::kParallel,
+        exec::Consumer{});
+    for (const auto& path : paths) {
+      task->addSplit("0", makeSplit(path));
+    }
+    std::vector<std::string> order;
+    for (auto i = 0; i < paths.size(); ++i) {
+      order.push_back(nextPath(*task));
+    }
+    if (lookahead == 0) {
+      EXPECT_EQ(order, paths);
+      EXPECT_EQ(task->taskStats().numCachedTableScanSplitsFirst, 0);
+    } else {
+      EXPECT_EQ(
+          order, (std::vector<std::string>{paths[2], paths[0], paths[1]}));
+      EXPECT_EQ(task->taskStats().numCachedTableScanSplitsFirst, 1);
+    }
+  }
+}
+
 TEST_F(TaskTest, duplicatePlanNodeIds) {
   auto plan = PlanBuilder()
                   .tableScan(ROW({"a", "b"}, {INTEGER(), DOUBLE()}))
@@ -1312,6 +1372,18 @@ TEST_F(TaskTest, supportSerialExecutionMode) {
           Task::ExecutionMode::kSerial,
           exec::Consumer{}),
       "");
+
+  auto serialPlan = PlanBuilder()
+                        .tableScan(ROW({"c0"}, {BIGINT()}))
+                        .project({"c0 % 10"})
+                        .planFragment();
+  auto serialTask = Task::create(
+      "single.execution.task.1",
+      serialPlan,
+      0,
+      core::QueryCtx::create(),
+      Task::ExecutionMode::kSerial);
+  ASSERT_TRUE(serialTask->supportSerialExecutionMode());
 }
 
 TEST_F(TaskTest, updateBroadCastOutputBuffers) {
@@ -3629,4 +3701,48 @@ DEBUG_ONLY_TEST_F(TaskTest, blockedWaitTimeOnAbort) {
       << "Operator should have recorded blocked time despite task abort";
 }
 
+TEST_F(TaskTest, stackSampling) {
+#ifndef __linux__
+  GTEST_SKIP() << "Stack sampling needs Linux";
+#endif
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 100; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<std::string>(
+            10'000, [](auto row) { return std::string(row % 100, 'a'); }),
+    }));
+  }
+  core::PlanNodeId projectId;
+  const auto plan = PlanBuilder()
+                        .values(data)
+                        .project({"length(upper(reverse(c0))) AS c1"})
+                        .capturePlanNodeId(projectId)
+                        .planFragment();
+
+  auto runTask = [&](std::unordered_map<std::string, std::string> configs) {
+    auto queryCtx = core::QueryCtx::create();
+    queryCtx->testingOverrideConfigUnsafe(std::move(configs));
+    auto task = Task::create(
+        "stackSampling", plan, 0, queryCtx, Task::ExecutionMode::kSerial);
+    while (task->next() != nullptr) {
+    }
+    return task;
+  };
+
+  auto task = runTask({});
+  EXPECT_EQ(task->stackProfileIfSampling(), nullptr);
+  EXPECT_EQ(task->foldedStacks(), "");
+
+  task = runTask({{core::QueryConfig::kTaskStackSampleIntervalMs, "1"}});
+  const auto profile = task->stackProfileIfSampling();
+  ASSERT_NE(profile, nullptr);
+  EXPECT_GT(profile->numSamples(), 0);
+  // The samples of the project are rooted at its plan node ID.
+  EXPECT_NE(task->foldedStacks().find(projectId + ";"), std::string::npos);
+
+  task->stopStackSampling();
+  EXPECT_EQ(task->stackProfileIfSampling(), nullptr);
+  EXPECT_FALSE(task->foldedStacks().empty());
+}
+
 } // namespace facebook::velox::exec::test
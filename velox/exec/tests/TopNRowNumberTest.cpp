@@ -444,6 +444,54 @@ TEST_P(MultiTopNRowNumberTest, abandonPartialEarly) {
   }
 }
 
+TEST_P(MultiTopNRowNumberTest, flushPartial) {
+  auto data = makeRowVector(
+      {"p", "s"},
+      {
+          makeFlatVector<int64_t>(10'000, [](auto row) { return row % 2'000; }),
+          makeFlatVector<int64_t>(10'000, [](auto row) { return row % 7; }),
+      });
+
+  createDuckDbTable({data});
+
+  core::PlanNodeId topNRowNumberId;
+  auto runPlan = [&](const std::string& maxPartialMemory) {
+    auto plan = PlanBuilder()
+                    .values(split(data, 20))
+                    .topNRank(functionName_, {"p"}, {"s"}, 2, false)
+                    .capturePlanNodeId(topNRowNumberId)
+                    .topNRank(functionName_, {"p"}, {"s"}, 2, true)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kMaxPartialTopNRowNumberMemory,
+                maxPartialMemory)
+            .assertResults(
+                fmt::format(
+                    "SELECT * FROM (SELECT *, {}() over (partition by p order by s) as rn FROM tmp) "
+                    "WHERE rn <= 2",
+                    functionName_));
+
+    return exec::toPlanStats(task->taskStats());
+  };
+
+  // Partial operator flushes its rows many times.
+  {
+    auto taskStats = runPlan("1B");
+    const auto& stats = taskStats.at(topNRowNumberId);
+    ASSERT_GT(stats.customStats.at("partialFlushes").sum, 1);
+    ASSERT_EQ(stats.customStats.count("abandonedPartial"), 0);
+  }
+
+  // Partial operator keeps all the partitions.
+  {
+    auto taskStats = runPlan("64MB");
+    const auto& stats = taskStats.at(topNRowNumberId);
+    ASSERT_EQ(stats.customStats.count("partialFlushes"), 0);
+  }
+}
+
 TEST_P(MultiTopNRowNumberTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b", "c", "d", "e"},
@@ -166,6 +166,32 @@ TEST_F(TopNTest, multipleKeys) {
   testTwoKeys(vectors, "c0", "c1", 200);
 }
 
+TEST_F(TopNTest, cutoff) {
+  // Once 'limit' rows are kept, later batches are filtered by the first key
+  // of the last kept row before the rows are compared. The keys are unique
+  // and get smaller and larger from batch to batch so that the cutoff both
+  // drops and keeps rows.
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 20; ++i) {
+    auto c0 = makeFlatVector<int32_t>(
+        batchSize,
+        [&](vector_size_t row) {
+          return (i % 2 == 0 ? i : -i) * batchSize + (row * 7) % batchSize;
+        },
+        nullEvery(97));
+    auto c1 = makeFlatVector<int64_t>(
+        batchSize, [&](vector_size_t row) { return i * batchSize + row; });
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  // There are 220 rows where c0 is null.
+  testSingleKey(vectors, "c0", 250);
+  testSingleKey(vectors, "c1", 10);
+  testTwoKeys(vectors, "c0", "c1", 250);
+}
+
 TEST_F(TopNTest, compaction) {
   vector_size_t batchSize = 1000;
   std::vector<RowVectorPtr> vectors;
@@ -1067,6 +1067,85 @@ TEST_P(UnnestTest, splitOutputNodeOverride) {
   }
 }
 
+TEST_P(UnnestTest, splitOutputByBytes) {
+  const vector_size_t numRows = 100;
+  const vector_size_t arraySize = 10;
+  const std::string value(1'000, 'x');
+  const auto vector = makeRowVector({
+      makeFlatVector<int64_t>(numRows, [](auto row) { return row; }),
+      makeArrayVector<StringView>(
+          numRows,
+          [&](auto /*row*/) { return arraySize; },
+          [&](auto /*row*/, auto /*index*/) { return StringView(value); }),
+  });
+  createDuckDbTable({vector});
+
+  core::PlanNodeId unnestPlanNodeId;
+  const auto plan = PlanBuilder()
+                        .values({vector})
+                        .unnest({"c0"}, {"c1"})
+                        .capturePlanNodeId(unnestPlanNodeId)
+                        .planNode();
+
+  const uint64_t preferredOutputBatchBytes = 64 << 10;
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(
+                      core::QueryConfig::kPreferredOutputBatchRows,
+                      std::to_string(batchSize_))
+                  .config(
+                      core::QueryConfig::kPreferredOutputBatchBytes,
+                      std::to_string(preferredOutputBatchBytes))
+                  .assertResults("SELECT c0, UNNEST(c1) FROM tmp");
+  const auto numOutputRows = numRows * arraySize;
+  const auto outputVectors =
+      exec::toPlanStats(task->taskStats()).at(unnestPlanNodeId).outputVectors;
+  ASSERT_GE(outputVectors, bits::divRoundUp(numOutputRows, batchSize_));
+  ASSERT_GE(
+      outputVectors,
+      bits::divRoundUp(
+          numOutputRows * value.size(), preferredOutputBatchBytes));
+}
+
+TEST_P(UnnestTest, outputEncodings) {
+  const auto vector = makeRowVector({
+      makeFlatVector<int64_t>({1, 2}),
+      makeArrayVector<int32_t>(
+          2,
+          [](auto /*row*/) { return 10; },
+          [](auto row, auto index) { return row * 10 + index; }),
+  });
+
+  CursorParameters params;
+  params.planNode =
+      PlanBuilder().values({vector}).unnest({"c0"}, {"c1"}).planNode();
+  params.queryConfigs[core::QueryConfig::kPreferredOutputBatchRows] = "4";
+  const auto results = readCursor(params).second;
+
+  // Each input row produces 10 output rows, so only the third batch of 4 rows
+  // spans both input rows.
+  ASSERT_EQ(results.size(), 5);
+  for (auto i = 0; i < results.size(); ++i) {
+    const auto& replicated = results[i]->childAt(0);
+    const auto& elements = results[i]->childAt(1);
+    ASSERT_EQ(
+        replicated->encoding(),
+        i == 2 ? VectorEncoding::Simple::DICTIONARY
+               : VectorEncoding::Simple::CONSTANT);
+    // The elements of consecutive input rows are contiguous and are sliced.
+    ASSERT_EQ(elements->encoding(), VectorEncoding::Simple::FLAT);
+  }
+
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row / 10 + 1; }),
+      makeFlatVector<int32_t>(20, [](auto row) { return row; }),
+  });
+  auto output = BaseVector::create<RowVector>(expected->type(), 0, pool());
+  for (const auto& result : results) {
+    output->append(result.get());
+  }
+  assertEqualVectors(expected, output);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     UnnestTest,
     UnnestTest,
@@ -201,6 +201,17 @@ TEST_F(VectorHasherTest, flat) {
     }
   }
 
+  // Flat vector without nulls, hashed and then mixed into existing hashes.
+  auto noNulls =
+      makeFlatVector<int64_t>(100, [](auto row) { return row * 3; });
+  hasher->decode(*noNulls, allRows_);
+  hasher->hash(allRows_, false, hashes);
+  hasher->hash(allRows_, true, hashes);
+  for (int32_t i = 0; i < 100; i++) {
+    const auto hash = folly::hasher<int64_t>()(i * 3);
+    EXPECT_EQ(hashes[i], bits::hashMix(hash, hash)) << "at " << i;
+  }
+
   // Test precompute methods for single null value.
   hasher->precompute(*vector);
   hasher->hashPrecomputed(allRows_, false, hashes);
@@ -448,6 +459,55 @@ TEST_F(VectorHasherTest, stringIds) {
   EXPECT_EQ(numInRange, rows.countSelected());
 }
 
+TEST_F(VectorHasherTest, stringIdRuns) {
+  // Runs of equal strings reuse the id of the previous row.
+  auto vector = makeFlatVector<std::string>(
+      1'000,
+      [](auto row) { return fmt::format("non-inline value {}", row / 5 % 7); },
+      nullEvery(11));
+  SelectivityVector rows(vector->size());
+  raw_vector<uint64_t> ids(vector->size());
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 1);
+  hasher->decode(*vector, rows);
+  EXPECT_FALSE(hasher->computeValueIds(rows, ids));
+  uint64_t asRange;
+  uint64_t asDistincts;
+  hasher->cardinality(0, asRange, asDistincts);
+  EXPECT_EQ(asDistincts, 8);
+
+  hasher->enableValueIds(1, 50);
+  hasher->decode(*vector, rows);
+  ASSERT_TRUE(hasher->computeValueIds(rows, ids));
+  std::unordered_map<std::string, uint64_t> valueIds;
+  for (auto i = 0; i < vector->size(); ++i) {
+    if (vector->isNullAt(i)) {
+      EXPECT_EQ(ids[i], 0);
+      continue;
+    }
+    const auto value = vector->valueAt(i).str();
+    auto it = valueIds.emplace(value, ids[i]).first;
+    EXPECT_EQ(it->second, ids[i]) << i;
+  }
+  EXPECT_EQ(valueIds.size(), 7);
+  std::unordered_set<uint64_t> distinctIds;
+  for (const auto& [value, id] : valueIds) {
+    EXPECT_NE(id, 0);
+    distinctIds.insert(id);
+  }
+  EXPECT_EQ(distinctIds.size(), 7);
+
+  // A new value in the middle of a run makes the ids fail and is analyzed.
+  auto withNew = makeFlatVector<std::string>(100, [](auto row) {
+    return row == 50 ? std::string("new non-inline value")
+                     : fmt::format("non-inline value {}", row / 5 % 7);
+  });
+  SelectivityVector newRows(withNew->size());
+  hasher->decode(*withNew, newRows);
+  EXPECT_FALSE(hasher->computeValueIds(newRows, ids));
+  hasher->cardinality(0, asRange, asDistincts);
+  EXPECT_EQ(asDistincts, 9);
+}
+
 // Tests distinct overflow, but starting with a small string
 TEST_F(VectorHasherTest, stringDistinctOverflow) {
   auto hasher = exec::VectorHasher::create(VARCHAR(), 1);
@@ -1413,6 +1473,44 @@ TEST_F(VectorHasherTest, stringFilterDistinctOverflow) {
   ASSERT_TRUE(filter == nullptr);
 }
 
+TEST_F(VectorHasherTest, maxDistinct) {
+  constexpr vector_size_t kNumRows = 10'000;
+  constexpr int kNumBatches = 15;
+  // 150,000 distinct values, above the default kMaxDistinct.
+  auto analyze = [&](VectorHasher& hasher) {
+    SelectivityVector rows(kNumRows);
+    raw_vector<uint64_t> ids(kNumRows);
+    for (auto batch = 0; batch < kNumBatches; ++batch) {
+      auto vector = makeFlatVector<int64_t>(kNumRows, [&](auto row) {
+        return (batch * kNumRows + row) * 1'000'003LL;
+      });
+      hasher.decode(*vector, rows);
+      hasher.computeValueIds(rows, ids);
+    }
+  };
+
+  uint64_t asRange;
+  uint64_t asDistincts;
+  VectorHasher defaultHasher(BIGINT(), 0);
+  analyze(defaultHasher);
+  ASSERT_EQ(defaultHasher.numUniqueValues(), 0);
+  defaultHasher.cardinality(0, asRange, asDistincts);
+  ASSERT_EQ(asDistincts, VectorHasher::kRangeTooLarge);
+
+  VectorHasher hasher(BIGINT(), 0);
+  hasher.setMaxDistinct(200'000);
+  ASSERT_EQ(hasher.maxDistinct(), 200'000);
+  analyze(hasher);
+  ASSERT_EQ(hasher.numUniqueValues(), kNumRows * kNumBatches);
+
+  hasher.cardinality(0, asRange, asDistincts);
+  ASSERT_EQ(asDistincts, kNumRows * kNumBatches + 1);
+  // The reservation is capped by the max distinct.
+  ASSERT_EQ(hasher.enableValueIds(1, VectorHasher::kNoLimit), 200'001);
+
+  VELOX_ASSERT_THROW(hasher.setMaxDistinct(300'000), "");
+}
+
 DEBUG_ONLY_TEST_F(VectorHasherTest, customComparisonNoValueIds) {
   // Test that custom comparison types cannot use value IDs for optimization.
   auto data = makeRowVector({makeNullableFlatVector<int64_t>(
@@ -503,6 +503,56 @@ TEST_F(WindowTest, prePartitionedSortBuildSkewed) {
           "SELECT *, row_number() over (partition by p order by s desc) FROM tmp ORDER BY s");
 }
 
+TEST_F(WindowTest, parallelEvaluation) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          // Partition key. Two partitions larger than an output batch followed
+          // by many partitions of 7 rows.
+          makeFlatVector<int32_t>(
+              size,
+              [](auto row) { return row < 3'000 ? row / 1'500 : row / 7; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::string windowFunctions =
+      "row_number() over (partition by p order by s), "
+      "rank() over (partition by p order by d), "
+      "sum(d) over (partition by p order by s "
+      "rows between 2 preceding and current row)";
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(
+                      {"row_number() over (partition by p order by s)",
+                       "rank() over (partition by p order by d)",
+                       "sum(d) over (partition by p order by s "
+                       "rows between 2 preceding and current row)"})
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+          .config(core::QueryConfig::kWindowParallelEvaluationBatches, "4")
+          .assertResults(
+              fmt::format("SELECT *, {} FROM tmp", windowFunctions));
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at(windowId);
+  ASSERT_GT(
+      stats.operatorStats.at("Window")
+          ->customStats[std::string(Window::kWindowParallelBatches)]
+          .sum,
+      0);
+}
+
 TEST_F(WindowTest, prePartitionedBuildWithSpill) {
   const vector_size_t size = 1'000;
   const int numPartitions = 37;
@@ -591,6 +641,62 @@ DEBUG_ONLY_TEST_F(WindowTest, aggregationWithNonDefaultFrame) {
   ASSERT_FALSE(isStreamCreated.load());
 }
 
+DEBUG_ONLY_TEST_F(WindowTest, boundedRowsFrameStreamingWindowBuild) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {makeFlatVector<int32_t>(size, [](auto row) { return row / 300; }),
+       makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(
+           size, [](auto row) { return row % 7 - 3; }, nullEvery(4))});
+
+  createDuckDbTable({data});
+
+  // sum and count retract the rows leaving the frame, min aggregates each
+  // frame.
+  const std::vector<std::string> kClauses = {
+      "sum(c2) over (partition by c0 order by c1 rows between 3 preceding and current row)",
+      "count(c2) over (partition by c0 order by c1 rows between 5 preceding and 2 preceding)",
+      "min(c2) over (partition by c0 order by c1 rows between 10 preceding and current row)",
+      "count(1) over (partition by c0 order by c1 rows between current row and current row)"};
+
+  auto plan = PlanBuilder()
+                  .values({split(data, 10)})
+                  .streamingWindow(kClauses)
+                  .planNode();
+
+  std::atomic_bool isStreamCreated{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::RowsStreamingWindowBuild::RowsStreamingWindowBuild",
+      std::function<void(RowsStreamingWindowBuild*)>(
+          [&](RowsStreamingWindowBuild* windowBuild) {
+            isStreamCreated.store(true);
+          }));
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+      .config(core::QueryConfig::kPreferredOutputBatchRows, "7")
+      .config(core::QueryConfig::kMaxOutputBatchRows, "7")
+      .assertResults(
+          "SELECT *, "
+          "sum(c2) over (partition by c0 order by c1 rows between 3 preceding and current row), "
+          "count(c2) over (partition by c0 order by c1 rows between 5 preceding and 2 preceding), "
+          "min(c2) over (partition by c0 order by c1 rows between 10 preceding and current row), "
+          "count(1) over (partition by c0 order by c1 rows between current row and current row) "
+          "FROM tmp");
+  ASSERT_TRUE(isStreamCreated.load());
+
+  core::WindowNode::Frame frame{
+      core::WindowNode::WindowType::kRows,
+      core::WindowNode::BoundType::kPreceding,
+      std::make_shared<core::ConstantTypedExpr>(BIGINT(), int64_t(100)),
+      core::WindowNode::BoundType::kCurrentRow,
+      nullptr};
+  ASSERT_EQ(RowsStreamingWindowBuild::numPrecedingRows(frame), 101);
+  frame.endType = core::WindowNode::BoundType::kFollowing;
+  frame.endValue = frame.startValue;
+  ASSERT_FALSE(RowsStreamingWindowBuild::numPrecedingRows(frame).has_value());
+}
+
 DEBUG_ONLY_TEST_F(WindowTest, nonRowsStreamingWindow) {
   auto data = makeRowVector(
       {"c1"},
@@ -16,6 +16,7 @@
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <atomic>
+#include "velox/common/Casts.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
@@ -62,8 +63,9 @@ class LocalExchangeSource : public exec::ExchangeSource {
     auto self = shared_from_this();
     // Since this lambda may outlive 'this', we need to capture a
     // shared_ptr to the current object (self).
+    // 'data' is std::vector<std::shared_ptr<SerializedPageBase>>.
     auto resultCallback = [self, requestedSequence, buffers, this](
-                              std::vector<std::unique_ptr<folly::IOBuf>> data,
+                              auto data,
                               int64_t sequence,
                               std::vector<int64_t> remainingBytes) {
       {
@@ -99,10 +101,16 @@ class LocalExchangeSource : public exec::ExchangeSource {
           // Keep looping, there could be extra end markers.
           continue;
         }
-        totalBytes += inputPage->length();
-        inputPage->unshare();
-        pages.push_back(
-            std::make_unique<PrestoSerializedPage>(std::move(inputPage)));
+        totalBytes += inputPage->size();
+        if (inputPage->vector() != nullptr) {
+          pages.push_back(
+              checkedPointerCast<VectorPage>(inputPage)->share());
+        } else {
+          auto iobuf = inputPage->getIOBuf();
+          iobuf->unshare();
+          pages.push_back(
+              std::make_unique<PrestoSerializedPage>(std::move(iobuf)));
+        }
         inputPage = nullptr;
       }
       numPages_ += pages.size();
@@ -155,7 +163,7 @@ class LocalExchangeSource : public exec::ExchangeSource {
 
     registerTimeout(self, resultCallback, maxWait);
 
-    buffers->getData(
+    buffers->getPages(
         remoteTaskId_, destination_, maxBytes, sequence_, resultCallback);
 
     return future;
@@ -228,10 +236,7 @@ class LocalExchangeSource : public exec::ExchangeSource {
   }
 
  private:
-  using ResultCallback = std::function<void(
-      std::vector<std::unique_ptr<folly::IOBuf>> data,
-      int64_t sequence,
-      std::vector<int64_t> remainingBytes)>;
+  using ResultCallback = PagesAvailableCallback;
 
   static void registerTimeout(
       const std::shared_ptr<ExchangeSource>& self,
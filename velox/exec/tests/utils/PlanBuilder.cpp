@@ -942,8 +942,7 @@ core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
       partialAggNode->ignoreNullKeys(),
       partialAggNode->noGroupsSpanBatches(),
       planNode_);
-  VELOX_CHECK_EQ(
-      aggregationNode->supportsBarrier(), aggregationNode->isPreGrouped());
+  VELOX_CHECK(aggregationNode->supportsBarrier());
   return aggregationNode;
 }
 
@@ -1148,8 +1147,7 @@ PlanBuilder& PlanBuilder::aggregation(
       ignoreNullKeys,
       /*noGroupsSpanBatches=*/false,
       planNode_);
-  VELOX_CHECK_EQ(
-      aggregationNode->supportsBarrier(), aggregationNode->isPreGrouped());
+  VELOX_CHECK(aggregationNode->supportsBarrier());
   planNode_ = std::move(aggregationNode);
   return *this;
 }
@@ -1173,8 +1171,7 @@ PlanBuilder& PlanBuilder::streamingAggregation(
       ignoreNullKeys,
       noGroupsSpanBatches,
       planNode_);
-  VELOX_CHECK_EQ(
-      aggregationNode->supportsBarrier(), aggregationNode->isPreGrouped());
+  VELOX_CHECK(aggregationNode->supportsBarrier());
   planNode_ = std::move(aggregationNode);
   return *this;
 }
@@ -2466,7 +2463,8 @@ PlanBuilder& PlanBuilder::streamingWindow(
 PlanBuilder& PlanBuilder::rowNumber(
     const std::vector<std::string>& partitionKeys,
     std::optional<int32_t> limit,
-    const bool generateRowNumber) {
+    const bool generateRowNumber,
+    const std::vector<std::string>& preGroupedKeys) {
   std::optional<std::string> rowNumberColumnName;
   if (generateRowNumber) {
     rowNumberColumnName = "row_number";
@@ -2476,11 +2474,19 @@ PlanBuilder& PlanBuilder::rowNumber(
       fields(partitionKeys),
       rowNumberColumnName,
       limit,
+      fields(preGroupedKeys),
       planNode_);
   VELOX_CHECK(!planNode_->supportsBarrier());
   return *this;
 }
 
+PlanBuilder& PlanBuilder::streamingRowNumber(
+    const std::vector<std::string>& partitionKeys,
+    std::optional<int32_t> limit,
+    bool generateRowNumber) {
+  return rowNumber(partitionKeys, limit, generateRowNumber, partitionKeys);
+}
+
 PlanBuilder& PlanBuilder::topNRank(
     std::string_view function,
     const std::vector<std::string>& partitionKeys,
@@ -2518,17 +2524,25 @@ PlanBuilder& PlanBuilder::topNRowNumber(
 
 PlanBuilder& PlanBuilder::markDistinct(
     std::string markerKey,
-    const std::vector<std::string>& distinctKeys) {
+    const std::vector<std::string>& distinctKeys,
+    const std::vector<std::string>& preGroupedKeys) {
   VELOX_CHECK_NOT_NULL(planNode_, "MarkDistinct cannot be the source node");
   planNode_ = std::make_shared<core::MarkDistinctNode>(
       nextPlanNodeId(),
       std::move(markerKey),
       fields(planNode_->outputType(), distinctKeys),
+      fields(planNode_->outputType(), preGroupedKeys),
       planNode_);
   VELOX_CHECK(!planNode_->supportsBarrier());
   return *this;
 }
 
+PlanBuilder& PlanBuilder::streamingMarkDistinct(
+    std::string markerKey,
+    const std::vector<std::string>& distinctKeys) {
+  return markDistinct(std::move(markerKey), distinctKeys, distinctKeys);
+}
+
 PlanBuilder& PlanBuilder::enforceDistinct(
     const std::vector<std::string>& distinctKeys,
     std::string errorMessage,
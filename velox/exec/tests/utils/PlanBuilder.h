@@ -1473,7 +1473,19 @@ class PlanBuilder {
 
   /// Add a RowNumberNode to compute single row_number window function with an
   /// optional limit and no sorting.
+  /// @param preGroupedKeys Optional subset of partitionKeys that input is
+  /// already clustered on. When equal to partitionKeys, uses the streaming
+  /// implementation.
   PlanBuilder& rowNumber(
+      const std::vector<std::string>& partitionKeys,
+      std::optional<int32_t> limit = std::nullopt,
+      bool generateRowNumber = true,
+      const std::vector<std::string>& preGroupedKeys = {});
+
+  /// Add a RowNumberNode over input clustered on 'partitionKeys'. Equivalent
+  /// to calling rowNumber with preGroupedKeys equal to partitionKeys, which
+  /// uses the streaming implementation.
+  PlanBuilder& streamingRowNumber(
       const std::vector<std::string>& partitionKeys,
       std::optional<int32_t> limit = std::nullopt,
       bool generateRowNumber = true);
@@ -1498,7 +1510,18 @@ class PlanBuilder {
   /// Add a MarkDistinctNode to compute aggregate mask channel
   /// @param markerKey Name of output mask channel
   /// @param distinctKeys List of columns to be marked distinct.
+  /// @param preGroupedKeys Optional subset of distinctKeys that input is
+  /// already clustered on. When equal to distinctKeys, uses the streaming
+  /// implementation.
   PlanBuilder& markDistinct(
+      std::string markerKey,
+      const std::vector<std::string>& distinctKeys,
+      const std::vector<std::string>& preGroupedKeys = {});
+
+  /// Add a MarkDistinctNode over input clustered on 'distinctKeys'.
+  /// Equivalent to calling markDistinct with preGroupedKeys equal to
+  /// distinctKeys, which uses the streaming implementation.
+  PlanBuilder& streamingMarkDistinct(
       std::string markerKey,
       const std::vector<std::string>& distinctKeys);
 
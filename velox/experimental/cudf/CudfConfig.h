@@ -41,6 +41,8 @@ struct CudfConfig {
   static constexpr const char* kCudfOutputMr{"cudf.output_mr"};
   static constexpr const char* kCudfAllowCpuFallback{"cudf.allow_cpu_fallback"};
   static constexpr const char* kCudfLogFallback{"cudf.log_fallback"};
+  static constexpr const char* kCudfAvoidIsolatedOperators{
+      "cudf.avoid_isolated_operators"};
   static constexpr const char* kCudfBatchSizeMinThreshold{
       "cudf.batch_size_min_threshold"};
   static constexpr const char* kCudfBatchSizeMaxThreshold{
@@ -107,6 +109,12 @@ struct CudfConfig {
   /// Whether to log a reason for falling back to Velox CPU execution.
   bool logFallback{true};
 
+  /// Whether to keep an operator on the CPU when it would run on the GPU
+  /// between two CPU operators. Such an operator needs a copy to the GPU
+  /// before it and a copy back after it, which often costs more than the
+  /// operator itself. Only applies if CPU fallback is allowed.
+  bool avoidIsolatedOperators{false};
+
   /// Whether to insert CudfBatchConcat operators before supported Cudf
   /// operators.
   /// This can improve performance by reducing the number of cuda kernel
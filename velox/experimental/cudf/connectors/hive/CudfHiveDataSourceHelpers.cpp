@@ -50,6 +50,31 @@ std::future<T> toStdFuture(folly::Future<T> follyFuture) {
 
   return stdFuture;
 }
+
+// Copies the 'size' bytes of 'input' to 'dst' on the device, one cache run
+// of 'input' at a time. 'input' may drop its cache pins once this returns:
+// the cache memory is pageable, so cudaMemcpyAsync has staged each run
+// before returning.
+void copyToDevice(
+    facebook::velox::dwio::common::SeekableInputStream& input,
+    uint8_t* dst,
+    uint64_t size,
+    rmm::cuda_stream_view stream) {
+  uint64_t copied = 0;
+  const void* data;
+  int32_t dataSize;
+  while (copied < size && input.Next(&data, &dataSize)) {
+    const auto copySize = std::min<uint64_t>(dataSize, size - copied);
+    CUDF_CUDA_TRY(cudaMemcpyAsync(
+        dst + copied,
+        data,
+        copySize,
+        cudaMemcpyHostToDevice,
+        stream.value()));
+    copied += copySize;
+  }
+  VELOX_CHECK_EQ(copied, size, "Short read of {}", input.getName());
+}
 } // namespace
 
 namespace facebook::velox::cudf_velox::connector::hive {
@@ -70,10 +95,7 @@ void BufferedInputDataSource::enqueueForDevice(
   std::shared_ptr sharedStream(std::move(inputStream));
   pendingDeviceLoads_.push_back(
       [dst, size, sharedStream](rmm::cuda_stream_view stream) {
-        std::vector<uint8_t> buffer(size);
-        sharedStream->readFully(reinterpret_cast<char*>(buffer.data()), size);
-        CUDF_CUDA_TRY(cudaMemcpyAsync(
-            dst, buffer.data(), size, cudaMemcpyHostToDevice, stream.value()));
+        copyToDevice(*sharedStream, dst, size, stream);
       });
 }
 
@@ -82,6 +104,25 @@ void BufferedInputDataSource::load(rmm::cuda_stream_view stream) {
   for (auto& deviceLoad : pendingDeviceLoads_) {
     deviceLoad(stream);
   }
+  pendingDeviceLoads_.clear();
+}
+
+std::vector<rmm::device_buffer> BufferedInputDataSource::fetchToDevice(
+    cudf::host_span<cudf::io::text::byte_range_info const> byteRanges,
+    rmm::cuda_stream_view stream,
+    rmm::device_async_resource_ref mr) {
+  std::vector<rmm::device_buffer> buffers;
+  buffers.reserve(byteRanges.size());
+  for (const auto& range : byteRanges) {
+    const auto size = static_cast<uint64_t>(range.size());
+    buffers.emplace_back(size, stream, mr);
+    if (size > 0) {
+      enqueueForDevice(
+          range.offset(), size, static_cast<uint8_t*>(buffers.back().data()));
+    }
+  }
+  load(stream);
+  return buffers;
 }
 
 std::unique_ptr<cudf::io::datasource::buffer>
@@ -129,14 +170,17 @@ std::future<size_t> BufferedInputDataSource::device_read_async(
   VELOX_CHECK(input_->executor() != nullptr, "IO executor is not initialized");
   auto future = folly::via(input_->executor())
                     .thenValue([this, offset, size, dst, stream](auto&&) {
-                      auto hostBuffer = this->host_read(offset, size);
-                      CUDF_CUDA_TRY(cudaMemcpyAsync(
-                          dst,
-                          hostBuffer->data(),
-                          hostBuffer->size(),
-                          cudaMemcpyHostToDevice,
-                          stream.value()));
-                      return hostBuffer->size();
+                      if (offset >= fileSize_) {
+                        return size_t{0};
+                      }
+                      const size_t readSize =
+                          std::min(size, fileSize_ - offset);
+                      auto input = input_->read(
+                          offset,
+                          readSize,
+                          velox::dwio::common::LogType::FILE);
+                      copyToDevice(*input, dst, readSize, stream);
+                      return readSize;
                     });
   return toStdFuture(std::move(future));
 }
@@ -179,7 +223,20 @@ fetchByteRangesAsync(
     cudf::host_span<cudf::io::text::byte_range_info const> byteRanges,
     rmm::cuda_stream_view stream,
     rmm::device_async_resource_ref mr) {
-  // Using libcudf utility but may have custom implementation in the future
+  if (auto* bufferedSource =
+          dynamic_cast<BufferedInputDataSource*>(dataSource.get())) {
+    auto buffers = bufferedSource->fetchToDevice(byteRanges, stream, mr);
+    std::vector<cudf::device_span<uint8_t const>> spans;
+    spans.reserve(buffers.size());
+    for (const auto& buffer : buffers) {
+      spans.emplace_back(
+          static_cast<uint8_t const*>(buffer.data()), buffer.size());
+    }
+    // The copies are issued on 'stream', which the reader uses too.
+    std::promise<void> done;
+    done.set_value();
+    return {std::move(buffers), std::move(spans), done.get_future()};
+  }
   return cudf::io::parquet::fetch_byte_ranges_to_device_async(
       *dataSource, byteRanges, stream, mr);
 }
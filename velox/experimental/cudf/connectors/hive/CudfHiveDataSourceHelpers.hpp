@@ -72,6 +72,16 @@ class BufferedInputDataSource : public cudf::io::datasource {
   // loads and copies to device.
   void load(rmm::cuda_stream_view stream);
 
+  // Fetches 'byteRanges' into one device buffer each. The ranges are enqueued
+  // together, so that BufferedInput coalesces them and serves them from the
+  // AsyncDataCache / SSD cache, and are copied to the device from the cache
+  // memory without an intermediate host buffer. The copies are ordered on
+  // 'stream'.
+  std::vector<rmm::device_buffer> fetchToDevice(
+      cudf::host_span<cudf::io::text::byte_range_info const> byteRanges,
+      rmm::cuda_stream_view stream,
+      rmm::device_async_resource_ref mr);
+
  private:
   void readContiguous(size_t offset, size_t size, uint8_t* dst);
 
@@ -119,6 +129,9 @@ std::unique_ptr<cudf::io::datasource::buffer> fetchPageIndexBytes(
 /**
  * @brief Fetches a list of byte ranges from a host buffer into device buffers
  *
+ * A BufferedInputDataSource fetches the ranges through the Velox cache, other
+ * data sources through libcudf.
+ *
  * @param dataSource Input datasource
  * @param byteRanges Byte ranges to fetch
  * @param stream CUDA stream
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/experimental/cudf/CudfNoDefaults.h"
+#include "velox/experimental/cudf/exec/CudfUnnest.h"
+#include "velox/experimental/cudf/exec/GpuResources.h"
+#include "velox/experimental/cudf/vector/CudfVector.h"
+
+#include <cudf/binaryop.hpp>
+#include <cudf/lists/explode.hpp>
+#include <cudf/scalar/scalar.hpp>
+
+namespace facebook::velox::cudf_velox {
+
+CudfUnnest::CudfUnnest(
+    int32_t operatorId,
+    exec::DriverCtx* driverCtx,
+    const std::shared_ptr<const core::UnnestNode>& unnestNode)
+    : Operator(
+          driverCtx,
+          unnestNode->outputType(),
+          operatorId,
+          unnestNode->id(),
+          "CudfUnnest"),
+      NvtxHelper(
+          nvtx3::rgb{0, 128, 128}, // Teal
+          operatorId,
+          fmt::format("[{}]", unnestNode->id())),
+      withOrdinality_{unnestNode->hasOrdinality()} {
+  VELOX_CHECK(canRun(*unnestNode), "Unsupported unnest: {}", unnestNode->id());
+  const auto& inputType = unnestNode->sources()[0]->outputType();
+  for (const auto& variable : unnestNode->replicateVariables()) {
+    inputChannels_.push_back(inputType->getChildIdx(variable->name()));
+  }
+  inputChannels_.push_back(
+      inputType->getChildIdx(unnestNode->unnestVariables()[0]->name()));
+}
+
+// static
+bool CudfUnnest::canRun(const core::UnnestNode& unnestNode) {
+  return unnestNode.unnestVariables().size() == 1 &&
+      unnestNode.unnestVariables()[0]->type()->kind() == TypeKind::ARRAY &&
+      !unnestNode.hasMarker();
+}
+
+void CudfUnnest::addInput(RowVectorPtr input) {
+  VELOX_NVTX_OPERATOR_FUNC_RANGE();
+  VELOX_CHECK_NULL(input_);
+  input_ = std::move(input);
+}
+
+RowVectorPtr CudfUnnest::getOutput() {
+  VELOX_NVTX_OPERATOR_FUNC_RANGE();
+  if (input_ == nullptr) {
+    return nullptr;
+  }
+
+  auto cudfInput = std::dynamic_pointer_cast<CudfVector>(input_);
+  VELOX_CHECK_NOT_NULL(cudfInput, "Input must be a CudfVector");
+  auto stream = cudfInput->stream();
+  auto mr = get_output_mr();
+  auto inputView = cudfInput->getTableView().select(
+      std::vector<cudf::size_type>(
+          inputChannels_.begin(), inputChannels_.end()));
+  const cudf::size_type unnestIndex = inputChannels_.size() - 1;
+
+  std::vector<std::unique_ptr<cudf::column>> columns;
+  if (withOrdinality_) {
+    // The columns are the replicated ones, the 0-based int32 position and the
+    // elements. Velox puts the 1-based BIGINT ordinality last.
+    columns = cudf::explode_position(inputView, unnestIndex, stream, mr)
+                  ->release();
+    auto position = std::move(columns[unnestIndex]);
+    columns.erase(columns.begin() + unnestIndex);
+    cudf::numeric_scalar<int64_t> one(1, true, stream, mr);
+    columns.push_back(cudf::binary_operation(
+        position->view(),
+        one,
+        cudf::binary_operator::ADD,
+        cudf::data_type{cudf::type_id::INT64},
+        stream,
+        mr));
+  } else {
+    columns = cudf::explode(inputView, unnestIndex, stream, mr)->release();
+  }
+  input_.reset();
+
+  const auto size = columns[0]->size();
+  if (size == 0) {
+    return nullptr;
+  }
+  return std::make_shared<CudfVector>(
+      pool(),
+      outputType_,
+      size,
+      std::make_unique<cudf::table>(std::move(columns)),
+      stream);
+}
+
+} // namespace facebook::velox::cudf_velox
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/cudf/exec/NvtxHelper.h"
+
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::cudf_velox {
+
+/// Unnests a single ARRAY column of a CudfVector on the GPU with
+/// cudf::explode, so that an unnest between cuDF operators does not send its
+/// input back to the host. Like the CPU Unnest, null and empty arrays produce
+/// no rows. Plans with a marker column, several unnest columns or a MAP
+/// column are left to the CPU Unnest, see canRun().
+class CudfUnnest : public exec::Operator, public NvtxHelper {
+ public:
+  CudfUnnest(
+      int32_t operatorId,
+      exec::DriverCtx* driverCtx,
+      const std::shared_ptr<const core::UnnestNode>& unnestNode);
+
+  /// Returns true if 'unnestNode' can be run by CudfUnnest.
+  static bool canRun(const core::UnnestNode& unnestNode);
+
+  bool needsInput() const override {
+    return input_ == nullptr;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  exec::BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return exec::BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+ private:
+  // Input channels of the replicated columns followed by the channel of the
+  // unnested column.
+  std::vector<column_index_t> inputChannels_;
+  const bool withOrdinality_;
+};
+
+} // namespace facebook::velox::cudf_velox
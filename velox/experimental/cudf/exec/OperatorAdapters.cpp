@@ -24,6 +24,7 @@
 #include "velox/experimental/cudf/exec/CudfLocalPartition.h"
 #include "velox/experimental/cudf/exec/CudfOrderBy.h"
 #include "velox/experimental/cudf/exec/CudfTopN.h"
+#include "velox/experimental/cudf/exec/CudfUnnest.h"
 #include "velox/experimental/cudf/exec/OperatorAdapters.h"
 #include "velox/experimental/cudf/exec/Utilities.h"
 #include "velox/experimental/cudf/expression/ExpressionEvaluator.h"
@@ -41,6 +42,7 @@
 #include "velox/exec/TableScan.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/TopN.h"
+#include "velox/exec/Unnest.h"
 #include "velox/exec/Values.h"
 
 namespace facebook::velox::cudf_velox {
@@ -617,6 +619,47 @@ class AssignUniqueIdAdapter : public OperatorAdapter {
   }
 };
 
+/// UnnestAdapter - Replaces with CudfUnnest
+class UnnestAdapter : public OperatorAdapter {
+ public:
+  UnnestAdapter() : OperatorAdapter("Unnest") {}
+
+  bool canHandle(const exec::Operator* op) const override {
+    return dynamic_cast<const exec::Unnest*>(op) != nullptr;
+  }
+
+  bool canRunOnGPU(
+      const exec::Operator* /*op*/,
+      const core::PlanNodePtr& planNode,
+      exec::DriverCtx* /*ctx*/) const override {
+    auto unnestPlanNode =
+        std::dynamic_pointer_cast<const core::UnnestNode>(planNode);
+    return unnestPlanNode != nullptr && CudfUnnest::canRun(*unnestPlanNode);
+  }
+
+  bool acceptsGpuInput() const override {
+    return true;
+  }
+
+  bool producesGpuOutput() const override {
+    return true;
+  }
+
+  std::vector<std::unique_ptr<exec::Operator>> createReplacements(
+      const exec::Operator* /*op*/,
+      const core::PlanNodePtr& planNode,
+      exec::DriverCtx* ctx,
+      int32_t operatorId) const override {
+    auto unnestPlanNode =
+        std::dynamic_pointer_cast<const core::UnnestNode>(planNode);
+
+    std::vector<std::unique_ptr<exec::Operator>> result;
+    result.push_back(
+        std::make_unique<CudfUnnest>(operatorId, ctx, unnestPlanNode));
+    return result;
+  }
+};
+
 /// ValuesAdapter - Keeps original operator
 class ValuesAdapter : public OperatorAdapter {
  public:
@@ -710,6 +753,7 @@ void registerAllOperatorAdapters() {
   registry.registerAdapter(std::make_unique<LocalPartitionAdapter>());
   registry.registerAdapter(std::make_unique<LocalExchangeAdapter>());
   registry.registerAdapter(std::make_unique<AssignUniqueIdAdapter>());
+  registry.registerAdapter(std::make_unique<UnnestAdapter>());
   registry.registerAdapter(std::make_unique<ValuesAdapter>());
   registry.registerAdapter(std::make_unique<CallbackSinkAdapter>());
 }
@@ -29,6 +29,7 @@
 #include "velox/experimental/cudf/expression/JitExpression.h"
 
 #include "folly/Conv.h"
+#include "folly/String.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Values.h"
@@ -122,6 +123,36 @@ bool CompileState::compile(bool allowCpuFallback) {
       opProps.begin(),
       getOperatorProperties);
 
+  const bool isOutputDriver = driverFactory_.outputDriver;
+  const auto numOperators = static_cast<int32_t>(operators.size());
+
+  // An operator that would run on the GPU between two CPU operators is kept
+  // on the CPU, unless the adapter has to replace it. A run of several GPU
+  // operators is assumed to pay for its two conversions.
+  std::vector<bool> keptOnCpu(numOperators, false);
+  if (allowCpuFallback && CudfConfig::getInstance().avoidIsolatedOperators) {
+    for (int32_t i = 1; i < numOperators; ++i) {
+      auto& props = opProps[i];
+      if (!props.canRunOnGPU || !props.adapter ||
+          props.adapter->keepOperator()) {
+        continue;
+      }
+      const bool previousIsCpu = !opProps[i - 1].producesGpuOutput;
+      const bool nextIsCpu = i < numOperators - 1
+          ? !opProps[i + 1].acceptsGpuInput
+          : isOutputDriver;
+      if (previousIsCpu && nextIsCpu) {
+        static_cast<OperatorAdapter::Properties&>(props) = {};
+        keptOnCpu[i] = true;
+      }
+    }
+  }
+
+  // The operators that force a conversion, for the summary logged at the end.
+  int32_t numFromVelox = 0;
+  int32_t numToVelox = 0;
+  std::vector<std::string> conversionCauses;
+
   int32_t operatorsOffset = 0;
   for (int32_t operatorIndex = 0; operatorIndex < operators.size();
        ++operatorIndex) {
@@ -152,6 +183,8 @@ bool CompileState::compile(bool allowCpuFallback) {
       replaceOp.push_back(
           std::make_unique<CudfFromVelox>(
               id, planNode->outputType(), ctx, planNode->id() + "-from-velox"));
+      ++numFromVelox;
+      conversionCauses.push_back(operators[operatorIndex - 1]->operatorType());
     }
     if (not replaceOp.empty()) {
       // from-velox only, because need to inserted before current operator.
@@ -206,6 +239,10 @@ bool CompileState::compile(bool allowCpuFallback) {
       replaceOp.push_back(
           std::make_unique<CudfToVelox>(
               id, planNode->outputType(), ctx, planNode->id() + "-to-velox"));
+      ++numToVelox;
+      conversionCauses.push_back(
+          nextOperatorIsNotGpu ? operators[operatorIndex + 1]->operatorType()
+                               : "task output");
     }
 
     if (debugEnabled) {
@@ -228,7 +265,7 @@ bool CompileState::compile(bool allowCpuFallback) {
       // GPU compatible. or if specific CPU operator is allowed even when
       // fallback is disabled.
       VELOX_CHECK(!isPureCpuOperator, "Replacement with cuDF operator failed");
-    } else if (isPureCpuOperator) {
+    } else if (isPureCpuOperator && !keptOnCpu[operatorIndex]) {
       LOG(WARNING)
           << "Replacement with cuDF operator failed. Falling back to CPU execution";
       LOG(WARNING) << "Replacement Failed Operator: " << oper->toString();
@@ -249,6 +286,12 @@ bool CompileState::compile(bool allowCpuFallback) {
     }
   }
 
+  if (debugEnabled || (numFromVelox + numToVelox > 0 && VLOG_IS_ON(1))) {
+    LOG(INFO) << "cuDF conversions of driver " << driver_.driverCtx()->driverId
+              << ": " << numFromVelox << " to GPU, " << numToVelox
+              << " to CPU, at " << folly::join(", ", conversionCauses);
+  }
+
   if (debugEnabled) {
     // Print before/after together for easy comparison.
     LOG(INFO) << "Operators " << "before adapting for cuDF"
@@ -410,6 +453,10 @@ void CudfConfig::initialize(
   if (config.find(kCudfLogFallback) != config.end()) {
     logFallback = folly::to<bool>(config[kCudfLogFallback]);
   }
+  if (config.find(kCudfAvoidIsolatedOperators) != config.end()) {
+    avoidIsolatedOperators =
+        folly::to<bool>(config[kCudfAvoidIsolatedOperators]);
+  }
   if (config.find(kCudfTopNBatchSize) != config.end()) {
     topNBatchSize = folly::to<int32_t>(config[kCudfTopNBatchSize]);
   }
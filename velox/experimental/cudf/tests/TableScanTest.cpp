@@ -349,6 +349,37 @@ TEST_F(TableScanTest, allColumnsUsingExperimentalReader) {
   }
 }
 
+TEST_F(TableScanTest, experimentalReaderColumnSubsetUsingBufferedInput) {
+  // The experimental reader fetches the column chunks of the projected
+  // columns through the buffered input data source. The chunks of the
+  // columns in between are skipped, so the byte ranges are not contiguous.
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors, "c");
+  createDuckDbTable(vectors);
+
+  auto config = std::unordered_map<std::string, std::string>{
+      {facebook::velox::cudf_velox::connector::hive::CudfHiveConfig::
+           kUseExperimentalCudfReader,
+       "true"},
+      {facebook::velox::cudf_velox::connector::hive::CudfHiveConfig::
+           kUseBufferedInput,
+       "true"}};
+  resetCudfHiveConnector(
+      std::make_shared<config::ConfigBase>(std::move(config)));
+
+  auto plan = tableScanNode(ROW({"c1", "c4"}, {VARCHAR(), BIGINT()}));
+  // The second scan of the file reads the same ranges again.
+  for (auto i = 0; i < 2; ++i) {
+    SCOPED_TRACE(fmt::format("scan {}", i));
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .plan(plan)
+        .splits(makeCudfHiveConnectorSplits({filePath, filePath}))
+        .assertResults(
+            "SELECT c1, c4 FROM tmp UNION ALL SELECT c1, c4 FROM tmp");
+  }
+}
+
 TEST_F(TableScanTest, directBufferInputRawInputBytes) {
   constexpr int kSize = 10;
   auto vector = makeRowVector({
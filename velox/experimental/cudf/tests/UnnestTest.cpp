@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/experimental/cudf/CudfConfig.h"
+#include "velox/experimental/cudf/exec/ToCudf.h"
+
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::cudf_velox;
+
+class CudfUnnestTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    cudf_velox::registerCudf();
+  }
+
+  void TearDown() override {
+    CudfConfig::getInstance().avoidIsolatedOperators = false;
+    cudf_velox::unregisterCudf();
+    OperatorTestBase::TearDown();
+  }
+
+  RowVectorPtr makeInput() {
+    return makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+        makeArrayVector<int32_t>(
+            100,
+            [](auto row) { return row % 5; },
+            [](auto row, auto index) { return index * (row % 3); },
+            nullEvery(7)),
+    });
+  }
+
+  // Returns true if 'nodeId' of 'task' ran as 'operatorType'.
+  static bool ranAs(
+      const std::shared_ptr<Task>& task,
+      const core::PlanNodeId& nodeId,
+      const std::string& operatorType) {
+    auto planStats = toPlanStats(task->taskStats());
+    auto it = planStats.find(nodeId);
+    return it != planStats.end() &&
+        it->second.operatorStats.count(operatorType) > 0;
+  }
+};
+
+TEST_F(CudfUnnestTest, array) {
+  auto input = makeInput();
+  createDuckDbTable({input});
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({input})
+                  .unnest({"c0"}, {"c1"})
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+  auto task = assertQuery(plan, "SELECT c0, UNNEST(c1) FROM tmp");
+  EXPECT_TRUE(ranAs(task, unnestId, "CudfUnnest"));
+}
+
+TEST_F(CudfUnnestTest, ordinality) {
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4}),
+      makeNullableArrayVector<int32_t>(
+          {{{10, 20}}, {{}}, std::nullopt, {{30, std::nullopt, 40}}}),
+  });
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({1, 1, 4, 4, 4}),
+      makeNullableFlatVector<int32_t>({10, 20, 30, std::nullopt, 40}),
+      makeFlatVector<int64_t>({1, 2, 1, 2, 3}),
+  });
+
+  auto plan = PlanBuilder()
+                  .values({input})
+                  .unnest({"c0"}, {"c1"}, "ordinal")
+                  .planNode();
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+TEST_F(CudfUnnestTest, avoidIsolatedOperators) {
+  auto input = makeInput();
+  createDuckDbTable({input});
+
+  // Between the CPU Values and the task output, the unnest stays on the CPU.
+  CudfConfig::getInstance().avoidIsolatedOperators = true;
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({input})
+                  .unnest({"c0"}, {"c1"})
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+  auto task = assertQuery(plan, "SELECT c0, UNNEST(c1) FROM tmp");
+  EXPECT_TRUE(ranAs(task, unnestId, "Unnest"));
+  EXPECT_FALSE(ranAs(task, unnestId, "CudfUnnest"));
+}
@@ -861,7 +861,11 @@ void CompileState::planSegment(
 
       markOutputStored(candidate, segment);
       // If the source should be a standalone kernel, like Values or
-      // TableScan and there is more to plan, add a kernel boundary.
+      // TableScan and there is more to plan, add a kernel boundary. The
+      // filters, projections and aggregation after the source are fused into
+      // the kernels that follow. A TableScan decodes with the GpuDecoder
+      // kernels of its ReadStreams, so the decoded columns are in device
+      // memory before the first generated kernel reads them.
       if (needNewKernel && segmentIdx < segments_.size() - 1) {
         newKernel(candidate);
       }
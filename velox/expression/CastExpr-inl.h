@@ -209,13 +209,37 @@ void CastExpr::applyCastKernel(
         if constexpr (TPolicy::throwOnUnicode) {
           if (!functions::stringCore::isAscii(
                   inputRowValue.data(), inputRowValue.size())) {
-            VELOX_USER_FAIL(
+            setError(
                 "Unicode characters are not supported for conversion to integer types");
+            return;
           }
         }
       }
     }
 
+    if constexpr (
+        ToKind == TypeKind::VARCHAR &&
+        (FromKind == TypeKind::TINYINT || FromKind == TypeKind::SMALLINT ||
+         FromKind == TypeKind::INTEGER || FromKind == TypeKind::BIGINT)) {
+      // Write the digits straight into the result buffer. This gives the same
+      // text as folly::to<std::string> without a temporary string per row.
+      const int64_t value = inputRowValue;
+      char buffer[20];
+      char* digits = buffer;
+      if (value < 0) {
+        *digits++ = '-';
+      }
+      const uint64_t magnitude =
+          value < 0 ? 0 - static_cast<uint64_t>(value) : value;
+      const auto size = (digits - buffer) +
+          folly::uint64ToBufferUnsafe(magnitude, digits);
+      auto writer = exec::StringWriter(result, row);
+      writer.resize(size);
+      std::memcpy(writer.data(), buffer, size);
+      writer.finalize();
+      return;
+    }
+
     const auto castResult =
         util::Converter<ToKind, void, TPolicy>::tryCast(inputRowValue);
     if (castResult.hasError()) {
@@ -179,6 +179,17 @@ void ConjunctExpr::evalSpecialForm(
 }
 
 void ConjunctExpr::maybeReorderInputs() {
+  if (++numEvaluations_ == kDecayInterval) {
+    numEvaluations_ = 0;
+    for (auto i = 0; i < selectivity_.size(); ++i) {
+      if (selectivity_[i].numIn() == numInAtDecay_[i]) {
+        selectivity_[i] = SelectivityInfo();
+      } else {
+        selectivity_[i].decay();
+      }
+      numInAtDecay_[i] = selectivity_[i].numIn();
+    }
+  }
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
     if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
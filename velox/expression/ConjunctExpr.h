@@ -38,6 +38,7 @@ class ConjunctExpr : public SpecialForm {
             false /* trackCpuUsage */),
         isAnd_(isAnd) {
     selectivity_.resize(inputs_.size());
+    numInAtDecay_.resize(inputs_.size());
     inputOrder_.resize(inputs_.size());
     std::iota(inputOrder_.begin(), inputOrder_.end(), 0);
 
@@ -62,6 +63,13 @@ class ConjunctExpr : public SpecialForm {
     return true;
   }
 
+  /// Number of evaluations after which the selectivity and time of the inputs
+  /// decay, so that the order of the inputs follows changes in the data. The
+  /// statistics of an input that was not evaluated in this time, because the
+  /// inputs before it dropped all rows, are cleared, so that it is evaluated
+  /// first once to sample it again.
+  static constexpr int32_t kDecayInterval = 64;
+
   const SelectivityInfo& selectivityAt(int32_t index) {
     return selectivity_[inputOrder_[index]];
   }
@@ -104,6 +112,10 @@ class ConjunctExpr : public SpecialForm {
   bool reorderEnabled_;
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  // Evaluations since the last decay of 'selectivity_'.
+  int32_t numEvaluations_{0};
+  // numIn() of 'selectivity_' after the last decay.
+  std::vector<uint64_t> numInAtDecay_;
 
   friend class ConjunctCallToSpecialForm;
 };
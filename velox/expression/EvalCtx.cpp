@@ -58,6 +58,45 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
   inputFlatNoNulls_ = false;
 }
 
+EvalCtx::VectorIndexEntry& EvalCtx::lookupVectorIndex(
+    const BaseVector* vector,
+    const VectorPtr& holder) {
+  if (vectorIndexes_ == nullptr) {
+    vectorIndexes_ = std::make_unique<
+        folly::F14FastMap<const BaseVector*, VectorIndexEntry>>();
+  }
+  auto& entry = (*vectorIndexes_)[vector];
+  if (entry.holder == nullptr) {
+    entry.holder = holder;
+  }
+  ++entry.numLookups;
+  return entry;
+}
+
+std::shared_ptr<DecodedVector> EvalCtx::sharedDecodedVector(
+    const VectorPtr& vector,
+    const SelectivityVector& rows) {
+  if (vector->encoding() != VectorEncoding::Simple::DICTIONARY ||
+      vector->valueVector()->encoding() !=
+          VectorEncoding::Simple::DICTIONARY) {
+    return nullptr;
+  }
+  if (decodedVectors_ == nullptr) {
+    decodedVectors_ = std::make_unique<
+        folly::F14FastMap<const BaseVector*, SharedDecodedVector>>();
+  }
+  auto& entry = (*decodedVectors_)[vector.get()];
+  if (entry.decoded != nullptr && rows.isSubset(entry.rows)) {
+    return entry.decoded;
+  }
+  // Decodes again over 'rows' alone. The callers of the previous decoding
+  // still hold it.
+  entry.holder = vector;
+  entry.rows = rows;
+  entry.decoded = std::make_shared<DecodedVector>(*vector, rows);
+  return entry.decoded;
+}
+
 void EvalCtx::saveAndReset(ContextSaver& saver, const SelectivityVector& rows) {
   if (saver.context) {
     return;
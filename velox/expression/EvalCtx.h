@@ -20,6 +20,8 @@
 #include <functional>
 #include <memory>
 
+#include <folly/container/F14Map.h>
+
 #include "velox/common/base/Portability.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/vector/ComplexVector.h"
@@ -33,6 +35,14 @@ class LocalSelectivityVector;
 struct ContextSaver;
 class PeeledEncoding;
 
+/// State that a function builds over an input vector for the other calls over
+/// the same vector in one evaluation, e.g. a hash table of the keys of a map
+/// vector that several subscripts look up.
+class VectorIndex {
+ public:
+  virtual ~VectorIndex() = default;
+};
+
 /// Tracks per-row errors that occurred during expression evaluation.
 /// Used when EvalCtx::throwOnError() is false.
 class EvalErrors {
@@ -561,6 +571,31 @@ class EvalCtx {
     return execCtx_->optimizationParams().deferredLazyLoadingEnabled;
   }
 
+  /// The index of a vector shared by the calls over the vector in this
+  /// evaluation.
+  struct VectorIndexEntry {
+    // Keeps the vector alive, so that its address is not reused.
+    VectorPtr holder;
+    // The number of lookups of the entry, including the current one.
+    int32_t numLookups{0};
+    std::shared_ptr<VectorIndex> index;
+  };
+
+  /// Returns the entry of 'vector', which 'holder' keeps alive, e.g. 'holder'
+  /// is a dictionary over 'vector'. The caller sets the index.
+  VectorIndexEntry& lookupVectorIndex(
+      const BaseVector* vector,
+      const VectorPtr& holder);
+
+  /// Returns the decoding of 'vector' over 'rows' shared by the other
+  /// decodings of 'vector' over the same or fewer rows in this evaluation.
+  /// Returns nullptr if 'vector' is not a dictionary over another dictionary,
+  /// as other vectors decode without combining indices. The caller must not
+  /// change the decoding.
+  std::shared_ptr<DecodedVector> sharedDecodedVector(
+      const VectorPtr& vector,
+      const SelectivityVector& rows);
+
  private:
   void ensureErrorsVectorSize(EvalErrorsPtr& errors, vector_size_t size) const;
 
@@ -610,6 +645,22 @@ class EvalCtx {
   // If 'captureErrorDetails()' is false, stores flags indicating which rows had
   // errors without storing actual exceptions.
   EvalErrorsPtr errors_;
+
+  // The entries of lookupVectorIndex(). Allocated on first use.
+  std::unique_ptr<folly::F14FastMap<const BaseVector*, VectorIndexEntry>>
+      vectorIndexes_;
+
+  struct SharedDecodedVector {
+    // Keeps the vector alive, so that its address is not reused.
+    VectorPtr holder;
+    // The rows 'decoded' is valid for.
+    SelectivityVector rows;
+    std::shared_ptr<DecodedVector> decoded;
+  };
+
+  // The entries of sharedDecodedVector(). Allocated on first use.
+  std::unique_ptr<folly::F14FastMap<const BaseVector*, SharedDecodedVector>>
+      decodedVectors_;
 };
 
 /// Utility wrapper struct that is used to temporarily reset the value of the
@@ -799,12 +850,32 @@ class LocalDecodedVector {
     get()->decode(vector, rows, loadLazy);
   }
 
+  /// Like the above, but takes the decoding of a dictionary over another
+  /// dictionary from EvalCtx::sharedDecodedVector(), so that the calls over
+  /// the same input in one evaluation combine its indices once.
+  LocalDecodedVector(
+      EvalCtx& context,
+      const VectorPtr& vector,
+      const SelectivityVector& rows)
+      : context_(context.execCtx()),
+        shared_(context.sharedDecodedVector(vector, rows)) {
+    if (!shared_) {
+      get()->decode(*vector, rows);
+    }
+  }
+
   LocalDecodedVector(LocalDecodedVector&& other) noexcept
-      : context_{other.context_}, vector_{std::move(other.vector_)} {}
+      : context_{other.context_},
+        vector_{std::move(other.vector_)},
+        shared_{std::move(other.shared_)} {}
 
   void operator=(LocalDecodedVector&& other) noexcept {
+    if (vector_ && context_) {
+      context_->releaseDecodedVector(std::move(vector_));
+    }
     context_ = other.context_;
     vector_ = std::move(other.vector_);
+    shared_ = std::move(other.shared_);
   }
 
   ~LocalDecodedVector() {
@@ -814,6 +885,9 @@ class LocalDecodedVector {
   }
 
   DecodedVector* get() {
+    if (shared_) {
+      return shared_.get();
+    }
     if (!vector_) {
       vector_ = context_ ? context_->getDecodedVector()
                          : std::make_unique<DecodedVector>();
@@ -823,28 +897,34 @@ class LocalDecodedVector {
 
   // Must either use the constructor that provides data or call get() first.
   DecodedVector& operator*() {
-    VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
-    return *vector_;
+    return *decoded();
   }
 
   const DecodedVector& operator*() const {
-    VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
-    return *vector_;
+    return *decoded();
   }
 
   DecodedVector* operator->() {
-    VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
-    return vector_.get();
+    return decoded();
   }
 
   const DecodedVector* operator->() const {
+    return decoded();
+  }
+
+ private:
+  DecodedVector* decoded() const {
+    if (shared_) {
+      return shared_.get();
+    }
     VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
     return vector_.get();
   }
 
- private:
   core::ExecCtx* context_;
   std::unique_ptr<DecodedVector> vector_;
+  // Set instead of 'vector_' if the decoding is shared with other calls.
+  std::shared_ptr<DecodedVector> shared_;
 };
 
 /// Utility class used to activate final selection (setting isFinalSelection to
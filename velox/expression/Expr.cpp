@@ -1345,6 +1345,132 @@ void Expr::evalWithMemo(
   context.releaseVector(base);
 }
 
+bool Expr::enableValueCache(int32_t maxEntries) {
+  VELOX_CHECK_GT(maxEntries, 0);
+  if (valueCache_ != nullptr) {
+    return true;
+  }
+  if (!deterministic_ || distinctFields_.size() != 1 ||
+      is<FieldReference>() || !type()->isPrimitiveType()) {
+    return false;
+  }
+  const auto fieldKind = distinctFields_[0]->type()->kind();
+  if (fieldKind != TypeKind::VARCHAR && fieldKind != TypeKind::VARBINARY) {
+    return false;
+  }
+  valueCache_ = std::make_unique<ValueCache>(maxEntries);
+  valueCache_->windowStartLookups = stats_.numValueCacheLookups;
+  valueCache_->windowStartHits = stats_.numValueCacheHits;
+  return true;
+}
+
+// Keeps the results of expensive functions of low cardinality strings
+// across batches, e.g. regexp_extract() over the values of a log column.
+// Unlike evalWithMemo(), the inputs need not be dictionaries over the same
+// base. The cache is only filled until it has 'maxEntries' and is disabled if
+// less than half of the lookups are hits, so that it costs no more than a
+// lookup per row if the values do not repeat.
+void Expr::evalWithValueCache(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  auto& cache = *valueCache_;
+  VectorPtr input;
+  distinctFields_[0]->evalSpecialForm(rows, context, input);
+  LocalDecodedVector decodedHolder(context, *input, rows);
+  const auto* decoded = decodedHolder.get();
+
+  auto valueAt = [&](vector_size_t row) {
+    const auto value = decoded->valueAt<StringView>(row);
+    return std::string_view(value.data(), value.size());
+  };
+
+  LocalSelectivityVector uncachedHolder(context, rows);
+  auto* uncached = uncachedHolder.get();
+  std::vector<BaseVector::CopyRange> hits;
+  if (!cache.rows.empty()) {
+    rows.applyToSelected([&](auto row) {
+      if (decoded->isNullAt(row)) {
+        return;
+      }
+      auto it = cache.rows.find(valueAt(row));
+      if (it != cache.rows.end()) {
+        hits.push_back({it->second, row, 1});
+        uncached->setValid(row, false);
+      }
+    });
+    uncached->updateBounds();
+  }
+  stats_.numValueCacheLookups += rows.countSelected();
+  stats_.numValueCacheHits += hits.size();
+
+  if (!hits.empty()) {
+    context.ensureWritable(rows, type(), result);
+    result->copyRanges(cache.results.get(), hits);
+  }
+
+  if (uncached->hasSelections()) {
+    // Fix finalSelection at "rows" to keep the cached results copied into
+    // "result".
+    ScopedFinalSelectionSetter scopedFinalSelectionSetter(
+        context, &rows, !hits.empty());
+    evalAllImpl(*uncached, context, result);
+    context.deselectErrors(*uncached);
+
+    if (cache.rows.size() < cache.maxEntries && uncached->hasSelections()) {
+      if (cache.results == nullptr) {
+        cache.results =
+            BaseVector::create(type(), cache.maxEntries, context.pool());
+      }
+      // Copies the strings of a string result, so that 'results' does not
+      // keep the string buffers of 'result' alive.
+      const bool isString = type()->kind() == TypeKind::VARCHAR ||
+          type()->kind() == TypeKind::VARBINARY;
+      LocalDecodedVector decodedResult(context);
+      if (isString) {
+        decodedResult.get()->decode(*result, *uncached);
+      }
+      std::vector<BaseVector::CopyRange> inserts;
+      uncached->testSelected([&](auto row) {
+        if (decoded->isNullAt(row)) {
+          return true;
+        }
+        const auto value = valueAt(row);
+        if (cache.rows.contains(value)) {
+          return true;
+        }
+        const vector_size_t index = cache.rows.size();
+        cache.rows.emplace(std::string(value), index);
+        if (!isString) {
+          inserts.push_back({row, index, 1});
+        } else if (decodedResult->isNullAt(row)) {
+          cache.results->setNull(index, true);
+        } else {
+          cache.results->asUnchecked<FlatVector<StringView>>()->set(
+              index, decodedResult->valueAt<StringView>(row));
+        }
+        return cache.rows.size() < cache.maxEntries;
+      });
+      if (!inserts.empty()) {
+        cache.results->copyRanges(result.get(), inserts);
+      }
+    }
+  }
+  context.releaseVector(input);
+
+  const auto numLookups =
+      stats_.numValueCacheLookups - cache.windowStartLookups;
+  if (numLookups >= kValueCacheWindow) {
+    const auto numHits = stats_.numValueCacheHits - cache.windowStartHits;
+    if (2 * numHits < numLookups) {
+      valueCache_.reset();
+      return;
+    }
+    cache.windowStartLookups = stats_.numValueCacheLookups;
+    cache.windowStartHits = stats_.numValueCacheHits;
+  }
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1459,6 +1585,8 @@ void Expr::evalAll(
         [&](const SelectivityVector& rows,
             EvalCtx& context,
             VectorPtr& result) { evalAllImpl(rows, context, result); });
+  } else if (valueCache_ != nullptr) {
+    evalWithValueCache(rows, context, result);
   } else {
     evalAllImpl(rows, context, result);
   }
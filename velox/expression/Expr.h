@@ -243,6 +243,9 @@ class Expr {
   virtual void clearCache() {
     sharedSubexprResults_.clear();
     clearMemo();
+    if (valueCache_ != nullptr) {
+      valueCache_->clear();
+    }
     for (auto& input : inputs_) {
       input->clearCache();
     }
@@ -320,6 +323,24 @@ class Expr {
     return deterministic_;
   }
 
+  /// Enables caching the results of 'this' by the value of its input column
+  /// across batches. Pays off for expensive functions, e.g. regular
+  /// expressions or JSON and URL parsing, on columns with few distinct values.
+  /// 'this' is eligible if it is deterministic, depends on a single VARCHAR or
+  /// VARBINARY column and has a primitive result type. At most 'maxEntries'
+  /// values are cached. The cache disables itself if the hit rate in
+  /// 'stats()' is low. Returns false and does nothing if 'this' is not
+  /// eligible.
+  bool enableValueCache(int32_t maxEntries);
+
+  bool hasValueCache() const {
+    return valueCache_ != nullptr;
+  }
+
+  /// Number of lookups into the value cache after which the cache is disabled
+  /// if less than half of them are hits.
+  static constexpr uint64_t kValueCacheWindow = 8'192;
+
   virtual bool isConstantExpr() const;
 
   bool supportsFlatNoNullsFastPath() const {
@@ -480,6 +501,14 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Copies the results for the values of 'rows' that are in 'valueCache_' and
+  // evaluates the other rows. Adds the values of the rows evaluated without
+  // errors to 'valueCache_' while it has space.
+  void evalWithValueCache(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
   void
   evalAll(const SelectivityVector& rows, EvalCtx& context, VectorPtr& result);
 
@@ -707,6 +736,33 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // Results of 'this' by the value of the single input column. Unlike
+  // 'dictionaryCache_', it does not depend on the identity of the input
+  // vectors and is kept across batches.
+  struct ValueCache {
+    explicit ValueCache(int32_t _maxEntries) : maxEntries(_maxEntries) {}
+
+    void clear() {
+      rows.clear();
+      results.reset();
+    }
+
+    const int32_t maxEntries;
+
+    // Maps an input value to the row of its result in 'results'.
+    folly::F14FastMap<std::string, vector_size_t> rows;
+
+    // Flat vector of 'maxEntries' rows.
+    VectorPtr results;
+
+    // The lookups and hits in 'stats_' at the start of the current window.
+    uint64_t windowStartLookups{0};
+    uint64_t windowStartHits{0};
+  };
+
+  // Set by enableValueCache(). Reset if the hit rate is too low.
+  std::unique_ptr<ValueCache> valueCache_;
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -21,6 +21,7 @@
 #include "velox/expression/ExprRewriteRegistry.h"
 #include "velox/expression/ExprUtils.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -66,6 +67,9 @@ struct CompilerCtx {
   /// Whether to enable constant folding.
   bool enableConstantFolding;
 
+  /// Whether to compile trees of arithmetic and comparisons into FusedExpr.
+  bool fuseArithmetic;
+
   /// Names of simple or vector functions within the expression tree being
   /// compiled that support flattening.
   std::unordered_set<std::string> flatteningCandidates;
@@ -384,6 +388,115 @@ ExprPtr compileCast(
       trackCpuUsage);
 }
 
+// Returns true if 'expr' is an arithmetic function or a comparison over inputs
+// of 'inputType' that FusedExpr can evaluate with its inputs. Only the root
+// may be a comparison. Adds the number of functions to 'numOps'.
+bool isFusable(
+    const TypedExprPtr& expr,
+    const TypePtr& inputType,
+    bool isRoot,
+    int32_t& numOps) {
+  if (expr->isFieldAccessKind()) {
+    return expr->asUnchecked<core::FieldAccessTypedExpr>()->isInputColumn() &&
+        expr->type()->equivalent(*inputType);
+  }
+  if (expr->isConstantKind()) {
+    return !expr->asUnchecked<core::ConstantTypedExpr>()->isNull() &&
+        expr->type()->equivalent(*inputType);
+  }
+  if (!expr->isCallKind() || expr->inputs().size() != 2) {
+    return false;
+  }
+  const auto op =
+      FusedExpr::toOp(expr->asUnchecked<core::CallTypedExpr>()->name());
+  if (!op.has_value()) {
+    return false;
+  }
+  if (FusedExpr::isComparison(op.value())
+          ? !isRoot || !expr->type()->isBoolean()
+          : !expr->type()->equivalent(*inputType)) {
+    return false;
+  }
+  ++numOps;
+  for (const auto& input : expr->inputs()) {
+    if (!isFusable(input, inputType, false, numOps)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compiles 'expr' into instructions of 'program' and returns the operand for
+// its result. The field references and constants go into 'inputs'.
+int32_t compileFusedOperand(
+    const TypedExprPtr& expr,
+    Scope* scope,
+    const CompilerCtx& ctx,
+    std::vector<ExprPtr>& inputs,
+    std::vector<FusedExpr::Instruction>& program) {
+  if (!expr->isCallKind()) {
+    auto input = compileExpression(expr, scope, ctx);
+    auto it = std::find(inputs.begin(), inputs.end(), input);
+    if (it != inputs.end()) {
+      return it - inputs.begin();
+    }
+    inputs.push_back(std::move(input));
+    return inputs.size() - 1;
+  }
+  const auto left =
+      compileFusedOperand(expr->inputs()[0], scope, ctx, inputs, program);
+  const auto right =
+      compileFusedOperand(expr->inputs()[1], scope, ctx, inputs, program);
+  program.push_back(
+      {FusedExpr::toOp(expr->asUnchecked<core::CallTypedExpr>()->name())
+           .value(),
+       left,
+       right});
+  return -static_cast<int32_t>(program.size());
+}
+
+ExprPtr compileRewrittenExpression(
+    const TypedExprPtr& expr,
+    Scope* scope,
+    const CompilerCtx& ctx);
+
+// Returns a FusedExpr for 'expr' if it is a tree of at least 2 functions that
+// FusedExpr can evaluate, otherwise nullptr.
+ExprPtr tryCompileFused(
+    const TypedExprPtr& expr,
+    Scope* scope,
+    const CompilerCtx& ctx) {
+  if (!expr->isCallKind() || expr->inputs().size() != 2) {
+    return nullptr;
+  }
+  const auto op =
+      FusedExpr::toOp(expr->asUnchecked<core::CallTypedExpr>()->name());
+  if (!op.has_value()) {
+    return nullptr;
+  }
+  const auto& inputType = FusedExpr::isComparison(op.value())
+      ? expr->inputs()[0]->type()
+      : expr->type();
+  int32_t numOps = 0;
+  if (!FusedExpr::isSupportedType(inputType) ||
+      !isFusable(expr, inputType, true, numOps) || numOps < 2) {
+    return nullptr;
+  }
+
+  CompilerCtx fallbackCtx = ctx;
+  fallbackCtx.fuseArithmetic = false;
+  auto fallback = compileRewrittenExpression(expr, scope, fallbackCtx);
+  std::vector<ExprPtr> inputs;
+  std::vector<FusedExpr::Instruction> program;
+  compileFusedOperand(expr, scope, ctx, inputs, program);
+  return std::make_shared<FusedExpr>(
+      expr->type(),
+      std::move(inputs),
+      std::move(program),
+      std::move(fallback),
+      ctx.queryCtx->queryConfig().exprTrackCpuUsage());
+}
+
 ExprPtr compileRewrittenExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -402,6 +515,14 @@ ExprPtr compileRewrittenExpression(
     return alreadyCompiled;
   }
 
+  if (ctx.fuseArithmetic) {
+    if (auto fused = tryCompileFused(expr, scope, ctx)) {
+      fused->computeMetadata();
+      scope->visited[expr.get()] = fused;
+      return fused;
+    }
+  }
+
   const bool trackCpuUsage = ctx.queryCtx->queryConfig().exprTrackCpuUsage();
 
   const auto& resultType = expr->type();
@@ -519,6 +640,18 @@ std::unordered_set<std::string> collectFlatteningCandidates(
     return flatteningCandidates;
   });
 }
+
+// Enables the value cache of the topmost eligible expressions of 'expr'. A
+// cached expression is not evaluated for the cached values, so that caching
+// its inputs would not help.
+void enableValueCaches(const ExprPtr& expr, int32_t maxEntries) {
+  if (expr->enableValueCache(maxEntries)) {
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    enableValueCaches(input, maxEntries);
+  }
+}
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
@@ -534,15 +667,28 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
       .queryCtx = execCtx->queryCtx(),
       .pool = execCtx->pool(),
       .enableConstantFolding = enableConstantFolding,
+      .fuseArithmetic =
+          execCtx->queryCtx()->queryConfig().exprFuseArithmetic(),
       // Precompute a set of function calls that support flattening. This allows
       // to lock function registry once vs. locking for each function call.
       .flatteningCandidates = collectFlatteningCandidates(sources),
       .cpuUsageTrackingCandidates =
           fetchCallExprNamesForCpuTracking(execCtx->queryCtx()->queryConfig())};
 
-  for (auto& source : sources) {
+  const auto rewrittenSources = enableConstantFolding
+      ? expression::ExprRewriteRegistry::instance().rewriteExprSet(sources)
+      : sources;
+  for (auto& source : rewrittenSources) {
     exprs.push_back(compileExpression(source, &scope, ctx));
   }
+
+  const auto valueCacheMaxEntries =
+      execCtx->queryCtx()->queryConfig().exprValueCacheMaxEntries();
+  if (valueCacheMaxEntries > 0) {
+    for (auto& expr : exprs) {
+      enableValueCaches(expr, valueCacheMaxEntries);
+    }
+  }
   return exprs;
 }
 
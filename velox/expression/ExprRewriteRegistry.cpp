@@ -22,8 +22,15 @@ void ExprRewriteRegistry::registerRewrite(ExpressionRewrite rewrite) {
   registry_.withWLock([&](auto& list) { list.push_back(std::move(rewrite)); });
 }
 
+void ExprRewriteRegistry::registerExprSetRewrite(
+    ExpressionSetRewrite rewrite) {
+  exprSetRegistry_.withWLock(
+      [&](auto& list) { list.push_back(std::move(rewrite)); });
+}
+
 void ExprRewriteRegistry::clear() {
   registry_.withWLock([&](auto& list) { list.clear(); });
+  exprSetRegistry_.withWLock([&](auto& list) { list.clear(); });
 }
 
 core::TypedExprPtr ExprRewriteRegistry::rewrite(
@@ -51,4 +58,20 @@ core::TypedExprPtr ExprRewriteRegistry::rewrite(
 
   return result;
 }
+
+std::vector<core::TypedExprPtr> ExprRewriteRegistry::rewriteExprSet(
+    const std::vector<core::TypedExprPtr>& exprs) {
+  std::vector<core::TypedExprPtr> result = exprs;
+  exprSetRegistry_.withRLock([&](const auto& list) {
+    for (const auto& rewrite : list) {
+      VELOX_CHECK_NOT_NULL(rewrite);
+      auto rewritten = rewrite(result);
+      if (!rewritten.empty()) {
+        VELOX_CHECK_EQ(rewritten.size(), result.size());
+        result = std::move(rewritten);
+      }
+    }
+  });
+  return result;
+}
 } // namespace facebook::velox::expression
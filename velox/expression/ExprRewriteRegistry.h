@@ -25,6 +25,12 @@ namespace facebook::velox::expression {
 using ExpressionRewrite =
     std::function<core::TypedExprPtr(const core::TypedExprPtr)>;
 
+/// A re-writer that takes the expressions of an ExprSet and returns equivalent
+/// expressions, e.g. expressions that share work between them, or an empty
+/// vector if re-write is not possible.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
 class ExprRewriteRegistry {
  public:
   /// Appends a 'rewrite' to 'expressionRewrites'.
@@ -35,6 +41,11 @@ class ExprRewriteRegistry {
   /// terminates the re-write for that particular expression.
   void registerRewrite(ExpressionRewrite rewrite);
 
+  /// Appends a 'rewrite' of all expressions of an ExprSet. These rewrites are
+  /// applied in the order they were registered, each to the result of the
+  /// previous one, before the rewrites of the single expressions.
+  void registerExprSetRewrite(ExpressionSetRewrite rewrite);
+
   /// Clears the registry to remove all registered rewrites.
   void clear();
 
@@ -42,6 +53,10 @@ class ExprRewriteRegistry {
   /// expression only has constant inputs.
   core::TypedExprPtr rewrite(const core::TypedExprPtr& expr);
 
+  /// Rewrites the expressions of an ExprSet to equivalent expressions.
+  std::vector<core::TypedExprPtr> rewriteExprSet(
+      const std::vector<core::TypedExprPtr>& exprs);
+
   static ExprRewriteRegistry& instance() {
     static ExprRewriteRegistry kInstance;
     return kInstance;
@@ -49,5 +64,6 @@ class ExprRewriteRegistry {
 
  private:
   folly::Synchronized<std::vector<ExpressionRewrite>> registry_;
+  folly::Synchronized<std::vector<ExpressionSetRewrite>> exprSetRegistry_;
 };
 } // namespace facebook::velox::expression
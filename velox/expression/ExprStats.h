@@ -35,6 +35,11 @@ struct ExprStats {
   /// evaluation of rows.
   bool defaultNullRowsSkipped{false};
 
+  /// Number of rows looked up in the value cache of the expression and the
+  /// number of them found. See Expr::enableValueCache().
+  uint64_t numValueCacheLookups{0};
+  uint64_t numValueCacheHits{0};
+
   auto operator<=>(const ExprStats&) const = default;
 
   void add(const ExprStats& other) {
@@ -42,15 +47,19 @@ struct ExprStats {
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
     defaultNullRowsSkipped |= other.defaultNullRowsSkipped;
+    numValueCacheLookups += other.numValueCacheLookups;
+    numValueCacheHits += other.numValueCacheHits;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, defaultNullRowsSkipped: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, defaultNullRowsSkipped: {}, numValueCacheLookups: {}, numValueCacheHits: {}",
         timing.toString(),
         numProcessedRows,
         numProcessedVectors,
-        defaultNullRowsSkipped ? "true" : "false");
+        defaultNullRowsSkipped ? "true" : "false",
+        numValueCacheLookups,
+        numValueCacheHits);
   }
 };
 } // namespace facebook::velox::exec
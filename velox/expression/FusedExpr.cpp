@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedExpr.h"
+
+#include <array>
+#include <cmath>
+#include <functional>
+
+#include "velox/expression/EvalCtx.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+template <typename T>
+void arithmetic(
+    FusedExpr::Op op,
+    const T* left,
+    const T* right,
+    vector_size_t size,
+    T* out,
+    uint8_t* exceptional) {
+  switch (op) {
+    case FusedExpr::Op::kPlus:
+      for (auto i = 0; i < size; ++i) {
+        if constexpr (std::is_integral_v<T>) {
+          exceptional[i] |= __builtin_add_overflow(left[i], right[i], &out[i]);
+        } else {
+          out[i] = left[i] + right[i];
+        }
+      }
+      break;
+    case FusedExpr::Op::kMinus:
+      for (auto i = 0; i < size; ++i) {
+        if constexpr (std::is_integral_v<T>) {
+          exceptional[i] |= __builtin_sub_overflow(left[i], right[i], &out[i]);
+        } else {
+          out[i] = left[i] - right[i];
+        }
+      }
+      break;
+    case FusedExpr::Op::kMultiply:
+      for (auto i = 0; i < size; ++i) {
+        if constexpr (std::is_integral_v<T>) {
+          exceptional[i] |= __builtin_mul_overflow(left[i], right[i], &out[i]);
+        } else {
+          out[i] = left[i] * right[i];
+        }
+      }
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T, typename Compare>
+void compare(
+    const T* left,
+    const T* right,
+    vector_size_t size,
+    uint8_t* out,
+    uint8_t* exceptional,
+    Compare cmp) {
+  for (auto i = 0; i < size; ++i) {
+    out[i] = cmp(left[i], right[i]);
+    if constexpr (std::is_floating_point_v<T>) {
+      // The comparison functions order NaN differently from IEEE.
+      exceptional[i] |= std::isnan(left[i]) | std::isnan(right[i]);
+    }
+  }
+}
+
+template <typename T>
+void comparison(
+    FusedExpr::Op op,
+    const T* left,
+    const T* right,
+    vector_size_t size,
+    uint8_t* out,
+    uint8_t* exceptional) {
+  switch (op) {
+    case FusedExpr::Op::kEq:
+      compare(left, right, size, out, exceptional, std::equal_to<T>());
+      break;
+    case FusedExpr::Op::kNeq:
+      compare(left, right, size, out, exceptional, std::not_equal_to<T>());
+      break;
+    case FusedExpr::Op::kLt:
+      compare(left, right, size, out, exceptional, std::less<T>());
+      break;
+    case FusedExpr::Op::kLte:
+      compare(left, right, size, out, exceptional, std::less_equal<T>());
+      break;
+    case FusedExpr::Op::kGt:
+      compare(left, right, size, out, exceptional, std::greater<T>());
+      break;
+    case FusedExpr::Op::kGte:
+      compare(left, right, size, out, exceptional, std::greater_equal<T>());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Returns true if any row of 'rows' in [begin, begin + size) is set in
+// 'exceptional'.
+bool hasExceptional(
+    const SelectivityVector& rows,
+    vector_size_t begin,
+    vector_size_t size,
+    const uint8_t* exceptional) {
+  const bool allSelected = rows.isAllSelected();
+  for (auto i = 0; i < size; ++i) {
+    if (exceptional[i] && (allSelected || rows.isValid(begin + i))) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+// static
+std::optional<FusedExpr::Op> FusedExpr::toOp(const std::string& name) {
+  static const std::unordered_map<std::string, Op> kOps = {
+      {"plus", Op::kPlus},
+      {"minus", Op::kMinus},
+      {"multiply", Op::kMultiply},
+      {"eq", Op::kEq},
+      {"neq", Op::kNeq},
+      {"lt", Op::kLt},
+      {"lte", Op::kLte},
+      {"gt", Op::kGt},
+      {"gte", Op::kGte}};
+  auto it = kOps.find(name);
+  if (it == kOps.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+// static
+bool FusedExpr::isSupportedType(const TypePtr& type) {
+  // Excludes the logical types like DATE and DECIMAL, whose functions have
+  // their own semantics.
+  return *type == *INTEGER() || *type == *BIGINT() || *type == *DOUBLE();
+}
+
+FusedExpr::FusedExpr(
+    TypePtr type,
+    std::vector<ExprPtr>&& inputs,
+    std::vector<Instruction> program,
+    ExprPtr fallback,
+    bool trackCpuUsage)
+    : SpecialForm(
+          SpecialFormKind::kCustom,
+          std::move(type),
+          std::move(inputs),
+          "fused",
+          /*supportsFlatNoNullsFastPath=*/false,
+          trackCpuUsage),
+      program_(std::move(program)),
+      fallback_(std::move(fallback)),
+      inputType_(inputs_.at(0)->type()) {
+  VELOX_CHECK(!program_.empty());
+  VELOX_CHECK(isSupportedType(inputType_));
+  for (const auto& input : inputs_) {
+    VELOX_CHECK(input->type()->equivalent(*inputType_));
+  }
+  for (auto i = 0; i < program_.size(); ++i) {
+    const auto& instruction = program_[i];
+    for (auto operand : {instruction.left, instruction.right}) {
+      VELOX_CHECK_LT(operand, static_cast<int32_t>(inputs_.size()));
+      VELOX_CHECK_GE(operand, -i);
+    }
+    VELOX_CHECK(
+        !isComparison(instruction.op) || i == program_.size() - 1,
+        "Only the last instruction of a fused program may be a comparison");
+  }
+  VELOX_CHECK(
+      isComparison(program_.back().op) ? this->type()->isBoolean()
+                                       : this->type()->equivalent(*inputType_));
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  std::vector<VectorPtr> inputValues(inputs_.size());
+  bool fusable = true;
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputs_[i]->eval(rows, context, inputValues[i]);
+    const auto* vector = inputValues[i]->loadedVector();
+    fusable &= vector->isFlatEncoding() || vector->isConstantEncoding();
+  }
+
+  if (fusable) {
+    for (auto& value : inputValues) {
+      value = BaseVector::loadedVectorShared(value);
+    }
+    context.ensureWritable(rows, type(), result);
+    switch (inputType_->kind()) {
+      case TypeKind::INTEGER:
+        fusable = evalFused<int32_t>(rows, inputValues, context, result);
+        break;
+      case TypeKind::BIGINT:
+        fusable = evalFused<int64_t>(rows, inputValues, context, result);
+        break;
+      case TypeKind::DOUBLE:
+        fusable = evalFused<double>(rows, inputValues, context, result);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    if (fusable) {
+      setNulls(rows, inputValues, *result);
+      return;
+    }
+  }
+  fallback_->eval(rows, context, result);
+}
+
+template <typename T>
+bool FusedExpr::evalFused(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& inputValues,
+    EvalCtx& /*context*/,
+    VectorPtr& result) {
+  const int32_t numInstructions = program_.size();
+  registers_.resize((numInstructions + inputs_.size()) * kBlockSize);
+  auto registerAt = [&](size_t index) {
+    return reinterpret_cast<T*>(registers_.data() + index * kBlockSize);
+  };
+
+  // Flat inputs are read in place. Constants are read from a register that
+  // has the constant in all rows.
+  std::vector<const T*> rawInputs(inputs_.size());
+  std::vector<bool> isConstant(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    const auto& vector = inputValues[i];
+    isConstant[i] = vector->isConstantEncoding();
+    if (isConstant[i]) {
+      auto* constant = registerAt(numInstructions + i);
+      const auto* constantVector = vector->asUnchecked<ConstantVector<T>>();
+      std::fill_n(
+          constant,
+          kBlockSize,
+          constantVector->isNullAt(0) ? T() : constantVector->valueAt(0));
+      rawInputs[i] = constant;
+    } else {
+      rawInputs[i] = vector->asUnchecked<FlatVector<T>>()->rawValues();
+    }
+  }
+
+  const bool isBoolean = isComparison(program_.back().op);
+  T* rawResult = nullptr;
+  uint64_t* rawResultBits = nullptr;
+  if (isBoolean) {
+    rawResultBits =
+        result->asFlatVector<bool>()->mutableRawValues<uint64_t>();
+  } else {
+    rawResult = result->asFlatVector<T>()->mutableRawValues();
+  }
+
+  std::array<uint8_t, kBlockSize> booleans;
+  std::array<uint8_t, kBlockSize> exceptional;
+  for (auto begin = rows.begin(); begin < rows.end(); begin += kBlockSize) {
+    const auto size = std::min(kBlockSize, rows.end() - begin);
+    auto operand = [&](int32_t index) -> const T* {
+      if (index < 0) {
+        return registerAt(-index - 1);
+      }
+      return isConstant[index] ? rawInputs[index] : rawInputs[index] + begin;
+    };
+
+    std::fill_n(exceptional.begin(), size, 0);
+    for (auto i = 0; i < numInstructions; ++i) {
+      const auto& instruction = program_[i];
+      if (isComparison(instruction.op)) {
+        comparison(
+            instruction.op,
+            operand(instruction.left),
+            operand(instruction.right),
+            size,
+            booleans.data(),
+            exceptional.data());
+      } else {
+        arithmetic(
+            instruction.op,
+            operand(instruction.left),
+            operand(instruction.right),
+            size,
+            registerAt(i),
+            exceptional.data());
+      }
+    }
+    if (hasExceptional(rows, begin, size, exceptional.data())) {
+      return false;
+    }
+
+    // Only 'rows' of 'result' are written. The other rows may have values that
+    // the caller keeps.
+    const auto* values = registerAt(numInstructions - 1);
+    bits::forEachSetBit(rows.allBits(), begin, begin + size, [&](auto row) {
+      if (isBoolean) {
+        bits::setBit(rawResultBits, row, booleans[row - begin]);
+      } else {
+        rawResult[row] = values[row - begin];
+      }
+    });
+  }
+  return true;
+}
+
+// static
+void FusedExpr::setNulls(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& inputValues,
+    BaseVector& result) {
+  bool mayHaveNulls = false;
+  for (const auto& value : inputValues) {
+    mayHaveNulls |= value->mayHaveNulls();
+  }
+  if (!mayHaveNulls) {
+    result.clearNulls(rows);
+    return;
+  }
+  rows.applyToSelected([&](auto row) {
+    bool isNull = false;
+    for (const auto& value : inputValues) {
+      isNull |= value->isNullAt(row);
+    }
+    result.setNull(row, isNull);
+  });
+}
+
+} // namespace facebook::velox::exec
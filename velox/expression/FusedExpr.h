@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// Evaluates a tree of arithmetic and comparison functions over columns and
+/// constants of one primitive type in a single loop, e.g. 'a * 2 + b > c'.
+/// The tree is a program of instructions that run on blocks of rows. The
+/// intermediate results of a block stay in scratch registers that fit in the
+/// cache instead of being materialized into vectors through EvalCtx.
+///
+/// Produces the same results as 'fallback', the interpreted tree, and
+/// evaluates 'fallback' instead if an input is not flat or constant, or if a
+/// row needs the error or special value handling of the functions, i.e. an
+/// integer overflow or a NaN compared. ExprCompiler makes FusedExpr if
+/// 'expression.fuse_arithmetic' is true.
+class FusedExpr : public SpecialForm {
+ public:
+  enum class Op { kPlus, kMinus, kMultiply, kEq, kNeq, kLt, kLte, kGt, kGte };
+
+  /// One operation of the program. An operand 'i' >= 0 refers to 'inputs[i]'
+  /// and an operand 'i' < 0 to the result of instruction '-i - 1', which must
+  /// come before. The last instruction produces the result. Only the last
+  /// instruction may be a comparison.
+  struct Instruction {
+    Op op;
+    int32_t left;
+    int32_t right;
+  };
+
+  /// Returns the operation for function 'name' or std::nullopt if it cannot
+  /// be fused.
+  static std::optional<Op> toOp(const std::string& name);
+
+  static bool isComparison(Op op) {
+    return op >= Op::kEq;
+  }
+
+  /// Returns true if the values of 'type' can be computed by FusedExpr.
+  static bool isSupportedType(const TypePtr& type);
+
+  /// @param type The result type. BOOLEAN if the last instruction is a
+  /// comparison, otherwise the type of the inputs.
+  /// @param inputs Field references and constants of one supported type.
+  FusedExpr(
+      TypePtr type,
+      std::vector<ExprPtr>&& inputs,
+      std::vector<Instruction> program,
+      ExprPtr fallback,
+      bool trackCpuUsage);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  const std::vector<Instruction>& program() const {
+    return program_;
+  }
+
+  const ExprPtr& fallback() const {
+    return fallback_;
+  }
+
+  /// The number of rows of a block.
+  static constexpr vector_size_t kBlockSize = 1'024;
+
+ private:
+  void computePropagatesNulls() override {
+    propagatesNulls_ = true;
+  }
+
+  // Runs the program on 'inputValues' and writes 'rows' of 'result'. Returns
+  // false without writing the nulls of 'result' if a row needs 'fallback_'.
+  template <typename T>
+  bool evalFused(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& inputValues,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  // Sets the nulls of 'rows' of 'result' to the nulls of 'inputValues'.
+  static void setNulls(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& inputValues,
+      BaseVector& result);
+
+  const std::vector<Instruction> program_;
+  const ExprPtr fallback_;
+  // Type of the inputs.
+  const TypePtr inputType_;
+
+  // Registers of one block for the results of the instructions and the
+  // constant inputs.
+  std::vector<uint64_t> registers_;
+};
+
+} // namespace facebook::velox::exec
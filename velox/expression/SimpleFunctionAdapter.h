@@ -533,7 +533,7 @@ class SimpleFunctionAdapter : public VectorFunction {
 
       for (auto i = POSITION; i < rawArgs.size(); ++i) {
         decodedArgs[i] = LocalDecodedVector(
-            applyContext.context, *rawArgs[i], *applyContext.rows);
+            applyContext.context, rawArgs[i], *applyContext.rows);
       }
       auto variadicReader =
           VectorReader<arg_at<POSITION>>(decodedArgs, POSITION);
@@ -556,7 +556,7 @@ class SimpleFunctionAdapter : public VectorFunction {
             applyContext, decodedArgs, rawArgs, readers..., reader);
       } else {
         decodedArgs[POSITION] = LocalDecodedVector(
-            applyContext.context, *rawArgs[POSITION], *applyContext.rows);
+            applyContext.context, rawArgs[POSITION], *applyContext.rows);
 
         auto* oneUnpacked = decodedArgs.at(POSITION).value().get();
         auto reader = VectorReader<arg_at<POSITION>>(oneUnpacked);
@@ -566,6 +566,44 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
   }
 
+  // Evaluates all rows of 'applyContext' for a BOOLEAN result that is never
+  // null. The results of up to 64 rows are gathered in a word and stored at
+  // once instead of setting one bit per row, which lets the compiler unroll
+  // and vectorize comparisons of flat and constant inputs. 'func' computes
+  // one row. Returns false if a row fails. The caller then evaluates the rows
+  // one by one, which records the errors.
+  template <typename Func>
+  bool applyToAllBooleanWords(ApplyContext& applyContext, Func func) const {
+    auto* rawResult =
+        applyContext.result->template mutableRawValues<uint64_t>();
+    const auto end = applyContext.rows->end();
+    try {
+      for (auto begin = applyContext.rows->begin(); begin < end;) {
+        const auto wordEnd =
+            std::min<vector_size_t>(end, bits::roundUp(begin + 1, 64));
+        uint64_t word = 0;
+        for (auto row = begin; row < wordEnd; ++row) {
+          T out{};
+          bool notNull;
+          auto status = func(row, out, notNull);
+          if UNLIKELY (!status.ok()) {
+            return false;
+          }
+          word |= static_cast<uint64_t>(out) << (row & 63);
+        }
+        const auto mask = wordEnd - begin == 64
+            ? ~0ULL
+            : bits::lowMask(wordEnd - begin) << (begin & 63);
+        auto& target = rawResult[begin / 64];
+        target = (target & ~mask) | word;
+        begin = wordEnd;
+      }
+    } catch (const std::exception&) {
+      return false;
+    }
+    return true;
+  }
+
   template <typename... TReader>
   void iterate(ApplyContext& applyContext, TReader&... readers) const {
     // If udf_has_callNullFree is true compute mayHaveNullsRecursive.
@@ -626,6 +664,29 @@ class SimpleFunctionAdapter : public VectorFunction {
           bits::setNull(nullBuffer, row);
         }
       };
+      if constexpr (
+          return_type_traits::typeKind == TypeKind::BOOLEAN &&
+          !FUNC::can_produce_null_output) {
+        if (applyContext.rows->isAllSelected()) {
+          if (callNullFree && !applyContext.mayHaveNullsRecursive) {
+            if (applyToAllBooleanWords(
+                    applyContext,
+                    [&](auto row, auto& out, bool& notNull) INLINE_LAMBDA {
+                      return doApplyNullFree<0>(row, out, notNull, readers...);
+                    })) {
+              return;
+            }
+          } else if (!callNullFree && allNotNull && !applyContext.allAscii) {
+            if (applyToAllBooleanWords(
+                    applyContext,
+                    [&](auto row, auto& out, bool& notNull) INLINE_LAMBDA {
+                      return doApplyNotNull<0>(row, out, notNull, readers...);
+                    })) {
+              return;
+            }
+          }
+        }
+      }
       if (callNullFree) {
         // This results in some code duplication, but applying this check
         // once per batch instead of once per row shows a significant
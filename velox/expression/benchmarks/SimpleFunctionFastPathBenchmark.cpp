@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/Macros.h"
+#include "velox/functions/Registerer.h"
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+// Benchmark the fast paths of simple functions over flat and constant
+// primitive inputs for arithmetic and comparison.
+
+// Results:
+// simple* evaluates simple functions through SimpleFunctionAdapter. The
+// arithmetic compares the checked 'plus' with an unchecked simple function.
+// The comparisons compare a simple function, whose results are gathered 64
+// rows at a time, with the SIMD 'lt' vector function. The *Nulls variants
+// have nulls in the inputs, so that the rows are not all selected and the
+// results are written one row at a time.
+
+namespace facebook::velox::functions {
+
+template <typename T>
+struct UncheckedPlusFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void
+  call(int64_t& out, const int64_t& a, const int64_t& b) {
+    out = a + b;
+  }
+};
+
+template <typename T>
+struct SimpleLessThanFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void
+  call(bool& out, const int64_t& a, const int64_t& b) {
+    out = a < b;
+  }
+};
+
+namespace {
+
+class SimpleFunctionFastPathBenchmark
+    : public functions::test::FunctionBenchmarkBase {
+ public:
+  SimpleFunctionFastPathBenchmark() : FunctionBenchmarkBase() {
+    prestosql::registerArithmeticFunctions();
+    prestosql::registerComparisonFunctions();
+    registerFunction<UncheckedPlusFunction, int64_t, int64_t, int64_t>(
+        {"unchecked_plus"});
+    registerFunction<SimpleLessThanFunction, bool, int64_t, int64_t>(
+        {"simple_lt"});
+  }
+
+  RowVectorPtr makeData(bool withNulls) {
+    constexpr vector_size_t kSize = 10'000;
+    auto nulls = [&](vector_size_t row) { return withNulls && row % 11 == 0; };
+    return vectorMaker_.rowVector({
+        vectorMaker_.flatVector<int64_t>(
+            kSize, [](auto row) { return row; }, nulls),
+        vectorMaker_.flatVector<int64_t>(
+            kSize, [](auto row) { return (row * 7) % 1'000; }),
+    });
+  }
+
+  size_t run(const std::string& expression, bool withNulls = false) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(withNulls);
+    auto exprSet = compileExpression(expression, data->type());
+    suspender.dismiss();
+
+    size_t count = 0;
+    for (auto i = 0; i < 100; ++i) {
+      count += evaluate(exprSet, data)->size();
+    }
+    return count;
+  }
+
+  void test() {
+    auto data = makeData(true);
+    for (const auto& [reference, other] :
+         std::vector<std::pair<std::string, std::string>>{
+             {"plus(c0, c1)", "unchecked_plus(c0, c1)"},
+             {"lt(c0, c1)", "simple_lt(c0, c1)"},
+             {"lt(c0, 500)", "simple_lt(c0, 500)"}}) {
+      auto referenceSet = compileExpression(reference, data->type());
+      auto otherSet = compileExpression(other, data->type());
+      auto expected = evaluate(referenceSet, data);
+      auto actual = evaluate(otherSet, data);
+      for (auto i = 0; i < data->size(); ++i) {
+        VELOX_CHECK(expected->equalValueAt(actual.get(), i, i), "{}", other);
+      }
+    }
+  }
+};
+
+std::unique_ptr<SimpleFunctionFastPathBenchmark> benchmark;
+
+BENCHMARK_MULTI(simplePlus) {
+  return benchmark->run("plus(c0, c1)");
+}
+
+BENCHMARK_MULTI(simpleUncheckedPlus) {
+  return benchmark->run("unchecked_plus(c0, c1)");
+}
+
+BENCHMARK_MULTI(simpleUncheckedPlusConstant) {
+  return benchmark->run("unchecked_plus(c0, 10)");
+}
+
+BENCHMARK_MULTI(simpleUncheckedPlusNulls) {
+  return benchmark->run("unchecked_plus(c0, c1)", true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(vectorLessThan) {
+  return benchmark->run("lt(c0, c1)");
+}
+
+BENCHMARK_MULTI(simpleLessThan) {
+  return benchmark->run("simple_lt(c0, c1)");
+}
+
+BENCHMARK_MULTI(vectorLessThanConstant) {
+  return benchmark->run("lt(c0, 500)");
+}
+
+BENCHMARK_MULTI(simpleLessThanConstant) {
+  return benchmark->run("simple_lt(c0, 500)");
+}
+
+BENCHMARK_MULTI(vectorLessThanNulls) {
+  return benchmark->run("lt(c0, c1)", true);
+}
+
+BENCHMARK_MULTI(simpleLessThanNulls) {
+  return benchmark->run("simple_lt(c0, c1)", true);
+}
+
+} // namespace
+} // namespace facebook::velox::functions
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  facebook::velox::memory::MemoryManager::initialize(
+      facebook::velox::memory::MemoryManager::Options{});
+  facebook::velox::functions::benchmark = std::make_unique<
+      facebook::velox::functions::SimpleFunctionFastPathBenchmark>();
+  facebook::velox::functions::benchmark->test();
+  folly::runBenchmarks();
+  facebook::velox::functions::benchmark.reset();
+  return 0;
+}
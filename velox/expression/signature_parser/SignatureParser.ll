@@ -84,9 +84,13 @@ int yyFlexLexer::yylex() {
     throw std::runtime_error("Bad call to yyFlexLexer::yylex()");
 }
 
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
 #include "velox/expression/signature_parser/SignatureParser.h"
 
-facebook::velox::exec::TypeSignature facebook::velox::exec::parseTypeSignature(
+namespace {
+facebook::velox::exec::TypeSignature parseTypeSignatureUncached(
     const std::string& signatureText) {
   std::istringstream is(signatureText);
   std::ostringstream os;
@@ -97,3 +101,32 @@ facebook::velox::exec::TypeSignature facebook::velox::exec::parseTypeSignature(
   VELOX_CHECK(signature, "Failed to parse signature [{}]", signatureText);
   return std::move(*signature);
 }
+
+// Function registration parses the same few type strings, e.g. 'bigint' or
+// 'array(T)', for thousands of signatures. The parse result only depends on
+// the text, so we keep it to avoid running the scanner and parser again.
+folly::Synchronized<folly::F14FastMap<
+    std::string,
+    facebook::velox::exec::TypeSignature>>&
+parsedTypeSignatures() {
+  static folly::Synchronized<folly::F14FastMap<
+      std::string,
+      facebook::velox::exec::TypeSignature>>
+      instance;
+  return instance;
+}
+} // namespace
+
+facebook::velox::exec::TypeSignature facebook::velox::exec::parseTypeSignature(
+    const std::string& signatureText) {
+  {
+    auto cache = parsedTypeSignatures().rlock();
+    auto it = cache->find(signatureText);
+    if (it != cache->end()) {
+      return it->second;
+    }
+  }
+  auto signature = parseTypeSignatureUncached(signatureText);
+  parsedTypeSignatures().wlock()->emplace(signatureText, signature);
+  return signature;
+}
@@ -339,6 +339,22 @@ TEST_F(ParseTypeSignatureTest, roundTrip) {
   ASSERT_EQ(roundTrip("row(bigint, ...)"), "row(bigint, ...)");
 }
 
+TEST_F(ParseTypeSignatureTest, repeatedParse) {
+  // Parsing the same text again returns an equal signature.
+  for (const auto& text :
+       {"bigint", "array(T)", "map(K,V)", "row(named bigint,array(T))"}) {
+    SCOPED_TRACE(text);
+    const auto first = parseTypeSignature(text);
+    const auto second = parseTypeSignature(text);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(first.toString(), second.toString());
+  }
+
+  // A failed parse is not remembered.
+  EXPECT_THROW(parseTypeSignature("array(T"), VeloxRuntimeError);
+  EXPECT_THROW(parseTypeSignature("array(T"), VeloxRuntimeError);
+}
+
 TEST_F(ParseTypeSignatureTest, invalidSignatures) {
   EXPECT_THROW(parseTypeSignature("array(varchar"), VeloxRuntimeError);
   EXPECT_THROW(parseTypeSignature("array(array(T)"), VeloxRuntimeError);
@@ -1307,6 +1307,23 @@ TEST_F(CastExprTest, errorHandling) {
       "Non-whitespace character found after end of conversion");
 }
 
+TEST_F(CastExprTest, unicodeToIntegerErrors) {
+  // Rows with unicode characters fail without failing the other rows.
+  testTryCast<std::string, int64_t>(
+      "bigint",
+      {"12", "٣", "1٣", std::nullopt, "-7"},
+      {12, std::nullopt, std::nullopt, std::nullopt, -7});
+  testTryCast<std::string, int8_t>(
+      "tinyint", {"٣", "3"}, {std::nullopt, 3});
+
+  auto input = makeRowVector({makeNullableFlatVector<std::string>(
+      {"12", "٣", std::nullopt, "-7"})});
+  auto result = evaluate("try(cast(c0 as integer))", input);
+  assertEqualVectors(
+      makeNullableFlatVector<int32_t>({12, std::nullopt, std::nullopt, -7}),
+      result);
+}
+
 constexpr vector_size_t kVectorSize = 1'000;
 
 TEST_F(CastExprTest, mapCast) {
@@ -237,3 +237,48 @@ TEST_F(EvalCtxTest, inputFlatNoNulls) {
   EvalCtx context(&execCtx_);
   ASSERT_FALSE(context.inputFlatNoNulls());
 }
+
+TEST_F(EvalCtxTest, sharedDecodedVector) {
+  EvalCtx context(&execCtx_);
+  const vector_size_t size = 100;
+  auto flat = makeFlatVector<int64_t>(size, [](auto row) { return row; });
+  auto dictionary = wrapInDictionary(makeIndicesInReverse(size), size, flat);
+  auto nested =
+      wrapInDictionary(makeIndicesInReverse(size), size, dictionary);
+
+  SelectivityVector allRows(size);
+  ASSERT_EQ(context.sharedDecodedVector(flat, allRows), nullptr);
+  ASSERT_EQ(context.sharedDecodedVector(dictionary, allRows), nullptr);
+
+  // Decodings over the same or fewer rows are shared.
+  auto decoded = context.sharedDecodedVector(nested, allRows);
+  ASSERT_NE(decoded, nullptr);
+  SelectivityVector evenRows(size, false);
+  for (auto row = 0; row < size; row += 2) {
+    evenRows.setValid(row, true);
+  }
+  evenRows.updateBounds();
+  ASSERT_EQ(context.sharedDecodedVector(nested, evenRows), decoded);
+
+  LocalDecodedVector local(context, nested, evenRows);
+  ASSERT_EQ(local.get(), decoded.get());
+  for (auto row = 0; row < size; row += 2) {
+    ASSERT_EQ(local->valueAt<int64_t>(row), row);
+  }
+
+  // A single dictionary is decoded locally.
+  LocalDecodedVector localDictionary(context, dictionary, allRows);
+  ASSERT_EQ(localDictionary->valueAt<int64_t>(0), size - 1);
+
+  // A decoding over more rows replaces the entry. The previous decoding
+  // stays valid for its holders.
+  EvalCtx otherContext(&execCtx_);
+  auto evenDecoded = otherContext.sharedDecodedVector(nested, evenRows);
+  auto allDecoded = otherContext.sharedDecodedVector(nested, allRows);
+  ASSERT_NE(allDecoded, evenDecoded);
+  ASSERT_EQ(otherContext.sharedDecodedVector(nested, evenRows), allDecoded);
+  for (auto row = 0; row < size; ++row) {
+    ASSERT_EQ(allDecoded->valueAt<int64_t>(row), row);
+  }
+  ASSERT_EQ(evenDecoded->valueAt<int64_t>(2), 2);
+}
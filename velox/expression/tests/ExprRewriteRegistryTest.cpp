@@ -47,5 +47,32 @@ TEST_F(ExprRewriteRegistryTest, basic) {
   ASSERT_TRUE(*rewriteAfterClear == *input);
 }
 
+TEST_F(ExprRewriteRegistryTest, exprSet) {
+  expression::ExprRewriteRegistry registry;
+  auto a = std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "a");
+  // Replaces the first expression by the second.
+  registry.registerExprSetRewrite(
+      [](const std::vector<core::TypedExprPtr>& exprs) {
+        return std::vector<core::TypedExprPtr>{exprs[1], exprs[1]};
+      });
+  // Does not rewrite.
+  registry.registerExprSetRewrite(
+      [](const std::vector<core::TypedExprPtr>& /*exprs*/) {
+        return std::vector<core::TypedExprPtr>{};
+      });
+
+  std::vector<core::TypedExprPtr> exprs = {
+      std::make_shared<core::CallTypedExpr>(BIGINT(), "first", a),
+      std::make_shared<core::CallTypedExpr>(BIGINT(), "second", a)};
+  auto rewritten = registry.rewriteExprSet(exprs);
+  ASSERT_EQ(rewritten.size(), 2);
+  EXPECT_EQ(*rewritten[0], *exprs[1]);
+  EXPECT_EQ(*rewritten[1], *exprs[1]);
+
+  registry.clear();
+  rewritten = registry.rewriteExprSet(exprs);
+  EXPECT_EQ(*rewritten[0], *exprs[0]);
+}
+
 } // namespace
 } // namespace facebook::velox::expression
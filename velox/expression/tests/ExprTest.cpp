@@ -493,6 +493,40 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_P(ParameterizedExprTest, reorderAfterDataChange) {
+  constexpr int32_t kBatchSize = 1'000;
+  auto exprSet = compileExpression(
+      "c0 = 1 and c1 = 1", ROW({"c0", "c1"}, {BIGINT(), BIGINT()}));
+  auto conjunct =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(conjunct != nullptr);
+
+  // 'c1 = 1' drops all rows first and 'c0 = 1' afterwards.
+  auto evaluateBatches = [&](int32_t numBatches, bool dropByC1) {
+    auto data = makeRowVector({
+        makeConstant<int64_t>(dropByC1 ? 1 : 0, kBatchSize),
+        makeConstant<int64_t>(dropByC1 ? 0 : 1, kBatchSize),
+    });
+    for (auto i = 0; i < numBatches; ++i) {
+      auto result = evaluate(exprSet.get(), data);
+      assertEqualVectors(makeConstant(false, kBatchSize), result);
+    }
+  };
+  evaluateBatches(exec::ConjunctExpr::kDecayInterval * 4, true);
+  // The statistics decay, so that they do not cover all batches.
+  uint64_t numIn = 0;
+  for (auto i = 0; i < conjunct->inputs().size(); ++i) {
+    numIn += conjunct->selectivityAt(i).numIn();
+  }
+  EXPECT_LT(numIn, exec::ConjunctExpr::kDecayInterval * 2 * kBatchSize);
+
+  // After the data changes, the input that drops the rows gets first.
+  evaluateBatches(exec::ConjunctExpr::kDecayInterval * 4, false);
+  const auto& first = conjunct->selectivityAt(0);
+  EXPECT_GT(first.numIn(), 0);
+  EXPECT_LT(first.numOut() * 10, first.numIn());
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -5163,6 +5197,77 @@ TEST_F(ExprTest, disableMemoization) {
   ASSERT_EQ(stats["plus"].numProcessedRows, 3 * flatSize);
 }
 
+TEST_F(ExprTest, valueCache) {
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kExprValueCacheMaxEntries, "100"}});
+  // Strings longer than the inline size with 10 distinct values.
+  auto makeInput = [&](vector_size_t size, int32_t offset) {
+    return makeRowVector({makeFlatVector<std::string>(
+        size,
+        [&](auto row) {
+          return fmt::format("https://host/path/{}", (row + offset) % 10);
+        },
+        nullEvery(7))});
+  };
+  auto expected = [&](vector_size_t size, int32_t offset) {
+    return makeFlatVector<std::string>(
+        size,
+        [&](auto row) { return fmt::format("path/{}", (row + offset) % 10); },
+        nullEvery(7));
+  };
+  const auto rowType = ROW({"c0"}, {VARCHAR()});
+  auto exprSet =
+      compileExpression("regexp_extract(c0, 'path/[0-9]+')", rowType);
+  ASSERT_TRUE(exprSet->expr(0)->hasValueCache());
+
+  auto [result, stats] = evaluateWithStats(exprSet.get(), makeInput(1'000, 0));
+  assertEqualVectors(expected(1'000, 0), result);
+  const auto numNotNull = 1'000 - 1'000 / 7 - 1;
+  EXPECT_EQ(stats["regexp_extract"].numProcessedRows, numNotNull);
+  EXPECT_EQ(stats["regexp_extract"].numValueCacheLookups, numNotNull);
+  EXPECT_EQ(stats["regexp_extract"].numValueCacheHits, 0);
+
+  // The values of a new batch are found in the cache.
+  std::tie(result, stats) = evaluateWithStats(exprSet.get(), makeInput(500, 3));
+  assertEqualVectors(expected(500, 3), result);
+  EXPECT_EQ(stats["regexp_extract"].numProcessedRows, numNotNull);
+  EXPECT_EQ(stats["regexp_extract"].numValueCacheHits, 500 - 500 / 7 - 1);
+
+  // Only the topmost of nested expressions is cached. Expressions over more
+  // than a single string column are not cached.
+  exprSet = compileExpression("length(regexp_extract(c0, '[0-9]+'))", rowType);
+  ASSERT_TRUE(exprSet->expr(0)->hasValueCache());
+  ASSERT_FALSE(exprSet->expr(0)->inputs()[0]->hasValueCache());
+  exprSet = compileExpression(
+      "concat(c0, c1)", ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()}));
+  ASSERT_FALSE(exprSet->expr(0)->hasValueCache());
+  exprSet = compileExpression("c0 + 1", ROW({"c0"}, {BIGINT()}));
+  ASSERT_FALSE(exprSet->expr(0)->hasValueCache());
+
+  // At most 'maxEntries' values are cached.
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kExprValueCacheMaxEntries, "5"}});
+  exprSet = compileExpression("regexp_extract(c0, 'path/[0-9]+')", rowType);
+  evaluateWithStats(exprSet.get(), makeInput(100, 0));
+  std::tie(result, stats) = evaluateWithStats(exprSet.get(), makeInput(100, 0));
+  assertEqualVectors(expected(100, 0), result);
+  const auto numHits = stats["regexp_extract"].numValueCacheHits;
+  EXPECT_GT(numHits, 0);
+  EXPECT_LT(numHits, 100 - 100 / 7 - 1);
+
+  // The cache is disabled if the values do not repeat.
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kExprValueCacheMaxEntries, "100000"}});
+  exprSet = compileExpression("upper(c0)", rowType);
+  ASSERT_TRUE(exprSet->expr(0)->hasValueCache());
+  for (auto i = 0; i < 10; ++i) {
+    auto input = makeRowVector({makeFlatVector<std::string>(
+        1'000, [&](auto row) { return fmt::format("{}", i * 1'000 + row); })});
+    evaluateWithStats(exprSet.get(), input);
+  }
+  EXPECT_FALSE(exprSet->expr(0)->hasValueCache());
+}
+
 TEST_F(ExprTest, disabledeferredLazyLoading) {
   // Verify that deferred lazy loading is disabled when the config is set by
   // confirming that all rows are loaded even when only a subset is required.
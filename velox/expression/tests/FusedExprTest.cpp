@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedExpr.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class FusedExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  // Evaluates 'expr' with and without fusing and checks that the results are
+  // the same. Returns the fused expression or nullptr if 'expr' was not fused.
+  const FusedExpr* assertFused(
+      const std::string& expr,
+      const RowVectorPtr& data,
+      const std::optional<SelectivityVector>& rows = std::nullopt) {
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kExprFuseArithmetic, "false"}});
+    auto expected = evaluate(expr, data, rows);
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kExprFuseArithmetic, "true"}});
+    fusedExprSet_ = compileExpression(expr, asRowType(data->type()));
+    auto actual = evaluate(*fusedExprSet_, data, rows);
+    if (rows.has_value()) {
+      rows->applyToSelected([&](auto row) {
+        ASSERT_TRUE(expected->equalValueAt(actual.get(), row, row)) << row;
+      });
+    } else {
+      velox::test::assertEqualVectors(expected, actual);
+    }
+    return dynamic_cast<const FusedExpr*>(fusedExprSet_->expr(0).get());
+  }
+
+  std::unique_ptr<ExprSet> fusedExprSet_;
+};
+
+TEST_F(FusedExprTest, comparison) {
+  constexpr vector_size_t kSize = 3'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return 3 * row; }),
+  });
+  const auto* fused = assertFused("c0 * 2 + c1 > c2", data);
+  ASSERT_NE(fused, nullptr);
+  ASSERT_EQ(fused->program().size(), 3);
+  EXPECT_EQ(fused->program().back().op, FusedExpr::Op::kGt);
+  EXPECT_EQ(fused->inputs().size(), 4);
+
+  // Nulls in the inputs make the result null.
+  auto withNulls = makeRowVector({
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row; }, nullEvery(5)),
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row % 17; }, nullEvery(7)),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return 3 * row; }),
+  });
+  ASSERT_NE(assertFused("c0 * 2 + c1 > c2", withNulls), nullptr);
+  ASSERT_NE(assertFused("c0 - c1 * c0 <= 10", withNulls), nullptr);
+
+  // Only the selected rows are evaluated.
+  SelectivityVector rows(kSize, false);
+  for (auto row = 0; row < kSize; row += 3) {
+    rows.setValid(row, true);
+  }
+  rows.updateBounds();
+  ASSERT_NE(assertFused("c0 * 2 + c1 = c2", withNulls, rows), nullptr);
+}
+
+TEST_F(FusedExprTest, arithmetic) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(2'000, [](auto row) { return row - 1'000; }),
+      makeFlatVector<int32_t>(2'000, [](auto row) { return row / 3; }),
+      makeFlatVector<double>(2'000, [](auto row) { return row * 0.5; }),
+  });
+  ASSERT_NE(assertFused("c0 * c1 - c0", data), nullptr);
+  ASSERT_NE(assertFused("c2 * c2 + c2", data), nullptr);
+  ASSERT_NE(assertFused("(c2 + c2) * 1.5 < c2", data), nullptr);
+
+  // Dictionary encoded inputs are peeled before fused evaluation.
+  auto indices = makeIndicesInReverse(2'000);
+  auto dictionary = makeRowVector({
+      wrapInDictionary(indices, data->childAt(0)),
+      wrapInDictionary(indices, data->childAt(1)),
+  });
+  ASSERT_NE(assertFused("c0 * c1 - c0", dictionary), nullptr);
+}
+
+TEST_F(FusedExprTest, notFused) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeFlatVector<int32_t>({1, 2, 3}),
+      makeFlatVector<std::string>({"a", "b", "c"}),
+  });
+  // A single function is evaluated as usual.
+  EXPECT_EQ(assertFused("c0 + c0", data), nullptr);
+  // Casts are not fused.
+  EXPECT_EQ(assertFused("c0 + c1 > c0", data), nullptr);
+  // Functions other than arithmetic and comparisons are not fused.
+  EXPECT_EQ(assertFused("c0 % 2 + c0 > 1", data), nullptr);
+  EXPECT_EQ(assertFused("length(c2) + c0 > 1", data), nullptr);
+  // Only the root may be a comparison. Comparisons of booleans are not fused
+  // but their inputs are.
+  EXPECT_EQ(assertFused("(c0 + c0 > 1) = (c0 * 2 > c0)", data), nullptr);
+  const auto& root = fusedExprSet_->expr(0);
+  EXPECT_EQ(dynamic_cast<const FusedExpr*>(root->inputs()[0].get()), nullptr);
+  EXPECT_NE(dynamic_cast<const FusedExpr*>(root->inputs()[1].get()), nullptr);
+}
+
+TEST_F(FusedExprTest, fallback) {
+  // Integer overflow raises the error of the function.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, std::numeric_limits<int64_t>::max()}),
+      makeFlatVector<int64_t>({1, 2, 3}),
+  });
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kExprFuseArithmetic, "true"}});
+  VELOX_ASSERT_THROW(evaluate("c0 * c1 + 1", data), "overflow");
+  // Under TRY the overflowing row is null.
+  EXPECT_EQ(assertFused("try(c0 * c1 + 1)", data), nullptr);
+  EXPECT_NE(
+      dynamic_cast<const FusedExpr*>(
+          fusedExprSet_->expr(0)->inputs()[0].get()),
+      nullptr);
+  auto result = evaluate(*fusedExprSet_, data);
+  EXPECT_TRUE(result->isNullAt(2));
+  EXPECT_FALSE(result->isNullAt(0));
+
+  // NaN is compared by the comparison functions.
+  auto doubles = makeRowVector({
+      makeFlatVector<double>({1.0, std::nan(""), 3.0}),
+      makeFlatVector<double>({1.0, std::nan(""), 2.0}),
+  });
+  ASSERT_NE(assertFused("c0 * 1.0 = c1 + 0.0", doubles), nullptr);
+  ASSERT_NE(assertFused("c0 + c1 > c1 * 2.0", doubles), nullptr);
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
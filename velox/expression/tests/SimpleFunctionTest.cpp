@@ -1611,6 +1611,54 @@ TEST_F(SimpleFunctionTest, callNullFreeNoThrow) {
   EXPECT_EQ(2, result);
 }
 
+template <typename TExec>
+struct LessThanFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(TExec);
+
+  void call(bool& out, const int64_t& a, const int64_t& b) {
+    out = a < b;
+  }
+};
+
+template <typename TExec>
+struct LessThanThrowFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(TExec);
+
+  void call(bool& out, const int64_t& a, const int64_t& b) {
+    VELOX_USER_CHECK_NE(a, 100, "Input must not be 100");
+    out = a < b;
+  }
+};
+
+TEST_F(SimpleFunctionTest, booleanResultWords) {
+  registerFunction<LessThanFunction, bool, int64_t, int64_t>({"less_than"});
+  registerFunction<LessThanThrowFunction, bool, int64_t, int64_t>(
+      {"less_than_throw"});
+
+  constexpr vector_size_t kSize = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return (row * 7) % 500; }),
+  });
+  auto expected = makeFlatVector<bool>(
+      kSize, [](auto row) { return row < (row * 7) % 500; });
+  assertEqualVectors(expected, evaluate("less_than(c0, c1)", data));
+
+  // Flat and constant inputs.
+  expected = makeFlatVector<bool>(kSize, [](auto row) { return row < 333; });
+  assertEqualVectors(expected, evaluate("less_than(c0, 333)", data));
+
+  // A row that throws is evaluated with the other rows one by one.
+  VELOX_ASSERT_THROW(
+      evaluate("less_than_throw(c0, c1)", data), "Input must not be 100");
+  auto result = evaluate("try(less_than_throw(c0, c1))", data);
+  expected = makeFlatVector<bool>(
+      kSize,
+      [](auto row) { return row < (row * 7) % 500; },
+      [](auto row) { return row == 100; });
+  assertEqualVectors(expected, result);
+}
+
 template <typename TExec>
 struct DecimalPlusValueFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
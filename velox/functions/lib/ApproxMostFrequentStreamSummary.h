@@ -38,10 +38,32 @@ namespace facebook::velox::functions {
 ///
 /// Note that the memory allocated by the custom allocator must be
 /// aligned on 16-byte boundary to work with F14 map.
+///
+/// A summary with a capacity of at most kMaxFlatCapacity keeps its values,
+/// counts and an open addressing index of the values in one allocation and
+/// finds the value to evict by a scan of the counts. This uses a fraction of
+/// the memory and allocations of the hash map and heap used for larger
+/// capacities, which matters with many groups. Both layouts track and evict
+/// the same values in the same order.
 template <typename T, typename Allocator = std::allocator<T>>
 struct ApproxMostFrequentStreamSummary {
+  static constexpr int kMaxFlatCapacity = 256;
+
   explicit ApproxMostFrequentStreamSummary(const Allocator& = {});
 
+  ApproxMostFrequentStreamSummary(ApproxMostFrequentStreamSummary&& other);
+
+  /// 'other' must use an equal allocator.
+  ApproxMostFrequentStreamSummary& operator=(
+      ApproxMostFrequentStreamSummary&& other);
+
+  ApproxMostFrequentStreamSummary(const ApproxMostFrequentStreamSummary&) =
+      delete;
+  ApproxMostFrequentStreamSummary& operator=(
+      const ApproxMostFrequentStreamSummary&) = delete;
+
+  ~ApproxMostFrequentStreamSummary();
+
   void setCapacity(int);
 
   /// Add a value with the given count to the summary.
@@ -89,33 +111,142 @@ struct ApproxMostFrequentStreamSummary {
 
   /// Return the pointer to values data.  The number of values equals to size().
   const T* values() const {
-    return queue_.values();
+    return flat_ != nullptr ? flatValues() : queue_.values();
   }
 
   /// Return the pointer to counts data.  The number of counts equals to size().
   const int64_t* counts() const {
-    return queue_.priorities();
+    return flat_ != nullptr ? flatCounts() : queue_.priorities();
   }
 
   bool contains(T value) const {
+    if (flat_ != nullptr) {
+      return flatSlots()[flatSlot(value)] != kEmptySlot;
+    }
     return queue_.getValueIndex(value).has_value();
   }
 
  private:
+  using WordAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<int64_t>;
+
+  static constexpr int32_t kEmptySlot = -1;
+
+  // Orders the values at 'i' and 'j' like IndexedPriorityQueue::compare().
+  int64_t compare(int i, int j) const;
+
+  // The flat layout has 'capacity_' counts, 'capacity_' update generations
+  // that break ties between equal counts, 'capacity_' values and the slots of
+  // the index. A slot has the index of a value or kEmptySlot.
+  int64_t* flatCounts() const {
+    return flat_;
+  }
+
+  int64_t* flatGenerations() const {
+    return flat_ + capacity_;
+  }
+
+  T* flatValues() const {
+    return reinterpret_cast<T*>(flat_ + 2 * capacity_);
+  }
+
+  int32_t* flatSlots() const {
+    return reinterpret_cast<int32_t*>(
+        flat_ + 2 * capacity_ + bits::divRoundUp(capacity_ * sizeof(T), 8));
+  }
+
+  int32_t numFlatSlots() const {
+    return bits::nextPowerOfTwo(2 * capacity_);
+  }
+
+  size_t numFlatWords() const {
+    return 2 * capacity_ + bits::divRoundUp(capacity_ * sizeof(T), 8) +
+        bits::divRoundUp(numFlatSlots() * sizeof(int32_t), 8);
+  }
+
+  // Returns the slot of 'value' or else the empty slot to insert it at.
+  int32_t flatSlot(const T& value) const;
+
+  // Empties 'slot' and moves the values after it that probed past it back.
+  void eraseFlatSlot(int32_t slot);
+
+  // Returns the index of the value with the lowest count. Ties go to the
+  // value updated least recently.
+  int32_t flatMinIndex() const;
+
+  std::optional<T> flatInsert(T value, int64_t count);
+
+  void freeFlat();
+
   int capacity_ = 0;
   IndexedPriorityQueue<T, false, Allocator> queue_;
+
+  WordAllocator wordAllocator_;
+  // Set if 'capacity_' is at most kMaxFlatCapacity.
+  int64_t* flat_{nullptr};
+  int32_t flatSize_{0};
+  int64_t flatGeneration_{0};
 };
 
 template <typename T, typename A>
 ApproxMostFrequentStreamSummary<T, A>::ApproxMostFrequentStreamSummary(
     const A& allocator)
-    : queue_(allocator) {}
+    : queue_(allocator), wordAllocator_(allocator) {}
+
+template <typename T, typename A>
+ApproxMostFrequentStreamSummary<T, A>::ApproxMostFrequentStreamSummary(
+    ApproxMostFrequentStreamSummary&& other)
+    : capacity_(other.capacity_),
+      queue_(std::move(other.queue_)),
+      wordAllocator_(other.wordAllocator_),
+      flat_(other.flat_),
+      flatSize_(other.flatSize_),
+      flatGeneration_(other.flatGeneration_) {
+  other.flat_ = nullptr;
+  other.flatSize_ = 0;
+}
+
+template <typename T, typename A>
+ApproxMostFrequentStreamSummary<T, A>&
+ApproxMostFrequentStreamSummary<T, A>::operator=(
+    ApproxMostFrequentStreamSummary&& other) {
+  if (this == &other) {
+    return *this;
+  }
+  VELOX_CHECK(wordAllocator_ == other.wordAllocator_);
+  freeFlat();
+  capacity_ = other.capacity_;
+  queue_ = std::move(other.queue_);
+  flat_ = other.flat_;
+  flatSize_ = other.flatSize_;
+  flatGeneration_ = other.flatGeneration_;
+  other.flat_ = nullptr;
+  other.flatSize_ = 0;
+  return *this;
+}
+
+template <typename T, typename A>
+ApproxMostFrequentStreamSummary<T, A>::~ApproxMostFrequentStreamSummary() {
+  freeFlat();
+}
+
+template <typename T, typename A>
+void ApproxMostFrequentStreamSummary<T, A>::freeFlat() {
+  if (flat_ != nullptr) {
+    wordAllocator_.deallocate(flat_, numFlatWords());
+    flat_ = nullptr;
+  }
+}
 
 template <typename T, typename A>
 void ApproxMostFrequentStreamSummary<T, A>::setCapacity(int capacity) {
   VELOX_CHECK_GT(capacity, 0);
   if (capacity_ == 0) {
     capacity_ = capacity;
+    if (capacity_ <= kMaxFlatCapacity) {
+      flat_ = wordAllocator_.allocate(numFlatWords());
+      std::fill(flatSlots(), flatSlots() + numFlatSlots(), kEmptySlot);
+    }
   } else {
     VELOX_CHECK_EQ(capacity, capacity_);
   }
@@ -123,7 +254,7 @@ void ApproxMostFrequentStreamSummary<T, A>::setCapacity(int capacity) {
 
 template <typename T, typename A>
 int ApproxMostFrequentStreamSummary<T, A>::size() const {
-  return queue_.size();
+  return flat_ != nullptr ? flatSize_ : queue_.size();
 }
 
 template <typename T, typename A>
@@ -131,10 +262,109 @@ int ApproxMostFrequentStreamSummary<T, A>::capacity() const {
   return capacity_;
 }
 
+template <typename T, typename A>
+int64_t ApproxMostFrequentStreamSummary<T, A>::compare(int i, int j) const {
+  if (flat_ == nullptr) {
+    return queue_.compare(i, j);
+  }
+  const int64_t result = flatCounts()[i] - flatCounts()[j];
+  return result != 0 ? result
+                     : flatGenerations()[i] - flatGenerations()[j];
+}
+
+template <typename T, typename A>
+int32_t ApproxMostFrequentStreamSummary<T, A>::flatSlot(const T& value) const {
+  const auto* slots = flatSlots();
+  const auto* values = flatValues();
+  const int32_t mask = numFlatSlots() - 1;
+  int32_t slot = bits::hashMix(std::hash<T>{}(value), 0) & mask;
+  while (slots[slot] != kEmptySlot && !(values[slots[slot]] == value)) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+template <typename T, typename A>
+void ApproxMostFrequentStreamSummary<T, A>::eraseFlatSlot(int32_t slot) {
+  auto* slots = flatSlots();
+  const auto* values = flatValues();
+  const int32_t mask = numFlatSlots() - 1;
+  auto hole = slot;
+  for (auto next = (hole + 1) & mask; slots[next] != kEmptySlot;
+       next = (next + 1) & mask) {
+    // A value can move back to the hole if the hole is between its home slot
+    // and its current slot.
+    const int32_t home =
+        bits::hashMix(std::hash<T>{}(values[slots[next]]), 0) & mask;
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      slots[hole] = slots[next];
+      hole = next;
+    }
+  }
+  slots[hole] = kEmptySlot;
+}
+
+template <typename T, typename A>
+int32_t ApproxMostFrequentStreamSummary<T, A>::flatMinIndex() const {
+  const auto* counts = flatCounts();
+  const auto* generations = flatGenerations();
+  // The first scan has no branches and vectorizes.
+  int64_t minCount = counts[0];
+  for (auto i = 1; i < flatSize_; ++i) {
+    minCount = std::min(minCount, counts[i]);
+  }
+  int32_t minIndex = -1;
+  for (auto i = 0; i < flatSize_; ++i) {
+    if (counts[i] == minCount &&
+        (minIndex < 0 || generations[i] < generations[minIndex])) {
+      minIndex = i;
+    }
+  }
+  return minIndex;
+}
+
+template <typename T, typename A>
+std::optional<T> ApproxMostFrequentStreamSummary<T, A>::flatInsert(
+    T value,
+    int64_t count) {
+  auto* counts = flatCounts();
+  auto* generations = flatGenerations();
+  auto* values = flatValues();
+  auto* slots = flatSlots();
+  auto slot = flatSlot(value);
+  if (slots[slot] != kEmptySlot) {
+    const auto index = slots[slot];
+    counts[index] += count;
+    generations[index] = ++flatGeneration_;
+    return std::nullopt;
+  }
+  if (flatSize_ < capacity_) {
+    const auto index = flatSize_++;
+    values[index] = value;
+    counts[index] = count;
+    generations[index] = ++flatGeneration_;
+    slots[slot] = index;
+    return std::nullopt;
+  }
+
+  // At capacity - need to evict the minimum entry.
+  const auto index = flatMinIndex();
+  std::optional<T> evictedValue{values[index]};
+  eraseFlatSlot(flatSlot(values[index]));
+  values[index] = value;
+  counts[index] += count;
+  generations[index] = ++flatGeneration_;
+  slots[flatSlot(value)] = index;
+  return evictedValue;
+}
+
 template <typename T, typename A>
 std::optional<T> ApproxMostFrequentStreamSummary<T, A>::insert(
     T value,
     int64_t count) {
+  if (flat_ != nullptr) {
+    return flatInsert(value, count);
+  }
   auto index = queue_.getValueIndex(value);
   if (index.has_value()) {
     const auto oldCount = queue_.priorities()[*index];
@@ -167,12 +397,12 @@ void ApproxMostFrequentStreamSummary<T, A>::topK(
   // elements.
   auto posEnd = reinterpret_cast<int32_t*>(counts + k);
   auto posBeg = posEnd - k;
-  auto gt = [&](auto i, auto j) { return queue_.compare(i, j) > 0; };
+  auto gt = [&](auto i, auto j) { return compare(i, j) > 0; };
   for (int i = 0; i < size(); ++i) {
     if (i < k) {
       posBeg[i] = i;
       std::push_heap(posBeg, posBeg + i + 1, gt);
-    } else if (queue_.compare(i, *posBeg) > 0) {
+    } else if (compare(i, *posBeg) > 0) {
       std::pop_heap(posBeg, posEnd, gt);
       posBeg[k - 1] = i;
       std::push_heap(posBeg, posEnd, gt);
@@ -181,8 +411,8 @@ void ApproxMostFrequentStreamSummary<T, A>::topK(
   std::sort(posBeg, posEnd, gt);
   for (auto it = posBeg; it != posEnd; ++it) {
     auto i = *it;
-    *values++ = queue_.values()[i];
-    *counts++ = queue_.priorities()[i];
+    *values++ = this->values()[i];
+    *counts++ = this->counts()[i];
   }
 }
 
@@ -206,7 +436,7 @@ size_t ApproxMostFrequentStreamSummary<T, A>::serializedByteSize() const {
   size_t ans = sizeof(int32_t) + sizeof(T) * size() + sizeof(int64_t) * size();
   if constexpr (std::is_same_v<T, StringView>) {
     for (int i = 0; i < size(); ++i) {
-      auto& v = queue_.values()[i];
+      auto& v = values()[i];
       if (!v.isInline()) {
         ans += v.size();
       }
@@ -226,14 +456,14 @@ void ApproxMostFrequentStreamSummary<T, A>::serialize(char* out) const {
   folly::storeUnaligned<int32_t>(cur, size());
   cur += sizeof(int32_t);
   auto byteSize = sizeof(T) * size();
-  memcpy(cur, queue_.values(), byteSize);
+  memcpy(cur, values(), byteSize);
   cur += byteSize;
   byteSize = sizeof(int64_t) * size();
-  memcpy(cur, queue_.priorities(), byteSize);
+  memcpy(cur, counts(), byteSize);
   cur += byteSize;
   if constexpr (std::is_same_v<T, StringView>) {
     for (int i = 0; i < size(); ++i) {
-      auto& v = queue_.values()[i];
+      auto& v = values()[i];
       if (!v.isInline()) {
         memcpy(cur, v.data(), v.size());
         cur += v.size();
@@ -16,6 +16,7 @@
 
 #include "velox/functions/lib/DateTimeFormatter.h"
 #include <folly/String.h>
+#include <algorithm>
 #include <charconv>
 #include <cstring>
 #include "velox/common/base/CountBits.h"
@@ -1563,8 +1564,152 @@ int32_t DateTimeFormatter::format(
   return resultSize;
 }
 
+namespace {
+
+// Returns the number of digits of 'pattern' in a fixed-width layout, or 0 if
+// the general parser may read it differently, e.g. a sign or a two-digit year.
+size_t fixedFieldWidth(const FormatPattern& pattern) {
+  switch (pattern.specifier) {
+    case DateTimeFormatSpecifier::YEAR:
+      return pattern.minRepresentDigits == 4 ? 4 : 0;
+    case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+    case DateTimeFormatSpecifier::DAY_OF_MONTH:
+    case DateTimeFormatSpecifier::HOUR_OF_DAY:
+    case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+    case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+      return pattern.minRepresentDigits <= 2 ? 2 : 0;
+    case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+      return pattern.minRepresentDigits == 3 ? 3 : 0;
+    default:
+      return 0;
+  }
+}
+
+uint32_t specifierBit(DateTimeFormatSpecifier specifier) {
+  return 1u << static_cast<uint8_t>(specifier);
+}
+
+} // namespace
+
+void DateTimeFormatter::initFixedWidthLayout() {
+  if (type_ != DateTimeFormatterType::JODA &&
+      type_ != DateTimeFormatterType::MYSQL) {
+    return;
+  }
+  FixedWidthLayout layout;
+  uint32_t specifiers = 0;
+  bool previousIsPattern = false;
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      // A digit in a literal could be read as part of the previous field.
+      if (std::any_of(
+              token.literal.begin(), token.literal.end(), characterIsDigit)) {
+        return;
+      }
+      layout.literals.emplace_back(layout.size, token.literal);
+      layout.size += token.literal.size();
+      previousIsPattern = false;
+      continue;
+    }
+    // Adjacent fields are split by the widths of the pattern rather than
+    // by the digits, and repeated fields are checked against each other.
+    const auto width = fixedFieldWidth(token.pattern);
+    const auto bit = specifierBit(token.pattern.specifier);
+    if (width == 0 || previousIsPattern || (specifiers & bit) != 0) {
+      return;
+    }
+    specifiers |= bit;
+    layout.fields.push_back({token.pattern.specifier, layout.size, width});
+    layout.size += width;
+    previousIsPattern = true;
+  }
+  if (layout.fields.empty()) {
+    return;
+  }
+  if ((specifiers &
+       (specifierBit(DateTimeFormatSpecifier::MONTH_OF_YEAR) |
+        specifierBit(DateTimeFormatSpecifier::DAY_OF_MONTH))) != 0) {
+    layout.defaultYear = 2000;
+  }
+  fixedWidthLayout_ = std::move(layout);
+}
+
+std::optional<DateTimeResult> DateTimeFormatter::tryParseFixedWidth(
+    const std::string_view& input) const {
+  const auto& layout = *fixedWidthLayout_;
+  for (const auto& [offset, literal] : layout.literals) {
+    if (std::memcmp(input.data() + offset, literal.data(), literal.size()) !=
+        0) {
+      return std::nullopt;
+    }
+  }
+
+  int32_t year = layout.defaultYear;
+  int32_t month = 1;
+  int32_t day = 1;
+  int32_t hour = 0;
+  int32_t minute = 0;
+  int32_t second = 0;
+  int32_t microsecond = 0;
+  for (const auto& field : layout.fields) {
+    int32_t number = 0;
+    for (size_t i = 0; i < field.width; ++i) {
+      const char c = input[field.offset + i];
+      if (!characterIsDigit(c)) {
+        return std::nullopt;
+      }
+      number = number * 10 + (c - '0');
+    }
+    switch (field.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        year = number;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        month = number;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        day = number;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        hour = number;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        minute = number;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        second = number;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        microsecond = number * util::kMicrosPerMsec;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  if (month < 1 || month > 12 || hour > 23 || minute > 59 || second > 59 ||
+      !util::isValidDate(year, month, day)) {
+    return std::nullopt;
+  }
+  const auto daysSinceEpoch = util::daysSinceEpochFromDate(year, month, day);
+  if (daysSinceEpoch.hasError()) {
+    return std::nullopt;
+  }
+  return DateTimeResult{
+      util::fromDatetime(
+          daysSinceEpoch.value(),
+          util::fromTime(hour, minute, second, microsecond)),
+      nullptr};
+}
+
 Expected<DateTimeResult> DateTimeFormatter::parse(
     const std::string_view& input) const {
+  if (fixedWidthLayout_.has_value() &&
+      input.size() == fixedWidthLayout_->size) {
+    if (auto result = tryParseFixedWidth(input)) {
+      return *result;
+    }
+  }
+
   Date date;
   const char* cur = input.data();
   const char* end = cur + input.size();
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "velox/common/base/Exceptions.h"
@@ -192,7 +193,9 @@ class DateTimeFormatter {
       : literalBuf_(std::move(literalBuf)),
         bufSize_(bufSize),
         tokens_(std::move(tokens)),
-        type_(type) {}
+        type_(type) {
+    initFixedWidthLayout();
+  }
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -211,6 +214,12 @@ class DateTimeFormatter {
   // Returns Unexpected with UserError status if parsing failed.
   Expected<DateTimeResult> parse(const std::string_view& input) const;
 
+  /// True if parse() reads the inputs of the length of the format without
+  /// interpreting the tokens, e.g. for '%Y-%m-%d %H:%i:%s'.
+  bool hasFixedWidthLayout() const {
+    return fixedWidthLayout_.has_value();
+  }
+
   /// Returns max size of the formatted string. Can be used to preallocate
   /// memory before calling format() to avoid extra copy.
   uint32_t maxResultSize(const tz::TimeZone* timezone) const;
@@ -233,10 +242,38 @@ class DateTimeFormatter {
       const std::optional<std::string>& zeroOffsetText = std::nullopt) const;
 
  private:
+  // A numeric field of a fixed number of digits at a fixed offset.
+  struct FixedWidthField {
+    DateTimeFormatSpecifier specifier;
+    size_t offset;
+    size_t width;
+  };
+
+  // The positions of the fields and literals of a format made of fixed-width
+  // numeric fields separated by literals without digits. The general parser
+  // reads the fields of an input of 'size' bytes at the same positions.
+  struct FixedWidthLayout {
+    std::vector<FixedWidthField> fields;
+    std::vector<std::pair<size_t, std::string_view>> literals;
+    size_t size{0};
+    // The year if the format has no year: 2000 if it has a month or day.
+    int32_t defaultYear{1970};
+  };
+
+  // Sets 'fixedWidthLayout_' if the tokens of a Joda or MySQL format allow it.
+  void initFixedWidthLayout();
+
+  // Parses 'input' of fixedWidthLayout_->size bytes. Returns std::nullopt if
+  // 'input' does not match the layout or has an out of range field, in which
+  // case the general parser is to produce the result or the error.
+  std::optional<DateTimeResult> tryParseFixedWidth(
+      const std::string_view& input) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+  std::optional<FixedWidthLayout> fixedWidthLayout_;
 };
 
 Expected<std::shared_ptr<DateTimeFormatter>> buildMysqlDateTimeFormatter(
@@ -20,6 +20,8 @@
 #include <xxhash.h>
 #include <cmath>
 
+#include <folly/Range.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/common/hyperloglog/Murmur3Hash128.h"
@@ -107,9 +109,13 @@ struct HllAccumulator {
     }
   }
 
+  /// Returns the hash that append() inserts for 'value'.
+  static uint64_t hash(const T& value) {
+    return detail::hashOne<T, HllAsFinalResult>(value);
+  }
+
   void append(T value) {
-    const auto hash = detail::hashOne<T, HllAsFinalResult>(value);
-    insertHash(hash);
+    insertHash(hash(value));
   }
 
   void insertHash(uint64_t hash) {
@@ -123,6 +129,19 @@ struct HllAccumulator {
     }
   }
 
+  /// Same as calling insertHash() for each of 'hashes'. Once the accumulator
+  /// is dense, the remaining hashes go to the dense HLL without checking
+  /// for each hash.
+  void insertHashes(folly::Range<const uint64_t*> hashes) {
+    size_t i = 0;
+    for (; isSparse_ && i < hashes.size(); ++i) {
+      insertHash(hashes[i]);
+    }
+    for (; i < hashes.size(); ++i) {
+      denseHll_.insertHash(hashes[i]);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -138,8 +157,15 @@ struct HllAccumulator {
       SparseHll<TAllocator> other{input, allocator};
       mergeWithSparse(other);
     } else if (DenseHlls::canDeserialize(input)) {
-      DenseHll<TAllocator> other{input, allocator};
-      mergeWithDense(other);
+      // Merges from the serialized digest without copying it into a DenseHll.
+      if (isSparse_) {
+        toDense();
+      }
+      VELOX_USER_CHECK_EQ(
+          indexBitLength_,
+          DenseHlls::deserializeIndexBitLength(input),
+          "Cannot merge HLLs with different number of buckets");
+      denseHll_.mergeWith(input);
     } else {
       VELOX_USER_FAIL("Unexpected type of HLL");
     }
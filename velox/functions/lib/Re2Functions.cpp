@@ -14,6 +14,11 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+
+#include <mutex>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -66,6 +71,42 @@ RE2* ReCache::findOrCompile(const StringView& pattern) {
       [&](const Status& status) { VELOX_USER_FAIL("{}", status.message()); });
 }
 
+std::shared_ptr<const RE2> findOrCompileShared(
+    std::string_view pattern,
+    uint64_t maxMemory) {
+  // The number of regular expressions kept by the cache.
+  constexpr size_t kMaxSharedRegexes = 10'000;
+  struct Entry {
+    std::shared_ptr<const RE2> re;
+  };
+  static std::mutex mutex;
+  static auto* cache =
+      new SimpleLRUCache<std::string, Entry>(kMaxSharedRegexes);
+
+  // The budget is an option of the compiled regular expression.
+  auto key = fmt::format("{}:{}", maxMemory, pattern);
+  {
+    std::lock_guard<std::mutex> l(mutex);
+    if (auto* entry = cache->get(key)) {
+      auto re = entry->re;
+      cache->release(key);
+      return re;
+    }
+  }
+
+  // Compiled outside of the lock. Concurrent misses of a pattern compile it
+  // more than once and keep the first.
+  RE2::Options options{RE2::Quiet};
+  options.set_max_mem(maxMemory);
+  auto re = std::make_shared<const RE2>(toStringPiece(pattern), options);
+  auto entry = std::make_unique<Entry>(Entry{re});
+  std::lock_guard<std::mutex> l(mutex);
+  if (cache->add(std::move(key), entry.get(), 1)) {
+    entry.release();
+  }
+  return re;
+}
+
 } // namespace detail
 
 namespace {
@@ -216,8 +257,8 @@ std::string likePatternToRe2(
 template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public exec::VectorFunction {
  public:
-  explicit Re2MatchConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+  Re2MatchConstantPattern(StringView pattern, uint64_t maxMemory)
+      : re_(detail::findOrCompileShared(pattern, maxMemory)) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -229,25 +270,26 @@ class Re2MatchConstantPattern final : public exec::VectorFunction {
     FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
     exec::LocalDecodedVector toSearch(context, *args[0], rows);
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception&) {
       context.setErrors(rows, std::current_exception());
       return;
     }
 
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-      result.set(i, Fn(toSearch->valueAt<StringView>(i), re_));
+      result.set(i, Fn(toSearch->valueAt<StringView>(i), *re_));
     });
   }
 
  private:
-  RE2 re_;
+  const std::shared_ptr<const RE2> re_;
 };
 
 template <bool (*Fn)(StringView, const RE2&)>
 class Re2Match final : public exec::VectorFunction {
  public:
-  explicit Re2Match(int64_t maxCompiledRegexes) : cache_(maxCompiledRegexes) {}
+  Re2Match(int64_t maxCompiledRegexes, uint64_t regexMaxMemory)
+      : cache_(maxCompiledRegexes), regexMaxMemory_(regexMaxMemory) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -257,8 +299,8 @@ class Re2Match final : public exec::VectorFunction {
       VectorPtr& resultRef) const override {
     VELOX_CHECK_EQ(args.size(), 2);
     if (auto pattern = getIfConstant<StringView>(*args[1])) {
-      Re2MatchConstantPattern<Fn>(*pattern).apply(
-          rows, args, outputType, context, resultRef);
+      Re2MatchConstantPattern<Fn>(*pattern, regexMaxMemory_)
+          .apply(rows, args, outputType, context, resultRef);
       return;
     }
     // General case.
@@ -278,6 +320,7 @@ class Re2Match final : public exec::VectorFunction {
 
  private:
   mutable detail::ReCache cache_;
+  const uint64_t regexMaxMemory_;
 };
 
 void checkForBadGroupId(int64_t groupId, const RE2& re) {
@@ -674,9 +717,11 @@ bool matchSuffixPattern(
 bool matchSubstringPattern(
     const StringView& input,
     const std::string& fixedPattern) {
-  return (
-      std::string_view(input).find(std::string_view(fixedPattern)) !=
-      std::string::npos);
+  return simd::simdStrstr(
+             input.data(),
+             input.size(),
+             fixedPattern.data(),
+             fixedPattern.size()) != std::string::npos;
 }
 
 bool matchSubstringsPattern(
@@ -684,9 +729,8 @@ bool matchSubstringsPattern(
     const std::vector<std::string>& patterns) {
   const char* data = input.data();
   for (int i = 0; i < patterns.size(); i++) {
-    auto curPos =
-        std::string_view(data, input.end() - data)
-            .find(std::string_view(patterns[i].c_str(), patterns[i].size()));
+    auto curPos = simd::simdStrstr(
+        data, input.end() - data, patterns[i].data(), patterns[i].size());
     if (curPos == std::string::npos) {
       return false;
     }
@@ -1278,10 +1322,12 @@ std::shared_ptr<exec::VectorFunction> makeRe2MatchImpl(
 
   if (constantPattern != nullptr && !constantPattern->isNullAt(0)) {
     return std::make_shared<Re2MatchConstantPattern<Fn>>(
-        constantPattern->as<ConstantVector<StringView>>()->valueAt(0));
+        constantPattern->as<ConstantVector<StringView>>()->valueAt(0),
+        config.exprRegexMaxMemory());
   }
 
-  return std::make_shared<Re2Match<Fn>>(config.exprMaxCompiledRegexes());
+  return std::make_shared<Re2Match<Fn>>(
+      config.exprMaxCompiledRegexes(), config.exprRegexMaxMemory());
 }
 
 class RegexpReplaceWithLambdaFunction : public exec::VectorFunction {
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include <re2/re2.h>
@@ -275,6 +276,16 @@ class ReCache {
   uint64_t maxCompiledRegexes_;
 };
 
+/// Returns the regular expression compiled from 'pattern' with at most
+/// 'maxMemory' bytes of program and DFA memory. The result is shared through a
+/// process-wide LRU cache of the most recently used patterns, so the function
+/// instances of all drivers and queries with the same constant pattern match
+/// with one RE2, which is thread safe. The result is not ok() if 'pattern' is
+/// invalid.
+std::shared_ptr<const RE2> findOrCompileShared(
+    std::string_view pattern,
+    uint64_t maxMemory);
+
 } // namespace detail
 
 /// regexp_replace(string, pattern, replacement) -> string
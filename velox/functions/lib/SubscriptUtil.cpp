@@ -404,6 +404,29 @@ VectorPtr MapSubscript::applyMap(
   bool triggerCaching = shouldTriggerCaching(mapArg);
   if (indexArg->type()->isPrimitiveType() &&
       !indexArg->type()->providesCustomComparison()) {
+    // Lookups of constant keys into one map vector, e.g. m['a'], m['b'] and
+    // m['c'] in one expression, share the hash tables of its large maps. The
+    // tables are built from the second lookup on, so that a single lookup
+    // scans the keys.
+    if (!triggerCaching && indexArg->isConstantEncoding() &&
+        !indexArg->type()->isBoolean()) {
+      auto& entry = context.lookupVectorIndex(decodedMap->base(), mapArg);
+      if (entry.numLookups > 1) {
+        auto sharedTable =
+            std::static_pointer_cast<LookupTableBase>(entry.index);
+        auto result = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+            applyMapTyped,
+            indexArg->typeKind(),
+            true,
+            sharedTable,
+            rows,
+            *decodedMap,
+            indexArg,
+            context);
+        entry.index = std::move(sharedTable);
+        return result;
+      }
+    }
     return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
         applyMapTyped,
         indexArg->typeKind(),
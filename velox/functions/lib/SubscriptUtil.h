@@ -74,13 +74,15 @@ using ComplexKeyHashMap = folly::F14FastSet<
 template <typename NativeType>
 class LookupTable;
 
-class LookupTableBase {
+// Hash tables of the keys of the maps of a map vector. Cached by a function
+// for the same map vector over many batches and shared through the EvalCtx by
+// the lookups with constant keys into one map vector in an evaluation.
+class LookupTableBase : public exec::VectorIndex {
  public:
   template <typename NativeType>
   LookupTable<NativeType>* typedTable() {
     return static_cast<LookupTable<NativeType>*>(this);
   }
-  virtual ~LookupTableBase() {}
 };
 
 // NativeType should by TypeTraits<TypeKind>::NativeType for the key's TypeKind.
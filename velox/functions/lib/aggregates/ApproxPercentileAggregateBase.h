@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "velox/common/base/RandomUtil.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/Aggregate.h"
@@ -79,24 +81,52 @@ inline unsigned getRandomSeed(std::optional<uint32_t> fixedRandomSeed) {
 
 /// Aggregate accumulator for KllSketch, supporting weighted insertions
 /// with optimization for large weight values.
+///
+/// A group with few values keeps them in a fixed-size buffer that shares the
+/// storage of the sketch, so that these groups allocate no memory outside of
+/// the row. The sketch is created from the buffered values when the buffer
+/// overflows or a sketch is merged in. Since the sketch stores its first k
+/// values as is, the result is the same as inserting into the sketch
+/// directly.
 template <typename T>
 struct KllSketchAccumulator {
+  /// Number of values a group can have before the sketch is created.
+  static constexpr uint32_t kMaxInlineValues =
+      sizeof(KllSketch<T>) / sizeof(T);
+
   explicit KllSketchAccumulator(
       HashStringAllocator* allocator,
       std::optional<uint32_t> fixedRandomSeed)
-      : sketch_(
-            functions::kll::kDefaultK,
-            StlAllocator<T>(allocator),
-            getRandomSeed(fixedRandomSeed)),
+      : seed_(getRandomSeed(fixedRandomSeed)),
         largeCountValues_(StlAllocator<std::pair<T, int64_t>>(allocator)) {}
 
+  KllSketchAccumulator(const KllSketchAccumulator&) = delete;
+  KllSketchAccumulator& operator=(const KllSketchAccumulator&) = delete;
+
+  ~KllSketchAccumulator() {
+    if (isPromoted()) {
+      std::destroy_at(&sketch_);
+    }
+  }
+
   /// Sets the accuracy of the sketch using the given epsilon value.
   /// The epsilon value is a double in (0, 1] representing the error bound.
   void setAccuracy(double epsilon) {
-    sketch_.setK(functions::kll::kFromEpsilon(epsilon));
+    const auto k = functions::kll::kFromEpsilon(epsilon);
+    if (isPromoted()) {
+      sketch_.setK(k);
+    } else if (k != k_) {
+      VELOX_CHECK_EQ(numInlineValues_, 0);
+      k_ = k;
+    }
   }
 
   void append(T value) {
+    if (numInlineValues_ < kMaxInlineValues) {
+      inlineValues_[numInlineValues_++] = value;
+      return;
+    }
+    promote();
     sketch_.insert(value);
   }
 
@@ -109,7 +139,7 @@ struct KllSketchAccumulator {
     constexpr int64_t kMinCountToBuffer = 512;
     if (count < kMinCountToBuffer) {
       for (int i = 0; i < count; ++i) {
-        sketch_.insert(value);
+        append(value);
       }
     } else {
       largeCountValues_.emplace_back(value, count);
@@ -120,10 +150,11 @@ struct KllSketchAccumulator {
   }
 
   void append(const KllView<T>& view) {
-    sketch_.mergeViews(folly::Range(&view, 1));
+    append(folly::Range(&view, 1));
   }
 
-  void append(const std::vector<KllView<T>>& views) {
+  void append(folly::Range<const KllView<T>*> views) {
+    promote();
     sketch_.mergeViews(views);
   }
 
@@ -135,11 +166,18 @@ struct KllSketchAccumulator {
   // depends on it can lead to concurrency bugs.
   KllSketch<T, std::allocator<T>> compact(
       std::optional<uint32_t> fixedRandomSeed) const {
-    KllSketch<T, std::allocator<T>> newSketch =
-        KllSketch<T, std::allocator<T>>::fromView(
-            sketch_.toView(),
-            std::allocator<T>(),
-            getRandomSeed(fixedRandomSeed));
+    KllSketch<T, std::allocator<T>> newSketch = isPromoted()
+        ? KllSketch<T, std::allocator<T>>::fromView(
+              sketch_.toView(),
+              std::allocator<T>(),
+              getRandomSeed(fixedRandomSeed))
+        : KllSketch<T, std::allocator<T>>(
+              k_, std::allocator<T>(), getRandomSeed(fixedRandomSeed));
+    if (!isPromoted()) {
+      for (uint32_t i = 0; i < numInlineValues_; ++i) {
+        newSketch.insert(inlineValues_[i]);
+      }
+    }
 
     mergeLargeCountValuesIntoSketch(
         std::allocator<T>(), newSketch, fixedRandomSeed);
@@ -149,7 +187,9 @@ struct KllSketchAccumulator {
     return newSketch;
   }
 
+  // Must be called after flush().
   const KllSketch<T>& getSketch() const {
+    VELOX_DCHECK(isPromoted());
     return sketch_;
   }
 
@@ -158,6 +198,7 @@ struct KllSketchAccumulator {
   void flush(
       HashStringAllocator* allocator,
       std::optional<uint32_t> fixedRandomSeed) {
+    promote();
     mergeLargeCountValuesIntoSketch(
         StlAllocator<T>(allocator), sketch_, fixedRandomSeed);
     largeCountValues_.clear();
@@ -166,6 +207,33 @@ struct KllSketchAccumulator {
   }
 
  private:
+  // Marks 'numInlineValues_' once the values are moved to 'sketch_'.
+  static constexpr uint32_t kPromoted = ~0u;
+
+  bool isPromoted() const {
+    return numInlineValues_ == kPromoted;
+  }
+
+  uint32_t k() const {
+    return isPromoted() ? sketch_.k() : k_;
+  }
+
+  // Creates 'sketch_' in place of 'inlineValues_' and inserts the values.
+  void promote() {
+    if (isPromoted()) {
+      return;
+    }
+    std::array<T, kMaxInlineValues> values;
+    const auto numValues = numInlineValues_;
+    std::copy(inlineValues_, inlineValues_ + numValues, values.begin());
+    new (&sketch_) KllSketch<T>(
+        k_, StlAllocator<T>(largeCountValues_.get_allocator()), seed_);
+    numInlineValues_ = kPromoted;
+    for (uint32_t i = 0; i < numValues; ++i) {
+      sketch_.insert(values[i]);
+    }
+  }
+
   template <typename Allocator, typename Compare>
   void mergeLargeCountValuesIntoSketch(
       const Allocator& allocator,
@@ -177,13 +245,20 @@ struct KllSketchAccumulator {
       for (auto [x, n] : largeCountValues_) {
         sketches.push_back(
             functions::kll::KllSketch<T, Allocator, Compare>::fromRepeatedValue(
-                x, n, sketch_.k(), allocator, getRandomSeed(fixedRandomSeed)));
+                x, n, k(), allocator, getRandomSeed(fixedRandomSeed)));
       }
       sketch.merge(folly::Range(sketches.begin(), sketches.end()));
     }
   }
 
-  KllSketch<T> sketch_;
+  uint32_t k_{functions::kll::kDefaultK};
+  const uint32_t seed_;
+  // Number of values in 'inlineValues_', or kPromoted.
+  uint32_t numInlineValues_{0};
+  union {
+    T inlineValues_[kMaxInlineValues];
+    KllSketch<T> sketch_;
+  };
   std::vector<std::pair<T, int64_t>, StlAllocator<std::pair<T, int64_t>>>
       largeCountValues_;
 };
@@ -819,6 +894,9 @@ class ApproxPercentileAggregateBase : public exec::Aggregate {
     std::vector<detail::KllView<T>> views;
     if constexpr (kSingleGroup) {
       views.reserve(rows.end());
+    } else {
+      // Drops the views of a batch that failed validation.
+      groupViews_.clear();
     }
     rows.applyToSelected([&](auto row) {
       if (decoded.isNullAt(row)) {
@@ -894,17 +972,50 @@ class ApproxPercentileAggregateBase : public exec::Aggregate {
       if constexpr (kSingleGroup) {
         views.push_back(v);
       } else {
-        auto tracker = trackRowSize(group[row]);
-        accumulator->append(v);
+        groupViews_.emplace_back(group[row], v);
       }
     });
     if constexpr (kSingleGroup) {
       if (!views.empty()) {
         auto tracker = trackRowSize(group);
-        accumulator->append(views);
+        accumulator->append(folly::Range(views.data(), views.size()));
+      }
+    } else {
+      mergeGroupViews();
+    }
+  }
+
+  // Merges the sketches in 'groupViews_' with one merge per group. Merging
+  // many sketches at once compacts each level once instead of once per
+  // sketch.
+  void mergeGroupViews() {
+    if (groupViews_.size() > 1) {
+      std::stable_sort(
+          groupViews_.begin(),
+          groupViews_.end(),
+          [](const auto& left, const auto& right) {
+            return left.first < right.first;
+          });
+    }
+    std::vector<detail::KllView<T>> views;
+    for (size_t begin = 0; begin < groupViews_.size();) {
+      auto* group = groupViews_[begin].first;
+      auto end = begin;
+      views.clear();
+      while (end < groupViews_.size() && groupViews_[end].first == group) {
+        views.push_back(groupViews_[end++].second);
       }
+      auto tracker = trackRowSize(group);
+      value<detail::KllSketchAccumulator<T>>(group)->append(
+          folly::Range(views.data(), views.size()));
+      begin = end;
     }
+    groupViews_.clear();
   }
+
+  // Sketches of addIntermediateResults() with their groups. Reused across
+  // batches.
+  std::vector<std::pair<char*, detail::KllView<T>>> groupViews_;
 };
 
 } // namespace facebook::velox::functions::aggregate
@@ -68,6 +68,46 @@ struct LongDecimalWithOverflowState {
   int64_t overflow{0};
 };
 
+/// Sums decimals exactly without checking each addition for overflow. The
+/// lower and upper 64 bits of the values are summed apart, which cannot
+/// overflow for fewer than 2^63 values, and the total is added to a
+/// LongDecimalWithOverflowState at the end.
+class LongDecimalSum {
+ public:
+  void add(int128_t value) {
+    lower_ += HugeInt::lower(value);
+    upper_ += static_cast<int64_t>(value >> 64);
+  }
+
+  /// Adds the sum of the values to 'state.sum' and 'state.overflow'. Does not
+  /// change 'state.count'.
+  void addTo(LongDecimalWithOverflowState& state) const {
+    constexpr uint128_t kLower127Bits = ~uint128_t(0) >> 1;
+    // The total is upper_ * 2^64 + lower_. Splits it into overflow * 2^127 +
+    // remainder with 0 <= remainder < 2^127.
+    int64_t overflow = static_cast<int64_t>(upper_ >> 63);
+    uint128_t remainder =
+        (static_cast<uint128_t>(upper_) & (kLower127Bits >> 64)) << 64;
+    remainder += lower_ & kLower127Bits;
+    overflow += static_cast<int64_t>(lower_ >> 127);
+    overflow += static_cast<int64_t>(remainder >> 127);
+    remainder &= kLower127Bits;
+    // A negative total that fits in int128_t is added without overflow, as
+    // addWithOverflow() would.
+    int128_t value = static_cast<int128_t>(remainder);
+    if (overflow < 0 && value != 0) {
+      ++overflow;
+      value += std::numeric_limits<int128_t>::min();
+    }
+    state.overflow +=
+        overflow + DecimalUtil::addWithOverflow(state.sum, state.sum, value);
+  }
+
+ private:
+  uint128_t lower_{0};
+  int128_t upper_{0};
+};
+
 template <typename TResultType, typename TInputType = TResultType>
 class DecimalAggregate : public exec::Aggregate {
  public:
@@ -137,31 +177,21 @@ class DecimalAggregate : public exec::Aggregate {
       });
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
-      LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
-      accumulator.count = rows.countSelected();
-      std::vector<char> rawData(LongDecimalWithOverflowState::serializedSize());
-      StringView serialized(
-          rawData.data(), LongDecimalWithOverflowState::serializedSize());
-      accumulator.serialize(serialized);
-      mergeAccumulators<false>(group, serialized);
+      LongDecimalSum sum;
+      if (rows.isAllSelected()) {
+        for (auto i = rows.begin(); i < rows.end(); ++i) {
+          sum.add(data[i]);
+        }
+      } else {
+        rows.applyToSelected([&](vector_size_t i) { sum.add(data[i]); });
+      }
+      addSum<false>(group, sum, rows.countSelected());
     } else {
-      LongDecimalWithOverflowState accumulator;
+      LongDecimalSum sum;
       rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum,
-            decodedRaw_.valueAt<TInputType>(i),
-            accumulator.sum);
+        sum.add(decodedRaw_.valueAt<TInputType>(i));
       });
-      accumulator.count = rows.countSelected();
-      std::vector<char> rawData(LongDecimalWithOverflowState::serializedSize());
-      StringView serialized(
-          rawData.data(), LongDecimalWithOverflowState::serializedSize());
-      accumulator.serialize(serialized);
-      mergeAccumulators(group, serialized);
+      addSum(group, sum, rows.countSelected());
     }
   }
 
@@ -306,6 +336,16 @@ class DecimalAggregate : public exec::Aggregate {
     accumulator->mergeWith(serialized);
   }
 
+  template <bool tableHasNulls = true>
+  void addSum(char* group, const LongDecimalSum& sum, int64_t count) {
+    if constexpr (tableHasNulls) {
+      exec::Aggregate::clearNull(group);
+    }
+    auto accumulator = decimalAccumulator(group);
+    sum.addTo(*accumulator);
+    accumulator->count += count;
+  }
+
   template <bool tableHasNulls = true>
   void updateNonNullValue(char* group, TResultType value) {
     if constexpr (tableHasNulls) {
@@ -60,6 +60,10 @@ class SimpleNumericMinMaxAggregate : public SimpleNumericAggregate<T, T, T> {
     return true;
   }
 
+  bool supportsGroupRuns() const override {
+    return true;
+  }
+
   void toIntermediate(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
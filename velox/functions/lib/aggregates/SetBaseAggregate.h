@@ -276,6 +276,12 @@ class SetAggAggregate
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
     Base::decoded_.decode(*args[0], rows);
+    if constexpr (kInternsStrings) {
+      if (shouldIntern(rows)) {
+        addDictionaryRawInput(groups, rows);
+        return;
+      }
+    }
     rows.applyToSelected([&](vector_size_t i) {
       auto* group = groups[i];
       Base::clearNull(group);
@@ -309,6 +315,91 @@ class SetAggAggregate
       }
     });
   }
+
+ private:
+  static constexpr bool kInternsStrings = std::is_same_v<
+      AccumulatorType,
+      velox::aggregate::prestosql::detail::StringViewSetAccumulator>;
+
+  // Total size of the strings interned by one aggregate. Past this, strings
+  // are copied into each group.
+  static constexpr uint64_t kMaxInternedBytes = 1 << 20;
+
+  // Returns true if the input is a dictionary with fewer distinct values than
+  // rows, e.g. low cardinality tags.
+  bool shouldIntern(const SelectivityVector& rows) const {
+    const auto& decoded = Base::decoded_;
+    return !decoded.isIdentityMapping() && !decoded.isConstantMapping() &&
+        decoded.base()->isFlatEncoding() &&
+        decoded.base()->size() < rows.countSelected() &&
+        internedBytes_ < kMaxInternedBytes;
+  }
+
+  // Adds a dictionary-encoded input. The non-inline strings are interned once
+  // per aggregate and the groups reference the interned copy instead of
+  // copying the string into each group. Each dictionary entry is looked up in
+  // the interned strings once per batch.
+  void addDictionaryRawInput(char** groups, const SelectivityVector& rows) {
+    const auto& decoded = Base::decoded_;
+    // An empty view marks a dictionary entry that is not interned yet. Non
+    // inline strings are never empty.
+    batchInterned_.assign(decoded.base()->size(), StringView());
+    rows.applyToSelected([&](vector_size_t i) {
+      auto* group = groups[i];
+      Base::clearNull(group);
+
+      auto tracker = Base::trackRowSize(group);
+      auto* accumulator = Base::value(group);
+      if (!decoded.isNullAt(i)) {
+        const auto value = decoded.valueAt<StringView>(i);
+        if (!value.isInline()) {
+          auto& interned = batchInterned_[decoded.index(i)];
+          if (interned.empty()) {
+            interned = intern(value);
+          }
+          if (!interned.empty()) {
+            accumulator->addUnownedValue(interned);
+            return;
+          }
+        }
+      }
+      if constexpr (ignoreNulls) {
+        accumulator->addNonNullValue(decoded, i, Base::allocator_);
+      } else {
+        accumulator->addValue(decoded, i, Base::allocator_);
+      }
+    });
+  }
+
+  // Returns the interned copy of 'value', or an empty view if
+  // kMaxInternedBytes is reached.
+  StringView intern(StringView value) {
+    auto it = internedValues_.find(value);
+    if (it != internedValues_.end()) {
+      return *it;
+    }
+    if (internedBytes_ >= kMaxInternedBytes) {
+      return StringView();
+    }
+    if (internAllocator_ == nullptr) {
+      internAllocator_ =
+          std::make_unique<HashStringAllocator>(Base::allocator_->pool());
+    }
+    const auto copy = internedStrings_.append(value, *internAllocator_);
+    internedValues_.insert(copy);
+    internedBytes_ += value.size();
+    return copy;
+  }
+
+  // Holds the interned strings. The groups reference them until the groups
+  // are extracted, which happens before the aggregate is destroyed.
+  std::unique_ptr<HashStringAllocator> internAllocator_;
+  velox::aggregate::prestosql::Strings internedStrings_;
+  folly::F14FastSet<StringView> internedValues_;
+  uint64_t internedBytes_{0};
+
+  // Interned strings by dictionary index for the current batch.
+  std::vector<StringView> batchInterned_;
 };
 
 } // namespace facebook::velox::functions::aggregate
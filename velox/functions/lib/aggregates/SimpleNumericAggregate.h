@@ -135,6 +135,12 @@ class SimpleNumericAggregate : public exec::Aggregate {
         updateNonNullValue<tableHasNulls, TData>(
             groups[i], TData(decoded.valueAt<TValue>(i)), updateSingleValue);
       });
+    } else if (exec::Aggregate::groupRuns_) {
+      updateGroupRuns<tableHasNulls, TData>(
+          groups,
+          rows,
+          [&](vector_size_t i) { return TData(decoded.valueAt<TValue>(i)); },
+          updateSingleValue);
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
       auto data = decoded.data<TValue>();
       rows.applyToSelected([&](vector_size_t i) {
@@ -149,6 +155,39 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Updates the groups of input clustered by group. Combines the values of
+  // each run of rows of the same group in a register and updates the
+  // accumulator once per run.
+  template <
+      bool tableHasNulls,
+      typename TData,
+      typename GetValue,
+      typename UpdateSingleValue>
+  void updateGroupRuns(
+      char** groups,
+      const SelectivityVector& rows,
+      GetValue getValue,
+      UpdateSingleValue updateSingleValue) {
+    char* runGroup = nullptr;
+    TData runValue{};
+    rows.applyToSelected([&](vector_size_t i) {
+      if (groups[i] == runGroup) {
+        updateSingleValue(runValue, getValue(i));
+        return;
+      }
+      if (runGroup != nullptr) {
+        updateNonNullValue<tableHasNulls, TData>(
+            runGroup, runValue, updateSingleValue);
+      }
+      runGroup = groups[i];
+      runValue = getValue(i);
+    });
+    if (runGroup != nullptr) {
+      updateNonNullValue<tableHasNulls, TData>(
+          runGroup, runValue, updateSingleValue);
+    }
+  }
+
   // TData is used to store the updated group state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
   // sum(real) can differ. TValue is used to decode the update input 'args'.
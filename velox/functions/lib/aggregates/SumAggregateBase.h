@@ -45,6 +45,14 @@ class SumAggregateBase
     return 1;
   }
 
+  /// Wrapping integer sums of a run of rows can be added up in a register
+  /// first. Checked integer sums are not, as a run such as [INT64_MAX, 5]
+  /// added to -10 would fail although row by row it does not. Floating point
+  /// sums are not either, as that would change their rounding.
+  bool supportsGroupRuns() const override {
+    return std::is_integral_v<TAccumulator> && Overflow;
+  }
+
   void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
       override {
     BaseAggregate::template doExtractValues<ResultType>(
@@ -110,6 +118,31 @@ class SumAggregateBase
         TAccumulator(0));
   }
 
+  /// Integer sums retract by subtraction. Floating point sums do not, as
+  /// subtracting would not give back the sum of the remaining rows.
+  bool supportsRetract() const override {
+    return std::is_integral_v<TAccumulator>;
+  }
+
+  void retractSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    if constexpr (std::is_integral_v<TAccumulator>) {
+      BaseAggregate::template updateOneGroup<TAccumulator>(
+          group,
+          rows,
+          args[0],
+          &retractSingleValue<TAccumulator>,
+          // Constant input: sums the values first, then subtracts the sum.
+          &updateDuplicateValues<TAccumulator>,
+          false,
+          TAccumulator(0));
+    } else {
+      VELOX_UNREACHABLE();
+    }
+  }
+
  protected:
   // TData is used to store the updated sum state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
@@ -172,6 +205,18 @@ class SumAggregateBase
           result, functions::checkedMultiply<TData>(TData(n), value));
     }
   }
+
+  template <typename TData>
+#if defined(FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER)
+  FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER("signed-integer-overflow")
+#endif
+  static void retractSingleValue(TData& result, TData value) {
+    if constexpr (Overflow) {
+      result -= value;
+    } else {
+      result = functions::checkedMinus<TData>(result, value);
+    }
+  }
 };
 
 template <typename TInputType>
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/aggregates/DecimalAggregate.h"
+
+#include <folly/Random.h>
+#include <gtest/gtest.h>
+
+namespace facebook::velox::functions::aggregate {
+namespace {
+
+// Returns 'state.sum' + 'state.overflow' * 2^127 as (quotient, remainder)
+// with 0 <= remainder < 2^127, so that equal totals compare equal.
+std::pair<int64_t, int128_t> total(const LongDecimalWithOverflowState& state) {
+  if (state.sum < 0) {
+    return {
+        state.overflow - 1,
+        state.sum - std::numeric_limits<int128_t>::min()};
+  }
+  return {state.overflow, state.sum};
+}
+
+void testSum(const std::vector<int128_t>& values) {
+  LongDecimalWithOverflowState expected;
+  for (auto value : values) {
+    expected.overflow +=
+        DecimalUtil::addWithOverflow(expected.sum, expected.sum, value);
+  }
+
+  LongDecimalWithOverflowState actual;
+  LongDecimalSum sum;
+  for (auto value : values) {
+    sum.add(value);
+  }
+  sum.addTo(actual);
+  EXPECT_EQ(total(actual), total(expected));
+  EXPECT_EQ(
+      DecimalUtil::adjustSumForOverflow(actual.sum, actual.overflow),
+      DecimalUtil::adjustSumForOverflow(expected.sum, expected.overflow));
+  EXPECT_EQ(actual.count, 0);
+
+  // Adding to a non-empty state.
+  sum.addTo(actual);
+  sum.addTo(expected);
+  EXPECT_EQ(total(actual), total(expected));
+}
+
+TEST(DecimalAggregateTest, longDecimalSum) {
+  testSum({});
+  testSum({1, -1});
+  testSum({-1});
+  testSum({-5, 3});
+  testSum({DecimalUtil::kLongDecimalMax, DecimalUtil::kLongDecimalMax});
+  testSum({DecimalUtil::kLongDecimalMin, DecimalUtil::kLongDecimalMin});
+  testSum(
+      {DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMin});
+  testSum(std::vector<int128_t>(1'000, DecimalUtil::kLongDecimalMin));
+
+  folly::Random::DefaultGenerator rng(1);
+  for (auto i = 0; i < 100; ++i) {
+    std::vector<int128_t> values;
+    const auto numValues = folly::Random::rand32(1, 1'000, rng);
+    for (auto j = 0; j < numValues; ++j) {
+      const auto value = HugeInt::build(
+          folly::Random::rand64(rng), folly::Random::rand64(rng));
+      values.push_back(value % DecimalUtil::kLongDecimalMax);
+    }
+    testSum(values);
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::functions::aggregate
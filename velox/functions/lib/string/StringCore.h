@@ -130,6 +130,19 @@ lowerAscii(char* output, const char* input, size_t length) {
   }
 }
 
+namespace detail {
+// Returns the number of leading ASCII bytes in 'input'. Mixed language text
+// has long ASCII runs of spaces, digits and punctuation between the non-ASCII
+// characters, so the case conversion only decodes code points outside them.
+FOLLY_ALWAYS_INLINE size_t asciiPrefixLength(const char* input, size_t length) {
+  size_t i = 0;
+  while (i < length && !(input[i] & 0x80)) {
+    ++i;
+  }
+  return i;
+}
+} // namespace detail
+
 /// Perform upper for utf8 string input, output should be pre-allocated and
 /// large enough for the results. outputLength refers to the number of bytes
 /// available in the output buffer, and inputLength is the number of bytes in
@@ -143,6 +156,15 @@ FOLLY_ALWAYS_INLINE size_t upperUnicode(
   size_t outputIdx = 0;
 
   while (inputIdx < inputLength) {
+    if (const auto asciiLength =
+            detail::asciiPrefixLength(&input[inputIdx], inputLength - inputIdx);
+        asciiLength > 0) {
+      upperAscii(&output[outputIdx], &input[inputIdx], asciiLength);
+      inputIdx += asciiLength;
+      outputIdx += asciiLength;
+      continue;
+    }
+
     utf8proc_int32_t nextCodePoint;
     int size;
     nextCodePoint =
@@ -189,6 +211,17 @@ FOLLY_ALWAYS_INLINE size_t lowerUnicode(
   size_t outputIdx = 0;
 
   while (inputIdx < inputLength) {
+    // The Turkish and Greek final sigma rules only apply to non-ASCII
+    // characters, so ASCII runs take the plain ASCII path.
+    if (const auto asciiLength =
+            detail::asciiPrefixLength(&input[inputIdx], inputLength - inputIdx);
+        asciiLength > 0) {
+      lowerAscii(&output[outputIdx], &input[inputIdx], asciiLength);
+      inputIdx += asciiLength;
+      outputIdx += asciiLength;
+      continue;
+    }
+
     utf8proc_int32_t nextCodePoint;
     int size;
     nextCodePoint =
@@ -264,10 +297,23 @@ applyAppendersRecursive(TOutStr& output, Func appenderFunc, Funcs... funcs) {
  */
 FOLLY_ALWAYS_INLINE int64_t
 lengthUnicode(const char* inputBuffer, size_t bufferLength) {
+  using Batch = xsimd::batch<int8_t>;
+  // Continuation bytes are 0x80 to 0xBF, i.e. -128 to -65 as signed bytes.
+  // Count the other bytes a register at a time.
+  const auto lastContinuationByte = Batch::broadcast(-65);
+  int64_t size = 0;
+  size_t i = 0;
+  for (; i + Batch::size <= bufferLength; i += Batch::size) {
+    const auto bytes =
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(inputBuffer) + i);
+    const auto mask = simd::toBitMask(bytes > lastContinuationByte);
+    size += __builtin_popcountll(
+        static_cast<std::make_unsigned_t<decltype(mask)>>(mask));
+  }
+
   // First address after the last byte in the buffer
   auto buffEndAddress = inputBuffer + bufferLength;
-  auto currentChar = inputBuffer;
-  int64_t size = 0;
+  auto currentChar = inputBuffer + i;
   while (currentChar < buffEndAddress) {
     // This function detects bytes that come after the first byte in a
     // multi-byte UTF-8 character (provided that the string is valid UTF-8). We
@@ -447,11 +493,16 @@ static inline int64_t findNthInstanceByteIndexFromStart(
     return -1;
   }
 
-  auto byteIndex = string.find(subString, startPosition);
+  auto byteIndex = simd::simdStrstr(
+      string.data() + startPosition,
+      string.size() - startPosition,
+      subString.data(),
+      subString.size());
   // Not found
-  if (byteIndex == std::string_view::npos) {
+  if (byteIndex == std::string::npos) {
     return -1;
   }
+  byteIndex += startPosition;
 
   // Search done
   if (instance == 1) {
@@ -46,6 +46,7 @@ class StringImplTest : public testing::Test {
          "АБВГДЕЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ"},
         {"\u0069", "\u0049"},
         {"\u03C3", "\u03A3"},
+        {"abc déjà vu, 42 раза! xyz", "ABC DÉJÀ VU, 42 РАЗА! XYZ"},
         {"i\xCC\x87", "I\xCC\x87"},
         {"\u010B", "\u010A"},
         {"\u0117", "\u0116"},
@@ -90,6 +91,7 @@ class StringImplTest : public testing::Test {
          "абвгдежзийклмнопрстуфхцчшщъыьэюя"},
         {"\u0130", "\u0069"},
         {"\u03A3", "\u03C3"},
+        {"ABC DÉJÀ VU, 42 РАЗА! XYZ", "abc déjà vu, 42 раза! xyz"},
         {"I\xCC\x87", "i\xCC\x87"},
         {"\u010A", "\u010B"},
         {"\u0116", "\u0117"},
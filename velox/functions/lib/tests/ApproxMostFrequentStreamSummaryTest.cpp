@@ -267,6 +267,49 @@ TEST(ApproxMostFrequentStreamSummaryTest, merge) {
   }
 }
 
+// The flat layout of small capacities must track and evict the same values in
+// the same order as the priority queue of large capacities.
+TEST(ApproxMostFrequentStreamSummaryTest, flatLayout) {
+  constexpr int kMaxFlatCapacity =
+      ApproxMostFrequentStreamSummary<int64_t>::kMaxFlatCapacity;
+  std::default_random_engine gen(0);
+  for (int capacity : {1, 2, 7, 64, kMaxFlatCapacity}) {
+    for (int cardinality : {capacity, 3 * capacity + 5, 1'000}) {
+      SCOPED_TRACE(fmt::format("{} {}", capacity, cardinality));
+      ApproxMostFrequentStreamSummary<int64_t> summary;
+      summary.setCapacity(capacity);
+      IndexedPriorityQueue<int64_t, false> expected;
+      std::uniform_int_distribution<int64_t> dist(0, cardinality);
+      for (int i = 0; i < 10'000; ++i) {
+        // Spread the values so that some collide in the index.
+        const int64_t value = dist(gen) << (i % 3 == 0 ? 0 : 10);
+        const int64_t count = 1 + i % 4;
+        std::optional<int64_t> expectedEvicted;
+        if (auto index = expected.getValueIndex(value)) {
+          expected.updatePriority(
+              *index, expected.priorities()[*index] + count);
+        } else if (expected.size() < capacity) {
+          expected.addNewValue(value, count);
+        } else {
+          expectedEvicted = expected.top();
+          expected.replaceTop(value, expected.topPriority() + count);
+        }
+        ASSERT_EQ(summary.insert(value, count), expectedEvicted);
+      }
+      ASSERT_EQ(summary.size(), expected.size());
+      for (int i = 0; i < summary.size(); ++i) {
+        ASSERT_EQ(summary.values()[i], expected.values()[i]);
+        ASSERT_EQ(summary.counts()[i], expected.priorities()[i]);
+        ASSERT_TRUE(summary.contains(summary.values()[i]));
+      }
+
+      auto topK = summary.topK(capacity);
+      auto moved = std::move(summary);
+      ASSERT_EQ(moved.topK(capacity), topK);
+    }
+  }
+}
+
 TEST(ApproxMostFrequentStreamSummaryTest, capacity) {
   constexpr int kCapacity = 30;
   ApproxMostFrequentStreamSummary<int> summary;
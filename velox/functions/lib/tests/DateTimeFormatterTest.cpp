@@ -2328,6 +2328,49 @@ TEST_F(MysqlDateTimeTest, parseConsecutiveSpecifiers) {
   EXPECT_THROW(parseMysql("1212", "%Y%H"), VeloxUserError);
 }
 
+TEST_F(MysqlDateTimeTest, parseFixedWidth) {
+  EXPECT_TRUE(
+      getMysqlDateTimeFormatter("%Y-%m-%d %H:%i:%s")->hasFixedWidthLayout());
+  EXPECT_TRUE(getJodaDateTimeFormatter("dd/MM/yyyy")->hasFixedWidthLayout());
+  EXPECT_TRUE(getJodaDateTimeFormatter("HH:mm:ss.SSS")->hasFixedWidthLayout());
+  EXPECT_FALSE(getMysqlDateTimeFormatter("%Y%m%d")->hasFixedWidthLayout());
+  EXPECT_FALSE(getMysqlDateTimeFormatter("%y-%m-%d")->hasFixedWidthLayout());
+  EXPECT_FALSE(getMysqlDateTimeFormatter("%Y-%b-%d")->hasFixedWidthLayout());
+  EXPECT_FALSE(getJodaDateTimeFormatter("yyyy'1'MM")->hasFixedWidthLayout());
+  EXPECT_FALSE(getMysqlDateTimeFormatter("%d-%d")->hasFixedWidthLayout());
+
+  EXPECT_EQ(
+      fromTimestampString("2019-07-03 11:04:10"),
+      parseMysql("2019-07-03 11:04:10", "%Y-%m-%d %H:%i:%s"));
+  EXPECT_EQ(
+      fromTimestampString("2024-02-29 23:59:59"),
+      parseMysql("2024-02-29 23:59:59", "%Y-%m-%d %H:%i:%s"));
+  EXPECT_EQ(fromTimestampString("2000-12-25"), parseMysql("12/25", "%m/%d"));
+  EXPECT_EQ(
+      fromTimestampString("1970-01-01 10:20:30.456"),
+      parseJoda("10:20:30.456", "HH:mm:ss.SSS").timestamp);
+  EXPECT_EQ(
+      fromTimestampString("2021-01-04"),
+      parseJoda("04/01/2021", "dd/MM/yyyy").timestamp);
+
+  // Inputs of another length and out of range fields go through the general
+  // parser, which reports the errors.
+  EXPECT_EQ(
+      fromTimestampString("2019-07-03 01:04:10"),
+      parseMysql("2019-7-3 1:04:10", "%Y-%m-%d %H:%i:%s"));
+  VELOX_ASSERT_THROW(
+      parseMysql("2023-02-29 00:00:00", "%Y-%m-%d %H:%i:%s"),
+      "Value 29 for dayOfMonth must be in the range [1,28]");
+  EXPECT_THROW(
+      parseMysql("2023-13-01 00:00:00", "%Y-%m-%d %H:%i:%s"), VeloxUserError);
+  EXPECT_THROW(
+      parseMysql("2023-01-01 24:00:00", "%Y-%m-%d %H:%i:%s"), VeloxUserError);
+  EXPECT_THROW(
+      parseMysql("2023-01-01T00:00:00", "%Y-%m-%d %H:%i:%s"), VeloxUserError);
+  EXPECT_THROW(
+      parseMysql("2023-01-0a 00:00:00", "%Y-%m-%d %H:%i:%s"), VeloxUserError);
+}
+
 class SimpleDateTimeFormatterTest : public DateTimeFormatterTest {
  protected:
   DateTimeResult parseSimple(
@@ -21,6 +21,8 @@
 #include <gtest/gtest-typed-test.h>
 #include <gtest/gtest.h>
 
+#include "velox/common/base/tests/GTestUtils.h"
+
 using namespace facebook::velox;
 using namespace facebook::velox::common::hll;
 
@@ -312,6 +314,64 @@ TYPED_TEST(HllAccumulatorTest, mergeWithOverlappingDataSparse) {
   EXPECT_EQ(accumulator1.cardinality(), 150);
 }
 
+TYPED_TEST(HllAccumulatorTest, insertHashes) {
+  using Accumulator = HllAccumulator<int64_t, false, TypeParam>;
+  auto serialize = [](Accumulator& accumulator) {
+    std::string buffer(accumulator.serializedSize(), '\0');
+    accumulator.serialize(buffer.data());
+    return buffer;
+  };
+
+  // The batches turn the accumulator dense in the middle of a batch.
+  Accumulator expected(kDefaultIndexBitLength, this->allocator_);
+  Accumulator accumulator(kDefaultIndexBitLength, this->allocator_);
+  std::vector<uint64_t> hashes;
+  for (int64_t i = 0; i < 10'000; ++i) {
+    expected.append(i);
+    hashes.push_back(Accumulator::hash(i));
+    if (hashes.size() == 700) {
+      accumulator.insertHashes(
+          folly::Range<const uint64_t*>(hashes.data(), hashes.size()));
+      hashes.clear();
+    }
+  }
+  accumulator.insertHashes(
+      folly::Range<const uint64_t*>(hashes.data(), hashes.size()));
+
+  EXPECT_FALSE(accumulator.isSparse());
+  EXPECT_EQ(accumulator.cardinality(), expected.cardinality());
+  EXPECT_EQ(serialize(accumulator), serialize(expected));
+}
+
+TYPED_TEST(HllAccumulatorTest, mergeWithSerializedDataDense) {
+  using Accumulator = HllAccumulator<int64_t, false, TypeParam>;
+  Accumulator dense(kDefaultIndexBitLength, this->allocator_);
+  for (int64_t i = 0; i < 5'000; ++i) {
+    dense.append(i);
+  }
+  ASSERT_FALSE(dense.isSparse());
+  std::string serialized(dense.serializedSize(), '\0');
+  dense.serialize(serialized.data());
+
+  for (const int64_t numSparseValues : {0, 100}) {
+    Accumulator expected(kDefaultIndexBitLength, this->allocator_);
+    Accumulator accumulator(kDefaultIndexBitLength, this->allocator_);
+    for (int64_t i = 0; i < numSparseValues; ++i) {
+      expected.append(-i);
+      accumulator.append(-i);
+    }
+    expected.mergeWith(dense);
+    accumulator.mergeWith(StringView(serialized), this->allocator_);
+    EXPECT_FALSE(accumulator.isSparse());
+    EXPECT_EQ(accumulator.cardinality(), expected.cardinality());
+  }
+
+  Accumulator otherBuckets(kDefaultIndexBitLength + 1, this->allocator_);
+  VELOX_ASSERT_USER_THROW(
+      otherBuckets.mergeWith(StringView(serialized), this->allocator_),
+      "Cannot merge HLLs with different number of buckets");
+}
+
 TYPED_TEST(HllAccumulatorTest, mergeUninitializedAccumulator) {
   HllAccumulator<int64_t, false, TypeParam> accumulator(this->allocator_);
   HllAccumulator<int64_t, false, TypeParam> initialized(
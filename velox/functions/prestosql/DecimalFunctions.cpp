@@ -24,6 +24,12 @@
 namespace facebook::velox::functions {
 namespace {
 
+// Returns true if the sum or difference of values with 'aDigits' and 'bDigits'
+// digits may not fit in a long decimal.
+inline bool mayOverflow(int32_t aDigits, int32_t bDigits) {
+  return std::max(aDigits, bDigits) >= LongDecimalType::kMaxPrecision;
+}
+
 template <typename TExec>
 struct DecimalPlusFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
@@ -34,12 +40,11 @@ struct DecimalPlusFunction {
       const core::QueryConfig& /*config*/,
       A* /*a*/,
       B* /*b*/) {
-    auto aType = inputTypes[0];
-    auto bType = inputTypes[1];
-    auto aScale = getDecimalPrecisionScale(*aType).second;
-    auto bScale = getDecimalPrecisionScale(*bType).second;
+    auto [aPrecision, aScale] = getDecimalPrecisionScale(*inputTypes[0]);
+    auto [bPrecision, bScale] = getDecimalPrecisionScale(*inputTypes[1]);
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    mayOverflow_ = mayOverflow(aPrecision + aRescale_, bPrecision + bRescale_);
   }
 
   template <typename R, typename A, typename B>
@@ -50,6 +55,12 @@ struct DecimalPlusFunction {
 #endif
 #endif
   {
+    if (!mayOverflow_) {
+      out = R(
+          a * DecimalUtil::kPowersOfTen[aRescale_] +
+          b * DecimalUtil::kPowersOfTen[bRescale_]);
+      return;
+    }
     int128_t aRescaled;
     int128_t bRescaled;
     if (__builtin_mul_overflow(
@@ -71,6 +82,9 @@ struct DecimalPlusFunction {
 
   uint8_t aRescale_;
   uint8_t bRescale_;
+  // False if the rescaled inputs have few enough digits that their sum
+  // cannot overflow or be out of range, so the checks are skipped.
+  bool mayOverflow_;
 };
 
 template <typename TExec>
@@ -83,12 +97,11 @@ struct DecimalMinusFunction {
       const core::QueryConfig& /*config*/,
       A* /*a*/,
       B* /*b*/) {
-    const auto& aType = inputTypes[0];
-    const auto& bType = inputTypes[1];
-    auto aScale = getDecimalPrecisionScale(*aType).second;
-    auto bScale = getDecimalPrecisionScale(*bType).second;
+    auto [aPrecision, aScale] = getDecimalPrecisionScale(*inputTypes[0]);
+    auto [bPrecision, bScale] = getDecimalPrecisionScale(*inputTypes[1]);
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    mayOverflow_ = mayOverflow(aPrecision + aRescale_, bPrecision + bRescale_);
   }
 
   template <typename R, typename A, typename B>
@@ -99,6 +112,12 @@ struct DecimalMinusFunction {
 #endif
 #endif
   {
+    if (!mayOverflow_) {
+      out = R(
+          a * DecimalUtil::kPowersOfTen[aRescale_] -
+          b * DecimalUtil::kPowersOfTen[bRescale_]);
+      return;
+    }
     int128_t aRescaled;
     int128_t bRescaled;
     if (__builtin_mul_overflow(
@@ -120,17 +139,39 @@ struct DecimalMinusFunction {
 
   uint8_t aRescale_;
   uint8_t bRescale_;
+  // False if the rescaled inputs have few enough digits that their difference
+  // cannot overflow or be out of range, so the checks are skipped.
+  bool mayOverflow_;
 };
 
 template <typename TExec>
 struct DecimalMultiplyFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
 
+  template <typename A, typename B>
+  void initialize(
+      const std::vector<TypePtr>& inputTypes,
+      const core::QueryConfig& /*config*/,
+      A* /*a*/,
+      B* /*b*/) {
+    const auto aPrecision = getDecimalPrecisionScale(*inputTypes[0]).first;
+    const auto bPrecision = getDecimalPrecisionScale(*inputTypes[1]).first;
+    // The product has at most aPrecision + bPrecision digits.
+    mayOverflow_ = aPrecision + bPrecision > LongDecimalType::kMaxPrecision;
+  }
+
   template <typename R, typename A, typename B>
   void call(R& out, const A& a, const B& b) {
+    if (!mayOverflow_) {
+      out = R(a) * R(b);
+      return;
+    }
     out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
     DecimalUtil::valueInRange(out);
   }
+
+ private:
+  bool mayOverflow_;
 };
 
 template <typename TExec>
@@ -37,6 +37,7 @@
 #include <velox/type/StringView.h>
 #include "velox/common/geospatial/GeometrySerde.h"
 #include "velox/functions/Macros.h"
+#include "velox/functions/prestosql/geospatial/ConstantGeometry.h"
 #include "velox/functions/prestosql/geospatial/GeometryUtils.h"
 #include "velox/functions/prestosql/types/BingTileType.h"
 #include "velox/functions/prestosql/types/GeometryType.h"
@@ -227,10 +228,24 @@ template <typename T>
 struct StContainsFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /* inputTypes */,
+      const core::QueryConfig& /* config */,
+      const arg_type<Geometry>* leftGeometry,
+      const arg_type<Geometry>* /* rightGeometry */) {
+    if (leftGeometry != nullptr) {
+      constantGeometry_ =
+          std::make_unique<geospatial::ConstantGeometry>(*leftGeometry);
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status call(
       out_type<bool>& result,
       const arg_type<Geometry>& leftGeometry,
       const arg_type<Geometry>& rightGeometry) {
+    if (constantGeometry_ != nullptr) {
+      return constantGeometry_->contains(rightGeometry, result);
+    }
     std::unique_ptr<geos::geom::Geometry> leftGeosGeometry =
         common::geospatial::GeometryDeserializer::deserialize(leftGeometry);
     std::unique_ptr<geos::geom::Geometry> rightGeosGeometry =
@@ -249,6 +264,10 @@ struct StContainsFunction {
 
     return Status::OK();
   }
+
+ private:
+  // Set if the container is constant.
+  std::unique_ptr<geospatial::ConstantGeometry> constantGeometry_;
 };
 
 template <typename T>
@@ -343,10 +362,30 @@ template <typename T>
 struct StIntersectsFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /* inputTypes */,
+      const core::QueryConfig& /* config */,
+      const arg_type<Geometry>* leftGeometry,
+      const arg_type<Geometry>* rightGeometry) {
+    // Intersection is symmetric, so either constant argument is cached.
+    if (leftGeometry != nullptr) {
+      constantGeometry_ =
+          std::make_unique<geospatial::ConstantGeometry>(*leftGeometry);
+    } else if (rightGeometry != nullptr) {
+      constantGeometry_ =
+          std::make_unique<geospatial::ConstantGeometry>(*rightGeometry);
+      constantIsLeft_ = false;
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status call(
       out_type<bool>& result,
       const arg_type<Geometry>& leftGeometry,
       const arg_type<Geometry>& rightGeometry) {
+    if (constantGeometry_ != nullptr) {
+      return constantGeometry_->intersects(
+          constantIsLeft_ ? rightGeometry : leftGeometry, result);
+    }
     std::unique_ptr<geos::geom::Geometry> leftGeosGeometry =
         common::geospatial::GeometryDeserializer::deserialize(leftGeometry);
     std::unique_ptr<geos::geom::Geometry> rightGeosGeometry =
@@ -365,6 +404,10 @@ struct StIntersectsFunction {
 
     return Status::OK();
   }
+
+ private:
+  std::unique_ptr<geospatial::ConstantGeometry> constantGeometry_;
+  bool constantIsLeft_{true};
 };
 
 template <typename T>
@@ -427,10 +470,26 @@ template <typename T>
 struct StWithinFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /* inputTypes */,
+      const core::QueryConfig& /* config */,
+      const arg_type<Geometry>* /* leftGeometry */,
+      const arg_type<Geometry>* rightGeometry) {
+    if (rightGeometry != nullptr) {
+      constantGeometry_ =
+          std::make_unique<geospatial::ConstantGeometry>(*rightGeometry);
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status call(
       out_type<bool>& result,
       const arg_type<Geometry>& leftGeometry,
       const arg_type<Geometry>& rightGeometry) {
+    // 'leftGeometry' is within 'rightGeometry' iff 'rightGeometry' contains
+    // 'leftGeometry'.
+    if (constantGeometry_ != nullptr) {
+      return constantGeometry_->contains(leftGeometry, result);
+    }
     std::unique_ptr<geos::geom::Geometry> leftGeosGeometry =
         common::geospatial::GeometryDeserializer::deserialize(leftGeometry);
     std::unique_ptr<geos::geom::Geometry> rightGeosGeometry =
@@ -449,6 +508,10 @@ struct StWithinFunction {
 
     return Status::OK();
   }
+
+ private:
+  // Set if the container is constant.
+  std::unique_ptr<geospatial::ConstantGeometry> constantGeometry_;
 };
 
 // Overlay operations
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/JsonExtractScalars.h"
+
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/ExprRewriteRegistry.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+constexpr const char* kJsonExtractScalars = "$internal$json_extract_scalars";
+
+// The most paths that one $internal$json_extract_scalars call extracts.
+constexpr size_t kMaxPaths = 32;
+
+// $internal$json_extract_scalars(json, path, path...) -> row(varchar...)
+//
+// Returns a struct with the result of json_extract_scalar(json, path) for the
+// i-th path in field i. Parses each document once and extracts all paths
+// from the parsed document.
+class JsonExtractScalarsFunction : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    const auto numPaths = args.size() - 1;
+    std::vector<std::string> paths;
+    paths.reserve(numPaths);
+    for (auto i = 1; i < args.size(); ++i) {
+      VELOX_USER_CHECK(
+          args[i]->isConstantEncoding() && !args[i]->isNullAt(0),
+          "{} requires constant non-null JSON paths",
+          kJsonExtractScalars);
+      paths.push_back(
+          args[i]->asUnchecked<ConstantVector<StringView>>()->valueAt(0).str());
+    }
+
+    std::vector<VectorPtr> children(numPaths);
+    std::vector<FlatVector<StringView>*> flatChildren(numPaths);
+    for (auto i = 0; i < numPaths; ++i) {
+      children[i] = BaseVector::create(VARCHAR(), rows.end(), context.pool());
+      flatChildren[i] = children[i]->asUnchecked<FlatVector<StringView>>();
+    }
+
+    exec::LocalDecodedVector decodedJson(context, *args[0], rows);
+    // Resolved on the first row, so that an invalid path is an error of each
+    // row as in json_extract_scalar().
+    std::vector<SIMDJsonExtractor*> extractors;
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      if (extractors.empty()) {
+        std::vector<SIMDJsonExtractor*> resolved;
+        resolved.reserve(numPaths);
+        for (const auto& path : paths) {
+          resolved.push_back(&SIMDJsonExtractor::getInstance(path));
+        }
+        extractors = std::move(resolved);
+      }
+
+      const auto json = decodedJson->valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(json.data(), json.size());
+      simdjson::ondemand::document doc;
+      if (simdjsonParse(paddedJson).get(doc) || jsonParsingError(doc)) {
+        for (auto* child : flatChildren) {
+          child->setNull(row, true);
+        }
+        return;
+      }
+
+      std::optional<std::string> value;
+      for (auto i = 0; i < numPaths; ++i) {
+        if (i > 0) {
+          doc.rewind();
+        }
+        if (extractJsonScalar(doc, *extractors[i], value) ==
+                simdjson::SUCCESS &&
+            value.has_value()) {
+          flatChildren[i]->set(row, StringView(*value));
+        } else {
+          flatChildren[i]->setNull(row, true);
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+    for (const auto& inputType : {"json", "varchar"}) {
+      signatures.push_back(exec::FunctionSignatureBuilder()
+                               .returnType("row(unknown)")
+                               .argumentType(inputType)
+                               .constantArgumentType("varchar")
+                               .constantVariableArity("varchar")
+                               .build());
+    }
+    return signatures;
+  }
+};
+
+// Returns the path of 'expr' if it is a json_extract_scalar call with a
+// constant path.
+std::optional<std::string> jsonExtractScalarPath(
+    const std::string& prefix,
+    const core::ITypedExpr& expr) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(&expr);
+  if (call == nullptr || call->name() != prefix + "json_extract_scalar" ||
+      call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  const auto* path =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  if (path == nullptr || !path->type()->isVarchar() || path->isNull()) {
+    return std::nullopt;
+  }
+  if (path->hasValueVector()) {
+    return path->valueVector()
+        ->as<SimpleVector<StringView>>()
+        ->valueAt(0)
+        .str();
+  }
+  return path->value().value<TypeKind::VARCHAR>();
+}
+
+// Returns true for the expressions whose inputs are searched for
+// json_extract_scalar calls. Lambdas are not searched since their bodies are
+// evaluated over different rows.
+bool isRewritable(const core::ITypedExpr& expr) {
+  switch (expr.kind()) {
+    case core::ExprKind::kCall:
+    case core::ExprKind::kCast:
+    case core::ExprKind::kDereference:
+    case core::ExprKind::kFieldAccess:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The distinct paths of the json_extract_scalar calls over one input.
+struct PathGroup {
+  core::TypedExprPtr input;
+  std::vector<std::string> paths;
+  // The call that extracts all 'paths'. Set if there are at least 2 paths.
+  core::TypedExprPtr call;
+};
+
+using PathGroups = folly::F14FastMap<
+    const core::ITypedExpr*,
+    PathGroup,
+    core::ITypedExprHasher,
+    core::ITypedExprComparer>;
+
+void collectPaths(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    PathGroups& groups) {
+  if (auto path = jsonExtractScalarPath(prefix, *expr)) {
+    const auto& input = expr->inputs()[0];
+    auto& group = groups[input.get()];
+    if (group.input == nullptr) {
+      group.input = input;
+    }
+    auto& paths = group.paths;
+    if (paths.size() < kMaxPaths &&
+        std::find(paths.begin(), paths.end(), *path) == paths.end()) {
+      paths.push_back(std::move(*path));
+    }
+    return;
+  }
+  if (!isRewritable(*expr)) {
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectPaths(prefix, input, groups);
+  }
+}
+
+// Returns 'expr' with the grouped json_extract_scalar calls replaced by
+// dereferences of the call of their group.
+core::TypedExprPtr replaceCalls(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    const PathGroups& groups) {
+  if (auto path = jsonExtractScalarPath(prefix, *expr)) {
+    auto it = groups.find(expr->inputs()[0].get());
+    if (it == groups.end() || it->second.call == nullptr) {
+      return expr;
+    }
+    const auto& paths = it->second.paths;
+    auto pathIt = std::find(paths.begin(), paths.end(), *path);
+    if (pathIt == paths.end()) {
+      return expr;
+    }
+    return std::make_shared<core::DereferenceTypedExpr>(
+        VARCHAR(), it->second.call, pathIt - paths.begin());
+  }
+  if (!isRewritable(*expr)) {
+    return expr;
+  }
+
+  bool changed = false;
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(replaceCalls(prefix, input, groups));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+
+  switch (expr->kind()) {
+    case core::ExprKind::kCall:
+      return std::make_shared<core::CallTypedExpr>(
+          expr->type(),
+          std::move(inputs),
+          expr->asUnchecked<core::CallTypedExpr>()->name());
+    case core::ExprKind::kCast:
+      return std::make_shared<core::CastTypedExpr>(
+          expr->type(),
+          inputs,
+          expr->asUnchecked<core::CastTypedExpr>()->isTryCast());
+    case core::ExprKind::kDereference:
+      return std::make_shared<core::DereferenceTypedExpr>(
+          expr->type(),
+          inputs[0],
+          expr->asUnchecked<core::DereferenceTypedExpr>()->index());
+    case core::ExprKind::kFieldAccess:
+      return std::make_shared<core::FieldAccessTypedExpr>(
+          expr->type(),
+          inputs[0],
+          expr->asUnchecked<core::FieldAccessTypedExpr>()->name());
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  PathGroups groups;
+  for (const auto& expr : exprs) {
+    collectPaths(prefix, expr, groups);
+  }
+
+  bool grouped = false;
+  for (auto& [_, group] : groups) {
+    const auto numPaths = group.paths.size();
+    if (numPaths < 2) {
+      continue;
+    }
+    std::vector<std::string> names;
+    names.reserve(numPaths);
+    std::vector<core::TypedExprPtr> inputs;
+    inputs.reserve(numPaths + 1);
+    inputs.push_back(group.input);
+    for (auto i = 0; i < numPaths; ++i) {
+      names.push_back(fmt::format("c{}", i));
+      inputs.push_back(std::make_shared<core::ConstantTypedExpr>(
+          VARCHAR(), Variant(group.paths[i])));
+    }
+    group.call = std::make_shared<core::CallTypedExpr>(
+        ROW(std::move(names), VARCHAR()),
+        std::move(inputs),
+        kJsonExtractScalars);
+    grouped = true;
+  }
+  if (!grouped) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(replaceCalls(prefix, expr, groups));
+  }
+  return rewritten;
+}
+
+VELOX_DECLARE_VECTOR_FUNCTION(
+    udf_$internal$_json_extract_scalars,
+    JsonExtractScalarsFunction::signatures(),
+    std::make_unique<JsonExtractScalarsFunction>());
+
+void registerJsonExtractScalars(const std::string& prefix) {
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$_json_extract_scalars, kJsonExtractScalars);
+  expression::ExprRewriteRegistry::instance().registerExprSetRewrite(
+      [prefix](const auto& exprs) {
+        return rewriteJsonExtractScalars(prefix, exprs);
+      });
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+
+namespace facebook::velox::functions {
+
+/// Rewrites the json_extract_scalar calls with constant paths over the same
+/// input in 'exprs', e.g. the expressions of a projection,
+///     json_extract_scalar(j, '$.a'), json_extract_scalar(j, '$.b')
+/// into dereferences of one call that parses 'j' once for all paths
+///     $internal$json_extract_scalars(j, '$.a', '$.b').c0,
+///     $internal$json_extract_scalars(j, '$.a', '$.b').c1
+///
+/// The calls in lambdas are not rewritten. Returns the new expressions or an
+/// empty vector if there are no two calls over the same input.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+/// Registers $internal$json_extract_scalars and the rewrite above.
+void registerJsonExtractScalars(const std::string& prefix);
+
+} // namespace facebook::velox::functions
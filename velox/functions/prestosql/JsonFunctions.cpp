@@ -87,6 +87,50 @@ simdjson::error_code jsonParsingError(const simdjson::padded_string& json) {
   return jsonParsingError(doc);
 }
 
+simdjson::error_code extractJsonScalar(
+    simdjson::ondemand::document& doc,
+    SIMDJsonExtractor& extractor,
+    std::optional<std::string>& result) {
+  bool resultPopulated = false;
+  result = std::nullopt;
+
+  auto consumer = [&result, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        result = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  };
+
+  bool isDefinitePath = true;
+  return extractor.extract(doc, consumer, isDefinitePath);
+}
+
 namespace {
 
 const std::string_view kArrayStart = "[";
@@ -185,6 +185,14 @@ struct JsonArrayGetFunction {
   }
 };
 
+/// Extracts the value at the path of 'extractor' from 'doc' as
+/// json_extract_scalar() does. Sets 'result' to std::nullopt if the path does
+/// not refer to a single boolean, number or string.
+simdjson::error_code extractJsonScalar(
+    simdjson::ondemand::document& doc,
+    SIMDJsonExtractor& extractor,
+    std::optional<std::string>& result);
+
 // json_extract_scalar(json, json_path) -> varchar
 // Like json_extract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -205,42 +213,8 @@ struct JsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
     std::optional<std::string> resultStr;
 
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
-    };
-
     // TODO: Remove explicit std::string_view cast.
     auto& extractor =
         SIMDJsonExtractor::getInstance(std::string_view(jsonPath));
@@ -252,8 +226,7 @@ struct JsonExtractScalarFunction {
       return val;
     }
 
-    bool isDefinitePath = true;
-    SIMDJSON_TRY(extractor.extract(doc, consumer, isDefinitePath));
+    SIMDJSON_TRY(extractJsonScalar(doc, extractor, resultStr));
 
     if (resultStr.has_value()) {
       result.copy_from(*resultStr);
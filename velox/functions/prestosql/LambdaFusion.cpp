@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/JsonExtractScalars.h"
+#include "velox/functions/prestosql/LambdaFusion.h"
+
+#include <folly/container/F14Set.h>
+
+#include "velox/common/base/RuntimeMetrics.h"
+#include "velox/expression/ExprConstants.h"
+#include "velox/expression/ExprRewriteRegistry.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+// Returns the lambda of 'expr' if 'expr' is a call to 'name' with an array and
+// a single-argument lambda, e.g. transform(a, x -> f(x)), or nullptr.
+const core::LambdaTypedExpr* singleArgLambda(
+    const std::string& name,
+    const core::ITypedExpr& expr) {
+  if (!expr.isCallKind() ||
+      expr.asUnchecked<core::CallTypedExpr>()->name() != name ||
+      expr.inputs().size() != 2) {
+    return nullptr;
+  }
+  const auto* lambda =
+      dynamic_cast<const core::LambdaTypedExpr*>(expr.inputs()[1].get());
+  if (lambda == nullptr || lambda->signature()->size() != 1) {
+    return nullptr;
+  }
+  return lambda;
+}
+
+// Returns true for the special forms that evaluate some of their inputs on a
+// subset of rows or suppress their errors.
+bool isConditional(const std::string& name) {
+  return name == expression::kIf || name == expression::kSwitch ||
+      name == expression::kAnd || name == expression::kOr ||
+      name == expression::kCoalesce || name == expression::kTry;
+}
+
+// Describes the body of a lambda.
+struct BodyInfo {
+  // Names of the input columns the body depends on.
+  folly::F14FastSet<std::string> fields;
+
+  // Number of references to the argument.
+  int32_t numReferences{0};
+
+  // True if the argument is referenced under a conditional form.
+  bool conditionalReference{false};
+
+  // False if the body has lambdas or other expressions that are not rewritten.
+  bool rewritable{true};
+};
+
+void collectBodyInfo(
+    const core::ITypedExpr& expr,
+    const std::string& arg,
+    bool conditional,
+    BodyInfo& info) {
+  switch (expr.kind()) {
+    case core::ExprKind::kFieldAccess: {
+      const auto* field = expr.asUnchecked<core::FieldAccessTypedExpr>();
+      if (!field->isInputColumn()) {
+        break;
+      }
+      info.fields.insert(field->name());
+      if (field->name() == arg) {
+        ++info.numReferences;
+        info.conditionalReference |= conditional;
+      }
+      return;
+    }
+    case core::ExprKind::kCall:
+      conditional |=
+          isConditional(expr.asUnchecked<core::CallTypedExpr>()->name());
+      break;
+    case core::ExprKind::kCast:
+      conditional |= expr.asUnchecked<core::CastTypedExpr>()->isTryCast();
+      break;
+    case core::ExprKind::kDereference:
+    case core::ExprKind::kConstant:
+      break;
+    default:
+      info.rewritable = false;
+      return;
+  }
+  for (const auto& input : expr.inputs()) {
+    collectBodyInfo(*input, arg, conditional, info);
+  }
+}
+
+// Returns a copy of 'expr' with 'inputs'. 'expr' is a call, cast, dereference
+// or field access.
+core::TypedExprPtr withInputs(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr> inputs) {
+  switch (expr->kind()) {
+    case core::ExprKind::kCall:
+      return std::make_shared<core::CallTypedExpr>(
+          expr->type(),
+          std::move(inputs),
+          expr->asUnchecked<core::CallTypedExpr>()->name());
+    case core::ExprKind::kCast:
+      return std::make_shared<core::CastTypedExpr>(
+          expr->type(),
+          inputs,
+          expr->asUnchecked<core::CastTypedExpr>()->isTryCast());
+    case core::ExprKind::kDereference:
+      return std::make_shared<core::DereferenceTypedExpr>(
+          expr->type(),
+          inputs[0],
+          expr->asUnchecked<core::DereferenceTypedExpr>()->index());
+    case core::ExprKind::kFieldAccess:
+      return std::make_shared<core::FieldAccessTypedExpr>(
+          expr->type(),
+          inputs[0],
+          expr->asUnchecked<core::FieldAccessTypedExpr>()->name());
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Returns 'expr' with the references to input column 'name' replaced by
+// 'replacement'. 'expr' must be rewritable, see BodyInfo.
+core::TypedExprPtr substitute(
+    const core::TypedExprPtr& expr,
+    const std::string& name,
+    const core::TypedExprPtr& replacement) {
+  if (expr->kind() == core::ExprKind::kFieldAccess) {
+    const auto* field = expr->asUnchecked<core::FieldAccessTypedExpr>();
+    if (field->isInputColumn()) {
+      return field->name() == name ? replacement : expr;
+    }
+  }
+  if (expr->inputs().empty()) {
+    return expr;
+  }
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(substitute(input, name, replacement));
+  }
+  return withInputs(expr, std::move(inputs));
+}
+
+// transform(transform(a, x -> f(x)), y -> g(y)) => transform(a, x -> g(f(x)))
+core::TypedExprPtr fuseTransforms(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  const auto name = prefix + "transform";
+  const auto* outer = singleArgLambda(name, *expr);
+  if (outer == nullptr) {
+    return nullptr;
+  }
+  const auto& innerCall = expr->inputs()[0];
+  const auto* inner = singleArgLambda(name, *innerCall);
+  if (inner == nullptr) {
+    return nullptr;
+  }
+
+  // 'f' is evaluated once per element of 'a' before the transforms are fused,
+  // and so it must be after. Inputs of 'g' other than 'y' could be null or
+  // skip rows and suppress the errors of 'f'.
+  const auto& y = outer->signature()->nameOf(0);
+  BodyInfo info;
+  collectBodyInfo(*outer->body(), y, false, info);
+  if (!info.rewritable || info.numReferences != 1 ||
+      info.conditionalReference || info.fields.size() != 1) {
+    return nullptr;
+  }
+
+  auto lambda = std::make_shared<core::LambdaTypedExpr>(
+      inner->signature(), substitute(outer->body(), y, inner->body()));
+  return std::make_shared<core::CallTypedExpr>(
+      expr->type(), name, innerCall->inputs()[0], lambda);
+}
+
+// filter(filter(a, x -> p(x)), y -> q(y)) =>
+// filter(a, x -> if(p(x), q(x), false))
+core::TypedExprPtr fuseFilters(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  const auto name = prefix + "filter";
+  const auto* outer = singleArgLambda(name, *expr);
+  if (outer == nullptr) {
+    return nullptr;
+  }
+  const auto& innerCall = expr->inputs()[0];
+  const auto* inner = singleArgLambda(name, *innerCall);
+  if (inner == nullptr) {
+    return nullptr;
+  }
+
+  // 'q' is evaluated on the elements for which 'p' is true, as before. A
+  // capture of 'q' named 'x' would be shadowed by the argument of 'p'.
+  const auto& x = inner->signature()->nameOf(0);
+  const auto& y = outer->signature()->nameOf(0);
+  BodyInfo info;
+  collectBodyInfo(*outer->body(), y, false, info);
+  if (!info.rewritable || (x != y && info.fields.count(x) > 0)) {
+    return nullptr;
+  }
+
+  auto q = x == y ? outer->body()
+                  : substitute(
+                        outer->body(),
+                        y,
+                        std::make_shared<core::FieldAccessTypedExpr>(
+                            inner->signature()->childAt(0), x));
+  auto body = std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(),
+      expression::kIf,
+      inner->body(),
+      std::move(q),
+      std::make_shared<core::ConstantTypedExpr>(BOOLEAN(), Variant(false)));
+  auto lambda =
+      std::make_shared<core::LambdaTypedExpr>(inner->signature(), body);
+  return std::make_shared<core::CallTypedExpr>(
+      expr->type(), name, innerCall->inputs()[0], lambda);
+}
+
+// Fuses the chains in 'expr' bottom up, including in lambda bodies.
+core::TypedExprPtr fuseChains(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr,
+    int32_t& numFused) {
+  core::TypedExprPtr result = expr;
+  switch (expr->kind()) {
+    case core::ExprKind::kLambda: {
+      const auto* lambda = expr->asUnchecked<core::LambdaTypedExpr>();
+      auto body = fuseChains(prefix, lambda->body(), numFused);
+      if (body != lambda->body()) {
+        result = std::make_shared<core::LambdaTypedExpr>(
+            lambda->signature(), std::move(body));
+      }
+      return result;
+    }
+    case core::ExprKind::kCall:
+    case core::ExprKind::kCast:
+    case core::ExprKind::kDereference:
+    case core::ExprKind::kFieldAccess:
+      break;
+    default:
+      return result;
+  }
+  if (expr->inputs().empty()) {
+    return result;
+  }
+
+  bool changed = false;
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(fuseChains(prefix, input, numFused));
+    changed |= inputs.back() != input;
+  }
+  if (changed) {
+    result = withInputs(expr, std::move(inputs));
+  }
+
+  for (;;) {
+    auto fused = fuseTransforms(prefix, result);
+    if (fused == nullptr) {
+      fused = fuseFilters(prefix, result);
+    }
+    if (fused == nullptr) {
+      return result;
+    }
+    VLOG(1) << "Rewrite expression: " << result->toString() << " => "
+            << fused->toString();
+    ++numFused;
+    result = std::move(fused);
+  }
+}
+
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteLambdaChains(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  int32_t numFused = 0;
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(fuseChains(prefix, expr, numFused));
+  }
+  if (numFused == 0) {
+    return {};
+  }
+  addThreadLocalRuntimeStat("numLambdaFusion", RuntimeCounter(numFused));
+  return rewritten;
+}
+
+void registerLambdaFusion(const std::string& prefix) {
+  expression::ExprRewriteRegistry::instance().registerExprSetRewrite(
+      [prefix](const auto& exprs) {
+        return rewriteLambdaChains(prefix, exprs);
+      });
+}
+
+} // namespace facebook::velox::functions
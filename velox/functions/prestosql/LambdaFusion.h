@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+
+namespace facebook::velox::functions {
+
+/// Fuses chains of lambda functions over the same array in 'exprs' so that
+/// the intermediate arrays are not materialized:
+///     transform(transform(a, x -> f(x)), y -> g(y)) =>
+///         transform(a, x -> g(f(x)))
+///     filter(filter(a, x -> p(x)), y -> q(y)) =>
+///         filter(a, x -> if(p(x), q(x), false))
+///
+/// The transforms are fused only if 'g' has no lambdas, depends on no field
+/// but 'y' and references it exactly once outside of conditional forms, so
+/// that 'f' is evaluated for the same elements and raises the same errors.
+/// Returns the new expressions or an empty vector if there is nothing to fuse.
+std::vector<core::TypedExprPtr> rewriteLambdaChains(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+/// Registers the rewrite above.
+void registerLambdaFusion(const std::string& prefix);
+
+} // namespace facebook::velox::functions
@@ -15,10 +15,77 @@
  */
 
 #include "velox/expression/VectorFunction.h"
+#include "velox/vector/FlatMapVector.h"
 
 namespace facebook::velox::functions {
 namespace {
 
+// Layout of the entries of the maps of a FlatMapVector as the elements of an
+// ArrayVector. The entries of each map are in the order of the distinct keys.
+struct FlatMapLayout {
+  BufferPtr offsets;
+  BufferPtr sizes;
+  vector_size_t numElements{0};
+  // For each distinct key, the ranges that copy its entries from the rows of
+  // the map values to the elements.
+  std::vector<std::vector<BaseVector::CopyRange>> ranges;
+};
+
+// Returns the layout of the maps of 'flatMap' in 'rows'. Only reads the in-map
+// buffers, so distinct keys that are absent from most rows cost little.
+FlatMapLayout layoutFlatMap(
+    const SelectivityVector& rows,
+    const FlatMapVector& flatMap,
+    memory::MemoryPool* pool) {
+  FlatMapLayout layout;
+  layout.sizes = allocateSizes(rows.end(), pool);
+  layout.offsets = allocateOffsets(rows.end(), pool);
+  auto* rawSizes = layout.sizes->asMutable<vector_size_t>();
+  auto* rawOffsets = layout.offsets->asMutable<vector_size_t>();
+
+  const auto numKeys = flatMap.numDistinctKeys();
+  auto forEachEntry = [&](column_index_t channel, auto func) {
+    if (flatMap.mapValuesAt(channel) == nullptr) {
+      return;
+    }
+    auto addEntry = [&](vector_size_t row) {
+      if (!flatMap.isNullAt(row)) {
+        func(row);
+      }
+    };
+    if (const auto* inMap = flatMap.rawInMapsAt(channel)) {
+      bits::forEachSetBit(
+          inMap, rows.begin(), rows.end(), [&](vector_size_t row) {
+            if (rows.isValid(row)) {
+              addEntry(row);
+            }
+          });
+    } else {
+      rows.applyToSelected(addEntry);
+    }
+  };
+
+  for (column_index_t channel = 0; channel < numKeys; ++channel) {
+    forEachEntry(channel, [&](vector_size_t row) { ++rawSizes[row]; });
+  }
+  rows.applyToSelected([&](vector_size_t row) {
+    rawOffsets[row] = layout.numElements;
+    layout.numElements += rawSizes[row];
+  });
+
+  // 'rawSizes' counts the entries placed so far while the ranges are built.
+  std::fill(rawSizes, rawSizes + rows.end(), 0);
+  layout.ranges.resize(numKeys);
+  for (column_index_t channel = 0; channel < numKeys; ++channel) {
+    forEachEntry(channel, [&](vector_size_t row) {
+      layout.ranges[channel].push_back(
+          {row, rawOffsets[row] + rawSizes[row], 1});
+      ++rawSizes[row];
+    });
+  }
+  return layout;
+}
+
 class MapKeyValueFunction : public exec::VectorFunction {
  public:
   void apply(
@@ -73,6 +140,10 @@ class MapKeysFunction : public MapKeyValueFunction {
         "Unsupported type for map_keys function {}",
         TypeKindName::toName(arg->typeKind()));
 
+    if (arg->encoding() == VectorEncoding::Simple::FLAT_MAP) {
+      return applyFlatMap(rows, *arg->as<FlatMapVector>(), context);
+    }
+
     auto mapVector = arg->as<MapVector>();
     auto mapKeys = mapVector->mapKeys();
     return std::make_shared<ArrayVector>(
@@ -86,6 +157,32 @@ class MapKeysFunction : public MapKeyValueFunction {
         mapVector->getNullCount());
   }
 
+  // The keys are a dictionary over the distinct keys of 'flatMap'.
+  static VectorPtr applyFlatMap(
+      const SelectivityVector& rows,
+      const FlatMapVector& flatMap,
+      exec::EvalCtx& context) {
+    auto layout = layoutFlatMap(rows, flatMap, context.pool());
+    auto indices = allocateIndices(layout.numElements, context.pool());
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    for (column_index_t channel = 0; channel < layout.ranges.size();
+         ++channel) {
+      for (const auto& range : layout.ranges[channel]) {
+        rawIndices[range.targetIndex] = channel;
+      }
+    }
+    return std::make_shared<ArrayVector>(
+        context.pool(),
+        ARRAY(flatMap.keyType()),
+        flatMap.nulls(),
+        rows.end(),
+        std::move(layout.offsets),
+        std::move(layout.sizes),
+        BaseVector::wrapInDictionary(
+            nullptr, indices, layout.numElements, flatMap.distinctKeys()),
+        flatMap.getNullCount());
+  }
+
   static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
     // map(K,V) -> array(K)
     return {exec::FunctionSignatureBuilder()
@@ -110,6 +207,10 @@ class MapValuesFunction : public MapKeyValueFunction {
         "Unsupported type for map_values function {}",
         TypeKindName::toName(arg->typeKind()));
 
+    if (arg->encoding() == VectorEncoding::Simple::FLAT_MAP) {
+      return applyFlatMap(rows, *arg->as<FlatMapVector>(), context);
+    }
+
     auto mapVector = arg->as<MapVector>();
     auto mapValues = mapVector->mapValues();
     return std::make_shared<ArrayVector>(
@@ -123,6 +224,32 @@ class MapValuesFunction : public MapKeyValueFunction {
         mapVector->getNullCount());
   }
 
+  // The values are copied from the map values of each distinct key.
+  static VectorPtr applyFlatMap(
+      const SelectivityVector& rows,
+      const FlatMapVector& flatMap,
+      exec::EvalCtx& context) {
+    auto layout = layoutFlatMap(rows, flatMap, context.pool());
+    auto values = BaseVector::create(
+        flatMap.valueType(), layout.numElements, context.pool());
+    for (column_index_t channel = 0; channel < layout.ranges.size();
+         ++channel) {
+      const auto& ranges = layout.ranges[channel];
+      if (!ranges.empty()) {
+        values->copyRanges(flatMap.mapValuesAt(channel).get(), ranges);
+      }
+    }
+    return std::make_shared<ArrayVector>(
+        context.pool(),
+        ARRAY(flatMap.valueType()),
+        flatMap.nulls(),
+        rows.end(),
+        std::move(layout.offsets),
+        std::move(layout.sizes),
+        std::move(values),
+        flatMap.getNullCount());
+  }
+
   static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
     // map(K,V) -> array(V)
     return {exec::FunctionSignatureBuilder()
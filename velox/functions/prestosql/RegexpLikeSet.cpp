@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/RegexpLikeSet.h"
+
+#include <algorithm>
+
+#include <folly/container/F14Map.h>
+#include <re2/set.h>
+
+#include "velox/expression/ExprConstants.h"
+#include "velox/expression/ExprRewriteRegistry.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/lib/Re2Functions.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+constexpr const char* kRegexpLikeSet = "$internal$regexp_like_set";
+
+re2::StringPiece toStringPiece(const StringView& s) {
+  return re2::StringPiece(s.data(), s.size());
+}
+
+// $internal$regexp_like_set(string, pattern, pattern...) -> row(boolean...)
+//
+// Returns a struct with the result of regexp_like(string, pattern) for the
+// i-th pattern in field i. The patterns are compiled into one RE2::Set, which
+// finds all the matching patterns in one pass over each string.
+class RegexpLikeSetFunction : public exec::VectorFunction {
+ public:
+  RegexpLikeSetFunction(
+      const std::vector<std::string>& patterns,
+      uint64_t maxMemory)
+      : set_(makeOptions(maxMemory), RE2::UNANCHORED) {
+    regexes_.reserve(patterns.size());
+    bool valid = true;
+    for (const auto& pattern : patterns) {
+      regexes_.push_back(detail::findOrCompileShared(pattern, maxMemory));
+      valid &= set_.Add(pattern, nullptr) >= 0;
+    }
+    // The set is not used if it does not fit in 'maxMemory'.
+    setCompiled_ = valid && set_.Compile();
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    for (const auto& re : regexes_) {
+      if (!re->ok()) {
+        try {
+          VELOX_USER_FAIL("invalid regular expression:{}", re->error());
+        } catch (const std::exception&) {
+          context.setErrors(rows, std::current_exception());
+        }
+        return;
+      }
+    }
+
+    const auto numPatterns = regexes_.size();
+    std::vector<VectorPtr> children(numPatterns);
+    std::vector<FlatVector<bool>*> flatChildren(numPatterns);
+    for (auto i = 0; i < numPatterns; ++i) {
+      children[i] = BaseVector::create(BOOLEAN(), rows.end(), context.pool());
+      flatChildren[i] = children[i]->asUnchecked<FlatVector<bool>>();
+    }
+
+    exec::LocalDecodedVector decoded(context, *args[0], rows);
+    std::vector<int> matches;
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      const auto str = toStringPiece(decoded->valueAt<StringView>(row));
+      RE2::Set::ErrorInfo errorInfo;
+      if (setCompiled_ &&
+          (set_.Match(str, &matches, &errorInfo) ||
+           errorInfo.kind == RE2::Set::kNoError)) {
+        for (auto* child : flatChildren) {
+          child->set(row, false);
+        }
+        for (auto i : matches) {
+          flatChildren[i]->set(row, true);
+        }
+        return;
+      }
+      // The DFA of the set ran out of memory. Matches each pattern, which
+      // falls back to a slower matcher only for the patterns that need to.
+      for (auto i = 0; i < numPatterns; ++i) {
+        flatChildren[i]->set(row, RE2::PartialMatch(str, *regexes_[i]));
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    return {exec::FunctionSignatureBuilder()
+                .returnType("row(unknown)")
+                .argumentType("varchar")
+                .constantArgumentType("varchar")
+                .constantVariableArity("varchar")
+                .build()};
+  }
+
+ private:
+  static RE2::Options makeOptions(uint64_t maxMemory) {
+    RE2::Options options{RE2::Quiet};
+    options.set_max_mem(maxMemory);
+    return options;
+  }
+
+  RE2::Set set_;
+  bool setCompiled_{false};
+  // The patterns compiled one by one. Used if the set does not fit in memory.
+  std::vector<std::shared_ptr<const RE2>> regexes_;
+};
+
+std::shared_ptr<exec::VectorFunction> makeRegexpLikeSet(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config) {
+  std::vector<std::string> patterns;
+  patterns.reserve(inputArgs.size() - 1);
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto& pattern = inputArgs[i].constantValue;
+    VELOX_USER_CHECK(
+        pattern != nullptr && !pattern->isNullAt(0),
+        "{} requires constant non-null patterns",
+        name);
+    patterns.push_back(
+        pattern->as<ConstantVector<StringView>>()->valueAt(0).str());
+  }
+  return std::make_shared<RegexpLikeSetFunction>(
+      patterns, config.exprRegexMaxMemory());
+}
+
+// Returns the pattern of 'expr' if it is a regexp_like call with a constant
+// valid pattern.
+std::optional<std::string> regexpLikePattern(
+    const std::string& prefix,
+    const core::ITypedExpr& expr) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(&expr);
+  if (call == nullptr || call->name() != prefix + "regexp_like" ||
+      call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  const auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  if (constant == nullptr || !constant->type()->isVarchar() ||
+      constant->isNull()) {
+    return std::nullopt;
+  }
+  auto pattern = constant->hasValueVector()
+      ? constant->valueVector()
+            ->as<SimpleVector<StringView>>()
+            ->valueAt(0)
+            .str()
+      : constant->value().value<TypeKind::VARCHAR>();
+  // An invalid pattern is an error of the rows that evaluate its call, which
+  // the set would raise for all rows.
+  if (!RE2(pattern, RE2::Quiet).ok()) {
+    return std::nullopt;
+  }
+  return pattern;
+}
+
+bool isCall(const core::ITypedExpr& expr, const char* name) {
+  return expr.isCallKind() &&
+      expr.asUnchecked<core::CallTypedExpr>()->name() == name;
+}
+
+// Returns true if input 'index' of 'expr' is a condition whose regexp_like
+// calls are grouped: the conditions of the cases of a switch or if and the
+// operands of an or.
+bool isCondition(const core::ITypedExpr& expr, size_t index) {
+  if (isCall(expr, expression::kOr)) {
+    return true;
+  }
+  if (isCall(expr, expression::kSwitch) || isCall(expr, expression::kIf)) {
+    return index % 2 == 0 && index + 1 < expr.inputs().size();
+  }
+  return false;
+}
+
+// Returns true for the expressions whose inputs are searched for switch, if
+// and or. Lambdas are not searched since their bodies are evaluated over
+// different rows.
+bool isRewritable(const core::ITypedExpr& expr) {
+  switch (expr.kind()) {
+    case core::ExprKind::kCall:
+    case core::ExprKind::kCast:
+    case core::ExprKind::kDereference:
+    case core::ExprKind::kFieldAccess:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The distinct patterns of the regexp_like calls over one input among the
+// conditions of a switch, if or or.
+struct PatternGroup {
+  core::TypedExprPtr input;
+  std::vector<std::string> patterns;
+  // The call that matches all 'patterns'. Set if there are at least 2.
+  core::TypedExprPtr call;
+};
+
+using PatternGroups = folly::F14FastMap<
+    const core::ITypedExpr*,
+    PatternGroup,
+    core::ITypedExprHasher,
+    core::ITypedExprComparer>;
+
+// Adds the patterns of the regexp_like calls of 'condition' to 'groups'. Goes
+// into the operands of an or.
+void collectPatterns(
+    const std::string& prefix,
+    const core::TypedExprPtr& condition,
+    PatternGroups& groups) {
+  if (auto pattern = regexpLikePattern(prefix, *condition)) {
+    const auto& input = condition->inputs()[0];
+    auto& group = groups[input.get()];
+    if (group.input == nullptr) {
+      group.input = input;
+    }
+    auto& patterns = group.patterns;
+    if (std::find(patterns.begin(), patterns.end(), *pattern) ==
+        patterns.end()) {
+      patterns.push_back(std::move(*pattern));
+    }
+    return;
+  }
+  if (isCall(*condition, expression::kOr)) {
+    for (const auto& input : condition->inputs()) {
+      collectPatterns(prefix, input, groups);
+    }
+  }
+}
+
+void makeCalls(PatternGroups& groups) {
+  for (auto& [_, group] : groups) {
+    const auto numPatterns = group.patterns.size();
+    if (numPatterns < 2) {
+      continue;
+    }
+    std::vector<std::string> names;
+    names.reserve(numPatterns);
+    std::vector<core::TypedExprPtr> inputs;
+    inputs.reserve(numPatterns + 1);
+    inputs.push_back(group.input);
+    for (auto i = 0; i < numPatterns; ++i) {
+      names.push_back(fmt::format("c{}", i));
+      inputs.push_back(std::make_shared<core::ConstantTypedExpr>(
+          VARCHAR(), Variant(group.patterns[i])));
+    }
+    group.call = std::make_shared<core::CallTypedExpr>(
+        ROW(std::move(names), BOOLEAN()), std::move(inputs), kRegexpLikeSet);
+  }
+}
+
+core::TypedExprPtr withInputs(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr> inputs) {
+  switch (expr->kind()) {
+    case core::ExprKind::kCall:
+      return std::make_shared<core::CallTypedExpr>(
+          expr->type(),
+          std::move(inputs),
+          expr->asUnchecked<core::CallTypedExpr>()->name());
+    case core::ExprKind::kCast:
+      return std::make_shared<core::CastTypedExpr>(
+          expr->type(),
+          inputs,
+          expr->asUnchecked<core::CastTypedExpr>()->isTryCast());
+    case core::ExprKind::kDereference:
+      return std::make_shared<core::DereferenceTypedExpr>(
+          expr->type(),
+          inputs[0],
+          expr->asUnchecked<core::DereferenceTypedExpr>()->index());
+    case core::ExprKind::kFieldAccess:
+      return std::make_shared<core::FieldAccessTypedExpr>(
+          expr->type(),
+          inputs[0],
+          expr->asUnchecked<core::FieldAccessTypedExpr>()->name());
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+core::TypedExprPtr rewrite(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
+// Returns 'condition' with its grouped regexp_like calls replaced by
+// dereferences of the call of their group.
+core::TypedExprPtr replaceCalls(
+    const std::string& prefix,
+    const core::TypedExprPtr& condition,
+    const PatternGroups& groups) {
+  if (auto pattern = regexpLikePattern(prefix, *condition)) {
+    auto it = groups.find(condition->inputs()[0].get());
+    if (it == groups.end() || it->second.call == nullptr) {
+      return condition;
+    }
+    const auto& patterns = it->second.patterns;
+    auto patternIt = std::find(patterns.begin(), patterns.end(), *pattern);
+    VELOX_CHECK(patternIt != patterns.end());
+    return std::make_shared<core::DereferenceTypedExpr>(
+        BOOLEAN(), it->second.call, patternIt - patterns.begin());
+  }
+  if (!isCall(*condition, expression::kOr)) {
+    return rewrite(prefix, condition);
+  }
+
+  bool changed = false;
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(condition->inputs().size());
+  for (const auto& input : condition->inputs()) {
+    inputs.push_back(replaceCalls(prefix, input, groups));
+    changed |= inputs.back() != input;
+  }
+  return changed ? withInputs(condition, std::move(inputs)) : condition;
+}
+
+// Returns 'expr' with the regexp_like calls of the conditions of each switch,
+// if and or grouped.
+core::TypedExprPtr rewrite(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  if (!isRewritable(*expr)) {
+    return expr;
+  }
+  const auto& inputs = expr->inputs();
+  PatternGroups groups;
+  for (auto i = 0; i < inputs.size(); ++i) {
+    if (isCondition(*expr, i)) {
+      collectPatterns(prefix, inputs[i], groups);
+    }
+  }
+  makeCalls(groups);
+
+  bool changed = false;
+  std::vector<core::TypedExprPtr> newInputs;
+  newInputs.reserve(inputs.size());
+  for (auto i = 0; i < inputs.size(); ++i) {
+    newInputs.push_back(
+        isCondition(*expr, i) ? replaceCalls(prefix, inputs[i], groups)
+                              : rewrite(prefix, inputs[i]));
+    changed |= newInputs.back() != inputs[i];
+  }
+  return changed ? withInputs(expr, std::move(newInputs)) : expr;
+}
+
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteRegexpLikes(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  bool changed = false;
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(rewrite(prefix, expr));
+    changed |= rewritten.back() != expr;
+  }
+  if (!changed) {
+    return {};
+  }
+  return rewritten;
+}
+
+void registerRegexpLikeSet(const std::string& prefix) {
+  exec::registerStatefulVectorFunction(
+      kRegexpLikeSet,
+      RegexpLikeSetFunction::signatures(),
+      makeRegexpLikeSet);
+  expression::ExprRewriteRegistry::instance().registerExprSetRewrite(
+      [prefix](const auto& exprs) {
+        return rewriteRegexpLikes(prefix, exprs);
+      });
+}
+
+} // namespace facebook::velox::functions
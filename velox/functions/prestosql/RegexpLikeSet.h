@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+
+namespace facebook::velox::functions {
+
+/// Rewrites the regexp_like calls with constant patterns over the same input
+/// among the conditions of a switch, if or or, e.g.
+///     CASE WHEN regexp_like(s, 'a') THEN 1 WHEN regexp_like(s, 'b') THEN 2 END
+/// into dereferences of one call that matches 's' with all patterns in one pass
+///     CASE WHEN $internal$regexp_like_set(s, 'a', 'b').c0 THEN 1
+///          WHEN $internal$regexp_like_set(s, 'a', 'b').c1 THEN 2 END
+///
+/// Calls with invalid patterns and calls in lambdas are not rewritten. Returns
+/// the new expressions or an empty vector if there is nothing to rewrite.
+std::vector<core::TypedExprPtr> rewriteRegexpLikes(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+/// Registers $internal$regexp_like_set and the rewrite above.
+void registerRegexpLikeSet(const std::string& prefix);
+
+} // namespace facebook::velox::functions
@@ -69,6 +69,47 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     }
   }
 
+  bool supportsAddRawClusteredInput() const override {
+    return clusteredInput_;
+  }
+
+  // Adds the count of each run of rows of the same group at once.
+  void addRawClusteredInput(
+      char** groups,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      const folly::Range<const vector_size_t*>& groupBoundaries) override {
+    VELOX_CHECK(clusteredInput_);
+    DecodedVector decoded;
+    bool mayHaveNulls{false};
+    if (!args.empty()) {
+      decoded.decode(*args[0], rows);
+      if (decoded.isConstantMapping() && decoded.isNullAt(0)) {
+        return;
+      }
+      mayHaveNulls = !decoded.isConstantMapping() && decoded.mayHaveNulls();
+    }
+
+    const bool allSelected = rows.isAllSelected();
+    vector_size_t groupStart = 0;
+    for (auto groupEnd : groupBoundaries) {
+      int64_t count = 0;
+      if (allSelected && !mayHaveNulls) {
+        count = groupEnd - groupStart;
+      } else {
+        for (auto i = groupStart; i < groupEnd; ++i) {
+          if (rows.isValid(i) && !(mayHaveNulls && decoded.isNullAt(i))) {
+            ++count;
+          }
+        }
+      }
+      if (count > 0) {
+        addToGroup(groups[groupEnd - 1], count);
+      }
+      groupStart = groupEnd;
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -85,27 +126,18 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
-    if (args.empty()) {
-      addToGroup(group, rows.countSelected());
-      return;
-    }
+    addToGroup(group, countNonNull(rows, args));
+  }
 
-    DecodedVector decoded(*args[0], rows);
-    if (decoded.isConstantMapping()) {
-      if (!decoded.isNullAt(0)) {
-        addToGroup(group, rows.countSelected());
-      }
-    } else if (decoded.mayHaveNulls()) {
-      int64_t nonNullCount = 0;
-      rows.applyToSelected([&](vector_size_t i) {
-        if (!decoded.isNullAt(i)) {
-          ++nonNullCount;
-        }
-      });
-      addToGroup(group, nonNullCount);
-    } else {
-      addToGroup(group, rows.countSelected());
-    }
+  bool supportsRetract() const override {
+    return true;
+  }
+
+  void retractSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    addToGroup(group, -countNonNull(rows, args));
   }
 
   void addSingleGroupIntermediateResults(
@@ -142,6 +174,30 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
   }
 
  private:
+  // Returns the number of 'rows' that count(*) or count(x) counts.
+  static int64_t countNonNull(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    if (args.empty()) {
+      return rows.countSelected();
+    }
+
+    DecodedVector decoded(*args[0], rows);
+    if (decoded.isConstantMapping()) {
+      return decoded.isNullAt(0) ? 0 : rows.countSelected();
+    }
+    if (decoded.mayHaveNulls()) {
+      int64_t nonNullCount = 0;
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          ++nonNullCount;
+        }
+      });
+      return nonNullCount;
+    }
+    return rows.countSelected();
+  }
+
   inline void addToGroup(char* group, int64_t count) {
     *value<int64_t>(group) += count;
   }
@@ -184,19 +184,37 @@ class HyperLogLogAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
+      auto accumulator =
+          value<velox::common::hll::HllAccumulator<T, HllAsFinalResult>>(
+              group);
+      if constexpr (std::is_same_v<T, bool>) {
+        rows.applyToSelected([&](auto row) {
+          if (decodedValue_.isNullAt(row)) {
+            return;
+          }
+          clearNull(group);
+          accumulator->setIndexBitLength(indexBitLength_);
+          accumulator->append(decodedValue_.valueAt<T>(row));
+        });
+      } else {
+        // Hashes all rows first, so that the hashing loop does not wait on
+        // the updates of the accumulator.
+        hashes_.resize(rows.end());
+        size_t numHashes = 0;
+        rows.applyToSelected([&](auto row) {
+          if (!decodedValue_.isNullAt(row)) {
+            hashes_[numHashes++] =
+                accumulator->hash(decodedValue_.valueAt<T>(row));
+          }
+        });
+        if (numHashes == 0) {
           return;
         }
-
-        auto accumulator =
-            value<velox::common::hll::HllAccumulator<T, HllAsFinalResult>>(
-                group);
         clearNull(group);
         accumulator->setIndexBitLength(indexBitLength_);
-
-        accumulator->append(decodedValue_.valueAt<T>(row));
-      });
+        accumulator->insertHashes(
+            folly::Range<const uint64_t*>(hashes_.data(), numHashes));
+      }
     }
   }
 
@@ -352,6 +370,8 @@ class HyperLogLogAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  // Hashes of the rows of one addSingleGroupRawInput() call.
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
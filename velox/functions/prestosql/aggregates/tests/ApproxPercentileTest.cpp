@@ -361,6 +361,35 @@ TEST_F(ApproxPercentileTest, groupByAgg) {
       keys, valuesWithNulls, weightsWithNulls, 0.5, 0.005, expectedResult);
 }
 
+// Groups below and above the number of values kept before a group creates its
+// sketch, each seen in several batches so that the final aggregation merges
+// many sketches per group at once.
+TEST_F(ApproxPercentileTest, smallGroups) {
+  constexpr int32_t kNumGroups = 500;
+  for (int32_t groupSize : {1, 3, 61}) {
+    SCOPED_TRACE(fmt::format("groupSize {}", groupSize));
+    const auto size = kNumGroups * groupSize;
+    auto batch = makeRowVector({
+        makeFlatVector<int32_t>(
+            size, [](auto row) { return row % kNumGroups; }),
+        makeFlatVector<int32_t>(
+            size, [](auto row) { return row % kNumGroups + row / kNumGroups; }),
+    });
+    auto expected = makeRowVector({
+        makeFlatVector<int32_t>(kNumGroups, [](auto row) { return row; }),
+        makeFlatVector<int32_t>(
+            kNumGroups,
+            [&](auto row) { return row + (groupSize - 1) / 2; }),
+    });
+    testAggregations(
+        {batch, batch, batch},
+        {"c0"},
+        {"approx_percentile(c1, 0.5)"},
+        {expected},
+        queryConfig_);
+  }
+}
+
 // Test large values of "weight" parameter used in global aggregation.
 TEST_F(ApproxPercentileTest, largeWeightsGlobal) {
   vector_size_t size = 1'000;
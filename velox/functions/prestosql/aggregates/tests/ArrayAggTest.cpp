@@ -282,6 +282,44 @@ TEST_F(ArrayAggTest, sortedGroupBy) {
   testFunction("simple_array_agg");
 }
 
+TEST_F(ArrayAggTest, sortedGroupByManyGroups) {
+  // The sorted rows of many small groups are added to the aggregate in batches
+  // of up to SortedAggregations::kMaxBatchRows rows. The 30'000 groups of 3
+  // rows and the one large group make several batches.
+  const vector_size_t size = 100'000;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row < 10'000 ? -1 : row % 30'000; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (row * 7) % 1'000; }, nullEvery(11)),
+  });
+  createDuckDbTable({data});
+
+  auto testFunction = [&](const std::string& name) {
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .project({"c0", "c1", "c2", "c1 % 3 > 0 as m"})
+                    .singleAggregation(
+                        {"c0"},
+                        {fmt::format("{}(c1 ORDER BY c2, c1 DESC)", name),
+                         fmt::format("{}(c1 ORDER BY c2 DESC, c1)", name),
+                         "count(1)"},
+                        {"", "m", ""})
+                    .planNode();
+
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .assertResults(
+            "SELECT c0, array_agg(c1 ORDER BY c2, c1 DESC), "
+            "array_agg(c1 ORDER BY c2 DESC, c1) "
+            "FILTER (WHERE c1 % 3 > 0), "
+            "count(1) FROM tmp GROUP BY 1");
+  };
+
+  testFunction("array_agg");
+  testFunction("simple_array_agg");
+}
+
 TEST_F(ArrayAggTest, global) {
   auto testFunction = [this](
                           const std::string& functionName,
@@ -453,6 +453,39 @@ TEST_F(SetAggTest, groupByVarchar) {
       {expected});
 }
 
+// Dictionary-encoded strings are interned once and shared by the groups.
+TEST_F(SetAggTest, groupByDictionaryVarchar) {
+  const std::vector<std::optional<std::string>> strings = {
+      "grapes",
+      "sweet fruits: apple",
+      "sweet fruits: banana",
+      "sweet fruits: papaya",
+      std::nullopt,
+  };
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int16_t>(size, [](auto row) { return row % 7; }),
+      wrapInDictionary(
+          makeIndices(size, [](auto row) { return row % 5; }),
+          size,
+          makeNullableFlatVector<std::string>(strings)),
+  });
+
+  std::vector<std::vector<std::optional<std::string>>> expectedSets(
+      7, strings);
+  auto expected = makeRowVector({
+      makeFlatVector<int16_t>(7, [](auto row) { return row; }),
+      makeNullableArrayVector<std::string>(expectedSets),
+  });
+
+  testAggregations(
+      {data, data, data},
+      {"c0"},
+      {"set_agg(c1)"},
+      {"c0", "array_sort(a0)"},
+      {expected});
+}
+
 TEST_F(SetAggTest, globalArray) {
   auto data = makeRowVector({
       makeArrayVector<int32_t>({
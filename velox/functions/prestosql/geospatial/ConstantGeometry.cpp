@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/geospatial/ConstantGeometry.h"
+
+#include <geos/geom/prep/PreparedGeometryFactory.h>
+#include <cmath>
+
+#include "velox/common/geospatial/GeometrySerde.h"
+#include "velox/functions/prestosql/geospatial/GeometryUtils.h"
+
+namespace facebook::velox::functions::geospatial {
+
+using common::geospatial::GeometryDeserializer;
+
+ConstantGeometry::ConstantGeometry(const StringView& serialized)
+    : geometry_(GeometryDeserializer::deserialize(serialized)),
+      isCollection_(isGeometryCollection(*geometry_)) {
+  if (geometry_->isEmpty() || isCollection_) {
+    return;
+  }
+  prepared_ = geos::geom::prep::PreparedGeometryFactory::prepare(
+      geometry_.get());
+  const auto type = geometry_->getGeometryTypeId();
+  if (type == geos::geom::GeometryTypeId::GEOS_POLYGON ||
+      type == geos::geom::GeometryTypeId::GEOS_MULTIPOLYGON) {
+    pointLocator_ =
+        std::make_unique<geos::algorithm::locate::IndexedPointInAreaLocator>(
+            *geometry_);
+  }
+}
+
+Status ConstantGeometry::contains(const StringView& other, bool& result)
+    const {
+  return evaluate<true>(other, result);
+}
+
+Status ConstantGeometry::intersects(const StringView& other, bool& result)
+    const {
+  return evaluate<false>(other, result);
+}
+
+template <bool kContains>
+Status ConstantGeometry::evaluate(const StringView& other, bool& result)
+    const {
+  const auto* envelope = geometry_->getEnvelopeInternal();
+  if (pointLocator_ != nullptr) {
+    if (const auto point = GeometryDeserializer::deserializePoint(other)) {
+      // An empty point has a null envelope, which no envelope contains or
+      // intersects.
+      if (std::isnan(point->x) || std::isnan(point->y) ||
+          !envelope->intersects(*point)) {
+        result = false;
+        return Status::OK();
+      }
+      // A polygon contains the points of its interior and intersects those of
+      // its boundary as well.
+      const auto location = pointLocator_->locate(&*point);
+      result = kContains ? location == geos::geom::Location::INTERIOR
+                         : location != geos::geom::Location::EXTERIOR;
+      return Status::OK();
+    }
+  }
+
+  const auto otherGeometry = GeometryDeserializer::deserialize(other);
+  if (isCollection_ || isGeometryCollection(*otherGeometry)) {
+    GEOS_TRY(
+        result = kContains ? geometry_->contains(otherGeometry.get())
+                           : geometry_->intersects(otherGeometry.get());
+        , kContains ? "Failed to check geometry contains"
+                    : "Failed to check geometry intersects");
+    return Status::OK();
+  }
+
+  const auto* otherEnvelope = otherGeometry->getEnvelopeInternal();
+  if (kContains ? !envelope->contains(otherEnvelope)
+                : !envelope->intersects(otherEnvelope)) {
+    result = false;
+    return Status::OK();
+  }
+
+  const auto* prepared = prepared_.get();
+  GEOS_TRY(
+      if (prepared != nullptr) {
+        result = kContains ? prepared->contains(otherGeometry.get())
+                           : prepared->intersects(otherGeometry.get());
+      } else {
+        result = kContains ? geometry_->contains(otherGeometry.get())
+                           : geometry_->intersects(otherGeometry.get());
+      },
+      kContains ? "Failed to check geometry contains"
+                : "Failed to check geometry intersects");
+  return Status::OK();
+}
+
+} // namespace facebook::velox::functions::geospatial
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/prep/PreparedGeometry.h>
+#include <memory>
+
+#include "velox/common/base/Status.h"
+#include "velox/type/StringView.h"
+
+namespace facebook::velox::functions::geospatial {
+
+/// The constant geometry argument of a spatial predicate, e.g. the polygon of
+/// ST_Contains(ST_GeometryFromText('POLYGON (...)'), point), deserialized once
+/// per expression rather than once per row. Unless the geometry is empty or a
+/// geometry collection, it is also prepared, so that GEOS indexes its segments
+/// once for all the rows. Points tested against a polygonal constant are
+/// located in the indexed polygon without building a GEOS geometry for them.
+///
+/// The predicates have the results of the GEOS predicates with the constant
+/// as the left argument. Not thread safe: GEOS builds the indexes on first use.
+class ConstantGeometry {
+ public:
+  explicit ConstantGeometry(const StringView& serialized);
+
+  /// Sets 'result' to whether the constant contains 'other'.
+  Status contains(const StringView& other, bool& result) const;
+
+  /// Sets 'result' to whether the constant intersects 'other'.
+  Status intersects(const StringView& other, bool& result) const;
+
+ private:
+  template <bool kContains>
+  Status evaluate(const StringView& other, bool& result) const;
+
+  std::unique_ptr<geos::geom::Geometry> geometry_;
+  bool isCollection_{false};
+  // Set unless 'geometry_' is empty or a geometry collection.
+  std::unique_ptr<geos::geom::prep::PreparedGeometry> prepared_;
+  // Set if 'geometry_' is a non-empty polygon or multipolygon.
+  std::unique_ptr<geos::algorithm::locate::IndexedPointInAreaLocator>
+      pointLocator_;
+};
+
+} // namespace facebook::velox::functions::geospatial
@@ -133,6 +133,14 @@ TEST_F(DecimalArithmeticTest, add) {
        makeNullableFlatVector<int64_t>(
            {1, 2, 5, std::nullopt, std::nullopt}, DECIMAL(10, 3))});
 
+  // The largest inputs whose sum is computed without overflow checks.
+  const int128_t max37 = DecimalUtil::kPowersOfTen[37] - 1;
+  auto long37Flat = makeFlatVector<int128_t>({max37, -max37}, DECIMAL(37, 0));
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>({2 * max37, -2 * max37}, DECIMAL(38, 0)),
+      "c0 + c1",
+      {long37Flat, long37Flat});
+
   // Addition overflow.
   VELOX_ASSERT_USER_THROW(
       testDecimalExpr<TypeKind::HUGEINT>(
@@ -288,6 +296,14 @@ TEST_F(DecimalArithmeticTest, multiply) {
   testDecimalExpr<TypeKind::BIGINT>(
       expectedConstantFlat, "c0 * 1.00", {shortFlat});
 
+  // The largest inputs whose product is computed without overflow checks.
+  const int128_t max19 = DecimalUtil::kPowersOfTen[19] - 1;
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>({max19 * max19, -max19 * max19}, DECIMAL(38, 0)),
+      "c0 * c1",
+      {makeFlatVector<int128_t>({max19, max19}, DECIMAL(19, 0)),
+       makeFlatVector<int128_t>({max19, -max19}, DECIMAL(19, 0))});
+
   // Long decimal limits
   VELOX_ASSERT_USER_THROW(
       testDecimalExpr<TypeKind::HUGEINT>(
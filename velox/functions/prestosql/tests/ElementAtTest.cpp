@@ -1455,6 +1455,66 @@ TEST_F(ElementAtTest, testCachingOptimization) {
   }
 }
 
+TEST_F(ElementAtTest, sharedLookupTable) {
+  // Two maps of 1000 keys and one of 10 keys, which is not hashed.
+  std::vector<std::vector<std::pair<int64_t, std::optional<int64_t>>>> data(3);
+  for (int i = 0; i < 1000; i++) {
+    data[0].push_back({i, i + 1000});
+    data[1].push_back({i * 2, i});
+  }
+  for (int i = 0; i < 10; i++) {
+    data[2].push_back({i, i});
+  }
+  auto inputMap = makeMapVector<int64_t, int64_t>(data);
+
+  exec::ExprSet exprSet({}, &execCtx_);
+  auto inputs = makeRowVector({});
+  exec::EvalCtx evalCtx(&execCtx_, &exprSet, inputs.get());
+  SelectivityVector rows(3);
+  facebook::velox::functions::detail::MapSubscript mapSubscript(false);
+
+  auto lookup = [&](const VectorPtr& map, int64_t key) {
+    std::vector<VectorPtr> args = {map, makeConstant<int64_t>(key, 3)};
+    return mapSubscript.applyMap(rows, args, evalCtx);
+  };
+
+  // The first lookup scans the keys. The second builds the hash tables,
+  // which the lookups through a dictionary over the same map share.
+  auto result = lookup(inputMap, 4);
+  test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>({1004, 2, 4}), result);
+  result = lookup(inputMap, 6);
+  test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>({1006, 3, 6}), result);
+  auto dictionaryMap = BaseVector::wrapInDictionary(
+      nullptr, makeIndicesInReverse(3), 3, inputMap);
+  result = lookup(dictionaryMap, 999);
+  test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>({std::nullopt, std::nullopt, 1999}),
+      result);
+
+  auto& entry = evalCtx.lookupVectorIndex(inputMap.get(), inputMap);
+  EXPECT_EQ(entry.numLookups, 4);
+  ASSERT_NE(entry.index, nullptr);
+  using LookupTable = facebook::velox::functions::detail::LookupTable<int64_t>;
+  auto& tables = *static_cast<LookupTable*>(entry.index.get())->map();
+  EXPECT_EQ(tables.size(), 2);
+  EXPECT_EQ(tables.find(1)->second.size(), 1000);
+  EXPECT_EQ(tables.count(2), 0);
+
+  // A lookup in another evaluation does not see the tables.
+  exec::EvalCtx otherEvalCtx(&execCtx_, &exprSet, inputs.get());
+  EXPECT_EQ(
+      otherEvalCtx.lookupVectorIndex(inputMap.get(), inputMap).index, nullptr);
+
+  // Lookups in one expression.
+  auto row = makeRowVector({inputMap});
+  test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>({4002, 501, std::nullopt}),
+      evaluate(
+          "element_at(c0, 2) + element_at(c0, 4) + element_at(c0, 996)", row));
+}
+
 TEST_F(ElementAtTest, testCachingOptimizationNonZeroOffset) {
   // Test the case where the input map has a non-zero offset when caching is
   // enabled.
@@ -935,6 +935,79 @@ TEST_F(GeometryFunctionsTest, testStWithin) {
       "TopologyException: side location conflict at 1 2. This can occur if the input geometry is invalid.");
 }
 
+TEST_F(GeometryFunctionsTest, testConstantRelations) {
+  // Geometries tested against each constant, including points inside, on the
+  // boundary of, and outside the polygons.
+  const std::vector<std::optional<std::string>> wkts = {
+      "POINT (2 2)",
+      "POINT (0 2)",
+      "POINT (0 0)",
+      "POINT (5 5)",
+      "POINT (1.5 1.5)",
+      "POINT EMPTY",
+      std::nullopt,
+      "MULTIPOINT (1 1, 2 2)",
+      "MULTIPOINT (1 1, 5 5)",
+      "LINESTRING (1 1, 3 3)",
+      "LINESTRING (1 1, 5 5)",
+      "LINESTRING (0 0, 0 4)",
+      "POLYGON ((1 1, 1 3, 3 3, 3 1, 1 1))",
+      "POLYGON ((3 3, 3 5, 5 5, 5 3, 3 3))",
+      "POLYGON EMPTY",
+      "GEOMETRYCOLLECTION (POINT (2 2), LINESTRING (1 1, 3 3))",
+  };
+  const std::vector<std::string> constants = {
+      "POLYGON ((0 0, 0 4, 4 4, 4 0, 0 0))",
+      "POLYGON ((0 0, 0 4, 4 4, 4 0, 0 0), (1 1, 2 1, 2 2, 1 2, 1 1))",
+      "MULTIPOLYGON (((0 0, 0 1, 1 1, 1 0, 0 0)), ((2 2, 2 3, 3 3, 3 2, 2 2)))",
+      "LINESTRING (0 0, 4 4)",
+      "POINT (2 2)",
+      "POLYGON EMPTY",
+      "GEOMETRYCOLLECTION (POINT (2 2), POLYGON ((0 0, 0 4, 4 4, 4 0, 0 0)))",
+  };
+
+  for (const auto& constant : constants) {
+    SCOPED_TRACE(constant);
+    const auto input = makeRowVector(
+        {makeNullableFlatVector<std::string>(wkts),
+         makeFlatVector<std::string>(
+             wkts.size(), [&](auto /* row */) { return constant; })});
+    const auto literal = fmt::format("ST_GeometryFromText('{}')", constant);
+    const std::string column = "ST_GeometryFromText(c1)";
+    const std::string geometry = "ST_GeometryFromText(c0)";
+    for (const auto& [constantExpr, expectedExpr] :
+         std::vector<std::pair<std::string, std::string>>{
+             {fmt::format("ST_Contains({}, {})", literal, geometry),
+              fmt::format("ST_Contains({}, {})", column, geometry)},
+             {fmt::format("ST_Within({}, {})", geometry, literal),
+              fmt::format("ST_Within({}, {})", geometry, column)},
+             {fmt::format("ST_Intersects({}, {})", literal, geometry),
+              fmt::format("ST_Intersects({}, {})", column, geometry)},
+             {fmt::format("ST_Intersects({}, {})", geometry, literal),
+              fmt::format("ST_Intersects({}, {})", geometry, column)}}) {
+      SCOPED_TRACE(constantExpr);
+      facebook::velox::test::assertEqualVectors(
+          evaluate(expectedExpr, input), evaluate(constantExpr, input));
+    }
+  }
+
+  // Points located in the indexed polygon.
+  const auto polygon =
+      "ST_GeometryFromText('POLYGON ((0 0, 0 4, 4 4, 4 0, 0 0))')";
+  const auto points = makeRowVector({makeNullableFlatVector<std::string>(
+      {"POINT (2 2)", "POINT (0 2)", "POINT (5 5)", "POINT EMPTY"})});
+  facebook::velox::test::assertEqualVectors(
+      makeFlatVector<bool>({true, false, false, false}),
+      evaluate(
+          fmt::format("ST_Contains({}, ST_GeometryFromText(c0))", polygon),
+          points));
+  facebook::velox::test::assertEqualVectors(
+      makeFlatVector<bool>({true, true, false, false}),
+      evaluate(
+          fmt::format("ST_Intersects(ST_GeometryFromText(c0), {})", polygon),
+          points));
+}
+
 // Overlay operations
 
 TEST_F(GeometryFunctionsTest, testStDifference) {
@@ -251,6 +251,52 @@ TEST_F(JsonExtractScalarTest, nanJson) {
   }
 }
 
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {R"({"a": 1, "b": "x", "c": [1]})",
+           R"({"a": true, "b": {"c": 2}})",
+           "invalid",
+           std::nullopt,
+           R"({"a": "a long string that is not inlined", "b": null})"}),
+      makeFlatVector<std::string>({"1", "2", "3", "4", "5"}),
+  });
+  const std::vector<std::string> exprs = {
+      "json_extract_scalar(c0, '$.a')",
+      "concat(json_extract_scalar(c0, '$.b'), c1)",
+      "upper(json_extract_scalar(c0, '$.a'))",
+      "json_extract_scalar(c0, '$.c')",
+      "json_extract_scalar(c1, '$.a')",
+  };
+  auto exprSet = compileExpressions(exprs, asRowType(data->type()));
+
+  // The calls over c0 are dereferences of one call that extracts all 3 paths.
+  // The call over c1 is not rewritten.
+  const auto& first = exprSet->expr(0);
+  ASSERT_EQ(first->inputs().size(), 1);
+  const auto& multi = first->inputs()[0];
+  EXPECT_EQ(multi->name(), "$internal$json_extract_scalars");
+  EXPECT_EQ(multi->inputs().size(), 4);
+  EXPECT_EQ(exprSet->expr(1)->inputs()[0]->inputs()[0], multi);
+  EXPECT_EQ(exprSet->expr(3)->inputs()[0], multi);
+  EXPECT_EQ(exprSet->expr(4)->name(), "json_extract_scalar");
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(exprs.size());
+  exprSet->eval(rows, context, results);
+  for (auto i = 0; i < exprs.size(); ++i) {
+    SCOPED_TRACE(exprs[i]);
+    velox::test::assertEqualVectors(evaluate(exprs[i], data), results[i]);
+  }
+  EXPECT_EQ(results[0]->toString(0), "1");
+  EXPECT_EQ(results[1]->toString(0), "x1");
+  EXPECT_TRUE(results[1]->isNullAt(1));
+  EXPECT_TRUE(results[0]->isNullAt(2));
+  EXPECT_TRUE(results[0]->isNullAt(3));
+  EXPECT_EQ(results[0]->toString(4), "a long string that is not inlined");
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox::functions::prestosql {
+
+namespace {
+
+class LambdaFusionTest : public functions::test::FunctionBaseTest {
+ protected:
+  // Evaluates 'expr' over 'data' and checks that the compiled expression has
+  // 'numCalls' calls to 'name'.
+  VectorPtr evaluateFused(
+      const std::string& expr,
+      const RowVectorPtr& data,
+      const std::string& name,
+      int32_t numCalls) {
+    auto exprSet = compileExpressions({expr}, asRowType(data->type()));
+    EXPECT_EQ(countCalls(*exprSet->expr(0), name), numCalls) << expr;
+    return evaluate(*exprSet, data);
+  }
+
+  static int32_t countCalls(const exec::Expr& expr, const std::string& name) {
+    int32_t count = expr.name() == name ? 1 : 0;
+    for (const auto& input : expr.inputs()) {
+      count += countCalls(*input, name);
+    }
+    return count;
+  }
+};
+
+TEST_F(LambdaFusionTest, transform) {
+  auto data = makeRowVector({
+      makeNullableArrayVector<int64_t>(
+          {{{1, 2, 3}}, {{}}, std::nullopt, {{4, std::nullopt}}}),
+      makeFlatVector<int64_t>({1, 2, 3, 4}),
+  });
+
+  TestRuntimeStatWriter writer;
+  RuntimeStatWriterScopeGuard guard(&writer);
+  auto result = evaluateFused(
+      "transform(transform(transform(c0, x -> x * 2), y -> y + 1), "
+      "z -> cast(z as varchar))",
+      data,
+      "transform",
+      1);
+  ASSERT_EQ(writer.stats().size(), 1);
+  ASSERT_EQ(writer.stats()[0].first, "numLambdaFusion");
+  ASSERT_EQ(writer.stats()[0].second.value, 2);
+  velox::test::assertEqualVectors(
+      makeNullableArrayVector<StringView>(
+          {{{"3", "5", "7"}}, {{}}, std::nullopt, {{"9", std::nullopt}}}),
+      result);
+
+  // The inner lambda may have captures.
+  result = evaluateFused(
+      "transform(transform(c0, x -> x * c1), y -> y + 1)",
+      data,
+      "transform",
+      1);
+  velox::test::assertEqualVectors(
+      makeNullableArrayVector<int64_t>(
+          {{{2, 3, 4}}, {{}}, std::nullopt, {{17, std::nullopt}}}),
+      result);
+
+  // The outer lambda is not fused if it references its argument more than
+  // once, under a conditional form or together with a capture.
+  for (const auto& lambda :
+       {"y -> y * y", "y -> coalesce(y, 0)", "y -> y + c1", "y -> 1"}) {
+    evaluateFused(
+        fmt::format("transform(transform(c0, x -> x * 2), {})", lambda),
+        data,
+        "transform",
+        2);
+  }
+
+  // Errors of the inner lambda are raised as before.
+  data = makeRowVector({makeArrayVector<int64_t>({{1, 0}, {2}})});
+  VELOX_ASSERT_THROW(
+      evaluateFused(
+          "transform(transform(c0, x -> 6 / x), y -> y + 1)",
+          data,
+          "transform",
+          1),
+      "division by zero");
+  velox::test::assertEqualVectors(
+      makeNullableArrayVector<int64_t>({std::nullopt, {{4}}}),
+      evaluateFused(
+          "try(transform(transform(c0, x -> 6 / x), y -> y + 1))",
+          data,
+          "transform",
+          1));
+}
+
+TEST_F(LambdaFusionTest, filter) {
+  auto data = makeRowVector({
+      makeNullableArrayVector<int64_t>(
+          {{{1, 2, 3}}, {{}}, std::nullopt, {{4, std::nullopt, 2}}}),
+      makeFlatVector<int64_t>({3, 2, 1, 3}),
+  });
+
+  auto result = evaluateFused(
+      "filter(filter(filter(c0, x -> x > 1), y -> y < 4), x -> x <> c1)",
+      data,
+      "filter",
+      1);
+  velox::test::assertEqualVectors(
+      makeNullableArrayVector<int64_t>({{{2}}, {{}}, std::nullopt, {{2}}}),
+      result);
+
+  // A capture of the outer lambda with the name of the argument of the inner
+  // lambda prevents the fusion.
+  result = evaluateFused(
+      "filter(filter(c0, c1 -> c1 > 1), y -> y < c1)", data, "filter", 2);
+  velox::test::assertEqualVectors(
+      makeNullableArrayVector<int64_t>({{{2}}, {{}}, std::nullopt, {{2}}}),
+      result);
+
+  // The outer lambda is not evaluated on the elements removed by the inner
+  // one.
+  data = makeRowVector({makeArrayVector<int64_t>({{1, 0, 3}})});
+  velox::test::assertEqualVectors(
+      makeArrayVector<int64_t>({{1, 3}}),
+      evaluateFused(
+          "filter(filter(c0, x -> x <> 0), y -> 6 / y > 1)",
+          data,
+          "filter",
+          1));
+}
+
+} // namespace
+
+} // namespace facebook::velox::functions::prestosql
@@ -258,6 +258,29 @@ TEST_F(MapKeysTest, unknown) {
   test::assertEqualVectors(expected, result);
 }
 
+TEST_F(MapKeysTest, flatMap) {
+  auto input = makeFlatMapVectorFromJson<int64_t, int32_t>({
+      "{1:10, 2:20, 4:40, 5:50}",
+      "{1:11, 4:41}",
+      "{}",
+      "null",
+      "{2:23, 4:43}",
+  });
+  auto result = evaluate("map_keys(c0)", makeRowVector({input}));
+  auto expected = makeArrayVectorFromJson<int64_t>(
+      {"[1, 2, 4, 5]", "[1, 4]", "[]", "null", "[2, 4]"});
+  test::assertEqualVectors(expected, result);
+
+  // Only some rows selected.
+  result = evaluate(
+      "if(c1, map_keys(c0), null)",
+      makeRowVector(
+          {input, makeFlatVector<bool>({false, true, false, true, true})}));
+  expected = makeArrayVectorFromJson<int64_t>(
+      {"null", "[1, 4]", "null", "null", "[2, 4]"});
+  test::assertEqualVectors(expected, result);
+}
+
 TEST_F(MapValuesTest, noNulls) {
   auto sizeAt = [](vector_size_t row) { return row % 7; };
   testMapValues(sizeAt, nullptr);
@@ -344,6 +367,20 @@ TEST_F(MapValuesTest, noDictionaryReceived) {
   test::assertEqualVectors(expected, result);
 }
 
+TEST_F(MapValuesTest, flatMap) {
+  auto input = makeFlatMapVectorFromJson<int64_t, int32_t>({
+      "{1:10, 2:20, 4:40, 5:50}",
+      "{1:11, 4:null}",
+      "{}",
+      "null",
+      "{2:23, 4:43}",
+  });
+  auto result = evaluate("map_values(c0)", makeRowVector({input}));
+  auto expected = makeArrayVectorFromJson<int32_t>(
+      {"[10, 20, 40, 50]", "[11, null]", "[]", "null", "[23, 43]"});
+  test::assertEqualVectors(expected, result);
+}
+
 TEST_F(MapValuesTest, unknown) {
   auto keys = makeFlatVector<UnknownValue>({}, UNKNOWN());
   auto values = makeFlatVector<UnknownValue>({}, UNKNOWN());
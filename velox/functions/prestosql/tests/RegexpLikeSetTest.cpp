@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox::functions::prestosql {
+
+namespace {
+
+class RegexpLikeSetTest : public functions::test::FunctionBaseTest {
+ protected:
+  // Evaluates 'exprs' as one ExprSet over 'data'.
+  std::vector<VectorPtr> evaluateExprSet(
+      const std::vector<std::string>& exprs,
+      const RowVectorPtr& data,
+      std::unique_ptr<exec::ExprSet>& exprSet) {
+    exprSet = compileExpressions(exprs, asRowType(data->type()));
+    exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+    SelectivityVector rows(data->size());
+    std::vector<VectorPtr> results(exprs.size());
+    exprSet->eval(rows, context, results);
+    return results;
+  }
+};
+
+TEST_F(RegexpLikeSetTest, switch) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"aab",
+           "xyz",
+           "foo bar",
+           std::nullopt,
+           "",
+           "a long string ending in bar"}),
+  });
+  const std::vector<std::string> exprs = {
+      "CASE WHEN regexp_like(c0, 'a+b') THEN 1 "
+      "WHEN regexp_like(c0, '^x') THEN 2 "
+      "WHEN regexp_like(c0, 'bar$') THEN 3 "
+      "WHEN regexp_like(c0, 'a+b') THEN 4 ELSE 5 END",
+  };
+  std::unique_ptr<exec::ExprSet> exprSet;
+  auto results = evaluateExprSet(exprs, data, exprSet);
+
+  // The conditions are dereferences of one call that matches the 3 distinct
+  // patterns.
+  const auto& switchExpr = exprSet->expr(0);
+  ASSERT_EQ(switchExpr->name(), "switch");
+  const auto& set = switchExpr->inputs()[0]->inputs()[0];
+  EXPECT_EQ(set->name(), "$internal$regexp_like_set");
+  EXPECT_EQ(set->inputs().size(), 4);
+  EXPECT_EQ(switchExpr->inputs()[2]->inputs()[0], set);
+  EXPECT_EQ(switchExpr->inputs()[6]->inputs()[0], set);
+
+  velox::test::assertEqualVectors(
+      makeFlatVector<int64_t>({1, 2, 3, 5, 5, 3}), results[0]);
+}
+
+TEST_F(RegexpLikeSetTest, or) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"foo", "bar", "baz", std::nullopt, "food"}),
+      makeFlatVector<std::string>({"foo", "x", "x", "foo", "x"}),
+  });
+  const std::vector<std::string> exprs = {
+      "regexp_like(c0, '^foo$') OR (regexp_like(c0, 'ar') OR "
+      "regexp_like(c1, 'foo')) OR regexp_like(c0, 'z')",
+      // A single pattern is not grouped.
+      "regexp_like(c0, 'a') OR c1 = 'x'",
+  };
+  std::unique_ptr<exec::ExprSet> exprSet;
+  auto results = evaluateExprSet(exprs, data, exprSet);
+
+  EXPECT_NE(
+      exprSet->expr(0)->toString().find("$internal$regexp_like_set"),
+      std::string::npos);
+  EXPECT_EQ(
+      exprSet->expr(1)->toString().find("$internal$regexp_like_set"),
+      std::string::npos);
+
+  velox::test::assertEqualVectors(
+      makeFlatVector<bool>({true, true, true, true, false}),
+      results[0]);
+
+  // An invalid pattern is not grouped, so the rows for which it is not
+  // evaluated do not fail.
+  data = makeRowVector({makeFlatVector<std::string>({"foo", "x"})});
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "regexp_like(c0, 'o') OR regexp_like(c0, 'r') OR "
+          "regexp_like(c0, '[')",
+          data),
+      "invalid regular expression");
+  velox::test::assertEqualVectors(
+      makeFlatVector<bool>({true, true}),
+      evaluate(
+          "regexp_like(c0, 'o') OR regexp_like(c0, 'r') OR "
+          "regexp_like(c0, '[')",
+          makeRowVector({makeFlatVector<std::string>({"foo", "bar"})})));
+}
+
+} // namespace
+
+} // namespace facebook::velox::functions::prestosql
@@ -443,5 +443,27 @@ TEST_F(AggregateWindowTest, singlePartitionColumnForPrefixSort) {
       {"rows between unbounded preceding and unbounded following"});
 }
 
+// Tests frames that are large enough to be computed from the segment tree of
+// the partition.
+TEST_F(AggregateWindowTest, segmentTreeFrames) {
+  const vector_size_t size = 3'000;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row / 1'700; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (row * 7'919) % 1'009; }, nullEvery(3)),
+  });
+
+  const std::vector<std::string> kFrames = {
+      "rows between 200 preceding and 100 following",
+      "rows between 500 following and 1000 following",
+      "rows between 1000 preceding and 999 preceding",
+      "rows between current row and unbounded following"};
+  for (const auto& function : {"min(c2)", "max(c2)"}) {
+    WindowTestBase::testWindowFunction(
+        {input}, function, {"partition by c0 order by c1"}, kFrames);
+  }
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
@@ -236,8 +236,9 @@ struct ContainsFunction {
       out_type<bool>& result,
       const arg_type<Varchar>& str,
       const arg_type<Varchar>& pattern) {
-    result = std::string_view(str).find(std::string_view(pattern)) !=
-        std::string_view::npos;
+    result = simd::simdStrstr(
+                 str.data(), str.size(), pattern.data(), pattern.size()) !=
+        std::string::npos;
     return true;
   }
 };
@@ -16,6 +16,8 @@
 
 #include "velox/parse/QueryPlanner.h"
 #include "velox/duckdb/conversion/DuckConversion.h"
+#include "velox/exec/AggregateFunctionRegistry.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/parse/DuckLogicalOperator.h"
 
 #include <duckdb.hpp> // @manual
@@ -23,11 +25,18 @@
 #include <duckdb/planner/expression/bound_aggregate_expression.hpp> // @manual
 #include <duckdb/planner/expression/bound_cast_expression.hpp> // @manual
 #include <duckdb/planner/expression/bound_comparison_expression.hpp> // @manual
+#include <duckdb/planner/expression/bound_conjunction_expression.hpp> // @manual
 #include <duckdb/planner/expression/bound_constant_expression.hpp> // @manual
 #include <duckdb/planner/expression/bound_function_expression.hpp> // @manual
+#include <duckdb/planner/expression/bound_operator_expression.hpp> // @manual
 #include <duckdb/planner/expression/bound_reference_expression.hpp> // @manual
+#include <duckdb/planner/filter/conjunction_filter.hpp> // @manual
+#include <duckdb/planner/filter/constant_filter.hpp> // @manual
+#include <duckdb/planner/filter/null_filter.hpp> // @manual
 #include <duckdb/planner/operator/logical_dummy_scan.hpp> // @manual
 
+#include <numeric>
+
 namespace facebook::velox::core {
 
 namespace {
@@ -57,6 +66,8 @@ struct QueryContext {
       inMemoryTables;
   MakeTableScan makeTableScan;
   bool isInDelimJoin{false};
+  // See DuckDbQueryPlanner::Options::parallel.
+  bool parallel{false};
 
   QueryContext(
       const std::unordered_map<std::string, std::vector<RowVectorPtr>>&
@@ -95,6 +106,88 @@ std::string mapScalarFunctionName(const std::string& name) {
   return name;
 }
 
+// Returns the Velox function for a DuckDB comparison, nullptr if 'type' is
+// not a comparison.
+const char* comparisonFunctionName(::duckdb::ExpressionType type) {
+  switch (type) {
+    case ::duckdb::ExpressionType::COMPARE_EQUAL:
+      return "eq";
+    case ::duckdb::ExpressionType::COMPARE_NOTEQUAL:
+      return "neq";
+    case ::duckdb::ExpressionType::COMPARE_GREATERTHAN:
+      return "gt";
+    case ::duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return "gte";
+    case ::duckdb::ExpressionType::COMPARE_LESSTHAN:
+      return "lt";
+    case ::duckdb::ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return "lte";
+    default:
+      return nullptr;
+  }
+}
+
+// Combines 'conjuncts' with 'and'.
+TypedExprPtr andConjuncts(std::vector<TypedExprPtr> conjuncts) {
+  VELOX_CHECK(!conjuncts.empty());
+  if (conjuncts.size() == 1) {
+    return conjuncts[0];
+  }
+  return std::make_shared<CallTypedExpr>(
+      BOOLEAN(), std::move(conjuncts), "and");
+}
+
+// Converts a filter that DuckDB's optimizer pushed into a scan of 'column'.
+TypedExprPtr toVeloxFilter(
+    const ::duckdb::TableFilter& filter,
+    const FieldAccessTypedExprPtr& column) {
+  switch (filter.filter_type) {
+    case ::duckdb::TableFilterType::CONSTANT_COMPARISON: {
+      const auto& constantFilter =
+          dynamic_cast<const ::duckdb::ConstantFilter&>(filter);
+      const auto* name = comparisonFunctionName(constantFilter.comparison_type);
+      VELOX_CHECK_NOT_NULL(
+          name,
+          "Unsupported comparison in a pushed down filter: {}",
+          filter.ToString(column->name()));
+      return std::make_shared<CallTypedExpr>(
+          BOOLEAN(),
+          name,
+          column,
+          std::make_shared<ConstantTypedExpr>(
+              duckdb::toVeloxType(constantFilter.constant.type()),
+              duckdb::duckValueToVariant(constantFilter.constant)));
+    }
+    case ::duckdb::TableFilterType::IS_NULL:
+      return std::make_shared<CallTypedExpr>(BOOLEAN(), "is_null", column);
+    case ::duckdb::TableFilterType::IS_NOT_NULL:
+      return std::make_shared<CallTypedExpr>(
+          BOOLEAN(),
+          "not",
+          std::make_shared<CallTypedExpr>(BOOLEAN(), "is_null", column));
+    case ::duckdb::TableFilterType::CONJUNCTION_AND:
+    case ::duckdb::TableFilterType::CONJUNCTION_OR: {
+      const bool isAnd =
+          filter.filter_type == ::duckdb::TableFilterType::CONJUNCTION_AND;
+      const auto& children = isAnd
+          ? dynamic_cast<const ::duckdb::ConjunctionAndFilter&>(filter)
+                .child_filters
+          : dynamic_cast<const ::duckdb::ConjunctionOrFilter&>(filter)
+                .child_filters;
+      std::vector<TypedExprPtr> inputs;
+      for (const auto& child : children) {
+        inputs.push_back(toVeloxFilter(*child, column));
+      }
+      return std::make_shared<CallTypedExpr>(
+          BOOLEAN(), std::move(inputs), isAnd ? "and" : "or");
+    }
+    default:
+      VELOX_NYI(
+          "Pushed down filter is not supported yet: {}",
+          filter.ToString(column->name()));
+  }
+}
+
 std::string mapAggregateFunctionName(const std::string& name) {
   static const std::unordered_map<std::string, std::string> kMapping = {
       {"count_star", "count"},
@@ -153,6 +246,8 @@ PlanNodePtr toVeloxPlan(
   const auto& columnIds = logicalGet.column_ids;
   std::vector<std::string> names;
   std::vector<TypePtr> types;
+  // The output column of each of 'columnIds'.
+  std::vector<FieldAccessTypedExprPtr> columns(columnIds.size());
   constexpr uint64_t kNone = ~0UL;
   for (auto i = 0; i < columnIds.size(); ++i) {
     if (columnIds[i] == kNone) {
@@ -163,16 +258,36 @@ PlanNodePtr toVeloxPlan(
     types.push_back(
         duckdb::toVeloxType(logicalGet.returned_types[columnIds[i]]));
     columnNames.push_back(logicalGet.names[columnIds[i]]);
+    columns[i] =
+        std::make_shared<FieldAccessTypedExpr>(types.back(), names.back());
   }
 
   auto rowType = ROW(std::move(names), std::move(types));
 
+  // Filters pushed into the scan by DuckDB's optimizer. These are keyed on
+  // the index in 'columnIds'.
+  std::vector<TypedExprPtr> conjuncts;
+  for (const auto& [index, filter] : logicalGet.table_filters.filters) {
+    VELOX_CHECK_LT(index, columns.size());
+    VELOX_CHECK_NOT_NULL(columns[index]);
+    conjuncts.push_back(toVeloxFilter(*filter, columns[index]));
+  }
+  const auto withFilters = [&](PlanNodePtr scan) -> PlanNodePtr {
+    if (conjuncts.empty()) {
+      return scan;
+    }
+    return std::make_shared<FilterNode>(
+        queryContext.nextNodeId(),
+        andConjuncts(std::move(conjuncts)),
+        std::move(scan));
+  };
+
   auto tableName = logicalGet.function.to_string(logicalGet.bind_data.get());
   auto it = queryContext.inMemoryTables.find(tableName);
 
   if (it == queryContext.inMemoryTables.end()) {
-    return queryContext.makeTableScan(
-        queryContext.nextNodeId(), tableName, rowType, columnNames);
+    return withFilters(queryContext.makeTableScan(
+        queryContext.nextNodeId(), tableName, rowType, columnNames));
   }
 
   std::vector<RowVectorPtr> data;
@@ -188,7 +303,8 @@ PlanNodePtr toVeloxPlan(
             pool, rowType, nullptr, rowVector->size(), children));
   }
 
-  return std::make_shared<ValuesNode>(queryContext.nextNodeId(), data);
+  return withFilters(
+      std::make_shared<ValuesNode>(queryContext.nextNodeId(), data));
 }
 
 TypedExprPtr toVeloxExpression(
@@ -277,17 +393,44 @@ TypedExprPtr toVeloxExpression(
           duckdb::duckValueToVariant(constant->value));
     }
     case ::duckdb::ExpressionType::COMPARE_EQUAL:
-      return toVeloxComparisonExpression("eq", expression, inputType);
     case ::duckdb::ExpressionType::COMPARE_NOTEQUAL:
-      return toVeloxComparisonExpression("neq", expression, inputType);
     case ::duckdb::ExpressionType::COMPARE_GREATERTHAN:
-      return toVeloxComparisonExpression("gt", expression, inputType);
     case ::duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO:
-      return toVeloxComparisonExpression("gte", expression, inputType);
     case ::duckdb::ExpressionType::COMPARE_LESSTHAN:
-      return toVeloxComparisonExpression("lt", expression, inputType);
     case ::duckdb::ExpressionType::COMPARE_LESSTHANOREQUALTO:
-      return toVeloxComparisonExpression("lte", expression, inputType);
+      return toVeloxComparisonExpression(
+          comparisonFunctionName(expression.type), expression, inputType);
+    case ::duckdb::ExpressionType::CONJUNCTION_AND:
+    case ::duckdb::ExpressionType::CONJUNCTION_OR: {
+      auto* conjunction =
+          dynamic_cast<::duckdb::BoundConjunctionExpression*>(&expression);
+      std::vector<TypedExprPtr> children;
+      for (auto& child : conjunction->children) {
+        children.push_back(toVeloxExpression(*child, inputType));
+      }
+      return std::make_shared<CallTypedExpr>(
+          BOOLEAN(),
+          std::move(children),
+          expression.type == ::duckdb::ExpressionType::CONJUNCTION_AND
+              ? "and"
+              : "or");
+    }
+    case ::duckdb::ExpressionType::OPERATOR_NOT:
+    case ::duckdb::ExpressionType::OPERATOR_IS_NULL:
+    case ::duckdb::ExpressionType::OPERATOR_IS_NOT_NULL: {
+      auto* op = dynamic_cast<::duckdb::BoundOperatorExpression*>(&expression);
+      VELOX_CHECK_EQ(op->children.size(), 1);
+      auto child = toVeloxExpression(*op->children[0], inputType);
+      if (expression.type == ::duckdb::ExpressionType::OPERATOR_NOT) {
+        return std::make_shared<CallTypedExpr>(BOOLEAN(), "not", child);
+      }
+      auto isNull =
+          std::make_shared<CallTypedExpr>(BOOLEAN(), "is_null", child);
+      if (expression.type == ::duckdb::ExpressionType::OPERATOR_IS_NULL) {
+        return isNull;
+      }
+      return std::make_shared<CallTypedExpr>(BOOLEAN(), "not", isNull);
+    }
 
     case ::duckdb::ExpressionType::OPERATOR_CAST: {
       auto* cast = dynamic_cast<::duckdb::BoundCastExpression*>(&expression);
@@ -488,16 +631,95 @@ PlanNodePtr toVeloxPlan(
     names.push_back(queryContext.nextColumnName("_a"));
   }
 
-  return std::make_shared<AggregationNode>(
+  if (!queryContext.parallel) {
+    return std::make_shared<AggregationNode>(
+        queryContext.nextNodeId(),
+        AggregationNode::Step::kSingle,
+        groupingKeys,
+        std::vector<FieldAccessTypedExprPtr>{}, // preGroupedKeys
+        names,
+        std::move(aggregates),
+        /*ignoreNullKeys=*/false,
+        /*noGroupsSpanBatches=*/false,
+        source);
+  }
+
+  // Each driver aggregates its part of the input into accumulators, which
+  // are then repartitioned on the grouping keys, or gathered for a global
+  // aggregation, and merged into the final results.
+  std::vector<AggregationNode::Aggregate> partialAggregates;
+  std::vector<AggregationNode::Aggregate> finalAggregates;
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    const auto intermediateType = exec::resolveIntermediateType(
+        aggregate.call->name(), aggregate.rawInputTypes);
+    partialAggregates.push_back(aggregate);
+    partialAggregates.back().call = std::make_shared<CallTypedExpr>(
+        intermediateType, aggregate.call->inputs(), aggregate.call->name());
+    finalAggregates.push_back(aggregate);
+    finalAggregates.back().call = std::make_shared<CallTypedExpr>(
+        aggregate.call->type(),
+        std::vector<TypedExprPtr>{
+            std::make_shared<FieldAccessTypedExpr>(intermediateType, names[i])},
+        aggregate.call->name());
+  }
+
+  PlanNodePtr partial = std::make_shared<AggregationNode>(
       queryContext.nextNodeId(),
-      AggregationNode::Step::kSingle,
+      AggregationNode::Step::kPartial,
       groupingKeys,
       std::vector<FieldAccessTypedExprPtr>{}, // preGroupedKeys
       names,
-      std::move(aggregates),
+      std::move(partialAggregates),
       /*ignoreNullKeys=*/false,
       /*noGroupsSpanBatches=*/false,
       source);
+
+  PlanNodePtr exchange;
+  if (groupingKeys.empty()) {
+    exchange = LocalPartitionNode::gather(queryContext.nextNodeId(), {partial});
+  } else {
+    // The grouping keys lead the output of the partial aggregation.
+    std::vector<column_index_t> keyChannels(groupingKeys.size());
+    std::iota(keyChannels.begin(), keyChannels.end(), 0);
+    exchange = std::make_shared<LocalPartitionNode>(
+        queryContext.nextNodeId(),
+        LocalPartitionNode::Type::kRepartition,
+        /*scaleWriter=*/false,
+        std::make_shared<exec::HashPartitionFunctionSpec>(
+            partial->outputType(), std::move(keyChannels)),
+        std::vector<PlanNodePtr>{partial});
+  }
+
+  return std::make_shared<AggregationNode>(
+      queryContext.nextNodeId(),
+      AggregationNode::Step::kFinal,
+      groupingKeys,
+      std::vector<FieldAccessTypedExprPtr>{}, // preGroupedKeys
+      names,
+      std::move(finalAggregates),
+      /*ignoreNullKeys=*/false,
+      /*noGroupsSpanBatches=*/false,
+      std::move(exchange));
+}
+
+// Appends the sort keys and orders of 'orders' to 'keys' and 'sortOrder'.
+// Keys that are not columns of 'source' are added to 'projections'.
+void toVeloxSortKeys(
+    const std::vector<::duckdb::BoundOrderByNode>& orders,
+    const PlanNodePtr& source,
+    VeloxColumnProjections& projections,
+    std::vector<FieldAccessTypedExprPtr>& keys,
+    std::vector<SortOrder>& sortOrder) {
+  for (auto& order : orders) {
+    keys.push_back(
+        projections.toFieldAccess(*order.expression, source->outputType()));
+    sortOrder.push_back(SortOrder(
+        order.type == ::duckdb::OrderType::ASCENDING ||
+            order.type == ::duckdb::OrderType::ORDER_DEFAULT,
+        order.null_order == ::duckdb::OrderByNullType::NULLS_FIRST ||
+            order.null_order == ::duckdb::OrderByNullType::ORDER_DEFAULT));
+  }
 }
 
 PlanNodePtr toVeloxPlan(
@@ -509,22 +731,72 @@ PlanNodePtr toVeloxPlan(
   std::vector<FieldAccessTypedExprPtr> keys;
   std::vector<SortOrder> sortOrder;
   const auto& source = sources[0];
-  for (auto& order : logicalOrder.orders) {
-    keys.push_back(
-        projections.toFieldAccess(*order.expression, source->outputType()));
-    sortOrder.push_back(SortOrder(
-        order.type == ::duckdb::OrderType::ASCENDING ||
-            order.type == ::duckdb::OrderType::ORDER_DEFAULT,
-        order.null_order == ::duckdb::OrderByNullType::NULLS_FIRST ||
-            order.null_order == ::duckdb::OrderByNullType::ORDER_DEFAULT));
+  toVeloxSortKeys(logicalOrder.orders, source, projections, keys, sortOrder);
+
+  if (!queryContext.parallel) {
+    return std::make_shared<OrderByNode>(
+        queryContext.nextNodeId(),
+        keys,
+        sortOrder,
+        /*isPartial=*/false,
+        projections.source(source));
   }
 
-  return std::make_shared<OrderByNode>(
+  // Each driver sorts its part of the input and the sorted runs are merged.
+  auto partial = std::make_shared<OrderByNode>(
       queryContext.nextNodeId(),
       keys,
       sortOrder,
-      /*isPartial=*/false,
+      /*isPartial=*/true,
       projections.source(source));
+  return std::make_shared<LocalMergeNode>(
+      queryContext.nextNodeId(),
+      std::move(keys),
+      std::move(sortOrder),
+      std::vector<PlanNodePtr>{std::move(partial)});
+}
+
+PlanNodePtr toVeloxPlan(
+    ::duckdb::LogicalTopN& logicalTopN,
+    memory::MemoryPool* pool,
+    std::vector<PlanNodePtr> sources,
+    QueryContext& queryContext) {
+  VeloxColumnProjections projections(queryContext);
+  std::vector<FieldAccessTypedExprPtr> keys;
+  std::vector<SortOrder> sortOrder;
+  const auto& source = sources[0];
+  toVeloxSortKeys(logicalTopN.orders, source, projections, keys, sortOrder);
+
+  // TopN has no offset. Keep the first 'offset' rows and skip them after.
+  const auto count = logicalTopN.offset + logicalTopN.limit;
+  VELOX_USER_CHECK_LE(
+      count,
+      std::numeric_limits<int32_t>::max(),
+      "TopN count is too large: {}",
+      count);
+
+  PlanNodePtr topN = std::make_shared<TopNNode>(
+      queryContext.nextNodeId(),
+      keys,
+      sortOrder,
+      count,
+      /*isPartial=*/queryContext.parallel,
+      projections.source(source));
+  if (queryContext.parallel) {
+    topN = std::make_shared<LocalMergeNode>(
+        queryContext.nextNodeId(),
+        std::move(keys),
+        std::move(sortOrder),
+        std::vector<PlanNodePtr>{std::move(topN)});
+  } else if (logicalTopN.offset == 0) {
+    return topN;
+  }
+  return std::make_shared<LimitNode>(
+      queryContext.nextNodeId(),
+      logicalTopN.offset,
+      logicalTopN.limit,
+      /*isPartial=*/false,
+      std::move(topN));
 }
 
 PlanNodePtr toVeloxPlan(
@@ -783,14 +1055,36 @@ PlanNodePtr toVeloxPlan(
           std::move(sources),
           queryContext);
     }
+    case ::duckdb::LogicalOperatorType::LOGICAL_TOP_N:
+      return toVeloxPlan(
+          dynamic_cast<::duckdb::LogicalTopN&>(plan),
+          pool,
+          std::move(sources),
+          queryContext);
     case ::duckdb::LogicalOperatorType::LOGICAL_LIMIT: {
       auto& limit = dynamic_cast<const ::duckdb::LogicalLimit&>(plan);
+      if (!queryContext.parallel) {
+        return std::make_shared<core::LimitNode>(
+            queryContext.nextNodeId(),
+            limit.offset_val,
+            limit.limit_val,
+            false,
+            sources[0]);
+      }
+      // Each driver produces at most 'offset + limit' rows. The offset is
+      // applied once the rows are gathered.
+      auto partial = std::make_shared<core::LimitNode>(
+          queryContext.nextNodeId(),
+          0,
+          limit.offset_val + limit.limit_val,
+          true,
+          sources[0]);
       return std::make_shared<core::LimitNode>(
           queryContext.nextNodeId(),
           limit.offset_val,
           limit.limit_val,
           false,
-          sources[0]);
+          LocalPartitionNode::gather(queryContext.nextNodeId(), {partial}));
     }
     case ::duckdb::LogicalOperatorType::LOGICAL_COMPARISON_JOIN:
       return toVeloxPlan(
@@ -1025,14 +1319,18 @@ void DuckDbQueryPlanner::registerAggregateFunction(
 }
 
 PlanNodePtr DuckDbQueryPlanner::plan(const std::string& sql) {
-  // Disable the optimizer. Otherwise, the filter over table scan gets pushdown
-  // as a callback that is impossible to recover.
-  conn_.Query("PRAGMA disable_optimizer");
+  // Filters pushed into a scan by the optimizer are converted back into a
+  // FilterNode over the scan. Rewrites that produce operators other than the
+  // ones handled above make the conversion fail.
+  conn_.Query(
+      options_.optimize ? "PRAGMA enable_optimizer"
+                        : "PRAGMA disable_optimizer");
 
   auto plan = conn_.ExtractPlan(sql);
 
   QueryContext queryContext{tables_};
   queryContext.makeTableScan = makeTableScan_;
+  queryContext.parallel = options_.parallel;
   return toVeloxPlan(*plan, pool_, queryContext);
 }
 
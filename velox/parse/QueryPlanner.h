@@ -30,9 +30,24 @@ using MakeTableScan = std::function<PlanNodePtr(
     const RowTypePtr& rowType,
     const std::vector<std::string>& columnNames)>;
 
+/// Plans SQL queries with DuckDB's parser and planner and converts the
+/// resulting logical plans to Velox plans.
 class DuckDbQueryPlanner {
  public:
-  DuckDbQueryPlanner(memory::MemoryPool* pool) : pool_{pool} {}
+  struct Options {
+    /// Runs DuckDB's optimizer before the conversion, e.g. to reorder joins
+    /// and push filters into the scans. The filters pushed into a scan become
+    /// a filter over the scan.
+    bool optimize{false};
+
+    /// Makes plans that run on several drivers. Aggregations are split into
+    /// partial and final steps over a local exchange, and order by and limit
+    /// are computed per driver, then merged.
+    bool parallel{false};
+  };
+
+  explicit DuckDbQueryPlanner(memory::MemoryPool* pool, Options options = {})
+      : pool_{pool}, options_{options} {}
 
   void registerTable(
       const std::string& name,
@@ -63,6 +78,7 @@ class DuckDbQueryPlanner {
   ::duckdb::DuckDB db_;
   ::duckdb::Connection conn_{db_};
   memory::MemoryPool* pool_;
+  const Options options_;
   std::unordered_map<std::string, std::vector<RowVectorPtr>> tables_;
   MakeTableScan makeTableScan_{nullptr};
 };
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "velox/parse/QueryPlanner.h"
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 
 namespace facebook::velox::core::test {
 
@@ -22,6 +24,7 @@ class QueryPlannerTest : public testing::Test {
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+    aggregate::prestosql::registerAllAggregateFunctions();
   }
 
   void assertPlan(
@@ -157,6 +160,52 @@ TEST_F(QueryPlannerTest, customAggregateFunctions) {
       "          -- Values[0]\n");
 }
 
+TEST_F(QueryPlannerTest, optimizedParallel) {
+  DuckDbQueryPlanner planner(
+      pool_.get(), {.optimize = true, .parallel = true});
+  planner.registerTable(
+      "t",
+      {makeEmptyRowVector(
+          ROW({"a", "b", "c"}, {BIGINT(), INTEGER(), SMALLINT()}))});
+
+  auto toString = [&](const std::string& sql) {
+    SCOPED_TRACE(sql);
+    return planner.plan(sql)->toString(true, true);
+  };
+
+  // The filter pushed into the scan comes back as a Filter over the scan.
+  auto plan = toString("SELECT a FROM t WHERE c > 5 AND b IS NOT NULL");
+  EXPECT_THAT(plan, testing::HasSubstr("-- Filter["));
+  EXPECT_THAT(plan, testing::HasSubstr("gt"));
+  EXPECT_THAT(plan, testing::HasSubstr("is_null"));
+
+  plan = toString("SELECT a, sum(b) FROM t GROUP BY 1");
+  EXPECT_THAT(plan, testing::HasSubstr("[FINAL"));
+  EXPECT_THAT(plan, testing::HasSubstr("[REPARTITION"));
+  EXPECT_THAT(plan, testing::HasSubstr("[PARTIAL"));
+
+  plan = toString("SELECT count(*) FROM t");
+  EXPECT_THAT(plan, testing::HasSubstr("[FINAL"));
+  EXPECT_THAT(plan, testing::HasSubstr("[GATHER]"));
+  EXPECT_THAT(plan, testing::HasSubstr("[PARTIAL"));
+
+  plan = toString("SELECT a FROM t ORDER BY b");
+  EXPECT_THAT(plan, testing::HasSubstr("-- LocalMerge["));
+  EXPECT_THAT(plan, testing::HasSubstr("-- OrderBy["));
+  EXPECT_THAT(plan, testing::HasSubstr("PARTIAL"));
+
+  // The optimizer turns ORDER BY + LIMIT into a TopN.
+  plan = toString("SELECT a FROM t ORDER BY b LIMIT 10 OFFSET 2");
+  EXPECT_THAT(plan, testing::HasSubstr("-- Limit["));
+  EXPECT_THAT(plan, testing::HasSubstr("-- LocalMerge["));
+  EXPECT_THAT(plan, testing::HasSubstr("-- TopN["));
+  EXPECT_THAT(plan, testing::HasSubstr("12"));
+
+  plan = toString("SELECT a FROM t LIMIT 10");
+  EXPECT_THAT(plan, testing::HasSubstr("-- LocalPartition["));
+  EXPECT_THAT(plan, testing::HasSubstr("PARTIAL 10"));
+}
+
 TEST_F(QueryPlannerTest, error) {
   assertPlanError(
       "SELECT * FROM my_table", "Table with name my_table does not exist");
@@ -20,6 +20,8 @@
 #include <arrow/python/pyarrow.h>
 #include <arrow/record_batch.h>
 
+#include <cerrno>
+
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -29,10 +31,82 @@
 
 namespace py = pybind11;
 
+namespace {
+
+// State of an ArrowArrayStream over a Python iterator of Velox RowVectors,
+// e.g. a pyvelox.runner.TaskIterator. The callbacks may be called without the
+// GIL, so these acquire it before touching the iterator.
+struct VectorStream {
+  py::object iterator;
+  // The vector read ahead to get the schema, returned by the first
+  // get_next().
+  facebook::velox::VectorPtr first;
+  facebook::velox::memory::MemoryPool* pool;
+  std::string lastError;
+};
+
+int vectorStreamGetSchema(ArrowArrayStream* stream, ArrowSchema* out) {
+  auto* state = static_cast<VectorStream*>(stream->private_data);
+  if (state->first == nullptr) {
+    state->lastError = "The schema of an empty stream is unknown.";
+    return EINVAL;
+  }
+  try {
+    facebook::velox::exportToArrow(state->first, *out);
+  } catch (const std::exception& e) {
+    state->lastError = e.what();
+    return EINVAL;
+  }
+  return 0;
+}
+
+int vectorStreamGetNext(ArrowArrayStream* stream, ArrowArray* out) {
+  auto* state = static_cast<VectorStream*>(stream->private_data);
+  try {
+    facebook::velox::VectorPtr vector = std::move(state->first);
+    if (vector == nullptr) {
+      py::gil_scoped_acquire acquire;
+      auto next = py::reinterpret_steal<py::object>(
+          PyIter_Next(state->iterator.ptr()));
+      if (next.ptr() == nullptr) {
+        if (PyErr_Occurred()) {
+          throw py::error_already_set();
+        }
+        // End of stream.
+        out->release = nullptr;
+        return 0;
+      }
+      vector = next.cast<facebook::velox::py::PyVector&>().vector();
+    }
+    // Shares the buffers of flat vectors with the array instead of copying.
+    facebook::velox::exportToArrow(vector, *out, state->pool);
+  } catch (const std::exception& e) {
+    state->lastError = e.what();
+    return EIO;
+  }
+  return 0;
+}
+
+const char* vectorStreamGetLastError(ArrowArrayStream* stream) {
+  auto* state = static_cast<VectorStream*>(stream->private_data);
+  return state->lastError.empty() ? nullptr : state->lastError.c_str();
+}
+
+void vectorStreamRelease(ArrowArrayStream* stream) {
+  {
+    py::gil_scoped_acquire acquire;
+    delete static_cast<VectorStream*>(stream->private_data);
+  }
+  stream->release = nullptr;
+}
+
+} // namespace
+
 /// This module adds two functions `to_velox()` and `to_arrow()` that allow the
 /// conversion between Velox Vectors and Arrow Arrays from a Python program. It
 /// works by extracting the Arrow C structures from the Arrow C++ Array, then
 /// using Velox's Arrow bridge to convert it to a Velox Vector (and vice-versa).
+/// `to_arrow_reader()` streams a sequence of Vectors as record batches.
 PYBIND11_MODULE(arrow, m) {
   using namespace facebook;
 
@@ -121,5 +195,55 @@ Converts a velox vector to an arrow object.
     >>> vec = pv.from_list([1, 2, 3, 4, 5])
     >>> arrow = to_arrow(vec)
 
+)pbdoc");
+
+  /// Wraps an iterator of pyvelox.vector.Vector in a pyarrow.RecordBatchReader
+  /// through the Arrow C stream interface. Reads the first vector to get the
+  /// schema, then one vector per batch read.
+  m.def(
+      "to_arrow_reader",
+      [](py::object& vectors) {
+        auto state = std::make_unique<VectorStream>();
+        state->iterator = py::iter(vectors);
+        state->pool = leafPool.get();
+        auto first = py::reinterpret_steal<py::object>(
+            PyIter_Next(state->iterator.ptr()));
+        if (first.ptr() == nullptr) {
+          if (PyErr_Occurred()) {
+            throw py::error_already_set();
+          }
+          throw std::runtime_error(
+              "Cannot make an arrow reader over no vectors.");
+        }
+        state->first = first.cast<velox::py::PyVector&>().vector();
+        if (state->first->typeKind() != velox::TypeKind::ROW) {
+          throw std::runtime_error("Arrow readers take row vectors.");
+        }
+
+        ArrowArrayStream stream;
+        stream.get_schema = vectorStreamGetSchema;
+        stream.get_next = vectorStreamGetNext;
+        stream.get_last_error = vectorStreamGetLastError;
+        stream.release = vectorStreamRelease;
+        stream.private_data = state.release();
+        return py::module::import("pyarrow")
+            .attr("RecordBatchReader")
+            .attr("_import_from_c")(reinterpret_cast<uintptr_t>(&stream));
+      },
+      R"pbdoc(
+Wraps an iterator of velox row vectors, such as the one returned by
+LocalRunner.execute(), in a pyarrow.RecordBatchReader. The vectors are read as
+the batches are, so the results stream into arrow without being materialized.
+Flat vectors are handed over without copies.
+
+:param vectors: An iterator or iterable of velox row vectors.
+
+:examples:
+
+.. doctest::
+
+    >>> reader = to_arrow_reader(runner.execute())
+    >>> table = reader.read_all()
+
 )pbdoc");
 }
@@ -15,7 +15,9 @@
 # pyre-unsafe
 
 from pyvelox.vector import Vector
-from pyarrow import Array, RecordBatch
+from typing import Iterable
+from pyarrow import Array, RecordBatch, RecordBatchReader
 
 def to_velox(array: Array | RecordBatch) -> Vector: ...
 def to_arrow(vector: Vector) -> Array: ...
+def to_arrow_reader(vectors: Iterable[Vector]) -> RecordBatchReader: ...
@@ -69,7 +69,13 @@ PyTaskIterator::PyTaskIterator(
 }
 
 PyVector PyTaskIterator::next() {
-  if (!cursor_->moveNext()) {
+  bool hasNext;
+  {
+    // Drivers and other Python threads run while waiting for the output.
+    py::gil_scoped_release release;
+    hasNext = cursor_->moveNext();
+  }
+  if (!hasNext) {
     vector_ = nullptr;
     throw py::stop_iteration(); // Raise StopIteration when done.
   }
@@ -78,7 +84,13 @@ PyVector PyTaskIterator::next() {
 }
 
 PyVector PyTaskIterator::step(const std::string& planId) {
-  if (!cursor_->moveStep(planId)) {
+  bool hasNext;
+  {
+    // Hooks acquire the GIL to run their callbacks.
+    py::gil_scoped_release release;
+    hasNext = cursor_->moveStep(planId);
+  }
+  if (!hasNext) {
     vector_ = nullptr;
     throw py::stop_iteration(); // Raise StopIteration when done.
   }
@@ -37,6 +37,7 @@ class PyTaskIterator {
     return *this;
   }
 
+  /// Returns the next output vector. Releases the GIL while waiting for it.
   PyVector next();
 
   /// Steps through execution, returning either the input to the next operator
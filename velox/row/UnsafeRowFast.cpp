@@ -173,6 +173,118 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) const {
   return serializeRow(index, buffer);
 }
 
+template <typename T>
+void UnsafeRowFast::serializeFixedWidthColumn(
+    const raw_vector<vector_size_t>& rows,
+    int32_t fieldIndex,
+    size_t slotOffset,
+    const size_t* bufferOffsets,
+    char* buffer) const {
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  for (auto i = 0; i < rows.size(); ++i) {
+    char* row = buffer + bufferOffsets[i];
+    if (mayHaveNulls && decoded_.isNullAt(rows[i])) {
+      bits::setBit(row, fieldIndex, true);
+      continue;
+    }
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      const int64_t micros = decoded_.valueAt<Timestamp>(rows[i]).toMicros();
+      memcpy(row + slotOffset, &micros, sizeof(int64_t));
+    } else {
+      const T value = decoded_.valueAt<T>(rows[i]);
+      memcpy(row + slotOffset, &value, sizeof(T));
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) const {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  raw_vector<vector_size_t> rows(size);
+  for (auto i = 0; i < size; ++i) {
+    rows[i] = decoded_.index(offset + i);
+  }
+
+  // Offsets of the variable-width sections, relative to the start of each
+  // row. Grow as the variable-width fields are written.
+  raw_vector<int64_t> variableWidthOffsets(size);
+  std::fill(
+      variableWidthOffsets.begin(),
+      variableWidthOffsets.end(),
+      rowNullBytes_ + kFieldWidth * children_.size());
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    const size_t slotOffset = rowNullBytes_ + i * kFieldWidth;
+    if (childIsFixedWidth_[i]) {
+      switch (child.typeKind_) {
+        case TypeKind::BOOLEAN:
+          child.serializeFixedWidthColumn<bool>(
+              rows, i, slotOffset, bufferOffsets, buffer);
+          break;
+        case TypeKind::TINYINT:
+          child.serializeFixedWidthColumn<int8_t>(
+              rows, i, slotOffset, bufferOffsets, buffer);
+          break;
+        case TypeKind::SMALLINT:
+          child.serializeFixedWidthColumn<int16_t>(
+              rows, i, slotOffset, bufferOffsets, buffer);
+          break;
+        case TypeKind::INTEGER:
+          child.serializeFixedWidthColumn<int32_t>(
+              rows, i, slotOffset, bufferOffsets, buffer);
+          break;
+        case TypeKind::BIGINT:
+          child.serializeFixedWidthColumn<int64_t>(
+              rows, i, slotOffset, bufferOffsets, buffer);
+          break;
+        case TypeKind::REAL:
+          child.serializeFixedWidthColumn<float>(
+              rows, i, slotOffset, bufferOffsets, buffer);
+          break;
+        case TypeKind::DOUBLE:
+          child.serializeFixedWidthColumn<double>(
+              rows, i, slotOffset, bufferOffsets, buffer);
+          break;
+        case TypeKind::TIMESTAMP:
+          child.serializeFixedWidthColumn<Timestamp>(
+              rows, i, slotOffset, bufferOffsets, buffer);
+          break;
+        default:
+          // UNKNOWN values are always null.
+          for (auto row = 0; row < size; ++row) {
+            if (child.isNullAt(rows[row])) {
+              bits::setBit(buffer + bufferOffsets[row], i, true);
+            } else {
+              child.serializeFixedWidth(
+                  rows[row], buffer + bufferOffsets[row] + slotOffset);
+            }
+          }
+      }
+      continue;
+    }
+
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    for (auto row = 0; row < size; ++row) {
+      char* rowBuffer = buffer + bufferOffsets[row];
+      if (mayHaveNulls && child.isNullAt(rows[row])) {
+        bits::setBit(rowBuffer, i, true);
+        continue;
+      }
+      auto& variableWidthOffset = variableWidthOffsets[row];
+      const auto valueSize = child.serializeVariableWidth(
+          rows[row], rowBuffer + variableWidthOffset);
+      // Write size and offset.
+      const uint64_t sizeAndOffset = variableWidthOffset << 32 | valueSize;
+      memcpy(rowBuffer + slotOffset, &sizeAndOffset, sizeof(uint64_t));
+      variableWidthOffset += alignBytes(valueSize);
+    }
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer)
     const {
   VELOX_DCHECK(fixedWidthTypeKind_);
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/memory/RawVector.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
 
@@ -43,6 +44,17 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer) const;
 
+  /// Serializes rows in the range [offset, offset + size) into 'buffer' at
+  /// given 'bufferOffsets', one column at a time. 'buffer' must have
+  /// sufficient capacity and set to all zeros. 'bufferOffsets' must be
+  /// accessible for 'size' elements and the space between each offset must be
+  /// no less than the 'fixedRowSize' or 'rowSize' of the row.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer) const;
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   /// @param data The start memory address of each row.
@@ -118,6 +130,17 @@ class UnsafeRowFast {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer) const;
 
+  /// Writes the fixed-width values at 'rows' into the field slot at
+  /// 'slotOffset' of the rows at 'bufferOffsets' and sets null bit
+  /// 'fieldIndex' of the rows with nulls.
+  template <typename T>
+  void serializeFixedWidthColumn(
+      const raw_vector<vector_size_t>& rows,
+      int32_t fieldIndex,
+      size_t slotOffset,
+      const size_t* bufferOffsets,
+      char* buffer) const;
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
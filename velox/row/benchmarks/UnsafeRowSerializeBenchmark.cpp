@@ -39,6 +39,21 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeUnsafeRange(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    const auto numRows = data->size();
+    std::vector<size_t> rowSize(numRows);
+    std::vector<size_t> offsets(numRows);
+
+    UnsafeRowFast fast(data);
+    auto totalSize = computeTotalSize(fast, rowType, numRows, rowSize, offsets);
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    fast.serialize(0, numRows, offsets.data(), buffer->asMutable<char>());
+  }
+
   void deserializeUnsafe(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -162,14 +177,15 @@ class SerializeBenchmark {
     return serialized;
   }
 
+  template <typename Serializer>
   size_t computeTotalSize(
-      CompactRow& compactRow,
+      Serializer& row,
       const RowTypePtr& rowType,
       vector_size_t numRows,
       std::vector<size_t>& rowSize,
       std::vector<size_t>& offsets) {
     size_t totalSize = 0;
-    if (auto fixedRowSize = CompactRow::fixedRowSize(rowType)) {
+    if (auto fixedRowSize = Serializer::fixedRowSize(rowType)) {
       totalSize = fixedRowSize.value() * numRows;
       for (auto i = 0; i < numRows; ++i) {
         rowSize[i] = fixedRowSize.value();
@@ -177,7 +193,7 @@ class SerializeBenchmark {
       }
     } else {
       for (auto i = 0; i < numRows; ++i) {
-        rowSize[i] = compactRow.rowSize(i);
+        rowSize[i] = row.rowSize(i);
         offsets[i] = totalSize;
         totalSize += rowSize[i];
       }
@@ -229,6 +245,11 @@ class SerializeBenchmark {
     benchmark.serializeUnsafe(rowType);      \
   }                                          \
                                              \
+  BENCHMARK(unsafe_range_serialize_##name) { \
+    SerializeBenchmark benchmark;            \
+    benchmark.serializeUnsafeRange(rowType); \
+  }                                          \
+                                             \
   BENCHMARK(compact_serialize_##name) {      \
     SerializeBenchmark benchmark;            \
     benchmark.serializeCompact(rowType);     \
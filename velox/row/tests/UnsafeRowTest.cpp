@@ -123,6 +123,21 @@ class UnsafeRowTest : public ::testing::Test, public VectorTestBase {
     VectorPtr outputVector =
         UnsafeRowFast::deserialize(serialized, rowType, pool_.get());
     assertEqualVectors(data, outputVector);
+
+    // Serialize by range and expect the same bytes.
+    BufferPtr rangeBuffer =
+        AlignedBuffer::allocate<char>(totalSize, pool_.get(), 0);
+    auto* rawRangeBuffer = rangeBuffer->asMutable<char>();
+    vector_size_t rangeOffset = 0;
+    vector_size_t rangeSize = 1;
+    while (rangeOffset < numRows) {
+      auto size = std::min<vector_size_t>(rangeSize, numRows - rangeOffset);
+      row.serialize(
+          rangeOffset, size, offsets.data() + rangeOffset, rawRangeBuffer);
+      rangeOffset += size;
+      rangeSize = checkedMultiply<vector_size_t>(rangeSize, 2);
+    }
+    ASSERT_EQ(memcmp(rawBuffer, rawRangeBuffer, totalSize), 0);
   }
 
   std::shared_ptr<memory::MemoryPool> pool_ =
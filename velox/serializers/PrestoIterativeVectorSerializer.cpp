@@ -35,6 +35,9 @@ PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
     streams_.emplace_back(
         types[i], std::nullopt, std::nullopt, streamArena, numRows, opts);
   }
+  if (opts_.columnCompression) {
+    columnStates_.resize(numTypes);
+  }
 }
 
 void PrestoIterativeVectorSerializer::append(
@@ -59,14 +62,57 @@ void PrestoIterativeVectorSerializer::append(
   if (numNewRows == 0) {
     return;
   }
+  const bool firstRows = numRows_ == 0;
   numRows_ += numNewRows;
   for (int32_t i = 0; i < vector->childrenSize(); ++i) {
-    serializeColumn(vector->childAt(i), rows, &streams_[i], scratch);
+    appendRows(i, vector->childAt(i), rows, firstRows, scratch);
   }
 }
 
+void PrestoIterativeVectorSerializer::appendColumn(
+    column_index_t index,
+    const VectorPtr& column,
+    const folly::Range<const vector_size_t*>& rows,
+    Scratch& scratch) {
+  appendRows(index, column, rows, numRows_ == 0, scratch);
+}
+
+void PrestoIterativeVectorSerializer::appendRows(
+    column_index_t index,
+    const VectorPtr& column,
+    const folly::Range<const vector_size_t*>& rows,
+    bool firstRows,
+    Scratch& scratch) {
+  auto& stream = streams_[index];
+  if (!opts_.encodeOnAppend) {
+    serializeColumn(column, rows, &stream, scratch);
+    return;
+  }
+  const auto& loaded = BaseVector::loadedVectorShared(column);
+  if (firstRows && !stream.isConstantStream() &&
+      !stream.isDictionaryStream()) {
+    // The first rows of the page decide the encoding of the column.
+    const auto encoding = loaded->encoding();
+    if (encoding == VectorEncoding::Simple::CONSTANT ||
+        (encoding == VectorEncoding::Simple::DICTIONARY &&
+         !loaded->nulls())) {
+      stream.encodeStream(encoding, rows.size());
+    }
+  }
+  serializeEncodedColumn(loaded, rows, &stream, scratch);
+}
+
 size_t PrestoIterativeVectorSerializer::maxSerializedSize() const {
   size_t dataSize = 4; // streams_.size()
+  if (opts_.columnCompression && needCompression(*codec_)) {
+    // compressed(1) | uncompressedSize(4) | size(4) before each column.
+    for (auto& stream : streams_) {
+      dataSize += 9 +
+          codec_->maxCompressedLength(
+              const_cast<VectorStream&>(stream).serializedSize());
+    }
+    return kHeaderSize + dataSize;
+  }
   for (auto& stream : streams_) {
     dataSize += const_cast<VectorStream&>(stream).serializedSize();
   }
@@ -82,7 +128,17 @@ size_t PrestoIterativeVectorSerializer::maxSerializedSize() const {
 // checksum(8) | data
 void PrestoIterativeVectorSerializer::flush(OutputStream* out) {
   constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
-  if (!needCompression(*codec_)) {
+  if (opts_.columnCompression && needCompression(*codec_)) {
+    flushColumnCompressed(
+        streams_,
+        *streamArena_,
+        *codec_,
+        numRows_,
+        opts_.minCompressionRatio,
+        columnStates_,
+        stats_,
+        out);
+  } else if (!needCompression(*codec_)) {
     flushStreams(
         streams_,
         numRows_,
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/serializers/PrestoSerializer.h"
+#include "velox/serializers/PrestoSerializerSerializationUtils.h"
 #include "velox/serializers/VectorStream.h"
 #include "velox/vector/VectorStream.h"
 
@@ -39,6 +40,20 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       const folly::Range<const vector_size_t*>& rows,
       Scratch& scratch) override;
 
+  bool supportsAppendColumn() const override {
+    return true;
+  }
+
+  void appendColumn(
+      column_index_t index,
+      const VectorPtr& column,
+      const folly::Range<const vector_size_t*>& rows,
+      Scratch& scratch) override;
+
+  void appendNumRows(vector_size_t numRows) override {
+    numRows_ += numRows;
+  }
+
   size_t maxSerializedSize() const override;
 
   // The SerializedPage layout is:
@@ -51,6 +66,16 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   void clear() override;
 
  private:
+  // Appends 'rows' of 'column' to the stream of column 'index'. With
+  // PrestoOptions::encodeOnAppend, 'firstRows' of the page make the stream
+  // CONSTANT or DICTIONARY if 'column' is.
+  void appendRows(
+      column_index_t index,
+      const VectorPtr& column,
+      const folly::Range<const vector_size_t*>& rows,
+      bool firstRows,
+      Scratch& scratch);
+
   const PrestoVectorSerde::PrestoOptions opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::compression::Codec> codec_;
@@ -60,6 +85,8 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
 
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
+  // Compression state of each column with PrestoOptions::columnCompression.
+  std::vector<ColumnCompressionState> columnStates_;
   CompressionStats stats_;
 };
 } // namespace facebook::velox::serializer::presto::detail
@@ -92,8 +92,57 @@ PrestoVectorSerde::PrestoOptions toPrestoOptions(
       !(prestoOptions->useLosslessTimestamp &&
         prestoOptions->useMicrosecondPrecision),
       "useLosslessTimestamp and useMicrosecondPrecision are mutually exclusive");
+  VELOX_CHECK(
+      !prestoOptions->compactTimestamp ||
+          (prestoOptions->useLosslessTimestamp && prestoOptions->nullsFirst),
+      "compactTimestamp requires useLosslessTimestamp and nullsFirst");
   return *prestoOptions;
 }
+
+// Reads the columns of a page written with PrestoOptions::columnCompression.
+void readColumnCompressed(
+    ByteInputStream* source,
+    const RowTypePtr& type,
+    velox::memory::MemoryPool* pool,
+    folly::compression::Codec& codec,
+    const RowVectorPtr& result,
+    vector_size_t resultOffset,
+    const PrestoVectorSerde::PrestoOptions& opts) {
+  const auto numColumns = source->read<int32_t>();
+  VELOX_USER_CHECK_EQ(
+      numColumns,
+      type->size(),
+      "Number of columns in serialized data doesn't match "
+      "number of columns requested for deserialization");
+  auto& children = result->children();
+  for (auto i = 0; i < numColumns; ++i) {
+    const bool compressed = source->read<int8_t>() != 0;
+    const auto uncompressedSize = source->read<int32_t>();
+    const auto size = source->read<int32_t>();
+    auto columnType = ROW({type->nameOf(i)}, {type->childAt(i)});
+    auto column = std::make_shared<RowVector>(
+        pool,
+        columnType,
+        BufferPtr(nullptr),
+        0,
+        std::vector<VectorPtr>{std::move(children[i])});
+    if (!compressed) {
+      const auto offset = source->tellp();
+      detail::readTopColumns(
+          *source, columnType, pool, column, resultOffset, opts, true);
+      VELOX_CHECK_EQ(source->tellp() - offset, size);
+    } else {
+      auto compressBuf = folly::IOBuf::create(size);
+      source->readBytes(compressBuf->writableData(), size);
+      compressBuf->append(size);
+      auto uncompress = codec.uncompress(compressBuf.get(), uncompressedSize);
+      BufferInputStream columnSource(byteRangesFromIOBuf(uncompress.get()));
+      detail::readTopColumns(
+          columnSource, columnType, pool, column, resultOffset, opts, true);
+    }
+    children[i] = column->childAt(0);
+  }
+}
 } // namespace
 
 void PrestoVectorSerde::estimateSerializedSize(
@@ -182,7 +231,10 @@ void PrestoVectorSerde::deserialize(
   VELOX_CHECK_EQ(
       header.checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  if (!detail::isCompressedBitSet(header.pageCodecMarker)) {
+  if (detail::isColumnCompressedBitSet(header.pageCodecMarker)) {
+    readColumnCompressed(
+        source, type, pool, *codec, *result, resultOffset, prestoOptions);
+  } else if (!detail::isCompressedBitSet(header.pageCodecMarker)) {
     detail::readTopColumns(
         *source, type, pool, *result, resultOffset, prestoOptions);
   } else {
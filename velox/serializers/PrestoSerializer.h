@@ -69,6 +69,12 @@ class PrestoVectorSerde : public VectorSerde {
     /// currently used for spilling. Is false by default.
     bool useLosslessTimestamp{false};
 
+    /// With useLosslessTimestamp, writes a timestamp of microsecond or
+    /// coarser precision as one 64-bit value instead of 16 bytes of seconds
+    /// and nanos. Other timestamps take 24 bytes. Only Velox reads this
+    /// format. Requires nullsFirst. Used for spilling.
+    bool compactTimestamp{false};
+
     /// When true, interprets serialized timestamp values as microseconds
     /// instead of milliseconds. Used when the source data contains timestamps
     /// in microsecond precision (e.g., TIMESTAMP_MICROSECONDS Presto type).
@@ -86,6 +92,22 @@ class PrestoVectorSerde : public VectorSerde {
     /// affect the encoding of the input vectors. This is only relevant when
     /// using BatchVectorSerializer.
     bool preserveEncodings{false};
+
+    /// If true, IterativeVectorSerializer::append() with rows keeps constant
+    /// and dictionary encodings on the wire. A column whose first rows in a
+    /// page are a ConstantVector or a DictionaryVector without nulls in the
+    /// wrapper is written as RLE or DICTIONARY. The rows of other constants or
+    /// encodings that follow in the same page become new dictionary values.
+    /// The deserializer produces ConstantVectors and DictionaryVectors for
+    /// these.
+    bool encodeOnAppend{false};
+
+    /// If true, IterativeVectorSerializer compresses each column of a page on
+    /// its own with 'compressionKind' instead of the whole page. Columns that
+    /// do not compress to 'minCompressionRatio', e.g. random data, are written
+    /// uncompressed and are not tried again for a number of pages while the
+    /// other columns stay compressed. Only Velox can read these pages.
+    bool columnCompression{false};
   };
 
   PrestoVectorSerde() : VectorSerde(kSerdeKind) {}
@@ -570,6 +570,15 @@ Timestamp readLosslessTimestamp(ByteInputStream* source) {
   return Timestamp(seconds, nanos);
 }
 
+Timestamp readCompactTimestamp(ByteInputStream* source) {
+  const auto compact = source->read<int64_t>();
+  if (compact == kCompactTimestampEscape) {
+    return readLosslessTimestamp(source);
+  }
+  return Timestamp::fromMicros(compact / 2);
+}
+
+template <bool kCompact>
 void readLosslessTimestampValues(
     ByteInputStream* source,
     vector_size_t size,
@@ -577,6 +586,13 @@ void readLosslessTimestampValues(
     const BufferPtr& nulls,
     vector_size_t nullCount,
     const BufferPtr& values) {
+  auto readValue = [&]() {
+    if constexpr (kCompact) {
+      return readCompactTimestamp(source);
+    } else {
+      return readLosslessTimestamp(source);
+    }
+  };
   auto rawValues = values->asMutable<Timestamp>();
   checkValuesSize<Timestamp>(values, nulls, size, offset);
   if (nullCount > 0) {
@@ -587,12 +603,12 @@ void readLosslessTimestampValues(
           for (; toClear < row; ++toClear) {
             rawValues[toClear] = Timestamp();
           }
-          rawValues[row] = readLosslessTimestamp(source);
+          rawValues[row] = readValue();
           toClear = row + 1;
         });
   } else {
     for (int32_t row = offset; row < offset + size; ++row) {
-      rawValues[row] = readLosslessTimestamp(source);
+      rawValues[row] = readValue();
     }
   }
 }
@@ -741,8 +757,18 @@ void read(
 
   BufferPtr values = flatResult->mutableValues();
   if constexpr (std::is_same_v<T, Timestamp>) {
+    if (opts.useLosslessTimestamp && opts.compactTimestamp) {
+      readLosslessTimestampValues<true>(
+          source,
+          numNewValues,
+          resultOffset,
+          flatResult->nulls(),
+          nullCount,
+          values);
+      return;
+    }
     if (opts.useLosslessTimestamp) {
-      readLosslessTimestampValues(
+      readLosslessTimestampValues<false>(
           source,
           numNewValues,
           resultOffset,
@@ -33,6 +33,10 @@ inline bool isChecksumBitSet(int8_t codec) {
   return (codec & kCheckSumBitMask) == kCheckSumBitMask;
 }
 
+inline bool isColumnCompressedBitSet(int8_t codec) {
+  return (codec & kColumnCompressedBitMask) == kColumnCompressedBitMask;
+}
+
 void readTopColumns(
     ByteInputStream& source,
     const RowTypePtr& type,
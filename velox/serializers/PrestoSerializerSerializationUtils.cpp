@@ -16,6 +16,9 @@
 
 #include "velox/serializers/PrestoSerializerSerializationUtils.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/DictionaryVector.h"
 #include "velox/vector/FlatVector.h"
@@ -1139,6 +1142,71 @@ void serializeColumn(
   }
 }
 
+void serializeEncodedColumn(
+    const VectorPtr& vector,
+    const folly::Range<const vector_size_t*>& rows,
+    VectorStream* stream,
+    Scratch& scratch) {
+  if (rows.empty()) {
+    return;
+  }
+  if (stream->isConstantStream()) {
+    const auto& constant = stream->constantVector();
+    if (vector->isConstantEncoding()) {
+      if (constant == nullptr) {
+        stream->setConstantVector(vector);
+        serializeColumn(
+            vector,
+            folly::Range<const vector_size_t*>(rows.data(), 1),
+            stream->childAt(0),
+            scratch);
+        stream->appendNonNull(rows.size());
+        return;
+      }
+      if (constant->equalValueAt(vector.get(), 0, 0)) {
+        stream->appendNonNull(rows.size());
+        return;
+      }
+    }
+    stream->constantToDictionary();
+  }
+  if (!stream->isDictionaryStream()) {
+    serializeColumn(vector, rows, stream, scratch);
+    return;
+  }
+
+  const auto numRows = rows.size();
+  const int32_t firstIndex = stream->childAt(0)->size();
+  ScratchPtr<int32_t, 64> newIndicesHolder(scratch);
+  auto* newIndices = newIndicesHolder.get(numRows);
+  if (vector->encoding() == VectorEncoding::Simple::DICTIONARY &&
+      !vector->nulls()) {
+    // Adds the used values in ascending order and maps the indices to these.
+    const auto* indices = vector->wrapInfo()->as<vector_size_t>();
+    ScratchPtr<vector_size_t, 64> usedHolder(scratch);
+    auto* used = usedHolder.get(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      used[i] = indices[rows[i]];
+    }
+    std::sort(used, used + numRows);
+    const auto numUsed = std::unique(used, used + numRows) - used;
+    serializeColumn(
+        vector->valueVector(),
+        folly::Range<const vector_size_t*>(used, numUsed),
+        stream->childAt(0),
+        scratch);
+    for (auto i = 0; i < numRows; ++i) {
+      newIndices[i] = firstIndex +
+          (std::lower_bound(used, used + numUsed, indices[rows[i]]) - used);
+    }
+  } else {
+    serializeColumn(vector, rows, stream->childAt(0), scratch);
+    std::iota(newIndices, newIndices + numRows, firstIndex);
+  }
+  stream->appendNonNull(numRows);
+  stream->append(folly::Range<const int32_t*>(newIndices, numRows));
+}
+
 int32_t rowsToRanges(
     folly::Range<const vector_size_t*> rows,
     const uint64_t* rawNulls,
@@ -30,6 +30,9 @@ namespace facebook::velox::serializer::presto::detail {
 constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
+// Set instead of kCompressedBitMask when each column is compressed on its own.
+// Only Velox reads pages with this bit.
+constexpr int8_t kColumnCompressedBitMask = 8;
 // uncompressed size comes after the number of rows and the codec
 constexpr int32_t kSizeInBytesOffset{4 + 1};
 // There header for a page is:
@@ -100,6 +103,27 @@ inline void writeInt64(OutputStream* out, int64_t value) {
   out->write(reinterpret_cast<char*>(&value), sizeof(value));
 }
 
+// With PrestoOptions::compactTimestamp, a timestamp of microsecond precision
+// whose seconds are within +/- kMaxCompactTimestampSeconds is written as one
+// int64 of twice its microseconds. Any other timestamp is written as
+// kCompactTimestampEscape followed by its seconds and nanos.
+constexpr int64_t kMaxCompactTimestampSeconds = 4'000'000'000'000;
+constexpr int64_t kCompactTimestampEscape = 1;
+
+inline bool toCompactTimestamp(const Timestamp& value, int64_t& compact) {
+  const auto seconds = value.getSeconds();
+  if (value.getNanos() % Timestamp::kNanosecondsInMicrosecond != 0 ||
+      seconds > kMaxCompactTimestampSeconds ||
+      seconds < -kMaxCompactTimestampSeconds) {
+    return false;
+  }
+  compact = 2 *
+      (seconds * Timestamp::kMicrosecondsInSecond +
+       static_cast<int64_t>(
+           value.getNanos() / Timestamp::kNanosecondsInMicrosecond));
+  return true;
+}
+
 std::string_view typeToEncodingName(const TypePtr& type);
 
 inline int32_t rangesTotalSize(const folly::Range<const IndexRange*>& ranges) {
@@ -356,6 +380,85 @@ inline FlushSizes flushStreams(
   }
 }
 
+// Per column state of PrestoOptions::columnCompression.
+struct ColumnCompressionState {
+  // Number of pages for which the column is not compressed.
+  int32_t numCompressionToSkip{0};
+  // Number of pages for which compression of the column was skipped.
+  int32_t numCompressionSkipped{0};
+};
+
+// Writes 'streams' as a page where each column is compressed with 'codec' on
+// its own. A column that does not compress to 'minCompressionRatio' is written
+// uncompressed and is not tried again for a number of pages that grows with
+// its number of past skips, as for whole pages. The sizes in the header are
+// both the size of the data. The data is the number of columns followed by
+// compressed(1) | uncompressedSize(4) | size(4) | bytes for each column.
+template <typename Allocator>
+inline void flushColumnCompressed(
+    std::vector<VectorStream, Allocator>& streams,
+    const StreamArena& arena,
+    folly::compression::Codec& codec,
+    int32_t numRows,
+    float minCompressionRatio,
+    std::vector<ColumnCompressionState>& columnStates,
+    CompressionStats& stats,
+    OutputStream* output) {
+  constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
+  VELOX_CHECK_EQ(streams.size(), columnStates.size());
+  auto listener = dynamic_cast<PrestoOutputStreamListener*>(output->listener());
+  char codecMask = kColumnCompressedBitMask;
+  if (listener) {
+    listener->reset();
+    listener->pause();
+    codecMask |= kCheckSumBitMask;
+  }
+  writeInt32(output, numRows);
+
+  IOBufOutputStream out(*(arena.pool()), nullptr, arena.size());
+  writeInt32(&out, streams.size());
+  for (auto i = 0; i < streams.size(); ++i) {
+    auto& state = columnStates[i];
+    IOBufOutputStream column(*(arena.pool()), nullptr, arena.size());
+    streams[i].flush(&column);
+    const int32_t uncompressedSize = column.tellp();
+    auto iobuf = column.getIOBuf();
+    std::unique_ptr<folly::IOBuf> compressed;
+    if (state.numCompressionToSkip > 0) {
+      --state.numCompressionToSkip;
+      ++state.numCompressionSkipped;
+      ++stats.numCompressionSkipped;
+      stats.compressionSkippedBytes += uncompressedSize;
+    } else if (uncompressedSize > 0) {
+      VELOX_CHECK_LE(
+          uncompressedSize,
+          codec.maxUncompressedLength(),
+          "UncompressedSize exceeds limit");
+      compressed = codec.compress(iobuf.get());
+      const int32_t compressedSize = compressed->computeChainDataLength();
+      stats.compressionInputBytes += uncompressedSize;
+      stats.compressedBytes += compressedSize;
+      if (compressedSize > uncompressedSize * minCompressionRatio) {
+        compressed.reset();
+        state.numCompressionToSkip = std::min<int32_t>(
+            kMaxCompressionAttemptsToSkip, 1 + state.numCompressionSkipped);
+      }
+    }
+    const auto& data = compressed != nullptr ? compressed : iobuf;
+    const char isCompressed = compressed != nullptr;
+    out.write(&isCompressed, 1);
+    writeInt32(&out, uncompressedSize);
+    writeInt32(&out, data->computeChainDataLength());
+    for (auto range : *data) {
+      out.write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
+  }
+
+  const int32_t size = out.tellp();
+  flushSerialization(
+      numRows, size, size, codecMask, out.getIOBuf(), output, listener);
+}
+
 void serializeColumn(
     const VectorPtr& vector,
     const folly::Range<const IndexRange*>& ranges,
@@ -367,4 +470,16 @@ void serializeColumn(
     const folly::Range<const vector_size_t*>& rows,
     VectorStream* stream,
     Scratch& scratch);
+
+// Appends 'rows' of 'vector' to 'stream' keeping the encoding of a CONSTANT or
+// DICTIONARY stream from VectorStream::encodeStream(). A CONSTANT stream
+// becomes a DICTIONARY stream when 'vector' is not the same constant. A
+// DICTIONARY stream adds the values that 'rows' use of a dictionary without
+// nulls in the wrapper, and adds the rows of any other 'vector' as new values.
+// Same as serializeColumn() for other streams.
+void serializeEncodedColumn(
+    const VectorPtr& vector,
+    const folly::Range<const vector_size_t*>& rows,
+    VectorStream* stream,
+    Scratch& scratch);
 } // namespace facebook::velox::serializer::presto::detail
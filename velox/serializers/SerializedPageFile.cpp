@@ -93,15 +93,19 @@ SerializedPageFile* SerializedPageFileWriter::ensureFile() {
     closeFile();
   }
   if (currentFile_ == nullptr) {
-    currentFile_ = SerializedPageFile::create(
-        nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
-        fileCreateConfig_,
-        ioStats_);
+    currentFile_ = createFile();
   }
   return currentFile_.get();
 }
 
+std::unique_ptr<SerializedPageFile> SerializedPageFileWriter::createFile() {
+  return SerializedPageFile::create(
+      nextFileId_++,
+      fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+      fileCreateConfig_,
+      ioStats_);
+}
+
 void SerializedPageFileWriter::closeFile() {
   if (currentFile_ == nullptr) {
     return;
@@ -155,24 +159,32 @@ uint64_t SerializedPageFileWriter::write(
   checkNotFinished();
 
   uint64_t timeNs{0};
+  uint64_t bufferedBytes{0};
   {
     NanosecondTimer timer(&timeNs);
-    if (batch_ == nullptr) {
-      batch_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
-      batch_->createStreamTree(
-          std::static_pointer_cast<const RowType>(rows->type()),
-          1'000,
-          serdeOptions_.get());
-    }
-    batch_->append(rows, indices);
+    bufferedBytes = append(rows, indices);
   }
   updateAppendStats(rows->size(), timeNs);
-  if (batch_->size() < writeBufferSize_) {
+  if (bufferedBytes < writeBufferSize_) {
     return 0;
   }
   return flush();
 }
 
+uint64_t SerializedPageFileWriter::append(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  if (batch_ == nullptr) {
+    batch_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
+    batch_->createStreamTree(
+        std::static_pointer_cast<const RowType>(rows->type()),
+        1'000,
+        serdeOptions_.get());
+  }
+  batch_->append(rows, indices);
+  return batch_->size();
+}
+
 void SerializedPageFileWriter::finishFile() {
   checkNotFinished();
   flush();
@@ -195,16 +207,23 @@ SerializedPageFileReader::SerializedPageFileReader(
     VectorSerde* serde,
     std::unique_ptr<VectorSerde::Options> readOptions,
     memory::MemoryPool* pool,
-    IoStats* ioStats)
+    IoStats* ioStats,
+    folly::Executor* readAheadExecutor,
+    bool mapFile)
     : readOptions_(std::move(readOptions)),
       pool_(pool),
       serde_(serde),
       type_(type) {
   auto fs = filesystems::getFileSystem(path, nullptr);
+  if (mapFile) {
+    input_ = std::make_unique<common::MappedFileInputStream>(
+        std::string(fs->extractPath(path)), bufferSize);
+    return;
+  }
   auto file =
       fs->openFileForRead(path, filesystems::FileOptions{.stats = ioStats});
   input_ = std::make_unique<common::FileInputStream>(
-      std::move(file), bufferSize, pool_);
+      std::move(file), bufferSize, pool_, readAheadExecutor);
 }
 
 bool SerializedPageFileReader::nextBatch(RowVectorPtr& rowVector) {
@@ -216,10 +235,22 @@ bool SerializedPageFileReader::nextBatch(RowVectorPtr& rowVector) {
   uint64_t timeNs{0};
   {
     NanosecondTimer timer{&timeNs};
-    VectorStreamGroup::read(
-        input_.get(), pool_, type_, serde_, &rowVector, readOptions_.get());
+    readBatch(rowVector);
   }
   updateSerializationTimeStats(timeNs);
   return true;
 }
+
+void SerializedPageFileReader::readBatch(RowVectorPtr& rowVector) {
+  VectorStreamGroup::read(
+      input_.get(), pool_, type_, serde_, &rowVector, readOptions_.get());
+}
+
+common::FileInputStream::Stats SerializedPageFileReader::readStats() const {
+  if (auto* mapped =
+          dynamic_cast<const common::MappedFileInputStream*>(input_.get())) {
+    return mapped->stats();
+  }
+  return static_cast<const common::FileInputStream*>(input_.get())->stats();
+}
 } // namespace facebook::velox::serializer
@@ -21,6 +21,7 @@
 #include <memory>
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
+#include "velox/common/file/MappedFileInputStream.h"
 #include "velox/serializers/VectorStream.h"
 
 namespace facebook::velox::serializer {
@@ -160,6 +161,15 @@ class SerializedPageFileWriter {
   // Closes the current open file pointed by 'currentFile_'.
   virtual void closeFile();
 
+  // Creates a new file for write.
+  virtual std::unique_ptr<SerializedPageFile> createFile();
+
+  // Buffers 'rows' for the positions in 'indices' for write. Returns the
+  // buffered size.
+  virtual uint64_t append(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
   // Writes data from 'batch_' to the current output file. Returns the actual
   // written size.
   virtual uint64_t flush();
@@ -199,7 +209,11 @@ class SerializedPageFileReader {
   /// size. 'type' is the row type of the data. 'serde' is the VectorSerde
   /// instance to use. 'readOptions' specifies the deserialization options.
   /// 'pool' is used for buffering. 'ioStats' is used to collect
-  /// filesystem I/O stats such as wsServiceTime.
+  /// filesystem I/O stats such as wsServiceTime. If 'readAheadExecutor' is
+  /// set, the next buffer is read on it while the current buffer is consumed.
+  /// If 'mapFile' is true, 'path' must be in the local file system and the
+  /// pages are deserialized from the mapped file 'bufferSize' bytes at a time
+  /// instead of being read into buffers.
   SerializedPageFileReader(
       const std::string& path,
       uint64_t bufferSize,
@@ -207,7 +221,9 @@ class SerializedPageFileReader {
       VectorSerde* serde,
       std::unique_ptr<VectorSerde::Options> readOptions,
       memory::MemoryPool* pool,
-      IoStats* ioStats);
+      IoStats* ioStats,
+      folly::Executor* readAheadExecutor = nullptr,
+      bool mapFile = false);
 
   virtual ~SerializedPageFileReader() = default;
 
@@ -218,6 +234,12 @@ class SerializedPageFileReader {
 
   virtual void updateSerializationTimeStats(uint64_t /* timeNs */) {}
 
+  // Deserializes the next batch from 'input_' into 'rowVector'.
+  virtual void readBatch(RowVectorPtr& rowVector);
+
+  // Returns the read stats of 'input_'.
+  common::FileInputStream::Stats readStats() const;
+
   const std::unique_ptr<VectorSerde::Options> readOptions_;
 
   memory::MemoryPool* const pool_;
@@ -226,7 +248,8 @@ class SerializedPageFileReader {
 
   const RowTypePtr type_;
 
-  std::unique_ptr<common::FileInputStream> input_;
+  // Either a common::FileInputStream or a common::MappedFileInputStream.
+  std::unique_ptr<ByteInputStream> input_;
 };
 
 } // namespace facebook::velox::serializer
@@ -20,6 +20,45 @@
 
 namespace facebook::velox::serializer::spark {
 namespace {
+class UnsafeRowVectorSerializer : public RowSerializer<row::UnsafeRowFast> {
+ public:
+  UnsafeRowVectorSerializer(
+      memory::MemoryPool* pool,
+      const VectorSerde::Options* options)
+      : RowSerializer<row::UnsafeRowFast>(pool, options) {}
+
+ private:
+  void serializeRanges(
+      const row::UnsafeRowFast& row,
+      const folly::Range<const IndexRange*>& ranges,
+      char* rawBuffer,
+      const std::vector<vector_size_t>& rowSize) override {
+    size_t offset = 0;
+    vector_size_t index = 0;
+    for (const auto& range : ranges) {
+      if (range.size == 1) {
+        // Fast path for single-row serialization.
+        *reinterpret_cast<TRowSize*>(rawBuffer + offset) =
+            folly::Endian::big(rowSize[index]);
+        auto size =
+            row.serialize(range.begin, rawBuffer + offset + sizeof(TRowSize));
+        offset += size + sizeof(TRowSize);
+        ++index;
+      } else {
+        raw_vector<size_t> offsets(range.size, pool_);
+        for (auto i = 0; i < range.size; ++i, ++index) {
+          // Write raw size. Needs to be in big endian order.
+          *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(rowSize[index]);
+          offsets[i] = offset + sizeof(TRowSize);
+          offset += rowSize[index] + sizeof(TRowSize);
+        }
+        // Write row data for all rows in range, one column at a time.
+        row.serialize(range.begin, range.size, offsets.data(), rawBuffer);
+      }
+    }
+  }
+};
+
 std::unique_ptr<RowIterator> unsafeRowIteratorFactory(
     ByteInputStream* source,
     const VectorSerde::Options* options) {
@@ -66,7 +105,7 @@ UnsafeRowVectorSerde::createIterativeSerializer(
     int32_t /* numRows */,
     StreamArena* streamArena,
     const Options* options) {
-  return std::make_unique<RowSerializer<row::UnsafeRowFast>>(
+  return std::make_unique<UnsafeRowVectorSerializer>(
       streamArena->pool(), options);
 }
 
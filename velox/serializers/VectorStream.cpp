@@ -101,49 +101,64 @@ VectorStream::VectorStream(
   }
 
   if (encoding_.has_value()) {
-    switch (encoding_.value()) {
-      case VectorEncoding::Simple::CONSTANT: {
-        initializeHeader(kRLE, *streamArena);
-        isConstantStream_ = true;
-        children_.emplace_back(
-            type_,
-            std::nullopt,
-            std::nullopt,
-            streamArena,
-            initialNumRows,
-            opts);
-        return;
-      }
-      case VectorEncoding::Simple::DICTIONARY: {
-        // For fix width types that are smaller than int32_t (the type for
-        // indexes into the dictionary) dictionary encoding increases the
-        // size, so we should flatten it.
-        if (!preserveEncodings() && type->isFixedWidth() &&
-            type->cppSizeInBytes() <= sizeof(int32_t)) {
-          encoding_ = std::nullopt;
-          break;
-        }
-
-        initializeHeader(kDictionary, *streamArena);
-        values_.startWrite(initialNumRows * 4);
-        isDictionaryStream_ = true;
-        children_.emplace_back(
-            type_,
-            std::nullopt,
-            std::nullopt,
-            streamArena,
-            initialNumRows,
-            opts);
-        return;
-      }
-      default:
-        break;
+    const auto encoding = encoding_.value();
+    encoding_ = std::nullopt;
+    if (encodeStream(encoding, initialNumRows)) {
+      return;
     }
   }
 
   initializeFlatStream(vector, initialNumRows);
 }
 
+bool VectorStream::encodeStream(
+    VectorEncoding::Simple encoding,
+    int32_t initialNumRows) {
+  VELOX_CHECK_EQ(size(), 0);
+  VELOX_CHECK(!isConstantStream_ && !isDictionaryStream_);
+  switch (encoding) {
+    case VectorEncoding::Simple::CONSTANT:
+      initializeHeader(kRLE, *streamArena_);
+      isConstantStream_ = true;
+      break;
+    case VectorEncoding::Simple::DICTIONARY:
+      // For fix width types that are smaller than int32_t (the type for
+      // indexes into the dictionary) dictionary encoding increases the
+      // size, so we should flatten it.
+      if (!preserveEncodings() && type_->isFixedWidth() &&
+          type_->cppSizeInBytes() <= sizeof(int32_t)) {
+        return false;
+      }
+      initializeHeader(kDictionary, *streamArena_);
+      values_.startWrite(initialNumRows * 4);
+      isDictionaryStream_ = true;
+      break;
+    default:
+      return false;
+  }
+  encoding_ = encoding;
+  hasLengths_ = false;
+  totalLength_ = 0;
+  children_.clear();
+  children_.emplace_back(
+      type_, std::nullopt, std::nullopt, streamArena_, initialNumRows, opts_);
+  return true;
+}
+
+void VectorStream::constantToDictionary() {
+  VELOX_CHECK(isConstantStream_);
+  VELOX_CHECK_LE(children_[0].size(), 1);
+  encoding_ = VectorEncoding::Simple::DICTIONARY;
+  isConstantStream_ = false;
+  isDictionaryStream_ = true;
+  constantVector_.reset();
+  initializeHeader(kDictionary, *streamArena_);
+  values_.startWrite(nonNullCount_ * sizeof(int32_t));
+  for (auto i = 0; i < nonNullCount_; ++i) {
+    appendOne<int32_t>(0);
+  }
+}
+
 void VectorStream::appendNulls(
     const uint64_t* nulls,
     int32_t begin,
@@ -307,6 +322,20 @@ void VectorStream::flushNulls(OutputStream* out) {
 }
 
 void VectorStream::clear() {
+  if (isConstantStream_ || isDictionaryStream_) {
+    // Back to the flat stream of 'type_', like a stream made without encoding.
+    nonNullCount_ = 0;
+    nullCount_ = 0;
+    totalLength_ = 0;
+    encoding_ = std::nullopt;
+    isConstantStream_ = false;
+    isDictionaryStream_ = false;
+    constantVector_.reset();
+    children_.clear();
+    values_.startWrite(values_.size());
+    initializeFlatStream(std::nullopt, 0);
+    return;
+  }
   encoding_ = std::nullopt;
   initializeHeader(typeToEncodingName(type_), *streamArena_);
   nonNullCount_ = 0;
@@ -337,7 +366,18 @@ size_t VectorStream::serializedSize() {
 
 template <>
 void VectorStream::append(folly::Range<const Timestamp*> values) {
-  if (opts_.useLosslessTimestamp) {
+  if (opts_.useLosslessTimestamp && opts_.compactTimestamp) {
+    int64_t compact;
+    for (auto& value : values) {
+      if (detail::toCompactTimestamp(value, compact)) {
+        appendOne(compact);
+      } else {
+        appendOne(detail::kCompactTimestampEscape);
+        appendOne(value.getSeconds());
+        appendOne(value.getNanos());
+      }
+    }
+  } else if (opts_.useLosslessTimestamp) {
     for (auto& value : values) {
       appendOne(value.getSeconds());
       appendOne(value.getNanos());
@@ -42,6 +42,31 @@ class VectorStream {
 
   void flattenStream(const VectorPtr& vector, int32_t initialNumRows);
 
+  /// Changes an empty flat stream to CONSTANT or DICTIONARY 'encoding'. Keeps
+  /// the stream flat for other encodings and for dictionaries of fixed width
+  /// values no wider than the indices, unless preserveEncodings(). Returns true
+  /// if the stream is encoded.
+  bool encodeStream(VectorEncoding::Simple encoding, int32_t initialNumRows);
+
+  /// Changes a CONSTANT stream to a DICTIONARY stream over the same value
+  /// with index 0 for all rows, so that rows with other values can be added.
+  void constantToDictionary();
+
+  /// Returns the number of values in the stream, including nulls.
+  int32_t size() const {
+    return nullCount_ + nonNullCount_;
+  }
+
+  /// The vector whose value a CONSTANT stream from encodeStream() repeats.
+  /// nullptr until the first rows are added.
+  const VectorPtr& constantVector() const {
+    return constantVector_;
+  }
+
+  void setConstantVector(VectorPtr vector) {
+    constantVector_ = std::move(vector);
+  }
+
   std::optional<VectorEncoding::Simple> getEncoding(
       std::optional<VectorEncoding::Simple> encoding,
       std::optional<VectorPtr> vector) {
@@ -224,6 +249,7 @@ class VectorStream {
   std::vector<VectorStream, memory::StlAllocator<VectorStream>> children_;
   bool isDictionaryStream_{false};
   bool isConstantStream_{false};
+  VectorPtr constantVector_;
 };
 
 template <>
@@ -128,6 +128,8 @@ class PrestoSerializerTest
     serializer::presto::PrestoVectorSerde::PrestoOptions paramOptions{
         useLosslessTimestamp, kind, 0.8, nullsFirst, preserveEncodings};
     paramOptions.useMicrosecondPrecision = useMicrosecondPrecision;
+    paramOptions.compactTimestamp =
+        serdeOptions != nullptr && serdeOptions->compactTimestamp;
 
     return paramOptions;
   }
@@ -1160,6 +1162,51 @@ TEST_P(PrestoSerializerTest, timestampWithNanosecondPrecision) {
   assertEqualVectors(deserialized, expectedOutputWithLostPrecision);
 }
 
+TEST_P(PrestoSerializerTest, compactTimestamp) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions losslessOptions(
+      true, common::CompressionKind::CompressionKind_NONE, 0.8, true);
+  auto compactOptions = losslessOptions;
+  compactOptions.compactTimestamp = true;
+
+  // Timestamps of microsecond precision take 8 bytes.
+  auto micros = makeNullableFlatVector<Timestamp>(
+      {Timestamp::fromMicros(1704067200123456),
+       std::nullopt,
+       Timestamp{-1, 17'123'000},
+       Timestamp{0, 0},
+       Timestamp{4'000'000'000'000, 999'999'000},
+       Timestamp{-4'000'000'000'000, 0}});
+  testRoundTrip(micros, &compactOptions);
+
+  // Nanosecond precision and very large seconds are kept.
+  auto nanos = makeFlatVector<Timestamp>(
+      {Timestamp{0, 17'123'456},
+       Timestamp{-1, 1},
+       Timestamp{4'000'000'000'001, 0},
+       Timestamp{Timestamp::kMinSeconds, 0},
+       Timestamp{Timestamp::kMaxSeconds, Timestamp::kMaxNanos},
+       Timestamp{1, 1'000}});
+  testRoundTrip(nanos, &compactOptions);
+
+  auto many = makeFlatVector<Timestamp>(1'000, [](auto row) {
+    return Timestamp::fromMillis(1704067200000 + row * 1'001);
+  });
+  testRoundTrip(many, &compactOptions);
+  std::ostringstream compactOut;
+  std::ostringstream losslessOut;
+  const auto compactSize =
+      serialize(makeRowVector({many}), &compactOut, &compactOptions).actualSize;
+  const auto losslessSize =
+      serialize(makeRowVector({many}), &losslessOut, &losslessOptions)
+          .actualSize;
+  EXPECT_LT(compactSize, losslessSize * 6 / 10);
+
+  compactOptions.nullsFirst = false;
+  VELOX_ASSERT_THROW(
+      testRoundTrip(many, &compactOptions),
+      "compactTimestamp requires useLosslessTimestamp and nullsFirst");
+}
+
 TEST_P(PrestoSerializerTest, timestampMicrosecondPrecision) {
   auto timestamps = makeFlatVector<Timestamp>({
       Timestamp::fromMicros(1704067200000000),
@@ -1653,6 +1700,131 @@ TEST_P(PrestoSerializerTest, encodedConcatenation2) {
   }
 }
 
+TEST_P(PrestoSerializerTest, encodeOnAppend) {
+  auto base = makeFlatVector<std::string>(
+      {"apple", "banana", "cherry", "a string that is not inlined"});
+  auto makeBatch = [&](int32_t offset, int64_t constant) {
+    return makeRowVector(
+        {wrapInDictionary(
+             makeIndices(100, [&](auto row) { return (row + offset) % 3; }),
+             100,
+             base),
+         makeConstant<int64_t>(constant, 100),
+         makeFlatVector<int32_t>(100, [](auto row) { return row; })});
+  };
+  auto first = makeBatch(0, 7);
+  auto second = makeBatch(1, 8);
+  std::vector<vector_size_t> rows;
+  for (auto i = 0; i < 100; i += 2) {
+    rows.push_back(i);
+  }
+
+  auto serializeBatches = [&](const std::vector<RowVectorPtr>& batches) {
+    auto options = getParamSerdeOptions(nullptr);
+    options.encodeOnAppend = true;
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    auto serializer = serde_->createIterativeSerializer(
+        asRowType(first->type()), rows.size(), arena.get(), &options);
+    Scratch scratch;
+    for (const auto& batch : batches) {
+      serializer->append(
+          batch, folly::Range(rows.data(), rows.size()), scratch);
+    }
+    std::ostringstream output;
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+    return deserialize(asRowType(first->type()), output.str(), &options);
+  };
+
+  // The rows of a single batch keep both encodings. The dictionary only has
+  // the base values that are referenced.
+  auto result = serializeBatches({first});
+  ASSERT_EQ(result->size(), 50);
+  ASSERT_EQ(result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(result->childAt(0)->valueVector()->size(), 3);
+  ASSERT_EQ(result->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+  ASSERT_EQ(result->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+  assertEqualVectors(
+      makeRowVector(
+          {makeFlatVector<std::string>(
+               50,
+               [&](auto row) { return base->valueAt((2 * row) % 3).str(); }),
+           makeConstant<int64_t>(7, 50),
+           makeFlatVector<int32_t>(50, [](auto row) { return 2 * row; })}),
+      result);
+
+  // A second batch with another constant turns the constant into a
+  // dictionary. The dictionary column gets the values of the second batch.
+  result = serializeBatches({first, second});
+  ASSERT_EQ(result->size(), 100);
+  ASSERT_EQ(result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(result->childAt(0)->valueVector()->size(), 6);
+  ASSERT_EQ(result->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  assertEqualVectors(
+      makeRowVector(
+          {makeFlatVector<std::string>(
+               100,
+               [&](auto row) {
+                 return base->valueAt((2 * (row % 50) + row / 50) % 3).str();
+               }),
+           makeFlatVector<int64_t>(
+               100, [](auto row) { return row < 50 ? 7 : 8; }),
+           makeFlatVector<int32_t>(
+               100, [](auto row) { return 2 * (row % 50); })}),
+      result);
+}
+
+TEST_P(PrestoSerializerTest, columnCompression) {
+  if (GetParam() == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  folly::Random::DefaultGenerator rng(1);
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; }),
+       makeFlatVector<std::string>(1'000, [&](auto /*row*/) {
+         std::string value(64, 0);
+         for (auto& c : value) {
+           c = folly::Random::rand32(rng);
+         }
+         return value;
+       })});
+  const auto rowType = asRowType(data->type());
+  auto options = getParamSerdeOptions(nullptr);
+  options.columnCompression = true;
+  auto arena = std::make_unique<StreamArena>(pool_.get());
+  auto serializer = serde_->createIterativeSerializer(
+      rowType, data->size(), arena.get(), &options);
+  const IndexRange range{0, data->size()};
+  Scratch scratch;
+
+  auto flushPage = [&]() {
+    serializer->append(data, folly::Range(&range, 1), scratch);
+    std::ostringstream output;
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+    serializer->clear();
+    return output.str();
+  };
+
+  // The integers compress and the random strings do not. The page is smaller
+  // than the uncompressed strings alone.
+  auto page = flushPage();
+  EXPECT_LT(page.size(), 1'000 * 64 + 1'000 * 8);
+  assertEqualVectors(data, deserialize(rowType, page, &options, true));
+  auto stats = serializer->runtimeStats();
+  EXPECT_EQ(stats.count("compressionSkippedBytes"), 0);
+  const auto compressedBytes = stats.at("compressedBytes").value;
+
+  // The strings are not compressed in the next page. The integers still are.
+  page = flushPage();
+  assertEqualVectors(data, deserialize(rowType, page, &options, true));
+  stats = serializer->runtimeStats();
+  EXPECT_GT(stats.at("compressionSkippedBytes").value, 1'000 * 64);
+  EXPECT_GT(stats.at("compressedBytes").value, compressedBytes);
+}
+
 TEST_P(PrestoSerializerTest, emptyArrayOfRowVector) {
   // The value of nullCount_ + nonNullCount_ of the inner RowVector is 0.
   auto arrayOfRow = makeArrayOfRowVector(ROW({UNKNOWN()}), {{}});
@@ -156,14 +156,14 @@ OperatorReplayerBase::replayNodeFactory(const core::PlanNode* node) const {
   };
 }
 
-void OperatorReplayerBase::printStats(
-    const std::shared_ptr<exec::Task>& task) const {
-  const auto taskStats = exec::toPlanStats(task->taskStats());
-  const auto& nodeStats = taskStats.at(replayPlanNodeId_);
+void OperatorReplayerBase::printStats(const std::shared_ptr<exec::Task>& task) {
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  auto& nodeStats = taskStats.at(replayPlanNodeId_);
   LOG(INFO) << "Stats of replaying execution:";
   LOG(INFO) << nodeStats.toString(
       /*includeInputStats=*/true,
       /*includeRuntimeStats=*/true);
   LOG(INFO) << "Memory usage: " << task->pool()->treeMemoryUsage(false);
+  lastRunStats_ = std::make_unique<exec::PlanNodeStats>(std::move(nodeStats));
 }
 } // namespace facebook::velox::tool::trace
@@ -19,6 +19,7 @@
 #include "velox/common/file/FileSystems.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/parse/PlanNodeIdGenerator.h"
 
 namespace facebook::velox::exec {
@@ -64,6 +65,12 @@ class OperatorReplayerBase {
       bool copyResults = true,
       bool cursorCopyResult = false);
 
+  /// Returns the stats of the replayed plan node in the last run(), or
+  /// nullptr if run() has not been called.
+  const exec::PlanNodeStats* lastRunStats() const {
+    return lastRunStats_.get();
+  }
+
  protected:
   virtual core::PlanNodePtr createPlanNode(
       const core::PlanNode* node,
@@ -95,10 +102,14 @@ class OperatorReplayerBase {
   core::PlanNodePtr planFragment_;
   core::PlanNodeId replayPlanNodeId_;
 
-  void printStats(const std::shared_ptr<exec::Task>& task) const;
+  /// Logs the stats of the replayed plan node of 'task' and keeps them as the
+  /// stats of the last run.
+  void printStats(const std::shared_ptr<exec::Task>& task);
 
  private:
   std::function<core::PlanNodePtr(std::string, core::PlanNodePtr)>
   replayNodeFactory(const core::PlanNode* node) const;
+
+  std::unique_ptr<exec::PlanNodeStats> lastRunStats_;
 };
 } // namespace facebook::velox::tool::trace
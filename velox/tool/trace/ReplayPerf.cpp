@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/tool/trace/ReplayPerf.h"
+
+#include <algorithm>
+#include <map>
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::tool::trace {
+namespace {
+
+folly::dynamic statsToJson(const exec::PlanNodeStats& stats) {
+  return folly::dynamic::object("cpuNanos", stats.cpuWallTiming.cpuNanos)(
+      "wallNanos", stats.cpuWallTiming.wallNanos)(
+      "blockedWallNanos", stats.blockedWallNanos)(
+      "inputRows", stats.inputRows)("inputBytes", stats.inputBytes)(
+      "rawInputRows", stats.rawInputRows)(
+      "rawInputBytes", stats.rawInputBytes)("outputRows", stats.outputRows)(
+      "outputBytes", stats.outputBytes)(
+      "peakMemoryBytes", stats.peakMemoryBytes)(
+      "numMemoryAllocations", stats.numMemoryAllocations)(
+      "spilledBytes", stats.spilledBytes)("spilledRows", stats.spilledRows)(
+      "spilledFiles", stats.spilledFiles);
+}
+
+// Adds the numeric values of 'json' to 'metrics' under 'prefix' followed by
+// their keys.
+void addMetrics(
+    const folly::dynamic& json,
+    const std::string& prefix,
+    std::map<std::string, double>& metrics) {
+  for (const auto& [key, value] : json.items()) {
+    if (value.isNumber()) {
+      metrics[prefix + key.asString()] = value.asDouble();
+    }
+  }
+}
+
+std::map<std::string, double> metricsOf(const folly::dynamic& results) {
+  std::map<std::string, double> metrics;
+  addMetrics(results, "", metrics);
+  if (const auto* node = results.get_ptr("node")) {
+    addMetrics(*node, "node.", metrics);
+  }
+  if (const auto* operators = results.get_ptr("operators")) {
+    for (const auto& [operatorType, stats] : operators->items()) {
+      addMetrics(stats, operatorType.asString() + ".", metrics);
+    }
+  }
+  return metrics;
+}
+
+} // namespace
+
+ReplayPerf::ReplayPerf(OperatorReplayerBase* replayer, Options options)
+    : replayer_(replayer), options_(options) {
+  VELOX_CHECK_NOT_NULL(replayer_);
+  VELOX_USER_CHECK_GT(options_.numRuns, 0);
+  VELOX_USER_CHECK_GE(options_.numWarmupRuns, 0);
+}
+
+folly::dynamic ReplayPerf::run() {
+  for (auto i = 0; i < options_.numWarmupRuns; ++i) {
+    replayer_->run(/*copyResults=*/false, /*cursorCopyResult=*/false);
+  }
+  std::vector<folly::dynamic> runs;
+  runs.reserve(options_.numRuns);
+  for (auto i = 0; i < options_.numRuns; ++i) {
+    uint64_t wallMicros{0};
+    {
+      MicrosecondTimer timer(&wallMicros);
+      replayer_->run(/*copyResults=*/false, /*cursorCopyResult=*/false);
+    }
+    VELOX_CHECK_NOT_NULL(replayer_->lastRunStats());
+    runs.push_back(toJson(*replayer_->lastRunStats(), wallMicros));
+  }
+  folly::dynamic runWallMs = folly::dynamic::array;
+  for (const auto& run : runs) {
+    runWallMs.push_back(run["wallMs"]);
+  }
+  std::sort(runs.begin(), runs.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs["wallMs"].asDouble() < rhs["wallMs"].asDouble();
+  });
+  auto median = std::move(runs[runs.size() / 2]);
+  median["runWallMs"] = std::move(runWallMs);
+  return median;
+}
+
+// static
+folly::dynamic ReplayPerf::toJson(
+    const exec::PlanNodeStats& stats,
+    uint64_t wallMicros) {
+  // A scan has no input, its rows and bytes are raw input.
+  const auto rows = stats.inputRows != 0 ? stats.inputRows : stats.rawInputRows;
+  const auto bytes =
+      stats.inputBytes != 0 ? stats.inputBytes : stats.rawInputBytes;
+  const double seconds = wallMicros / 1'000'000.0;
+  folly::dynamic operators = folly::dynamic::object;
+  for (const auto& [operatorType, operatorStats] : stats.operatorStats) {
+    operators[operatorType] = statsToJson(*operatorStats);
+  }
+  return folly::dynamic::object("wallMs", wallMicros / 1'000.0)(
+      "numDrivers", stats.numDrivers)(
+      "rowsPerSec", seconds > 0 ? rows / seconds : 0)(
+      "mbPerSec", seconds > 0 ? bytes / seconds / (1 << 20) : 0)(
+      "node", statsToJson(stats))("operators", std::move(operators));
+}
+
+// static
+folly::dynamic ReplayPerf::compare(
+    const folly::dynamic& results,
+    const folly::dynamic& baseline) {
+  const auto baselineMetrics = metricsOf(baseline);
+  folly::dynamic deltas = folly::dynamic::array;
+  for (const auto& [metric, value] : metricsOf(results)) {
+    auto it = baselineMetrics.find(metric);
+    if (it == baselineMetrics.end()) {
+      continue;
+    }
+    const auto baselineValue = it->second;
+    const double deltaPct = baselineValue != 0
+        ? (value - baselineValue) * 100 / baselineValue
+        : (value != 0 ? 100 : 0);
+    deltas.push_back(
+        folly::dynamic::object("metric", metric)("baseline", baselineValue)(
+            "current", value)("deltaPct", deltaPct));
+  }
+  return deltas;
+}
+
+// static
+std::string ReplayPerf::toString(const folly::dynamic& deltas) {
+  std::string out = fmt::format(
+      "{:<40} {:>18} {:>18} {:>9}\n", "metric", "baseline", "current", "delta");
+  for (const auto& delta : deltas) {
+    out += fmt::format(
+        "{:<40} {:>18.2f} {:>18.2f} {:>+8.1f}%\n",
+        delta["metric"].asString(),
+        delta["baseline"].asDouble(),
+        delta["current"].asDouble(),
+        delta["deltaPct"].asDouble());
+  }
+  return out;
+}
+
+} // namespace facebook::velox::tool::trace
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/dynamic.h>
+
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/tool/trace/OperatorReplayerBase.h"
+
+namespace facebook::velox::tool::trace {
+
+/// Measures the performance of replaying a traced operator. The traced inputs
+/// are replayed 'numWarmupRuns' times without measuring, then 'numRuns' times
+/// with the wall time and the stats of the replayed plan node and of each of
+/// its operators recorded. The memory cap and the number of drivers are those
+/// of the replayer: each run gets a new query pool of the query capacity and
+/// a driver per replayed traced driver.
+///
+/// The results of a build can be written as JSON and compared against the
+/// results of another build replaying the same trace.
+class ReplayPerf {
+ public:
+  struct Options {
+    int32_t numRuns{5};
+    int32_t numWarmupRuns{1};
+  };
+
+  ReplayPerf(OperatorReplayerBase* replayer, Options options);
+
+  /// Replays the trace and returns the measured run with the median wall
+  /// time, with the wall times of all measured runs under "runWallMs".
+  folly::dynamic run();
+
+  /// Returns the wall time, throughput and stats of a run that took
+  /// 'wallMicros' and replayed a node with 'stats'.
+  static folly::dynamic toJson(
+      const exec::PlanNodeStats& stats,
+      uint64_t wallMicros);
+
+  /// Returns the changes of the metrics of 'results' from 'baseline', both
+  /// as returned by run(). Each change has the "metric", its "baseline" and
+  /// "current" values and the "deltaPct". A metric of an operator is prefixed
+  /// by the operator type, e.g. "FilterProject.cpuNanos". Metrics missing
+  /// from either side are skipped.
+  static folly::dynamic compare(
+      const folly::dynamic& results,
+      const folly::dynamic& baseline);
+
+  /// Formats the changes returned by compare() as a table.
+  static std::string toString(const folly::dynamic& deltas);
+
+ private:
+  OperatorReplayerBase* const replayer_;
+  const Options options_;
+};
+
+} // namespace facebook::velox::tool::trace
@@ -17,6 +17,10 @@
 #include "velox/tool/trace/TraceReplayRunner.h"
 #include <folly/system/HardwareConcurrency.h>
 
+#include <iostream>
+
+#include <folly/FileUtil.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 
 #include "velox/common/file/FileSystems.h"
@@ -50,6 +54,7 @@
 #include "velox/tool/trace/OperatorReplayerBase.h"
 #include "velox/tool/trace/OrderByReplayer.h"
 #include "velox/tool/trace/PartitionedOutputReplayer.h"
+#include "velox/tool/trace/ReplayPerf.h"
 #include "velox/tool/trace/TableScanReplayer.h"
 #include "velox/tool/trace/TableWriterReplayer.h"
 #include "velox/tool/trace/TopNRowNumberReplayer.h"
@@ -121,6 +126,27 @@ DEFINE_string(
     spill_directory,
     "",
     "Base directory for spilling. If not specified, a local temporary directory will be used.");
+DEFINE_int32(
+    perf_runs,
+    0,
+    "If positive, replays the traced operator this many times after "
+    "--perf_warmup_runs and reports the run with the median wall time. The "
+    "memory cap is --query_memory_capacity_mb and the number of drivers is "
+    "the number of --driver_ids.");
+DEFINE_int32(
+    perf_warmup_runs,
+    1,
+    "Number of unmeasured replays before the --perf_runs.");
+DEFINE_string(
+    perf_output_json,
+    "",
+    "If not empty, the --perf_runs results are written to this file.");
+DEFINE_string(
+    perf_baseline_json,
+    "",
+    "Results written by --perf_output_json of an earlier build. If not empty, "
+    "the changes of the throughput and operator stats from these are "
+    "printed.");
 
 namespace facebook::velox::tool::trace {
 namespace {
@@ -494,6 +520,44 @@ void TraceReplayRunner::run() {
     return;
   }
   VELOX_USER_CHECK(!FLAGS_task_id.empty(), "--task_id must be provided");
+  if (FLAGS_perf_runs > 0) {
+    runPerf();
+    return;
+  }
   createReplayer()->run(FLAGS_copy_results, FLAGS_cursor_copy_result);
 }
+
+void TraceReplayRunner::runPerf() {
+  const auto replayer = createReplayer();
+  auto results =
+      ReplayPerf(replayer.get(), {FLAGS_perf_runs, FLAGS_perf_warmup_runs})
+          .run();
+  results["nodeName"] = taskTraceMetadataReader_->nodeName(FLAGS_node_id);
+  std::cout << fmt::format(
+                   "Replayed {} in {:.2f}ms median of {} runs: {:.0f} rows/s, "
+                   "{:.2f} MB/s",
+                   results["nodeName"].asString(),
+                   results["wallMs"].asDouble(),
+                   FLAGS_perf_runs,
+                   results["rowsPerSec"].asDouble(),
+                   results["mbPerSec"].asDouble())
+            << std::endl;
+  if (!FLAGS_perf_baseline_json.empty()) {
+    std::string baselineJson;
+    VELOX_USER_CHECK(
+        folly::readFile(FLAGS_perf_baseline_json.c_str(), baselineJson),
+        "Cannot read baseline {}",
+        FLAGS_perf_baseline_json);
+    const auto deltas =
+        ReplayPerf::compare(results, folly::parseJson(baselineJson));
+    std::cout << ReplayPerf::toString(deltas);
+  }
+  if (!FLAGS_perf_output_json.empty()) {
+    VELOX_CHECK(
+        folly::writeFile(
+            folly::toPrettyJson(results), FLAGS_perf_output_json.c_str()),
+        "Cannot write {}",
+        FLAGS_perf_output_json);
+  }
+}
 } // namespace facebook::velox::tool::trace
@@ -39,6 +39,10 @@ DECLARE_double(driver_cpu_executor_hw_multiplier);
 DECLARE_string(memory_arbitrator_type);
 DECLARE_bool(copy_results);
 DECLARE_string(function_prefix);
+DECLARE_int32(perf_runs);
+DECLARE_int32(perf_warmup_runs);
+DECLARE_string(perf_output_json);
+DECLARE_string(perf_baseline_json);
 
 namespace facebook::velox::tool::trace {
 
@@ -56,6 +60,10 @@ class TraceReplayRunner {
   /// Runs the trace replay with a set of gflags passed from replayer tool.
   virtual void run();
 
+  /// Replays the trace --perf_runs times and prints the throughput and the
+  /// changes from --perf_baseline_json.
+  void runPerf();
+
  protected:
   virtual std::unique_ptr<tool::trace::OperatorReplayerBase> createReplayer()
       const;
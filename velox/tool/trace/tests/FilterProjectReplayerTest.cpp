@@ -32,6 +32,7 @@
 #include "velox/exec/trace/TraceUtil.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/tool/trace/FilterProjectReplayer.h"
+#include "velox/tool/trace/ReplayPerf.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::core;
@@ -338,5 +339,62 @@ TEST_F(FilterProjectReplayerTest, dryRun) {
                              .run();
   assertEqualResults({result}, {replayingResult});
 }
+
+TEST_F(FilterProjectReplayerTest, perf) {
+  const auto traceRoot = fmt::format("{}/{}", testDir_->getPath(), "perf");
+  const auto tracePlanWithSplits = createPlan(PlanMode::FilterProject);
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder traceBuilder(tracePlanWithSplits.plan);
+  traceBuilder.maxDrivers(4)
+      .config(core::QueryConfig::kQueryTraceEnabled, true)
+      .config(core::QueryConfig::kQueryTraceDir, traceRoot)
+      .config(core::QueryConfig::kQueryTraceMaxBytes, 100UL << 30)
+      .config(core::QueryConfig::kQueryTraceTaskRegExp, ".*")
+      .config(core::QueryConfig::kQueryTraceNodeId, projectNodeId_);
+  traceBuilder.splits(tracePlanWithSplits.splits).copyResults(pool(), task);
+
+  FilterProjectReplayer replayer(
+      traceRoot,
+      task->queryCtx()->queryId(),
+      task->taskId(),
+      projectNodeId_,
+      "FilterProject",
+      "0,2",
+      0,
+      executor_.get());
+  ASSERT_EQ(replayer.lastRunStats(), nullptr);
+  const auto results =
+      ReplayPerf(&replayer, {.numRuns = 3, .numWarmupRuns = 1}).run();
+  ASSERT_NE(replayer.lastRunStats(), nullptr);
+  ASSERT_EQ(results["runWallMs"].size(), 3);
+  ASSERT_EQ(results["numDrivers"].asInt(), 2);
+  ASSERT_GT(results["wallMs"].asDouble(), 0);
+  ASSERT_GT(results["rowsPerSec"].asDouble(), 0);
+  ASSERT_GT(results["node"]["inputRows"].asInt(), 0);
+  ASSERT_EQ(
+      results["node"]["outputRows"].asInt(),
+      results["operators"]["FilterProject"]["outputRows"].asInt());
+
+  const auto deltas = ReplayPerf::compare(results, results);
+  ASSERT_FALSE(deltas.empty());
+  for (const auto& delta : deltas) {
+    ASSERT_EQ(delta["deltaPct"].asDouble(), 0) << delta["metric"].asString();
+  }
+
+  auto slower = results;
+  slower["operators"]["FilterProject"]["cpuNanos"] =
+      results["operators"]["FilterProject"]["cpuNanos"].asInt() * 2 + 1;
+  bool found = false;
+  for (const auto& delta : ReplayPerf::compare(slower, results)) {
+    if (delta["metric"].asString() == "FilterProject.cpuNanos") {
+      ASSERT_GT(delta["deltaPct"].asDouble(), 0);
+      found = true;
+    }
+  }
+  ASSERT_TRUE(found);
+  ASSERT_NE(
+      ReplayPerf::toString(deltas).find("FilterProject.cpuNanos"),
+      std::string::npos);
+}
 } // namespace
 } // namespace facebook::velox::tool::trace::test
@@ -20,6 +20,8 @@
 #include <folly/Conv.h>
 #include <folly/Expected.h>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -151,6 +153,75 @@ Expected<T> callFollyTo(const F& v) {
   return result.value();
 }
 
+/// Returns true if the 8 bytes in 'chunk' are all ASCII digits and sets
+/// 'value' to the number they represent. The bytes are combined pairwise in
+/// registers instead of being parsed one at a time.
+inline bool tryParseEightDigits(uint64_t chunk, uint64_t& value) {
+  constexpr uint64_t kZeros = 0x3030303030303030ULL;
+  constexpr uint64_t kHighNibbles = 0xF0F0F0F0F0F0F0F0ULL;
+  // A byte is a digit if its high nibble is 3 and adding 6 to it doesn't
+  // carry into the high nibble, i.e. it is in ['0', '9'].
+  if ((chunk & kHighNibbles) != kZeros ||
+      ((chunk + 0x0606060606060606ULL) & kHighNibbles) != kZeros) {
+    return false;
+  }
+  chunk -= kZeros;
+  // The first character is in the lowest byte on little endian.
+  chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+  chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+  value = (chunk * 10000 + (chunk >> 32)) & 0xFFFFFFFFULL;
+  return true;
+}
+
+/// Fast path of string to integer cast. Returns true and sets 'result' if
+/// 'v' is an optional sign followed by up to 18 digits, and the value fits in
+/// T. Such a value can't overflow int64 and folly::tryTo gives the same
+/// result, so callers fall back to it only for the remaining inputs and all
+/// the error cases.
+template <typename T>
+bool tryFastStringToInt(std::string_view v, T& result) {
+  constexpr size_t kMaxDigits = 18;
+  const char* data = v.data();
+  size_t size = v.size();
+  const bool negative = size > 0 && data[0] == '-';
+  if (size > 0 && (data[0] == '-' || data[0] == '+')) {
+    ++data;
+    --size;
+  }
+  if (size == 0 || size > kMaxDigits) {
+    return false;
+  }
+
+  uint64_t value = 0;
+  for (; size >= 8; data += 8, size -= 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data, 8);
+    uint64_t digits;
+    if (!tryParseEightDigits(chunk, digits)) {
+      return false;
+    }
+    value = value * 100'000'000 + digits;
+  }
+  for (; size > 0; ++data, --size) {
+    const uint8_t digit = *data - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+
+  const int64_t signedValue =
+      negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+  if constexpr (sizeof(T) < sizeof(int64_t)) {
+    if (signedValue < std::numeric_limits<T>::min() ||
+        signedValue > std::numeric_limits<T>::max()) {
+      return false;
+    }
+  }
+  result = signedValue;
+  return true;
+}
+
 } // namespace detail
 
 /// To BOOLEAN converter.
@@ -340,6 +411,10 @@ struct Converter<
       return convertStringToInt(v);
     } else {
       auto trimmed = trimWhiteSpace(v.data(), v.size());
+      T result;
+      if (detail::tryFastStringToInt(trimmed, result)) {
+        return result;
+      }
       return detail::callFollyTo<T>(trimmed);
     }
   }
@@ -349,6 +424,10 @@ struct Converter<
       return convertStringToInt(std::string_view(v));
     } else {
       auto trimmed = trimWhiteSpace(v.data(), v.size());
+      T result;
+      if (detail::tryFastStringToInt(trimmed, result)) {
+        return result;
+      }
       return detail::callFollyTo<T>(trimmed);
     }
   }
@@ -358,6 +437,10 @@ struct Converter<
       return convertStringToInt(v);
     } else {
       auto trimmed = trimWhiteSpace(v.data(), v.length());
+      T result;
+      if (detail::tryFastStringToInt(trimmed, result)) {
+        return result;
+      }
       return detail::callFollyTo<T>(trimmed);
     }
   }
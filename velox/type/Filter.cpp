@@ -53,6 +53,10 @@ const auto& filterKindNames() {
       {FilterKind::kHugeintValuesUsingHashTable, "HugeintValuesUsingHashTable"},
       {FilterKind::kBigintValuesUsingBloomFilter,
        "BigintValuesUsingBloomFilter"},
+      {FilterKind::kBytesValuesUsingBloomFilter,
+       "BytesValuesUsingBloomFilter"},
+      {FilterKind::kBigintValuesUsingSortedArray,
+       "BigintValuesUsingSortedArray"},
   };
   return kNames;
 }
@@ -113,8 +117,12 @@ void Filter::registerSerDe() {
       "BigintValuesUsingHashTable", BigintValuesUsingHashTable::create);
   registry.Register(
       "BigintValuesUsingBitmask", BigintValuesUsingBitmask::create);
+  registry.Register(
+      "BigintValuesUsingSortedArray", BigintValuesUsingSortedArray::create);
   registry.Register(
       "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
+  registry.Register(
+      "BytesValuesUsingBloomFilter", BytesValuesUsingBloomFilter::create);
   registry.Register(
       "NegatedBigintValuesUsingHashTable",
       NegatedBigintValuesUsingHashTable::create);
@@ -333,6 +341,31 @@ bool BigintValuesUsingHashTable::testingEquals(const Filter& other) const {
   return false;
 }
 
+folly::dynamic BigintValuesUsingSortedArray::serialize() const {
+  auto obj = Filter::serializeBase();
+  folly::dynamic values = folly::dynamic::array;
+  for (auto v : *values_) {
+    values.push_back(v);
+  }
+  obj["values"] = values;
+  return obj;
+}
+
+std::unique_ptr<Filter> BigintValuesUsingSortedArray::create(
+    const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto values = deserializeValues(obj);
+  return std::make_unique<BigintValuesUsingSortedArray>(values, nullAllowed);
+}
+
+bool BigintValuesUsingSortedArray::testingEquals(const Filter& other) const {
+  if (const auto* otherValues =
+          Filter::testingBaseEquals<BigintValuesUsingSortedArray>(other)) {
+    return *values_ == *otherValues->values_;
+  }
+  return false;
+}
+
 folly::dynamic BigintValuesUsingBitmask::serialize() const {
   auto obj = Filter::serializeBase();
   obj["min"] = min_;
@@ -383,51 +416,84 @@ bool BigintValuesUsingBitmask::testingEquals(const Filter& other) const {
   return false;
 }
 
-folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
-  auto obj = Filter::serializeBase();
+void RuntimeBloomFilter::serializeBlocks(folly::dynamic& obj) const {
   folly::dynamic words = folly::dynamic::array;
-  for (auto& block : blocks_) {
+  for (auto& block : *blocks_) {
     for (auto word : block.data) {
       words.push_back(word);
     }
   }
   obj["numHashes"] = xsimd::batch<uint32_t>::size;
   obj["blockWords"] = words;
-  return obj;
+  obj["minTested"] = selectivity_.minTested();
+  obj["maxPassPct"] = selectivity_.maxPassPct();
 }
 
-std::unique_ptr<Filter> BigintValuesUsingBloomFilter::create(
-    const folly::dynamic& obj) {
+// static
+std::shared_ptr<std::vector<SplitBlockBloomFilter::Block>>
+RuntimeBloomFilter::deserializeBlocks(const folly::dynamic& obj) {
   VELOX_USER_CHECK_EQ(
       obj["numHashes"].asInt(),
       xsimd::batch<uint32_t>::size,
-      "Cannot deserialize BigintValuesUsingBloomFilter serialized on hardware with different SIMD length");
-  auto nullAllowed = deserializeNullAllowed(obj);
-  std::vector<SplitBlockBloomFilter::Block> blocks;
+      "Cannot deserialize {} serialized on hardware with different SIMD length",
+      obj["name"].asString());
+  auto blocks = std::make_shared<std::vector<SplitBlockBloomFilter::Block>>();
   int i = 0;
   SplitBlockBloomFilter::Block current{};
   for (auto& word : obj["blockWords"]) {
     current.data[i++] = word.asInt();
     if (i == xsimd::batch<uint32_t>::size) {
-      blocks.push_back(current);
+      blocks->push_back(current);
       i = 0;
     }
   }
-  return std::unique_ptr<BigintValuesUsingBloomFilter>(
-      new BigintValuesUsingBloomFilter(nullAllowed, std::move(blocks)));
+  return blocks;
 }
 
-bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
-  auto* typedOther =
-      Filter::testingBaseEquals<BigintValuesUsingBloomFilter>(other);
+// static
+BloomFilterSelectivity RuntimeBloomFilter::deserializeSelectivity(
+    const folly::dynamic& obj) {
+  return BloomFilterSelectivity(
+      obj.getDefault("minTested", 0).asInt(),
+      obj.getDefault("maxPassPct", 100).asInt());
+}
+
+bool RuntimeBloomFilter::testingEquals(const Filter& other) const {
+  auto* typedOther = Filter::testingBaseEquals<RuntimeBloomFilter>(other);
   if (!typedOther) {
     return false;
   }
-  return blocks_.size() == typedOther->blocks_.size() &&
+  return blocks_->size() == typedOther->blocks_->size() &&
       memcmp(
-          blocks_.data(),
-          typedOther->blocks_.data(),
-          blocks_.size() * sizeof(SplitBlockBloomFilter::Block)) == 0;
+          blocks_->data(), typedOther->blocks_->data(), blocksByteSize()) == 0;
+}
+
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase();
+  serializeBlocks(obj);
+  return obj;
+}
+
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::create(
+    const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  return std::unique_ptr<BigintValuesUsingBloomFilter>(
+      new BigintValuesUsingBloomFilter(
+          nullAllowed, deserializeBlocks(obj), deserializeSelectivity(obj)));
+}
+
+folly::dynamic BytesValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase();
+  serializeBlocks(obj);
+  return obj;
+}
+
+std::unique_ptr<Filter> BytesValuesUsingBloomFilter::create(
+    const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  return std::unique_ptr<BytesValuesUsingBloomFilter>(
+      new BytesValuesUsingBloomFilter(
+          nullAllowed, deserializeBlocks(obj), deserializeSelectivity(obj)));
 }
 
 folly::dynamic NegatedBigintValuesUsingHashTable::serialize() const {
@@ -876,6 +942,74 @@ bool BigintValuesUsingHashTable::testInt64Range(
   return max >= *it;
 }
 
+namespace {
+// Fills 'tree' with 'sorted' in Eytzinger order by an in-order walk of the
+// subtree rooted at 'node'. Returns the index of the next value of 'sorted' to
+// place.
+size_t fillEytzinger(
+    const std::vector<int64_t>& sorted,
+    size_t next,
+    size_t node,
+    std::vector<int64_t>& tree) {
+  if (node < tree.size()) {
+    next = fillEytzinger(sorted, next, 2 * node, tree);
+    tree[node] = sorted[next++];
+    next = fillEytzinger(sorted, next, 2 * node + 1, tree);
+  }
+  return next;
+}
+} // namespace
+
+BigintValuesUsingSortedArray::BigintValuesUsingSortedArray(
+    const std::vector<int64_t>& values,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingSortedArray) {
+  VELOX_CHECK_GT(
+      values.size(),
+      1,
+      "values must contain at least 2 entries, current size is {}",
+      values.size());
+  auto sorted = std::make_shared<std::vector<int64_t>>(values);
+  std::sort(sorted->begin(), sorted->end());
+  sorted->erase(std::unique(sorted->begin(), sorted->end()), sorted->end());
+  min_ = sorted->front();
+  max_ = sorted->back();
+
+  depth_ = 1;
+  while ((1UL << depth_) - 1 < sorted->size()) {
+    ++depth_;
+  }
+  // Padding with 'max_' keeps the tree complete without changing which values
+  // pass.
+  std::vector<int64_t> padded(*sorted);
+  padded.resize((1UL << depth_) - 1, max_);
+  auto tree = std::make_shared<std::vector<int64_t>>(1UL << depth_, max_);
+  fillEytzinger(padded, 0, 1, *tree);
+
+  values_ = std::move(sorted);
+  tree_ = std::move(tree);
+}
+
+bool BigintValuesUsingSortedArray::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  if (min > max_ || max < min_) {
+    return false;
+  }
+  auto it = std::lower_bound(values_->begin(), values_->end(), min);
+  VELOX_DCHECK(it != values_->end());
+  return max >= *it;
+}
+
 folly::dynamic HugeintValuesUsingHashTable::serialize() const {
   auto obj = Filter::serializeBase();
   obj["min_lower"] = HugeInt::lower(min_);
@@ -1100,6 +1234,12 @@ std::unique_ptr<Filter> createBigintValuesFilter(
     return std::make_unique<NegatedBigintValuesUsingHashTable>(
         min, max, values, nullAllowed);
   }
+  // A hash table for this many values no longer fits in cache and every
+  // probe is a miss. The sorted array is a fraction of the size and keeps its
+  // upper levels hot.
+  if (values.size() >= BigintValuesUsingSortedArray::kMinValues) {
+    return std::make_unique<BigintValuesUsingSortedArray>(values, nullAllowed);
+  }
   return std::make_unique<BigintValuesUsingHashTable>(
       min, max, values, nullAllowed);
 }
@@ -1486,6 +1626,7 @@ std::unique_ptr<Filter> MultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
     case FilterKind::kNegatedBytesRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(/*nullAllowed=*/false);
@@ -1817,6 +1958,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBloomFilter:
+    case FilterKind::kBigintValuesUsingSortedArray:
       return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
@@ -1952,6 +2094,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintValuesUsingBloomFilter:
+    case FilterKind::kBigintValuesUsingSortedArray:
       return other->mergeWith(this);
     case FilterKind::kNegatedBigintValuesUsingHashTable:
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
@@ -2008,6 +2151,7 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     }
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintValuesUsingBloomFilter:
+    case FilterKind::kBigintValuesUsingSortedArray:
       return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
@@ -2075,6 +2219,38 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingSortedArray::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return std::make_unique<BigintValuesUsingSortedArray>(*this, false);
+    case FilterKind::kBigintRange:
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingSortedArray:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kBigintMultiRange: {
+      std::vector<int64_t> valuesToKeep;
+      for (auto v : *values_) {
+        if (other->testInt64(v)) {
+          valuesToKeep.push_back(v);
+        }
+      }
+      return createBigintValues(
+          valuesToKeep, nullAllowed_ && other->testNull());
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     const Filter* other) const {
   switch (other->kind()) {
@@ -2082,6 +2258,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
     case FilterKind::kBigintValuesUsingBloomFilter:
+    case FilterKind::kBigintValuesUsingSortedArray:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingBitmask>(*this, false);
@@ -2173,6 +2350,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kBigintRange:
     case FilterKind::kBigintMultiRange:
     case FilterKind::kBigintValuesUsingBloomFilter:
+    case FilterKind::kBigintValuesUsingSortedArray:
       return other->mergeWith(this);
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       auto otherNegated =
@@ -2213,6 +2391,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintMultiRange:
     case FilterKind::kBigintValuesUsingBloomFilter:
+    case FilterKind::kBigintValuesUsingSortedArray:
       return other->mergeWith(this);
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       auto otherHashTable =
@@ -2253,6 +2432,7 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBloomFilter:
+    case FilterKind::kBigintValuesUsingSortedArray:
       return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       std::vector<std::unique_ptr<BigintRange>> newRanges;
@@ -2334,9 +2514,11 @@ std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
       }
       return createBigintValues(values, nullAllowed_ && other->testNull());
     }
-    case FilterKind::kBigintValuesUsingHashTable: {
-      auto* filter = other->as<BigintValuesUsingHashTable>();
-      auto values = filter->values();
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingSortedArray: {
+      auto values = other->kind() == FilterKind::kBigintValuesUsingHashTable
+          ? other->as<BigintValuesUsingHashTable>()->values()
+          : other->as<BigintValuesUsingSortedArray>()->values();
       int64_t size = 0;
       for (int64_t i = 0; i < values.size(); ++i) {
         if (testInt64(values[i])) {
@@ -2391,6 +2573,7 @@ std::unique_ptr<Filter> BytesRange::mergeWith(const Filter* other) const {
     case FilterKind::kNegatedBytesValues:
     case FilterKind::kNegatedBytesRange:
     case FilterKind::kMultiRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kBytesRange: {
       bool bothNullAllowed = nullAllowed_ && other->testNull();
@@ -2467,6 +2650,7 @@ std::unique_ptr<Filter> NegatedBytesRange::mergeWith(
     case FilterKind::kIsNotNull:
       return this->clone(false);
     case FilterKind::kBytesValues:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kNegatedBytesValues:
     case FilterKind::kBytesRange:
@@ -2486,6 +2670,7 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
     case FilterKind::kMultiRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2600,6 +2785,7 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
     case FilterKind::kBytesValues:
     case FilterKind::kNegatedBytesRange:
     case FilterKind::kMultiRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2695,4 +2881,42 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
   }
 }
 
+std::unique_ptr<Filter> BytesValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return clone(false);
+    case FilterKind::kBytesValues: {
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      std::vector<std::string> newValues;
+      for (const auto& value : other->as<BytesValues>()->values()) {
+        // Tests the bits directly so that merging does not count towards
+        // the selectivity of 'this'.
+        if (filter_.mayContain(hash(value))) {
+          newValues.emplace_back(value);
+        }
+      }
+      if (newValues.empty()) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BytesValues>(
+          std::move(newValues), bothNullAllowed);
+    }
+    case FilterKind::kBytesRange:
+    case FilterKind::kNegatedBytesRange:
+    case FilterKind::kNegatedBytesValues:
+    case FilterKind::kMultiRange:
+    case FilterKind::kBytesValuesUsingBloomFilter:
+      // Bloom filter allows false positive so dropping it will not affect
+      // correctness.
+      return other->clone();
+    default:
+      VELOX_FAIL("Cannot merge {} with {}", kindName(), other->kindName());
+  }
+}
+
 } // namespace facebook::velox::common
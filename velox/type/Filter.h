@@ -53,6 +53,8 @@ enum class FilterKind {
   kTimestampRange,
   kHugeintValuesUsingHashTable,
   kBigintValuesUsingBloomFilter,
+  kBytesValuesUsingBloomFilter,
+  kBigintValuesUsingSortedArray,
 };
 
 VELOX_DECLARE_ENUM_NAME(FilterKind);
@@ -273,6 +275,13 @@ class Filter : public velox::ISerializable {
     VELOX_UNSUPPORTED("{}: testTimestampRange() is not supported.", toString());
   }
 
+  /// True if the filter keeps state about the values it has tested. Such a
+  /// filter is not thread safe and each reader must use its own copy from
+  /// clone().
+  virtual bool isStateful() const {
+    return false;
+  }
+
   /// Combines this filter with another filter using 'AND' logic.
   virtual std::unique_ptr<Filter> mergeWith(const Filter* /*other*/) const {
     VELOX_UNSUPPORTED("{}: mergeWith() is not supported.", toString());
@@ -1290,19 +1299,271 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
-class BigintValuesUsingBloomFilter final : public Filter {
+/// IN-list filter for integral data types with a very large number of values,
+/// e.g. the ones produced by turning a semi join into an IN list. The values
+/// are stored once, sorted, in Eytzinger (breadth first binary tree) order so
+/// that the first levels of every search share the same cache lines. A lookup
+/// is a fixed number of branch free steps, which testValues() runs for all
+/// lanes of a batch at once using gathers. Takes a fraction of the memory of
+/// BigintValuesUsingHashTable, which is sized at 5x the number of values.
+class BigintValuesUsingSortedArray final : public Filter {
+ public:
+  /// Minimum number of values for which createBigintValues() prefers this
+  /// filter over BigintValuesUsingHashTable.
+  static constexpr int32_t kMinValues = 64 << 10;
+
+  /// @param values A list of unique values that pass the filter. Must contain
+  /// at least two entries.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingSortedArray(
+      const std::vector<int64_t>& values,
+      bool nullAllowed);
+
+  BigintValuesUsingSortedArray(
+      const BigintValuesUsingSortedArray& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, other.kind()),
+        min_(other.min_),
+        max_(other.max_),
+        values_(other.values_),
+        tree_(other.tree_),
+        depth_(other.depth_) {}
+
+  folly::dynamic serialize() const override;
+
+  static std::unique_ptr<Filter> create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingSortedArray>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingSortedArray>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    if (value < min_ || value > max_) {
+      return false;
+    }
+    // The path from the root to the lower bound of 'value' passes through
+    // 'value' if it is in the tree.
+    const int64_t* tree = tree_->data();
+    uint64_t index = 1;
+    bool found = false;
+    for (auto level = 0; level < depth_; ++level) {
+      const auto node = tree[index];
+      found |= node == value;
+      index = 2 * index + (node < value);
+    }
+    return found;
+  }
+
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t> x) const final {
+    auto inRange = (x >= xsimd::broadcast<int64_t>(min_)) &
+        (x <= xsimd::broadcast<int64_t>(max_));
+    if (simd::toBitMask(inRange) == 0) {
+      return xsimd::batch_bool<int64_t>(false);
+    }
+    const int64_t* tree = tree_->data();
+    const auto one = xsimd::broadcast<int64_t>(1);
+    const auto zero = xsimd::broadcast<int64_t>(0);
+    auto indices = one;
+    auto found = xsimd::batch_bool<int64_t>(false);
+    for (auto level = 0; level < depth_; ++level) {
+      const auto nodes = simd::gather(tree, indices);
+      found = found | (nodes == x);
+      indices = indices + indices + xsimd::select(nodes < x, one, zero);
+    }
+    return found & inRange;
+  }
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t> x) const final {
+    auto first = simd::toBitMask(testValues(simd::getHalf<int64_t, 0>(x)));
+    auto second = simd::toBitMask(testValues(simd::getHalf<int64_t, 1>(x)));
+    return simd::fromBitMask<int32_t>(
+        first | (second << xsimd::batch<int64_t>::size));
+  }
+
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return genericTestValues(x, [this](int16_t x) { return testInt64(x); });
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  /// The values in ascending order.
+  const std::vector<int64_t>& values() const {
+    return *values_;
+  }
+
+  std::string toString() const override {
+    return fmt::format(
+        "BigintValuesUsingSortedArray: [{}, {}] {} values {}",
+        min_,
+        max_,
+        values_->size(),
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  int64_t min_;
+  int64_t max_;
+
+  // Sorted values. Shared between clones since the lists can be large.
+  std::shared_ptr<const std::vector<int64_t>> values_;
+
+  // 'values_' laid out as a complete binary tree rooted at index 1, where the
+  // children of node i are at 2i and 2i + 1. Padded with copies of 'max_' to
+  // 2^'depth_' - 1 nodes so that every search takes exactly 'depth_' steps.
+  std::shared_ptr<const std::vector<int64_t>> tree_;
+  int32_t depth_;
+};
+
+/// Fraction of the tested values that a RuntimeBloomFilter passes. After each
+/// 'minTested' tested values the filter is turned off for good if it passed
+/// more than 'maxPassPct' percent of them, since then hashing the values costs
+/// more than the rows it drops save. A 'minTested' of 0 never turns the filter
+/// off.
+class BloomFilterSelectivity {
+ public:
+  BloomFilterSelectivity() = default;
+
+  BloomFilterSelectivity(int64_t minTested, int32_t maxPassPct)
+      : minTested_(minTested), maxPassPct_(maxPassPct) {
+    VELOX_CHECK_GE(minTested_, 0);
+    VELOX_CHECK_LE(maxPassPct_, 100);
+  }
+
+  /// Records the result of testing one value and returns it.
+  bool record(bool passed) {
+    numPassed_ += passed;
+    if (++numTested_ == minTested_) {
+      disabled_ = numPassed_ * 100 > numTested_ * maxPassPct_;
+      numTested_ = 0;
+      numPassed_ = 0;
+    }
+    return passed;
+  }
+
+  bool disabled() const {
+    return disabled_;
+  }
+
+  int64_t minTested() const {
+    return minTested_;
+  }
+
+  int32_t maxPassPct() const {
+    return maxPassPct_;
+  }
+
+  /// Returns the same settings with no tested values.
+  BloomFilterSelectivity restart() const {
+    return BloomFilterSelectivity(minTested_, maxPassPct_);
+  }
+
+ private:
+  int64_t minTested_{0};
+  int32_t maxPassPct_{100};
+  int64_t numTested_{0};
+  int64_t numPassed_{0};
+  bool disabled_{false};
+};
+
+/// Base of the bloom filters a hash join pushes down from its build side to
+/// the scan of its probe side. Copies made by clone() share the bits and start
+/// with no tested values, so the filter must be fully built before it is
+/// copied. A filter with a
+/// BloomFilterSelectivity is stateful and turns itself off when it drops too
+/// few values. This is correct since the join checks all keys again.
+class RuntimeBloomFilter : public Filter {
  public:
   static int64_t numBlocks(int64_t capacity) {
     return SplitBlockBloomFilter::numBlocks(capacity, 0.01);
   }
 
+  bool isStateful() const final {
+    return selectivity_.minTested() > 0;
+  }
+
+  /// Returns a copy that shares the bits of 'this' and is turned off as
+  /// described by 'minTested' and 'maxPassPct' in BloomFilterSelectivity.
+  virtual std::unique_ptr<Filter> withSelectivity(
+      int64_t minTested,
+      int32_t maxPassPct) const = 0;
+
+  /// True if the filter has turned itself off and passes all values.
+  bool disabled() const {
+    return selectivity_.disabled();
+  }
+
+  int64_t blocksByteSize() const {
+    return blocks_->size() * sizeof(SplitBlockBloomFilter::Block);
+  }
+
+  bool testingEquals(const Filter& other) const override;
+
+ protected:
+  RuntimeBloomFilter(FilterKind kind, int64_t capacity, bool nullAllowed)
+      : Filter(true, nullAllowed, kind),
+        blocks_(std::make_shared<std::vector<SplitBlockBloomFilter::Block>>(
+            numBlocks(capacity))),
+        filter_(*blocks_) {}
+
+  RuntimeBloomFilter(
+      FilterKind kind,
+      bool nullAllowed,
+      std::shared_ptr<std::vector<SplitBlockBloomFilter::Block>> blocks,
+      BloomFilterSelectivity selectivity)
+      : Filter(true, nullAllowed, kind),
+        blocks_(std::move(blocks)),
+        filter_(*blocks_),
+        selectivity_(selectivity) {}
+
+  bool mayContain(uint64_t hash) const {
+    if (selectivity_.disabled()) {
+      return true;
+    }
+    return selectivity_.record(filter_.mayContain(hash));
+  }
+
+  // Adds the bits and the selectivity settings to 'obj'.
+  void serializeBlocks(folly::dynamic& obj) const;
+
+  static std::shared_ptr<std::vector<SplitBlockBloomFilter::Block>>
+  deserializeBlocks(const folly::dynamic& obj);
+
+  static BloomFilterSelectivity deserializeSelectivity(
+      const folly::dynamic& obj);
+
+  std::shared_ptr<std::vector<SplitBlockBloomFilter::Block>> blocks_;
+  SplitBlockBloomFilter filter_;
+  mutable BloomFilterSelectivity selectivity_;
+};
+
+class BigintValuesUsingBloomFilter final : public RuntimeBloomFilter {
+ public:
   BigintValuesUsingBloomFilter(int64_t capacity, bool nullAllowed)
-      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
-        blocks_(numBlocks(capacity)),
-        filter_(blocks_) {}
+      : RuntimeBloomFilter(
+            FilterKind::kBigintValuesUsingBloomFilter,
+            capacity,
+            nullAllowed) {}
 
   bool testInt64(int64_t value) const final {
-    return filter_.mayContain(hash(value));
+    return mayContain(hash(value));
   }
 
   xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t> x) const final {
@@ -1326,15 +1587,25 @@ class BigintValuesUsingBloomFilter final : public Filter {
       std::optional<bool> nullAllowed) const override {
     return std::unique_ptr<BigintValuesUsingBloomFilter>(
         new BigintValuesUsingBloomFilter(
-            nullAllowed.value_or(nullAllowed_), blocks_));
+            nullAllowed.value_or(nullAllowed_),
+            blocks_,
+            selectivity_.restart()));
+  }
+
+  std::unique_ptr<Filter> withSelectivity(
+      int64_t minTested,
+      int32_t maxPassPct) const final {
+    return std::unique_ptr<BigintValuesUsingBloomFilter>(
+        new BigintValuesUsingBloomFilter(
+            nullAllowed_,
+            blocks_,
+            BloomFilterSelectivity(minTested, maxPassPct)));
   }
 
   folly::dynamic serialize() const override;
 
   static std::unique_ptr<Filter> create(const folly::dynamic& obj);
 
-  bool testingEquals(const Filter& other) const override;
-
   std::unique_ptr<Filter> mergeWith(const Filter* other) const override;
 
   void insert(int64_t value) {
@@ -1345,10 +1616,6 @@ class BigintValuesUsingBloomFilter final : public Filter {
     return filter_.blockIndex(hash(value));
   }
 
-  int64_t blocksByteSize() const {
-    return blocks_.size() * sizeof(SplitBlockBloomFilter::Block);
-  }
-
  private:
   static uint64_t hash(int64_t value) {
     // Simple multiplication hash like the one in BigintValuesUsingHashTable
@@ -1360,13 +1627,88 @@ class BigintValuesUsingBloomFilter final : public Filter {
   // Private constructor used by clone() and create().
   BigintValuesUsingBloomFilter(
       bool nullAllowed,
-      std::vector<SplitBlockBloomFilter::Block> blocks)
-      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
-        blocks_(std::move(blocks)),
-        filter_(blocks_) {}
+      std::shared_ptr<std::vector<SplitBlockBloomFilter::Block>> blocks,
+      BloomFilterSelectivity selectivity)
+      : RuntimeBloomFilter(
+            FilterKind::kBigintValuesUsingBloomFilter,
+            nullAllowed,
+            std::move(blocks),
+            selectivity) {}
+};
 
-  std::vector<SplitBlockBloomFilter::Block> blocks_;
-  SplitBlockBloomFilter filter_;
+/// IN-list filter for string data types implemented as a bloom filter. Used
+/// for join keys with too many distinct values for BytesValues.
+class BytesValuesUsingBloomFilter final : public RuntimeBloomFilter {
+ public:
+  BytesValuesUsingBloomFilter(int64_t capacity, bool nullAllowed)
+      : RuntimeBloomFilter(
+            FilterKind::kBytesValuesUsingBloomFilter,
+            capacity,
+            nullAllowed) {}
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return mayContain(hash(std::string_view(value, length)));
+  }
+
+  bool testLength(int32_t /*length*/) const final {
+    return true;
+  }
+
+  bool testBytesRange(
+      std::optional<std::string_view> /*min*/,
+      std::optional<std::string_view> /*max*/,
+      bool /*hasNull*/) const final {
+    return true;
+  }
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed) const override {
+    return std::unique_ptr<BytesValuesUsingBloomFilter>(
+        new BytesValuesUsingBloomFilter(
+            nullAllowed.value_or(nullAllowed_),
+            blocks_,
+            selectivity_.restart()));
+  }
+
+  std::unique_ptr<Filter> withSelectivity(
+      int64_t minTested,
+      int32_t maxPassPct) const final {
+    return std::unique_ptr<BytesValuesUsingBloomFilter>(
+        new BytesValuesUsingBloomFilter(
+            nullAllowed_,
+            blocks_,
+            BloomFilterSelectivity(minTested, maxPassPct)));
+  }
+
+  folly::dynamic serialize() const override;
+
+  static std::unique_ptr<Filter> create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const override;
+
+  void insert(std::string_view value) {
+    filter_.insert(hash(value));
+  }
+
+  uint64_t blockIndex(std::string_view value) const {
+    return filter_.blockIndex(hash(value));
+  }
+
+ private:
+  static uint64_t hash(std::string_view value) {
+    return folly::hasher<std::string_view>()(value);
+  }
+
+  // Private constructor used by clone() and create().
+  BytesValuesUsingBloomFilter(
+      bool nullAllowed,
+      std::shared_ptr<std::vector<SplitBlockBloomFilter::Block>> blocks,
+      BloomFilterSelectivity selectivity)
+      : RuntimeBloomFilter(
+            FilterKind::kBytesValuesUsingBloomFilter,
+            nullAllowed,
+            std::move(blocks),
+            selectivity) {}
 };
 
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
@@ -2285,8 +2627,9 @@ class BytesValues final : public Filter {
   }
 
   bool testBytes(const char* value, int32_t length) const final {
+    // Heterogeneous lookup, no std::string is built for the probe.
     return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+        values_.contains(std::string_view(value, length));
   }
 
   bool testBytesRange(
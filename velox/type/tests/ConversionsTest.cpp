@@ -592,6 +592,50 @@ TEST_F(ConversionsTest, toIntegralTypes) {
   }
 }
 
+TEST_F(ConversionsTest, stringToIntegralDigitRuns) {
+  // Inputs that take the eight digits at a time path, mixed with the inputs
+  // that fall back to folly at the boundaries.
+  testConversion<std::string, int64_t>(
+      {"12345678",
+       "-12345678",
+       "+00000000123",
+       "123456789012345678",
+       "-123456789012345678",
+       "1234567890123456789",
+       "9223372036854775807",
+       "-9223372036854775808",
+       " 87654321 "},
+      {12345678,
+       -12345678,
+       123,
+       123456789012345678,
+       -123456789012345678,
+       1234567890123456789,
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min(),
+       87654321});
+  testConversion<std::string, int32_t>(
+      {"2147483647", "-2147483648", "0000000000000042"},
+      {std::numeric_limits<int32_t>::max(),
+       std::numeric_limits<int32_t>::min(),
+       42});
+
+  // Non-digits inside and right after an eight digit run, and out of range
+  // values.
+  testConversion<std::string, int64_t>(
+      {"1234/678", "1234:678", "12345678a", "-", "9223372036854775808"},
+      {},
+      /*truncate*/ false,
+      false,
+      /*expectError*/ true);
+  testConversion<std::string, int32_t>(
+      {"2147483648", "-2147483649"},
+      {},
+      /*truncate*/ false,
+      false,
+      /*expectError*/ true);
+}
+
 TEST_F(ConversionsTest, toString) {
   // From integral types.
   {
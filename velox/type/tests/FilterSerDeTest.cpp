@@ -97,6 +97,7 @@ TEST_F(FilterSerDeTest, valuesFilters) {
     for (auto nullAllowed : {false, true}) {
       testSerde(BigintValuesUsingHashTable(lower, upper, values, nullAllowed));
       testSerde(BigintValuesUsingBitmask(lower, upper, values, nullAllowed));
+      testSerde(BigintValuesUsingSortedArray(values, nullAllowed));
       testSerde(
           NegatedBigintValuesUsingHashTable(lower, upper, values, nullAllowed));
       testSerde(
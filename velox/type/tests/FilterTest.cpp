@@ -476,6 +476,64 @@ TEST(FilterTest, negatedBigintValuesUsingHashTableSimd) {
   applySimdTestToVector(numbers16, *filter, verify);
 }
 
+TEST(FilterTest, bigintValuesUsingSortedArray) {
+  std::vector<int64_t> numbers;
+  for (auto i = 0; i < BigintValuesUsingSortedArray::kMinValues; ++i) {
+    numbers.push_back(i * 1209 - 1'000'000);
+  }
+  auto filter = createBigintValues(numbers, false);
+  ASSERT_TRUE(dynamic_cast<BigintValuesUsingSortedArray*>(filter.get()));
+  for (auto n : numbers) {
+    ASSERT_TRUE(filter->testInt64(n)) << n;
+    ASSERT_FALSE(filter->testInt64(n + 1)) << n;
+  }
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(numbers.front() - 1));
+  EXPECT_FALSE(filter->testInt64(INT64_MIN));
+  EXPECT_FALSE(filter->testInt64(INT64_MAX));
+
+  EXPECT_TRUE(filter->testInt64Range(0, 10'000, false));
+  EXPECT_FALSE(filter->testInt64Range(1, 1'000, false));
+  EXPECT_TRUE(filter->testInt64Range(1, 1'000, true));
+  EXPECT_FALSE(filter->testInt64Range(INT64_MIN, numbers.front() - 1, false));
+  EXPECT_TRUE(filter->testInt64Range(numbers.back(), INT64_MAX, false));
+
+  int64_t outOfRange[] = {INT64_MIN, -20'000'000, 0x10000000, INT64_MAX};
+  auto verify = [&](int64_t x) { return filter->testInt64(x); };
+  checkSimd(filter.get(), outOfRange, verify);
+  applySimdTestToVector(numbers, *filter, verify);
+
+  std::vector<int32_t> numbers32;
+  for (auto n : numbers) {
+    numbers32.push_back(n);
+  }
+  applySimdTestToVector(numbers32, *filter, verify);
+
+  // A size that is not 2^n - 1 pads the tree with copies of the maximum.
+  numbers.push_back(INT64_MAX);
+  filter = createBigintValues(numbers, true);
+  ASSERT_TRUE(dynamic_cast<BigintValuesUsingSortedArray*>(filter.get()));
+  EXPECT_TRUE(filter->testNull());
+  EXPECT_TRUE(filter->testInt64(INT64_MAX));
+  EXPECT_FALSE(filter->testInt64(INT64_MAX - 1));
+  int64_t nearMax[] = {INT64_MAX, INT64_MAX - 1, numbers[0], numbers[1] + 1};
+  checkSimd(filter.get(), nearMax, verify);
+
+  auto other = createBigintValues({numbers[10], numbers[10] + 1}, false);
+  auto merged = filter->mergeWith(other.get());
+  ASSERT_TRUE(
+      merged->testingEquals(BigintRange(numbers[10], numbers[10], false)));
+
+  auto range = std::make_unique<BigintRange>(-1'000'000, 0, false);
+  merged = filter->mergeWith(range.get());
+  EXPECT_FALSE(merged->testNull());
+  for (auto i = 0; i < 1'000; ++i) {
+    auto value = numbers[i];
+    EXPECT_EQ(merged->testInt64(value), value <= 0) << value;
+  }
+  ASSERT_TRUE(range->mergeWith(filter.get())->testingEquals(*merged));
+}
+
 TEST(FilterTest, bigintValuesUsingBitmask) {
   auto filter = createBigintValues({1, 10, 100, 1000}, false);
   auto castedFilter = dynamic_cast<BigintValuesUsingBitmask*>(filter.get());
@@ -679,6 +737,85 @@ TEST(FilterTest, bigintValuesUsingBloomFilterMergeWith) {
   }
 }
 
+TEST(FilterTest, bytesValuesUsingBloomFilter) {
+  BytesValuesUsingBloomFilter filter(10, false);
+  folly::F14FastSet<std::string> inserted;
+  for (const char* x : {"a", "bb", "ccc", "a long string that is not inline"}) {
+    filter.insert(x);
+    inserted.insert(x);
+  }
+  ASSERT_FALSE(filter.testNull());
+  ASSERT_FALSE(filter.hasTestLength());
+  for (const char* x :
+       {"a", "b", "bb", "ccc", "cc", "a long string that is not inline"}) {
+    ASSERT_EQ(
+        filter.testBytes(x, strlen(x)), inserted.contains(std::string(x)))
+        << x;
+  }
+  ASSERT_TRUE(filter.testBytesRange("x", "y", false));
+  ASSERT_FALSE(filter.isStateful());
+  Filter::registerSerDe();
+  auto deserialized = ISerializable::deserialize<BytesValuesUsingBloomFilter>(
+      filter.serialize());
+  ASSERT_TRUE(deserialized->testingEquals(filter));
+  ASSERT_TRUE(filter.clone(true)->testNull());
+
+  // Clones share the bits.
+  auto clone = filter.clone(std::nullopt);
+  ASSERT_FALSE(clone->testBytes("dddd", 4));
+  filter.insert("dddd");
+  ASSERT_TRUE(clone->testBytes("dddd", 4));
+
+  auto other = BytesValues({"a", "b", "ccc", "eeeee"}, true);
+  auto merged = filter.mergeWith(&other);
+  ASSERT_TRUE(merged->testingEquals(BytesValues({"a", "ccc"}, false)));
+  ASSERT_TRUE(other.mergeWith(&filter)->testingEquals(*merged));
+  auto range = BytesRange("a", false, false, "b", false, false, false);
+  ASSERT_TRUE(filter.mergeWith(&range)->testingEquals(range));
+}
+
+TEST(FilterTest, bloomFilterSelectivity) {
+  BigintValuesUsingBloomFilter filter(1'000, false);
+  for (auto i = 0; i < 1'000; ++i) {
+    filter.insert(i);
+  }
+  ASSERT_FALSE(filter.isStateful());
+  int64_t rejected = -1;
+  while (filter.testInt64(rejected)) {
+    --rejected;
+  }
+  auto selective = filter.withSelectivity(100, 50);
+  ASSERT_TRUE(selective->isStateful());
+  auto* selectiveBloom = selective->as<BigintValuesUsingBloomFilter>();
+
+  // The filter stays on while it drops enough values.
+  for (auto i = 0; i < 1'000; ++i) {
+    selective->testInt64(i % 3 == 0 ? i : -i - 1);
+  }
+  ASSERT_FALSE(selectiveBloom->disabled());
+  ASSERT_FALSE(selective->testInt64(rejected));
+
+  // After passing more than half of 100 tested values, every value passes.
+  for (auto i = 0; i < 100; ++i) {
+    selective->testInt64(i % 3 == 0 ? -i - 1 : i);
+  }
+  ASSERT_TRUE(selectiveBloom->disabled());
+  ASSERT_TRUE(selective->testInt64(rejected));
+
+  // A clone for another reader starts with no tested values.
+  auto clone = selective->clone();
+  ASSERT_TRUE(clone->isStateful());
+  ASSERT_FALSE(clone->as<BigintValuesUsingBloomFilter>()->disabled());
+  ASSERT_FALSE(clone->testInt64(rejected));
+  ASSERT_TRUE(clone->testingEquals(filter));
+
+  Filter::registerSerDe();
+  auto deserialized =
+      ISerializable::deserialize<BigintValuesUsingBloomFilter>(
+          selective->serialize());
+  ASSERT_TRUE(deserialized->isStateful());
+}
+
 TEST(FilterTest, bigintMultiRange) {
   // x between 1 and 10 or x between 100 and 120
   auto filter = bigintOr(between(1, 10), between(100, 120));
@@ -16,6 +16,8 @@
 
 #include "velox/type/tz/TimeZoneMap.h"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <fmt/core.h>
 #include <folly/container/F14Map.h>
@@ -237,6 +239,14 @@ std::string normalizeTimeZone(const std::string& originalZoneId) {
   return originalZoneId;
 }
 
+// The GMT times covered by the periods of a time zone: [1900-01-01,
+// 2100-01-01).
+constexpr int64_t kPeriodsBegin = -2'208'988'800;
+constexpr int64_t kPeriodsEnd = 4'102'444'800;
+
+// Bounds the offsets of time zones from GMT.
+constexpr int64_t kMaxOffsetSeconds = 86'400;
+
 template <typename TDuration>
 void validateRangeImpl(time_point<TDuration> timePoint) {
   using namespace velox::date;
@@ -451,24 +461,107 @@ std::vector<int16_t> getTimeZoneIDs() {
   return ids;
 }
 
+const std::vector<TimeZone::Period>& TimeZone::periods() const {
+  std::call_once(periodsOnce_, [&]() {
+    VELOX_CHECK_NOT_NULL(tz_);
+    auto begin = kPeriodsBegin;
+    while (begin < kPeriodsEnd) {
+      const auto info = tz_->get_info(date::sys_seconds{seconds{begin}});
+      const auto offset = static_cast<int32_t>(info.offset.count());
+      // Periods that only differ in their abbreviation or savings are merged.
+      if (periods_.empty() || periods_.back().offset != offset) {
+        periods_.push_back({begin, offset});
+      }
+      const auto end = info.end.time_since_epoch().count();
+      VELOX_CHECK_GT(end, begin);
+      begin = end;
+    }
+  });
+  return periods_;
+}
+
+std::optional<int64_t> TimeZone::sysOffset(int64_t timestamp) const {
+  if (timestamp < kPeriodsBegin || timestamp >= kPeriodsEnd) {
+    return std::nullopt;
+  }
+  const auto& periods = this->periods();
+  const auto it = std::upper_bound(
+      periods.begin(),
+      periods.end(),
+      timestamp,
+      [](int64_t time, const Period& period) { return time < period.begin; });
+  return std::prev(it)->offset;
+}
+
+std::optional<int64_t> TimeZone::localOffset(int64_t timestamp) const {
+  if (timestamp < kPeriodsBegin + kMaxOffsetSeconds ||
+      timestamp >= kPeriodsEnd - kMaxOffsetSeconds) {
+    return std::nullopt;
+  }
+  // The periods that may contain 'timestamp' in local time start before
+  // 'timestamp' + kMaxOffsetSeconds and end after 'timestamp' -
+  // kMaxOffsetSeconds.
+  const auto& periods = this->periods();
+  auto it = std::prev(std::upper_bound(
+      periods.begin(),
+      periods.end(),
+      timestamp - kMaxOffsetSeconds,
+      [](int64_t time, const Period& period) { return time < period.begin; }));
+  std::optional<int64_t> offset;
+  for (; it != periods.end() && it->begin <= timestamp + kMaxOffsetSeconds;
+       ++it) {
+    const auto end =
+        std::next(it) == periods.end() ? kPeriodsEnd : std::next(it)->begin;
+    if (timestamp >= it->begin + it->offset && timestamp < end + it->offset) {
+      if (offset.has_value()) {
+        return std::nullopt;
+      }
+      offset = it->offset;
+    }
+  }
+  return offset;
+}
+
 TimeZone::seconds TimeZone::to_sys(
     TimeZone::seconds timestamp,
     TimeZone::TChoose choose) const {
+  if (tz_ != nullptr) {
+    if (const auto offset = localOffset(timestamp.count())) {
+      return timestamp - seconds{*offset};
+    }
+  }
   return toSysImpl(timestamp, choose, tz_, offset_);
 }
 
 TimeZone::milliseconds TimeZone::to_sys(
     TimeZone::milliseconds timestamp,
     TimeZone::TChoose choose) const {
+  if (tz_ != nullptr) {
+    if (const auto offset =
+            localOffset(std::chrono::floor<seconds>(timestamp).count())) {
+      return timestamp - seconds{*offset};
+    }
+  }
   return toSysImpl(timestamp, choose, tz_, offset_);
 }
 
 TimeZone::seconds TimeZone::to_local(TimeZone::seconds timestamp) const {
+  if (tz_ != nullptr) {
+    if (const auto offset = sysOffset(timestamp.count())) {
+      return timestamp + seconds{*offset};
+    }
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
 TimeZone::milliseconds TimeZone::to_local(
     TimeZone::milliseconds timestamp) const {
+  if (tz_ != nullptr) {
+    if (const auto offset =
+            sysOffset(std::chrono::floor<seconds>(timestamp).count())) {
+      return timestamp + seconds{*offset};
+    }
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -194,10 +195,35 @@ class TimeZone {
       TChoose choose = TChoose::kFail) const;
 
  private:
+  // A period starting at 'begin' seconds since the epoch in GMT, in which the
+  // time zone is 'offset' seconds ahead of GMT.
+  struct Period {
+    int64_t begin;
+    int32_t offset;
+  };
+
+  // Returns the periods of 'tz_' in ascending 'begin', built on first use.
+  // Conversions of times covered by the periods look up the offset here
+  // rather than in the time zone database, which builds a sys_info with its
+  // abbreviation every time.
+  const std::vector<Period>& periods() const;
+
+  // Returns the offset from GMT at GMT seconds 'timestamp', or std::nullopt
+  // if 'timestamp' is not covered by periods().
+  std::optional<int64_t> sysOffset(int64_t timestamp) const;
+
+  // Returns the offset from GMT at local seconds 'timestamp', or
+  // std::nullopt if 'timestamp' is not covered by periods() or is ambiguous
+  // or nonexistent, which the time zone database handles.
+  std::optional<int64_t> localOffset(int64_t timestamp) const;
+
   const tzdb::time_zone* tz_{nullptr};
   const std::chrono::minutes offset_{0};
   const std::string timeZoneName_;
   const int16_t timeZoneID_;
+
+  mutable std::once_flag periodsOnce_;
+  mutable std::vector<Period> periods_;
 };
 
 } // namespace facebook::velox::tz
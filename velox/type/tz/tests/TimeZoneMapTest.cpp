@@ -19,6 +19,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/date.h"
+#include "velox/external/tzdb/zoned_time.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
 namespace facebook::velox::tz {
@@ -116,6 +117,52 @@ TEST(TimeZoneMapTest, offsetToSys) {
   EXPECT_NE(toSysTime("-07:00", ts), toSysTime("America/Los_Angeles", ts));
 }
 
+TEST(TimeZoneMapTest, periods) {
+  // Conversions of times from 1900 to 2100 look up the offsets cached by the
+  // time zone. Compare them with the time zone database.
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Australia/Lord_Howe",
+        "Asia/Kolkata",
+        "Pacific/Apia"}) {
+    SCOPED_TRACE(name);
+    const auto* tz = locateZone(name);
+    ASSERT_NE(tz, nullptr);
+    for (int64_t ts = -2'250'000'000; ts < 4'150'000'000; ts += 86'399 * 7) {
+      for (const auto delta : {0, 1'800, 3'599, 3'600, 5'400}) {
+        const seconds time{ts + delta};
+        EXPECT_EQ(
+            tz->to_local(time),
+            tzdb::zoned_time{tz->tz(), date::sys_seconds{time}}
+                .get_local_time()
+                .time_since_epoch());
+        EXPECT_EQ(
+            tz->to_sys(time, TimeZone::TChoose::kEarliest),
+            tzdb::zoned_time{
+                tz->tz(), date::local_seconds{time}, tzdb::choose::earliest}
+                .get_sys_time()
+                .time_since_epoch());
+      }
+    }
+  }
+
+  const auto* tz = locateZone("America/Los_Angeles");
+  EXPECT_EQ(
+      tz->to_local(milliseconds{1'721'890'800'123}).count(),
+      1'721'890'800'123 - 7 * 3'600'000);
+  EXPECT_EQ(
+      tz->to_sys(milliseconds{1'721'890'800'123}).count(),
+      1'721'890'800'123 + 7 * 3'600'000);
+  // 2024-11-03 01:30:00 is ambiguous and 2024-03-10 02:30:00 does not exist.
+  EXPECT_THROW(tz->to_sys(seconds{1'730'597'400}), tzdb::ambiguous_local_time);
+  EXPECT_EQ(
+      tz->to_sys(seconds{1'730'597'400}, TimeZone::TChoose::kLatest).count(),
+      1'730'597'400 + 8 * 3'600);
+  EXPECT_THROW(
+      tz->to_sys(seconds{1'710'037'800}), tzdb::nonexistent_local_time);
+}
+
 TEST(TimeZoneMapTest, timePointBoundary) {
   using namespace date;
 
@@ -49,6 +49,21 @@ const BaseVector* getValueVector(const BaseVector* vector) {
   return vector->valueVector().get();
 }
 
+// Sets the first 'size' entries of 'indices' to the index of the run of
+// 'sequenceVector' that each row is in.
+void fillSequenceIndices(
+    const BaseVector& sequenceVector,
+    vector_size_t size,
+    vector_size_t* indices) {
+  const auto* lengths = sequenceVector.wrapInfo()->as<SequenceLength>();
+  vector_size_t row = 0;
+  for (vector_size_t run = 0; row < size; ++run) {
+    const auto end = std::min<vector_size_t>(size, row + lengths[run]);
+    std::fill(indices + row, indices + end, run);
+    row = end;
+  }
+}
+
 } // namespace
 
 const std::vector<vector_size_t>& DecodedVector::consecutiveIndices() {
@@ -204,6 +219,12 @@ void DecodedVector::combineWrappers(
       hasExtraNulls_ = true;
       mayHaveNulls_ = true;
     }
+  } else if (topEncoding == VectorEncoding::Simple::SEQUENCE) {
+    // The nulls of a sequence are the nulls of its values.
+    copiedIndices_.resize(size_ > 0 ? size_ : 1);
+    fillSequenceIndices(*vector, size_, copiedIndices_.data());
+    indices_ = copiedIndices_.data();
+    values = getValueVector(vector);
   } else {
     VELOX_FAIL(
         "Unsupported wrapper encoding: {}",
@@ -243,6 +264,10 @@ void DecodedVector::combineWrappers(
         applyDictionaryWrapper(*values, rows);
         values = getValueVector(values);
         break;
+      case VectorEncoding::Simple::SEQUENCE:
+        applySequenceWrapper(*values, rows);
+        values = getValueVector(values);
+        break;
       default:
         VELOX_CHECK(false, "Unsupported vector encoding");
     }
@@ -288,6 +313,24 @@ void DecodedVector::applyDictionaryWrapper(
   });
 }
 
+void DecodedVector::applySequenceWrapper(
+    const BaseVector& sequenceVector,
+    const SelectivityVector* rows) {
+  if (size_ == 0 || (rows && !rows->hasSelections())) {
+    // No further processing is needed.
+    return;
+  }
+
+  std::vector<vector_size_t> runs(sequenceVector.size());
+  fillSequenceIndices(sequenceVector, sequenceVector.size(), runs.data());
+  makeIndicesMutable();
+  applyToRows(rows, [&](vector_size_t row) {
+    if (!nulls_ || !bits::isBitNull(nulls_, row)) {
+      copiedIndices_[row] = runs[copiedIndices_[row]];
+    }
+  });
+}
+
 void DecodedVector::fillInIndices() const {
   if (isConstantMapping_) {
     if (size_ > zeroIndices().size() || constantIndex_ != 0) {
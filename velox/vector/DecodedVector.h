@@ -32,7 +32,8 @@ namespace facebook::velox {
 /// Decoding a vector is straightforward if it is flat. However, if it is not,
 /// the following steps are taken:
 /// 1. It first traverses the top dictionary layers (if they exist) and
-///    combines their indices and nulls
+///    combines their indices and nulls. A sequence (run-length encoded) layer
+///    is treated as a dictionary that maps each row to the index of its run
 /// 2. Next, if it encounters a constant layer, it does the following:
 ///    ** If the dictionary layers over it were adding additional nulls, then it
 ///    replaces all non-null indices with the constant index.
@@ -351,6 +352,12 @@ class DecodedVector {
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
 
+  // Maps the indices of 'rows' to the runs of 'sequenceVector', which is
+  // wrapped in the encodings applied so far.
+  void applySequenceWrapper(
+      const BaseVector& sequenceVector,
+      const SelectivityVector* rows);
+
   void copyNulls(vector_size_t size);
 
   void fillInIndices() const;
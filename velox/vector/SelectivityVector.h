@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -88,6 +89,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = value ? size_ : 0;
     allSelected_ = value;
+    sparseRowsState_ = SparseRowsState::kUnknown;
   }
 
   /**
@@ -99,6 +101,7 @@ class SelectivityVector {
     VELOX_DCHECK_LT(idx, bits_.size() * sizeof(bits_[0]) * 8);
     bits::setBit(bits_.data(), idx, valid);
     allSelected_.reset();
+    sparseRowsState_ = SparseRowsState::kUnknown;
   }
 
   /**
@@ -114,6 +117,7 @@ class SelectivityVector {
     VELOX_DCHECK_LE(end, bits_.size() * sizeof(bits_[0]) * 8);
     bits::fillBits(bits_.data(), begin, end, valid);
     allSelected_.reset();
+    sparseRowsState_ = SparseRowsState::kUnknown;
   }
 
   /**
@@ -131,6 +135,7 @@ class SelectivityVector {
    * updateBounds() need to be called explicitly if data is modified.
    */
   MutableRange<bool> asMutableRange() {
+    sparseRowsState_ = SparseRowsState::kUnknown;
     return MutableRange<bool>(bits_.data(), begin_, end_);
   }
 
@@ -163,6 +168,7 @@ class SelectivityVector {
     VELOX_SUPPRESS_STRINGOP_OVERFLOW_WARNING
     allSelected_ = false;
     VELOX_UNSUPPRESS_STRINGOP_OVERFLOW_WARNING
+    sparseRowsState_ = SparseRowsState::kUnknown;
   }
 
   /**
@@ -173,6 +179,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = size_;
     allSelected_ = true;
+    sparseRowsState_ = SparseRowsState::kUnknown;
   }
 
   void setFromBits(const uint64_t* bits, int32_t size) {
@@ -289,6 +296,7 @@ class SelectivityVector {
    * index (noting that the range in between may contain not selected indices).
    */
   void updateBounds() {
+    sparseRowsState_ = SparseRowsState::kUnknown;
     begin_ = bits::findFirstBit(bits_.data(), 0, size_);
     if (begin_ == -1) {
       begin_ = 0;
@@ -344,6 +352,27 @@ class SelectivityVector {
   template <typename Callable>
   void applyToSelected(Callable func) const;
 
+  /// Returns the selected rows in ascending order if there are fewer than one
+  /// per kSparseRowsDensity rows between begin() and end(), nullptr
+  /// otherwise. The list is made on first use and kept until 'this' is
+  /// modified, so that a chain of expressions over highly selective rows
+  /// iterates the rows instead of scanning mostly empty words each time.
+  std::shared_ptr<const std::vector<vector_size_t>> sparseRows() const {
+    if (sparseRowsState_ == SparseRowsState::kUnknown) {
+      makeSparseRows();
+    }
+    return sparseRowsState_ == SparseRowsState::kSparse ? sparseRows_
+                                                        : nullptr;
+  }
+
+  /// Rows per selected row below which the selection is kept as a list by
+  /// sparseRows().
+  static constexpr vector_size_t kSparseRowsDensity = 64;
+
+  /// Minimum end() - begin() for sparseRows() to make a list. Narrower
+  /// ranges are scanned in a few words.
+  static constexpr vector_size_t kMinSparseRowsRange = 1024;
+
   /// Invokes a function on each selected row sequentially in order starting
   /// from the lowest row number until a function returns 'false' or all
   /// selected rows have been processed. The function must take a single "row"
@@ -390,6 +419,35 @@ class SelectivityVector {
 
   mutable std::optional<bool> allSelected_;
 
+  enum class SparseRowsState : int8_t { kUnknown, kDense, kSparse };
+
+  // Fills 'sparseRows_' and 'sparseRowsState_' from the bits.
+  void makeSparseRows() const {
+    sparseRowsState_ = SparseRowsState::kDense;
+    if (end_ - begin_ < kMinSparseRowsRange) {
+      return;
+    }
+    const auto numSelected = bits::countBits(bits_.data(), begin_, end_);
+    if (numSelected * kSparseRowsDensity >= end_ - begin_) {
+      return;
+    }
+    // A list still referenced by an iteration in progress is not reused.
+    if (sparseRows_ == nullptr || sparseRows_.use_count() > 1) {
+      sparseRows_ = std::make_shared<std::vector<vector_size_t>>();
+    }
+    sparseRows_->resize(numSelected);
+    auto* rows = sparseRows_->data();
+    bits::forEachSetBit(
+        bits_.data(), begin_, end_, [&](vector_size_t row) { *rows++ = row; });
+    sparseRowsState_ = SparseRowsState::kSparse;
+  }
+
+  // Whether 'sparseRows_' is valid. Reset whenever the bits may change.
+  mutable SparseRowsState sparseRowsState_{SparseRowsState::kUnknown};
+
+  // The selected rows if 'sparseRowsState_' is kSparse.
+  mutable std::shared_ptr<std::vector<vector_size_t>> sparseRows_;
+
   friend class SelectivityIterator;
 };
 
@@ -444,6 +502,10 @@ inline void SelectivityVector::applyToSelected(Callable func) const {
     for (vector_size_t row = begin_; row < end; ++row) {
       func(row);
     }
+  } else if (const auto rows = sparseRows()) {
+    for (const auto row : *rows) {
+      func(row);
+    }
   } else {
     bits::forEachSetBit(bits_.data(), begin_, end_, func);
   }
@@ -47,12 +47,33 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+bool isComplexType(const TypePtr& type) {
+  return type->kind() == TypeKind::ARRAY || type->kind() == TypeKind::MAP ||
+      type->kind() == TypeKind::ROW;
+}
+
+// Marks the first 'size' rows of 'vector' not null.
+void clearNulls(BaseVector& vector, vector_size_t size) {
+  if (FOLLY_UNLIKELY(vector.rawNulls() != nullptr)) {
+    // This is a recyclable vector, no need to check uniqueness.
+    simd::memset(
+        const_cast<uint64_t*>(vector.rawNulls()),
+        bits::kNotNullByte,
+        bits::roundUp(std::min<int32_t>(size, vector.size()), 64) / 8);
+  }
+}
 } // namespace
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
   auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    if (cacheIndex >= 0) {
+      return vectors_[cacheIndex].pop(type, size, *pool_);
+    }
+    if (isComplexType(type)) {
+      return complexVectors_.pop(type, size, *pool_);
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -67,6 +88,9 @@ bool VectorPool::release(VectorPtr& vector) {
 
   auto cacheIndex = toCacheIndex(vector->type());
   if (cacheIndex < 0) {
+    if (isComplexType(vector->type())) {
+      return complexVectors_.maybePushBack(vector);
+    }
     return false;
   }
   return vectors_[cacheIndex].maybePushBack(vector);
@@ -88,6 +112,7 @@ void VectorPool::clear() {
   for (auto& vectorPool : vectors_) {
     vectorPool.clear();
   }
+  complexVectors_.clear();
 }
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
@@ -111,13 +136,7 @@ VectorPtr VectorPool::TypePool::pop(
     memory::MemoryPool& pool) {
   if (size) {
     auto result = std::move(vectors[--size]);
-    if (UNLIKELY(result->rawNulls() != nullptr)) {
-      // This is a recyclable vector, no need to check uniqueness.
-      simd::memset(
-          const_cast<uint64_t*>(result->rawNulls()),
-          bits::kNotNullByte,
-          bits::roundUp(std::min<int32_t>(vectorSize, result->size()), 64) / 8);
-    }
+    clearNulls(*result, vectorSize);
     if (UNLIKELY(
             result->typeKind() == TypeKind::VARCHAR ||
             result->typeKind() == TypeKind::VARBINARY)) {
@@ -138,4 +157,39 @@ void VectorPool::TypePool::clear() {
   std::fill_n(vectors.begin(), kNumPerType, nullptr);
   size = 0;
 }
+
+bool VectorPool::ComplexTypePool::maybePushBack(VectorPtr& vector) {
+  if (size >= kNumComplex || !BaseVector::recursivelyReusable(vector)) {
+    return false;
+  }
+
+  // Empties the children and keeps the buffers that are singly-referenced.
+  vector->prepareForReuse();
+  vectors[size++] = std::move(vector);
+  return true;
+}
+
+VectorPtr VectorPool::ComplexTypePool::pop(
+    const TypePtr& type,
+    vector_size_t vectorSize,
+    memory::MemoryPool& pool) {
+  for (auto i = size - 1; i >= 0; --i) {
+    if (!vectors[i]->type()->equals(*type)) {
+      continue;
+    }
+    auto result = std::move(vectors[i]);
+    if (i != --size) {
+      vectors[i] = std::move(vectors[size]);
+    }
+    clearNulls(*result, vectorSize);
+    result->resize(vectorSize);
+    return result;
+  }
+  return BaseVector::create(type, vectorSize, &pool);
+}
+
+void VectorPool::ComplexTypePool::clear() {
+  std::fill_n(vectors.begin(), kNumComplex, nullptr);
+  size = 0;
+}
 } // namespace facebook::velox
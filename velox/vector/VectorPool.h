@@ -20,13 +20,17 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
-/// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// A thread-level cache of pre-allocated vectors of different types.
+/// Keeps up to 10 recyclable flat vectors of each singleton built-in type and
+/// up to 10 recyclable ARRAY, MAP and ROW vectors of any types. A flat vector
+/// is recyclable if it is singly-referenced. An ARRAY, MAP or ROW vector is
+/// recyclable if it and its children are recursively singly-referenced and
+/// not encoded. A recycled complex vector keeps its children, which are
+/// emptied, and their buffers, so that filling it again does not allocate
+/// until it outgrows them. Decimal types, fixed-size array type and custom
+/// flat types are not supported. Calling 'get' for an unsupported type
+/// always returns a newly allocated vector. Calling 'release' for an
+/// unsupported type is a no-op.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
@@ -50,6 +54,7 @@ class VectorPool {
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  static constexpr int32_t kNumComplex = 10;
 
   struct TypePool {
     int32_t size{0};
@@ -66,6 +71,22 @@ class VectorPool {
     void clear();
   };
 
+  // Cache of ARRAY, MAP and ROW vectors of any types. 'pop' returns the most
+  // recently added vector of the requested type.
+  struct ComplexTypePool {
+    int32_t size{0};
+    std::array<VectorPtr, kNumComplex> vectors;
+
+    bool maybePushBack(VectorPtr& vector);
+
+    VectorPtr pop(
+        const TypePtr& type,
+        vector_size_t vectorSize,
+        memory::MemoryPool& pool);
+
+    void clear();
+  };
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -73,6 +94,8 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  ComplexTypePool complexVectors_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -15,6 +15,7 @@
  */
 #include "velox/vector/VectorStream.h"
 
+#include <algorithm>
 #include <memory>
 
 namespace facebook::velox {
@@ -202,6 +203,38 @@ void VectorStreamGroup::append(const RowVectorPtr& vector) {
   serializer_->append(vector);
 }
 
+// static
+void VectorStreamGroup::scatter(
+    const RowVectorPtr& vector,
+    const std::vector<VectorStreamGroup*>& groups,
+    const std::vector<folly::Range<const vector_size_t*>>& rows,
+    Scratch& scratch) {
+  VELOX_CHECK_EQ(groups.size(), rows.size());
+  const bool byColumn = std::all_of(
+      groups.begin(), groups.end(), [](const VectorStreamGroup* group) {
+        return group->serializer_->supportsAppendColumn();
+      });
+  if (!byColumn) {
+    for (auto i = 0; i < groups.size(); ++i) {
+      groups[i]->append(vector, rows[i], scratch);
+    }
+    return;
+  }
+  for (column_index_t column = 0; column < vector->childrenSize(); ++column) {
+    const auto& child = vector->childAt(column);
+    for (auto i = 0; i < groups.size(); ++i) {
+      if (!rows[i].empty()) {
+        groups[i]->serializer_->appendColumn(column, child, rows[i], scratch);
+      }
+    }
+  }
+  for (auto i = 0; i < groups.size(); ++i) {
+    if (!rows[i].empty()) {
+      groups[i]->serializer_->appendNumRows(rows[i].size());
+    }
+  }
+}
+
 void VectorStreamGroup::append(
     const row::CompactRow& compactRow,
     const folly::Range<const vector_size_t*>& rows,
@@ -105,6 +105,29 @@ class IterativeVectorSerializer {
     return false;
   }
 
+  /// True if supports appendColumn() and appendNumRows().
+  virtual bool supportsAppendColumn() const {
+    return false;
+  }
+
+  /// Serializes 'rows' of 'column', the child at 'index' of the rows being
+  /// appended. After all columns, appendNumRows() completes the rows. This
+  /// lets a caller that serializes subsets of the same batch into many
+  /// serializers, e.g. one per destination of a shuffle, go over the batch a
+  /// column at a time.
+  virtual void appendColumn(
+      column_index_t /*index*/,
+      const VectorPtr& /*column*/,
+      const folly::Range<const vector_size_t*>& /*rows*/,
+      Scratch& /*scratch*/) {
+    VELOX_UNSUPPORTED("{}", __FUNCTION__);
+  }
+
+  /// Adds 'numRows' rows whose columns were added by appendColumn().
+  virtual void appendNumRows(vector_size_t /*numRows*/) {
+    VELOX_UNSUPPORTED("{}", __FUNCTION__);
+  }
+
   /// Returns the maximum serialized size of the data previously added via
   /// 'append' methods. Can be used to allocate buffer of exact or maximum size
   /// before calling 'flush'.
@@ -450,6 +473,18 @@ class VectorStreamGroup : public StreamArena {
 
   void append(const RowVectorPtr& vector);
 
+  /// Appends rows[i] of 'vector' to groups[i] for each i. Same as calling
+  /// append(vector, rows[i], scratch) on each group, but if the serializers
+  /// support appendColumn(), goes over 'vector' a column at a time, so that
+  /// each column is read once for all groups. Serializing a batch into many
+  /// groups then costs one pass per column instead of one per group and
+  /// column.
+  static void scatter(
+      const RowVectorPtr& vector,
+      const std::vector<VectorStreamGroup*>& groups,
+      const std::vector<folly::Range<const vector_size_t*>>& rows,
+      Scratch& scratch);
+
   void append(
       const row::CompactRow& compactRow,
       const folly::Range<const vector_size_t*>& rows,
@@ -16,6 +16,9 @@
 
 #include "velox/vector/arrow/Bridge.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CheckedArithmetic.h"
@@ -591,6 +594,32 @@ VectorPtr createFlatVector(
 using WrapInBufferViewFunc =
     std::function<BufferPtr(const void* buffer, size_t length)>;
 
+// Converts the 16-byte Arrow Utf8Views [4-byte length, 4-byte prefix, 4-byte
+// buffer-index, 4-byte buffer-offset] of 'arrowArray' to 16-byte Velox
+// StringViews [4-byte length, 4-byte prefix, 8-byte buffer-ptr] in
+// 'rawStringViews'. Inline strings (length <= 12) are copied as is.
+void convertUtf8Views(const ArrowArray& arrowArray, uint64_t* rawStringViews) {
+  const int64_t numDataBuffers = arrowArray.n_buffers - 3;
+  for (int32_t idx_64 = 0; idx_64 < arrowArray.length; ++idx_64) {
+    auto* view = reinterpret_cast<const uint32_t*>(&(
+        reinterpret_cast<const uint64_t*>(arrowArray.buffers[1]))[2 * idx_64]);
+    rawStringViews[2 * idx_64] = *reinterpret_cast<const uint64_t*>(view);
+    if (view[0] > 12) {
+      const auto bufferIndex = view[2];
+      VELOX_CHECK_LT(
+          bufferIndex,
+          numDataBuffers,
+          "Arrow Utf8View buffer index out of range");
+      rawStringViews[2 * idx_64 + 1] =
+          reinterpret_cast<uint64_t>(arrowArray.buffers[2 + bufferIndex]) +
+          view[3];
+    } else {
+      rawStringViews[2 * idx_64 + 1] =
+          *reinterpret_cast<const uint64_t*>(&view[2]);
+    }
+  }
+}
+
 VectorPtr createStringFlatVectorFromUtf8View(
     memory::MemoryPool* pool,
     const TypePtr& type,
@@ -614,33 +643,27 @@ VectorPtr createStringFlatVectorFromUtf8View(
         arrowArray.buffers[buffer_id], bufferSizes[buffer_id - 2]);
   }
 
-  BufferPtr stringViews =
-      AlignedBuffer::allocate<StringView>(arrowArray.length, pool);
-  auto* rawStringViews = stringViews->asMutable<uint64_t>();
-
-  // Full copy for inline strings (length <= 12). For non-inline strings,
-  // convert 16-byte Arrow Utf8View [4-byte length, 4-byte prefix, 4-byte
-  // buffer-index, 4-byte buffer-offset] to 16-byte Velox StringView [4-byte
-  // length, 4-byte prefix, 8-byte buffer-ptr]
-  for (int32_t idx_64 = 0; idx_64 < arrowArray.length; ++idx_64) {
-    auto* view = reinterpret_cast<const uint32_t*>(&(
-        reinterpret_cast<const uint64_t*>(arrowArray.buffers[1]))[2 * idx_64]);
-    rawStringViews[2 * idx_64] = *reinterpret_cast<const uint64_t*>(view);
-    if (view[0] > 12) {
-      const auto bufferIndex = view[2];
-      VELOX_CHECK_LT(
-          bufferIndex,
-          num_buffers - 3,
-          "Arrow Utf8View buffer index out of range");
-      rawStringViews[2 * idx_64 + 1] =
-          reinterpret_cast<uint64_t>(arrowArray.buffers[2 + bufferIndex]) +
-          view[3];
-    } else {
-      rawStringViews[2 * idx_64 + 1] =
-          *reinterpret_cast<const uint64_t*>(&view[2]);
+  // An inline Arrow Utf8View has the same layout as an inline
+  // Velox::StringView. If all values are inline, the views are imported as is
+  // (zero-copy).
+  const auto* arrowViews = static_cast<const uint32_t*>(arrowArray.buffers[1]);
+  bool allInline = true;
+  for (int64_t i = 0; i < arrowArray.length; ++i) {
+    if (!StringView::isInline(arrowViews[4 * i])) {
+      allInline = false;
+      break;
     }
   }
 
+  BufferPtr stringViews;
+  if (allInline) {
+    stringViews = wrapInBufferView(
+        arrowArray.buffers[1], arrowArray.length * sizeof(StringView));
+  } else {
+    stringViews = AlignedBuffer::allocate<StringView>(arrowArray.length, pool);
+    convertUtf8Views(arrowArray, stringViews->asMutable<uint64_t>());
+  }
+
   return std::make_shared<FlatVector<StringView>>(
       pool,
       type,
@@ -805,14 +828,36 @@ void exportViews(
     ArrowArray& out,
     memory::MemoryPool* pool,
     VeloxToArrowBridgeHolder& holder) {
-  auto stringBuffers = vec.stringBuffers();
-  size_t numStringBuffers = stringBuffers.size();
+  const auto& stringBuffers = vec.stringBuffers();
+  const size_t numStringBuffers = stringBuffers.size();
   // Buffers for nulls, values, variadic_buffer_sizes, and all stringBuffers.
-  size_t numBuffers = 3 + numStringBuffers;
+  const size_t numBuffers = 3 + numStringBuffers;
 
   // Resize and reassign holder buffers.
   holder.resizeBuffers(numBuffers);
   out.buffers = holder.getArrowBuffers();
+  out.n_buffers = numBuffers;
+
+  BufferPtr variadicBufferSizes =
+      AlignedBuffer::allocate<uint64_t>(numStringBuffers, pool);
+  auto* rawVariadicBufferSizes = variadicBufferSizes->asMutable<uint64_t>();
+  for (int32_t idx = 0; idx < numStringBuffers; ++idx) {
+    rawVariadicBufferSizes[idx] = stringBuffers[idx]->size();
+    holder.setBuffer(2 + idx, stringBuffers[idx]);
+  }
+  holder.setBuffer(numBuffers - 1, variadicBufferSizes);
+
+  // An inline Velox::StringView has the same layout as an inline Arrow
+  // Utf8View: [4-byte len, 12-byte zero padded data]. If all values are
+  // inline, the values buffer is exported as is (zero-copy).
+  const auto* rawValues = vec.rawValues();
+  if (!rows.changed() && vec.values() != nullptr &&
+      std::all_of(rawValues, rawValues + out.length, [](const auto& value) {
+        return value.isInline();
+      })) {
+    holder.setBuffer(1, vec.values());
+    return;
+  }
 
   // Given the difference b/w structures of the non-inline Arrow Utf8View and
   // Velox::StringView as
@@ -822,72 +867,56 @@ void exportViews(
   //
   // Velox::StringView only has a pointer to the buffer but Arrow requires the
   // exact index to the string buffer for that value the offset from the start
-  // of this buffer. Hence, we must obtain this buffer's index and offset from
-  // stringBuffers_. This is done in two parts:
-  // 1. Create a vector to store stringBuffer indices and sort this vector by
-  //    lowest to highest buffer pointer address to prepare for binary search.
-  // 2. Find the correct string buffer with binary search using the velox
-  //    buffer-pointer as key on the sorted vector of buffer indices.
-  //    We optimize further by caching the previous buffer's address and index
-  //    and only search again if the key pointer does not lie within the cached
-  //    buffer.
-
-  // Vector to store stringBuffer indices.
-  std::vector<int32_t> stringBufferVec(numStringBuffers);
-
-  BufferPtr variadicBufferSizes =
-      AlignedBuffer::allocate<size_t>(numStringBuffers, pool);
-  auto rawVariadicBufferSizes = variadicBufferSizes->asMutable<uint64_t>();
-  for (int32_t idx = 0; idx < numStringBuffers; ++idx) {
-    rawVariadicBufferSizes[idx] = stringBuffers[idx]->size();
-    holder.setBuffer(2 + idx, stringBuffers[idx]);
-    // 1a. Insert index into the vector.
-    stringBufferVec[idx] = idx;
-  }
-  holder.setBuffer(numBuffers - 1, variadicBufferSizes);
-  out.n_buffers = numBuffers;
-
-  // 1b. Sorting cache for fast binary search of [4-byte buffer-idx, 4-byte
-  // buffer-offset] from stringBufferVec with key [8-byte buffer-ptr].
-  std::stable_sort(
-      stringBufferVec.begin(),
-      stringBufferVec.end(),
-      [&out](const auto& lhs, const auto& rhs) {
-        return reinterpret_cast<uint64_t*>(&out.buffers[2])[lhs] <
-            reinterpret_cast<uint64_t*>(&out.buffers[2])[rhs];
+  // of this buffer. Hence, the views are written to a new buffer and each
+  // non-inline pointer is looked up in the string buffers sorted by address.
+  // The last found buffer is cached, since consecutive values are usually in
+  // the same buffer. The string data is not copied.
+  std::vector<int32_t> sortedBuffers(numStringBuffers);
+  std::iota(sortedBuffers.begin(), sortedBuffers.end(), 0);
+  std::sort(
+      sortedBuffers.begin(),
+      sortedBuffers.end(),
+      [&](int32_t lhs, int32_t rhs) {
+        return stringBuffers[lhs]->as<char>() < stringBuffers[rhs]->as<char>();
       });
 
-  auto utf8Views = reinterpret_cast<const uint64_t*>(out.buffers[1]);
-  int32_t bufferIdxCache = 0;
-  uint64_t bufferAddrCache = 0;
-
+  BufferPtr views = AlignedBuffer::allocate<StringView>(out.length, pool);
+  auto* rawViews = views->asMutable<uint32_t>();
+  int32_t bufferIdxCache = -1;
+  const char* bufferAddrCache = nullptr;
+  vector_size_t outIndex = 0;
   rows.apply([&](vector_size_t i) {
-    auto view = const_cast<uint32_t*>(
-        reinterpret_cast<const uint32_t*>(&utf8Views[2 * i]));
-    if (!vec.isNullAt(i) && view[0] > 12) {
-      const uint64_t currAddr = *reinterpret_cast<uint64_t*>(&view[2]);
-      // 2. Search for correct index with the buffer-pointer as key. Cache the
-      // found buffer's address and index in bufferAddrCache and bufferIdxCache
-      // respectively
-      if (i == 0 ||
-          (currAddr - bufferAddrCache) >
-              rawVariadicBufferSizes[bufferIdxCache]) {
-        auto it = std::prev(
-            std::upper_bound(
-                stringBufferVec.begin(),
-                stringBufferVec.end(),
-                currAddr,
-                [&out](const auto& lhs, const auto& rhs) {
-                  return lhs <
-                      (reinterpret_cast<uint64_t*>(&out.buffers[2]))[rhs];
-                }));
-        bufferAddrCache = (reinterpret_cast<uint64_t*>(&out.buffers[2]))[*it];
-        bufferIdxCache = *it;
-      }
-      view[2] = bufferIdxCache;
-      view[3] = currAddr - bufferAddrCache;
+    auto* view = rawViews + 4 * outIndex++;
+    if (vec.isNullAt(i)) {
+      memset(view, 0, sizeof(StringView));
+      return;
+    }
+    const auto& value = rawValues[i];
+    memcpy(view, &value, sizeof(StringView));
+    if (value.isInline()) {
+      return;
     }
+    const char* data = value.data();
+    if (bufferIdxCache < 0 || data < bufferAddrCache ||
+        static_cast<uint64_t>(data - bufferAddrCache) >=
+            rawVariadicBufferSizes[bufferIdxCache]) {
+      auto it = std::upper_bound(
+          sortedBuffers.begin(),
+          sortedBuffers.end(),
+          data,
+          [&](const char* addr, int32_t idx) {
+            return addr < stringBuffers[idx]->as<char>();
+          });
+      VELOX_CHECK(
+          it != sortedBuffers.begin(),
+          "StringView does not point into a string buffer");
+      bufferIdxCache = *std::prev(it);
+      bufferAddrCache = stringBuffers[bufferIdxCache]->as<char>();
+    }
+    view[2] = bufferIdxCache;
+    view[3] = data - bufferAddrCache;
   });
+  holder.setBuffer(1, views);
 }
 
 void exportStrings(
@@ -950,7 +979,6 @@ void exportFlat(
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
       if (options.exportToStringView) {
-        exportValues(vec, rows, options, out, pool, holder);
         exportViews(
             *vec.asUnchecked<FlatVector<StringView>>(),
             rows,
@@ -1861,12 +1889,17 @@ VectorPtr createVectorFromReeArray(
     auto indices = allocateIndices(arrowArray.length, pool);
     auto rawIndices = indices->asMutable<vector_size_t>();
 
-    size_t cursor = 0;
-    for (size_t i = 0; i < runsArray.length; ++i) {
-      while (cursor < runsBuffer[i]) {
-        rawIndices[cursor++] = i;
-      }
+    // The last run may end after 'arrowArray.length'.
+    int64_t cursor = 0;
+    for (int64_t i = 0; i < runsArray.length && cursor < arrowArray.length;
+         ++i) {
+      const auto runEnd = std::min<int64_t>(runsBuffer[i], arrowArray.length);
+      VELOX_USER_CHECK_GE(runEnd, cursor, "REE run ends must be increasing.");
+      std::fill(rawIndices + cursor, rawIndices + runEnd, i);
+      cursor = runEnd;
     }
+    VELOX_USER_CHECK_EQ(
+        cursor, arrowArray.length, "REE runs must cover the whole array.");
     return BaseVector::wrapInDictionary(
         nullptr, indices, arrowArray.length, values);
   }
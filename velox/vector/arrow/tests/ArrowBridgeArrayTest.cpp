@@ -845,6 +845,55 @@ TEST_F(ArrowBridgeArrayExportTest, arrayGap) {
   EXPECT_EQ(values.Value(3), 5);
 }
 
+TEST_F(ArrowBridgeArrayExportTest, flatStringView) {
+  const ArrowOptions options{.exportToStringView = true};
+  auto vec = vectorMaker_.flatVectorNullable<StringView>({
+      "my string",
+      "another slightly longer string",
+      std::nullopt,
+      "",
+      "another even longer string to ensure it's for sure not stored inline!!!",
+  });
+  auto expected = BaseVector::copy(*vec);
+  auto array = toArrow(vec, options, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  ASSERT_EQ(*array->type(), *arrow::utf8_view());
+  auto& views = static_cast<const arrow::StringViewArray&>(*array);
+  EXPECT_EQ(views.GetView(1), "another slightly longer string");
+  EXPECT_TRUE(views.IsNull(2));
+  EXPECT_EQ(views.GetView(3), "");
+  EXPECT_EQ(views.GetView(4).size(), 71);
+  // The string data is shared and the exported vector is not modified.
+  EXPECT_EQ(views.data_buffers().size(), vec->stringBuffers().size());
+  assertEqualVectors(expected, vec);
+
+  // Inline strings are exported without converting the views.
+  auto inlined = vectorMaker_.flatVector<StringView>({"a", "bc", "short"});
+  ArrowArray data;
+  exportToArrow(inlined, data, pool_.get(), options);
+  EXPECT_EQ(data.buffers[1], inlined->values()->as<void>());
+  data.release(&data);
+  array = toArrow(inlined, options, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  EXPECT_EQ(
+      static_cast<const arrow::StringViewArray&>(*array).GetView(2), "short");
+
+  // Values of an array with a gap are exported from the selected rows.
+  auto offsets = makeBuffer<vector_size_t>({0, 3});
+  auto sizes = makeBuffer<vector_size_t>({2, 2});
+  auto arrayVector = std::make_shared<ArrayVector>(
+      pool_.get(), ARRAY(VARCHAR()), nullptr, 2, offsets, sizes, vec);
+  array = toArrow(arrayVector, options, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  auto& elements = static_cast<const arrow::StringViewArray&>(
+      *static_cast<const arrow::ListArray&>(*array).values());
+  ASSERT_EQ(elements.length(), 4);
+  EXPECT_EQ(elements.GetView(0), "my string");
+  EXPECT_EQ(elements.GetView(1), "another slightly longer string");
+  EXPECT_EQ(elements.GetView(2), "");
+  EXPECT_EQ(elements.GetView(3).size(), 71);
+}
+
 TEST_F(ArrowBridgeArrayExportTest, arrayReorder) {
   auto elements = vectorMaker_.flatVector<int64_t>({1, 2, 3, 4, 5});
   elements->setNull(3, true);
@@ -1824,6 +1873,22 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
           EXPECT_EQ(vec.size(), 12);
         },
         ArrowOptions{.exportToStringView = true});
+
+    // Inline views are imported without conversion.
+    arrow::StringViewBuilder inlined(arrow::default_memory_pool());
+    ASSERT_OK(inlined.Append("hello", 5));
+    ASSERT_OK(inlined.AppendNull());
+    ASSERT_OK(inlined.Append("hello world", 11));
+    ASSERT_OK_AND_ASSIGN(array, inlined.Finish());
+    const void* views = array->data()->buffers[1]->data();
+    testArrowRoundTrip(
+        *array,
+        [views](const BaseVector& vec) {
+          ASSERT_EQ(vec.values()->as<void>(), views);
+          EXPECT_EQ(
+              vec.asFlatVector<StringView>()->valueAt(2).str(), "hello world");
+        },
+        ArrowOptions{.exportToStringView = true});
   }
 
   void testImportREE() {
@@ -18,6 +18,7 @@
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <numeric>
 #include <optional>
 
 #include "velox/type/Variant.h"
@@ -651,6 +652,54 @@ TEST_F(DecodedVectorTest, dictionary) {
       1000, [](vector_size_t i) { return std::make_shared<int>(i % 5); });
 }
 
+TEST_F(DecodedVectorTest, sequence) {
+  const std::vector<std::optional<int64_t>> data = {
+      1, 1, 1, std::nullopt, std::nullopt, 2, 3, 3, 3, 3};
+  const vector_size_t size = data.size();
+  VectorPtr sequence = vectorMaker_.sequenceVector(data);
+  auto assertDecoded = [&](const DecodedVector& decoded,
+                           const std::vector<vector_size_t>& rowToData,
+                           const SelectivityVector& rows) {
+    ASSERT_FALSE(decoded.isIdentityMapping());
+    ASSERT_FALSE(decoded.isConstantMapping());
+    ASSERT_EQ(decoded.base(), sequence->valueVector().get());
+    rows.applyToSelected([&](auto row) {
+      const auto& expected = data[rowToData[row]];
+      ASSERT_EQ(decoded.isNullAt(row), !expected.has_value()) << row;
+      if (expected.has_value()) {
+        ASSERT_EQ(decoded.valueAt<int64_t>(row), *expected) << row;
+      }
+    });
+  };
+
+  std::vector<vector_size_t> identity(size);
+  std::iota(identity.begin(), identity.end(), 0);
+  SelectivityVector allRows(size);
+  DecodedVector decoded(*sequence, allRows);
+  assertDecoded(decoded, identity, allRows);
+  // Rows map to their runs.
+  EXPECT_EQ(decoded.index(2), 0);
+  EXPECT_EQ(decoded.index(3), 1);
+  EXPECT_EQ(decoded.index(9), 3);
+
+  SelectivityVector someRows(size, false);
+  someRows.setValid(4, true);
+  someRows.setValid(7, true);
+  someRows.updateBounds();
+  decoded.decode(*sequence, someRows);
+  assertDecoded(decoded, identity, someRows);
+
+  // A dictionary over a sequence.
+  std::vector<vector_size_t> reverse(size);
+  for (auto i = 0; i < size; ++i) {
+    reverse[i] = size - 1 - i;
+  }
+  auto dictionary = BaseVector::wrapInDictionary(
+      nullptr, makeIndicesInReverse(size), size, sequence);
+  decoded.decode(*dictionary, allRows);
+  assertDecoded(decoded, reverse, allRows);
+}
+
 TEST_F(DecodedVectorTest, dictionaryOverLazy) {
   constexpr vector_size_t size = 1000;
   auto lazyVector = vectorMaker_.lazyFlatVector<int32_t>(
@@ -619,4 +619,54 @@ TEST(SelectivityVectorTest, copyNulls) {
   }
 }
 
+TEST(SelectivityVectorTest, sparseRows) {
+  constexpr vector_size_t kSize = 10'000;
+  SelectivityVector rows(kSize, false);
+  std::vector<vector_size_t> expected;
+  for (auto i = 7; i < kSize; i += 997) {
+    rows.setValid(i, true);
+    expected.push_back(i);
+  }
+  rows.updateBounds();
+
+  auto sparseRows = rows.sparseRows();
+  ASSERT_NE(sparseRows, nullptr);
+  EXPECT_EQ(*sparseRows, expected);
+  // The list is kept while 'rows' is not modified.
+  EXPECT_EQ(rows.sparseRows(), sparseRows);
+
+  std::vector<vector_size_t> applied;
+  rows.applyToSelected([&](auto row) { applied.push_back(row); });
+  EXPECT_EQ(applied, expected);
+
+  // A modification drops the list.
+  rows.setValid(expected[1], false);
+  expected.erase(expected.begin() + 1);
+  rows.updateBounds();
+  EXPECT_EQ(*rows.sparseRows(), expected);
+  // The list given out before is not changed.
+  EXPECT_EQ(sparseRows->size(), expected.size() + 1);
+
+  applied.clear();
+  rows.applyToSelected([&](auto row) { applied.push_back(row); });
+  EXPECT_EQ(applied, expected);
+
+  // Dense or narrow selections are scanned as bits.
+  rows.setValidRange(0, kSize / 2, true);
+  rows.updateBounds();
+  EXPECT_EQ(rows.sparseRows(), nullptr);
+
+  SelectivityVector narrow(kSize, false);
+  narrow.setValid(100, true);
+  narrow.setValid(200, true);
+  narrow.updateBounds();
+  EXPECT_EQ(narrow.sparseRows(), nullptr);
+
+  rows.clearAll();
+  EXPECT_EQ(rows.sparseRows(), nullptr);
+  applied.clear();
+  rows.applyToSelected([&](auto row) { applied.push_back(row); });
+  EXPECT_TRUE(applied.empty());
+}
+
 } // namespace facebook::velox
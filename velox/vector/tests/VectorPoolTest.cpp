@@ -198,4 +198,54 @@ TEST_F(VectorPoolTest, clear) {
     ASSERT_EQ(vectorPtrs[i].lock(), nullptr);
   }
 }
+
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+  const auto rowType = ROW({"a", "b"}, {BIGINT(), ARRAY(VARCHAR())});
+
+  VectorPtr vector = makeRowVector(
+      {"a", "b"},
+      {
+          makeFlatVector<int64_t>({1, 2, 3}),
+          makeArrayVector<std::string>({{"a", "b"}, {}, {"a long string"}}),
+      });
+  vector->setNull(1, true);
+  auto* vectorPtr = vector.get();
+  auto* elementsPtr =
+      vector->as<RowVector>()->childAt(1)->as<ArrayVector>()->elements().get();
+  ASSERT_TRUE(vectorPool.release(vector));
+  ASSERT_EQ(vector, nullptr);
+
+  // A type with other names does not get the recycled vector.
+  auto other =
+      vectorPool.get(ROW({"x", "y"}, {BIGINT(), ARRAY(VARCHAR())}), 2);
+  ASSERT_NE(other.get(), vectorPtr);
+
+  // The recycled vector keeps its children, which are empty, and has no
+  // nulls.
+  auto recycled = vectorPool.get(rowType, 5);
+  ASSERT_EQ(recycled.get(), vectorPtr);
+  ASSERT_EQ(recycled->size(), 5);
+  auto* row = recycled->as<RowVector>();
+  auto* array = row->childAt(1)->as<ArrayVector>();
+  ASSERT_EQ(array->elements().get(), elementsPtr);
+  ASSERT_EQ(array->elements()->size(), 0);
+  for (auto i = 0; i < 5; ++i) {
+    ASSERT_FALSE(recycled->isNullAt(i));
+    ASSERT_EQ(array->sizeAt(i), 0);
+  }
+
+  // A vector with shared children is not recycled.
+  auto child = makeFlatVector<int64_t>({1, 2});
+  VectorPtr shared = makeRowVector({child});
+  ASSERT_FALSE(vectorPool.release(shared));
+  ASSERT_NE(shared, nullptr);
+
+  // Clearing frees the recycled complex vectors.
+  std::weak_ptr<BaseVector> recycledPtr = recycled;
+  ASSERT_TRUE(vectorPool.release(recycled));
+  vectorPool.clear();
+  ASSERT_EQ(recycledPtr.lock(), nullptr);
+}
+
 } // namespace facebook::velox::test